@@ -0,0 +1,433 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <benchmark/benchmark.h>
+#include <ftw.h>
+#include <algorithm>
+#include <cstdio>
+#include <pqxx/pqxx>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <vector>
+#include "ametsuchi/impl/block_serializer.hpp"
+#include "ametsuchi/impl/flat_file/flat_file.hpp"
+#include "ametsuchi/impl/segmented_log/segmented_log.hpp"
+#include "ametsuchi/impl/storage_impl.hpp"
+#include "model/commands/add_asset_quantity.hpp"
+#include "model/commands/create_account.hpp"
+#include "model/commands/create_asset.hpp"
+#include "model/commands/create_domain.hpp"
+#include "model/model_hash_provider_impl.hpp"
+
+/**
+ * Storage layer: block append and reads of both block stores in both
+ * encodings, range scans, world state view point queries and commit
+ * latency, for embedded (LMDB) and external (PostgreSQL and Redis)
+ * backends. External backends are measured when IROHA_POSTGRES_HOST,
+ * IROHA_POSTGRES_PORT, IROHA_POSTGRES_USER, IROHA_POSTGRES_PASSWORD,
+ * IROHA_REDIS_HOST and IROHA_REDIS_PORT are set, as for ametsuchi_test.
+ * For trend tracking run with --benchmark_out=<file>
+ * --benchmark_out_format=json
+ */
+
+using namespace iroha;
+using namespace iroha::ametsuchi;
+
+namespace {
+  const size_t kAccounts = 1000;
+  const std::string kDomain = "bench";
+  const std::string kAsset = "coin#bench";
+
+  std::string accountId(size_t i) {
+    return "user" + std::to_string(i) + "@" + kDomain;
+  }
+
+  /**
+   * Empty directory removed with its contents on destruction
+   */
+  class TempDir {
+   public:
+    TempDir() {
+      char path[] = "/tmp/ametsuchi_benchmark_XXXXXX";
+      path_ = mkdtemp(path);
+    }
+
+    ~TempDir() {
+      nftw(path_.c_str(),
+           [](const char *path, const struct stat *, int, struct FTW *) {
+             return ::remove(path);
+           },
+           16,
+           FTW_DEPTH | FTW_PHYS);
+    }
+
+    /**
+     * @return path of new subdirectory
+     */
+    std::string sub(const std::string &name) const {
+      auto path = path_ + "/" + name;
+      mkdir(path.c_str(), S_IRWXU);
+      return path;
+    }
+
+   private:
+    std::string path_;
+  };
+
+  /**
+   * Connection settings of external backends, nullopt if not configured
+   */
+  struct External {
+    std::string postgres;
+    std::string redis_host;
+    size_t redis_port;
+  };
+
+  nonstd::optional<External> external() {
+    auto pg_host = std::getenv("IROHA_POSTGRES_HOST");
+    auto pg_port = std::getenv("IROHA_POSTGRES_PORT");
+    auto pg_user = std::getenv("IROHA_POSTGRES_USER");
+    auto pg_pass = std::getenv("IROHA_POSTGRES_PASSWORD");
+    auto rd_host = std::getenv("IROHA_REDIS_HOST");
+    auto rd_port = std::getenv("IROHA_REDIS_PORT");
+    if (not(pg_host and pg_port and pg_user and pg_pass and rd_host
+            and rd_port)) {
+      return nonstd::nullopt;
+    }
+    std::stringstream ss;
+    ss << "host=" << pg_host << " port=" << pg_port << " user=" << pg_user
+       << " password=" << pg_pass;
+    return External{ss.str(), rd_host, std::stoull(rd_port)};
+  }
+
+  /**
+   * Drop tables so the next run starts from empty world state view
+   */
+  void dropTables(const std::string &postgres) {
+    pqxx::connection connection(postgres);
+    pqxx::work txn(connection);
+    txn.exec(
+        "DROP TABLE IF EXISTS account_has_asset;\n"
+        "DROP TABLE IF EXISTS account_has_signatory;\n"
+        "DROP TABLE IF EXISTS peer;\n"
+        "DROP TABLE IF EXISTS account;\n"
+        "DROP TABLE IF EXISTS exchange;\n"
+        "DROP TABLE IF EXISTS asset;\n"
+        "DROP TABLE IF EXISTS domain;\n"
+        "DROP TABLE IF EXISTS signatory;");
+    txn.commit();
+  }
+
+  /**
+   * Block of transactions issuing coins to accounts created by genesis
+   */
+  model::Block makeBlock(uint32_t height, size_t transactions) {
+    model::HashProviderImpl hash_provider;
+    model::Block block;
+    block.height = height;
+    for (size_t i = 0; i < transactions; ++i) {
+      auto add = std::make_shared<model::AddAssetQuantity>();
+      add->account_id = accountId((height * transactions + i) % kAccounts);
+      add->asset_id = kAsset;
+      add->amount = Amount(1, 0);
+      model::Transaction tx;
+      tx.creator_account_id = accountId(0);
+      tx.tx_counter = height * transactions + i;
+      tx.commands.push_back(add);
+      tx.tx_hash = hash_provider.get_hash(tx);
+      block.transactions.push_back(tx);
+    }
+    block.txs_number = block.transactions.size();
+    block.merkle_root = hash_provider.get_merkle_root(block.transactions);
+    block.hash = hash_provider.get_hash(block);
+    return block;
+  }
+
+  /**
+   * Block creating domain, asset and kAccounts accounts
+   */
+  model::Block makeGenesis() {
+    model::Transaction tx;
+    auto domain = std::make_shared<model::CreateDomain>();
+    domain->domain_name = kDomain;
+    tx.commands.push_back(domain);
+    auto asset = std::make_shared<model::CreateAsset>();
+    asset->asset_name = "coin";
+    asset->domain_id = kDomain;
+    asset->precision = 2;
+    tx.commands.push_back(asset);
+    for (size_t i = 0; i < kAccounts; ++i) {
+      auto account = std::make_shared<model::CreateAccount>();
+      account->account_name = "user" + std::to_string(i);
+      account->domain_id = kDomain;
+      tx.commands.push_back(account);
+    }
+    model::Block block;
+    block.height = 1;
+    block.transactions.push_back(tx);
+    block.txs_number = 1;
+    block.hash = model::HashProviderImpl().get_hash(block);
+    return block;
+  }
+
+  bool apply(StorageImpl &storage, const model::Block &block) {
+    auto ms = storage.createMutableStorage();
+    auto applied = ms->apply(
+        block,
+        [](const auto &blk, auto &executor, auto &query, const auto &) {
+          for (const auto &tx : blk.transactions) {
+            for (const auto &command : tx.commands) {
+              if (not command->execute(query, executor)) {
+                return false;
+              }
+            }
+          }
+          return true;
+        });
+    storage.commit(std::move(ms));
+    return applied;
+  }
+
+  /**
+   * Storage with genesis committed, on embedded or external backends
+   */
+  class Fixture {
+   public:
+    Fixture(WsvBackendType backend, BlockFormat format) {
+      BlockStorageOptions options;
+      options.format = format;
+      options.wsv_backend = backend;
+      options.wsv_path = dir_.sub("wsv");
+      options.block_index = BlockIndexType::Embedded;
+      options.block_index_path = dir_.sub("index");
+      External settings{};
+      if (backend == WsvBackendType::Postgres) {
+        auto configured = external();
+        if (not configured) {
+          error = "external backends are not configured";
+          return;
+        }
+        settings = *configured;
+        postgres_ = settings.postgres;
+        options.block_index = BlockIndexType::Redis;
+      }
+      storage = StorageImpl::create(dir_.sub("blocks"),
+                                    settings.redis_host,
+                                    settings.redis_port,
+                                    settings.postgres,
+                                    options);
+      if (not storage) {
+        error = "cannot create storage";
+      } else if (not apply(*storage, makeGenesis())) {
+        error = "cannot apply genesis";
+      }
+    }
+
+    ~Fixture() {
+      storage.reset();
+      if (not postgres_.empty()) {
+        dropTables(postgres_);
+      }
+    }
+
+    std::shared_ptr<StorageImpl> storage;
+    std::string error;
+
+   private:
+    TempDir dir_;
+    std::string postgres_;
+  };
+
+  std::unique_ptr<BlockStorage> createStore(BlockStorageType type,
+                                            const std::string &path) {
+    switch (type) {
+      case BlockStorageType::Segmented:
+        return SegmentedLog::create(path);
+      case BlockStorageType::FlatFile:
+        return FlatFile::create(path);
+    }
+    return nullptr;
+  }
+
+  /**
+   * Arguments of block store benchmarks: store, encoding, transactions per
+   * block
+   */
+  void storeArguments(benchmark::internal::Benchmark *benchmark) {
+    for (auto type : {BlockStorageType::FlatFile, BlockStorageType::Segmented}) {
+      for (auto format : {BlockFormat::Json, BlockFormat::Protobuf}) {
+        for (auto transactions : {10, 100, 1000}) {
+          benchmark->Args(
+              {static_cast<int>(type), static_cast<int>(format), transactions});
+        }
+      }
+    }
+  }
+
+  /**
+   * Arguments of storage benchmarks: world state view backend, transactions
+   * per block
+   */
+  void backendArguments(benchmark::internal::Benchmark *benchmark) {
+    for (auto backend : {WsvBackendType::Lmdb, WsvBackendType::Postgres}) {
+      for (auto transactions : {10, 100, 1000}) {
+        benchmark->Args({static_cast<int>(backend), transactions});
+      }
+    }
+  }
+}  // namespace
+
+/**
+ * Arguments: block store, encoding, transactions per block
+ */
+static void BM_BlockAppend(benchmark::State &state) {
+  TempDir dir;
+  auto store =
+      createStore(static_cast<BlockStorageType>(state.range(0)), dir.sub("s"));
+  BlockSerializer serializer(static_cast<BlockFormat>(state.range(1)));
+  auto bytes = serializer.serialize(makeBlock(1, state.range(2)));
+  uint32_t id = 0;
+  while (state.KeepRunning()) {
+    store->add(++id, bytes);
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+BENCHMARK(BM_BlockAppend)->Apply(storeArguments);
+
+/**
+ * Arguments: block store, encoding, transactions per block, random order
+ */
+static void BM_BlockGet(benchmark::State &state) {
+  const uint32_t blocks = 1000;
+  TempDir dir;
+  auto store =
+      createStore(static_cast<BlockStorageType>(state.range(0)), dir.sub("s"));
+  BlockSerializer serializer(static_cast<BlockFormat>(state.range(1)));
+  for (uint32_t id = 1; id <= blocks; ++id) {
+    store->add(id, serializer.serialize(makeBlock(id, state.range(2))));
+  }
+  std::vector<uint32_t> order(blocks);
+  std::iota(order.begin(), order.end(), 1);
+  if (state.range(3)) {
+    std::shuffle(order.begin(), order.end(), std::mt19937(42));
+  }
+  size_t i = 0;
+  while (state.KeepRunning()) {
+    auto bytes = store->get(order[i++ % blocks]);
+    benchmark::DoNotOptimize(
+        serializer.deserialize(bytes->data(), bytes->size()));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+static void getArguments(benchmark::internal::Benchmark *benchmark) {
+  for (auto type : {BlockStorageType::FlatFile, BlockStorageType::Segmented}) {
+    for (auto format : {BlockFormat::Json, BlockFormat::Protobuf}) {
+      for (auto transactions : {10, 100}) {
+        for (auto random : {0, 1}) {
+          benchmark->Args({static_cast<int>(type),
+                           static_cast<int>(format),
+                           transactions,
+                           random});
+        }
+      }
+    }
+  }
+}
+BENCHMARK(BM_BlockGet)->Apply(getArguments);
+
+/**
+ * Arguments: world state view backend, blocks in range
+ */
+static void BM_GetBlocks(benchmark::State &state) {
+  Fixture fixture(static_cast<WsvBackendType>(state.range(0)),
+                  BlockFormat::Protobuf);
+  if (not fixture.error.empty()) {
+    state.SkipWithError(fixture.error.c_str());
+    return;
+  }
+  const uint32_t blocks = 1000;
+  for (uint32_t height = 2; height <= blocks; ++height) {
+    apply(*fixture.storage, makeBlock(height, 10));
+  }
+  const uint32_t range = state.range(1);
+  uint32_t from = 1;
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(fixture.storage->getBlocks(from, from + range - 1)
+                                 .count()
+                                 .as_blocking()
+                                 .first());
+    from = from + range > blocks - range ? 1 : from + range;
+  }
+  state.SetItemsProcessed(state.iterations() * range);
+}
+BENCHMARK(BM_GetBlocks)
+    ->Args({static_cast<int>(WsvBackendType::Lmdb), 10})
+    ->Args({static_cast<int>(WsvBackendType::Lmdb), 100})
+    ->Args({static_cast<int>(WsvBackendType::Postgres), 10})
+    ->Args({static_cast<int>(WsvBackendType::Postgres), 100});
+
+/**
+ * Argument: world state view backend
+ */
+static void BM_WsvPointQuery(benchmark::State &state) {
+  Fixture fixture(static_cast<WsvBackendType>(state.range(0)),
+                  BlockFormat::Protobuf);
+  if (not fixture.error.empty()) {
+    state.SkipWithError(fixture.error.c_str());
+    return;
+  }
+  apply(*fixture.storage, makeBlock(2, kAccounts));
+  std::mt19937 random(42);
+  std::uniform_int_distribution<size_t> accounts(0, kAccounts - 1);
+  while (state.KeepRunning()) {
+    auto account_id = accountId(accounts(random));
+    benchmark::DoNotOptimize(
+        fixture.storage->getAccountAsset(account_id, kAsset));
+    benchmark::DoNotOptimize(fixture.storage->getAccount(account_id));
+  }
+  state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_WsvPointQuery)
+    ->Arg(static_cast<int>(WsvBackendType::Lmdb))
+    ->Arg(static_cast<int>(WsvBackendType::Postgres));
+
+/**
+ * Arguments: world state view backend, transactions per block
+ */
+static void BM_Commit(benchmark::State &state) {
+  Fixture fixture(static_cast<WsvBackendType>(state.range(0)),
+                  BlockFormat::Protobuf);
+  if (not fixture.error.empty()) {
+    state.SkipWithError(fixture.error.c_str());
+    return;
+  }
+  uint32_t height = 1;
+  while (state.KeepRunning()) {
+    // building the block is not a part of commit
+    state.PauseTiming();
+    auto block = makeBlock(++height, state.range(1));
+    state.ResumeTiming();
+    apply(*fixture.storage, block);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK(BM_Commit)->Apply(backendArguments)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,237 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string>
+#include <vector>
+#include "common/types.hpp"
+#include "crypto/base64.hpp"
+#include "crypto/crypto.hpp"
+#include "crypto/hash.hpp"
+#include "model/commands/add_asset_quantity.hpp"
+#include "model/commands/transfer_asset.hpp"
+#include "model/model_hash_provider_impl.hpp"
+
+/**
+ * Throughput of crypto primitives and hashing of model objects.
+ * Hashes and codecs report bytes per second of input, signatures and
+ * model hashes report operations per second.
+ */
+
+using namespace iroha;
+
+namespace {
+  std::vector<uint8_t> randomBytes(size_t size) {
+    std::mt19937 generator(size);
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::vector<uint8_t> bytes(size);
+    for (auto &b : bytes) {
+      b = static_cast<uint8_t>(byte(generator));
+    }
+    return bytes;
+  }
+
+  /**
+   * Payment transaction like the ones clients send: two commands and
+   * one signature
+   */
+  model::Transaction makeTransaction(size_t i,
+                                     const ed25519::keypair_t &keys) {
+    model::Transaction tx;
+    tx.creator_account_id = "user" + std::to_string(i) + "@test";
+    tx.tx_counter = i;
+
+    auto add = std::make_shared<model::AddAssetQuantity>();
+    add->account_id = tx.creator_account_id;
+    add->asset_id = "coin#test";
+    add->amount = Amount(100, 0);
+    tx.commands.push_back(add);
+
+    auto transfer = std::make_shared<model::TransferAsset>();
+    transfer->src_account_id = tx.creator_account_id;
+    transfer->dest_account_id = "user" + std::to_string(i + 1) + "@test";
+    transfer->asset_id = "coin#test";
+    transfer->amount = Amount(10, 50);
+    tx.commands.push_back(transfer);
+
+    auto hash = model::HashProviderImpl().get_hash(tx);
+    model::Signature signature;
+    signature.pubkey = keys.pubkey;
+    signature.signature =
+        sign(hash.data(), hash.size(), keys.pubkey, keys.privkey);
+    tx.signatures.push_back(signature);
+    return tx;
+  }
+
+  model::Block makeBlock(size_t transactions) {
+    auto keys = create_keypair(create_seed());
+    model::Block block;
+    for (size_t i = 0; i < transactions; ++i) {
+      block.transactions.push_back(makeTransaction(i, keys));
+    }
+    block.txs_number = block.transactions.size();
+    block.height = 42;
+    return block;
+  }
+
+  void messageSizes(benchmark::internal::Benchmark *benchmark) {
+    benchmark->RangeMultiplier(8)->Range(32, 1 << 20);
+  }
+
+  void blockSizes(benchmark::internal::Benchmark *benchmark) {
+    benchmark->RangeMultiplier(10)->Range(10, 10000);
+  }
+}  // namespace
+
+static void BM_Sha3_256(benchmark::State &state) {
+  auto input = randomBytes(state.range(0));
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(sha3_256(input.data(), input.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_Sha3_256)->Apply(messageSizes);
+
+static void BM_Sha3_512(benchmark::State &state) {
+  auto input = randomBytes(state.range(0));
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(sha3_512(input.data(), input.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_Sha3_512)->Apply(messageSizes);
+
+/**
+ * Many short messages hashed at once, e.g. transactions of proposal
+ */
+static void BM_Sha3_256Batch(benchmark::State &state) {
+  std::vector<std::string> messages(state.range(0), std::string(200, 'a'));
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(sha3_256_batch(messages));
+  }
+  state.SetBytesProcessed(state.iterations() * messages.size() * 200);
+}
+BENCHMARK(BM_Sha3_256Batch)->Arg(4)->Arg(64)->Arg(1024);
+
+static void BM_Sign(benchmark::State &state) {
+  auto keys = create_keypair(create_seed());
+  auto hash = sha3_256(keys.pubkey.data(), keys.pubkey.size());
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(
+        sign(hash.data(), hash.size(), keys.pubkey, keys.privkey));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Sign);
+
+static void BM_Verify(benchmark::State &state) {
+  auto keys = create_keypair(create_seed());
+  auto hash = sha3_256(keys.pubkey.data(), keys.pubkey.size());
+  auto signature = sign(hash.data(), hash.size(), keys.pubkey, keys.privkey);
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(
+        verify(hash.data(), hash.size(), keys.pubkey, signature));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Verify);
+
+static void BM_VerifyBatch(benchmark::State &state) {
+  auto keys = create_keypair(create_seed());
+  auto hash = sha3_256(keys.pubkey.data(), keys.pubkey.size());
+  auto signature = sign(hash.data(), hash.size(), keys.pubkey, keys.privkey);
+  std::vector<SignedMessage> batch(
+      state.range(0), {hash.data(), hash.size(), keys.pubkey, signature});
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(verify_batch(batch));
+  }
+  state.SetItemsProcessed(state.iterations() * batch.size());
+}
+BENCHMARK(BM_VerifyBatch)->Arg(16)->Arg(256)->UseRealTime();
+
+static void BM_Base64Encode(benchmark::State &state) {
+  auto input = randomBytes(state.range(0));
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(base64_encode(input.data(), input.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_Base64Encode)->Arg(64)->Arg(4096);
+
+static void BM_Base64Decode(benchmark::State &state) {
+  auto input = randomBytes(state.range(0));
+  auto encoded = base64_encode(input.data(), input.size());
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(base64_decode(encoded));
+  }
+  state.SetBytesProcessed(state.iterations() * encoded.size());
+}
+BENCHMARK(BM_Base64Decode)->Arg(64)->Arg(4096);
+
+static void BM_HexEncode(benchmark::State &state) {
+  auto input = randomBytes(state.range(0));
+  std::string bytes(input.begin(), input.end());
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(bytestringToHexstring(bytes));
+  }
+  state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+BENCHMARK(BM_HexEncode)->Arg(32)->Arg(4096);
+
+static void BM_HexDecode(benchmark::State &state) {
+  auto input = randomBytes(state.range(0));
+  auto hex = bytestringToHexstring(std::string(input.begin(), input.end()));
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(hex2bytes(hex));
+  }
+  state.SetBytesProcessed(state.iterations() * hex.size());
+}
+BENCHMARK(BM_HexDecode)->Arg(32)->Arg(4096);
+
+/**
+ * Hash of transaction which has just arrived at Torii
+ */
+static void BM_TransactionHash(benchmark::State &state) {
+  auto tx = makeTransaction(0, create_keypair(create_seed()));
+  model::HashProviderImpl hash_provider;
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(hash_provider.get_hash(tx));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TransactionHash);
+
+/**
+ * Merkle root and hash of block whose transactions have no memoized
+ * hashes, e.g. block received from another peer
+ */
+static void BM_BlockHash(benchmark::State &state) {
+  auto block = makeBlock(state.range(0));
+  model::HashProviderImpl hash_provider;
+  while (state.KeepRunning()) {
+    block.merkle_root = hash_provider.get_merkle_root(block.transactions);
+    benchmark::DoNotOptimize(hash_provider.get_hash(block));
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.counters["tx/s"] = benchmark::Counter(
+      state.iterations() * block.transactions.size(),
+      benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_BlockHash)->Apply(blockSizes)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
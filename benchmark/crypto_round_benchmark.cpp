@@ -0,0 +1,135 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "consensus/yac/impl/yac_crypto_provider_impl.hpp"
+#include "crypto/crypto.hpp"
+#include "model/model_crypto_provider_impl.hpp"
+#include "model/model_hash_provider_impl.hpp"
+
+/**
+ * Crypto cost of one round with real providers: Torii checks every
+ * transaction of proposal, chain validation checks signatures of peers
+ * on the block, and YAC signs a vote and checks votes of all peers
+ */
+
+using namespace iroha;
+
+namespace {
+  std::vector<ed25519::keypair_t> makeKeys(size_t count) {
+    std::vector<ed25519::keypair_t> keys;
+    for (size_t i = 0; i < count; ++i) {
+      keys.push_back(create_keypair(create_seed()));
+    }
+    return keys;
+  }
+
+  model::Signature signHash(const hash256_t &hash,
+                            const ed25519::keypair_t &keys) {
+    model::Signature signature;
+    signature.pubkey = keys.pubkey;
+    signature.signature =
+        sign(hash.data(), hash.size(), keys.pubkey, keys.privkey);
+    return signature;
+  }
+
+  /**
+   * Block of transactions with given number of signatures each, signed by
+   * all peers
+   */
+  model::Block makeBlock(size_t transactions,
+                         size_t signatures,
+                         const std::vector<ed25519::keypair_t> &peers) {
+    model::HashProviderImpl hash_provider;
+    auto signers = makeKeys(signatures);
+    model::Block block;
+    for (size_t i = 0; i < transactions; ++i) {
+      model::Transaction tx;
+      tx.creator_account_id = "user" + std::to_string(i) + "@test";
+      tx.tx_counter = i;
+      auto hash = hash_provider.get_hash(tx);
+      for (const auto &signer : signers) {
+        tx.signatures.push_back(signHash(hash, signer));
+      }
+      // converted transactions carry their hash
+      tx.tx_hash = hash;
+      block.transactions.push_back(tx);
+    }
+    block.txs_number = block.transactions.size();
+    block.merkle_root = hash_provider.get_merkle_root(block.transactions);
+    auto hash = hash_provider.get_hash(block);
+    for (const auto &peer : peers) {
+      block.sigs.push_back(signHash(hash, peer));
+    }
+    return block;
+  }
+}  // namespace
+
+/**
+ * Arguments: signature check, signatures per transaction, peers
+ */
+static void BM_ProposalChecks(benchmark::State &state) {
+  auto check = static_cast<model::SignatureCheck>(state.range(0));
+  auto block = makeBlock(100, state.range(1), makeKeys(state.range(2)));
+  while (state.KeepRunning()) {
+    // cache lives as long as one round
+    model::ModelCryptoProviderImpl provider(check);
+    for (const auto &tx : block.transactions) {
+      benchmark::DoNotOptimize(provider.verify(tx));
+    }
+    benchmark::DoNotOptimize(provider.verify(block));
+  }
+  state.SetItemsProcessed(state.iterations() * block.transactions.size());
+}
+static void proposalArguments(benchmark::internal::Benchmark *benchmark) {
+  for (auto check : {model::SignatureCheck::Serial,
+                     model::SignatureCheck::Parallel,
+                     model::SignatureCheck::Cached}) {
+    for (auto signatures : {1, 5}) {
+      for (auto peers : {4, 16}) {
+        benchmark->Args({static_cast<int>(check), signatures, peers});
+      }
+    }
+  }
+}
+BENCHMARK(BM_ProposalChecks)
+    ->Apply(proposalArguments)
+    ->Unit(benchmark::kMillisecond);
+
+/**
+ * Argument: peers
+ */
+static void BM_YacRound(benchmark::State &state) {
+  using namespace consensus::yac;
+  auto keys = makeKeys(state.range(0));
+  YacHash hash(create_seed(), create_seed());
+  std::vector<VoteMessage> votes;
+  for (const auto &peer : keys) {
+    votes.push_back(YacCryptoProviderImpl(peer).getVote(hash));
+  }
+  YacCryptoProviderImpl crypto(keys.front());
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(crypto.getVote(hash));
+    benchmark::DoNotOptimize(crypto.verifyBatch(votes));
+    benchmark::DoNotOptimize(crypto.verify(CommitMessage(votes)));
+  }
+}
+BENCHMARK(BM_YacRound)->Arg(4)->Arg(16)->Arg(64)->Unit(
+    benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
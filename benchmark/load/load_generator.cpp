@@ -0,0 +1,422 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "load/load_generator.hpp"
+#include <netdb.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <sstream>
+#include "crypto/crypto.hpp"
+#include "model/commands/add_asset_quantity.hpp"
+#include "model/commands/add_peer.hpp"
+#include "model/commands/create_account.hpp"
+#include "model/commands/create_asset.hpp"
+#include "model/commands/create_domain.hpp"
+#include "model/commands/set_permissions.hpp"
+#include "model/commands/transfer_asset.hpp"
+#include "model/converters/pb_transaction_factory.hpp"
+#include "model/model_hash_provider_impl.hpp"
+#include "torii/command_client.hpp"
+
+namespace iroha {
+  namespace load {
+
+    const std::string LoadPlan::kDomain = "load";
+    const std::string LoadPlan::kAsset = "coin#load";
+
+    namespace {
+      model::Signature signHash(const hash256_t &hash,
+                                const ed25519::keypair_t &keys) {
+        model::Signature signature;
+        signature.pubkey = keys.pubkey;
+        signature.signature =
+            sign(hash.data(), hash.size(), keys.pubkey, keys.privkey);
+        return signature;
+      }
+
+      uint64_t nowMs() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::system_clock::now().time_since_epoch())
+            .count();
+      }
+
+      /**
+       * @return value at quantile q of sorted values
+       */
+      double percentile(const std::vector<double> &sorted, double q) {
+        if (sorted.empty()) {
+          return 0;
+        }
+        auto index = static_cast<size_t>(std::ceil(q * sorted.size()));
+        return sorted[std::min(sorted.size(), std::max<size_t>(index, 1)) - 1];
+      }
+
+      std::pair<std::string, int> splitAddress(const std::string &address) {
+        auto colon = address.rfind(':');
+        return {address.substr(0, colon),
+                std::stoi(address.substr(colon + 1))};
+      }
+    }  // namespace
+
+    // LoadPlan
+
+    LoadPlan::LoadPlan(size_t accounts, size_t transactions)
+        : transactions_count_(transactions) {
+      for (size_t i = 0; i < accounts; ++i) {
+        keys_.push_back(create_keypair(create_seed(accountId(i))));
+      }
+      model::HashProviderImpl hash_provider;
+      model::converters::PbTransactionFactory factory;
+      auto created = nowMs();
+      transactions_.reserve(transactions);
+      hashes_.reserve(transactions);
+      for (size_t i = 0; i < transactions; ++i) {
+        auto sender = i % accounts;
+        auto transfer = std::make_shared<model::TransferAsset>();
+        transfer->src_account_id = accountId(sender);
+        transfer->dest_account_id = accountId((sender + 1) % accounts);
+        transfer->asset_id = kAsset;
+        transfer->amount = Amount(1, 0);
+        model::Transaction tx;
+        tx.creator_account_id = transfer->src_account_id;
+        tx.created_ts = created;
+        tx.tx_counter = i / accounts + 1;
+        tx.commands.push_back(transfer);
+        auto hash = hash_provider.get_hash(tx);
+        tx.signatures.push_back(signHash(hash, keys_[sender]));
+        transactions_.push_back(factory.serialize(tx));
+        hashes_.push_back(hash.to_string());
+      }
+    }
+
+    std::string LoadPlan::accountId(size_t i) {
+      // names of accounts are limited to 7 characters
+      return "l" + std::to_string(i) + "@" + kDomain;
+    }
+
+    model::Block LoadPlan::genesis(
+        const std::vector<model::Peer> &peers) const {
+      model::Transaction tx;
+      tx.created_ts = nowMs();
+      for (const auto &peer : peers) {
+        auto add_peer = std::make_shared<model::AddPeer>();
+        add_peer->address = peer.address;
+        add_peer->peer_key = peer.pubkey;
+        tx.commands.push_back(add_peer);
+      }
+      auto domain = std::make_shared<model::CreateDomain>();
+      domain->domain_name = kDomain;
+      tx.commands.push_back(domain);
+      auto asset = std::make_shared<model::CreateAsset>();
+      asset->asset_name = "coin";
+      asset->domain_id = kDomain;
+      asset->precision = 2;
+      tx.commands.push_back(asset);
+
+      // every account sends its share of transfers and receives the same
+      // number, one spare transfer covers the remainder
+      auto funds = transactions_count_ / keys_.size() + 1;
+      model::Account::Permissions permissions;
+      permissions.can_transfer = true;
+      for (size_t i = 0; i < keys_.size(); ++i) {
+        auto id = accountId(i);
+        auto account = std::make_shared<model::CreateAccount>();
+        account->account_name = id.substr(0, id.find('@'));
+        account->domain_id = kDomain;
+        account->pubkey = keys_[i].pubkey;
+        tx.commands.push_back(account);
+        auto allow = std::make_shared<model::SetAccountPermissions>();
+        allow->account_id = id;
+        allow->new_permissions = permissions;
+        tx.commands.push_back(allow);
+        auto issue = std::make_shared<model::AddAssetQuantity>();
+        issue->account_id = id;
+        issue->asset_id = kAsset;
+        issue->amount = Amount(funds, 0);
+        tx.commands.push_back(issue);
+      }
+
+      model::HashProviderImpl hash_provider;
+      model::Block block;
+      block.transactions.push_back(tx);
+      block.height = 1;
+      block.prev_hash.fill(0);
+      block.txs_number = 1;
+      block.created_ts = tx.created_ts;
+      block.merkle_root = hash_provider.get_merkle_root(block.transactions);
+      block.hash = hash_provider.get_hash(block);
+      return block;
+    }
+
+    const std::vector<protocol::Transaction> &LoadPlan::transactions() const {
+      return transactions_;
+    }
+
+    const std::vector<std::string> &LoadPlan::hashes() const {
+      return hashes_;
+    }
+
+    // LoadReport
+
+    std::string LoadReport::toJson() const {
+      std::stringstream ss;
+      ss << "{\"submitted\":" << submitted << ",\"accepted\":" << accepted
+         << ",\"rejected\":" << rejected << ",\"retry_later\":" << retry_later
+         << ",\"committed\":" << committed
+         << ",\"submit_seconds\":" << submit_seconds
+         << ",\"commit_seconds\":" << commit_seconds
+         << ",\"submit_rate\":" << submit_rate
+         << ",\"commit_rate\":" << commit_rate
+         << ",\"latency_samples\":" << latency_samples
+         << ",\"latency_ms\":{\"p50\":" << p50_ms << ",\"p90\":" << p90_ms
+         << ",\"p99\":" << p99_ms << ",\"max\":" << max_ms << "}}";
+      return ss.str();
+    }
+
+    // scrapeCounter
+
+    nonstd::optional<uint64_t> scrapeCounter(const std::string &address,
+                                             const std::string &name) {
+      auto colon = address.rfind(':');
+      if (colon == std::string::npos) {
+        return nonstd::nullopt;
+      }
+      addrinfo hints{};
+      hints.ai_family = AF_UNSPEC;
+      hints.ai_socktype = SOCK_STREAM;
+      addrinfo *info = nullptr;
+      if (::getaddrinfo(address.substr(0, colon).c_str(),
+                        address.substr(colon + 1).c_str(),
+                        &hints,
+                        &info)
+          != 0) {
+        return nonstd::nullopt;
+      }
+      auto fd = ::socket(info->ai_family, info->ai_socktype, info->ai_protocol);
+      auto connected =
+          fd >= 0 and ::connect(fd, info->ai_addr, info->ai_addrlen) == 0;
+      ::freeaddrinfo(info);
+      if (not connected) {
+        if (fd >= 0) {
+          ::close(fd);
+        }
+        return nonstd::nullopt;
+      }
+      const std::string request =
+          "GET /metrics HTTP/1.0\r\nHost: " + address + "\r\n\r\n";
+      ::send(fd, request.data(), request.size(), MSG_NOSIGNAL);
+      std::string body;
+      char buffer[4096];
+      ssize_t read;
+      while ((read = ::recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+        body.append(buffer, read);
+      }
+      ::close(fd);
+
+      std::istringstream lines(body);
+      std::string line;
+      while (std::getline(lines, line)) {
+        if (line.compare(0, name.size() + 1, name + " ") == 0) {
+          return static_cast<uint64_t>(std::stod(line.substr(name.size())));
+        }
+      }
+      return nonstd::nullopt;
+    }
+
+    // LoadRunner
+
+    LoadRunner::LoadRunner(LoadOptions options)
+        : options_(std::move(options)), log_(logger::log("LoadRunner")) {
+      for (const auto &target : options_.targets) {
+        stubs_.push_back(protocol::CommandService::NewStub(grpc::CreateChannel(
+            target, grpc::InsecureChannelCredentials())));
+      }
+      listener_ = std::thread(&LoadRunner::listen, this);
+    }
+
+    LoadRunner::~LoadRunner() {
+      {
+        std::lock_guard<std::mutex> lock(lock_);
+        for (auto call : watching_) {
+          call->context.TryCancel();
+        }
+      }
+      watches_.Shutdown();
+      listener_.join();
+    }
+
+    void LoadRunner::watch(size_t target,
+                           const std::string &hash,
+                           Clock::time_point scheduled) {
+      auto call = new Watch;
+      call->scheduled = scheduled;
+      protocol::TxStatusRequest request;
+      request.set_tx_hash(hash);
+      {
+        std::lock_guard<std::mutex> lock(lock_);
+        watching_.insert(call);
+      }
+      call->reader = stubs_[target]->AsyncStatusStream(
+          &call->context, request, &watches_, call);
+    }
+
+    void LoadRunner::listen() {
+      void *tag;
+      bool ok = false;
+      while (watches_.Next(&tag, &ok)) {
+        auto call = static_cast<Watch *>(tag);
+        if (call->finishing) {
+          {
+            std::lock_guard<std::mutex> lock(lock_);
+            watching_.erase(call);
+          }
+          delete call;
+          continue;
+        }
+        // the first event is the start of stream, later ones are statuses
+        if (ok and call->response.status() == protocol::COMMITTED) {
+          auto latency = std::chrono::duration<double, std::milli>(
+                             Clock::now() - call->scheduled)
+                             .count();
+          std::lock_guard<std::mutex> lock(lock_);
+          latencies_.push_back(latency);
+        }
+        if (ok) {
+          call->reader->Read(&call->response, call);
+        } else {
+          call->finishing = true;
+          call->reader->Finish(&call->status, call);
+        }
+      }
+    }
+
+    LoadReport LoadRunner::run(const LoadPlan &plan) {
+      LoadReport report;
+      const auto &transactions = plan.transactions();
+      if (options_.targets.empty() or transactions.empty()) {
+        return report;
+      }
+
+      std::vector<std::unique_ptr<torii::CommandAsyncClient>> clients;
+      for (const auto &target : options_.targets) {
+        auto address = splitAddress(target);
+        clients.push_back(std::make_unique<torii::CommandAsyncClient>(
+            address.first, address.second, options_.channels));
+      }
+
+      auto counter = [this]() -> nonstd::optional<uint64_t> {
+        if (options_.metrics_address.empty()) {
+          return nonstd::nullopt;
+        }
+        return scrapeCounter(options_.metrics_address,
+                             "iroha_committed_transactions_total");
+      };
+      auto baseline = counter();
+      if (not baseline) {
+        log_->warn("committed transactions are not available from {}",
+                   options_.metrics_address);
+      }
+
+      std::atomic<size_t> accepted{0}, rejected{0}, retry_later{0};
+      auto callback = [&](protocol::ToriiResponse &response) {
+        if (response.retry_later()) {
+          ++retry_later;
+        } else if (response.validation()
+                   == protocol::STATELESS_VALIDATION_SUCCESS) {
+          ++accepted;
+        } else {
+          ++rejected;
+        }
+      };
+
+      const auto &hashes = plan.hashes();
+      const auto interval = std::chrono::duration_cast<Clock::duration>(
+          std::chrono::duration<double>(1 / options_.rate));
+      const auto start = Clock::now();
+      for (size_t i = 0; i < transactions.size(); ++i) {
+        auto scheduled = start + interval * i;
+        std::this_thread::sleep_until(scheduled);
+        auto target = i % clients.size();
+        clients[target]->Torii(transactions[i], callback);
+        if (options_.latency_sample > 0 and i % options_.latency_sample == 0) {
+          watch(target, hashes[i], scheduled);
+        }
+      }
+      auto submitted = Clock::now();
+      report.submitted = transactions.size();
+      report.submit_seconds =
+          std::chrono::duration<double>(submitted - start).count();
+      log_->info("{} transactions submitted in {:.2f} s",
+                 report.submitted,
+                 report.submit_seconds);
+
+      // commits are polled until all accepted transactions are committed,
+      // or nothing is committed for the drain period
+      auto last_commit = start;
+      uint64_t committed = 0;
+      while (baseline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        auto now = Clock::now();
+        auto current = counter();
+        if (current and *current - *baseline > committed) {
+          committed = *current - *baseline;
+          last_commit = now;
+        }
+        auto responded = accepted + rejected + retry_later;
+        if ((responded == transactions.size() and committed >= accepted)
+            or now - std::max(last_commit, submitted) > options_.drain) {
+          break;
+        }
+      }
+      // sampled transactions are given the same time to commit
+      auto deadline = Clock::now() + options_.drain;
+      auto watching = [this] {
+        std::lock_guard<std::mutex> lock(lock_);
+        return not watching_.empty();
+      };
+      while (watching() and Clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      }
+
+      report.accepted = accepted;
+      report.rejected = rejected;
+      report.retry_later = retry_later;
+      report.committed = committed;
+      report.commit_seconds =
+          std::chrono::duration<double>(last_commit - start).count();
+      report.submit_rate = report.submitted / report.submit_seconds;
+      if (report.commit_seconds > 0) {
+        report.commit_rate = report.committed / report.commit_seconds;
+      }
+      std::vector<double> latencies;
+      {
+        std::lock_guard<std::mutex> lock(lock_);
+        latencies = latencies_;
+      }
+      std::sort(latencies.begin(), latencies.end());
+      report.latency_samples = latencies.size();
+      report.p50_ms = percentile(latencies, 0.5);
+      report.p90_ms = percentile(latencies, 0.9);
+      report.p99_ms = percentile(latencies, 0.99);
+      report.max_ms = latencies.empty() ? 0 : latencies.back();
+      return report;
+    }
+
+  }  // namespace load
+}  // namespace iroha
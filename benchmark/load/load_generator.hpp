@@ -0,0 +1,201 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef IROHA_LOAD_GENERATOR_HPP
+#define IROHA_LOAD_GENERATOR_HPP
+
+#include <endpoint.grpc.pb.h>
+#include <grpc++/grpc++.h>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <nonstd/optional.hpp>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include "common/types.hpp"
+#include "logger/logger.hpp"
+#include "model/block.hpp"
+#include "model/peer.hpp"
+
+namespace iroha {
+  namespace load {
+
+    /**
+     * Funded accounts and transfers between them, signed in advance so
+     * that signing does not limit the submission rate. Keys are derived
+     * from account names, so the plan of genesis and the plan of a later
+     * run with the same number of accounts agree
+     */
+    class LoadPlan {
+     public:
+      static const std::string kDomain;
+      static const std::string kAsset;
+
+      /**
+       * @param accounts - number of funded accounts
+       * @param transactions - number of transfers, each account sends
+       * every accounts-th of them to the next account
+       */
+      LoadPlan(size_t accounts, size_t transactions);
+
+      /**
+       * @return id of i-th account
+       */
+      static std::string accountId(size_t i);
+
+      /**
+       * Genesis block adding peers and creating domain, asset and funded
+       * accounts allowed to transfer
+       * @param peers - peers of the network
+       */
+      model::Block genesis(const std::vector<model::Peer> &peers) const;
+
+      /**
+       * Transfers ready to be sent, in order of submission
+       */
+      const std::vector<protocol::Transaction> &transactions() const;
+
+      /**
+       * Hashes of transactions, in the same order
+       */
+      const std::vector<std::string> &hashes() const;
+
+     private:
+      size_t transactions_count_;
+      std::vector<ed25519::keypair_t> keys_;
+      std::vector<protocol::Transaction> transactions_;
+      std::vector<std::string> hashes_;
+    };
+
+    /**
+     * Settings of one run
+     */
+    struct LoadOptions {
+      // Torii addresses, transactions are spread over them round robin
+      std::vector<std::string> targets;
+      // connections to every target
+      size_t channels = 16;
+      // transactions per second, submission does not wait for responses
+      double rate = 1000;
+      // every that many transactions is followed until commit
+      size_t latency_sample = 100;
+      // metrics endpoint of a peer, host:port
+      std::string metrics_address;
+      // time to wait for commits after the last submission
+      std::chrono::seconds drain{30};
+    };
+
+    /**
+     * Outcome of run
+     */
+    struct LoadReport {
+      size_t submitted = 0;
+      // passed stateless validation
+      size_t accepted = 0;
+      size_t rejected = 0;
+      size_t retry_later = 0;
+      size_t committed = 0;
+      double submit_seconds = 0;
+      // from the first submission to the last observed commit
+      double commit_seconds = 0;
+      // achieved submission and commit rates, transactions per second
+      double submit_rate = 0;
+      double commit_rate = 0;
+      // submit-to-commit latency of sampled transactions, milliseconds
+      size_t latency_samples = 0;
+      double p50_ms = 0;
+      double p90_ms = 0;
+      double p99_ms = 0;
+      double max_ms = 0;
+
+      /**
+       * @return report as single-line JSON object
+       */
+      std::string toJson() const;
+    };
+
+    /**
+     * Value of counter without labels from Prometheus text exposition
+     * @param address - host:port of metrics endpoint
+     * @param name - name of counter
+     * @return value, nullopt if endpoint or counter is unavailable
+     */
+    nonstd::optional<uint64_t> scrapeCounter(const std::string &address,
+                                             const std::string &name);
+
+    /**
+     * Open-loop load: transactions are sent at their scheduled times
+     * regardless of responses, and latency is measured from the scheduled
+     * time, so a stalled network is not hidden by a stalled generator.
+     * Commit throughput is read from the committed transactions counter of
+     * a peer, latency from status streams of sampled transactions
+     */
+    class LoadRunner {
+     public:
+      explicit LoadRunner(LoadOptions options);
+
+      /**
+       * Cancel status streams still open
+       */
+      ~LoadRunner();
+
+      LoadRunner(const LoadRunner &) = delete;
+      LoadRunner &operator=(const LoadRunner &) = delete;
+
+      /**
+       * Submit all transactions of plan and wait for their commits
+       */
+      LoadReport run(const LoadPlan &plan);
+
+     private:
+      using Clock = std::chrono::steady_clock;
+
+      /**
+       * Status stream of sampled transaction
+       */
+      struct Watch {
+        Clock::time_point scheduled;
+        grpc::ClientContext context;
+        protocol::TxStatusResponse response;
+        std::unique_ptr<grpc::ClientAsyncReader<protocol::TxStatusResponse>>
+            reader;
+        grpc::Status status;
+        bool finishing = false;
+      };
+
+      void watch(size_t target,
+                 const std::string &hash,
+                 Clock::time_point scheduled);
+      void listen();
+
+      LoadOptions options_;
+      std::vector<std::unique_ptr<protocol::CommandService::Stub>> stubs_;
+      grpc::CompletionQueue watches_;
+      std::thread listener_;
+
+      std::mutex lock_;
+      std::unordered_set<Watch *> watching_;
+      std::vector<double> latencies_;
+
+      logger::Logger log_;
+    };
+
+  }  // namespace load
+}  // namespace iroha
+
+#endif  // IROHA_LOAD_GENERATOR_HPP
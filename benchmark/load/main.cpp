@@ -0,0 +1,181 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gflags/gflags.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include "load/load_generator.hpp"
+#include "main/application.hpp"
+#include "main/raw_block_insertion.hpp"
+#include "model/converters/json_block_factory.hpp"
+#include "model/converters/json_common.hpp"
+
+/**
+ * Load generator measuring transactions per second of a network.
+ *
+ * Multi-container network: write genesis for peers, start them with it,
+ * then run load against their Torii addresses
+ *   iroha_load --peers=192.168.10.2:10001,... --genesis_out=genesis.json
+ *   iroha_load --targets=192.168.10.2:50051,... --metrics=192.168.10.2:9100
+ * Single node started in this process on embedded storage:
+ *   iroha_load --in_process
+ * Report is printed to stdout as JSON
+ */
+
+DEFINE_uint64(accounts, 1000, "Number of funded accounts");
+DEFINE_uint64(transactions, 100000, "Number of transfers to submit");
+DEFINE_double(rate, 1000, "Target submission rate, transactions per second");
+DEFINE_uint64(channels, 16, "Connections to every Torii");
+DEFINE_uint64(latency_sample, 100,
+              "Every that many transactions is followed until commit");
+DEFINE_uint64(drain, 30, "Seconds to wait for commits after submission");
+DEFINE_string(targets, "127.0.0.1:50051", "Torii addresses, comma separated");
+DEFINE_string(metrics, "127.0.0.1:9100", "Metrics address of one peer");
+DEFINE_string(peers, "",
+              "Peers of genesis, comma separated address[/hex public key]");
+DEFINE_string(genesis_out, "", "Write genesis block for peers and exit");
+DEFINE_bool(in_process, false, "Run single peer in this process");
+
+namespace {
+  // internal address of the peer started in process
+  const std::string kPeerAddress = "127.0.0.1:10001";
+
+  std::vector<std::string> split(const std::string &list) {
+    std::vector<std::string> items;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+      if (not item.empty()) {
+        items.push_back(item);
+      }
+    }
+    return items;
+  }
+
+  std::vector<iroha::model::Peer> parsePeers(const std::string &list) {
+    std::vector<iroha::model::Peer> peers;
+    for (const auto &item : split(list)) {
+      iroha::model::Peer peer;
+      auto slash = item.find('/');
+      peer.address = item.substr(0, slash);
+      peer.pubkey.fill(0);
+      if (slash != std::string::npos) {
+        auto key = iroha::hex2bytes(item.substr(slash + 1));
+        std::copy_n(key.begin(),
+                    std::min(key.size(), peer.pubkey.size()),
+                    peer.pubkey.begin());
+      }
+      peers.push_back(peer);
+    }
+    return peers;
+  }
+
+  /**
+   * Start peer with embedded storage in a temporary directory, with the
+   * genesis of plan, serving Torii and metrics on the addresses of flags
+   */
+  std::unique_ptr<Irohad> startPeer(const iroha::load::LoadPlan &plan) {
+    char path[] = "/tmp/iroha_load_XXXXXX";
+    std::string dir = mkdtemp(path);
+    for (auto sub : {"/blocks", "/wsv", "/index"}) {
+      mkdir((dir + sub).c_str(), S_IRWXU);
+    }
+    iroha::ametsuchi::BlockStorageOptions storage_options;
+    storage_options.wsv_backend = iroha::ametsuchi::WsvBackendType::Lmdb;
+    storage_options.wsv_path = dir + "/wsv";
+    storage_options.block_index = iroha::ametsuchi::BlockIndexType::Embedded;
+    storage_options.block_index_path = dir + "/index";
+    ListenOptions listen_options;
+    listen_options.torii_address = split(FLAGS_targets).front();
+    listen_options.metrics_address = FLAGS_metrics;
+
+    auto irohad = std::make_unique<Irohad>(dir + "/blocks",
+                                           "",
+                                           0,
+                                           "",
+                                           0,
+                                           0,
+                                           storage_options,
+                                           iroha::consensus::yac::YacOptions(),
+                                           iroha::network::OrderingOptions(),
+                                           iroha::network::ChannelOptions(),
+                                           listen_options);
+    if (not irohad->storage) {
+      return nullptr;
+    }
+    iroha::main::BlockInserter inserter(irohad->storage, false);
+    inserter.applyToLedger(
+        {plan.genesis({{kPeerAddress, iroha::ed25519::pubkey_t{}}})});
+    return irohad;
+  }
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  auto log = logger::log("LOAD");
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  gflags::ShutDownCommandLineFlags();
+  if (FLAGS_accounts == 0 or FLAGS_rate <= 0) {
+    log->error("accounts and rate must be positive");
+    return EXIT_FAILURE;
+  }
+
+  log->info("signing {} transactions of {} accounts",
+            FLAGS_transactions,
+            FLAGS_accounts);
+  iroha::load::LoadPlan plan(FLAGS_accounts, FLAGS_transactions);
+
+  if (not FLAGS_genesis_out.empty()) {
+    auto genesis = plan.genesis(parsePeers(FLAGS_peers));
+    std::ofstream file(FLAGS_genesis_out);
+    file << iroha::model::converters::jsonToString(
+        iroha::model::converters::JsonBlockFactory().serialize(genesis));
+    log->info("genesis written to {}", FLAGS_genesis_out);
+    return file ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
+  std::unique_ptr<Irohad> irohad;
+  if (FLAGS_in_process) {
+    irohad = startPeer(plan);
+    if (not irohad) {
+      log->error("peer is not started");
+      return EXIT_FAILURE;
+    }
+    std::thread([&irohad] { irohad->run(); }).detach();
+    // Torii is ready after the peer initializes its services
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+  }
+
+  iroha::load::LoadOptions options;
+  options.targets = split(FLAGS_targets);
+  options.channels = FLAGS_channels;
+  options.rate = FLAGS_rate;
+  options.latency_sample = FLAGS_latency_sample;
+  options.metrics_address = FLAGS_metrics;
+  options.drain = std::chrono::seconds(FLAGS_drain);
+  auto report = iroha::load::LoadRunner(options).run(plan);
+  std::cout << report.toJson() << std::endl;
+
+  if (irohad) {
+    // the peer has no way to stop its loop, its threads end with process
+    std::_Exit(EXIT_SUCCESS);
+  }
+  return EXIT_SUCCESS;
+}
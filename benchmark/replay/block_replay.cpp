@@ -0,0 +1,215 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "replay/block_replay.hpp"
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include "ametsuchi/impl/block_serializer.hpp"
+#include "model/model_crypto_provider_impl.hpp"
+#include "validation/impl/chain_validator_impl.hpp"
+
+namespace iroha {
+  namespace replay {
+
+    namespace {
+      using Clock = std::chrono::steady_clock;
+
+      double since(Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+      }
+
+      // names of commands by kind, in order of model::Commands
+      const char *const kCommandNames[] = {"AddAssetQuantity",
+                                           "AddPeer",
+                                           "AddSignatory",
+                                           "AssignMasterKey",
+                                           "CreateAccount",
+                                           "CreateAsset",
+                                           "CreateDomain",
+                                           "RemoveSignatory",
+                                           "SetAccountPermissions",
+                                           "SetQuorum",
+                                           "TransferAsset",
+                                           "Unknown"};
+      static_assert(sizeof(kCommandNames) / sizeof(kCommandNames[0])
+                        == model::kCommandKinds + 1,
+                    "every kind of command is named");
+
+      // blocks between progress messages
+      const uint32_t kProgressBlocks = 1000;
+    }  // namespace
+
+    // ReplayReport
+
+    std::string ReplayReport::toJson() const {
+      std::stringstream ss;
+      ss << "{\"complete\":" << (complete ? "true" : "false")
+         << ",\"blocks\":" << blocks << ",\"transactions\":" << transactions
+         << ",\"commands\":" << commands << ",\"seconds\":" << seconds
+         << ",\"blocks_per_second\":" << blocks_per_second
+         << ",\"deserialize_seconds\":" << deserialize_seconds
+         << ",\"verify_seconds\":" << verify_seconds
+         << ",\"apply_seconds\":" << apply_seconds
+         << ",\"commit_seconds\":" << commit_seconds << ",\"by_command\":{";
+      auto first = true;
+      for (size_t kind = 0; kind < by_command.size(); ++kind) {
+        const auto &stats = by_command[kind];
+        if (stats.count == 0) {
+          continue;
+        }
+        ss << (first ? "" : ",") << "\"" << kCommandNames[kind]
+           << "\":{\"count\":" << stats.count
+           << ",\"seconds\":" << stats.seconds
+           << ",\"us_per_command\":" << stats.seconds * 1e6 / stats.count
+           << "}";
+        first = false;
+      }
+      ss << "}}";
+      return ss.str();
+    }
+
+    // BlockReplay
+
+    BlockReplay::BlockReplay(const ametsuchi::BlockStorage &source,
+                             std::shared_ptr<ametsuchi::MutableFactory> storage,
+                             ReplayOptions options)
+        : source_(source),
+          storage_(std::move(storage)),
+          options_(options),
+          log_(logger::log("BlockReplay")) {}
+
+    ReplayReport BlockReplay::run() {
+      ReplayReport report;
+      if (source_.first_id() > 1) {
+        log_->error("Blocks before {} are removed, replay needs all blocks",
+                    source_.first_id());
+        return report;
+      }
+      auto last = std::min(options_.to, source_.last_id());
+
+      ametsuchi::BlockSerializer serializer;
+      auto crypto_provider = std::make_shared<model::ModelCryptoProviderImpl>(
+          model::SignatureCheck::Parallel);
+      validation::ChainValidatorImpl validator(crypto_provider);
+      auto execute = [&report](const auto &block,
+                               auto &executor,
+                               auto &query,
+                               const auto &top_hash) {
+        if (block.prev_hash != top_hash) {
+          return false;
+        }
+        for (const auto &tx : block.transactions) {
+          for (const auto &command : tx.commands) {
+            auto start = Clock::now();
+            if (not command->execute(query, executor)) {
+              return false;
+            }
+            auto &stats = report.by_command[std::min(command->kind(),
+                                                     model::kCommandKinds)];
+            ++stats.count;
+            stats.seconds += since(start);
+          }
+        }
+        return true;
+      };
+
+      auto start = Clock::now();
+      std::unique_ptr<ametsuchi::MutableStorage> storage;
+      size_t pending = 0;
+      auto commit = [&] {
+        if (not storage) {
+          return;
+        }
+        auto commit_start = Clock::now();
+        storage_->commit(std::move(storage));
+        report.commit_seconds += since(commit_start);
+        pending = 0;
+      };
+
+      for (uint32_t height = 1; height <= last; ++height) {
+        auto stage = Clock::now();
+        auto bytes = source_.get(height);
+        auto block = bytes
+            ? serializer.deserialize(bytes->data(), bytes->size())
+            : nonstd::nullopt;
+        report.deserialize_seconds += since(stage);
+        if (not block) {
+          log_->error("Block {} is not readable", height);
+          break;
+        }
+
+        if (not storage) {
+          storage = storage_->createMutableStorage();
+        }
+        auto applied = true;
+        if (options_.engine == ReplayEngine::ChainValidator) {
+          stage = Clock::now();
+          applied = validator.validateBlock(*block, *storage);
+          report.apply_seconds += since(stage);
+          for (const auto &tx : block->transactions) {
+            for (const auto &command : tx.commands) {
+              ++report.by_command[std::min(command->kind(),
+                                           model::kCommandKinds)]
+                    .count;
+            }
+          }
+        } else {
+          if (options_.verify_signatures) {
+            stage = Clock::now();
+            applied = crypto_provider->verify(*block);
+            report.verify_seconds += since(stage);
+          }
+          stage = Clock::now();
+          applied = applied and storage->apply(*block, execute);
+          report.apply_seconds += since(stage);
+        }
+        if (not applied) {
+          // blocks of the uncommitted batch are discarded with it
+          log_->error("Block {} is not applied, the last committed is {}",
+                      height,
+                      height - 1 - pending);
+          report.blocks -= pending;
+          storage.reset();
+          break;
+        }
+
+        ++report.blocks;
+        report.transactions += block->transactions.size();
+        if (++pending >= options_.commit_blocks) {
+          commit();
+        }
+        if (height % kProgressBlocks == 0) {
+          log_->info("{} blocks replayed, {:.0f} blocks/s",
+                     height,
+                     height / since(start));
+        }
+      }
+      commit();
+
+      for (const auto &stats : report.by_command) {
+        report.commands += stats.count;
+      }
+      report.complete = report.blocks == last;
+      report.seconds = since(start);
+      report.blocks_per_second =
+          report.seconds > 0 ? report.blocks / report.seconds : 0;
+      return report;
+    }
+
+  }  // namespace replay
+}  // namespace iroha
@@ -0,0 +1,116 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_BLOCK_REPLAY_HPP
+#define IROHA_BLOCK_REPLAY_HPP
+
+#include <array>
+#include <limits>
+#include <memory>
+#include <string>
+#include "ametsuchi/impl/block_storage.hpp"
+#include "ametsuchi/mutable_factory.hpp"
+#include "logger/logger.hpp"
+#include "model/command_list.hpp"
+
+namespace iroha {
+  namespace replay {
+
+    /**
+     * How blocks are applied to world state view
+     */
+    enum class ReplayEngine {
+      // commands are executed directly and timed by type
+      Execute,
+      // blocks go through chain validator as on commit from other peers,
+      // with supermajority and signature checks
+      ChainValidator
+    };
+
+    /**
+     * Settings of one replay
+     */
+    struct ReplayOptions {
+      ReplayEngine engine = ReplayEngine::Execute;
+      // signatures of blocks are verified by execute engine too
+      bool verify_signatures = false;
+      // the last replayed height, the whole source if larger
+      uint32_t to = std::numeric_limits<uint32_t>::max();
+      // blocks applied on one mutable storage and committed together
+      size_t commit_blocks = 1;
+    };
+
+    /**
+     * Execution of one type of command
+     */
+    struct CommandStats {
+      uint64_t count = 0;
+      double seconds = 0;
+    };
+
+    /**
+     * Outcome of replay
+     */
+    struct ReplayReport {
+      // all blocks up to the requested height are applied
+      bool complete = false;
+      uint32_t blocks = 0;
+      uint64_t transactions = 0;
+      uint64_t commands = 0;
+      double seconds = 0;
+      double blocks_per_second = 0;
+      // time spent in stages, the rest is storage work and commits
+      double deserialize_seconds = 0;
+      double verify_seconds = 0;
+      double apply_seconds = 0;
+      double commit_seconds = 0;
+      // by kind of command, the last entry covers unlisted ones
+      std::array<CommandStats, model::kCommandKinds + 1> by_command;
+
+      std::string toJson() const;
+    };
+
+    /**
+     * Replays stored blocks into fresh world state view, so execution can
+     * be profiled on real data and backends compared on the same chain.
+     * Blocks are applied in order from height 1, each is checked to
+     * continue the chain, and replay stops at the first failed block.
+     */
+    class BlockReplay {
+     public:
+      /**
+       * @param source - stored blocks, starting from height 1
+       * @param storage - storage with empty world state view
+       * @param options - settings of replay
+       */
+      BlockReplay(const ametsuchi::BlockStorage &source,
+                  std::shared_ptr<ametsuchi::MutableFactory> storage,
+                  ReplayOptions options);
+
+      ReplayReport run();
+
+     private:
+      const ametsuchi::BlockStorage &source_;
+      std::shared_ptr<ametsuchi::MutableFactory> storage_;
+      ReplayOptions options_;
+      logger::Logger log_;
+    };
+
+  }  // namespace replay
+}  // namespace iroha
+
+#endif  // IROHA_BLOCK_REPLAY_HPP
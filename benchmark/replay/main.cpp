@@ -0,0 +1,129 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gflags/gflags.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include "ametsuchi/impl/flat_file/flat_file.hpp"
+#include "ametsuchi/impl/storage_impl.hpp"
+#include "logger/logger.hpp"
+#include "replay/block_replay.hpp"
+
+/**
+ * Replay of stored blocks into fresh world state view, for profiling of
+ * stateful execution on real data.
+ *
+ * Replay into embedded database in a temporary directory:
+ *   iroha-replay --blocks=/var/iroha/blocks
+ * Replay into empty PostgreSQL database through chain validator:
+ *   iroha-replay --blocks=/var/iroha/blocks --wsv_backend=postgres
+ *     --pg_opt="host=localhost user=iroha" --engine=chain
+ * Report is printed to stdout as JSON
+ */
+
+DEFINE_string(blocks, "", "Directory of flat file block storage to replay");
+DEFINE_string(block_store, "",
+              "Existing empty directory of replayed blocks, temporary if "
+              "empty");
+DEFINE_string(wsv_backend,
+              "lmdb",
+              "World state view backend, lmdb or postgres");
+DEFINE_string(wsv_path, "",
+              "Existing empty directory of embedded world state view, "
+              "temporary if empty");
+DEFINE_string(pg_opt, "", "Connection to empty PostgreSQL database");
+DEFINE_string(engine, "execute",
+              "execute to time commands by type, chain to apply blocks "
+              "through chain validator");
+DEFINE_bool(verify_signatures, false,
+            "Verify signatures of blocks with execute engine");
+DEFINE_uint64(to, 0, "The last replayed height, 0 for all blocks");
+DEFINE_uint64(commit_blocks, 1, "Blocks committed together");
+DEFINE_bool(defer_wsv_writes, false,
+            "Write account assets of block with multi-row statements");
+DEFINE_bool(state_root, false, "Maintain state root of world state view");
+
+namespace {
+  /**
+   * @return path if given, otherwise a new temporary directory
+   */
+  std::string directoryOr(const std::string &path, const char *name) {
+    if (not path.empty()) {
+      return path;
+    }
+    std::string pattern = std::string("/tmp/iroha_replay_") + name + "_XXXXXX";
+    return mkdtemp(&pattern[0]);
+  }
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  auto log = logger::log("REPLAY");
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  gflags::ShutDownCommandLineFlags();
+
+  auto source = iroha::ametsuchi::FlatFile::create(FLAGS_blocks);
+  if (not source or source->last_id() == 0) {
+    log->error("No blocks are found in {}", FLAGS_blocks);
+    return EXIT_FAILURE;
+  }
+
+  iroha::ametsuchi::BlockStorageOptions storage_options;
+  storage_options.block_index = iroha::ametsuchi::BlockIndexType::None;
+  storage_options.defer_wsv_writes = FLAGS_defer_wsv_writes;
+  storage_options.state_root = FLAGS_state_root;
+  storage_options.warm_up_blocks = 0;
+  if (FLAGS_wsv_backend == "lmdb") {
+    storage_options.wsv_backend = iroha::ametsuchi::WsvBackendType::Lmdb;
+    storage_options.wsv_path = directoryOr(FLAGS_wsv_path, "wsv");
+  } else if (FLAGS_wsv_backend == "postgres") {
+    storage_options.wsv_backend = iroha::ametsuchi::WsvBackendType::Postgres;
+  } else {
+    log->error("Unknown world state view backend {}", FLAGS_wsv_backend);
+    return EXIT_FAILURE;
+  }
+
+  iroha::replay::ReplayOptions options;
+  if (FLAGS_engine == "chain") {
+    options.engine = iroha::replay::ReplayEngine::ChainValidator;
+  } else if (FLAGS_engine != "execute") {
+    log->error("Unknown engine {}", FLAGS_engine);
+    return EXIT_FAILURE;
+  }
+  options.verify_signatures = FLAGS_verify_signatures;
+  if (FLAGS_to != 0) {
+    options.to = static_cast<uint32_t>(FLAGS_to);
+  }
+  options.commit_blocks = std::max<uint64_t>(FLAGS_commit_blocks, 1);
+
+  auto storage = iroha::ametsuchi::StorageImpl::create(
+      directoryOr(FLAGS_block_store, "blocks"),
+      "",
+      0,
+      FLAGS_pg_opt,
+      storage_options);
+  if (not storage) {
+    log->error("Storage for replay is not created");
+    return EXIT_FAILURE;
+  }
+
+  log->info("Replaying {} blocks of {}", source->last_id(), FLAGS_blocks);
+  auto report = iroha::replay::BlockReplay(*source, storage, options).run();
+  std::cout << report.toJson() << std::endl;
+  return report.complete ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,291 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <vector>
+#include "ametsuchi/impl/kv/key_value_wsv_backend.hpp"
+#include "ametsuchi/impl/temporary_wsv_impl.hpp"
+#include "consensus/yac/storage/yac_vote_storage.hpp"
+#include "crypto/crypto.hpp"
+#include "model/commands/add_asset_quantity.hpp"
+#include "model/commands/create_account.hpp"
+#include "model/commands/create_asset.hpp"
+#include "model/commands/create_domain.hpp"
+#include "model/commands/set_permissions.hpp"
+#include "model/commands/transfer_asset.hpp"
+#include "model/converters/json_block_factory.hpp"
+#include "model/converters/json_common.hpp"
+#include "model/converters/pb_transaction_factory.hpp"
+#include "model/model_crypto_provider_impl.hpp"
+#include "model/model_hash_provider_impl.hpp"
+#include "module/irohad/ametsuchi/memory_store.hpp"
+#include "validation/impl/stateful_validator_impl.hpp"
+#include "validation/impl/stateless_validator_impl.hpp"
+
+/**
+ * Stages of transaction pipeline in isolation, with transfers signed by
+ * real keys: conversion from protobuf, stateless validation, hashing of
+ * proposal, stateful validation against world state view in memory, vote
+ * storage of YAC and JSON codec of blocks. Hashes of transactions and
+ * blocks are measured by crypto_benchmark
+ */
+
+using namespace iroha;
+
+namespace {
+  const size_t kAccounts = 100;
+
+  std::string accountId(size_t i) {
+    return "user" + std::to_string(i) + "@bench";
+  }
+
+  std::vector<ed25519::keypair_t> makeKeys(size_t count) {
+    std::vector<ed25519::keypair_t> keys;
+    for (size_t i = 0; i < count; ++i) {
+      keys.push_back(create_keypair(create_seed()));
+    }
+    return keys;
+  }
+
+  model::Signature signHash(const hash256_t &hash,
+                            const ed25519::keypair_t &keys) {
+    model::Signature signature;
+    signature.pubkey = keys.pubkey;
+    signature.signature =
+        sign(hash.data(), hash.size(), keys.pubkey, keys.privkey);
+    return signature;
+  }
+
+  /**
+   * Transfers between accounts of given keys, as created by Torii clients
+   */
+  std::vector<model::Transaction> makeTransfers(
+      size_t count, const std::vector<ed25519::keypair_t> &keys) {
+    model::HashProviderImpl hash_provider;
+    auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::system_clock::now().time_since_epoch())
+                   .count();
+    std::vector<model::Transaction> txs;
+    for (size_t i = 0; i < count; ++i) {
+      auto sender = i % keys.size();
+      auto transfer = std::make_shared<model::TransferAsset>();
+      transfer->src_account_id = accountId(sender);
+      transfer->dest_account_id = accountId((sender + 1) % keys.size());
+      transfer->asset_id = "coin#bench";
+      transfer->amount = Amount(1, 0);
+      model::Transaction tx;
+      tx.creator_account_id = transfer->src_account_id;
+      tx.created_ts = now;
+      tx.tx_counter = i;
+      tx.commands.push_back(transfer);
+      auto hash = hash_provider.get_hash(tx);
+      tx.signatures.push_back(signHash(hash, keys[sender]));
+      tx.tx_hash = hash;
+      txs.push_back(tx);
+    }
+    return txs;
+  }
+
+  model::Block makeBlock(std::vector<model::Transaction> txs) {
+    model::HashProviderImpl hash_provider;
+    model::Block block;
+    block.height = 2;
+    block.transactions = std::move(txs);
+    block.txs_number = block.transactions.size();
+    block.merkle_root = hash_provider.get_merkle_root(block.transactions);
+    block.hash = hash_provider.get_hash(block);
+    block.sigs.push_back(signHash(block.hash, makeKeys(1).front()));
+    return block;
+  }
+
+  /**
+   * World state view in memory with funded accounts of given keys
+   */
+  std::unique_ptr<ametsuchi::WsvBackend> makeWsv(
+      const std::vector<ed25519::keypair_t> &keys) {
+    std::vector<std::shared_ptr<model::Command>> commands;
+    auto domain = std::make_shared<model::CreateDomain>();
+    domain->domain_name = "bench";
+    commands.push_back(domain);
+    auto asset = std::make_shared<model::CreateAsset>();
+    asset->asset_name = "coin";
+    asset->domain_id = "bench";
+    asset->precision = 2;
+    commands.push_back(asset);
+    model::Account::Permissions permissions;
+    permissions.can_transfer = true;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      auto account = std::make_shared<model::CreateAccount>();
+      account->account_name = "user" + std::to_string(i);
+      account->domain_id = "bench";
+      account->pubkey = keys[i].pubkey;
+      commands.push_back(account);
+      auto allow = std::make_shared<model::SetAccountPermissions>();
+      allow->account_id = accountId(i);
+      allow->new_permissions = permissions;
+      commands.push_back(allow);
+      auto issue = std::make_shared<model::AddAssetQuantity>();
+      issue->account_id = accountId(i);
+      issue->asset_id = "coin#bench";
+      issue->amount = Amount(1000000, 0);
+      commands.push_back(issue);
+    }
+
+    auto backend = std::make_unique<ametsuchi::KeyValueWsvBackend>(
+        std::make_unique<ametsuchi::MemoryStore>());
+    auto transaction = backend->begin();
+    auto query = transaction->query();
+    auto command = transaction->command();
+    for (const auto &c : commands) {
+      c->execute(*query, *command);
+    }
+    transaction->commit();
+    return std::move(backend);
+  }
+}  // namespace
+
+/**
+ * Argument: signatures per transaction
+ */
+static void BM_PbTransactionDeserialize(benchmark::State &state) {
+  auto keys = makeKeys(kAccounts);
+  auto tx = makeTransfers(1, keys).front();
+  for (auto &key : makeKeys(state.range(0) - 1)) {
+    tx.signatures.push_back(signHash(tx.tx_hash, key));
+  }
+  model::converters::PbTransactionFactory factory;
+  auto pb_tx = factory.serialize(tx);
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(factory.deserialize(pb_tx));
+  }
+  state.SetBytesProcessed(state.iterations() * pb_tx.ByteSize());
+}
+BENCHMARK(BM_PbTransactionDeserialize)->Arg(1)->Arg(5);
+
+static void BM_StatelessValidation(benchmark::State &state) {
+  auto txs = makeTransfers(1024, makeKeys(kAccounts));
+  // every transaction is checked once by Torii, so nothing is cached
+  validation::StatelessValidatorImpl validator(
+      std::make_shared<model::ModelCryptoProviderImpl>(
+          model::SignatureCheck::Serial));
+  size_t i = 0;
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(validator.validate(txs[i++ % txs.size()]));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StatelessValidation);
+
+/**
+ * Argument: transactions in proposal
+ */
+static void BM_ProposalHash(benchmark::State &state) {
+  model::Proposal proposal(makeTransfers(state.range(0), makeKeys(kAccounts)));
+  model::HashProviderImpl hash_provider;
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(hash_provider.get_hash(proposal));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ProposalHash)->Arg(10)->Arg(100)->Arg(1000);
+
+/**
+ * Arguments: transactions in proposal, concurrency, speculative execution
+ */
+static void BM_StatefulValidation(benchmark::State &state) {
+  auto keys = makeKeys(kAccounts);
+  auto backend = makeWsv(keys);
+  model::Proposal proposal(makeTransfers(state.range(0), keys));
+  validation::StatefulValidatorImpl validator(state.range(1), state.range(2));
+  while (state.KeepRunning()) {
+    // temporary wsv of every round starts from committed state
+    state.PauseTiming();
+    ametsuchi::TemporaryWsvImpl wsv(backend->begin());
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(validator.validate(proposal, wsv));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+static void statefulArguments(benchmark::internal::Benchmark *benchmark) {
+  for (auto transactions : {100, 1000}) {
+    benchmark->Args({transactions, 1, 0});
+    for (auto concurrency : {4, 8}) {
+      for (auto speculative : {0, 1}) {
+        benchmark->Args({transactions, concurrency, speculative});
+      }
+    }
+  }
+}
+BENCHMARK(BM_StatefulValidation)
+    ->Apply(statefulArguments)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+/**
+ * Argument: peers, every one votes for the same hash
+ */
+static void BM_YacStoreVotes(benchmark::State &state) {
+  using namespace consensus::yac;
+  const auto peers = static_cast<uint64_t>(state.range(0));
+  YacHash hash(create_seed(), create_seed());
+  std::vector<VoteMessage> votes;
+  for (const auto &key : makeKeys(peers)) {
+    VoteMessage vote;
+    vote.hash = hash;
+    vote.signature.pubkey = key.pubkey;
+    votes.push_back(vote);
+  }
+  while (state.KeepRunning()) {
+    YacVoteStorage storage;
+    for (const auto &vote : votes) {
+      benchmark::DoNotOptimize(storage.storeVote(vote, peers));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * peers);
+}
+BENCHMARK(BM_YacStoreVotes)->Arg(4)->Arg(16)->Arg(64)->Arg(256);
+
+/**
+ * Argument: transactions in block
+ */
+static void BM_JsonBlockSerialize(benchmark::State &state) {
+  auto block = makeBlock(makeTransfers(state.range(0), makeKeys(kAccounts)));
+  model::converters::JsonBlockFactory factory;
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(
+        model::converters::jsonToString(factory.serialize(block)));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_JsonBlockSerialize)->Arg(10)->Arg(100)->Arg(1000);
+
+/**
+ * Argument: transactions in block
+ */
+static void BM_JsonBlockDeserialize(benchmark::State &state) {
+  auto block = makeBlock(makeTransfers(state.range(0), makeKeys(kAccounts)));
+  model::converters::JsonBlockFactory factory;
+  auto json = model::converters::jsonToString(factory.serialize(block));
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(factory.deserialize(
+        reinterpret_cast<const uint8_t *>(json.data()), json.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+BENCHMARK(BM_JsonBlockDeserialize)->Arg(10)->Arg(100)->Arg(1000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,18 @@
+find_path(jemalloc_INCLUDE_DIR jemalloc/jemalloc.h)
+mark_as_advanced(jemalloc_INCLUDE_DIR)
+
+find_library(jemalloc_LIBRARY jemalloc)
+mark_as_advanced(jemalloc_LIBRARY)
+
+find_package(PackageHandleStandardArgs REQUIRED)
+find_package_handle_standard_args(jemalloc
+  REQUIRED_VARS jemalloc_INCLUDE_DIR jemalloc_LIBRARY
+  )
+
+if (jemalloc_FOUND)
+  add_library(jemalloc UNKNOWN IMPORTED)
+  set_target_properties(jemalloc PROPERTIES
+    INTERFACE_INCLUDE_DIRECTORIES ${jemalloc_INCLUDE_DIR}
+    IMPORTED_LOCATION ${jemalloc_LIBRARY}
+    )
+endif ()
@@ -0,0 +1,18 @@
+find_path(mimalloc_INCLUDE_DIR mimalloc.h)
+mark_as_advanced(mimalloc_INCLUDE_DIR)
+
+find_library(mimalloc_LIBRARY mimalloc)
+mark_as_advanced(mimalloc_LIBRARY)
+
+find_package(PackageHandleStandardArgs REQUIRED)
+find_package_handle_standard_args(mimalloc
+  REQUIRED_VARS mimalloc_INCLUDE_DIR mimalloc_LIBRARY
+  )
+
+if (mimalloc_FOUND)
+  add_library(mimalloc UNKNOWN IMPORTED)
+  set_target_properties(mimalloc PROPERTIES
+    INTERFACE_INCLUDE_DIRECTORIES ${mimalloc_INCLUDE_DIR}
+    IMPORTED_LOCATION ${mimalloc_LIBRARY}
+    )
+endif ()
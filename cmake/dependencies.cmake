@@ -476,4 +476,63 @@ include(cmake/Modules/TBBGet.cmake)
 include(cmake/Modules/TBBBuild.cmake)
 tbb_get(TBB_ROOT tbb_root SOURCE_CODE SAVE_TO ${EP_PREFIX})
 tbb_build(TBB_ROOT ${tbb_root} CONFIG_DIR TBB_DIR)
-find_package(TBB REQUIRED)
\ No newline at end of file
+find_package(TBB REQUIRED)
+##########################
+#          zstd          #
+##########################
+ExternalProject_Add(facebook_zstd
+    GIT_REPOSITORY "https://github.com/facebook/zstd.git"
+    GIT_TAG "v1.3.1"
+    BUILD_IN_SOURCE 1
+    BUILD_COMMAND $(MAKE) -C lib libzstd.a CFLAGS=-fPIC
+    CONFIGURE_COMMAND "" # remove configure step
+    INSTALL_COMMAND "" # remove install step
+    TEST_COMMAND "" # remove test step
+    UPDATE_COMMAND "" # remove update step
+    )
+ExternalProject_Get_Property(facebook_zstd source_dir)
+set(zstd_SOURCE_DIR "${source_dir}")
+
+add_library(zstd STATIC IMPORTED)
+file(MAKE_DIRECTORY ${zstd_SOURCE_DIR}/lib/dictBuilder)
+set_target_properties(zstd PROPERTIES
+    INTERFACE_INCLUDE_DIRECTORIES
+    "${zstd_SOURCE_DIR}/lib;${zstd_SOURCE_DIR}/lib/dictBuilder"
+    IMPORTED_LOCATION ${zstd_SOURCE_DIR}/lib/libzstd.a
+    )
+add_dependencies(zstd facebook_zstd)
+
+##########################
+#          lmdb          #
+##########################
+ExternalProject_Add(lmdb_lmdb
+    GIT_REPOSITORY "https://github.com/LMDB/lmdb.git"
+    GIT_TAG "LMDB_0.9.21"
+    BUILD_IN_SOURCE 1
+    BUILD_COMMAND $(MAKE) -C libraries/liblmdb liblmdb.a XCFLAGS=-fPIC
+    CONFIGURE_COMMAND "" # remove configure step
+    INSTALL_COMMAND "" # remove install step
+    TEST_COMMAND "" # remove test step
+    UPDATE_COMMAND "" # remove update step
+    )
+ExternalProject_Get_Property(lmdb_lmdb source_dir)
+set(lmdb_SOURCE_DIR "${source_dir}/libraries/liblmdb")
+
+add_library(lmdb STATIC IMPORTED)
+file(MAKE_DIRECTORY ${lmdb_SOURCE_DIR})
+set_target_properties(lmdb PROPERTIES
+    INTERFACE_INCLUDE_DIRECTORIES ${lmdb_SOURCE_DIR}
+    IMPORTED_LOCATION ${lmdb_SOURCE_DIR}/liblmdb.a
+    INTERFACE_LINK_LIBRARIES "pthread"
+    )
+add_dependencies(lmdb lmdb_lmdb)
+
+##########################
+#       allocator        #
+##########################
+# system allocator needs no library, others replace malloc of binaries
+if (ALLOCATOR STREQUAL "jemalloc")
+  find_package(jemalloc REQUIRED)
+elseif (ALLOCATOR STREQUAL "mimalloc")
+  find_package(mimalloc REQUIRED)
+endif ()
@@ -34,7 +34,8 @@ endfunction()
 # Creates benchmark "bench_name", with "SOURCES" (use string as second argument)
 function(addbenchmark bench_name SOURCES)
   add_executable(${bench_name} ${SOURCES})
-  target_link_libraries(${bench_name} PRIVATE benchmark)
+  # benchmarks run with allocator of irohad, so its effect is measured
+  target_link_libraries(${bench_name} PRIVATE benchmark allocator)
   strictmode(${bench_name})
 endfunction()
 
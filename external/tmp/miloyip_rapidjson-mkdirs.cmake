@@ -0,0 +1,22 @@
+# Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+# file Copyright.txt or https://cmake.org/licensing for details.
+
+cmake_minimum_required(VERSION 3.5)
+
+file(MAKE_DIRECTORY
+  "/root/repo/external/src/miloyip_rapidjson"
+  "/root/repo/external/src/miloyip_rapidjson-build"
+  "/root/repo/external"
+  "/root/repo/external/tmp"
+  "/root/repo/external/src/miloyip_rapidjson-stamp"
+  "/root/repo/external/src"
+  "/root/repo/external/src/miloyip_rapidjson-stamp"
+)
+
+set(configSubDirs )
+foreach(subDir IN LISTS configSubDirs)
+    file(MAKE_DIRECTORY "/root/repo/external/src/miloyip_rapidjson-stamp/${subDir}")
+endforeach()
+if(cfgdir)
+  file(MAKE_DIRECTORY "/root/repo/external/src/miloyip_rapidjson-stamp${cfgdir}") # cfgdir has leading slash
+endif()
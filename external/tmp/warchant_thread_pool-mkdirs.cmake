@@ -0,0 +1,22 @@
+# Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+# file Copyright.txt or https://cmake.org/licensing for details.
+
+cmake_minimum_required(VERSION 3.5)
+
+file(MAKE_DIRECTORY
+  "/root/repo/external/src/warchant_thread_pool"
+  "/root/repo/external/src/warchant_thread_pool-build"
+  "/root/repo/external"
+  "/root/repo/external/tmp"
+  "/root/repo/external/src/warchant_thread_pool-stamp"
+  "/root/repo/external/src"
+  "/root/repo/external/src/warchant_thread_pool-stamp"
+)
+
+set(configSubDirs )
+foreach(subDir IN LISTS configSubDirs)
+    file(MAKE_DIRECTORY "/root/repo/external/src/warchant_thread_pool-stamp/${subDir}")
+endforeach()
+if(cfgdir)
+  file(MAKE_DIRECTORY "/root/repo/external/src/warchant_thread_pool-stamp${cfgdir}") # cfgdir has leading slash
+endif()
@@ -0,0 +1,60 @@
+#include "stdint.h"
+#include "stddef.h"
+
+#include <algorithm>
+#include <vector>
+#include "consensus/yac/storage/yac_block_storage.hpp"
+#include "fuzz_budget.hpp"
+#include "yac.pb.h"
+
+using namespace iroha::consensus::yac;
+
+// same checks as vote parsing of network, inputs failing them never
+// reach the storage
+static bool parseVote(const proto::Vote &pb_vote, VoteMessage &vote) {
+  const auto &pb_hash = pb_vote.hash();
+  const auto &pb_signature = pb_vote.signature();
+  auto hash = YacHash::fromBytes(pb_hash.proposal(), pb_hash.block());
+  if (not hash
+      or pb_signature.pubkey().size() != iroha::ed25519::pubkey_t::size()
+      or pb_signature.signature().size() != iroha::ed25519::sig_t::size()) {
+    return false;
+  }
+  vote.hash = *hash;
+  std::copy(pb_signature.signature().begin(),
+            pb_signature.signature().end(),
+            vote.signature.signature.begin());
+  std::copy(pb_signature.pubkey().begin(),
+            pb_signature.pubkey().end(),
+            vote.signature.pubkey.begin());
+  return true;
+}
+
+// Votes of commit are inserted one by one and then as commit, into
+// storage of the first vote's hash, relay fanout sets size of round
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  fuzz::InputBudget budget(size);
+  proto::Commit pb_commit;
+  if (not pb_commit.ParseFromArray(data, size)) {
+    return 0;
+  }
+  std::vector<VoteMessage> votes;
+  for (const auto &pb_vote : pb_commit.votes()) {
+    VoteMessage vote;
+    if (parseVote(pb_vote, vote)) {
+      votes.push_back(vote);
+    }
+  }
+  if (votes.empty()) {
+    return 0;
+  }
+  YacBlockStorage storage(votes.front().hash,
+                          pb_commit.relay().fanout() % 1024 + 1);
+  for (const auto &vote : votes) {
+    storage.insert(vote);
+  }
+  storage.insert(CommitMessage(votes));
+  storage.getState();
+  storage.memoryUsage();
+  return 0;
+}
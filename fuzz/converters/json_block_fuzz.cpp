@@ -0,0 +1,12 @@
+#include "stdint.h"
+#include "stddef.h"
+
+#include "fuzz_budget.hpp"
+#include "model/converters/json_block_factory.hpp"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  static iroha::model::converters::JsonBlockFactory factory;
+  fuzz::InputBudget budget(size);
+  factory.deserialize(data, size);
+  return 0;
+}
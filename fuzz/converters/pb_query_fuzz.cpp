@@ -0,0 +1,16 @@
+#include "stdint.h"
+#include "stddef.h"
+
+#include "fuzz_budget.hpp"
+#include "model/converters/pb_query_factory.hpp"
+#include "queries.pb.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  static iroha::model::converters::PbQueryFactory factory;
+  fuzz::InputBudget budget(size);
+  iroha::protocol::Query pb_query;
+  if (pb_query.ParseFromArray(data, size)) {
+    factory.deserialize(pb_query);
+  }
+  return 0;
+}
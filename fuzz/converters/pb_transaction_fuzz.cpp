@@ -0,0 +1,16 @@
+#include "stdint.h"
+#include "stddef.h"
+
+#include "block.pb.h"
+#include "fuzz_budget.hpp"
+#include "model/converters/pb_transaction_factory.hpp"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  static iroha::model::converters::PbTransactionFactory factory;
+  fuzz::InputBudget budget(size);
+  iroha::protocol::Transaction pb_tx;
+  if (pb_tx.ParseFromArray(data, size)) {
+    factory.deserialize(pb_tx);
+  }
+  return 0;
+}
@@ -0,0 +1,116 @@
+#!/usr/bin/env bash
+#
+# Maintenance of seed corpora of fuzzers, binaries are in fuzz_bin of
+# the build directory, corpora in CORPUS (fuzz/corpus by default).
+#
+#   corpus.sh seed                  encode checked-in seeds of fuzz/seeds
+#   corpus.sh harvest BLOCK_STORE   add blocks and transactions of a ledger
+#   corpus.sh merge FUZZ_BIN        minimize corpora, keeping coverage
+#   corpus.sh run FUZZ_BIN NAME [SECONDS]
+#                                   fuzz with per-input time and memory
+#                                   limits, slow inputs abort as findings
+#
+# Harvest expects block_store_converter in PATH and a flat file block
+# store, e.g. copied from a peer of a test network.
+
+set -euo pipefail
+
+FUZZ_DIR=$(cd "$(dirname "$0")" && pwd)
+SCHEMA=${FUZZ_DIR}/../schema
+CORPUS=${CORPUS:-${FUZZ_DIR}/corpus}
+FUZZERS="pb_transaction_fuzz pb_query_fuzz json_block_fuzz
+  yac_block_storage_fuzz"
+
+# per-input limits of libFuzzer, on top of budgets of fuzz_budget.hpp
+TIMEOUT=${TIMEOUT:-2}
+RSS_LIMIT_MB=${RSS_LIMIT_MB:-2048}
+MALLOC_LIMIT_MB=${MALLOC_LIMIT_MB:-256}
+
+# encode FILE TYPE PROTO - write binary message of text format FILE
+encode() {
+  protoc -I"${SCHEMA}" --encode="$2" "${SCHEMA}/$3" < "$1"
+}
+
+seed() {
+  for name in ${FUZZERS}; do
+    mkdir -p "${CORPUS}/${name}"
+  done
+  for file in "${FUZZ_DIR}"/seeds/pb_transaction_fuzz/*.textproto; do
+    encode "${file}" iroha.protocol.Transaction block.proto \
+      > "${CORPUS}/pb_transaction_fuzz/$(basename "${file}" .textproto)"
+  done
+  for file in "${FUZZ_DIR}"/seeds/pb_query_fuzz/*.textproto; do
+    encode "${file}" iroha.protocol.Query queries.proto \
+      > "${CORPUS}/pb_query_fuzz/$(basename "${file}" .textproto)"
+  done
+  for file in "${FUZZ_DIR}"/seeds/yac_block_storage_fuzz/*.textproto; do
+    encode "${file}" iroha.consensus.yac.proto.Commit yac.proto \
+      > "${CORPUS}/yac_block_storage_fuzz/$(basename "${file}" .textproto)"
+  done
+  cp "${FUZZ_DIR}"/seeds/json_block_fuzz/*.json "${CORPUS}/json_block_fuzz/"
+}
+
+harvest() {
+  local store=$1
+  local tmp
+  tmp=$(mktemp -d)
+  trap 'rm -rf "${tmp}"' EXIT
+  mkdir -p "${CORPUS}/json_block_fuzz" "${CORPUS}/pb_transaction_fuzz"
+
+  block_store_converter --from="${store}" --to="${tmp}/json" --format=json
+  for block in "${tmp}"/json/*; do
+    cp "${block}" "${CORPUS}/json_block_fuzz/block_$(basename "${block}")"
+  done
+
+  # transactions are cut out of text format of protobuf blocks, where
+  # each of them is a top level "transactions" message of body
+  block_store_converter --from="${store}" --to="${tmp}/pb" --format=protobuf
+  for block in "${tmp}"/pb/*; do
+    local id
+    id=$(basename "${block}")
+    # skip the format tag and version of serialized block
+    tail -c +9 "${block}" \
+      | protoc -I"${SCHEMA}" --decode=iroha.protocol.Block \
+          "${SCHEMA}/block.proto" \
+      | awk -v out="${tmp}/tx_${id}_" '
+          /^  transactions {$/ { file = out (n++); next }
+          /^  }$/ { file = ""; next }
+          file != "" { print > file }'
+  done
+  for tx in "${tmp}"/tx_*; do
+    [ -e "${tx}" ] || continue
+    encode "${tx}" iroha.protocol.Transaction block.proto \
+      > "${CORPUS}/pb_transaction_fuzz/$(basename "${tx}")"
+  done
+}
+
+merge() {
+  local bin=$1
+  for name in ${FUZZERS}; do
+    local merged="${CORPUS}/${name}.merged"
+    mkdir -p "${merged}"
+    "${bin}/${name}" -merge=1 -timeout="${TIMEOUT}" \
+      -rss_limit_mb="${RSS_LIMIT_MB}" "${merged}" "${CORPUS}/${name}"
+    rm -rf "${CORPUS:?}/${name}"
+    mv "${merged}" "${CORPUS}/${name}"
+  done
+}
+
+run() {
+  local bin=$1 name=$2 seconds=${3:-600}
+  mkdir -p "${CORPUS}/${name}" "${CORPUS}/${name}.findings"
+  "${bin}/${name}" -max_total_time="${seconds}" -timeout="${TIMEOUT}" \
+    -rss_limit_mb="${RSS_LIMIT_MB}" -malloc_limit_mb="${MALLOC_LIMIT_MB}" \
+    -artifact_prefix="${CORPUS}/${name}.findings/" -print_final_stats=1 \
+    "${CORPUS}/${name}"
+}
+
+command=${1:-}
+shift || true
+case "${command}" in
+  seed) seed ;;
+  harvest) harvest "$@" ;;
+  merge) merge "$@" ;;
+  run) run "$@" ;;
+  *) sed -n '3,13p' "$0"; exit 1 ;;
+esac
@@ -0,0 +1,102 @@
+#ifndef IROHA_FUZZ_BUDGET_HPP
+#define IROHA_FUZZ_BUDGET_HPP
+
+#include <sanitizer/allocator_interface.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+/**
+ * Per-input budget of time and allocated bytes, both scaled linearly by
+ * size of input. Input which exceeds the budget aborts the run, so
+ * quadratic and otherwise slow cases are reported and minimized by
+ * libFuzzer like crashes.
+ *
+ * Budget is configured by environment:
+ *   IROHA_FUZZ_BASE_US, IROHA_FUZZ_US_PER_BYTE - time in microseconds
+ *   IROHA_FUZZ_BASE_BYTES, IROHA_FUZZ_BYTES_PER_BYTE - allocated bytes
+ * Zero base disables the corresponding check.
+ */
+namespace fuzz {
+
+  namespace detail {
+    inline size_t envOr(const char *name, size_t fallback) {
+      auto value = std::getenv(name);
+      return value ? std::strtoull(value, nullptr, 10) : fallback;
+    }
+
+    inline std::atomic<size_t> &allocated() {
+      static std::atomic<size_t> bytes{0};
+      return bytes;
+    }
+
+    inline void onMalloc(const volatile void *, size_t size) {
+      allocated().fetch_add(size, std::memory_order_relaxed);
+    }
+
+    inline void onFree(const volatile void *) {}
+
+    struct Limits {
+      size_t base_us = envOr("IROHA_FUZZ_BASE_US", 20000);
+      size_t us_per_byte = envOr("IROHA_FUZZ_US_PER_BYTE", 20);
+      size_t base_bytes = envOr("IROHA_FUZZ_BASE_BYTES", 1 << 20);
+      size_t bytes_per_byte = envOr("IROHA_FUZZ_BYTES_PER_BYTE", 256);
+    };
+
+    inline const Limits &limits() {
+      static const Limits limits;
+      static const int installed =
+          __sanitizer_install_malloc_and_free_hooks(onMalloc, onFree);
+      (void)installed;
+      return limits;
+    }
+  }  // namespace detail
+
+  /**
+   * Guard of one input, checks the budget on destruction
+   */
+  class InputBudget {
+   public:
+    explicit InputBudget(size_t size)
+        : size_(size), start_(std::chrono::steady_clock::now()) {
+      detail::limits();
+      detail::allocated().store(0, std::memory_order_relaxed);
+    }
+
+    ~InputBudget() {
+      const auto &limits = detail::limits();
+      auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+                         std::chrono::steady_clock::now() - start_)
+                         .count();
+      auto time_limit = limits.base_us + limits.us_per_byte * size_;
+      if (limits.base_us != 0 and size_t(elapsed) > time_limit) {
+        std::fprintf(stderr,
+                     "==budget== input of %zu bytes took %lld us, "
+                     "limit %zu us\n",
+                     size_,
+                     static_cast<long long>(elapsed),
+                     time_limit);
+        std::abort();
+      }
+      auto bytes = detail::allocated().load(std::memory_order_relaxed);
+      auto bytes_limit = limits.base_bytes + limits.bytes_per_byte * size_;
+      if (limits.base_bytes != 0 and bytes > bytes_limit) {
+        std::fprintf(stderr,
+                     "==budget== input of %zu bytes allocated %zu bytes, "
+                     "limit %zu bytes\n",
+                     size_,
+                     bytes,
+                     bytes_limit);
+        std::abort();
+      }
+    }
+
+   private:
+    size_t size_;
+    std::chrono::steady_clock::time_point start_;
+  };
+
+}  // namespace fuzz
+
+#endif  // IROHA_FUZZ_BUDGET_HPP
@@ -128,6 +128,7 @@ namespace iroha_cli {
 
     // block hash should be calculated after all members are assigned.
     auto hash_provider = iroha::model::HashProviderImpl();
+    block.merkle_root = hash_provider.get_merkle_root(block.transactions);
     block.hash = hash_provider.get_hash(block);
 
     return block;
@@ -160,6 +161,7 @@ namespace iroha_cli {
     ret.txs_number = ret.transactions.size();
 
     iroha::model::HashProviderImpl hash_provider;
+    ret.merkle_root = hash_provider.get_merkle_root(ret.transactions);
     ret.hash = hash_provider.get_hash(ret);
     return ret;
   }
@@ -0,0 +1,274 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bulk_submitter.hpp"
+#include <algorithm>
+#include <thread>
+#include <utility>
+#include "model/converters/json_common.hpp"
+#include "model/converters/json_transaction_factory.hpp"
+#include "model/converters/pb_transaction_factory.hpp"
+#include "model/model_hash_provider_impl.hpp"
+
+namespace iroha_cli {
+
+  namespace {
+    /**
+     * Parse and sign json transactions of range [begin, end) with one
+     * round trip to the key
+     */
+    void signRange(
+        const std::vector<std::string> &json_txs,
+        size_t begin,
+        size_t end,
+        iroha::Signer *signer,
+        std::vector<nonstd::optional<iroha::protocol::Transaction>> &result) {
+      iroha::model::converters::JsonTransactionFactory serializer;
+      iroha::model::HashProviderImpl hash_provider;
+      std::vector<iroha::model::Transaction> txs;
+      std::vector<size_t> indices;
+      std::vector<iroha::Signer::Message> hashes;
+      for (auto i = begin; i < end; ++i) {
+        auto doc = iroha::model::converters::stringToJson(json_txs[i]);
+        if (not doc.has_value()) {
+          continue;
+        }
+        auto tx = serializer.deserialize(doc.value());
+        if (not tx.has_value()) {
+          continue;
+        }
+        if (signer) {
+          auto hash = hash_provider.get_hash(tx.value());
+          hashes.emplace_back(hash.begin(), hash.end());
+        }
+        txs.push_back(std::move(tx.value()));
+        indices.push_back(i);
+      }
+
+      if (signer) {
+        auto signatures = signer->signBatch(hashes);
+        auto pubkey = signer->publicKey();
+        for (size_t k = 0; k < txs.size(); ++k) {
+          txs[k].signatures.push_back({signatures[k], pubkey});
+        }
+      }
+
+      iroha::model::converters::PbTransactionFactory factory;
+      for (size_t k = 0; k < txs.size(); ++k) {
+        result[indices[k]] = factory.serialize(txs[k]);
+      }
+    }
+
+    /**
+     * @return value at quantile q of sorted values
+     */
+    double percentile(const std::vector<double> &sorted, double q) {
+      if (sorted.empty()) {
+        return 0;
+      }
+      auto index = static_cast<size_t>(q * (sorted.size() - 1));
+      return sorted[index];
+    }
+  }  // namespace
+
+  BulkSubmitter::BulkSubmitter(const std::string &target_ip,
+                               int port,
+                               std::shared_ptr<iroha::Signer> signer,
+                               BulkOptions options)
+      : signer_(std::move(signer)),
+        options_(std::move(options)),
+        log_(logger::log("BulkSubmitter")),
+        client_(target_ip, port, options_.channels) {}
+
+  std::vector<nonstd::optional<iroha::protocol::Transaction>>
+  BulkSubmitter::sign(const std::vector<std::string> &json_txs) const {
+    std::vector<nonstd::optional<iroha::protocol::Transaction>> result(
+        json_txs.size());
+    if (json_txs.empty()) {
+      return result;
+    }
+    // every thread takes a contiguous share of transactions
+    auto threads = std::max<size_t>(
+        std::min(options_.signing_threads, json_txs.size()), 1);
+    auto share = (json_txs.size() + threads - 1) / threads;
+    std::vector<std::thread> workers;
+    for (size_t begin = 0; begin < json_txs.size(); begin += share) {
+      auto end = std::min(begin + share, json_txs.size());
+      workers.emplace_back([this, &json_txs, &result, begin, end] {
+        signRange(json_txs, begin, end, signer_.get(), result);
+      });
+    }
+    for (auto &worker : workers) {
+      worker.join();
+    }
+    return result;
+  }
+
+  BulkReport BulkSubmitter::submit(std::istream &input) {
+    start_ = last_progress_ = next_send_ = Clock::now();
+    std::vector<std::string> lines;
+    auto flush = [this, &lines] {
+      for (auto &tx : sign(lines)) {
+        sendDue();
+        if (not tx.has_value()) {
+          std::lock_guard<std::mutex> lock(mutex_);
+          ++report_.wrong_format;
+          continue;
+        }
+        send(std::make_shared<const iroha::protocol::Transaction>(
+                 std::move(tx.value())),
+             0);
+        reportProgress();
+      }
+      lines.clear();
+    };
+    for (std::string line; std::getline(input, line);) {
+      if (line.empty()) {
+        continue;
+      }
+      lines.push_back(std::move(line));
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++report_.read;
+      }
+      if (lines.size() >= options_.chunk_size) {
+        flush();
+      }
+    }
+    flush();
+
+    // retries are sent until no transaction is in flight or waiting
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (in_flight_ != 0 or not retries_.empty()) {
+      auto wake = Clock::now() + options_.progress;
+      if (not retries_.empty()) {
+        wake = std::min(wake, retries_.begin()->first);
+      }
+      responded_.wait_until(lock, wake);
+      lock.unlock();
+      sendDue();
+      reportProgress();
+      lock.lock();
+    }
+
+    report_.seconds =
+        std::chrono::duration<double>(Clock::now() - start_).count();
+    std::sort(latencies_.begin(), latencies_.end());
+    report_.p50_ms = percentile(latencies_, 0.5);
+    report_.p99_ms = percentile(latencies_, 0.99);
+    report_.max_ms = latencies_.empty() ? 0 : latencies_.back();
+    log_->info(
+        "{} read, {} accepted, {} rejected, {} wrong format, {} failed, "
+        "{} retried in {:.2f} s, latency p50 {:.1f} ms, p99 {:.1f} ms, "
+        "max {:.1f} ms",
+        report_.read,
+        report_.accepted,
+        report_.rejected,
+        report_.wrong_format,
+        report_.failed,
+        report_.retried,
+        report_.seconds,
+        report_.p50_ms,
+        report_.p99_ms,
+        report_.max_ms);
+    return report_;
+  }
+
+  void BulkSubmitter::send(
+      std::shared_ptr<const iroha::protocol::Transaction> transaction,
+      size_t attempt) {
+    if (options_.rate > 0) {
+      // sends are spaced evenly, time lost while signing is not caught up
+      std::this_thread::sleep_until(next_send_);
+      next_send_ = std::max(next_send_, Clock::now())
+          + std::chrono::duration_cast<Clock::duration>(
+                       std::chrono::duration<double>(1 / options_.rate));
+    }
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      responded_.wait(lock, [this] {
+        return in_flight_ < std::max<size_t>(options_.concurrency, 1);
+      });
+      ++in_flight_;
+    }
+
+    auto sent = Clock::now();
+    auto callback = [this, transaction, attempt, sent](
+        const grpc::Status &status,
+        iroha::protocol::ToriiResponse &response) {
+      auto latency =
+          std::chrono::duration<double, std::milli>(Clock::now() - sent)
+              .count();
+      std::lock_guard<std::mutex> lock(mutex_);
+      --in_flight_;
+      latencies_.push_back(latency);
+      if (status.ok() and not response.retry_later()) {
+        if (response.validation()
+            == iroha::protocol::STATELESS_VALIDATION_SUCCESS) {
+          ++report_.accepted;
+        } else {
+          ++report_.rejected;
+        }
+      } else if (attempt < options_.retries) {
+        ++report_.retried;
+        retries_.emplace(Clock::now() + options_.backoff * (1 << attempt),
+                         Retry{attempt + 1, transaction});
+      } else {
+        ++report_.failed;
+      }
+      responded_.notify_all();
+    };
+    client_.Torii(*transaction,
+                  torii::CommandAsyncClient::StatusCallback(callback));
+  }
+
+  void BulkSubmitter::sendDue() {
+    while (true) {
+      Retry retry;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (retries_.empty() or retries_.begin()->first > Clock::now()) {
+          return;
+        }
+        retry = std::move(retries_.begin()->second);
+        retries_.erase(retries_.begin());
+      }
+      send(std::move(retry.transaction), retry.attempt);
+    }
+  }
+
+  void BulkSubmitter::reportProgress() {
+    auto now = Clock::now();
+    if (now - last_progress_ < options_.progress) {
+      return;
+    }
+    last_progress_ = now;
+    auto seconds = std::chrono::duration<double>(now - start_).count();
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto responded = report_.accepted + report_.rejected + report_.failed;
+    log_->info(
+        "{} read, {} accepted, {} rejected, {} in flight, {} waiting for "
+        "retry, {:.0f} tx/s",
+        report_.read,
+        report_.accepted,
+        report_.rejected,
+        in_flight_,
+        retries_.size(),
+        responded / seconds);
+  }
+
+}  // namespace iroha_cli
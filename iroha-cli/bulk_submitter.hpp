@@ -0,0 +1,159 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_CLI_BULK_SUBMITTER_HPP
+#define IROHA_CLI_BULK_SUBMITTER_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <istream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <nonstd/optional.hpp>
+#include <string>
+#include <vector>
+#include "crypto/signer.hpp"
+#include "logger/logger.hpp"
+#include "torii/command_client.hpp"
+
+namespace iroha_cli {
+
+  /**
+   * Parameters of bulk submission
+   */
+  struct BulkOptions {
+    // threads parsing and signing transactions
+    size_t signing_threads = 4;
+    // transactions read and signed at once
+    size_t chunk_size = 10000;
+    // transactions submitted per second, unlimited if 0
+    double rate = 1000;
+    // rpcs in flight at once
+    size_t concurrency = 256;
+    // connections to torii
+    size_t channels = 4;
+    // resubmissions of transaction after failed rpc or retry later
+    size_t retries = 5;
+    // delay of the first retry, doubled with every next one
+    std::chrono::milliseconds backoff{100};
+    // period of progress reports
+    std::chrono::milliseconds progress{1000};
+  };
+
+  /**
+   * Outcome of bulk submission
+   */
+  struct BulkReport {
+    size_t read = 0;
+    size_t wrong_format = 0;
+    size_t accepted = 0;
+    size_t rejected = 0;
+    // transactions which have run out of retries
+    size_t failed = 0;
+    size_t retried = 0;
+    double seconds = 0;
+    // latency of torii rpcs
+    double p50_ms = 0;
+    double p99_ms = 0;
+    double max_ms = 0;
+  };
+
+  /**
+   * Submits pre-built transactions to torii in bulk, e.g. for migrations.
+   * Input is read in chunks of newline delimited json transactions, every
+   * chunk is signed by several threads and then submitted over concurrent
+   * async rpcs at limited rate. Transactions answered with retry later or
+   * lost with rpc are resubmitted with exponential backoff.
+   */
+  class BulkSubmitter {
+   public:
+    /**
+     * @param signer - signs transactions, they are sent as is if null
+     */
+    BulkSubmitter(const std::string &target_ip,
+                  int port,
+                  std::shared_ptr<iroha::Signer> signer,
+                  BulkOptions options);
+
+    /**
+     * Parse and sign transactions in parallel
+     * @param json_txs - transactions in json format
+     * @return signed transaction for each of json_txs, nullopt if it is
+     * malformed
+     */
+    std::vector<nonstd::optional<iroha::protocol::Transaction>> sign(
+        const std::vector<std::string> &json_txs) const;
+
+    /**
+     * Submit all transactions of input and wait for their responses
+     * @param input - one json transaction per line, empty lines are skipped
+     * @return counts and latencies of submission
+     */
+    BulkReport submit(std::istream &input);
+
+   private:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Transaction waiting for resubmission
+     */
+    struct Retry {
+      size_t attempt;
+      std::shared_ptr<const iroha::protocol::Transaction> transaction;
+    };
+
+    /**
+     * Send transaction once rate and concurrency allow
+     */
+    void send(std::shared_ptr<const iroha::protocol::Transaction> transaction,
+              size_t attempt);
+
+    /**
+     * Resubmit transactions whose backoff has elapsed
+     */
+    void sendDue();
+
+    /**
+     * Log progress if its period has elapsed
+     */
+    void reportProgress();
+
+    std::shared_ptr<iroha::Signer> signer_;
+    BulkOptions options_;
+    logger::Logger log_;
+
+    Clock::time_point start_;
+    Clock::time_point last_progress_;
+    // the earliest time of the next send allowed by rate
+    Clock::time_point next_send_;
+
+    std::mutex mutex_;
+    std::condition_variable responded_;
+    size_t in_flight_ = 0;
+    // retries by time when they are due
+    std::multimap<Clock::time_point, Retry> retries_;
+    std::vector<double> latencies_;
+    BulkReport report_;
+
+    // destroyed first, so its listener does not outlive the state above
+    torii::CommandAsyncClient client_;
+  };
+
+}  // namespace iroha_cli
+
+#endif  // IROHA_CLI_BULK_SUBMITTER_HPP
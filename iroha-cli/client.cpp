@@ -21,39 +21,78 @@
 #include "model/converters/json_common.hpp"
 #include "model/converters/json_transaction_factory.hpp"
 #include "model/converters/pb_transaction_factory.hpp"
+#include "model/model_hash_provider_impl.hpp"
 
 namespace iroha_cli {
 
-  CliClient::CliClient(std::string target_ip, int port)
-      : command_client_(target_ip, port), query_client_(target_ip, port) {}
+  CliClient::CliClient(std::string target_ip,
+                       int port,
+                       std::shared_ptr<iroha::Signer> signer)
+      : command_client_(target_ip, port),
+        query_client_(target_ip, port),
+        signer_(std::move(signer)) {}
 
   CliClient::Response<CliClient::TxStatus> CliClient::sendTx(std::string json_tx) {
-    CliClient::Response<CliClient::TxStatus> response;
+    std::vector<std::string> json_txs;
+    json_txs.push_back(std::move(json_tx));
+    return sendTxs(std::move(json_txs)).front();
+  }
+
+  std::vector<CliClient::Response<CliClient::TxStatus>> CliClient::sendTxs(
+      std::vector<std::string> json_txs) {
+    std::vector<CliClient::Response<CliClient::TxStatus>> responses(
+        json_txs.size());
     iroha::model::converters::JsonTransactionFactory serializer;
-    auto doc = iroha::model::converters::stringToJson(std::move(json_tx));
-    if (not doc.has_value()) {
-      response.status = grpc::Status::OK;
-      response.answer = WRONG_FORMAT;
-      return response;
+    std::vector<nonstd::optional<iroha::model::Transaction>> txs;
+    txs.reserve(json_txs.size());
+    for (auto &json_tx : json_txs) {
+      auto doc = iroha::model::converters::stringToJson(std::move(json_tx));
+      txs.push_back(doc.has_value() ? serializer.deserialize(doc.value())
+                                    : nonstd::nullopt);
     }
-    auto tx_opt = serializer.deserialize(doc.value());
-    if (not tx_opt.has_value()) {
-      response.status = grpc::Status::OK;
-      response.answer = WRONG_FORMAT;
-      return response;
+
+    if (signer_) {
+      // one round trip to the key for all transactions
+      iroha::model::HashProviderImpl hash_provider;
+      std::vector<iroha::Signer::Message> hashes;
+      for (const auto &tx : txs) {
+        if (tx.has_value()) {
+          auto hash = hash_provider.get_hash(tx.value());
+          hashes.emplace_back(hash.begin(), hash.end());
+        }
+      }
+      auto signatures = signer_->signBatch(hashes);
+      auto signature = signatures.begin();
+      for (auto &tx : txs) {
+        if (tx.has_value()) {
+          tx->signatures.push_back({*signature++, signer_->publicKey()});
+        }
+      }
     }
-    auto model_tx = tx_opt.value();
-    // Convert to protobuf
+
     iroha::model::converters::PbTransactionFactory factory;
-    auto pb_tx = factory.serialize(model_tx);
-    // Send to iroha:
-    iroha::protocol::ToriiResponse toriiResponse;
-    response.status = command_client_.Torii(pb_tx, toriiResponse);
-    response.answer = toriiResponse.validation() ==
-                              iroha::protocol::STATELESS_VALIDATION_SUCCESS
-                          ? OK
-                          : NOT_VALID;
-    return response;
+    for (size_t i = 0; i < txs.size(); ++i) {
+      auto &response = responses[i];
+      if (not txs[i].has_value()) {
+        response.status = grpc::Status::OK;
+        response.answer = WRONG_FORMAT;
+        continue;
+      }
+      // Convert to protobuf
+      auto pb_tx = factory.serialize(txs[i].value());
+      // Send to iroha:
+      iroha::protocol::ToriiResponse toriiResponse;
+      response.status = command_client_.Torii(pb_tx, toriiResponse);
+      if (toriiResponse.retry_later()) {
+        response.answer = RETRY_LATER;
+        continue;
+      }
+      response.answer = toriiResponse.validation() ==
+                                iroha::protocol::STATELESS_VALIDATION_SUCCESS
+                            ? OK
+                            : NOT_VALID;
+    }
+    return responses;
   }
 
   CliClient::Response<iroha::protocol::QueryResponse> CliClient::sendQuery(
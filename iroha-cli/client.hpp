@@ -18,8 +18,11 @@
 #ifndef IROHA_CLIENT_HPP
 #define IROHA_CLIENT_HPP
 
+#include <memory>
 #include <string>
 #include <torii_utils/query_client.hpp>
+#include <vector>
+#include "crypto/signer.hpp"
 #include "torii/command_client.hpp"
 
 namespace iroha_cli {
@@ -32,9 +35,15 @@ namespace iroha_cli {
       T answer;
     };
 
-    enum TxStatus { WRONG_FORMAT, NOT_VALID, OK,  };
+    enum TxStatus { WRONG_FORMAT, NOT_VALID, OK, RETRY_LATER };
 
-    CliClient(std::string target_ip, int port);
+    /**
+     * @param signer - signs sent transactions, they are sent as is when
+     * not set
+     */
+    CliClient(std::string target_ip,
+              int port,
+              std::shared_ptr<iroha::Signer> signer = nullptr);
     /**
      * Send transaction to Iroha-Network
      * @param json_tx
@@ -42,11 +51,21 @@ namespace iroha_cli {
      */
     CliClient::Response<CliClient::TxStatus> sendTx(std::string json_tx);
 
+    /**
+     * Send transactions to Iroha-Network, all of them are signed with one
+     * request to signer
+     * @param json_txs
+     * @return response for each transaction
+     */
+    std::vector<CliClient::Response<CliClient::TxStatus>> sendTxs(
+        std::vector<std::string> json_txs);
+
     CliClient::Response<iroha::protocol::QueryResponse> sendQuery(std::string json_query);
 
    private:
     torii::CommandSyncClient command_client_;
     torii_utils::QuerySyncClient query_client_;
+    std::shared_ptr<iroha::Signer> signer_;
   };
 }  // namespace iroha_cli
 
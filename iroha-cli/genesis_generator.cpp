@@ -0,0 +1,159 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "genesis_generator.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <utility>
+#include "model/commands/add_asset_quantity.hpp"
+#include "model/commands/add_peer.hpp"
+#include "model/commands/create_account.hpp"
+#include "model/commands/create_asset.hpp"
+#include "model/commands/create_domain.hpp"
+#include "model/commands/set_permissions.hpp"
+#include "model/model_hash_provider_impl.hpp"
+
+namespace iroha_cli {
+
+  namespace {
+    /**
+     * Name made of prefix and index in base 36, names of accounts are
+     * limited to 7 characters, which covers over two billion indexes
+     */
+    std::string name(char prefix, size_t index) {
+      const char digits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+      std::string suffix;
+      do {
+        suffix.push_back(digits[index % 36]);
+        index /= 36;
+      } while (index != 0);
+      return prefix + std::string(suffix.rbegin(), suffix.rend());
+    }
+
+    uint64_t nowMs() {
+      return std::chrono::duration_cast<std::chrono::milliseconds>(
+                 std::chrono::system_clock::now().time_since_epoch())
+          .count();
+    }
+  }  // namespace
+
+  GenesisGenerator::GenesisGenerator(GenesisOptions options)
+      : options_(std::move(options)) {}
+
+  std::string GenesisGenerator::accountId(size_t i) const {
+    return name('a', i) + "@" + options_.domain;
+  }
+
+  std::string GenesisGenerator::assetId(size_t j) const {
+    return name('c', j) + "#" + options_.domain;
+  }
+
+  iroha::ed25519::keypair_t GenesisGenerator::keypair(size_t i) const {
+    return iroha::create_keypair(
+        iroha::create_seed(options_.seed + accountId(i)));
+  }
+
+  iroha::model::Transaction GenesisGenerator::accountsTransaction(
+      size_t begin, size_t end) const {
+    iroha::model::Transaction tx;
+    iroha::model::Account::Permissions permissions;
+    permissions.can_transfer = true;
+    for (auto i = begin; i < end; ++i) {
+      auto id = accountId(i);
+      auto account = std::make_shared<iroha::model::CreateAccount>();
+      account->account_name = id.substr(0, id.find('@'));
+      account->domain_id = options_.domain;
+      account->pubkey = keypair(i).pubkey;
+      tx.commands.push_back(account);
+      auto allow = std::make_shared<iroha::model::SetAccountPermissions>();
+      allow->account_id = id;
+      allow->new_permissions = permissions;
+      tx.commands.push_back(allow);
+      for (size_t j = 0; j < options_.assets; ++j) {
+        auto issue = std::make_shared<iroha::model::AddAssetQuantity>();
+        issue->account_id = id;
+        issue->asset_id = assetId(j);
+        issue->amount = iroha::Amount(options_.balance, 0);
+        tx.commands.push_back(issue);
+      }
+    }
+    return tx;
+  }
+
+  iroha::model::Block GenesisGenerator::generate(
+      const std::vector<iroha::model::Peer> &peers) const {
+    auto created = nowMs();
+    iroha::model::Transaction setup;
+    for (const auto &peer : peers) {
+      auto add_peer = std::make_shared<iroha::model::AddPeer>();
+      add_peer->address = peer.address;
+      add_peer->peer_key = peer.pubkey;
+      setup.commands.push_back(add_peer);
+    }
+    auto domain = std::make_shared<iroha::model::CreateDomain>();
+    domain->domain_name = options_.domain;
+    setup.commands.push_back(domain);
+    for (size_t j = 0; j < options_.assets; ++j) {
+      auto id = assetId(j);
+      auto asset = std::make_shared<iroha::model::CreateAsset>();
+      asset->asset_name = id.substr(0, id.find('#'));
+      asset->domain_id = options_.domain;
+      asset->precision = options_.precision;
+      setup.commands.push_back(asset);
+    }
+
+    // ranges of accounts are taken by threads in turn, transactions keep
+    // the order of accounts
+    auto per_tx = std::max<size_t>(options_.accounts_per_transaction, 1);
+    auto ranges = (options_.accounts + per_tx - 1) / per_tx;
+    std::vector<iroha::model::Transaction> txs(ranges + 1);
+    txs.front() = std::move(setup);
+    std::atomic<size_t> next{0};
+    auto work = [&] {
+      for (size_t range; (range = next++) < ranges;) {
+        auto begin = range * per_tx;
+        txs[range + 1] = accountsTransaction(
+            begin, std::min(begin + per_tx, options_.accounts));
+      }
+    };
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < std::max<size_t>(options_.threads, 1); ++i) {
+      workers.emplace_back(work);
+    }
+    work();
+    for (auto &worker : workers) {
+      worker.join();
+    }
+
+    iroha::model::Block block;
+    for (auto &tx : txs) {
+      tx.created_ts = created;
+      block.transactions.push_back(std::move(tx));
+    }
+    block.height = 1;
+    block.prev_hash.fill(0);
+    block.txs_number = block.transactions.size();
+    block.created_ts = created;
+    iroha::model::HashProviderImpl hash_provider;
+    block.merkle_root = hash_provider.get_merkle_root(block.transactions);
+    block.hash = hash_provider.get_hash(block);
+    return block;
+  }
+
+}  // namespace iroha_cli
@@ -0,0 +1,97 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_CLI_GENESIS_GENERATOR_HPP
+#define IROHA_CLI_GENESIS_GENERATOR_HPP
+
+#include <string>
+#include <vector>
+#include "crypto/crypto.hpp"
+#include "model/block.hpp"
+#include "model/peer.hpp"
+
+namespace iroha_cli {
+
+  /**
+   * Parameters of generated genesis block
+   */
+  struct GenesisOptions {
+    size_t accounts = 1000;
+    size_t assets = 1;
+    std::string domain = "test";
+    // initial balance of every account in every asset, in whole units
+    uint64_t balance = 1000;
+    uint8_t precision = 2;
+    // secret from which keys of accounts are derived
+    std::string seed = "genesis";
+    // threads generating keys and commands
+    size_t threads = 4;
+    // accounts created by one transaction of the block
+    size_t accounts_per_transaction = 1000;
+  };
+
+  /**
+   * Generator of large genesis blocks for test and staging networks.
+   * Accounts are funded in every asset and allowed to transfer. Keys of
+   * accounts are derived from the seed and account id, so they are not
+   * stored anywhere and can be recreated by clients; such ledgers must
+   * not hold real value.
+   * Transactions of accounts are generated in parallel, the block is
+   * meant to be written in binary format and inserted with bulk load.
+   */
+  class GenesisGenerator {
+   public:
+    explicit GenesisGenerator(GenesisOptions options);
+
+    /**
+     * @return id of i-th account
+     */
+    std::string accountId(size_t i) const;
+
+    /**
+     * @return id of j-th asset
+     */
+    std::string assetId(size_t j) const;
+
+    /**
+     * @return key pair of i-th account
+     */
+    iroha::ed25519::keypair_t keypair(size_t i) const;
+
+    /**
+     * Generate genesis block. The first transaction adds peers and creates
+     * domain and assets, every next one creates and funds a range of
+     * accounts
+     * @param peers - peers of the network
+     * @return block at height 1 with merkle root and hash set
+     */
+    iroha::model::Block generate(
+        const std::vector<iroha::model::Peer> &peers) const;
+
+   private:
+    /**
+     * Transaction creating and funding accounts of range [begin, end)
+     */
+    iroha::model::Transaction accountsTransaction(size_t begin,
+                                                  size_t end) const;
+
+    GenesisOptions options_;
+  };
+
+}  // namespace iroha_cli
+
+#endif  // IROHA_CLI_GENESIS_GENERATOR_HPP
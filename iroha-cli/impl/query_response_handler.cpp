@@ -16,6 +16,7 @@
  */
 
 #include "query_response_handler.hpp"
+#include "common/types.hpp"
 
 using namespace iroha::protocol;
 namespace iroha_cli {
@@ -28,10 +29,22 @@ namespace iroha_cli {
         &QueryResponseHandler::handleAccountResponse;
     handler_map_[QueryResponse::ResponseCase::kAccountAssetsResponse] =
         &QueryResponseHandler::handleAccountAssetsResponse;
+    handler_map_[QueryResponse::ResponseCase::kAccountAssetListResponse] =
+        &QueryResponseHandler::handleAccountAssetListResponse;
+    handler_map_[QueryResponse::ResponseCase::kAssetHoldersResponse] =
+        &QueryResponseHandler::handleAssetHoldersResponse;
+    handler_map_[QueryResponse::ResponseCase::kAccountsResponse] =
+        &QueryResponseHandler::handleAccountsResponse;
+    handler_map_[QueryResponse::ResponseCase::kAccountIdsResponse] =
+        &QueryResponseHandler::handleAccountIdsResponse;
     handler_map_[QueryResponse::ResponseCase::kSignatoriesResponse] =
         &QueryResponseHandler::handleSignatoriesResponse;
     handler_map_[QueryResponse::ResponseCase::kTransactionsResponse] =
         &QueryResponseHandler::handleTransactionsResponse;
+    handler_map_[QueryResponse::ResponseCase::kStateRootResponse] =
+        &QueryResponseHandler::handleStateRootResponse;
+    handler_map_[QueryResponse::ResponseCase::kBatchResponse] =
+        &QueryResponseHandler::handleBatchResponse;
 
     // Error responses:
     error_handler_map_[ErrorResponse::STATEFUL_INVALID] =
@@ -86,6 +99,57 @@ namespace iroha_cli {
     log_->info("-Balance- {}", acc_assets.balance());
   }
 
+  void QueryResponseHandler::handleAccountAssetListResponse(
+      const iroha::protocol::QueryResponse &response) {
+    const auto &list = response.account_asset_list_response();
+    log_->info("[Account Assets]");
+    for (const auto &asset : list.account_assets()) {
+      log_->info("-Asset Id- {} -Balance- {}", asset.asset_id(),
+                 asset.balance());
+    }
+    if (not list.next_asset_id().empty()) {
+      log_->info("-Next page after- {}", list.next_asset_id());
+    }
+  }
+
+  void QueryResponseHandler::handleAssetHoldersResponse(
+      const iroha::protocol::QueryResponse &response) {
+    const auto &holders = response.asset_holders_response();
+    log_->info("[Asset Holders]");
+    for (const auto &asset : holders.account_assets()) {
+      log_->info("-Account Id- {} -Balance- {}", asset.account_id(),
+                 asset.balance());
+    }
+    if (not holders.next_account_id().empty()) {
+      log_->info("-Next page after- {}", holders.next_account_id());
+    }
+  }
+
+  void QueryResponseHandler::handleAccountsResponse(
+      const iroha::protocol::QueryResponse &response) {
+    const auto &accounts = response.accounts_response();
+    log_->info("[Accounts]");
+    for (const auto &account : accounts.accounts()) {
+      log_->info("-Id:- {} -Quorum- {}", account.account_id(),
+                 account.quorum());
+    }
+    if (not accounts.next_account_id().empty()) {
+      log_->info("-Next page after- {}", accounts.next_account_id());
+    }
+  }
+
+  void QueryResponseHandler::handleAccountIdsResponse(
+      const iroha::protocol::QueryResponse &response) {
+    const auto &ids = response.account_ids_response();
+    log_->info("[Accounts]");
+    for (const auto &account_id : ids.account_ids()) {
+      log_->info("-Id:- {}", account_id);
+    }
+    if (not ids.next_account_id().empty()) {
+      log_->info("-Next page after- {}", ids.next_account_id());
+    }
+  }
+
   void QueryResponseHandler::handleSignatoriesResponse(
       const iroha::protocol::QueryResponse &response) {
     auto signatories = response.signatories_response().keys();
@@ -95,6 +159,14 @@ namespace iroha_cli {
         [this](auto signatory) { log_->info("-Signatory- {}", signatory); });
   }
 
+  void QueryResponseHandler::handleStateRootResponse(
+      const iroha::protocol::QueryResponse &response) {
+    const auto &root = response.state_root_response();
+    log_->info("[State root]");
+    log_->info("-Height- {}", root.height());
+    log_->info("-Root- {}", iroha::bytestringToHexstring(root.root()));
+  }
+
   void QueryResponseHandler::handleTransactionsResponse(
       const iroha::protocol::QueryResponse &response) {
     auto txs = response.transactions_response().transactions();
@@ -106,4 +178,13 @@ namespace iroha_cli {
     });
   }
 
+  void QueryResponseHandler::handleBatchResponse(
+      const iroha::protocol::QueryResponse &response) {
+    const auto &responses = response.batch_response().responses();
+    log_->info("[Batch] {} responses", responses.size());
+    for (const auto &nested : responses) {
+      handle(nested);
+    }
+  }
+
 }  // namespace iroha_cli
@@ -31,6 +31,9 @@ namespace iroha_cli {
       case iroha_cli::CliClient::NOT_VALID:
         log_->error("Transaction is not valid");
         break;
+      case iroha_cli::CliClient::RETRY_LATER:
+        log_->warn("Network is overloaded, send transaction again later");
+        break;
     }
   }
   TransactionResponseHandler::TransactionResponseHandler()
@@ -17,11 +17,18 @@
 
 #include <gflags/gflags.h>
 #include <responses.pb.h>
+#include <algorithm>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
+#include <sstream>
+#include <thread>
 #include "bootstrap_network.hpp"
+#include "bulk_submitter.hpp"
+#include "ametsuchi/impl/block_serializer.hpp"
 #include "common/assert_config.hpp"
 #include "genesis_block_client_impl.hpp"
+#include "genesis_generator.hpp"
 #include "validators.hpp"
 
 #include "client.hpp"
@@ -39,6 +46,17 @@ DEFINE_string(config, "", "Trusted peer's ip addresses");
 DEFINE_string(genesis_block, "", "Genesis block for sending network");
 // DEFINE_validator(genesis_block, &iroha_cli::validate_genesis_block);
 
+DEFINE_string(generate_genesis,
+              "",
+              "Write generated genesis block in binary format to file");
+DEFINE_uint64(genesis_accounts, 1000, "Accounts of generated genesis block");
+DEFINE_uint64(genesis_assets, 1, "Assets held by every generated account");
+DEFINE_string(genesis_domain, "test", "Domain of generated accounts");
+DEFINE_uint64(genesis_balance, 1000, "Initial balance of generated accounts");
+DEFINE_string(genesis_seed,
+              "genesis",
+              "Secret from which keys of generated accounts are derived");
+
 DEFINE_bool(new_account, false, "Choose if account does not exist");
 DEFINE_string(name, "", "Name of the account");
 DEFINE_string(pass_phrase, "", "Name of the account");
@@ -48,8 +66,35 @@ DEFINE_bool(grpc, false, "Send sample transaction to IrohaNetwork");
 DEFINE_string(address, "0.0.0.0", "Address of the Iroha node");
 DEFINE_int32(torii_port, 50051, "Port of iroha's Torii");
 DEFINE_validator(torii_port, &iroha_cli::validate_port);
-DEFINE_string(json_transaction, "", "Transaction in json format");
+DEFINE_string(json_transaction,
+              "",
+              "Transactions in json format, comma separated files");
 DEFINE_string(json_query, "", "Query in json format");
+DEFINE_string(bulk_transactions,
+              "",
+              "File of json transactions, one per line, submitted in bulk");
+DEFINE_double(bulk_rate,
+              1000,
+              "Transactions submitted per second in bulk, 0 for unlimited");
+DEFINE_uint64(bulk_concurrency, 256, "Rpcs in flight at once in bulk");
+DEFINE_uint64(bulk_retries,
+              5,
+              "Resubmissions of transaction answered with retry later");
+DEFINE_uint64(bulk_signing_threads,
+              0,
+              "Threads signing transactions in bulk, 0 for number of cores");
+DEFINE_uint64(signer_pipeline_depth,
+              0,
+              "Batches waited for at once by remote signer, 0 for local keys");
+
+/**
+ * @return content of file
+ */
+std::string read_file(const std::string &path) {
+  std::ifstream file(path);
+  return std::string((std::istreambuf_iterator<char>(file)),
+                     std::istreambuf_iterator<char>());
+}
 
 using namespace iroha::protocol;
 
@@ -66,6 +111,35 @@ int main(int argc, char* argv[]) {
       logger->info(
           "Public and private key has been generated in current directory");
     };
+  } else if (not FLAGS_generate_genesis.empty()) {
+    // trusted peers are added by the block if they are given
+    std::vector<iroha::model::Peer> peers;
+    if (not FLAGS_config.empty()) {
+      iroha_cli::GenesisBlockClientImpl genesis_block_client;
+      peers = iroha_cli::BootstrapNetwork(genesis_block_client)
+                  .parse_trusted_peers(FLAGS_config);
+    }
+    iroha_cli::GenesisOptions options;
+    options.accounts = FLAGS_genesis_accounts;
+    options.assets = FLAGS_genesis_assets;
+    options.domain = FLAGS_genesis_domain;
+    options.balance = FLAGS_genesis_balance;
+    options.seed = FLAGS_genesis_seed;
+    options.threads = std::max(std::thread::hardware_concurrency(), 1u);
+    auto block = iroha_cli::GenesisGenerator(options).generate(peers);
+    auto bytes = iroha::ametsuchi::BlockSerializer().serialize(block);
+    std::ofstream file(FLAGS_generate_genesis, std::ios::binary);
+    file.write(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+    if (not file) {
+      logger->error("Genesis block is not written to {}",
+                    FLAGS_generate_genesis);
+      return EXIT_FAILURE;
+    }
+    logger->info(
+        "Genesis block with {} accounts is written to {}, insert it with "
+        "irohad --bulk_load",
+        options.accounts,
+        FLAGS_generate_genesis);
   } else if (not FLAGS_config.empty() && not FLAGS_genesis_block.empty()) {
     iroha_cli::GenesisBlockClientImpl genesis_block_client;
     auto bootstrap = iroha_cli::BootstrapNetwork(genesis_block_client);
@@ -74,22 +148,64 @@ int main(int argc, char* argv[]) {
     block = bootstrap.merge_tx_add_trusted_peers(block, peers);
     bootstrap.run_network(peers, block);
   } else if (FLAGS_grpc) {
-    iroha_cli::CliClient client(FLAGS_address, FLAGS_torii_port);
+    // transactions are signed with keys of account given by name
+    std::shared_ptr<iroha::Signer> signer;
+    if (not FLAGS_name.empty()) {
+      auto keypair = iroha_cli::KeysManagerImpl(FLAGS_name).loadKeys();
+      if (not keypair) {
+        logger->error("Keys of {} are not found", FLAGS_name);
+        return EXIT_FAILURE;
+      }
+      signer = std::make_shared<iroha::KeypairSigner>(*keypair);
+      if (FLAGS_signer_pipeline_depth > 0) {
+        signer = std::make_shared<iroha::BatchingSigner>(
+            signer,
+            iroha::BatchingSigner::kDefaultBatchSize,
+            FLAGS_signer_pipeline_depth);
+      }
+    }
+    iroha_cli::CliClient client(FLAGS_address, FLAGS_torii_port, signer);
     iroha_cli::GrpcResponseHandler response_handler;
     if (not FLAGS_json_transaction.empty()) {
       logger->info("Send transaction to {}:{} ", FLAGS_address,
                    FLAGS_torii_port);
-      std::ifstream file(FLAGS_json_transaction);
-      std::string str((std::istreambuf_iterator<char>(file)),
-                      std::istreambuf_iterator<char>());
-      response_handler.handle(client.sendTx(str));
+      std::vector<std::string> txs;
+      std::stringstream paths(FLAGS_json_transaction);
+      std::string path;
+      while (std::getline(paths, path, ',')) {
+        txs.push_back(read_file(path));
+      }
+      for (const auto &response : client.sendTxs(std::move(txs))) {
+        response_handler.handle(response);
+      }
     }
     if (not FLAGS_json_query.empty()) {
       logger->info("Send query to {}:{}", FLAGS_address, FLAGS_torii_port);
-      std::ifstream file(FLAGS_json_query);
-      std::string str((std::istreambuf_iterator<char>(file)),
-                      std::istreambuf_iterator<char>());
-      response_handler.handle(client.sendQuery(str));
+      response_handler.handle(client.sendQuery(read_file(FLAGS_json_query)));
+    }
+    if (not FLAGS_bulk_transactions.empty()) {
+      std::ifstream input(FLAGS_bulk_transactions);
+      if (not input) {
+        logger->error("Can not open {}", FLAGS_bulk_transactions);
+        return EXIT_FAILURE;
+      }
+      logger->info("Send transactions of {} to {}:{}",
+                   FLAGS_bulk_transactions,
+                   FLAGS_address,
+                   FLAGS_torii_port);
+      iroha_cli::BulkOptions options;
+      options.rate = FLAGS_bulk_rate;
+      options.concurrency = FLAGS_bulk_concurrency;
+      options.retries = FLAGS_bulk_retries;
+      options.signing_threads = FLAGS_bulk_signing_threads != 0
+          ? FLAGS_bulk_signing_threads
+          : std::max(std::thread::hardware_concurrency(), 1u);
+      iroha_cli::BulkSubmitter submitter(
+          FLAGS_address, FLAGS_torii_port, signer, options);
+      auto report = submitter.submit(input);
+      if (report.wrong_format != 0 or report.failed != 0) {
+        return EXIT_FAILURE;
+      }
     }
 
   } else {
@@ -40,10 +40,20 @@ namespace iroha_cli {
     void handleAccountResponse(const iroha::protocol::QueryResponse& response);
     void handleAccountAssetsResponse(
         const iroha::protocol::QueryResponse& response);
+    void handleAccountAssetListResponse(
+        const iroha::protocol::QueryResponse& response);
+    void handleAssetHoldersResponse(
+        const iroha::protocol::QueryResponse& response);
+    void handleAccountsResponse(const iroha::protocol::QueryResponse& response);
+    void handleAccountIdsResponse(
+        const iroha::protocol::QueryResponse& response);
     void handleTransactionsResponse(
         const iroha::protocol::QueryResponse& response);
     void handleSignatoriesResponse(
         const iroha::protocol::QueryResponse& response);
+    void handleStateRootResponse(
+        const iroha::protocol::QueryResponse& response);
+    void handleBatchResponse(const iroha::protocol::QueryResponse& response);
     // -- --
     using Handler =
         void (QueryResponseHandler::*)(const iroha::protocol::QueryResponse&);
@@ -19,12 +19,39 @@
 #define IROHA_BLOCK_QUERY_HPP
 
 #include <model/block.hpp>
+#include <model/inclusion_proof.hpp>
+#include <model/queries/get_transactions.hpp>
 #include <model/transaction.hpp>
+#include <nonstd/optional.hpp>
 #include <rxcpp/rx-observable.hpp>
+#include "block.pb.h"
+#include "responses.pb.h"
 
 namespace iroha {
 
   namespace ametsuchi {
+
+    /**
+     * Transaction with its place in the chain
+     */
+    struct CommittedTransaction {
+      model::Transaction transaction;
+      // height of the block which contains the transaction
+      uint32_t height;
+      // index of the transaction in its block
+      uint32_t index;
+    };
+
+    /**
+     * Root of world state view with the height it is taken at
+     */
+    struct CommittedStateRoot {
+      // height of the last block applied to the state
+      uint32_t height;
+      // root of the state, see StateRoot
+      hash256_t root;
+    };
+
     /**
      * Public interface for queries on blocks and transactions
      */
@@ -39,6 +66,45 @@ namespace iroha {
       virtual rxcpp::observable<model::Transaction> getAccountTransactions(
           std::string account_id) = 0;
 
+      /**
+       * Get page of transactions of an account
+       * @param account_id - account identifier
+       * @param pagination - requested page
+       * @return observable of transactions with their positions
+       */
+      virtual rxcpp::observable<CommittedTransaction> getAccountTransactions(
+          std::string account_id, const model::TxPagination &pagination) = 0;
+
+      /**
+       * Get page of transactions changing asset of an account
+       * @param account_id - account identifier
+       * @param asset_id - asset identifier
+       * @param pagination - requested page
+       * @return observable of transactions with their positions
+       */
+      virtual rxcpp::observable<CommittedTransaction>
+      getAccountAssetTransactions(std::string account_id,
+                                  std::string asset_id,
+                                  const model::TxPagination &pagination) = 0;
+
+      /**
+       * Get page of transactions transferring asset within blocks
+       * [from, to], planned over the columns of transactions when they
+       * cover the range, and by scanning blocks otherwise
+       * @param asset_id - asset identifier
+       * @param from - first block
+       * @param to - last block, 0 for the top block
+       * @param min_amount - transfers of smaller amount are skipped
+       * @param pagination - requested page
+       * @return observable of transactions with their positions
+       */
+      virtual rxcpp::observable<CommittedTransaction> getAssetTransfers(
+          std::string asset_id,
+          uint32_t from,
+          uint32_t to,
+          Amount min_amount,
+          const model::TxPagination &pagination) = 0;
+
       /**
       * Get all blocks with having id in range [from, to].
       * @param from - starting id
@@ -47,6 +113,65 @@ namespace iroha {
       */
       virtual rxcpp::observable<model::Block> getBlocks(uint32_t from,
                                                         uint32_t to) = 0;
+
+      /**
+       * Get blocks with id in range [from, to] in wire format. Blocks
+       * stored as protobuf are parsed from storage as is, without
+       * conversion to model and back, so they are sent to peers cheaply.
+       * @param from - starting id
+       * @param to - ending id
+       * @return observable of protobuf blocks
+       */
+      virtual rxcpp::observable<protocol::Block> getWireBlocks(
+          uint32_t from, uint32_t to) = 0;
+
+      /**
+       * Get rows of world state view written by blocks with id in range
+       * [from, to], as recorded on their commit
+       * @param from - starting id
+       * @param to - ending id
+       * @return observable of changes, empty if changes are not logged
+       */
+      virtual rxcpp::observable<protocol::WsvChanges> getWsvChanges(
+          uint32_t from, uint32_t to) = 0;
+
+      /**
+       * Get committed transaction by its hash
+       * @param tx_hash - hash of the transaction
+       * @return transaction with its position, nullopt if it is not committed
+       */
+      virtual nonstd::optional<CommittedTransaction> getTransaction(
+          const hash256_t &tx_hash) = 0;
+
+      /**
+       * Make proof that committed transaction is included into its block
+       * @param tx - transaction found by getTransaction
+       * @return proof, nullopt if block is unreadable or its merkle root
+       * does not cover its transactions
+       */
+      virtual nonstd::optional<model::InclusionProof> getInclusionProof(
+          const CommittedTransaction &tx) = 0;
+
+      /**
+       * Check whether transaction is committed, e.g. to reject duplicates.
+       * Most transactions are new, so negative answers are the cheap ones.
+       * @param tx_hash - hash of the transaction
+       * @return true if transaction is in the chain
+       */
+      virtual bool hasTransaction(const hash256_t &tx_hash) = 0;
+
+      /**
+       * @return height of the last committed block, 0 for empty ledger
+       */
+      virtual uint32_t getTopBlockHeight() = 0;
+
+      /**
+       * Get root of committed world state view together with its height.
+       * Root tells peers apart whose state has diverged by accident, it is
+       * not collision resistant and must not be used as proof of the state
+       * @return root, nullopt if it is not maintained
+       */
+      virtual nonstd::optional<CommittedStateRoot> getStateRoot() = 0;
     };
 
   }  // namespace ametsuchi
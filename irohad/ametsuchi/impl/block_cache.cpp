@@ -0,0 +1,94 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/block_cache.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    BlockCache::BlockCache(size_t max_blocks, size_t max_bytes)
+        : max_blocks_(max_blocks),
+          max_bytes_(max_bytes),
+          bytes_(0),
+          hits_(0),
+          misses_(0) {}
+
+    std::shared_ptr<const model::Block> BlockCache::get(uint32_t height) {
+      std::lock_guard<std::mutex> lock(lock_);
+      auto it = entries_.find(height);
+      if (it == entries_.end()) {
+        ++misses_;
+        return nullptr;
+      }
+      ++hits_;
+      order_.splice(order_.begin(), order_, it->second.position);
+      return it->second.block;
+    }
+
+    void BlockCache::put(uint32_t height,
+                         std::shared_ptr<const model::Block> block,
+                         size_t size) {
+      if (max_blocks_ == 0 or size > max_bytes_) {
+        return;
+      }
+      std::lock_guard<std::mutex> lock(lock_);
+      auto it = entries_.find(height);
+      if (it != entries_.end()) {
+        bytes_ -= it->second.size;
+        order_.erase(it->second.position);
+        entries_.erase(it);
+      }
+
+      while (not order_.empty() and
+             (entries_.size() >= max_blocks_ or bytes_ + size > max_bytes_)) {
+        evictLast();
+      }
+
+      order_.push_front(height);
+      entries_.emplace(height, Entry{std::move(block), size, order_.begin()});
+      bytes_ += size;
+    }
+
+    size_t BlockCache::bytes() const {
+      std::lock_guard<std::mutex> lock(lock_);
+      return bytes_;
+    }
+
+    size_t BlockCache::shrink(size_t bytes) {
+      std::lock_guard<std::mutex> lock(lock_);
+      size_t evicted = 0;
+      while (not order_.empty() and evicted < bytes) {
+        evicted += evictLast();
+      }
+      return evicted;
+    }
+
+    size_t BlockCache::evictLast() {
+      auto last = entries_.find(order_.back());
+      auto size = last->second.size;
+      bytes_ -= size;
+      entries_.erase(last);
+      order_.pop_back();
+      return size;
+    }
+
+    uint64_t BlockCache::hits() const { return hits_; }
+
+    uint64_t BlockCache::misses() const { return misses_; }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,111 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_BLOCK_CACHE_HPP
+#define IROHA_BLOCK_CACHE_HPP
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "model/block.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Bounded LRU cache of deserialized blocks, keyed by height.
+     * Size of a block is accounted as size of its serialized form.
+     */
+    class BlockCache {
+     public:
+      /**
+       * @param max_blocks - maximal number of cached blocks, 0 disables cache
+       * @param max_bytes - maximal total size of cached blocks
+       */
+      BlockCache(size_t max_blocks, size_t max_bytes);
+
+      /**
+       * Find block and mark it as recently used
+       * @param height - height of block
+       * @return block or nullptr if it is not cached
+       */
+      std::shared_ptr<const model::Block> get(uint32_t height);
+
+      /**
+       * Insert block evicting least recently used ones if needed.
+       * Blocks larger than the whole cache are not inserted.
+       * @param height - height of block
+       * @param block - deserialized block
+       * @param size - size of serialized block
+       */
+      void put(uint32_t height,
+               std::shared_ptr<const model::Block> block,
+               size_t size);
+
+      /**
+       * @return total size of cached blocks
+       */
+      size_t bytes() const;
+
+      /**
+       * Evict least recently used blocks, e.g. under memory pressure
+       * @param bytes - size of blocks to evict
+       * @return size of evicted blocks
+       */
+      size_t shrink(size_t bytes);
+
+      /**
+       * @return number of lookups which found the block
+       */
+      uint64_t hits() const;
+
+      /**
+       * @return number of lookups which did not find the block
+       */
+      uint64_t misses() const;
+
+     private:
+      struct Entry {
+        std::shared_ptr<const model::Block> block;
+        size_t size;
+        std::list<uint32_t>::iterator position;
+      };
+
+      /**
+       * Evict least recently used block, must be called under lock
+       * @return size of evicted block
+       */
+      size_t evictLast();
+
+      const size_t max_blocks_;
+      const size_t max_bytes_;
+
+      // most recently used heights first
+      std::list<uint32_t> order_;
+      std::unordered_map<uint32_t, Entry> entries_;
+      size_t bytes_;
+      mutable std::mutex lock_;
+
+      std::atomic<uint64_t> hits_;
+      std::atomic<uint64_t> misses_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+#endif  // IROHA_BLOCK_CACHE_HPP
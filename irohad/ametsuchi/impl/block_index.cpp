@@ -0,0 +1,58 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/block_index.hpp"
+#include "model/commands/add_asset_quantity.hpp"
+#include "model/commands/transfer_asset.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    std::set<std::pair<std::string, std::string>> changedAccountAssets(
+        const model::Transaction &tx) {
+      std::set<std::pair<std::string, std::string>> result;
+      for (const auto &command : tx.commands) {
+        if (instanceof <model::TransferAsset>(*command)) {
+          const auto &transfer =
+              static_cast<const model::TransferAsset &>(*command);
+          result.emplace(transfer.src_account_id, transfer.asset_id);
+          result.emplace(transfer.dest_account_id, transfer.asset_id);
+        }
+        if (instanceof <model::AddAssetQuantity>(*command)) {
+          const auto &add =
+              static_cast<const model::AddAssetQuantity &>(*command);
+          result.emplace(add.account_id, add.asset_id);
+        }
+      }
+      return result;
+    }
+
+    std::vector<std::pair<std::string, Amount>> assetTransfers(
+        const model::Transaction &tx) {
+      std::vector<std::pair<std::string, Amount>> result;
+      for (const auto &command : tx.commands) {
+        if (instanceof <model::TransferAsset>(*command)) {
+          const auto &transfer =
+              static_cast<const model::TransferAsset &>(*command);
+          result.emplace_back(transfer.asset_id, transfer.amount);
+        }
+      }
+      return result;
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
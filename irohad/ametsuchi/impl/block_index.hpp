@@ -0,0 +1,112 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_BLOCK_INDEX_HPP
+#define IROHA_BLOCK_INDEX_HPP
+
+#include <functional>
+#include <nonstd/optional.hpp>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include "model/block.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Position of transaction in the chain
+     */
+    struct TxPosition {
+      uint32_t height;
+      // index of transaction in its block
+      uint32_t index;
+    };
+
+    /**
+     * Blocks of one commit, in chain order
+     */
+    using BlockRefs = std::vector<std::reference_wrapper<const model::Block>>;
+
+    /**
+     * (account id, asset id) pairs whose balance is changed by the
+     * transaction, i.e. sides of TransferAsset and AddAssetQuantity
+     */
+    std::set<std::pair<std::string, std::string>> changedAccountAssets(
+        const model::Transaction &tx);
+
+    /**
+     * (asset id, amount) of each TransferAsset of the transaction, in
+     * order of commands
+     */
+    std::vector<std::pair<std::string, Amount>> assetTransfers(
+        const model::Transaction &tx);
+
+    /**
+     * Secondary index of committed blocks: block and transaction hashes,
+     * transactions of accounts and of account assets.
+     * Lookups return nullopt when the index can not be read.
+     */
+    class BlockIndex {
+     public:
+      virtual ~BlockIndex() = default;
+
+      /**
+       * Index blocks with one atomic write
+       * @return true on success
+       */
+      virtual bool add(const BlockRefs &blocks) = 0;
+
+      /**
+       * @return height of the last indexed block, 0 for empty index
+       */
+      virtual nonstd::optional<uint32_t> height() = 0;
+
+      /**
+       * @return positions of transactions created by the account,
+       * in chain order
+       */
+      virtual nonstd::optional<std::vector<TxPosition>> accountTransactions(
+          const std::string &account_id) = 0;
+
+      /**
+       * @return positions of transactions changing the account asset,
+       * in chain order
+       */
+      virtual nonstd::optional<std::vector<TxPosition>>
+      accountAssetTransactions(const std::string &account_id,
+                               const std::string &asset_id) = 0;
+
+      /**
+       * @return height of the block with given hash, nullopt if it is not
+       * indexed
+       */
+      virtual nonstd::optional<uint32_t> blockHeight(
+          const hash256_t &block_hash) = 0;
+
+      /**
+       * @return position of the transaction with given hash, nullopt if it
+       * is not indexed
+       */
+      virtual nonstd::optional<TxPosition> transaction(
+          const hash256_t &tx_hash) = 0;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+#endif  // IROHA_BLOCK_INDEX_HPP
@@ -0,0 +1,145 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/block_range_reader.hpp"
+#include <algorithm>
+
+namespace iroha {
+  namespace ametsuchi {
+
+    // BlockReadPool
+
+    BlockReadPool::BlockReadPool(size_t workers) {
+      for (size_t i = 0; i < std::max<size_t>(workers, 1); ++i) {
+        workers_.emplace_back(&BlockReadPool::run, this);
+      }
+    }
+
+    BlockReadPool::~BlockReadPool() {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+      }
+      wakeup_.notify_all();
+      for (auto &worker : workers_) {
+        worker.join();
+      }
+    }
+
+    void BlockReadPool::post(Task task) {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(std::move(task));
+      }
+      wakeup_.notify_one();
+    }
+
+    size_t BlockReadPool::size() const {
+      return workers_.size();
+    }
+
+    void BlockReadPool::run() {
+      std::unique_lock<std::mutex> lock(mutex_);
+      while (true) {
+        wakeup_.wait(lock, [this] { return stopped_ or not tasks_.empty(); });
+        if (tasks_.empty()) {
+          return;
+        }
+        auto task = std::move(tasks_.front());
+        tasks_.pop_front();
+        lock.unlock();
+        task();
+        lock.lock();
+      }
+    }
+
+    // BlockRangeReader
+
+    BlockRangeReader::BlockRangeReader(uint32_t from,
+                                       uint32_t to,
+                                       Loader loader,
+                                       BlockReadPool *pool,
+                                       size_t read_ahead)
+        : loader_(std::move(loader)),
+          pool_(pool),
+          to_(to),
+          read_ahead_(std::max<size_t>(read_ahead, 1)),
+          next_task_(from),
+          next_result_(from) {
+      if (pool_) {
+        std::lock_guard<std::mutex> lock(lock_);
+        schedule();
+      }
+    }
+
+    BlockRangeReader::~BlockRangeReader() {
+      std::unique_lock<std::mutex> lock(lock_);
+      stopped_ = true;
+      // posted loads refer to the reader, they skip loading once stopped
+      result_cv_.wait(lock, [this] { return in_flight_ == 0; });
+    }
+
+    void BlockRangeReader::schedule() {
+      // one reader takes no more workers than the pool has, so readers
+      // started later are not queued behind its whole window
+      while (not stopped_ and next_task_ <= to_
+             and next_task_ < next_result_ + read_ahead_
+             and in_flight_ < pool_->size()) {
+        auto height = next_task_++;
+        ++in_flight_;
+        pool_->post([this, height] { this->load(height); });
+      }
+    }
+
+    void BlockRangeReader::load(uint64_t height) {
+      std::unique_lock<std::mutex> lock(lock_);
+      if (not stopped_) {
+        lock.unlock();
+        auto block = loader_(height);
+        lock.lock();
+        ready_.emplace(height, std::move(block));
+      }
+      --in_flight_;
+      schedule();
+      // notified under lock, destructor may free the reader right after
+      result_cv_.notify_all();
+    }
+
+    nonstd::optional<std::shared_ptr<const model::Block>>
+    BlockRangeReader::next() {
+      std::unique_lock<std::mutex> lock(lock_);
+      if (next_result_ > to_) {
+        return nonstd::nullopt;
+      }
+      auto height = next_result_++;
+      if (not pool_) {
+        lock.unlock();
+        return loader_(height);
+      }
+
+      result_cv_.wait(
+          lock, [this, height] { return ready_.count(height) != 0; });
+      auto it = ready_.find(height);
+      auto block = std::move(it->second);
+      ready_.erase(it);
+      // window moved, so one more block can be loaded
+      schedule();
+      return block;
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
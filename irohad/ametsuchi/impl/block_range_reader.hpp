@@ -0,0 +1,149 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_BLOCK_RANGE_READER_HPP
+#define IROHA_BLOCK_RANGE_READER_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <nonstd/optional.hpp>
+#include <thread>
+#include <vector>
+#include "model/block.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Fixed set of threads loading blocks for all range readers of
+     * storage, so concurrent reads share workers instead of starting
+     * their own
+     */
+    class BlockReadPool {
+     public:
+      using Task = std::function<void()>;
+
+      /**
+       * @param workers - number of threads, at least one is started
+       */
+      explicit BlockReadPool(size_t workers);
+
+      BlockReadPool(const BlockReadPool &) = delete;
+      BlockReadPool &operator=(const BlockReadPool &) = delete;
+
+      /**
+       * Joins workers, readers using the pool must be destroyed before
+       */
+      ~BlockReadPool();
+
+      /**
+       * Queue task for execution on one of workers
+       */
+      void post(Task task);
+
+      /**
+       * @return number of workers
+       */
+      size_t size() const;
+
+     private:
+      void run();
+
+      std::deque<Task> tasks_;
+      bool stopped_ = false;
+      std::mutex mutex_;
+      std::condition_variable wakeup_;
+      std::vector<std::thread> workers_;
+    };
+
+    /**
+     * Reads range of blocks ahead of the consumer on a shared pool and
+     * returns them in height order. Number of blocks loaded but not yet
+     * consumed is bounded by read-ahead window, number of blocks loaded at
+     * once by size of the pool.
+     */
+    class BlockRangeReader {
+     public:
+      /**
+       * Loads block with given height, nullptr if block can not be read
+       */
+      using Loader =
+          std::function<std::shared_ptr<const model::Block>(uint32_t)>;
+
+      /**
+       * @param from - first height of the range
+       * @param to - last height of the range, inclusive
+       * @param loader - function which reads single block, called
+       * concurrently from workers of the pool
+       * @param pool - workers to load blocks on, nullptr loads blocks in
+       * consumer thread
+       * @param read_ahead - maximal number of blocks loaded in advance
+       */
+      BlockRangeReader(uint32_t from,
+                       uint32_t to,
+                       Loader loader,
+                       BlockReadPool *pool,
+                       size_t read_ahead);
+
+      /**
+       * Waits for loads in progress, not consumed blocks are dropped
+       */
+      ~BlockRangeReader();
+
+      BlockRangeReader(const BlockRangeReader &) = delete;
+      BlockRangeReader &operator=(const BlockRangeReader &) = delete;
+
+      /**
+       * Wait for block with next height
+       * @return block, which is nullptr if it can not be read;
+       * nullopt after the end of range
+       */
+      nonstd::optional<std::shared_ptr<const model::Block>> next();
+
+     private:
+      /**
+       * Post loads of heights within the window. Called under lock_
+       */
+      void schedule();
+
+      void load(uint64_t height);
+
+      Loader loader_;
+      BlockReadPool *pool_;
+      const uint64_t to_;
+      const uint64_t read_ahead_;
+
+      // next height to be loaded
+      uint64_t next_task_;
+      // next height to be returned to consumer
+      uint64_t next_result_;
+      // loads posted to the pool and not finished
+      size_t in_flight_ = 0;
+      std::map<uint64_t, std::shared_ptr<const model::Block>> ready_;
+      bool stopped_ = false;
+
+      std::mutex lock_;
+      std::condition_variable result_cv_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+#endif  // IROHA_BLOCK_RANGE_READER_HPP
@@ -0,0 +1,160 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/block_serializer.hpp"
+#include <cstring>
+#include "model/converters/json_common.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    namespace {
+      const char kProtobufMagic[4] = {'I', 'R', 'P', 'B'};
+      const uint32_t kProtobufVersion = 1;
+      const size_t kTagSize = sizeof(kProtobufMagic) + sizeof(uint32_t);
+      // number of blocks converted between two writes
+      const size_t kConvertBatchSize = 256;
+    }  // namespace
+
+    BlockSerializer::BlockSerializer(BlockFormat format) : format_(format) {
+      log_ = logger::log("BlockSerializer");
+    }
+
+    std::vector<uint8_t> BlockSerializer::serialize(
+        const model::Block &block) {
+      if (format_ == BlockFormat::Json) {
+        return model::converters::jsonToVector(json_factory_.serialize(block));
+      }
+      // message of the previous block is reused, so steady commits do not
+      // allocate its fields again
+      thread_local protocol::Block pb_block;
+      pb_factory_.serialize(block, pb_block);
+      std::vector<uint8_t> bytes(kTagSize + pb_block.ByteSize());
+      std::memcpy(bytes.data(), kProtobufMagic, sizeof(kProtobufMagic));
+      std::memcpy(bytes.data() + sizeof(kProtobufMagic),
+                  &kProtobufVersion,
+                  sizeof(kProtobufVersion));
+      pb_block.SerializeWithCachedSizesToArray(bytes.data() + kTagSize);
+      return bytes;
+    }
+
+    nonstd::optional<model::Block> BlockSerializer::deserialize(
+        const uint8_t *data, size_t size) {
+      auto block_format = format(data, size);
+      if (not block_format) {
+        log_->error("Unknown format of stored block");
+        return nonstd::nullopt;
+      }
+      if (*block_format == BlockFormat::Json) {
+        return json_factory_.deserialize(data, size);
+      }
+
+      protocol::Block pb_block;
+      if (not pb_block.ParseFromArray(data + kTagSize, size - kTagSize)) {
+        log_->error("Cannot parse binary block");
+        return nonstd::nullopt;
+      }
+      return pb_factory_.deserialize(pb_block);
+    }
+
+    std::shared_ptr<const LazyBlock> BlockSerializer::deserializeLazy(
+        BlockView bytes) {
+      auto block_format = format(bytes.data(), bytes.size());
+      if (block_format == BlockFormat::Protobuf) {
+        auto block = LazyBlock::parse(bytes, kTagSize);
+        if (block) {
+          return block;
+        }
+      }
+      // blocks which can not be delimited are decoded as usual
+      auto block = deserialize(bytes.data(), bytes.size());
+      if (not block) {
+        return nullptr;
+      }
+      return std::make_shared<const LazyBlock>(
+          std::make_shared<const model::Block>(std::move(*block)));
+    }
+
+    nonstd::optional<protocol::Block> BlockSerializer::deserializeWire(
+        const uint8_t *data, size_t size) {
+      auto block_format = format(data, size);
+      if (not block_format) {
+        log_->error("Unknown format of stored block");
+        return nonstd::nullopt;
+      }
+      if (*block_format == BlockFormat::Json) {
+        auto block = json_factory_.deserialize(data, size);
+        if (not block) {
+          return nonstd::nullopt;
+        }
+        return pb_factory_.serialize(*block);
+      }
+
+      protocol::Block pb_block;
+      if (not pb_block.ParseFromArray(data + kTagSize, size - kTagSize)) {
+        log_->error("Cannot parse binary block");
+        return nonstd::nullopt;
+      }
+      return pb_block;
+    }
+
+    nonstd::optional<BlockFormat> BlockSerializer::format(const uint8_t *data,
+                                                          size_t size) {
+      if (size >= kTagSize and
+          std::memcmp(data, kProtobufMagic, sizeof(kProtobufMagic)) == 0) {
+        uint32_t version;
+        std::memcpy(&version, data + sizeof(kProtobufMagic), sizeof(version));
+        if (version != kProtobufVersion) {
+          return nonstd::nullopt;
+        }
+        return BlockFormat::Protobuf;
+      }
+      if (size > 0 and data[0] == '{') {
+        return BlockFormat::Json;
+      }
+      return nonstd::nullopt;
+    }
+
+    bool convertBlocks(const BlockStorage &source,
+                       BlockStorage &destination,
+                       BlockSerializer &serializer) {
+      BlockBatch blocks;
+      auto flush = [&] {
+        auto written = destination.add_batch(blocks)
+            and destination.last_id() == blocks.back().first;
+        blocks.clear();
+        return written;
+      };
+      for (auto id = destination.last_id() + 1; id <= source.last_id(); ++id) {
+        auto bytes = source.view(id);
+        if (not bytes) {
+          return false;
+        }
+        auto block = serializer.deserialize(bytes->data(), bytes->size());
+        if (not block) {
+          return false;
+        }
+        blocks.emplace_back(id, serializer.serialize(*block));
+        if (blocks.size() == kConvertBatchSize and not flush()) {
+          return false;
+        }
+      }
+      return blocks.empty() or flush();
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
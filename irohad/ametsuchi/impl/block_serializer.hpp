@@ -0,0 +1,112 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_BLOCK_SERIALIZER_HPP
+#define IROHA_BLOCK_SERIALIZER_HPP
+
+#include <nonstd/optional.hpp>
+#include <vector>
+#include "ametsuchi/impl/block_storage.hpp"
+#include "ametsuchi/impl/lazy_block.hpp"
+#include "logger/logger.hpp"
+#include "model/block.hpp"
+#include "model/converters/json_block_factory.hpp"
+#include "model/converters/pb_block_factory.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Converts blocks to bytes kept in block storage and back.
+     * Binary blocks start with format tag [magic][uint32 version] followed by
+     * serialized protocol::Block. Blocks without the tag are JSON, compact
+     * or pretty-printed by earlier versions, so all of them are readable.
+     */
+    class BlockSerializer {
+     public:
+      /**
+       * @param format - format of serialized blocks
+       */
+      explicit BlockSerializer(BlockFormat format = BlockFormat::Protobuf);
+
+      /**
+       * Serialize block in format of the serializer
+       * @param block - block to serialize
+       * @return bytes to store
+       */
+      std::vector<uint8_t> serialize(const model::Block &block);
+
+      /**
+       * Deserialize stored block of any known format
+       * @param data - pointer to stored bytes
+       * @param size - number of stored bytes
+       * @return block if bytes are well-formed, nullopt otherwise
+       */
+      nonstd::optional<model::Block> deserialize(const uint8_t *data,
+                                                 size_t size);
+
+      /**
+       * Deserialize stored block of any known format lazily. Transactions
+       * of binary blocks are decoded on access, other blocks are decoded
+       * at once
+       * @param bytes - stored block, kept alive by the result
+       * @return block or nullptr if bytes are malformed
+       */
+      std::shared_ptr<const LazyBlock> deserializeLazy(BlockView bytes);
+
+      /**
+       * Deserialize stored block of any known format into wire format.
+       * Binary blocks are parsed in place without conversion to model
+       * @param data - pointer to stored bytes
+       * @param size - number of stored bytes
+       * @return block if bytes are well-formed, nullopt otherwise
+       */
+      nonstd::optional<protocol::Block> deserializeWire(const uint8_t *data,
+                                                        size_t size);
+
+      /**
+       * Detect format of stored block
+       * @param data - pointer to stored bytes
+       * @param size - number of stored bytes
+       * @return format of the block, nullopt if it is unknown
+       */
+      static nonstd::optional<BlockFormat> format(const uint8_t *data,
+                                                  size_t size);
+
+     private:
+      BlockFormat format_;
+      model::converters::JsonBlockFactory json_factory_;
+      model::converters::PbBlockFactory pb_factory_;
+      logger::Logger log_;
+    };
+
+    /**
+     * Copy all blocks of one storage to another one, rewriting them in
+     * format of the serializer
+     * @param source - storage to read blocks from
+     * @param destination - storage to append blocks to, must be empty or
+     * contain a prefix of source
+     * @param serializer - serializer with resulting format
+     * @return true if all blocks were converted
+     */
+    bool convertBlocks(const BlockStorage &source,
+                       BlockStorage &destination,
+                       BlockSerializer &serializer);
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+#endif  // IROHA_BLOCK_SERIALIZER_HPP
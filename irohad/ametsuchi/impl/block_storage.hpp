@@ -0,0 +1,374 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_BLOCK_STORAGE_HPP
+#define IROHA_BLOCK_STORAGE_HPP
+
+#include <cstdint>
+#include <memory>
+#include <nonstd/optional.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+#include "common/types.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Kind of on-disk layout used for storing serialized blocks
+     */
+    enum class BlockStorageType {
+      /**
+       * One file per block, named after block id
+       */
+      FlatFile,
+
+      /**
+       * Large append-only segment files with compact offset index
+       */
+      Segmented
+    };
+
+    /**
+     * Encoding of blocks kept in block storage
+     */
+    enum class BlockFormat {
+      /**
+       * Pretty-printed JSON document
+       */
+      Json,
+
+      /**
+       * Tagged binary protocol::Block
+       */
+      Protobuf
+    };
+
+    /**
+     * When written blocks are flushed to the disk
+     */
+    enum class DurabilityPolicy {
+      /**
+       * Rely on the operating system, blocks may be lost on power failure
+       */
+      None,
+
+      /**
+       * Flush once after all blocks of one commit are written
+       */
+      PerCommit,
+
+      /**
+       * Flush after every written block
+       */
+      PerBlock
+    };
+
+    /**
+     * Compression of stored blocks
+     */
+    enum class BlockCompression {
+      /**
+       * Blocks are stored as is
+       */
+      None,
+
+      /**
+       * zstd with dictionary trained per group of blocks
+       */
+      Zstd
+    };
+
+    /**
+     * Database keeping world state view
+     */
+    enum class WsvBackendType {
+      /**
+       * External PostgreSQL server
+       */
+      Postgres,
+
+      /**
+       * Embedded LMDB environment, no external services
+       */
+      Lmdb
+    };
+
+    /**
+     * Store of the block index serving transaction queries
+     */
+    enum class BlockIndexType {
+      /**
+       * No index, queries scan blocks
+       */
+      None,
+
+      /**
+       * External Redis server
+       */
+      Redis,
+
+      /**
+       * Embedded LMDB environment next to block storage
+       */
+      Embedded
+    };
+
+    /**
+     * Settings of block storage
+     */
+    struct BlockStorageOptions {
+      /**
+       * On-disk layout of blocks
+       */
+      BlockStorageType type = BlockStorageType::FlatFile;
+
+      /**
+       * Check every stored block on start instead of trusting the manifest;
+       * recovery mode for damaged stores
+       */
+      bool verify_blocks = false;
+
+      /**
+       * Flushing of written blocks
+       */
+      DurabilityPolicy durability = DurabilityPolicy::PerCommit;
+
+      /**
+       * Encoding of new blocks, stored blocks are read in any format
+       */
+      BlockFormat format = BlockFormat::Protobuf;
+
+      /**
+       * Compression of new blocks, compressed and plain blocks are both
+       * readable regardless of this setting
+       */
+      BlockCompression compression = BlockCompression::None;
+
+      /**
+       * Maximal number of deserialized blocks kept in memory, 0 disables
+       * the cache
+       */
+      size_t cache_blocks = 256;
+
+      /**
+       * Maximal total serialized size of blocks kept in memory
+       */
+      size_t cache_bytes = 64 * 1024 * 1024;
+
+      /**
+       * Number of the latest blocks read into cache on start, together
+       * with accounts and account assets they touch, so the first rounds
+       * after restart do not wait for disk and database; 0 disables
+       */
+      uint32_t warm_up_blocks = 64;
+
+      /**
+       * Keep account asset writes of a block in memory and write them with
+       * multi-row statements on commit
+       */
+      bool defer_wsv_writes = false;
+
+      /**
+       * Database of world state view
+       */
+      WsvBackendType wsv_backend = WsvBackendType::Postgres;
+
+      /**
+       * Existing directory of embedded world state view database
+       */
+      std::string wsv_path;
+
+      /**
+       * Connection string of PostgreSQL standby serving client queries,
+       * empty if queries are served by the node database
+       */
+      std::string wsv_replica;
+
+      /**
+       * Number of blocks the standby may lag behind the node before queries
+       * fall back to the node database
+       */
+      uint32_t wsv_replica_max_lag = 2;
+
+      /**
+       * Store of the block index
+       */
+      BlockIndexType block_index = BlockIndexType::Redis;
+
+      /**
+       * Existing directory of embedded block index
+       */
+      std::string block_index_path;
+
+      /**
+       * Upper bound of blocks per second indexed in background after start,
+       * so reads of old blocks leave disk bandwidth to consensus; 0 for no
+       * limit
+       */
+      uint32_t block_index_rebuild_rate = 5000;
+
+      /**
+       * Keep Bloom filters of transaction hashes next to blocks, so lookups
+       * of unknown transactions read neither blocks nor the index
+       */
+      bool tx_hash_filter = true;
+
+      /**
+       * Keep creators and changed account assets of transactions as
+       * columns next to blocks, so history queries without a complete
+       * block index read only matching blocks instead of all of them
+       */
+      bool tx_columns = false;
+
+      /**
+       * Existing directory of the log of rows written by each committed
+       * block, see WsvChanges, served to subscribers instead of replaying
+       * commands; empty disables the log. The log starts from the first
+       * block committed after it is enabled.
+       */
+      std::string wsv_changes_path;
+
+      /**
+       * Export world state view next to blocks after every that many
+       * blocks, so new nodes restore it instead of replaying the whole
+       * chain; 0 disables export
+       */
+      uint32_t wsv_snapshot_interval = 0;
+
+      /**
+       * Key signing exported snapshots, which are unsigned if absent
+       */
+      nonstd::optional<ed25519::keypair_t> wsv_snapshot_keypair;
+
+      /**
+       * Maintain root of world state view, see StateRoot, so peers compare
+       * their states by 32 bytes. Initial root is computed from all tables
+       * on start
+       */
+      bool state_root = false;
+
+      /**
+       * Number of the latest blocks kept in block storage, older ones are
+       * removed after commit; 0 keeps all blocks. Blocks after the latest
+       * world state view snapshot are kept while snapshots are exported,
+       * so retention of 1 keeps exactly the blocks needed to restore.
+       */
+      uint32_t block_retention = 0;
+
+      /**
+       * Directory where removed blocks are moved to, empty to delete them
+       */
+      std::string block_archive_path;
+    };
+
+    /**
+     * Serialized blocks with their ids, in order of writing
+     */
+    using BlockBatch = std::vector<std::pair<uint32_t, std::vector<uint8_t>>>;
+
+    /**
+     * Read-only view of serialized block without copying it from storage.
+     * View keeps underlying memory alive, so it stays valid after the
+     * storage has been modified.
+     */
+    class BlockView {
+     public:
+      BlockView(std::shared_ptr<const void> owner, const uint8_t *data,
+                size_t size)
+          : owner_(std::move(owner)), data_(data), size_(size) {}
+
+      const uint8_t *data() const { return data_; }
+      size_t size() const { return size_; }
+      const uint8_t *begin() const { return data_; }
+      const uint8_t *end() const { return data_ + size_; }
+
+     private:
+      std::shared_ptr<const void> owner_;
+      const uint8_t *data_;
+      size_t size_;
+    };
+
+    /**
+     * Append-only storage of serialized blocks, addressed by block id
+     */
+    class BlockStorage {
+     public:
+      virtual ~BlockStorage() = default;
+
+      /**
+       * Append block to the storage
+       * @param id - id of block, must follow last_id()
+       * @param block - serialized block
+       * @return true if block is stored or was stored before
+       */
+      virtual bool add(uint32_t id, const std::vector<uint8_t> &block) = 0;
+
+      /**
+       * Append several blocks at once, so they are flushed together
+       * according to durability policy
+       * @param blocks - consecutive blocks following last_id()
+       * @return true if all blocks are stored, otherwise storage keeps
+       * blocks preceding the first failed one
+       */
+      virtual bool add_batch(const BlockBatch &blocks) = 0;
+
+      /**
+       * Read block from the storage
+       * @param id - id of block
+       * @return serialized block if present, nullopt otherwise
+       */
+      virtual nonstd::optional<std::vector<uint8_t>> get(
+          uint32_t id) const = 0;
+
+      /**
+       * Read block from the storage without copying
+       * @param id - id of block
+       * @return view of serialized block if present, nullopt otherwise
+       */
+      virtual nonstd::optional<BlockView> view(uint32_t id) const = 0;
+
+      /**
+       * @return id of the last stored block, 0 if storage is empty
+       */
+      virtual uint32_t last_id() const = 0;
+
+      /**
+       * @return id of the oldest stored block, 0 if storage is empty
+       */
+      virtual uint32_t first_id() const = 0;
+
+      /**
+       * Remove blocks older than given id, the last block is always kept.
+       * Storages removing blocks in larger units may keep some of them.
+       * @param id - oldest block to keep
+       * @param archive_dir - directory on the same file system where
+       * removed files are moved to, empty to delete them
+       * @return true if no removal failed
+       */
+      virtual bool prune(uint32_t id, const std::string &archive_dir) = 0;
+
+      /**
+       * @return directory of the storage
+       */
+      virtual std::string directory() const = 0;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+#endif  // IROHA_BLOCK_STORAGE_HPP
@@ -0,0 +1,88 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/bloom_filter.hpp"
+#include <cstring>
+
+namespace iroha {
+  namespace ametsuchi {
+
+    namespace {
+      const size_t kHeaderSize = sizeof(uint64_t) + sizeof(uint32_t);
+
+      uint64_t word(const hash256_t &hash, size_t offset) {
+        uint64_t value;
+        std::memcpy(&value, hash.data() + offset, sizeof(value));
+        return value;
+      }
+    }  // namespace
+
+    BloomFilter::BloomFilter(size_t bits, uint32_t probes)
+        : bits_(bits == 0 ? 8 : (bits + 7) / 8 * 8),
+          probes_(probes == 0 ? 1 : probes),
+          array_(bits_ / 8) {}
+
+    uint64_t BloomFilter::probe(const hash256_t &hash, uint32_t i) const {
+      // odd step visits distinct positions of power-of-two filters
+      return (word(hash, 0) + i * (word(hash, 8) | 1)) % bits_;
+    }
+
+    void BloomFilter::insert(const hash256_t &hash) {
+      for (uint32_t i = 0; i < probes_; ++i) {
+        auto position = probe(hash, i);
+        array_[position / 8] |= 1 << (position % 8);
+      }
+    }
+
+    bool BloomFilter::mayContain(const hash256_t &hash) const {
+      for (uint32_t i = 0; i < probes_; ++i) {
+        auto position = probe(hash, i);
+        if (not(array_[position / 8] & (1 << (position % 8)))) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    std::vector<uint8_t> BloomFilter::serialize() const {
+      std::vector<uint8_t> result(kHeaderSize);
+      std::memcpy(result.data(), &bits_, sizeof(bits_));
+      std::memcpy(result.data() + sizeof(bits_), &probes_, sizeof(probes_));
+      result.insert(result.end(), array_.begin(), array_.end());
+      return result;
+    }
+
+    nonstd::optional<BloomFilter> BloomFilter::deserialize(
+        const uint8_t *data, size_t size) {
+      if (size < kHeaderSize) {
+        return nonstd::nullopt;
+      }
+      uint64_t bits;
+      uint32_t probes;
+      std::memcpy(&bits, data, sizeof(bits));
+      std::memcpy(&probes, data + sizeof(bits), sizeof(probes));
+      if (bits == 0 or bits % 8 != 0 or probes == 0
+          or size - kHeaderSize != bits / 8) {
+        return nonstd::nullopt;
+      }
+      BloomFilter filter(bits, probes);
+      std::memcpy(filter.array_.data(), data + kHeaderSize, bits / 8);
+      return filter;
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,73 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_BLOOM_FILTER_HPP
+#define IROHA_BLOOM_FILTER_HPP
+
+#include <nonstd/optional.hpp>
+#include <vector>
+#include "common/types.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Bloom filter of 256-bit hashes. Hashes are uniformly distributed
+     * already, so probe positions are derived from their bytes by double
+     * hashing instead of hashing them again.
+     */
+    class BloomFilter {
+     public:
+      /**
+       * @param bits - size of the filter, rounded up to whole bytes
+       * @param probes - number of bits set per hash
+       */
+      BloomFilter(size_t bits, uint32_t probes);
+
+      void insert(const hash256_t &hash);
+
+      /**
+       * @return false if the hash was never inserted, true if it probably
+       * was
+       */
+      bool mayContain(const hash256_t &hash) const;
+
+      /**
+       * @return layout [uint64 bits][uint32 probes][bit array]
+       */
+      std::vector<uint8_t> serialize() const;
+
+      /**
+       * @return filter or nullopt if bytes are not a serialized filter
+       */
+      static nonstd::optional<BloomFilter> deserialize(const uint8_t *data,
+                                                       size_t size);
+
+     private:
+      /**
+       * @return position of i-th probe of the hash
+       */
+      uint64_t probe(const hash256_t &hash, uint32_t i) const;
+
+      uint64_t bits_;
+      uint32_t probes_;
+      std::vector<uint8_t> array_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+#endif  // IROHA_BLOOM_FILTER_HPP
@@ -0,0 +1,207 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/bulk_wsv.hpp"
+#include <algorithm>
+
+namespace iroha {
+  namespace ametsuchi {
+
+    BulkWsv::BulkWsv(BulkTables &tables) : tables_(tables) {}
+
+    nonstd::optional<model::Account> BulkWsv::getAccount(
+        const std::string &account_id) {
+      auto it = tables_.accounts.find(account_id);
+      if (it == tables_.accounts.end()) {
+        return nonstd::nullopt;
+      }
+      return it->second;
+    }
+
+    nonstd::optional<std::vector<ed25519::pubkey_t>> BulkWsv::getSignatories(
+        const std::string &account_id) {
+      auto it = tables_.account_signatories.find(account_id);
+      if (it == tables_.account_signatories.end()) {
+        return std::vector<ed25519::pubkey_t>{};
+      }
+      return it->second;
+    }
+
+    nonstd::optional<model::Asset> BulkWsv::getAsset(
+        const std::string &asset_id) {
+      auto it = tables_.assets.find(asset_id);
+      if (it == tables_.assets.end()) {
+        return nonstd::nullopt;
+      }
+      return it->second;
+    }
+
+    nonstd::optional<model::AccountAsset> BulkWsv::getAccountAsset(
+        const std::string &account_id, const std::string &asset_id) {
+      auto it = tables_.account_assets.find({account_id, asset_id});
+      if (it == tables_.account_assets.end()) {
+        return nonstd::nullopt;
+      }
+      return it->second;
+    }
+
+    nonstd::optional<std::vector<model::AccountAsset>>
+    BulkWsv::getAccountAssets(const std::string &account_id,
+                              const std::string &after_asset_id,
+                              size_t limit) {
+      std::vector<model::AccountAsset> assets;
+      for (auto it = tables_.account_assets.upper_bound(
+               {account_id, after_asset_id});
+           it != tables_.account_assets.end()
+           and it->first.first == account_id
+           and (limit == 0 or assets.size() < limit);
+           ++it) {
+        assets.push_back(it->second);
+      }
+      return assets;
+    }
+
+    nonstd::optional<std::vector<model::AccountAsset>>
+    BulkWsv::getAssetHolders(const std::string &asset_id,
+                             const std::string &after_account_id,
+                             size_t limit) {
+      // loaded state is small enough to be scanned in order of accounts
+      std::vector<model::AccountAsset> holders;
+      for (auto it = tables_.accounts.upper_bound(after_account_id);
+           it != tables_.accounts.end()
+           and (limit == 0 or holders.size() < limit);
+           ++it) {
+        auto asset = tables_.account_assets.find({it->first, asset_id});
+        if (asset != tables_.account_assets.end()) {
+          holders.push_back(asset->second);
+        }
+      }
+      return holders;
+    }
+
+    nonstd::optional<std::vector<model::Account>>
+    BulkWsv::getDomainAccounts(const std::string &domain_id,
+                               const std::string &after_account_id,
+                               size_t limit) {
+      std::vector<model::Account> accounts;
+      for (auto it = tables_.accounts.upper_bound(after_account_id);
+           it != tables_.accounts.end()
+           and (limit == 0 or accounts.size() < limit);
+           ++it) {
+        if (it->second.domain_name == domain_id) {
+          accounts.push_back(it->second);
+        }
+      }
+      return accounts;
+    }
+
+    nonstd::optional<std::vector<std::string>>
+    BulkWsv::getAccountsBySignatory(const ed25519::pubkey_t &signatory,
+                                    const std::string &after_account_id,
+                                    size_t limit) {
+      std::vector<std::string> accounts;
+      for (auto it = tables_.account_signatories.upper_bound(after_account_id);
+           it != tables_.account_signatories.end()
+           and (limit == 0 or accounts.size() < limit);
+           ++it) {
+        if (std::find(it->second.begin(), it->second.end(), signatory)
+            != it->second.end()) {
+          accounts.push_back(it->first);
+        }
+      }
+      return accounts;
+    }
+
+    nonstd::optional<std::vector<model::Peer>> BulkWsv::getPeers() {
+      return tables_.peers;
+    }
+
+    bool BulkWsv::insertAccount(const model::Account &account) {
+      return tables_.accounts.emplace(account.account_id, account).second;
+    }
+
+    bool BulkWsv::updateAccount(const model::Account &account) {
+      // update of missing account changes nothing, as in SQL
+      auto it = tables_.accounts.find(account.account_id);
+      if (it != tables_.accounts.end()) {
+        auto domain = it->second.domain_name;
+        it->second = account;
+        it->second.domain_name = domain;
+      }
+      return true;
+    }
+
+    bool BulkWsv::insertAsset(const model::Asset &asset) {
+      return tables_.assets.emplace(asset.asset_id, asset).second;
+    }
+
+    bool BulkWsv::upsertAccountAsset(const model::AccountAsset &asset) {
+      tables_.account_assets[{asset.account_id, asset.asset_id}] = asset;
+      return true;
+    }
+
+    bool BulkWsv::insertSignatory(const ed25519::pubkey_t &signatory) {
+      return tables_.signatories.insert(signatory).second;
+    }
+
+    bool BulkWsv::insertAccountSignatory(const std::string &account_id,
+                                         const ed25519::pubkey_t &signatory) {
+      auto &signatories = tables_.account_signatories[account_id];
+      if (std::find(signatories.begin(), signatories.end(), signatory) !=
+          signatories.end()) {
+        return false;
+      }
+      signatories.push_back(signatory);
+      return true;
+    }
+
+    bool BulkWsv::deleteAccountSignatory(const std::string &account_id,
+                                         const ed25519::pubkey_t &signatory) {
+      auto &signatories = tables_.account_signatories[account_id];
+      signatories.erase(
+          std::remove(signatories.begin(), signatories.end(), signatory),
+          signatories.end());
+      return true;
+    }
+
+    bool BulkWsv::insertPeer(const model::Peer &peer) {
+      // both key and address are unique
+      auto duplicate = std::find_if(
+          tables_.peers.begin(), tables_.peers.end(), [&peer](auto &other) {
+            return other.pubkey == peer.pubkey or
+                other.address == peer.address;
+          });
+      if (duplicate != tables_.peers.end()) {
+        return false;
+      }
+      tables_.peers.push_back(peer);
+      return true;
+    }
+
+    bool BulkWsv::deletePeer(const model::Peer &peer) {
+      tables_.peers.erase(
+          std::remove(tables_.peers.begin(), tables_.peers.end(), peer),
+          tables_.peers.end());
+      return true;
+    }
+
+    bool BulkWsv::insertDomain(const model::Domain &domain) {
+      return tables_.domains.emplace(domain.domain_id, domain).second;
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,104 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_BULK_WSV_HPP
+#define IROHA_BULK_WSV_HPP
+
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include "ametsuchi/wsv_command.hpp"
+#include "ametsuchi/wsv_query.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Rows of world state view collected for bulk load
+     */
+    struct BulkTables {
+      std::map<std::string, model::Domain> domains;
+      std::set<ed25519::pubkey_t> signatories;
+      std::map<std::string, model::Account> accounts;
+      // signatories of every account in insertion order
+      std::map<std::string, std::vector<ed25519::pubkey_t>>
+          account_signatories;
+      std::map<std::string, model::Asset> assets;
+      std::map<std::pair<std::string, std::string>, model::AccountAsset>
+          account_assets;
+      // peers in insertion order
+      std::vector<model::Peer> peers;
+    };
+
+    /**
+     * World state view kept in memory until it is loaded into database at
+     * once. Intended for trusted input applied to empty state, so only
+     * uniqueness of keys is checked, references between tables are checked
+     * by database when the load is finished.
+     */
+    class BulkWsv : public WsvQuery, public WsvCommand {
+     public:
+      explicit BulkWsv(BulkTables &tables);
+
+      nonstd::optional<model::Account> getAccount(
+          const std::string &account_id) override;
+      nonstd::optional<std::vector<ed25519::pubkey_t>> getSignatories(
+          const std::string &account_id) override;
+      nonstd::optional<model::Asset> getAsset(
+          const std::string &asset_id) override;
+      nonstd::optional<model::AccountAsset> getAccountAsset(
+          const std::string &account_id, const std::string &asset_id) override;
+      nonstd::optional<std::vector<model::AccountAsset>> getAccountAssets(
+          const std::string &account_id,
+          const std::string &after_asset_id,
+          size_t limit) override;
+      nonstd::optional<std::vector<model::AccountAsset>> getAssetHolders(
+          const std::string &asset_id,
+          const std::string &after_account_id,
+          size_t limit) override;
+      nonstd::optional<std::vector<model::Account>> getDomainAccounts(
+          const std::string &domain_id,
+          const std::string &after_account_id,
+          size_t limit) override;
+      nonstd::optional<std::vector<std::string>> getAccountsBySignatory(
+          const ed25519::pubkey_t &signatory,
+          const std::string &after_account_id,
+          size_t limit) override;
+      nonstd::optional<std::vector<model::Peer>> getPeers() override;
+
+      bool insertAccount(const model::Account &account) override;
+      bool updateAccount(const model::Account &account) override;
+      bool insertAsset(const model::Asset &asset) override;
+      bool upsertAccountAsset(const model::AccountAsset &asset) override;
+      bool insertSignatory(const ed25519::pubkey_t &signatory) override;
+      bool insertAccountSignatory(const std::string &account_id,
+                                  const ed25519::pubkey_t &signatory) override;
+      bool deleteAccountSignatory(const std::string &account_id,
+                                  const ed25519::pubkey_t &signatory) override;
+      bool insertPeer(const model::Peer &peer) override;
+      bool deletePeer(const model::Peer &peer) override;
+      bool insertDomain(const model::Domain &domain) override;
+
+     private:
+      BulkTables &tables_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+#endif  // IROHA_BULK_WSV_HPP
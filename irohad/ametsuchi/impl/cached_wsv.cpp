@@ -0,0 +1,335 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/cached_wsv.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    CachedWsv::CachedWsv(std::unique_ptr<WsvQuery> wsv,
+                         std::unique_ptr<WsvCommand> executor,
+                         bool defer_asset_writes)
+        : wsv_(std::move(wsv)),
+          executor_(std::move(executor)),
+          defer_asset_writes_(defer_asset_writes),
+          in_savepoint_(false),
+          savepoint_opened_(false) {}
+
+    bool CachedWsv::flush() {
+      std::vector<model::AccountAsset> assets;
+      assets.reserve(pending_assets_.entries().size());
+      for (const auto &entry : pending_assets_.entries()) {
+        assets.push_back(*entry.second);
+      }
+      if (not assets.empty() and not writer().upsertAccountAssets(assets)) {
+        return false;
+      }
+      pending_assets_.clear();
+      return true;
+    }
+
+    WsvCommand &CachedWsv::writer() {
+      if (in_savepoint_ and not savepoint_opened_) {
+        open_savepoint_();
+        savepoint_opened_ = true;
+      }
+      return *executor_;
+    }
+
+    void CachedWsv::savepoint(std::function<void()> open) {
+      in_savepoint_ = true;
+      open_savepoint_ = std::move(open);
+      savepoint_opened_ = false;
+    }
+
+    bool CachedWsv::releaseSavepoint() {
+      accounts_.release();
+      signatories_.release();
+      assets_.release();
+      account_assets_.release();
+      pending_assets_.release();
+      peers_.release();
+      in_savepoint_ = false;
+      return savepoint_opened_;
+    }
+
+    bool CachedWsv::rollbackToSavepoint() {
+      accounts_.rollback();
+      signatories_.rollback();
+      assets_.rollback();
+      account_assets_.rollback();
+      pending_assets_.rollback();
+      peers_.rollback();
+      in_savepoint_ = false;
+      return savepoint_opened_;
+    }
+
+    void CachedWsv::discardWrites() {
+      accounts_.discardWrites();
+      signatories_.discardWrites();
+      assets_.discardWrites();
+      account_assets_.discardWrites();
+      pending_assets_.clear();
+      peers_.discardWrites();
+      in_savepoint_ = false;
+      savepoint_opened_ = false;
+    }
+
+    void CachedWsv::clear() {
+      accounts_.clear();
+      signatories_.clear();
+      assets_.clear();
+      account_assets_.clear();
+      pending_assets_.clear();
+      peers_.clear();
+      in_savepoint_ = false;
+      savepoint_opened_ = false;
+    }
+
+    template <typename Key, typename Value>
+    nonstd::optional<Value> CachedWsv::lookup(
+        Table<Key, Value> &table,
+        nonstd::optional<Key> key,
+        std::function<Key()> intern,
+        std::function<nonstd::optional<Value>()> load) {
+      if (key) {
+        return table.get(*key, std::move(load));
+      }
+      // identifier which is not interned has not been seen in existing
+      // entry, so interning misses would grow the table with any input
+      auto value = load();
+      if (value) {
+        table.get(intern(), [&value] { return value; });
+      }
+      return value;
+    }
+
+    nonstd::optional<std::vector<model::AccountAsset>>
+    CachedWsv::withPendingAssets(
+        nonstd::optional<std::vector<model::AccountAsset>> page,
+        std::string model::AccountAsset::*key,
+        const std::string &after,
+        size_t limit,
+        std::function<bool(const model::AccountAsset &)> selects) {
+      if (not page or pending_assets_.entries().empty()) {
+        return page;
+      }
+      // deferred writes are upserts, so rows of the merged page are among
+      // rows of the database page and deferred ones
+      std::map<std::string, model::AccountAsset> rows;
+      for (auto &asset : *page) {
+        auto row_key = asset.*key;
+        rows.emplace(std::move(row_key), std::move(asset));
+      }
+      for (const auto &entry : pending_assets_.entries()) {
+        if (entry.second and (*entry.second).*key > after
+            and selects(*entry.second)) {
+          rows[(*entry.second).*key] = *entry.second;
+        }
+      }
+      page->clear();
+      for (auto &row : rows) {
+        if (limit != 0 and page->size() == limit) {
+          break;
+        }
+        page->push_back(std::move(row.second));
+      }
+      return page;
+    }
+
+    nonstd::optional<model::Account> CachedWsv::getAccount(
+        const std::string &account_id) {
+      return lookup<model::InternedId, model::Account>(
+          accounts_,
+          model::InternedId::find(account_id),
+          [&] { return model::InternedId(account_id); },
+          [&] { return wsv_->getAccount(account_id); });
+    }
+
+    nonstd::optional<std::vector<ed25519::pubkey_t>>
+    CachedWsv::getSignatories(const std::string &account_id) {
+      return lookup<model::InternedId, std::vector<ed25519::pubkey_t>>(
+          signatories_,
+          model::InternedId::find(account_id),
+          [&] { return model::InternedId(account_id); },
+          [&] { return wsv_->getSignatories(account_id); });
+    }
+
+    nonstd::optional<model::Asset> CachedWsv::getAsset(
+        const std::string &asset_id) {
+      return lookup<model::InternedId, model::Asset>(
+          assets_,
+          model::InternedId::find(asset_id),
+          [&] { return model::InternedId(asset_id); },
+          [&] { return wsv_->getAsset(asset_id); });
+    }
+
+    nonstd::optional<model::AccountAsset> CachedWsv::getAccountAsset(
+        const std::string &account_id, const std::string &asset_id) {
+      auto account = model::InternedId::find(account_id);
+      auto asset = model::InternedId::find(asset_id);
+      nonstd::optional<AssetKey> key;
+      if (account and asset) {
+        key = AssetKey(*account, *asset);
+      }
+      return lookup<AssetKey, model::AccountAsset>(
+          account_assets_,
+          key,
+          [&] {
+            return AssetKey(model::InternedId(account_id),
+                            model::InternedId(asset_id));
+          },
+          [&] { return wsv_->getAccountAsset(account_id, asset_id); });
+    }
+
+    nonstd::optional<std::vector<model::AccountAsset>>
+    CachedWsv::getAccountAssets(const std::string &account_id,
+                                const std::string &after_asset_id,
+                                size_t limit) {
+      // deferred writes are not seen by wrapped query
+      return withPendingAssets(
+          wsv_->getAccountAssets(account_id, after_asset_id, limit),
+          &model::AccountAsset::asset_id,
+          after_asset_id,
+          limit,
+          [&account_id](const model::AccountAsset &asset) {
+            return asset.account_id == account_id;
+          });
+    }
+
+    nonstd::optional<std::vector<model::AccountAsset>>
+    CachedWsv::getAssetHolders(const std::string &asset_id,
+                               const std::string &after_account_id,
+                               size_t limit) {
+      // deferred writes are not seen by wrapped query
+      return withPendingAssets(
+          wsv_->getAssetHolders(asset_id, after_account_id, limit),
+          &model::AccountAsset::account_id,
+          after_account_id,
+          limit,
+          [&asset_id](const model::AccountAsset &asset) {
+            return asset.asset_id == asset_id;
+          });
+    }
+
+    nonstd::optional<std::vector<model::Account>>
+    CachedWsv::getDomainAccounts(const std::string &domain_id,
+                                 const std::string &after_account_id,
+                                 size_t limit) {
+      return wsv_->getDomainAccounts(domain_id, after_account_id, limit);
+    }
+
+    nonstd::optional<std::vector<std::string>>
+    CachedWsv::getAccountsBySignatory(const ed25519::pubkey_t &signatory,
+                                      const std::string &after_account_id,
+                                      size_t limit) {
+      return wsv_->getAccountsBySignatory(signatory, after_account_id, limit);
+    }
+
+    nonstd::optional<std::vector<model::Peer>> CachedWsv::getPeers() {
+      return peers_.get(true, [&] { return wsv_->getPeers(); });
+    }
+
+    bool CachedWsv::insertAccount(const model::Account &account) {
+      if (not writer().insertAccount(account)) {
+        return false;
+      }
+      accounts_.set(
+          model::InternedId(account.account_id), account, in_savepoint_);
+      return true;
+    }
+
+    bool CachedWsv::updateAccount(const model::Account &account) {
+      if (not writer().updateAccount(account)) {
+        return false;
+      }
+      accounts_.set(
+          model::InternedId(account.account_id), account, in_savepoint_);
+      return true;
+    }
+
+    bool CachedWsv::insertAsset(const model::Asset &asset) {
+      if (not writer().insertAsset(asset)) {
+        return false;
+      }
+      assets_.set(model::InternedId(asset.asset_id), asset, in_savepoint_);
+      return true;
+    }
+
+    bool CachedWsv::upsertAccountAsset(const model::AccountAsset &asset) {
+      if (defer_asset_writes_) {
+        // foreign keys are checked here, since the row is written later
+        if (not getAccount(asset.account_id) or not getAsset(asset.asset_id)) {
+          return false;
+        }
+      } else if (not writer().upsertAccountAsset(asset)) {
+        return false;
+      }
+      // account and asset exist, so their identifiers are interned
+      AssetKey key(model::InternedId(asset.account_id),
+                   model::InternedId(asset.asset_id));
+      if (defer_asset_writes_) {
+        pending_assets_.set(key, asset, in_savepoint_);
+      }
+      account_assets_.set(key, asset, in_savepoint_);
+      return true;
+    }
+
+    bool CachedWsv::insertSignatory(const ed25519::pubkey_t &signatory) {
+      return writer().insertSignatory(signatory);
+    }
+
+    bool CachedWsv::insertAccountSignatory(
+        const std::string &account_id, const ed25519::pubkey_t &signatory) {
+      if (not writer().insertAccountSignatory(account_id, signatory)) {
+        return false;
+      }
+      signatories_.invalidate(model::InternedId(account_id), in_savepoint_);
+      return true;
+    }
+
+    bool CachedWsv::deleteAccountSignatory(
+        const std::string &account_id, const ed25519::pubkey_t &signatory) {
+      if (not writer().deleteAccountSignatory(account_id, signatory)) {
+        return false;
+      }
+      signatories_.invalidate(model::InternedId(account_id), in_savepoint_);
+      return true;
+    }
+
+    bool CachedWsv::insertPeer(const model::Peer &peer) {
+      if (not writer().insertPeer(peer)) {
+        return false;
+      }
+      peers_.invalidate(true, in_savepoint_);
+      return true;
+    }
+
+    bool CachedWsv::deletePeer(const model::Peer &peer) {
+      if (not writer().deletePeer(peer)) {
+        return false;
+      }
+      peers_.invalidate(true, in_savepoint_);
+      return true;
+    }
+
+    bool CachedWsv::insertDomain(const model::Domain &domain) {
+      return writer().insertDomain(domain);
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
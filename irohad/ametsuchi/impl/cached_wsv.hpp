@@ -0,0 +1,289 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_CACHED_WSV_HPP
+#define IROHA_CACHED_WSV_HPP
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+#include "ametsuchi/wsv_command.hpp"
+#include "ametsuchi/wsv_query.hpp"
+#include "model/interned_id.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * World state view with in-memory overlay over wrapped query and command.
+     * Results of queries are kept in memory, so repeated lookups of the same
+     * keys do not reach the database. Writes are passed through to the
+     * wrapped command and update the overlay on success, except deferred
+     * account assets, which are merged into pages of account assets and
+     * asset holders read from wrapped query until flush.
+     * Savepoints are kept in memory: overlay changes made after savepoint are
+     * recorded in undo log, and database savepoint is opened only before the
+     * first write which reaches the database. So transactions which are
+     * served from memory cost no database round-trips.
+     * Results are keyed by interned identifiers. Identifiers are interned
+     * once they are known to exist, misses of other ones are not cached.
+     */
+    class CachedWsv : public WsvQuery, public WsvCommand {
+     public:
+      /**
+       * @param wsv - wrapped query
+       * @param executor - wrapped command
+       * @param defer_asset_writes - keep account asset writes in memory until
+       * flush, instead of passing each of them to the database
+       */
+      CachedWsv(std::unique_ptr<WsvQuery> wsv,
+                std::unique_ptr<WsvCommand> executor,
+                bool defer_asset_writes = false);
+
+      /**
+       * Write deferred account assets with one batch
+       * @return true on success
+       */
+      bool flush();
+
+      /**
+       * Start recording overlay changes
+       * @param open - opens database savepoint, called before the first
+       * write passed to the database
+       */
+      void savepoint(std::function<void()> open);
+
+      /**
+       * Keep changes made since savepoint
+       * @return true if database savepoint was opened and has to be released
+       */
+      bool releaseSavepoint();
+
+      /**
+       * Undo changes made since savepoint
+       * @return true if database savepoint was opened and has to be rolled
+       * back
+       */
+      bool rollbackToSavepoint();
+
+      /**
+       * Forget writes, when wrapped database changes are discarded. Cached
+       * results of keys which were not written stay valid
+       */
+      void discardWrites();
+
+      /**
+       * Forget all cached results, when wrapped state has changed
+       */
+      void clear();
+
+      nonstd::optional<model::Account> getAccount(
+          const std::string &account_id) override;
+      nonstd::optional<std::vector<ed25519::pubkey_t>> getSignatories(
+          const std::string &account_id) override;
+      nonstd::optional<model::Asset> getAsset(
+          const std::string &asset_id) override;
+      nonstd::optional<model::AccountAsset> getAccountAsset(
+          const std::string &account_id, const std::string &asset_id) override;
+      nonstd::optional<std::vector<model::AccountAsset>> getAccountAssets(
+          const std::string &account_id,
+          const std::string &after_asset_id,
+          size_t limit) override;
+      nonstd::optional<std::vector<model::AccountAsset>> getAssetHolders(
+          const std::string &asset_id,
+          const std::string &after_account_id,
+          size_t limit) override;
+      nonstd::optional<std::vector<model::Account>> getDomainAccounts(
+          const std::string &domain_id,
+          const std::string &after_account_id,
+          size_t limit) override;
+      nonstd::optional<std::vector<std::string>> getAccountsBySignatory(
+          const ed25519::pubkey_t &signatory,
+          const std::string &after_account_id,
+          size_t limit) override;
+      nonstd::optional<std::vector<model::Peer>> getPeers() override;
+
+      bool insertAccount(const model::Account &account) override;
+      bool updateAccount(const model::Account &account) override;
+      bool insertAsset(const model::Asset &asset) override;
+      bool upsertAccountAsset(const model::AccountAsset &asset) override;
+      bool insertSignatory(const ed25519::pubkey_t &signatory) override;
+      bool insertAccountSignatory(const std::string &account_id,
+                                  const ed25519::pubkey_t &signatory) override;
+      bool deleteAccountSignatory(const std::string &account_id,
+                                  const ed25519::pubkey_t &signatory) override;
+      bool insertPeer(const model::Peer &peer) override;
+      bool deletePeer(const model::Peer &peer) override;
+      bool insertDomain(const model::Domain &domain) override;
+
+     private:
+      /**
+       * Cached query results of one kind with undo log of changes
+       */
+      template <typename Key, typename Value>
+      class Table {
+       public:
+        using Entry = nonstd::optional<Value>;
+
+        /**
+         * Find cached result or load and cache it
+         */
+        Entry get(const Key &key, std::function<Entry()> load) {
+          auto it = entries_.find(key);
+          if (it != entries_.end()) {
+            return it->second;
+          }
+          auto entry = load();
+          // loaded value is valid both before and after savepoint
+          entries_.emplace(key, entry);
+          return entry;
+        }
+
+        /**
+         * Replace cached result after successful write
+         */
+        void set(const Key &key, Entry entry, bool record) {
+          remember(key, record);
+          written_.insert(key);
+          entries_[key] = std::move(entry);
+        }
+
+        /**
+         * Drop cached result, so it is loaded again
+         */
+        void invalidate(const Key &key, bool record) {
+          remember(key, record);
+          // reloaded result would include the write
+          written_.insert(key);
+          entries_.erase(key);
+        }
+
+        /**
+         * @return all cached results
+         */
+        const std::map<Key, Entry> &entries() const { return entries_; }
+
+        void clear() {
+          entries_.clear();
+          undo_.clear();
+          written_.clear();
+        }
+
+        /**
+         * Drop results of written keys
+         */
+        void discardWrites() {
+          for (const auto &key : written_) {
+            entries_.erase(key);
+          }
+          undo_.clear();
+          written_.clear();
+        }
+
+        void release() { undo_.clear(); }
+
+        void rollback() {
+          for (auto it = undo_.rbegin(); it != undo_.rend(); ++it) {
+            if (it->second) {
+              entries_[it->first] = std::move(*it->second);
+            } else {
+              entries_.erase(it->first);
+            }
+          }
+          undo_.clear();
+        }
+
+       private:
+        void remember(const Key &key, bool record) {
+          if (not record) {
+            return;
+          }
+          auto it = entries_.find(key);
+          undo_.emplace_back(key,
+                             it == entries_.end()
+                                 ? nonstd::optional<Entry>()
+                                 : nonstd::optional<Entry>(it->second));
+        }
+
+        std::map<Key, Entry> entries_;
+        std::vector<std::pair<Key, nonstd::optional<Entry>>> undo_;
+        // keys written since creation or the last discard
+        std::set<Key> written_;
+      };
+
+      using AssetKey = std::pair<model::InternedId, model::InternedId>;
+
+      /**
+       * Look up cached result by interned key, or load it. Result for key
+       * which is not interned is cached only if it exists
+       * @param key - interned key, nullopt if key is not interned
+       * @param intern - interns the key
+       * @param load - loads result from wrapped query
+       */
+      template <typename Key, typename Value>
+      nonstd::optional<Value> lookup(
+          Table<Key, Value> &table,
+          nonstd::optional<Key> key,
+          std::function<Key()> intern,
+          std::function<nonstd::optional<Value>()> load);
+
+      /**
+       * Merge deferred account assets into page of wrapped query, since
+       * they are not in the database until flush
+       * @param page - page of wrapped query in order of key
+       * @param key - field which orders the page
+       * @param after - rows with key up to this one are not in the page
+       * @param limit - maximal number of rows, 0 for all of them
+       * @param selects - tells whether deferred asset belongs to the query
+       * @return page with deferred assets in their places
+       */
+      nonstd::optional<std::vector<model::AccountAsset>> withPendingAssets(
+          nonstd::optional<std::vector<model::AccountAsset>> page,
+          std::string model::AccountAsset::*key,
+          const std::string &after,
+          size_t limit,
+          std::function<bool(const model::AccountAsset &)> selects);
+
+      /**
+       * Wrapped command, opens database savepoint if it is not opened yet
+       */
+      WsvCommand &writer();
+
+      std::unique_ptr<WsvQuery> wsv_;
+      std::unique_ptr<WsvCommand> executor_;
+
+      Table<model::InternedId, model::Account> accounts_;
+      Table<model::InternedId, std::vector<ed25519::pubkey_t>> signatories_;
+      Table<model::InternedId, model::Asset> assets_;
+      Table<AssetKey, model::AccountAsset> account_assets_;
+      // account assets written since last flush in deferred mode
+      Table<AssetKey, model::AccountAsset> pending_assets_;
+      // peers are cached as a single entry
+      Table<bool, std::vector<model::Peer>> peers_;
+
+      const bool defer_asset_writes_;
+      bool in_savepoint_;
+      std::function<void()> open_savepoint_;
+      bool savepoint_opened_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+#endif  // IROHA_CACHED_WSV_HPP
@@ -0,0 +1,119 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_CONNECTION_POOL_HPP
+#define IROHA_CONNECTION_POOL_HPP
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Connection taken from pool, returned to it on destruction
+     */
+    template <typename T>
+    using PooledConnection = std::unique_ptr<T, std::function<void(T *)>>;
+
+    /**
+     * Bounded pool of ready connections.
+     * Connections are checked before they are handed out and when they are
+     * returned, broken ones are dropped. Pool may be destroyed before its
+     * connections, which are closed then on return.
+     */
+    template <typename T>
+    class ConnectionPool {
+     public:
+      using Factory = std::function<std::unique_ptr<T>()>;
+      using Check = std::function<bool(T &)>;
+
+      /**
+       * @param capacity - maximal number of idle connections kept
+       * @param factory - opens new connection, returns nullptr on failure
+       * @param healthy - checks that connection is usable
+       */
+      ConnectionPool(size_t capacity, Factory factory, Check healthy)
+          : factory_(std::move(factory)),
+            state_(std::make_shared<State>(capacity, std::move(healthy))) {}
+
+      /**
+       * Take idle connection or open new one if there is no healthy idle
+       * connection
+       * @return connection or nullptr if it can not be opened
+       */
+      PooledConnection<T> acquire() {
+        std::unique_ptr<T> connection;
+        {
+          std::lock_guard<std::mutex> lock(state_->lock);
+          while (not connection and not state_->idle.empty()) {
+            connection = std::move(state_->idle.back());
+            state_->idle.pop_back();
+            if (not state_->healthy(*connection)) {
+              connection.reset();
+            }
+          }
+        }
+        if (not connection) {
+          connection = factory_();
+        }
+        if (not connection) {
+          return PooledConnection<T>(nullptr, [](T *) {});
+        }
+        std::weak_ptr<State> state = state_;
+        return PooledConnection<T>(connection.release(), [state](T *raw) {
+          std::unique_ptr<T> connection(raw);
+          auto pool = state.lock();
+          if (not pool) {
+            return;
+          }
+          std::lock_guard<std::mutex> lock(pool->lock);
+          if (pool->idle.size() < pool->capacity and
+              pool->healthy(*connection)) {
+            pool->idle.push_back(std::move(connection));
+          }
+        });
+      }
+
+      /**
+       * @return number of idle connections
+       */
+      size_t idle() const {
+        std::lock_guard<std::mutex> lock(state_->lock);
+        return state_->idle.size();
+      }
+
+     private:
+      struct State {
+        State(size_t capacity, Check healthy)
+            : capacity(capacity), healthy(std::move(healthy)) {}
+
+        const size_t capacity;
+        const Check healthy;
+        std::vector<std::unique_ptr<T>> idle;
+        std::mutex lock;
+      };
+
+      Factory factory_;
+      std::shared_ptr<State> state_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+#endif  // IROHA_CONNECTION_POOL_HPP
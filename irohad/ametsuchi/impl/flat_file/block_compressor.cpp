@@ -0,0 +1,247 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/flat_file/block_compressor.hpp"
+#include <zdict.h>
+#include <zstd.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace iroha {
+  namespace ametsuchi {
+
+    namespace {
+      const uint8_t kCodecZstd = 0xC1;
+      const uint8_t kCodecZstdDictionary = 0xC2;
+      const size_t kFrameHeaderSize = sizeof(uint8_t) + sizeof(uint32_t);
+      const size_t kDictionaryCapacity = 16 * 1024;
+      const std::string kDictionaryExtension = ".dict";
+    }  // namespace
+
+    struct BlockCompressor::Dictionary {
+      Dictionary(const std::vector<uint8_t> &bytes, int level)
+          : compress(ZSTD_createCDict(bytes.data(), bytes.size(), level)),
+            decompress(ZSTD_createDDict(bytes.data(), bytes.size())) {}
+
+      ~Dictionary() {
+        ZSTD_freeCDict(compress);
+        ZSTD_freeDDict(decompress);
+      }
+
+      ZSTD_CDict *compress;
+      ZSTD_DDict *decompress;
+    };
+
+    BlockCompressor::BlockCompressor(const std::string &path, int level)
+        : path_(path), level_(level) {
+      log_ = logger::log("BlockCompressor");
+    }
+
+    uint32_t BlockCompressor::segmentStart(uint32_t id) {
+      return id - (id - 1) % kSegmentBlocks;
+    }
+
+    std::string BlockCompressor::dictionaryName(uint32_t segment) const {
+      std::string name(16, '\0');
+      sprintf(&name[0], "%016u", segment);
+      return path_ + "/" + name + kDictionaryExtension;
+    }
+
+    std::shared_ptr<const BlockCompressor::Dictionary>
+    BlockCompressor::dictionary(uint32_t segment) {
+      auto it = dictionaries_.find(segment);
+      if (it != dictionaries_.end()) {
+        return it->second;
+      }
+      if (missing_.count(segment) != 0) {
+        return nullptr;
+      }
+      std::ifstream file(dictionaryName(segment), std::ios::binary);
+      std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)),
+                                 std::istreambuf_iterator<char>());
+      if (bytes.empty()) {
+        missing_.insert(segment);
+        return nullptr;
+      }
+      auto result = std::make_shared<const Dictionary>(bytes, level_);
+      if (not result->compress or not result->decompress) {
+        log_->error("Dictionary of segment {} is damaged", segment);
+        missing_.insert(segment);
+        return nullptr;
+      }
+      dictionaries_.emplace(segment, result);
+      return result;
+    }
+
+    bool BlockCompressor::needsDictionary(uint32_t id) {
+      auto segment = segmentStart(id);
+      if (id - segment < kTrainingBlocks) {
+        return false;
+      }
+      std::lock_guard<std::mutex> lock(dictionaries_lock_);
+      return untrainable_.count(segment) == 0 and not dictionary(segment);
+    }
+
+    bool BlockCompressor::train(
+        uint32_t id, const std::vector<std::vector<uint8_t>> &samples) {
+      auto segment = segmentStart(id);
+      std::vector<uint8_t> buffer;
+      std::vector<size_t> sizes;
+      for (const auto &sample : samples) {
+        buffer.insert(buffer.end(), sample.begin(), sample.end());
+        sizes.push_back(sample.size());
+      }
+      std::vector<uint8_t> bytes(kDictionaryCapacity);
+      auto size = ZDICT_trainFromBuffer(bytes.data(), bytes.size(),
+                                        buffer.data(), sizes.data(),
+                                        sizes.size());
+
+      std::lock_guard<std::mutex> lock(dictionaries_lock_);
+      if (ZDICT_isError(size)) {
+        log_->info("Segment {} is compressed without dictionary: {}",
+                   segment, ZDICT_getErrorName(size));
+        untrainable_.insert(segment);
+        return false;
+      }
+      bytes.resize(size);
+
+      // rename is atomic, so dictionary is either complete or missing
+      auto name = dictionaryName(segment);
+      auto tmp_name = name + ".tmp";
+      {
+        std::ofstream file(tmp_name, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+        if (not file.flush()) {
+          untrainable_.insert(segment);
+          return false;
+        }
+      }
+      if (std::rename(tmp_name.c_str(), name.c_str()) != 0) {
+        untrainable_.insert(segment);
+        return false;
+      }
+      missing_.erase(segment);
+      dictionaries_.emplace(segment,
+                            std::make_shared<const Dictionary>(bytes, level_));
+      return true;
+    }
+
+    std::vector<uint8_t> BlockCompressor::compress(
+        uint32_t id, const std::vector<uint8_t> &block) {
+      if (block.size() > kMaxBlockSize) {
+        return block;
+      }
+      std::shared_ptr<const Dictionary> dict;
+      {
+        std::lock_guard<std::mutex> lock(dictionaries_lock_);
+        dict = dictionary(segmentStart(id));
+      }
+
+      std::vector<uint8_t> frame(kFrameHeaderSize +
+                                 ZSTD_compressBound(block.size()));
+      size_t size;
+      if (dict) {
+        auto context = ZSTD_createCCtx();
+        size = ZSTD_compress_usingCDict(context,
+                                        frame.data() + kFrameHeaderSize,
+                                        frame.size() - kFrameHeaderSize,
+                                        block.data(),
+                                        block.size(),
+                                        dict->compress);
+        ZSTD_freeCCtx(context);
+      } else {
+        size = ZSTD_compress(frame.data() + kFrameHeaderSize,
+                             frame.size() - kFrameHeaderSize,
+                             block.data(),
+                             block.size(),
+                             level_);
+      }
+      if (ZSTD_isError(size)) {
+        log_->error("Cannot compress block {}", id);
+        return block;
+      }
+      // keep incompressible blocks as is unless they could be taken for frame
+      if (kFrameHeaderSize + size >= block.size() and
+          not isCompressed(block.data(), block.size())) {
+        return block;
+      }
+
+      frame[0] = dict ? kCodecZstdDictionary : kCodecZstd;
+      auto raw_size = static_cast<uint32_t>(block.size());
+      std::memcpy(&frame[1], &raw_size, sizeof(raw_size));
+      frame.resize(kFrameHeaderSize + size);
+      return frame;
+    }
+
+    nonstd::optional<std::vector<uint8_t>> BlockCompressor::decompress(
+        uint32_t id, const uint8_t *data, size_t size) {
+      if (not isCompressed(data, size)) {
+        return nonstd::nullopt;
+      }
+      uint32_t raw_size;
+      std::memcpy(&raw_size, data + 1, sizeof(raw_size));
+      auto content_size = ZSTD_getFrameContentSize(data + kFrameHeaderSize,
+                                                   size - kFrameHeaderSize);
+      if (raw_size > kMaxBlockSize or content_size != raw_size) {
+        log_->error("Frame of block {} declares invalid size {}",
+                    id,
+                    raw_size);
+        return nonstd::nullopt;
+      }
+      std::vector<uint8_t> block(raw_size);
+
+      size_t result;
+      if (data[0] == kCodecZstdDictionary) {
+        std::shared_ptr<const Dictionary> dict;
+        {
+          std::lock_guard<std::mutex> lock(dictionaries_lock_);
+          dict = dictionary(segmentStart(id));
+        }
+        if (not dict) {
+          log_->error("Missing dictionary of block {}", id);
+          return nonstd::nullopt;
+        }
+        auto context = ZSTD_createDCtx();
+        result = ZSTD_decompress_usingDDict(context,
+                                            block.data(),
+                                            block.size(),
+                                            data + kFrameHeaderSize,
+                                            size - kFrameHeaderSize,
+                                            dict->decompress);
+        ZSTD_freeDCtx(context);
+      } else {
+        result = ZSTD_decompress(block.data(),
+                                 block.size(),
+                                 data + kFrameHeaderSize,
+                                 size - kFrameHeaderSize);
+      }
+      if (ZSTD_isError(result) or result != raw_size) {
+        log_->error("Cannot decompress block {}", id);
+        return nonstd::nullopt;
+      }
+      return block;
+    }
+
+    bool BlockCompressor::isCompressed(const uint8_t *data, size_t size) {
+      return size >= kFrameHeaderSize and
+          (data[0] == kCodecZstd or data[0] == kCodecZstdDictionary);
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
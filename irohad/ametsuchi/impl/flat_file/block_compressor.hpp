@@ -0,0 +1,139 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_BLOCK_COMPRESSOR_HPP
+#define IROHA_BLOCK_COMPRESSOR_HPP
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <nonstd/optional.hpp>
+#include <set>
+#include <string>
+#include <vector>
+#include "logger/logger.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Transparent zstd compression of stored blocks.
+     * Compressed block is framed as [uint8 codec][uint32 size][payload],
+     * blocks with another first byte are stored as is. Serialized blocks
+     * start with '{' or format tag, so they never look like a frame.
+     * Blocks are grouped into segments of consecutive ids, each segment gets
+     * its own dictionary trained on its first blocks, which are compressed
+     * without dictionary.
+     */
+    class BlockCompressor {
+     public:
+      /**
+       * Number of blocks sharing one dictionary
+       */
+      static constexpr uint32_t kSegmentBlocks = 1024;
+
+      /**
+       * Number of first blocks of segment used for dictionary training
+       */
+      static constexpr uint32_t kTrainingBlocks = 128;
+
+      /**
+       * Largest block which is framed, size in frame header is checked
+       * against it before output is allocated, so damaged frame cannot
+       * demand arbitrary memory
+       */
+      static constexpr uint32_t kMaxBlockSize = 256 * 1024 * 1024;
+
+      /**
+       * @param path - directory to keep dictionaries in
+       * @param level - zstd compression level
+       */
+      explicit BlockCompressor(const std::string &path, int level = 3);
+
+      /**
+       * @param id - id of block to be compressed
+       * @return true if dictionary of block's segment is to be trained first
+       */
+      bool needsDictionary(uint32_t id);
+
+      /**
+       * Train and persist dictionary of the segment
+       * @param id - id of block in the segment
+       * @param samples - first blocks of the segment
+       * @return true if dictionary is created, otherwise segment is
+       * compressed without dictionary
+       */
+      bool train(uint32_t id, const std::vector<std::vector<uint8_t>> &samples);
+
+      /**
+       * @param id - id of the block
+       * @param block - serialized block
+       * @return framed block, or the block itself if it does not compress
+       * or is larger than kMaxBlockSize
+       */
+      std::vector<uint8_t> compress(uint32_t id,
+                                    const std::vector<uint8_t> &block);
+
+      /**
+       * @param id - id of the block
+       * @param data - stored bytes, must be a frame
+       * @param size - number of stored bytes
+       * @return serialized block, nullopt if frame is damaged or declares
+       * size above kMaxBlockSize
+       */
+      nonstd::optional<std::vector<uint8_t>> decompress(uint32_t id,
+                                                        const uint8_t *data,
+                                                        size_t size);
+
+      /**
+       * @return true if stored bytes are compressed frame
+       */
+      static bool isCompressed(const uint8_t *data, size_t size);
+
+      /**
+       * @return first id of segment which contains the block
+       */
+      static uint32_t segmentStart(uint32_t id);
+
+     private:
+      struct Dictionary;
+
+      /**
+       * Find dictionary of the segment, loading it from disk if needed
+       * Must be called under dictionaries lock.
+       * @return dictionary or nullptr if segment has none
+       */
+      std::shared_ptr<const Dictionary> dictionary(uint32_t segment);
+
+      std::string dictionaryName(uint32_t segment) const;
+
+      const std::string path_;
+      const int level_;
+
+      // segments without dictionary on disk
+      std::set<uint32_t> missing_;
+      // segments whose blocks do not give a usable dictionary
+      std::set<uint32_t> untrainable_;
+      std::map<uint32_t, std::shared_ptr<const Dictionary>> dictionaries_;
+      std::mutex dictionaries_lock_;
+
+      logger::Logger log_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+#endif  // IROHA_BLOCK_COMPRESSOR_HPP
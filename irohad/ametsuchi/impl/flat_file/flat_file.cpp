@@ -17,9 +17,20 @@
 
 #include "ametsuchi/impl/flat_file/flat_file.hpp"
 #include <dirent.h>
+#include <fcntl.h>
 #include <stdio.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
 #include <iostream>
+#include "ametsuchi/impl/mapped_region.hpp"
+#include "crypto/crc32c.hpp"
+
+extern "C" {
+#include <crypto/lookup3.h>
+}
 
 std::string id_to_name(uint32_t id) {
   std::string new_id(16, '\0');
@@ -40,34 +51,50 @@ void remove(std::string dump_dir, uint32_t id) {
   }
 }
 
-nonstd::optional<uint32_t> check_consistency(std::string dump_dir) {
-  uint32_t tmp_id = 0u;
+int is_tmp_file(const struct dirent *entry) {
+  auto name = std::string(entry->d_name);
+  return name.size() > 4 and name.compare(name.size() - 4, 4, ".tmp") == 0;
+}
+
+int is_block_file(const struct dirent *entry) {
+  auto name = std::string(entry->d_name);
+  return name.size() == 16 and
+      std::all_of(name.begin(), name.end(), ::isdigit);
+}
+
+nonstd::optional<uint32_t> check_consistency(std::string dump_dir,
+                                             uint32_t oldest_id) {
+  uint32_t tmp_id = oldest_id - 1;
   if (!dump_dir.empty()) {
     // Directory iterator:
     struct dirent **namelist;
-    auto status = scandir(dump_dir.c_str(), &namelist, NULL, alphasort);
+    auto status =
+        scandir(dump_dir.c_str(), &namelist, is_block_file, alphasort);
     if (status < 0) {
       // TODO: handle internal error
       return nonstd::nullopt;
-    } else if (status > 2) {
-      uint n = status;
-      tmp_id++;
-      uint i = 1;
-      while (++i < n) {
-        if (id_to_name(tmp_id) != namelist[i]->d_name) {
-          for (uint j = i; j < n; ++j) {
-            remove(dump_dir, name_to_id(namelist[j]->d_name));
-          }
-          break;
+    }
+    uint n = status;
+    for (uint i = 0; i < n; ++i) {
+      // left by interrupted pruning
+      if (name_to_id(namelist[i]->d_name) < oldest_id) {
+        remove(dump_dir, name_to_id(namelist[i]->d_name));
+        continue;
+      }
+      // blocks must be consecutive, everything after a gap is dropped
+      if (id_to_name(tmp_id + 1) != namelist[i]->d_name) {
+        for (uint j = i; j < n; ++j) {
+          remove(dump_dir, name_to_id(namelist[j]->d_name));
         }
-        tmp_id = name_to_id(namelist[i]->d_name);
+        break;
       }
+      ++tmp_id;
+    }
 
-      for (uint j = 0; j < n; ++j) {
-        free(namelist[j]);
-      }
-      free(namelist);
+    for (uint j = 0; j < n; ++j) {
+      free(namelist[j]);
     }
+    free(namelist);
 
   } else {
     // Not a directory
@@ -77,37 +104,351 @@ nonstd::optional<uint32_t> check_consistency(std::string dump_dir) {
   return tmp_id;
 }
 
+namespace {
+  const std::string kTmpExtension = ".tmp";
+  const char kFrameMagic[4] = {'I', 'R', 'B', 'F'};
+
+  /**
+   * Header of block file, followed by size bytes of block
+   */
+  struct FrameHeader {
+    char magic[4];
+    uint32_t size;
+    uint32_t crc;
+  };
+
+  /**
+   * Check frame of block file and skip its header
+   * Files without frame are written by earlier versions and taken as is.
+   * @param data - contents of file, set to beginning of block
+   * @param size - size of file, set to size of block
+   * @return false if frame is torn or damaged
+   */
+  bool unframe(const uint8_t *&data, size_t &size) {
+    FrameHeader header;
+    if (size < sizeof(header) or
+        std::memcmp(data, kFrameMagic, sizeof(kFrameMagic)) != 0) {
+      return true;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (header.size != size - sizeof(header) or
+        iroha::crc32c(data + sizeof(header), header.size) != header.crc) {
+      return false;
+    }
+    data += sizeof(header);
+    size = header.size;
+    return true;
+  }
+
+  const std::string kManifestName = "manifest";
+  const char kManifestMagic[4] = {'I', 'R', 'F', 'M'};
+  const uint32_t kManifestVersion = 1;
+  const uint32_t kChecksumSeed = 1337;
+
+  /**
+   * Layout of manifest file
+   */
+  struct Manifest {
+    char magic[4];
+    uint32_t version;
+    uint32_t last_id;
+    uint32_t checksum;
+    uint64_t last_size;
+  };
+
+  uint32_t checksum(const std::vector<uint8_t> &block) {
+    return hashlittle(block.data(), block.size(), kChecksumSeed);
+  }
+
+  nonstd::optional<Manifest> read_manifest(const std::string &dump_dir) {
+    Manifest manifest;
+    FILE *pfile = fopen((dump_dir + "/" + kManifestName).c_str(), "rb");
+    if (!pfile) {
+      return nonstd::nullopt;
+    }
+    auto read = fread(&manifest, sizeof(Manifest), 1, pfile);
+    fclose(pfile);
+    if (read != 1 or
+        std::memcmp(manifest.magic, kManifestMagic, sizeof(kManifestMagic)) !=
+            0 or
+        manifest.version != kManifestVersion) {
+      return nonstd::nullopt;
+    }
+    return manifest;
+  }
+
+  const std::string kPruneMarkName = "pruned";
+  const char kPruneMarkMagic[4] = {'I', 'R', 'F', 'P'};
+
+  /**
+   * Layout of mark file of pruned storage
+   */
+  struct PruneMark {
+    char magic[4];
+    uint32_t oldest_id;
+  };
+
+  /**
+   * @return id of the oldest kept block, 1 if storage was never pruned
+   */
+  uint32_t read_prune_mark(const std::string &dump_dir) {
+    PruneMark mark;
+    FILE *pfile = fopen((dump_dir + "/" + kPruneMarkName).c_str(), "rb");
+    if (!pfile) {
+      return 1;
+    }
+    auto read = fread(&mark, sizeof(PruneMark), 1, pfile);
+    fclose(pfile);
+    if (read != 1 or
+        std::memcmp(mark.magic, kPruneMarkMagic, sizeof(kPruneMarkMagic)) !=
+            0 or
+        mark.oldest_id == 0) {
+      return 1;
+    }
+    return mark.oldest_id;
+  }
+}  // namespace
+
 namespace iroha {
   namespace ametsuchi {
 
-    FlatFile::FlatFile(uint32_t current_id, const std::string &path)
-        : current_id(current_id), dump_dir(path) {}
+    FlatFile::FlatFile(uint32_t current_id,
+                       const std::string &path,
+                       DurabilityPolicy durability,
+                       BlockCompression compression)
+        : current_id(current_id),
+          oldest_id(1),
+          dump_dir(path),
+          durability(durability),
+          compression(compression),
+          compressor(std::make_unique<BlockCompressor>(path)) {}
 
     FlatFile::~FlatFile() {}
 
-    void FlatFile::add(uint32_t id, const std::vector<uint8_t> &block) {
-      auto next_id = id;
-      std::string file_name = dump_dir + "/" + id_to_name(id);
-      // Write block to binary file
+    bool FlatFile::add(uint32_t id, const std::vector<uint8_t> &block) {
+      return add_batch({{id, block}});
+    }
+
+    bool FlatFile::add_batch(const BlockBatch &blocks) {
+      std::vector<PendingBlock> written;
+      // blocks are flushed before manifest refers to them
+      auto flush = [&] {
+        if (written.empty()) {
+          return true;
+        }
+        auto stored = close_blocks(written);
+        if (stored > 0) {
+          // Update internals, release lock
+          current_id = written[stored - 1].id;
+          write_manifest(*written[stored - 1].block);
+        }
+        sync_directory();
+        auto result = stored == written.size();
+        written.clear();
+        return result;
+      };
+      for (const auto &block : blocks) {
+        // dictionary is trained on blocks, which must be visible already
+        if (compression != BlockCompression::None and
+            compressor->needsDictionary(block.first) and not flush()) {
+          return false;
+        }
+        auto previous = written.empty() ? current_id.load() : written.back().id;
+        if (previous != 0 and block.first <= previous) {
+          // Block already exists
+          continue;
+        }
+        // blocks after a missing one would leave a gap in the chain,
+        // so the batch stops at the first block which is not stored
+        if (previous != 0 and block.first != previous + 1) {
+          flush();
+          return false;
+        }
+        auto fd = write_block(block.first, block.second);
+        if (fd < 0) {
+          flush();
+          return false;
+        }
+        written.push_back({block.first, fd, &block.second});
+        if (durability == DurabilityPolicy::PerBlock and not flush()) {
+          return false;
+        }
+      }
+      return flush();
+    }
+
+    int FlatFile::write_block(uint32_t id,
+                              const std::vector<uint8_t> &block) const {
+      auto file_name = dump_dir + "/" + id_to_name(id);
       if (file_exist(file_name)) {
-        // File already exist
+        // stored blocks are kept untouched
+        return -1;
+      }
+      // block becomes visible only when it is completely written
+      auto tmp_name = file_name + kTmpExtension;
+      auto fd = open(tmp_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+      if (fd < 0) {
+        return -1;
+      }
+      std::vector<uint8_t> compressed;
+      const auto *bytes = &block;
+      if (compression != BlockCompression::None) {
+        compressed = compress(id, block);
+        bytes = &compressed;
+      }
 
-      } else {
-        // New file will be created
-        FILE *pfile;
-        pfile = fopen(file_name.c_str(), "wb");
-        if (!pfile) {
-          // TODO log file error
-          return;
-        }
-        /*auto res = */ fwrite(block.data(), sizeof(uint8_t), block.size(),
-                               pfile);
-        fflush(pfile);
-        fclose(pfile);
+      FrameHeader header;
+      std::memcpy(header.magic, kFrameMagic, sizeof(kFrameMagic));
+      header.size = bytes->size();
+      header.crc = iroha::crc32c(bytes->data(), bytes->size());
+      struct iovec frame[2];
+      frame[0].iov_base = &header;
+      frame[0].iov_len = sizeof(header);
+      frame[1].iov_base = const_cast<uint8_t *>(bytes->data());
+      frame[1].iov_len = bytes->size();
+      if (writev(fd, frame, 2) !=
+          static_cast<ssize_t>(sizeof(header) + bytes->size())) {
+        close(fd);
+        std::remove(tmp_name.c_str());
+        return -1;
+      }
+      return fd;
+    }
 
-        // Update internals, release lock
-        current_id = next_id;
+    std::vector<uint8_t> FlatFile::compress(
+        uint32_t id, const std::vector<uint8_t> &block) const {
+      if (compressor->needsDictionary(id)) {
+        std::vector<std::vector<uint8_t>> samples;
+        auto first_id = BlockCompressor::segmentStart(id);
+        for (auto i = first_id; i < first_id + BlockCompressor::kTrainingBlocks;
+             ++i) {
+          auto sample = get(i);
+          if (sample) {
+            samples.push_back(std::move(*sample));
+          }
+        }
+        compressor->train(id, samples);
       }
+      return compressor->compress(id, block);
+    }
+
+    size_t FlatFile::close_blocks(
+        const std::vector<PendingBlock> &blocks) const {
+      size_t stored = 0;
+      for (size_t i = 0; i < blocks.size(); ++i) {
+        const auto &block = blocks[i];
+        auto file_name = dump_dir + "/" + id_to_name(block.id);
+        auto tmp_name = file_name + kTmpExtension;
+        auto synced = durability == DurabilityPolicy::None or
+            fdatasync(block.fd) == 0;
+        close(block.fd);
+        // blocks after a failed one would leave a gap
+        if (stored < i or not synced or
+            std::rename(tmp_name.c_str(), file_name.c_str()) != 0) {
+          std::remove(tmp_name.c_str());
+          continue;
+        }
+        ++stored;
+      }
+      return stored;
+    }
+
+    void FlatFile::sync_directory() const {
+      if (durability == DurabilityPolicy::None) {
+        return;
+      }
+      auto fd = open(dump_dir.c_str(), O_RDONLY | O_DIRECTORY);
+      if (fd >= 0) {
+        fsync(fd);
+        close(fd);
+      }
+    }
+
+    nonstd::optional<uint32_t> FlatFile::recover_from_manifest() const {
+      auto manifest = read_manifest(dump_dir);
+      if (not manifest) {
+        return nonstd::nullopt;
+      }
+      if (manifest->last_id != 0) {
+        auto block = get(manifest->last_id);
+        if (not block or block->size() != manifest->last_size or
+            checksum(*block) != manifest->checksum) {
+          return nonstd::nullopt;
+        }
+      }
+      // blocks might have been written after the last manifest update
+      auto last_id = manifest->last_id;
+      while (file_exist(dump_dir + "/" + id_to_name(last_id + 1))) {
+        ++last_id;
+      }
+      return last_id;
+    }
+
+    bool FlatFile::write_manifest(
+        const std::vector<uint8_t> &last_block) const {
+      Manifest manifest;
+      std::memcpy(manifest.magic, kManifestMagic, sizeof(kManifestMagic));
+      manifest.version = kManifestVersion;
+      manifest.last_id = current_id;
+      manifest.checksum = checksum(last_block);
+      manifest.last_size = last_block.size();
+
+      // rename is atomic, so manifest is either old or new one
+      auto name = dump_dir + "/" + kManifestName;
+      auto tmp_name = name + ".tmp";
+      FILE *pfile = fopen(tmp_name.c_str(), "wb");
+      if (!pfile) {
+        return false;
+      }
+      auto written = fwrite(&manifest, sizeof(Manifest), 1, pfile);
+      fclose(pfile);
+      return written == 1 and
+          std::rename(tmp_name.c_str(), name.c_str()) == 0;
+    }
+
+    bool FlatFile::write_prune_mark(uint32_t oldest) const {
+      PruneMark mark;
+      std::memcpy(mark.magic, kPruneMarkMagic, sizeof(kPruneMarkMagic));
+      mark.oldest_id = oldest;
+
+      auto name = dump_dir + "/" + kPruneMarkName;
+      auto tmp_name = name + ".tmp";
+      FILE *pfile = fopen(tmp_name.c_str(), "wb");
+      if (!pfile) {
+        return false;
+      }
+      auto written = fwrite(&mark, sizeof(PruneMark), 1, pfile);
+      written = fclose(pfile) == 0 ? written : 0;
+      if (written != 1 or std::rename(tmp_name.c_str(), name.c_str()) != 0) {
+        return false;
+      }
+      // mark must be durable before blocks are removed
+      sync_directory();
+      return true;
+    }
+
+    bool FlatFile::prune(uint32_t id, const std::string &archive_dir) {
+      // the last block keeps manifest and top hash valid
+      id = std::min(id, current_id.load());
+      auto oldest = oldest_id.load();
+      if (id <= oldest) {
+        return true;
+      }
+      if (not write_prune_mark(id)) {
+        return false;
+      }
+      oldest_id = id;
+      auto removed = true;
+      for (auto i = oldest; i < id; ++i) {
+        auto name = dump_dir + "/" + id_to_name(i);
+        auto result = archive_dir.empty()
+            ? std::remove(name.c_str())
+            : std::rename(name.c_str(),
+                          (archive_dir + "/" + id_to_name(i)).c_str());
+        removed = removed and result == 0;
+      }
+      sync_directory();
+      return removed;
     }
 
     nonstd::optional<std::vector<uint8_t>> FlatFile::get(uint32_t id) const {
@@ -118,6 +459,17 @@ namespace iroha {
         FILE *pfile = fopen(filename.c_str(), "rb");
         fread(&buf[0], sizeof(uint8_t), f_size, pfile);
         fclose(pfile);
+        const uint8_t *data = buf.data();
+        size_t size = buf.size();
+        if (not unframe(data, size)) {
+          return nonstd::nullopt;
+        }
+        if (BlockCompressor::isCompressed(data, size)) {
+          return compressor->decompress(id, data, size);
+        }
+        if (data != buf.data()) {
+          buf.erase(buf.begin(), buf.begin() + (data - buf.data()));
+        }
         return buf;
       } else {
         // TODO log block not found
@@ -125,6 +477,40 @@ namespace iroha {
       }
     }
 
+    nonstd::optional<BlockView> FlatFile::view(uint32_t id) const {
+      std::string filename = dump_dir + "/" + id_to_name(id);
+      auto fd = open(filename.c_str(), O_RDONLY);
+      if (fd < 0) {
+        return nonstd::nullopt;
+      }
+      struct stat stat_buf;
+      std::shared_ptr<const MappedRegion> region;
+      if (fstat(fd, &stat_buf) == 0) {
+        region = MappedRegion::map(fd, stat_buf.st_size);
+      }
+      // mapping stays valid after descriptor is closed
+      close(fd);
+      if (not region) {
+        return nonstd::nullopt;
+      }
+      const uint8_t *data = region->data();
+      size_t size = region->size();
+      if (not unframe(data, size)) {
+        return nonstd::nullopt;
+      }
+      if (BlockCompressor::isCompressed(data, size)) {
+        // compressed block can not be served from mapping
+        auto block = compressor->decompress(id, data, size);
+        if (not block) {
+          return nonstd::nullopt;
+        }
+        auto owner = std::make_shared<const std::vector<uint8_t>>(
+            std::move(*block));
+        return BlockView(owner, owner->data(), owner->size());
+      }
+      return BlockView(region, data, size);
+    }
+
     bool FlatFile::file_exist(const std::string &name) const {
       struct stat buffer;
       return (stat(name.c_str(), &buffer) == 0);
@@ -136,18 +522,68 @@ namespace iroha {
       return rc == 0 ? stat_buf.st_size : 0u;
     }
 
-    std::unique_ptr<FlatFile> FlatFile::create(const std::string &path) {
+    std::unique_ptr<FlatFile> FlatFile::create(const std::string &path,
+                                               bool verify_blocks,
+                                               DurabilityPolicy durability,
+                                               BlockCompression compression) {
       // TODO directory check
-      auto res = check_consistency(path);
-      if (!res) {
-        return nullptr;
+      auto store = std::unique_ptr<FlatFile>(
+          new FlatFile(0, path, durability, compression));
+      store->oldest_id = read_prune_mark(path);
+      nonstd::optional<uint32_t> res;
+      if (not verify_blocks) {
+        res = store->recover_from_manifest();
+      }
+      if (not res) {
+        // no trusted manifest, fall back to full scan
+        res = check_consistency(path, store->oldest_id);
+        if (!res) {
+          return nullptr;
+        }
+      }
+      store->current_id = *res;
+      store->remove_torn_tail(verify_blocks ? 1 : store->current_id.load());
+
+      auto manifest = read_manifest(path);
+      if (not manifest or manifest->last_id != store->current_id) {
+        auto last_block = store->get(store->current_id);
+        store->write_manifest(last_block.value_or(std::vector<uint8_t>{}));
+      }
+      return store;
+    }
+
+    void FlatFile::remove_torn_tail(uint32_t from) {
+      // interrupted writes leave only temporary files
+      struct dirent **namelist;
+      auto status = scandir(dump_dir.c_str(), &namelist, is_tmp_file, nullptr);
+      if (status >= 0) {
+        for (auto i = 0; i < status; ++i) {
+          std::remove((dump_dir + "/" + namelist[i]->d_name).c_str());
+          free(namelist[i]);
+        }
+        free(namelist);
+      }
+
+      for (auto id = std::max(from, oldest_id.load()); id <= current_id;
+           ++id) {
+        if (not get(id)) {
+          // damaged block and everything after it are dropped
+          for (auto tail = id; tail <= current_id; ++tail) {
+            remove(dump_dir, tail);
+          }
+          current_id = id - 1;
+          break;
+        }
       }
-      return std::unique_ptr<FlatFile>(new FlatFile(*res, path));
     }
 
     std::string FlatFile::directory() const { return dump_dir; }
 
     uint32_t FlatFile::last_id() const { return current_id; }
 
+    uint32_t FlatFile::first_id() const {
+      return current_id < oldest_id ? 0 : oldest_id.load();
+    }
+
   }  // namespace ametsuchi
 }  // namespace iroha
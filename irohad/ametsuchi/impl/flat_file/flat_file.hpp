@@ -18,29 +18,130 @@
 #ifndef IROHA_FLAT_FILE_HPP
 #define IROHA_FLAT_FILE_HPP
 
+#include <atomic>
 #include <memory>
 #include <nonstd/optional.hpp>
 #include <string>
 #include <vector>
+#include "ametsuchi/impl/block_storage.hpp"
+#include "ametsuchi/impl/flat_file/block_compressor.hpp"
 
 namespace iroha {
   namespace ametsuchi {
-    class FlatFile {
+    /**
+     * Block storage which keeps every block in separate file.
+     * Manifest with id, size and checksum of the last block is kept next to
+     * blocks, so start only has to check the tail written after it.
+     * Blocks may be compressed, which is transparent for readers.
+     * Pruned storage keeps id of its oldest block in a mark file, blocks
+     * before it are removed after the mark is written.
+     */
+    class FlatFile : public BlockStorage {
      public:
-      static std::unique_ptr<FlatFile> create(const std::string &path);
-      ~FlatFile();
-      void add(uint32_t id, const std::vector<uint8_t> &block);
-      nonstd::optional<std::vector<uint8_t>> get(uint32_t id) const;
-      uint32_t last_id() const;
-      std::string directory() const;
+      /**
+       * Open or create block storage in given directory
+       * @param path - directory of the storage
+       * @param verify_blocks - scan the whole directory instead of using
+       * the manifest
+       * @param durability - flushing of written blocks
+       * @param compression - compression of new blocks
+       * @return storage if directory is usable, nullptr otherwise
+       */
+      static std::unique_ptr<FlatFile> create(
+          const std::string &path,
+          bool verify_blocks = false,
+          DurabilityPolicy durability = DurabilityPolicy::PerCommit,
+          BlockCompression compression = BlockCompression::None);
+      ~FlatFile() override;
+      bool add(uint32_t id, const std::vector<uint8_t> &block) override;
+      bool add_batch(const BlockBatch &blocks) override;
+      nonstd::optional<std::vector<uint8_t>> get(uint32_t id) const override;
+      nonstd::optional<BlockView> view(uint32_t id) const override;
+      uint32_t last_id() const override;
+      uint32_t first_id() const override;
+      bool prune(uint32_t id, const std::string &archive_dir) override;
+      std::string directory() const override;
 
      private:
-      uint32_t current_id;
+      // read by readers of stored blocks concurrently with writes
+      std::atomic<uint32_t> current_id;
+      // blocks before it are pruned
+      std::atomic<uint32_t> oldest_id;
       const std::string dump_dir;
+      const DurabilityPolicy durability;
+      const BlockCompression compression;
+      std::unique_ptr<BlockCompressor> compressor;
 
-      FlatFile(uint32_t current_id, const std::string &path);
+      FlatFile(uint32_t current_id,
+               const std::string &path,
+               DurabilityPolicy durability,
+               BlockCompression compression);
       bool file_exist(const std::string &name) const;
       long file_size(const std::string &filename) const;
+
+      /**
+       * Check last block recorded in manifest and find blocks written after
+       * @return id of last block, nullopt if manifest is missing or stale
+       */
+      nonstd::optional<uint32_t> recover_from_manifest() const;
+
+      /**
+       * Atomically replace manifest with the state of current_id block
+       * @param last_block - contents of current_id block
+       * @return true on success
+       */
+      bool write_manifest(const std::vector<uint8_t> &last_block) const;
+
+      /**
+       * Atomically replace mark of pruned blocks
+       * @param oldest - id of the oldest kept block
+       * @return true on success
+       */
+      bool write_prune_mark(uint32_t oldest) const;
+
+      /**
+       * Written block file, which is not visible yet
+       */
+      struct PendingBlock {
+        uint32_t id;
+        int fd;
+        const std::vector<uint8_t> *block;
+      };
+
+      /**
+       * Write framed block to temporary file without flushing it,
+       * compressing the block if compression is enabled
+       * @return descriptor of written file, -1 if block exists or on error
+       */
+      int write_block(uint32_t id, const std::vector<uint8_t> &block) const;
+
+      /**
+       * Compress block, training dictionary of its segment when enough
+       * blocks are stored
+       * @return bytes to store
+       */
+      std::vector<uint8_t> compress(uint32_t id,
+                                    const std::vector<uint8_t> &block) const;
+
+      /**
+       * Flush block files according to durability policy, close them and
+       * make them visible
+       * @param blocks - blocks returned by write_block, in order of ids
+       * @return number of stored blocks from the beginning of the list
+       */
+      size_t close_blocks(const std::vector<PendingBlock> &blocks) const;
+
+      /**
+       * Remove temporary files of interrupted writes and drop damaged
+       * blocks at the end of the storage
+       * @param from - first block to check
+       */
+      void remove_torn_tail(uint32_t from);
+
+      /**
+       * Flush directory entries of new files according to durability policy
+       */
+      void sync_directory() const;
     };
   }  // namespace ametsuchi
 }  // namespace iroha
@@ -0,0 +1,161 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/kv/key_value_block_index.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    namespace {
+      // key prefixes of tables
+      const std::string kHeight = "h";
+      const char kBlock = 'b';
+      const char kTx = 't';
+      const char kAccountTx = 'a';
+      const char kAccountAssetTx = 's';
+      // separates parts of composite keys
+      const char kSeparator = '\0';
+      // encoded height and index
+      const size_t kPositionSize = 8;
+
+      std::string encode(uint32_t value) {
+        std::string result(4, '\0');
+        for (size_t i = 0; i < 4; ++i) {
+          result[i] = static_cast<char>(value >> (8 * (3 - i)));
+        }
+        return result;
+      }
+
+      uint32_t decode(const std::string &bytes, size_t offset) {
+        uint32_t value = 0;
+        for (size_t i = 0; i < 4; ++i) {
+          value = (value << 8) | static_cast<uint8_t>(bytes[offset + i]);
+        }
+        return value;
+      }
+
+      std::string encode(const TxPosition &position) {
+        return encode(position.height) + encode(position.index);
+      }
+
+      TxPosition decodePosition(const std::string &bytes, size_t offset) {
+        TxPosition position;
+        position.height = decode(bytes, offset);
+        position.index = decode(bytes, offset + 4);
+        return position;
+      }
+
+      std::string key(char table, const hash256_t &hash) {
+        return table + hash.to_string();
+      }
+
+      std::string accountPrefix(const std::string &account_id) {
+        return kAccountTx + account_id + kSeparator;
+      }
+
+      std::string accountAssetPrefix(const std::string &account_id,
+                                     const std::string &asset_id) {
+        return kAccountAssetTx + account_id + kSeparator + asset_id
+            + kSeparator;
+      }
+    }  // namespace
+
+    KeyValueBlockIndex::KeyValueBlockIndex(
+        std::unique_ptr<KeyValueStore> store)
+        : store_(std::move(store)) {}
+
+    bool KeyValueBlockIndex::add(const BlockRefs &blocks) {
+      if (blocks.empty()) {
+        return true;
+      }
+      WriteBatch batch;
+      for (const auto &ref : blocks) {
+        const model::Block &block = ref;
+        batch[key(kBlock, block.hash)] = encode(block.height);
+        for (size_t i = 0; i < block.transactions.size(); ++i) {
+          const auto &tx = block.transactions[i];
+          auto position = encode(
+              TxPosition{block.height, static_cast<uint32_t>(i)});
+          batch[key(kTx, hash_provider_.get_hash(tx))] = position;
+          batch[accountPrefix(tx.creator_account_id) + position] =
+              std::string();
+          for (const auto &account_asset : changedAccountAssets(tx)) {
+            batch[accountAssetPrefix(account_asset.first,
+                                     account_asset.second)
+                  + position] = std::string();
+          }
+        }
+      }
+      batch[kHeight] = encode(blocks.back().get().height);
+      return store_->write(batch);
+    }
+
+    nonstd::optional<uint32_t> KeyValueBlockIndex::height() {
+      auto value = store_->snapshot()->get(kHeight);
+      if (not value) {
+        return 0;
+      }
+      if (value->size() != 4) {
+        return nonstd::nullopt;
+      }
+      return decode(*value, 0);
+    }
+
+    nonstd::optional<std::vector<TxPosition>>
+    KeyValueBlockIndex::accountTransactions(const std::string &account_id) {
+      return positions(accountPrefix(account_id));
+    }
+
+    nonstd::optional<std::vector<TxPosition>>
+    KeyValueBlockIndex::accountAssetTransactions(
+        const std::string &account_id, const std::string &asset_id) {
+      return positions(accountAssetPrefix(account_id, asset_id));
+    }
+
+    std::vector<TxPosition> KeyValueBlockIndex::positions(
+        const std::string &prefix) {
+      std::vector<TxPosition> result;
+      for (const auto &entry : store_->snapshot()->scan(prefix)) {
+        // malformed keys are skipped
+        if (entry.first.size() != prefix.size() + kPositionSize) {
+          continue;
+        }
+        result.push_back(decodePosition(entry.first, prefix.size()));
+      }
+      return result;
+    }
+
+    nonstd::optional<uint32_t> KeyValueBlockIndex::blockHeight(
+        const hash256_t &block_hash) {
+      auto value = store_->snapshot()->get(key(kBlock, block_hash));
+      if (not value or value->size() != 4) {
+        return nonstd::nullopt;
+      }
+      return decode(*value, 0);
+    }
+
+    nonstd::optional<TxPosition> KeyValueBlockIndex::transaction(
+        const hash256_t &tx_hash) {
+      auto value = store_->snapshot()->get(key(kTx, tx_hash));
+      if (not value or value->size() != kPositionSize) {
+        return nonstd::nullopt;
+      }
+      return decodePosition(*value, 0);
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,62 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_KEY_VALUE_BLOCK_INDEX_HPP
+#define IROHA_KEY_VALUE_BLOCK_INDEX_HPP
+
+#include "ametsuchi/impl/block_index.hpp"
+#include "ametsuchi/impl/kv/key_value_store.hpp"
+#include "model/model_hash_provider_impl.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Block index kept in embedded key-value store next to block storage,
+     * so queries do not depend on an external service.
+     * Positions are big-endian parts of keys, so prefix scan returns
+     * transactions of an account in chain order. Blocks of one add are
+     * written with one atomic batch.
+     */
+    class KeyValueBlockIndex : public BlockIndex {
+     public:
+      explicit KeyValueBlockIndex(std::unique_ptr<KeyValueStore> store);
+
+      bool add(const BlockRefs &blocks) override;
+      nonstd::optional<uint32_t> height() override;
+      nonstd::optional<std::vector<TxPosition>> accountTransactions(
+          const std::string &account_id) override;
+      nonstd::optional<std::vector<TxPosition>> accountAssetTransactions(
+          const std::string &account_id, const std::string &asset_id) override;
+      nonstd::optional<uint32_t> blockHeight(
+          const hash256_t &block_hash) override;
+      nonstd::optional<TxPosition> transaction(
+          const hash256_t &tx_hash) override;
+
+     private:
+      /**
+       * Read positions encoded at the end of keys with given prefix
+       */
+      std::vector<TxPosition> positions(const std::string &prefix);
+
+      std::unique_ptr<KeyValueStore> store_;
+      model::HashProviderImpl hash_provider_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+#endif  // IROHA_KEY_VALUE_BLOCK_INDEX_HPP
@@ -0,0 +1,77 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_KEY_VALUE_STORE_HPP
+#define IROHA_KEY_VALUE_STORE_HPP
+
+#include <map>
+#include <memory>
+#include <nonstd/optional.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Changes applied to key-value store at once,
+     * key without value is deleted
+     */
+    using WriteBatch = std::map<std::string, nonstd::optional<std::string>>;
+
+    /**
+     * Consistent read-only view of key-value store
+     */
+    class KeyValueSnapshot {
+     public:
+      virtual ~KeyValueSnapshot() = default;
+
+      /**
+       * @return value of the key if it exists
+       */
+      virtual nonstd::optional<std::string> get(const std::string &key) = 0;
+
+      /**
+       * @return all pairs which keys start with prefix, ordered by key
+       */
+      virtual std::vector<std::pair<std::string, std::string>> scan(
+          const std::string &prefix) = 0;
+    };
+
+    /**
+     * Embedded ordered key-value store
+     */
+    class KeyValueStore {
+     public:
+      virtual ~KeyValueStore() = default;
+
+      /**
+       * @return view of currently committed data
+       */
+      virtual std::unique_ptr<KeyValueSnapshot> snapshot() = 0;
+
+      /**
+       * Apply all changes atomically
+       * @return true on success
+       */
+      virtual bool write(const WriteBatch &batch) = 0;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+#endif  // IROHA_KEY_VALUE_STORE_HPP
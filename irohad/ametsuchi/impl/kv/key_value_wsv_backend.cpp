@@ -0,0 +1,631 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/kv/key_value_wsv_backend.hpp"
+#include "ametsuchi/impl/bulk_wsv.hpp"
+#include "ametsuchi/impl/record_codec.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    namespace {
+      // key prefixes of tables
+      const char kDomain = 'd';
+      const char kSignatory = 'k';
+      const char kAccount = 'a';
+      const char kAccountSignatory = 's';
+      const char kAsset = 'x';
+      const char kAccountAsset = 'b';
+      const char kPeer = 'p';
+      // secondary indexes, keys end with account id and values are empty
+      const char kDomainAccount = 'D';
+      const char kAssetHolder = 'h';
+      const char kSignatoryAccount = 'S';
+      // marks store whose indexes cover all records
+      const std::string kIndexesBuilt = "vindexes";
+      // separates parts of composite keys
+      const char kSeparator = '\0';
+
+      std::string key(char table, const std::string &id) {
+        return table + id;
+      }
+
+      std::string key(char table, const ed25519::pubkey_t &pubkey) {
+        return table + std::string(pubkey.begin(), pubkey.end());
+      }
+
+      std::string key(char table,
+                      const std::string &first,
+                      const std::string &second) {
+        return table + first + kSeparator + second;
+      }
+
+      std::string key(char table,
+                      const std::string &first,
+                      const ed25519::pubkey_t &second) {
+        return key(table, first, std::string(second.begin(), second.end()));
+      }
+
+      /**
+       * Snapshot reads with changes of the transaction on top of them
+       */
+      class KeyValueWsvTransaction : public WsvTransaction {
+       public:
+        explicit KeyValueWsvTransaction(KeyValueStore &store)
+            : store_(store),
+              snapshot_(store.snapshot()),
+              in_savepoint_(false) {}
+
+        std::unique_ptr<WsvQuery> query() override;
+        std::unique_ptr<WsvCommand> command() override;
+        bool dump(BulkTables &tables) override;
+
+        bool reset() override {
+          batch_.clear();
+          undo_.clear();
+          in_savepoint_ = false;
+          return true;
+        }
+
+        void refresh() override { snapshot_ = store_.snapshot(); }
+
+        void savepoint() override {
+          undo_.clear();
+          in_savepoint_ = true;
+        }
+
+        void releaseSavepoint() override {
+          undo_.clear();
+          in_savepoint_ = false;
+        }
+
+        void rollbackToSavepoint() override {
+          for (auto it = undo_.rbegin(); it != undo_.rend(); ++it) {
+            if (it->second) {
+              batch_[it->first] = *it->second;
+            } else {
+              batch_.erase(it->first);
+            }
+          }
+          undo_.clear();
+          in_savepoint_ = false;
+        }
+
+        bool commit() override {
+          return batch_.empty() or store_.write(batch_);
+        }
+
+        nonstd::optional<std::string> get(const std::string &key) {
+          auto it = batch_.find(key);
+          if (it != batch_.end()) {
+            return it->second;
+          }
+          return snapshot_->get(key);
+        }
+
+        std::vector<std::pair<std::string, std::string>> scan(
+            const std::string &prefix) {
+          std::map<std::string, std::string> result;
+          for (auto &pair : snapshot_->scan(prefix)) {
+            result.insert(std::move(pair));
+          }
+          for (auto it = batch_.lower_bound(prefix);
+               it != batch_.end() and
+               it->first.compare(0, prefix.size(), prefix) == 0;
+               ++it) {
+            if (it->second) {
+              result[it->first] = *it->second;
+            } else {
+              result.erase(it->first);
+            }
+          }
+          return {result.begin(), result.end()};
+        }
+
+        bool exists(const std::string &key) {
+          return static_cast<bool>(get(key));
+        }
+
+        void put(const std::string &key, const std::string &value) {
+          change(key, value);
+        }
+
+        void erase(const std::string &key) { change(key, nonstd::nullopt); }
+
+       private:
+        void change(const std::string &key,
+                    nonstd::optional<std::string> value) {
+          if (in_savepoint_) {
+            auto it = batch_.find(key);
+            undo_.emplace_back(
+                key,
+                it == batch_.end()
+                    ? nonstd::optional<nonstd::optional<std::string>>()
+                    : nonstd::optional<nonstd::optional<std::string>>(
+                          it->second));
+          }
+          batch_[key] = std::move(value);
+        }
+
+        KeyValueStore &store_;
+        std::unique_ptr<KeyValueSnapshot> snapshot_;
+        WriteBatch batch_;
+        // previous batch entries of keys changed since savepoint
+        std::vector<std::pair<std::string,
+                              nonstd::optional<nonstd::optional<std::string>>>>
+            undo_;
+        bool in_savepoint_;
+      };
+
+      /**
+       * Queries and commands over tables of one transaction
+       */
+      class KeyValueWsv : public WsvQuery, public WsvCommand {
+       public:
+        explicit KeyValueWsv(KeyValueWsvTransaction &transaction)
+            : transaction_(transaction) {}
+
+        nonstd::optional<model::Account> getAccount(
+            const std::string &account_id) override {
+          auto value = transaction_.get(key(kAccount, account_id));
+          if (not value) {
+            return nonstd::nullopt;
+          }
+          RecordDecoder decoder(*value);
+          model::Account account;
+          account.account_id = account_id;
+          account.domain_name = decoder.str();
+          account.master_key = decoder.pubkey();
+          account.quorum = decoder.u64();
+          account.permissions = model::Account::Permissions::fromBitmask(
+              decoder.u64());
+          // records written by earlier versions end before the counter
+          if (not decoder.finished()) {
+            account.tx_counter = decoder.u64();
+          }
+          if (not decoder.ok()) {
+            return nonstd::nullopt;
+          }
+          return account;
+        }
+
+        nonstd::optional<std::vector<ed25519::pubkey_t>> getSignatories(
+            const std::string &account_id) override {
+          auto prefix = key(kAccountSignatory, account_id, std::string());
+          std::vector<ed25519::pubkey_t> signatories;
+          for (const auto &pair : transaction_.scan(prefix)) {
+            ed25519::pubkey_t pubkey;
+            if (pair.first.size() != prefix.size() + pubkey.size()) {
+              continue;
+            }
+            std::copy(pair.first.begin() + prefix.size(), pair.first.end(),
+                      pubkey.begin());
+            signatories.push_back(pubkey);
+          }
+          return signatories;
+        }
+
+        nonstd::optional<model::Asset> getAsset(
+            const std::string &asset_id) override {
+          auto value = transaction_.get(key(kAsset, asset_id));
+          if (not value) {
+            return nonstd::nullopt;
+          }
+          RecordDecoder decoder(*value);
+          model::Asset asset;
+          asset.asset_id = asset_id;
+          asset.domain_id = decoder.str();
+          asset.precision = decoder.u64();
+          if (not decoder.ok()) {
+            return nonstd::nullopt;
+          }
+          return asset;
+        }
+
+        nonstd::optional<model::AccountAsset> getAccountAsset(
+            const std::string &account_id,
+            const std::string &asset_id) override {
+          auto value =
+              transaction_.get(key(kAccountAsset, account_id, asset_id));
+          if (not value) {
+            return nonstd::nullopt;
+          }
+          RecordDecoder decoder(*value);
+          model::AccountAsset asset;
+          asset.account_id = account_id;
+          asset.asset_id = asset_id;
+          asset.balance = decoder.u64();
+          if (not decoder.ok()) {
+            return nonstd::nullopt;
+          }
+          return asset;
+        }
+
+        nonstd::optional<std::vector<model::AccountAsset>> getAccountAssets(
+            const std::string &account_id,
+            const std::string &after_asset_id,
+            size_t limit) override {
+          auto prefix = key(kAccountAsset, account_id, std::string());
+          std::vector<model::AccountAsset> assets;
+          // scan is ordered by key, so by asset id within the account
+          for (const auto &pair : transaction_.scan(prefix)) {
+            if (limit != 0 and assets.size() == limit) {
+              break;
+            }
+            auto asset_id = pair.first.substr(prefix.size());
+            if (asset_id <= after_asset_id) {
+              continue;
+            }
+            RecordDecoder decoder(pair.second);
+            model::AccountAsset asset;
+            asset.account_id = account_id;
+            asset.asset_id = asset_id;
+            asset.balance = decoder.u64();
+            if (not decoder.ok()) {
+              return nonstd::nullopt;
+            }
+            assets.push_back(asset);
+          }
+          return assets;
+        }
+
+        nonstd::optional<std::vector<model::AccountAsset>> getAssetHolders(
+            const std::string &asset_id,
+            const std::string &after_account_id,
+            size_t limit) override {
+          std::vector<model::AccountAsset> holders;
+          for (const auto &account_id : indexed(key(kAssetHolder, asset_id, ""),
+                                                after_account_id,
+                                                limit)) {
+            auto asset = getAccountAsset(account_id, asset_id);
+            if (not asset) {
+              return nonstd::nullopt;
+            }
+            holders.push_back(*asset);
+          }
+          return holders;
+        }
+
+        nonstd::optional<std::vector<model::Account>> getDomainAccounts(
+            const std::string &domain_id,
+            const std::string &after_account_id,
+            size_t limit) override {
+          std::vector<model::Account> accounts;
+          for (const auto &account_id :
+               indexed(key(kDomainAccount, domain_id, ""),
+                       after_account_id,
+                       limit)) {
+            auto account = getAccount(account_id);
+            if (not account) {
+              return nonstd::nullopt;
+            }
+            accounts.push_back(*account);
+          }
+          return accounts;
+        }
+
+        nonstd::optional<std::vector<std::string>> getAccountsBySignatory(
+            const ed25519::pubkey_t &signatory,
+            const std::string &after_account_id,
+            size_t limit) override {
+          return indexed(
+              key(kSignatoryAccount,
+                  std::string(signatory.begin(), signatory.end()),
+                  ""),
+              after_account_id,
+              limit);
+        }
+
+        nonstd::optional<std::vector<model::Peer>> getPeers() override {
+          std::vector<model::Peer> peers;
+          for (const auto &pair : transaction_.scan(std::string(1, kPeer))) {
+            model::Peer peer;
+            if (pair.first.size() != 1 + peer.pubkey.size()) {
+              continue;
+            }
+            std::copy(pair.first.begin() + 1, pair.first.end(),
+                      peer.pubkey.begin());
+            peer.address = pair.second;
+            peers.push_back(peer);
+          }
+          return peers;
+        }
+
+        bool insertAccount(const model::Account &account) override {
+          if (transaction_.exists(key(kAccount, account.account_id)) or
+              not transaction_.exists(key(kDomain, account.domain_name))) {
+            return false;
+          }
+          return writeAccount(account);
+        }
+
+        bool updateAccount(const model::Account &account) override {
+          // update of missing account changes nothing, as in SQL
+          if (not transaction_.exists(key(kAccount, account.account_id))) {
+            return true;
+          }
+          return writeAccount(account);
+        }
+
+        bool insertAsset(const model::Asset &asset) override {
+          if (transaction_.exists(key(kAsset, asset.asset_id)) or
+              not transaction_.exists(key(kDomain, asset.domain_id))) {
+            return false;
+          }
+          transaction_.put(key(kAsset, asset.asset_id),
+                           RecordEncoder()
+                               .str(asset.domain_id)
+                               .u64(asset.precision)
+                               .value());
+          return true;
+        }
+
+        bool upsertAccountAsset(const model::AccountAsset &asset) override {
+          if (not transaction_.exists(key(kAccount, asset.account_id)) or
+              not transaction_.exists(key(kAsset, asset.asset_id))) {
+            return false;
+          }
+          auto balance = key(kAccountAsset, asset.account_id, asset.asset_id);
+          if (not transaction_.exists(balance)) {
+            transaction_.put(
+                key(kAssetHolder, asset.asset_id, asset.account_id),
+                std::string());
+          }
+          transaction_.put(balance, RecordEncoder().u64(asset.balance).value());
+          return true;
+        }
+
+        bool insertSignatory(const ed25519::pubkey_t &signatory) override {
+          if (transaction_.exists(key(kSignatory, signatory))) {
+            return false;
+          }
+          transaction_.put(key(kSignatory, signatory), std::string());
+          return true;
+        }
+
+        bool insertAccountSignatory(
+            const std::string &account_id,
+            const ed25519::pubkey_t &signatory) override {
+          auto relation = key(kAccountSignatory, account_id, signatory);
+          if (transaction_.exists(relation) or
+              not transaction_.exists(key(kAccount, account_id)) or
+              not transaction_.exists(key(kSignatory, signatory))) {
+            return false;
+          }
+          transaction_.put(relation, std::string());
+          transaction_.put(key(kSignatoryAccount,
+                               std::string(signatory.begin(), signatory.end()),
+                               account_id),
+                           std::string());
+          return true;
+        }
+
+        bool deleteAccountSignatory(
+            const std::string &account_id,
+            const ed25519::pubkey_t &signatory) override {
+          transaction_.erase(key(kAccountSignatory, account_id, signatory));
+          transaction_.erase(
+              key(kSignatoryAccount,
+                  std::string(signatory.begin(), signatory.end()),
+                  account_id));
+          return true;
+        }
+
+        bool insertPeer(const model::Peer &peer) override {
+          if (transaction_.exists(key(kPeer, peer.pubkey))) {
+            return false;
+          }
+          // addresses are unique too
+          auto peers = getPeers();
+          for (const auto &other : *peers) {
+            if (other.address == peer.address) {
+              return false;
+            }
+          }
+          transaction_.put(key(kPeer, peer.pubkey), peer.address);
+          return true;
+        }
+
+        bool deletePeer(const model::Peer &peer) override {
+          auto address = transaction_.get(key(kPeer, peer.pubkey));
+          if (address and *address == peer.address) {
+            transaction_.erase(key(kPeer, peer.pubkey));
+          }
+          return true;
+        }
+
+        bool insertDomain(const model::Domain &domain) override {
+          if (transaction_.exists(key(kDomain, domain.domain_id))) {
+            return false;
+          }
+          transaction_.put(key(kDomain, domain.domain_id), std::string());
+          return true;
+        }
+
+       private:
+        bool writeAccount(const model::Account &account) {
+          if (not transaction_.exists(key(kSignatory, account.master_key))) {
+            return false;
+          }
+          transaction_.put(key(kAccount, account.account_id),
+                           RecordEncoder()
+                               .str(account.domain_name)
+                               .pubkey(account.master_key)
+                               .u64(account.quorum)
+                               .u64(account.permissions.toBitmask())
+                               .u64(account.tx_counter)
+                               .value());
+          // domain of account never changes, so the entry is never stale
+          transaction_.put(
+              key(kDomainAccount, account.domain_name, account.account_id),
+              std::string());
+          return true;
+        }
+
+        /**
+         * Read account ids from index entries under prefix
+         */
+        std::vector<std::string> indexed(const std::string &prefix,
+                                         const std::string &after_account_id,
+                                         size_t limit) {
+          std::vector<std::string> accounts;
+          for (const auto &pair : transaction_.scan(prefix)) {
+            if (limit != 0 and accounts.size() == limit) {
+              break;
+            }
+            auto account_id = pair.first.substr(prefix.size());
+            if (account_id > after_account_id) {
+              accounts.push_back(std::move(account_id));
+            }
+          }
+          return accounts;
+        }
+
+        KeyValueWsvTransaction &transaction_;
+      };
+
+      std::unique_ptr<WsvQuery> KeyValueWsvTransaction::query() {
+        return std::make_unique<KeyValueWsv>(*this);
+      }
+
+      std::unique_ptr<WsvCommand> KeyValueWsvTransaction::command() {
+        return std::make_unique<KeyValueWsv>(*this);
+      }
+
+      bool KeyValueWsvTransaction::dump(BulkTables &tables) {
+        KeyValueWsv wsv(*this);
+        auto pubkey_size = ed25519::pubkey_t::size();
+        for (const auto &pair : scan(std::string(1, kDomain))) {
+          model::Domain domain;
+          domain.domain_id = pair.first.substr(1);
+          tables.domains.emplace(domain.domain_id, domain);
+        }
+        for (const auto &pair : scan(std::string(1, kSignatory))) {
+          if (pair.first.size() != 1 + pubkey_size) {
+            return false;
+          }
+          ed25519::pubkey_t pubkey;
+          std::copy(pair.first.begin() + 1, pair.first.end(), pubkey.begin());
+          tables.signatories.insert(pubkey);
+        }
+        for (const auto &pair : scan(std::string(1, kAccount))) {
+          auto account = wsv.getAccount(pair.first.substr(1));
+          if (not account) {
+            return false;
+          }
+          tables.accounts.emplace(account->account_id, *account);
+        }
+        // key is table, account id, separator and public key
+        for (const auto &pair : scan(std::string(1, kAccountSignatory))) {
+          if (pair.first.size() < 2 + pubkey_size) {
+            return false;
+          }
+          auto id_size = pair.first.size() - 2 - pubkey_size;
+          ed25519::pubkey_t pubkey;
+          std::copy(pair.first.end() - pubkey_size, pair.first.end(),
+                    pubkey.begin());
+          tables.account_signatories[pair.first.substr(1, id_size)]
+              .push_back(pubkey);
+        }
+        for (const auto &pair : scan(std::string(1, kAsset))) {
+          auto asset = wsv.getAsset(pair.first.substr(1));
+          if (not asset) {
+            return false;
+          }
+          tables.assets.emplace(asset->asset_id, *asset);
+        }
+        // identifiers never contain the separator
+        for (const auto &pair : scan(std::string(1, kAccountAsset))) {
+          auto separator = pair.first.find(kSeparator);
+          if (separator == std::string::npos) {
+            return false;
+          }
+          auto account_id = pair.first.substr(1, separator - 1);
+          auto asset_id = pair.first.substr(separator + 1);
+          auto asset = wsv.getAccountAsset(account_id, asset_id);
+          if (not asset) {
+            return false;
+          }
+          tables.account_assets.emplace(std::make_pair(account_id, asset_id),
+                                        *asset);
+        }
+        auto peers = wsv.getPeers();
+        tables.peers = *peers;
+        return true;
+      }
+
+      /**
+       * Add index entries of records written before indexes existed
+       * @return true on success
+       */
+      bool buildIndexes(KeyValueStore &store) {
+        auto snapshot = store.snapshot();
+        if (snapshot->get(kIndexesBuilt)) {
+          return true;
+        }
+        WriteBatch batch;
+        for (const auto &pair : snapshot->scan(std::string(1, kAccount))) {
+          RecordDecoder decoder(pair.second);
+          auto domain_id = decoder.str();
+          if (not decoder.ok()) {
+            return false;
+          }
+          batch[key(kDomainAccount, domain_id, pair.first.substr(1))] =
+              std::string();
+        }
+        // key is table, account id, separator and public key
+        auto pubkey_size = ed25519::pubkey_t::size();
+        for (const auto &pair :
+             snapshot->scan(std::string(1, kAccountSignatory))) {
+          if (pair.first.size() < 2 + pubkey_size) {
+            return false;
+          }
+          auto id_size = pair.first.size() - 2 - pubkey_size;
+          batch[key(kSignatoryAccount,
+                    pair.first.substr(pair.first.size() - pubkey_size),
+                    pair.first.substr(1, id_size))] = std::string();
+        }
+        for (const auto &pair : snapshot->scan(std::string(1, kAccountAsset))) {
+          auto separator = pair.first.find(kSeparator);
+          if (separator == std::string::npos) {
+            return false;
+          }
+          batch[key(kAssetHolder,
+                    pair.first.substr(separator + 1),
+                    pair.first.substr(1, separator - 1))] = std::string();
+        }
+        // empty store is marked on a later start, entries are idempotent
+        if (batch.empty()) {
+          return true;
+        }
+        batch[kIndexesBuilt] = std::string("1");
+        return store.write(batch);
+      }
+    }  // namespace
+
+    KeyValueWsvBackend::KeyValueWsvBackend(
+        std::unique_ptr<KeyValueStore> store)
+        : store_(std::move(store)) {
+      buildIndexes(*store_);
+    }
+
+    std::unique_ptr<WsvTransaction> KeyValueWsvBackend::begin() {
+      return std::make_unique<KeyValueWsvTransaction>(*store_);
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,48 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_KEY_VALUE_WSV_BACKEND_HPP
+#define IROHA_KEY_VALUE_WSV_BACKEND_HPP
+
+#include "ametsuchi/impl/kv/key_value_store.hpp"
+#include "ametsuchi/impl/wsv_backend.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * World state view kept in embedded key-value store.
+     * Every record of a table is stored under its primary key, and listings
+     * by domain, asset or signatory under keys of secondary indexes, so all
+     * queries are point lookups or prefix scans. Transactions read from a
+     * snapshot, collect their changes in memory and write them with one
+     * atomic batch on commit. Constraints of the relational schema are
+     * checked on write.
+     */
+    class KeyValueWsvBackend : public WsvBackend {
+     public:
+      explicit KeyValueWsvBackend(std::unique_ptr<KeyValueStore> store);
+
+      std::unique_ptr<WsvTransaction> begin() override;
+
+     private:
+      std::unique_ptr<KeyValueStore> store_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+#endif  // IROHA_KEY_VALUE_WSV_BACKEND_HPP
@@ -0,0 +1,171 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/kv/lmdb_store.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    namespace {
+      MDB_val value(const std::string &data) {
+        return MDB_val{data.size(), const_cast<char *>(data.data())};
+      }
+
+      std::string toString(const MDB_val &value) {
+        return std::string(static_cast<const char *>(value.mv_data),
+                           value.mv_size);
+      }
+
+      /**
+       * Read-only transaction, aborted on destruction
+       */
+      class LmdbSnapshot : public KeyValueSnapshot {
+       public:
+        LmdbSnapshot(MDB_txn *txn, MDB_dbi dbi) : txn_(txn), dbi_(dbi) {}
+
+        ~LmdbSnapshot() override {
+          if (txn_) {
+            mdb_txn_abort(txn_);
+          }
+        }
+
+        nonstd::optional<std::string> get(const std::string &key) override {
+          if (not txn_) {
+            return nonstd::nullopt;
+          }
+          auto k = value(key);
+          MDB_val v;
+          if (mdb_get(txn_, dbi_, &k, &v) != MDB_SUCCESS) {
+            return nonstd::nullopt;
+          }
+          return toString(v);
+        }
+
+        std::vector<std::pair<std::string, std::string>> scan(
+            const std::string &prefix) override {
+          std::vector<std::pair<std::string, std::string>> result;
+          MDB_cursor *cursor;
+          if (not txn_ or prefix.empty() or
+              mdb_cursor_open(txn_, dbi_, &cursor) != MDB_SUCCESS) {
+            return result;
+          }
+          auto k = value(prefix);
+          MDB_val v;
+          auto status = mdb_cursor_get(cursor, &k, &v, MDB_SET_RANGE);
+          while (status == MDB_SUCCESS) {
+            auto key = toString(k);
+            if (key.compare(0, prefix.size(), prefix) != 0) {
+              break;
+            }
+            result.emplace_back(std::move(key), toString(v));
+            status = mdb_cursor_get(cursor, &k, &v, MDB_NEXT);
+          }
+          mdb_cursor_close(cursor);
+          return result;
+        }
+
+       private:
+        MDB_txn *txn_;
+        MDB_dbi dbi_;
+      };
+    }  // namespace
+
+    LmdbStore::LmdbStore(MDB_env *env, MDB_dbi dbi)
+        : env_(env), dbi_(dbi), log_(logger::log("LmdbStore")) {}
+
+    LmdbStore::~LmdbStore() { mdb_env_close(env_); }
+
+    std::unique_ptr<LmdbStore> LmdbStore::create(const std::string &path,
+                                                 size_t map_size) {
+      auto log = logger::log("LmdbStore:create");
+      MDB_env *env;
+      if (mdb_env_create(&env) != MDB_SUCCESS) {
+        log->error("Cannot create LMDB environment");
+        return nullptr;
+      }
+      MDB_txn *txn;
+      MDB_dbi dbi;
+      auto status = mdb_env_set_mapsize(env, map_size);
+      if (status == MDB_SUCCESS) {
+        // snapshots may be used in other threads than they were taken in
+        status = mdb_env_open(env, path.c_str(), MDB_NOTLS, 0644);
+      }
+      if (status == MDB_SUCCESS) {
+        status = mdb_txn_begin(env, nullptr, 0, &txn);
+      }
+      if (status == MDB_SUCCESS) {
+        status = mdb_dbi_open(txn, nullptr, 0, &dbi);
+        if (status == MDB_SUCCESS) {
+          status = mdb_txn_commit(txn);
+        } else {
+          mdb_txn_abort(txn);
+        }
+      }
+      if (status != MDB_SUCCESS) {
+        log->error("Cannot open LMDB store in {}: {}", path,
+                   mdb_strerror(status));
+        mdb_env_close(env);
+        return nullptr;
+      }
+      return std::unique_ptr<LmdbStore>(new LmdbStore(env, dbi));
+    }
+
+    std::unique_ptr<KeyValueSnapshot> LmdbStore::snapshot() {
+      MDB_txn *txn;
+      auto status = mdb_txn_begin(env_, nullptr, MDB_RDONLY, &txn);
+      if (status != MDB_SUCCESS) {
+        log_->error("Cannot start read transaction: {}", mdb_strerror(status));
+        txn = nullptr;
+      }
+      return std::make_unique<LmdbSnapshot>(txn, dbi_);
+    }
+
+    bool LmdbStore::write(const WriteBatch &batch) {
+      MDB_txn *txn;
+      auto status = mdb_txn_begin(env_, nullptr, 0, &txn);
+      if (status != MDB_SUCCESS) {
+        log_->error("Cannot start write transaction: {}",
+                    mdb_strerror(status));
+        return false;
+      }
+      for (const auto &change : batch) {
+        auto k = value(change.first);
+        if (change.second) {
+          auto v = value(*change.second);
+          status = mdb_put(txn, dbi_, &k, &v, 0);
+        } else {
+          status = mdb_del(txn, dbi_, &k, nullptr);
+          if (status == MDB_NOTFOUND) {
+            status = MDB_SUCCESS;
+          }
+        }
+        if (status != MDB_SUCCESS) {
+          log_->error("Cannot write batch: {}", mdb_strerror(status));
+          mdb_txn_abort(txn);
+          return false;
+        }
+      }
+      status = mdb_txn_commit(txn);
+      if (status != MDB_SUCCESS) {
+        log_->error("Cannot commit batch: {}", mdb_strerror(status));
+        return false;
+      }
+      return true;
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,64 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_LMDB_STORE_HPP
+#define IROHA_LMDB_STORE_HPP
+
+#include <lmdb.h>
+#include "ametsuchi/impl/kv/key_value_store.hpp"
+#include "logger/logger.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Key-value store in LMDB environment.
+     * Snapshots are read-only LMDB transactions, so they do not block
+     * writers. Each batch is written by one write transaction, which is
+     * synced to disk on commit.
+     */
+    class LmdbStore : public KeyValueStore {
+     public:
+      /**
+       * Default upper bound of database size, 1 GiB
+       */
+      static constexpr size_t kDefaultMapSize = 1ull << 30;
+
+      /**
+       * Open or create store in existing directory
+       * @param path - directory of the store
+       * @param map_size - maximal size of the database
+       * @return store or nullptr if environment can not be opened
+       */
+      static std::unique_ptr<LmdbStore> create(
+          const std::string &path, size_t map_size = kDefaultMapSize);
+
+      ~LmdbStore() override;
+      std::unique_ptr<KeyValueSnapshot> snapshot() override;
+      bool write(const WriteBatch &batch) override;
+
+     private:
+      LmdbStore(MDB_env *env, MDB_dbi dbi);
+
+      MDB_env *env_;
+      MDB_dbi dbi_;
+      logger::Logger log_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+#endif  // IROHA_LMDB_STORE_HPP
@@ -0,0 +1,282 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/lazy_block.hpp"
+#include <utility>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
+#include "block.pb.h"
+#include "crypto/hash.hpp"
+#include "model/converters/pb_transaction_factory.hpp"
+#include "model/merkle_tree.hpp"
+#include "model/model_hash_provider_impl.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    namespace {
+      using google::protobuf::internal::WireFormatLite;
+
+      /**
+       * Call visit(field number, data, size) for each length-delimited
+       * field of message in order, other fields are skipped
+       * @return false if message is malformed
+       */
+      template <typename Visit>
+      bool forEachField(const uint8_t *data, size_t size, Visit &&visit) {
+        google::protobuf::io::CodedInputStream input(data, size);
+        while (auto tag = input.ReadTag()) {
+          if (WireFormatLite::GetTagWireType(tag)
+              != WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+            if (not WireFormatLite::SkipField(&input, tag)) {
+              return false;
+            }
+            continue;
+          }
+          uint32_t length;
+          if (not input.ReadVarint32(&length)) {
+            return false;
+          }
+          auto offset = input.CurrentPosition();
+          if (not input.Skip(length)
+              or not visit(WireFormatLite::GetTagFieldNumber(tag),
+                           data + offset,
+                           length)) {
+            return false;
+          }
+        }
+        return input.ConsumedEntireMessage();
+      }
+    }  // namespace
+
+    LazyBlock::LazyBlock(std::shared_ptr<const model::Block> block)
+        : block_(std::move(block)) {}
+
+    LazyBlock::LazyBlock(BlockView bytes, model::Block header)
+        : bytes_(std::move(bytes)), header_(std::move(header)) {}
+
+    std::shared_ptr<const LazyBlock> LazyBlock::parse(BlockView bytes,
+                                                      size_t offset) {
+      if (offset > bytes.size()) {
+        return nullptr;
+      }
+      model::Block header{};
+      std::vector<Entry> entries;
+      protocol::Header pb_header;
+      protocol::Block::Meta pb_meta;
+
+      // fields repeated in stored bytes would be merged by protobuf, so
+      // such blocks are not delimited
+      auto delimit_transaction = [](const uint8_t *data,
+                                    size_t size,
+                                    Entry &entry) {
+        bool has_meta = false, has_body = false;
+        entry.message = {data, size};
+        return forEachField(
+            data, size, [&](uint32_t field, const uint8_t *at, size_t length) {
+              switch (field) {
+                case protocol::Transaction::kMetaFieldNumber:
+                  entry.meta = {at, length};
+                  return not std::exchange(has_meta, true);
+                case protocol::Transaction::kBodyFieldNumber:
+                  entry.body = {at, length};
+                  return not std::exchange(has_body, true);
+                default:
+                  return true;
+              }
+            });
+      };
+      auto delimit_body = [&entries, &delimit_transaction](
+                              const uint8_t *data, size_t size) {
+        return forEachField(
+            data, size, [&](uint32_t field, const uint8_t *at, size_t length) {
+              if (field != protocol::Block::Body::kTransactionsFieldNumber) {
+                return true;
+              }
+              entries.emplace_back();
+              return delimit_transaction(at, length, entries.back());
+            });
+      };
+      bool has_header = false, has_meta = false, has_body = false;
+      auto parsed = forEachField(
+          bytes.data() + offset,
+          bytes.size() - offset,
+          [&](uint32_t field, const uint8_t *data, size_t size) {
+            switch (field) {
+              case protocol::Block::kHeaderFieldNumber:
+                return not std::exchange(has_header, true)
+                    and pb_header.ParseFromArray(data, size);
+              case protocol::Block::kMetaFieldNumber:
+                return not std::exchange(has_meta, true)
+                    and pb_meta.ParseFromArray(data, size);
+              case protocol::Block::kBodyFieldNumber:
+                return not std::exchange(has_body, true)
+                    and delimit_body(data, size);
+              default:
+                return true;
+            }
+          });
+      if (not parsed) {
+        return nullptr;
+      }
+
+      header.created_ts = pb_header.created_time();
+      header.sigs.reserve(pb_header.signatures_size());
+      for (const auto &pb_sig : pb_header.signatures()) {
+        model::Signature sig{};
+        std::copy(pb_sig.pubkey().begin(),
+                  pb_sig.pubkey().end(),
+                  sig.pubkey.begin());
+        std::copy(pb_sig.signature().begin(),
+                  pb_sig.signature().end(),
+                  sig.signature.begin());
+        header.sigs.push_back(sig);
+      }
+      // potential dangerous cast, as in PbBlockFactory
+      header.txs_number = (uint16_t)pb_meta.tx_number();
+      header.height = pb_meta.height();
+      std::copy(pb_meta.prev_block_hash().begin(),
+                pb_meta.prev_block_hash().end(),
+                header.prev_hash.begin());
+
+      std::shared_ptr<LazyBlock> block(
+          new LazyBlock(std::move(bytes), std::move(header)));
+      block->entries_ = std::move(entries);
+      return block;
+    }
+
+    uint64_t LazyBlock::height() const {
+      return block_ ? block_->height : header_.height;
+    }
+
+    const hash256_t &LazyBlock::prevHash() const {
+      return block_ ? block_->prev_hash : header_.prev_hash;
+    }
+
+    ts64_t LazyBlock::createdTs() const {
+      return block_ ? block_->created_ts : header_.created_ts;
+    }
+
+    const std::vector<model::Signature> &LazyBlock::sigs() const {
+      return block_ ? block_->sigs : header_.sigs;
+    }
+
+    size_t LazyBlock::transactionsSize() const {
+      return block_ ? block_->transactions.size() : entries_.size();
+    }
+
+    std::string LazyBlock::creatorAccountId(size_t index) const {
+      if (block_) {
+        return block_->transactions.at(index).creator_account_id;
+      }
+      // meta is small and immutable, so it is parsed without the lock
+      const auto &meta = entries_.at(index).meta;
+      protocol::Transaction::Meta pb_meta;
+      if (not pb_meta.ParseFromArray(meta.data, meta.size)) {
+        return {};
+      }
+      return pb_meta.creator_account_id();
+    }
+
+    hash256_t LazyBlock::transactionHash(size_t index) const {
+      if (block_) {
+        return model::HashProviderImpl().get_hash(
+            block_->transactions.at(index));
+      }
+      std::lock_guard<std::mutex> lock(lock_);
+      return transactionHashLocked(index);
+    }
+
+    hash256_t LazyBlock::transactionHashLocked(size_t index) const {
+      auto &entry = entries_.at(index);
+      if (not entry.hash) {
+        // stored meta and body are the canonical payload of transaction,
+        // see HashProviderImpl
+        entry.hash = Sha3_256()
+                         .update(entry.meta.data, entry.meta.size)
+                         .update(entry.body.data, entry.body.size)
+                         .final();
+      }
+      return *entry.hash;
+    }
+
+    const model::Transaction *LazyBlock::transaction(size_t index) const {
+      if (block_) {
+        return &block_->transactions.at(index);
+      }
+      std::lock_guard<std::mutex> lock(lock_);
+      return transactionLocked(index);
+    }
+
+    const model::Transaction *LazyBlock::transactionLocked(
+        size_t index) const {
+      auto &entry = entries_.at(index);
+      if (not entry.decoded) {
+        protocol::Transaction pb_tx;
+        if (not pb_tx.ParseFromArray(entry.message.data,
+                                     entry.message.size)) {
+          return nullptr;
+        }
+        model::converters::PbTransactionFactory factory;
+        auto tx = factory.deserialize(pb_tx);
+        if (not tx) {
+          return nullptr;
+        }
+        entry.decoded = std::make_unique<model::Transaction>(std::move(*tx));
+      }
+      return entry.decoded.get();
+    }
+
+    hash256_t LazyBlock::hash() const {
+      if (block_) {
+        return block_->hash;
+      }
+      std::lock_guard<std::mutex> lock(lock_);
+      if (not hashed_) {
+        // root is computed from transactions, as by PbBlockFactory
+        model::MerkleTree tree;
+        for (size_t i = 0; i < entries_.size(); ++i) {
+          tree.append(transactionHashLocked(i));
+        }
+        header_.merkle_root = tree.root();
+        header_.hash = model::HashProviderImpl().get_hash(header_);
+        hashed_ = true;
+      }
+      return header_.hash;
+    }
+
+    std::shared_ptr<const model::Block> LazyBlock::block() const {
+      if (block_) {
+        return block_;
+      }
+      auto hash = this->hash();
+      std::lock_guard<std::mutex> lock(lock_);
+      auto block = std::make_shared<model::Block>(header_);
+      block->hash = hash;
+      block->transactions.reserve(entries_.size());
+      for (size_t i = 0; i < entries_.size(); ++i) {
+        auto tx = transactionLocked(i);
+        if (not tx) {
+          return nullptr;
+        }
+        block->transactions.push_back(*tx);
+      }
+      return block;
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
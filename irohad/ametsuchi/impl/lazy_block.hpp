@@ -0,0 +1,121 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_LAZY_BLOCK_HPP
+#define IROHA_LAZY_BLOCK_HPP
+
+#include <memory>
+#include <mutex>
+#include <nonstd/optional.hpp>
+#include <string>
+#include <vector>
+#include "ametsuchi/impl/block_storage.hpp"
+#include "model/block.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Stored block decoded on demand. Header is decoded at once, while
+     * transactions are only delimited in stored bytes: creator and hash
+     * of a transaction are read from its meta and body without building
+     * its commands, and whole transaction is decoded on first access.
+     * Block may also wrap already decoded one, e.g. a cached block.
+     * Accessors are thread-safe.
+     */
+    class LazyBlock {
+     public:
+      /**
+       * @param block - decoded block
+       */
+      explicit LazyBlock(std::shared_ptr<const model::Block> block);
+
+      /**
+       * Delimit transactions of serialized protocol::Block
+       * @param bytes - stored block, kept alive by the result
+       * @param offset - position of the message in bytes
+       * @return block or nullptr if message can not be delimited
+       */
+      static std::shared_ptr<const LazyBlock> parse(BlockView bytes,
+                                                    size_t offset);
+
+      uint64_t height() const;
+      const hash256_t &prevHash() const;
+      ts64_t createdTs() const;
+      const std::vector<model::Signature> &sigs() const;
+
+      size_t transactionsSize() const;
+
+      /**
+       * @return creator of transaction, empty if it is malformed
+       */
+      std::string creatorAccountId(size_t index) const;
+
+      /**
+       * @return hash of transaction, computed over its stored payload
+       */
+      hash256_t transactionHash(size_t index) const;
+
+      /**
+       * @return transaction or nullptr if it is malformed
+       */
+      const model::Transaction *transaction(size_t index) const;
+
+      /**
+       * @return hash of block, which covers hashes of all transactions
+       */
+      hash256_t hash() const;
+
+      /**
+       * @return block with all transactions, nullptr if any is malformed
+       */
+      std::shared_ptr<const model::Block> block() const;
+
+     private:
+      struct Range {
+        const uint8_t *data = nullptr;
+        size_t size = 0;
+      };
+
+      struct Entry {
+        Range message;
+        Range meta;
+        Range body;
+        nonstd::optional<hash256_t> hash;
+        std::unique_ptr<model::Transaction> decoded;
+      };
+
+      LazyBlock(BlockView bytes, model::Block header);
+
+      hash256_t transactionHashLocked(size_t index) const;
+      const model::Transaction *transactionLocked(size_t index) const;
+
+      // set for decoded block
+      std::shared_ptr<const model::Block> block_;
+
+      // stored bytes, ranges of entries point into them
+      nonstd::optional<BlockView> bytes_;
+      // header and meta of block, hash is set on demand
+      mutable model::Block header_;
+      mutable std::vector<Entry> entries_;
+      mutable bool hashed_ = false;
+      mutable std::mutex lock_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+#endif  // IROHA_LAZY_BLOCK_HPP
@@ -0,0 +1,49 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/mapped_region.hpp"
+#include <sys/mman.h>
+
+namespace iroha {
+  namespace ametsuchi {
+
+    MappedRegion::MappedRegion(const uint8_t *data, size_t size)
+        : data_(data), size_(size) {}
+
+    MappedRegion::~MappedRegion() {
+      if (size_ > 0) {
+        munmap(const_cast<uint8_t *>(data_), size_);
+      }
+    }
+
+    std::shared_ptr<const MappedRegion> MappedRegion::map(int fd,
+                                                          size_t size) {
+      if (size == 0) {
+        // zero-length mappings are not allowed
+        return std::shared_ptr<const MappedRegion>(
+            new MappedRegion(nullptr, 0));
+      }
+      auto address = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+      if (address == MAP_FAILED) {
+        return nullptr;
+      }
+      return std::shared_ptr<const MappedRegion>(
+          new MappedRegion(static_cast<const uint8_t *>(address), size));
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,57 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_MAPPED_REGION_HPP
+#define IROHA_MAPPED_REGION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Read-only memory mapping of file prefix.
+     * Mapping is released when the last reference is dropped.
+     */
+    class MappedRegion {
+     public:
+      /**
+       * Map first size bytes of the file
+       * @param fd - descriptor of file opened for reading,
+       * may be closed after the call
+       * @param size - number of bytes to map, must not exceed file size
+       * @return mapping or nullptr on failure
+       */
+      static std::shared_ptr<const MappedRegion> map(int fd, size_t size);
+
+      ~MappedRegion();
+
+      const uint8_t *data() const { return data_; }
+      size_t size() const { return size_; }
+
+     private:
+      MappedRegion(const uint8_t *data, size_t size);
+
+      const uint8_t *data_;
+      const size_t size_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+#endif  // IROHA_MAPPED_REGION_HPP
@@ -0,0 +1,61 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/merkle_tree_cache.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    constexpr size_t MerkleTreeCache::kDefaultCapacity;
+
+    MerkleTreeCache::MerkleTreeCache(size_t max_trees)
+        : max_trees_(max_trees) {}
+
+    std::shared_ptr<const model::MerkleTree> MerkleTreeCache::get(
+        uint32_t height) {
+      std::lock_guard<std::mutex> lock(lock_);
+      auto it = entries_.find(height);
+      if (it == entries_.end()) {
+        return nullptr;
+      }
+      order_.splice(order_.begin(), order_, it->second.position);
+      return it->second.tree;
+    }
+
+    void MerkleTreeCache::put(uint32_t height,
+                              std::shared_ptr<const model::MerkleTree> tree) {
+      if (max_trees_ == 0) {
+        return;
+      }
+      std::lock_guard<std::mutex> lock(lock_);
+      auto it = entries_.find(height);
+      if (it != entries_.end()) {
+        order_.erase(it->second.position);
+        entries_.erase(it);
+      }
+
+      while (not order_.empty() and entries_.size() >= max_trees_) {
+        entries_.erase(order_.back());
+        order_.pop_back();
+      }
+
+      order_.push_front(height);
+      entries_.emplace(height, Entry{std::move(tree), order_.begin()});
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,74 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_MERKLE_TREE_CACHE_HPP
+#define IROHA_MERKLE_TREE_CACHE_HPP
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "model/merkle_tree.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Bounded LRU cache of hash trees over transactions of blocks, keyed
+     * by height. Proofs for transactions of recently queried blocks are
+     * made without hashing their transactions again.
+     */
+    class MerkleTreeCache {
+     public:
+      static constexpr size_t kDefaultCapacity = 256;
+
+      /**
+       * @param max_trees - maximal number of cached trees, 0 disables cache
+       */
+      explicit MerkleTreeCache(size_t max_trees = kDefaultCapacity);
+
+      /**
+       * Find tree and mark it as recently used
+       * @param height - height of block
+       * @return tree or nullptr if it is not cached
+       */
+      std::shared_ptr<const model::MerkleTree> get(uint32_t height);
+
+      /**
+       * Insert tree evicting least recently used one if needed
+       * @param height - height of block
+       * @param tree - tree over hashes of block transactions
+       */
+      void put(uint32_t height, std::shared_ptr<const model::MerkleTree> tree);
+
+     private:
+      struct Entry {
+        std::shared_ptr<const model::MerkleTree> tree;
+        std::list<uint32_t>::iterator position;
+      };
+
+      const size_t max_trees_;
+
+      // most recently used heights first
+      std::list<uint32_t> order_;
+      std::unordered_map<uint32_t, Entry> entries_;
+      std::mutex lock_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+#endif  // IROHA_MERKLE_TREE_CACHE_HPP
@@ -25,40 +25,57 @@ namespace iroha {
         std::function<bool(const model::Block &, WsvCommand &, WsvQuery &,
                            const hash256_t &)>
             function) {
-      transaction_->exec("SAVEPOINT savepoint_;");
-      auto result = function(block, *executor_, *this, top_hash_);
+      wsv_->savepoint([this] { transaction_->savepoint(); });
+      WsvCommand *command = wsv_.get();
+      // root and changes are kept only if the whole block is applied
+      auto state_root = state_root_;
+      std::unique_ptr<StateRootCommand> root_command;
+      if (state_root) {
+        root_command =
+            std::make_unique<StateRootCommand>(*command, *wsv_, *state_root);
+        command = root_command.get();
+      }
+      WsvChanges changes;
+      WsvChangesCommand changes_command(*command, changes);
+      if (capture_changes_) {
+        command = &changes_command;
+      }
+      auto result = function(block, *command, *this, top_hash_);
       if (result) {
-        block_store_.insert(std::make_pair(block.height, block));
+        state_root_ = state_root;
+        if (capture_changes_) {
+          changes_.emplace(block.height, std::move(changes));
+        }
+        // the block is shared with block cache once it is committed
+        block_store_.emplace(block.height,
+                             std::make_shared<const model::Block>(block));
         top_hash_ = block.hash;
-        transaction_->exec("RELEASE SAVEPOINT savepoint_;");
-      } else {
-        transaction_->exec("ROLLBACK TO SAVEPOINT savepoint_;");
+        if (wsv_->releaseSavepoint()) {
+          transaction_->releaseSavepoint();
+        }
+      } else if (wsv_->rollbackToSavepoint()) {
+        transaction_->rollbackToSavepoint();
       }
       return result;
     }
 
     MutableStorageImpl::MutableStorageImpl(
-        hash256_t top_hash, std::unique_ptr<cpp_redis::redis_client> index,
-        std::unique_ptr<pqxx::lazyconnection> connection,
-        std::unique_ptr<pqxx::nontransaction> transaction,
-        std::unique_ptr<WsvQuery> wsv, std::unique_ptr<WsvCommand> executor)
+        hash256_t top_hash,
+        std::unique_ptr<WsvTransaction> transaction,
+        bool defer_asset_writes,
+        nonstd::optional<StateRoot> state_root,
+        bool capture_changes)
         : top_hash_(top_hash),
-          index_(std::move(index)),
-          connection_(std::move(connection)),
           transaction_(std::move(transaction)),
-          wsv_(std::move(wsv)),
-          executor_(std::move(executor)),
-          committed(false) {
-      index_->multi();
-      transaction_->exec("BEGIN;");
-    }
+          wsv_(std::make_unique<CachedWsv>(transaction_->query(),
+                                           transaction_->command(),
+                                           defer_asset_writes)),
+          state_root_(state_root),
+          capture_changes_(capture_changes),
+          committed(false) {}
 
-    MutableStorageImpl::~MutableStorageImpl() {
-      if (!committed) {
-        index_->discard();
-        transaction_->exec("ROLLBACK;");
-      }
-    }
+    // uncommitted world state changes are discarded with the transaction
+    MutableStorageImpl::~MutableStorageImpl() = default;
 
     nonstd::optional<model::Account> MutableStorageImpl::getAccount(
         const std::string &account_id) {
@@ -80,6 +97,35 @@ namespace iroha {
       return wsv_->getAccountAsset(account_id, asset_id);
     }
 
+    nonstd::optional<std::vector<model::AccountAsset>>
+    MutableStorageImpl::getAccountAssets(const std::string &account_id,
+                                         const std::string &after_asset_id,
+                                         size_t limit) {
+      return wsv_->getAccountAssets(account_id, after_asset_id, limit);
+    }
+
+    nonstd::optional<std::vector<model::AccountAsset>>
+    MutableStorageImpl::getAssetHolders(const std::string &asset_id,
+                                        const std::string &after_account_id,
+                                        size_t limit) {
+      return wsv_->getAssetHolders(asset_id, after_account_id, limit);
+    }
+
+    nonstd::optional<std::vector<model::Account>>
+    MutableStorageImpl::getDomainAccounts(const std::string &domain_id,
+                                          const std::string &after_account_id,
+                                          size_t limit) {
+      return wsv_->getDomainAccounts(domain_id, after_account_id, limit);
+    }
+
+    nonstd::optional<std::vector<std::string>>
+    MutableStorageImpl::getAccountsBySignatory(
+        const ed25519::pubkey_t &signatory,
+        const std::string &after_account_id,
+        size_t limit) {
+      return wsv_->getAccountsBySignatory(signatory, after_account_id, limit);
+    }
+
     nonstd::optional<std::vector<model::Peer>> MutableStorageImpl::getPeers() {
       return wsv_->getPeers();
     }
@@ -18,10 +18,11 @@
 #ifndef IROHA_MUTABLE_STORAGE_IMPL_HPP
 #define IROHA_MUTABLE_STORAGE_IMPL_HPP
 
-#include <cpp_redis/redis_client.hpp>
-#include <pqxx/connection>
-#include <pqxx/nontransaction>
-#include <unordered_map>
+#include <map>
+#include "ametsuchi/impl/cached_wsv.hpp"
+#include "ametsuchi/impl/state_root.hpp"
+#include "ametsuchi/impl/wsv_backend.hpp"
+#include "ametsuchi/impl/wsv_changes.hpp"
 #include "ametsuchi/mutable_storage.hpp"
 
 namespace iroha {
@@ -30,12 +31,17 @@ namespace iroha {
       friend class StorageImpl;
 
      public:
+      /**
+       * @param state_root - root of state the transaction starts from,
+       * updated with applied blocks, nullopt if it is not maintained
+       * @param capture_changes - record rows written by each applied block
+       */
       MutableStorageImpl(hash256_t top_hash,
-                         std::unique_ptr<cpp_redis::redis_client> index,
-                         std::unique_ptr<pqxx::lazyconnection> connection,
-                         std::unique_ptr<pqxx::nontransaction> transaction,
-                         std::unique_ptr<WsvQuery> wsv,
-                         std::unique_ptr<WsvCommand> executor);
+                         std::unique_ptr<WsvTransaction> transaction,
+                         bool defer_asset_writes = false,
+                         nonstd::optional<StateRoot> state_root =
+                             nonstd::nullopt,
+                         bool capture_changes = false);
       bool apply(const model::Block &block,
                  std::function<bool(const model::Block &, WsvCommand &,
                                     WsvQuery &, const hash256_t &)>
@@ -49,17 +55,35 @@ namespace iroha {
           const std::string &asset_id) override;
       nonstd::optional<model::AccountAsset> getAccountAsset(
           const std::string &account_id, const std::string &asset_id) override;
+      nonstd::optional<std::vector<model::AccountAsset>> getAccountAssets(
+          const std::string &account_id,
+          const std::string &after_asset_id,
+          size_t limit) override;
+      nonstd::optional<std::vector<model::AccountAsset>> getAssetHolders(
+          const std::string &asset_id,
+          const std::string &after_account_id,
+          size_t limit) override;
+      nonstd::optional<std::vector<model::Account>> getDomainAccounts(
+          const std::string &domain_id,
+          const std::string &after_account_id,
+          size_t limit) override;
+      nonstd::optional<std::vector<std::string>> getAccountsBySignatory(
+          const ed25519::pubkey_t &signatory,
+          const std::string &after_account_id,
+          size_t limit) override;
       nonstd::optional<std::vector<model::Peer>> getPeers() override;
 
      private:
       hash256_t top_hash_;
-      std::unordered_map<uint32_t, model::Block> block_store_;
-      std::unique_ptr<cpp_redis::redis_client> index_;
-
-      std::unique_ptr<pqxx::lazyconnection> connection_;
-      std::unique_ptr<pqxx::nontransaction> transaction_;
-      std::unique_ptr<WsvQuery> wsv_;
-      std::unique_ptr<WsvCommand> executor_;
+      // ordered by height, so blocks are committed in chain order
+      std::map<uint32_t, std::shared_ptr<const model::Block>> block_store_;
+      std::unique_ptr<WsvTransaction> transaction_;
+      // serves repeated reads of the round from memory
+      std::unique_ptr<CachedWsv> wsv_;
+      nonstd::optional<StateRoot> state_root_;
+      const bool capture_changes_;
+      // rows written by applied blocks, by height
+      std::map<uint32_t, WsvChanges> changes_;
 
       bool committed;
     };
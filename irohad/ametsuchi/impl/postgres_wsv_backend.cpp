@@ -0,0 +1,658 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/postgres_wsv_backend.hpp"
+#include <algorithm>
+#include <future>
+#include <map>
+#include "ametsuchi/impl/bulk_wsv.hpp"
+#include "ametsuchi/impl/postgres_wsv_command.hpp"
+#include "ametsuchi/impl/postgres_wsv_query.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    namespace {
+      // idle connections kept by the pool
+      const size_t kConnectionPoolSize = 4;
+
+      const std::string kBegin = "BEGIN;";
+      // repeatable read takes its snapshot on the first query, not on BEGIN
+      const std::string kBeginSnapshot =
+          "BEGIN ISOLATION LEVEL REPEATABLE READ READ ONLY;\n"
+          "SELECT 1;";
+
+      const std::string kInit =
+          "CREATE TABLE IF NOT EXISTS domain (\n"
+          "    domain_id character varying(164),\n"
+          "    open bool NOT NULL DEFAULT TRUE,\n"
+          "    PRIMARY KEY (domain_id)\n"
+          ");\n"
+          "CREATE TABLE IF NOT EXISTS signatory (\n"
+          "    public_key bytea NOT NULL,\n"
+          "    PRIMARY KEY (public_key)\n"
+          ");\n"
+          "CREATE TABLE IF NOT EXISTS account (\n"
+          "    account_id character varying(197),    \n"
+          "    domain_id character varying(164) NOT NULL REFERENCES domain,\n"
+          "    master_key bytea NOT NULL REFERENCES signatory(public_key),\n"
+          "    quorum int NOT NULL,\n"
+          "    status int NOT NULL DEFAULT 0,    \n"
+          "    transaction_count bigint NOT NULL DEFAULT 0, \n"
+          "    permissions bigint NOT NULL,\n"
+          "    PRIMARY KEY (account_id)\n"
+          ");\n"
+          // counter of the latest transaction was int in earlier versions
+          "ALTER TABLE account ALTER COLUMN transaction_count TYPE bigint;\n"
+          "CREATE TABLE IF NOT EXISTS account_has_signatory (\n"
+          "    account_id character varying(197) NOT NULL REFERENCES account,\n"
+          "    public_key bytea NOT NULL REFERENCES signatory,\n"
+          "    PRIMARY KEY (account_id, public_key)\n"
+          ");\n"
+          "CREATE TABLE IF NOT EXISTS peer (\n"
+          "    public_key bytea NOT NULL,\n"
+          "    address character varying(21) NOT NULL UNIQUE,\n"
+          "    state int NOT NULL DEFAULT 0,\n"
+          "    PRIMARY KEY (public_key)\n"
+          ");\n"
+          "CREATE TABLE IF NOT EXISTS asset (\n"
+          "    asset_id character varying(197),\n"
+          "    domain_id character varying(164) NOT NULL REFERENCES domain,\n"
+          "    precision int NOT NULL,\n"
+          "    data json,\n"
+          "    PRIMARY KEY (asset_id)\n"
+          ");\n"
+          "CREATE TABLE IF NOT EXISTS account_has_asset (\n"
+          "    account_id character varying(197) NOT NULL REFERENCES account,\n"
+          "    asset_id character varying(197) NOT NULL REFERENCES asset,\n"
+          "    amount bigint NOT NULL,\n"
+          "    permissions bit varying NOT NULL,\n"
+          "    PRIMARY KEY (account_id, asset_id)\n"
+          ");\n"
+          "CREATE TABLE IF NOT EXISTS exchange (\n"
+          "    asset1_id character varying(197) NOT NULL REFERENCES "
+          "asset(asset_id),\n"
+          "    asset2_id character varying(197) NOT NULL REFERENCES "
+          "asset(asset_id),\n"
+          "    asset1 bigint NOT NULL,\n"
+          "    asset2 bigint NOT NULL,\n"
+          "    PRIMARY KEY (asset1_id, asset2_id)\n"
+          ");\n"
+          // lookups by columns other than primary keys, e.g. holders of
+          // asset, ordered by account for pagination
+          "CREATE INDEX IF NOT EXISTS account_domain_id_idx\n"
+          "    ON account (domain_id, account_id);\n"
+          "CREATE INDEX IF NOT EXISTS account_has_asset_asset_id_idx\n"
+          "    ON account_has_asset (asset_id, account_id);\n"
+          "CREATE INDEX IF NOT EXISTS account_has_signatory_public_key_idx\n"
+          "    ON account_has_signatory (public_key, account_id);\n"
+          "CREATE TABLE IF NOT EXISTS ledger_height (\n"
+          "    height bigint NOT NULL\n"
+          ");\n"
+          "INSERT INTO ledger_height SELECT 0\n"
+          "    WHERE NOT EXISTS (SELECT 1 FROM ledger_height);";
+
+      ed25519::pubkey_t pubkey(const pqxx::field &field) {
+        pqxx::binarystring bytes(field);
+        ed25519::pubkey_t pubkey{};
+        std::copy_n(bytes.begin(), std::min(bytes.size(), pubkey.size()),
+                    pubkey.begin());
+        return pubkey;
+      }
+
+      /**
+       * Transaction on pooled connection, rolled back unless committed
+       */
+      class PostgresWsvTransaction : public WsvTransaction {
+       public:
+        /**
+         * @param connection - connection to run the transaction on
+         * @param begin - statements starting the transaction
+         */
+        PostgresWsvTransaction(
+            PooledConnection<pqxx::lazyconnection> connection,
+            const std::string &begin)
+            : connection_(std::move(connection)),
+              transaction_(std::make_unique<pqxx::nontransaction>(
+                  *connection_, "WsvTransaction")),
+              begin_(begin),
+              committed_(false) {
+          transaction_->exec(begin_);
+        }
+
+        ~PostgresWsvTransaction() override {
+          if (not committed_) {
+            transaction_->exec("ROLLBACK;");
+          }
+        }
+
+        std::unique_ptr<WsvQuery> query() override {
+          return std::make_unique<PostgresWsvQuery>(*transaction_);
+        }
+
+        std::unique_ptr<WsvCommand> command() override {
+          return std::make_unique<PostgresWsvCommand>(*transaction_);
+        }
+
+        void setHeight(uint32_t height) override {
+          transaction_->exec("UPDATE ledger_height SET height = " +
+                             std::to_string(height) + ";");
+        }
+
+        bool dump(BulkTables &tables) override {
+          try {
+            for (const auto &row :
+                 transaction_->exec("SELECT domain_id FROM domain;")) {
+              model::Domain domain;
+              row.at("domain_id") >> domain.domain_id;
+              tables.domains.emplace(domain.domain_id, domain);
+            }
+            for (const auto &row :
+                 transaction_->exec("SELECT public_key FROM signatory;")) {
+              tables.signatories.insert(pubkey(row.at("public_key")));
+            }
+            for (const auto &row : transaction_->exec(
+                     "SELECT account_id, domain_id, master_key, quorum, "
+                     "transaction_count, permissions FROM account;")) {
+              model::Account account;
+              row.at("account_id") >> account.account_id;
+              row.at("domain_id") >> account.domain_name;
+              account.master_key = pubkey(row.at("master_key"));
+              row.at("quorum") >> account.quorum;
+              int64_t tx_counter;
+              row.at("transaction_count") >> tx_counter;
+              account.tx_counter = static_cast<uint64_t>(tx_counter);
+              int64_t permissions;
+              row.at("permissions") >> permissions;
+              account.permissions = model::Account::Permissions::fromBitmask(
+                  static_cast<uint64_t>(permissions));
+              tables.accounts.emplace(account.account_id, account);
+            }
+            for (const auto &row : transaction_->exec(
+                     "SELECT account_id, public_key "
+                     "FROM account_has_signatory;")) {
+              std::string account_id;
+              row.at("account_id") >> account_id;
+              tables.account_signatories[account_id].push_back(
+                  pubkey(row.at("public_key")));
+            }
+            for (const auto &row : transaction_->exec(
+                     "SELECT asset_id, domain_id, precision FROM asset;")) {
+              model::Asset asset;
+              row.at("asset_id") >> asset.asset_id;
+              row.at("domain_id") >> asset.domain_id;
+              int32_t precision;
+              row.at("precision") >> precision;
+              asset.precision = precision;
+              tables.assets.emplace(asset.asset_id, asset);
+            }
+            for (const auto &row : transaction_->exec(
+                     "SELECT account_id, asset_id, amount "
+                     "FROM account_has_asset;")) {
+              model::AccountAsset asset;
+              row.at("account_id") >> asset.account_id;
+              row.at("asset_id") >> asset.asset_id;
+              row.at("amount") >> asset.balance;
+              tables.account_assets.emplace(
+                  std::make_pair(asset.account_id, asset.asset_id), asset);
+            }
+            for (const auto &row :
+                 transaction_->exec("SELECT public_key, address FROM peer;")) {
+              model::Peer peer;
+              peer.pubkey = pubkey(row.at("public_key"));
+              row.at("address") >> peer.address;
+              tables.peers.push_back(peer);
+            }
+          } catch (const std::exception &e) {
+            return false;
+          }
+          return true;
+        }
+
+        bool reset() override {
+          if (committed_) {
+            return false;
+          }
+          try {
+            // one round trip, row locks are released by rollback
+            transaction_->exec("ROLLBACK;\n" + begin_);
+          } catch (const std::exception &e) {
+            return false;
+          }
+          return true;
+        }
+
+        void savepoint() override {
+          transaction_->exec("SAVEPOINT savepoint_;");
+        }
+
+        void releaseSavepoint() override {
+          transaction_->exec("RELEASE SAVEPOINT savepoint_;");
+        }
+
+        void rollbackToSavepoint() override {
+          transaction_->exec("ROLLBACK TO SAVEPOINT savepoint_;");
+        }
+
+        bool commit() override {
+          try {
+            transaction_->exec("COMMIT;");
+          } catch (const std::exception &e) {
+            return false;
+          }
+          committed_ = true;
+          return true;
+        }
+
+       private:
+        PooledConnection<pqxx::lazyconnection> connection_;
+        std::unique_ptr<pqxx::nontransaction> transaction_;
+        const std::string begin_;
+        bool committed_;
+      };
+
+      /**
+       * Constraint of the schema which is rebuilt after bulk load
+       */
+      struct Constraint {
+        const char *table;
+        const char *name;
+        const char *definition;
+      };
+
+      const Constraint kKeys[] = {
+          {"domain", "domain_pkey", "PRIMARY KEY (domain_id)"},
+          {"signatory", "signatory_pkey", "PRIMARY KEY (public_key)"},
+          {"account", "account_pkey", "PRIMARY KEY (account_id)"},
+          {"account_has_signatory",
+           "account_has_signatory_pkey",
+           "PRIMARY KEY (account_id, public_key)"},
+          {"peer", "peer_pkey", "PRIMARY KEY (public_key)"},
+          {"peer", "peer_address_key", "UNIQUE (address)"},
+          {"asset", "asset_pkey", "PRIMARY KEY (asset_id)"},
+          {"account_has_asset",
+           "account_has_asset_pkey",
+           "PRIMARY KEY (account_id, asset_id)"}};
+
+      // dropped before the keys they refer to
+      const Constraint kForeignKeys[] = {
+          {"account",
+           "account_domain_id_fkey",
+           "FOREIGN KEY (domain_id) REFERENCES domain"},
+          {"account",
+           "account_master_key_fkey",
+           "FOREIGN KEY (master_key) REFERENCES signatory(public_key)"},
+          {"account_has_signatory",
+           "account_has_signatory_account_id_fkey",
+           "FOREIGN KEY (account_id) REFERENCES account"},
+          {"account_has_signatory",
+           "account_has_signatory_public_key_fkey",
+           "FOREIGN KEY (public_key) REFERENCES signatory"},
+          {"asset",
+           "asset_domain_id_fkey",
+           "FOREIGN KEY (domain_id) REFERENCES domain"},
+          {"account_has_asset",
+           "account_has_asset_account_id_fkey",
+           "FOREIGN KEY (account_id) REFERENCES account"},
+          {"account_has_asset",
+           "account_has_asset_asset_id_fkey",
+           "FOREIGN KEY (asset_id) REFERENCES asset"},
+          {"exchange",
+           "exchange_asset1_id_fkey",
+           "FOREIGN KEY (asset1_id) REFERENCES asset(asset_id)"},
+          {"exchange",
+           "exchange_asset2_id_fkey",
+           "FOREIGN KEY (asset2_id) REFERENCES asset(asset_id)"}};
+
+      // secondary indexes, definition is the list of columns
+      const Constraint kIndexes[] = {
+          {"account", "account_domain_id_idx", "(domain_id, account_id)"},
+          {"account_has_asset",
+           "account_has_asset_asset_id_idx",
+           "(asset_id, account_id)"},
+          {"account_has_signatory",
+           "account_has_signatory_public_key_idx",
+           "(public_key, account_id)"}};
+
+      /**
+       * Public key in bytea input format, backslash is escaped by COPY
+       * writer
+       */
+      std::string bytea(const ed25519::pubkey_t &key) {
+        return "\\x" + key.to_hexstring();
+      }
+
+      /**
+       * Transaction of trusted load into empty state. Rows are collected in
+       * memory and written with COPY into tables without constraints, which
+       * are created afterwards. Load and rebuild of constraints are not
+       * atomic, if commit fails tables have to be recreated.
+       */
+      class PostgresBulkTransaction : public WsvTransaction {
+       public:
+        PostgresBulkTransaction(ConnectionPool<pqxx::lazyconnection> &pool,
+                                logger::Logger log)
+            : pool_(pool), height_(0), failed_(false), log_(std::move(log)) {}
+
+        std::unique_ptr<WsvQuery> query() override {
+          return std::make_unique<BulkWsv>(tables_);
+        }
+
+        std::unique_ptr<WsvCommand> command() override {
+          return std::make_unique<BulkWsv>(tables_);
+        }
+
+        void setHeight(uint32_t height) override { height_ = height; }
+
+        void savepoint() override {}
+
+        void releaseSavepoint() override {}
+
+        // changes are not undone, trusted input must apply cleanly
+        void rollbackToSavepoint() override { failed_ = true; }
+
+        bool commit() override {
+          if (failed_) {
+            log_->error("Bulk load contains rejected commands");
+            return false;
+          }
+          if (not load()) {
+            return false;
+          }
+          // tables are locked by ALTER TABLE, so keys and indexes of
+          // different tables are built concurrently, foreign keys need all
+          // of them
+          std::map<std::string, std::vector<const Constraint *>> tables;
+          for (const auto &key : kKeys) {
+            tables[key.table].push_back(&key);
+          }
+          std::map<std::string, std::vector<const Constraint *>> indexes;
+          for (const auto &index : kIndexes) {
+            indexes[index.table].push_back(&index);
+          }
+          std::vector<std::future<bool>> builds;
+          for (const auto &table : tables) {
+            builds.push_back(std::async(
+                std::launch::async,
+                [this, &table, table_indexes = indexes[table.first]] {
+                  return this->add(table.second)
+                      and this->index(table_indexes);
+                }));
+          }
+          auto built = true;
+          for (auto &build : builds) {
+            built = build.get() and built;
+          }
+          std::vector<const Constraint *> foreign_keys;
+          for (const auto &key : kForeignKeys) {
+            foreign_keys.push_back(&key);
+          }
+          return built and add(foreign_keys);
+        }
+
+       private:
+        /**
+         * Drop constraints and copy collected rows
+         */
+        bool load() {
+          auto connection = pool_.acquire();
+          if (not connection) {
+            return false;
+          }
+          try {
+            pqxx::work work(*connection, "BulkLoad");
+            auto filled = work.exec(
+                "SELECT EXISTS (SELECT 1 FROM domain) OR "
+                "EXISTS (SELECT 1 FROM signatory) OR "
+                "EXISTS (SELECT 1 FROM peer);");
+            if (filled.at(0).at(0).as<bool>()) {
+              log_->error("Bulk load requires empty world state view");
+              return false;
+            }
+            for (const auto &key : kForeignKeys) {
+              drop(work, key);
+            }
+            for (const auto &key : kKeys) {
+              drop(work, key);
+            }
+            // indexes would be updated by every copied row otherwise
+            for (const auto &index : kIndexes) {
+              work.exec(std::string("DROP INDEX IF EXISTS ") + index.name +
+                        ";");
+            }
+
+            copy(work, "domain", {"domain_id"}, [this](auto &writer) {
+              for (const auto &domain : tables_.domains) {
+                writer.insert(std::vector<std::string>{domain.first});
+              }
+            });
+            copy(work, "signatory", {"public_key"}, [this](auto &writer) {
+              for (const auto &key : tables_.signatories) {
+                writer.insert(std::vector<std::string>{bytea(key)});
+              }
+            });
+            copy(work,
+                 "account",
+                 {"account_id", "domain_id", "master_key", "quorum",
+                  "transaction_count", "permissions"},
+                 [this](auto &writer) {
+                   for (const auto &pair : tables_.accounts) {
+                     const auto &account = pair.second;
+                     writer.insert(std::vector<std::string>{
+                         account.account_id,
+                         account.domain_name,
+                         bytea(account.master_key),
+                         std::to_string(account.quorum),
+                         std::to_string(
+                             static_cast<int64_t>(account.tx_counter)),
+                         std::to_string(static_cast<int64_t>(
+                             account.permissions.toBitmask()))});
+                   }
+                 });
+            copy(work,
+                 "account_has_signatory",
+                 {"account_id", "public_key"},
+                 [this](auto &writer) {
+                   for (const auto &pair : tables_.account_signatories) {
+                     for (const auto &key : pair.second) {
+                       writer.insert(
+                           std::vector<std::string>{pair.first, bytea(key)});
+                     }
+                   }
+                 });
+            copy(work,
+                 "peer",
+                 {"public_key", "address"},
+                 [this](auto &writer) {
+                   for (const auto &peer : tables_.peers) {
+                     writer.insert(std::vector<std::string>{
+                         bytea(peer.pubkey), peer.address});
+                   }
+                 });
+            copy(work,
+                 "asset",
+                 {"asset_id", "domain_id", "precision"},
+                 [this](auto &writer) {
+                   for (const auto &pair : tables_.assets) {
+                     const auto &asset = pair.second;
+                     writer.insert(std::vector<std::string>{
+                         asset.asset_id,
+                         asset.domain_id,
+                         std::to_string(asset.precision)});
+                   }
+                 });
+            copy(work,
+                 "account_has_asset",
+                 {"account_id", "asset_id", "amount", "permissions"},
+                 [this](auto &writer) {
+                   for (const auto &pair : tables_.account_assets) {
+                     const auto &asset = pair.second;
+                     writer.insert(std::vector<std::string>{
+                         asset.account_id,
+                         asset.asset_id,
+                         std::to_string(asset.balance),
+                         "0"});
+                   }
+                 });
+            work.exec("UPDATE ledger_height SET height = " +
+                      std::to_string(height_) + ";");
+            work.commit();
+          } catch (const std::exception &e) {
+            log_->error("Bulk load failed: {}", e.what());
+            return false;
+          }
+          log_->info("Bulk load of {} accounts completed",
+                     tables_.accounts.size());
+          return true;
+        }
+
+        /**
+         * Create constraints in one transaction on separate connection
+         */
+        bool add(const std::vector<const Constraint *> &constraints) {
+          auto connection = pool_.acquire();
+          if (not connection) {
+            return false;
+          }
+          try {
+            pqxx::work work(*connection, "BulkConstraints");
+            for (const auto &constraint : constraints) {
+              work.exec(std::string("ALTER TABLE ") + constraint->table +
+                        " ADD CONSTRAINT " + constraint->name + " " +
+                        constraint->definition + ";");
+            }
+            work.commit();
+          } catch (const std::exception &e) {
+            log_->error("Constraints of bulk load violated: {}", e.what());
+            return false;
+          }
+          return true;
+        }
+
+        /**
+         * Create secondary indexes in one transaction on separate
+         * connection
+         */
+        bool index(const std::vector<const Constraint *> &indexes) {
+          if (indexes.empty()) {
+            return true;
+          }
+          auto connection = pool_.acquire();
+          if (not connection) {
+            return false;
+          }
+          try {
+            pqxx::work work(*connection, "BulkIndexes");
+            for (const auto &index : indexes) {
+              work.exec(std::string("CREATE INDEX ") + index->name + " ON " +
+                        index->table + " " + index->definition + ";");
+            }
+            work.commit();
+          } catch (const std::exception &e) {
+            log_->error("Indexes of bulk load not built: {}", e.what());
+            return false;
+          }
+          return true;
+        }
+
+        static void drop(pqxx::work &work, const Constraint &constraint) {
+          work.exec(std::string("ALTER TABLE ") + constraint.table +
+                    " DROP CONSTRAINT " + constraint.name + ";");
+        }
+
+        template <typename Rows>
+        static void copy(pqxx::work &work,
+                         const std::string &table,
+                         const std::vector<std::string> &columns,
+                         Rows rows) {
+          pqxx::tablewriter writer(work, table, columns.begin(),
+                                   columns.end());
+          rows(writer);
+          writer.complete();
+        }
+
+        ConnectionPool<pqxx::lazyconnection> &pool_;
+        BulkTables tables_;
+        uint32_t height_;
+        bool failed_;
+        logger::Logger log_;
+      };
+    }  // namespace
+
+    PostgresWsvBackend::PostgresWsvBackend(const std::string &options)
+        : options_(options),
+          pool_(kConnectionPoolSize,
+                [this]() -> std::unique_ptr<pqxx::lazyconnection> {
+                  auto connection =
+                      std::make_unique<pqxx::lazyconnection>(options_);
+                  try {
+                    connection->activate();
+                  } catch (const pqxx::broken_connection &e) {
+                    log_->error("Connection to PostgreSQL broken: {}",
+                                e.what());
+                    return nullptr;
+                  }
+                  return connection;
+                },
+                [](pqxx::lazyconnection &connection) {
+                  return connection.is_open();
+                }),
+          log_(logger::log("PostgresWsvBackend")) {}
+
+    std::unique_ptr<PostgresWsvBackend> PostgresWsvBackend::create(
+        const std::string &options) {
+      auto log = logger::log("PostgresWsvBackend:create");
+      try {
+        pqxx::lazyconnection connection(options);
+        connection.activate();
+        log->info("connection to PostgreSQL completed");
+        pqxx::nontransaction transaction(connection, "Storage");
+        transaction.exec(kInit);
+      } catch (const std::exception &e) {
+        log->error("Initialization of PostgreSQL failed: {}", e.what());
+        return nullptr;
+      }
+      log->info("tables of PostgreSQL initialized");
+
+      return std::unique_ptr<PostgresWsvBackend>(
+          new PostgresWsvBackend(options));
+    }
+
+    std::unique_ptr<WsvTransaction> PostgresWsvBackend::begin() {
+      auto connection = pool_.acquire();
+      if (not connection) {
+        return nullptr;
+      }
+      return std::make_unique<PostgresWsvTransaction>(std::move(connection),
+                                                      kBegin);
+    }
+
+    std::unique_ptr<WsvTransaction> PostgresWsvBackend::snapshot() {
+      auto connection = pool_.acquire();
+      if (not connection) {
+        return nullptr;
+      }
+      return std::make_unique<PostgresWsvTransaction>(std::move(connection),
+                                                      kBeginSnapshot);
+    }
+
+    std::unique_ptr<WsvTransaction> PostgresWsvBackend::beginBulk() {
+      return std::make_unique<PostgresBulkTransaction>(pool_, log_);
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,68 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_POSTGRES_WSV_BACKEND_HPP
+#define IROHA_POSTGRES_WSV_BACKEND_HPP
+
+#include <pqxx/pqxx>
+#include <string>
+#include "ametsuchi/impl/connection_pool.hpp"
+#include "ametsuchi/impl/wsv_backend.hpp"
+#include "logger/logger.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * World state view kept in PostgreSQL.
+     * Transactions are run on pooled connections.
+     */
+    class PostgresWsvBackend : public WsvBackend {
+     public:
+      /**
+       * Connect to PostgreSQL and create tables if needed
+       * @param options - connection string
+       * @return backend or nullptr if database is unavailable
+       */
+      static std::unique_ptr<PostgresWsvBackend> create(
+          const std::string &options);
+
+      std::unique_ptr<WsvTransaction> begin() override;
+
+      /**
+       * Rows are written with COPY on commit, keys are dropped for the load
+       * and rebuilt afterwards, concurrently for different tables
+       */
+      std::unique_ptr<WsvTransaction> beginBulk() override;
+
+      /**
+       * Snapshot is read only transaction with repeatable read isolation
+       */
+      std::unique_ptr<WsvTransaction> snapshot() override;
+
+     private:
+      explicit PostgresWsvBackend(const std::string &options);
+
+      const std::string options_;
+      ConnectionPool<pqxx::lazyconnection> pool_;
+
+      logger::Logger log_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+#endif  // IROHA_POSTGRES_WSV_BACKEND_HPP
@@ -16,44 +16,96 @@
  */
 
 #include "ametsuchi/impl/postgres_wsv_command.hpp"
+#include <algorithm>
 #include <iostream>
 
 namespace iroha {
   namespace ametsuchi {
 
+    namespace {
+      const std::string kInsertAccount = "wsv_insert_account";
+      const std::string kUpdateAccount = "wsv_update_account";
+      const std::string kInsertAsset = "wsv_insert_asset";
+      const std::string kUpsertAccountAsset = "wsv_upsert_account_asset";
+      const std::string kInsertSignatory = "wsv_insert_signatory";
+      const std::string kInsertAccountSignatory =
+          "wsv_insert_account_signatory";
+      const std::string kDeleteAccountSignatory =
+          "wsv_delete_account_signatory";
+      const std::string kInsertPeer = "wsv_insert_peer";
+      const std::string kDeletePeer = "wsv_delete_peer";
+      const std::string kInsertDomain = "wsv_insert_domain";
+
+      // rows written by one multi-row statement
+      const size_t kUpsertChunkSize = 1000;
+    }  // namespace
+
     PostgresWsvCommand::PostgresWsvCommand(pqxx::nontransaction &transaction)
-        : transaction_(transaction) {}
+        : transaction_(transaction) {
+      // statements are prepared by the connection on first use and reused
+      // by all commands over it
+      auto &connection = transaction_.conn();
+      connection.prepare(
+          kInsertAccount,
+          "INSERT INTO account(\n"
+          "            account_id, domain_id, master_key, quorum, status, "
+          "transaction_count, \n"
+          "            permissions)\n"
+          "    VALUES ($1, $2, $3, $4, $5, $6, $7);");
+      connection.prepare(kUpdateAccount,
+                         "UPDATE account\n"
+                         "   SET master_key=$2, quorum=$3, status=$4, "
+                         "transaction_count=$5, permissions=$6\n"
+                         " WHERE account_id=$1;");
+      connection.prepare(kInsertAsset,
+                         "INSERT INTO asset(\n"
+                         "            asset_id, domain_id, \"precision\", "
+                         "data)\n"
+                         "    VALUES ($1, $2, $3, NULL);");
+      connection.prepare(kUpsertAccountAsset,
+                         "INSERT INTO public.account_has_asset(\n"
+                         "            account_id, asset_id, amount, "
+                         "permissions)\n"
+                         "    VALUES ($1, $2, $3, $4)\n"
+                         "    ON CONFLICT (account_id, asset_id)\n"
+                         "    DO UPDATE SET \n"
+                         "        amount=EXCLUDED.amount, \n"
+                         "        permissions=EXCLUDED.permissions;");
+      connection.prepare(kInsertSignatory,
+                         "INSERT INTO signatory(\n"
+                         "            public_key)\n"
+                         "    VALUES ($1);");
+      connection.prepare(kInsertAccountSignatory,
+                         "INSERT INTO account_has_signatory(\n"
+                         "            account_id, public_key)\n"
+                         "    VALUES ($1, $2);");
+      connection.prepare(kDeleteAccountSignatory,
+                         "DELETE FROM account_has_signatory\n"
+                         " WHERE account_id=$1 AND public_key=$2;");
+      connection.prepare(kInsertPeer,
+                         "INSERT INTO peer(\n"
+                         "            public_key, address, state)\n"
+                         "    VALUES ($1, $2, $3);");
+      connection.prepare(kDeletePeer,
+                         "DELETE FROM peer\n"
+                         " WHERE public_key=$1 AND address=$2;");
+      connection.prepare(kInsertDomain,
+                         "INSERT INTO domain(\n"
+                         "            domain_id, open)\n"
+                         "    VALUES ($1, $2);");
+    }
 
     bool PostgresWsvCommand::insertAccount(const model::Account &account) {
       pqxx::binarystring master_key(account.master_key.data(),
                                     account.master_key.size());
-      std::stringstream permissions;
-      permissions << account.permissions.add_signatory
-                  << account.permissions.can_transfer
-                  << account.permissions.create_accounts
-                  << account.permissions.create_assets
-                  << account.permissions.create_domains
-                  << account.permissions.issue_assets
-                  << account.permissions.read_all_accounts
-                  << account.permissions.remove_signatory
-                  << account.permissions.set_permissions
-                  << account.permissions.set_quorum;
+      auto permissions =
+          static_cast<int64_t>(account.permissions.toBitmask());
       try {
-        transaction_.exec(
-            "INSERT INTO account(\n"
-            "            account_id, domain_id, master_key, quorum, status, "
-            "transaction_count, \n"
-            "            permissions)\n"
-            "    VALUES (" +
-            transaction_.quote(account.account_id) + ", " +
-            transaction_.quote(account.domain_name) + ", " +
-            transaction_.quote(master_key) + ", " +
-            transaction_.quote(account.quorum) + ", " +
-            /*account.status*/ transaction_.quote(0) + ", " +
-            /*account.transaction_count*/ transaction_.quote(0) +
-            ", \n"
-            "            " +
-            transaction_.quote(permissions.str()) + ");");
+        transaction_.prepared(kInsertAccount)(account.account_id)(
+            account.domain_name)(master_key)(account.quorum)(
+            /*account.status*/ 0)(static_cast<int64_t>(account.tx_counter))(
+            permissions)
+            .exec();
       } catch (const std::exception &e) {
         std::cerr << e.what() << std::endl;
         return false;
@@ -64,14 +116,9 @@ namespace iroha {
     bool PostgresWsvCommand::insertAsset(const model::Asset &asset) {
       uint32_t precision = asset.precision;
       try {
-        transaction_.exec(
-            "INSERT INTO asset(\n"
-            "            asset_id, domain_id, \"precision\", data)\n"
-            "    VALUES (" +
-            transaction_.quote(asset.asset_id) + ", " +
-            transaction_.quote(asset.domain_id) + ", " +
-            transaction_.quote(precision) + ", " + /*asset.data*/ "NULL" +
-            ");");
+        transaction_.prepared(kInsertAsset)(asset.asset_id)(asset.domain_id)(
+            precision)
+            .exec();
       } catch (const std::exception &e) {
         return false;
       }
@@ -81,34 +128,54 @@ namespace iroha {
     bool PostgresWsvCommand::upsertAccountAsset(
         const model::AccountAsset &asset) {
       try {
-        transaction_.exec(
-            "INSERT INTO public.account_has_asset(\n"
-            "            account_id, asset_id, amount, permissions)\n"
-            "    VALUES (" +
-            transaction_.quote(asset.account_id) + ", " +
-            transaction_.quote(asset.asset_id) + ", " +
-            transaction_.quote(asset.balance) + ", " +
-            /*asset.permissions*/ transaction_.quote(0) +
-            ")\n"
-            "    ON CONFLICT (account_id, asset_id)\n"
-            "    DO UPDATE SET \n"
-            "        amount=EXCLUDED.amount, \n"
-            "        permissions=EXCLUDED.permissions;");
+        transaction_.prepared(kUpsertAccountAsset)(asset.account_id)(
+            asset.asset_id)(asset.balance)(/*asset.permissions*/ 0)
+            .exec();
       } catch (const std::exception &e) {
         return false;
       }
       return true;
     }
 
+    bool PostgresWsvCommand::upsertAccountAssets(
+        const std::vector<model::AccountAsset> &assets) {
+      for (size_t begin = 0; begin < assets.size();
+           begin += kUpsertChunkSize) {
+        auto end = std::min(assets.size(), begin + kUpsertChunkSize);
+        std::string values;
+        for (auto i = begin; i < end; ++i) {
+          if (i != begin) {
+            values += ",\n           ";
+          }
+          values += "(" + transaction_.quote(assets[i].account_id) + ", " +
+              transaction_.quote(assets[i].asset_id) + ", " +
+              transaction_.quote(assets[i].balance) + ", " +
+              /*asset.permissions*/ transaction_.quote(0) + ")";
+        }
+        try {
+          transaction_.exec(
+              "INSERT INTO public.account_has_asset(\n"
+              "            account_id, asset_id, amount, permissions)\n"
+              "    VALUES " +
+              values +
+              "\n"
+              "    ON CONFLICT (account_id, asset_id)\n"
+              "    DO UPDATE SET \n"
+              "        amount=EXCLUDED.amount, \n"
+              "        permissions=EXCLUDED.permissions;");
+        } catch (const std::exception &e) {
+          std::cerr << e.what() << std::endl;
+          return false;
+        }
+      }
+      return true;
+    }
+
     bool PostgresWsvCommand::insertSignatory(
         const ed25519::pubkey_t &signatory) {
       try {
         pqxx::binarystring public_key(signatory.data(), signatory.size());
-        transaction_.exec(
-            "INSERT INTO signatory(\n"
-            "            public_key)\n"
-            "    VALUES (" +
-            transaction_.quote(public_key) + ");");
+        transaction_.prepared(kInsertSignatory)(public_key).exec();
       } catch (const std::exception &e) {
         return false;
       }
@@ -119,12 +186,8 @@ namespace iroha {
         const std::string &account_id, const ed25519::pubkey_t &signatory) {
       pqxx::binarystring public_key(signatory.data(), signatory.size());
       try {
-        transaction_.exec(
-            "INSERT INTO account_has_signatory(\n"
-            "            account_id, public_key)\n"
-            "    VALUES (" +
-            transaction_.quote(account_id) + ", " +
-            transaction_.quote(public_key) + ");");
+        transaction_.prepared(kInsertAccountSignatory)(account_id)(public_key)
+            .exec();
       } catch (const std::exception &e) {
         return false;
       }
@@ -135,11 +198,8 @@ namespace iroha {
         const std::string &account_id, const ed25519::pubkey_t &signatory) {
       pqxx::binarystring public_key(signatory.data(), signatory.size());
       try {
-        transaction_.exec(
-            "DELETE FROM account_has_signatory\n"
-            " WHERE account_id=" +
-            transaction_.quote(account_id) + " AND public_key=" +
-            transaction_.quote(public_key) + ";");
+        transaction_.prepared(kDeleteAccountSignatory)(account_id)(public_key)
+            .exec();
       } catch (const std::exception &e) {
         return false;
       }
@@ -149,13 +209,9 @@ namespace iroha {
     bool PostgresWsvCommand::insertPeer(const model::Peer &peer) {
       pqxx::binarystring public_key(peer.pubkey.data(), peer.pubkey.size());
       try {
-        transaction_.exec(
-            "INSERT INTO peer(\n"
-            "            public_key, address, state)\n"
-            "    VALUES (" +
-            transaction_.quote(public_key) + ", " +
-            transaction_.quote(peer.address) + ", " +
-            /*peer.state*/ transaction_.quote(0) + ");");
+        transaction_.prepared(kInsertPeer)(public_key)(peer.address)(
+            /*peer.state*/ 0)
+            .exec();
       } catch (const std::exception &e) {
         return false;
       }
@@ -165,11 +221,7 @@ namespace iroha {
     bool PostgresWsvCommand::deletePeer(const model::Peer &peer) {
       pqxx::binarystring public_key(peer.pubkey.data(), peer.pubkey.size());
       try {
-        transaction_.exec(
-            "DELETE FROM peer\n"
-            " WHERE public_key=" +
-            transaction_.quote(public_key) + " AND address=" +
-            transaction_.quote(peer.address) + ";");
+        transaction_.prepared(kDeletePeer)(public_key)(peer.address).exec();
       } catch (const std::exception &e) {
         return false;
       }
@@ -178,12 +230,9 @@ namespace iroha {
 
     bool PostgresWsvCommand::insertDomain(const model::Domain &domain) {
       try {
-        transaction_.exec(
-            "INSERT INTO domain(\n"
-            "            domain_id, open)\n"
-            "    VALUES (" +
-            transaction_.quote(domain.domain_id) + ", " +
-            /*domain.open*/ transaction_.quote(true) + ");");
+        transaction_.prepared(kInsertDomain)(domain.domain_id)(
+            /*domain.open*/ true)
+            .exec();
       } catch (const std::exception &e) {
         std::cerr << e.what() << std::endl;
         return false;
@@ -194,29 +243,13 @@ namespace iroha {
     bool PostgresWsvCommand::updateAccount(const model::Account &account) {
       pqxx::binarystring master_key(account.master_key.data(),
                                     account.master_key.size());
-      std::stringstream permissions;
-      permissions << account.permissions.add_signatory
-                  << account.permissions.can_transfer
-                  << account.permissions.create_accounts
-                  << account.permissions.create_assets
-                  << account.permissions.create_domains
-                  << account.permissions.issue_assets
-                  << account.permissions.read_all_accounts
-                  << account.permissions.remove_signatory
-                  << account.permissions.set_permissions
-                  << account.permissions.set_quorum;
+      auto permissions =
+          static_cast<int64_t>(account.permissions.toBitmask());
       try {
-        transaction_.exec(
-            "UPDATE account\n"
-            "   SET master_key=" +
-            transaction_.quote(master_key) + ", quorum=" +
-            transaction_.quote(account.quorum) + ", status=" +
-            /*account.status*/ transaction_.quote(0) + ", transaction_count=" +
-            /*account.transaction_count*/ transaction_.quote(0) +
-            ", permissions=" + transaction_.quote(permissions.str()) +
-            "\n"
-            " WHERE account_id=" +
-            transaction_.quote(account.account_id) + ";");
+        transaction_.prepared(kUpdateAccount)(account.account_id)(master_key)(
+            account.quorum)(/*account.status*/ 0)(
+            static_cast<int64_t>(account.tx_counter))(permissions)
+            .exec();
       } catch (const std::exception &e) {
         std::cerr << e.what() << std::endl;
         return false;
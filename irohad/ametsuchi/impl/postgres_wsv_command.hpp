@@ -30,6 +30,8 @@ namespace iroha {
       bool updateAccount(const model::Account &account) override;
       bool insertAsset(const model::Asset &asset) override;
       bool upsertAccountAsset(const model::AccountAsset &asset) override;
+      bool upsertAccountAssets(
+          const std::vector<model::AccountAsset> &assets) override;
       bool insertSignatory(const ed25519::pubkey_t &signatory) override;
       bool insertAccountSignatory(const std::string &account_id,
                                   const ed25519::pubkey_t &signatory) override;
@@ -29,20 +29,130 @@ namespace iroha {
     using model::AccountAsset;
     using model::Peer;
 
+    namespace {
+      const std::string kGetAccount = "wsv_get_account";
+      const std::string kGetSignatories = "wsv_get_signatories";
+      const std::string kGetAsset = "wsv_get_asset";
+      const std::string kGetAccountAsset = "wsv_get_account_asset";
+      const std::string kGetAccountAssets = "wsv_get_account_assets";
+      const std::string kGetAssetHolders = "wsv_get_asset_holders";
+      const std::string kGetDomainAccounts = "wsv_get_domain_accounts";
+      const std::string kGetAccountsBySignatory =
+          "wsv_get_accounts_by_signatory";
+      const std::string kGetPeers = "wsv_get_peers";
+
+      template <typename Row>
+      Account accountOf(const Row &row) {
+        Account account;
+        row.at("account_id") >> account.account_id;
+        row.at("domain_id") >> account.domain_name;
+        pqxx::binarystring master_key(row.at("master_key"));
+        std::copy(master_key.begin(), master_key.end(),
+                  account.master_key.begin());
+        row.at("quorum") >> account.quorum;
+        //      row.at("status") >> ?
+        int64_t tx_counter;
+        row.at("transaction_count") >> tx_counter;
+        account.tx_counter = static_cast<uint64_t>(tx_counter);
+        int64_t permissions;
+        row.at("permissions") >> permissions;
+        account.permissions = Account::Permissions::fromBitmask(
+            static_cast<uint64_t>(permissions));
+        return account;
+      }
+    }  // namespace
+
     PostgresWsvQuery::PostgresWsvQuery(pqxx::nontransaction &transaction)
-        : transaction_(transaction) {}
+        : transaction_(transaction) {
+      // statements are prepared by the connection on first use and reused
+      // by all queries over it
+      auto &connection = transaction_.conn();
+      connection.prepare(kGetAccount,
+                         "SELECT \n"
+                         "  *\n"
+                         "FROM \n"
+                         "  account\n"
+                         "WHERE \n"
+                         "  account.account_id = $1;");
+      connection.prepare(kGetSignatories,
+                         "SELECT \n"
+                         "  account_has_signatory.public_key\n"
+                         "FROM \n"
+                         "  account_has_signatory\n"
+                         "WHERE \n"
+                         "  account_has_signatory.account_id = $1;");
+      connection.prepare(kGetAsset,
+                         "SELECT \n"
+                         "  * \n"
+                         "FROM \n"
+                         "  asset\n"
+                         "WHERE \n"
+                         "  asset.asset_id = $1;");
+      connection.prepare(kGetAccountAsset,
+                         "SELECT \n"
+                         "  * \n"
+                         "FROM \n"
+                         "  account_has_asset\n"
+                         "WHERE \n"
+                         "  account_has_asset.account_id = $1 AND \n"
+                         "  account_has_asset.asset_id = $2;");
+      // range of primary key index, limit of 0 is no limit
+      connection.prepare(kGetAccountAssets,
+                         "SELECT \n"
+                         "  * \n"
+                         "FROM \n"
+                         "  account_has_asset\n"
+                         "WHERE \n"
+                         "  account_has_asset.account_id = $1 AND \n"
+                         "  account_has_asset.asset_id > $2\n"
+                         "ORDER BY \n"
+                         "  account_has_asset.asset_id\n"
+                         "LIMIT NULLIF($3, 0);");
+      // ranges of secondary indexes, which end with account id
+      connection.prepare(kGetAssetHolders,
+                         "SELECT \n"
+                         "  * \n"
+                         "FROM \n"
+                         "  account_has_asset\n"
+                         "WHERE \n"
+                         "  account_has_asset.asset_id = $1 AND \n"
+                         "  account_has_asset.account_id > $2\n"
+                         "ORDER BY \n"
+                         "  account_has_asset.account_id\n"
+                         "LIMIT NULLIF($3, 0);");
+      connection.prepare(kGetDomainAccounts,
+                         "SELECT \n"
+                         "  * \n"
+                         "FROM \n"
+                         "  account\n"
+                         "WHERE \n"
+                         "  account.domain_id = $1 AND \n"
+                         "  account.account_id > $2\n"
+                         "ORDER BY \n"
+                         "  account.account_id\n"
+                         "LIMIT NULLIF($3, 0);");
+      connection.prepare(kGetAccountsBySignatory,
+                         "SELECT \n"
+                         "  account_has_signatory.account_id\n"
+                         "FROM \n"
+                         "  account_has_signatory\n"
+                         "WHERE \n"
+                         "  account_has_signatory.public_key = $1 AND \n"
+                         "  account_has_signatory.account_id > $2\n"
+                         "ORDER BY \n"
+                         "  account_has_signatory.account_id\n"
+                         "LIMIT NULLIF($3, 0);");
+      connection.prepare(kGetPeers,
+                         "SELECT \n"
+                         "  * \n"
+                         "FROM \n"
+                         "  peer;");
+    }
 
     optional<Account> PostgresWsvQuery::getAccount(const string &account_id) {
       pqxx::result result;
       try {
-        result = transaction_.exec(
-            "SELECT \n"
-            "  *\n"
-            "FROM \n"
-            "  account\n"
-            "WHERE \n"
-            "  account.account_id = " +
-            transaction_.quote(account_id) + ";");
+        result = transaction_.prepared(kGetAccount)(account_id).exec();
       } catch (const std::exception &e) {
         // TODO log
         return nullopt;
@@ -50,43 +160,14 @@ namespace iroha {
       if (result.size() != 1) {
         return nullopt;
       }
-      Account account;
-      auto row = result.at(0);
-      row.at("account_id") >> account.account_id;
-      row.at("domain_id") >> account.domain_name;
-      pqxx::binarystring master_key(row.at("master_key"));
-      std::copy(master_key.begin(), master_key.end(),
-                account.master_key.begin());
-      row.at("quorum") >> account.quorum;
-      //      row.at("status") >> ?
-      //      row.at("transaction_count") >> ?
-      std::string permissions;
-      row.at("permissions") >> permissions;
-      account.permissions.add_signatory = permissions.at(0) - '0';
-      account.permissions.can_transfer = permissions.at(1) - '0';
-      account.permissions.create_accounts = permissions.at(2) - '0';
-      account.permissions.create_assets = permissions.at(3) - '0';
-      account.permissions.create_domains = permissions.at(4) - '0';
-      account.permissions.issue_assets = permissions.at(5) - '0';
-      account.permissions.read_all_accounts = permissions.at(6) - '0';
-      account.permissions.remove_signatory = permissions.at(7) - '0';
-      account.permissions.set_permissions = permissions.at(8) - '0';
-      account.permissions.set_quorum = permissions.at(9) - '0';
-      return account;
+      return accountOf(result.at(0));
     }
 
     nonstd::optional<std::vector<ed25519::pubkey_t>>
     PostgresWsvQuery::getSignatories(const string &account_id) {
       pqxx::result result;
       try {
-        result = transaction_.exec(
-            "SELECT \n"
-            "  account_has_signatory.public_key\n"
-            "FROM \n"
-            "  account_has_signatory\n"
-            "WHERE \n"
-            "  account_has_signatory.account_id = " +
-            transaction_.quote(account_id) + ";");
+        result = transaction_.prepared(kGetSignatories)(account_id).exec();
       } catch (const std::exception &e) {
         // TODO log
         return nullopt;
@@ -104,14 +185,7 @@ namespace iroha {
     optional<Asset> PostgresWsvQuery::getAsset(const string &asset_id) {
       pqxx::result result;
       try {
-        result = transaction_.exec(
-            "SELECT \n"
-            "  * \n"
-            "FROM \n"
-            "  asset\n"
-            "WHERE \n"
-            "  asset.asset_id = " +
-            transaction_.quote(asset_id) + ";");
+        result = transaction_.prepared(kGetAsset)(asset_id).exec();
       } catch (const std::exception &e) {
         // TODO log
         return nullopt;
@@ -134,17 +208,8 @@ namespace iroha {
         const std::string &account_id, const std::string &asset_id) {
       pqxx::result result;
       try {
-        result = transaction_.exec(
-            "SELECT \n"
-            "  * \n"
-            "FROM \n"
-            "  account_has_asset\n"
-            "WHERE \n"
-            "  account_has_asset.account_id = " +
-            transaction_.quote(account_id) +
-            " AND \n"
-            "  account_has_asset.asset_id = " +
-            transaction_.quote(asset_id) + ";");
+        result = transaction_.prepared(kGetAccountAsset)(account_id)(asset_id)
+                     .exec();
       } catch (const std::exception &e) {
         return nullopt;
       }
@@ -160,14 +225,98 @@ namespace iroha {
       return asset;
     }
 
+    optional<std::vector<AccountAsset>> PostgresWsvQuery::getAccountAssets(
+        const std::string &account_id,
+        const std::string &after_asset_id,
+        size_t limit) {
+      pqxx::result result;
+      try {
+        result = transaction_.prepared(kGetAccountAssets)(account_id)(
+                                 after_asset_id)(limit)
+                     .exec();
+      } catch (const std::exception &e) {
+        return nullopt;
+      }
+      std::vector<AccountAsset> assets;
+      for (const auto &row : result) {
+        model::AccountAsset asset;
+        row.at("account_id") >> asset.account_id;
+        row.at("asset_id") >> asset.asset_id;
+        row.at("amount") >> asset.balance;
+        assets.push_back(asset);
+      }
+      return assets;
+    }
+
+    optional<std::vector<AccountAsset>> PostgresWsvQuery::getAssetHolders(
+        const std::string &asset_id,
+        const std::string &after_account_id,
+        size_t limit) {
+      pqxx::result result;
+      try {
+        result = transaction_.prepared(kGetAssetHolders)(asset_id)(
+                                 after_account_id)(limit)
+                     .exec();
+      } catch (const std::exception &e) {
+        return nullopt;
+      }
+      std::vector<AccountAsset> holders;
+      for (const auto &row : result) {
+        model::AccountAsset asset;
+        row.at("account_id") >> asset.account_id;
+        row.at("asset_id") >> asset.asset_id;
+        row.at("amount") >> asset.balance;
+        holders.push_back(asset);
+      }
+      return holders;
+    }
+
+    optional<std::vector<Account>> PostgresWsvQuery::getDomainAccounts(
+        const std::string &domain_id,
+        const std::string &after_account_id,
+        size_t limit) {
+      pqxx::result result;
+      try {
+        result = transaction_.prepared(kGetDomainAccounts)(domain_id)(
+                                 after_account_id)(limit)
+                     .exec();
+      } catch (const std::exception &e) {
+        return nullopt;
+      }
+      std::vector<Account> accounts;
+      for (const auto &row : result) {
+        accounts.push_back(accountOf(row));
+      }
+      return accounts;
+    }
+
+    optional<std::vector<std::string>>
+    PostgresWsvQuery::getAccountsBySignatory(
+        const ed25519::pubkey_t &signatory,
+        const std::string &after_account_id,
+        size_t limit) {
+      pqxx::binarystring public_key(signatory.data(), signatory.size());
+      pqxx::result result;
+      try {
+        result = transaction_.prepared(kGetAccountsBySignatory)(public_key)(
+                                 after_account_id)(limit)
+                     .exec();
+      } catch (const std::exception &e) {
+        return nullopt;
+      }
+      std::vector<std::string> accounts;
+      for (const auto &row : result) {
+        std::string account_id;
+        row.at("account_id") >> account_id;
+        accounts.push_back(account_id);
+      }
+      return accounts;
+    }
+
     nonstd::optional<std::vector<model::Peer>> PostgresWsvQuery::getPeers() {
       pqxx::result result;
       try {
-        result = transaction_.exec(
-            "SELECT \n"
-            "  * \n"
-            "FROM \n"
-            "  peer;");
+        result = transaction_.prepared(kGetPeers).exec();
       } catch (const std::exception &e) {
         return nullopt;
       }
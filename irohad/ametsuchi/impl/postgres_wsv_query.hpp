@@ -34,6 +34,22 @@ namespace iroha {
           const std::string &asset_id) override;
       nonstd::optional<model::AccountAsset> getAccountAsset(
           const std::string &account_id, const std::string &asset_id) override;
+      nonstd::optional<std::vector<model::AccountAsset>> getAccountAssets(
+          const std::string &account_id,
+          const std::string &after_asset_id,
+          size_t limit) override;
+      nonstd::optional<std::vector<model::AccountAsset>> getAssetHolders(
+          const std::string &asset_id,
+          const std::string &after_account_id,
+          size_t limit) override;
+      nonstd::optional<std::vector<model::Account>> getDomainAccounts(
+          const std::string &domain_id,
+          const std::string &after_account_id,
+          size_t limit) override;
+      nonstd::optional<std::vector<std::string>> getAccountsBySignatory(
+          const ed25519::pubkey_t &signatory,
+          const std::string &after_account_id,
+          size_t limit) override;
       nonstd::optional<std::vector<model::Peer>> getPeers() override;
 
      private:
@@ -0,0 +1,124 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_RECORD_CODEC_HPP
+#define IROHA_RECORD_CODEC_HPP
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include "common/types.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Appends fields of a record to its value.
+     * Integers are written in host byte order.
+     */
+    class RecordEncoder {
+     public:
+      RecordEncoder &u64(uint64_t value) {
+        out_.append(reinterpret_cast<const char *>(&value), sizeof(value));
+        return *this;
+      }
+
+      RecordEncoder &str(const std::string &value) {
+        u64(value.size());
+        out_.append(value);
+        return *this;
+      }
+
+      template <size_t size>
+      RecordEncoder &blob(const blob_t<size> &value) {
+        out_.append(value.begin(), value.end());
+        return *this;
+      }
+
+      RecordEncoder &pubkey(const ed25519::pubkey_t &value) {
+        return blob(value);
+      }
+
+      std::string value() const { return out_; }
+
+     private:
+      std::string out_;
+    };
+
+    /**
+     * Reads fields of a record in order they were encoded
+     */
+    class RecordDecoder {
+     public:
+      explicit RecordDecoder(const std::string &in) : in_(in), pos_(0) {}
+
+      uint64_t u64() {
+        uint64_t value = 0;
+        if (take(sizeof(value))) {
+          std::memcpy(&value, in_.data() + pos_ - sizeof(value),
+                      sizeof(value));
+        }
+        return value;
+      }
+
+      std::string str() {
+        auto size = u64();
+        if (not take(size)) {
+          return {};
+        }
+        return in_.substr(pos_ - size, size);
+      }
+
+      template <size_t size>
+      blob_t<size> blob() {
+        blob_t<size> value{};
+        if (take(size)) {
+          std::copy(in_.begin() + pos_ - size, in_.begin() + pos_,
+                    value.begin());
+        }
+        return value;
+      }
+
+      ed25519::pubkey_t pubkey() { return blob<ed25519::pubkey_t::size()>(); }
+
+      /**
+       * @return true if all fields were read
+       */
+      bool ok() const { return pos_ <= in_.size(); }
+
+      /**
+       * @return true if all fields were read and nothing is left
+       */
+      bool finished() const { return pos_ == in_.size(); }
+
+     private:
+      bool take(uint64_t size) {
+        if (pos_ > in_.size() or in_.size() - pos_ < size) {
+          pos_ = in_.size() + 1;
+          return false;
+        }
+        pos_ += size;
+        return true;
+      }
+
+      const std::string &in_;
+      size_t pos_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+#endif  // IROHA_RECORD_CODEC_HPP
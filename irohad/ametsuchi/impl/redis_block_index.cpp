@@ -0,0 +1,217 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/redis_block_index.hpp"
+#include <map>
+
+namespace iroha {
+  namespace ametsuchi {
+
+    namespace {
+      const std::string kBlockPrefix = "block:";
+      const std::string kTxPrefix = "tx:";
+      const std::string kAccountPrefix = "account_tx:";
+      const std::string kAccountAssetPrefix = "account_asset_tx:";
+      const std::string kHeightKey = "last_id";
+      // idle connections kept by the pool
+      const size_t kConnectionPoolSize = 4;
+
+      std::string accountAssetKey(const std::string &account_id,
+                                  const std::string &asset_id) {
+        return kAccountAssetPrefix + account_id + ":" + asset_id;
+      }
+    }  // namespace
+
+    std::unique_ptr<RedisBlockIndex> RedisBlockIndex::create(
+        const std::string &host, std::size_t port) {
+      std::unique_ptr<RedisBlockIndex> index(new RedisBlockIndex(host, port));
+      // fail early instead of on the first commit
+      if (not index->pool_.acquire()) {
+        return nullptr;
+      }
+      return index;
+    }
+
+    RedisBlockIndex::RedisBlockIndex(const std::string &host,
+                                     std::size_t port)
+        : host_(host),
+          port_(port),
+          pool_(kConnectionPoolSize,
+                [this]() -> std::unique_ptr<cpp_redis::redis_client> {
+                  auto client = std::make_unique<cpp_redis::redis_client>();
+                  try {
+                    client->connect(host_, port_);
+                  } catch (const cpp_redis::redis_error &e) {
+                    log_->error("Connection {}:{} with Redis broken: {}",
+                                host_,
+                                port_,
+                                e.what());
+                    return nullptr;
+                  }
+                  return client;
+                },
+                [](cpp_redis::redis_client &client) {
+                  return client.is_connected();
+                }),
+          log_(logger::log("RedisBlockIndex")) {}
+
+    bool RedisBlockIndex::add(const BlockRefs &blocks) {
+      auto client = pool_.acquire();
+      if (not client) {
+        return false;
+      }
+      bool applied = false;
+      try {
+        client->multi();
+        for (const auto &block : blocks) {
+          index(*client, block);
+        }
+        client->exec([&applied](cpp_redis::reply &reply) {
+          applied = reply.is_array();
+        });
+        client->sync_commit();
+      } catch (const cpp_redis::redis_error &e) {
+        log_->error("Cannot write block index: {}", e.what());
+        return false;
+      }
+      return applied;
+    }
+
+    void RedisBlockIndex::index(cpp_redis::redis_client &client,
+                                const model::Block &block) {
+      auto height = std::to_string(block.height);
+      client.set(kBlockPrefix + block.hash.to_hexstring(), height);
+      // transactions of one account are pushed with one command
+      std::map<std::string, std::vector<std::string>> positions;
+      for (size_t i = 0; i < block.transactions.size(); ++i) {
+        const auto &tx = block.transactions[i];
+        auto id = std::to_string(i);
+        client.hmset(kTxPrefix + hash_provider_.get_hash(tx).to_hexstring(),
+                     {{"blockid", height}, {"txid", id}});
+        auto position = height + ":" + id;
+        positions[kAccountPrefix + tx.creator_account_id].push_back(position);
+        for (const auto &account_asset : changedAccountAssets(tx)) {
+          positions[accountAssetKey(account_asset.first,
+                                    account_asset.second)]
+              .push_back(position);
+        }
+      }
+      for (const auto &list : positions) {
+        client.rpush(list.first, list.second);
+      }
+      client.set(kHeightKey, height);
+    }
+
+    nonstd::optional<uint32_t> RedisBlockIndex::height() {
+      auto client = pool_.acquire();
+      if (not client) {
+        return nonstd::nullopt;
+      }
+      nonstd::optional<uint32_t> result;
+      client->get(kHeightKey, [&result](cpp_redis::reply &reply) {
+        if (reply.is_null()) {
+          result = 0;
+        } else if (reply.is_string()) {
+          result = std::stoul(reply.as_string());
+        }
+      });
+      client->sync_commit();
+      return result;
+    }
+
+    nonstd::optional<std::vector<TxPosition>>
+    RedisBlockIndex::accountTransactions(const std::string &account_id) {
+      return positions(kAccountPrefix + account_id);
+    }
+
+    nonstd::optional<std::vector<TxPosition>>
+    RedisBlockIndex::accountAssetTransactions(const std::string &account_id,
+                                              const std::string &asset_id) {
+      return positions(accountAssetKey(account_id, asset_id));
+    }
+
+    nonstd::optional<std::vector<TxPosition>> RedisBlockIndex::positions(
+        const std::string &key) {
+      auto client = pool_.acquire();
+      if (not client) {
+        return nonstd::nullopt;
+      }
+      nonstd::optional<std::vector<TxPosition>> result;
+      client->lrange(key, 0, -1, [&result](cpp_redis::reply &reply) {
+        if (not reply.is_array()) {
+          return;
+        }
+        result = std::vector<TxPosition>();
+        for (const auto &entry : reply.as_array()) {
+          const auto &value = entry.as_string();
+          auto separator = value.find(':');
+          if (separator == std::string::npos) {
+            continue;
+          }
+          TxPosition position;
+          position.height = std::stoul(value.substr(0, separator));
+          position.index = std::stoul(value.substr(separator + 1));
+          result->push_back(position);
+        }
+      });
+      client->sync_commit();
+      return result;
+    }
+
+    nonstd::optional<uint32_t> RedisBlockIndex::blockHeight(
+        const hash256_t &block_hash) {
+      auto client = pool_.acquire();
+      if (not client) {
+        return nonstd::nullopt;
+      }
+      nonstd::optional<uint32_t> result;
+      client->get(kBlockPrefix + block_hash.to_hexstring(),
+                   [&result](cpp_redis::reply &reply) {
+                     if (reply.is_string()) {
+                       result = std::stoul(reply.as_string());
+                     }
+                   });
+      client->sync_commit();
+      return result;
+    }
+
+    nonstd::optional<TxPosition> RedisBlockIndex::transaction(
+        const hash256_t &tx_hash) {
+      auto client = pool_.acquire();
+      if (not client) {
+        return nonstd::nullopt;
+      }
+      nonstd::optional<TxPosition> result;
+      client->hmget(kTxPrefix + tx_hash.to_hexstring(), {"blockid", "txid"},
+                     [&result](cpp_redis::reply &reply) {
+                       if (not reply.is_array() or reply.as_array().size() != 2
+                           or not reply.as_array()[0].is_string()
+                           or not reply.as_array()[1].is_string()) {
+                         return;
+                       }
+                       const auto &fields = reply.as_array();
+                       TxPosition position;
+                       position.height = std::stoul(fields[0].as_string());
+                       position.index = std::stoul(fields[1].as_string());
+                       result = position;
+                     });
+      client->sync_commit();
+      return result;
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
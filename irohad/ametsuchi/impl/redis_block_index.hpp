@@ -0,0 +1,86 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_REDIS_BLOCK_INDEX_HPP
+#define IROHA_REDIS_BLOCK_INDEX_HPP
+
+#include <cpp_redis/redis_client.hpp>
+#include "ametsuchi/impl/block_index.hpp"
+#include "ametsuchi/impl/connection_pool.hpp"
+#include "logger/logger.hpp"
+#include "model/model_hash_provider_impl.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Block index kept in Redis:
+     *  - block:<block hash> - height of the block
+     *  - tx:<tx hash> - hash with blockid and txid of the transaction
+     *  - account_tx:<account id> - list of "height:index" of transactions
+     *    created by the account, in chain order
+     *  - account_asset_tx:<account id>:<asset id> - list of "height:index"
+     *    of transactions changing the account asset, in chain order
+     *  - last_id - height of the last indexed block
+     * Hashes are hex encoded, the layout matches index::Redis.
+     * Blocks of one add are written within one MULTI/EXEC.
+     */
+    class RedisBlockIndex : public BlockIndex {
+     public:
+      /**
+       * Connect to Redis server
+       * @return index or nullptr if server is unavailable
+       */
+      static std::unique_ptr<RedisBlockIndex> create(const std::string &host,
+                                                     std::size_t port);
+
+      bool add(const BlockRefs &blocks) override;
+      nonstd::optional<uint32_t> height() override;
+      nonstd::optional<std::vector<TxPosition>> accountTransactions(
+          const std::string &account_id) override;
+      nonstd::optional<std::vector<TxPosition>> accountAssetTransactions(
+          const std::string &account_id, const std::string &asset_id) override;
+      nonstd::optional<uint32_t> blockHeight(
+          const hash256_t &block_hash) override;
+      nonstd::optional<TxPosition> transaction(
+          const hash256_t &tx_hash) override;
+
+     private:
+      RedisBlockIndex(const std::string &host, std::size_t port);
+
+      /**
+       * Queue index entries of the block on the client
+       */
+      void index(cpp_redis::redis_client &client, const model::Block &block);
+
+      /**
+       * Read list of "height:index" positions
+       */
+      nonstd::optional<std::vector<TxPosition>> positions(
+          const std::string &key);
+
+      const std::string host_;
+      const std::size_t port_;
+      // connections are shared by commit and query threads
+      ConnectionPool<cpp_redis::redis_client> pool_;
+      model::HashProviderImpl hash_provider_;
+      logger::Logger log_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+#endif  // IROHA_REDIS_BLOCK_INDEX_HPP
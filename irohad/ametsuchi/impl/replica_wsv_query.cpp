@@ -0,0 +1,145 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/replica_wsv_query.hpp"
+#include "ametsuchi/impl/postgres_wsv_query.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    ReplicaWsvQuery::ReplicaWsvQuery(const std::string &options,
+                                     std::shared_ptr<WsvQuery> primary,
+                                     std::function<uint32_t()> height,
+                                     uint32_t max_lag)
+        : primary_(std::move(primary)),
+          height_(std::move(height)),
+          max_lag_(max_lag),
+          connection_(options),
+          transaction_(connection_, "ReplicaWsvQuery"),
+          replica_(std::make_unique<PostgresWsvQuery>(transaction_)),
+          replica_height_(0),
+          log_(logger::log("ReplicaWsvQuery")) {}
+
+    bool ReplicaWsvQuery::fresh() {
+      auto height = height_();
+      if (replica_height_ + max_lag_ >= height) {
+        return true;
+      }
+      try {
+        auto result = transaction_.exec("SELECT height FROM ledger_height;");
+        replica_height_ = result.at(0).at(0).as<uint32_t>();
+      } catch (const std::exception &e) {
+        log_->warn("Standby is unavailable: {}", e.what());
+        return false;
+      }
+      if (replica_height_ + max_lag_ < height) {
+        log_->warn("Standby lags at height {} of {}", replica_height_, height);
+        return false;
+      }
+      return true;
+    }
+
+    template <typename Result>
+    Result ReplicaWsvQuery::route(std::function<Result(WsvQuery &)> query) {
+      {
+        std::lock_guard<std::mutex> lock(lock_);
+        if (fresh()) {
+          auto result = query(*replica_);
+          if (result) {
+            return result;
+          }
+          // failed queries are retried on the node database, since missing
+          // rows and broken connection look the same
+        }
+      }
+      return query(*primary_);
+    }
+
+    nonstd::optional<model::Account> ReplicaWsvQuery::getAccount(
+        const std::string &account_id) {
+      return route<nonstd::optional<model::Account>>(
+          [&](WsvQuery &wsv) { return wsv.getAccount(account_id); });
+    }
+
+    nonstd::optional<std::vector<ed25519::pubkey_t>>
+    ReplicaWsvQuery::getSignatories(const std::string &account_id) {
+      return route<nonstd::optional<std::vector<ed25519::pubkey_t>>>(
+          [&](WsvQuery &wsv) { return wsv.getSignatories(account_id); });
+    }
+
+    nonstd::optional<model::Asset> ReplicaWsvQuery::getAsset(
+        const std::string &asset_id) {
+      return route<nonstd::optional<model::Asset>>(
+          [&](WsvQuery &wsv) { return wsv.getAsset(asset_id); });
+    }
+
+    nonstd::optional<model::AccountAsset> ReplicaWsvQuery::getAccountAsset(
+        const std::string &account_id, const std::string &asset_id) {
+      return route<nonstd::optional<model::AccountAsset>>([&](WsvQuery &wsv) {
+        return wsv.getAccountAsset(account_id, asset_id);
+      });
+    }
+
+    nonstd::optional<std::vector<model::AccountAsset>>
+    ReplicaWsvQuery::getAccountAssets(const std::string &account_id,
+                                      const std::string &after_asset_id,
+                                      size_t limit) {
+      return route<nonstd::optional<std::vector<model::AccountAsset>>>(
+          [&](WsvQuery &wsv) {
+            return wsv.getAccountAssets(account_id, after_asset_id, limit);
+          });
+    }
+
+    nonstd::optional<std::vector<model::AccountAsset>>
+    ReplicaWsvQuery::getAssetHolders(const std::string &asset_id,
+                                     const std::string &after_account_id,
+                                     size_t limit) {
+      return route<nonstd::optional<std::vector<model::AccountAsset>>>(
+          [&](WsvQuery &wsv) {
+            return wsv.getAssetHolders(asset_id, after_account_id, limit);
+          });
+    }
+
+    nonstd::optional<std::vector<model::Account>>
+    ReplicaWsvQuery::getDomainAccounts(const std::string &domain_id,
+                                       const std::string &after_account_id,
+                                       size_t limit) {
+      return route<nonstd::optional<std::vector<model::Account>>>(
+          [&](WsvQuery &wsv) {
+            return wsv.getDomainAccounts(domain_id, after_account_id, limit);
+          });
+    }
+
+    nonstd::optional<std::vector<std::string>>
+    ReplicaWsvQuery::getAccountsBySignatory(const ed25519::pubkey_t &signatory,
+                                            const std::string &after_account_id,
+                                            size_t limit) {
+      return route<nonstd::optional<std::vector<std::string>>>(
+          [&](WsvQuery &wsv) {
+            return wsv.getAccountsBySignatory(signatory,
+                                              after_account_id,
+                                              limit);
+          });
+    }
+
+    nonstd::optional<std::vector<model::Peer>> ReplicaWsvQuery::getPeers() {
+      return route<nonstd::optional<std::vector<model::Peer>>>(
+          [](WsvQuery &wsv) { return wsv.getPeers(); });
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,109 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_REPLICA_WSV_QUERY_HPP
+#define IROHA_REPLICA_WSV_QUERY_HPP
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <pqxx/pqxx>
+#include <string>
+#include "ametsuchi/wsv_query.hpp"
+#include "logger/logger.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Queries served by PostgreSQL standby which replicates the node
+     * database. Before a query the height replayed by the standby is
+     * compared with the height committed by the node, and queries fall
+     * back to the node database when the standby lags too far behind or
+     * is unavailable. Height of the standby only grows, so it is read again
+     * only when the last known one is too old.
+     */
+    class ReplicaWsvQuery : public WsvQuery {
+     public:
+      /**
+       * @param options - connection string of the standby
+       * @param primary - query of the node database
+       * @param height - returns height committed by the node
+       * @param max_lag - number of blocks the standby may lag behind
+       */
+      ReplicaWsvQuery(const std::string &options,
+                      std::shared_ptr<WsvQuery> primary,
+                      std::function<uint32_t()> height,
+                      uint32_t max_lag);
+
+      nonstd::optional<model::Account> getAccount(
+          const std::string &account_id) override;
+      nonstd::optional<std::vector<ed25519::pubkey_t>> getSignatories(
+          const std::string &account_id) override;
+      nonstd::optional<model::Asset> getAsset(
+          const std::string &asset_id) override;
+      nonstd::optional<model::AccountAsset> getAccountAsset(
+          const std::string &account_id, const std::string &asset_id) override;
+      nonstd::optional<std::vector<model::AccountAsset>> getAccountAssets(
+          const std::string &account_id,
+          const std::string &after_asset_id,
+          size_t limit) override;
+      nonstd::optional<std::vector<model::AccountAsset>> getAssetHolders(
+          const std::string &asset_id,
+          const std::string &after_account_id,
+          size_t limit) override;
+      nonstd::optional<std::vector<model::Account>> getDomainAccounts(
+          const std::string &domain_id,
+          const std::string &after_account_id,
+          size_t limit) override;
+      nonstd::optional<std::vector<std::string>> getAccountsBySignatory(
+          const ed25519::pubkey_t &signatory,
+          const std::string &after_account_id,
+          size_t limit) override;
+      nonstd::optional<std::vector<model::Peer>> getPeers() override;
+
+     private:
+      /**
+       * Run query on the standby if it is fresh enough, otherwise on the
+       * node database
+       */
+      template <typename Result>
+      Result route(std::function<Result(WsvQuery &)> query);
+
+      /**
+       * @return true if the standby is within allowed lag,
+       * must be called under lock
+       */
+      bool fresh();
+
+      std::shared_ptr<WsvQuery> primary_;
+      std::function<uint32_t()> height_;
+      const uint32_t max_lag_;
+
+      // session of the standby, used by one query at a time
+      pqxx::lazyconnection connection_;
+      pqxx::nontransaction transaction_;
+      std::unique_ptr<WsvQuery> replica_;
+      uint32_t replica_height_;
+      std::mutex lock_;
+
+      logger::Logger log_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+#endif  // IROHA_REPLICA_WSV_QUERY_HPP
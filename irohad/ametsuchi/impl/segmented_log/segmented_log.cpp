@@ -0,0 +1,591 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/segmented_log/segmented_log.hpp"
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include "crypto/crc32c.hpp"
+#include <iterator>
+
+namespace iroha {
+  namespace ametsuchi {
+
+    namespace {
+      const char kSegmentMagic[4] = {'I', 'R', 'S', 'G'};
+      // version 1 records have no checksum
+      const uint32_t kUncheckedVersion = 1;
+      const uint32_t kSegmentVersion = 2;
+      const size_t kSegmentHeaderSize =
+          sizeof(kSegmentMagic) + sizeof(kSegmentVersion);
+
+      /**
+       * Header of record preceding the block
+       */
+      struct RecordHeader {
+        uint32_t size;
+        uint32_t crc;
+      };
+
+      size_t record_header_size(uint32_t version) {
+        return version == kUncheckedVersion ? sizeof(uint32_t)
+                                            : sizeof(RecordHeader);
+      }
+
+      /**
+       * Check record against its index entry and checksum
+       * @param version - version of segment
+       * @param header - record header
+       * @param block - block bytes following the header
+       * @param size - size of block from index entry
+       * @return true if record is intact
+       */
+      bool check_record(uint32_t version,
+                        const uint8_t *header,
+                        const uint8_t *block,
+                        uint32_t size) {
+        RecordHeader record;
+        std::memcpy(&record, header, record_header_size(version));
+        return record.size == size and
+            (version == kUncheckedVersion or
+             iroha::crc32c(block, size) == record.crc);
+      }
+      const size_t kIndexEntrySize = sizeof(uint64_t) + sizeof(uint32_t);
+      // two buffers per record keep one write within IOV_MAX
+      const long kMaxRecordsPerWrite = 512;
+
+      const std::string kDataExtension = ".seg";
+      const std::string kIndexExtension = ".idx";
+
+      std::string segment_name(uint32_t first_id) {
+        std::string name(16, '\0');
+        sprintf(&name[0], "%016u", first_id);
+        return name;
+      }
+
+      int is_index_file(const struct dirent *entry) {
+        auto name = std::string(entry->d_name);
+        return name.size() > kIndexExtension.size() and
+            name.compare(name.size() - kIndexExtension.size(),
+                         kIndexExtension.size(), kIndexExtension) == 0;
+      }
+
+      void sync_directory(const std::string &path) {
+        auto fd = open(path.c_str(), O_RDONLY | O_DIRECTORY);
+        if (fd >= 0) {
+          fsync(fd);
+          close(fd);
+        }
+      }
+
+      off_t file_size(int fd) {
+        struct stat stat_buf;
+        return fstat(fd, &stat_buf) == 0 ? stat_buf.st_size : -1;
+      }
+    }  // namespace
+
+    SegmentedLog::SegmentedLog(const std::string &path,
+                               uint64_t max_segment_size,
+                               DurabilityPolicy durability,
+                               BlockCompression compression)
+        : dump_dir_(path),
+          max_segment_size_(max_segment_size),
+          durability_(durability),
+          compression_(compression),
+          compressor_(std::make_unique<BlockCompressor>(path)),
+          current_id_(0) {
+      log_ = logger::log("SegmentedLog");
+    }
+
+    SegmentedLog::~SegmentedLog() {
+      for (auto &segment : segments_) {
+        close(segment.data_fd);
+        close(segment.index_fd);
+      }
+    }
+
+    std::unique_ptr<SegmentedLog> SegmentedLog::create(
+        const std::string &path, uint64_t max_segment_size,
+        bool verify_blocks,
+        DurabilityPolicy durability,
+        BlockCompression compression) {
+      std::unique_ptr<SegmentedLog> log(
+          new SegmentedLog(path, max_segment_size, durability, compression));
+
+      struct dirent **namelist;
+      auto status = scandir(path.c_str(), &namelist, is_index_file, alphasort);
+      if (status < 0) {
+        log->log_->error("Cannot read directory {}", path);
+        return nullptr;
+      }
+
+      std::vector<uint32_t> first_ids;
+      for (auto i = 0; i < status; ++i) {
+        first_ids.push_back(std::stoul(namelist[i]->d_name));
+        free(namelist[i]);
+      }
+      free(namelist);
+
+      for (auto it = first_ids.begin(); it != first_ids.end(); ++it) {
+        // segments must contain consecutive blocks
+        auto consistent = log->segments_.empty() or
+            log->segments_.back().first_id +
+                    log->segments_.back().entries.size() ==
+                *it;
+        // tail of the last segment may be torn, so it is always checked
+        auto verify = verify_blocks or std::next(it) == first_ids.end();
+        if (not consistent or not log->loadSegment(*it, verify)) {
+          log->log_->warn("Segment {} is inconsistent, dropping the tail",
+                          *it);
+          for (; it != first_ids.end(); ++it) {
+            auto name = path + "/" + segment_name(*it);
+            std::remove((name + kDataExtension).c_str());
+            std::remove((name + kIndexExtension).c_str());
+          }
+          break;
+        }
+      }
+
+      if (not log->segments_.empty()) {
+        const auto &last = log->segments_.back();
+        log->current_id_ = last.first_id + last.entries.size() - 1;
+      }
+      return log;
+    }
+
+    bool SegmentedLog::loadSegment(uint32_t first_id, bool verify_records) {
+      auto name = dump_dir_ + "/" + segment_name(first_id);
+      Segment segment{first_id, 0, -1, -1, 0, {}, nullptr};
+
+      segment.data_fd = open((name + kDataExtension).c_str(), O_RDWR);
+      segment.index_fd = open((name + kIndexExtension).c_str(), O_RDWR);
+      auto fail = [&segment] {
+        if (segment.data_fd >= 0) close(segment.data_fd);
+        if (segment.index_fd >= 0) close(segment.index_fd);
+        return false;
+      };
+      if (segment.data_fd < 0 or segment.index_fd < 0) {
+        return fail();
+      }
+
+      char header[kSegmentHeaderSize];
+      auto data_size = file_size(segment.data_fd);
+      if (data_size < static_cast<off_t>(kSegmentHeaderSize) or
+          pread(segment.data_fd, header, kSegmentHeaderSize, 0) !=
+              static_cast<ssize_t>(kSegmentHeaderSize) or
+          std::memcmp(header, kSegmentMagic, sizeof(kSegmentMagic)) != 0) {
+        return fail();
+      }
+      std::memcpy(&segment.version,
+                  header + sizeof(kSegmentMagic),
+                  sizeof(segment.version));
+      if (segment.version != kUncheckedVersion and
+          segment.version != kSegmentVersion) {
+        return fail();
+      }
+      auto record_header = record_header_size(segment.version);
+
+      auto index_size = file_size(segment.index_fd);
+      if (index_size < 0) {
+        return fail();
+      }
+      std::vector<uint8_t> index(index_size - index_size % kIndexEntrySize);
+      if (pread(segment.index_fd, index.data(), index.size(), 0) !=
+          static_cast<ssize_t>(index.size())) {
+        return fail();
+      }
+
+      // accept only entries which point to completely written records
+      uint64_t expected_offset = kSegmentHeaderSize;
+      for (size_t pos = 0; pos < index.size(); pos += kIndexEntrySize) {
+        IndexEntry entry;
+        std::memcpy(&entry.offset, &index[pos], sizeof(entry.offset));
+        std::memcpy(&entry.size, &index[pos + sizeof(entry.offset)],
+                    sizeof(entry.size));
+        auto end = entry.offset + record_header + entry.size;
+        if (entry.offset != expected_offset or
+            end > static_cast<uint64_t>(data_size)) {
+          break;
+        }
+        if (verify_records) {
+          std::vector<uint8_t> record(record_header + entry.size);
+          if (pread(segment.data_fd, record.data(), record.size(),
+                    entry.offset) != static_cast<ssize_t>(record.size()) or
+              not check_record(segment.version,
+                               record.data(),
+                               record.data() + record_header,
+                               entry.size)) {
+            log_->warn("Record of block {} is damaged",
+                       first_id + segment.entries.size());
+            break;
+          }
+        }
+        segment.entries.push_back(entry);
+        expected_offset = end;
+      }
+      segment.data_size = expected_offset;
+
+      if (ftruncate(segment.index_fd,
+                    segment.entries.size() * kIndexEntrySize) != 0 or
+          ftruncate(segment.data_fd, segment.data_size) != 0) {
+        return fail();
+      }
+
+      segments_.push_back(std::move(segment));
+      return true;
+    }
+
+    bool SegmentedLog::createSegment(uint32_t first_id) {
+      auto name = dump_dir_ + "/" + segment_name(first_id);
+      Segment segment{
+          first_id, kSegmentVersion, -1, -1, kSegmentHeaderSize, {}, nullptr};
+
+      segment.data_fd = open((name + kDataExtension).c_str(),
+                             O_RDWR | O_CREAT | O_TRUNC, 0644);
+      segment.index_fd = open((name + kIndexExtension).c_str(),
+                              O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+      char header[kSegmentHeaderSize];
+      std::memcpy(header, kSegmentMagic, sizeof(kSegmentMagic));
+      std::memcpy(header + sizeof(kSegmentMagic), &kSegmentVersion,
+                  sizeof(kSegmentVersion));
+
+      if (segment.data_fd < 0 or segment.index_fd < 0 or
+          pwrite(segment.data_fd, header, kSegmentHeaderSize, 0) !=
+              static_cast<ssize_t>(kSegmentHeaderSize)) {
+        log_->error("Cannot create segment {}", name);
+        if (segment.data_fd >= 0) close(segment.data_fd);
+        if (segment.index_fd >= 0) close(segment.index_fd);
+        return false;
+      }
+      if (durability_ != DurabilityPolicy::None) {
+        sync_directory(dump_dir_);
+      }
+
+      segments_.push_back(std::move(segment));
+      return true;
+    }
+
+    const SegmentedLog::Segment *SegmentedLog::findSegment(
+        uint32_t id) const {
+      auto it = std::upper_bound(segments_.begin(), segments_.end(), id,
+                                 [](uint32_t id, const Segment &segment) {
+                                   return id < segment.first_id;
+                                 });
+      if (it == segments_.begin()) {
+        return nullptr;
+      }
+      return &*std::prev(it);
+    }
+
+    bool SegmentedLog::add(uint32_t id, const std::vector<uint8_t> &block) {
+      std::unique_lock<std::shared_timed_mutex> write(rw_lock_);
+      return store({BlockRef(id, &block)});
+    }
+
+    bool SegmentedLog::add_batch(const BlockBatch &blocks) {
+      std::vector<BlockRef> refs;
+      refs.reserve(blocks.size());
+      for (const auto &block : blocks) {
+        refs.emplace_back(block.first, &block.second);
+      }
+      std::unique_lock<std::shared_timed_mutex> write(rw_lock_);
+      return store(refs);
+    }
+
+    bool SegmentedLog::store(const std::vector<BlockRef> &blocks) {
+      if (compression_ == BlockCompression::None) {
+        return append(blocks);
+      }
+      // compressed copies are reserved up front, refs point into them
+      std::vector<std::vector<uint8_t>> compressed;
+      compressed.reserve(blocks.size());
+      std::vector<BlockRef> pending;
+      for (const auto &block : blocks) {
+        if (not segments_.empty() and block.first <= current_id_) {
+          continue;
+        }
+        if (compressor_->needsDictionary(block.first)) {
+          if (not append(pending)) {
+            return false;
+          }
+          pending.clear();
+          std::vector<std::vector<uint8_t>> samples;
+          auto first_id = BlockCompressor::segmentStart(block.first);
+          for (auto id = first_id;
+               id < first_id + BlockCompressor::kTrainingBlocks;
+               ++id) {
+            if (auto sample = readBlock(id)) {
+              samples.push_back(std::move(*sample));
+            }
+          }
+          compressor_->train(block.first, samples);
+        }
+        compressed.push_back(
+            compressor_->compress(block.first, *block.second));
+        pending.emplace_back(block.first, &compressed.back());
+      }
+      return append(pending);
+    }
+
+    bool SegmentedLog::append(const std::vector<BlockRef> &blocks) {
+      auto it = blocks.begin();
+      while (it != blocks.end()) {
+        if (not segments_.empty() and it->first <= current_id_) {
+          // Block already exists
+          ++it;
+          continue;
+        }
+        if (not segments_.empty() and it->first != current_id_ + 1) {
+          log_->error(
+              "Block {} does not follow last block {}", it->first, current_id_);
+          return false;
+        }
+
+        // empty segment of previous version is recreated in place
+        if (not segments_.empty() and segments_.back().entries.empty() and
+            segments_.back().version != kSegmentVersion) {
+          close(segments_.back().data_fd);
+          close(segments_.back().index_fd);
+          segments_.pop_back();
+          if (not createSegment(it->first)) {
+            return false;
+          }
+        }
+        // rotate only non-empty segment to get unique segment names,
+        // records are appended only to segments of current version
+        if (segments_.empty() or
+            (not segments_.back().entries.empty() and
+             (segments_.back().data_size >= max_segment_size_ or
+              segments_.back().version != kSegmentVersion))) {
+          if (not createSegment(it->first)) {
+            return false;
+          }
+        }
+
+        // take following blocks while the segment stays under the limit
+        auto size = segments_.back().data_size + sizeof(RecordHeader) +
+            it->second->size();
+        auto end = std::next(it);
+        while (end != blocks.end() and
+               durability_ != DurabilityPolicy::PerBlock and
+               size < max_segment_size_ and end - it < kMaxRecordsPerWrite and
+               end->first == std::prev(end)->first + 1) {
+          size += sizeof(RecordHeader) + end->second->size();
+          ++end;
+        }
+        if (not writeRecords(it, end)) {
+          return false;
+        }
+        it = end;
+      }
+      return true;
+    }
+
+    bool SegmentedLog::writeRecords(
+        std::vector<BlockRef>::const_iterator begin,
+        std::vector<BlockRef>::const_iterator end) {
+      auto &segment = segments_.back();
+      auto first_id = begin->first;
+      auto last_id = std::prev(end)->first;
+
+      std::vector<IndexEntry> entries;
+      std::vector<RecordHeader> headers;
+      auto offset = segment.data_size;
+      for (auto it = begin; it != end; ++it) {
+        const auto &block = *it->second;
+        auto size = static_cast<uint32_t>(block.size());
+        entries.push_back(IndexEntry{offset, size});
+        headers.push_back(
+            RecordHeader{size, iroha::crc32c(block.data(), block.size())});
+        offset += sizeof(RecordHeader) + block.size();
+      }
+      std::vector<struct iovec> records;
+      for (size_t i = 0; i < entries.size(); ++i) {
+        const auto &block = *(begin + i)->second;
+        records.push_back({&headers[i], sizeof(headers[i])});
+        records.push_back({const_cast<uint8_t *>(block.data()), block.size()});
+      }
+      if (pwritev(segment.data_fd, records.data(), records.size(),
+                  segment.data_size) !=
+          static_cast<ssize_t>(offset - segment.data_size)) {
+        log_->error("Cannot write blocks {}-{} to segment {}", first_id,
+                    last_id, segment.first_id);
+        return false;
+      }
+
+      // records become visible after their index entries are written,
+      // so data has to reach the disk first
+      if (durability_ != DurabilityPolicy::None and
+          fdatasync(segment.data_fd) != 0) {
+        log_->error("Cannot flush segment {}", segment.first_id);
+        return false;
+      }
+
+      std::vector<uint8_t> index(entries.size() * kIndexEntrySize);
+      for (size_t i = 0; i < entries.size(); ++i) {
+        auto pos = &index[i * kIndexEntrySize];
+        std::memcpy(pos, &entries[i].offset, sizeof(entries[i].offset));
+        std::memcpy(pos + sizeof(entries[i].offset), &entries[i].size,
+                    sizeof(entries[i].size));
+      }
+      if (pwrite(segment.index_fd, index.data(), index.size(),
+                 segment.entries.size() * kIndexEntrySize) !=
+              static_cast<ssize_t>(index.size()) or
+          (durability_ != DurabilityPolicy::None and
+           fdatasync(segment.index_fd) != 0)) {
+        log_->error("Cannot write index of blocks {}-{}", first_id, last_id);
+        return false;
+      }
+
+      segment.entries.insert(
+          segment.entries.end(), entries.begin(), entries.end());
+      segment.data_size = offset;
+      current_id_ = last_id;
+      return true;
+    }
+
+    nonstd::optional<std::vector<uint8_t>> SegmentedLog::get(
+        uint32_t id) const {
+      std::shared_lock<std::shared_timed_mutex> read(rw_lock_);
+      return readBlock(id);
+    }
+
+    nonstd::optional<std::vector<uint8_t>> SegmentedLog::readBlock(
+        uint32_t id) const {
+      auto segment = findSegment(id);
+      if (segment == nullptr or
+          id - segment->first_id >= segment->entries.size()) {
+        return nonstd::nullopt;
+      }
+      const auto &entry = segment->entries[id - segment->first_id];
+      auto header_size = record_header_size(segment->version);
+      uint8_t header[sizeof(RecordHeader)];
+      std::vector<uint8_t> buf(entry.size);
+      struct iovec record[2];
+      record[0].iov_base = header;
+      record[0].iov_len = header_size;
+      record[1].iov_base = buf.data();
+      record[1].iov_len = buf.size();
+      if (preadv(segment->data_fd, record, 2, entry.offset) !=
+          static_cast<ssize_t>(header_size + entry.size)) {
+        log_->error("Cannot read block {}", id);
+        return nonstd::nullopt;
+      }
+      if (not check_record(segment->version, header, buf.data(), entry.size)) {
+        log_->error("Block {} is damaged", id);
+        return nonstd::nullopt;
+      }
+      if (BlockCompressor::isCompressed(buf.data(), buf.size())) {
+        return compressor_->decompress(id, buf.data(), buf.size());
+      }
+      return buf;
+    }
+
+    nonstd::optional<BlockView> SegmentedLog::view(uint32_t id) const {
+      std::shared_lock<std::shared_timed_mutex> read(rw_lock_);
+      auto segment = findSegment(id);
+      if (segment == nullptr or
+          id - segment->first_id >= segment->entries.size()) {
+        return nonstd::nullopt;
+      }
+      const auto &entry = segment->entries[id - segment->first_id];
+      auto begin = entry.offset + record_header_size(segment->version);
+
+      std::shared_ptr<const MappedRegion> region;
+      {
+        std::lock_guard<std::mutex> lock(map_lock_);
+        if (not segment->mapping or
+            segment->mapping->size() < begin + entry.size) {
+          // previous mapping is kept alive by views referencing it
+          segment->mapping =
+              MappedRegion::map(segment->data_fd, segment->data_size);
+        }
+        region = segment->mapping;
+      }
+      if (not region) {
+        log_->error("Cannot map segment {}", segment->first_id);
+        return nonstd::nullopt;
+      }
+      if (not check_record(segment->version,
+                           region->data() + entry.offset,
+                           region->data() + begin,
+                           entry.size)) {
+        log_->error("Block {} is damaged", id);
+        return nonstd::nullopt;
+      }
+      if (BlockCompressor::isCompressed(region->data() + begin, entry.size)) {
+        // compressed block can not be served from mapping
+        auto block =
+            compressor_->decompress(id, region->data() + begin, entry.size);
+        if (not block) {
+          return nonstd::nullopt;
+        }
+        auto owner = std::make_shared<const std::vector<uint8_t>>(
+            std::move(*block));
+        return BlockView(owner, owner->data(), owner->size());
+      }
+      return BlockView(region, region->data() + begin, entry.size);
+    }
+
+    uint32_t SegmentedLog::last_id() const {
+      std::shared_lock<std::shared_timed_mutex> read(rw_lock_);
+      return current_id_;
+    }
+
+    uint32_t SegmentedLog::first_id() const {
+      std::shared_lock<std::shared_timed_mutex> read(rw_lock_);
+      return current_id_ == 0 ? 0 : segments_.front().first_id;
+    }
+
+    bool SegmentedLog::prune(uint32_t id, const std::string &archive_dir) {
+      std::unique_lock<std::shared_timed_mutex> write(rw_lock_);
+      auto removed = true;
+      // whole segments are removed, the last one is always kept
+      while (segments_.size() > 1 and segments_[1].first_id <= id) {
+        auto &segment = segments_.front();
+        close(segment.data_fd);
+        close(segment.index_fd);
+        auto name = segment_name(segment.first_id);
+        // segment without index is ignored on start, so index goes first
+        for (const auto &extension : {kIndexExtension, kDataExtension}) {
+          auto path = dump_dir_ + "/" + name + extension;
+          auto result = archive_dir.empty()
+              ? std::remove(path.c_str())
+              : std::rename(path.c_str(),
+                            (archive_dir + "/" + name + extension).c_str());
+          if (result != 0) {
+            log_->error("Cannot remove {}", path);
+            removed = false;
+          }
+        }
+        segments_.erase(segments_.begin());
+      }
+      if (durability_ != DurabilityPolicy::None) {
+        sync_directory(dump_dir_);
+      }
+      return removed;
+    }
+
+    std::string SegmentedLog::directory() const { return dump_dir_; }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,173 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_SEGMENTED_LOG_HPP
+#define IROHA_SEGMENTED_LOG_HPP
+
+#include <memory>
+#include <mutex>
+#include <nonstd/optional.hpp>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+#include "ametsuchi/impl/block_storage.hpp"
+#include "ametsuchi/impl/flat_file/block_compressor.hpp"
+#include "ametsuchi/impl/mapped_region.hpp"
+#include "logger/logger.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Block storage which keeps many blocks in one segment file.
+     * Each segment consists of two files named after id of its first block:
+     *  - <id>.seg - header followed by records
+     *    [uint32 size][uint32 crc32c][block bytes]
+     *  - <id>.idx - array of fixed-size entries [uint64 offset][uint32 size]
+     * Segment is rotated when its data file exceeds the size limit.
+     * Checksums of the last segment are verified on start, so records torn
+     * by a crash are truncated before they are read.
+     * Pruning removes whole segments, starting from the oldest one.
+     * Reading of a block costs one pread call on an already opened file,
+     * views are served from memory mapping of the segment.
+     * Blocks may be compressed as in FlatFile, record then holds the
+     * compressed frame, and views of such blocks are decompressed copies.
+     */
+    class SegmentedLog : public BlockStorage {
+     public:
+      /**
+       * Default upper bound of segment data file size, 64 MiB
+       */
+      static constexpr uint64_t kDefaultSegmentSize = 64ull * 1024 * 1024;
+
+      /**
+       * Open or create segmented log in given directory.
+       * Records not covered by index are dropped as incomplete.
+       * @param path - directory of the log
+       * @param max_segment_size - segment rotation threshold in bytes
+       * @param verify_blocks - check every record against the index
+       * @param durability - flushing of written blocks
+       * @param compression - compression of new blocks
+       * @return log if directory is consistent, nullptr otherwise
+       */
+      static std::unique_ptr<SegmentedLog> create(
+          const std::string &path,
+          uint64_t max_segment_size = kDefaultSegmentSize,
+          bool verify_blocks = false,
+          DurabilityPolicy durability = DurabilityPolicy::PerCommit,
+          BlockCompression compression = BlockCompression::None);
+
+      ~SegmentedLog() override;
+      bool add(uint32_t id, const std::vector<uint8_t> &block) override;
+      bool add_batch(const BlockBatch &blocks) override;
+      nonstd::optional<std::vector<uint8_t>> get(uint32_t id) const override;
+      nonstd::optional<BlockView> view(uint32_t id) const override;
+      uint32_t last_id() const override;
+      uint32_t first_id() const override;
+      bool prune(uint32_t id, const std::string &archive_dir) override;
+      std::string directory() const override;
+
+     private:
+      struct IndexEntry {
+        uint64_t offset;
+        uint32_t size;
+      };
+
+      struct Segment {
+        uint32_t first_id;
+        uint32_t version;
+        int data_fd;
+        int index_fd;
+        uint64_t data_size;
+        std::vector<IndexEntry> entries;
+        // mapping of written part of data file, created on first view
+        mutable std::shared_ptr<const MappedRegion> mapping;
+      };
+
+      using BlockRef = std::pair<uint32_t, const std::vector<uint8_t> *>;
+
+      SegmentedLog(const std::string &path,
+                   uint64_t max_segment_size,
+                   DurabilityPolicy durability,
+                   BlockCompression compression);
+
+      /**
+       * Compress blocks if compression is enabled and append them.
+       * Dictionary is trained on stored blocks, so blocks preceding it are
+       * appended first. Must be called under write lock.
+       * @return true if all new blocks are written
+       */
+      bool store(const std::vector<BlockRef> &blocks);
+
+      /**
+       * Append blocks, rotating segments when needed. Consecutive blocks of
+       * one segment are written with single vectored write.
+       * Must be called under write lock.
+       * @return true if all new blocks are written
+       */
+      bool append(const std::vector<BlockRef> &blocks);
+
+      /**
+       * Read block without locking, decompressing it if needed
+       */
+      nonstd::optional<std::vector<uint8_t>> readBlock(uint32_t id) const;
+
+      /**
+       * Write records with their index entries to the last segment
+       * @param begin, end - range of blocks which fit into the segment
+       * @return true on success
+       */
+      bool writeRecords(std::vector<BlockRef>::const_iterator begin,
+                        std::vector<BlockRef>::const_iterator end);
+
+      /**
+       * Load segment with given first id from disk and repair its tail
+       * @param verify_records - read header of every record, otherwise only
+       * index is checked
+       * @return true if segment is usable
+       */
+      bool loadSegment(uint32_t first_id, bool verify_records);
+
+      /**
+       * Create empty segment starting from given id
+       * @return true on success
+       */
+      bool createSegment(uint32_t first_id);
+
+      /**
+       * Find segment which contains block with given id
+       */
+      const Segment *findSegment(uint32_t id) const;
+
+      const std::string dump_dir_;
+      const uint64_t max_segment_size_;
+      const DurabilityPolicy durability_;
+      const BlockCompression compression_;
+      std::unique_ptr<BlockCompressor> compressor_;
+      std::vector<Segment> segments_;
+      uint32_t current_id_;
+
+      // Allows concurrent reads during segment rotation
+      mutable std::shared_timed_mutex rw_lock_;
+      // Guards segment mappings, which are updated by readers
+      mutable std::mutex map_lock_;
+
+      logger::Logger log_;
+    };
+  }  // namespace ametsuchi
+}  // namespace iroha
+#endif  // IROHA_SEGMENTED_LOG_HPP
@@ -0,0 +1,277 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/state_root.hpp"
+#include <algorithm>
+#include "crypto/hash.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    namespace {
+      // fields are terminated, so rows of different fields never collide
+      void append(std::string &row, const std::string &field) {
+        row.append(field);
+        row.push_back('\0');
+      }
+
+      void append(std::string &row, uint64_t field) {
+        append(row, std::to_string(field));
+      }
+
+      template <size_t N>
+      void append(std::string &row, const blob_t<N> &field) {
+        row.append(reinterpret_cast<const char *>(field.data()), N);
+      }
+
+      std::array<uint64_t, 4> limbs(const std::string &row) {
+        auto hash = sha3_256(reinterpret_cast<const uint8_t *>(row.data()),
+                             row.size());
+        std::array<uint64_t, 4> result{};
+        for (size_t i = 0; i < hash.size(); ++i) {
+          result[i / 8] |= static_cast<uint64_t>(hash[i]) << (8 * (i % 8));
+        }
+        return result;
+      }
+    }  // namespace
+
+    StateRoot::StateRoot() : sum_{} {}
+
+    StateRoot StateRoot::of(const BulkTables &tables) {
+      StateRoot root;
+      for (const auto &domain : tables.domains) {
+        root.add(row(domain.second));
+      }
+      for (const auto &account : tables.accounts) {
+        root.add(row(account.second));
+      }
+      for (const auto &signatories : tables.account_signatories) {
+        for (const auto &signatory : signatories.second) {
+          root.add(row(signatories.first, signatory));
+        }
+      }
+      for (const auto &asset : tables.assets) {
+        root.add(row(asset.second));
+      }
+      for (const auto &asset : tables.account_assets) {
+        root.add(row(asset.second));
+      }
+      for (const auto &peer : tables.peers) {
+        root.add(row(peer));
+      }
+      return root;
+    }
+
+    void StateRoot::add(const std::string &row) {
+      auto term = limbs(row);
+      uint64_t carry = 0;
+      for (size_t i = 0; i < sum_.size(); ++i) {
+        auto sum = sum_[i] + term[i];
+        auto next = sum < term[i] ? 1 : 0;
+        sum_[i] = sum + carry;
+        carry = next + (sum_[i] < carry ? 1 : 0);
+      }
+    }
+
+    void StateRoot::remove(const std::string &row) {
+      auto term = limbs(row);
+      uint64_t borrow = 0;
+      for (size_t i = 0; i < sum_.size(); ++i) {
+        auto difference = sum_[i] - term[i];
+        auto next = sum_[i] < term[i] ? 1 : 0;
+        sum_[i] = difference - borrow;
+        borrow = next + (difference < borrow ? 1 : 0);
+      }
+    }
+
+    hash256_t StateRoot::value() const {
+      hash256_t result;
+      for (size_t i = 0; i < result.size(); ++i) {
+        result[i] = static_cast<uint8_t>(sum_[i / 8] >> (8 * (i % 8)));
+      }
+      return result;
+    }
+
+    bool StateRoot::operator==(const StateRoot &rhs) const {
+      return sum_ == rhs.sum_;
+    }
+
+    std::string StateRoot::row(const model::Domain &domain) {
+      std::string row;
+      append(row, "domain");
+      append(row, domain.domain_id);
+      return row;
+    }
+
+    std::string StateRoot::row(const model::Account &account) {
+      std::string row;
+      append(row, "account");
+      append(row, account.account_id);
+      append(row, account.domain_name);
+      append(row, account.master_key);
+      append(row, account.quorum);
+      append(row, account.permissions.toBitmask());
+      append(row, account.tx_counter);
+      return row;
+    }
+
+    std::string StateRoot::row(const std::string &account_id,
+                               const ed25519::pubkey_t &signatory) {
+      std::string row;
+      append(row, "account_signatory");
+      append(row, account_id);
+      append(row, signatory);
+      return row;
+    }
+
+    std::string StateRoot::row(const model::Asset &asset) {
+      std::string row;
+      append(row, "asset");
+      append(row, asset.asset_id);
+      append(row, asset.domain_id);
+      append(row, asset.precision);
+      return row;
+    }
+
+    std::string StateRoot::row(const model::AccountAsset &asset) {
+      std::string row;
+      append(row, "account_asset");
+      append(row, asset.account_id);
+      append(row, asset.asset_id);
+      append(row, asset.balance);
+      return row;
+    }
+
+    std::string StateRoot::row(const model::Peer &peer) {
+      std::string row;
+      append(row, "peer");
+      append(row, peer.address);
+      append(row, peer.pubkey);
+      return row;
+    }
+
+    // StateRootCommand
+
+    StateRootCommand::StateRootCommand(WsvCommand &command,
+                                       WsvQuery &query,
+                                       StateRoot &root)
+        : command_(command), query_(query), root_(root) {}
+
+    bool StateRootCommand::insertAccount(const model::Account &account) {
+      if (not command_.insertAccount(account)) {
+        return false;
+      }
+      root_.add(StateRoot::row(account));
+      return true;
+    }
+
+    bool StateRootCommand::updateAccount(const model::Account &account) {
+      auto previous = query_.getAccount(account.account_id);
+      if (not command_.updateAccount(account)) {
+        return false;
+      }
+      // update of missing account changes nothing, domain is not updated
+      if (previous) {
+        root_.remove(StateRoot::row(*previous));
+        auto updated = account;
+        updated.domain_name = previous->domain_name;
+        root_.add(StateRoot::row(updated));
+      }
+      return true;
+    }
+
+    bool StateRootCommand::insertAsset(const model::Asset &asset) {
+      if (not command_.insertAsset(asset)) {
+        return false;
+      }
+      root_.add(StateRoot::row(asset));
+      return true;
+    }
+
+    bool StateRootCommand::upsertAccountAsset(
+        const model::AccountAsset &asset) {
+      auto previous = query_.getAccountAsset(asset.account_id, asset.asset_id);
+      if (not command_.upsertAccountAsset(asset)) {
+        return false;
+      }
+      if (previous) {
+        root_.remove(StateRoot::row(*previous));
+      }
+      root_.add(StateRoot::row(asset));
+      return true;
+    }
+
+    bool StateRootCommand::insertSignatory(
+        const ed25519::pubkey_t &signatory) {
+      return command_.insertSignatory(signatory);
+    }
+
+    bool StateRootCommand::insertAccountSignatory(
+        const std::string &account_id, const ed25519::pubkey_t &signatory) {
+      if (not command_.insertAccountSignatory(account_id, signatory)) {
+        return false;
+      }
+      root_.add(StateRoot::row(account_id, signatory));
+      return true;
+    }
+
+    bool StateRootCommand::deleteAccountSignatory(
+        const std::string &account_id, const ed25519::pubkey_t &signatory) {
+      auto signatories = query_.getSignatories(account_id);
+      auto existed = signatories
+          and std::find(signatories->begin(), signatories->end(), signatory)
+              != signatories->end();
+      if (not command_.deleteAccountSignatory(account_id, signatory)) {
+        return false;
+      }
+      if (existed) {
+        root_.remove(StateRoot::row(account_id, signatory));
+      }
+      return true;
+    }
+
+    bool StateRootCommand::insertPeer(const model::Peer &peer) {
+      if (not command_.insertPeer(peer)) {
+        return false;
+      }
+      root_.add(StateRoot::row(peer));
+      return true;
+    }
+
+    bool StateRootCommand::deletePeer(const model::Peer &peer) {
+      auto peers = query_.getPeers();
+      auto existed = peers
+          and std::find(peers->begin(), peers->end(), peer) != peers->end();
+      if (not command_.deletePeer(peer)) {
+        return false;
+      }
+      if (existed) {
+        root_.remove(StateRoot::row(peer));
+      }
+      return true;
+    }
+
+    bool StateRootCommand::insertDomain(const model::Domain &domain) {
+      if (not command_.insertDomain(domain)) {
+        return false;
+      }
+      root_.add(StateRoot::row(domain));
+      return true;
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,110 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_STATE_ROOT_HPP
+#define IROHA_STATE_ROOT_HPP
+
+#include <array>
+#include <string>
+#include "ametsuchi/impl/bulk_wsv.hpp"
+#include "ametsuchi/wsv_command.hpp"
+#include "ametsuchi/wsv_query.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Commitment to world state view: sum modulo 2^256 of sha3-256 of its
+     * rows. Sum does not depend on order of rows, so root is updated with
+     * changed rows only, and peers with equal state have equal roots.
+     * Global signatory table is derived from account signatories and is
+     * not included.
+     * Sum of hashes is not collision resistant: rows whose hashes add up
+     * to a given root are found by generalized birthday attack (Wagner's
+     * k-sum), so root only detects state which has diverged by accident.
+     * It is no proof of the state and must not be verified by light
+     * clients.
+     */
+    class StateRoot {
+     public:
+      /**
+       * Root of empty state
+       */
+      StateRoot();
+
+      /**
+       * Root of all rows of tables
+       */
+      static StateRoot of(const BulkTables &tables);
+
+      void add(const std::string &row);
+      void remove(const std::string &row);
+
+      /**
+       * @return sum as 32 little-endian bytes
+       */
+      hash256_t value() const;
+
+      bool operator==(const StateRoot &rhs) const;
+
+      static std::string row(const model::Domain &domain);
+      static std::string row(const model::Account &account);
+      static std::string row(const std::string &account_id,
+                             const ed25519::pubkey_t &signatory);
+      static std::string row(const model::Asset &asset);
+      static std::string row(const model::AccountAsset &asset);
+      static std::string row(const model::Peer &peer);
+
+     private:
+      std::array<uint64_t, 4> sum_;
+    };
+
+    /**
+     * Command which updates state root with rows written through it.
+     * Previous values of updated and deleted rows are read from query
+     */
+    class StateRootCommand : public WsvCommand {
+     public:
+      /**
+       * @param command - wrapped command
+       * @param query - state before each write
+       * @param root - updated after each successful write
+       */
+      StateRootCommand(WsvCommand &command, WsvQuery &query, StateRoot &root);
+
+      bool insertAccount(const model::Account &account) override;
+      bool updateAccount(const model::Account &account) override;
+      bool insertAsset(const model::Asset &asset) override;
+      bool upsertAccountAsset(const model::AccountAsset &asset) override;
+      bool insertSignatory(const ed25519::pubkey_t &signatory) override;
+      bool insertAccountSignatory(const std::string &account_id,
+                                  const ed25519::pubkey_t &signatory) override;
+      bool deleteAccountSignatory(const std::string &account_id,
+                                  const ed25519::pubkey_t &signatory) override;
+      bool insertPeer(const model::Peer &peer) override;
+      bool deletePeer(const model::Peer &peer) override;
+      bool insertDomain(const model::Domain &domain) override;
+
+     private:
+      WsvCommand &command_;
+      WsvQuery &query_;
+      StateRoot &root_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+#endif  // IROHA_STATE_ROOT_HPP
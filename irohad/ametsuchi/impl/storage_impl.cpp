@@ -16,249 +16,1385 @@
  */
 
 #include "ametsuchi/impl/storage_impl.hpp"
+#include <algorithm>
+#include <future>
+#include <limits>
+#include <thread>
+#include "ametsuchi/impl/flat_file/flat_file.hpp"
+#include "ametsuchi/impl/kv/key_value_block_index.hpp"
+#include "ametsuchi/impl/kv/key_value_wsv_backend.hpp"
+#include "ametsuchi/impl/kv/lmdb_store.hpp"
 #include "ametsuchi/impl/mutable_storage_impl.hpp"
-#include "ametsuchi/impl/postgres_wsv_command.hpp"
-#include "ametsuchi/impl/postgres_wsv_query.hpp"
+#include "ametsuchi/impl/postgres_wsv_backend.hpp"
+#include "ametsuchi/impl/redis_block_index.hpp"
+#include "ametsuchi/impl/segmented_log/segmented_log.hpp"
 #include "ametsuchi/impl/temporary_wsv_impl.hpp"
-#include "model/converters/json_common.hpp"
+#include "metrics/metrics.hpp"
 
 namespace iroha {
   namespace ametsuchi {
 
+    namespace {
+      // range reads share all cores, but at least two workers
+      const size_t kReadWorkers =
+          std::max(2u, std::thread::hardware_concurrency());
+      // blocks decoded ahead of the subscriber
+      const size_t kReadAhead = 64;
+      // ranges shorter than this are read in subscriber thread
+      const uint32_t kParallelReadThreshold = 8;
+
+      /**
+       * Time of commit spent in one store: block_store, wsv (Postgres or
+       * key-value) and index (Redis or key-value)
+       */
+      metrics::Histogram &commitTime(const std::string &store) {
+        return metrics::registry().histogram(
+            "iroha_storage_commit_seconds",
+            "Time of commit spent writing to each store",
+            metrics::latencyBounds(),
+            {{"store", store}});
+      }
+
+      /**
+       * @return true if transaction at height and index follows the cursor
+       */
+      bool isAfter(uint32_t height,
+                   uint32_t index,
+                   const nonstd::optional<model::TxCursor> &cursor) {
+        return not cursor or height > cursor->height
+            or (height == cursor->height and index > cursor->index);
+      }
+
+      /**
+       * Select requested page from positions in chain order
+       */
+      std::vector<TxPosition> page(const std::vector<TxPosition> &positions,
+                                   const model::TxPagination &pagination) {
+        auto begin = std::find_if(
+            positions.begin(), positions.end(), [&](const auto &position) {
+              return isAfter(position.height, position.index, pagination.after);
+            });
+        auto end = positions.end();
+        if (pagination.page_size != 0
+            and static_cast<size_t>(end - begin) > pagination.page_size) {
+          end = begin + pagination.page_size;
+        }
+        return std::vector<TxPosition>(begin, end);
+      }
+
+      /**
+       * Insert rows of snapshot in order of references between tables
+       * @return true if all rows are inserted
+       */
+      bool loadTables(const BulkTables &tables, WsvCommand &command) {
+        for (const auto &domain : tables.domains) {
+          if (not command.insertDomain(domain.second)) {
+            return false;
+          }
+        }
+        for (const auto &signatory : tables.signatories) {
+          if (not command.insertSignatory(signatory)) {
+            return false;
+          }
+        }
+        for (const auto &account : tables.accounts) {
+          if (not command.insertAccount(account.second)) {
+            return false;
+          }
+        }
+        for (const auto &pair : tables.account_signatories) {
+          for (const auto &signatory : pair.second) {
+            if (not command.insertAccountSignatory(pair.first, signatory)) {
+              return false;
+            }
+          }
+        }
+        for (const auto &asset : tables.assets) {
+          if (not command.insertAsset(asset.second)) {
+            return false;
+          }
+        }
+        for (const auto &asset : tables.account_assets) {
+          if (not command.upsertAccountAsset(asset.second)) {
+            return false;
+          }
+        }
+        for (const auto &peer : tables.peers) {
+          if (not command.insertPeer(peer)) {
+            return false;
+          }
+        }
+        return true;
+      }
+    }  // namespace
+
     StorageImpl::StorageImpl(
         std::string block_store_dir, std::string redis_host,
         std::size_t redis_port, std::string postgres_options,
-        std::unique_ptr<FlatFile> block_store,
-        std::unique_ptr<cpp_redis::redis_client> index,
-        std::unique_ptr<pqxx::lazyconnection> wsv_connection,
-        std::unique_ptr<pqxx::nontransaction> wsv_transaction,
-        std::unique_ptr<WsvQuery> wsv)
+        std::unique_ptr<BlockStorage> block_store,
+        const BlockStorageOptions &block_storage_options,
+        std::unique_ptr<BlockIndex> block_index,
+        std::unique_ptr<TxHashFilter> tx_filter,
+        std::unique_ptr<TxColumns> tx_columns,
+        std::unique_ptr<BlockStorage> wsv_changes,
+        std::unique_ptr<WsvBackend> wsv)
         : block_store_dir_(block_store_dir),
           redis_host_(redis_host),
           redis_port_(redis_port),
           postgres_options_(postgres_options),
           block_store_(std::move(block_store)),
-          index_(std::move(index)),
-          wsv_connection_(std::move(wsv_connection)),
-          wsv_transaction_(std::move(wsv_transaction)),
-          wsv_(std::move(wsv)) {
+          block_index_(std::move(block_index)),
+          tx_filter_(std::move(tx_filter)),
+          tx_columns_(std::move(tx_columns)),
+          wsv_changes_(std::move(wsv_changes)),
+          wsv_(std::move(wsv)),
+          serializer_(block_storage_options.format),
+          block_cache_(block_storage_options.cache_blocks,
+                       block_storage_options.cache_bytes),
+          defer_wsv_writes_(block_storage_options.defer_wsv_writes),
+          wsv_snapshots_(block_store_dir),
+          wsv_snapshot_interval_(block_storage_options.wsv_snapshot_interval),
+          wsv_snapshot_keypair_(block_storage_options.wsv_snapshot_keypair),
+          block_retention_(block_storage_options.block_retention),
+          block_archive_path_(block_storage_options.block_archive_path),
+          read_pool_(kReadWorkers) {
       log_ = logger::log("StorageImpl");
+    }
 
-      wsv_transaction_->exec(init_);
-      wsv_transaction_->exec(
-          "SET SESSION CHARACTERISTICS AS TRANSACTION READ ONLY;");
+    StorageImpl::~StorageImpl() {
+      waitWarmUp();
+      if (index_thread_.joinable()) {
+        index_mediator_->stop();
+        index_thread_.join();
+      }
+      if (snapshot_thread_.joinable()) {
+        snapshot_thread_.join();
+      }
     }
 
-    std::unique_ptr<TemporaryWsv> StorageImpl::createTemporaryWsv() {
-      // TODO lock
+    void StorageImpl::startIndexing(uint32_t max_rate) {
+      index_mediator_ =
+          std::make_unique<IndexMediator>(*this, *block_index_, max_rate);
+      index_thread_ = std::thread([this] {
+        // blocks committed meanwhile are picked up by the next pass
+        while (index_mediator_->synchronize(snapshot()->height)) {
+          std::lock_guard<std::mutex> lock(commit_lock_);
+          auto indexed = block_index_->height();
+          if (indexed and *indexed >= snapshot()->height) {
+            index_live_ = true;
+            log_->info("Block index is up to date");
+            return;
+          }
+        }
+        log_->warn("Block index is incomplete, queries will scan blocks");
+      });
+    }
 
-      auto postgres_connection =
-          std::make_unique<pqxx::lazyconnection>(postgres_options_);
-      try {
-        postgres_connection->activate();
-      } catch (const pqxx::broken_connection &e) {
-        log_->error("Connection to PostgreSQL broken: {}", e.what());
-        return nullptr;
+    void StorageImpl::startWarmUp(uint32_t blocks) {
+      warm_up_thread_ = std::thread([this, blocks] {
+        auto start = std::chrono::steady_clock::now();
+        auto top = snapshot()->height;
+        auto from = top > blocks ? top - blocks + 1 : 1;
+        std::set<std::string> accounts;
+        std::set<std::pair<std::string, std::string>> account_assets;
+        for (auto height = from; height <= top; ++height) {
+          auto block = readBlock(height);
+          if (not block) {
+            continue;
+          }
+          for (const auto &tx : block->transactions) {
+            accounts.insert(tx.creator_account_id);
+            for (const auto &asset : changedAccountAssets(tx)) {
+              accounts.insert(asset.first);
+              account_assets.insert(asset);
+            }
+          }
+        }
+        // reads are cached by temporary wsv, which returns to the idle
+        // slot when it is destroyed, so the first proposal finds them
+        if (auto wsv = createTemporaryWsv()) {
+          for (const auto &account_id : accounts) {
+            wsv->getAccount(account_id);
+            wsv->getSignatories(account_id);
+          }
+          for (const auto &asset : account_assets) {
+            wsv->getAccountAsset(asset.first, asset.second);
+          }
+        }
+        log_->info("Warmed up {} blocks, {} accounts, {} account assets",
+                   top >= from ? top - from + 1 : 0,
+                   accounts.size(),
+                   account_assets.size());
+        metrics::startupPhase("warm_up",
+                              std::chrono::steady_clock::now() - start);
+      });
+    }
+
+    void StorageImpl::waitWarmUp() {
+      if (warm_up_thread_.joinable()) {
+        warm_up_thread_.join();
       }
-      auto wsv_transaction = std::make_unique<pqxx::nontransaction>(
-          *postgres_connection, "TemporaryWsv");
-      std::unique_ptr<WsvQuery> wsv =
-          std::make_unique<PostgresWsvQuery>(*wsv_transaction);
-      std::unique_ptr<WsvCommand> executor =
-          std::make_unique<PostgresWsvCommand>(*wsv_transaction);
+    }
 
-      return std::make_unique<TemporaryWsvImpl>(
-          std::move(postgres_connection), std::move(wsv_transaction),
-          std::move(wsv), std::move(executor));
+    std::unique_ptr<TemporaryWsv> StorageImpl::createTemporaryWsv() {
+      auto top_hash = snapshot()->top_hash;
+      std::unique_ptr<TemporaryWsvImpl> wsv;
+      {
+        std::lock_guard<std::mutex> lock(idle_temporary_wsv_->lock);
+        wsv = std::move(idle_temporary_wsv_->wsv);
+        if (wsv and idle_temporary_wsv_->top_hash != top_hash) {
+          // blocks were committed since its reads were cached
+          wsv->refresh();
+        }
+      }
+      if (not wsv) {
+        auto wsv_transaction = wsv_->begin();
+        if (not wsv_transaction) {
+          return nullptr;
+        }
+        wsv = std::make_unique<TemporaryWsvImpl>(std::move(wsv_transaction),
+                                                 defer_wsv_writes_);
+      }
+      std::weak_ptr<IdleTemporaryWsv> idle = idle_temporary_wsv_;
+      return std::make_unique<PooledTemporaryWsv>(
+          std::move(wsv),
+          [idle, top_hash](std::unique_ptr<TemporaryWsvImpl> wsv) {
+            auto slot = idle.lock();
+            // changes are discarded right away, so their row locks do not
+            // block commits while the wsv is idle
+            if (not slot or not wsv->reset()) {
+              return;
+            }
+            std::lock_guard<std::mutex> lock(slot->lock);
+            if (not slot->wsv) {
+              slot->wsv = std::move(wsv);
+              slot->top_hash = top_hash;
+            }
+          });
     }
 
     std::unique_ptr<MutableStorage> StorageImpl::createMutableStorage() {
       // TODO lock
 
-      auto postgres_connection =
-          std::make_unique<pqxx::lazyconnection>(postgres_options_);
-      try {
-        postgres_connection->activate();
-      } catch (const pqxx::broken_connection &e) {
-        log_->error("Connection to PostgreSQL broken: {}", e.what());
+      return createMutableStorage(wsv_->begin());
+    }
+
+    std::unique_ptr<MutableStorage> StorageImpl::createBulkStorage() {
+      return createMutableStorage(wsv_->beginBulk());
+    }
+
+    std::unique_ptr<MutableStorage> StorageImpl::createMutableStorage(
+        std::unique_ptr<WsvTransaction> wsv_transaction) {
+      if (not wsv_transaction) {
         return nullptr;
       }
-      auto wsv_transaction = std::make_unique<pqxx::nontransaction>(
-          *postgres_connection, "TemporaryWsv");
-      std::unique_ptr<WsvQuery> wsv =
-          std::make_unique<PostgresWsvQuery>(*wsv_transaction);
-      std::unique_ptr<WsvCommand> executor =
-          std::make_unique<PostgresWsvCommand>(*wsv_transaction);
-
-      auto index = std::make_unique<cpp_redis::redis_client>();
-      try {
-        index->connect(redis_host_, redis_port_);
-      } catch (const cpp_redis::redis_error &e) {
-        log_->error("Connection to Redis broken: {}", e.what());
-        return nullptr;
+      auto state = snapshot();
+      return std::make_unique<MutableStorageImpl>(state->top_hash,
+                                                  std::move(wsv_transaction),
+                                                  defer_wsv_writes_,
+                                                  state->state_root,
+                                                  wsv_changes_ != nullptr);
+    }
+
+    nonstd::optional<hash256_t> StorageImpl::loadTopHash() {
+      if (block_store_->last_id() == 0) {
+        hash256_t top_hash;
+        top_hash.fill(0);
+        return top_hash;
+      }
+      auto blob = block_store_->view(block_store_->last_id());
+      if (not blob.has_value()) {
+        log_->error("Fetching of blob failed");
+        return nonstd::nullopt;
       }
 
-      hash256_t top_hash;
+      // only hashes of transactions are needed, commands are not decoded
+      auto block = serializer_.deserializeLazy(std::move(*blob));
+      if (not block) {
+        log_->error("Deserialization of block failed");
+        return nonstd::nullopt;
+      }
+      return block->hash();
+    }
 
-      if (block_store_->last_id()) {
-        auto blob = block_store_->get(block_store_->last_id());
-        if (not blob.has_value()) {
-          log_->error("Fetching of blob failed");
-          return nullptr;
-        }
+    std::shared_ptr<StorageImpl::Snapshot> StorageImpl::snapshot() const {
+      return std::atomic_load(&snapshot_);
+    }
 
-        auto document = model::converters::vectorToJson(blob.value());
-        if (not document.has_value()) {
-          log_->error("Blob parsing failed");
-          return nullptr;
-        }
+    thread_local StorageImpl::Pin *StorageImpl::Pin::top = nullptr;
 
-        auto block = serializer_.deserialize(document.value());
-        if (not block.has_value()) {
-          log_->error("Deserialization of block failed");
-          return nullptr;
+    StorageImpl::Pin::Pin(const StorageImpl &storage,
+                          std::shared_ptr<Snapshot> snapshot)
+        : storage(storage), snapshot(std::move(snapshot)), previous(top) {
+      top = this;
+    }
+
+    StorageImpl::Pin::~Pin() {
+      top = previous;
+    }
+
+    std::shared_ptr<StorageImpl::Snapshot> StorageImpl::readSnapshot() const {
+      for (auto pin = Pin::top; pin; pin = pin->previous) {
+        if (&pin->storage == this) {
+          return pin->snapshot;
         }
-        top_hash = block->hash;
-      } else {
-        top_hash.fill(0);
       }
+      return snapshot();
+    }
 
-      return std::make_unique<MutableStorageImpl>(
-          top_hash, std::move(index), std::move(postgres_connection),
-          std::move(wsv_transaction), std::move(wsv), std::move(executor));
+    std::unique_ptr<SnapshotPin> StorageImpl::pinSnapshot() {
+      return std::make_unique<Pin>(*this, snapshot());
+    }
+
+    bool StorageImpl::publishSnapshot(const hash256_t &top_hash) {
+      auto snapshot = std::make_shared<Snapshot>();
+      snapshot->height = block_store_->last_id();
+      snapshot->top_hash = top_hash;
+      snapshot->state_root = state_root_;
+      snapshot->transaction = wsv_->snapshot();
+      if (not snapshot->transaction) {
+        log_->error("Cannot start snapshot of world state view");
+        return false;
+      }
+      snapshot->wsv = snapshot->transaction->query();
+      std::atomic_store(&snapshot_, snapshot);
+      return true;
     }
 
     std::shared_ptr<StorageImpl> StorageImpl::create(
         std::string block_store_dir, std::string redis_host,
-        std::size_t redis_port, std::string postgres_options) {
+        std::size_t redis_port, std::string postgres_options,
+        BlockStorageOptions block_storage_options) {
       auto log_ = logger::log("StorageImpl:create");
       log_->info("Start storage creation");
       // TODO lock
 
-      auto block_store = FlatFile::create(block_store_dir);
+      // block store, world state view and block index are independent, so
+      // scan of blocks, connections and schema setup overlap
+      auto block_store_opened = std::async(std::launch::async, [&] {
+        auto start = std::chrono::steady_clock::now();
+        std::unique_ptr<BlockStorage> block_store;
+        switch (block_storage_options.type) {
+          case BlockStorageType::Segmented:
+            block_store =
+                SegmentedLog::create(block_store_dir,
+                                     SegmentedLog::kDefaultSegmentSize,
+                                     block_storage_options.verify_blocks,
+                                     block_storage_options.durability,
+                                     block_storage_options.compression);
+            break;
+          case BlockStorageType::FlatFile:
+            block_store =
+                FlatFile::create(block_store_dir,
+                                 block_storage_options.verify_blocks,
+                                 block_storage_options.durability,
+                                 block_storage_options.compression);
+            break;
+        }
+        metrics::startupPhase("block_store",
+                              std::chrono::steady_clock::now() - start);
+        return block_store;
+      });
+
+      auto wsv_opened = std::async(std::launch::async, [&] {
+        auto start = std::chrono::steady_clock::now();
+        std::unique_ptr<WsvBackend> wsv;
+        switch (block_storage_options.wsv_backend) {
+          case WsvBackendType::Postgres:
+            wsv = PostgresWsvBackend::create(postgres_options);
+            break;
+          case WsvBackendType::Lmdb: {
+            auto store = LmdbStore::create(block_storage_options.wsv_path);
+            if (store) {
+              wsv = std::make_unique<KeyValueWsvBackend>(std::move(store));
+            }
+            break;
+          }
+        }
+        metrics::startupPhase("wsv", std::chrono::steady_clock::now() - start);
+        return wsv;
+      });
+
+      auto block_index_opened = std::async(std::launch::async, [&] {
+        auto start = std::chrono::steady_clock::now();
+        std::unique_ptr<BlockIndex> block_index;
+        switch (block_storage_options.block_index) {
+          case BlockIndexType::None:
+            break;
+          case BlockIndexType::Redis:
+            block_index = RedisBlockIndex::create(redis_host, redis_port);
+            break;
+          case BlockIndexType::Embedded: {
+            auto store =
+                LmdbStore::create(block_storage_options.block_index_path);
+            if (store) {
+              block_index =
+                  std::make_unique<KeyValueBlockIndex>(std::move(store));
+            }
+            break;
+          }
+        }
+        metrics::startupPhase("block_index",
+                              std::chrono::steady_clock::now() - start);
+        return block_index;
+      });
+
+      auto block_store = block_store_opened.get();
+      auto wsv = wsv_opened.get();
+      auto block_index = block_index_opened.get();
+
       if (!block_store) {
         log_->error("Cannot create block store in {}", block_store_dir);
         return nullptr;
       }
       log_->info("block store created");
 
-      auto index = std::make_unique<cpp_redis::redis_client>();
-      try {
-        index->connect(redis_host, redis_port);
-      } catch (const cpp_redis::redis_error &e) {
-        log_->error("Connection {}:{} with Redis broken",
-                    redis_host,
-                    redis_port);
+      if (not wsv) {
+        log_->error("Cannot open world state view");
         return nullptr;
       }
-      log_->info("connection to Redis completed");
+      log_->info("world state view opened");
 
-      auto postgres_connection =
-          std::make_unique<pqxx::lazyconnection>(postgres_options);
-      try {
-        postgres_connection->activate();
-      } catch (const pqxx::broken_connection &e) {
-        log_->error("Cannot with PostgreSQL broken: {}", e.what());
-        return nullptr;
+      switch (block_storage_options.block_index) {
+        case BlockIndexType::None:
+          break;
+        case BlockIndexType::Redis:
+          if (not block_index) {
+            log_->error("Connection {}:{} with Redis broken",
+                        redis_host,
+                        redis_port);
+            return nullptr;
+          }
+          log_->info("connection to Redis completed");
+          break;
+        case BlockIndexType::Embedded:
+          if (not block_index) {
+            log_->error("Cannot open block index in {}",
+                        block_storage_options.block_index_path);
+            return nullptr;
+          }
+          log_->info("embedded block index opened");
+          break;
+      }
+
+      metrics::StartupPhases phases;
+      std::unique_ptr<TxHashFilter> tx_filter;
+      if (block_storage_options.tx_hash_filter) {
+        tx_filter = TxHashFilter::create(block_store_dir);
+        if (not tx_filter) {
+          log_->warn("Transaction hash filter is disabled");
+        }
       }
-      log_->info("connection to PostgreSQL completed");
 
-      auto wsv_transaction = std::make_unique<pqxx::nontransaction>(
-          *postgres_connection, "Storage");
-      std::unique_ptr<WsvQuery> wsv =
-          std::make_unique<PostgresWsvQuery>(*wsv_transaction);
-      log_->info("transaction to PostgreSQL initialized");
+      std::unique_ptr<TxColumns> tx_columns;
+      if (block_storage_options.tx_columns) {
+        tx_columns = TxColumns::create(block_store_dir);
+        if (not tx_columns) {
+          log_->warn("Transaction columns are disabled");
+        }
+      }
 
-      return std::shared_ptr<StorageImpl>(
+      std::unique_ptr<BlockStorage> wsv_changes;
+      if (not block_storage_options.wsv_changes_path.empty()) {
+        wsv_changes = SegmentedLog::create(
+            block_storage_options.wsv_changes_path,
+            SegmentedLog::kDefaultSegmentSize,
+            block_storage_options.verify_blocks,
+            block_storage_options.durability);
+        if (not wsv_changes) {
+          log_->warn("Changes of world state view are not logged");
+        }
+      }
+
+      auto storage = std::shared_ptr<StorageImpl>(
           new StorageImpl(block_store_dir, redis_host, redis_port,
                           postgres_options, std::move(block_store),
-                          std::move(index), std::move(postgres_connection),
-                          std::move(wsv_transaction), std::move(wsv)));
+                          block_storage_options,
+                          std::move(block_index), std::move(tx_filter),
+                          std::move(tx_columns), std::move(wsv_changes),
+                          std::move(wsv)));
+      if (block_storage_options.state_root) {
+        storage->state_root_ = storage->computeStateRoot();
+        if (not storage->state_root_) {
+          log_->warn("Root of world state view is not maintained");
+        }
+        phases.mark("state_root");
+      }
+      auto top_hash = storage->loadTopHash();
+      if (not top_hash or not storage->publishSnapshot(*top_hash)) {
+        return nullptr;
+      }
+      phases.mark("snapshot");
+      // blocks committed while the index was unavailable, queries scan
+      // blocks until they are indexed
+      if (storage->block_index_) {
+        storage->startIndexing(block_storage_options.block_index_rebuild_rate);
+      }
+      if (storage->tx_filter_
+          and not storage->synchronize(
+                  storage->tx_filter_->height(),
+                  TxHashFilter::kSegmentBlocks,
+                  [&storage](const BlockRefs &blocks) {
+                    return storage->tx_filter_->add(blocks);
+                  })) {
+        log_->warn("Transaction hash filter is incomplete, it is not used");
+      }
+      phases.mark("tx_filter");
+      if (storage->tx_columns_
+          and not storage->synchronize(
+                  storage->tx_columns_->height(),
+                  TxColumns::kSegmentBlocks,
+                  [&storage](const BlockRefs &blocks) {
+                    return storage->tx_columns_->add(blocks);
+                  })) {
+        log_->warn("Transaction columns are incomplete, queries scan blocks");
+      }
+      phases.mark("tx_columns");
+      if (block_storage_options.warm_up_blocks > 0) {
+        storage->startWarmUp(block_storage_options.warm_up_blocks);
+      }
+      return storage;
     }
 
     void StorageImpl::commit(std::unique_ptr<MutableStorage> mutableStorage) {
-      std::unique_lock<std::shared_timed_mutex> write(rw_lock_);
+      std::lock_guard<std::mutex> lock(commit_lock_);
       auto storage_ptr = std::move(mutableStorage);  // get ownership of storage
       auto storage = static_cast<MutableStorageImpl *>(storage_ptr.get());
+      static auto &block_store_time = commitTime("block_store");
+      static auto &wsv_time = commitTime("wsv");
+      static auto &index_time = commitTime("index");
+      // deferred writes go first, so nothing is stored if they fail
+      auto start = std::chrono::steady_clock::now();
+      if (not storage->wsv_->flush()) {
+        log_->error("Cannot write world state of committed blocks");
+        return;
+      }
+      auto wsv_duration = std::chrono::steady_clock::now() - start;
+      // blocks up to the stored height are applied again over imported
+      // world state view, only their changes of the state are committed
+      auto stored_height = block_store_->last_id();
+      // blocks of one commit are flushed together
+      BlockBatch blocks;
+      BlockRefs added;
+      std::vector<std::shared_ptr<const model::Block>> handles;
+      start = std::chrono::steady_clock::now();
       for (const auto &block : storage->block_store_) {
-        block_store_->add(block.first,
-                          model::converters::jsonToVector(
-                              serializer_.serialize(block.second)));
+        if (block.first > stored_height) {
+          blocks.emplace_back(block.first,
+                              serializer_.serialize(*block.second));
+          added.push_back(std::cref(*block.second));
+          handles.push_back(block.second);
+        }
+      }
+      // world state view must not get ahead of stored blocks, stored part
+      // of the batch is applied again by the next commit
+      if (not blocks.empty() and not block_store_->add_batch(blocks)) {
+        log_->error("Cannot store blocks {}..{}, nothing is committed",
+                    blocks.front().first,
+                    blocks.back().first);
+        return;
+      }
+      block_store_time.observe(std::chrono::steady_clock::now() - start);
+      // recently committed blocks are the ones most likely to be queried
+      for (size_t i = 0; i < blocks.size(); ++i) {
+        block_cache_.put(
+            blocks[i].first, std::move(handles[i]), blocks[i].second.size());
+      }
+      // later blocks must not hide the gap, so indexing stops until
+      // IndexMediator restores missing entries on restart
+      start = std::chrono::steady_clock::now();
+      if (index_live_ and not block_index_->add(added)) {
+        log_->warn("Cannot index committed blocks, queries will scan");
+        index_live_ = false;
+      }
+      index_time.observe(std::chrono::steady_clock::now() - start);
+      // filter gets blocks before readers can see them
+      if (tx_filter_) {
+        tx_filter_->add(added);
       }
-      storage->index_->exec();
-      storage->transaction_->exec("COMMIT;");
+      if (tx_columns_) {
+        tx_columns_->add(added);
+      }
+      if (wsv_changes_) {
+        logWsvChanges(*storage, stored_height);
+      }
+      if (not storage->block_store_.empty()) {
+        storage->transaction_->setHeight(storage->block_store_.rbegin()->first);
+      }
+      start = std::chrono::steady_clock::now();
+      if (not storage->transaction_->commit()) {
+        log_->error("Cannot commit world state view");
+      }
+      wsv_time.observe(wsv_duration + std::chrono::steady_clock::now() - start);
       storage->committed = true;
+      if (storage->state_root_) {
+        state_root_ = storage->state_root_;
+        log_->info("State root at height {} is {}",
+                   block_store_->last_id(),
+                   state_root_->value().to_hexstring());
+      }
+      // readers switch to the new state only when all of it is written
+      auto top_hash =
+          blocks.empty() ? snapshot()->top_hash : storage->top_hash_;
+      if (not publishSnapshot(top_hash)) {
+        log_->error("Readers stay at height {}", snapshot()->height);
+        return;
+      }
+      if (wsv_snapshot_interval_ != 0
+          and block_store_->last_id() / wsv_snapshot_interval_
+              > stored_height / wsv_snapshot_interval_) {
+        exportWsvSnapshot();
+      }
+      if (block_retention_ != 0) {
+        pruneBlocks();
+      }
+    }
+
+    void StorageImpl::logWsvChanges(const MutableStorageImpl &storage,
+                                    uint32_t stored_height) {
+      // blocks applied again over imported state are logged already
+      BlockBatch changes;
+      for (const auto &block : storage.changes_) {
+        if (block.first > stored_height) {
+          auto pb_changes = block.second.serialize(block.first);
+          std::vector<uint8_t> bytes(pb_changes.ByteSizeLong());
+          pb_changes.SerializeToArray(bytes.data(), bytes.size());
+          changes.emplace_back(block.first, std::move(bytes));
+        }
+      }
+      if (changes.empty()) {
+        return;
+      }
+      auto last_id = wsv_changes_->last_id();
+      if (last_id != 0 and changes.front().first != last_id + 1) {
+        log_->warn("Changes of blocks {}..{} are missing, log is not extended",
+                   last_id + 1,
+                   changes.front().first - 1);
+        return;
+      }
+      if (not wsv_changes_->add_batch(changes)) {
+        log_->warn("Cannot log changes of blocks {}..{}",
+                   changes.front().first,
+                   changes.back().first);
+      }
+    }
+
+    void StorageImpl::pruneBlocks() {
+      auto last_id = block_store_->last_id();
+      if (last_id <= block_retention_) {
+        return;
+      }
+      auto oldest = last_id - block_retention_ + 1;
+      if (wsv_snapshot_interval_ != 0) {
+        // restore needs the block of the latest snapshot and all after it
+        auto heights = wsv_snapshots_.heights();
+        oldest = heights.empty() ? 0 : std::min(oldest, heights.back());
+      }
+      if (oldest > block_store_->first_id()
+          and not block_store_->prune(oldest, block_archive_path_)) {
+        log_->warn("Some blocks before {} are not removed", oldest);
+      }
+    }
+
+    void StorageImpl::exportWsvSnapshot() {
+      auto height = snapshot()->height;
+      if (snapshot_running_) {
+        log_->warn("Snapshot export is running, height {} is skipped",
+                   height);
+        return;
+      }
+      if (snapshot_thread_.joinable()) {
+        snapshot_thread_.join();
+      }
+      // taken under commit lock, so it sees exactly the published height
+      std::shared_ptr<WsvTransaction> transaction = wsv_->snapshot();
+      if (not transaction) {
+        log_->error("Cannot start export of world state view");
+        return;
+      }
+      snapshot_running_ = true;
+      auto top_hash = snapshot()->top_hash;
+      snapshot_thread_ = std::thread([this, height, top_hash, transaction] {
+        WsvSnapshot wsv_snapshot{height, top_hash, {}};
+        if (not transaction->dump(wsv_snapshot.tables)) {
+          log_->error("Cannot read world state view at height {}", height);
+        } else if (wsv_snapshots_.write(wsv_snapshot,
+                                        wsv_snapshot_keypair_)) {
+          log_->info("World state view at height {} is exported", height);
+        }
+        snapshot_running_ = false;
+      });
+    }
+
+    nonstd::optional<uint32_t> StorageImpl::importWsvSnapshot(
+        const std::vector<ed25519::pubkey_t> &trusted) {
+      std::lock_guard<std::mutex> lock(commit_lock_);
+      auto state = snapshot();
+      nonstd::optional<std::vector<model::Peer>> peers;
+      {
+        std::lock_guard<std::mutex> state_lock(state->lock);
+        peers = state->wsv->getPeers();
+      }
+      if (not peers or not peers->empty()) {
+        log_->error("Snapshot can be imported into empty state only");
+        return nonstd::nullopt;
+      }
+
+      auto heights = wsv_snapshots_.heights();
+      for (auto it = heights.rbegin(); it != heights.rend(); ++it) {
+        // snapshot must belong to the stored chain
+        if (*it == 0 or *it > state->height) {
+          continue;
+        }
+        auto block = readLazyBlock(*it);
+        auto wsv_snapshot = wsv_snapshots_.read(*it, trusted);
+        if (not block or not wsv_snapshot
+            or wsv_snapshot->top_hash != block->hash()) {
+          log_->warn("Snapshot at height {} is skipped", *it);
+          continue;
+        }
+        auto transaction = wsv_->beginBulk();
+        if (not transaction
+            or not loadTables(wsv_snapshot->tables, *transaction->command())) {
+          log_->error("Cannot load snapshot at height {}", *it);
+          return nonstd::nullopt;
+        }
+        transaction->setHeight(*it);
+        if (state_root_) {
+          state_root_ = StateRoot::of(wsv_snapshot->tables);
+        }
+        if (not transaction->commit() or not publishSnapshot(state->top_hash)) {
+          log_->error("Cannot commit snapshot at height {}", *it);
+          return nonstd::nullopt;
+        }
+        log_->info("World state view at height {} is imported", *it);
+        return *it;
+      }
+      log_->error("No usable snapshot of world state view");
+      return nonstd::nullopt;
+    }
+
+    nonstd::optional<StateRoot> StorageImpl::computeStateRoot() {
+      auto transaction = wsv_->snapshot();
+      BulkTables tables;
+      if (not transaction or not transaction->dump(tables)) {
+        return nonstd::nullopt;
+      }
+      return StateRoot::of(tables);
+    }
+
+    std::vector<uint32_t> StorageImpl::wsvSnapshotHeights() const {
+      return wsv_snapshots_.heights();
+    }
+
+    bool StorageImpl::insertBlocks(const std::vector<model::Block> &blocks) {
+      std::lock_guard<std::mutex> lock(commit_lock_);
+      auto state = snapshot();
+      nonstd::optional<std::vector<model::Peer>> peers;
+      {
+        std::lock_guard<std::mutex> state_lock(state->lock);
+        peers = state->wsv->getPeers();
+      }
+      if (not peers or not peers->empty()) {
+        log_->error("Blocks can be inserted over empty state only");
+        return false;
+      }
+
+      auto top_hash = state->top_hash;
+      auto height = block_store_->last_id();
+      BlockBatch batch;
+      BlockRefs added;
+      for (const auto &block : blocks) {
+        if (block.height != height + 1 or block.prev_hash != top_hash) {
+          log_->error("Block {} does not extend stored chain", block.height);
+          return false;
+        }
+        batch.emplace_back(block.height, serializer_.serialize(block));
+        added.push_back(std::cref(block));
+        top_hash = block.hash;
+        ++height;
+      }
+      if (batch.empty()) {
+        return true;
+      }
+      if (not block_store_->add_batch(batch)) {
+        log_->error("Cannot store inserted blocks");
+        return false;
+      }
+      if (index_live_ and not block_index_->add(added)) {
+        log_->warn("Cannot index inserted blocks, queries will scan");
+        index_live_ = false;
+      }
+      if (tx_filter_) {
+        tx_filter_->add(added);
+      }
+      if (tx_columns_) {
+        tx_columns_->add(added);
+      }
+      if (not publishSnapshot(top_hash)) {
+        log_->error("Readers stay at height {}", state->height);
+        return false;
+      }
+      log_->info("Stored {} blocks up to height {}", batch.size(), height);
+      return true;
     }
 
     rxcpp::observable<model::Transaction> StorageImpl::getAccountTransactions(
         std::string account_id) {
-      std::shared_lock<std::shared_timed_mutex> write(rw_lock_);
-      auto last_id = block_store_->last_id();
-      return getBlocks(1, last_id)
-          .flat_map([](auto block) {
-            return rxcpp::observable<>::iterate(block.transactions);
-          })
-          .filter([account_id](auto tx) {
-            return tx.creator_account_id == account_id;
+      return getAccountTransactions(account_id, model::TxPagination())
+          .map([](const CommittedTransaction &tx) { return tx.transaction; });
+    }
+
+    rxcpp::observable<CommittedTransaction> StorageImpl::getAccountTransactions(
+        std::string account_id, const model::TxPagination &pagination) {
+      auto height = readSnapshot()->height;
+      auto positions = indexedTransactions(account_id, height);
+      if (positions) {
+        return readTransactions(page(*positions, pagination));
+      }
+      // no complete index, e.g. it is disabled or unavailable
+      if (tx_columns_ and tx_columns_->height() >= height) {
+        return readTransactions(
+            page(tx_columns_->accountTransactions(account_id, height),
+                 pagination));
+      }
+      // creators are read from stored meta of transactions
+      return scanLazyTransactions(
+          height,
+          pagination,
+          [account_id](const LazyBlock &block, size_t index) {
+            return block.creatorAccountId(index) == account_id;
+          });
+    }
+
+    rxcpp::observable<CommittedTransaction>
+    StorageImpl::getAccountAssetTransactions(
+        std::string account_id,
+        std::string asset_id,
+        const model::TxPagination &pagination) {
+      auto height = readSnapshot()->height;
+      auto positions = indexedAssetTransactions(account_id, asset_id, height);
+      if (positions) {
+        return readTransactions(page(*positions, pagination));
+      }
+      // no complete index, e.g. it is disabled or unavailable
+      if (tx_columns_ and tx_columns_->height() >= height) {
+        return readTransactions(page(
+            tx_columns_->accountAssetTransactions(account_id, asset_id, height),
+            pagination));
+      }
+      auto account_asset = std::make_pair(account_id, asset_id);
+      return scanTransactions(
+          height, pagination, [account_asset](const model::Transaction &tx) {
+            return changedAccountAssets(tx).count(account_asset) > 0;
+          });
+    }
+
+    rxcpp::observable<CommittedTransaction> StorageImpl::getAssetTransfers(
+        std::string asset_id,
+        uint32_t from,
+        uint32_t to,
+        Amount min_amount,
+        const model::TxPagination &pagination) {
+      auto height = readSnapshot()->height;
+      from = std::max(from, 1u);
+      if (to == 0 or to > height) {
+        to = height;
+      }
+      if (from > to) {
+        return rxcpp::observable<>::empty<CommittedTransaction>();
+      }
+      // block index has no transfers by asset, so columns are the index;
+      // their scan skips segments without the asset and reads only
+      // blocks with matching transfers
+      if (tx_columns_ and tx_columns_->height() >= to) {
+        return readTransactions(page(
+            tx_columns_->assetTransfers(asset_id, from, to, min_amount),
+            pagination));
+      }
+      // otherwise blocks of the range are scanned, starting from the
+      // later of the range and the cursor
+      auto range = pagination;
+      if (not range.after or range.after->height < from) {
+        range.after = model::TxCursor{from - 1,
+                                      std::numeric_limits<uint32_t>::max()};
+      }
+      return scanTransactions(
+          to, range, [asset_id, min_amount](const model::Transaction &tx) {
+            auto transfers = assetTransfers(tx);
+            return std::any_of(
+                transfers.begin(), transfers.end(), [&](const auto &transfer) {
+                  return transfer.first == asset_id
+                      and not(transfer.second < min_amount);
+                });
+          });
+    }
+
+    rxcpp::observable<CommittedTransaction> StorageImpl::readTransactions(
+        std::vector<TxPosition> positions) {
+      return rxcpp::observable<>::create<CommittedTransaction>(
+          [this, positions](auto s) {
+            for (const auto &position : positions) {
+              if (not s.is_subscribed()) {
+                break;
+              }
+              // transactions of one block are read from the cache
+              auto block = this->readBlock(position.height);
+              if (block and position.index < block->transactions.size()) {
+                s.on_next(CommittedTransaction{
+                    block->transactions[position.index],
+                    position.height,
+                    position.index});
+              }
+            }
+            s.on_completed();
+          });
+    }
+
+    rxcpp::observable<CommittedTransaction> StorageImpl::scanTransactions(
+        uint32_t height,
+        const model::TxPagination &pagination,
+        std::function<bool(const model::Transaction &)> predicate) {
+      auto after = pagination.after;
+      auto from = after ? std::max(after->height, 1u) : 1u;
+      rxcpp::observable<CommittedTransaction> transactions =
+          getBlocks(from, height)
+              .flat_map([](auto block) {
+                std::vector<CommittedTransaction> transactions;
+                for (size_t i = 0; i < block.transactions.size(); ++i) {
+                  transactions.push_back(
+                      CommittedTransaction{block.transactions[i],
+                                           block.height,
+                                           static_cast<uint32_t>(i)});
+                }
+                return rxcpp::observable<>::iterate(transactions);
+              })
+              .filter([after, predicate](const CommittedTransaction &tx) {
+                return isAfter(tx.height, tx.index, after)
+                    and predicate(tx.transaction);
+              });
+      if (pagination.page_size == 0) {
+        return transactions;
+      }
+      return transactions.take(pagination.page_size);
+    }
+
+    rxcpp::observable<CommittedTransaction> StorageImpl::scanLazyTransactions(
+        uint32_t height,
+        const model::TxPagination &pagination,
+        std::function<bool(const LazyBlock &, size_t)> predicate) {
+      auto after = pagination.after;
+      auto from = after ? std::max(after->height, 1u) : 1u;
+      auto page_size = pagination.page_size;
+      return rxcpp::observable<>::create<CommittedTransaction>(
+          [this, from, height, after, page_size, predicate](auto s) {
+            uint32_t found = 0;
+            for (auto id = from; id <= height and s.is_subscribed(); ++id) {
+              auto block = this->readLazyBlock(id);
+              if (not block) {
+                continue;
+              }
+              for (size_t i = 0; i < block->transactionsSize(); ++i) {
+                if (not isAfter(id, static_cast<uint32_t>(i), after)
+                    or not predicate(*block, i)) {
+                  continue;
+                }
+                auto tx = block->transaction(i);
+                if (not tx) {
+                  continue;
+                }
+                s.on_next(CommittedTransaction{
+                    *tx, id, static_cast<uint32_t>(i)});
+                if (++found == page_size or not s.is_subscribed()) {
+                  s.on_completed();
+                  return;
+                }
+              }
+            }
+            s.on_completed();
           });
     }
 
     rxcpp::observable<model::Block> StorageImpl::getBlocks(uint32_t from,
                                                            uint32_t to) {
-      std::shared_lock<std::shared_timed_mutex> write(rw_lock_);
-      auto last_id = block_store_->last_id();
+      // blocks committed later are not visible to this read
+      auto last_id = snapshot()->height;
+      if (to > last_id) {
+        to = last_id;
+      }
+      return rxcpp::observable<>::create<model::Block>(
+          [this, from, to](auto s) {
+            // short ranges are not worth handing over to workers
+            auto pool =
+                from + kParallelReadThreshold > to ? nullptr : &read_pool_;
+            BlockRangeReader reader(
+                from,
+                to,
+                [this](uint32_t height) { return this->readBlock(height); },
+                pool,
+                kReadAhead);
+            while (s.is_subscribed()) {
+              auto block = reader.next();
+              if (not block) {
+                break;
+              }
+              // unreadable blocks are skipped
+              if (*block) {
+                s.on_next(**block);
+              }
+            }
+            s.on_completed();
+          });
+    }
+
+    rxcpp::observable<protocol::Block> StorageImpl::getWireBlocks(
+        uint32_t from, uint32_t to) {
+      auto last_id = snapshot()->height;
       if (to > last_id) {
         to = last_id;
       }
-      return rxcpp::observable<>::range(from, to).flat_map([this](auto i) {
-        auto bytes = block_store_->get(i);
-        return rxcpp::observable<>::create<model::Block>(
-            [this, bytes](auto s) {
-              if (not bytes.has_value()) {
-                s.on_completed();
+      return rxcpp::observable<>::create<protocol::Block>(
+          [this, from, to](auto s) {
+            for (uint64_t height = from; height <= to and s.is_subscribed();
+                 ++height) {
+              auto bytes = block_store_->view(height);
+              if (not bytes) {
+                continue;
               }
-              auto document = model::converters::vectorToJson(bytes.value());
-              if (not document.has_value()) {
-                s.on_completed();
+              // unreadable blocks are skipped
+              auto block =
+                  serializer_.deserializeWire(bytes->data(), bytes->size());
+              if (block) {
+                s.on_next(*block);
               }
-              auto block = serializer_.deserialize(document.value());
-              if (not block.has_value()) {
-                s.on_completed();
+            }
+            s.on_completed();
+          });
+    }
+
+    rxcpp::observable<protocol::WsvChanges> StorageImpl::getWsvChanges(
+        uint32_t from, uint32_t to) {
+      if (not wsv_changes_) {
+        return rxcpp::observable<>::empty<protocol::WsvChanges>();
+      }
+      // blocks committed before the log was enabled have no changes
+      from = std::max(from, wsv_changes_->first_id());
+      to = std::min(to, wsv_changes_->last_id());
+      return rxcpp::observable<>::create<protocol::WsvChanges>(
+          [this, from, to](auto s) {
+            for (uint64_t height = from; height <= to and s.is_subscribed();
+                 ++height) {
+              auto bytes = wsv_changes_->view(height);
+              protocol::WsvChanges changes;
+              // unreadable records are skipped
+              if (bytes and changes.ParseFromArray(bytes->data(),
+                                                   bytes->size())) {
+                s.on_next(changes);
+              }
+            }
+            s.on_completed();
+          });
+    }
+
+    nonstd::optional<CommittedTransaction> StorageImpl::getTransaction(
+        const hash256_t &tx_hash) {
+      auto height = readSnapshot()->height;
+      // transactions are compared by hash, only the found one is decoded
+      auto find = [&tx_hash](const LazyBlock &block)
+          -> nonstd::optional<CommittedTransaction> {
+        for (size_t i = 0; i < block.transactionsSize(); ++i) {
+          if (block.transactionHash(i) == tx_hash) {
+            auto tx = block.transaction(i);
+            if (not tx) {
+              return nonstd::nullopt;
+            }
+            return CommittedTransaction{*tx,
+                                        static_cast<uint32_t>(block.height()),
+                                        static_cast<uint32_t>(i)};
+          }
+        }
+        return nonstd::nullopt;
+      };
+      // most looked up transactions are not committed yet
+      if (tx_filter_ and tx_filter_->height() >= height
+          and not tx_filter_->mayContain(tx_hash)) {
+        return nonstd::nullopt;
+      }
+      auto position = indexedTransaction(tx_hash, height);
+      if (position) {
+        if (not *position) {
+          return nonstd::nullopt;
+        }
+        // only the block of the transaction is read, usually from the cache
+        auto block = readLazyBlock((*position)->height);
+        if (not block) {
+          return nonstd::nullopt;
+        }
+        return find(*block);
+      }
+      // no complete index, e.g. it is disabled or unavailable
+      for (uint32_t id = 1; id <= height; ++id) {
+        auto block = readLazyBlock(id);
+        if (not block) {
+          continue;
+        }
+        if (auto result = find(*block)) {
+          return result;
+        }
+      }
+      return nonstd::nullopt;
+    }
+
+    nonstd::optional<model::InclusionProof> StorageImpl::getInclusionProof(
+        const CommittedTransaction &tx) {
+      auto block = readBlock(tx.height);
+      if (not block or tx.index >= block->transactions.size()) {
+        return nonstd::nullopt;
+      }
+      auto tree = merkle_trees_.get(tx.height);
+      if (not tree) {
+        model::HashProviderImpl hash_provider;
+        std::vector<hash256_t> leaves;
+        leaves.reserve(block->transactions.size());
+        for (const auto &transaction : block->transactions) {
+          leaves.push_back(hash_provider.get_hash(transaction));
+        }
+        tree = std::make_shared<const model::MerkleTree>(
+            model::MerkleTree::build(leaves));
+        merkle_trees_.put(tx.height, tree);
+      }
+      // blocks stored before merkle roots were computed can not be proven
+      if (tree->root() != block->merkle_root) {
+        return nonstd::nullopt;
+      }
+      model::InclusionProof proof;
+      auto &header = proof.header;
+      header.hash = block->hash;
+      header.sigs = block->sigs;
+      header.created_ts = block->created_ts;
+      header.height = block->height;
+      header.prev_hash = block->prev_hash;
+      header.txs_number = block->txs_number;
+      header.merkle_root = block->merkle_root;
+      proof.path = *tree->proof(tx.index);
+      return proof;
+    }
+
+    bool StorageImpl::hasTransaction(const hash256_t &tx_hash) {
+      return static_cast<bool>(getTransaction(tx_hash));
+    }
+
+    uint32_t StorageImpl::getTopBlockHeight() { return height(); }
+
+    nonstd::optional<CommittedStateRoot> StorageImpl::getStateRoot() {
+      // root and height are taken from one snapshot to match each other
+      auto state = snapshot();
+      if (not state->state_root) {
+        return nonstd::nullopt;
+      }
+      return CommittedStateRoot{state->height, state->state_root->value()};
+    }
+
+    bool StorageImpl::synchronize(
+        uint32_t added_height,
+        uint32_t step,
+        const std::function<bool(const BlockRefs &)> &add) {
+      auto height = snapshot()->height;
+      auto from = added_height + 1;
+      while (from <= height) {
+        auto to = std::min(height, from + step - 1);
+        std::vector<model::Block> batch;
+        getBlocks(from, to).as_blocking().subscribe(
+            [&batch, from](const model::Block &block) {
+              if (block.height == from + batch.size()) {
+                batch.push_back(block);
               }
-              s.on_next(block.value());
-              s.on_completed();
             });
-      });
+        if (batch.size() != to - from + 1
+            or not add(BlockRefs(batch.begin(), batch.end()))) {
+          return false;
+        }
+        from = to + 1;
+      }
+      return true;
+    }
+
+    nonstd::optional<std::vector<TxPosition>> StorageImpl::indexedTransactions(
+        const std::string &account_id, uint32_t height) {
+      if (not block_index_) {
+        return nonstd::nullopt;
+      }
+      auto indexed = block_index_->height();
+      if (not indexed or *indexed < height) {
+        return nonstd::nullopt;
+      }
+      auto positions = block_index_->accountTransactions(account_id);
+      if (not positions) {
+        return nonstd::nullopt;
+      }
+      // transactions committed after the snapshot are not visible
+      positions->erase(std::remove_if(positions->begin(),
+                                      positions->end(),
+                                      [height](const auto &position) {
+                                        return position.height > height;
+                                      }),
+                       positions->end());
+      return positions;
+    }
+
+    nonstd::optional<std::vector<TxPosition>>
+    StorageImpl::indexedAssetTransactions(const std::string &account_id,
+                                          const std::string &asset_id,
+                                          uint32_t height) {
+      if (not block_index_) {
+        return nonstd::nullopt;
+      }
+      auto indexed = block_index_->height();
+      if (not indexed or *indexed < height) {
+        return nonstd::nullopt;
+      }
+      auto positions =
+          block_index_->accountAssetTransactions(account_id, asset_id);
+      if (not positions) {
+        return nonstd::nullopt;
+      }
+      // transactions committed after the snapshot are not visible
+      positions->erase(std::remove_if(positions->begin(),
+                                      positions->end(),
+                                      [height](const auto &position) {
+                                        return position.height > height;
+                                      }),
+                       positions->end());
+      return positions;
+    }
+
+    nonstd::optional<nonstd::optional<TxPosition>>
+    StorageImpl::indexedTransaction(const hash256_t &tx_hash,
+                                    uint32_t height) {
+      if (not block_index_) {
+        return nonstd::nullopt;
+      }
+      auto indexed = block_index_->height();
+      if (not indexed or *indexed < height) {
+        return nonstd::nullopt;
+      }
+      auto position = block_index_->transaction(tx_hash);
+      // transactions committed after the snapshot are not visible
+      if (position and position->height > height) {
+        position = nonstd::nullopt;
+      }
+      return nonstd::make_optional(position);
+    }
+
+    std::shared_ptr<const model::Block> StorageImpl::readBlock(
+        uint32_t height) {
+      auto cached = block_cache_.get(height);
+      if (cached) {
+        return cached;
+      }
+      auto bytes = block_store_->view(height);
+      if (not bytes) {
+        return nullptr;
+      }
+      auto block = serializer_.deserialize(bytes->data(), bytes->size());
+      if (not block) {
+        return nullptr;
+      }
+      auto shared = std::make_shared<const model::Block>(std::move(*block));
+      block_cache_.put(height, shared, bytes->size());
+      return shared;
+    }
+
+    std::shared_ptr<const LazyBlock> StorageImpl::readLazyBlock(
+        uint32_t height) {
+      auto cached = block_cache_.get(height);
+      if (cached) {
+        return std::make_shared<const LazyBlock>(std::move(cached));
+      }
+      auto bytes = block_store_->view(height);
+      if (not bytes) {
+        return nullptr;
+      }
+      return serializer_.deserializeLazy(std::move(*bytes));
     }
 
     nonstd::optional<model::Account> StorageImpl::getAccount(
         const std::string &account_id) {
-      std::shared_lock<std::shared_timed_mutex> write(rw_lock_);
-      return wsv_->getAccount(account_id);
+      auto snapshot = readSnapshot();
+      std::lock_guard<std::mutex> lock(snapshot->lock);
+      return snapshot->wsv->getAccount(account_id);
     }
 
     nonstd::optional<std::vector<ed25519::pubkey_t>>
     StorageImpl::getSignatories(const std::string &account_id) {
-      std::shared_lock<std::shared_timed_mutex> write(rw_lock_);
-      return wsv_->getSignatories(account_id);
+      auto snapshot = readSnapshot();
+      std::lock_guard<std::mutex> lock(snapshot->lock);
+      return snapshot->wsv->getSignatories(account_id);
     }
 
     nonstd::optional<model::Asset> StorageImpl::getAsset(
         const std::string &asset_id) {
-      std::shared_lock<std::shared_timed_mutex> write(rw_lock_);
-      return wsv_->getAsset(asset_id);
+      auto snapshot = readSnapshot();
+      std::lock_guard<std::mutex> lock(snapshot->lock);
+      return snapshot->wsv->getAsset(asset_id);
     }
 
     nonstd::optional<model::AccountAsset> StorageImpl::getAccountAsset(
         const std::string &account_id, const std::string &asset_id) {
-      std::shared_lock<std::shared_timed_mutex> write(rw_lock_);
-      return wsv_->getAccountAsset(account_id, asset_id);
+      auto snapshot = readSnapshot();
+      std::lock_guard<std::mutex> lock(snapshot->lock);
+      return snapshot->wsv->getAccountAsset(account_id, asset_id);
+    }
+
+    nonstd::optional<std::vector<model::AccountAsset>>
+    StorageImpl::getAccountAssets(const std::string &account_id,
+                                  const std::string &after_asset_id,
+                                  size_t limit) {
+      auto snapshot = readSnapshot();
+      std::lock_guard<std::mutex> lock(snapshot->lock);
+      return snapshot->wsv->getAccountAssets(account_id, after_asset_id, limit);
+    }
+
+    nonstd::optional<std::vector<model::AccountAsset>>
+    StorageImpl::getAssetHolders(const std::string &asset_id,
+                                 const std::string &after_account_id,
+                                 size_t limit) {
+      auto snapshot = readSnapshot();
+      std::lock_guard<std::mutex> lock(snapshot->lock);
+      return snapshot->wsv->getAssetHolders(asset_id, after_account_id, limit);
+    }
+
+    nonstd::optional<std::vector<model::Account>>
+    StorageImpl::getDomainAccounts(const std::string &domain_id,
+                                   const std::string &after_account_id,
+                                   size_t limit) {
+      auto snapshot = readSnapshot();
+      std::lock_guard<std::mutex> lock(snapshot->lock);
+      return snapshot->wsv->getDomainAccounts(domain_id,
+                                              after_account_id,
+                                              limit);
+    }
+
+    nonstd::optional<std::vector<std::string>>
+    StorageImpl::getAccountsBySignatory(const ed25519::pubkey_t &signatory,
+                                        const std::string &after_account_id,
+                                        size_t limit) {
+      auto snapshot = readSnapshot();
+      std::lock_guard<std::mutex> lock(snapshot->lock);
+      return snapshot->wsv->getAccountsBySignatory(signatory,
+                                                   after_account_id,
+                                                   limit);
     }
 
     nonstd::optional<std::vector<model::Peer>> StorageImpl::getPeers() {
-      std::shared_lock<std::shared_timed_mutex> write(rw_lock_);
-      return wsv_->getPeers();
+      auto snapshot = readSnapshot();
+      std::lock_guard<std::mutex> lock(snapshot->lock);
+      return snapshot->wsv->getPeers();
     }
 
+    uint32_t StorageImpl::height() const { return snapshot()->height; }
+
+    BlockCache &StorageImpl::blockCache() { return block_cache_; }
+
   }  // namespace ametsuchi
 }  // namespace iroha
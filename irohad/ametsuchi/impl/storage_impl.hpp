@@ -18,31 +18,73 @@
 #ifndef IROHA_STORAGE_IMPL_HPP
 #define IROHA_STORAGE_IMPL_HPP
 
-#include <cpp_redis/cpp_redis>
+#include <atomic>
+#include <functional>
 #include <nonstd/optional.hpp>
-#include <pqxx/pqxx>
-#include <shared_mutex>
+#include <mutex>
 #include <cmath>
-#include "model/converters/json_block_factory.hpp"
-#include "ametsuchi/impl/flat_file/flat_file.hpp"
+#include <thread>
+#include "ametsuchi/impl/block_cache.hpp"
+#include "ametsuchi/impl/block_index.hpp"
+#include "ametsuchi/impl/block_range_reader.hpp"
+#include "ametsuchi/impl/block_serializer.hpp"
+#include "ametsuchi/impl/block_storage.hpp"
+#include "ametsuchi/impl/merkle_tree_cache.hpp"
+#include "ametsuchi/impl/state_root.hpp"
+#include "ametsuchi/impl/temporary_wsv_impl.hpp"
+#include "ametsuchi/impl/tx_columns.hpp"
+#include "ametsuchi/impl/tx_hash_filter.hpp"
+#include "ametsuchi/impl/wsv_backend.hpp"
+#include "ametsuchi/impl/wsv_snapshot.hpp"
+#include "ametsuchi/index/index_mediator.hpp"
+#include "ametsuchi/snapshot_pin.hpp"
 #include "ametsuchi/storage.hpp"
 #include "logger/logger.hpp"
 
 namespace iroha {
   namespace ametsuchi {
-    class StorageImpl : public Storage {
+    class MutableStorageImpl;
+
+    class StorageImpl : public Storage, public SnapshotPinFactory {
      public:
       static std::shared_ptr<StorageImpl> create(
           std::string block_store_dir, std::string redis_host,
-          std::size_t redis_port, std::string postgres_connection);
+          std::size_t redis_port, std::string postgres_connection,
+          BlockStorageOptions block_storage_options = BlockStorageOptions());
+      ~StorageImpl() override;
       std::unique_ptr<TemporaryWsv> createTemporaryWsv() override;
       std::unique_ptr<MutableStorage> createMutableStorage() override;
+      std::unique_ptr<MutableStorage> createBulkStorage() override;
       void commit(std::unique_ptr<MutableStorage> mutableStorage) override;
 
       rxcpp::observable<model::Transaction> getAccountTransactions(
           std::string account_id) override;
+      rxcpp::observable<CommittedTransaction> getAccountTransactions(
+          std::string account_id,
+          const model::TxPagination &pagination) override;
+      rxcpp::observable<CommittedTransaction> getAccountAssetTransactions(
+          std::string account_id,
+          std::string asset_id,
+          const model::TxPagination &pagination) override;
+      rxcpp::observable<CommittedTransaction> getAssetTransfers(
+          std::string asset_id,
+          uint32_t from,
+          uint32_t to,
+          Amount min_amount,
+          const model::TxPagination &pagination) override;
       rxcpp::observable<model::Block> getBlocks(uint32_t from,
                                                 uint32_t to) override;
+      rxcpp::observable<protocol::Block> getWireBlocks(uint32_t from,
+                                                       uint32_t to) override;
+      rxcpp::observable<protocol::WsvChanges> getWsvChanges(
+          uint32_t from, uint32_t to) override;
+      nonstd::optional<CommittedTransaction> getTransaction(
+          const hash256_t &tx_hash) override;
+      nonstd::optional<model::InclusionProof> getInclusionProof(
+          const CommittedTransaction &tx) override;
+      bool hasTransaction(const hash256_t &tx_hash) override;
+      uint32_t getTopBlockHeight() override;
+      nonstd::optional<CommittedStateRoot> getStateRoot() override;
 
       nonstd::optional<model::Account> getAccount(
           const std::string &account_id) override;
@@ -52,90 +94,335 @@ namespace iroha {
           const std::string &asset_id) override;
       nonstd::optional<model::AccountAsset> getAccountAsset(
           const std::string &account_id, const std::string &asset_id) override;
+      nonstd::optional<std::vector<model::AccountAsset>> getAccountAssets(
+          const std::string &account_id,
+          const std::string &after_asset_id,
+          size_t limit) override;
+      nonstd::optional<std::vector<model::AccountAsset>> getAssetHolders(
+          const std::string &asset_id,
+          const std::string &after_account_id,
+          size_t limit) override;
+      nonstd::optional<std::vector<model::Account>> getDomainAccounts(
+          const std::string &domain_id,
+          const std::string &after_account_id,
+          size_t limit) override;
+      nonstd::optional<std::vector<std::string>> getAccountsBySignatory(
+          const ed25519::pubkey_t &signatory,
+          const std::string &after_account_id,
+          size_t limit) override;
       nonstd::optional<std::vector<model::Peer>> getPeers() override;
 
+      /**
+       * Pin world state view and transaction reads of calling thread, e.g.
+       * for queries of one batch
+       */
+      std::unique_ptr<SnapshotPin> pinSnapshot() override;
+
+      /**
+       * @return height of the last committed block
+       */
+      uint32_t height() const;
+
+      /**
+       * @return cache of recently used blocks, e.g. to read its counters
+       * or shrink it under memory pressure
+       */
+      BlockCache &blockCache();
+
+      /**
+       * Load the latest snapshot of world state view matching stored blocks
+       * into empty database. Blocks after the snapshot stay in block storage
+       * and have to be applied again, their commit does not store them twice.
+       * @param trusted - keys one of which must sign the snapshot, any
+       * intact snapshot is accepted if empty
+       * @return height of the loaded snapshot, nullopt if none was loaded
+       */
+      nonstd::optional<uint32_t> importWsvSnapshot(
+          const std::vector<ed25519::pubkey_t> &trusted);
+
+      /**
+       * @return heights of stored snapshots of world state view in
+       * ascending order
+       */
+      std::vector<uint32_t> wsvSnapshotHeights() const;
+
+      /**
+       * Store blocks following the stored chain without applying them to
+       * world state view, which must be empty. Snapshot at one of them is
+       * imported afterwards, e.g. when blocks are downloaded by peer which
+       * joins late
+       * @param blocks - blocks in order of height
+       * @return true if blocks extend the stored chain and are stored
+       */
+      bool insertBlocks(const std::vector<model::Block> &blocks);
+
+      /**
+       * Wait until caches are warmed up after start, see
+       * BlockStorageOptions::warm_up_blocks
+       */
+      void waitWarmUp();
+
      private:
       StorageImpl(std::string block_store_dir, std::string redis_host,
                   std::size_t redis_port, std::string postgres_options,
-                  std::unique_ptr<FlatFile> block_store,
-                  std::unique_ptr<cpp_redis::redis_client> index,
-                  std::unique_ptr<pqxx::lazyconnection> wsv_connection,
-                  std::unique_ptr<pqxx::nontransaction> wsv_transaction,
-                  std::unique_ptr<WsvQuery> wsv);
+                  std::unique_ptr<BlockStorage> block_store,
+                  const BlockStorageOptions &block_storage_options,
+                  std::unique_ptr<BlockIndex> block_index,
+                  std::unique_ptr<TxHashFilter> tx_filter,
+                  std::unique_ptr<TxColumns> tx_columns,
+                  std::unique_ptr<BlockStorage> wsv_changes,
+                  std::unique_ptr<WsvBackend> wsv);
+
+      /**
+       * Create mutable storage over given world state transaction
+       * @return storage or nullptr if transaction is unavailable
+       */
+      std::unique_ptr<MutableStorage> createMutableStorage(
+          std::unique_ptr<WsvTransaction> wsv_transaction);
+
       // Storage info
       const std::string block_store_dir_;
       const std::string redis_host_;
       const std::size_t redis_port_;
       const std::string postgres_options_;
 
-      std::unique_ptr<FlatFile> block_store_;
-      std::unique_ptr<cpp_redis::redis_client> index_;
+      std::unique_ptr<BlockStorage> block_store_;
+      // absent when queries scan blocks
+      std::unique_ptr<BlockIndex> block_index_;
+      // absent when disabled or its directory is unreadable
+      std::unique_ptr<TxHashFilter> tx_filter_;
+      // absent when disabled or its directory is unreadable
+      std::unique_ptr<TxColumns> tx_columns_;
+      // absent when disabled or its directory is unreadable
+      std::unique_ptr<BlockStorage> wsv_changes_;
 
-      std::unique_ptr<pqxx::lazyconnection> wsv_connection_;
-      std::unique_ptr<pqxx::nontransaction> wsv_transaction_;
-      std::unique_ptr<WsvQuery> wsv_;
+      std::unique_ptr<WsvBackend> wsv_;
 
-      model::converters::JsonBlockFactory serializer_;
+      /**
+       * Temporary wsv kept between proposals, so each of them does not
+       * start a database transaction and warm up the cache again
+       */
+      struct IdleTemporaryWsv {
+        std::mutex lock;
+        // nullptr when taken or not created yet
+        std::unique_ptr<TemporaryWsvImpl> wsv;
+        // top hash of the state its cached reads were loaded from
+        hash256_t top_hash;
+      };
+      // shared with handed out wsv, which may outlive storage
+      std::shared_ptr<IdleTemporaryWsv> idle_temporary_wsv_ =
+          std::make_shared<IdleTemporaryWsv>();
 
-      // Allows multiple readers and a single writer
-      std::shared_timed_mutex rw_lock_;
+      BlockSerializer serializer_;
+      BlockCache block_cache_;
+      MerkleTreeCache merkle_trees_;
+      const bool defer_wsv_writes_;
 
-      logger::Logger log_;
+      /**
+       * Read hash of the last stored block
+       * @return hash, zero for empty ledger, nullopt if block is unreadable
+       */
+      nonstd::optional<hash256_t> loadTopHash();
+
+      /**
+       * Committed state seen by readers. It is immutable once published and
+       * replaced as a whole after commit, so readers never wait for writers.
+       */
+      struct Snapshot {
+        // last committed block, blocks up to it are never modified
+        uint32_t height;
+        // hash of the last committed block, zero for empty ledger
+        hash256_t top_hash;
+        // root of world state view at height, if it is maintained
+        nonstd::optional<StateRoot> state_root;
+        // world state view at height
+        std::unique_ptr<WsvTransaction> transaction;
+        std::unique_ptr<WsvQuery> wsv;
+        // database session serves one query at a time
+        std::mutex lock;
+      };
+
+      /**
+       * @return the latest published snapshot
+       */
+      std::shared_ptr<Snapshot> snapshot() const;
+
+      /**
+       * Snapshot pinned by a thread, pins of one thread form a stack
+       */
+      class Pin : public SnapshotPin {
+       public:
+        Pin(const StorageImpl &storage, std::shared_ptr<Snapshot> snapshot);
+        ~Pin() override;
+
+        const StorageImpl &storage;
+        const std::shared_ptr<Snapshot> snapshot;
+        // pin taken before this one
+        Pin *const previous;
+
+        // innermost pin of calling thread
+        static thread_local Pin *top;
+      };
+
+      /**
+       * @return snapshot pinned by calling thread, or the latest one
+       */
+      std::shared_ptr<Snapshot> readSnapshot() const;
+
+      /**
+       * Publish snapshot of current committed state, previous snapshot is
+       * released when its last reader is done
+       * @return true on success
+       */
+      bool publishSnapshot(const hash256_t &top_hash);
+
+      /**
+       * Read block from cache or block store, caching it
+       * @return block or nullptr if it can not be read
+       */
+      std::shared_ptr<const model::Block> readBlock(uint32_t height);
+
+      /**
+       * Read block from cache or lazily from block store, for reads of
+       * headers, hashes and creators which do not need commands
+       * @return block or nullptr if it can not be read
+       */
+      std::shared_ptr<const LazyBlock> readLazyBlock(uint32_t height);
+
+      /**
+       * @return transactions at given positions, read through the cache
+       */
+      rxcpp::observable<CommittedTransaction> readTransactions(
+          std::vector<TxPosition> positions);
 
-      const std::string init_ =
-          "CREATE TABLE IF NOT EXISTS domain (\n"
-          "    domain_id character varying(164),\n"
-          "    open bool NOT NULL DEFAULT TRUE,\n"
-          "    PRIMARY KEY (domain_id)\n"
-          ");\n"
-          "CREATE TABLE IF NOT EXISTS signatory (\n"
-          "    public_key bytea NOT NULL,\n"
-          "    PRIMARY KEY (public_key)\n"
-          ");\n"
-          "CREATE TABLE IF NOT EXISTS account (\n"
-          "    account_id character varying(197),    \n"
-          "    domain_id character varying(164) NOT NULL REFERENCES domain,\n"
-          "    master_key bytea NOT NULL REFERENCES signatory(public_key),\n"
-          "    quorum int NOT NULL,\n"
-          "    status int NOT NULL DEFAULT 0,    \n"
-          "    transaction_count int NOT NULL DEFAULT 0, \n"
-          "    permissions bit varying NOT NULL,\n"
-          "    PRIMARY KEY (account_id)\n"
-          ");\n"
-          "CREATE TABLE IF NOT EXISTS account_has_signatory (\n"
-          "    account_id character varying(197) NOT NULL REFERENCES account,\n"
-          "    public_key bytea NOT NULL REFERENCES signatory,\n"
-          "    PRIMARY KEY (account_id, public_key)\n"
-          ");\n"
-          "CREATE TABLE IF NOT EXISTS peer (\n"
-          "    public_key bytea NOT NULL,\n"
-          "    address character varying(21) NOT NULL UNIQUE,\n"
-          "    state int NOT NULL DEFAULT 0,\n"
-          "    PRIMARY KEY (public_key)\n"
-          ");\n"
-          "CREATE TABLE IF NOT EXISTS asset (\n"
-          "    asset_id character varying(197),\n"
-          "    domain_id character varying(164) NOT NULL REFERENCES domain,\n"
-          "    precision int NOT NULL,\n"
-          "    data json,\n"
-          "    PRIMARY KEY (asset_id)\n"
-          ");\n"
-          "CREATE TABLE IF NOT EXISTS account_has_asset (\n"
-          "    account_id character varying(197) NOT NULL REFERENCES account,\n"
-          "    asset_id character varying(197) NOT NULL REFERENCES asset,\n"
-          "    amount bigint NOT NULL,\n"
-          "    permissions bit varying NOT NULL,\n"
-          "    PRIMARY KEY (account_id, asset_id)\n"
-          ");\n"
-          "CREATE TABLE IF NOT EXISTS exchange (\n"
-          "    asset1_id character varying(197) NOT NULL REFERENCES "
-          "asset(asset_id),\n"
-          "    asset2_id character varying(197) NOT NULL REFERENCES "
-          "asset(asset_id),\n"
-          "    asset1 bigint NOT NULL,\n"
-          "    asset2 bigint NOT NULL,\n"
-          "    PRIMARY KEY (asset1_id, asset2_id)\n"
-          ");";
+      /**
+       * Read page of transactions matching predicate from blocks up to height
+       */
+      rxcpp::observable<CommittedTransaction> scanTransactions(
+          uint32_t height,
+          const model::TxPagination &pagination,
+          std::function<bool(const model::Transaction &)> predicate);
+
+      /**
+       * Read page of transactions matching predicate from lazily read
+       * blocks up to height, only matching transactions are decoded
+       * @param predicate - called with block and index of transaction
+       */
+      rxcpp::observable<CommittedTransaction> scanLazyTransactions(
+          uint32_t height,
+          const model::TxPagination &pagination,
+          std::function<bool(const LazyBlock &, size_t)> predicate);
+
+      /**
+       * Look up transactions of account in the block index
+       * @param height - last visible block
+       * @return positions up to height, nullopt if index is unavailable or
+       * does not cover the height
+       */
+      nonstd::optional<std::vector<TxPosition>> indexedTransactions(
+          const std::string &account_id, uint32_t height);
+
+      /**
+       * Look up transactions changing account asset in the block index
+       * @param height - last visible block
+       * @return positions up to height, nullopt if index is unavailable or
+       * does not cover the height
+       */
+      nonstd::optional<std::vector<TxPosition>> indexedAssetTransactions(
+          const std::string &account_id,
+          const std::string &asset_id,
+          uint32_t height);
+
+      /**
+       * Look up position of transaction in the block index
+       * @param height - last visible block
+       * @return position, nullopt if index is unavailable or does not cover
+       * the height
+       */
+      nonstd::optional<nonstd::optional<TxPosition>> indexedTransaction(
+          const hash256_t &tx_hash, uint32_t height);
+
+      /**
+       * Insert committed blocks missing from a structure kept next to
+       * blocks, e.g. transaction hash filter
+       * @param added_height - height up to which blocks are inserted
+       * @param step - number of blocks inserted at once
+       * @param add - inserts blocks, false on failure
+       * @return true if structure covers the last committed block
+       */
+      bool synchronize(uint32_t added_height,
+                       uint32_t step,
+                       const std::function<bool(const BlockRefs &)> &add);
+
+      /**
+       * Index blocks missing from block index in background thread,
+       * then let commits index their blocks
+       * @param max_rate - indexed blocks per second, 0 for no limit
+       */
+      void startIndexing(uint32_t max_rate);
+
+      /**
+       * Export world state view of the last commit in background thread,
+       * unless previous export is still running. Called under commit_lock_
+       */
+      void exportWsvSnapshot();
+
+      WsvSnapshotStore wsv_snapshots_;
+      // 0 if snapshots are not exported
+      const uint32_t wsv_snapshot_interval_;
+      const nonstd::optional<ed25519::keypair_t> wsv_snapshot_keypair_;
+      std::thread snapshot_thread_;
+      std::atomic<bool> snapshot_running_{false};
+
+      /**
+       * Remove blocks outside of retention window. Called under commit_lock_
+       */
+      void pruneBlocks();
+
+      /**
+       * Append changes of blocks above stored height to the log of changes.
+       * Called under commit_lock_
+       */
+      void logWsvChanges(const MutableStorageImpl &storage,
+                         uint32_t stored_height);
+
+      // 0 if all blocks are kept
+      const uint32_t block_retention_;
+      const std::string block_archive_path_;
+
+      // workers of parallel range reads, shared by all of them
+      BlockReadPool read_pool_;
+
+      std::unique_ptr<IndexMediator> index_mediator_;
+      std::thread index_thread_;
+      // commits write to the index, guarded by commit_lock_
+      bool index_live_ = false;
+
+      /**
+       * Read the latest blocks into block cache, and accounts and account
+       * assets they touch into idle temporary wsv, in background thread
+       * @param blocks - number of the latest blocks
+       */
+      void startWarmUp(uint32_t blocks);
+
+      std::thread warm_up_thread_;
+
+      /**
+       * Compute root of committed world state view from all its tables
+       * @return root, nullopt if tables can not be read
+       */
+      nonstd::optional<StateRoot> computeStateRoot();
+
+      // root of the last commit, guarded by commit_lock_
+      nonstd::optional<StateRoot> state_root_;
+
+      // accessed with atomic operations only
+      std::shared_ptr<Snapshot> snapshot_;
+
+      // serializes commits
+      std::mutex commit_lock_;
+
+      logger::Logger log_;
     };
   }  // namespace ametsuchi
 }  // namespace iroha
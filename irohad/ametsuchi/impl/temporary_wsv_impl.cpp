@@ -24,28 +24,37 @@ namespace iroha {
                                  std::function<bool(const model::Transaction &,
                                                     WsvCommand &, WsvQuery &)>
                                      function) {
-      transaction_->exec("SAVEPOINT savepoint_;");
-      auto result = function(transaction, *executor_, *this);
+      wsv_->savepoint([this] { transaction_->savepoint(); });
+      auto result = function(transaction, *wsv_, *this);
       if (result) {
-        transaction_->exec("RELEASE SAVEPOINT savepoint_;");
-      } else {
-        transaction_->exec("ROLLBACK TO SAVEPOINT savepoint_;");
+        if (wsv_->releaseSavepoint()) {
+          transaction_->releaseSavepoint();
+        }
+      } else if (wsv_->rollbackToSavepoint()) {
+        transaction_->rollbackToSavepoint();
       }
       return result;
     }
 
     TemporaryWsvImpl::TemporaryWsvImpl(
-        std::unique_ptr<pqxx::lazyconnection> connection,
-        std::unique_ptr<pqxx::nontransaction> transaction,
-        std::unique_ptr<WsvQuery> wsv, std::unique_ptr<WsvCommand> executor)
-        : connection_(std::move(connection)),
-          transaction_(std::move(transaction)),
-          wsv_(std::move(wsv)),
-          executor_(std::move(executor)) {
-      transaction_->exec("BEGIN;");
+        std::unique_ptr<WsvTransaction> transaction, bool defer_asset_writes)
+        : transaction_(std::move(transaction)),
+          wsv_(std::make_unique<CachedWsv>(transaction_->query(),
+                                           transaction_->command(),
+                                           defer_asset_writes)) {}
+
+    // changes are discarded together with the transaction
+    TemporaryWsvImpl::~TemporaryWsvImpl() = default;
+
+    bool TemporaryWsvImpl::reset() {
+      wsv_->discardWrites();
+      return transaction_->reset();
     }
 
-    TemporaryWsvImpl::~TemporaryWsvImpl() { transaction_->exec("ROLLBACK;"); }
+    void TemporaryWsvImpl::refresh() {
+      wsv_->clear();
+      transaction_->refresh();
+    }
 
     nonstd::optional<model::Account> TemporaryWsvImpl::getAccount(
         const std::string &account_id) {
@@ -67,9 +76,107 @@ namespace iroha {
       return wsv_->getAccountAsset(account_id, asset_id);
     }
 
+    nonstd::optional<std::vector<model::AccountAsset>>
+    TemporaryWsvImpl::getAccountAssets(const std::string &account_id,
+                                       const std::string &after_asset_id,
+                                       size_t limit) {
+      return wsv_->getAccountAssets(account_id, after_asset_id, limit);
+    }
+
+    nonstd::optional<std::vector<model::AccountAsset>>
+    TemporaryWsvImpl::getAssetHolders(const std::string &asset_id,
+                                      const std::string &after_account_id,
+                                      size_t limit) {
+      return wsv_->getAssetHolders(asset_id, after_account_id, limit);
+    }
+
+    nonstd::optional<std::vector<model::Account>>
+    TemporaryWsvImpl::getDomainAccounts(const std::string &domain_id,
+                                        const std::string &after_account_id,
+                                        size_t limit) {
+      return wsv_->getDomainAccounts(domain_id, after_account_id, limit);
+    }
+
+    nonstd::optional<std::vector<std::string>>
+    TemporaryWsvImpl::getAccountsBySignatory(
+        const ed25519::pubkey_t &signatory,
+        const std::string &after_account_id,
+        size_t limit) {
+      return wsv_->getAccountsBySignatory(signatory, after_account_id, limit);
+    }
+
     nonstd::optional<std::vector<model::Peer>> TemporaryWsvImpl::getPeers() {
       return wsv_->getPeers();
     }
 
+    PooledTemporaryWsv::PooledTemporaryWsv(
+        std::unique_ptr<TemporaryWsvImpl> wsv, Release release)
+        : wsv_(std::move(wsv)), release_(std::move(release)) {}
+
+    PooledTemporaryWsv::~PooledTemporaryWsv() {
+      release_(std::move(wsv_));
+    }
+
+    bool PooledTemporaryWsv::apply(
+        const model::Transaction &transaction,
+        std::function<bool(const model::Transaction &, WsvCommand &,
+                           WsvQuery &)>
+            function) {
+      return wsv_->apply(transaction, std::move(function));
+    }
+
+    nonstd::optional<model::Account> PooledTemporaryWsv::getAccount(
+        const std::string &account_id) {
+      return wsv_->getAccount(account_id);
+    }
+
+    nonstd::optional<std::vector<ed25519::pubkey_t>>
+    PooledTemporaryWsv::getSignatories(const std::string &account_id) {
+      return wsv_->getSignatories(account_id);
+    }
+
+    nonstd::optional<model::Asset> PooledTemporaryWsv::getAsset(
+        const std::string &asset_id) {
+      return wsv_->getAsset(asset_id);
+    }
+
+    nonstd::optional<model::AccountAsset> PooledTemporaryWsv::getAccountAsset(
+        const std::string &account_id, const std::string &asset_id) {
+      return wsv_->getAccountAsset(account_id, asset_id);
+    }
+
+    nonstd::optional<std::vector<model::AccountAsset>>
+    PooledTemporaryWsv::getAccountAssets(const std::string &account_id,
+                                         const std::string &after_asset_id,
+                                         size_t limit) {
+      return wsv_->getAccountAssets(account_id, after_asset_id, limit);
+    }
+
+    nonstd::optional<std::vector<model::AccountAsset>>
+    PooledTemporaryWsv::getAssetHolders(const std::string &asset_id,
+                                        const std::string &after_account_id,
+                                        size_t limit) {
+      return wsv_->getAssetHolders(asset_id, after_account_id, limit);
+    }
+
+    nonstd::optional<std::vector<model::Account>>
+    PooledTemporaryWsv::getDomainAccounts(const std::string &domain_id,
+                                          const std::string &after_account_id,
+                                          size_t limit) {
+      return wsv_->getDomainAccounts(domain_id, after_account_id, limit);
+    }
+
+    nonstd::optional<std::vector<std::string>>
+    PooledTemporaryWsv::getAccountsBySignatory(
+        const ed25519::pubkey_t &signatory,
+        const std::string &after_account_id,
+        size_t limit) {
+      return wsv_->getAccountsBySignatory(signatory, after_account_id, limit);
+    }
+
+    nonstd::optional<std::vector<model::Peer>> PooledTemporaryWsv::getPeers() {
+      return wsv_->getPeers();
+    }
+
   }  // namespace ametsuchi
 }  // namespace iroha
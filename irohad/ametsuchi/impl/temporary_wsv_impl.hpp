@@ -18,18 +18,16 @@
 #ifndef IROHA_TEMPORARY_WSV_IMPL_HPP
 #define IROHA_TEMPORARY_WSV_IMPL_HPP
 
-#include <pqxx/connection>
-#include <pqxx/nontransaction>
+#include "ametsuchi/impl/cached_wsv.hpp"
+#include "ametsuchi/impl/wsv_backend.hpp"
 #include "ametsuchi/temporary_wsv.hpp"
 
 namespace iroha {
   namespace ametsuchi {
     class TemporaryWsvImpl : public TemporaryWsv {
      public:
-      TemporaryWsvImpl(std::unique_ptr<pqxx::lazyconnection> connection,
-                       std::unique_ptr<pqxx::nontransaction> transaction,
-                       std::unique_ptr<WsvQuery> wsv,
-                       std::unique_ptr<WsvCommand> executor);
+      TemporaryWsvImpl(std::unique_ptr<WsvTransaction> transaction,
+                       bool defer_asset_writes = false);
       bool apply(const model::Transaction &transaction,
                  std::function<bool(const model::Transaction &, WsvCommand &,
                                     WsvQuery &)>
@@ -42,14 +40,87 @@ namespace iroha {
           const std::string &asset_id) override;
       nonstd::optional<model::AccountAsset> getAccountAsset(
           const std::string &account_id, const std::string &asset_id) override;
+      nonstd::optional<std::vector<model::AccountAsset>> getAccountAssets(
+          const std::string &account_id,
+          const std::string &after_asset_id,
+          size_t limit) override;
+      nonstd::optional<std::vector<model::AccountAsset>> getAssetHolders(
+          const std::string &asset_id,
+          const std::string &after_account_id,
+          size_t limit) override;
+      nonstd::optional<std::vector<model::Account>> getDomainAccounts(
+          const std::string &domain_id,
+          const std::string &after_account_id,
+          size_t limit) override;
+      nonstd::optional<std::vector<std::string>> getAccountsBySignatory(
+          const ed25519::pubkey_t &signatory,
+          const std::string &after_account_id,
+          size_t limit) override;
       nonstd::optional<std::vector<model::Peer>> getPeers() override;
       ~TemporaryWsvImpl() override;
 
+      /**
+       * Discard changes, so the wsv can validate next proposal on the same
+       * database transaction. Cached reads of unchanged keys are kept
+       * @return false if database transaction can not be restarted
+       */
+      bool reset();
+
+      /**
+       * Drop cached reads and see state committed since reset
+       */
+      void refresh();
+
+     private:
+      std::unique_ptr<WsvTransaction> transaction_;
+      // serves repeated reads of the round from memory
+      std::unique_ptr<CachedWsv> wsv_;
+    };
+
+    /**
+     * Temporary wsv handed out by storage, passed to release function on
+     * destruction to be reused
+     */
+    class PooledTemporaryWsv : public TemporaryWsv {
+     public:
+      using Release = std::function<void(std::unique_ptr<TemporaryWsvImpl>)>;
+
+      PooledTemporaryWsv(std::unique_ptr<TemporaryWsvImpl> wsv,
+                         Release release);
+      bool apply(const model::Transaction &transaction,
+                 std::function<bool(const model::Transaction &, WsvCommand &,
+                                    WsvQuery &)>
+                     function) override;
+      nonstd::optional<model::Account> getAccount(
+          const std::string &account_id) override;
+      nonstd::optional<std::vector<ed25519::pubkey_t>> getSignatories(
+          const std::string &account_id) override;
+      nonstd::optional<model::Asset> getAsset(
+          const std::string &asset_id) override;
+      nonstd::optional<model::AccountAsset> getAccountAsset(
+          const std::string &account_id, const std::string &asset_id) override;
+      nonstd::optional<std::vector<model::AccountAsset>> getAccountAssets(
+          const std::string &account_id,
+          const std::string &after_asset_id,
+          size_t limit) override;
+      nonstd::optional<std::vector<model::AccountAsset>> getAssetHolders(
+          const std::string &asset_id,
+          const std::string &after_account_id,
+          size_t limit) override;
+      nonstd::optional<std::vector<model::Account>> getDomainAccounts(
+          const std::string &domain_id,
+          const std::string &after_account_id,
+          size_t limit) override;
+      nonstd::optional<std::vector<std::string>> getAccountsBySignatory(
+          const ed25519::pubkey_t &signatory,
+          const std::string &after_account_id,
+          size_t limit) override;
+      nonstd::optional<std::vector<model::Peer>> getPeers() override;
+      ~PooledTemporaryWsv() override;
+
      private:
-      std::unique_ptr<pqxx::lazyconnection> connection_;
-      std::unique_ptr<pqxx::nontransaction> transaction_;
-      std::unique_ptr<WsvQuery> wsv_;
-      std::unique_ptr<WsvCommand> executor_;
+      std::unique_ptr<TemporaryWsvImpl> wsv_;
+      Release release_;
     };
   }  // namespace ametsuchi
 }  // namespace iroha
@@ -0,0 +1,560 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/tx_columns.hpp"
+#include <dirent.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <future>
+#include <limits>
+#include <mutex>
+#include <set>
+#include <thread>
+#include "crypto/crc32c.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    constexpr uint32_t TxColumns::kSegmentBlocks;
+
+    namespace {
+      const std::string kColumnsExtension = ".cols";
+      const char kColumnsMagic[4] = {'I', 'R', 'T', 'C'};
+      // segments of older versions are dropped and rebuilt from blocks
+      const uint32_t kColumnsVersion = 2;
+
+      /**
+       * Header of segment file, followed by serialized segment
+       */
+      struct ColumnsHeader {
+        char magic[4];
+        uint32_t version;
+        uint32_t size;
+        // checksum of serialized segment
+        uint32_t checksum;
+      };
+
+      std::string columns_name(uint32_t first_id) {
+        std::string name(16, '\0');
+        sprintf(&name[0], "%016u", first_id);
+        return name + kColumnsExtension;
+      }
+
+      int is_columns_file(const struct dirent *entry) {
+        auto name = std::string(entry->d_name);
+        return name.size() > kColumnsExtension.size() and
+            name.compare(name.size() - kColumnsExtension.size(),
+                         kColumnsExtension.size(), kColumnsExtension) == 0;
+      }
+
+      uint32_t segment_start(uint32_t height) {
+        return (height - 1) / TxColumns::kSegmentBlocks
+            * TxColumns::kSegmentBlocks
+            + 1;
+      }
+
+      void put(std::vector<uint8_t> &bytes, uint32_t value) {
+        auto pos = bytes.size();
+        bytes.resize(pos + sizeof(value));
+        std::memcpy(bytes.data() + pos, &value, sizeof(value));
+      }
+
+      template <typename T>
+      void put(std::vector<uint8_t> &bytes, const std::vector<T> &column) {
+        put(bytes, column.size());
+        auto pos = bytes.size();
+        bytes.resize(pos + column.size() * sizeof(T));
+        if (not column.empty()) {
+          std::memcpy(
+              bytes.data() + pos, column.data(), column.size() * sizeof(T));
+        }
+      }
+
+      /**
+       * Reads values written by put, fails on truncated input
+       */
+      class Reader {
+       public:
+        explicit Reader(const std::vector<uint8_t> &bytes) : bytes_(bytes) {}
+
+        bool get(uint32_t &value) {
+          if (bytes_.size() - pos_ < sizeof(value)) {
+            return false;
+          }
+          std::memcpy(&value, bytes_.data() + pos_, sizeof(value));
+          pos_ += sizeof(value);
+          return true;
+        }
+
+        template <typename T>
+        bool get(std::vector<T> &column) {
+          uint32_t size;
+          if (not get(size) or (bytes_.size() - pos_) / sizeof(T) < size) {
+            return false;
+          }
+          column.resize(size);
+          if (size != 0) {
+            std::memcpy(column.data(), bytes_.data() + pos_, size * sizeof(T));
+          }
+          pos_ += size * sizeof(T);
+          return true;
+        }
+
+        bool get(std::string &value) {
+          uint32_t size;
+          if (not get(size) or bytes_.size() - pos_ < size) {
+            return false;
+          }
+          value.assign(
+              reinterpret_cast<const char *>(bytes_.data()) + pos_, size);
+          pos_ += size;
+          return true;
+        }
+
+        bool done() const {
+          return pos_ == bytes_.size();
+        }
+
+       private:
+        const std::vector<uint8_t> &bytes_;
+        size_t pos_ = 0;
+      };
+
+      /**
+       * Append rows below given count which match, in order. Predicate
+       * reads plain arrays, so the loop is easy to vectorize
+       */
+      template <typename Match>
+      void scan(size_t rows, Match match, std::vector<size_t> &result) {
+        for (size_t i = 0; i < rows; ++i) {
+          if (match(i)) {
+            result.push_back(i);
+          }
+        }
+      }
+    }  // namespace
+
+    uint32_t TxColumns::Segment::code(const std::string &name) {
+      auto inserted = codes.emplace(name, names.size());
+      if (inserted.second) {
+        names.push_back(name);
+      }
+      return inserted.first->second;
+    }
+
+    nonstd::optional<uint32_t> TxColumns::Segment::find(
+        const std::string &name) const {
+      auto it = codes.find(name);
+      if (it == codes.end()) {
+        return nonstd::nullopt;
+      }
+      return it->second;
+    }
+
+    void TxColumns::Segment::append(const model::Block &block) {
+      if (change_offsets.empty()) {
+        change_offsets.push_back(0);
+      }
+      for (size_t i = 0; i < block.transactions.size(); ++i) {
+        const auto &tx = block.transactions[i];
+        heights.push_back(block.height);
+        indices.push_back(i);
+        creators.push_back(code(tx.creator_account_id));
+        for (const auto &change : changedAccountAssets(tx)) {
+          change_accounts.push_back(code(change.first));
+          change_assets.push_back(code(change.second));
+        }
+        change_offsets.push_back(change_accounts.size());
+        for (const auto &transfer : ametsuchi::assetTransfers(tx)) {
+          transfer_rows.push_back(heights.size() - 1);
+          transfer_assets.push_back(code(transfer.first));
+          transfer_ints.push_back(transfer.second.int_part);
+          transfer_fracs.push_back(transfer.second.frac_part);
+        }
+      }
+      last_height = block.height;
+    }
+
+    void TxColumns::Segment::transfers(
+        uint32_t asset,
+        uint32_t from,
+        uint32_t to,
+        const Amount &min_amount,
+        std::vector<TxPosition> &positions) const {
+      // rows and transfers within blocks are found by binary search
+      auto first_row =
+          std::lower_bound(heights.begin(), heights.end(), from)
+          - heights.begin();
+      auto last_row = std::upper_bound(heights.begin(), heights.end(), to)
+          - heights.begin();
+      auto begin = std::lower_bound(
+                       transfer_rows.begin(), transfer_rows.end(), first_row)
+          - transfer_rows.begin();
+      auto end = std::lower_bound(
+                     transfer_rows.begin(), transfer_rows.end(), last_row)
+          - transfer_rows.begin();
+
+      std::vector<size_t> matches;
+      const auto assets = transfer_assets.data() + begin;
+      const auto ints = transfer_ints.data() + begin;
+      const auto fracs = transfer_fracs.data() + begin;
+      // bitwise operators evaluate whole predicate without branches
+      scan(end - begin,
+           [assets, ints, fracs, asset, min_amount](size_t i) {
+             return (assets[i] == asset)
+                 & ((ints[i] > min_amount.int_part)
+                    | ((ints[i] == min_amount.int_part)
+                       & (fracs[i] >= min_amount.frac_part)));
+           },
+           matches);
+      // transaction with several matching transfers is reported once
+      auto last = std::numeric_limits<uint32_t>::max();
+      for (auto match : matches) {
+        auto row = transfer_rows[begin + match];
+        if (row != last) {
+          positions.push_back({heights[row], indices[row]});
+          last = row;
+        }
+      }
+    }
+
+    std::vector<uint8_t> TxColumns::Segment::serialize() const {
+      std::vector<uint8_t> bytes;
+      put(bytes, last_height);
+      put(bytes, names.size());
+      for (const auto &name : names) {
+        put(bytes, name.size());
+        bytes.insert(bytes.end(), name.begin(), name.end());
+      }
+      put(bytes, heights);
+      put(bytes, indices);
+      put(bytes, creators);
+      put(bytes, change_offsets);
+      put(bytes, change_accounts);
+      put(bytes, change_assets);
+      put(bytes, transfer_rows);
+      put(bytes, transfer_assets);
+      put(bytes, transfer_ints);
+      put(bytes, transfer_fracs);
+      return bytes;
+    }
+
+    bool TxColumns::Segment::deserialize(const std::vector<uint8_t> &bytes) {
+      Reader reader(bytes);
+      uint32_t names_size;
+      if (not reader.get(last_height) or not reader.get(names_size)) {
+        return false;
+      }
+      for (uint32_t i = 0; i < names_size; ++i) {
+        std::string name;
+        if (not reader.get(name) or code(name) != i) {
+          return false;
+        }
+      }
+      if (not(reader.get(heights) and reader.get(indices)
+              and reader.get(creators) and reader.get(change_offsets)
+              and reader.get(change_accounts) and reader.get(change_assets)
+              and reader.get(transfer_rows) and reader.get(transfer_assets)
+              and reader.get(transfer_ints) and reader.get(transfer_fracs)
+              and reader.done())) {
+        return false;
+      }
+      // scans index columns by each other without further checks
+      auto rows = heights.size();
+      auto is_code = [names_size](uint32_t code) { return code < names_size; };
+      return indices.size() == rows and creators.size() == rows
+          and change_offsets.size() == rows + 1 and change_offsets.front() == 0
+          and std::is_sorted(change_offsets.begin(), change_offsets.end())
+          and change_offsets.back() == change_accounts.size()
+          and change_assets.size() == change_accounts.size()
+          and std::all_of(creators.begin(), creators.end(), is_code)
+          and std::all_of(
+                  change_accounts.begin(), change_accounts.end(), is_code)
+          and std::all_of(change_assets.begin(), change_assets.end(), is_code)
+          and transfer_assets.size() == transfer_rows.size()
+          and transfer_ints.size() == transfer_rows.size()
+          and transfer_fracs.size() == transfer_rows.size()
+          and std::is_sorted(transfer_rows.begin(), transfer_rows.end())
+          and (transfer_rows.empty() or transfer_rows.back() < rows)
+          and std::all_of(
+                  transfer_assets.begin(), transfer_assets.end(), is_code);
+    }
+
+    TxColumns::TxColumns(const std::string &path)
+        : path_(path), log_(logger::log("TxColumns")) {}
+
+    std::unique_ptr<TxColumns> TxColumns::create(const std::string &path) {
+      std::unique_ptr<TxColumns> columns(new TxColumns(path));
+
+      struct dirent **namelist;
+      auto status =
+          scandir(path.c_str(), &namelist, is_columns_file, alphasort);
+      if (status < 0) {
+        columns->log_->error("Cannot read directory {}", path);
+        return nullptr;
+      }
+      for (auto i = 0; i < status; ++i) {
+        auto first_id = std::stoul(namelist[i]->d_name);
+        free(namelist[i]);
+        // missing segment is rebuilt from blocks together with later ones
+        if (not columns->load(first_id)) {
+          columns->log_->warn("Columns of blocks from {} are dropped",
+                              first_id);
+        }
+      }
+      free(namelist);
+      return columns;
+    }
+
+    bool TxColumns::load(uint32_t first_id) {
+      if (first_id == 0 or segment_start(first_id) != first_id) {
+        return false;
+      }
+      FILE *pfile =
+          fopen((path_ + "/" + columns_name(first_id)).c_str(), "rb");
+      if (not pfile) {
+        return false;
+      }
+      ColumnsHeader header;
+      std::vector<uint8_t> bytes;
+      auto read = fread(&header, sizeof(header), 1, pfile) == 1
+          and fseek(pfile, 0, SEEK_END) == 0
+          and ftell(pfile) == static_cast<long>(sizeof(header) + header.size)
+          and fseek(pfile, sizeof(header), SEEK_SET) == 0;
+      if (read) {
+        bytes.resize(header.size);
+        read = fread(bytes.data(), 1, bytes.size(), pfile) == bytes.size();
+      }
+      fclose(pfile);
+      Segment segment;
+      if (not read
+          or std::memcmp(header.magic, kColumnsMagic, sizeof(kColumnsMagic))
+              != 0
+          or header.version != kColumnsVersion
+          or header.checksum != crc32c(bytes.data(), bytes.size())
+          or not segment.deserialize(bytes)
+          or segment.last_height < first_id
+          or segment.last_height >= first_id + kSegmentBlocks) {
+        return false;
+      }
+      segments_.emplace(first_id, std::move(segment));
+      return true;
+    }
+
+    bool TxColumns::store(uint32_t first_id, const Segment &segment) const {
+      auto bytes = segment.serialize();
+      ColumnsHeader header;
+      std::memcpy(header.magic, kColumnsMagic, sizeof(kColumnsMagic));
+      header.version = kColumnsVersion;
+      header.size = bytes.size();
+      header.checksum = crc32c(bytes.data(), bytes.size());
+
+      // rename is atomic, so segment is either old or new one
+      auto name = path_ + "/" + columns_name(first_id);
+      auto tmp_name = name + ".tmp";
+      FILE *pfile = fopen(tmp_name.c_str(), "wb");
+      if (not pfile) {
+        return false;
+      }
+      auto written = fwrite(&header, sizeof(header), 1, pfile) == 1
+          and fwrite(bytes.data(), 1, bytes.size(), pfile) == bytes.size();
+      written = fclose(pfile) == 0 and written;
+      return written and std::rename(tmp_name.c_str(), name.c_str()) == 0;
+    }
+
+    uint32_t TxColumns::height() const {
+      std::shared_lock<std::shared_timed_mutex> lock(rw_lock_);
+      uint32_t height = 0;
+      for (const auto &segment : segments_) {
+        // blocks of a segment are appended in order
+        if (segment.first != height + 1) {
+          break;
+        }
+        height = segment.second.last_height;
+        if (height != segment.first + kSegmentBlocks - 1) {
+          break;
+        }
+      }
+      return height;
+    }
+
+    bool TxColumns::add(const BlockRefs &blocks) {
+      std::unique_lock<std::shared_timed_mutex> lock(rw_lock_);
+      std::set<uint32_t> changed;
+      for (const auto &ref : blocks) {
+        const model::Block &block = ref;
+        if (block.height == 0) {
+          continue;
+        }
+        auto first_id = segment_start(block.height);
+        auto inserted = segments_.emplace(first_id, Segment());
+        auto &segment = inserted.first->second;
+        if (inserted.second) {
+          segment.last_height = first_id - 1;
+        }
+        if (block.height <= segment.last_height) {
+          continue;
+        }
+        // rows stay in chain order, the gap is filled on restart
+        if (block.height != segment.last_height + 1) {
+          log_->warn("Block {} does not follow columns", block.height);
+          continue;
+        }
+        segment.append(block);
+        changed.insert(first_id);
+      }
+      bool stored = true;
+      for (auto first_id : changed) {
+        if (not store(first_id, segments_.at(first_id))) {
+          log_->error("Cannot write columns of blocks from {}", first_id);
+          stored = false;
+        }
+      }
+      return stored;
+    }
+
+    std::vector<TxPosition> TxColumns::accountTransactions(
+        const std::string &account_id, uint32_t height) const {
+      std::shared_lock<std::shared_timed_mutex> lock(rw_lock_);
+      std::vector<TxPosition> positions;
+      std::vector<size_t> rows;
+      for (const auto &entry : segments_) {
+        const auto &segment = entry.second;
+        if (entry.first > height) {
+          break;
+        }
+        auto code = segment.find(account_id);
+        if (not code) {
+          continue;
+        }
+        rows.clear();
+        const auto creators = segment.creators.data();
+        scan(segment.creators.size(),
+             [creators, creator = *code](size_t i) {
+               return creators[i] == creator;
+             },
+             rows);
+        for (auto row : rows) {
+          if (segment.heights[row] > height) {
+            break;
+          }
+          positions.push_back({segment.heights[row], segment.indices[row]});
+        }
+      }
+      return positions;
+    }
+
+    std::vector<TxPosition> TxColumns::accountAssetTransactions(
+        const std::string &account_id,
+        const std::string &asset_id,
+        uint32_t height) const {
+      std::shared_lock<std::shared_timed_mutex> lock(rw_lock_);
+      std::vector<TxPosition> positions;
+      std::vector<size_t> changes;
+      for (const auto &entry : segments_) {
+        const auto &segment = entry.second;
+        if (entry.first > height) {
+          break;
+        }
+        auto account = segment.find(account_id);
+        auto asset = segment.find(asset_id);
+        if (not account or not asset) {
+          continue;
+        }
+        changes.clear();
+        const auto accounts = segment.change_accounts.data();
+        const auto assets = segment.change_assets.data();
+        scan(segment.change_accounts.size(),
+             [accounts, assets, account = *account, asset = *asset](
+                 size_t i) {
+               return accounts[i] == account and assets[i] == asset;
+             },
+             changes);
+        // each transaction changes an account asset at most once, so
+        // matching changes map to distinct rows in order
+        const auto &offsets = segment.change_offsets;
+        auto row = offsets.begin();
+        for (auto change : changes) {
+          row = std::upper_bound(row, offsets.end(), change);
+          auto index = row - offsets.begin() - 1;
+          if (segment.heights[index] > height) {
+            break;
+          }
+          positions.push_back(
+              {segment.heights[index], segment.indices[index]});
+        }
+      }
+      return positions;
+    }
+
+    std::vector<TxPosition> TxColumns::assetTransfers(
+        const std::string &asset_id,
+        uint32_t from,
+        uint32_t to,
+        const Amount &min_amount) const {
+      std::shared_lock<std::shared_timed_mutex> lock(rw_lock_);
+      // segments within blocks where the asset occurs
+      std::vector<std::pair<const Segment *, uint32_t>> selected;
+      for (const auto &entry : segments_) {
+        const auto &segment = entry.second;
+        if (entry.first > to) {
+          break;
+        }
+        if (segment.last_height < from) {
+          continue;
+        }
+        if (auto asset = segment.find(asset_id)) {
+          selected.emplace_back(&segment, *asset);
+        }
+      }
+
+      // each worker scans consecutive segments, so results are
+      // concatenated in chain order
+      size_t workers = std::max(1u, std::thread::hardware_concurrency());
+      workers = std::min(workers, selected.size());
+      if (workers == 0) {
+        return {};
+      }
+      auto chunk = (selected.size() + workers - 1) / workers;
+      auto scan_chunk = [&selected, from, to, &min_amount](size_t begin,
+                                                           size_t end) {
+        std::vector<TxPosition> positions;
+        for (auto i = begin; i < end; ++i) {
+          selected[i].first->transfers(
+              selected[i].second, from, to, min_amount, positions);
+        }
+        return positions;
+      };
+      std::vector<std::future<std::vector<TxPosition>>> results;
+      for (auto begin = chunk; begin < selected.size(); begin += chunk) {
+        results.push_back(std::async(std::launch::async,
+                                     scan_chunk,
+                                     begin,
+                                     std::min(begin + chunk, selected.size())));
+      }
+      // the first chunk is scanned by the calling thread
+      auto positions = scan_chunk(0, std::min(chunk, selected.size()));
+      for (auto &result : results) {
+        auto part = result.get();
+        positions.insert(positions.end(), part.begin(), part.end());
+      }
+      return positions;
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
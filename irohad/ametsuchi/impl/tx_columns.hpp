@@ -0,0 +1,177 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_TX_COLUMNS_HPP
+#define IROHA_TX_COLUMNS_HPP
+
+#include <map>
+#include <memory>
+#include <nonstd/optional.hpp>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ametsuchi/impl/block_index.hpp"
+#include "logger/logger.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Columns of committed transactions serving history queries when
+     * there is no block index: creator account, changed account assets
+     * and asset transfers of every transaction, per segment of
+     * consecutive blocks. Ids are
+     * coded by dictionary of the segment, so a scan compares integers of
+     * contiguous arrays, skips segments where the id never occurs, and
+     * reads only blocks of matching transactions. Segment starting from
+     * block <id> is stored as <id>.cols next to block storage and
+     * rewritten on each commit touching it.
+     */
+    class TxColumns {
+     public:
+      /**
+       * Number of blocks covered by one segment
+       */
+      static constexpr uint32_t kSegmentBlocks = 1024;
+
+      /**
+       * Load segments from directory, unreadable ones are dropped
+       * @param path - existing directory, e.g. of block storage
+       * @return columns or nullptr if directory can not be read
+       */
+      static std::unique_ptr<TxColumns> create(const std::string &path);
+
+      /**
+       * @return height up to which all blocks are in columns
+       */
+      uint32_t height() const;
+
+      /**
+       * Append transactions of blocks and store changed segments. Blocks
+       * already in columns are skipped, blocks not following the last one
+       * of their segment are dropped
+       * @return true if segments were written
+       */
+      bool add(const BlockRefs &blocks);
+
+      /**
+       * @param height - last visible block
+       * @return positions of transactions created by the account up to
+       * height, in chain order
+       */
+      std::vector<TxPosition> accountTransactions(
+          const std::string &account_id, uint32_t height) const;
+
+      /**
+       * @param height - last visible block
+       * @return positions of transactions changing the account asset up to
+       * height, in chain order
+       */
+      std::vector<TxPosition> accountAssetTransactions(
+          const std::string &account_id,
+          const std::string &asset_id,
+          uint32_t height) const;
+
+      /**
+       * Segments are scanned by several threads
+       * @param from - first block
+       * @param to - last block, not above height()
+       * @param min_amount - transfers of smaller amount are skipped
+       * @return positions of transactions transferring the asset within
+       * blocks [from, to], in chain order
+       */
+      std::vector<TxPosition> assetTransfers(const std::string &asset_id,
+                                             uint32_t from,
+                                             uint32_t to,
+                                             const Amount &min_amount) const;
+
+     private:
+      struct Segment {
+        // highest block appended to the segment
+        uint32_t last_height;
+
+        // account and asset ids by their codes
+        std::vector<std::string> names;
+        std::unordered_map<std::string, uint32_t> codes;
+
+        // one row per transaction, in chain order
+        std::vector<uint32_t> heights;
+        std::vector<uint32_t> indices;
+        std::vector<uint32_t> creators;
+
+        // changes of row i are [change_offsets[i], change_offsets[i + 1])
+        std::vector<uint32_t> change_offsets;
+        std::vector<uint32_t> change_accounts;
+        std::vector<uint32_t> change_assets;
+
+        // transfers by row, in order of rows
+        std::vector<uint32_t> transfer_rows;
+        std::vector<uint32_t> transfer_assets;
+        std::vector<uint64_t> transfer_ints;
+        std::vector<uint64_t> transfer_fracs;
+
+        /**
+         * @return code of id, which is added to dictionary if missing
+         */
+        uint32_t code(const std::string &name);
+
+        /**
+         * @return code of id, nullopt if it does not occur in segment
+         */
+        nonstd::optional<uint32_t> find(const std::string &name) const;
+
+        void append(const model::Block &block);
+
+        /**
+         * Append positions of matching transfers within blocks [from, to]
+         */
+        void transfers(uint32_t asset,
+                       uint32_t from,
+                       uint32_t to,
+                       const Amount &min_amount,
+                       std::vector<TxPosition> &positions) const;
+
+        std::vector<uint8_t> serialize() const;
+        bool deserialize(const std::vector<uint8_t> &bytes);
+      };
+
+      explicit TxColumns(const std::string &path);
+
+      /**
+       * Read file of segment starting from given block
+       */
+      bool load(uint32_t first_id);
+
+      /**
+       * Replace file of segment starting from given block
+       */
+      bool store(uint32_t first_id, const Segment &segment) const;
+
+      const std::string path_;
+      // by the first block of segment
+      std::map<uint32_t, Segment> segments_;
+
+      // readers scan columns during commit of next blocks
+      mutable std::shared_timed_mutex rw_lock_;
+
+      logger::Logger log_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+#endif  // IROHA_TX_COLUMNS_HPP
@@ -0,0 +1,201 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/tx_hash_filter.hpp"
+#include <dirent.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include "crypto/crc32c.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    namespace {
+      const std::string kFilterExtension = ".bloom";
+      const char kFilterMagic[4] = {'I', 'R', 'B', 'F'};
+      const uint32_t kFilterVersion = 1;
+
+      /**
+       * Header of filter file, followed by serialized filter
+       */
+      struct FilterHeader {
+        char magic[4];
+        uint32_t version;
+        uint32_t last_height;
+        // checksum of serialized filter
+        uint32_t checksum;
+      };
+
+      std::string filter_name(uint32_t first_id) {
+        std::string name(16, '\0');
+        sprintf(&name[0], "%016u", first_id);
+        return name + kFilterExtension;
+      }
+
+      int is_filter_file(const struct dirent *entry) {
+        auto name = std::string(entry->d_name);
+        return name.size() > kFilterExtension.size() and
+            name.compare(name.size() - kFilterExtension.size(),
+                         kFilterExtension.size(), kFilterExtension) == 0;
+      }
+
+      uint32_t segment_start(uint32_t height) {
+        return (height - 1) / TxHashFilter::kSegmentBlocks
+            * TxHashFilter::kSegmentBlocks
+            + 1;
+      }
+    }  // namespace
+
+    TxHashFilter::TxHashFilter(const std::string &path)
+        : path_(path), log_(logger::log("TxHashFilter")) {}
+
+    std::unique_ptr<TxHashFilter> TxHashFilter::create(
+        const std::string &path) {
+      std::unique_ptr<TxHashFilter> filter(new TxHashFilter(path));
+
+      struct dirent **namelist;
+      auto status = scandir(path.c_str(), &namelist, is_filter_file, alphasort);
+      if (status < 0) {
+        filter->log_->error("Cannot read directory {}", path);
+        return nullptr;
+      }
+      for (auto i = 0; i < status; ++i) {
+        auto first_id = std::stoul(namelist[i]->d_name);
+        free(namelist[i]);
+        // missing filter is rebuilt from blocks together with later ones
+        if (not filter->load(first_id)) {
+          filter->log_->warn("Filter of blocks from {} is dropped", first_id);
+        }
+      }
+      free(namelist);
+      return filter;
+    }
+
+    bool TxHashFilter::load(uint32_t first_id) {
+      if (first_id == 0 or segment_start(first_id) != first_id) {
+        return false;
+      }
+      FILE *pfile = fopen((path_ + "/" + filter_name(first_id)).c_str(), "rb");
+      if (not pfile) {
+        return false;
+      }
+      FilterHeader header;
+      std::vector<uint8_t> bytes;
+      auto read = fread(&header, sizeof(header), 1, pfile) == 1;
+      if (read) {
+        bytes.resize(BloomFilter(kSegmentBits, kProbes).serialize().size());
+        read = fread(bytes.data(), 1, bytes.size(), pfile) == bytes.size();
+      }
+      fclose(pfile);
+      if (not read
+          or std::memcmp(header.magic, kFilterMagic, sizeof(kFilterMagic)) != 0
+          or header.version != kFilterVersion
+          or header.checksum != crc32c(bytes.data(), bytes.size())
+          or header.last_height < first_id
+          or header.last_height >= first_id + kSegmentBlocks) {
+        return false;
+      }
+      auto bloom = BloomFilter::deserialize(bytes.data(), bytes.size());
+      if (not bloom) {
+        return false;
+      }
+      segments_.emplace(first_id, Segment{header.last_height, *bloom});
+      return true;
+    }
+
+    bool TxHashFilter::store(uint32_t first_id, const Segment &segment) const {
+      auto bytes = segment.filter.serialize();
+      FilterHeader header;
+      std::memcpy(header.magic, kFilterMagic, sizeof(kFilterMagic));
+      header.version = kFilterVersion;
+      header.last_height = segment.last_height;
+      header.checksum = crc32c(bytes.data(), bytes.size());
+
+      // rename is atomic, so filter is either old or new one
+      auto name = path_ + "/" + filter_name(first_id);
+      auto tmp_name = name + ".tmp";
+      FILE *pfile = fopen(tmp_name.c_str(), "wb");
+      if (not pfile) {
+        return false;
+      }
+      auto written = fwrite(&header, sizeof(header), 1, pfile) == 1
+          and fwrite(bytes.data(), 1, bytes.size(), pfile) == bytes.size();
+      written = fclose(pfile) == 0 and written;
+      return written and std::rename(tmp_name.c_str(), name.c_str()) == 0;
+    }
+
+    uint32_t TxHashFilter::height() const {
+      std::shared_lock<std::shared_timed_mutex> lock(rw_lock_);
+      uint32_t height = 0;
+      for (const auto &segment : segments_) {
+        // blocks of a segment are inserted in order
+        if (segment.first != height + 1) {
+          break;
+        }
+        height = segment.second.last_height;
+        if (height != segment.first + kSegmentBlocks - 1) {
+          break;
+        }
+      }
+      return height;
+    }
+
+    bool TxHashFilter::add(const BlockRefs &blocks) {
+      std::unique_lock<std::shared_timed_mutex> lock(rw_lock_);
+      std::set<uint32_t> changed;
+      for (const auto &ref : blocks) {
+        const model::Block &block = ref;
+        if (block.height == 0) {
+          continue;
+        }
+        auto first_id = segment_start(block.height);
+        auto segment =
+            segments_
+                .emplace(first_id,
+                         Segment{0, BloomFilter(kSegmentBits, kProbes)})
+                .first;
+        for (const auto &tx : block.transactions) {
+          segment->second.filter.insert(hash_provider_.get_hash(tx));
+        }
+        segment->second.last_height =
+            std::max<uint32_t>(segment->second.last_height, block.height);
+        changed.insert(first_id);
+      }
+      bool stored = true;
+      for (auto first_id : changed) {
+        if (not store(first_id, segments_.at(first_id))) {
+          log_->error("Cannot write filter of blocks from {}", first_id);
+          stored = false;
+        }
+      }
+      return stored;
+    }
+
+    bool TxHashFilter::mayContain(const hash256_t &tx_hash) const {
+      std::shared_lock<std::shared_timed_mutex> lock(rw_lock_);
+      for (const auto &segment : segments_) {
+        if (segment.second.filter.mayContain(tx_hash)) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,116 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_TX_HASH_FILTER_HPP
+#define IROHA_TX_HASH_FILTER_HPP
+
+#include <map>
+#include <memory>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include "ametsuchi/impl/block_index.hpp"
+#include "ametsuchi/impl/bloom_filter.hpp"
+#include "logger/logger.hpp"
+#include "model/model_hash_provider_impl.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Bloom filters of committed transaction hashes, one per segment of
+     * consecutive blocks. Segment of blocks starting from <id> is stored
+     * as <id>.bloom next to block storage and rewritten on each commit
+     * touching it, so a definite negative answer costs no block or index
+     * read. Filters only gain bits, so lost writes make them miss blocks,
+     * which are added again on start, but never give false negatives.
+     */
+    class TxHashFilter {
+     public:
+      /**
+       * Number of blocks covered by one filter
+       */
+      static constexpr uint32_t kSegmentBlocks = 1024;
+
+      /**
+       * Size of one filter, 128 KiB. Keeps false positive rate about 1%
+       * for 100 transactions per block
+       */
+      static constexpr size_t kSegmentBits = 1u << 20;
+
+      /**
+       * Bits set per hash
+       */
+      static constexpr uint32_t kProbes = 7;
+
+      /**
+       * Load filters from directory, unreadable ones are dropped
+       * @param path - existing directory, e.g. of block storage
+       * @return filter set or nullptr if directory can not be read
+       */
+      static std::unique_ptr<TxHashFilter> create(const std::string &path);
+
+      /**
+       * @return height up to which all blocks are in filters
+       */
+      uint32_t height() const;
+
+      /**
+       * Insert transaction hashes of blocks and store changed filters
+       * @return true if filters were written
+       */
+      bool add(const BlockRefs &blocks);
+
+      /**
+       * @return false if transaction is not in any block up to height(),
+       * true if it might be
+       */
+      bool mayContain(const hash256_t &tx_hash) const;
+
+     private:
+      struct Segment {
+        // highest block inserted into the filter
+        uint32_t last_height;
+        BloomFilter filter;
+      };
+
+      explicit TxHashFilter(const std::string &path);
+
+      /**
+       * Read filter file of segment starting from given block
+       */
+      bool load(uint32_t first_id);
+
+      /**
+       * Replace filter file of segment starting from given block
+       */
+      bool store(uint32_t first_id, const Segment &segment) const;
+
+      const std::string path_;
+      // by the first block of segment
+      std::map<uint32_t, Segment> segments_;
+      model::HashProviderImpl hash_provider_;
+
+      // readers check filters during commit of next blocks
+      mutable std::shared_timed_mutex rw_lock_;
+
+      logger::Logger log_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+#endif  // IROHA_TX_HASH_FILTER_HPP
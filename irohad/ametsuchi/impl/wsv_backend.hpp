@@ -0,0 +1,122 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_WSV_BACKEND_HPP
+#define IROHA_WSV_BACKEND_HPP
+
+#include <memory>
+#include "ametsuchi/wsv_command.hpp"
+#include "ametsuchi/wsv_query.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    struct BulkTables;
+
+    /**
+     * Database transaction backing temporary wsv or mutable storage.
+     * Changes which are not committed are discarded on destruction.
+     */
+    class WsvTransaction {
+     public:
+      virtual ~WsvTransaction() = default;
+
+      /**
+       * @return query reading state of this transaction
+       */
+      virtual std::unique_ptr<WsvQuery> query() = 0;
+
+      /**
+       * @return command writing into this transaction
+       */
+      virtual std::unique_ptr<WsvCommand> command() = 0;
+
+      /**
+       * Record height of the last block applied by this transaction, so
+       * replicas of the database can tell how far behind they are
+       */
+      virtual void setHeight(uint32_t height) {}
+
+      /**
+       * Read all rows of world state view seen by this transaction,
+       * e.g. to export a snapshot of the state
+       * @param tables - filled with the rows
+       * @return true on success, false if the backend can not export state
+       */
+      virtual bool dump(BulkTables &tables) { return false; }
+
+      /**
+       * Discard changes and start new transaction over current state, so
+       * the same connection serves the next user
+       * @return true on success, false if backend can not restart
+       * transaction, it has to be destroyed then
+       */
+      virtual bool reset() { return false; }
+
+      /**
+       * Make state committed since the transaction was started or reset
+       * visible, called only when there are no changes. Transactions which
+       * read the latest committed state anyway need nothing
+       */
+      virtual void refresh() {}
+
+      virtual void savepoint() = 0;
+      virtual void releaseSavepoint() = 0;
+      virtual void rollbackToSavepoint() = 0;
+
+      /**
+       * Make changes of the transaction visible and durable
+       * @return true on success
+       */
+      virtual bool commit() = 0;
+    };
+
+    /**
+     * Database which keeps world state view
+     */
+    class WsvBackend {
+     public:
+      virtual ~WsvBackend() = default;
+
+      /**
+       * Start transaction over current state
+       * @return transaction or nullptr if database is unavailable
+       */
+      virtual std::unique_ptr<WsvTransaction> begin() = 0;
+
+      /**
+       * Start transaction which loads trusted data into empty state.
+       * Backends may skip checks of references and savepoints, failed
+       * commands abort the whole load.
+       * @return transaction or nullptr if database is unavailable
+       */
+      virtual std::unique_ptr<WsvTransaction> beginBulk() { return begin(); }
+
+      /**
+       * Start transaction which keeps reading the state committed at the
+       * moment of the call, regardless of later commits. It is only queried
+       * and never committed.
+       * By default it is a regular transaction, which is enough for
+       * backends whose transactions read from one snapshot.
+       * @return transaction or nullptr if database is unavailable
+       */
+      virtual std::unique_ptr<WsvTransaction> snapshot() { return begin(); }
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+#endif  // IROHA_WSV_BACKEND_HPP
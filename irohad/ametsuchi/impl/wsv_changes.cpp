@@ -0,0 +1,156 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/wsv_changes.hpp"
+#include "model/converters/pb_query_response_factory.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    protocol::WsvChanges WsvChanges::serialize(uint32_t height) const {
+      model::converters::PbQueryResponseFactory factory;
+      protocol::WsvChanges pb_changes;
+      pb_changes.set_height(height);
+      for (const auto &account : new_accounts) {
+        *pb_changes.add_new_accounts() =
+            factory.serializeAccount(account.second);
+      }
+      for (const auto &account : updated_accounts) {
+        *pb_changes.add_updated_accounts() =
+            factory.serializeAccount(account.second);
+      }
+      for (const auto &asset : account_assets) {
+        *pb_changes.add_account_assets() =
+            factory.serializeAccountAsset(asset.second);
+      }
+      for (const auto &signatory : signatories) {
+        auto pb_signatory = pb_changes.add_signatories();
+        pb_signatory->set_account_id(signatory.account_id);
+        pb_signatory->set_pubkey(signatory.pubkey.data(),
+                                 signatory.pubkey.size());
+        pb_signatory->set_removed(signatory.removed);
+      }
+      for (const auto &asset : assets) {
+        auto pb_asset = pb_changes.add_assets();
+        pb_asset->set_asset_id(asset.asset_id);
+        pb_asset->set_domain_id(asset.domain_id);
+        pb_asset->set_precision(asset.precision);
+      }
+      for (const auto &domain : domains) {
+        pb_changes.add_domains(domain);
+      }
+      return pb_changes;
+    }
+
+    WsvChangesCommand::WsvChangesCommand(WsvCommand &command,
+                                         WsvChanges &changes)
+        : command_(command), changes_(changes) {}
+
+    bool WsvChangesCommand::insertAccount(const model::Account &account) {
+      if (not command_.insertAccount(account)) {
+        return false;
+      }
+      changes_.new_accounts[account.account_id] = account;
+      return true;
+    }
+
+    bool WsvChangesCommand::updateAccount(const model::Account &account) {
+      if (not command_.updateAccount(account)) {
+        return false;
+      }
+      // account created by the same block is still exported as new one,
+      // domain is not updated
+      auto created = changes_.new_accounts.find(account.account_id);
+      if (created != changes_.new_accounts.end()) {
+        auto domain_name = created->second.domain_name;
+        created->second = account;
+        created->second.domain_name = domain_name;
+      } else {
+        changes_.updated_accounts[account.account_id] = account;
+      }
+      return true;
+    }
+
+    bool WsvChangesCommand::insertAsset(const model::Asset &asset) {
+      if (not command_.insertAsset(asset)) {
+        return false;
+      }
+      changes_.assets.push_back(asset);
+      return true;
+    }
+
+    bool WsvChangesCommand::upsertAccountAsset(
+        const model::AccountAsset &asset) {
+      if (not command_.upsertAccountAsset(asset)) {
+        return false;
+      }
+      changes_.account_assets[{asset.account_id, asset.asset_id}] = asset;
+      return true;
+    }
+
+    bool WsvChangesCommand::upsertAccountAssets(
+        const std::vector<model::AccountAsset> &assets) {
+      if (not command_.upsertAccountAssets(assets)) {
+        return false;
+      }
+      for (const auto &asset : assets) {
+        changes_.account_assets[{asset.account_id, asset.asset_id}] = asset;
+      }
+      return true;
+    }
+
+    bool WsvChangesCommand::insertSignatory(
+        const ed25519::pubkey_t &signatory) {
+      return command_.insertSignatory(signatory);
+    }
+
+    bool WsvChangesCommand::insertAccountSignatory(
+        const std::string &account_id, const ed25519::pubkey_t &signatory) {
+      if (not command_.insertAccountSignatory(account_id, signatory)) {
+        return false;
+      }
+      changes_.signatories.push_back({account_id, signatory, false});
+      return true;
+    }
+
+    bool WsvChangesCommand::deleteAccountSignatory(
+        const std::string &account_id, const ed25519::pubkey_t &signatory) {
+      if (not command_.deleteAccountSignatory(account_id, signatory)) {
+        return false;
+      }
+      changes_.signatories.push_back({account_id, signatory, true});
+      return true;
+    }
+
+    bool WsvChangesCommand::insertPeer(const model::Peer &peer) {
+      return command_.insertPeer(peer);
+    }
+
+    bool WsvChangesCommand::deletePeer(const model::Peer &peer) {
+      return command_.deletePeer(peer);
+    }
+
+    bool WsvChangesCommand::insertDomain(const model::Domain &domain) {
+      if (not command_.insertDomain(domain)) {
+        return false;
+      }
+      changes_.domains.push_back(domain.domain_id);
+      return true;
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,93 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_WSV_CHANGES_HPP
+#define IROHA_WSV_CHANGES_HPP
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include "ametsuchi/wsv_command.hpp"
+#include "responses.pb.h"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Rows written by one block. Accounts and account assets keep only
+     * their values after the block, signatories are kept in order of
+     * execution, so deleted and added again one is replayed correctly.
+     */
+    struct WsvChanges {
+      struct Signatory {
+        std::string account_id;
+        ed25519::pubkey_t pubkey;
+        bool removed;
+      };
+
+      std::map<std::string, model::Account> new_accounts;
+      // accounts created by earlier blocks
+      std::map<std::string, model::Account> updated_accounts;
+      std::map<std::pair<std::string, std::string>, model::AccountAsset>
+          account_assets;
+      std::vector<Signatory> signatories;
+      std::vector<model::Asset> assets;
+      std::vector<std::string> domains;
+
+      /**
+       * @param height - height of the block
+       * @return changes in wire format, rows ordered by their keys
+       */
+      protocol::WsvChanges serialize(uint32_t height) const;
+    };
+
+    /**
+     * Command which records rows written through it into changes of the
+     * block. Failed writes are not recorded
+     */
+    class WsvChangesCommand : public WsvCommand {
+     public:
+      /**
+       * @param command - wrapped command
+       * @param changes - changes of the applied block
+       */
+      WsvChangesCommand(WsvCommand &command, WsvChanges &changes);
+
+      bool insertAccount(const model::Account &account) override;
+      bool updateAccount(const model::Account &account) override;
+      bool insertAsset(const model::Asset &asset) override;
+      bool upsertAccountAsset(const model::AccountAsset &asset) override;
+      bool upsertAccountAssets(
+          const std::vector<model::AccountAsset> &assets) override;
+      bool insertSignatory(const ed25519::pubkey_t &signatory) override;
+      bool insertAccountSignatory(const std::string &account_id,
+                                  const ed25519::pubkey_t &signatory) override;
+      bool deleteAccountSignatory(const std::string &account_id,
+                                  const ed25519::pubkey_t &signatory) override;
+      bool insertPeer(const model::Peer &peer) override;
+      bool deletePeer(const model::Peer &peer) override;
+      bool insertDomain(const model::Domain &domain) override;
+
+     private:
+      WsvCommand &command_;
+      WsvChanges &changes_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+#endif  // IROHA_WSV_CHANGES_HPP
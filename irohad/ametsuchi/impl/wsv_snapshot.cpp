@@ -0,0 +1,292 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/wsv_snapshot.hpp"
+#include <dirent.h>
+#include <algorithm>
+#include <cstdio>
+#include "ametsuchi/impl/record_codec.hpp"
+#include "crypto/crypto.hpp"
+#include "crypto/hash.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    namespace {
+      const std::string kSnapshotExtension = ".wsv";
+      const std::string kSnapshotMagic = "IRWS";
+      const uint64_t kSnapshotVersion = 2;
+      // accounts have no tx_counter, it is read as zero
+      const uint64_t kSnapshotVersionWithoutTxCounter = 1;
+      // hash, public key and signature closing the file
+      const size_t kTrailerSize = hash256_t::size()
+          + ed25519::pubkey_t::size() + ed25519::sig_t::size();
+
+      int is_snapshot_file(const struct dirent *entry) {
+        auto name = std::string(entry->d_name);
+        return name.size() > kSnapshotExtension.size() and
+            name.compare(name.size() - kSnapshotExtension.size(),
+                         kSnapshotExtension.size(), kSnapshotExtension) == 0;
+      }
+
+      std::string encode(const WsvSnapshot &snapshot) {
+        const auto &tables = snapshot.tables;
+        RecordEncoder encoder;
+        encoder.u64(kSnapshotVersion)
+            .u64(snapshot.height)
+            .blob(snapshot.top_hash);
+        encoder.u64(tables.domains.size());
+        for (const auto &domain : tables.domains) {
+          encoder.str(domain.first);
+        }
+        encoder.u64(tables.signatories.size());
+        for (const auto &signatory : tables.signatories) {
+          encoder.pubkey(signatory);
+        }
+        encoder.u64(tables.accounts.size());
+        for (const auto &pair : tables.accounts) {
+          const auto &account = pair.second;
+          encoder.str(account.account_id)
+              .str(account.domain_name)
+              .pubkey(account.master_key)
+              .u64(account.quorum)
+              .u64(account.permissions.toBitmask())
+              .u64(account.tx_counter);
+        }
+        encoder.u64(tables.account_signatories.size());
+        for (const auto &pair : tables.account_signatories) {
+          encoder.str(pair.first).u64(pair.second.size());
+          for (const auto &signatory : pair.second) {
+            encoder.pubkey(signatory);
+          }
+        }
+        encoder.u64(tables.assets.size());
+        for (const auto &pair : tables.assets) {
+          encoder.str(pair.second.asset_id)
+              .str(pair.second.domain_id)
+              .u64(pair.second.precision);
+        }
+        encoder.u64(tables.account_assets.size());
+        for (const auto &pair : tables.account_assets) {
+          encoder.str(pair.second.account_id)
+              .str(pair.second.asset_id)
+              .u64(pair.second.balance);
+        }
+        encoder.u64(tables.peers.size());
+        for (const auto &peer : tables.peers) {
+          encoder.pubkey(peer.pubkey).str(peer.address);
+        }
+        return kSnapshotMagic + encoder.value();
+      }
+
+      nonstd::optional<WsvSnapshot> decode(const std::string &bytes) {
+        if (bytes.compare(0, kSnapshotMagic.size(), kSnapshotMagic) != 0) {
+          return nonstd::nullopt;
+        }
+        auto body = bytes.substr(kSnapshotMagic.size());
+        RecordDecoder decoder(body);
+        WsvSnapshot snapshot;
+        auto &tables = snapshot.tables;
+        auto version = decoder.u64();
+        if (version != kSnapshotVersion
+            and version != kSnapshotVersionWithoutTxCounter) {
+          return nonstd::nullopt;
+        }
+        snapshot.height = decoder.u64();
+        snapshot.top_hash = decoder.blob<hash256_t::size()>();
+        // counts are checked against the input as records are read
+        for (auto n = decoder.u64(); n > 0 and decoder.ok(); --n) {
+          model::Domain domain;
+          domain.domain_id = decoder.str();
+          tables.domains.emplace(domain.domain_id, domain);
+        }
+        for (auto n = decoder.u64(); n > 0 and decoder.ok(); --n) {
+          tables.signatories.insert(decoder.pubkey());
+        }
+        for (auto n = decoder.u64(); n > 0 and decoder.ok(); --n) {
+          model::Account account;
+          account.account_id = decoder.str();
+          account.domain_name = decoder.str();
+          account.master_key = decoder.pubkey();
+          account.quorum = decoder.u64();
+          account.permissions =
+              model::Account::Permissions::fromBitmask(decoder.u64());
+          if (version != kSnapshotVersionWithoutTxCounter) {
+            account.tx_counter = decoder.u64();
+          }
+          tables.accounts.emplace(account.account_id, account);
+        }
+        for (auto n = decoder.u64(); n > 0 and decoder.ok(); --n) {
+          auto &signatories = tables.account_signatories[decoder.str()];
+          for (auto m = decoder.u64(); m > 0 and decoder.ok(); --m) {
+            signatories.push_back(decoder.pubkey());
+          }
+        }
+        for (auto n = decoder.u64(); n > 0 and decoder.ok(); --n) {
+          model::Asset asset;
+          asset.asset_id = decoder.str();
+          asset.domain_id = decoder.str();
+          asset.precision = decoder.u64();
+          tables.assets.emplace(asset.asset_id, asset);
+        }
+        for (auto n = decoder.u64(); n > 0 and decoder.ok(); --n) {
+          model::AccountAsset asset;
+          asset.account_id = decoder.str();
+          asset.asset_id = decoder.str();
+          asset.balance = decoder.u64();
+          tables.account_assets.emplace(
+              std::make_pair(asset.account_id, asset.asset_id), asset);
+        }
+        for (auto n = decoder.u64(); n > 0 and decoder.ok(); --n) {
+          model::Peer peer;
+          peer.pubkey = decoder.pubkey();
+          peer.address = decoder.str();
+          tables.peers.push_back(peer);
+        }
+        if (not decoder.finished()) {
+          return nonstd::nullopt;
+        }
+        return snapshot;
+      }
+
+      hash256_t digest(const std::string &bytes) {
+        return sha3_256(reinterpret_cast<const uint8_t *>(bytes.data()),
+                        bytes.size());
+      }
+    }  // namespace
+
+    WsvSnapshotStore::WsvSnapshotStore(const std::string &path)
+        : path_(path), log_(logger::log("WsvSnapshotStore")) {}
+
+    std::string WsvSnapshotStore::fileName(uint32_t height) const {
+      std::string name(16, '\0');
+      sprintf(&name[0], "%016u", height);
+      return path_ + "/" + name + kSnapshotExtension;
+    }
+
+    bool WsvSnapshotStore::write(
+        const WsvSnapshot &snapshot,
+        const nonstd::optional<ed25519::keypair_t> &keypair) {
+      auto bytes = encode(snapshot);
+      auto hash = digest(bytes);
+      ed25519::pubkey_t signer{};
+      ed25519::sig_t signature{};
+      if (keypair) {
+        signer = keypair->pubkey;
+        signature = sign(
+            hash.data(), hash.size(), keypair->pubkey, keypair->privkey);
+      }
+      bytes.append(hash.begin(), hash.end());
+      bytes.append(signer.begin(), signer.end());
+      bytes.append(signature.begin(), signature.end());
+
+      // rename is atomic, so readers never see a partial snapshot
+      auto name = fileName(snapshot.height);
+      auto tmp_name = name + ".tmp";
+      FILE *pfile = fopen(tmp_name.c_str(), "wb");
+      if (not pfile) {
+        log_->error("Cannot create {}", tmp_name);
+        return false;
+      }
+      auto written = fwrite(bytes.data(), 1, bytes.size(), pfile)
+          == bytes.size();
+      written = fclose(pfile) == 0 and written;
+      if (not written or std::rename(tmp_name.c_str(), name.c_str()) != 0) {
+        log_->error("Cannot write {}", name);
+        std::remove(tmp_name.c_str());
+        return false;
+      }
+
+      auto stored = heights();
+      for (size_t i = 0; i + kKeptSnapshots < stored.size(); ++i) {
+        std::remove(fileName(stored[i]).c_str());
+      }
+      return true;
+    }
+
+    std::vector<uint32_t> WsvSnapshotStore::heights() const {
+      std::vector<uint32_t> heights;
+      struct dirent **namelist;
+      auto status =
+          scandir(path_.c_str(), &namelist, is_snapshot_file, alphasort);
+      if (status < 0) {
+        log_->error("Cannot read directory {}", path_);
+        return heights;
+      }
+      for (auto i = 0; i < status; ++i) {
+        // names are zero padded, so alphabetical order is numeric one
+        heights.push_back(std::stoul(namelist[i]->d_name));
+        free(namelist[i]);
+      }
+      free(namelist);
+      return heights;
+    }
+
+    nonstd::optional<WsvSnapshot> WsvSnapshotStore::read(
+        uint32_t height, const std::vector<ed25519::pubkey_t> &trusted) const {
+      auto name = fileName(height);
+      FILE *pfile = fopen(name.c_str(), "rb");
+      if (not pfile) {
+        return nonstd::nullopt;
+      }
+      std::string bytes;
+      char buffer[64 * 1024];
+      size_t read;
+      while ((read = fread(buffer, 1, sizeof(buffer), pfile)) > 0) {
+        bytes.append(buffer, read);
+      }
+      auto failed = ferror(pfile);
+      fclose(pfile);
+      if (failed or bytes.size() < kTrailerSize) {
+        log_->error("Cannot read {}", name);
+        return nonstd::nullopt;
+      }
+
+      auto content = bytes.substr(0, bytes.size() - kTrailerSize);
+      auto trailer_bytes = bytes.substr(content.size());
+      RecordDecoder trailer(trailer_bytes);
+      auto hash = trailer.blob<hash256_t::size()>();
+      auto signer = trailer.pubkey();
+      auto signature = trailer.blob<ed25519::sig_t::size()>();
+      if (hash != digest(content)) {
+        log_->error("Snapshot {} is damaged", name);
+        return nonstd::nullopt;
+      }
+      auto is_signed = signer != ed25519::pubkey_t{};
+      if (is_signed
+          and not verify(hash.data(), hash.size(), signer, signature)) {
+        log_->error("Snapshot {} has invalid signature", name);
+        return nonstd::nullopt;
+      }
+      if (not trusted.empty()
+          and (not is_signed
+               or std::find(trusted.begin(), trusted.end(), signer)
+                   == trusted.end())) {
+        log_->error("Snapshot {} is not signed by a trusted key", name);
+        return nonstd::nullopt;
+      }
+
+      auto snapshot = decode(content);
+      if (not snapshot or snapshot->height != height) {
+        log_->error("Snapshot {} is malformed", name);
+        return nonstd::nullopt;
+      }
+      return snapshot;
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,92 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_WSV_SNAPSHOT_HPP
+#define IROHA_WSV_SNAPSHOT_HPP
+
+#include <nonstd/optional.hpp>
+#include <string>
+#include <vector>
+#include "ametsuchi/impl/bulk_wsv.hpp"
+#include "common/types.hpp"
+#include "logger/logger.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * World state view after block at given height
+     */
+    struct WsvSnapshot {
+      uint32_t height;
+      // hash of the block at height
+      hash256_t top_hash;
+      BulkTables tables;
+    };
+
+    /**
+     * Snapshots of world state view stored as <height>.wsv next to block
+     * storage. File is header [magic][version][height][top hash], encoded
+     * tables, then sha3-256 of all preceding bytes, public key of the
+     * signer and signature of the hash. Unsigned snapshots have zero key
+     * and signature, they are as trusted as the directory they are read
+     * from.
+     */
+    class WsvSnapshotStore {
+     public:
+      /**
+       * Number of the latest snapshots kept on disk
+       */
+      static constexpr size_t kKeptSnapshots = 2;
+
+      /**
+       * @param path - existing directory, e.g. of block storage
+       */
+      explicit WsvSnapshotStore(const std::string &path);
+
+      /**
+       * Write snapshot and remove the old ones
+       * @param keypair - key signing the snapshot, unsigned if absent
+       * @return true if snapshot is written
+       */
+      bool write(const WsvSnapshot &snapshot,
+                 const nonstd::optional<ed25519::keypair_t> &keypair);
+
+      /**
+       * @return heights of stored snapshots in ascending order
+       */
+      std::vector<uint32_t> heights() const;
+
+      /**
+       * Read snapshot and check its signature
+       * @param trusted - keys one of which must sign the snapshot, any
+       * intact snapshot is accepted if empty
+       * @return snapshot, nullopt if it is missing, damaged or not trusted
+       */
+      nonstd::optional<WsvSnapshot> read(
+          uint32_t height, const std::vector<ed25519::pubkey_t> &trusted) const;
+
+     private:
+      std::string fileName(uint32_t height) const;
+
+      const std::string path_;
+      logger::Logger log_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+#endif  // IROHA_WSV_SNAPSHOT_HPP
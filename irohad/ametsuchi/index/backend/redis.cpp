@@ -35,25 +35,19 @@ namespace iroha {
         read_client_.disconnect();
       }
 
+      // writes are only queued in the open MULTI and sent by exec_multi
       bool Redis::add_blockhash_blockid(std::string block_hash,
                                         uint32_t height) {
-        bool res;
-        client_.set("block:" + block_hash, std::to_string(height),
-                    [&res](cpp_redis::reply &reply) { res = reply.ok(); });
-        client_.set("last_id", std::to_string(height),
-                    [&res](cpp_redis::reply &reply) { res &= reply.ok(); });
-        client_.sync_commit();
-        return res;
+        client_.set("block:" + block_hash, std::to_string(height));
+        client_.set("last_id", std::to_string(height));
+        return true;
       }
 
       bool Redis::add_pubkey_txhash(std::string pubkey, std::string txhash) {
-        bool res;
         std::vector<std::string> txhashes(
             {txhash});  // cpp redis requires to put vector into rpush
-        client_.rpush("account_pubkey:" + pubkey, txhashes,
-                      [&res](cpp_redis::reply &reply) { res = reply.ok(); });
-        client_.sync_commit();
-        return res;
+        client_.rpush("account_pubkey:" + pubkey, txhashes);
+        return true;
       }
 
       nonstd::optional<uint64_t> Redis::get_blockid_by_blockhash(
@@ -70,9 +64,7 @@ namespace iroha {
 
       bool Redis::add_txhash_blockid_txid(std::string txhash, uint32_t height,
                                           int txid) {
-        bool res = _add_txhash_blockid_txid(txhash, height, txid);
-        client_.sync_commit();
-        return res;
+        return _add_txhash_blockid_txid(txhash, height, txid);
       }
 
       nonstd::optional<uint64_t> Redis::get_txid_by_txhash(std::string txhash) {
@@ -142,11 +134,8 @@ namespace iroha {
 
       bool Redis::_add_txhash_blockid_txid(std::string txhash, uint32_t height,
                                            int txid) {
-        bool res;
-        client_.hset("tx:" + txhash, "blockid", std::to_string(height),
-                     [&res](cpp_redis::reply &reply) { res = reply.ok(); });
-        client_.hset("tx:" + txhash, "txid", std::to_string(txid),
-                     [&res](cpp_redis::reply &reply) { res &= reply.ok(); });
+        client_.hmset("tx:" + txhash, {{"blockid", std::to_string(height)},
+                                       {"txid", std::to_string(txid)}});
         return true;
       }
 
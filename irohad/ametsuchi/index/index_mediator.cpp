@@ -15,30 +15,76 @@
  * limitations under the License.
  */
 
-#include <ametsuchi/index/index_mediator.hpp>
-#include <block.pb.h>
+#include "ametsuchi/index/index_mediator.hpp"
+#include <algorithm>
+#include <chrono>
+#include <thread>
 
 namespace iroha {
 
-  IndexMediator::IndexMediator(ametsuchi::Storage *ametsuchi)
-      : ametsuchi_(ametsuchi) {}
+  IndexMediator::IndexMediator(ametsuchi::BlockQuery &blocks,
+                               ametsuchi::BlockIndex &index,
+                               uint32_t max_rate)
+      : blocks_(blocks),
+        index_(index),
+        max_rate_(max_rate),
+        stopped_(false),
+        log_(logger::log("IndexMediator")) {}
 
-  void IndexMediator::synchronize() {
-    auto last_block_id_store = ametsuchi_->last_block_id_store();
-    auto last_block_id_index_opt = ametsuchi_->last_block_id_index();
-    auto last_block_id_index =
-        last_block_id_index_opt ? *last_block_id_index_opt : 1;
+  bool IndexMediator::synchronize(uint32_t height) {
+    auto indexed = index_.height();
+    if (not indexed) {
+      log_->error("Cannot read height of block index");
+      return false;
+    }
+    if (*indexed >= height) {
+      return true;
+    }
+    log_->info("Indexing blocks {}..{}", *indexed + 1, height);
+    auto started = std::chrono::steady_clock::now();
+    for (auto from = *indexed + 1; from <= height; from += kBatchSize) {
+      if (stopped_) {
+        log_->info("Indexing stopped at block {}", from - 1);
+        return false;
+      }
+      auto to = std::min(height, from + kBatchSize - 1);
+      std::vector<model::Block> batch;
+      blocks_.getBlocks(from, to).as_blocking().subscribe(
+          [&batch, from](const model::Block &block) {
+            if (block.height == from + batch.size()) {
+              batch.push_back(block);
+            }
+          });
+      // batch with missing blocks is dropped, index stays consistent
+      if (batch.size() != to - from + 1) {
+        log_->error("Cannot read block {} for index", from + batch.size());
+        return false;
+      }
+      if (not index_.add(ametsuchi::BlockRefs(batch.begin(), batch.end()))) {
+        log_->error("Cannot write index of blocks {}..{}", from, to);
+        return false;
+      }
 
-    for (; last_block_id_index < last_block_id_store; ++last_block_id_index) {
-      auto blob = ametsuchi_->get_block(last_block_id_index);
-      iroha::protocol::Block block;
-      block.ParseFromArray(blob.data(), blob.size());
-      ametsuchi_->insert_block_index(last_block_id_index,
-                                     std::string());  // TODO calculate hash
-      for (int i = 0; i < block.body().txs_size(); ++i) {
-        ametsuchi_->insert_tx_index(
-            i, std::string(), last_block_id_index);  // TODO calculate hash
+      auto done = to - *indexed;
+      auto elapsed = std::chrono::duration<double>(
+          std::chrono::steady_clock::now() - started);
+      log_->info("Indexed {} of {} blocks, {:.0f} blocks/s",
+                 to,
+                 height,
+                 done / std::max(elapsed.count(), 1e-3));
+      if (max_rate_ != 0) {
+        // sleep until the average rate drops to the limit
+        auto planned = std::chrono::duration<double>(double(done) / max_rate_);
+        if (planned > elapsed) {
+          std::this_thread::sleep_for(planned - elapsed);
+        }
       }
     }
+    return true;
+  }
+
+  void IndexMediator::stop() {
+    stopped_ = true;
   }
+
 }  // namespace iroha
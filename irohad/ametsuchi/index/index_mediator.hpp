@@ -18,17 +18,55 @@
 #ifndef IROHA_INDEX_MEDIATOR_HPP
 #define IROHA_INDEX_MEDIATOR_HPP
 
-#include <ametsuchi/storage.hpp>
+#include <atomic>
+#include "ametsuchi/block_query.hpp"
+#include "ametsuchi/impl/block_index.hpp"
+#include "logger/logger.hpp"
 
 namespace iroha {
 
+  /**
+   * Brings block index up to the height of block storage,
+   * e.g. after the index was lost or unavailable during commits.
+   * Each batch is written atomically together with the indexed height,
+   * so interrupted synchronization resumes from the last written batch.
+   */
   class IndexMediator {
    public:
-    IndexMediator(ametsuchi::Storage* ametsuchi);
-    void synchronize();
+    /**
+     * Blocks indexed with one write
+     */
+    static constexpr uint32_t kBatchSize = 1000;
+
+    /**
+     * @param blocks - storage to read blocks from
+     * @param index - index to write to
+     * @param max_rate - upper bound of indexed blocks per second, so reads
+     * of old blocks do not starve commits; 0 for no limit
+     */
+    IndexMediator(ametsuchi::BlockQuery &blocks,
+                  ametsuchi::BlockIndex &index,
+                  uint32_t max_rate = 0);
+
+    /**
+     * Index blocks after the last indexed one up to given height.
+     * Progress is logged after every batch.
+     * @return true if index covers the height
+     */
+    bool synchronize(uint32_t height);
+
+    /**
+     * Interrupt synchronization after the current batch, may be called
+     * from any thread
+     */
+    void stop();
 
    private:
-    ametsuchi::Storage* ametsuchi_;
+    ametsuchi::BlockQuery &blocks_;
+    ametsuchi::BlockIndex &index_;
+    const uint32_t max_rate_;
+    std::atomic<bool> stopped_;
+    logger::Logger log_;
   };
 
 }  // namespace iroha
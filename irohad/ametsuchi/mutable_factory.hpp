@@ -33,6 +33,16 @@ namespace iroha {
        */
       virtual std::unique_ptr<MutableStorage> createMutableStorage() = 0;
 
+      /**
+       * Creates a mutable storage for trusted blocks applied to empty state,
+       * such as genesis block. Its changes may be written with faster bulk
+       * load, and a failed block makes the whole commit fail.
+       * @return Created mutable storage
+       */
+      virtual std::unique_ptr<MutableStorage> createBulkStorage() {
+        return createMutableStorage();
+      }
+
       /**
        * Commit mutable storage to Ametsuchi.
        * This transforms Ametsuchi to the new state consistent with
@@ -0,0 +1,55 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_SNAPSHOT_PIN_HPP
+#define IROHA_SNAPSHOT_PIN_HPP
+
+#include <memory>
+
+namespace iroha {
+
+  namespace ametsuchi {
+
+    /**
+     * Keeps reads of calling thread at committed state seen when the pin
+     * was taken, until it is destroyed
+     */
+    class SnapshotPin {
+     public:
+      virtual ~SnapshotPin() = default;
+    };
+
+    /**
+     * Storage which reads can be pinned to one committed state
+     */
+    class SnapshotPinFactory {
+     public:
+      /**
+       * Pin world state view and block reads made by calling thread.
+       * Pin must be destroyed on the same thread, pins may nest
+       * @return pin
+       */
+      virtual std::unique_ptr<SnapshotPin> pinSnapshot() = 0;
+
+      virtual ~SnapshotPinFactory() = default;
+    };
+
+  }  // namespace ametsuchi
+
+}  // namespace iroha
+
+#endif  // IROHA_SNAPSHOT_PIN_HPP
@@ -25,6 +25,7 @@
 #include <model/domain.hpp>
 #include <common/types.hpp>
 #include <string>
+#include <vector>
 
 namespace iroha {
   namespace ametsuchi {
@@ -64,6 +65,21 @@ namespace iroha {
        */
       virtual bool upsertAccountAsset(const model::AccountAsset &asset) = 0;
 
+      /**
+       * Update or insert many account assets at once
+       * @param assets
+       * @return true if all assets are written, false otherwise
+       */
+      virtual bool upsertAccountAssets(
+          const std::vector<model::AccountAsset> &assets) {
+        for (const auto &asset : assets) {
+          if (not upsertAccountAsset(asset)) {
+            return false;
+          }
+        }
+        return true;
+      }
+
       /**
        *
        * @param signatory
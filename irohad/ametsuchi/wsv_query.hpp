@@ -70,6 +70,58 @@ namespace iroha {
       virtual nonstd::optional<model::AccountAsset> getAccountAsset(
           const std::string &account_id, const std::string &asset_id) = 0;
 
+      /**
+       * Get assets of account in order of asset id
+       * @param account_id
+       * @param after_asset_id - assets up to this one are skipped, empty
+       * to start from the first asset
+       * @param limit - maximal number of assets, 0 for all of them
+       * @return
+       */
+      virtual nonstd::optional<std::vector<model::AccountAsset>>
+      getAccountAssets(const std::string &account_id,
+                       const std::string &after_asset_id,
+                       size_t limit) = 0;
+
+      /**
+       * Get balances of accounts holding asset in order of account id
+       * @param asset_id
+       * @param after_account_id - accounts up to this one are skipped,
+       * empty to start from the first account
+       * @param limit - maximal number of accounts, 0 for all of them
+       * @return
+       */
+      virtual nonstd::optional<std::vector<model::AccountAsset>>
+      getAssetHolders(const std::string &asset_id,
+                      const std::string &after_account_id,
+                      size_t limit) = 0;
+
+      /**
+       * Get accounts of domain in order of account id
+       * @param domain_id
+       * @param after_account_id - accounts up to this one are skipped,
+       * empty to start from the first account
+       * @param limit - maximal number of accounts, 0 for all of them
+       * @return
+       */
+      virtual nonstd::optional<std::vector<model::Account>> getDomainAccounts(
+          const std::string &domain_id,
+          const std::string &after_account_id,
+          size_t limit) = 0;
+
+      /**
+       * Get ids of accounts which have signatory, in order of account id
+       * @param signatory
+       * @param after_account_id - accounts up to this one are skipped,
+       * empty to start from the first account
+       * @param limit - maximal number of accounts, 0 for all of them
+       * @return
+       */
+      virtual nonstd::optional<std::vector<std::string>>
+      getAccountsBySignatory(const ed25519::pubkey_t &signatory,
+                             const std::string &after_account_id,
+                             size_t limit) = 0;
+
       /**
        *
        * @return
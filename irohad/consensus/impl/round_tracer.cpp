@@ -0,0 +1,140 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "consensus/round_tracer.hpp"
+#include <algorithm>
+#include <sstream>
+
+namespace iroha {
+  namespace consensus {
+
+    constexpr std::array<uint64_t, 12> LatencyHistogram::kBounds;
+    constexpr size_t RoundTracer::kRoundsKept;
+
+    namespace {
+      const std::array<const char *, kRoundPhases> kPhaseNames = {
+          {"received", "verified", "voted", "supermajority", "committed"}};
+
+      void render(std::ostringstream &out,
+                  const std::string &name,
+                  const std::string &labels,
+                  const LatencyHistogram &histogram) {
+        auto prefix = labels.empty() ? "{" : "{" + labels + ",";
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < LatencyHistogram::kBounds.size(); ++i) {
+          cumulative += histogram.buckets()[i];
+          out << name << "_bucket" << prefix << "le=\""
+              << LatencyHistogram::kBounds[i] << "\"} " << cumulative << "\n";
+        }
+        out << name << "_bucket" << prefix << "le=\"+Inf\"} "
+            << histogram.count() << "\n";
+        auto suffix = labels.empty() ? "" : "{" + labels + "}";
+        out << name << "_sum" << suffix << " " << histogram.sum() << "\n";
+        out << name << "_count" << suffix << " " << histogram.count() << "\n";
+      }
+    }  // namespace
+
+    void LatencyHistogram::observe(std::chrono::milliseconds value) {
+      auto ms = static_cast<uint64_t>(std::max<int64_t>(value.count(), 0));
+      auto bucket = std::lower_bound(kBounds.begin(), kBounds.end(), ms)
+          - kBounds.begin();
+      ++buckets_[bucket];
+      ++count_;
+      sum_ += ms;
+    }
+
+    RoundTracer::RoundTracer() : log_(logger::log("RoundTracer")) {}
+
+    void RoundTracer::mark(uint64_t round,
+                           RoundPhase phase,
+                           Clock::time_point time) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto &trace = rounds_[round];
+      auto &slot = trace.phases.at(static_cast<size_t>(phase));
+      if (slot) {
+        return;
+      }
+      slot = time;
+      if (phase == RoundPhase::Committed) {
+        finish(round, trace);
+      }
+      while (rounds_.size() > kRoundsKept) {
+        rounds_.erase(rounds_.begin());
+      }
+    }
+
+    void RoundTracer::voteArrived(const std::string &peer,
+                                  std::chrono::milliseconds latency) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      votes_[peer].observe(latency);
+    }
+
+    nonstd::optional<RoundTrace> RoundTracer::round(uint64_t round) const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto trace = rounds_.find(round);
+      if (trace == rounds_.end()) {
+        return nonstd::nullopt;
+      }
+      return trace->second;
+    }
+
+    std::string RoundTracer::report() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      std::ostringstream out;
+      out << "# TYPE iroha_round_phase_ms histogram\n";
+      for (size_t i = 1; i < kRoundPhases; ++i) {
+        render(out,
+               "iroha_round_phase_ms",
+               std::string("phase=\"") + kPhaseNames[i] + "\"",
+               phases_[i]);
+      }
+      out << "# TYPE iroha_vote_latency_ms histogram\n";
+      for (const auto &peer : votes_) {
+        render(out,
+               "iroha_vote_latency_ms",
+               "peer=\"" + peer.first + "\"",
+               peer.second);
+      }
+      return out.str();
+    }
+
+    void RoundTracer::finish(uint64_t round, const RoundTrace &trace) {
+      std::ostringstream line;
+      line << "round " << round;
+      nonstd::optional<Clock::time_point> previous;
+      for (size_t i = 0; i < kRoundPhases; ++i) {
+        if (not trace.phases[i]) {
+          continue;
+        }
+        if (previous) {
+          auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+              *trace.phases[i] - *previous);
+          phases_[i].observe(duration);
+          line << " " << kPhaseNames[i] << "=+" << duration.count() << "ms";
+        }
+        previous = trace.phases[i];
+      }
+      log_->info("{}", line.str());
+    }
+
+    RoundTracer &roundTracer() {
+      static RoundTracer tracer;
+      return tracer;
+    }
+
+  }  // namespace consensus
+}  // namespace iroha
@@ -0,0 +1,143 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_ROUND_TRACER_HPP
+#define IROHA_ROUND_TRACER_HPP
+
+#include <array>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <nonstd/optional.hpp>
+#include <string>
+#include "logger/logger.hpp"
+
+namespace iroha {
+  namespace consensus {
+
+    /**
+     * Stages of one round, in order of their appearance
+     */
+    enum class RoundPhase {
+      ProposalReceived,
+      ProposalVerified,
+      Voted,
+      Supermajority,
+      Committed
+    };
+
+    constexpr size_t kRoundPhases = 5;
+
+    /**
+     * Histogram of durations with fixed millisecond buckets
+     */
+    class LatencyHistogram {
+     public:
+      /**
+       * Upper bounds of buckets in milliseconds, last bucket is unbounded
+       */
+      static constexpr std::array<uint64_t, 12> kBounds = {
+          {1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000}};
+
+      void observe(std::chrono::milliseconds value);
+
+      /**
+       * @return number of observations in each bucket, not cumulative
+       */
+      const std::array<uint64_t, kBounds.size() + 1> &buckets() const {
+        return buckets_;
+      }
+
+      uint64_t count() const { return count_; }
+
+      uint64_t sum() const { return sum_; }
+
+     private:
+      std::array<uint64_t, kBounds.size() + 1> buckets_{};
+      uint64_t count_ = 0;
+      uint64_t sum_ = 0;
+    };
+
+    /**
+     * Timestamps of phases of one round, missing phase was not observed,
+     * e.g. block downloaded from other peers has no vote
+     */
+    struct RoundTrace {
+      std::array<nonstd::optional<std::chrono::steady_clock::time_point>,
+                 kRoundPhases>
+          phases;
+    };
+
+    /**
+     * Collects timings of consensus rounds and arrival latency of votes.
+     * Rounds are identified by height of proposal. When round is committed,
+     * its timings are logged and added to per-phase histograms.
+     * Thread safe.
+     */
+    class RoundTracer {
+     public:
+      using Clock = std::chrono::steady_clock;
+
+      static constexpr size_t kRoundsKept = 64;
+
+      RoundTracer();
+
+      /**
+       * Record the moment of phase, only the first mark of phase is kept
+       * @param round - height of proposal
+       */
+      void mark(uint64_t round,
+                RoundPhase phase,
+                Clock::time_point time = Clock::now());
+
+      /**
+       * Record delay between own vote and arrival of vote of peer
+       * @param peer - identifier of voter
+       */
+      void voteArrived(const std::string &peer,
+                       std::chrono::milliseconds latency);
+
+      /**
+       * @return trace of round if it is still kept
+       */
+      nonstd::optional<RoundTrace> round(uint64_t round) const;
+
+      /**
+       * Render all histograms in prometheus text exposition format
+       */
+      std::string report() const;
+
+     private:
+      void finish(uint64_t round, const RoundTrace &trace);
+
+      mutable std::mutex mutex_;
+      std::map<uint64_t, RoundTrace> rounds_;
+      // duration of each phase measured from the previous observed phase
+      std::array<LatencyHistogram, kRoundPhases> phases_;
+      std::map<std::string, LatencyHistogram> votes_;
+      logger::Logger log_;
+    };
+
+    /**
+     * @return tracer shared by all components of the peer
+     */
+    RoundTracer &roundTracer();
+
+  }  // namespace consensus
+}  // namespace iroha
+
+#endif  // IROHA_ROUND_TRACER_HPP
@@ -0,0 +1,73 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_COMMIT_CERTIFICATE_HPP
+#define IROHA_COMMIT_CERTIFICATE_HPP
+
+#include <nonstd/optional.hpp>
+#include <vector>
+#include "consensus/yac/messages.hpp"
+#include "model/peer.hpp"
+
+namespace iroha {
+  namespace consensus {
+    namespace yac {
+
+      /**
+       * Compact form of commit: common hash of all votes, bitmap of signers
+       * over peer list and their signatures. Public keys are not
+       * transferred, since receiver knows them from the same peer list.
+       */
+      struct CommitCertificate {
+        YacHash hash;
+
+        /**
+         * Bit i (least significant first) is set if peer i has signed
+         */
+        std::vector<uint8_t> signers;
+
+        /**
+         * Signatures of signers in order of peer list
+         */
+        std::vector<ed25519::sig_t> signatures;
+      };
+
+      /**
+       * Build certificate for votes
+       * @param votes - votes for one hash
+       * @param peers - peer list known to sender and receiver
+       * @return certificate, nullopt if votes differ in hash, repeat
+       * a signer or are signed by unknown peer
+       */
+      nonstd::optional<CommitCertificate> makeCertificate(
+          const std::vector<VoteMessage> &votes,
+          const std::vector<model::Peer> &peers);
+
+      /**
+       * Restore votes from certificate
+       * @param certificate - received certificate
+       * @param peers - peer list known to sender and receiver
+       * @return votes, nullopt if certificate does not match peer list
+       */
+      nonstd::optional<std::vector<VoteMessage>> openCertificate(
+          const CommitCertificate &certificate,
+          const std::vector<model::Peer> &peers);
+
+    }  // namespace yac
+  }    // namespace consensus
+}  // namespace iroha
+#endif  // IROHA_COMMIT_CERTIFICATE_HPP
@@ -0,0 +1,54 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_YAC_EXECUTOR_HPP
+#define IROHA_YAC_EXECUTOR_HPP
+
+#include <functional>
+
+namespace iroha {
+  namespace consensus {
+    namespace yac {
+
+      /**
+       * Interface provide execution context of yac state transitions
+       */
+      class Executor {
+       public:
+        using Task = std::function<void()>;
+
+        /**
+         * Schedule task, tasks are executed one by one in order of posting
+         * @param task - function, that will be invoked
+         */
+        virtual void post(Task task) = 0;
+
+        virtual ~Executor() = default;
+      };
+
+      /**
+       * Executor which runs task immediately in the calling thread,
+       * for callers which are single-threaded themselves
+       */
+      class InlineExecutor : public Executor {
+       public:
+        void post(Task task) override { task(); }
+      };
+    }  // namespace yac
+  }    // namespace consensus
+}  // namespace iroha
+#endif  // IROHA_YAC_EXECUTOR_HPP
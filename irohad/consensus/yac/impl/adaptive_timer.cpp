@@ -0,0 +1,85 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "consensus/yac/impl/adaptive_timer.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace iroha {
+  namespace consensus {
+    namespace yac {
+
+      namespace {
+        // gains of srtt and rttvar from RFC 6298
+        constexpr double kAlpha = 1.0 / 8;
+        constexpr double kBeta = 1.0 / 4;
+        constexpr uint32_t kMaxBackoff = 16;
+      }  // namespace
+
+      AdaptiveTimer::AdaptiveTimer(std::shared_ptr<Timer> timer,
+                                   uint64_t max_delay)
+          : timer_(std::move(timer)),
+            max_delay_(std::max(max_delay, kMinDelay)) {}
+
+      void AdaptiveTimer::invokeAfterDelay(uint64_t millis,
+                                           std::function<void()> handler) {
+        timer_->invokeAfterDelay(millis, std::move(handler));
+      }
+
+      void AdaptiveTimer::deny() { timer_->deny(); }
+
+      uint64_t AdaptiveTimer::delayFor(const model::Peer &peer,
+                                       uint64_t base) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = timings_.find(peer);
+        if (it == timings_.end()) {
+          return std::min(base, max_delay_);
+        }
+        const auto &timing = it->second;
+        double delay = timing.measured
+            ? timing.srtt + 4 * timing.rttvar
+            : static_cast<double>(base);
+        delay = std::max(delay, static_cast<double>(kMinDelay))
+            * std::pow(2.0, timing.backoff);
+        return std::min(static_cast<uint64_t>(delay), max_delay_);
+      }
+
+      void AdaptiveTimer::onAnswer(const model::Peer &peer, uint64_t millis) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto &timing = timings_[peer];
+        auto rtt = static_cast<double>(millis);
+        if (not timing.measured) {
+          timing.srtt = rtt;
+          timing.rttvar = rtt / 2;
+          timing.measured = true;
+        } else {
+          timing.rttvar = (1 - kBeta) * timing.rttvar
+              + kBeta * std::abs(timing.srtt - rtt);
+          timing.srtt = (1 - kAlpha) * timing.srtt + kAlpha * rtt;
+        }
+        timing.backoff = 0;
+      }
+
+      void AdaptiveTimer::onTimeout(const model::Peer &peer) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto &timing = timings_[peer];
+        timing.backoff = std::min(timing.backoff + 1, kMaxBackoff);
+      }
+
+    }  // namespace yac
+  }    // namespace consensus
+}  // namespace iroha
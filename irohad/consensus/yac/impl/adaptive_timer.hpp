@@ -0,0 +1,75 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_ADAPTIVE_TIMER_HPP
+#define IROHA_ADAPTIVE_TIMER_HPP
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "consensus/yac/timer.hpp"
+
+namespace iroha {
+  namespace consensus {
+    namespace yac {
+
+      /**
+       * Timer which adapts delays to observed answer times of peers.
+       * Smoothed round trip time and its variation are kept per peer as
+       * EWMA, delay is srtt + 4 * rttvar like TCP retransmission timeout.
+       * Every timeout in a row doubles the delay.
+       * Timing itself is delegated to wrapped timer.
+       */
+      class AdaptiveTimer : public Timer {
+       public:
+        /**
+         * Lower bound of adaptive delay in milliseconds
+         */
+        static constexpr uint64_t kMinDelay = 100;
+
+        /**
+         * @param timer - timer which invokes handlers
+         * @param max_delay - upper bound of delay in milliseconds
+         */
+        AdaptiveTimer(std::shared_ptr<Timer> timer, uint64_t max_delay);
+
+        void invokeAfterDelay(uint64_t millis,
+                              std::function<void()> handler) override;
+        void deny() override;
+
+        uint64_t delayFor(const model::Peer &peer, uint64_t base) override;
+        void onAnswer(const model::Peer &peer, uint64_t millis) override;
+        void onTimeout(const model::Peer &peer) override;
+
+       private:
+        struct PeerTiming {
+          double srtt = 0;
+          double rttvar = 0;
+          bool measured = false;
+          uint32_t backoff = 0;
+        };
+
+        std::shared_ptr<Timer> timer_;
+        const uint64_t max_delay_;
+        std::unordered_map<model::Peer, PeerTiming> timings_;
+        std::mutex mutex_;
+      };
+
+    }  // namespace yac
+  }    // namespace consensus
+}  // namespace iroha
+#endif  // IROHA_ADAPTIVE_TIMER_HPP
@@ -0,0 +1,98 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "consensus/yac/impl/batch_vote_verifier.hpp"
+#include <algorithm>
+
+namespace iroha {
+  namespace consensus {
+    namespace yac {
+
+      constexpr std::chrono::microseconds BatchVoteVerifier::kDefaultWindow;
+      constexpr size_t BatchVoteVerifier::kDefaultBatchSize;
+
+      BatchVoteVerifier::BatchVoteVerifier(
+          std::shared_ptr<YacCryptoProvider> crypto,
+          std::chrono::microseconds window,
+          size_t batch_size)
+          : crypto_(std::move(crypto)),
+            window_(window),
+            batch_size_(std::max<size_t>(batch_size, 1)),
+            thread_(&BatchVoteVerifier::run, this) {}
+
+      void BatchVoteVerifier::verify(VoteMessage vote,
+                                     Handler on_valid,
+                                     Handler on_invalid) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (votes_.empty()) {
+          first_arrival_ = std::chrono::steady_clock::now();
+        }
+        votes_.push_back(std::move(vote));
+        handlers_.push_back(std::move(on_valid));
+        invalid_handlers_.push_back(std::move(on_invalid));
+        if (votes_.size() == 1 or votes_.size() == batch_size_) {
+          wakeup_.notify_one();
+        }
+      }
+
+      void BatchVoteVerifier::run() {
+        std::vector<VoteMessage> votes;
+        std::vector<Handler> handlers;
+        std::vector<Handler> invalid_handlers;
+        while (true) {
+          {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wakeup_.wait(lock,
+                         [this] { return stopped_ or not votes_.empty(); });
+            wakeup_.wait_until(lock, first_arrival_ + window_, [this] {
+              return stopped_ or votes_.size() >= batch_size_;
+            });
+            if (stopped_) {
+              return;
+            }
+            votes.swap(votes_);
+            handlers.swap(handlers_);
+            invalid_handlers.swap(invalid_handlers_);
+          }
+
+          auto valid = crypto_->verifyBatch(votes);
+          for (size_t i = 0; i < handlers.size(); ++i) {
+            if (valid.at(i)) {
+              handlers[i]();
+            } else if (invalid_handlers[i]) {
+              invalid_handlers[i]();
+            }
+          }
+          votes.clear();
+          handlers.clear();
+          invalid_handlers.clear();
+        }
+      }
+
+      BatchVoteVerifier::~BatchVoteVerifier() {
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          stopped_ = true;
+        }
+        wakeup_.notify_one();
+        if (thread_.joinable()) {
+          thread_.join();
+        }
+      }
+    }  // namespace yac
+  }    // namespace consensus
+}  // namespace iroha
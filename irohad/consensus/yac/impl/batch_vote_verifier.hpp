@@ -0,0 +1,80 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_BATCH_VOTE_VERIFIER_HPP
+#define IROHA_BATCH_VOTE_VERIFIER_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "consensus/yac/vote_verifier.hpp"
+
+namespace iroha {
+  namespace consensus {
+    namespace yac {
+
+      /**
+       * Verifier which collects votes arriving within a short window and
+       * checks them with one batch verification on a dedicated thread.
+       * Votes pending on destruction are dropped.
+       */
+      class BatchVoteVerifier : public VoteVerifier {
+       public:
+        static constexpr std::chrono::microseconds kDefaultWindow{500};
+        static constexpr size_t kDefaultBatchSize = 64;
+
+        /**
+         * @param crypto - provider of batch verification
+         * @param window - time to wait for more votes after the first one
+         * @param batch_size - batch is verified without waiting when full
+         */
+        explicit BatchVoteVerifier(
+            std::shared_ptr<YacCryptoProvider> crypto,
+            std::chrono::microseconds window = kDefaultWindow,
+            size_t batch_size = kDefaultBatchSize);
+
+        BatchVoteVerifier(const BatchVoteVerifier &) = delete;
+        BatchVoteVerifier &operator=(const BatchVoteVerifier &) = delete;
+
+        void verify(VoteMessage vote,
+                    Handler on_valid,
+                    Handler on_invalid = Handler()) override;
+
+        ~BatchVoteVerifier() override;
+
+       private:
+        void run();
+
+        std::shared_ptr<YacCryptoProvider> crypto_;
+        const std::chrono::microseconds window_;
+        const size_t batch_size_;
+
+        std::vector<VoteMessage> votes_;
+        std::vector<Handler> handlers_;
+        std::vector<Handler> invalid_handlers_;
+        std::chrono::steady_clock::time_point first_arrival_;
+        bool stopped_ = false;
+        std::mutex mutex_;
+        std::condition_variable wakeup_;
+        std::thread thread_;
+      };
+    }  // namespace yac
+  }    // namespace consensus
+}  // namespace iroha
+#endif  // IROHA_BATCH_VOTE_VERIFIER_HPP
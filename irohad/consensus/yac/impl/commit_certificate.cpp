@@ -0,0 +1,90 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "consensus/yac/commit_certificate.hpp"
+#include <unordered_map>
+#include "common/byteutils.hpp"
+
+namespace iroha {
+  namespace consensus {
+    namespace yac {
+
+      nonstd::optional<CommitCertificate> makeCertificate(
+          const std::vector<VoteMessage> &votes,
+          const std::vector<model::Peer> &peers) {
+        if (votes.empty()) {
+          return nonstd::nullopt;
+        }
+        std::unordered_map<ed25519::pubkey_t, size_t> positions;
+        for (size_t i = 0; i < peers.size(); ++i) {
+          positions.emplace(peers[i].pubkey, i);
+        }
+
+        CommitCertificate certificate;
+        certificate.hash = votes.front().hash;
+        certificate.signers.resize((peers.size() + 7) / 8);
+        std::vector<const VoteMessage *> ordered(peers.size(), nullptr);
+        for (const auto &vote : votes) {
+          auto position = positions.find(vote.signature.pubkey);
+          if (vote.hash != certificate.hash or position == positions.end()
+              or ordered[position->second] != nullptr) {
+            return nonstd::nullopt;
+          }
+          ordered[position->second] = &vote;
+          certificate.signers[position->second / 8] |=
+              1u << (position->second % 8);
+        }
+        for (auto vote : ordered) {
+          if (vote != nullptr) {
+            certificate.signatures.push_back(vote->signature.signature);
+          }
+        }
+        return certificate;
+      }
+
+      nonstd::optional<std::vector<VoteMessage>> openCertificate(
+          const CommitCertificate &certificate,
+          const std::vector<model::Peer> &peers) {
+        if (certificate.signers.size() != (peers.size() + 7) / 8) {
+          return nonstd::nullopt;
+        }
+        std::vector<VoteMessage> votes;
+        for (size_t i = 0; i < peers.size(); ++i) {
+          if ((certificate.signers[i / 8] & (1u << (i % 8))) == 0) {
+            continue;
+          }
+          if (votes.size() == certificate.signatures.size()) {
+            return nonstd::nullopt;
+          }
+          VoteMessage vote;
+          vote.hash = certificate.hash;
+          vote.signature.pubkey = peers[i].pubkey;
+          vote.signature.signature = certificate.signatures[votes.size()];
+          votes.push_back(vote);
+        }
+        // bits beyond peer list and extra signatures are malformed input
+        auto tail = peers.size() % 8;
+        if (votes.size() != certificate.signatures.size()
+            or (tail != 0 and (certificate.signers.back() >> tail) != 0)) {
+          return nonstd::nullopt;
+        }
+        return votes;
+      }
+
+    }  // namespace yac
+  }    // namespace consensus
+}  // namespace iroha
@@ -0,0 +1,85 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "consensus/yac/impl/gossip.hpp"
+
+namespace iroha {
+  namespace consensus {
+    namespace yac {
+
+      std::vector<size_t> relayTargets(size_t self,
+                                       size_t origin,
+                                       size_t peers,
+                                       size_t fanout) {
+        std::vector<size_t> targets;
+        if (peers == 0 or fanout == 0 or self >= peers or origin >= peers) {
+          return targets;
+        }
+        auto relative = (self + peers - origin) % peers;
+        for (size_t i = 1; i <= fanout; ++i) {
+          auto child = relative * fanout + i;
+          if (child >= peers) {
+            break;
+          }
+          targets.push_back((child + origin) % peers);
+        }
+        return targets;
+      }
+
+      RecentMessages::RecentMessages(size_t capacity)
+          : capacity_(capacity) {}
+
+      bool RecentMessages::insert(const std::string &key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (not keys_.insert(key).second) {
+          return false;
+        }
+        order_.push_back(key);
+        if (order_.size() > capacity_) {
+          keys_.erase(order_.front());
+          order_.pop_front();
+        }
+        return true;
+      }
+
+      DuplicateFilter::DuplicateFilter(size_t capacity,
+                                       Clock::duration window)
+          : capacity_(capacity), window_(window) {}
+
+      bool DuplicateFilter::admit(const std::string &key,
+                                  Clock::time_point now) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto inserted = received_.emplace(key, now);
+        if (not inserted.second) {
+          auto &received = inserted.first->second;
+          if (now - received < window_) {
+            return false;
+          }
+          received = now;
+          return true;
+        }
+        order_.push_back(key);
+        if (order_.size() > capacity_) {
+          received_.erase(order_.front());
+          order_.pop_front();
+        }
+        return true;
+      }
+
+    }  // namespace yac
+  }    // namespace consensus
+}  // namespace iroha
@@ -0,0 +1,100 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_YAC_GOSSIP_HPP
+#define IROHA_YAC_GOSSIP_HPP
+
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace iroha {
+  namespace consensus {
+    namespace yac {
+
+      /**
+       * Positions of peers which receive message from given peer when
+       * message is broadcast over tree rooted at origin.
+       * Peers are numbered by common peer list, the tree is built over
+       * positions relative to origin, each node has up to fanout children.
+       * @param self - position of relaying peer
+       * @param origin - position of broadcasting peer
+       * @param peers - size of peer list
+       * @param fanout - number of children of each node
+       * @return positions of children of self
+       */
+      std::vector<size_t> relayTargets(size_t self,
+                                       size_t origin,
+                                       size_t peers,
+                                       size_t fanout);
+
+      /**
+       * Thread-safe bounded set of keys of recently delivered messages,
+       * oldest keys are forgotten first
+       */
+      class RecentMessages {
+       public:
+        explicit RecentMessages(size_t capacity);
+
+        /**
+         * Remember message key
+         * @return true if key has not been seen before
+         */
+        bool insert(const std::string &key);
+
+       private:
+        const size_t capacity_;
+        std::unordered_set<std::string> keys_;
+        std::deque<std::string> order_;
+        std::mutex mutex_;
+      };
+
+      /**
+       * Thread-safe filter of retransmitted messages.
+       * Copy of a message received within the window after the previous one
+       * is dropped, later copies pass, so peers which resend a message on
+       * timeout are still answered. Oldest keys are forgotten first.
+       */
+      class DuplicateFilter {
+       public:
+        using Clock = std::chrono::steady_clock;
+
+        DuplicateFilter(size_t capacity, Clock::duration window);
+
+        /**
+         * Check message key and remember when it was received
+         * @return true if message should be processed
+         */
+        bool admit(const std::string &key,
+                   Clock::time_point now = Clock::now());
+
+       private:
+        const size_t capacity_;
+        const Clock::duration window_;
+        std::unordered_map<std::string, Clock::time_point> received_;
+        std::deque<std::string> order_;
+        std::mutex mutex_;
+      };
+
+    }  // namespace yac
+  }    // namespace consensus
+}  // namespace iroha
+#endif  // IROHA_YAC_GOSSIP_HPP
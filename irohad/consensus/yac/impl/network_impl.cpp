@@ -17,6 +17,8 @@
 
 #include "consensus/yac/impl/network_impl.hpp"
 #include <grpc++/grpc++.h>
+#include "consensus/yac/commit_certificate.hpp"
+#include "crypto/hash.hpp"
 #include "logger/logger.hpp"
 
 using namespace logger;
@@ -25,14 +27,118 @@ namespace iroha {
   namespace consensus {
     namespace yac {
 
+      namespace {
+        void setHash(const YacHash &hash, proto::Hash *pb_hash) {
+          pb_hash->set_proposal(hash.proposal_hash.data(),
+                                hash.proposal_hash.size());
+          pb_hash->set_block(hash.block_hash.data(), hash.block_hash.size());
+        }
+
+        /**
+         * @return hash, nullopt if some part has wrong size
+         */
+        nonstd::optional<YacHash> parseHash(const proto::Hash &pb_hash) {
+          return YacHash::fromBytes(pb_hash.proposal(), pb_hash.block());
+        }
+
+        /**
+         * @return vote, nullopt if hash or signature has wrong size
+         */
+        nonstd::optional<VoteMessage> parseVote(const proto::Vote &pb_vote) {
+          const auto &pb_signature = pb_vote.signature();
+          auto hash = parseHash(pb_vote.hash());
+          if (not hash
+              or pb_signature.pubkey().size() != ed25519::pubkey_t::size()
+              or pb_signature.signature().size()
+                  != ed25519::sig_t::size()) {
+            return nonstd::nullopt;
+          }
+          VoteMessage vote;
+          vote.hash = *hash;
+          std::copy(pb_signature.signature().begin(),
+                    pb_signature.signature().end(),
+                    vote.signature.signature.begin());
+          std::copy(pb_signature.pubkey().begin(),
+                    pb_signature.pubkey().end(),
+                    vote.signature.pubkey.begin());
+          return vote;
+        }
+
+        /**
+         * Identity of relayed message, digest of all its votes with their
+         * signatures, so a copy with forged signatures does not shadow
+         * the genuine message
+         * @param kind - type of message
+         */
+        std::string relayKey(const std::string &kind,
+                             const std::vector<VoteMessage> &votes) {
+          std::string data;
+          for (const auto &vote : votes) {
+            data += vote.hash.proposal_hash.to_string()
+                + vote.hash.block_hash.to_string()
+                + vote.signature.pubkey.to_string()
+                + vote.signature.signature.to_string();
+          }
+          return kind
+              + sha3_256(reinterpret_cast<const uint8_t *>(data.data()),
+                         data.size())
+                    .to_string();
+        }
+      }  // namespace
+
+      constexpr std::chrono::milliseconds NetworkImpl::kVoteRetransmission;
+      constexpr std::chrono::seconds NetworkImpl::kBanDuration;
+
       NetworkImpl::NetworkImpl(const std::string &address,
-                               const std::vector<model::Peer> &peers)
-          : address_(address) {
-        for (const auto &peer : peers) {
-          peers_[peer] = proto::Yac::NewStub(grpc::CreateChannel(
-              peer.address, grpc::InsecureChannelCredentials()));
-          peers_addresses_[peer.address] = peer;
+                               const std::vector<model::Peer> &peers,
+                               bool compact_commits,
+                               size_t fanout,
+                               std::shared_ptr<network::ChannelRegistry>
+                                   channels)
+          : address_(address),
+            channels_(std::move(channels)),
+            compact_commits_(compact_commits),
+            fanout_(fanout),
+            relayed_(kRecentMessages),
+            votes_(kRecentVotes, kVoteRetransmission),
+            guard_(kPeerRate, kPeerBurst, kBanScore, kBanDuration) {
+        updatePeers(peers);
+      }
+
+      void NetworkImpl::updatePeers(const std::vector<model::Peer> &peers) {
+        auto peer_set = std::make_shared<PeerSet>();
+        peer_set->order = peers;
+        for (size_t i = 0; i < peers.size(); ++i) {
+          const auto &peer = peers[i];
+          peer_set->addresses[peer.address] = peer;
+          if (peer.address == address_) {
+            peer_set->self = i;
+          }
+        }
+        {
+          std::lock_guard<std::mutex> lock(stubs_mutex_);
+          for (auto it = peers_.begin(); it != peers_.end();) {
+            if (peer_set->addresses.count(it->first.address) == 0) {
+              it = peers_.erase(it);
+            } else {
+              ++it;
+            }
+          }
+          for (const auto &peer : peers) {
+            auto &stub = peers_[peer];
+            if (not stub) {
+              stub = proto::Yac::NewStub(channels_->channel(peer.address));
+            }
+          }
         }
+        std::lock_guard<std::mutex> lock(peer_set_mutex_);
+        peer_set_ = std::move(peer_set);
+      }
+
+      std::shared_ptr<const NetworkImpl::PeerSet> NetworkImpl::peerSet()
+          const {
+        std::lock_guard<std::mutex> lock(peer_set_mutex_);
+        return peer_set_;
       }
 
       void NetworkImpl::subscribe(
@@ -41,96 +147,209 @@ namespace iroha {
       }
 
       void NetworkImpl::send_commit(model::Peer to, CommitMessage commit) {
+        sendCommitRequest(to, makeCommitRequest(commit));
+      }
+
+      void NetworkImpl::broadcast_commit(const std::vector<model::Peer> &peers,
+                                         CommitMessage commit) {
+        auto request = makeCommitRequest(commit);
+        auto peer_set = peerSet();
+        if (fanout_ == 0 or not peer_set->self) {
+          // serialize once, the same request is sent to every peer
+          for (const auto &peer : peers) {
+            sendCommitRequest(peer, request);
+          }
+          return;
+        }
+        request.mutable_relay()->set_origin(*peer_set->self);
+        request.mutable_relay()->set_fanout(fanout_);
+        // this peer is the root of relay tree, it forwards message on receipt
+        sendCommitRequest(peer_set->order.at(*peer_set->self), request);
+      }
+
+      proto::Commit NetworkImpl::makeCommitRequest(
+          const CommitMessage &commit) {
         proto::Commit request;
-        for (const auto &vote : commit.votes) {
-          auto pb_vote = request.add_votes();
-          auto hash = pb_vote->mutable_hash();
-          hash->set_block(vote.hash.block_hash);
-          hash->set_proposal(vote.hash.proposal_hash);
-          auto signature = pb_vote->mutable_signature();
-          signature->set_signature(vote.signature.signature.data(),
-                                   vote.signature.signature.size());
-          signature->set_pubkey(vote.signature.pubkey.data(),
-                                vote.signature.pubkey.size());
+        auto certificate = compact_commits_
+            ? makeCertificate(commit.votes, peerSet()->order)
+            : nonstd::nullopt;
+        if (certificate) {
+          auto pb_certificate = request.mutable_certificate();
+          setHash(certificate->hash, pb_certificate->mutable_hash());
+          pb_certificate->set_signers(certificate->signers.data(),
+                                      certificate->signers.size());
+          for (const auto &signature : certificate->signatures) {
+            pb_certificate->add_signatures(signature.data(),
+                                           signature.size());
+          }
+        } else {
+          for (const auto &vote : commit.votes) {
+            auto pb_vote = request.add_votes();
+            setHash(vote.hash, pb_vote->mutable_hash());
+            auto signature = pb_vote->mutable_signature();
+            signature->set_signature(vote.signature.signature.data(),
+                                     vote.signature.signature.size());
+            signature->set_pubkey(vote.signature.pubkey.data(),
+                                  vote.signature.pubkey.size());
+          }
         }
+        return request;
+      }
 
-        auto call = new AsyncClientCall;
+      void NetworkImpl::sendCommitRequest(const model::Peer &to,
+                                          const proto::Commit &request) {
+        auto call = new AsyncClientCall(state_);
 
         call->context.AddMetadata("address", address_);
 
         call->response_reader =
-            peers_.at(to)->AsyncSendCommit(&call->context, request, &cq_);
+            stub(to)->AsyncSendCommit(&call->context, request, &cq_);
 
         call->response_reader->Finish(&call->reply, &call->status, call);
       }
 
       void NetworkImpl::send_reject(model::Peer to, RejectMessage reject) {
+        sendRejectRequest(to, makeRejectRequest(reject));
+      }
+
+      void NetworkImpl::broadcast_reject(const std::vector<model::Peer> &peers,
+                                         RejectMessage reject) {
+        auto request = makeRejectRequest(reject);
+        auto peer_set = peerSet();
+        if (fanout_ == 0 or not peer_set->self) {
+          for (const auto &peer : peers) {
+            sendRejectRequest(peer, request);
+          }
+          return;
+        }
+        request.mutable_relay()->set_origin(*peer_set->self);
+        request.mutable_relay()->set_fanout(fanout_);
+        sendRejectRequest(peer_set->order.at(*peer_set->self), request);
+      }
+
+      proto::Reject NetworkImpl::makeRejectRequest(
+          const RejectMessage &reject) {
         proto::Reject request;
         for (const auto &vote : reject.votes) {
           auto pb_vote = request.add_votes();
-          auto hash = pb_vote->mutable_hash();
-          hash->set_block(vote.hash.block_hash);
-          hash->set_proposal(vote.hash.proposal_hash);
+          setHash(vote.hash, pb_vote->mutable_hash());
           auto signature = pb_vote->mutable_signature();
           signature->set_signature(vote.signature.signature.data(),
                                    vote.signature.signature.size());
           signature->set_pubkey(vote.signature.pubkey.data(),
                                 vote.signature.pubkey.size());
         }
+        return request;
+      }
 
-        auto call = new AsyncClientCall;
+      void NetworkImpl::sendRejectRequest(const model::Peer &to,
+                                          const proto::Reject &request) {
+        auto call = new AsyncClientCall(state_);
 
         call->context.AddMetadata("address", address_);
 
         call->response_reader =
-            peers_.at(to)->AsyncSendReject(&call->context, request, &cq_);
+            stub(to)->AsyncSendReject(&call->context, request, &cq_);
 
         call->response_reader->Finish(&call->reply, &call->status, call);
       }
 
       void NetworkImpl::send_vote(model::Peer to, VoteMessage vote) {
-        proto::Vote request;
-        auto hash = request.mutable_hash();
-        hash->set_block(vote.hash.block_hash);
-        hash->set_proposal(vote.hash.proposal_hash);
+        // request is serialized when call starts, so its fields are
+        // reused by the next vote sent from this thread
+        thread_local proto::Vote request;
+        setHash(vote.hash, request.mutable_hash());
         auto signature = request.mutable_signature();
         signature->set_signature(vote.signature.signature.data(),
                                  vote.signature.signature.size());
         signature->set_pubkey(vote.signature.pubkey.data(),
                               vote.signature.pubkey.size());
 
-        auto call = new AsyncClientCall;
+        auto call = new AsyncClientCall(state_);
 
         call->context.AddMetadata("address", address_);
 
         call->response_reader =
-            peers_.at(to)->AsyncSendVote(&call->context, request, &cq_);
+            stub(to)->AsyncSendVote(&call->context, request, &cq_);
 
         call->response_reader->Finish(&call->reply, &call->status, call);
       }
 
+      void NetworkImpl::report_invalid(const model::Peer &from) {
+        guard_.penalize(from.address, PeerGuard::Offence::InvalidSignature);
+      }
+
+      grpc::Status NetworkImpl::admit(const grpc::ServerContext &context,
+                                      model::Peer &peer) {
+        auto it = context.client_metadata().find("address");
+        if (it == context.client_metadata().end()) {
+          return grpc::Status(grpc::StatusCode::UNAUTHENTICATED,
+                              "missing source address");
+        }
+        auto address = std::string(it->second.data(), it->second.size());
+        auto peer_set = peerSet();
+        auto known = peer_set->addresses.find(address);
+        if (known == peer_set->addresses.end()) {
+          return grpc::Status(grpc::StatusCode::PERMISSION_DENIED,
+                              "unknown peer");
+        }
+        if (not guard_.admit(address)) {
+          return grpc::Status(grpc::StatusCode::RESOURCE_EXHAUSTED,
+                              "peer is rate limited");
+        }
+        peer = known->second;
+        return grpc::Status::OK;
+      }
+
+      grpc::Status NetworkImpl::malformed(const model::Peer &peer,
+                                          const std::string &error) {
+        guard_.penalize(peer.address, PeerGuard::Offence::Malformed);
+        return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, error);
+      }
+
+      std::shared_ptr<proto::Yac::Stub> NetworkImpl::stub(
+          const model::Peer &peer) {
+        std::lock_guard<std::mutex> lock(stubs_mutex_);
+        auto &stub = peers_[peer];
+        if (not stub) {
+          // peer is not known yet, its channel may be already opened
+          // by other components
+          stub = proto::Yac::NewStub(channels_->channel(peer.address));
+        }
+        return stub;
+      }
+
       grpc::Status NetworkImpl::SendVote(
           ::grpc::ServerContext *context,
           const ::iroha::consensus::yac::proto::Vote *request,
           ::google::protobuf::Empty *response) {
-        auto it = context->client_metadata().find("address");
-        if (it == context->client_metadata().end()) {
-          // TODO handle missing source address
+        model::Peer peer;
+        auto admission = admit(*context, peer);
+        if (not admission.ok()) {
+          return admission;
         }
-        auto address = std::string(it->second.data(), it->second.size());
-        auto peer = peers_addresses_.at(address);
-
-        VoteMessage vote;
-        vote.hash.proposal_hash = request->hash().proposal();
-        vote.hash.block_hash = request->hash().block();
-        std::copy(request->signature().signature().begin(),
-                  request->signature().signature().end(),
-                  vote.signature.signature.begin());
-        std::copy(request->signature().pubkey().begin(),
-                  request->signature().pubkey().end(),
-                  vote.signature.pubkey.begin());
-
-        handler_.lock()->on_vote(peer, vote);
+
+        const auto &pb_hash = request->hash();
+        const auto &pb_signature = request->signature();
+        if (pb_signature.pubkey().size() != ed25519::pubkey_t::size()
+            or pb_signature.signature().size() != ed25519::sig_t::size()) {
+          return malformed(peer, "malformed signature");
+        }
+        // drop retransmitted copies before decoding and verification;
+        // signature is a part of the key, so a forged copy can not shadow
+        // the genuine vote
+        if (not votes_.admit(pb_signature.pubkey() + pb_signature.signature()
+                             + pb_hash.proposal() + pb_hash.block())) {
+          guard_.penalize(peer.address, PeerGuard::Offence::Duplicate);
+          return grpc::Status::OK;
+        }
+
+        auto vote = parseVote(*request);
+        if (not vote) {
+          return malformed(peer, "malformed vote");
+        }
+
+        handler_.lock()->on_vote(peer, *vote);
         return grpc::Status::OK;
       }
 
@@ -138,25 +357,57 @@ namespace iroha {
           ::grpc::ServerContext *context,
           const ::iroha::consensus::yac::proto::Commit *request,
           ::google::protobuf::Empty *response) {
-        auto it = context->client_metadata().find("address");
-        if (it == context->client_metadata().end()) {
-          // TODO handle missing source address
+        model::Peer peer;
+        auto admission = admit(*context, peer);
+        if (not admission.ok()) {
+          return admission;
         }
-        auto address = std::string(it->second.data(), it->second.size());
-        auto peer = peers_addresses_.at(address);
 
         CommitMessage commit;
+        if (request->has_certificate()) {
+          const auto &pb_certificate = request->certificate();
+          auto hash = parseHash(pb_certificate.hash());
+          if (not hash) {
+            return malformed(peer, "malformed hash");
+          }
+          CommitCertificate certificate;
+          certificate.hash = *hash;
+          certificate.signers.assign(pb_certificate.signers().begin(),
+                                     pb_certificate.signers().end());
+          for (const auto &pb_signature : pb_certificate.signatures()) {
+            ed25519::sig_t signature;
+            if (pb_signature.size() != signature.size()) {
+              return malformed(peer, "malformed signature");
+            }
+            std::copy(pb_signature.begin(), pb_signature.end(),
+                      signature.begin());
+            certificate.signatures.push_back(signature);
+          }
+          auto votes = openCertificate(certificate, peerSet()->order);
+          if (not votes) {
+            return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT,
+                                "certificate does not match peer list");
+          }
+          commit.votes = std::move(*votes);
+        }
+        commit.votes.reserve(commit.votes.size() + request->votes_size());
         for (const auto &pb_vote : request->votes()) {
-          VoteMessage vote;
-          vote.hash.proposal_hash = pb_vote.hash().proposal();
-          vote.hash.block_hash = pb_vote.hash().block();
-          std::copy(pb_vote.signature().signature().begin(),
-                    pb_vote.signature().signature().end(),
-                    vote.signature.signature.begin());
-          std::copy(pb_vote.signature().pubkey().begin(),
-                    pb_vote.signature().pubkey().end(),
-                    vote.signature.pubkey.begin());
-          commit.votes.push_back(vote);
+          auto vote = parseVote(pb_vote);
+          if (not vote) {
+            return malformed(peer, "malformed vote");
+          }
+          commit.votes.push_back(*vote);
+        }
+
+        if (request->has_relay()) {
+          auto hops =
+              relayHops(request->relay(), relayKey("commit", commit.votes));
+          if (not hops) {
+            return grpc::Status::OK;
+          }
+          for (const auto &hop : *hops) {
+            sendCommitRequest(hop, *request);
+          }
         }
 
         handler_.lock()->on_commit(peer, commit);
@@ -167,31 +418,55 @@ namespace iroha {
           ::grpc::ServerContext *context,
           const ::iroha::consensus::yac::proto::Reject *request,
           ::google::protobuf::Empty *response) {
-        auto it = context->client_metadata().find("address");
-        if (it == context->client_metadata().end()) {
-          // TODO handle missing source address
+        model::Peer peer;
+        auto admission = admit(*context, peer);
+        if (not admission.ok()) {
+          return admission;
         }
-        auto address = std::string(it->second.data(), it->second.size());
-        auto peer = peers_addresses_.at(address);
 
         RejectMessage reject;
+        reject.votes.reserve(request->votes_size());
         for (const auto &pb_vote : request->votes()) {
-          VoteMessage vote;
-          vote.hash.proposal_hash = pb_vote.hash().proposal();
-          vote.hash.block_hash = pb_vote.hash().block();
-          std::copy(pb_vote.signature().signature().begin(),
-                    pb_vote.signature().signature().end(),
-                    vote.signature.signature.begin());
-          std::copy(pb_vote.signature().pubkey().begin(),
-                    pb_vote.signature().pubkey().end(),
-                    vote.signature.pubkey.begin());
-          reject.votes.push_back(vote);
+          auto vote = parseVote(pb_vote);
+          if (not vote) {
+            return malformed(peer, "malformed vote");
+          }
+          reject.votes.push_back(*vote);
+        }
+
+        if (request->has_relay()) {
+          auto hops =
+              relayHops(request->relay(), relayKey("reject", reject.votes));
+          if (not hops) {
+            return grpc::Status::OK;
+          }
+          for (const auto &hop : *hops) {
+            sendRejectRequest(hop, *request);
+          }
         }
 
         handler_.lock()->on_reject(peer, reject);
         return grpc::Status::OK;
       }
 
+      nonstd::optional<std::vector<model::Peer>> NetworkImpl::relayHops(
+          const proto::Relay &relay, const std::string &key) {
+        if (not relayed_.insert(key)) {
+          return nonstd::nullopt;
+        }
+        std::vector<model::Peer> hops;
+        auto peer_set = peerSet();
+        if (peer_set->self) {
+          for (auto position : relayTargets(*peer_set->self,
+                                            relay.origin(),
+                                            peer_set->order.size(),
+                                            relay.fanout())) {
+            hops.push_back(peer_set->order.at(position));
+          }
+        }
+        return hops;
+      }
+
     }  // namespace yac
   }    // namespace consensus
 }  // namespace iroha
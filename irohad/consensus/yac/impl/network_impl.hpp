@@ -19,9 +19,14 @@
 #define IROHA_NETWORK_IMPL_HPP
 
 #include <atomic>
+#include <mutex>
 #include <thread>
 #include <unordered_map>
+#include <nonstd/optional.hpp>
 #include "network/impl/async_grpc_client.hpp"
+#include "network/impl/channel_registry.hpp"
+#include "consensus/yac/impl/gossip.hpp"
+#include "consensus/yac/impl/peer_guard.hpp"
 #include "consensus/yac/yac_network_interface.hpp"
 #include "yac.grpc.pb.h"
 
@@ -33,13 +38,40 @@ namespace iroha {
                           public proto::Yac::Service,
                           network::AsyncGrpcClient<google::protobuf::Empty> {
        public:
-        explicit NetworkImpl(const std::string &address,
-                             const std::vector<model::Peer> &peers);
+        /**
+         * @param address - address of this peer
+         * @param peers - peer list, its order defines signer bitmaps
+         * @param compact_commits - send commits as certificates
+         * @param fanout - broadcast commits and rejects over relay tree
+         * with given number of children per peer, 0 sends them to every
+         * peer directly
+         * @param channels - registry of peer channels, shared with other
+         * components
+         */
+        NetworkImpl(const std::string &address,
+                    const std::vector<model::Peer> &peers,
+                    bool compact_commits = false,
+                    size_t fanout = 0,
+                    std::shared_ptr<network::ChannelRegistry> channels =
+                        std::make_shared<network::ChannelRegistry>());
         void subscribe(
             std::shared_ptr<YacNetworkNotifications> handler) override;
         void send_commit(model::Peer to, CommitMessage commit) override;
         void send_reject(model::Peer to, RejectMessage reject) override;
         void send_vote(model::Peer to, VoteMessage vote) override;
+        void broadcast_commit(const std::vector<model::Peer> &peers,
+                              CommitMessage commit) override;
+        void broadcast_reject(const std::vector<model::Peer> &peers,
+                              RejectMessage reject) override;
+        void report_invalid(const model::Peer &from) override;
+
+        /**
+         * Replace peer list after it is changed by committed block.
+         * Requests being processed keep the list they have started with,
+         * stubs of removed peers are released
+         * @param peers - new peer list, its order defines signer bitmaps
+         */
+        void updatePeers(const std::vector<model::Peer> &peers);
 
         /*
          * gRPC server methods
@@ -58,12 +90,106 @@ namespace iroha {
             ::google::protobuf::Empty *response) override;
 
        private:
+        /**
+         * Immutable list of peers, replaced as a whole on change
+         */
+        struct PeerSet {
+          std::vector<model::Peer> order;
+          std::unordered_map<std::string, model::Peer> addresses;
+          // position of this peer in order
+          nonstd::optional<size_t> self;
+        };
+
+        /**
+         * Number of remembered relayed messages, used for deduplication
+         */
+        static constexpr size_t kRecentMessages = 1024;
+
+        /**
+         * Number of remembered votes, used for dropping retransmissions
+         */
+        static constexpr size_t kRecentVotes = 4096;
+
+        /**
+         * Copies of a vote received within this window are retransmissions:
+         * peers resend a vote to the same peer only after a voting delay
+         * elapses
+         */
+        static constexpr std::chrono::milliseconds kVoteRetransmission{100};
+
+        /**
+         * Sustained and burst number of messages accepted from one peer
+         * per second, well above what honest peer sends
+         */
+        static constexpr double kPeerRate = 200;
+        static constexpr double kPeerBurst = 400;
+
+        /**
+         * Misbehaviour score at which peer is ignored for ban duration,
+         * e.g. five messages with invalid signatures
+         */
+        static constexpr double kBanScore = 100;
+        static constexpr std::chrono::seconds kBanDuration{30};
+
+        /**
+         * Identify sender of request and take its rate limit token
+         * @param context - context of request
+         * @param peer - set to sender on success
+         * @return OK if request should be processed, error status otherwise
+         */
+        grpc::Status admit(const grpc::ServerContext &context,
+                           model::Peer &peer);
+
+        /**
+         * Penalize peer for undecodable message
+         * @return status of rejected request
+         */
+        grpc::Status malformed(const model::Peer &peer,
+                               const std::string &error);
+
+        proto::Commit makeCommitRequest(const CommitMessage &commit);
+        proto::Reject makeRejectRequest(const RejectMessage &reject);
+        void sendCommitRequest(const model::Peer &to,
+                               const proto::Commit &request);
+        void sendRejectRequest(const model::Peer &to,
+                               const proto::Reject &request);
+
+        /**
+         * Get stub of given peer, creating it for peers unknown to the
+         * list, which may be removed by the next update
+         */
+        std::shared_ptr<proto::Yac::Stub> stub(const model::Peer &peer);
+
+        /**
+         * Check whether relayed message is new and compute next hops
+         * @param relay - relay parameters of message
+         * @param key - identity of message
+         * @return peers to forward message to, nullopt if message is
+         * a duplicate or has invalid parameters
+         */
+        nonstd::optional<std::vector<model::Peer>> relayHops(
+            const proto::Relay &relay, const std::string &key);
+
+        /**
+         * @return current list of peers
+         */
+        std::shared_ptr<const PeerSet> peerSet() const;
+
         std::string address_;
-        std::unordered_map<model::Peer, std::unique_ptr<proto::Yac::Stub>>
+        std::shared_ptr<network::ChannelRegistry> channels_;
+        std::unordered_map<model::Peer, std::shared_ptr<proto::Yac::Stub>>
             peers_;
+        std::mutex stubs_mutex_;
         std::weak_ptr<YacNetworkNotifications> handler_;
 
-        std::unordered_map<std::string, model::Peer> peers_addresses_;
+        std::shared_ptr<const PeerSet> peer_set_;
+        mutable std::mutex peer_set_mutex_;
+
+        bool compact_commits_;
+        size_t fanout_;
+        RecentMessages relayed_;
+        DuplicateFilter votes_;
+        PeerGuard guard_;
       };
 
     }  // namespace yac
@@ -0,0 +1,103 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "consensus/yac/impl/peer_guard.hpp"
+#include <algorithm>
+
+namespace iroha {
+  namespace consensus {
+    namespace yac {
+
+      constexpr double PeerGuard::kScoreDecay;
+
+      PeerGuard::PeerGuard(double rate,
+                           double burst,
+                           double ban_score,
+                           Clock::duration ban)
+          : rate_(rate), burst_(burst), ban_score_(ban_score), ban_(ban) {}
+
+      bool PeerGuard::admit(const std::string &peer, Clock::time_point now) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto &peer_state = state(peer, now);
+        if (now < peer_state.banned_until) {
+          return false;
+        }
+        if (peer_state.tokens < 1) {
+          offend(peer_state, Offence::Flood, now);
+          return false;
+        }
+        peer_state.tokens -= 1;
+        return true;
+      }
+
+      void PeerGuard::penalize(const std::string &peer,
+                               Offence offence,
+                               Clock::time_point now) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto &peer_state = state(peer, now);
+        if (now < peer_state.banned_until) {
+          return;
+        }
+        offend(peer_state, offence, now);
+      }
+
+      bool PeerGuard::banned(const std::string &peer, Clock::time_point now) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return now < state(peer, now).banned_until;
+      }
+
+      PeerGuard::State &PeerGuard::state(const std::string &peer,
+                                         Clock::time_point now) {
+        auto inserted = peers_.emplace(peer, State{burst_, 0, now, {}});
+        auto &peer_state = inserted.first->second;
+        if (now > peer_state.updated) {
+          auto elapsed =
+              std::chrono::duration<double>(now - peer_state.updated).count();
+          peer_state.tokens =
+              std::min(burst_, peer_state.tokens + elapsed * rate_);
+          peer_state.score =
+              std::max(0.0, peer_state.score - elapsed * kScoreDecay);
+          peer_state.updated = now;
+        }
+        return peer_state;
+      }
+
+      void PeerGuard::offend(State &peer_state,
+                             Offence offence,
+                             Clock::time_point now) const {
+        peer_state.score += weight(offence);
+        if (peer_state.score >= ban_score_) {
+          peer_state.score = 0;
+          peer_state.banned_until = now + ban_;
+        }
+      }
+
+      double PeerGuard::weight(Offence offence) {
+        switch (offence) {
+          case Offence::Flood:
+          case Offence::Duplicate:
+            return 1;
+          case Offence::Malformed:
+          case Offence::InvalidSignature:
+            return 20;
+        }
+        return 0;
+      }
+
+    }  // namespace yac
+  }    // namespace consensus
+}  // namespace iroha
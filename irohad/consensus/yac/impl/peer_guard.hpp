@@ -0,0 +1,123 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_YAC_PEER_GUARD_HPP
+#define IROHA_YAC_PEER_GUARD_HPP
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace iroha {
+  namespace consensus {
+    namespace yac {
+
+      /**
+       * Thread-safe admission control of messages from peers.
+       * Every peer has a token bucket, which limits rate of its messages,
+       * and a misbehaviour score. Score grows with offences and decays
+       * over time, peer whose score reaches the limit is ignored for
+       * a while, then its score starts from zero.
+       */
+      class PeerGuard {
+       public:
+        using Clock = std::chrono::steady_clock;
+
+        enum class Offence {
+          // message exceeded rate limit
+          Flood,
+          // copy of recent message
+          Duplicate,
+          // message can not be decoded
+          Malformed,
+          // message failed signature verification
+          InvalidSignature
+        };
+
+        /**
+         * Score lost by peer every second
+         */
+        static constexpr double kScoreDecay = 1.0;
+
+        /**
+         * @param rate - sustained number of messages per second
+         * @param burst - number of messages accepted at once
+         * @param ban_score - score at which peer is ignored
+         * @param ban - time during which peer is ignored
+         */
+        PeerGuard(double rate,
+                  double burst,
+                  double ban_score,
+                  Clock::duration ban);
+
+        /**
+         * Take a token of peer for incoming message. Message over the rate
+         * limit is a flood offence.
+         * @return true if message should be processed
+         */
+        bool admit(const std::string &peer,
+                   Clock::time_point now = Clock::now());
+
+        /**
+         * Add score of offence to peer
+         */
+        void penalize(const std::string &peer,
+                      Offence offence,
+                      Clock::time_point now = Clock::now());
+
+        /**
+         * @return true if messages of peer are ignored now
+         */
+        bool banned(const std::string &peer,
+                    Clock::time_point now = Clock::now());
+
+       private:
+        struct State {
+          double tokens;
+          double score;
+          Clock::time_point updated;
+          Clock::time_point banned_until;
+        };
+
+        /**
+         * Get state of peer with tokens and score brought up to now.
+         * Must be called under lock.
+         */
+        State &state(const std::string &peer, Clock::time_point now);
+
+        /**
+         * Add score of offence, banning peer on reaching the limit
+         */
+        void offend(State &peer_state,
+                    Offence offence,
+                    Clock::time_point now) const;
+
+        static double weight(Offence offence);
+
+        const double rate_;
+        const double burst_;
+        const double ban_score_;
+        const Clock::duration ban_;
+        std::unordered_map<std::string, State> peers_;
+        std::mutex mutex_;
+      };
+
+    }  // namespace yac
+  }    // namespace consensus
+}  // namespace iroha
+#endif  // IROHA_YAC_PEER_GUARD_HPP
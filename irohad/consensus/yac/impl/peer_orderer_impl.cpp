@@ -16,19 +16,24 @@
  */
 
 #include "consensus/yac/impl/peer_orderer_impl.hpp"
+#include <random>
 
 namespace iroha {
   namespace consensus {
     namespace yac {
 
       PeerOrdererImpl::PeerOrdererImpl(
-          std::shared_ptr<ametsuchi::WsvQuery> query)
-          : query_(std::move(query)) {}
+          std::shared_ptr<ametsuchi::WsvQuery> query,
+          std::shared_ptr<ametsuchi::BlockQuery> block_query,
+          std::shared_ptr<network::PeerHealth> health)
+          : query_(std::move(query)),
+            block_query_(std::move(block_query)),
+            health_(std::move(health)) {}
 
       nonstd::optional<ClusterOrdering> PeerOrdererImpl::getInitialOrdering() {
-        auto peers = query_->getPeers();
+        auto peers = this->peers();
         if (peers.has_value()) {
-          return ClusterOrdering(peers.value());
+          return order(peers.value());
         }
 
         return nonstd::nullopt;
@@ -36,15 +41,54 @@ namespace iroha {
 
       nonstd::optional<ClusterOrdering> PeerOrdererImpl::getOrdering(
           YacHash hash) {
-        auto peers = query_->getPeers();
+        auto peers = this->peers();
         if (peers.has_value()) {
-          // todo implement effective ordering based on hash value
-          return ClusterOrdering(peers.value());
+          return order(permute(std::move(peers.value()),
+                               hash.proposal_hash.to_string()));
         }
 
         return nonstd::nullopt;
       }
 
+      ClusterOrdering PeerOrdererImpl::order(std::vector<model::Peer> peers) {
+        // only grades reorder the permutation, so peers which agree on
+        // health of the network still agree on leaders
+        if (health_) {
+          peers = health_->leaderOrder(std::move(peers));
+        }
+        return ClusterOrdering(std::move(peers));
+      }
+
+      std::vector<model::Peer> PeerOrdererImpl::permute(
+          std::vector<model::Peer> peers, const std::string &seed) {
+        // seed_seq and mt19937 are fully specified by the standard, unlike
+        // distributions and std::shuffle, so all peers get the same order
+        std::seed_seq seq(seed.begin(), seed.end());
+        std::mt19937 generator(seq);
+        for (auto i = peers.size(); i > 1; --i) {
+          std::swap(peers[i - 1], peers[generator() % i]);
+        }
+        return peers;
+      }
+
+      nonstd::optional<std::vector<model::Peer>> PeerOrdererImpl::peers() {
+        if (not block_query_) {
+          return query_->getPeers();
+        }
+        // every commit changes the height, including ones with peer commands
+        auto height = block_query_->getTopBlockHeight();
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        if (not cached_peers_ or cached_height_ != height) {
+          auto peers = query_->getPeers();
+          if (not peers) {
+            return nonstd::nullopt;
+          }
+          cached_peers_ = std::move(peers);
+          cached_height_ = height;
+        }
+        return cached_peers_;
+      }
+
     }  // namespace yac
   }    // namespace consensus
 }  // namespace iroha
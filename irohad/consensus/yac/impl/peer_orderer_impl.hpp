@@ -18,24 +18,70 @@
 #ifndef IROHA_PEER_ORDERER_IMPL_HPP
 #define IROHA_PEER_ORDERER_IMPL_HPP
 
+#include <mutex>
+#include "ametsuchi/block_query.hpp"
 #include "ametsuchi/wsv_query.hpp"
 #include "consensus/yac/yac_peer_orderer.hpp"
+#include "network/impl/peer_health.hpp"
 
 namespace iroha {
   namespace consensus {
     namespace yac {
 
+      /**
+       * Orderer which keeps peers of the ledger in memory until the next
+       * commit, so ordering of a round does not require reading of wsv
+       */
       class PeerOrdererImpl : public YacPeerOrderer {
        public:
-        explicit PeerOrdererImpl(std::shared_ptr<ametsuchi::WsvQuery> query);
+        /**
+         * @param query - source of peers
+         * @param block_query - source of ledger height, which is a key of
+         * cached peers. When not set, peers are read on every call
+         * @param health - health of peers, when set slow and unresponsive
+         * peers are moved behind healthy ones in every ordering
+         */
+        explicit PeerOrdererImpl(
+            std::shared_ptr<ametsuchi::WsvQuery> query,
+            std::shared_ptr<ametsuchi::BlockQuery> block_query = nullptr,
+            std::shared_ptr<network::PeerHealth> health = nullptr);
 
         nonstd::optional<ClusterOrdering> getInitialOrdering() override;
 
+        /**
+         * Provide peers shuffled with proposal hash as a seed, so all peers
+         * voting for the same proposal select the same leaders
+         */
         nonstd::optional<ClusterOrdering> getOrdering(YacHash hash) override;
 
+        /**
+         * Deterministic permutation of peers, which does not depend on
+         * standard library implementation
+         * @param peers - peers to shuffle
+         * @param seed - bytes of seed
+         * @return shuffled peers
+         */
+        static std::vector<model::Peer> permute(std::vector<model::Peer> peers,
+                                                const std::string &seed);
+
        private:
+        /**
+         * @return peers of the ledger, cached for current height
+         */
+        nonstd::optional<std::vector<model::Peer>> peers();
+
+        /**
+         * @return ordering of peers, demoted by health when it is known
+         */
+        ClusterOrdering order(std::vector<model::Peer> peers);
+
         std::shared_ptr<ametsuchi::WsvQuery> query_;
-        std::shared_ptr<YacHashProvider> hash_provider_;
+        std::shared_ptr<ametsuchi::BlockQuery> block_query_;
+        std::shared_ptr<network::PeerHealth> health_;
+
+        std::mutex cache_mutex_;
+        nonstd::optional<std::vector<model::Peer>> cached_peers_;
+        uint32_t cached_height_ = 0;
       };
 
     }  // namespace yac
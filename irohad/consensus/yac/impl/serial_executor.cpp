@@ -0,0 +1,56 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "consensus/yac/impl/serial_executor.hpp"
+
+namespace iroha {
+  namespace consensus {
+    namespace yac {
+
+      SerialExecutor::SerialExecutor(size_t capacity)
+          : tasks_(capacity), thread_(&SerialExecutor::run, this) {}
+
+      void SerialExecutor::post(Task task) {
+        if (std::this_thread::get_id() == thread_.get_id()) {
+          nested_.push_back(std::move(task));
+          return;
+        }
+        tasks_.push(std::move(task));
+      }
+
+      void SerialExecutor::run() {
+        Task task;
+        while (not stopped_ and tasks_.pop(task)) {
+          task();
+          while (not stopped_ and not nested_.empty()) {
+            task = std::move(nested_.front());
+            nested_.pop_front();
+            task();
+          }
+        }
+      }
+
+      SerialExecutor::~SerialExecutor() {
+        stopped_ = true;
+        tasks_.close();
+        if (thread_.joinable()) {
+          thread_.join();
+        }
+      }
+    }  // namespace yac
+  }    // namespace consensus
+}  // namespace iroha
@@ -0,0 +1,69 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_SERIAL_EXECUTOR_HPP
+#define IROHA_SERIAL_EXECUTOR_HPP
+
+#include <atomic>
+#include <deque>
+#include <thread>
+#include "consensus/yac/executor.hpp"
+#include "ring_buffer/ring_buffer.hpp"
+
+namespace iroha {
+  namespace consensus {
+    namespace yac {
+
+      /**
+       * Executor with dedicated thread.
+       * Producers push to bounded lock-free queue and wait while it is
+       * full, so network and timer threads are slowed down instead of
+       * piling up tasks when consensus falls behind. Tasks posted by
+       * tasks themselves bypass the queue and run right after the
+       * posting task, so the executor never waits for itself.
+       * Tasks left in queue on destruction are dropped, so executor must
+       * not be destroyed by its own task.
+       */
+      class SerialExecutor : public Executor {
+       public:
+        static constexpr size_t kDefaultCapacity = 4096;
+
+        /**
+         * @param capacity - max number of tasks waiting in queue
+         */
+        explicit SerialExecutor(size_t capacity = kDefaultCapacity);
+
+        SerialExecutor(const SerialExecutor &) = delete;
+        SerialExecutor &operator=(const SerialExecutor &) = delete;
+
+        void post(Task task) override;
+
+        ~SerialExecutor() override;
+
+       private:
+        void run();
+
+        MpmcRingBuffer<Task> tasks_;
+        // tasks posted by tasks, accessed by executor thread only
+        std::deque<Task> nested_;
+        std::atomic<bool> stopped_{false};
+        std::thread thread_;
+      };
+    }  // namespace yac
+  }    // namespace consensus
+}  // namespace iroha
+#endif  // IROHA_SERIAL_EXECUTOR_HPP
@@ -18,6 +18,7 @@
 #include <utility>
 
 #include "consensus/yac/yac.hpp"
+#include "consensus/round_tracer.hpp"
 
 namespace iroha {
   namespace consensus {
@@ -29,13 +30,22 @@ namespace iroha {
           std::shared_ptr<YacCryptoProvider> crypto,
           std::shared_ptr<Timer> timer,
           ClusterOrdering order,
-          uint64_t delay) {
+          uint64_t delay,
+          std::shared_ptr<Executor> executor,
+          std::shared_ptr<VoteVerifier> verifier,
+          std::shared_ptr<network::PeerHealth> health) {
+        if (not verifier) {
+          verifier = std::make_shared<InlineVoteVerifier>(crypto);
+        }
         return std::make_shared<Yac>(vote_storage,
                                      network,
                                      crypto,
                                      timer,
                                      order,
-                                     delay);
+                                     delay,
+                                     executor,
+                                     verifier,
+                                     health);
       }
 
       Yac::Yac(YacVoteStorage vote_storage,
@@ -43,19 +53,30 @@ namespace iroha {
                std::shared_ptr<YacCryptoProvider> crypto,
                std::shared_ptr<Timer> timer,
                ClusterOrdering order,
-               uint64_t delay)
+               uint64_t delay,
+               std::shared_ptr<Executor> executor,
+               std::shared_ptr<VoteVerifier> verifier,
+               std::shared_ptr<network::PeerHealth> health)
           : vote_storage_(std::move(vote_storage)),
             network_(std::move(network)),
             crypto_(std::move(crypto)),
             timer_(std::move(timer)),
+            health_(std::move(health)),
             cluster_order_(order),
-            delay_(delay) {}
+            delay_(delay),
+            executor_(std::move(executor)),
+            verifier_(std::move(verifier)) {
+        log_ = logger::log("YAC");
+      }
 
       // ------|Hash gate|------
 
       void Yac::vote(YacHash hash, ClusterOrdering order) {
-        this->cluster_order_ = order;
-        votingStep(hash);
+        executor_->post([this, hash, order] {
+          this->cluster_order_ = order;
+          voted_at_ = std::chrono::steady_clock::now();
+          votingStep(hash);
+        });
       };
 
       rxcpp::observable<CommitMessage> Yac::on_commit() {
@@ -65,21 +86,50 @@ namespace iroha {
       // ------|Network notifications|------
 
       void Yac::on_vote(model::Peer from, VoteMessage vote) {
-        if (crypto_->verify(vote)) {
-          this->applyVote(from, vote);
-        }
+        executor_->post([this, from, vote] {
+          // voter of decided round only needs the outcome, its vote can not
+          // change anything, so it is not verified
+          auto decided = vote_storage_.findProposal(vote.hash);
+          if (decided and decided->state != CommitState::not_committed) {
+            answerDecided(from, decided->answer);
+            return;
+          }
+          verifier_->verify(vote,
+                            [this, from, vote] {
+                              executor_->post([this, from, vote] {
+                                this->applyVote(from, vote);
+                              });
+                            },
+                            [this, from] { network_->report_invalid(from); });
+        });
       }
 
       void Yac::on_commit(model::Peer from, CommitMessage commit) {
-        if (crypto_->verify(commit)) {
-          this->applyCommit(from, commit);
-        }
+        executor_->post([this, from, commit] {
+          if (crypto_->verify(commit)) {
+            this->applyCommit(from, commit);
+          } else {
+            network_->report_invalid(from);
+          }
+        });
       }
 
       void Yac::on_reject(model::Peer from, RejectMessage reject) {
-        if (crypto_->verify(reject)) {
-          this->applyReject(from, reject);
-        }
+        executor_->post([this, from, reject] {
+          if (crypto_->verify(reject)) {
+            this->applyReject(from, reject);
+          } else {
+            network_->report_invalid(from);
+          }
+        });
+      }
+
+      void Yac::setDelay(uint64_t delay) {
+        executor_->post([this, delay] { delay_ = delay; });
+      }
+
+      size_t Yac::votesMemory() const {
+        return votes_memory_;
       }
 
       // ------|Private interface|------
@@ -90,18 +140,64 @@ namespace iroha {
             proposal.value().state == CommitState::committed) {
           return;
         }
-        network_->send_vote(cluster_order_.currentLeader(),
-                            crypto_->getVote(hash));
-        timer_->invokeAfterDelay(delay_, [this, hash]() {
-          cluster_order_.switchToNext();
-          if (cluster_order_.hasNext()) {
-            this->votingStep(hash);
-          }
+        auto leader = cluster_order_.currentLeader();
+        sendVote(leader, hash);
+        awaited_leader_ = std::make_pair(leader,
+                                         std::chrono::steady_clock::now());
+        timer_->invokeAfterDelay(timer_->delayFor(leader, delay_),
+                                 [this, hash, leader]() {
+          executor_->post([this, hash, leader] {
+            timer_->onTimeout(leader);
+            if (health_) {
+              health_->onTimeout(leader.pubkey);
+            }
+            awaited_leader_ = nonstd::nullopt;
+            cluster_order_.switchToNext();
+            if (cluster_order_.hasNext()) {
+              this->votingStep(hash);
+            }
+          });
+        });
+      }
+
+      void Yac::sendVote(model::Peer to, YacHash hash) {
+        if (own_vote_ and own_vote_->hash == hash) {
+          network_->send_vote(to, *own_vote_);
+          return;
+        }
+        // signer may be remote, so the vote is sent when signature arrives
+        crypto_->getVoteAsync(hash, [this, to](VoteMessage vote) {
+          executor_->post([this, to, vote] {
+            own_vote_ = vote;
+            network_->send_vote(to, vote);
+          });
         });
       }
 
+      void Yac::answerReceived() {
+        if (not awaited_leader_) {
+          return;
+        }
+        auto elapsed = std::chrono::steady_clock::now()
+            - awaited_leader_->second;
+        auto millis =
+            std::chrono::duration_cast<std::chrono::milliseconds>(elapsed)
+                .count();
+        timer_->onAnswer(awaited_leader_->first, millis);
+        if (health_) {
+          health_->onAnswer(awaited_leader_->first.pubkey, millis);
+        }
+        awaited_leader_ = nonstd::nullopt;
+      }
+
       void Yac::closeRound() {
+        answerReceived();
         timer_->deny();
+        vote_storage_.collectGarbage();
+        votes_memory_ = vote_storage_.memoryUsage();
+        log_->info("live rounds: {}, votes memory: {} bytes",
+                   vote_storage_.liveRounds(),
+                   votes_memory_.load());
       };
 
       // ------|Apply data|------
@@ -131,6 +227,12 @@ namespace iroha {
       };
 
       void Yac::applyVote(model::Peer from, VoteMessage vote) {
+        if (voted_at_) {
+          roundTracer().voteArrived(
+              vote.signature.pubkey.to_hexstring(),
+              std::chrono::duration_cast<std::chrono::milliseconds>(
+                  std::chrono::steady_clock::now() - *voted_at_));
+        }
         auto result = vote_storage_.storeVote(vote,
                                               cluster_order_
                                                   .getNumberOfPeers());
@@ -148,23 +250,25 @@ namespace iroha {
             }
             break;
           case committed_before:
-            // propagate directly
-            if (result.answer.commit != nonstd::nullopt) {
-              propagateCommitDirectly(from, *result.answer.commit);
-            }
-            if (result.answer.reject != nonstd::nullopt) {
-              propagateRejectDirectly(from, *result.answer.reject);
-            }
+            answerDecided(from, result.answer);
             break;
         }
       };
 
+      void Yac::answerDecided(model::Peer to, const Answer &answer) {
+        // propagate directly
+        if (answer.commit != nonstd::nullopt) {
+          propagateCommitDirectly(to, *answer.commit);
+        }
+        if (answer.reject != nonstd::nullopt) {
+          propagateRejectDirectly(to, *answer.reject);
+        }
+      }
+
       // ------|Propagation|------
 
       void Yac::propagateCommit(CommitMessage msg) {
-        for (auto peer :cluster_order_.getPeers()) {
-          propagateCommitDirectly(peer, msg);
-        }
+        network_->broadcast_commit(cluster_order_.getPeers(), std::move(msg));
       }
 
       void Yac::propagateCommitDirectly(model::Peer to, CommitMessage msg) {
@@ -172,9 +276,7 @@ namespace iroha {
       }
 
       void Yac::propagateReject(RejectMessage msg) {
-        for (auto peer :cluster_order_.getPeers()) {
-          propagateRejectDirectly(peer, msg);
-        }
+        network_->broadcast_reject(cluster_order_.getPeers(), std::move(msg));
       }
 
       void Yac::propagateRejectDirectly(model::Peer to, RejectMessage msg) {
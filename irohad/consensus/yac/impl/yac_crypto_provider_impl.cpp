@@ -0,0 +1,110 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "consensus/yac/impl/yac_crypto_provider_impl.hpp"
+#include "crypto/crypto.hpp"
+
+namespace iroha {
+  namespace consensus {
+    namespace yac {
+      YacCryptoProviderImpl::YacCryptoProviderImpl(
+          const ed25519::keypair_t &keypair)
+          : YacCryptoProviderImpl(std::make_shared<KeypairSigner>(keypair)) {}
+
+      YacCryptoProviderImpl::YacCryptoProviderImpl(
+          std::shared_ptr<Signer> signer)
+          : signer_(std::move(signer)), pubkey_(signer_->publicKey()) {}
+
+      bool YacCryptoProviderImpl::verify(CommitMessage msg) {
+        return verifyVotes(msg.votes);
+      }
+
+      bool YacCryptoProviderImpl::verify(RejectMessage msg) {
+        return verifyVotes(msg.votes);
+      }
+
+      bool YacCryptoProviderImpl::verify(VoteMessage msg) {
+        auto payload = signedPayload(msg.hash);
+        return iroha::verify(payload.data(), payload.size(),
+                             msg.signature.pubkey, msg.signature.signature);
+      }
+
+      std::vector<bool> YacCryptoProviderImpl::verifyBatch(
+          const std::vector<VoteMessage> &votes) {
+        if (verifyVotes(votes)) {
+          return std::vector<bool>(votes.size(), true);
+        }
+        return YacCryptoProvider::verifyBatch(votes);
+      }
+
+      VoteMessage YacCryptoProviderImpl::getVote(YacHash hash) {
+        auto vote = unsignedVote(hash);
+        auto payload = signedPayload(hash);
+        vote.signature.signature =
+            signer_->signBatch({{payload.begin(), payload.end()}}).front();
+        return vote;
+      }
+
+      void YacCryptoProviderImpl::getVoteAsync(
+          YacHash hash, std::function<void(VoteMessage)> callback) {
+        auto vote = unsignedVote(hash);
+        auto payload = signedPayload(hash);
+        signer_->signAsync(
+            {payload.begin(), payload.end()},
+            [vote, callback](const ed25519::sig_t &signature) mutable {
+              vote.signature.signature = signature;
+              callback(vote);
+            });
+      }
+
+      VoteMessage YacCryptoProviderImpl::unsignedVote(
+          const YacHash &hash) const {
+        VoteMessage vote;
+        vote.hash = hash;
+        vote.signature.pubkey = pubkey_;
+        return vote;
+      }
+
+      hash256_t YacCryptoProviderImpl::signedPayload(const YacHash &hash) {
+        // vote signs the block hash itself, so signatures of commit are
+        // copied into the block and checked by chain validator as
+        // signatures of the block
+        return hash.block_hash;
+      }
+
+      bool YacCryptoProviderImpl::verifyVotes(
+          const std::vector<VoteMessage> &votes) {
+        if (votes.empty()) {
+          return false;
+        }
+        // payloads are reserved up front, batch refers to their memory
+        std::vector<hash256_t> payloads;
+        payloads.reserve(votes.size());
+        std::vector<SignedMessage> batch;
+        batch.reserve(votes.size());
+        for (const auto &vote : votes) {
+          payloads.push_back(signedPayload(vote.hash));
+          batch.push_back({payloads.back().data(),
+                           payloads.back().size(),
+                           vote.signature.pubkey,
+                           vote.signature.signature});
+        }
+        return verify_batch(batch);
+      }
+    }  // namespace yac
+  }    // namespace consensus
+}  // namespace iroha
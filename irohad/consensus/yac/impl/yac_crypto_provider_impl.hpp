@@ -0,0 +1,89 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_YAC_CRYPTO_PROVIDER_IMPL_HPP
+#define IROHA_YAC_CRYPTO_PROVIDER_IMPL_HPP
+
+#include <memory>
+#include <vector>
+#include "consensus/yac/yac_crypto_provider.hpp"
+#include "crypto/signer.hpp"
+
+namespace iroha {
+  namespace consensus {
+    namespace yac {
+
+      /**
+       * Crypto provider which signs votes with ed25519 key of the peer.
+       * Vote signature covers the block hash, so a commit carries
+       * signatures of the block.
+       * Votes of commit and reject messages are verified as one batch.
+       */
+      class YacCryptoProviderImpl : public YacCryptoProvider {
+       public:
+        /**
+         * Sign votes with key pair in memory
+         */
+        explicit YacCryptoProviderImpl(const ed25519::keypair_t &keypair);
+
+        /**
+         * Sign votes with given signer, e.g. remote one
+         */
+        explicit YacCryptoProviderImpl(std::shared_ptr<Signer> signer);
+
+        bool verify(CommitMessage msg) override;
+
+        bool verify(RejectMessage msg) override;
+
+        bool verify(VoteMessage msg) override;
+
+        /**
+         * Verify all votes as one batch, votes of failed batch are checked
+         * one by one to find invalid ones
+         */
+        std::vector<bool> verifyBatch(
+            const std::vector<VoteMessage> &votes) override;
+
+        VoteMessage getVote(YacHash hash) override;
+
+        void getVoteAsync(YacHash hash,
+                          std::function<void(VoteMessage)> callback) override;
+
+       private:
+        /**
+         * @return payload covered by vote signature, the hash of voted
+         * block, as block signatures are checked against it
+         */
+        static hash256_t signedPayload(const YacHash &hash);
+
+        /**
+         * @return vote without signature
+         */
+        VoteMessage unsignedVote(const YacHash &hash) const;
+
+        /**
+         * Verify signatures of all votes at once
+         */
+        static bool verifyVotes(const std::vector<VoteMessage> &votes);
+
+        std::shared_ptr<Signer> signer_;
+        ed25519::pubkey_t pubkey_;
+      };
+    }  // namespace yac
+  }    // namespace consensus
+}  // namespace iroha
+#endif  // IROHA_YAC_CRYPTO_PROVIDER_IMPL_HPP
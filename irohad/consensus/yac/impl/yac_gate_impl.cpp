@@ -16,55 +16,255 @@
  */
 
 #include "consensus/yac/impl/yac_gate_impl.hpp"
+#include <algorithm>
+#include "consensus/round_tracer.hpp"
+#include "tracing/tracing.hpp"
 
 namespace iroha {
   namespace consensus {
     namespace yac {
 
+      namespace {
+        /**
+         * Record span from own vote to supermajority for sampled
+         * transactions of block
+         */
+        void traceCommit(const model::Block &block) {
+          if (std::none_of(block.transactions.begin(),
+                           block.transactions.end(),
+                           [](const auto &tx) { return bool(tx.trace); })) {
+            return;
+          }
+          auto start = std::chrono::steady_clock::now();
+          auto round = roundTracer().round(block.height);
+          if (round) {
+            const auto &voted =
+                round->phases.at(static_cast<size_t>(RoundPhase::Voted));
+            if (voted) {
+              start = *voted;
+            }
+          }
+          tracing::traceEach(
+              "yac.consensus", block.transactions, start, block.height);
+        }
+      }  // namespace
+
       YacGateImpl::YacGateImpl(
           std::shared_ptr<HashGate> hash_gate,
           std::shared_ptr<YacPeerOrderer> orderer,
           std::shared_ptr<YacHashProvider> hash_provider,
-          std::shared_ptr<simulator::BlockCreator> block_creator)
+          std::shared_ptr<simulator::BlockCreator> block_creator,
+          std::shared_ptr<network::BlockLoader> block_loader,
+          std::shared_ptr<network::OrderingGate> ordering_gate)
           : hash_gate_(std::move(hash_gate)),
             orderer_(std::move(orderer)),
             hash_provider_(std::move(hash_provider)),
-            block_creator_(std::move(block_creator)) {
+            block_creator_(std::move(block_creator)),
+            block_loader_(std::move(block_loader)),
+            vote_on_proposal_(ordering_gate != nullptr) {
         log_ = logger::log("YacGate");
+        if (not vote_on_proposal_) {
+          block_creator_->on_block().subscribe([this](auto block) {
+            this->vote(std::move(block));
+          });
+          return;
+        }
+        hash_gate_->on_commit().subscribe([this](auto commit) {
+          this->proposalCommitted(commit);
+        });
         block_creator_->on_block().subscribe([this](auto block) {
-          this->vote(block);
+          this->blockBuilt(std::move(block));
+        });
+        ordering_gate->on_proposal().subscribe([this](auto proposal) {
+          this->voteProposal(*proposal);
         });
       };
 
-      void YacGateImpl::vote(model::Block block) {
+      void YacGateImpl::vote(std::shared_ptr<const model::Block> block) {
         log_->info("vote for block");
-        auto hash = hash_provider_->makeHash(block);
+        auto hash = hash_provider_->makeHash(*block);
         auto order = orderer_->getOrdering(hash);
         if (not order.has_value()) {
           log_->error("ordering doesn't provide peers => pass round");
           return;
         }
-        current_block_ = std::make_pair(hash, block);
+        // keep at most two rounds: the one being committed and the next
+        for (auto it = pending_blocks_.begin(); it != pending_blocks_.end();) {
+          if (it->second->height + 1 < block->height) {
+            it = pending_blocks_.erase(it);
+          } else {
+            ++it;
+          }
+        }
+        auto height = block->height;
+        pending_blocks_[hash] = std::move(block);
         hash_gate_->vote(hash, order.value());
+        roundTracer().mark(height, RoundPhase::Voted);
       };
 
-      rxcpp::observable<model::Block> YacGateImpl::on_commit() {
-        return hash_gate_->on_commit().map([this](auto commit_message) {
-          if (commit_message.votes.at(0).hash == current_block_.first) {
-            current_block_.second.sigs.clear();
-            for (auto &&vote : commit_message.votes) {
-              current_block_.second.sigs.push_back(vote.signature);
-            }
+      rxcpp::observable<std::shared_ptr<const model::Block>>
+      YacGateImpl::on_commit() {
+        if (vote_on_proposal_) {
+          return committed_.get_observable();
+        }
+        using BlockPtr = std::shared_ptr<const model::Block>;
+        return hash_gate_->on_commit().map([this](auto commit_message)
+                                               -> BlockPtr {
+          auto pending = pending_blocks_.find(commit_message.votes.at(0).hash);
+          if (pending != pending_blocks_.end()) {
+            auto block = signedBlock(*pending->second, commit_message);
+            this->forgetRounds(block->height);
+            roundTracer().mark(block->height, RoundPhase::Supermajority);
+            traceCommit(*block);
             log_->info("consensus: commit top block");
-            return current_block_.second;
+            return block;
           }
 
-          // TODO download committed block
-          log_->warn(
-              "Functionality of downloading blocks absent, return empty block");
-          return model::Block();
+          auto block = this->loadBlock(commit_message);
+          if (not block) {
+            log_->warn("committed block is not downloaded, return empty block");
+            return std::make_shared<const model::Block>();
+          }
+          this->forgetRounds(block->height);
+          roundTracer().mark(block->height, RoundPhase::Supermajority);
+          log_->info("consensus: commit downloaded block");
+          return std::make_shared<const model::Block>(std::move(*block));
         });
       };
+
+      nonstd::optional<model::Block> YacGateImpl::loadBlock(
+          const CommitMessage &commit) {
+        // committed block belongs to the oldest round this peer voted in
+        auto oldest = std::min_element(
+            pending_blocks_.begin(),
+            pending_blocks_.end(),
+            [](const auto &lhs, const auto &rhs) {
+              return lhs.second->height < rhs.second->height;
+            });
+        if (oldest == pending_blocks_.end()) {
+          return nonstd::nullopt;
+        }
+        const auto &hash = commit.votes.at(0).hash.block_hash;
+
+        for (const auto &vote : commit.votes) {
+          model::Peer signer;
+          signer.pubkey = vote.signature.pubkey;
+          auto block = block_loader_->retrieveBlock(
+              signer, oldest->second->height, hash);
+          if (block) {
+            block->sigs.clear();
+            for (const auto &commit_vote : commit.votes) {
+              block->sigs.push_back(commit_vote.signature);
+            }
+            return block;
+          }
+        }
+        return nonstd::nullopt;
+      }
+
+      void YacGateImpl::forgetRounds(uint64_t height) {
+        // blocks of this and earlier rounds can not be committed anymore
+        for (auto it = pending_blocks_.begin(); it != pending_blocks_.end();) {
+          if (it->second->height <= height) {
+            it = pending_blocks_.erase(it);
+          } else {
+            ++it;
+          }
+        }
+      }
+
+      void YacGateImpl::voteProposal(const model::Proposal &proposal) {
+        log_->info("vote for proposal {}", proposal.height);
+        auto hash = hash_provider_->makeProposalHash(proposal);
+        auto order = orderer_->getOrdering(hash);
+        if (not order.has_value()) {
+          log_->error("ordering doesn't provide peers => pass round");
+          return;
+        }
+        {
+          std::lock_guard<std::mutex> lock(proposal_mutex_);
+          // keep at most two rounds: the one being committed and the next
+          for (auto it = voted_proposals_.begin();
+               it != voted_proposals_.end();) {
+            if (it->second + 1 < proposal.height) {
+              it = voted_proposals_.erase(it);
+            } else {
+              ++it;
+            }
+          }
+          voted_proposals_[hash] = proposal.height;
+        }
+        hash_gate_->vote(hash, order.value());
+        roundTracer().mark(proposal.height, RoundPhase::Voted);
+      }
+
+      void YacGateImpl::blockBuilt(std::shared_ptr<const model::Block> block) {
+        std::unique_lock<std::mutex> lock(proposal_mutex_);
+        auto awaited = awaited_blocks_.find(block->height);
+        if (awaited == awaited_blocks_.end()) {
+          built_blocks_.erase(built_blocks_.begin(),
+                              built_blocks_.lower_bound(block->height));
+          built_blocks_[block->height] = std::move(block);
+          return;
+        }
+        auto commit = std::move(awaited->second);
+        lock.unlock();
+        emitCommitted(*block, commit);
+      }
+
+      void YacGateImpl::proposalCommitted(const CommitMessage &commit) {
+        std::unique_lock<std::mutex> lock(proposal_mutex_);
+        auto voted = voted_proposals_.find(commit.votes.at(0).hash);
+        if (voted == voted_proposals_.end()) {
+          log_->warn("committed proposal is unknown, wait for next commit");
+          return;
+        }
+        auto height = voted->second;
+        auto built = built_blocks_.find(height);
+        if (built == built_blocks_.end()) {
+          log_->info("proposal {} is committed before its block is built",
+                     height);
+          awaited_blocks_[height] = commit;
+          return;
+        }
+        auto block = std::move(built->second);
+        lock.unlock();
+        emitCommitted(*block, commit);
+      }
+
+      void YacGateImpl::emitCommitted(const model::Block &block,
+                                      const CommitMessage &commit) {
+        {
+          std::lock_guard<std::mutex> lock(proposal_mutex_);
+          // blocks of this and earlier rounds can not be committed anymore
+          for (auto it = voted_proposals_.begin();
+               it != voted_proposals_.end();) {
+            if (it->second <= block.height) {
+              it = voted_proposals_.erase(it);
+            } else {
+              ++it;
+            }
+          }
+          built_blocks_.erase(built_blocks_.begin(),
+                              built_blocks_.upper_bound(block.height));
+          awaited_blocks_.erase(awaited_blocks_.begin(),
+                                awaited_blocks_.upper_bound(block.height));
+        }
+        roundTracer().mark(block.height, RoundPhase::Supermajority);
+        traceCommit(block);
+        log_->info("consensus: commit block of proposal");
+        committed_.get_subscriber().on_next(signedBlock(block, commit));
+      }
+
+      std::shared_ptr<const model::Block> YacGateImpl::signedBlock(
+          const model::Block &block, const CommitMessage &commit) {
+        auto signed_block = std::make_shared<model::Block>(block);
+        signed_block->sigs.clear();
+        for (const auto &vote : commit.votes) {
+          signed_block->sigs.push_back(vote.signature);
+        }
+        return signed_block;
+      }
     }  // namespace yac
   }    // namespace consensus
 }  // namespace iroha
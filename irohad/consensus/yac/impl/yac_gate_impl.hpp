@@ -18,8 +18,13 @@
 #ifndef IROHA_YAC_GATE_IMPL_HPP
 #define IROHA_YAC_GATE_IMPL_HPP
 
+#include <map>
+#include <mutex>
+#include <unordered_map>
 #include "consensus/yac/yac_gate.hpp"
 #include "consensus/yac/yac_peer_orderer.hpp"
+#include "network/block_loader.hpp"
+#include "network/ordering_gate.hpp"
 #include "simulator/block_creator.hpp"
 
 #include "logger/logger.hpp"
@@ -30,22 +35,98 @@ namespace iroha {
 
       class YacGateImpl : public YacGate {
        public:
-        YacGateImpl(std::shared_ptr<HashGate> hash_gate,
-                    std::shared_ptr<YacPeerOrderer> orderer,
-                    std::shared_ptr<YacHashProvider> hash_provider,
-                    std::shared_ptr<simulator::BlockCreator> block_creator);
-        void vote(model::Block block) override;
-        rxcpp::observable<model::Block> on_commit() override;
+        /**
+         * @param block_loader - source of committed blocks which this peer
+         * has not voted for
+         * @param ordering_gate - when set, peer votes for hash of proposal
+         * as soon as it is received, and block built from the proposal by
+         * block creator in the meantime is committed by its height
+         */
+        YacGateImpl(
+            std::shared_ptr<HashGate> hash_gate,
+            std::shared_ptr<YacPeerOrderer> orderer,
+            std::shared_ptr<YacHashProvider> hash_provider,
+            std::shared_ptr<simulator::BlockCreator> block_creator,
+            std::shared_ptr<network::BlockLoader> block_loader,
+            std::shared_ptr<network::OrderingGate> ordering_gate = nullptr);
+        void vote(std::shared_ptr<const model::Block> block) override;
+        rxcpp::observable<std::shared_ptr<const model::Block>> on_commit()
+            override;
 
        private:
+        // ------|Proposal voting|------
+
+        /**
+         * Vote for hash of received proposal
+         */
+        void voteProposal(const model::Proposal &proposal);
+
+        /**
+         * Keep block built from voted proposal, commit it if its proposal
+         * has been committed already
+         */
+        void blockBuilt(std::shared_ptr<const model::Block> block);
+
+        /**
+         * Commit block of committed proposal or wait until it is built
+         */
+        void proposalCommitted(const CommitMessage &commit);
+
+        /**
+         * Attach signatures of commit to block and emit it
+         */
+        void emitCommitted(const model::Block &block,
+                           const CommitMessage &commit);
+
+        // ------|Common|------
+
+        /**
+         * Copy block with signatures of commit in place of its own, the
+         * only copy of block made on its way to synchronizer
+         */
+        static std::shared_ptr<const model::Block> signedBlock(
+            const model::Block &block, const CommitMessage &commit);
+
+        // ------|Block voting|------
+
+        /**
+         * Download committed block from peers which signed it
+         * @param commit - commit of block unknown to this peer
+         * @return block if any signer provided it
+         */
+        nonstd::optional<model::Block> loadBlock(
+            const CommitMessage &commit);
+
+        /**
+         * Drop pending blocks which can not be committed anymore
+         * @param height - height of committed block
+         */
+        void forgetRounds(uint64_t height);
+
         std::shared_ptr<HashGate> hash_gate_;
         std::shared_ptr<YacPeerOrderer> orderer_;
         std::shared_ptr<YacHashProvider> hash_provider_;
         std::shared_ptr<simulator::BlockCreator> block_creator_;
+        std::shared_ptr<network::BlockLoader> block_loader_;
 
         logger::Logger log_;
 
-        std::pair<YacHash, model::Block> current_block_;
+        /**
+         * Blocks voted for and not committed yet. With pipelined rounds
+         * the next block is voted for before the current one is committed.
+         */
+        std::unordered_map<YacHash, std::shared_ptr<const model::Block>>
+            pending_blocks_;
+
+        // state of proposal voting, accessed from block creator and
+        // consensus threads
+        std::mutex proposal_mutex_;
+        std::unordered_map<YacHash, uint64_t> voted_proposals_;
+        std::map<uint64_t, std::shared_ptr<const model::Block>> built_blocks_;
+        std::map<uint64_t, CommitMessage> awaited_blocks_;
+        rxcpp::subjects::subject<std::shared_ptr<const model::Block>>
+            committed_;
+        const bool vote_on_proposal_;
       };
 
     }  // namespace yac
@@ -17,23 +17,25 @@
 
 #include "consensus/yac/impl/yac_hash_provider_impl.hpp"
 #include "algorithm"
+#include "crypto/hash.hpp"
+#include "model/model_hash_provider_impl.hpp"
 
 namespace iroha {
   namespace consensus {
     namespace yac {
 
-      YacHash YacHashProviderImpl::makeHash(model::Block &block) {
-        YacHash hash;
+      YacHash YacHashProviderImpl::makeHash(const model::Block &block) {
         // todo add proposal hash from block.proposal_hash
-        hash.proposal_hash = std::string(block.hash.size(), 0);
-        std::copy(block.hash.begin(),
-                  block.hash.end(),
-                  hash.proposal_hash.begin());
-        hash.block_hash = std::string(block.hash.size(), 0);
-        std::copy(block.hash.begin(),
-                  block.hash.end(),
-                  hash.block_hash.begin());
-        return hash;
+        return YacHash(block.hash, block.hash);
+      }
+
+      YacHash YacHashProviderImpl::makeProposalHash(
+          const model::Proposal &proposal) {
+        auto data = std::to_string(proposal.height)
+            + model::HashProviderImpl().get_hash(proposal).to_string();
+        auto digest = sha3_256(reinterpret_cast<const uint8_t *>(data.data()),
+                               data.size());
+        return YacHash(digest, digest);
       }
     }  // namespace yac
   }    // namespace consensus
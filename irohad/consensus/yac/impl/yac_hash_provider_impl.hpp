@@ -25,7 +25,13 @@ namespace iroha {
     namespace yac {
       class YacHashProviderImpl : public YacHashProvider {
        public:
-        YacHash makeHash(model::Block &block) override;
+        YacHash makeHash(const model::Block &block) override;
+
+        /**
+         * Hash covers height and hashes of transactions of the proposal,
+         * so empty proposals of different rounds differ
+         */
+        YacHash makeProposalHash(const model::Proposal &proposal) override;
       };
     }  // namespace yac
   }    // namespace consensus
@@ -28,37 +28,15 @@ namespace iroha {
       };
 
       StorageResult YacBlockStorage::insert(VoteMessage msg) {
-        auto inserted = tryInsert(msg);
-        if (inserted) {
-          // update state branch
-          auto prev_state = current_state_.state;
-
-          switch (prev_state) {
-
-            case not_committed:
-              current_state_.state = updateSupermajorityState();
-              if (current_state_.state == CommitState::committed) {
-                current_state_.answer.commit = CommitMessage(votes_);
-              }
-              break;
-
-            case committed:current_state_.state = committed_before;
-              current_state_.answer.commit = CommitMessage(votes_);
-              break;
-
-            case committed_before:
-              current_state_.answer.commit = CommitMessage(votes_);
-              break;
-          }
-        }
+        update(std::move(msg));
         return getState();
       };
 
       StorageResult YacBlockStorage::insert(CommitMessage commit) {
         if (checkCommitScheme(commit)) {
-          auto initial_state = getState().state;
-          for (auto &&vote : commit.votes) {
-            current_state_ = insert(vote);
+          auto initial_state = current_state_.state;
+          for (auto &vote : commit.votes) {
+            update(std::move(vote));
           }
           if (initial_state == CommitState::not_committed and
               current_state_.state == CommitState::committed_before) {
@@ -85,11 +63,41 @@ namespace iroha {
         return hash_.block_hash;
       };
 
+      size_t YacBlockStorage::memoryUsage() const {
+        return sizeof(*this) + votes_.capacity() * sizeof(VoteMessage)
+            + voters_.size() * sizeof(ed25519::pubkey_t);
+      }
+
       // --------| private fields |--------
 
-      bool YacBlockStorage::tryInsert(VoteMessage msg) {
+      void YacBlockStorage::update(VoteMessage msg) {
+        if (not tryInsert(msg)) {
+          return;
+        }
+        switch (current_state_.state) {
+          case not_committed:
+            current_state_.state = updateSupermajorityState();
+            if (current_state_.state == CommitState::committed) {
+              current_state_.answer.commit = CommitMessage(votes_);
+            }
+            break;
+
+          case committed:
+            current_state_.state = committed_before;
+            current_state_.answer.commit->votes.push_back(votes_.back());
+            break;
+
+          case committed_before:
+            // commit already holds all previous votes, only new one is added
+            current_state_.answer.commit->votes.push_back(votes_.back());
+            break;
+        }
+      }
+
+      bool YacBlockStorage::tryInsert(VoteMessage &msg) {
         if (unique_vote(msg)) {
-          votes_.push_back(msg);
+          voters_.insert(msg.signature.pubkey);
+          votes_.push_back(std::move(msg));
           return true;
         }
         return false;
@@ -101,18 +109,13 @@ namespace iroha {
       };
 
       bool YacBlockStorage::unique_vote(VoteMessage &msg) {
-        for (auto &&vote: votes_) {
-          if (vote == msg) {
-            return false;
-          }
-        }
-        return true;
+        return voters_.count(msg.signature.pubkey) == 0;
       };
 
       bool YacBlockStorage::checkCommitScheme(const CommitMessage &commit) {
-        auto votes = commit.votes;
+        const auto &votes = commit.votes;
         if (!hasSupermajority(votes.size(), peers_in_round_)) return false;
-        auto common_hash = votes.at(0).hash;
+        const auto &common_hash = votes.at(0).hash;
         if (common_hash != hash_) return false;
         for (auto &&vote:votes) {
           if (common_hash != vote.hash) {
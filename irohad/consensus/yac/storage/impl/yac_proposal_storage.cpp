@@ -98,6 +98,19 @@ namespace iroha {
         return current_state_;
       };
 
+      bool YacProposalStorage::isClosed() const {
+        return current_state_.state != CommitState::not_committed;
+      }
+
+      size_t YacProposalStorage::memoryUsage() const {
+        size_t usage = sizeof(*this)
+            + block_index_.size() * (sizeof(YacHash) + sizeof(uint64_t));
+        for (const auto &block_storage : block_votes_) {
+          usage += block_storage.memoryUsage();
+        }
+        return usage;
+      }
+
       // --------| private api |--------
 
       bool YacProposalStorage::shouldInsert(const VoteMessage &msg) {
@@ -121,24 +134,20 @@ namespace iroha {
 
       uint64_t YacProposalStorage::findStore(ProposalHash proposal_hash,
                                              BlockHash block_hash) {
-
-        // find exist
-        for (uint32_t i = 0; i < block_votes_.size(); ++i) {
-          if (block_votes_.at(i).getProposalHash() == proposal_hash and
-              block_votes_.at(i).getBlockHash() == block_hash) {
-            return i;
-          }
+        YacHash hash(proposal_hash, block_hash);
+        auto it = block_index_.find(hash);
+        if (it != block_index_.end()) {
+          return it->second;
         }
         // insert and return new
-        YacBlockStorage
-            new_container(YacHash(proposal_hash, block_hash), peers_in_round_);
-        block_votes_.push_back(new_container);
+        block_votes_.emplace_back(hash, peers_in_round_);
+        block_index_.emplace(hash, block_votes_.size() - 1);
         return block_votes_.size() - 1;
       };
 
       std::vector<VoteMessage> YacProposalStorage::aggregateAll() {
         std::vector<VoteMessage> all_votes;
-        for (auto vote_storage: block_votes_) {
+        for (auto &vote_storage: block_votes_) {
           auto votes = vote_storage.getVotes();
           all_votes.insert(all_votes.end(),
                            votes.begin(), votes.end());
@@ -17,55 +17,91 @@
 
 #include "consensus/yac/storage/yac_vote_storage.hpp"
 
+#include <algorithm>
+
 namespace iroha {
   namespace consensus {
     namespace yac {
 
+      YacVoteStorage::YacVoteStorage(size_t round_window)
+          : round_window_(std::max<size_t>(round_window, 1)) {}
+
       StorageResult YacVoteStorage::storeVote(VoteMessage msg,
                                               uint64_t peers_in_round) {
-        return proposal_storages_
-            .at(findProposalStorage(msg, peers_in_round))
-            .insert(msg);
+        return findProposalStorage(msg, peers_in_round).insert(msg);
       }
 
       StorageResult YacVoteStorage::applyCommit(CommitMessage commit,
                                                 uint64_t peers_in_round) {
         if (commit.votes.empty()) return StorageResult();
 
-        auto index = findProposalStorage(commit.votes.at(0), peers_in_round);
-        return proposal_storages_.at(index).applyCommit(commit, peers_in_round);
+        return findProposalStorage(commit.votes.at(0), peers_in_round)
+            .applyCommit(commit, peers_in_round);
       };
 
       StorageResult YacVoteStorage::applyReject(RejectMessage reject,
                                                 uint64_t peers_in_round) {
         if (reject.votes.empty()) return StorageResult();
 
-        auto index = findProposalStorage(reject.votes.at(0), peers_in_round);
-        return proposal_storages_.at(index).applyReject(reject, peers_in_round);
+        return findProposalStorage(reject.votes.at(0), peers_in_round)
+            .applyReject(reject, peers_in_round);
       };
 
       nonstd::optional<StorageResult> YacVoteStorage::findProposal(
           YacHash hash) {
-        for (const auto &proposal_storage : proposal_storages_) {
-          if (proposal_storage.getProposalHash() == hash.proposal_hash) {
-            return proposal_storage.getState();
+        auto it = proposal_storages_.find(hash.proposal_hash);
+        if (it == proposal_storages_.end()) {
+          return nonstd::nullopt;
+        }
+        return it->second.getState();
+      }
+
+      void YacVoteStorage::collectGarbage() {
+        auto outdated = rounds_.size() > round_window_
+            ? rounds_.size() - round_window_ : 0;
+        auto stale = rounds_.size() > 2 * round_window_
+            ? rounds_.size() - 2 * round_window_ : 0;
+        auto round = rounds_.begin();
+        for (size_t i = 0; i < outdated; ++i) {
+          auto storage = proposal_storages_.find(*round);
+          if (i < stale or storage->second.isClosed()) {
+            proposal_storages_.erase(storage);
+            round = rounds_.erase(round);
+          } else {
+            ++round;
           }
         }
-        return nonstd::nullopt;
+      }
+
+      size_t YacVoteStorage::liveRounds() const {
+        return proposal_storages_.size();
+      }
+
+      size_t YacVoteStorage::memoryUsage() const {
+        size_t usage = 0;
+        for (const auto &storage : proposal_storages_) {
+          usage += sizeof(storage.first) + storage.second.memoryUsage();
+        }
+        return usage;
       }
 
       // --------| private api |--------
 
-      uint64_t YacVoteStorage::findProposalStorage(const VoteMessage &msg,
-                                                   uint64_t peers_in_round) {
-        for (uint64_t i = 0; i < proposal_storages_.size(); ++i) {
-          if (proposal_storages_.at(i).getProposalHash()
-              == msg.hash.proposal_hash) {
-            return i;
-          }
+      YacProposalStorage &YacVoteStorage::findProposalStorage(
+          const VoteMessage &msg, uint64_t peers_in_round) {
+        auto it = proposal_storages_.find(msg.hash.proposal_hash);
+        if (it != proposal_storages_.end()) {
+          return it->second;
         }
-        proposal_storages_.emplace_back(msg.hash.proposal_hash, peers_in_round);
-        return proposal_storages_.size() - 1;
+        rounds_.push_back(msg.hash.proposal_hash);
+        auto &storage = proposal_storages_
+            .emplace(msg.hash.proposal_hash,
+                     YacProposalStorage(msg.hash.proposal_hash,
+                                        peers_in_round))
+            .first->second;
+        // new round has started, so older ones may be closed by now
+        collectGarbage();
+        return storage;
       }
 
     } // namespace yac
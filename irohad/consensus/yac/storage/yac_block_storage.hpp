@@ -18,6 +18,8 @@
 #ifndef IROHA_YAC_BLOCK_VOTE_STORAGE_HPP
 #define IROHA_YAC_BLOCK_VOTE_STORAGE_HPP
 
+#include <unordered_set>
+#include "common/byteutils.hpp"
 #include "consensus/yac/storage/storage_result.hpp"
 #include "consensus/yac/storage/yac_common.hpp"
 
@@ -68,15 +70,26 @@ namespace iroha {
          */
         BlockHash getBlockHash();
 
+        /**
+         * @return approximate number of bytes occupied by storage
+         */
+        size_t memoryUsage() const;
+
        private:
         // --------| private fields |--------
 
         /**
-         * Try to invert new vote
+         * Insert vote and update state of storage in place
          * @param msg - vote for insertion
+         */
+        void update(VoteMessage msg);
+
+        /**
+         * Try to invert new vote
+         * @param msg - vote for insertion, moved from if inserted
          * @return true, if inserted
          */
-        bool tryInsert(VoteMessage msg);
+        bool tryInsert(VoteMessage &msg);
 
         /**
          * Return new status of state based on supermajority metrics
@@ -87,7 +100,7 @@ namespace iroha {
         /**
          * Verify uniqueness of vote in storage
          * @param msg - vote for verification
-         * @return true if vote doesn't appear in storage
+         * @return true if voter of the message has not voted yet
          */
         bool unique_vote(VoteMessage &msg);
 
@@ -108,6 +121,11 @@ namespace iroha {
          */
         std::vector<VoteMessage> votes_;
 
+        /**
+         * Public keys of peers who voted, one vote per peer is counted
+         */
+        std::unordered_set<ed25519::pubkey_t> voters_;
+
         /**
          * Provide knowledge about state of block storage
          */
@@ -18,6 +18,7 @@
 #ifndef IROHA_YAC_PROPOSAL_STORAGE_HPP
 #define IROHA_YAC_PROPOSAL_STORAGE_HPP
 
+#include <unordered_map>
 #include <vector>
 #include "consensus/yac/messages.hpp"
 #include "consensus/yac/storage/yac_common.hpp"
@@ -69,6 +70,16 @@ namespace iroha {
          */
         StorageResult getState() const;
 
+        /**
+         * @return true if commit or reject is achieved in storage
+         */
+        bool isClosed() const;
+
+        /**
+         * @return approximate number of bytes occupied by storage
+         */
+        size_t memoryUsage() const;
+
        private:
         // --------| private api |--------
 
@@ -151,6 +162,11 @@ namespace iroha {
          * Vector of blocks based on this proposal
          */
         std::vector<YacBlockStorage> block_votes_;
+
+        /**
+         * Position of block storage in block_votes_ by its hash
+         */
+        std::unordered_map<YacHash, uint64_t> block_index_;
       };
     } // namespace yac
   } // namespace consensus
@@ -18,6 +18,7 @@
 #ifndef IROHA_YAC_VOTE_STORAGE_HPP
 #define IROHA_YAC_VOTE_STORAGE_HPP
 
+#include <deque>
 #include <unordered_map>
 #include <vector>
 #include <nonstd/optional.hpp>
@@ -36,6 +37,16 @@ namespace iroha {
        */
       class YacVoteStorage {
        public:
+        /**
+         * Default number of latest rounds kept in storage
+         */
+        static constexpr size_t kDefaultRoundWindow = 100;
+
+        /**
+         * @param round_window - number of latest rounds kept in storage,
+         * older rounds are evicted once they are closed
+         */
+        explicit YacVoteStorage(size_t round_window = kDefaultRoundWindow);
 
         /**
          * Insert vote in storage
@@ -53,6 +64,23 @@ namespace iroha {
 
         nonstd::optional<StorageResult> findProposal(YacHash hash);
 
+        /**
+         * Evict committed or rejected rounds older than the window.
+         * Rounds which are still open after twice the window are evicted
+         * too, since they can not be finished anymore.
+         */
+        void collectGarbage();
+
+        /**
+         * @return number of rounds currently kept in storage
+         */
+        size_t liveRounds() const;
+
+        /**
+         * @return approximate number of bytes occupied by stored votes
+         */
+        size_t memoryUsage() const;
+
        private:
         // --------| private api |--------
 
@@ -62,15 +90,23 @@ namespace iroha {
          * @param peers_in_round - number of peer required
          * for verify supermajority;
          * This parameter used on creation of proposal storage
-         * @return - index of required proposal storage
+         * @return - required proposal storage
          */
-        uint64_t findProposalStorage(const VoteMessage &msg,
-                                     uint64_t peers_in_round);
+        YacProposalStorage &findProposalStorage(const VoteMessage &msg,
+                                                uint64_t peers_in_round);
 
         /**
          * Active proposals
          */
-        std::vector<YacProposalStorage> proposal_storages_;
+        std::unordered_map<ProposalHash, YacProposalStorage>
+            proposal_storages_;
+
+        /**
+         * Proposal hashes in order of their first vote
+         */
+        std::deque<ProposalHash> rounds_;
+
+        const size_t round_window_;
       };
 
     } // namespace yac
@@ -19,6 +19,7 @@
 #define IROHA_YAC_TIMER_HPP
 
 #include <functional>
+#include "model/peer.hpp"
 
 namespace iroha {
   namespace consensus {
@@ -42,6 +43,29 @@ namespace iroha {
          */
         virtual void deny() = 0;
 
+        /**
+         * Delay of waiting for answer of peer, fixed by default
+         * @param peer - awaited peer
+         * @param base - configured delay in milliseconds
+         * @return delay in milliseconds
+         */
+        virtual uint64_t delayFor(const model::Peer &peer, uint64_t base) {
+          return base;
+        }
+
+        /**
+         * Report that peer has answered
+         * @param peer - answered peer
+         * @param millis - time between request and answer
+         */
+        virtual void onAnswer(const model::Peer &peer, uint64_t millis) {}
+
+        /**
+         * Report that peer has not answered within its delay
+         * @param peer - silent peer
+         */
+        virtual void onTimeout(const model::Peer &peer) {}
+
         virtual ~Timer() = default;
       };
     }  // namespace yac
@@ -0,0 +1,75 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_YAC_VOTE_VERIFIER_HPP
+#define IROHA_YAC_VOTE_VERIFIER_HPP
+
+#include <functional>
+#include <memory>
+#include "consensus/yac/yac_crypto_provider.hpp"
+
+namespace iroha {
+  namespace consensus {
+    namespace yac {
+
+      /**
+       * Interface of verification stage of incoming votes
+       */
+      class VoteVerifier {
+       public:
+        using Handler = std::function<void()>;
+
+        /**
+         * Verify signature of vote. Handlers of valid votes are invoked in
+         * order of submission, possibly from another thread
+         * @param vote - for verification
+         * @param on_valid - invoked only if signature is correct
+         * @param on_invalid - invoked only if signature is wrong, may be
+         * empty
+         */
+        virtual void verify(VoteMessage vote,
+                            Handler on_valid,
+                            Handler on_invalid = Handler()) = 0;
+
+        virtual ~VoteVerifier() = default;
+      };
+
+      /**
+       * Verifier which checks vote immediately in the calling thread
+       */
+      class InlineVoteVerifier : public VoteVerifier {
+       public:
+        explicit InlineVoteVerifier(std::shared_ptr<YacCryptoProvider> crypto)
+            : crypto_(std::move(crypto)) {}
+
+        void verify(VoteMessage vote,
+                    Handler on_valid,
+                    Handler on_invalid = Handler()) override {
+          if (crypto_->verify(std::move(vote))) {
+            on_valid();
+          } else if (on_invalid) {
+            on_invalid();
+          }
+        }
+
+       private:
+        std::shared_ptr<YacCryptoProvider> crypto_;
+      };
+    }  // namespace yac
+  }    // namespace consensus
+}  // namespace iroha
+#endif  // IROHA_YAC_VOTE_VERIFIER_HPP
@@ -18,6 +18,8 @@
 #ifndef IROHA_YAC_HPP
 #define IROHA_YAC_HPP
 
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <tuple>
 #include <unordered_map>
@@ -28,8 +30,12 @@
 #include "consensus/yac/yac_gate.hpp"
 #include "consensus/yac/yac_network_interface.hpp"
 #include "consensus/yac/yac_crypto_provider.hpp"
+#include "consensus/yac/executor.hpp"
 #include "consensus/yac/timer.hpp"
+#include "consensus/yac/vote_verifier.hpp"
 #include "consensus/yac/storage/yac_vote_storage.hpp"
+#include "logger/logger.hpp"
+#include "network/impl/peer_health.hpp"
 
 namespace iroha {
   namespace consensus {
@@ -40,6 +46,12 @@ namespace iroha {
         /**
          * Method for creating Yac consensus object
          * @param delay for timer in milliseconds
+         * @param executor - context of all state transitions, calls from
+         * network, timer and gate only post work to it
+         * @param verifier - stage of vote signature verification, votes are
+         * checked inline with crypto provider when not set
+         * @param health - table of peer health, fed with answer times and
+         * timeouts of leaders when set
          */
         static std::shared_ptr<Yac> create(
             YacVoteStorage vote_storage,
@@ -47,14 +59,21 @@ namespace iroha {
             std::shared_ptr<YacCryptoProvider> crypto,
             std::shared_ptr<Timer> timer,
             ClusterOrdering order,
-            uint64_t delay);
+            uint64_t delay,
+            std::shared_ptr<Executor> executor =
+                std::make_shared<InlineExecutor>(),
+            std::shared_ptr<VoteVerifier> verifier = nullptr,
+            std::shared_ptr<network::PeerHealth> health = nullptr);
 
         Yac(YacVoteStorage vote_storage,
             std::shared_ptr<YacNetwork> network,
             std::shared_ptr<YacCryptoProvider> crypto,
             std::shared_ptr<Timer> timer,
             ClusterOrdering order,
-            uint64_t delay);
+            uint64_t delay,
+            std::shared_ptr<Executor> executor,
+            std::shared_ptr<VoteVerifier> verifier,
+            std::shared_ptr<network::PeerHealth> health = nullptr);
 
         // ------|Hash gate|------
 
@@ -70,6 +89,19 @@ namespace iroha {
 
         virtual void on_vote(model::Peer from, VoteMessage vote);
 
+        /**
+         * Change time of waiting for commit before switching to next
+         * leader, applies from the next voting step
+         * @param delay - in milliseconds
+         */
+        void setDelay(uint64_t delay);
+
+        /**
+         * @return approximate memory of stored votes as of the last closed
+         * round, safe to call from any thread
+         */
+        size_t votesMemory() const;
+
        private:
         // ------|Private interface|------
 
@@ -80,10 +112,21 @@ namespace iroha {
         void votingStep(YacHash hash);
 
         /**
-         * Erase temporary data of current round
+         * Send own vote for hash to peer. Vote is signed once per round and
+         * reused when it is sent to the next leader
+         */
+        void sendVote(model::Peer to, YacHash hash);
+
+        /**
+         * Erase temporary data of current round and evict finished rounds
          */
         void closeRound();
 
+        /**
+         * Report answer time of awaited leader to timer
+         */
+        void answerReceived();
+
         // ------|Apply data|------
         void applyCommit(model::Peer from, CommitMessage commit);
         void applyReject(model::Peer from, RejectMessage reject);
@@ -95,19 +138,44 @@ namespace iroha {
         void propagateReject(RejectMessage msg);
         void propagateRejectDirectly(model::Peer to, RejectMessage msg);
 
+        /**
+         * Send outcome of decided round to peer which voted in it
+         */
+        void answerDecided(model::Peer to, const Answer &answer);
+
         // ------|Fields|------
         YacVoteStorage vote_storage_;
+        // memory of vote storage, published for other threads
+        std::atomic<size_t> votes_memory_{0};
         std::shared_ptr<YacNetwork> network_;
         std::shared_ptr<YacCryptoProvider> crypto_;
         std::shared_ptr<Timer> timer_;
+        std::shared_ptr<network::PeerHealth> health_;
         rxcpp::subjects::subject<CommitMessage> notifier_;
 
         // ------|One round|------
         ClusterOrdering cluster_order_;
 
+        // leader which has received our vote and the time of sending
+        nonstd::optional<std::pair<model::Peer,
+                                   std::chrono::steady_clock::time_point>>
+            awaited_leader_;
+
+        // moment of own vote in current round, origin of vote latencies
+        nonstd::optional<std::chrono::steady_clock::time_point> voted_at_;
+
+        // last signed own vote
+        nonstd::optional<VoteMessage> own_vote_;
+
+        // milliseconds of waiting for leader, changed on executor
+        uint64_t delay_;
+
+        logger::Logger log_;
 
-        // ------|Constants|------
-        const uint64_t delay_;
+        // declared last to stop executing tasks before other fields die
+        std::shared_ptr<Executor> executor_;
+        // stops before executor, which receives its verified votes
+        std::shared_ptr<VoteVerifier> verifier_;
       };
     }  // namespace yac
   }    // namespace consensus
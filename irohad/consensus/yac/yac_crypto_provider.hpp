@@ -18,6 +18,8 @@
 #ifndef IROHA_YAC_CRYPTO_PROVIDER_HPP
 #define IROHA_YAC_CRYPTO_PROVIDER_HPP
 
+#include <functional>
+#include <vector>
 #include "consensus/yac/messages.hpp"
 
 namespace iroha {
@@ -47,6 +49,22 @@ namespace iroha {
          */
         virtual bool verify(VoteMessage msg) = 0;
 
+        /**
+         * Verify signatories of many independent votes, by default one by
+         * one
+         * @param votes - for verification
+         * @return result of verification of each vote
+         */
+        virtual std::vector<bool> verifyBatch(
+            const std::vector<VoteMessage> &votes) {
+          std::vector<bool> result;
+          result.reserve(votes.size());
+          for (const auto &vote : votes) {
+            result.push_back(verify(vote));
+          }
+          return result;
+        }
+
         /**
          * Generate vote for provided hash;
          * @param hash - hash for signing
@@ -54,6 +72,18 @@ namespace iroha {
          */
         virtual VoteMessage getVote(YacHash hash) = 0;
 
+        /**
+         * Generate vote for provided hash without waiting for the key, by
+         * default immediately
+         * @param hash - hash for signing
+         * @param callback - receives vote, may be invoked from another
+         * thread
+         */
+        virtual void getVoteAsync(YacHash hash,
+                                  std::function<void(VoteMessage)> callback) {
+          callback(getVote(hash));
+        }
+
         virtual ~YacCryptoProvider() = default;
       };
 
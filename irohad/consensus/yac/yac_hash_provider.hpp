@@ -18,12 +18,17 @@
 #ifndef IROHA_YAC_HASH_PROVIDER_HPP
 #define IROHA_YAC_HASH_PROVIDER_HPP
 
+#include <algorithm>
 #include <functional>
+#include <nonstd/optional.hpp>
 #include <string>
 #include <vector>
+#include "common/byteutils.hpp"
+#include "common/types.hpp"
 #include "consensus/yac/cluster_order.hpp"
 #include "model/block.hpp"
 #include "model/peer.hpp"
+#include "model/proposal.hpp"
 
 namespace iroha {
   namespace consensus {
@@ -31,22 +36,38 @@ namespace iroha {
 
       class YacHash {
        public:
-        YacHash(std::string proposal, std::string block)
-            : proposal_hash(std::move(proposal)),
-              block_hash(std::move(block)) {
+        YacHash(const hash256_t &proposal, const hash256_t &block)
+            : proposal_hash(proposal), block_hash(block) {
         }
 
         YacHash() = default;
 
+        /**
+         * Make hash from byte strings, such as fields of network message
+         * @return hash, nullopt if some string is not of hash size
+         */
+        static nonstd::optional<YacHash> fromBytes(const std::string &proposal,
+                                                   const std::string &block) {
+          if (proposal.size() != hash256_t::size()
+              or block.size() != hash256_t::size()) {
+            return nonstd::nullopt;
+          }
+          YacHash hash;
+          std::copy(proposal.begin(), proposal.end(),
+                    hash.proposal_hash.begin());
+          std::copy(block.begin(), block.end(), hash.block_hash.begin());
+          return hash;
+        }
+
         /**
          * Hash computed from proposal
          */
-        std::string proposal_hash;
+        hash256_t proposal_hash{};
 
         /**
          * Hash computed from block;
          */
-        std::string block_hash;
+        hash256_t block_hash{};
 
         bool operator==(const YacHash &obj) const {
           return proposal_hash == obj.proposal_hash and
@@ -68,7 +89,15 @@ namespace iroha {
          * @param block - for hashing
          * @return hashed value of block
          */
-        virtual YacHash makeHash(model::Block &block) = 0;
+        virtual YacHash makeHash(const model::Block &block) = 0;
+
+        /**
+         * Make hash-only vote value from proposal, which does not require
+         * block to be built before voting
+         * @param proposal - for hashing
+         * @return hash with the same proposal and block parts
+         */
+        virtual YacHash makeProposalHash(const model::Proposal &proposal) = 0;
 
         virtual ~YacHashProvider() = default;
       };
@@ -81,7 +110,11 @@ namespace std {
   template <>
   struct hash<iroha::consensus::yac::YacHash> {
     std::size_t operator()(const iroha::consensus::yac::YacHash &obj) const {
-      return std::hash<std::string>()(obj.proposal_hash + obj.block_hash);
+      return hashlittle(obj.block_hash.data(),
+                        obj.block_hash.size(),
+                        hashlittle(obj.proposal_hash.data(),
+                                   obj.proposal_hash.size(),
+                                   1337));
     }
   };
 }
@@ -19,6 +19,7 @@
 #define IROHA_YAC_NETWORK_INTERFACE_HPP
 
 #include <memory>
+#include <vector>
 #include "consensus/yac/messages.hpp"
 #include "model/peer.hpp"
 
@@ -78,6 +79,37 @@ namespace iroha {
          */
         virtual void send_vote(model::Peer to, VoteMessage vote) = 0;
 
+        /**
+         * Share commit message with all peers, by default directly
+         * @param peers - recipients
+         * @param commit - message for sending
+         */
+        virtual void broadcast_commit(const std::vector<model::Peer> &peers,
+                                      CommitMessage commit) {
+          for (const auto &peer : peers) {
+            send_commit(peer, commit);
+          }
+        }
+
+        /**
+         * Share reject message with all peers, by default directly
+         * @param peers - recipients
+         * @param reject - message for sending
+         */
+        virtual void broadcast_reject(const std::vector<model::Peer> &peers,
+                                      RejectMessage reject) {
+          for (const auto &peer : peers) {
+            send_reject(peer, reject);
+          }
+        }
+
+        /**
+         * Notify that message received from peer failed verification,
+         * by default nothing is done
+         * @param from - peer that provide message
+         */
+        virtual void report_invalid(const model::Peer &from) {}
+
         /**
          * Virtual destructor required for inheritance
          */
@@ -15,21 +15,37 @@ limitations under the License.
 */
 
 #include "main/application.hpp"
+#include <algorithm>
+#include <csignal>
+#include <cstdlib>
+#include <limits>
 #include <synchronizer/impl/synchronizer_impl.hpp>
 #include <validation/impl/chain_validator_impl.hpp>
-#include <gmock/gmock.h>
 #include "model/converters/pb_transaction_factory.hpp"
 #include "torii/processor/transaction_processor_impl.hpp"
 #include "network/block_loader.hpp"
+#include "network/impl/block_loader_impl.hpp"
+#include "network/impl/block_loader_service.hpp"
 
 #include "simulator/impl/simulator.hpp"
+#include "network/impl/peer_authenticator.hpp"
 #include "network/impl/peer_communication_service_impl.hpp"
 
 #include "validation/impl/stateful_validator_impl.hpp"
 
+#include "main/impl/internal_service_handler.hpp"
 #include "main/impl/ordering_init.hpp"
 #include "main/impl/consensus_init.hpp"
+#include "main/iroha_conf_loader.hpp"
+#include "consensus/round_tracer.hpp"
+#include "affinity/affinity.hpp"
+#include "allocator/allocator.hpp"
+#include "metrics/metrics.hpp"
+#include "profiler/profiler.hpp"
+#include "tracing/tracing.hpp"
 #include "ametsuchi/impl/peer_query_wsv.hpp"
+#include "ametsuchi/impl/replica_wsv_query.hpp"
+#include "model/commands/add_peer.hpp"
 
 using namespace iroha;
 using namespace iroha::ametsuchi;
@@ -42,50 +58,141 @@ using namespace iroha::torii;
 using namespace iroha::model::converters;
 using namespace iroha::consensus::yac;
 
+/**
+ * Number of commits between dumps of consensus metrics to log
+ */
+static constexpr uint64_t kMetricsReportRounds = 100;
+
+/**
+ * @return true if block changes the list of ledger peers
+ */
+static bool changesPeers(const Block &block) {
+  return std::any_of(
+      block.transactions.begin(),
+      block.transactions.end(),
+      [](const auto &transaction) {
+        return std::any_of(transaction.commands.begin(),
+                           transaction.commands.end(),
+                           [](const auto &command) {
+                             return instanceof <AddPeer>(*command);
+                           });
+      });
+}
+
+/**
+ * Transactions are forwarded to ordering service in batches of this size,
+ * incomplete batch waits for the delay
+ */
+static constexpr size_t kOrderingBatchSize = 100;
+static constexpr std::chrono::microseconds kOrderingBatchDelay{1000};
+
+/**
+ * Limits of proposal size and delay, ordering service adapts both to load
+ */
+static const iroha::ordering::BatchingController::Bounds kProposalBounds{
+    10, 1000, std::chrono::milliseconds(100), std::chrono::milliseconds(5000)};
+
 Irohad::Irohad(const std::string &block_store_dir,
                const std::string &redis_host, size_t redis_port,
                const std::string &pg_conn, size_t torii_port,
-               uint64_t peer_number)
+               uint64_t peer_number,
+               BlockStorageOptions block_storage_options,
+               YacOptions yac_options,
+               iroha::network::OrderingOptions ordering_options,
+               iroha::network::ChannelOptions channel_options,
+               ListenOptions listen_options,
+               AdmissionOptions admission_options,
+               CryptoOptions crypto_options,
+               ValidationOptions validation_options,
+               ThreadingOptions threading_options,
+               ObserverOptions observer_options,
+               TuningOptions tuning_options)
     : block_store_dir_(block_store_dir),
       redis_host_(redis_host),
       redis_port_(redis_port),
       pg_conn_(pg_conn),
       torii_port_(torii_port),
+      block_storage_options_(block_storage_options),
+      yac_options_(yac_options),
+      ordering_options_(ordering_options),
+      channel_options_(channel_options),
+      listen_options_(listen_options),
+      admission_options_(admission_options),
+      crypto_options_(crypto_options),
+      validation_options_(validation_options),
+      threading_options_(threading_options),
+      observer_options_(std::move(observer_options)),
+      tunables_(tuning_options.config_path),
+      channels_(
+          std::make_shared<iroha::network::ChannelRegistry>(channel_options)),
+      peer_authenticator_(
+          std::make_shared<iroha::network::PeerAuthenticator>()),
       storage(StorageImpl::create(block_store_dir, redis_host, redis_port,
-                                  pg_conn)),
+                                  pg_conn, block_storage_options)),
       peer_number_(peer_number) {
       log_ = logger::log("IROHAD");
       log_->info("created");
 }
 
 Irohad::~Irohad() {
-  internal_server->Shutdown();
-  torii_server->shutdown();
-  internal_thread.join();
-  server_thread.join();
+  // collectors refer to services, so scraping stops before they are gone
+  metrics_server_.reset();
+  for (auto id : metrics_collectors_) {
+    iroha::metrics::registry().remove(id);
+  }
+  for (auto id : memory_subsystems_) {
+    iroha::memory::budget().remove(id);
+  }
+  // subscriber invalidates query cache owned by torii, so it stops first
+  if (block_subscriber_) {
+    block_subscriber_->stop();
+  }
+  if (internal_server) {
+    internal_server->Shutdown();
+    internal_handler->shutdown();
+  }
+  if (torii_server) {
+    torii_server->shutdown();
+  }
+  if (internal_thread.joinable()) {
+    internal_thread.join();
+  }
+  if (server_thread.joinable()) {
+    server_thread.join();
+  }
 }
 
-class MockBlockLoader : public iroha::network::BlockLoader {
- public:
-  MOCK_METHOD2(requestBlocks,
-               rxcpp::observable<model::Block>(model::Peer & ,
-                                               model::Block & ));
-};
-
-class MockCryptoProvider : public ModelCryptoProvider {
- public:
-  MOCK_CONST_METHOD1(verify, bool(
-      const Transaction &));
-  MOCK_CONST_METHOD1(verify, bool(std::shared_ptr<const Query>));
-  MOCK_CONST_METHOD1(verify, bool(
-      const Block &));
-};
-
 void Irohad::run() {
+  if (not observer_options_.validators.empty()) {
+    runObserver();
+    return;
+  }
+  // durations of steps are exported, so slow restarts can be attributed
+  iroha::metrics::StartupPhases phases;
+  // clients of consensus and ordering take queues of the pool on creation
+  iroha::network::clientCompletionPool(threading_options_.grpc_client_threads);
   loop = uvw::Loop::create();
-
-  torii_server =
-      std::make_unique<ServerRunner>("0.0.0.0:" + std::to_string(torii_port_));
+  auto consensus_loop = loop;
+  auto ordering_loop = loop;
+  if (threading_options_.stages) {
+    consensus_stage_ = std::make_unique<iroha::Stage>(
+        "consensus", threading_options_.consensus_core);
+    ordering_stage_ = std::make_unique<iroha::Stage>(
+        "ordering", threading_options_.ordering_core);
+    storage_stage_ = std::make_unique<iroha::Stage>(
+        "storage", threading_options_.storage_core);
+    consensus_loop = consensus_stage_->loop();
+    ordering_loop = ordering_stage_->loop();
+  }
+
+  auto torii_address = listen_options_.torii_address.empty()
+      ? "0.0.0.0:" + std::to_string(torii_port_)
+      : listen_options_.torii_address;
+  // one completion queue per core
+  torii_server = std::make_unique<ServerRunner>(
+      torii_address,
+      std::max(1u, std::thread::hardware_concurrency()),
+      channel_options_);
 
   // Protobuf converters
   auto pb_tx_factory = std::make_shared<PbTransactionFactory>();
@@ -94,15 +201,10 @@ void Irohad::run() {
   log_->info("[Init] => converters");
 
   // Crypto Provider:
-  auto crypto_verifier = std::make_shared<MockCryptoProvider>();
-
-  EXPECT_CALL(*crypto_verifier, verify(::testing::A<const Transaction &>()))
-      .WillRepeatedly(::testing::Return(true));
-  EXPECT_CALL(*crypto_verifier,
-              verify(::testing::A<std::shared_ptr<const Query>>()))
-      .WillRepeatedly(::testing::Return(true));
-  EXPECT_CALL(*crypto_verifier, verify(::testing::A<const Block &>()))
-      .WillRepeatedly(::testing::Return(true));
+  auto crypto_verifier = std::make_shared<ModelCryptoProviderImpl>(
+      crypto_options_.signature_check,
+      std::make_shared<iroha::SignatureCache>(
+          crypto_options_.cache_capacity));
   log_->info("[Init] => crypto provider");
 
   // Hash provider
@@ -111,37 +213,95 @@ void Irohad::run() {
 
   // Validators:
   auto stateless_validator = createStatelessValidator(crypto_verifier);
-  auto stateful_validator = std::make_shared<StatefulValidatorImpl>();
-  auto chain_validator = std::make_shared<ChainValidatorImpl>(crypto_verifier);
+  auto stateful_validator = std::make_shared<StatefulValidatorImpl>(
+      validation_options_.concurrency,
+      validation_options_.speculative,
+      std::chrono::milliseconds(yac_options_.vote_delay
+                                * validation_options_.budget_percent / 100));
+  auto wsv_deltas = std::make_shared<WsvDeltaCache>();
+  auto chain_validator =
+      std::make_shared<ChainValidatorImpl>(crypto_verifier, wsv_deltas);
   log_->info("[Init] => validators");
+  phases.mark("validators");
 
-  auto orderer = std::make_shared<PeerOrdererImpl>(storage);
+  auto orderer = std::make_shared<PeerOrdererImpl>(
+      storage, storage, yac_options_.peer_health);
   log_->info("[Init] => peer orderer");
 
   auto wsv = std::make_shared<ametsuchi::PeerQueryWsv>(storage);
-  auto peer_address = wsv->getLedgerPeers().value().at(peer_number_).address;
+  auto ledger_peers = wsv->getLedgerPeers().value();
+  auto peer_address = ledger_peers.at(peer_number_).address;
+  // channels know keys of peers before the first call, to check their
+  // certificates over TLS
+  channels_->update(ledger_peers);
+  peer_authenticator_->update(ledger_peers);
+  peer_authenticator_->setObservers(observer_options_.observer_keys);
 
   // Ordering gate
-  auto ordering_gate = ordering_init.initOrderingGate(wsv, loop, 10, 5000);
+  auto ordering_gate =
+      ordering_init.initOrderingGate(wsv,
+                                     ordering_loop,
+                                     kProposalBounds,
+                                     channels_,
+                                     kOrderingBatchSize,
+                                     kOrderingBatchDelay,
+                                     ordering_options_.multi_ingest
+                                         ? peer_address
+                                         : std::string());
+  if (ordering_options_.compact_proposals) {
+    ordering_init.ordering_service->enableCompactProposals();
+  }
+  if (not ordering_options_.mempool_log_path.empty()) {
+    // transactions committed before restart are dropped from the log
+    nonstd::optional<size_t> restored;
+    if (auto mempool_log = iroha::ordering::MempoolLog::create(
+            ordering_options_.mempool_log_path)) {
+      restored = ordering_init.ordering_service->enableMempoolLog(
+          std::move(mempool_log),
+          [storage = storage](const iroha::hash256_t &hash) {
+            return storage->hasTransaction(hash);
+          });
+    }
+    if (restored) {
+      log_->info("[Init] => restored {} transactions of mempool", *restored);
+    } else {
+      log_->warn("[Init] => mempool log in {} is not used",
+                 ordering_options_.mempool_log_path);
+    }
+  }
   log_->info("[Init] => init ordering gate - [{}]",
               logger::logBool(ordering_gate));
+  phases.mark("ordering");
 
   // Simulator
   auto simulator = createSimulator(ordering_gate, stateful_validator, storage,
-                                   storage, hash_provider);
+                                   storage, hash_provider, wsv_deltas);
+
+  // Block loader
+  auto block_loader =
+      std::make_shared<BlockLoaderImpl>(wsv, storage, channels_);
+  loader_service = std::make_shared<BlockLoaderService>(storage);
+  log_->info("[Init] => block loader");
 
   // Consensus gate
   auto consensus_gate = yac_init.initConsensusGate(peer_address,
-                                                   loop,
+                                                   consensus_loop,
                                                    orderer,
-                                                   simulator);
-
-  // Block loader
-  auto block_loader = std::make_shared<MockBlockLoader>();
+                                                   simulator,
+                                                   block_loader,
+                                                   yac_options_,
+                                                   channels_,
+                                                   ordering_gate);
+  initTunables();
+  phases.mark("consensus");
 
   // Synchronizer
-  auto synchronizer = createSynchronizer(consensus_gate, chain_validator,
-                                         storage, block_loader);
+  auto synchronizer = createSynchronizer(consensus_gate,
+                                         chain_validator,
+                                         storage,
+                                         block_loader,
+                                         storage,
+                                         yac_options_.peer_health);
 
   // PeerCommunicationService
   auto pcs = createPeerCommunicationService(ordering_gate, synchronizer);
@@ -150,52 +310,292 @@ void Irohad::run() {
     log_->info("~~~~~~~~~| PROPOSAL ^_^ |~~~~~~~~~ ");
   });
 
-  pcs->on_commit().subscribe([this](auto) {
+  // observers waiting for the next block are woken up, load generators
+  // measure throughput by committed transactions
+  pcs->on_commit().subscribe([this](auto commit) {
+    static auto &committed = iroha::metrics::registry().counter(
+        "iroha_committed_transactions_total",
+        "Transactions of blocks committed by this peer");
+    commit.subscribe([this](const auto &block) {
+      loader_service->committed(block->height);
+      committed.inc(block->transactions.size());
+    });
+  });
+
+  // with stages, commits reach their consumers on the consumers' threads,
+  // so a slow consumer does not hold the synchronizer
+  auto commits_on = [&pcs](const std::unique_ptr<iroha::Stage> &stage) {
+    auto commits = pcs->on_commit();
+    return stage ? commits.observe_on(stage->coordination()).as_dynamic()
+                 : commits;
+  };
+
+  commits_on(ordering_stage_).subscribe([this, commits = 0ull](
+                                            auto commit) mutable {
     log_->info("~~~~~~~~~| COMMIT =^._.^= |~~~~~~~~~ ");
+    static auto &round_time = iroha::metrics::registry().histogram(
+        "iroha_consensus_round_seconds",
+        "Time from receiving proposal to committing its block",
+        iroha::metrics::latencyBounds());
+    // duration of consensus round drives adaptive proposal size
+    commit.subscribe([this](const auto &block) {
+      ordering_init.ordering_service->committed(block->height);
+      auto trace = iroha::consensus::roundTracer().round(block->height);
+      if (not trace) {
+        return;
+      }
+      const auto &phases = trace->phases;
+      const auto &received = phases.at(static_cast<size_t>(
+          iroha::consensus::RoundPhase::ProposalReceived));
+      const auto &committed = phases.at(
+          static_cast<size_t>(iroha::consensus::RoundPhase::Committed));
+      if (received and committed) {
+        round_time.observe(*committed - *received);
+        ordering_init.ordering_service->roundCompleted(
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                *committed - *received));
+      }
+    });
+    // spans of committed transactions are complete on this peer
+    iroha::tracing::tracer().flush();
+    if (++commits % kMetricsReportRounds == 0) {
+      log_->info("consensus metrics:\n{}",
+                 iroha::consensus::roundTracer().report());
+      log_->info("mempool metrics:\n{}",
+                 ordering_init.ordering_service->metrics());
+    }
   });
 
   // Torii:
   // --- Transactions:
   auto tx_processor = createTransactionProcessor(pcs, stateless_validator);
 
-  command_service = createCommandService(pb_tx_factory, tx_processor);
+  auto status_tracker = std::make_shared<TransactionStatusTracker>(
+      tx_processor, pcs, simulator);
+
+  // quotas are checked against depth of local mempool, which fills up
+  // first when clients send faster than ledger commits
+  std::shared_ptr<::torii::AdmissionControl> admission;
+  if (admission_options_.rate > 0) {
+    auto ordering_service = ordering_init.ordering_service;
+    admission = std::make_shared<::torii::AdmissionControl>(
+        admission_options_.rate,
+        admission_options_.burst,
+        [ordering_service] { return ordering_service->queueDepth(); },
+        admission_options_.shed_depth);
+  }
+
+  // replayed transactions are refused by counters of their creators
+  auto counters = std::make_shared<::torii::TxCounterFilter>(
+      [storage = storage](const std::string &account_id)
+          -> nonstd::optional<uint64_t> {
+        auto account = storage->getAccount(account_id);
+        if (not account) {
+          return nonstd::nullopt;
+        }
+        return account->tx_counter;
+      });
+  pcs->on_commit().subscribe([counters](auto commit) {
+    commit.subscribe(
+        [counters](const auto &block) { counters->committed(*block); });
+  });
+
+  command_service = createCommandService(
+      pb_tx_factory, tx_processor, status_tracker, admission, counters);
 
   // --- Queries
-  auto query_proccessing_factory =
-      createQueryProcessingFactory(storage, storage);
+  // client queries are served by standby when it is configured
+  std::shared_ptr<ametsuchi::WsvQuery> query_wsv = storage;
+  if (not block_storage_options_.wsv_replica.empty()) {
+    auto storage_ptr = storage;
+    query_wsv = std::make_shared<ametsuchi::ReplicaWsvQuery>(
+        block_storage_options_.wsv_replica,
+        storage,
+        [storage_ptr] { return storage_ptr->height(); },
+        block_storage_options_.wsv_replica_max_lag);
+  }
+  // standby applies blocks later than they are notified, so reads are
+  // cached only from own world state view
+  auto cache_results = block_storage_options_.wsv_replica.empty();
+  // batches see one state only when world state view is read from storage
+  std::shared_ptr<SnapshotPinFactory> snapshots;
+  if (cache_results) {
+    snapshots = storage;
+  }
+  auto query_proccessing_factory = createQueryProcessingFactory(
+      query_wsv, storage, cache_results, snapshots);
+  if (cache_results) {
+    // factory is owned by query processor, which lives as long as irohad
+    commits_on(storage_stage_).subscribe(
+        [factory = query_proccessing_factory.get()](auto commit) {
+          commit.subscribe(
+              [factory](const auto &block) { factory->invalidate(*block); });
+        });
+  }
 
   auto query_processor = createQueryProcessor(
       std::move(query_proccessing_factory), stateless_validator);
 
   query_service = createQueryService(
-      pb_query_factory, pb_query_response_factory, query_processor);
+      pb_query_factory, pb_query_response_factory, query_processor, storage);
+
+  // peers added by committed blocks join consensus and ordering without
+  // restart; orderer and ordering service read peers every round
+  pcs->on_commit().subscribe([this](auto commit) {
+    auto changed = false;
+    commit.subscribe([&changed](const auto &block) {
+      changed = changed or changesPeers(*block);
+    });
+    if (not changed) {
+      return;
+    }
+    auto peers = storage->getPeers();
+    if (not peers) {
+      log_->error("cannot read peers of ledger");
+      return;
+    }
+    log_->info("peer list is changed, {} peers", peers->size());
+    channels_->update(*peers);
+    peer_authenticator_->update(*peers);
+    yac_init.consensus_network->updatePeers(*peers);
+    if (ordering_init.ordering_gate) {
+      ordering_init.ordering_gate->updateLeaders(*peers);
+    }
+  });
+
+  // services are owned by torii server once it runs, and live as long as it
+  pcs->on_commit().subscribe([this,
+                              commands = command_service.get(),
+                              queries = query_service.get(),
+                              commits = 0ull](auto commit) mutable {
+    // subscriptions waiting for the next block read it from storage
+    commit.subscribe(
+        [queries](const auto &block) { queries->committed(block->height); });
+    if (++commits % kMetricsReportRounds == 0) {
+      log_->info("torii metrics:\n{}{}", commands->metrics(),
+                 queries->metrics());
+    }
+  });
 
   grpc::ServerBuilder builder;
   int port = 0;
-  builder.AddListeningPort(peer_address,
-                           grpc::InsecureServerCredentials(), &port);
-  builder.RegisterService(ordering_init.ordering_gate.get());
-  builder.RegisterService(ordering_init.ordering_service.get());
-  builder.RegisterService(yac_init.consensus_network.get());
+  // over TLS only ledger peers are served, and observers fetch blocks
+  auto credentials = iroha::network::serverCredentials(channel_options_,
+                                                       peer_authenticator_);
+  builder.AddListeningPort(peer_address, credentials, &port);
+  if (not listen_options_.internal_address.empty()) {
+    builder.AddListeningPort(listen_options_.internal_address, credentials);
+  }
+  iroha::network::configureServer(builder, channel_options_);
+  phases.mark("services");
+
+  // peers are served once caches are warm, so the first rounds after
+  // restart are not slowed down by cold reads
+  storage->waitWarmUp();
+  phases.mark("warm_up");
+
+  // peer-to-peer rpcs are served asynchronously by fixed number of threads,
+  // block streams are long, so they use synchronous threads
+  internal_handler = std::make_unique<InternalServiceHandler>(builder);
+  internal_handler->assignServices(yac_init.consensus_network,
+                                   ordering_init.ordering_gate,
+                                   ordering_init.ordering_service);
+  builder.RegisterService(loader_service.get());
   internal_server = builder.BuildAndStart();
-  internal_thread = std::thread([this] { internal_server->Wait(); });
+  internal_thread = std::thread([this] { internal_handler->handleRpcs(); });
+  serveMetrics();
+  initMemoryBudget();
   server_thread = std::thread([this] {
     torii_server->run(std::move(command_service), std::move(query_service));
   });
   log_->info("===> iroha initialized");
   torii_server->waitForServersReady();
+  phases.mark("servers");
+  for (auto stage :
+       {consensus_stage_.get(), ordering_stage_.get(), storage_stage_.get()}) {
+    if (stage) {
+      stage->start();
+    }
+  }
+  iroha::Stage::pinCurrentThread(threading_options_.io_core);
+  iroha::affinity::nameCurrentThread("io-loop");
+  // loop of the main thread may have no handles left when stages run
+  // on their own threads, the handle keeps it running
+  auto keep_alive = loop->resource<uvw::AsyncHandle>();
   loop->run();
 }
 
+void Irohad::runObserver() {
+  auto torii_address = listen_options_.torii_address.empty()
+      ? "0.0.0.0:" + std::to_string(torii_port_)
+      : listen_options_.torii_address;
+  torii_server = std::make_unique<ServerRunner>(
+      torii_address,
+      std::max(1u, std::thread::hardware_concurrency()),
+      channel_options_);
+
+  auto pb_query_factory = std::make_shared<PbQueryFactory>();
+  auto pb_query_response_factory = std::make_shared<PbQueryResponseFactory>();
+
+  auto crypto_verifier = std::make_shared<ModelCryptoProviderImpl>(
+      crypto_options_.signature_check,
+      std::make_shared<iroha::SignatureCache>(
+          crypto_options_.cache_capacity));
+  auto stateless_validator = createStatelessValidator(crypto_verifier);
+  auto chain_validator = std::make_shared<ChainValidatorImpl>(crypto_verifier);
+
+  // certificates of validators are checked by keys, of ledger peers or
+  // configured ones, since validators may be reached at other addresses
+  if (auto peers = storage->getPeers()) {
+    channels_->update(*peers);
+  }
+  for (const auto &validator : observer_options_.validator_keys) {
+    channels_->pin(validator.first, validator.second);
+  }
+  block_subscriber_ = std::make_unique<BlockSubscriber>(
+      observer_options_.validators, channels_, chain_validator, storage,
+      storage);
+  log_->info("[Init] => block subscriber, {} validators",
+             observer_options_.validators.size());
+
+  auto query_proccessing_factory =
+      createQueryProcessingFactory(storage, storage, true, storage);
+  // factory is owned by query processor, which lives as long as irohad
+  block_subscriber_->on_commit().subscribe(
+      [factory = query_proccessing_factory.get()](auto commit) {
+        commit.subscribe(
+            [factory](const auto &block) { factory->invalidate(*block); });
+      });
+  auto query_processor = createQueryProcessor(
+      std::move(query_proccessing_factory), stateless_validator);
+  query_service = createQueryService(
+      pb_query_factory, pb_query_response_factory, query_processor, storage);
+  block_subscriber_->on_commit().subscribe(
+      [queries = query_service.get()](auto commit) {
+        commit.subscribe([queries](const auto &block) {
+          queries->committed(block->height);
+        });
+      });
+
+  server_thread = std::thread([this] {
+    torii_server->run(nullptr, std::move(query_service));
+  });
+  torii_server->waitForServersReady();
+  block_subscriber_->start();
+  log_->info("===> iroha observer initialized");
+  server_thread.join();
+}
+
 std::shared_ptr<Simulator> Irohad::createSimulator(
     std::shared_ptr<OrderingGate> ordering_gate,
     std::shared_ptr<StatefulValidator> stateful_validator,
     std::shared_ptr<BlockQuery> block_query,
     std::shared_ptr<TemporaryFactory> temporary_factory,
-    std::shared_ptr<HashProviderImpl> hash_provider) {
+    std::shared_ptr<HashProviderImpl> hash_provider,
+    std::shared_ptr<WsvDeltaCache> wsv_deltas) {
   return std::make_shared<Simulator>(ordering_gate, stateful_validator,
                                      temporary_factory, block_query,
-                                     hash_provider);
+                                     hash_provider, wsv_deltas);
 }
 
 std::shared_ptr<PeerCommunicationService>
@@ -206,27 +606,226 @@ Irohad::createPeerCommunicationService(
                                                         synchronizer);
 }
 
+bool Irohad::syncHeaders(const std::string &peer_address) {
+  auto heights = storage->wsvSnapshotHeights();
+  if (heights.empty()) {
+    log_->error("No snapshot of world state view to sync to");
+    return false;
+  }
+  auto crypto_verifier = std::make_shared<ModelCryptoProviderImpl>(
+      crypto_options_.signature_check,
+      std::make_shared<iroha::SignatureCache>(
+          crypto_options_.cache_capacity));
+  ChainValidatorImpl validator(crypto_verifier);
+  BlockLoaderImpl loader(
+      std::make_shared<ametsuchi::PeerQueryWsv>(storage), storage, channels_);
+
+  Peer peer;
+  peer.address = peer_address;
+  std::vector<Block> chain;
+  loader.retrieveChain({peer}, heights.back())
+      .as_blocking()
+      .subscribe([&chain](auto block) { chain.push_back(std::move(block)); });
+  if (chain.empty() or chain.back().height != heights.back()) {
+    log_->error("Blocks up to snapshot at height {} are not downloaded",
+                heights.back());
+    return false;
+  }
+  if (not validator.validateHeaders(chain)) {
+    log_->error("Downloaded blocks are invalid");
+    return false;
+  }
+  return storage->insertBlocks(chain);
+}
+
 std::shared_ptr<Synchronizer> Irohad::createSynchronizer(
     std::shared_ptr<ConsensusGate> consensus_gate,
     std::shared_ptr<ChainValidator> validator,
     std::shared_ptr<MutableFactory> mutableFactory,
-    std::shared_ptr<BlockLoader> blockLoader) {
-  return std::make_shared<SynchronizerImpl>(consensus_gate, validator,
-                                            mutableFactory, blockLoader);
+    std::shared_ptr<BlockLoader> blockLoader,
+    std::shared_ptr<BlockQuery> blockQuery,
+    std::shared_ptr<PeerHealth> health) {
+  return std::make_shared<SynchronizerImpl>(consensus_gate,
+                                            validator,
+                                            mutableFactory,
+                                            blockLoader,
+                                            blockQuery,
+                                            SynchronizerImpl::kCommitBatch,
+                                            std::move(health));
+}
+
+void Irohad::initTunables() {
+  const uint64_t kMaxSize = 100000;
+  const uint64_t kMaxDelay = 600000;
+  auto ordering_service = ordering_init.ordering_service;
+  auto bounds = ordering_service->proposalBounds();
+  auto set_bound = [ordering_service](auto field) {
+    return [ordering_service, field](uint64_t value) {
+      auto bounds = ordering_service->proposalBounds();
+      field(bounds, value);
+      ordering_service->setProposalBounds(bounds);
+    };
+  };
+  tunables_.add(config_members::ProposalMinSize,
+                bounds.min_size,
+                1,
+                kMaxSize,
+                set_bound([](auto &bounds, uint64_t value) {
+                  bounds.min_size = value;
+                }));
+  tunables_.add(config_members::ProposalMaxSize,
+                bounds.max_size,
+                1,
+                kMaxSize,
+                set_bound([](auto &bounds, uint64_t value) {
+                  bounds.max_size = value;
+                }));
+  tunables_.add(config_members::ProposalMinDelay,
+                bounds.min_delay.count(),
+                1,
+                kMaxDelay,
+                set_bound([](auto &bounds, uint64_t value) {
+                  bounds.min_delay = std::chrono::milliseconds(value);
+                }));
+  tunables_.add(config_members::ProposalMaxDelay,
+                bounds.max_delay.count(),
+                1,
+                kMaxDelay,
+                set_bound([](auto &bounds, uint64_t value) {
+                  bounds.max_delay = std::chrono::milliseconds(value);
+                }));
+  tunables_.add(config_members::ConsensusVoteDelay,
+                yac_options_.vote_delay,
+                1,
+                kMaxDelay,
+                [yac = yac_init.yac](uint64_t value) { yac->setDelay(value); });
+  // 0 disables eviction, usage is exported anyway
+  tunables_.add(config_members::MemoryLimit,
+                iroha::memory::budget().limit(),
+                0,
+                std::numeric_limits<uint64_t>::max(),
+                [](uint64_t value) { iroha::memory::budget().setLimit(value); });
+  tunables_.reload();
+
+  reload_signal_ = loop->resource<uvw::SignalHandle>();
+  reload_signal_->on<uvw::SignalEvent>(
+      [this](const auto &, auto &) { tunables_.reload(); });
+  reload_signal_->start(SIGHUP);
+}
+
+void Irohad::initMemoryBudget() {
+  const auto kCheckPeriod = std::chrono::seconds(1);
+  auto &budget = iroha::memory::budget();
+  // cached blocks are read again from disk, so they go first; dropped
+  // handlers fail requests of clients, commands are dropped last
+  memory_subsystems_.push_back(budget.add(
+      "block_cache",
+      0,
+      [storage = storage] { return storage->blockCache().bytes(); },
+      [storage = storage](size_t bytes) {
+        return storage->blockCache().shrink(bytes);
+      }));
+  // services are owned by torii server, subsystems are removed before it
+  memory_subsystems_.push_back(budget.add(
+      "query_handlers",
+      1,
+      [queries = query_service.get()] { return queries->memoryUsage(); },
+      [queries = query_service.get()](size_t bytes) {
+        return queries->releaseMemory(bytes);
+      }));
+  memory_subsystems_.push_back(budget.add(
+      "command_handlers",
+      2,
+      [commands = command_service.get()] { return commands->memoryUsage(); },
+      [commands = command_service.get()](size_t bytes) {
+        return commands->releaseMemory(bytes);
+      }));
+  // queued transactions and votes are bounded by their own limits, they
+  // are accounted but not evicted
+  memory_subsystems_.push_back(budget.add(
+      "mempool",
+      3,
+      [ordering_service = ordering_init.ordering_service] {
+        return ordering_service->queueBytes();
+      }));
+  memory_subsystems_.push_back(
+      budget.add("yac_votes", 3, [yac = yac_init.yac] {
+        return yac->votesMemory();
+      }));
+  budget.start(kCheckPeriod);
+}
+
+void Irohad::serveMetrics() {
+  if (listen_options_.metrics_address.empty()) {
+    return;
+  }
+  auto &registry = iroha::metrics::registry();
+  auto ordering_service = ordering_init.ordering_service;
+  metrics_collectors_.push_back(registry.collect(
+      [] { return iroha::consensus::roundTracer().report(); }));
+  metrics_collectors_.push_back(registry.collect(
+      [ordering_service] { return ordering_service->metrics(); }));
+  // collectors are removed before torii server, which owns the services
+  metrics_collectors_.push_back(registry.collect(
+      [commands = command_service.get()] { return commands->metrics(); }));
+  metrics_collectors_.push_back(registry.collect(
+      [queries = query_service.get()] { return queries->metrics(); }));
+  metrics_collectors_.push_back(
+      registry.collect([] { return iroha::allocator::report(); }));
+  std::map<std::string, iroha::metrics::MetricsServer::Handler> handlers;
+  handlers["/debug/tunables"] = [this](const std::string &query) {
+    if (query == "reload") {
+      tunables_.reload();
+    }
+    return tunables_.report();
+  };
+  handlers["/debug/allocator"] = [](const std::string &query) {
+    if (query == "purge" and not iroha::allocator::purge()) {
+      return std::string(iroha::allocator::name())
+          + " allocator can not purge\n";
+    }
+    return iroha::allocator::report();
+  };
+  if (listen_options_.profiler) {
+    handlers["/debug/profile"] = [this](const std::string &query) {
+      // scrapes wait while profile is taken, so its length is bounded
+      const uint64_t kMaxSeconds = 60;
+      uint64_t seconds = 10;
+      if (query.compare(0, 8, "seconds=") == 0) {
+        seconds = std::strtoull(query.c_str() + 8, nullptr, 10);
+      }
+      seconds = std::max<uint64_t>(1, std::min(seconds, kMaxSeconds));
+      log_->info("taking CPU profile for {} s", seconds);
+      auto profile = iroha::profiler::profiler().profile(
+          std::chrono::seconds(seconds));
+      return profile ? *profile : std::string("profile is being taken\n");
+    };
+  }
+  metrics_server_ = std::make_unique<iroha::metrics::MetricsServer>(
+      listen_options_.metrics_address,
+      [&registry] { return registry.render(); },
+      std::move(handlers));
 }
 
 std::unique_ptr<::torii::CommandService> Irohad::createCommandService(
     std::shared_ptr<PbTransactionFactory> pb_factory,
-    std::shared_ptr<TransactionProcessor> txProccesor) {
-  return std::make_unique<::torii::CommandService>(pb_factory, txProccesor);
+    std::shared_ptr<TransactionProcessor> txProccesor,
+    std::shared_ptr<TransactionStatusTracker> tracker,
+    std::shared_ptr<::torii::AdmissionControl> admission,
+    std::shared_ptr<::torii::TxCounterFilter> counters) {
+  return std::make_unique<::torii::CommandService>(
+      pb_factory, txProccesor, tracker, admission, counters);
 }
 
 std::unique_ptr<::torii::QueryService> Irohad::createQueryService(
     std::shared_ptr<PbQueryFactory> pb_query_factory,
     std::shared_ptr<PbQueryResponseFactory> pb_query_response_factory,
-    std::shared_ptr<QueryProcessor> query_processor) {
-  return std::make_unique<::torii::QueryService>(
-      pb_query_factory, pb_query_response_factory, query_processor);
+    std::shared_ptr<QueryProcessor> query_processor,
+    std::shared_ptr<BlockQuery> block_query) {
+  return std::make_unique<::torii::QueryService>(pb_query_factory,
+                                                 pb_query_response_factory,
+                                                 query_processor,
+                                                 block_query);
 }
 
 std::shared_ptr<QueryProcessor> Irohad::createQueryProcessor(
@@ -239,7 +838,9 @@ std::shared_ptr<QueryProcessor> Irohad::createQueryProcessor(
 std::shared_ptr<TransactionProcessor> Irohad::createTransactionProcessor(
     std::shared_ptr<PeerCommunicationService> pcs,
     std::shared_ptr<StatelessValidator> validator) {
-  return std::make_shared<TransactionProcessorImpl>(pcs, validator);
+  // signature checks of incoming transactions use all cores
+  return std::make_shared<TransactionProcessorImpl>(
+      pcs, validator, std::max(1u, std::thread::hardware_concurrency()));
 }
 
 std::shared_ptr<StatelessValidator> Irohad::createStatelessValidator(
@@ -249,6 +850,9 @@ std::shared_ptr<StatelessValidator> Irohad::createStatelessValidator(
 
 std::unique_ptr<QueryProcessingFactory> Irohad::createQueryProcessingFactory(
     std::shared_ptr<WsvQuery> wsvQuery,
-    std::shared_ptr<BlockQuery> blockQuery) {
-  return std::make_unique<QueryProcessingFactory>(wsvQuery, blockQuery);
+    std::shared_ptr<BlockQuery> blockQuery,
+    bool cache_results,
+    std::shared_ptr<SnapshotPinFactory> snapshots) {
+  return std::make_unique<QueryProcessingFactory>(
+      wsvQuery, blockQuery, cache_results, snapshots);
 }
@@ -24,9 +24,15 @@
 
 #include <ametsuchi/impl/storage_impl.hpp>
 #include <crypto/crypto.hpp>
+#include <unordered_map>
 #include <uvw/loop.hpp>
 #include "network/consensus_gate.hpp"
 #include "network/block_loader.hpp"
+#include "network/impl/block_loader_service.hpp"
+#include "network/impl/block_subscriber.hpp"
+#include "network/impl/channel_registry.hpp"
+#include "network/impl/peer_authenticator.hpp"
+#include "network/impl/client_completion_pool.hpp"
 #include "synchronizer/synchronizer.hpp"
 #include "validation/chain_validator.hpp"
 
@@ -41,11 +47,176 @@
 
 #include "simulator/impl/simulator.hpp"
 
+#include "main/impl/internal_service_handler.hpp"
 #include "main/impl/ordering_init.hpp"
 #include "main/impl/consensus_init.hpp"
+#include "main/impl/stage.hpp"
+#include "main/impl/tunables.hpp"
+#include "memory/memory_budget.hpp"
+#include "metrics/metrics_server.hpp"
 
 #include "logger/logger.hpp"
 
+/**
+ * Addresses served by irohad besides its ledger peer address.
+ * Besides host:port, unix:path addresses are accepted, so co-located
+ * components talk without loopback TCP
+ */
+struct ListenOptions {
+  /**
+   * Address of Torii, 0.0.0.0:torii_port when empty
+   */
+  std::string torii_address;
+
+  /**
+   * Additional address of internal services, not listened when empty
+   */
+  std::string internal_address;
+
+  /**
+   * Address of Prometheus metrics endpoint, not served when empty
+   */
+  std::string metrics_address;
+
+  /**
+   * Serve CPU profiles of the process at /debug/profile?seconds=N of
+   * metrics endpoint, in collapsed-stack format
+   */
+  bool profiler = false;
+};
+
+/**
+ * Quotas of Torii clients, keyed by creator account of transactions
+ */
+struct AdmissionOptions {
+  /**
+   * Transactions per second admitted from one creator, no quotas if zero
+   */
+  double rate = 0;
+
+  /**
+   * Transactions admitted from idle creator at once
+   */
+  size_t burst = 100;
+
+  /**
+   * Mempool depth from which creators using their quota are shed, no
+   * shedding if zero
+   */
+  size_t shed_depth = 0;
+};
+
+/**
+ * Verification of transaction, query and block signatures, signatures of
+ * consensus votes are verified when peer keys are set in YacOptions
+ */
+struct CryptoOptions {
+  /**
+   * How signatures are checked, nothing is checked by default, for test
+   * networks; checked block signatures are consensus votes of peers, so
+   * validators need peer keys in YacOptions
+   */
+  iroha::model::SignatureCheck signature_check =
+      iroha::model::SignatureCheck::None;
+
+  /**
+   * Max number of valid signatures remembered by cached check
+   */
+  size_t cache_capacity = iroha::SignatureCache::kDefaultCapacity;
+};
+
+/**
+ * Stateful validation of proposals
+ */
+struct ValidationOptions {
+  /**
+   * Number of validating threads, hardware concurrency if zero
+   */
+  size_t concurrency = 0;
+
+  /**
+   * Execute transactions speculatively and re-execute the ones which have
+   * read stale values, instead of deriving conflicts from commands
+   */
+  bool speculative = false;
+
+  /**
+   * Time validation of proposal may take, in percent of consensus vote
+   * delay, zero for no limit. Transactions not validated in time are
+   * proposed again. Peers which stop at different transactions create
+   * different blocks, so the limit is off by default
+   */
+  uint32_t budget_percent = 0;
+};
+
+/**
+ * Threads of pipeline stages. Core indices are negative for no pinning
+ */
+struct ThreadingOptions {
+  /**
+   * Run consensus and ordering loops and storage work on threads of their
+   * own, otherwise they share the loop of the main thread
+   */
+  bool stages = false;
+
+  int consensus_core = -1;
+  int ordering_core = -1;
+  int storage_core = -1;
+
+  /**
+   * Core of the main thread, which runs the loop of I/O
+   */
+  int io_core = -1;
+
+  /**
+   * NUMA node whose cores run all threads and whose memory they use,
+   * negative for no binding. Pinned cores should belong to the node
+   */
+  int numa_node = -1;
+
+  /**
+   * Threads completing asynchronous calls of consensus and ordering
+   * clients, shared by all of them
+   */
+  size_t grpc_client_threads =
+      iroha::network::ClientCompletionPool::kDefaultThreads;
+};
+
+/**
+ * Observer node follows committed blocks of validators, never votes and
+ * serves queries only
+ */
+struct ObserverOptions {
+  /**
+   * Addresses of validators to follow, the node is a validator when empty
+   */
+  std::vector<std::string> validators;
+
+  /**
+   * Keys of followed validators by address, over TLS their certificates
+   * are checked against them. Validators at addresses of ledger peers
+   * need no key
+   */
+  std::unordered_map<std::string, iroha::ed25519::pubkey_t> validator_keys;
+
+  /**
+   * Keys of observers following the node as validator, over TLS their
+   * certificates are admitted to block loader
+   */
+  std::vector<iroha::ed25519::pubkey_t> observer_keys;
+};
+
+/**
+ * Performance parameters which are reloaded while the peer runs
+ */
+struct TuningOptions {
+  /**
+   * Config file which is read again on SIGHUP or request to metrics
+   * endpoint, nothing is reloaded when empty
+   */
+  std::string config_path;
+};
+
 class Irohad {
  public:
 
@@ -57,26 +228,91 @@ class Irohad {
    * @param pg_conn - initialization string for postgre
    * @param torii_port - port for torii binding
    * @param peer_number - number of peer in ledger // todo replace with pub key
+   * @param block_storage_options - settings of block store
+   * @param yac_options - settings of consensus
+   * @param ordering_options - settings of ordering
+   * @param channel_options - transport settings of peer channels and
+   * servers
+   * @param listen_options - addresses of Torii and internal services
+   * @param admission_options - quotas of Torii clients
+   * @param crypto_options - verification of signatures
+   * @param validation_options - stateful validation of proposals
+   * @param threading_options - threads of pipeline stages
+   * @param observer_options - validators followed by observer node
+   * @param tuning_options - source of reloaded parameters
    */
   Irohad(const std::string &block_store_dir, const std::string &redis_host,
          size_t redis_port, const std::string &pg_conn, size_t torii_port,
-         uint64_t peer_number);
+         uint64_t peer_number,
+         iroha::ametsuchi::BlockStorageOptions block_storage_options =
+             iroha::ametsuchi::BlockStorageOptions(),
+         iroha::consensus::yac::YacOptions yac_options =
+             iroha::consensus::yac::YacOptions(),
+         iroha::network::OrderingOptions ordering_options =
+             iroha::network::OrderingOptions(),
+         iroha::network::ChannelOptions channel_options =
+             iroha::network::ChannelOptions(),
+         ListenOptions listen_options = ListenOptions(),
+         AdmissionOptions admission_options = AdmissionOptions(),
+         CryptoOptions crypto_options = CryptoOptions(),
+         ValidationOptions validation_options = ValidationOptions(),
+         ThreadingOptions threading_options = ThreadingOptions(),
+         ObserverOptions observer_options = ObserverOptions(),
+         TuningOptions tuning_options = TuningOptions());
   void run();
+
+  /**
+   * Download blocks up to the latest local snapshot of world state view
+   * from peer, checking only their signatures and links, and store them
+   * without executing commands. Snapshot is imported afterwards and only
+   * blocks after it are executed
+   * @param peer_address - address of peer which has the chain
+   * @return true if blocks are stored
+   */
+  bool syncHeaders(const std::string &peer_address);
+
   ~Irohad();
 
  private:
+  /**
+   * Serve metrics registry and reports of services on metrics address,
+   * if it is configured
+   */
+  void serveMetrics();
+
+  /**
+   * Register parameters which are changed at runtime, apply values of
+   * config file and reload it on SIGHUP
+   */
+  void initTunables();
+
+  /**
+   * Account memory of caches and queues in memory budget, which evicts
+   * cached blocks and pending handlers when memory_limit is exceeded
+   */
+  void initMemoryBudget();
+
+  /**
+   * Run observer node: blocks of validators are applied to storage, and
+   * Torii serves queries only
+   */
+  void runObserver();
+
   std::shared_ptr<iroha::synchronizer::Synchronizer> createSynchronizer(
       std::shared_ptr<iroha::network::ConsensusGate> consensus_gate,
       std::shared_ptr<iroha::validation::ChainValidator> validator,
       std::shared_ptr<iroha::ametsuchi::MutableFactory> mutableFactory,
-      std::shared_ptr<iroha::network::BlockLoader> blockLoader);
+      std::shared_ptr<iroha::network::BlockLoader> blockLoader,
+      std::shared_ptr<iroha::ametsuchi::BlockQuery> blockQuery,
+      std::shared_ptr<iroha::network::PeerHealth> health);
 
   std::shared_ptr<iroha::simulator::Simulator> createSimulator(
       std::shared_ptr<iroha::network::OrderingGate> ordering_gate,
       std::shared_ptr<iroha::validation::StatefulValidator> stateful_validator,
       std::shared_ptr<iroha::ametsuchi::BlockQuery> block_query,
       std::shared_ptr<iroha::ametsuchi::TemporaryFactory> temporary_factory,
-      std::shared_ptr<iroha::model::HashProviderImpl> hash_provider);
+      std::shared_ptr<iroha::model::HashProviderImpl> hash_provider,
+      std::shared_ptr<iroha::validation::WsvDeltaCache> wsv_deltas);
 
   std::shared_ptr<iroha::network::PeerCommunicationService>
   createPeerCommunicationService(
@@ -86,14 +322,18 @@ class Irohad {
   std::unique_ptr<::torii::CommandService> createCommandService(
       std::shared_ptr<iroha::model::converters::PbTransactionFactory>
       pb_factory,
-      std::shared_ptr<iroha::torii::TransactionProcessor> txProccesor);
+      std::shared_ptr<iroha::torii::TransactionProcessor> txProccesor,
+      std::shared_ptr<iroha::torii::TransactionStatusTracker> tracker,
+      std::shared_ptr<::torii::AdmissionControl> admission,
+      std::shared_ptr<::torii::TxCounterFilter> counters);
 
   std::unique_ptr<::torii::QueryService> createQueryService(
       std::shared_ptr<iroha::model::converters::PbQueryFactory>
       pb_query_factory,
       std::shared_ptr<iroha::model::converters::PbQueryResponseFactory>
       pb_query_response_factory,
-      std::shared_ptr<iroha::torii::QueryProcessor> query_processor);
+      std::shared_ptr<iroha::torii::QueryProcessor> query_processor,
+      std::shared_ptr<iroha::ametsuchi::BlockQuery> block_query);
 
   std::shared_ptr<iroha::torii::QueryProcessor> createQueryProcessor(
       std::unique_ptr<iroha::model::QueryProcessingFactory> qpf,
@@ -112,25 +352,57 @@ class Irohad {
   std::unique_ptr<iroha::model::QueryProcessingFactory>
   createQueryProcessingFactory(
       std::shared_ptr<iroha::ametsuchi::WsvQuery> wsvQuery,
-      std::shared_ptr<iroha::ametsuchi::BlockQuery> blockQuery);
+      std::shared_ptr<iroha::ametsuchi::BlockQuery> blockQuery,
+      bool cache_results,
+      std::shared_ptr<iroha::ametsuchi::SnapshotPinFactory> snapshots);
 
   std::string block_store_dir_;
   std::string redis_host_;
   size_t redis_port_;
   std::string pg_conn_;
   size_t torii_port_;
+  iroha::ametsuchi::BlockStorageOptions block_storage_options_;
+  iroha::consensus::yac::YacOptions yac_options_;
+  iroha::network::OrderingOptions ordering_options_;
+  iroha::network::ChannelOptions channel_options_;
+  ListenOptions listen_options_;
+  AdmissionOptions admission_options_;
+  CryptoOptions crypto_options_;
+  ValidationOptions validation_options_;
+  ThreadingOptions threading_options_;
+  ObserverOptions observer_options_;
+  iroha::Tunables tunables_;
+  std::shared_ptr<uvw::SignalHandle> reload_signal_;
+  // channels to peers, shared by ordering and consensus
+  std::shared_ptr<iroha::network::ChannelRegistry> channels_;
+  // admits certificates of ledger peers to internal services
+  std::shared_ptr<iroha::network::PeerAuthenticator> peer_authenticator_;
   std::shared_ptr<uvw::Loop> loop;
+  // stages with threads of their own, null when they share the loop
+  std::unique_ptr<iroha::Stage> consensus_stage_;
+  std::unique_ptr<iroha::Stage> ordering_stage_;
+  std::unique_ptr<iroha::Stage> storage_stage_;
 
   std::unique_ptr<::torii::CommandService> command_service;
   std::unique_ptr<::torii::QueryService> query_service;
 
   std::unique_ptr<ServerRunner> torii_server;
   std::unique_ptr<grpc::Server> internal_server;
+  std::unique_ptr<iroha::network::InternalServiceHandler> internal_handler;
   iroha::network::OrderingInit ordering_init;
   iroha::consensus::yac::YacInit yac_init;
+  std::shared_ptr<iroha::network::BlockLoaderService> loader_service;
+  // follows validators in observer mode, null otherwise
+  std::unique_ptr<iroha::network::BlockSubscriber> block_subscriber_;
 
   std::thread internal_thread, server_thread;
 
+  // metrics endpoint, null when not configured
+  std::unique_ptr<iroha::metrics::MetricsServer> metrics_server_;
+  std::vector<size_t> metrics_collectors_;
+  // subsystems registered in memory budget
+  std::vector<iroha::memory::MemoryBudget::Id> memory_subsystems_;
+
   logger::Logger log_;
 
 
@@ -0,0 +1,86 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gflags/gflags.h>
+#include "ametsuchi/impl/block_serializer.hpp"
+#include "ametsuchi/impl/flat_file/flat_file.hpp"
+#include "ametsuchi/impl/segmented_log/segmented_log.hpp"
+#include "logger/logger.hpp"
+
+/**
+ * Rewrites existing block store in another format or layout, e.g. converts
+ * JSON blocks written by earlier versions to binary ones.
+ * Conversion is resumable: blocks already present in destination are kept.
+ */
+
+bool validate_path(const char *flag_name, std::string const &path) {
+  return not path.empty();
+}
+
+bool validate_type(const char *flag_name, std::string const &type) {
+  return type == "flat_file" or type == "segmented";
+}
+
+bool validate_format(const char *flag_name, std::string const &format) {
+  return format == "json" or format == "protobuf";
+}
+
+DEFINE_string(from, "", "Specify block store to convert");
+DEFINE_validator(from, &validate_path);
+
+DEFINE_string(to, "", "Specify directory of converted block store");
+DEFINE_validator(to, &validate_path);
+
+DEFINE_string(from_type, "flat_file", "Specify layout of source store");
+DEFINE_validator(from_type, &validate_type);
+
+DEFINE_string(to_type, "flat_file", "Specify layout of converted store");
+DEFINE_validator(to_type, &validate_type);
+
+DEFINE_string(format, "protobuf", "Specify format of converted blocks");
+DEFINE_validator(format, &validate_format);
+
+std::unique_ptr<iroha::ametsuchi::BlockStorage> open_store(
+    const std::string &path, const std::string &type) {
+  if (type == "segmented") {
+    return iroha::ametsuchi::SegmentedLog::create(path);
+  }
+  return iroha::ametsuchi::FlatFile::create(path);
+}
+
+int main(int argc, char *argv[]) {
+  auto log = logger::log("CONVERTER");
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  gflags::ShutDownCommandLineFlags();
+
+  auto source = open_store(FLAGS_from, FLAGS_from_type);
+  auto destination = open_store(FLAGS_to, FLAGS_to_type);
+  if (not source or not destination) {
+    log->error("Cannot open block stores");
+    return EXIT_FAILURE;
+  }
+
+  iroha::ametsuchi::BlockSerializer serializer(
+      FLAGS_format == "json" ? iroha::ametsuchi::BlockFormat::Json
+                             : iroha::ametsuchi::BlockFormat::Protobuf);
+  if (not iroha::ametsuchi::convertBlocks(*source, *destination, serializer)) {
+    log->error("Conversion stopped at block {}", destination->last_id() + 1);
+    return EXIT_FAILURE;
+  }
+  log->info("Converted {} blocks", destination->last_id());
+  return EXIT_SUCCESS;
+}
@@ -23,7 +23,8 @@ namespace iroha {
   bool GenesisBlockProcessor::genesis_block_handle(
       const iroha::model::Block &block) {
 
-    auto ms = mutable_factory_.createMutableStorage();
+    auto ms = bulk_load_ ? mutable_factory_.createBulkStorage()
+                         : mutable_factory_.createMutableStorage();
 
     auto result = ms->apply(block, [](const auto &blk, auto &executor,
                                       auto &query, const auto &top_hash) {
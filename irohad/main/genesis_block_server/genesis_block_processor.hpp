@@ -28,14 +28,20 @@ namespace iroha {
 
   class GenesisBlockProcessor {
   public:
-    explicit GenesisBlockProcessor(ametsuchi::MutableFactory &mutable_factory)
-      : mutable_factory_(mutable_factory) {}
+    /**
+     * @param mutable_factory - storage to insert genesis block into
+     * @param bulk_load - apply genesis block with bulk load
+     */
+    explicit GenesisBlockProcessor(ametsuchi::MutableFactory &mutable_factory,
+                                   bool bulk_load = false)
+      : mutable_factory_(mutable_factory), bulk_load_(bulk_load) {}
 
     ~GenesisBlockProcessor() {}
     bool genesis_block_handle(const iroha::model::Block &block);
 
   private:
     ametsuchi::MutableFactory &mutable_factory_;
+    bool bulk_load_;
   };
 }
 
@@ -17,13 +17,13 @@
 
 #include "main/impl/consensus_init.hpp"
 
-#include <gmock/gmock.h>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 #include "consensus/yac/yac.hpp"
 #include "consensus/yac/messages.hpp"
+#include "consensus/yac/impl/yac_crypto_provider_impl.hpp"
 #include "consensus/yac/impl/yac_gate_impl.hpp"
 #include "consensus/yac/impl/network_impl.hpp"
 #include <consensus/yac/impl/timer_impl.hpp>
@@ -34,50 +34,59 @@ namespace iroha {
   namespace consensus {
     namespace yac {
 
-      class MockYacCryptoProvider : public YacCryptoProvider {
+      /**
+       * Crypto provider of networks without peer keys, accepts every
+       * message and does not sign votes
+       */
+      class TrustingYacCryptoProvider : public YacCryptoProvider {
        public:
-        MOCK_METHOD1(verify, bool(CommitMessage));
-        MOCK_METHOD1(verify, bool(RejectMessage));
-        MOCK_METHOD1(verify, bool(VoteMessage));
+        bool verify(CommitMessage) override {
+          return true;
+        }
+
+        bool verify(RejectMessage) override {
+          return true;
+        }
+
+        bool verify(VoteMessage) override {
+          return true;
+        }
 
         VoteMessage getVote(YacHash hash) override {
           VoteMessage vote;
           vote.hash = hash;
           return vote;
         }
-
-        MockYacCryptoProvider() = default;
-
-        MockYacCryptoProvider(const MockYacCryptoProvider &) {}
-
-        MockYacCryptoProvider &operator=(const MockYacCryptoProvider &) {
-          return *this;
-        }
       };
 
       auto YacInit::createNetwork(std::string network_address,
-                                  std::vector<model::Peer> initial_peers) {
-        consensus_network = std::make_shared<NetworkImpl>(network_address, initial_peers);
+                                  std::vector<model::Peer> initial_peers,
+                                  const YacOptions &options,
+                                  std::shared_ptr<network::ChannelRegistry> channels,
+                                  std::shared_ptr<network::OrderingGate> ordering_gate) {
+        consensus_network = std::make_shared<NetworkImpl>(
+            network_address, initial_peers, options.compact_commits,
+            options.fanout, std::move(channels));
         return consensus_network;
       }
 
-      auto YacInit::createCryptoProvider() {
-        std::shared_ptr<MockYacCryptoProvider>
-            crypto = std::make_shared<MockYacCryptoProvider>();
-
-        EXPECT_CALL(*crypto, verify(testing::An<CommitMessage>()))
-            .WillRepeatedly(testing::Return(true));
-
-        EXPECT_CALL(*crypto, verify(testing::An<RejectMessage>()))
-            .WillRepeatedly(testing::Return(true));
-
-        EXPECT_CALL(*crypto, verify(testing::An<VoteMessage>()))
-            .WillRepeatedly(testing::Return(true));
-        return crypto;
+      std::shared_ptr<YacCryptoProvider> YacInit::createCryptoProvider(
+          const YacOptions &options) {
+        if (options.signer) {
+          return std::make_shared<YacCryptoProviderImpl>(options.signer);
+        }
+        return std::make_shared<TrustingYacCryptoProvider>();
       }
 
-      auto YacInit::createTimer(std::shared_ptr<uvw::Loop> loop) {
-        return std::make_shared<TimerImpl>(loop);
+      std::shared_ptr<Timer> YacInit::createTimer(
+          std::shared_ptr<uvw::Loop> loop, const YacOptions &options) {
+        std::shared_ptr<Timer> timer = std::make_shared<TimerImpl>(loop);
+        if (options.adaptive_delay) {
+          // slow leaders may take up to four base delays before failover
+          timer = std::make_shared<AdaptiveTimer>(std::move(timer),
+                                                  4 * options.vote_delay);
+        }
+        return timer;
       }
 
       auto YacInit::createHashProvider() {
@@ -87,32 +96,48 @@ namespace iroha {
       std::shared_ptr<consensus::yac::Yac> YacInit::createYac(std::string network_address,
                                                               std::shared_ptr<
                                                                   uvw::Loop> loop,
-                                                              ClusterOrdering initial_order) {
-        uint64_t delay_seconds = 5;
-
-        return Yac::create(YacVoteStorage(),
+                                                              ClusterOrdering initial_order,
+                                                              const YacOptions &options,
+                                                              std::shared_ptr<network::ChannelRegistry> channels) {
+        auto crypto = createCryptoProvider(options);
+        return Yac::create(YacVoteStorage(options.round_window),
                            createNetwork(std::move(network_address),
-                                         initial_order.getPeers()),
-                           createCryptoProvider(),
-                           createTimer(std::move(loop)),
+                                         initial_order.getPeers(),
+                                         options,
+                                         std::move(channels)),
+                           crypto,
+                           createTimer(std::move(loop), options),
                            initial_order,
-                           delay_seconds * 1000);
+                           options.vote_delay,
+                           std::make_shared<SerialExecutor>(),
+                           std::make_shared<BatchVoteVerifier>(crypto),
+                           options.peer_health);
 
       }
 
       std::shared_ptr<YacGateImpl> YacInit::initConsensusGate(std::string network_address,
                                   std::shared_ptr<uvw::Loop> loop,
                                   std::shared_ptr<YacPeerOrderer> peer_orderer,
-                                  std::shared_ptr<simulator::BlockCreator> block_creator) {
-        auto yac = createYac(std::move(network_address),
-                             std::move(loop),
-                             peer_orderer->getInitialOrdering().value());
+                                  std::shared_ptr<simulator::BlockCreator> block_creator,
+                                  std::shared_ptr<network::BlockLoader> block_loader,
+                                  const YacOptions &options,
+                                  std::shared_ptr<network::ChannelRegistry> channels) {
+        yac = createYac(std::move(network_address),
+                        std::move(loop),
+                        peer_orderer->getInitialOrdering().value(),
+                        options,
+                        std::move(channels));
         consensus_network->subscribe(yac);
 
         auto hash_provider = createHashProvider();
-        return std::make_shared<YacGateImpl>(std::move(yac),
+        if (not options.vote_on_proposal) {
+          ordering_gate = nullptr;
+        }
+        return std::make_shared<YacGateImpl>(yac,
                                              std::move(peer_orderer),
-                                             hash_provider, block_creator);
+                                             hash_provider, block_creator,
+                                             std::move(block_loader),
+                                             std::move(ordering_gate));
       }
 
     } // namespace yac
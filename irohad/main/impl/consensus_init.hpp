@@ -21,11 +21,16 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include "common/types.hpp"
+#include "crypto/signer.hpp"
 #include "consensus/yac/yac.hpp"
 #include "consensus/yac/messages.hpp"
 #include "consensus/yac/impl/yac_gate_impl.hpp"
 #include "consensus/yac/impl/network_impl.hpp"
 #include "consensus/yac/impl/timer_impl.hpp"
+#include "consensus/yac/impl/adaptive_timer.hpp"
+#include "consensus/yac/impl/serial_executor.hpp"
+#include "consensus/yac/impl/batch_vote_verifier.hpp"
 #include "consensus/yac/impl/peer_orderer_impl.hpp"
 #include "consensus/yac/impl/yac_hash_provider_impl.hpp"
 
@@ -33,30 +38,102 @@ namespace iroha {
   namespace consensus {
     namespace yac {
 
+      /**
+       * Settings of YAC consensus
+       */
+      struct YacOptions {
+        /**
+         * Number of latest rounds kept in vote storage
+         */
+        size_t round_window = YacVoteStorage::kDefaultRoundWindow;
+
+        /**
+         * Send commits as certificates with signer bitmap instead of
+         * full votes
+         */
+        bool compact_commits = false;
+
+        /**
+         * Number of peers each peer relays commits and rejects to,
+         * 0 sends them from the origin to every peer directly
+         */
+        size_t fanout = 0;
+
+        /**
+         * Time of waiting for commit before switching to next leader,
+         * in milliseconds
+         */
+        uint64_t vote_delay = 5000;
+
+        /**
+         * Adapt waiting time to observed answer times of each leader,
+         * vote_delay is used until leader is measured and as base of
+         * upper bound
+         */
+        bool adaptive_delay = false;
+
+        /**
+         * Vote for hash of proposal as soon as it is received, block is
+         * built locally while votes are collected
+         */
+        bool vote_on_proposal = false;
+
+        /**
+         * Holder of key of this peer. When set, votes are signed and
+         * signatures of received votes and commits are verified, otherwise
+         * votes carry no signatures and every message is trusted
+         */
+        std::shared_ptr<Signer> signer;
+
+        /**
+         * Table of peer health. When set, it is fed with answer times of
+         * leaders, and unhealthy peers are tried as leaders last
+         */
+        std::shared_ptr<network::PeerHealth> peer_health;
+      };
+
       class YacInit {
        private:
         // ----------| Yac dependencies |----------
 
         auto createNetwork(std::string network_address,
-                           std::vector<model::Peer> initial_peers);
+                           std::vector<model::Peer> initial_peers,
+                           const YacOptions &options,
+                           std::shared_ptr<network::ChannelRegistry> channels);
 
-        auto createCryptoProvider();
+        std::shared_ptr<YacCryptoProvider> createCryptoProvider(
+            const YacOptions &options);
 
-        auto createTimer(std::shared_ptr<uvw::Loop> loop);
+        std::shared_ptr<Timer> createTimer(std::shared_ptr<uvw::Loop> loop,
+                                           const YacOptions &options);
 
         auto createHashProvider();
 
         std::shared_ptr<consensus::yac::Yac> createYac(std::string network_address,
                                                        std::shared_ptr<uvw::Loop> loop,
-                                                       ClusterOrdering initial_order);
+                                                       ClusterOrdering initial_order,
+                                                       const YacOptions &options,
+                                                       std::shared_ptr<network::ChannelRegistry> channels);
 
        public:
+        /**
+         * @param block_loader - source of blocks committed without this peer
+         * @param options - settings of consensus
+         * @param channels - registry of peer channels, shared with ordering
+         */
         std::shared_ptr<YacGateImpl> initConsensusGate(std::string network_address,
                                std::shared_ptr<uvw::Loop> loop,
                                std::shared_ptr<YacPeerOrderer> peer_orderer,
-                               std::shared_ptr<simulator::BlockCreator> block_creator);
+                               std::shared_ptr<simulator::BlockCreator> block_creator,
+                               std::shared_ptr<network::BlockLoader> block_loader,
+                               const YacOptions &options = YacOptions(),
+                               std::shared_ptr<network::ChannelRegistry> channels =
+                                   std::make_shared<network::ChannelRegistry>(),
+                               std::shared_ptr<network::OrderingGate> ordering_gate = nullptr);
 
         std::shared_ptr<NetworkImpl> consensus_network;
+        // consensus of the gate, for parameters changed at runtime
+        std::shared_ptr<Yac> yac;
       };
     } // namespace yac
   } // namespace consensus
@@ -0,0 +1,165 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "main/impl/internal_service_handler.hpp"
+#include <algorithm>
+#include <thread>
+
+namespace iroha {
+  namespace network {
+
+    InternalServiceHandler::InternalServiceHandler(
+        ::grpc::ServerBuilder &builder, size_t threads) {
+      builder.RegisterService(&yac_async_);
+      builder.RegisterService(&gate_async_);
+      builder.RegisterService(&ordering_async_);
+      for (size_t i = 0; i < std::max<size_t>(threads, 1); ++i) {
+        queues_.push_back(builder.AddCompletionQueue());
+      }
+    }
+
+    void InternalServiceHandler::assignServices(
+        std::shared_ptr<consensus::yac::proto::Yac::Service> yac,
+        std::shared_ptr<ordering::proto::OrderingGate::Service> gate,
+        std::shared_ptr<ordering::proto::OrderingService::Service>
+            ordering) {
+      yac_ = std::move(yac);
+      gate_ = std::move(gate);
+      ordering_ = std::move(ordering);
+    }
+
+    void InternalServiceHandler::handleRpcs() {
+      std::vector<std::thread> threads;
+      for (size_t i = 1; i < queues_.size(); ++i) {
+        threads.emplace_back(
+            [this, i] { this->handleQueue(queues_[i].get()); });
+      }
+      handleQueue(queues_.front().get());
+      for (auto &thread : threads) {
+        thread.join();
+      }
+    }
+
+    void InternalServiceHandler::shutdown() {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        is_shutdown_ = true;
+      }
+      for (auto &queue : queues_) {
+        queue->Shutdown();
+      }
+    }
+
+    void InternalServiceHandler::handleQueue(
+        ::grpc::ServerCompletionQueue *cq) {
+      enqueueRequest<YacService, consensus::yac::proto::Vote>(
+          &YacService::RequestSendVote,
+          &InternalServiceHandler::VoteHandler,
+          yac_async_,
+          cq);
+      enqueueRequest<YacService, consensus::yac::proto::Commit>(
+          &YacService::RequestSendCommit,
+          &InternalServiceHandler::CommitHandler,
+          yac_async_,
+          cq);
+      enqueueRequest<YacService, consensus::yac::proto::Reject>(
+          &YacService::RequestSendReject,
+          &InternalServiceHandler::RejectHandler,
+          yac_async_,
+          cq);
+      enqueueRequest<GateService, ordering::proto::Proposal>(
+          &GateService::RequestSendProposal,
+          &InternalServiceHandler::ProposalHandler,
+          gate_async_,
+          cq);
+      enqueueRequest<OrderingService, protocol::Transaction>(
+          &OrderingService::RequestSendTransaction,
+          &InternalServiceHandler::TransactionHandler,
+          ordering_async_,
+          cq);
+
+      void *tag;
+      bool ok;
+      // queue is drained after shutdown, pending calls are not handled
+      while (cq->Next(&tag, &ok)) {
+        auto callbackTag = static_cast<
+            ::network::UntypedCall<InternalServiceHandler>::CallOwner *>(tag);
+        if (ok and callbackTag) {
+          callbackTag->onCompleted(this);
+        }
+      }
+    }
+
+    // Each handler requests the next rpc from the same queue first, so the
+    // method keeps being served while the current rpc is processed
+
+    void InternalServiceHandler::VoteHandler(
+        InternalCall<YacService, consensus::yac::proto::Vote> *call) {
+      enqueueRequest<YacService, consensus::yac::proto::Vote>(
+          &YacService::RequestSendVote,
+          &InternalServiceHandler::VoteHandler,
+          yac_async_,
+          call->completionQueue());
+      call->sendResponse(yac_->SendVote(
+          &call->context(), &call->request(), &call->response()));
+    }
+
+    void InternalServiceHandler::CommitHandler(
+        InternalCall<YacService, consensus::yac::proto::Commit> *call) {
+      enqueueRequest<YacService, consensus::yac::proto::Commit>(
+          &YacService::RequestSendCommit,
+          &InternalServiceHandler::CommitHandler,
+          yac_async_,
+          call->completionQueue());
+      call->sendResponse(yac_->SendCommit(
+          &call->context(), &call->request(), &call->response()));
+    }
+
+    void InternalServiceHandler::RejectHandler(
+        InternalCall<YacService, consensus::yac::proto::Reject> *call) {
+      enqueueRequest<YacService, consensus::yac::proto::Reject>(
+          &YacService::RequestSendReject,
+          &InternalServiceHandler::RejectHandler,
+          yac_async_,
+          call->completionQueue());
+      call->sendResponse(yac_->SendReject(
+          &call->context(), &call->request(), &call->response()));
+    }
+
+    void InternalServiceHandler::ProposalHandler(
+        InternalCall<GateService, ordering::proto::Proposal> *call) {
+      enqueueRequest<GateService, ordering::proto::Proposal>(
+          &GateService::RequestSendProposal,
+          &InternalServiceHandler::ProposalHandler,
+          gate_async_,
+          call->completionQueue());
+      call->sendResponse(gate_->SendProposal(
+          &call->context(), &call->request(), &call->response()));
+    }
+
+    void InternalServiceHandler::TransactionHandler(
+        InternalCall<OrderingService, protocol::Transaction> *call) {
+      enqueueRequest<OrderingService, protocol::Transaction>(
+          &OrderingService::RequestSendTransaction,
+          &InternalServiceHandler::TransactionHandler,
+          ordering_async_,
+          call->completionQueue());
+      call->sendResponse(ordering_->SendTransaction(
+          &call->context(), &call->request(), &call->response()));
+    }
+  }  // namespace network
+}  // namespace iroha
@@ -0,0 +1,138 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_INTERNAL_SERVICE_HANDLER_HPP
+#define IROHA_INTERNAL_SERVICE_HANDLER_HPP
+
+#include <google/protobuf/empty.pb.h>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "network/grpc_async_service.hpp"
+#include "network/grpc_call.hpp"
+#include "ordering.grpc.pb.h"
+#include "yac.grpc.pb.h"
+
+namespace iroha {
+  namespace network {
+
+    /**
+     * Async server of peer-to-peer services: YAC, ordering gate and
+     * ordering service. Rpcs are served by fixed number of threads, each
+     * polls its own completion queue, and processing is delegated to
+     * synchronous implementations of the services.
+     */
+    class InternalServiceHandler : public ::network::GrpcAsyncService {
+     public:
+      /**
+       * Default number of completion queue threads
+       */
+      static constexpr size_t kDefaultThreads = 2;
+
+      /**
+       * requires builder to use same server.
+       * @param builder - builder of internal server
+       * @param threads - number of completion queue threads
+       */
+      explicit InternalServiceHandler(::grpc::ServerBuilder &builder,
+                                      size_t threads = kDefaultThreads);
+
+      /**
+       * Set implementations of services, must be called before
+       * handleRpcs()
+       */
+      void assignServices(
+          std::shared_ptr<consensus::yac::proto::Yac::Service> yac,
+          std::shared_ptr<ordering::proto::OrderingGate::Service> gate,
+          std::shared_ptr<ordering::proto::OrderingService::Service>
+              ordering);
+
+      /**
+       * handles rpcs in all completion queues, returns after shutdown
+       */
+      void handleRpcs() override;
+
+      /**
+       * releases completion queues.
+       * @note Call this method after calling server->Shutdown()
+       */
+      void shutdown() override;
+
+      template <typename AsyncService, typename RequestType>
+      using InternalCall = ::network::Call<InternalServiceHandler,
+                                           AsyncService,
+                                           RequestType,
+                                           google::protobuf::Empty>;
+
+      using YacService = consensus::yac::proto::Yac::AsyncService;
+      using GateService = ordering::proto::OrderingGate::AsyncService;
+      using OrderingService = ordering::proto::OrderingService::AsyncService;
+
+     private:
+      /**
+       * helper to call Call::enqueueRequest()
+       */
+      template <typename AsyncService, typename RequestType>
+      void enqueueRequest(
+          ::network::RequestMethod<AsyncService,
+                                   RequestType,
+                                   google::protobuf::Empty> requester,
+          ::network::RpcHandler<InternalServiceHandler,
+                                AsyncService,
+                                RequestType,
+                                google::protobuf::Empty> rpcHandler,
+          AsyncService &asyncService,
+          ::grpc::ServerCompletionQueue *cq) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (not is_shutdown_) {
+          InternalCall<AsyncService, RequestType>::enqueueRequest(
+              &asyncService, cq, requester, rpcHandler);
+        }
+      }
+
+      /**
+       * Request first rpcs of every method and poll the queue
+       */
+      void handleQueue(::grpc::ServerCompletionQueue *cq);
+
+      void VoteHandler(
+          InternalCall<YacService, consensus::yac::proto::Vote> *call);
+      void CommitHandler(
+          InternalCall<YacService, consensus::yac::proto::Commit> *call);
+      void RejectHandler(
+          InternalCall<YacService, consensus::yac::proto::Reject> *call);
+      void ProposalHandler(
+          InternalCall<GateService, ordering::proto::Proposal> *call);
+      void TransactionHandler(
+          InternalCall<OrderingService, protocol::Transaction> *call);
+
+      YacService yac_async_;
+      GateService gate_async_;
+      OrderingService ordering_async_;
+      std::vector<std::unique_ptr<::grpc::ServerCompletionQueue>> queues_;
+
+      std::shared_ptr<consensus::yac::proto::Yac::Service> yac_;
+      std::shared_ptr<ordering::proto::OrderingGate::Service> gate_;
+      std::shared_ptr<ordering::proto::OrderingService::Service> ordering_;
+
+      std::mutex mutex_;
+      bool is_shutdown_ = false;
+    };
+  }  // namespace network
+}  // namespace iroha
+
+#endif  // IROHA_INTERNAL_SERVICE_HANDLER_HPP
@@ -19,29 +19,50 @@
 
 namespace iroha {
   namespace network {
-    auto OrderingInit::createGate(std::string network_address) {
-      return std::make_shared<ordering::OrderingGateImpl>(network_address);
+    constexpr int OrderingInit::kLeaderTimeoutRounds;
+
+    auto OrderingInit::createGate(std::string network_address,
+                                  std::shared_ptr<ChannelRegistry> channels,
+                                  size_t batch_size,
+                                  std::chrono::microseconds batch_delay,
+                                  std::shared_ptr<ordering::BatchPool> pool) {
+      return std::make_shared<ordering::OrderingGateImpl>(
+          network_address, channels, batch_size, batch_delay, pool);
     }
 
-    auto OrderingInit::createService(std::shared_ptr<ametsuchi::PeerQuery> wsv,
-                                     size_t max_size,
-                                     size_t delay_milliseconds,
-                                     std::shared_ptr<uvw::Loop> loop) {
+    auto OrderingInit::createService(
+        std::shared_ptr<ametsuchi::PeerQuery> wsv,
+        ordering::BatchingController::Bounds bounds,
+        std::shared_ptr<uvw::Loop> loop,
+        std::shared_ptr<ChannelRegistry> channels) {
 
-      return std::make_shared<ordering::OrderingServiceImpl>(wsv,
-                                                             max_size,
-                                                             delay_milliseconds,
-                                                             loop);
+      return std::make_shared<ordering::OrderingServiceImpl>(
+          wsv, bounds, loop, channels);
     }
 
     std::shared_ptr<ordering::OrderingGateImpl> OrderingInit::initOrderingGate(
         std::shared_ptr<ametsuchi::PeerQuery> wsv,
         std::shared_ptr<uvw::Loop> loop,
-        size_t max_size,
-        size_t delay_milliseconds) {
-      ordering_service =
-          createService(wsv, max_size, delay_milliseconds, loop);
-      ordering_gate = createGate(wsv->getLedgerPeers().value().front().address);
+        ordering::BatchingController::Bounds bounds,
+        std::shared_ptr<ChannelRegistry> channels,
+        size_t batch_size,
+        std::chrono::microseconds batch_delay,
+        const std::string &ingest_address) {
+      ordering_service = createService(wsv, bounds, loop, channels);
+      if (ingest_address.empty()) {
+        auto peers = wsv->getLedgerPeers().value();
+        ordering_gate = createGate(
+            peers.front().address, channels, batch_size, batch_delay, nullptr);
+        ordering_gate->enableFailover(
+            consensus::yac::ClusterOrdering(std::move(peers)),
+            bounds.max_delay * kLeaderTimeoutRounds);
+        return ordering_gate;
+      }
+
+      auto pool = std::make_shared<ordering::BatchPool>();
+      ordering_service->enableMultiIngest(pool, ingest_address);
+      ordering_gate = createGate(
+          ingest_address, channels, batch_size, batch_delay, pool);
       return ordering_gate;
     }
   }  // namespace network
@@ -26,6 +26,30 @@
 namespace iroha {
   namespace network {
 
+    /**
+     * Settings of ordering
+     */
+    struct OrderingOptions {
+      /**
+       * Every peer collects transactions of its clients and disseminates
+       * them in batches, instead of forwarding all of them to the first
+       * ledger peer
+       */
+      bool multi_ingest = false;
+
+      /**
+       * Proposals carry hashes of transactions, peers fetch only bodies of
+       * transactions which have not passed through their gates
+       */
+      bool compact_proposals = false;
+
+      /**
+       * Existing directory of write-ahead log of mempool, see MempoolLog;
+       * empty disables the log, so queued transactions are lost on restart
+       */
+      std::string mempool_log_path;
+    };
+
     /**
      * Class aimed to effective initialization of OrderingGate component
      */
@@ -35,36 +59,63 @@ namespace iroha {
       /**
        * Init effective realisation of ordering gate (client of ordering service)
        * @param network_address - address of ordering service
+       * @param channels - registry of peer channels
+       * @param batch_size - number of transactions forwarded in one call
+       * @param batch_delay - delay before incomplete batch is forwarded
+       * @param pool - disseminated batches in multi-ingest mode
        */
-      auto createGate(std::string network_address);
+      auto createGate(std::string network_address,
+                      std::shared_ptr<ChannelRegistry> channels,
+                      size_t batch_size,
+                      std::chrono::microseconds batch_delay,
+                      std::shared_ptr<ordering::BatchPool> pool);
 
       /**
        * Init ordering service
        * @param peers - endpoints of peers for connection
-       * @param max_size - limitation of proposal size
-       * @param delay_milliseconds - delay before emitting proposal
+       * @param bounds - limitation of proposal size and delay before
+       * emitting proposal
        * @param loop - handler of async events
+       * @param channels - registry of peer channels
        */
       auto createService(std::shared_ptr<ametsuchi::PeerQuery> wsv,
-                         size_t max_size,
-                         size_t delay_milliseconds,
-                         std::shared_ptr<uvw::Loop> loop);
+                         ordering::BatchingController::Bounds bounds,
+                         std::shared_ptr<uvw::Loop> loop,
+                         std::shared_ptr<ChannelRegistry> channels);
 
      public:
 
+      /**
+       * Ordering leader is replaced when it does not propose for this many
+       * longest proposal delays while transactions wait
+       */
+      static constexpr int kLeaderTimeoutRounds = 3;
+
       /**
        * Initialization of ordering gate(client) and ordering service (service)
        * @param peers - endpoints of peers for connection
        * @param loop - handler of async events
-       * @param max_size - limitation of proposal size
-       * @param delay_milliseconds - delay before emitting proposal
+       * @param bounds - limitation of proposal size and delay before
+       * emitting proposal, both are adapted to load within them
+       * @param channels - registry of peer channels, shared with consensus
+       * @param batch_size - number of transactions forwarded by gate in one
+       * call, 1 forwards every transaction separately
+       * @param batch_delay - delay before incomplete batch is forwarded
+       * @param ingest_address - address of this peer to collect transactions
+       * in multi-ingest mode, empty forwards them to the first ledger peer,
+       * which is replaced by the next ledger peer on failure
        * @return effective realisation of OrderingGate
        */
       std::shared_ptr<ordering::OrderingGateImpl> initOrderingGate(
           std::shared_ptr<ametsuchi::PeerQuery> wsv,
           std::shared_ptr<uvw::Loop> loop,
-          size_t max_size,
-          size_t delay_milliseconds);
+          ordering::BatchingController::Bounds bounds,
+          std::shared_ptr<ChannelRegistry> channels =
+              std::make_shared<ChannelRegistry>(),
+          size_t batch_size = 1,
+          std::chrono::microseconds batch_delay =
+              std::chrono::microseconds(0),
+          const std::string &ingest_address = "");
 
       std::shared_ptr<ordering::OrderingServiceImpl> ordering_service;
       std::shared_ptr<ordering::OrderingGateImpl> ordering_gate;
@@ -16,7 +16,6 @@
  */
 
 #include "main/raw_block_insertion.hpp"
-#include "model/converters/json_common.hpp"
 #include <fstream>
 #include <utility>
 #include "common/types.hpp"
@@ -24,22 +23,24 @@
 namespace iroha {
   namespace main {
 
-    BlockInserter::BlockInserter(std::shared_ptr<ametsuchi::MutableFactory> factory)
-        : factory_(std::move(factory)) {
+    BlockInserter::BlockInserter(std::shared_ptr<ametsuchi::MutableFactory> factory,
+                                 bool bulk_load)
+        : factory_(std::move(factory)), bulk_load_(bulk_load) {
       log_ = logger::log("BlockInserter");
     }
 
     nonstd::optional<model::Block> BlockInserter::parseBlock(std::string data) {
-      auto document = model::converters::stringToJson(data);
-      if (not document.has_value()) {
+      auto block = block_factory_.deserialize(
+          reinterpret_cast<const uint8_t *>(data.data()), data.size());
+      if (not block) {
         log_->error("Blob parsing failed");
-        return nonstd::nullopt;
       }
-      return block_factory_.deserialize(document.value());
+      return block;
     };
 
     void BlockInserter::applyToLedger(std::vector<model::Block> blocks) {
-      auto storage = factory_->createMutableStorage();
+      auto storage = bulk_load_ ? factory_->createBulkStorage()
+                                : factory_->createMutableStorage();
       for (auto &&block : blocks) {
         storage->apply(block,
                        [](const auto &current_block, auto &executor,
@@ -58,7 +59,7 @@ namespace iroha {
     };
 
     nonstd::optional<std::string> BlockInserter::loadFile(std::string path) {
-      std::ifstream file(path);
+      std::ifstream file(path, std::ios::binary);
       std::string str((std::istreambuf_iterator<char>(file)),
                       std::istreambuf_iterator<char>());
       return str;
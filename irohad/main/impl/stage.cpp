@@ -0,0 +1,100 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "main/impl/stage.hpp"
+#include "affinity/affinity.hpp"
+#include "logger/logger.hpp"
+
+namespace iroha {
+
+  namespace {
+    /**
+     * Single worker on a dedicated thread, created by the factory
+     */
+    rxcpp::schedulers::worker makeWorker(
+        rxcpp::composite_subscription lifetime,
+        std::function<std::thread(std::function<void()>)> factory) {
+      return rxcpp::schedulers::make_new_thread(std::move(factory))
+          .create_worker(std::move(lifetime));
+    }
+  }  // namespace
+
+  Stage::Stage(std::string name, int core)
+      : name_(std::move(name)),
+        core_(core),
+        loop_(uvw::Loop::create()),
+        worker_(makeWorker(lifetime_,
+                           [core, name = name_](std::function<void()> start) {
+                             std::thread thread([name, start] {
+                               affinity::nameCurrentThread(name + "-tasks");
+                               start();
+                             });
+                             affinity::pinThread(thread.native_handle(), core);
+                             return thread;
+                           })),
+        coordination_(rxcpp::schedulers::make_same_worker(worker_)) {
+    stop_signal_ = loop_->resource<uvw::AsyncHandle>();
+    // handles of components are closed by their owners
+    stop_signal_->on<uvw::AsyncEvent>(
+        [](const auto &, auto &handle) { handle.loop().stop(); });
+  }
+
+  std::shared_ptr<uvw::Loop> Stage::loop() const {
+    return loop_;
+  }
+
+  rxcpp::observe_on_one_worker Stage::coordination() const {
+    return coordination_;
+  }
+
+  void Stage::post(std::function<void()> task) {
+    worker_.schedule(
+        [task = std::move(task)](const rxcpp::schedulers::schedulable &) {
+          task();
+        });
+  }
+
+  void Stage::start() {
+    if (loop_thread_.joinable()) {
+      return;
+    }
+    loop_thread_ = std::thread([this] {
+      affinity::nameCurrentThread(name_ + "-loop");
+      loop_->run();
+    });
+    affinity::pinThread(loop_thread_.native_handle(), core_);
+    logger::log("STAGE")->info(
+        "{} runs on {}", name_, core_ < 0 ? "any core" : std::to_string(core_));
+  }
+
+  void Stage::stop() {
+    lifetime_.unsubscribe();
+    if (loop_thread_.joinable()) {
+      stop_signal_->send();
+      loop_thread_.join();
+    }
+  }
+
+  Stage::~Stage() {
+    stop();
+  }
+
+  void Stage::pinCurrentThread(int core) {
+    affinity::pinCurrentThread(core);
+  }
+
+}  // namespace iroha
@@ -0,0 +1,98 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_STAGE_HPP
+#define IROHA_STAGE_HPP
+
+#include <memory>
+#include <rxcpp/rx.hpp>
+#include <string>
+#include <thread>
+#include <uvw.hpp>
+
+namespace iroha {
+
+  /**
+   * Execution context of one stage of the pipeline: an event loop for
+   * timers and handles of the stage, and a serial queue for its tasks and
+   * reactive subscriptions. Both run on threads of their own, pinned to
+   * a core when it is given, so stages do not interfere with each other.
+   * Threads are named after the stage, e.g. "consensus-loop".
+   * Handles are created on the loop before start(), because uvw loop is
+   * not thread-safe once it runs.
+   */
+  class Stage {
+   public:
+    /**
+     * @param name - name of stage in logs
+     * @param core - index of core which threads of stage are pinned to,
+     * negative for no pinning
+     */
+    explicit Stage(std::string name, int core = -1);
+
+    Stage(const Stage &) = delete;
+    Stage &operator=(const Stage &) = delete;
+
+    /**
+     * @return event loop of the stage
+     */
+    std::shared_ptr<uvw::Loop> loop() const;
+
+    /**
+     * @return coordination which delivers emissions on the queue of stage
+     */
+    rxcpp::observe_on_one_worker coordination() const;
+
+    /**
+     * Schedule task on the queue, tasks run one by one in order of posting
+     */
+    void post(std::function<void()> task);
+
+    /**
+     * Run the loop on thread of the stage
+     */
+    void start();
+
+    /**
+     * Stop the loop and the queue, pending tasks are dropped
+     */
+    void stop();
+
+    ~Stage();
+
+    /**
+     * Pin calling thread to core, for stages which run on existing threads
+     * @param core - index of core, negative for no pinning
+     */
+    static void pinCurrentThread(int core);
+
+   private:
+    std::string name_;
+    int core_;
+    std::shared_ptr<uvw::Loop> loop_;
+    // keeps the loop alive while it has no other handles, and stops it
+    std::shared_ptr<uvw::AsyncHandle> stop_signal_;
+    std::thread loop_thread_;
+
+    rxcpp::composite_subscription lifetime_;
+    rxcpp::schedulers::worker worker_;
+    rxcpp::observe_on_one_worker coordination_;
+  };
+
+}  // namespace iroha
+
+#endif  // IROHA_STAGE_HPP
@@ -0,0 +1,102 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "main/impl/tunables.hpp"
+#include <fstream>
+#include <rapidjson/istreamwrapper.h>
+#include <sstream>
+
+namespace iroha {
+
+  Tunables::Tunables(std::string config_path)
+      : config_path_(std::move(config_path)), log_(logger::log("Tunables")) {}
+
+  void Tunables::add(std::string key,
+                     uint64_t value,
+                     uint64_t min,
+                     uint64_t max,
+                     Apply apply) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    parameters_[std::move(key)] = {value, min, max, std::move(apply)};
+  }
+
+  size_t Tunables::load(const rapidjson::Value &config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t applied = 0;
+    for (auto &entry : parameters_) {
+      const auto &key = entry.first;
+      auto &parameter = entry.second;
+      if (not config.IsObject() or not config.HasMember(key.c_str())) {
+        continue;
+      }
+      const auto &member = config[key.c_str()];
+      if (not member.IsUint64()) {
+        log_->error("{} is not an unsigned integer, kept {}",
+                    key,
+                    parameter.value);
+        continue;
+      }
+      auto value = member.GetUint64();
+      if (value < parameter.min or value > parameter.max) {
+        log_->error("{} = {} is out of range [{}, {}], kept {}",
+                    key,
+                    value,
+                    parameter.min,
+                    parameter.max,
+                    parameter.value);
+        continue;
+      }
+      if (value == parameter.value) {
+        continue;
+      }
+      log_->info("{}: {} -> {}", key, parameter.value, value);
+      parameter.apply(value);
+      parameter.value = value;
+      ++applied;
+    }
+    return applied;
+  }
+
+  size_t Tunables::reload() {
+    if (config_path_.empty()) {
+      return 0;
+    }
+    std::ifstream file(config_path_);
+    rapidjson::Document config;
+    if (file.is_open()) {
+      rapidjson::IStreamWrapper stream(file);
+      config.ParseStream(stream);
+    }
+    if (not file.is_open() or config.HasParseError()) {
+      log_->error("cannot reload {}, values are kept", config_path_);
+      return 0;
+    }
+    auto applied = load(config);
+    log_->info("reloaded {}, {} values changed", config_path_, applied);
+    return applied;
+  }
+
+  std::string Tunables::report() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ostringstream out;
+    for (const auto &entry : parameters_) {
+      out << entry.first << " " << entry.second.value << "\n";
+    }
+    return out.str();
+  }
+
+}  // namespace iroha
@@ -0,0 +1,99 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_TUNABLES_HPP
+#define IROHA_TUNABLES_HPP
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <rapidjson/document.h>
+#include <string>
+#include "logger/logger.hpp"
+
+namespace iroha {
+
+  /**
+   * Performance parameters which may be changed while the peer runs.
+   * Each parameter is an unsigned member of config, bound to the range of
+   * accepted values and to the setter of component which applies it.
+   * Values are applied when config is loaded at start and again on
+   * reload, so throughput and latency trade-offs are tuned without
+   * restarting the peer. Parameters not registered here are read once.
+   * Thread safe, loads are serialized.
+   */
+  class Tunables {
+   public:
+    using Apply = std::function<void(uint64_t)>;
+
+    /**
+     * @param config_path - config file which is read on reload, empty if
+     * values are only loaded from parsed config
+     */
+    explicit Tunables(std::string config_path = "");
+
+    /**
+     * Register parameter
+     * @param key - name of config member
+     * @param value - value used by component now
+     * @param min, max - range of accepted values
+     * @param apply - applies new value, called on the thread of load
+     */
+    void add(std::string key,
+             uint64_t value,
+             uint64_t min,
+             uint64_t max,
+             Apply apply);
+
+    /**
+     * Apply values of registered parameters which differ from current
+     * ones. Values of wrong type or out of range are reported and
+     * skipped, the parameter keeps its previous value
+     * @return number of applied values
+     */
+    size_t load(const rapidjson::Value &config);
+
+    /**
+     * Read config file again and load it, malformed file is reported and
+     * nothing is changed
+     * @return number of applied values
+     */
+    size_t reload();
+
+    /**
+     * @return current values, one "key value" line each
+     */
+    std::string report() const;
+
+   private:
+    struct Parameter {
+      uint64_t value;
+      uint64_t min;
+      uint64_t max;
+      Apply apply;
+    };
+
+    const std::string config_path_;
+    mutable std::mutex mutex_;
+    std::map<std::string, Parameter> parameters_;
+    logger::Logger log_;
+  };
+
+}  // namespace iroha
+
+#endif  // IROHA_TUNABLES_HPP
@@ -20,16 +20,100 @@
 
 #include <fstream>
 #include <string>
+#include <rapidjson/document.h>
+#include <rapidjson/istreamwrapper.h>
 #include <rapidjson/rapidjson.h>
 #include "common/assert_config.hpp"
 
 namespace config_members {
-  const char* BlockStorePath = "block_store_path";
-  const char* ToriiPort = "torii_port";  // TODO: Needs AddPeer.
-  const char* KeyPairPath = "key_pair_path";
-  const char* PgOpt = "pg_opt";
-  const char* RedisHost = "redis_host";
-  const char* RedisPort = "redis_port";
+  constexpr const char* BlockStorePath = "block_store_path";
+  constexpr const char* BlockStoreType = "block_store_type";  // optional
+  constexpr const char* BlockStoreDurability = "block_store_durability";  // optional
+  constexpr const char* BlockStoreFormat = "block_store_format";  // optional
+  constexpr const char* BlockStoreCompression = "block_store_compression";  // optional
+  constexpr const char* BlockCacheBlocks = "block_cache_blocks";  // optional
+  constexpr const char* BlockCacheBytes = "block_cache_bytes";  // optional
+  constexpr const char* WarmUpBlocks = "warm_up_blocks";  // optional
+  constexpr const char* WsvDeferWrites = "wsv_defer_writes";  // optional
+  constexpr const char* WsvBackend = "wsv_backend";  // optional
+  constexpr const char* WsvPath = "wsv_path";  // required for lmdb backend
+  constexpr const char* WsvReplica = "wsv_replica";  // optional
+  constexpr const char* WsvReplicaMaxLag = "wsv_replica_max_lag";  // optional
+  constexpr const char* BlockIndex = "block_index";  // optional
+  constexpr const char* BlockIndexPath = "block_index_path";  // required for embedded
+  constexpr const char* BlockIndexRebuildRate = "block_index_rebuild_rate";  // optional
+  constexpr const char* TxHashFilter = "tx_hash_filter";  // optional
+  constexpr const char* TxColumns = "tx_columns";  // optional
+  constexpr const char* WsvChangesPath = "wsv_changes_path";  // optional
+  constexpr const char* WsvSnapshotInterval = "wsv_snapshot_interval";  // optional
+  constexpr const char* StateRoot = "state_root";  // optional
+  constexpr const char* BlockRetention = "block_retention";  // optional
+  constexpr const char* BlockArchivePath = "block_archive_path";  // optional
+  constexpr const char* ConsensusRoundWindow = "consensus_round_window";  // optional
+  constexpr const char* ConsensusCompactCommits =
+      "consensus_compact_commits";  // optional
+  constexpr const char* ConsensusFanout = "consensus_fanout";  // optional
+  constexpr const char* ConsensusVoteDelay = "consensus_vote_delay";  // optional
+  constexpr const char* ConsensusAdaptiveDelay =
+      "consensus_adaptive_delay";  // optional
+  constexpr const char* ConsensusVoteOnProposal =
+      "consensus_vote_on_proposal";  // optional
+  constexpr const char* ConsensusPeerHealth = "consensus_peer_health";  // optional
+  constexpr const char* ProposalMinSize = "proposal_min_size";  // optional
+  constexpr const char* ProposalMaxSize = "proposal_max_size";  // optional
+  constexpr const char* ProposalMinDelay = "proposal_min_delay";  // optional
+  constexpr const char* ProposalMaxDelay = "proposal_max_delay";  // optional
+  constexpr const char* MemoryLimit = "memory_limit";  // optional
+  constexpr const char* OrderingMultiIngest = "ordering_multi_ingest";  // optional
+  constexpr const char* OrderingCompactProposals =
+      "ordering_compact_proposals";  // optional
+  constexpr const char* OrderingMempoolLogPath =
+      "ordering_mempool_log_path";  // optional
+  constexpr const char* GrpcCompression = "grpc_compression";  // optional
+  constexpr const char* GrpcKeepaliveTime = "grpc_keepalive_time";  // optional
+  constexpr const char* GrpcKeepaliveTimeout = "grpc_keepalive_timeout";  // optional
+  constexpr const char* GrpcMaxMessageSize = "grpc_max_message_size";  // optional
+  constexpr const char* GrpcInitialWindowSize = "grpc_initial_window_size";  // optional
+  constexpr const char* TlsCertificate = "tls_certificate";  // optional
+  constexpr const char* TlsPrivateKey = "tls_private_key";  // optional
+  constexpr const char* TlsRootCertificates = "tls_root_certificates";  // optional
+  constexpr const char* TlsTorii = "tls_torii";  // optional
+  constexpr const char* TlsSessionCache = "tls_session_cache";  // optional
+  constexpr const char* ToriiAddress = "torii_address";  // optional
+  constexpr const char* InternalAddress = "internal_address";  // optional
+  constexpr const char* MetricsAddress = "metrics_address";  // optional
+  constexpr const char* Profiler = "profiler";  // optional
+  constexpr const char* TraceFile = "trace_file";  // optional
+  constexpr const char* TraceSampling = "trace_sampling";  // optional
+  constexpr const char* ToriiQuotaRate = "torii_quota_rate";  // optional
+  constexpr const char* ToriiQuotaBurst = "torii_quota_burst";  // optional
+  constexpr const char* ToriiShedDepth = "torii_shed_depth";  // optional
+  // "none" (default, nothing is verified), "serial", "parallel" or
+  // "cached"; any check but "none" needs peer_key_path on validators, as
+  // blocks are signed by consensus votes, and excludes
+  // consensus_vote_on_proposal
+  constexpr const char* SignatureCheck = "signature_check";  // optional
+  constexpr const char* SignatureCacheCapacity = "signature_cache_capacity";  // optional
+  constexpr const char* PeerKeyPath = "peer_key_path";  // optional
+  constexpr const char* SignerBatchSize = "signer_batch_size";  // optional
+  constexpr const char* SignerPipelineDepth = "signer_pipeline_depth";  // optional
+  constexpr const char* ValidationConcurrency = "validation_concurrency";  // optional
+  constexpr const char* SpeculativeValidation = "speculative_validation";  // optional
+  constexpr const char* ValidationBudgetPercent = "validation_budget_percent";  // optional
+  constexpr const char* StageThreads = "stage_threads";  // optional
+  constexpr const char* ConsensusCore = "consensus_core";  // optional
+  constexpr const char* OrderingCore = "ordering_core";  // optional
+  constexpr const char* StorageCore = "storage_core";  // optional
+  constexpr const char* IoCore = "io_core";  // optional
+  constexpr const char* NumaNode = "numa_node";  // optional
+  constexpr const char* GrpcClientThreads = "grpc_client_threads";  // optional
+  constexpr const char* ObserveValidators = "observe_validators";  // optional
+  constexpr const char* ObserverKeys = "observer_keys";  // optional
+  constexpr const char* ToriiPort = "torii_port";  // TODO: Needs AddPeer.
+  constexpr const char* KeyPairPath = "key_pair_path";
+  constexpr const char* PgOpt = "pg_opt";
+  constexpr const char* RedisHost = "redis_host";
+  constexpr const char* RedisPort = "redis_port";
 }  // namespace config_members
 
 /**
@@ -51,6 +135,252 @@ inline rapidjson::Document parse_iroha_config(std::string const& iroha_conf_path
   assert_fatal(doc[mbr::BlockStorePath].IsString(),
                type_error(mbr::BlockStorePath, "string"));
 
+  if (doc.HasMember(mbr::BlockStoreType)) {
+    assert_fatal(doc[mbr::BlockStoreType].IsString(),
+                 type_error(mbr::BlockStoreType, "string"));
+    std::string type = doc[mbr::BlockStoreType].GetString();
+    assert_fatal(type == "flat_file" or type == "segmented",
+                 type_error(mbr::BlockStoreType, "flat_file or segmented"));
+  }
+
+  if (doc.HasMember(mbr::BlockStoreDurability)) {
+    assert_fatal(doc[mbr::BlockStoreDurability].IsString(),
+                 type_error(mbr::BlockStoreDurability, "string"));
+    std::string durability = doc[mbr::BlockStoreDurability].GetString();
+    assert_fatal(durability == "none" or durability == "per_commit" or
+                     durability == "per_block",
+                 type_error(mbr::BlockStoreDurability,
+                            "none, per_commit or per_block"));
+  }
+
+  if (doc.HasMember(mbr::BlockStoreFormat)) {
+    assert_fatal(doc[mbr::BlockStoreFormat].IsString(),
+                 type_error(mbr::BlockStoreFormat, "string"));
+    std::string format = doc[mbr::BlockStoreFormat].GetString();
+    assert_fatal(format == "json" or format == "protobuf",
+                 type_error(mbr::BlockStoreFormat, "json or protobuf"));
+  }
+
+  if (doc.HasMember(mbr::BlockStoreCompression)) {
+    assert_fatal(doc[mbr::BlockStoreCompression].IsString(),
+                 type_error(mbr::BlockStoreCompression, "string"));
+    std::string compression = doc[mbr::BlockStoreCompression].GetString();
+    assert_fatal(compression == "none" or compression == "zstd",
+                 type_error(mbr::BlockStoreCompression, "none or zstd"));
+  }
+
+  if (doc.HasMember(mbr::BlockCacheBlocks)) {
+    assert_fatal(doc[mbr::BlockCacheBlocks].IsUint(),
+                 type_error(mbr::BlockCacheBlocks, "uint"));
+  }
+
+  if (doc.HasMember(mbr::BlockCacheBytes)) {
+    assert_fatal(doc[mbr::BlockCacheBytes].IsUint64(),
+                 type_error(mbr::BlockCacheBytes, "uint64"));
+  }
+
+  if (doc.HasMember(mbr::WsvDeferWrites)) {
+    assert_fatal(doc[mbr::WsvDeferWrites].IsBool(),
+                 type_error(mbr::WsvDeferWrites, "bool"));
+  }
+
+  if (doc.HasMember(mbr::WsvBackend)) {
+    assert_fatal(doc[mbr::WsvBackend].IsString(),
+                 type_error(mbr::WsvBackend, "string"));
+    std::string backend = doc[mbr::WsvBackend].GetString();
+    assert_fatal(backend == "postgres" or backend == "lmdb",
+                 type_error(mbr::WsvBackend, "postgres or lmdb"));
+    if (backend == "lmdb") {
+      assert_fatal(doc.HasMember(mbr::WsvPath), no_member_error(mbr::WsvPath));
+      assert_fatal(doc[mbr::WsvPath].IsString(),
+                   type_error(mbr::WsvPath, "string"));
+    }
+  }
+
+  if (doc.HasMember(mbr::WsvReplica)) {
+    assert_fatal(doc[mbr::WsvReplica].IsString(),
+                 type_error(mbr::WsvReplica, "string"));
+  }
+
+  if (doc.HasMember(mbr::WsvReplicaMaxLag)) {
+    assert_fatal(doc[mbr::WsvReplicaMaxLag].IsUint(),
+                 type_error(mbr::WsvReplicaMaxLag, "uint"));
+  }
+
+  if (doc.HasMember(mbr::BlockIndex)) {
+    assert_fatal(doc[mbr::BlockIndex].IsString(),
+                 type_error(mbr::BlockIndex, "string"));
+    std::string index = doc[mbr::BlockIndex].GetString();
+    assert_fatal(index == "redis" or index == "embedded" or index == "none",
+                 type_error(mbr::BlockIndex, "redis, embedded or none"));
+    if (index == "embedded") {
+      assert_fatal(doc.HasMember(mbr::BlockIndexPath),
+                   no_member_error(mbr::BlockIndexPath));
+      assert_fatal(doc[mbr::BlockIndexPath].IsString(),
+                   type_error(mbr::BlockIndexPath, "string"));
+    }
+  }
+
+  if (doc.HasMember(mbr::WarmUpBlocks)) {
+    assert_fatal(doc[mbr::WarmUpBlocks].IsUint(),
+                 type_error(mbr::WarmUpBlocks, "uint"));
+  }
+
+  if (doc.HasMember(mbr::BlockIndexRebuildRate)) {
+    assert_fatal(doc[mbr::BlockIndexRebuildRate].IsUint(),
+                 type_error(mbr::BlockIndexRebuildRate, "uint"));
+  }
+
+  if (doc.HasMember(mbr::TxHashFilter)) {
+    assert_fatal(doc[mbr::TxHashFilter].IsBool(),
+                 type_error(mbr::TxHashFilter, "bool"));
+  }
+
+  if (doc.HasMember(mbr::TxColumns)) {
+    assert_fatal(doc[mbr::TxColumns].IsBool(),
+                 type_error(mbr::TxColumns, "bool"));
+  }
+
+  if (doc.HasMember(mbr::WsvChangesPath)) {
+    assert_fatal(doc[mbr::WsvChangesPath].IsString(),
+                 type_error(mbr::WsvChangesPath, "string"));
+  }
+
+  if (doc.HasMember(mbr::WsvSnapshotInterval)) {
+    assert_fatal(doc[mbr::WsvSnapshotInterval].IsUint(),
+                 type_error(mbr::WsvSnapshotInterval, "uint"));
+  }
+
+  if (doc.HasMember(mbr::StateRoot)) {
+    assert_fatal(doc[mbr::StateRoot].IsBool(),
+                 type_error(mbr::StateRoot, "bool"));
+  }
+
+  if (doc.HasMember(mbr::Profiler)) {
+    assert_fatal(doc[mbr::Profiler].IsBool(),
+                 type_error(mbr::Profiler, "bool"));
+  }
+
+  if (doc.HasMember(mbr::BlockRetention)) {
+    assert_fatal(doc[mbr::BlockRetention].IsUint(),
+                 type_error(mbr::BlockRetention, "uint"));
+  }
+
+  if (doc.HasMember(mbr::BlockArchivePath)) {
+    assert_fatal(doc[mbr::BlockArchivePath].IsString(),
+                 type_error(mbr::BlockArchivePath, "string"));
+  }
+
+  if (doc.HasMember(mbr::ConsensusRoundWindow)) {
+    assert_fatal(doc[mbr::ConsensusRoundWindow].IsUint(),
+                 type_error(mbr::ConsensusRoundWindow, "uint"));
+  }
+
+  if (doc.HasMember(mbr::ConsensusCompactCommits)) {
+    assert_fatal(doc[mbr::ConsensusCompactCommits].IsBool(),
+                 type_error(mbr::ConsensusCompactCommits, "bool"));
+  }
+
+  if (doc.HasMember(mbr::ConsensusFanout)) {
+    assert_fatal(doc[mbr::ConsensusFanout].IsUint(),
+                 type_error(mbr::ConsensusFanout, "uint"));
+  }
+
+  if (doc.HasMember(mbr::ConsensusVoteDelay)) {
+    assert_fatal(doc[mbr::ConsensusVoteDelay].IsUint64(),
+                 type_error(mbr::ConsensusVoteDelay, "uint64"));
+  }
+
+  if (doc.HasMember(mbr::ConsensusAdaptiveDelay)) {
+    assert_fatal(doc[mbr::ConsensusAdaptiveDelay].IsBool(),
+                 type_error(mbr::ConsensusAdaptiveDelay, "bool"));
+  }
+  if (doc.HasMember(mbr::ConsensusVoteOnProposal)) {
+    assert_fatal(doc[mbr::ConsensusVoteOnProposal].IsBool(),
+                 type_error(mbr::ConsensusVoteOnProposal, "bool"));
+  }
+  if (doc.HasMember(mbr::ConsensusPeerHealth)) {
+    assert_fatal(doc[mbr::ConsensusPeerHealth].IsBool(),
+                 type_error(mbr::ConsensusPeerHealth, "bool"));
+  }
+  for (auto proposal : {mbr::ProposalMinSize,
+                        mbr::ProposalMaxSize,
+                        mbr::ProposalMinDelay,
+                        mbr::ProposalMaxDelay}) {
+    if (doc.HasMember(proposal)) {
+      assert_fatal(doc[proposal].IsUint64(), type_error(proposal, "uint64"));
+    }
+  }
+  if (doc.HasMember(mbr::MemoryLimit)) {
+    assert_fatal(doc[mbr::MemoryLimit].IsUint64(),
+                 type_error(mbr::MemoryLimit, "uint64"));
+  }
+  if (doc.HasMember(mbr::StageThreads)) {
+    assert_fatal(doc[mbr::StageThreads].IsBool(),
+                 type_error(mbr::StageThreads, "bool"));
+  }
+  for (auto core : {mbr::ConsensusCore,
+                    mbr::OrderingCore,
+                    mbr::StorageCore,
+                    mbr::IoCore,
+                    mbr::NumaNode}) {
+    if (doc.HasMember(core)) {
+      assert_fatal(doc[core].IsInt(), type_error(core, "int"));
+    }
+  }
+
+  if (doc.HasMember(mbr::GrpcClientThreads)) {
+    assert_fatal(doc[mbr::GrpcClientThreads].IsUint(),
+                 type_error(mbr::GrpcClientThreads, "uint"));
+  }
+
+  for (auto path : {mbr::TlsCertificate,
+                    mbr::TlsPrivateKey,
+                    mbr::TlsRootCertificates}) {
+    if (doc.HasMember(path)) {
+      assert_fatal(doc[path].IsString(), type_error(path, "string"));
+    }
+  }
+  if (doc.HasMember(mbr::TlsCertificate)) {
+    assert_fatal(doc.HasMember(mbr::TlsPrivateKey)
+                     and doc.HasMember(mbr::TlsRootCertificates),
+                 "tls_certificate requires tls_private_key and "
+                 "tls_root_certificates");
+  }
+  if (doc.HasMember(mbr::TlsTorii)) {
+    assert_fatal(doc[mbr::TlsTorii].IsBool(),
+                 type_error(mbr::TlsTorii, "bool"));
+  }
+  if (doc.HasMember(mbr::TlsSessionCache)) {
+    assert_fatal(doc[mbr::TlsSessionCache].IsUint(),
+                 type_error(mbr::TlsSessionCache, "uint"));
+  }
+
+  if (doc.HasMember(mbr::ObserveValidators)) {
+    const auto &validators = doc[mbr::ObserveValidators];
+    assert_fatal(validators.IsArray(),
+                 type_error(mbr::ObserveValidators, "array"));
+    // validator is given by address, or by address and key of its
+    // certificate when it is not reached at address of ledger peer
+    for (const auto &validator : validators.GetArray()) {
+      auto keyed = validator.IsObject() and validator.HasMember("address")
+          and validator["address"].IsString()
+          and validator.HasMember("pubkey") and validator["pubkey"].IsString();
+      assert_fatal(
+          validator.IsString() or keyed,
+          type_error(mbr::ObserveValidators,
+                     "array of addresses or {address, pubkey} objects"));
+    }
+  }
+  if (doc.HasMember(mbr::ObserverKeys)) {
+    const auto &keys = doc[mbr::ObserverKeys];
+    assert_fatal(keys.IsArray(), type_error(mbr::ObserverKeys, "array"));
+    for (const auto &key : keys.GetArray()) {
+      assert_fatal(key.IsString(),
+                   type_error(mbr::ObserverKeys, "array of strings"));
+    }
+  }
+
   assert_fatal(doc.HasMember(mbr::ToriiPort), no_member_error(mbr::ToriiPort));
   assert_fatal(doc[mbr::ToriiPort].IsUint(),
                type_error(mbr::ToriiPort, "uint"));
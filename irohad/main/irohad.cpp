@@ -16,12 +16,17 @@ limitations under the License.
 
 #include <gflags/gflags.h>
 #include <grpc++/grpc++.h>
+#include <cstdlib>
+#include <exception>
 #include <fstream>
+#include <iterator>
 #include <thread>
+#include "affinity/affinity.hpp"
 #include "common/config.hpp"
 #include "main/application.hpp"
 #include "main/iroha_conf_loader.hpp"
 #include "main/raw_block_insertion.hpp"
+#include "tracing/tracing.hpp"
 
 #include "logger/logger.hpp"
 
@@ -33,6 +38,59 @@ bool validate_genesis_path(const char *flag_name, std::string const &path) {
   return not path.empty();
 }
 
+/**
+ * Load keypair of peer from <path>.pub and <path>.priv hex files, as
+ * written by iroha-cli
+ * @return keypair, nullopt if files cannot be read or keys have wrong size
+ */
+nonstd::optional<iroha::ed25519::keypair_t> load_keypair(
+    const std::string &path) {
+  std::ifstream pub_file(path + ".pub");
+  std::ifstream priv_file(path + ".priv");
+  std::string pub_hex, priv_hex;
+  if (not(pub_file >> pub_hex) or not(priv_file >> priv_hex)) {
+    return nonstd::nullopt;
+  }
+  auto pubkey = iroha::hex2bytes(pub_hex);
+  auto privkey = iroha::hex2bytes(priv_hex);
+  iroha::ed25519::keypair_t keypair;
+  if (pubkey.size() != keypair.pubkey.size()
+      or privkey.size() != keypair.privkey.size()) {
+    return nonstd::nullopt;
+  }
+  std::copy(pubkey.begin(), pubkey.end(), keypair.pubkey.begin());
+  std::copy(privkey.begin(), privkey.end(), keypair.privkey.begin());
+  return keypair;
+}
+
+/**
+ * Parse public key of peer from hex string, as in config
+ * @return key, nullopt if string is not hex of key size
+ */
+nonstd::optional<iroha::ed25519::pubkey_t> parse_pubkey(
+    const std::string &hex) {
+  auto bytes = iroha::hex2bytes(hex);
+  iroha::ed25519::pubkey_t key;
+  if (bytes.size() != key.size()) {
+    return nonstd::nullopt;
+  }
+  std::copy(bytes.begin(), bytes.end(), key.begin());
+  return key;
+}
+
+/**
+ * Read whole file, for PEM certificates and keys
+ * @return contents, nullopt if file cannot be read
+ */
+nonstd::optional<std::string> read_file(const std::string &path) {
+  std::ifstream file(path);
+  if (not file) {
+    return nonstd::nullopt;
+  }
+  return std::string(std::istreambuf_iterator<char>(file),
+                     std::istreambuf_iterator<char>());
+}
+
 DEFINE_string(config, "", "Specify iroha provisioning path.");
 DEFINE_validator(config, &validate_config);
 
@@ -41,8 +99,29 @@ DEFINE_validator(genesis_block, &validate_genesis_path);
 
 DEFINE_uint64(peer_number, 0, "Specify peer number");
 
+DEFINE_bool(verify_blocks, false,
+            "Check all stored blocks on start instead of trusting manifest");
+
+DEFINE_bool(bulk_load, false,
+            "Insert genesis block with bulk load, requires empty ledger");
+
+DEFINE_bool(restore_wsv, false,
+            "Restore world state view from the latest snapshot instead of "
+            "inserting genesis block, then apply blocks stored after it");
+
+DEFINE_string(sync_peer, "",
+              "Download blocks up to the latest snapshot of world state view "
+              "from peer at given address, checking only their signatures, "
+              "then restore world state view from the snapshot");
+
 int main(int argc, char *argv[]) {
   auto log = logger::log("MAIN");
+  // queued messages are written on every exit, errors and terminate included
+  std::atexit(logger::shutdown);
+  std::set_terminate([] {
+    logger::shutdown();
+    std::abort();
+  });
   log->info("start");
   namespace mbr = config_members;
 
@@ -51,22 +130,409 @@ int main(int argc, char *argv[]) {
 
   auto config = parse_iroha_config(FLAGS_config);
   log->info("config initialized");
+
+  iroha::ametsuchi::BlockStorageOptions block_storage_options;
+  if (config.HasMember(mbr::BlockStoreType) and
+      std::string(config[mbr::BlockStoreType].GetString()) == "segmented") {
+    block_storage_options.type = iroha::ametsuchi::BlockStorageType::Segmented;
+  }
+  if (config.HasMember(mbr::BlockStoreDurability)) {
+    std::string durability = config[mbr::BlockStoreDurability].GetString();
+    if (durability == "none") {
+      block_storage_options.durability =
+          iroha::ametsuchi::DurabilityPolicy::None;
+    } else if (durability == "per_block") {
+      block_storage_options.durability =
+          iroha::ametsuchi::DurabilityPolicy::PerBlock;
+    }
+  }
+  if (config.HasMember(mbr::BlockStoreFormat) and
+      std::string(config[mbr::BlockStoreFormat].GetString()) == "json") {
+    block_storage_options.format = iroha::ametsuchi::BlockFormat::Json;
+  }
+  if (config.HasMember(mbr::BlockStoreCompression) and
+      std::string(config[mbr::BlockStoreCompression].GetString()) ==
+          "zstd") {
+    block_storage_options.compression =
+        iroha::ametsuchi::BlockCompression::Zstd;
+  }
+  if (config.HasMember(mbr::BlockCacheBlocks)) {
+    block_storage_options.cache_blocks =
+        config[mbr::BlockCacheBlocks].GetUint();
+  }
+  if (config.HasMember(mbr::BlockCacheBytes)) {
+    block_storage_options.cache_bytes =
+        config[mbr::BlockCacheBytes].GetUint64();
+  }
+  if (config.HasMember(mbr::WsvDeferWrites)) {
+    block_storage_options.defer_wsv_writes =
+        config[mbr::WsvDeferWrites].GetBool();
+  }
+  if (config.HasMember(mbr::WsvBackend) and
+      std::string(config[mbr::WsvBackend].GetString()) == "lmdb") {
+    block_storage_options.wsv_backend = iroha::ametsuchi::WsvBackendType::Lmdb;
+    block_storage_options.wsv_path = config[mbr::WsvPath].GetString();
+    // embedded world state does not need external services by default
+    block_storage_options.block_index =
+        iroha::ametsuchi::BlockIndexType::None;
+  }
+  if (config.HasMember(mbr::WsvReplica)) {
+    block_storage_options.wsv_replica = config[mbr::WsvReplica].GetString();
+  }
+  if (config.HasMember(mbr::WsvReplicaMaxLag)) {
+    block_storage_options.wsv_replica_max_lag =
+        config[mbr::WsvReplicaMaxLag].GetUint();
+  }
+  if (config.HasMember(mbr::BlockIndex)) {
+    std::string index = config[mbr::BlockIndex].GetString();
+    if (index == "none") {
+      block_storage_options.block_index =
+          iroha::ametsuchi::BlockIndexType::None;
+    } else if (index == "embedded") {
+      block_storage_options.block_index =
+          iroha::ametsuchi::BlockIndexType::Embedded;
+      block_storage_options.block_index_path =
+          config[mbr::BlockIndexPath].GetString();
+    } else {
+      block_storage_options.block_index =
+          iroha::ametsuchi::BlockIndexType::Redis;
+    }
+  }
+  if (config.HasMember(mbr::WarmUpBlocks)) {
+    block_storage_options.warm_up_blocks = config[mbr::WarmUpBlocks].GetUint();
+  }
+  if (config.HasMember(mbr::BlockIndexRebuildRate)) {
+    block_storage_options.block_index_rebuild_rate =
+        config[mbr::BlockIndexRebuildRate].GetUint();
+  }
+  if (config.HasMember(mbr::TxHashFilter)) {
+    block_storage_options.tx_hash_filter =
+        config[mbr::TxHashFilter].GetBool();
+  }
+  if (config.HasMember(mbr::TxColumns)) {
+    block_storage_options.tx_columns = config[mbr::TxColumns].GetBool();
+  }
+  if (config.HasMember(mbr::WsvChangesPath)) {
+    block_storage_options.wsv_changes_path =
+        config[mbr::WsvChangesPath].GetString();
+  }
+  if (config.HasMember(mbr::WsvSnapshotInterval)) {
+    block_storage_options.wsv_snapshot_interval =
+        config[mbr::WsvSnapshotInterval].GetUint();
+  }
+  if (config.HasMember(mbr::StateRoot)) {
+    block_storage_options.state_root = config[mbr::StateRoot].GetBool();
+  }
+  if (config.HasMember(mbr::BlockRetention)) {
+    block_storage_options.block_retention =
+        config[mbr::BlockRetention].GetUint();
+  }
+  if (config.HasMember(mbr::BlockArchivePath)) {
+    block_storage_options.block_archive_path =
+        config[mbr::BlockArchivePath].GetString();
+  }
+  block_storage_options.verify_blocks = FLAGS_verify_blocks;
+
+  iroha::consensus::yac::YacOptions yac_options;
+  if (config.HasMember(mbr::ConsensusRoundWindow)) {
+    yac_options.round_window = config[mbr::ConsensusRoundWindow].GetUint();
+  }
+  if (config.HasMember(mbr::ConsensusCompactCommits)) {
+    yac_options.compact_commits =
+        config[mbr::ConsensusCompactCommits].GetBool();
+  }
+  if (config.HasMember(mbr::ConsensusFanout)) {
+    yac_options.fanout = config[mbr::ConsensusFanout].GetUint();
+  }
+  if (config.HasMember(mbr::ConsensusVoteDelay)) {
+    yac_options.vote_delay = config[mbr::ConsensusVoteDelay].GetUint64();
+  }
+  if (config.HasMember(mbr::ConsensusAdaptiveDelay)) {
+    yac_options.adaptive_delay =
+        config[mbr::ConsensusAdaptiveDelay].GetBool();
+  }
+  if (config.HasMember(mbr::ConsensusVoteOnProposal)) {
+    yac_options.vote_on_proposal =
+        config[mbr::ConsensusVoteOnProposal].GetBool();
+  }
+  if (config.HasMember(mbr::ConsensusPeerHealth)
+      and config[mbr::ConsensusPeerHealth].GetBool()) {
+    // leader answering in half of vote delay leaves time for failover
+    yac_options.peer_health = std::make_shared<iroha::network::PeerHealth>(
+        yac_options.vote_delay / 2);
+  }
+
+  iroha::network::OrderingOptions ordering_options;
+  if (config.HasMember(mbr::OrderingMultiIngest)) {
+    ordering_options.multi_ingest =
+        config[mbr::OrderingMultiIngest].GetBool();
+  }
+  if (config.HasMember(mbr::OrderingCompactProposals)) {
+    ordering_options.compact_proposals =
+        config[mbr::OrderingCompactProposals].GetBool();
+  }
+  if (config.HasMember(mbr::OrderingMempoolLogPath)) {
+    ordering_options.mempool_log_path =
+        config[mbr::OrderingMempoolLogPath].GetString();
+  }
+
+  iroha::network::ChannelOptions channel_options;
+  if (config.HasMember(mbr::GrpcCompression)) {
+    auto compression = iroha::network::parseCompression(
+        config[mbr::GrpcCompression].GetString());
+    if (not compression) {
+      log->error("unknown grpc compression {}",
+                 config[mbr::GrpcCompression].GetString());
+      return EXIT_FAILURE;
+    }
+    channel_options.compression = *compression;
+  }
+  if (config.HasMember(mbr::GrpcKeepaliveTime)) {
+    channel_options.keepalive_time = std::chrono::milliseconds(
+        config[mbr::GrpcKeepaliveTime].GetUint());
+  }
+  if (config.HasMember(mbr::GrpcKeepaliveTimeout)) {
+    channel_options.keepalive_timeout = std::chrono::milliseconds(
+        config[mbr::GrpcKeepaliveTimeout].GetUint());
+  }
+  if (config.HasMember(mbr::GrpcMaxMessageSize)) {
+    channel_options.max_message_size =
+        config[mbr::GrpcMaxMessageSize].GetInt();
+  }
+  if (config.HasMember(mbr::GrpcInitialWindowSize)) {
+    channel_options.initial_window_size =
+        config[mbr::GrpcInitialWindowSize].GetInt();
+  }
+  if (config.HasMember(mbr::TlsCertificate)) {
+    auto certificate = read_file(config[mbr::TlsCertificate].GetString());
+    auto private_key = read_file(config[mbr::TlsPrivateKey].GetString());
+    auto roots = read_file(config[mbr::TlsRootCertificates].GetString());
+    if (not certificate or not private_key or not roots) {
+      log->error("cannot read tls certificates");
+      return EXIT_FAILURE;
+    }
+    channel_options.tls.certificate = *certificate;
+    channel_options.tls.private_key = *private_key;
+    channel_options.tls.root_certificates = *roots;
+    // before the first secure channel initializes ssl of grpc
+    iroha::network::selectCipherSuites();
+  }
+  if (config.HasMember(mbr::TlsTorii)) {
+    channel_options.tls.torii = config[mbr::TlsTorii].GetBool();
+  }
+  if (config.HasMember(mbr::TlsSessionCache)) {
+    channel_options.tls.session_cache_size =
+        config[mbr::TlsSessionCache].GetUint();
+  }
+
+  ListenOptions listen_options;
+  if (config.HasMember(mbr::ToriiAddress)) {
+    listen_options.torii_address = config[mbr::ToriiAddress].GetString();
+  }
+  if (config.HasMember(mbr::InternalAddress)) {
+    listen_options.internal_address =
+        config[mbr::InternalAddress].GetString();
+  }
+  if (config.HasMember(mbr::MetricsAddress)) {
+    listen_options.metrics_address = config[mbr::MetricsAddress].GetString();
+  }
+  if (config.HasMember(mbr::Profiler)) {
+    listen_options.profiler = config[mbr::Profiler].GetBool();
+  }
+  // spans are exported only when file is set, sampling is shared by all
+  // components, so it is configured before they are created
+  if (config.HasMember(mbr::TraceFile)) {
+    iroha::tracing::tracer().configure(
+        config.HasMember(mbr::TraceSampling)
+            ? config[mbr::TraceSampling].GetDouble()
+            : 0,
+        config[mbr::TraceFile].GetString());
+  }
+
+  AdmissionOptions admission_options;
+  if (config.HasMember(mbr::ToriiQuotaRate)) {
+    admission_options.rate = config[mbr::ToriiQuotaRate].GetDouble();
+  }
+  if (config.HasMember(mbr::ToriiQuotaBurst)) {
+    admission_options.burst = config[mbr::ToriiQuotaBurst].GetUint();
+  }
+  if (config.HasMember(mbr::ToriiShedDepth)) {
+    admission_options.shed_depth = config[mbr::ToriiShedDepth].GetUint();
+  }
+
+  CryptoOptions crypto_options;
+  if (config.HasMember(mbr::SignatureCheck)) {
+    auto check = iroha::model::parseSignatureCheck(
+        config[mbr::SignatureCheck].GetString());
+    if (not check) {
+      log->error("unknown signature check {}",
+                 config[mbr::SignatureCheck].GetString());
+      return EXIT_FAILURE;
+    }
+    crypto_options.signature_check = *check;
+  }
+  if (config.HasMember(mbr::SignatureCacheCapacity)) {
+    crypto_options.cache_capacity =
+        config[mbr::SignatureCacheCapacity].GetUint();
+  }
+  if (config.HasMember(mbr::PeerKeyPath)) {
+    auto keypair = load_keypair(config[mbr::PeerKeyPath].GetString());
+    if (not keypair) {
+      log->error("cannot load peer keys from {}",
+                 config[mbr::PeerKeyPath].GetString());
+      return EXIT_FAILURE;
+    }
+    yac_options.signer = std::make_shared<iroha::KeypairSigner>(*keypair);
+  }
+  // key which is held remotely is reached through batching pipeline,
+  // for key in memory it only moves signing off consensus thread
+  if (yac_options.signer and config.HasMember(mbr::SignerPipelineDepth)) {
+    auto batch_size = config.HasMember(mbr::SignerBatchSize)
+        ? config[mbr::SignerBatchSize].GetUint()
+        : iroha::BatchingSigner::kDefaultBatchSize;
+    yac_options.signer = std::make_shared<iroha::BatchingSigner>(
+        yac_options.signer,
+        batch_size,
+        config[mbr::SignerPipelineDepth].GetUint());
+  }
+
+  ValidationOptions validation_options;
+  if (config.HasMember(mbr::ValidationConcurrency)) {
+    validation_options.concurrency =
+        config[mbr::ValidationConcurrency].GetUint();
+  }
+  if (config.HasMember(mbr::SpeculativeValidation)) {
+    validation_options.speculative =
+        config[mbr::SpeculativeValidation].GetBool();
+  }
+  if (config.HasMember(mbr::ValidationBudgetPercent)) {
+    validation_options.budget_percent =
+        config[mbr::ValidationBudgetPercent].GetUint();
+  }
+
+  ThreadingOptions threading_options;
+  if (config.HasMember(mbr::StageThreads)) {
+    threading_options.stages = config[mbr::StageThreads].GetBool();
+  }
+  if (config.HasMember(mbr::ConsensusCore)) {
+    threading_options.consensus_core = config[mbr::ConsensusCore].GetInt();
+  }
+  if (config.HasMember(mbr::OrderingCore)) {
+    threading_options.ordering_core = config[mbr::OrderingCore].GetInt();
+  }
+  if (config.HasMember(mbr::StorageCore)) {
+    threading_options.storage_core = config[mbr::StorageCore].GetInt();
+  }
+  if (config.HasMember(mbr::IoCore)) {
+    threading_options.io_core = config[mbr::IoCore].GetInt();
+  }
+  if (config.HasMember(mbr::NumaNode)) {
+    threading_options.numa_node = config[mbr::NumaNode].GetInt();
+  }
+  if (config.HasMember(mbr::GrpcClientThreads)) {
+    threading_options.grpc_client_threads =
+        config[mbr::GrpcClientThreads].GetUint();
+  }
+
+  ObserverOptions observer_options;
+  if (config.HasMember(mbr::ObserveValidators)) {
+    for (const auto &validator : config[mbr::ObserveValidators].GetArray()) {
+      if (validator.IsString()) {
+        observer_options.validators.emplace_back(validator.GetString());
+        continue;
+      }
+      std::string address = validator["address"].GetString();
+      auto key = parse_pubkey(validator["pubkey"].GetString());
+      if (not key) {
+        log->error("malformed key of validator {}", address);
+        return EXIT_FAILURE;
+      }
+      observer_options.validators.push_back(address);
+      observer_options.validator_keys[address] = *key;
+    }
+  }
+  if (config.HasMember(mbr::ObserverKeys)) {
+    for (const auto &hex : config[mbr::ObserverKeys].GetArray()) {
+      auto key = parse_pubkey(hex.GetString());
+      if (not key) {
+        log->error("malformed observer key {}", hex.GetString());
+        return EXIT_FAILURE;
+      }
+      observer_options.observer_keys.push_back(*key);
+    }
+  }
+
+  // commits carry vote signatures as signatures of their blocks, which
+  // chain validation checks unless signature check is off
+  auto validates = observer_options.validators.empty();
+  if (crypto_options.signature_check == iroha::model::SignatureCheck::None) {
+    log->warn("Signatures are not verified, set {} to verify them",
+              mbr::SignatureCheck);
+  } else if (validates and not yac_options.signer) {
+    log->error("{} requires {}, votes are not signed without peer key",
+               mbr::SignatureCheck,
+               mbr::PeerKeyPath);
+    return EXIT_FAILURE;
+  } else if (validates and yac_options.vote_on_proposal) {
+    log->error("{} requires {} none, votes on proposal do not sign its block",
+               mbr::ConsensusVoteOnProposal,
+               mbr::SignatureCheck);
+    return EXIT_FAILURE;
+  }
+
+  // threads started from now on, including those of storage, run on the
+  // node and allocate its memory
+  if (not iroha::affinity::bindCurrentThreadToNode(
+          threading_options.numa_node)) {
+    log->warn("Threads are not bound to NUMA node {}",
+              threading_options.numa_node);
+  }
+
   Irohad irohad(config[mbr::BlockStorePath].GetString(),
                 config[mbr::RedisHost].GetString(),
                 config[mbr::RedisPort].GetUint(),
                 config[mbr::PgOpt].GetString(),
-                config[mbr::ToriiPort].GetUint(), FLAGS_peer_number);
+                config[mbr::ToriiPort].GetUint(), FLAGS_peer_number,
+                block_storage_options, yac_options, ordering_options,
+                channel_options, listen_options, admission_options,
+                crypto_options, validation_options, threading_options,
+                std::move(observer_options), TuningOptions{FLAGS_config});
   log->info("storage initialized: {}", logger::logBool(irohad.storage));
 
-  iroha::main::BlockInserter inserter(irohad.storage);
-  auto file = inserter.loadFile(FLAGS_genesis_block);
-  auto block = inserter.parseBlock(file.value());
-  log->info("Block is parsed");
+  iroha::main::BlockInserter inserter(irohad.storage, FLAGS_bulk_load);
+  if (not FLAGS_sync_peer.empty()
+      and not irohad.syncHeaders(FLAGS_sync_peer)) {
+    log->error("Blocks are not synchronized from {}", FLAGS_sync_peer);
+    return EXIT_FAILURE;
+  }
+  if (FLAGS_restore_wsv or not FLAGS_sync_peer.empty()) {
+    auto height = irohad.storage->importWsvSnapshot({});
+    if (not height) {
+      log->error("World state view is not restored");
+      return EXIT_FAILURE;
+    }
+    // blocks after the snapshot are applied in parts to bound memory use
+    const uint32_t kReplayBlocks = 1000;
+    auto top = irohad.storage->height();
+    for (auto from = *height + 1; from <= top; from += kReplayBlocks) {
+      std::vector<iroha::model::Block> blocks;
+      irohad.storage->getBlocks(from, from + kReplayBlocks - 1)
+          .as_blocking()
+          .subscribe([&blocks](auto block) { blocks.push_back(block); });
+      inserter.applyToLedger(blocks);
+    }
+    log->info("World state view restored at height {}, applied {} blocks",
+              *height, top - *height);
+  } else {
+    auto file = inserter.loadFile(FLAGS_genesis_block);
+    auto block = inserter.parseBlock(file.value());
+    log->info("Block is parsed");
 
-  if (block.has_value()) {
-    inserter.applyToLedger({block.value()});
-    log->info("Genesis block inserted, number of transactions: {}",
-               block.value().transactions.size());
+    if (block.has_value()) {
+      inserter.applyToLedger({block.value()});
+      log->info("Genesis block inserted, number of transactions: {}",
+                block.value().transactions.size());
+    }
   }
 
   // runs iroha
@@ -22,10 +22,10 @@
 #include <nonstd/optional.hpp>
 #include <string>
 #include <vector>
+#include "ametsuchi/impl/block_serializer.hpp"
 #include "ametsuchi/storage.hpp"
 #include "logger/logger.hpp"
 #include "model/block.hpp"
-#include "model/converters/json_block_factory.hpp"
 
 namespace iroha {
   namespace main {
@@ -37,10 +37,15 @@ namespace iroha {
      */
     class BlockInserter {
      public:
-      explicit BlockInserter(std::shared_ptr<ametsuchi::MutableFactory> factory);
+      /**
+       * @param factory - storage to insert blocks into
+       * @param bulk_load - apply blocks with bulk load into empty ledger
+       */
+      explicit BlockInserter(std::shared_ptr<ametsuchi::MutableFactory> factory,
+                             bool bulk_load = false);
 
       /**
-       * Parse block from file
+       * Parse block from file, in JSON or binary format
        * @param data - raw presenetation of block
        * @return object if operation done successfully, nullopt otherwise
        */
@@ -62,7 +67,8 @@ namespace iroha {
 
      private:
       std::shared_ptr<ametsuchi::MutableFactory> factory_;
-      model::converters::JsonBlockFactory block_factory_;
+      bool bulk_load_;
+      ametsuchi::BlockSerializer block_factory_;
 
       logger::Logger log_;
     };
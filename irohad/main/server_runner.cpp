@@ -20,35 +20,47 @@ limitations under the License.
 #include <logger/logger.hpp>
 #include <main/server_runner.hpp>
 
-ServerRunner::ServerRunner(const std::string &address)
-    : serverAddress_(address) {}
+ServerRunner::ServerRunner(const std::string &address,
+                           size_t queues,
+                           iroha::network::ChannelOptions options)
+    : serverAddress_(address), queues_(queues), options_(options) {}
 
-ServerRunner::~ServerRunner() { toriiServiceHandler_->shutdown(); }
+constexpr std::chrono::milliseconds ServerRunner::kDefaultDrainTimeout;
+
+ServerRunner::~ServerRunner() {
+  if (toriiServiceHandler_) {
+    toriiServiceHandler_->shutdown();
+  }
+}
 
 void ServerRunner::run(std::unique_ptr<torii::CommandService> command_service,
                        std::unique_ptr<torii::QueryService> query_service) {
   grpc::ServerBuilder builder;
 
-  builder.AddListeningPort(serverAddress_, grpc::InsecureServerCredentials());
+  builder.AddListeningPort(serverAddress_,
+                           options_.tls.torii
+                               ? iroha::network::serverCredentials(options_)
+                               : grpc::InsecureServerCredentials());
+  iroha::network::configureServer(builder, options_);
 
   // Register services.
-  toriiServiceHandler_ = std::make_unique<torii::ToriiServiceHandler>(builder);
+  toriiServiceHandler_ =
+      std::make_unique<torii::ToriiServiceHandler>(builder, queues_);
   toriiServiceHandler_->assignCommandHandler(std::move(command_service));
   toriiServiceHandler_->assignQueryHandler(std::move(query_service));
 
   serverInstance_ = builder.BuildAndStart();
   serverInstanceCV_.notify_one();
 
-  // proceed to server's main loop
+  // proceed to server's main loop, returns when all queues are shut down
   toriiServiceHandler_->handleRpcs();
 }
 
-void ServerRunner::shutdown() {
-  serverInstance_->Shutdown();
-
-  while (not toriiServiceHandler_->isShutdownCompletionQueue()) {
-    usleep(1);  // wait for shutting down completion queue
-  }
+void ServerRunner::shutdown(std::chrono::milliseconds drain_timeout) {
+  // new calls are refused at once, in-flight ones are cancelled once the
+  // deadline passes, and pending requests of rpcs are failed
+  serverInstance_->Shutdown(std::chrono::system_clock::now() +
+                            drain_timeout);
   toriiServiceHandler_->shutdown();
 }
 
@@ -16,6 +16,8 @@ limitations under the License.
 
 #include <grpc++/grpc++.h>
 #include <grpc++/server_builder.h>
+#include <chrono>
+#include "network/impl/channel_options.hpp"
 #include "torii/command_service.hpp"
 #include "torii/torii_service_handler.hpp"
 
@@ -28,11 +30,31 @@ namespace torii {
 
 class ServerRunner {
  public:
-  explicit ServerRunner(const std::string &address);
+  /**
+   * @param address - listening address of Torii
+   * @param queues - number of completion queues, each polled by its own
+   * thread
+   * @param options - transport settings of the server
+   */
+  explicit ServerRunner(const std::string &address,
+                        size_t queues = 1,
+                        iroha::network::ChannelOptions options =
+                            iroha::network::ChannelOptions());
   ~ServerRunner();
   void run(std::unique_ptr<torii::CommandService> commandService,
            std::unique_ptr<torii::QueryService> queryService);
-  void shutdown();
+  /**
+   * Default time given to in-flight calls to finish on shutdown
+   */
+  static constexpr std::chrono::milliseconds kDefaultDrainTimeout{5000};
+
+  /**
+   * Stop accepting calls, let in-flight calls finish within timeout and
+   * cancel the rest, then shut down completion queues.
+   * Returns when queues are drained
+   * @param drain_timeout - time given to in-flight calls
+   */
+  void shutdown(std::chrono::milliseconds drain_timeout = kDefaultDrainTimeout);
   void waitForServersReady();
 
  private:
@@ -41,6 +63,8 @@ class ServerRunner {
   std::condition_variable serverInstanceCV_;
 
   std::string serverAddress_;
+  size_t queues_;
+  iroha::network::ChannelOptions options_;
   std::unique_ptr<torii::ToriiServiceHandler> toriiServiceHandler_;
 };
 
@@ -98,6 +98,33 @@ namespace iroha {
 
         bool operator==(const Permissions &rhs) const;
         bool operator!=(const Permissions &rhs) const;
+
+        /**
+         * Bits of permissions in integer encoding, new permissions must be
+         * appended to keep stored values valid
+         */
+        enum Bit : uint64_t {
+          kAddSignatory = 1ull << 0,
+          kCanTransfer = 1ull << 1,
+          kCreateAccounts = 1ull << 2,
+          kCreateAssets = 1ull << 3,
+          kCreateDomains = 1ull << 4,
+          kIssueAssets = 1ull << 5,
+          kReadAllAccounts = 1ull << 6,
+          kRemoveSignatory = 1ull << 7,
+          kSetPermissions = 1ull << 8,
+          kSetQuorum = 1ull << 9
+        };
+
+        /**
+         * @return permissions packed into bitmask of Bit values
+         */
+        uint64_t toBitmask() const;
+
+        /**
+         * Unpack permissions from bitmask, unknown bits are ignored
+         */
+        static Permissions fromBitmask(uint64_t mask);
       };
 
       /**
@@ -124,6 +151,13 @@ namespace iroha {
        * Identifier of account
        */
       ed25519::pubkey_t master_key;
+
+      /**
+       * Counter of the latest transaction created by account, transactions
+       * with counter not above it are replays. Zero until a transaction
+       * with counter is committed
+       */
+      uint64_t tx_counter = 0;
     };
   }
 }
@@ -70,8 +70,7 @@ namespace iroha {
       uint16_t txs_number;
 
       /**
-       * Root of merkle tree based on the block and all previous blocks
-       * in the ledger
+       * Root of merkle tree of transaction hashes of the block
        * META field
        */
       hash256_t merkle_root;
@@ -21,6 +21,7 @@
 #include <ametsuchi/wsv_command.hpp>
 #include <ametsuchi/wsv_query.hpp>
 #include <model/account.hpp>
+#include "model/command_list.hpp"
 
 namespace iroha {
   namespace model {
@@ -36,6 +37,24 @@ namespace iroha {
                            ametsuchi::WsvCommand& commands) = 0;
       virtual bool operator==(const Command& rhs) const = 0;
       virtual bool operator!=(const Command& rhs) const = 0;
+
+      /**
+       * @return position of command type in Commands,
+       * kCommandKinds if it is not listed there
+       */
+      virtual size_t kind() const {
+        return kCommandKinds;
+      }
+    };
+
+    /**
+     * Base of listed commands, provides their kind
+     */
+    template <typename T>
+    struct CommandOf : public Command {
+      size_t kind() const override {
+        return kindOf<T>();
+      }
     };
   }
 }
@@ -0,0 +1,97 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_COMMAND_LIST_HPP
+#define IROHA_COMMAND_LIST_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+namespace iroha {
+  namespace model {
+
+    struct AddAssetQuantity;
+    struct AddPeer;
+    struct AddSignatory;
+    struct AssignMasterKey;
+    struct CreateAccount;
+    struct CreateAsset;
+    struct CreateDomain;
+    struct RemoveSignatory;
+    struct SetAccountPermissions;
+    struct SetQuorum;
+    struct TransferAsset;
+
+    template <typename... Ts>
+    struct TypeList {};
+
+    /**
+     * All commands known to the model. Converters build their dispatch
+     * tables from this list, indexed by kind of command, so a new command
+     * is added here and given bindings in each converter
+     */
+    using Commands = TypeList<AddAssetQuantity,
+                              AddPeer,
+                              AddSignatory,
+                              AssignMasterKey,
+                              CreateAccount,
+                              CreateAsset,
+                              CreateDomain,
+                              RemoveSignatory,
+                              SetAccountPermissions,
+                              SetQuorum,
+                              TransferAsset>;
+
+    namespace detail {
+      template <typename T, typename List>
+      struct IndexOf;
+
+      template <typename T, typename... Ts>
+      struct IndexOf<T, TypeList<T, Ts...>>
+          : std::integral_constant<size_t, 0> {};
+
+      template <typename T, typename U, typename... Ts>
+      struct IndexOf<T, TypeList<U, Ts...>>
+          : std::integral_constant<size_t,
+                                   1 + IndexOf<T, TypeList<Ts...>>::value> {
+      };
+
+      template <typename List>
+      struct SizeOf;
+
+      template <typename... Ts>
+      struct SizeOf<TypeList<Ts...>>
+          : std::integral_constant<size_t, sizeof...(Ts)> {};
+    }  // namespace detail
+
+    /**
+     * Number of command kinds, also kind of commands not in the list
+     */
+    constexpr size_t kCommandKinds = detail::SizeOf<Commands>::value;
+
+    /**
+     * @return position of command type in Commands
+     */
+    template <typename T>
+    constexpr size_t kindOf() {
+      return detail::IndexOf<T, Commands>::value;
+    }
+
+  }  // namespace model
+}  // namespace iroha
+
+#endif  // IROHA_COMMAND_LIST_HPP
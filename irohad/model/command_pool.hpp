@@ -0,0 +1,185 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_COMMAND_POOL_HPP
+#define IROHA_COMMAND_POOL_HPP
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace iroha {
+  namespace model {
+
+    namespace detail {
+
+      /**
+       * Free lists of released memory blocks by size class, one set per
+       * thread. Blocks released by another thread join lists of that
+       * thread, lists are bounded so memory of a burst is given back
+       */
+      class FreeLists {
+       public:
+        static constexpr size_t kGranularity = 32;
+        static constexpr size_t kClasses = 16;
+        static constexpr size_t kMaxFree = 4096;
+
+        /**
+         * @return true if blocks of size are pooled
+         */
+        static constexpr bool pooled(size_t size) {
+          return size <= kGranularity * kClasses;
+        }
+
+        /**
+         * @return lists of current thread, null once they are destroyed at
+         * thread exit
+         */
+        static FreeLists *local() {
+          if (destroyed()) {
+            return nullptr;
+          }
+          thread_local FreeLists lists;
+          return &lists;
+        }
+
+        void *acquire(size_t size) {
+          auto &list = lists_[index(size)];
+          if (list.head) {
+            auto block = list.head;
+            list.head = block->next;
+            --list.size;
+            return block;
+          }
+          return ::operator new((index(size) + 1) * kGranularity);
+        }
+
+        void release(void *pointer, size_t size) {
+          auto &list = lists_[index(size)];
+          if (list.size == kMaxFree) {
+            ::operator delete(pointer);
+            return;
+          }
+          auto block = static_cast<Block *>(pointer);
+          block->next = list.head;
+          list.head = block;
+          ++list.size;
+        }
+
+        ~FreeLists() {
+          destroyed() = true;
+          for (auto &list : lists_) {
+            while (list.head) {
+              auto block = list.head;
+              list.head = block->next;
+              ::operator delete(block);
+            }
+          }
+        }
+
+       private:
+        struct Block {
+          Block *next;
+        };
+
+        struct List {
+          Block *head = nullptr;
+          size_t size = 0;
+        };
+
+        // trivial, so it is readable after the lists are destroyed
+        static bool &destroyed() {
+          thread_local bool flag = false;
+          return flag;
+        }
+
+        static size_t index(size_t size) {
+          return (size + kGranularity - 1) / kGranularity - 1;
+        }
+
+        std::array<List, kClasses> lists_;
+      };
+
+    }  // namespace detail
+
+    /**
+     * Allocator which reuses memory of released objects of the same size
+     * class from per-thread free lists, so threads deserializing
+     * transactions do not contend on the heap and small objects of
+     * long-running node do not fragment it. Objects too big for the pool
+     * come from the heap
+     */
+    template <typename T>
+    class PoolAllocator {
+     public:
+      using value_type = T;
+
+      PoolAllocator() = default;
+
+      template <typename U>
+      PoolAllocator(const PoolAllocator<U> &) {}
+
+      T *allocate(size_t n) {
+        auto size = n * sizeof(T);
+        auto lists = pooled(size) ? detail::FreeLists::local() : nullptr;
+        return static_cast<T *>(lists ? lists->acquire(size)
+                                      : ::operator new(size));
+      }
+
+      void deallocate(T *pointer, size_t n) {
+        auto size = n * sizeof(T);
+        auto lists = pooled(size) ? detail::FreeLists::local() : nullptr;
+        if (lists) {
+          lists->release(pointer, size);
+        } else {
+          ::operator delete(pointer);
+        }
+      }
+
+      template <typename U>
+      bool operator==(const PoolAllocator<U> &) const {
+        return true;
+      }
+
+      template <typename U>
+      bool operator!=(const PoolAllocator<U> &) const {
+        return false;
+      }
+
+     private:
+      static constexpr bool pooled(size_t size) {
+        return alignof(T) <= alignof(std::max_align_t)
+            and detail::FreeLists::pooled(size);
+      }
+    };
+
+    /**
+     * Create shared object, which shares one pooled block with its
+     * control block
+     */
+    template <typename T, typename... Args>
+    std::shared_ptr<T> makePooled(Args &&... args) {
+      return std::allocate_shared<T>(PoolAllocator<T>(),
+                                     std::forward<Args>(args)...);
+    }
+
+  }  // namespace model
+}  // namespace iroha
+
+#endif  // IROHA_COMMAND_POOL_HPP
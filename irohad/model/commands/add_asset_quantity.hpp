@@ -28,7 +28,7 @@ namespace iroha {
     /**
      * Add amount of asset to an account
      */
-    struct AddAssetQuantity : public Command {
+    struct AddAssetQuantity : public CommandOf<AddAssetQuantity> {
       /**
        * Account where to add assets
        */
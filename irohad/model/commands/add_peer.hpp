@@ -28,7 +28,7 @@ namespace iroha {
     /**
      * Provide user's intent for adding peer to current network
      */
-    struct AddPeer : public Command {
+    struct AddPeer : public CommandOf<AddPeer> {
       ed25519::pubkey_t peer_key;
 
       std::string address;
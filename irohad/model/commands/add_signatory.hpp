@@ -28,7 +28,7 @@ namespace iroha {
     /**
      * Attach signatory for account
      */
-    struct AddSignatory : public Command {
+    struct AddSignatory : public CommandOf<AddSignatory> {
       /**
        * Account to add new signatory
        */
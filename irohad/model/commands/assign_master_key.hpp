@@ -27,7 +27,7 @@ namespace iroha {
     /**
      * Attach signatory for account
      */
-    struct AssignMasterKey : public Command {
+    struct AssignMasterKey : public CommandOf<AssignMasterKey> {
       /**
        * Account to assign master key
        */
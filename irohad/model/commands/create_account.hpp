@@ -26,7 +26,7 @@ namespace iroha {
     /**
      * Command for creation of a new account in the system
      */
-    struct CreateAccount : public Command {
+    struct CreateAccount : public CommandOf<CreateAccount> {
       /**
        * Account's user name
        */
@@ -28,7 +28,7 @@ namespace iroha {
     /**
      * Create new asset in the system
      */
-    struct CreateAsset : public Command {
+    struct CreateAsset : public CommandOf<CreateAsset> {
       /**
        * Asset to create in the system
        */
@@ -26,7 +26,7 @@ namespace iroha {
     /**
      * Create new asset in the system
      */
-    struct CreateDomain : public Command {
+    struct CreateDomain : public CommandOf<CreateDomain> {
       /**
        * Asset to insert to the system
        */
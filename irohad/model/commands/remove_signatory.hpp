@@ -27,7 +27,7 @@ namespace iroha {
     /**
      * Attach signatory for account
      */
-    struct RemoveSignatory : public Command {
+    struct RemoveSignatory : public CommandOf<RemoveSignatory> {
       /**
        * Account to remove from
        */
@@ -27,7 +27,7 @@ namespace iroha {
     /**
      * Set permissions for account
      */
-    struct SetAccountPermissions : public Command {
+    struct SetAccountPermissions : public CommandOf<SetAccountPermissions> {
       /**
        * Identifier of account to set permission
        */
@@ -27,7 +27,7 @@ namespace iroha {
     /**
      * Change quorum for account
      */
-    struct SetQuorum : public Command {
+    struct SetQuorum : public CommandOf<SetQuorum> {
       /**
        * Account in which change the quorum
        */
@@ -28,7 +28,7 @@ namespace iroha {
     /**
      * Transfer asset from one account to another
      */
-    struct TransferAsset : public Command {
+    struct TransferAsset : public CommandOf<TransferAsset> {
       /**
        * Source account
        */
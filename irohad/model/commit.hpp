@@ -22,7 +22,7 @@
 #include "model/block.hpp"
 
 namespace iroha {
-  using Commit = rxcpp::observable<model::Block>;
+  using Commit = rxcpp::observable<std::shared_ptr<const model::Block>>;
 }  // namespace iroha
 
 #endif  // IROHA_COMMIT_HPP
@@ -18,6 +18,11 @@
 #define RAPIDJSON_HAS_STDSTRING 1
 
 #include "model/converters/json_block_factory.hpp"
+#include <rapidjson/memorystream.h>
+#include <rapidjson/reader.h>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
 #include "model/converters/json_common.hpp"
 
 using namespace rapidjson;
@@ -26,6 +31,380 @@ namespace iroha {
   namespace model {
     namespace converters {
 
+      namespace {
+
+        const char *const kBlockFields[] = {"signatures",
+                                            "created_ts",
+                                            "hash",
+                                            "prev_hash",
+                                            "height",
+                                            "txs_number",
+                                            "merkle_root",
+                                            "transactions"};
+        enum BlockField {
+          kBlockSignatures,
+          kBlockCreatedTs,
+          kHash,
+          kPrevHash,
+          kHeight,
+          kTxsNumber,
+          kMerkleRoot,
+          kTransactions
+        };
+        const unsigned kBlockRequired = 1u << kBlockSignatures
+            | 1u << kBlockCreatedTs | 1u << kHash | 1u << kPrevHash
+            | 1u << kHeight | 1u << kTxsNumber;
+
+        const char *const kTransactionFields[] = {"signatures",
+                                                  "created_ts",
+                                                  "creator_account_id",
+                                                  "tx_counter",
+                                                  "commands"};
+        enum TransactionField {
+          kTxSignatures,
+          kTxCreatedTs,
+          kCreatorAccountId,
+          kTxCounter,
+          kCommands
+        };
+        const unsigned kTransactionRequired = (1u << 5) - 1;
+
+        const char *const kSignatureFields[] = {"pubkey", "signature"};
+        enum SignatureField { kPubkey, kSignature };
+        const unsigned kSignatureRequired = (1u << 2) - 1;
+
+        /**
+         * @return index of field with name, -1 if it is unknown
+         */
+        template <size_t N>
+        int lookup(const char *const (&fields)[N],
+                   const char *name,
+                   SizeType length) {
+          auto it = std::find_if(
+              std::begin(fields), std::end(fields), [=](const char *field) {
+                return std::strlen(field) == length
+                    and std::memcmp(field, name, length) == 0;
+              });
+          return it == std::end(fields)
+              ? -1
+              : static_cast<int>(std::distance(std::begin(fields), it));
+        }
+
+        /**
+         * Handler of SAX events of block json. Unknown members are skipped,
+         * members of unexpected type fail parsing. Commands are parsed
+         * again from their range of input by command factory
+         */
+        class BlockReader
+            : public BaseReaderHandler<UTF8<>, BlockReader> {
+         public:
+          BlockReader(const char *input,
+                      const MemoryStream &stream,
+                      JsonCommandFactory &commands)
+              : input_(input), stream_(stream), commands_(commands) {}
+
+          bool done() const {
+            return state_ == State::Done;
+          }
+
+          Block &block() {
+            return block_;
+          }
+
+          bool Default() {
+            return skip_ > 0 or state_ == State::Command or unknownMember();
+          }
+
+          bool Int(int i) {
+            return i >= 0 ? Uint64(static_cast<uint64_t>(i)) : Default();
+          }
+
+          bool Uint(unsigned u) {
+            return Uint64(u);
+          }
+
+          bool Int64(int64_t i) {
+            return i >= 0 ? Uint64(static_cast<uint64_t>(i)) : Default();
+          }
+
+          bool Uint64(uint64_t u) {
+            if (skip_ > 0 or state_ == State::Command) {
+              return true;
+            }
+            if (state_ == State::Block) {
+              switch (field_) {
+                case kBlockCreatedTs:
+                  block_.created_ts = u;
+                  return seen(block_seen_);
+                case kHeight:
+                  block_.height = u;
+                  return seen(block_seen_);
+                case kTxsNumber:
+                  block_.txs_number =
+                      static_cast<decltype(block_.txs_number)>(u);
+                  return seen(block_seen_);
+              }
+            } else if (state_ == State::Transaction) {
+              switch (field_) {
+                case kTxCreatedTs:
+                  transaction_.created_ts = u;
+                  return seen(transaction_seen_);
+                case kTxCounter:
+                  transaction_.tx_counter = u;
+                  return seen(transaction_seen_);
+              }
+            }
+            return unknownMember();
+          }
+
+          bool String(const char *str, SizeType length, bool) {
+            if (skip_ > 0 or state_ == State::Command) {
+              return true;
+            }
+            if (state_ == State::Block) {
+              switch (field_) {
+                case kHash:
+                  hexstringToArray(str, length, block_.hash);
+                  return seen(block_seen_);
+                case kPrevHash:
+                  hexstringToArray(str, length, block_.prev_hash);
+                  return seen(block_seen_);
+                case kMerkleRoot:
+                  hexstringToArray(str, length, block_.merkle_root);
+                  return seen(block_seen_);
+              }
+            } else if (state_ == State::Transaction) {
+              if (field_ == kCreatorAccountId) {
+                transaction_.creator_account_id.assign(str, length);
+                return seen(transaction_seen_);
+              }
+            } else if (state_ == State::Signature) {
+              switch (field_) {
+                case kPubkey:
+                  hexstringToArray(str, length, signature_.pubkey);
+                  return seen(signature_seen_);
+                case kSignature:
+                  hexstringToArray(str, length, signature_.signature);
+                  return seen(signature_seen_);
+              }
+            }
+            return unknownMember();
+          }
+
+          bool Key(const char *str, SizeType length, bool) {
+            switch (skip_ > 0 ? State::Done : state_) {
+              case State::Block:
+                field_ = lookup(kBlockFields, str, length);
+                break;
+              case State::Transaction:
+                field_ = lookup(kTransactionFields, str, length);
+                break;
+              case State::Signature:
+                field_ = lookup(kSignatureFields, str, length);
+                break;
+              default:
+                break;
+            }
+            return true;
+          }
+
+          bool StartObject() {
+            switch (skip_ > 0 ? State::Done : state_) {
+              case State::Start:
+                state_ = State::Block;
+                return true;
+              case State::BlockSignatures:
+              case State::TransactionSignatures:
+                signatures_state_ = state_;
+                signature_ = Signature{};
+                signature_seen_ = 0;
+                state_ = State::Signature;
+                return true;
+              case State::Transactions:
+                transaction_ = Transaction{};
+                transaction_seen_ = 0;
+                state_ = State::Transaction;
+                return true;
+              case State::Commands:
+                // reader has just taken the opening brace
+                command_begin_ = stream_.Tell() - 1;
+                command_depth_ = 1;
+                state_ = State::Command;
+                return true;
+              case State::Command:
+                ++command_depth_;
+                return true;
+              default:
+                return startNested();
+            }
+          }
+
+          bool EndObject(SizeType) {
+            if (skip_ > 0) {
+              --skip_;
+              return true;
+            }
+            switch (state_) {
+              case State::Block:
+                state_ = State::Done;
+                return (block_seen_ & kBlockRequired) == kBlockRequired;
+              case State::Transaction:
+                if ((transaction_seen_ & kTransactionRequired)
+                    != kTransactionRequired) {
+                  return false;
+                }
+                block_.transactions.push_back(std::move(transaction_));
+                state_ = State::Transactions;
+                return true;
+              case State::Signature:
+                if ((signature_seen_ & kSignatureRequired)
+                    != kSignatureRequired) {
+                  return false;
+                }
+                (signatures_state_ == State::BlockSignatures
+                     ? block_.sigs
+                     : transaction_.signatures)
+                    .push_back(signature_);
+                state_ = signatures_state_;
+                return true;
+              case State::Command:
+                return --command_depth_ > 0 or endCommand();
+              default:
+                return false;
+            }
+          }
+
+          bool StartArray() {
+            switch (skip_ > 0 ? State::Done : state_) {
+              case State::Block:
+                if (field_ == kBlockSignatures) {
+                  state_ = State::BlockSignatures;
+                  return seen(block_seen_);
+                }
+                if (field_ == kTransactions) {
+                  state_ = State::Transactions;
+                  return seen(block_seen_);
+                }
+                return startNested();
+              case State::Transaction:
+                if (field_ == kTxSignatures) {
+                  state_ = State::TransactionSignatures;
+                  return seen(transaction_seen_);
+                }
+                if (field_ == kCommands) {
+                  state_ = State::Commands;
+                  return seen(transaction_seen_);
+                }
+                return startNested();
+              case State::Command:
+                ++command_depth_;
+                return true;
+              default:
+                return startNested();
+            }
+          }
+
+          bool EndArray(SizeType) {
+            if (skip_ > 0) {
+              --skip_;
+              return true;
+            }
+            switch (state_) {
+              case State::BlockSignatures:
+              case State::Transactions:
+                state_ = State::Block;
+                return true;
+              case State::TransactionSignatures:
+              case State::Commands:
+                state_ = State::Transaction;
+                return true;
+              case State::Command:
+                --command_depth_;
+                return true;
+              default:
+                return false;
+            }
+          }
+
+         private:
+          enum class State {
+            Start,
+            Block,
+            BlockSignatures,
+            Transactions,
+            Transaction,
+            TransactionSignatures,
+            Commands,
+            Command,
+            Signature,
+            Done
+          };
+
+          bool seen(unsigned &fields) {
+            fields |= 1u << field_;
+            return true;
+          }
+
+          /**
+           * Values of unknown members are skipped, known members of
+           * unexpected type are errors
+           */
+          bool unknownMember() const {
+            return (state_ == State::Block or state_ == State::Transaction
+                    or state_ == State::Signature)
+                and field_ < 0;
+          }
+
+          bool startNested() {
+            if (skip_ > 0 or unknownMember()) {
+              ++skip_;
+              return true;
+            }
+            return false;
+          }
+
+          bool endCommand() {
+            Document document;
+            document.Parse(input_ + command_begin_,
+                           stream_.Tell() - command_begin_);
+            if (document.HasParseError() or not document.IsObject()
+                or not document.HasMember("command_type")
+                or not document["command_type"].IsString()) {
+              return false;
+            }
+            auto command = commands_.deserializeAbstractCommand(document);
+            if (not command) {
+              return false;
+            }
+            transaction_.commands.push_back(std::move(command));
+            state_ = State::Commands;
+            return true;
+          }
+
+          const char *input_;
+          const MemoryStream &stream_;
+          JsonCommandFactory &commands_;
+
+          State state_ = State::Start;
+          // state to return to once signature is read
+          State signatures_state_ = State::Start;
+          // field of the current member of block, transaction or signature
+          int field_ = -1;
+          // depth of skipped value of unknown member
+          size_t skip_ = 0;
+          size_t command_begin_ = 0;
+          size_t command_depth_ = 0;
+
+          Block block_{};
+          Transaction transaction_{};
+          Signature signature_{};
+          unsigned block_seen_ = 0;
+          unsigned transaction_seen_ = 0;
+          unsigned signature_seen_ = 0;
+        };
+
+      }  // namespace
+
       JsonBlockFactory::JsonBlockFactory() {
         log_ = logger::log("JsonBlockFactory");
       }
@@ -115,6 +494,19 @@ namespace iroha {
         return block;
       }
 
+      nonstd::optional<Block> JsonBlockFactory::deserialize(
+          const uint8_t *data, size_t size) {
+        auto input = reinterpret_cast<const char *>(data);
+        MemoryStream stream(input, size);
+        BlockReader handler(input, stream, command_factory_);
+        Reader reader;
+        if (reader.Parse(stream, handler).IsError() or not handler.done()) {
+          log_->error("Block parsing failure");
+          return nonstd::nullopt;
+        }
+        return std::move(handler.block());
+      }
+
     }  // namespace converters
   }    // namespace model
 }  // namespace iroha
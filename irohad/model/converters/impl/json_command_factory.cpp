@@ -18,6 +18,8 @@
 #define RAPIDJSON_HAS_STDSTRING 1
 
 #include "model/converters/json_command_factory.hpp"
+#include <array>
+#include <cstring>
 #include "model/commands/add_asset_quantity.hpp"
 #include "model/commands/add_peer.hpp"
 #include "model/commands/add_signatory.hpp"
@@ -29,6 +31,7 @@
 #include "model/commands/set_permissions.hpp"
 #include "model/commands/set_quorum.hpp"
 #include "model/commands/transfer_asset.hpp"
+#include "model/command_pool.hpp"
 
 using namespace rapidjson;
 
@@ -36,51 +39,6 @@ namespace iroha {
   namespace model {
     namespace converters {
 
-      JsonCommandFactory::JsonCommandFactory() {
-        serializers_[typeid(AddAssetQuantity)] =
-            &JsonCommandFactory::serializeAddAssetQuantity;
-        serializers_[typeid(AddPeer)] = &JsonCommandFactory::serializeAddPeer;
-        serializers_[typeid(AddSignatory)] =
-            &JsonCommandFactory::serializeAddSignatory;
-        serializers_[typeid(AssignMasterKey)] =
-            &JsonCommandFactory::serializeAssignMasterKey;
-        serializers_[typeid(CreateAccount)] =
-            &JsonCommandFactory::serializeCreateAccount;
-        serializers_[typeid(CreateAsset)] =
-            &JsonCommandFactory::serializeCreateAsset;
-        serializers_[typeid(CreateDomain)] =
-            &JsonCommandFactory::serializeCreateDomain;
-        serializers_[typeid(RemoveSignatory)] =
-            &JsonCommandFactory::serializeRemoveSignatory;
-        serializers_[typeid(SetAccountPermissions)] =
-            &JsonCommandFactory::serializeSetAccountPermissions;
-        serializers_[typeid(SetQuorum)] =
-            &JsonCommandFactory::serializeSetQuorum;
-        serializers_[typeid(TransferAsset)] =
-            &JsonCommandFactory::serializeTransferAsset;
-
-        deserializers_["AddAssetQuantity"] =
-            &JsonCommandFactory::deserializeAddAssetQuantity;
-        deserializers_["AddPeer"] = &JsonCommandFactory::deserializeAddPeer;
-        deserializers_["AddSignatory"] =
-            &JsonCommandFactory::deserializeAddSignatory;
-        deserializers_["AssignMasterKey"] =
-            &JsonCommandFactory::deserializeAssignMasterKey;
-        deserializers_["CreateAccount"] =
-            &JsonCommandFactory::deserializeCreateAccount;
-        deserializers_["CreateAsset"] =
-            &JsonCommandFactory::deserializeCreateAsset;
-        deserializers_["CreateDomain"] =
-            &JsonCommandFactory::deserializeCreateDomain;
-        deserializers_["RemoveSignatory"] =
-            &JsonCommandFactory::deserializeRemoveSignatory;
-        deserializers_["SetAccountPermissions"] =
-            &JsonCommandFactory::deserializeSetAccountPermissions;
-        deserializers_["SetQuorum"] = &JsonCommandFactory::deserializeSetQuorum;
-        deserializers_["TransferAsset"] =
-            &JsonCommandFactory::deserializeTransferAsset;
-      }
-
       // AddAssetQuantity
       Document JsonCommandFactory::serializeAddAssetQuantity(
           std::shared_ptr<Command> command) {
@@ -110,7 +68,7 @@ namespace iroha {
 
       std::shared_ptr<Command> JsonCommandFactory::deserializeAddAssetQuantity(
           const Document &command) {
-        auto add_asset_quantity = std::make_shared<AddAssetQuantity>();
+        auto add_asset_quantity = makePooled<AddAssetQuantity>();
 
         // account_id
         add_asset_quantity->account_id = command["account_id"].GetString();
@@ -145,7 +103,7 @@ namespace iroha {
 
       std::shared_ptr<Command> JsonCommandFactory::deserializeAddPeer(
           const Document &command) {
-        auto add_peer = std::make_shared<AddPeer>();
+        auto add_peer = makePooled<AddPeer>();
 
         // peer key
         hexstringToArray(command["peer_key"].GetString(), add_peer->peer_key);
@@ -174,7 +132,7 @@ namespace iroha {
 
       std::shared_ptr<Command> JsonCommandFactory::deserializeAddSignatory(
           const Document &command) {
-        auto add_signatory = std::make_shared<AddSignatory>();
+        auto add_signatory = makePooled<AddSignatory>();
 
         // account_id
         add_signatory->account_id = command["account_id"].GetString();
@@ -205,7 +163,7 @@ namespace iroha {
 
       std::shared_ptr<Command> JsonCommandFactory::deserializeAssignMasterKey(
           const Document &command) {
-        auto assign_master_key = std::make_shared<AssignMasterKey>();
+        auto assign_master_key = makePooled<AssignMasterKey>();
 
         // account_id
         assign_master_key->account_id = command["account_id"].GetString();
@@ -238,7 +196,7 @@ namespace iroha {
 
       std::shared_ptr<Command> JsonCommandFactory::deserializeCreateAccount(
           const Document &command) {
-        auto create_account = std::make_shared<CreateAccount>();
+        auto create_account = makePooled<CreateAccount>();
 
         // account_name
         create_account->account_name = command["account_name"].GetString();
@@ -271,7 +229,7 @@ namespace iroha {
 
       std::shared_ptr<Command> JsonCommandFactory::deserializeCreateAsset(
           const Document &command) {
-        auto create_asset = std::make_shared<CreateAsset>();
+        auto create_asset = makePooled<CreateAsset>();
 
         // asset_name
         create_asset->asset_name = command["asset_name"].GetString();
@@ -303,7 +261,7 @@ namespace iroha {
 
       std::shared_ptr<Command> JsonCommandFactory::deserializeCreateDomain(
           const Document &command) {
-        auto create_domain = std::make_shared<CreateDomain>();
+        auto create_domain = makePooled<CreateDomain>();
 
         // domain_name
         create_domain->domain_name = command["domain_name"].GetString();
@@ -331,7 +289,7 @@ namespace iroha {
 
       std::shared_ptr<Command> JsonCommandFactory::deserializeRemoveSignatory(
           const Document &command) {
-        auto remove_signatory = std::make_shared<RemoveSignatory>();
+        auto remove_signatory = makePooled<RemoveSignatory>();
 
         // account_id
         remove_signatory->account_id = command["account_id"].GetString();
@@ -403,7 +361,7 @@ namespace iroha {
       JsonCommandFactory::deserializeSetAccountPermissions(
           const Document &command) {
         auto set_account_permissions =
-            std::make_shared<SetAccountPermissions>();
+            makePooled<SetAccountPermissions>();
 
         // account_id
         set_account_permissions->account_id = command["account_id"].GetString();
@@ -452,7 +410,7 @@ namespace iroha {
 
       std::shared_ptr<Command> JsonCommandFactory::deserializeSetQuorum(
           const Document &command) {
-        auto set_quorum = std::make_shared<SetQuorum>();
+        auto set_quorum = makePooled<SetQuorum>();
 
         // account_id
         set_quorum->account_id = command["account_id"].GetString();
@@ -493,7 +451,7 @@ namespace iroha {
 
       std::shared_ptr<Command> JsonCommandFactory::deserializeTransferAsset(
           const Document &command) {
-        auto transfer_asset = std::make_shared<TransferAsset>();
+        auto transfer_asset = makePooled<TransferAsset>();
 
         // src_account_id
         transfer_asset->src_account_id = command["src_account_id"].GetString();
@@ -513,12 +471,140 @@ namespace iroha {
         return transfer_asset;
       }
 
+      namespace {
+        using F = JsonCommandFactory;
+
+        template <Document (F::*serialize_)(std::shared_ptr<Command>),
+                  std::shared_ptr<Command> (F::*deserialize_)(
+                      const Document &)>
+        struct JsonBinding {
+          static constexpr auto serialize = serialize_;
+          static constexpr auto deserialize = deserialize_;
+        };
+
+        /**
+         * Binds listed command to its converters and command_type
+         */
+        template <typename Model>
+        struct JsonCommand;
+
+        template <>
+        struct JsonCommand<AddAssetQuantity>
+            : JsonBinding<&F::serializeAddAssetQuantity, &F::deserializeAddAssetQuantity> {
+          static const char *name() {
+            return "AddAssetQuantity";
+          }
+        };
+
+        template <>
+        struct JsonCommand<AddPeer>
+            : JsonBinding<&F::serializeAddPeer, &F::deserializeAddPeer> {
+          static const char *name() {
+            return "AddPeer";
+          }
+        };
+
+        template <>
+        struct JsonCommand<AddSignatory>
+            : JsonBinding<&F::serializeAddSignatory, &F::deserializeAddSignatory> {
+          static const char *name() {
+            return "AddSignatory";
+          }
+        };
+
+        template <>
+        struct JsonCommand<AssignMasterKey>
+            : JsonBinding<&F::serializeAssignMasterKey, &F::deserializeAssignMasterKey> {
+          static const char *name() {
+            return "AssignMasterKey";
+          }
+        };
+
+        template <>
+        struct JsonCommand<CreateAccount>
+            : JsonBinding<&F::serializeCreateAccount, &F::deserializeCreateAccount> {
+          static const char *name() {
+            return "CreateAccount";
+          }
+        };
+
+        template <>
+        struct JsonCommand<CreateAsset>
+            : JsonBinding<&F::serializeCreateAsset, &F::deserializeCreateAsset> {
+          static const char *name() {
+            return "CreateAsset";
+          }
+        };
+
+        template <>
+        struct JsonCommand<CreateDomain>
+            : JsonBinding<&F::serializeCreateDomain, &F::deserializeCreateDomain> {
+          static const char *name() {
+            return "CreateDomain";
+          }
+        };
+
+        template <>
+        struct JsonCommand<RemoveSignatory>
+            : JsonBinding<&F::serializeRemoveSignatory, &F::deserializeRemoveSignatory> {
+          static const char *name() {
+            return "RemoveSignatory";
+          }
+        };
+
+        template <>
+        struct JsonCommand<SetAccountPermissions>
+            : JsonBinding<&F::serializeSetAccountPermissions, &F::deserializeSetAccountPermissions> {
+          static const char *name() {
+            return "SetAccountPermissions";
+          }
+        };
+
+        template <>
+        struct JsonCommand<SetQuorum>
+            : JsonBinding<&F::serializeSetQuorum, &F::deserializeSetQuorum> {
+          static const char *name() {
+            return "SetQuorum";
+          }
+        };
+
+        template <>
+        struct JsonCommand<TransferAsset>
+            : JsonBinding<&F::serializeTransferAsset, &F::deserializeTransferAsset> {
+          static const char *name() {
+            return "TransferAsset";
+          }
+        };
+
+        using Serializer = Document (F::*)(std::shared_ptr<Command>);
+        using Deserializer =
+            std::shared_ptr<Command> (F::*)(const Document &);
+
+        struct Entry {
+          const char *name;
+          Serializer serialize;
+          Deserializer deserialize;
+        };
+
+        /**
+         * Converters indexed by kind of command
+         */
+        template <typename... Ts>
+        const std::array<Entry, sizeof...(Ts)> &entries(TypeList<Ts...>) {
+          static const std::array<Entry, sizeof...(Ts)> table{
+              {{JsonCommand<Ts>::name(),
+                JsonCommand<Ts>::serialize,
+                JsonCommand<Ts>::deserialize}...}};
+          return table;
+        }
+      }  // namespace
+
       // Abstract
       Document JsonCommandFactory::serializeAbstractCommand(
           std::shared_ptr<Command> command) {
-        auto it = serializers_.find(typeid(*command));
-        if (it != serializers_.end()) {
-          return (this->*it->second)(command);
+        auto kind = command->kind();
+        if (kind < kCommandKinds) {
+          return (this->*entries(Commands{})[kind].serialize)(command);
         }
         return Document();
       }
@@ -527,9 +613,11 @@ namespace iroha {
           const Document &command) {
         auto command_type = command["command_type"].GetString();
 
-        auto it = deserializers_.find(command_type);
-        if (it != deserializers_.end()) {
-          return (this->*it->second)(command);
+        // a handful of short names, scanning them is cheaper than hashing
+        for (const auto &entry : entries(Commands{})) {
+          if (std::strcmp(entry.name, command_type) == 0) {
+            return (this->*entry.deserialize)(command);
+          }
         }
         return nullptr;
       }
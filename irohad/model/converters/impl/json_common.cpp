@@ -20,6 +20,7 @@
 #include "model/converters/json_common.hpp"
 #include <rapidjson/prettywriter.h>
 #include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
 #include <algorithm>
 #include "common/types.hpp"
 
@@ -29,6 +30,28 @@ namespace iroha {
   namespace model {
     namespace converters {
 
+      namespace {
+        /**
+         * Output stream of rapidjson writers over byte buffer
+         */
+        class BufferStream {
+         public:
+          using Ch = char;
+
+          explicit BufferStream(std::vector<uint8_t>& buffer)
+              : buffer_(buffer) {}
+
+          void Put(Ch c) {
+            buffer_.push_back(static_cast<uint8_t>(c));
+          }
+
+          void Flush() {}
+
+         private:
+          std::vector<uint8_t>& buffer_;
+        };
+      }  // namespace
+
       bool verifyRequiredMembers(
           const Document& document,
           const std::initializer_list<std::string>& members) {
@@ -77,20 +100,45 @@ namespace iroha {
         return document;
       }
 
-      std::string jsonToString(const Document& document) {
+      std::string jsonToString(const Document& document, bool pretty) {
         StringBuffer sb;
-        PrettyWriter<StringBuffer> writer(sb);
-        document.Accept(writer);
-        return sb.GetString();
+        if (pretty) {
+          PrettyWriter<StringBuffer> writer(sb);
+          document.Accept(writer);
+        } else {
+          Writer<StringBuffer> writer(sb);
+          document.Accept(writer);
+        }
+        return std::string(sb.GetString(), sb.GetSize());
       }
 
       nonstd::optional<Document> vectorToJson(
           const std::vector<uint8_t>& vector) {
-        return stringToJson(bytesToString(vector));
+        return bytesToJson(vector.data(), vector.size());
+      }
+
+      nonstd::optional<Document> bytesToJson(const uint8_t* data,
+                                             size_t size) {
+        Document document;
+        document.Parse(reinterpret_cast<const char*>(data), size);
+        if (document.HasParseError()) {
+          return nonstd::nullopt;
+        }
+        return document;
       }
 
       std::vector<uint8_t> jsonToVector(const Document& document) {
-        return stringToBytes(jsonToString(document));
+        std::vector<uint8_t> buffer;
+        jsonToVector(document, buffer);
+        return buffer;
+      }
+
+      void jsonToVector(const Document& document,
+                        std::vector<uint8_t>& buffer) {
+        buffer.clear();
+        BufferStream stream(buffer);
+        Writer<BufferStream> writer(stream);
+        document.Accept(writer);
       }
 
     }  // namespace converters
@@ -16,8 +16,10 @@
  */
 
 #include "model/converters/pb_block_factory.hpp"
+#include <utility>
 #include <model/model_hash_provider_impl.hpp>
 #include "model/converters/pb_transaction_factory.hpp"
+#include "model/merkle_tree.hpp"
 
 namespace iroha {
   namespace model {
@@ -25,11 +27,21 @@ namespace iroha {
 
       protocol::Block PbBlockFactory::serialize(model::Block const&block) {
         protocol::Block pb_block;
+        serialize(block, pb_block);
+        return pb_block;
+      }
+
+      void PbBlockFactory::serialize(model::Block const &block,
+                                     protocol::Block &pb_block) {
+        // cleared messages keep their strings and repeated elements, which
+        // are reused by fields set below
+        pb_block.Clear();
 
         // -----|Header|-----
         auto header = pb_block.mutable_header();
         header->set_created_time(block.created_ts);
-        for (auto sig : block.sigs) {
+        header->mutable_signatures()->Reserve(block.sigs.size());
+        for (const auto &sig : block.sigs) {
           auto pb_sig = header->add_signatures();
           pb_sig->set_pubkey(sig.pubkey.data(), sig.pubkey.size());
           pb_sig->set_signature(sig.signature.data(), sig.signature.size());
@@ -47,12 +59,13 @@ namespace iroha {
         // -----|Body|-----
         auto body = pb_block.mutable_body();
         PbTransactionFactory tx_factory;
-        for (auto tx : block.transactions) {
+        body->mutable_transactions()->Reserve(block.transactions.size());
+        for (const auto &tx : block.transactions) {
           auto pb_tx = body->add_transactions();
-          pb_tx->CopyFrom(tx_factory.serialize(tx));
+          tx_factory.serialize(tx, *pb_tx);
+          // traces are local to the run, stored blocks are the same on peers
+          pb_tx->clear_trace_parent();
         }
-
-        return pb_block;
       }
 
       model::Block PbBlockFactory::deserialize(protocol::Block const&pb_block) {
@@ -60,8 +73,9 @@ namespace iroha {
 
         // -----|Header|-----
         block.created_ts = pb_block.header().created_time();
-        auto header = pb_block.header();
-        for (auto pb_sig : header.signatures()) {
+        const auto &header = pb_block.header();
+        block.sigs.reserve(header.signatures_size());
+        for (const auto &pb_sig : header.signatures()) {
           Signature sig{};
           std::copy(pb_sig.pubkey().begin(), pb_sig.pubkey().end(),
                     sig.pubkey.begin());
@@ -71,7 +85,7 @@ namespace iroha {
         }
 
         // -----|Meta|-----
-        auto meta = pb_block.meta();
+        const auto &meta = pb_block.meta();
         // potential dangerous cast
         block.txs_number = (uint16_t)meta.tx_number();
         block.height = meta.height();
@@ -81,11 +95,19 @@ namespace iroha {
                   block.prev_hash.begin());
 
         // -----|Body|-----
-        auto body = pb_block.body();
+        const auto &body = pb_block.body();
         PbTransactionFactory tx_factory;
-        for (auto pb_tx : body.transactions()) {
-          block.transactions.push_back(*tx_factory.deserialize(pb_tx));
+        MerkleTree tree;
+        block.transactions.reserve(body.transactions_size());
+        for (const auto &pb_tx : body.transactions()) {
+          // transaction is owned only by the pointer, so it is moved out
+          block.transactions.push_back(
+              std::move(*tx_factory.deserialize(pb_tx)));
+          tree.append(block.transactions.back().tx_hash);
         }
+        // root is recomputed from transactions, so hash of the block
+        // can not vouch for transactions which are not in it
+        block.merkle_root = tree.root();
 
         iroha::model::HashProviderImpl hash_provider;
         block.hash = hash_provider.get_hash(block);
@@ -17,7 +17,9 @@
 
 #include "model/converters/pb_command_factory.hpp"
 
+#include <array>
 #include <string>
+#include "model/command_pool.hpp"
 
 namespace iroha {
   namespace model {
@@ -270,191 +272,223 @@ namespace iroha {
         return transfer_asset;
       }
 
-      protocol::Command
-      PbCommandFactory::serializeAbstractCommand(const model::Command &command) {
-        PbCommandFactory commandFactory;
-        auto cmd = protocol::Command();
-
-        // -----|AddAssetQuantity|-----
-        if (instanceof<model::AddAssetQuantity>(command)) {
-          auto serialized = commandFactory
-              .serializeAddAssetQuantity(
-                  static_cast<const model::AddAssetQuantity &>(command));
-          cmd.set_allocated_add_asset_quantity(new protocol::AddAssetQuantity(
-              serialized));
-        }
-
-        // -----|AddPeer|-----
-        if (instanceof<model::AddPeer>(command)) {
-          auto serialized = commandFactory
-              .serializeAddPeer(
-                  static_cast<const model::AddPeer &>(command));
-          cmd.set_allocated_add_peer(new protocol::AddPeer(serialized));
-        }
-
-        // -----|AddSignatory|-----
-        if (instanceof<model::AddSignatory>(command)) {
-          auto serialized = commandFactory
-              .serializeAddSignatory(
-                  static_cast<const model::AddSignatory &>(command));
-          cmd.set_allocated_add_signatory(new protocol::AddSignatory(serialized));
-        }
-
-        // -----|AssignMasterKey|-----
-        if (instanceof<model::AssignMasterKey>(command)) {
-          auto serialized = commandFactory
-              .serializeAssignMasterKey(
-                  static_cast<const model::AssignMasterKey &>(command));
-          cmd.set_allocated_account_assign_mk(new protocol::AssignMasterKey(
-              serialized));
+      namespace {
+        using F = PbCommandFactory;
+        using C = protocol::Command;
+
+        /**
+         * Converts command of model type to and from its field of proto
+         * command
+         */
+        template <typename Model,
+                  typename Pb,
+                  Pb (F::*serialize_)(const Model &),
+                  Model (F::*deserialize_)(const Pb &),
+                  Pb *(C::*mutable_field)(),
+                  const Pb &(C::*field)() const,
+                  C::CommandCase command_case>
+        struct PbBinding {
+          static constexpr C::CommandCase kCase = command_case;
+
+          static void serialize(F &factory,
+                                const model::Command &command,
+                                C &pb_command) {
+            auto serialized =
+                (factory.*serialize_)(static_cast<const Model &>(command));
+            (pb_command.*mutable_field)()->Swap(&serialized);
+          }
+
+          static std::shared_ptr<model::Command> deserialize(
+              F &factory, const C &pb_command) {
+            return model::makePooled<Model>(
+                (factory.*deserialize_)((pb_command.*field)()));
+          }
+        };
+
+        template <typename Model>
+        struct PbCommand;
+
+        template <>
+        struct PbCommand<model::AddAssetQuantity>
+            : PbBinding<model::AddAssetQuantity,
+                        protocol::AddAssetQuantity,
+                        &F::serializeAddAssetQuantity,
+                        &F::deserializeAddAssetQuantity,
+                        &C::mutable_add_asset_quantity,
+                        &C::add_asset_quantity,
+                        C::kAddAssetQuantity> {};
+
+        template <>
+        struct PbCommand<model::AddPeer>
+            : PbBinding<model::AddPeer,
+                        protocol::AddPeer,
+                        &F::serializeAddPeer,
+                        &F::deserializeAddPeer,
+                        &C::mutable_add_peer,
+                        &C::add_peer,
+                        C::kAddPeer> {};
+
+        template <>
+        struct PbCommand<model::AddSignatory>
+            : PbBinding<model::AddSignatory,
+                        protocol::AddSignatory,
+                        &F::serializeAddSignatory,
+                        &F::deserializeAddSignatory,
+                        &C::mutable_add_signatory,
+                        &C::add_signatory,
+                        C::kAddSignatory> {};
+
+        template <>
+        struct PbCommand<model::AssignMasterKey>
+            : PbBinding<model::AssignMasterKey,
+                        protocol::AssignMasterKey,
+                        &F::serializeAssignMasterKey,
+                        &F::deserializeAssignMasterKey,
+                        &C::mutable_account_assign_mk,
+                        &C::account_assign_mk,
+                        C::kAccountAssignMk> {};
+
+        template <>
+        struct PbCommand<model::CreateAccount>
+            : PbBinding<model::CreateAccount,
+                        protocol::CreateAccount,
+                        &F::serializeCreateAccount,
+                        &F::deserializeCreateAccount,
+                        &C::mutable_create_account,
+                        &C::create_account,
+                        C::kCreateAccount> {};
+
+        template <>
+        struct PbCommand<model::CreateAsset>
+            : PbBinding<model::CreateAsset,
+                        protocol::CreateAsset,
+                        &F::serializeCreateAsset,
+                        &F::deserializeCreateAsset,
+                        &C::mutable_create_asset,
+                        &C::create_asset,
+                        C::kCreateAsset> {};
+
+        template <>
+        struct PbCommand<model::CreateDomain>
+            : PbBinding<model::CreateDomain,
+                        protocol::CreateDomain,
+                        &F::serializeCreateDomain,
+                        &F::deserializeCreateDomain,
+                        &C::mutable_create_domain,
+                        &C::create_domain,
+                        C::kCreateDomain> {};
+
+        template <>
+        struct PbCommand<model::RemoveSignatory>
+            : PbBinding<model::RemoveSignatory,
+                        protocol::RemoveSignatory,
+                        &F::serializeRemoveSignatory,
+                        &F::deserializeRemoveSignatory,
+                        &C::mutable_remove_sign,
+                        &C::remove_sign,
+                        C::kRemoveSign> {};
+
+        template <>
+        struct PbCommand<model::SetAccountPermissions>
+            : PbBinding<model::SetAccountPermissions,
+                        protocol::SetAccountPermissions,
+                        &F::serializeSetAccountPermissions,
+                        &F::deserializeSetAccountPermissions,
+                        &C::mutable_set_permission,
+                        &C::set_permission,
+                        C::kSetPermission> {};
+
+        template <>
+        struct PbCommand<model::SetQuorum>
+            : PbBinding<model::SetQuorum,
+                        protocol::SetAccountQuorum,
+                        &F::serializeSetQuorum,
+                        &F::deserializeSetQuorum,
+                        &C::mutable_set_quorum,
+                        &C::set_quorum,
+                        C::kSetQuorum> {};
+
+        template <>
+        struct PbCommand<model::TransferAsset>
+            : PbBinding<model::TransferAsset,
+                        protocol::TransferAsset,
+                        &F::serializeTransferAsset,
+                        &F::deserializeTransferAsset,
+                        &C::mutable_transfer_asset,
+                        &C::transfer_asset,
+                        C::kTransferAsset> {};
+
+        using CommandSerializer = void (*)(F &,
+                                           const model::Command &,
+                                           C &);
+        using CommandDeserializer =
+            std::shared_ptr<model::Command> (*)(F &, const C &);
+
+        constexpr size_t maxOf(size_t value) {
+          return value;
         }
 
-        // -----|AssignMasterKey|-----
-        if (instanceof<model::CreateAsset>(command)) {
-          auto serialized = commandFactory
-              .serializeCreateAsset(
-                  static_cast<const model::CreateAsset &>(command));
-          cmd.set_allocated_create_asset(new protocol::CreateAsset(serialized));
+        template <typename... Rest>
+        constexpr size_t maxOf(size_t first, size_t second, Rest... rest) {
+          return maxOf(first > second ? first : second, rest...);
         }
 
-        // -----|CreateAccount|-----
-        if (instanceof<model::CreateAccount>(command)) {
-          auto serialized = commandFactory
-              .serializeCreateAccount(
-                  static_cast<const model::CreateAccount &>(command));
-          cmd.set_allocated_create_account(new protocol::CreateAccount(
-              serialized));
+        /**
+         * Serializers indexed by kind of command
+         */
+        template <typename... Ts>
+        const std::array<CommandSerializer, sizeof...(Ts)> &serializers(
+            TypeList<Ts...>) {
+          static constexpr std::array<CommandSerializer, sizeof...(Ts)> table{
+              {&PbCommand<Ts>::serialize...}};
+          return table;
         }
 
-        // -----|CreateDomain|-----
-        if (instanceof<model::CreateDomain>(command)) {
-          auto serialized = commandFactory
-              .serializeCreateDomain(
-                  static_cast<const model::CreateDomain &>(command));
-          cmd.set_allocated_create_domain(new protocol::CreateDomain(serialized));
+        template <typename... Ts>
+        constexpr size_t casesOf(TypeList<Ts...>) {
+          return maxOf(0, PbCommand<Ts>::kCase...) + 1;
         }
 
-        // -----|RemoveSignatory|-----
-        if (instanceof<model::RemoveSignatory>(command)) {
-          auto serialized = commandFactory
-              .serializeRemoveSignatory(
-                  static_cast<const model::RemoveSignatory &>(command));
-          cmd.set_allocated_remove_sign(new protocol::RemoveSignatory(serialized));
+        constexpr size_t kCases = casesOf(Commands{});
+
+        /**
+         * Deserializers indexed by case of proto command, null for cases
+         * without command
+         */
+        template <typename... Ts>
+        const std::array<CommandDeserializer, kCases> &deserializers(
+            TypeList<Ts...>) {
+          static const std::array<CommandDeserializer, kCases> table = [] {
+            std::array<CommandDeserializer, kCases> result{};
+            using expand = int[];
+            (void)expand{0,
+                         (result[PbCommand<Ts>::kCase] =
+                              &PbCommand<Ts>::deserialize,
+                          0)...};
+            return result;
+          }();
+          return table;
         }
+      }  // namespace
 
-        // -----|SetAccountPermissions|-----
-        if (instanceof<model::SetAccountPermissions>(command)) {
-          auto serialized = commandFactory
-              .serializeSetAccountPermissions(
-                  static_cast<const model::SetAccountPermissions &>(command));
-          cmd.set_allocated_set_permission(new protocol::SetAccountPermissions(
-              serialized));
-        }
-
-        // -----|SetAccountQuorum|-----
-        if (instanceof<model::SetQuorum>(command)) {
-          auto serialized = commandFactory
-              .serializeSetQuorum(
-                  static_cast<const model::SetQuorum &>(command));
-          cmd.set_allocated_set_quorum(new protocol::SetAccountQuorum(serialized));
-        }
-
-        // -----|TransferAsset|-----
-        if (instanceof<model::TransferAsset>(command)) {
-          auto serialized = commandFactory
-              .serializeTransferAsset(
-                  static_cast<const model::TransferAsset &>(command));
-          cmd.set_allocated_transfer_asset(new protocol::TransferAsset(
-              serialized));
+      protocol::Command
+      PbCommandFactory::serializeAbstractCommand(const model::Command &command) {
+        auto cmd = protocol::Command();
+        auto kind = command.kind();
+        if (kind < kCommandKinds) {
+          serializers(Commands{})[kind](*this, command, cmd);
         }
-
         return cmd;
       }
 
       std::shared_ptr<model::Command>
       PbCommandFactory::deserializeAbstractCommand(const protocol::Command &command) {
-        PbCommandFactory commandFactory;
-        std::shared_ptr<model::Command> val;
-
-        // -----|AddAssetQuantity|-----
-        if (command.has_add_asset_quantity()) {
-          auto pb_command = command.add_asset_quantity();
-          auto cmd = commandFactory.deserializeAddAssetQuantity(pb_command);
-          val = std::make_shared<model::AddAssetQuantity>(cmd);
-        }
-
-        // -----|AddPeer|-----
-        if (command.has_add_peer()) {
-          auto pb_command = command.add_peer();
-          auto cmd = commandFactory.deserializeAddPeer(pb_command);
-          val = std::make_shared<model::AddPeer>(cmd);
+        auto command_case = static_cast<size_t>(command.command_case());
+        if (command_case >= kCases) {
+          return nullptr;
         }
-
-        // -----|AddSignatory|-----
-        if (command.has_add_signatory()) {
-          auto pb_command = command.add_signatory();
-          auto cmd = commandFactory.deserializeAddSignatory(pb_command);
-          val = std::make_shared<model::AddSignatory>(cmd);
-        }
-
-        // -----|AssignMasterKey|-----
-        if (command.has_account_assign_mk()) {
-          auto pb_command = command.account_assign_mk();
-          auto cmd = commandFactory.deserializeAssignMasterKey(pb_command);
-          val = std::make_shared<model::AssignMasterKey>(cmd);
-        }
-
-        // -----|CreateAsset|-----
-        if (command.has_create_asset()) {
-          auto pb_command = command.create_asset();
-          auto cmd = commandFactory.deserializeCreateAsset(pb_command);
-          val = std::make_shared<model::CreateAsset>(cmd);
-        }
-
-        // -----|CreateAccount|-----
-        if (command.has_create_account()) {
-          auto pb_command = command.create_account();
-          auto cmd = commandFactory.deserializeCreateAccount(pb_command);
-          val = std::make_shared<model::CreateAccount>(cmd);
-        }
-
-        // -----|CreateDomain|-----
-        if (command.has_create_domain()) {
-          auto pb_command = command.create_domain();
-          auto cmd = commandFactory.deserializeCreateDomain(pb_command);
-          val = std::make_shared<model::CreateDomain>(cmd);
-        }
-
-        // -----|RemoveSignatory|-----
-        if (command.has_remove_sign()) {
-          auto pb_command = command.remove_sign();
-          auto cmd = commandFactory.deserializeRemoveSignatory(pb_command);
-          val = std::make_shared<model::RemoveSignatory>(cmd);
-        }
-
-        // -----|SetAccountPermissions|-----
-        if (command.has_set_permission()) {
-          auto pb_command = command.set_permission();
-          auto
-              cmd = commandFactory.deserializeSetAccountPermissions(pb_command);
-          val = std::make_shared<model::SetAccountPermissions>(cmd);
-        }
-
-        // -----|SetAccountQuorum|-----
-        if (command.has_set_quorum()) {
-          auto pb_command = command.set_quorum();
-          auto cmd = commandFactory.deserializeSetQuorum(pb_command);
-          val = std::make_shared<model::SetQuorum>(cmd);
-        }
-
-        // -----|TransferAsset|-----
-        if (command.has_transfer_asset()) {
-          auto pb_command = command.transfer_asset();
-          auto cmd = commandFactory.deserializeTransferAsset(pb_command);
-          val = std::make_shared<model::TransferAsset>(cmd);
-        }
-
-        return val;
+        auto deserializer = deserializers(Commands{})[command_case];
+        return deserializer ? deserializer(*this, command) : nullptr;
       }
 
     } // namespace converters
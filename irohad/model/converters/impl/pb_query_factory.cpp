@@ -16,19 +16,48 @@
  */
 
 #include <model/model_hash_provider_impl.hpp>
+#include <limits>
 #include "model/converters/pb_query_factory.hpp"
 #include "model/queries/get_account.hpp"
 #include "model/queries/get_account_assets.hpp"
 #include "model/queries/get_signatories.hpp"
+#include "model/queries/get_state_root.hpp"
 #include "model/queries/get_transactions.hpp"
+#include "model/queries/list_accounts.hpp"
+#include "model/queries/query_batch.hpp"
 
 namespace iroha {
   namespace model {
     namespace converters {
 
+      namespace {
+        TxPagination deserializePagination(
+            const protocol::TxPagination &pb_pagination) {
+          TxPagination pagination;
+          pagination.page_size = pb_pagination.page_size();
+          if (pb_pagination.has_after()) {
+            TxCursor after;
+            after.height = pb_pagination.after().height();
+            after.index = pb_pagination.after().index();
+            pagination.after = after;
+          }
+          return pagination;
+        }
+
+        AccountPagination deserializePagination(
+            const protocol::AccountPagination &pb_pagination) {
+          AccountPagination pagination;
+          pagination.page_size = pb_pagination.page_size();
+          pagination.after_account_id = pb_pagination.after_account_id();
+          return pagination;
+        }
+      }  // namespace
+
       std::shared_ptr<model::Query> PbQueryFactory::deserialize(
            const protocol::Query &pb_query) {
         std::shared_ptr<model::Query> val;
+        // queries of batch, header of the batch is set on them below
+        std::vector<std::shared_ptr<model::Query>> nested;
 
         if (pb_query.has_get_account()) {
           // Convert to get Account
@@ -46,6 +75,16 @@ namespace iroha {
           query.asset_id = pb_cast.asset_id();
           val = std::make_shared<model::GetAccountAssets>(query);
         }
+        if (pb_query.has_get_account_asset_list()) {
+          // Convert to get Account Asset List
+          auto pb_cast = pb_query.get_account_asset_list();
+          auto query = GetAccountAssetList();
+          query.account_id = pb_cast.account_id();
+          query.pagination.page_size = pb_cast.pagination().page_size();
+          query.pagination.after_asset_id =
+              pb_cast.pagination().after_asset_id();
+          val = std::make_shared<model::GetAccountAssetList>(query);
+        }
         if (pb_query.has_get_account_signatories()) {
           // Convert to get Signatories
           auto pb_cast = pb_query.get_account_signatories();
@@ -59,8 +98,97 @@ namespace iroha {
           auto pb_cast = pb_query.get_account_transactions();
           auto query = GetAccountTransactions();
           query.account_id = pb_cast.account_id();
+          query.pagination = deserializePagination(pb_cast.pagination());
           val = std::make_shared<model::GetAccountTransactions>(query);
         }
+        if (pb_query.has_get_account_asset_transactions()) {
+          // Convert to get Account Asset Transactions
+          auto pb_cast = pb_query.get_account_asset_transactions();
+          auto query = GetAccountAssetTransactions();
+          query.account_id = pb_cast.account_id();
+          query.asset_id = pb_cast.asset_id();
+          query.pagination = deserializePagination(pb_cast.pagination());
+          val = std::make_shared<model::GetAccountAssetTransactions>(query);
+        }
+        if (pb_query.has_get_transaction()) {
+          // Convert to get Transaction
+          auto pb_cast = pb_query.get_transaction();
+          auto query = GetTransaction();
+          if (pb_cast.tx_hash().size() != query.tx_hash.size()) {
+            return nullptr;
+          }
+          std::copy(pb_cast.tx_hash().begin(), pb_cast.tx_hash().end(),
+                    query.tx_hash.begin());
+          query.with_proof = pb_cast.with_proof();
+          val = std::make_shared<model::GetTransaction>(query);
+        }
+        if (pb_query.has_get_asset_transfers()) {
+          // Convert to get Asset Transfers
+          auto pb_cast = pb_query.get_asset_transfers();
+          auto query = GetAssetTransfers();
+          query.asset_id = pb_cast.asset_id();
+          if (pb_cast.from_height() > std::numeric_limits<uint32_t>::max()
+              or pb_cast.to_height() > std::numeric_limits<uint32_t>::max()) {
+            return nullptr;
+          }
+          query.from_height = pb_cast.from_height();
+          query.to_height = pb_cast.to_height();
+          query.min_amount.int_part = pb_cast.min_amount().integer_part();
+          query.min_amount.frac_part = pb_cast.min_amount().fractial_part();
+          query.pagination = deserializePagination(pb_cast.pagination());
+          val = std::make_shared<model::GetAssetTransfers>(query);
+        }
+        if (pb_query.has_get_asset_holders()) {
+          // Convert to get Asset Holders
+          auto pb_cast = pb_query.get_asset_holders();
+          auto query = GetAssetHolders();
+          query.asset_id = pb_cast.asset_id();
+          query.pagination = deserializePagination(pb_cast.pagination());
+          val = std::make_shared<model::GetAssetHolders>(query);
+        }
+        if (pb_query.has_get_domain_accounts()) {
+          // Convert to get Domain Accounts
+          auto pb_cast = pb_query.get_domain_accounts();
+          auto query = GetDomainAccounts();
+          query.domain_id = pb_cast.domain_id();
+          query.pagination = deserializePagination(pb_cast.pagination());
+          val = std::make_shared<model::GetDomainAccounts>(query);
+        }
+        if (pb_query.has_get_accounts_by_signatory()) {
+          // Convert to get Accounts By Signatory
+          auto pb_cast = pb_query.get_accounts_by_signatory();
+          auto query = GetAccountsBySignatory();
+          if (pb_cast.public_key().size() != query.signatory.size()) {
+            return nullptr;
+          }
+          std::copy(pb_cast.public_key().begin(), pb_cast.public_key().end(),
+                    query.signatory.begin());
+          query.pagination = deserializePagination(pb_cast.pagination());
+          val = std::make_shared<model::GetAccountsBySignatory>(query);
+        }
+        if (pb_query.has_get_state_root()) {
+          val = std::make_shared<model::GetStateRoot>();
+        }
+        if (pb_query.has_batch()) {
+          // Convert to Query Batch
+          const auto &pb_queries = pb_query.batch().queries();
+          if (pb_queries.empty()
+              or static_cast<size_t>(pb_queries.size())
+                  > QueryBatch::kMaxQueries) {
+            return nullptr;
+          }
+          for (const auto &pb_nested : pb_queries) {
+            if (pb_nested.has_batch()) {
+              return nullptr;
+            }
+            auto query = deserialize(pb_nested);
+            if (not query) {
+              return nullptr;
+            }
+            nested.push_back(query);
+          }
+          val = std::make_shared<model::QueryBatch>();
+        }
         if (!val) {
           // Query not implemented
           return nullptr;
@@ -73,10 +201,24 @@ namespace iroha {
         std::copy(pb_sign.signature().begin(), pb_sign.signature().end(),
                   sign.signature.begin());
         val->query_counter = pb_query.query_counter();
+        val->mask.omit_permissions = pb_query.mask().omit_permissions();
+        val->mask.omit_bodies = pb_query.mask().omit_bodies();
+        val->mask.omit_signatures = pb_query.mask().omit_signatures();
         val->signature = sign;
         val->created_ts = pb_query.header().created_time();
         val->creator_account_id = pb_query.creator_account_id();
         model::HashProviderImpl hashProvider; // TODO: get rid off unnecessary object initialization
+        if (not nested.empty()) {
+          auto &batch = static_cast<model::QueryBatch &>(*val);
+          for (auto &query : nested) {
+            query->signature = val->signature;
+            query->created_ts = val->created_ts;
+            query->creator_account_id = val->creator_account_id;
+            query->query_counter = val->query_counter;
+            query->query_hash = hashProvider.get_hash(query);
+            batch.queries.push_back(query);
+          }
+        }
         val->query_hash = hashProvider.get_hash(val);
         return val;
       }
@@ -16,7 +16,9 @@
  */
 
 #include "model/converters/pb_query_response_factory.hpp"
+#include "model/converters/pb_block_factory.hpp"
 #include "model/converters/pb_transaction_factory.hpp"
+#include "model/model_hash_provider_impl.hpp"
 
 namespace iroha {
   namespace model {
@@ -38,6 +40,13 @@ namespace iroha {
               serializeAccountAssetResponse(
                   static_cast<model::AccountAssetResponse &>(*query_response)));
         }
+        if (instanceof <model::AccountAssetsResponse>(*query_response)) {
+          response = nonstd::make_optional<protocol::QueryResponse>();
+          response->mutable_account_asset_list_response()->CopyFrom(
+              serializeAccountAssetsResponse(
+                  static_cast<model::AccountAssetsResponse &>(
+                      *query_response)));
+        }
         if (instanceof <model::AccountResponse>(*query_response)) {
           response = nonstd::make_optional<protocol::QueryResponse>();
           response->mutable_account_response()->CopyFrom(
@@ -56,9 +65,69 @@ namespace iroha {
               serializeTransactionsResponse(
                   static_cast<model::TransactionsResponse &>(*query_response)));
         }
+        if (instanceof <model::TransactionResponse>(*query_response)) {
+          response = nonstd::make_optional<protocol::QueryResponse>();
+          response->mutable_transaction_response()->CopyFrom(
+              serializeTransactionResponse(
+                  static_cast<model::TransactionResponse &>(*query_response)));
+        }
+        if (instanceof <model::AssetHoldersResponse>(*query_response)) {
+          response = nonstd::make_optional<protocol::QueryResponse>();
+          response->mutable_asset_holders_response()->CopyFrom(
+              serializeAssetHoldersResponse(
+                  static_cast<model::AssetHoldersResponse &>(*query_response)));
+        }
+        if (instanceof <model::AccountsResponse>(*query_response)) {
+          response = nonstd::make_optional<protocol::QueryResponse>();
+          response->mutable_accounts_response()->CopyFrom(
+              serializeAccountsResponse(
+                  static_cast<model::AccountsResponse &>(*query_response)));
+        }
+        if (instanceof <model::AccountIdsResponse>(*query_response)) {
+          response = nonstd::make_optional<protocol::QueryResponse>();
+          response->mutable_account_ids_response()->CopyFrom(
+              serializeAccountIdsResponse(
+                  static_cast<model::AccountIdsResponse &>(*query_response)));
+        }
+        if (instanceof <model::StateRootResponse>(*query_response)) {
+          response = nonstd::make_optional<protocol::QueryResponse>();
+          response->mutable_state_root_response()->CopyFrom(
+              serializeStateRootResponse(
+                  static_cast<model::StateRootResponse &>(*query_response)));
+        }
+        if (instanceof <model::QueryBatchResponse>(*query_response)) {
+          response = nonstd::make_optional<protocol::QueryResponse>();
+          response->mutable_batch_response()->CopyFrom(
+              serializeQueryBatchResponse(
+                  static_cast<model::QueryBatchResponse &>(*query_response)));
+        }
         return response;
       }
 
+      protocol::StateRootResponse
+      PbQueryResponseFactory::serializeStateRootResponse(
+          const model::StateRootResponse &stateRootResponse) const {
+        protocol::StateRootResponse pb_response;
+        pb_response.set_height(stateRootResponse.height);
+        pb_response.set_root(stateRootResponse.root.data(),
+                             stateRootResponse.root.size());
+        return pb_response;
+      }
+
+      protocol::QueryBatchResponse
+      PbQueryResponseFactory::serializeQueryBatchResponse(
+          const model::QueryBatchResponse &batchResponse) const {
+        protocol::QueryBatchResponse pb_response;
+        for (const auto &response : batchResponse.responses) {
+          // unknown response is left empty, so the rest keep their places
+          auto pb_nested = pb_response.add_responses();
+          if (auto serialized = serialize(response)) {
+            pb_nested->Swap(&*serialized);
+          }
+        }
+        return pb_response;
+      }
+
       protocol::Account PbQueryResponseFactory::serializeAccount(
           const model::Account &account) const {
         protocol::Account pb_account;
@@ -81,6 +150,7 @@ namespace iroha {
 
         pb_account.set_master_key(account.master_key.data(),
                                   account.master_key.size());
+        pb_account.set_tx_counter(account.tx_counter);
         return pb_account;
       }
 
@@ -111,6 +181,7 @@ namespace iroha {
 
         std::copy(pb_account.master_key().begin(),
                   pb_account.master_key().end(), res.master_key.begin());
+        res.tx_counter = pb_account.tx_counter();
         return res;
       }
 
@@ -120,6 +191,9 @@ namespace iroha {
         protocol::AccountResponse pb_response;
         pb_response.mutable_account()->CopyFrom(
             serializeAccount(accountResponse.account));
+        if (accountResponse.mask.omit_permissions) {
+          pb_response.mutable_account()->clear_permissions();
+        }
         return pb_response;
       }
 
@@ -174,6 +248,78 @@ namespace iroha {
         return res;
       }
 
+      protocol::AccountAssetsResponse
+      PbQueryResponseFactory::serializeAccountAssetsResponse(
+          const model::AccountAssetsResponse &accountAssetsResponse) const {
+        protocol::AccountAssetsResponse pb_response;
+        for (const auto &asset : accountAssetsResponse.account_assets) {
+          pb_response.add_account_assets()->CopyFrom(
+              serializeAccountAsset(asset));
+        }
+        if (accountAssetsResponse.next_asset_id) {
+          pb_response.set_next_asset_id(*accountAssetsResponse.next_asset_id);
+        }
+        return pb_response;
+      }
+
+      model::AccountAssetsResponse
+      PbQueryResponseFactory::deserializeAccountAssetsResponse(
+          const protocol::AccountAssetsResponse &account_assets_response)
+          const {
+        model::AccountAssetsResponse res;
+        for (const auto &asset : account_assets_response.account_assets()) {
+          res.account_assets.push_back(deserializeAccountAsset(asset));
+        }
+        if (not account_assets_response.next_asset_id().empty()) {
+          res.next_asset_id = account_assets_response.next_asset_id();
+        }
+        return res;
+      }
+
+      protocol::AssetHoldersResponse
+      PbQueryResponseFactory::serializeAssetHoldersResponse(
+          const model::AssetHoldersResponse &holdersResponse) const {
+        protocol::AssetHoldersResponse pb_response;
+        for (const auto &asset : holdersResponse.account_assets) {
+          pb_response.add_account_assets()->CopyFrom(
+              serializeAccountAsset(asset));
+        }
+        if (holdersResponse.next_account_id) {
+          pb_response.set_next_account_id(*holdersResponse.next_account_id);
+        }
+        return pb_response;
+      }
+
+      protocol::AccountsResponse
+      PbQueryResponseFactory::serializeAccountsResponse(
+          const model::AccountsResponse &accountsResponse) const {
+        protocol::AccountsResponse pb_response;
+        for (const auto &account : accountsResponse.accounts) {
+          auto pb_account = pb_response.add_accounts();
+          pb_account->CopyFrom(serializeAccount(account));
+          if (accountsResponse.mask.omit_permissions) {
+            pb_account->clear_permissions();
+          }
+        }
+        if (accountsResponse.next_account_id) {
+          pb_response.set_next_account_id(*accountsResponse.next_account_id);
+        }
+        return pb_response;
+      }
+
+      protocol::AccountIdsResponse
+      PbQueryResponseFactory::serializeAccountIdsResponse(
+          const model::AccountIdsResponse &accountIdsResponse) const {
+        protocol::AccountIdsResponse pb_response;
+        for (const auto &account_id : accountIdsResponse.account_ids) {
+          pb_response.add_account_ids(account_id);
+        }
+        if (accountIdsResponse.next_account_id) {
+          pb_response.set_next_account_id(*accountIdsResponse.next_account_id);
+        }
+        return pb_response;
+      }
+
       protocol::SignatoriesResponse
       PbQueryResponseFactory::serializeSignatoriesResponse(
           const model::SignatoriesResponse &signatoriesResponse) const {
@@ -200,19 +346,86 @@ namespace iroha {
       protocol::TransactionsResponse
       PbQueryResponseFactory::serializeTransactionsResponse(
           const model::TransactionsResponse &transactionsResponse) const {
-        PbTransactionFactory pb_transaction_factory;
+        const auto &mask = transactionsResponse.mask;
 
         // converting observable to the vector using reduce
-        return transactionsResponse.transactions
-            .reduce(protocol::TransactionsResponse(),
-                    [&pb_transaction_factory](auto &&response, auto tx) {
-                      response.add_transactions()->CopyFrom(
-                          pb_transaction_factory.serialize(tx));
-                      return response;
-                    },
-                    [](auto &&response) { return response; })
-            .as_blocking()  // we need to wait when on_complete happens
-            .first();
+        auto pb_response =
+            transactionsResponse.transactions
+                .reduce(protocol::TransactionsResponse(),
+                        [this, &mask](auto &&response, auto tx) {
+                          this->appendTransaction(response, tx, mask);
+                          return response;
+                        },
+                        [](auto &&response) { return response; })
+                .as_blocking()  // we need to wait when on_complete happens
+                .first();
+        if (transactionsResponse.next) {
+          auto next = pb_response.mutable_next();
+          next->set_height(transactionsResponse.next->height);
+          next->set_index(transactionsResponse.next->index);
+        }
+        return pb_response;
+      }
+
+      protocol::TransactionResponse
+      PbQueryResponseFactory::serializeTransactionResponse(
+          const model::TransactionResponse &transactionResponse) const {
+        const auto &mask = transactionResponse.mask;
+        protocol::TransactionResponse pb_response;
+        pb_response.mutable_transaction()->CopyFrom(
+            serializeTransaction(transactionResponse.transaction, mask));
+        pb_response.set_height(transactionResponse.height);
+        pb_response.set_index(transactionResponse.index);
+        if (mask.omit_bodies) {
+          HashProviderImpl hash_provider;
+          auto hash = hash_provider.get_hash(transactionResponse.transaction);
+          pb_response.set_tx_hash(hash.data(), hash.size());
+        }
+        if (transactionResponse.proof) {
+          const auto &proof = *transactionResponse.proof;
+          auto pb_proof = pb_response.mutable_proof();
+          // header has no transactions, so only its own fields are sent
+          auto pb_block = PbBlockFactory().serialize(proof.header);
+          pb_proof->mutable_block_header()->Swap(pb_block.mutable_header());
+          pb_proof->mutable_block_meta()->Swap(pb_block.mutable_meta());
+          for (const auto &step : proof.path) {
+            auto pb_step = pb_proof->add_path();
+            pb_step->set_sibling(step.sibling.data(), step.sibling.size());
+            pb_step->set_sibling_is_left(step.sibling_is_left);
+          }
+        }
+        return pb_response;
+      }
+
+      void PbQueryResponseFactory::appendTransaction(
+          protocol::TransactionsResponse &response,
+          const model::Transaction &transaction,
+          const model::ResponseMask &mask) const {
+        response.add_transactions()->CopyFrom(
+            serializeTransaction(transaction, mask));
+        if (mask.omit_bodies) {
+          HashProviderImpl hash_provider;
+          auto hash = hash_provider.get_hash(transaction);
+          response.add_tx_hashes(hash.data(), hash.size());
+        }
+      }
+
+      protocol::Transaction PbQueryResponseFactory::serializeTransaction(
+          const model::Transaction &transaction,
+          const model::ResponseMask &mask) const {
+        PbTransactionFactory pb_transaction_factory;
+        if (not mask.omit_bodies and not mask.omit_signatures) {
+          return pb_transaction_factory.serialize(transaction);
+        }
+        // commands are shared, so the copy does not duplicate them
+        auto stripped = transaction;
+        if (mask.omit_bodies) {
+          stripped.commands.clear();
+        }
+        if (mask.omit_signatures) {
+          stripped.signatures.clear();
+        }
+        return pb_transaction_factory.serialize(stripped);
       }
 
       protocol::ErrorResponse PbQueryResponseFactory::serializeErrorResponse(
@@ -237,6 +450,9 @@ namespace iroha {
           case ErrorResponse::NOT_SUPPORTED:
             pb_response.set_reason(protocol::ErrorResponse::NOT_SUPPORTED);
             break;
+          case ErrorResponse::NO_TRANSACTION:
+            pb_response.set_reason(protocol::ErrorResponse::NO_TRANSACTION);
+            break;
         }
         return pb_response;
       }
@@ -18,6 +18,7 @@
 #include "model/converters/pb_transaction_factory.hpp"
 #include "model/commands/add_asset_quantity.hpp"
 #include "common/types.hpp"
+#include "model/command_pool.hpp"
 #include "model/converters/pb_command_factory.hpp"
 #include "model/model_hash_provider_impl.hpp"
 
@@ -27,12 +28,20 @@ namespace iroha {
 
       protocol::Transaction PbTransactionFactory::serialize(
           const model::Transaction &tx) const {
-        model::converters::PbCommandFactory factory;
         protocol::Transaction pb_tx;
+        serialize(tx, pb_tx);
+        return pb_tx;
+      }
+
+      void PbTransactionFactory::serialize(const model::Transaction &tx,
+                                           protocol::Transaction &pb_tx) const {
+        model::converters::PbCommandFactory factory;
+        pb_tx.Clear();
 
         // -----|Header|-----
         auto header = pb_tx.mutable_header();
         header->set_created_time(tx.created_ts);
+        header->mutable_signatures()->Reserve(tx.signatures.size());
         for (auto &signature : tx.signatures) {
           auto proto_signature = pb_tx.mutable_header()->add_signatures();
           proto_signature->set_pubkey(signature.pubkey.data(),
@@ -47,21 +56,27 @@ namespace iroha {
         meta->set_tx_counter(tx.tx_counter);
 
         // -----|Body|-----
+        pb_tx.mutable_body()->mutable_commands()->Reserve(tx.commands.size());
         for (auto &command : tx.commands) {
-          auto cmd = pb_tx.mutable_body()->add_commands();
-          new (cmd)
-              protocol::Command(factory.serializeAbstractCommand(*command));
+          auto serialized = factory.serializeAbstractCommand(*command);
+          pb_tx.mutable_body()->add_commands()->Swap(&serialized);
+        }
+
+        if (tx.trace) {
+          pb_tx.set_trace_parent(tx.trace->traceparent());
         }
-        return pb_tx;
       }
 
       std::shared_ptr<model::Transaction> PbTransactionFactory::deserialize(
           const protocol::Transaction &pb_tx) const {
         model::converters::PbCommandFactory commandFactory;
-        model::Transaction tx;
+        // transaction is built in place, so its fields are not copied again
+        auto result = model::makePooled<model::Transaction>();
+        auto &tx = *result;
 
         // -----|Header|-----
         tx.created_ts = pb_tx.header().created_time();
+        tx.signatures.reserve(pb_tx.header().signatures_size());
         for (auto &pb_sign : pb_tx.header().signatures()) {
           model::Signature sign;
           std::copy(pb_sign.pubkey().begin(), pb_sign.pubkey().end(),
@@ -76,15 +91,20 @@ namespace iroha {
         tx.tx_counter = pb_tx.meta().tx_counter();
 
         // -----|Body|-----
+        tx.commands.reserve(pb_tx.body().commands_size());
         for (const auto &pb_command : pb_tx.body().commands()) {
           tx.commands.push_back(
               commandFactory.deserializeAbstractCommand(pb_command));
         }
 
+        if (not pb_tx.trace_parent().empty()) {
+          tx.trace = tracing::TraceContext::parse(pb_tx.trace_parent());
+        }
+
         model::HashProviderImpl hashProvider;
         tx.tx_hash = hashProvider.get_hash(tx);
 
-        return std::make_shared<model::Transaction>(tx);
+        return result;
       }
 
     }  // namespace converters
@@ -0,0 +1,42 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "model/converters/pb_transaction_view.hpp"
+
+namespace iroha {
+  namespace model {
+    namespace converters {
+
+      bool PbTransactionView::wellFormed() const {
+        for (const auto &pb_sign : pb_tx_.header().signatures()) {
+          if (pb_sign.pubkey().size() != ed25519::pubkey_t::size()
+              or pb_sign.signature().size() != ed25519::sig_t::size()) {
+            return false;
+          }
+        }
+        for (const auto &pb_command : pb_tx_.body().commands()) {
+          if (pb_command.command_case()
+              == protocol::Command::COMMAND_NOT_SET) {
+            return false;
+          }
+        }
+        return true;
+      }
+
+    }  // namespace converters
+  }    // namespace model
+}  // namespace iroha
@@ -34,8 +34,20 @@ namespace iroha {
         nonstd::optional<Block> deserialize(
             const rapidjson::Document &document);
 
+        /**
+         * Deserialize block while parsing its json, without building
+         * document of the whole block. Fields of block, transactions and
+         * signatures are set as they are read, each command is parsed into
+         * small document of its own
+         * @param data - serialized json, not null-terminated
+         * @param size - size of serialized json in bytes
+         * @return block if json is well-formed, nullopt otherwise
+         */
+        nonstd::optional<Block> deserialize(const uint8_t *data, size_t size);
+
        private:
         JsonTransactionFactory factory_;
+        JsonCommandFactory command_factory_;
         logger::Logger log_;
       };
 
@@ -20,8 +20,6 @@
 
 #include <rapidjson/document.h>
 #include <memory>
-#include <typeindex>
-#include <unordered_map>
 #include "model/command.hpp"
 
 namespace iroha {
@@ -30,8 +28,6 @@ namespace iroha {
 
       class JsonCommandFactory {
        public:
-        JsonCommandFactory();
-
         // AddAssetQuantity
         rapidjson::Document serializeAddAssetQuantity(
             std::shared_ptr<Command> command);
@@ -102,15 +98,6 @@ namespace iroha {
             std::shared_ptr<Command> command);
         std::shared_ptr<model::Command> deserializeAbstractCommand(
             const rapidjson::Document &command);
-
-       private:
-        using Serializer = rapidjson::Document (JsonCommandFactory::*)(
-            std::shared_ptr<Command>);
-        using Deserializer = std::shared_ptr<model::Command> (
-            JsonCommandFactory::*)(const rapidjson::Document &);
-
-        std::unordered_map<std::type_index, Serializer> serializers_;
-        std::unordered_map<std::string, Deserializer> deserializers_;
       };
 
     }  // namespace converters
@@ -40,13 +40,44 @@ namespace iroha {
       nonstd::optional<rapidjson::Document> stringToJson(
           const std::string& string);
 
-      std::string jsonToString(const rapidjson::Document& document);
+      /**
+       * Serialize json, compact unless pretty-printing is requested
+       * @param document - json to serialize
+       * @param pretty - indent members and put them on lines of their own,
+       * for output read by people
+       * @return serialized json
+       */
+      std::string jsonToString(const rapidjson::Document& document,
+                               bool pretty = false);
 
       nonstd::optional<rapidjson::Document> vectorToJson(
           const std::vector<uint8_t>& vector);
 
+      /**
+       * Parse json directly from raw memory without intermediate copies
+       * @param data - pointer to serialized json, not null-terminated
+       * @param size - size of serialized json in bytes
+       * @return document if parsing succeeded, nullopt otherwise
+       */
+      nonstd::optional<rapidjson::Document> bytesToJson(const uint8_t* data,
+                                                        size_t size);
+
+      /**
+       * Serialize compact json to bytes
+       * @param document - json to serialize
+       * @return serialized json
+       */
       std::vector<uint8_t> jsonToVector(const rapidjson::Document& document);
 
+      /**
+       * Serialize compact json into buffer, so one buffer is reused for many
+       * documents
+       * @param document - json to serialize
+       * @param buffer - buffer which is cleared and filled with json
+       */
+      void jsonToVector(const rapidjson::Document& document,
+                        std::vector<uint8_t>& buffer);
+
     }  // namespace converters
   }    // namespace model
 }  // namespace iroha
@@ -38,6 +38,14 @@ namespace iroha {
          */
         protocol::Block serialize(model::Block const&block);
 
+        /**
+         * Convert block into existing proto block, which keeps memory
+         * allocated by its previous contents for reuse
+         * @param block - reference to block
+         * @param pb_block - proto block to overwrite
+         */
+        void serialize(model::Block const &block, protocol::Block &pb_block);
+
         /**
          * Convert proto block to model block
          * @param pb_block - reference to proto block
@@ -22,9 +22,13 @@
 #include <model/account_asset.hpp>
 #include <model/queries/responses/account_assets_response.hpp>
 #include <model/queries/responses/account_response.hpp>
+#include <model/queries/responses/accounts_response.hpp>
 #include <nonstd/optional.hpp>
 #include "model/queries/responses/error_response.hpp"
+#include "model/queries/responses/query_batch_response.hpp"
 #include "model/queries/responses/signatories_response.hpp"
+#include "model/queries/responses/state_root_response.hpp"
+#include "model/queries/responses/transaction_response.hpp"
 #include "model/queries/responses/transactions_response.hpp"
 
 namespace iroha {
@@ -58,6 +62,24 @@ namespace iroha {
         model::AccountAssetResponse deserializeAccountAssetResponse(
             const protocol::AccountAssetResponse &account_asset_response) const;
 
+        protocol::AccountAssetsResponse serializeAccountAssetsResponse(
+            const model::AccountAssetsResponse &accountAssetsResponse) const;
+        model::AccountAssetsResponse deserializeAccountAssetsResponse(
+            const protocol::AccountAssetsResponse &account_assets_response)
+            const;
+
+        protocol::AssetHoldersResponse serializeAssetHoldersResponse(
+            const model::AssetHoldersResponse &holdersResponse) const;
+
+        /**
+         * Serialize page of accounts without parts left out by mask
+         */
+        protocol::AccountsResponse serializeAccountsResponse(
+            const model::AccountsResponse &accountsResponse) const;
+
+        protocol::AccountIdsResponse serializeAccountIdsResponse(
+            const model::AccountIdsResponse &accountIdsResponse) const;
+
         protocol::SignatoriesResponse serializeSignatoriesResponse(
             const model::SignatoriesResponse &signatoriesResponse) const;
         model::SignatoriesResponse deserializeSignatoriesResponse(
@@ -68,8 +90,37 @@ namespace iroha {
         model::TransactionsResponse deserializeTransactionsResponse(
             const protocol::TransactionsResponse &tx_response) const;
 
+        protocol::TransactionResponse serializeTransactionResponse(
+            const model::TransactionResponse &transactionResponse) const;
+
+        protocol::StateRootResponse serializeStateRootResponse(
+            const model::StateRootResponse &stateRootResponse) const;
+
+        /**
+         * Serialize responses of batch in order of its queries
+         */
+        protocol::QueryBatchResponse serializeQueryBatchResponse(
+            const model::QueryBatchResponse &batchResponse) const;
+
+        /**
+         * Append transaction to response without parts left out by mask.
+         * If bodies are omitted, hash of the whole transaction is appended
+         * as well, so client can still refer to it
+         */
+        void appendTransaction(protocol::TransactionsResponse &response,
+                               const model::Transaction &transaction,
+                               const model::ResponseMask &mask) const;
+
         protocol::ErrorResponse serializeErrorResponse(
             const model::ErrorResponse &errorResponse) const;
+
+       private:
+        /**
+         * Serialize transaction without parts left out by mask
+         */
+        protocol::Transaction serializeTransaction(
+            const model::Transaction &transaction,
+            const model::ResponseMask &mask) const;
       };
     }
   }
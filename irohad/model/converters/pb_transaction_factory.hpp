@@ -38,6 +38,15 @@ namespace iroha {
          */
         protocol::Transaction serialize(const model::Transaction &tx) const;
 
+        /**
+         * Convert transaction into existing proto transaction, which
+         * keeps memory allocated by its previous contents for reuse
+         * @param tx - transaction to convert
+         * @param pb_tx - proto transaction to overwrite
+         */
+        void serialize(const model::Transaction &tx,
+                       protocol::Transaction &pb_tx) const;
+
         /**
          * Convert proto block to model block
          * @param pb_block - reference to proto block
@@ -0,0 +1,77 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_PB_TRANSACTION_VIEW_HPP
+#define IROHA_PB_TRANSACTION_VIEW_HPP
+
+#include <string>
+#include "block.pb.h"
+#include "common/types.hpp"
+
+namespace iroha {
+  namespace model {
+    namespace converters {
+
+      /**
+       * Read-only view of protobuf transaction, so it is checked before
+       * conversion to model, which copies every field.
+       * Accessors refer to fields of the message, which must outlive view
+       */
+      class PbTransactionView {
+       public:
+        explicit PbTransactionView(const protocol::Transaction &pb_tx)
+            : pb_tx_(pb_tx) {}
+
+        const std::string &creatorAccountId() const {
+          return pb_tx_.meta().creator_account_id();
+        }
+
+        ts64_t createdTs() const {
+          return pb_tx_.header().created_time();
+        }
+
+        uint64_t txCounter() const {
+          return pb_tx_.meta().tx_counter();
+        }
+
+        size_t signaturesSize() const {
+          return pb_tx_.header().signatures_size();
+        }
+
+        size_t commandsSize() const {
+          return pb_tx_.body().commands_size();
+        }
+
+        /**
+         * @return true if keys and signatures have sizes of their model
+         * blobs, and every command is set, so conversion is lossless
+         */
+        bool wellFormed() const;
+
+        const protocol::Transaction &message() const {
+          return pb_tx_;
+        }
+
+       private:
+        const protocol::Transaction &pb_tx_;
+      };
+
+    }  // namespace converters
+  }    // namespace model
+}  // namespace iroha
+
+#endif  // IROHA_PB_TRANSACTION_VIEW_HPP
@@ -0,0 +1,59 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "model/account.hpp"
+
+namespace iroha {
+  namespace model {
+
+    namespace {
+      using Permissions = Account::Permissions;
+
+      // flag of every permission with its bit
+      const std::pair<bool Permissions::*, Permissions::Bit> kFlags[] = {
+          {&Permissions::add_signatory, Permissions::kAddSignatory},
+          {&Permissions::can_transfer, Permissions::kCanTransfer},
+          {&Permissions::create_accounts, Permissions::kCreateAccounts},
+          {&Permissions::create_assets, Permissions::kCreateAssets},
+          {&Permissions::create_domains, Permissions::kCreateDomains},
+          {&Permissions::issue_assets, Permissions::kIssueAssets},
+          {&Permissions::read_all_accounts, Permissions::kReadAllAccounts},
+          {&Permissions::remove_signatory, Permissions::kRemoveSignatory},
+          {&Permissions::set_permissions, Permissions::kSetPermissions},
+          {&Permissions::set_quorum, Permissions::kSetQuorum}};
+    }  // namespace
+
+    uint64_t Account::Permissions::toBitmask() const {
+      uint64_t mask = 0;
+      for (const auto &flag : kFlags) {
+        if (this->*flag.first) {
+          mask |= flag.second;
+        }
+      }
+      return mask;
+    }
+
+    Account::Permissions Account::Permissions::fromBitmask(uint64_t mask) {
+      Permissions permissions;
+      for (const auto &flag : kFlags) {
+        permissions.*flag.first = (mask & flag.second) != 0;
+      }
+      return permissions;
+    }
+
+  }  // namespace model
+}  // namespace iroha
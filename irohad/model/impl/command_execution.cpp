@@ -28,6 +28,7 @@
 #include "model/commands/subtract_asset_quantity.hpp"
 #include "model/commands/transfer_asset.hpp"
 
+#include <limits>
 #include <math.h>
 #include <cmath>
 
@@ -43,6 +44,8 @@ namespace iroha {
       auto precision = asset.value().precision;
       // Amount is wrongly formed
       if (amount.get_frac_number() > precision) return false;
+      uint64_t quantity;
+      if (not amount.get_joint_amount(precision, quantity)) return false;
       if (!queries.getAccount(account_id))
         // No such account
         return false;
@@ -54,14 +57,14 @@ namespace iroha {
         accountAsset = AccountAsset();
         accountAsset.asset_id = asset_id;
         accountAsset.account_id = account_id;
-        accountAsset.balance = amount.get_joint_amount(precision);
+        accountAsset.balance = quantity;
       } else {
         accountAsset = account_asset.value();
-        // TODO: handle non trivial arithmetic
-        auto new_balance =
-            account_asset.value().balance + amount.get_joint_amount(precision);
-        // TODO: handle overflow
-        accountAsset.balance = new_balance;
+        if (accountAsset.balance
+            > std::numeric_limits<uint64_t>::max() - quantity)
+          // Balance would overflow
+          return false;
+        accountAsset.balance += quantity;
       }
 
       // accountAsset.value().balance += amount;
@@ -175,12 +178,17 @@ namespace iroha {
       if (amount.get_frac_number() > precision)
         // Precision is wrong
         return false;
+      uint64_t quantity;
+      if (not amount.get_joint_amount(precision, quantity))
+        // Amount does not fit into balance
+        return false;
       // Get src balance
       auto src_balance = src_account_asset.value().balance;
-      // TODO: handle non-trivial arithmetic
-      src_balance -= amount.get_joint_amount(precision);
+      if (src_balance < quantity)
+        // Not enough assets
+        return false;
       // Set new balance for source account
-      src_account_asset.value().balance = src_balance;
+      src_account_asset.value().balance = src_balance - quantity;
 
       if (!dest_account_asset) {
         // This assert is new for this account - create new AccountAsset
@@ -188,17 +196,18 @@ namespace iroha {
         dest_AccountAsset.asset_id = asset_id;
         dest_AccountAsset.account_id = dest_account_id;
         // Set new balance for dest account
-        dest_AccountAsset.balance = amount.get_joint_amount(precision);
+        dest_AccountAsset.balance = quantity;
 
       } else {
         // Account already has such asset
         dest_AccountAsset = dest_account_asset.value();
         // Get balance dest account
         auto dest_balance = dest_account_asset.value().balance;
-
-        dest_balance += amount.get_joint_amount(precision);
+        if (dest_balance > std::numeric_limits<uint64_t>::max() - quantity)
+          // Balance would overflow
+          return false;
         // Set new balance for dest
-        dest_AccountAsset.balance = dest_balance;
+        dest_AccountAsset.balance = dest_balance + quantity;
       }
 
       return commands.upsertAccountAsset(dest_AccountAsset) &&
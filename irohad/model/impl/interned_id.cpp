@@ -0,0 +1,79 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "model/interned_id.hpp"
+#include <array>
+#include <mutex>
+#include <unordered_set>
+
+namespace iroha {
+  namespace model {
+
+    namespace {
+      /**
+       * Intern table split into shards with locks of their own, so threads
+       * interning different identifiers rarely wait for each other. Nodes
+       * of unordered set are not moved by rehash, so entry pointers stay
+       * valid
+       */
+      class InternTable {
+       public:
+        static InternTable &instance() {
+          static InternTable table;
+          return table;
+        }
+
+        const std::string *intern(const std::string &id) {
+          auto &shard = shards_[std::hash<std::string>()(id) % kShards];
+          std::lock_guard<std::mutex> lock(shard.mutex);
+          return &*shard.entries.insert(id).first;
+        }
+
+        const std::string *find(const std::string &id) {
+          auto &shard = shards_[std::hash<std::string>()(id) % kShards];
+          std::lock_guard<std::mutex> lock(shard.mutex);
+          auto it = shard.entries.find(id);
+          return it == shard.entries.end() ? nullptr : &*it;
+        }
+
+       private:
+        static constexpr size_t kShards = 16;
+
+        struct Shard {
+          std::mutex mutex;
+          std::unordered_set<std::string> entries;
+        };
+
+        std::array<Shard, kShards> shards_;
+      };
+    }  // namespace
+
+    InternedId::InternedId() : InternedId(std::string()) {}
+
+    InternedId::InternedId(const std::string &id)
+        : entry_(InternTable::instance().intern(id)) {}
+
+    nonstd::optional<InternedId> InternedId::find(const std::string &id) {
+      auto entry = InternTable::instance().find(id);
+      if (not entry) {
+        return nonstd::nullopt;
+      }
+      return InternedId(entry);
+    }
+
+  }  // namespace model
+}  // namespace iroha
@@ -0,0 +1,100 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "model/merkle_tree.hpp"
+
+namespace iroha {
+  namespace model {
+
+    MerkleTree MerkleTree::build(const std::vector<hash256_t> &leaves) {
+      MerkleTree tree;
+      for (const auto &leaf : leaves) {
+        tree.append(leaf);
+      }
+      return tree;
+    }
+
+    bool MerkleTree::verify(const hash256_t &leaf,
+                            const Proof &proof,
+                            const hash256_t &root) {
+      return verify_merkle_path(leaf, proof, root);
+    }
+
+    void MerkleTree::append(const hash256_t &leaf) {
+      auto node = leaf;
+      for (size_t level = 0;; ++level) {
+        if (level == levels_.size()) {
+          levels_.emplace_back();
+        }
+        levels_[level].push_back(node);
+        if (levels_[level].size() % 2 == 1) {
+          return;
+        }
+        // pair is complete, its parent is complete too
+        const auto &nodes = levels_[level];
+        node = merkle_parent(nodes[nodes.size() - 2], nodes.back());
+      }
+    }
+
+    hash256_t MerkleTree::root() const {
+      auto root = partials().back();
+      return root ? *root : hash256_t{};
+    }
+
+    size_t MerkleTree::size() const {
+      return levels_.empty() ? 0 : levels_.front().size();
+    }
+
+    nonstd::optional<MerkleTree::Proof> MerkleTree::proof(
+        size_t index) const {
+      if (index >= size()) {
+        return nonstd::nullopt;
+      }
+      auto partial = partials();
+      Proof proof;
+      auto position = index;
+      for (size_t level = 0; level < levels_.size(); ++level) {
+        const auto &nodes = levels_[level];
+        auto sibling = position ^ 1;
+        if (sibling < nodes.size()) {
+          proof.push_back({nodes[sibling], sibling < position});
+        } else if (sibling == nodes.size() and partial[level]) {
+          proof.push_back({*partial[level], false});
+        }
+        // node without sibling is promoted, its position is still halved
+        position /= 2;
+      }
+      return proof;
+    }
+
+    std::vector<nonstd::optional<hash256_t>> MerkleTree::partials() const {
+      std::vector<nonstd::optional<hash256_t>> partial(levels_.size() + 1);
+      for (size_t level = 0; level < levels_.size(); ++level) {
+        const auto &nodes = levels_[level];
+        partial[level + 1] = partial[level];
+        if (nodes.size() % 2 == 1) {
+          // the last node is paired with the rest of tree on its right
+          partial[level + 1] = partial[level]
+              ? merkle_parent(nodes.back(), *partial[level])
+              : nodes.back();
+        }
+      }
+      return partial;
+    }
+
+  }  // namespace model
+}  // namespace iroha
@@ -129,16 +129,7 @@ namespace iroha {
     }
 
     bool Account::Permissions::operator==(const Permissions &rhs) const {
-      return rhs.add_signatory == add_signatory &&
-             rhs.can_transfer == can_transfer &&
-             rhs.create_accounts == create_accounts &&
-             rhs.create_assets == create_assets &&
-             rhs.create_domains == create_domains &&
-             rhs.issue_assets == issue_assets &&
-             rhs.read_all_accounts == read_all_accounts &&
-             rhs.remove_signatory == remove_signatory &&
-             rhs.set_permissions == set_permissions &&
-             rhs.set_quorum == set_quorum;
+      return toBitmask() == rhs.toBitmask();
     }
 
     bool Account::Permissions::operator!=(const Permissions &rhs) const {
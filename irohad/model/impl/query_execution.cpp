@@ -16,77 +16,363 @@
  */
 
 #include "model/query_execution.hpp"
+#include <typeindex>
+#include <unordered_set>
+#include "metrics/metrics.hpp"
+#include "model/commands/add_asset_quantity.hpp"
+#include "model/commands/add_peer.hpp"
+#include "model/commands/add_signatory.hpp"
+#include "model/commands/assign_master_key.hpp"
+#include "model/commands/create_account.hpp"
+#include "model/commands/create_asset.hpp"
+#include "model/commands/create_domain.hpp"
+#include "model/commands/remove_signatory.hpp"
+#include "model/commands/set_permissions.hpp"
+#include "model/commands/set_quorum.hpp"
+#include "model/commands/transfer_asset.hpp"
 #include "model/queries/responses/account_assets_response.hpp"
 #include "model/queries/responses/account_response.hpp"
+#include "model/queries/responses/accounts_response.hpp"
 #include "model/queries/responses/error_response.hpp"
+#include "model/queries/responses/query_batch_response.hpp"
 #include "model/queries/responses/signatories_response.hpp"
+#include "model/queries/responses/state_root_response.hpp"
+#include "model/queries/responses/transaction_response.hpp"
 #include "model/queries/responses/transactions_response.hpp"
 
+namespace {
+  /**
+   * Latency of query execution by type, other types share "Unknown".
+   * Lazy transaction histories are measured until the response is built
+   */
+  iroha::metrics::Histogram& queryLatency(const iroha::model::Query& query) {
+    using Latencies =
+        std::vector<std::pair<std::type_index, iroha::metrics::Histogram*>>;
+    static const auto histogram = [](const std::string& type) {
+      return &iroha::metrics::registry().histogram(
+          "iroha_query_latency_seconds",
+          "Time of stateful validation and execution of query",
+          iroha::metrics::latencyBounds(),
+          {{"type", type}});
+    };
+    static const Latencies latencies = {
+        {typeid(iroha::model::GetAccount), histogram("GetAccount")},
+        {typeid(iroha::model::GetAccountAssets),
+         histogram("GetAccountAssets")},
+        {typeid(iroha::model::GetAccountAssetList),
+         histogram("GetAccountAssetList")},
+        {typeid(iroha::model::GetSignatories), histogram("GetSignatories")},
+        {typeid(iroha::model::GetAccountTransactions),
+         histogram("GetAccountTransactions")},
+        {typeid(iroha::model::GetAccountAssetTransactions),
+         histogram("GetAccountAssetTransactions")},
+        {typeid(iroha::model::GetTransaction), histogram("GetTransaction")},
+        {typeid(iroha::model::GetAssetTransfers),
+         histogram("GetAssetTransfers")},
+        {typeid(iroha::model::GetAssetHolders), histogram("GetAssetHolders")},
+        {typeid(iroha::model::GetDomainAccounts),
+         histogram("GetDomainAccounts")},
+        {typeid(iroha::model::GetAccountsBySignatory),
+         histogram("GetAccountsBySignatory")},
+        {typeid(iroha::model::GetStateRoot), histogram("GetStateRoot")},
+        {typeid(iroha::model::QueryBatch), histogram("QueryBatch")}};
+    static auto& unknown = *histogram("Unknown");
+
+    std::type_index type = typeid(query);
+    for (const auto& latency : latencies) {
+      if (latency.first == type) {
+        return *latency.second;
+      }
+    }
+    return unknown;
+  }
+
+  /**
+   * Make response with page of transactions. Unbounded history is left
+   * lazy, a bounded page is read to find out its continuation.
+   */
+  std::shared_ptr<iroha::model::QueryResponse> transactionsPage(
+      rxcpp::observable<iroha::ametsuchi::CommittedTransaction> transactions,
+      const iroha::model::TxPagination& pagination,
+      const iroha::hash256_t& query_hash) {
+    iroha::model::TransactionsResponse response;
+    response.query_hash = query_hash;
+    if (pagination.page_size == 0) {
+      response.transactions = transactions.map(
+          [](const auto& committed) { return committed.transaction; });
+      return std::make_shared<iroha::model::TransactionsResponse>(response);
+    }
+    std::vector<iroha::model::Transaction> page;
+    iroha::model::TxCursor last{};
+    transactions.as_blocking().subscribe([&page, &last](const auto& committed) {
+      page.push_back(committed.transaction);
+      last.height = committed.height;
+      last.index = committed.index;
+    });
+    if (not page.empty()) {
+      response.last = last;
+    }
+    if (page.size() == pagination.page_size) {
+      response.next = last;
+    }
+    response.transactions = rxcpp::observable<>::iterate(page);
+    return std::make_shared<iroha::model::TransactionsResponse>(response);
+  }
+
+  /**
+   * Collect accounts whose state may be changed by command
+   * @return false if command is not known, so any account may be changed
+   */
+  bool touchedAccounts(const iroha::model::Command& command,
+                       std::unordered_set<std::string>& accounts) {
+    using namespace iroha::model;
+    using iroha::instanceof;
+    if (instanceof <AddAssetQuantity>(command)) {
+      accounts.insert(static_cast<const AddAssetQuantity&>(command).account_id);
+    } else if (instanceof <TransferAsset>(command)) {
+      auto& transfer = static_cast<const TransferAsset&>(command);
+      accounts.insert(transfer.src_account_id);
+      accounts.insert(transfer.dest_account_id);
+    } else if (instanceof <AddSignatory>(command)) {
+      accounts.insert(static_cast<const AddSignatory&>(command).account_id);
+    } else if (instanceof <RemoveSignatory>(command)) {
+      accounts.insert(static_cast<const RemoveSignatory&>(command).account_id);
+    } else if (instanceof <AssignMasterKey>(command)) {
+      accounts.insert(static_cast<const AssignMasterKey&>(command).account_id);
+    } else if (instanceof <SetAccountPermissions>(command)) {
+      accounts.insert(
+          static_cast<const SetAccountPermissions&>(command).account_id);
+    } else if (instanceof <SetQuorum>(command)) {
+      accounts.insert(static_cast<const SetQuorum&>(command).account_id);
+    } else if (instanceof <CreateAccount>(command)) {
+      auto& create = static_cast<const CreateAccount&>(command);
+      accounts.insert(create.account_name + "@" + create.domain_id);
+    } else if (not(instanceof <AddPeer>(command)
+                   or instanceof <CreateAsset>(command)
+                   or instanceof <CreateDomain>(command))) {
+      return false;
+    }
+    return true;
+  }
+
+  struct PinnedVersion;
+
+  // set while calling thread executes a batch
+  thread_local const PinnedVersion* pinned_version = nullptr;
+
+  /**
+   * Cache version when batch executed by calling thread pinned its state
+   */
+  struct PinnedVersion {
+    PinnedVersion(const void* factory, uint64_t version)
+        : factory(factory), version(version) {
+      pinned_version = this;
+    }
+
+    ~PinnedVersion() { pinned_version = nullptr; }
+
+    const void* factory;
+    uint64_t version;
+  };
+}  // namespace
+
+constexpr size_t iroha::model::QueryProcessingFactory::kMaxCachedEntries;
+
 iroha::model::QueryProcessingFactory::QueryProcessingFactory(
     std::shared_ptr<ametsuchi::WsvQuery> wsvQuery,
-    std::shared_ptr<ametsuchi::BlockQuery> blockQuery)
-    : _wsvQuery(wsvQuery), _blockQuery(blockQuery) {}
+    std::shared_ptr<ametsuchi::BlockQuery> blockQuery,
+    bool cache_results,
+    std::shared_ptr<ametsuchi::SnapshotPinFactory> snapshots)
+    : _wsvQuery(wsvQuery),
+      _blockQuery(blockQuery),
+      snapshots_(snapshots),
+      cache_results_(cache_results) {}
 
-bool iroha::model::QueryProcessingFactory::validate(
-    const model::GetAccount& query) {
-  auto creator = _wsvQuery->getAccount(query.creator_account_id);
+void iroha::model::QueryProcessingFactory::invalidate(
+    const model::Block& block) {
+  if (not cache_results_) {
+    return;
+  }
+  std::unordered_set<std::string> accounts;
+  bool known = true;
+  for (const auto& tx : block.transactions) {
+    for (const auto& command : tx.commands) {
+      known = known and touchedAccounts(*command, accounts);
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  ++cache_version_;
+  if (not known) {
+    accounts_.clear();
+    signatories_.clear();
+    account_assets_.clear();
+    return;
+  }
+  for (const auto& account : accounts) {
+    accounts_.erase(account);
+    signatories_.erase(account);
+    auto assets = account_assets_.lower_bound({account, ""});
+    while (assets != account_assets_.end()
+           and assets->first.first == account) {
+      assets = account_assets_.erase(assets);
+    }
+  }
+}
+
+template <typename Cache, typename Read>
+typename Cache::mapped_type iroha::model::QueryProcessingFactory::cached(
+    Cache& cache, const typename Cache::key_type& key, Read read) {
+  if (not cache_results_) {
+    return read();
+  }
+  uint64_t version;
+  {
+    std::unique_lock<std::mutex> lock(cache_mutex_);
+    // entries cached after a commit are newer than state pinned by batch
+    if (pinned_version and pinned_version->factory == this
+        and pinned_version->version != cache_version_) {
+      lock.unlock();
+      return read();
+    }
+    auto it = cache.find(key);
+    if (it != cache.end()) {
+      return it->second;
+    }
+    version = cache_version_;
+  }
+  auto value = read();
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  // value read before the last commit may be already outdated
+  if (version == cache_version_) {
+    if (cache.size() >= kMaxCachedEntries) {
+      cache.clear();
+    }
+    cache.emplace(key, value);
+  }
+  return value;
+}
+
+nonstd::optional<iroha::model::Account>
+iroha::model::QueryProcessingFactory::getAccount(
+    const std::string& account_id) {
+  return cached(accounts_, account_id,
+                [&] { return _wsvQuery->getAccount(account_id); });
+}
+
+nonstd::optional<std::vector<iroha::ed25519::pubkey_t>>
+iroha::model::QueryProcessingFactory::getSignatories(
+    const std::string& account_id) {
+  return cached(signatories_, account_id,
+                [&] { return _wsvQuery->getSignatories(account_id); });
+}
+
+nonstd::optional<iroha::model::AccountAsset>
+iroha::model::QueryProcessingFactory::getAccountAsset(
+    const std::string& account_id, const std::string& asset_id) {
+  return cached(account_assets_, {account_id, asset_id}, [&] {
+    return _wsvQuery->getAccountAsset(account_id, asset_id);
+  });
+}
+
+iroha::model::QueryProcessingFactory::QueryContext
+iroha::model::QueryProcessingFactory::makeContext(const model::Query& query) {
+  return {query.creator_account_id, getAccount(query.creator_account_id)};
+}
+
+nonstd::optional<iroha::model::Account>
+iroha::model::QueryProcessingFactory::account(const QueryContext& context,
+                                              const std::string& account_id) {
+  if (account_id == context.creator_account_id) {
+    return context.creator;
+  }
+  return getAccount(account_id);
+}
+
+bool iroha::model::QueryProcessingFactory::canRead(
+    const QueryContext& context, const std::string& account_id) {
   // TODO: check signatures
   return
       // Creator account exits
-      creator.has_value() &&
+      context.creator.has_value() &&
       // Creator has permission to read, or account = creator
-      (creator.value().permissions.read_all_accounts ||
-       query.account_id == query.creator_account_id);
+      (context.creator->permissions.read_all_accounts ||
+       account_id == context.creator_account_id);
 }
 
 bool iroha::model::QueryProcessingFactory::validate(
-    const model::GetSignatories& query) {
-  auto creator = _wsvQuery->getAccount(query.creator_account_id);
-  return
-      // Creator account exits
-      creator.has_value() &&
-      // Creator has permission to read, or account = creator
-      (creator.value().permissions.read_all_accounts ||
-       query.account_id == query.creator_account_id);
+    const model::GetAccount& query, const QueryContext& context) {
+  return canRead(context, query.account_id);
 }
 
 bool iroha::model::QueryProcessingFactory::validate(
-    const model::GetAccountAssets& query) {
-  auto creator = _wsvQuery->getAccount(query.creator_account_id);
-  return
-      // Creator account exits
-      creator.has_value() &&
-      // Creator has permission to read, or account = creator
-      (creator.value().permissions.read_all_accounts ||
-       query.account_id == query.creator_account_id);
+    const model::GetSignatories& query, const QueryContext& context) {
+  return canRead(context, query.account_id);
 }
 
 bool iroha::model::QueryProcessingFactory::validate(
-    const model::GetAccountTransactions& query) {
-  auto creator = _wsvQuery->getAccount(query.creator_account_id);
-  return
-      // Creator account exits
-      creator.has_value() &&
-      // Creator has permission to read, or account = creator
-      (creator.value().permissions.read_all_accounts ||
-       query.account_id == query.creator_account_id);
+    const model::GetAccountAssets& query, const QueryContext& context) {
+  return canRead(context, query.account_id);
 }
 
 bool iroha::model::QueryProcessingFactory::validate(
-    const model::GetAccountAssetTransactions& query) {
-  auto creator = _wsvQuery->getAccount(query.creator_account_id);
-  return
-      // Creator account exits
-      creator.has_value() &&
-      // Creator has permission to read, or account = creator
-      (creator.value().permissions.read_all_accounts ||
-       query.account_id == query.creator_account_id);
+    const model::GetAccountAssetList& query, const QueryContext& context) {
+  return canRead(context, query.account_id);
+}
+
+bool iroha::model::QueryProcessingFactory::validate(
+    const model::GetAccountTransactions& query, const QueryContext& context) {
+  return canRead(context, query.account_id);
+}
+
+bool iroha::model::QueryProcessingFactory::validate(
+    const model::GetAccountAssetTransactions& query,
+    const QueryContext& context) {
+  return canRead(context, query.account_id);
+}
+
+bool iroha::model::QueryProcessingFactory::validate(
+    const model::GetTransaction& query, const QueryContext& context) {
+  // access to the transaction itself is checked on execution
+  return context.creator.has_value();
+}
+
+bool iroha::model::QueryProcessingFactory::validate(
+    const model::GetAssetTransfers& query, const QueryContext& context) {
+  // transfers of all accounts are read
+  return context.creator.has_value()
+      and context.creator->permissions.read_all_accounts;
+}
+
+bool iroha::model::QueryProcessingFactory::validate(
+    const model::GetAssetHolders& query, const QueryContext& context) {
+  // balances of all accounts are read
+  return context.creator.has_value()
+      and context.creator->permissions.read_all_accounts;
+}
+
+bool iroha::model::QueryProcessingFactory::validate(
+    const model::GetDomainAccounts& query, const QueryContext& context) {
+  return context.creator.has_value()
+      and context.creator->permissions.read_all_accounts;
+}
+
+bool iroha::model::QueryProcessingFactory::validate(
+    const model::GetAccountsBySignatory& query, const QueryContext& context) {
+  return context.creator.has_value()
+      and context.creator->permissions.read_all_accounts;
+}
+
+bool iroha::model::QueryProcessingFactory::validate(
+    const model::GetStateRoot& query, const QueryContext& context) {
+  // root tells nothing about particular accounts
+  return context.creator.has_value();
 }
 
 std::shared_ptr<iroha::model::QueryResponse>
 iroha::model::QueryProcessingFactory::executeGetAccount(
-    const model::GetAccount& query) {
-  auto acc = _wsvQuery->getAccount(query.account_id);
+    const model::GetAccount& query, const QueryContext& context) {
+  auto acc = account(context, query.account_id);
   if (!acc.has_value()) {
     iroha::model::ErrorResponse response;
     response.query_hash = query.query_hash;
@@ -102,14 +388,13 @@ iroha::model::QueryProcessingFactory::executeGetAccount(
 std::shared_ptr<iroha::model::QueryResponse>
 iroha::model::QueryProcessingFactory::executeGetAccountAssets(
     const model::GetAccountAssets& query) {
-  auto acct_asset = _wsvQuery->getAccountAsset(query.account_id, query.asset_id);
+  auto acct_asset = getAccountAsset(query.account_id, query.asset_id);
   if (!acct_asset.has_value()) {
     iroha::model::ErrorResponse response;
     response.query_hash = query.query_hash;
     response.reason = iroha::model::ErrorResponse::NO_ACCOUNT_ASSETS;
     return std::make_shared<iroha::model::ErrorResponse>(response);
   }
-  auto asset = _wsvQuery->getAsset(query.asset_id);
   // TODO: Add format with precision balance
   iroha::model::AccountAssetResponse response;
   response.acct_asset = acct_asset.value();
@@ -117,20 +402,131 @@ iroha::model::QueryProcessingFactory::executeGetAccountAssets(
   return std::make_shared<iroha::model::AccountAssetResponse>(response);
 }
 
+std::shared_ptr<iroha::model::QueryResponse>
+iroha::model::QueryProcessingFactory::executeGetAccountAssetList(
+    const model::GetAccountAssetList& query) {
+  // one range read of account assets, instead of a query per asset
+  auto assets = _wsvQuery->getAccountAssets(query.account_id,
+                                            query.pagination.after_asset_id,
+                                            query.pagination.page_size);
+  if (not assets) {
+    iroha::model::ErrorResponse response;
+    response.query_hash = query.query_hash;
+    response.reason = iroha::model::ErrorResponse::NO_ACCOUNT_ASSETS;
+    return std::make_shared<iroha::model::ErrorResponse>(response);
+  }
+  iroha::model::AccountAssetsResponse response;
+  response.query_hash = query.query_hash;
+  response.account_assets = std::move(*assets);
+  if (query.pagination.page_size != 0
+      and response.account_assets.size() == query.pagination.page_size) {
+    response.next_asset_id = response.account_assets.back().asset_id;
+  }
+  return std::make_shared<iroha::model::AccountAssetsResponse>(response);
+}
+
+std::shared_ptr<iroha::model::QueryResponse>
+iroha::model::QueryProcessingFactory::executeGetAssetHolders(
+    const model::GetAssetHolders& query) {
+  // range of the index of holders by asset
+  auto holders = _wsvQuery->getAssetHolders(query.asset_id,
+                                            query.pagination.after_account_id,
+                                            query.pagination.page_size);
+  if (not holders) {
+    iroha::model::ErrorResponse response;
+    response.query_hash = query.query_hash;
+    response.reason = iroha::model::ErrorResponse::NO_ACCOUNT_ASSETS;
+    return std::make_shared<iroha::model::ErrorResponse>(response);
+  }
+  iroha::model::AssetHoldersResponse response;
+  response.query_hash = query.query_hash;
+  response.account_assets = std::move(*holders);
+  if (query.pagination.page_size != 0
+      and response.account_assets.size() == query.pagination.page_size) {
+    response.next_account_id = response.account_assets.back().account_id;
+  }
+  return std::make_shared<iroha::model::AssetHoldersResponse>(response);
+}
+
+std::shared_ptr<iroha::model::QueryResponse>
+iroha::model::QueryProcessingFactory::executeGetDomainAccounts(
+    const model::GetDomainAccounts& query) {
+  auto accounts = _wsvQuery->getDomainAccounts(
+      query.domain_id,
+      query.pagination.after_account_id,
+      query.pagination.page_size);
+  if (not accounts) {
+    iroha::model::ErrorResponse response;
+    response.query_hash = query.query_hash;
+    response.reason = iroha::model::ErrorResponse::NO_ACCOUNT;
+    return std::make_shared<iroha::model::ErrorResponse>(response);
+  }
+  iroha::model::AccountsResponse response;
+  response.query_hash = query.query_hash;
+  response.accounts = std::move(*accounts);
+  if (query.pagination.page_size != 0
+      and response.accounts.size() == query.pagination.page_size) {
+    response.next_account_id = response.accounts.back().account_id;
+  }
+  return std::make_shared<iroha::model::AccountsResponse>(response);
+}
+
+std::shared_ptr<iroha::model::QueryResponse>
+iroha::model::QueryProcessingFactory::executeGetAccountsBySignatory(
+    const model::GetAccountsBySignatory& query) {
+  auto account_ids = _wsvQuery->getAccountsBySignatory(
+      query.signatory,
+      query.pagination.after_account_id,
+      query.pagination.page_size);
+  if (not account_ids) {
+    iroha::model::ErrorResponse response;
+    response.query_hash = query.query_hash;
+    response.reason = iroha::model::ErrorResponse::NO_ACCOUNT;
+    return std::make_shared<iroha::model::ErrorResponse>(response);
+  }
+  iroha::model::AccountIdsResponse response;
+  response.query_hash = query.query_hash;
+  response.account_ids = std::move(*account_ids);
+  if (query.pagination.page_size != 0
+      and response.account_ids.size() == query.pagination.page_size) {
+    response.next_account_id = response.account_ids.back();
+  }
+  return std::make_shared<iroha::model::AccountIdsResponse>(response);
+}
+
+std::shared_ptr<iroha::model::QueryResponse>
+iroha::model::QueryProcessingFactory::executeGetStateRoot(
+    const model::GetStateRoot& query) {
+  auto root = _blockQuery->getStateRoot();
+  if (not root) {
+    iroha::model::ErrorResponse response;
+    response.query_hash = query.query_hash;
+    response.reason = model::ErrorResponse::NOT_SUPPORTED;
+    return std::make_shared<iroha::model::ErrorResponse>(response);
+  }
+  iroha::model::StateRootResponse response;
+  response.query_hash = query.query_hash;
+  response.height = root->height;
+  response.root = root->root;
+  return std::make_shared<iroha::model::StateRootResponse>(response);
+}
+
 std::shared_ptr<iroha::model::QueryResponse>
 iroha::model::QueryProcessingFactory::executeGetAccountAssetTransactions(
     const model::GetAccountAssetTransactions& query) {
-  // auto acc_asset_tx = _blockQuery.
-  // TODO: implement
-  iroha::model::ErrorResponse response;
-  response.query_hash = query.query_hash;
-  response.reason = ErrorResponse::NOT_SUPPORTED;
-  return std::make_shared<iroha::model::ErrorResponse>(response);
+  auto acc_asset_tx = _blockQuery->getAccountAssetTransactions(
+      query.account_id, query.asset_id, query.pagination);
+  return transactionsPage(acc_asset_tx, query.pagination, query.query_hash);
 }
 
 std::shared_ptr<iroha::model::QueryResponse>
 iroha::model::QueryProcessingFactory::executeGetAccountTransactions(
     const model::GetAccountTransactions& query) {
+  if (query.pagination.page_size != 0 or query.pagination.after) {
+    auto acc_tx = _blockQuery->getAccountTransactions(query.account_id,
+                                                      query.pagination);
+    return transactionsPage(acc_tx, query.pagination, query.query_hash);
+  }
   auto acc_tx = _blockQuery->getAccountTransactions(query.account_id);
   iroha::model::TransactionsResponse response;
   response.query_hash = query.query_hash;
@@ -138,10 +534,52 @@ iroha::model::QueryProcessingFactory::executeGetAccountTransactions(
   return std::make_shared<iroha::model::TransactionsResponse>(response);
 }
 
+std::shared_ptr<iroha::model::QueryResponse>
+iroha::model::QueryProcessingFactory::executeGetTransaction(
+    const model::GetTransaction& query, const QueryContext& context) {
+  const auto& creator = context.creator;
+  auto tx = _blockQuery->getTransaction(query.tx_hash);
+  if (not tx) {
+    iroha::model::ErrorResponse response;
+    response.query_hash = query.query_hash;
+    response.reason = ErrorResponse::NO_TRANSACTION;
+    return std::make_shared<iroha::model::ErrorResponse>(response);
+  }
+  // Creator has permission to read, or transaction is created by creator
+  if (not creator or
+      (not creator->permissions.read_all_accounts and
+       tx->transaction.creator_account_id != query.creator_account_id)) {
+    iroha::model::ErrorResponse response;
+    response.query_hash = query.query_hash;
+    response.reason = ErrorResponse::STATEFUL_INVALID;
+    return std::make_shared<iroha::model::ErrorResponse>(response);
+  }
+  iroha::model::TransactionResponse response;
+  response.query_hash = query.query_hash;
+  response.transaction = tx->transaction;
+  response.height = tx->height;
+  response.index = tx->index;
+  if (query.with_proof) {
+    response.proof = _blockQuery->getInclusionProof(*tx);
+  }
+  return std::make_shared<iroha::model::TransactionResponse>(response);
+}
+
+std::shared_ptr<iroha::model::QueryResponse>
+iroha::model::QueryProcessingFactory::executeGetAssetTransfers(
+    const model::GetAssetTransfers& query) {
+  auto transfers = _blockQuery->getAssetTransfers(query.asset_id,
+                                                  query.from_height,
+                                                  query.to_height,
+                                                  query.min_amount,
+                                                  query.pagination);
+  return transactionsPage(transfers, query.pagination, query.query_hash);
+}
+
 std::shared_ptr<iroha::model::QueryResponse>
 iroha::model::QueryProcessingFactory::executeGetSignatories(
     const model::GetSignatories& query) {
-  auto signs = _wsvQuery->getSignatories(query.account_id);
+  auto signs = getSignatories(query.account_id);
   if (!signs.has_value()) {
     iroha::model::ErrorResponse response;
     response.query_hash = query.query_hash;
@@ -157,21 +595,68 @@ iroha::model::QueryProcessingFactory::executeGetSignatories(
 std::shared_ptr<iroha::model::QueryResponse>
 iroha::model::QueryProcessingFactory::execute(
     std::shared_ptr<const model::Query> query) {
+  iroha::metrics::ScopedTimer timer(queryLatency(*query));
+  std::shared_ptr<iroha::model::QueryResponse> response;
+  if (instanceof <iroha::model::QueryBatch>(query.get())) {
+    response =
+        executeQueryBatch(static_cast<const iroha::model::QueryBatch&>(*query));
+  } else {
+    response = executeQuery(query, makeContext(*query));
+  }
+  response->mask = query->mask;
+  return response;
+}
+
+std::shared_ptr<iroha::model::QueryResponse>
+iroha::model::QueryProcessingFactory::executeQueryBatch(
+    const model::QueryBatch& batch) {
+  uint64_t version;
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    version = cache_version_;
+  }
+  PinnedVersion pinned(this, version);
+  std::unique_ptr<ametsuchi::SnapshotPin> pin;
+  if (snapshots_) {
+    pin = snapshots_->pinSnapshot();
+  }
+
+  // creator is read and checked once for all queries
+  auto context = makeContext(batch);
+  if (not context.creator) {
+    iroha::model::ErrorResponse response;
+    response.query_hash = batch.query_hash;
+    response.reason = model::ErrorResponse::STATEFUL_INVALID;
+    return std::make_shared<iroha::model::ErrorResponse>(response);
+  }
+  iroha::model::QueryBatchResponse response;
+  response.query_hash = batch.query_hash;
+  for (const auto& query : batch.queries) {
+    auto nested = executeQuery(query, context);
+    nested->mask = query->mask;
+    response.responses.push_back(nested);
+  }
+  return std::make_shared<iroha::model::QueryBatchResponse>(response);
+}
+
+std::shared_ptr<iroha::model::QueryResponse>
+iroha::model::QueryProcessingFactory::executeQuery(
+    std::shared_ptr<const model::Query> query, const QueryContext& context) {
   if (instanceof <iroha::model::GetAccount>(query.get())) {
     auto qry = std::static_pointer_cast<const iroha::model::GetAccount>(query);
 
-    if (!validate(*qry)) {
+    if (!validate(*qry, context)) {
       iroha::model::ErrorResponse response;
       response.query_hash = qry->query_hash;
       response.reason = model::ErrorResponse::STATEFUL_INVALID;
       return std::make_shared<ErrorResponse>(response);
     }
-    return executeGetAccount(*qry);
+    return executeGetAccount(*qry, context);
   }
   if (instanceof <iroha::model::GetAccountAssets>(query.get())) {
     auto qry =
         std::static_pointer_cast<const iroha::model::GetAccountAssets>(query);
-    if (!validate(*qry)) {
+    if (!validate(*qry, context)) {
       iroha::model::ErrorResponse response;
       response.query_hash = qry->query_hash;
       response.reason = model::ErrorResponse::STATEFUL_INVALID;
@@ -179,10 +664,22 @@ iroha::model::QueryProcessingFactory::execute(
     }
     return executeGetAccountAssets(*qry);
   }
+  if (instanceof <iroha::model::GetAccountAssetList>(query.get())) {
+    auto qry =
+        std::static_pointer_cast<const iroha::model::GetAccountAssetList>(
+            query);
+    if (!validate(*qry, context)) {
+      iroha::model::ErrorResponse response;
+      response.query_hash = qry->query_hash;
+      response.reason = model::ErrorResponse::STATEFUL_INVALID;
+      return std::make_shared<iroha::model::ErrorResponse>(response);
+    }
+    return executeGetAccountAssetList(*qry);
+  }
   if (instanceof <iroha::model::GetSignatories>(query.get())) {
     auto qry =
         std::static_pointer_cast<const iroha::model::GetSignatories>(query);
-    if (!validate(*qry)) {
+    if (!validate(*qry, context)) {
       iroha::model::ErrorResponse response;
       response.query_hash = qry->query_hash;
       response.reason = model::ErrorResponse::STATEFUL_INVALID;
@@ -194,7 +691,7 @@ iroha::model::QueryProcessingFactory::execute(
     auto qry =
         std::static_pointer_cast<const iroha::model::GetAccountTransactions>(
             query);
-    if (!validate(*qry)) {
+    if (!validate(*qry, context)) {
       iroha::model::ErrorResponse response;
       response.query_hash = qry->query_hash;
       response.reason = model::ErrorResponse::STATEFUL_INVALID;
@@ -205,7 +702,7 @@ iroha::model::QueryProcessingFactory::execute(
   if (instanceof <iroha::model::GetAccountAssetTransactions>(query.get())) {
     auto qry = std::static_pointer_cast<
         const iroha::model::GetAccountAssetTransactions>(query);
-    if (!validate(*qry)) {
+    if (!validate(*qry, context)) {
       iroha::model::ErrorResponse response;
       response.query_hash = qry->query_hash;
       response.reason = model::ErrorResponse::STATEFUL_INVALID;
@@ -213,6 +710,73 @@ iroha::model::QueryProcessingFactory::execute(
     }
     return executeGetAccountAssetTransactions(*qry);
   }
+  if (instanceof <iroha::model::GetTransaction>(query.get())) {
+    auto qry =
+        std::static_pointer_cast<const iroha::model::GetTransaction>(query);
+    if (!validate(*qry, context)) {
+      iroha::model::ErrorResponse response;
+      response.query_hash = qry->query_hash;
+      response.reason = model::ErrorResponse::STATEFUL_INVALID;
+      return std::make_shared<iroha::model::ErrorResponse>(response);
+    }
+    return executeGetTransaction(*qry, context);
+  }
+  if (instanceof <iroha::model::GetAssetTransfers>(query.get())) {
+    auto qry =
+        std::static_pointer_cast<const iroha::model::GetAssetTransfers>(query);
+    if (!validate(*qry, context)) {
+      iroha::model::ErrorResponse response;
+      response.query_hash = qry->query_hash;
+      response.reason = model::ErrorResponse::STATEFUL_INVALID;
+      return std::make_shared<iroha::model::ErrorResponse>(response);
+    }
+    return executeGetAssetTransfers(*qry);
+  }
+  if (instanceof <iroha::model::GetAssetHolders>(query.get())) {
+    auto qry =
+        std::static_pointer_cast<const iroha::model::GetAssetHolders>(query);
+    if (!validate(*qry, context)) {
+      iroha::model::ErrorResponse response;
+      response.query_hash = qry->query_hash;
+      response.reason = model::ErrorResponse::STATEFUL_INVALID;
+      return std::make_shared<iroha::model::ErrorResponse>(response);
+    }
+    return executeGetAssetHolders(*qry);
+  }
+  if (instanceof <iroha::model::GetDomainAccounts>(query.get())) {
+    auto qry =
+        std::static_pointer_cast<const iroha::model::GetDomainAccounts>(query);
+    if (!validate(*qry, context)) {
+      iroha::model::ErrorResponse response;
+      response.query_hash = qry->query_hash;
+      response.reason = model::ErrorResponse::STATEFUL_INVALID;
+      return std::make_shared<iroha::model::ErrorResponse>(response);
+    }
+    return executeGetDomainAccounts(*qry);
+  }
+  if (instanceof <iroha::model::GetAccountsBySignatory>(query.get())) {
+    auto qry =
+        std::static_pointer_cast<const iroha::model::GetAccountsBySignatory>(
+            query);
+    if (!validate(*qry, context)) {
+      iroha::model::ErrorResponse response;
+      response.query_hash = qry->query_hash;
+      response.reason = model::ErrorResponse::STATEFUL_INVALID;
+      return std::make_shared<iroha::model::ErrorResponse>(response);
+    }
+    return executeGetAccountsBySignatory(*qry);
+  }
+  if (instanceof <iroha::model::GetStateRoot>(query.get())) {
+    auto qry =
+        std::static_pointer_cast<const iroha::model::GetStateRoot>(query);
+    if (!validate(*qry, context)) {
+      iroha::model::ErrorResponse response;
+      response.query_hash = qry->query_hash;
+      response.reason = model::ErrorResponse::STATEFUL_INVALID;
+      return std::make_shared<iroha::model::ErrorResponse>(response);
+    }
+    return executeGetStateRoot(*qry);
+  }
   iroha::model::ErrorResponse response;
   response.query_hash = query->query_hash;
   response.reason = model::ErrorResponse::NOT_SUPPORTED;
@@ -224,6 +224,10 @@ namespace iroha {
       // Amount is formed wrong
       if (amount.get_frac_number() > asset.value().precision) return false;
 
+      uint64_t quantity;
+      if (not amount.get_joint_amount(asset.value().precision, quantity))
+        return false;
+
       auto account_asset = queries.getAccountAsset(src_account_id, asset_id);
 
       return
@@ -231,8 +235,7 @@ namespace iroha {
           // Check if dest account exist
           queries.getAccount(dest_account_id) and
           // Balance in your wallet should be at least amount of transfer
-          account_asset.value().balance >=
-              amount.get_joint_amount(asset.value().precision);
+          account_asset.value().balance >= quantity;
     }
 
   }  // namespace model
@@ -0,0 +1,46 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_INCLUSION_PROOF_HPP
+#define IROHA_INCLUSION_PROOF_HPP
+
+#include "model/block.hpp"
+#include "model/merkle_tree.hpp"
+
+namespace iroha {
+  namespace model {
+
+    /**
+     * Proof that transaction is included into committed block. Thin client
+     * checks signatures of peers over hash of the header, then that path
+     * leads from hash of the transaction to merkle root of the header.
+     */
+    struct InclusionProof {
+      /**
+       * Block without transactions: fields covered by its hash and
+       * signatures of peers
+       */
+      Block header;
+
+      /**
+       * Path from hash of the transaction to merkle root of the block
+       */
+      MerkleTree::Proof path;
+    };
+  }  // namespace model
+}  // namespace iroha
+#endif  // IROHA_INCLUSION_PROOF_HPP
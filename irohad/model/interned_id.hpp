@@ -0,0 +1,93 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_INTERNED_ID_HPP
+#define IROHA_INTERNED_ID_HPP
+
+#include <functional>
+#include <nonstd/optional.hpp>
+#include <string>
+
+namespace iroha {
+  namespace model {
+
+    /**
+     * Identifier of account, asset or domain kept once in global intern
+     * table. Handle is a pointer to the table entry, so copies, equality and
+     * hash cost as much as for a pointer, and the string is read in place.
+     * Entries are never removed, so only identifiers known to exist should
+     * be interned, others are looked up with find().
+     * Order of identifiers is order of their entries, it is stable within
+     * process only
+     */
+    class InternedId {
+     public:
+      /**
+       * Empty identifier
+       */
+      InternedId();
+
+      /**
+       * Find identifier in the table or add it, safe from any thread
+       */
+      explicit InternedId(const std::string &id);
+
+      /**
+       * Find identifier without adding it to the table
+       * @return identifier if it is interned, nullopt otherwise
+       */
+      static nonstd::optional<InternedId> find(const std::string &id);
+
+      const std::string &str() const {
+        return *entry_;
+      }
+
+      bool operator==(const InternedId &rhs) const {
+        return entry_ == rhs.entry_;
+      }
+
+      bool operator!=(const InternedId &rhs) const {
+        return entry_ != rhs.entry_;
+      }
+
+      bool operator<(const InternedId &rhs) const {
+        return std::less<const std::string *>()(entry_, rhs.entry_);
+      }
+
+      size_t hash() const {
+        return std::hash<const std::string *>()(entry_);
+      }
+
+     private:
+      explicit InternedId(const std::string *entry) : entry_(entry) {}
+
+      const std::string *entry_;
+    };
+
+  }  // namespace model
+}  // namespace iroha
+
+namespace std {
+  template <>
+  struct hash<iroha::model::InternedId> {
+    size_t operator()(const iroha::model::InternedId &id) const {
+      return id.hash();
+    }
+  };
+}  // namespace std
+
+#endif  // IROHA_INTERNED_ID_HPP
@@ -0,0 +1,94 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_MERKLE_TREE_HPP
+#define IROHA_MERKLE_TREE_HPP
+
+#include <nonstd/optional.hpp>
+#include <vector>
+#include "common/types.hpp"
+#include "crypto/merkle.hpp"
+
+namespace iroha {
+  namespace model {
+
+    /**
+     * Binary hash tree which is built incrementally from leaf hashes.
+     * Node without sibling is promoted to the next level unchanged.
+     * Complete nodes of every level are kept, so appending a leaf,
+     * computing root and making inclusion proof take O(log n) hashes.
+     */
+    class MerkleTree {
+     public:
+      using ProofStep = MerkleStep;
+
+      using Proof = MerklePath;
+
+      /**
+       * Make tree of given leaves
+       */
+      static MerkleTree build(const std::vector<hash256_t> &leaves);
+
+      /**
+       * Check that leaf belongs to tree with given root, see
+       * iroha::verify_merkle_path
+       * @param leaf - hash of leaf
+       * @param proof - path made by proof()
+       * @param root - expected root of tree
+       * @return true if path leads from leaf to root
+       */
+      static bool verify(const hash256_t &leaf,
+                         const Proof &proof,
+                         const hash256_t &root);
+
+      /**
+       * Append leaf to the right edge of tree
+       */
+      void append(const hash256_t &leaf);
+
+      /**
+       * @return root of tree, zero hash if tree is empty
+       */
+      hash256_t root() const;
+
+      /**
+       * @return number of leaves
+       */
+      size_t size() const;
+
+      /**
+       * Make inclusion proof of leaf
+       * @param index - position of leaf
+       * @return path from leaf to root, nullopt if index is out of range
+       */
+      nonstd::optional<Proof> proof(size_t index) const;
+
+     private:
+      /**
+       * Hashes of incomplete right subtrees: element l follows all
+       * complete nodes of level l, there are levels_.size() + 1 elements
+       */
+      std::vector<nonstd::optional<hash256_t>> partials() const;
+
+      // complete nodes by level, level 0 contains leaves
+      std::vector<std::vector<hash256_t>> levels_;
+    };
+
+  }  // namespace model
+}  // namespace iroha
+
+#endif  // IROHA_MERKLE_TREE_HPP
@@ -17,33 +17,65 @@
 
 #include <model/model_crypto_provider_impl.hpp>
 #include <model/model_hash_provider_impl.hpp>
+#include <algorithm>
 
 namespace iroha {
   namespace model {
 
+    nonstd::optional<SignatureCheck> parseSignatureCheck(
+        const std::string &name) {
+      if (name == "none") {
+        return SignatureCheck::None;
+      }
+      if (name == "serial") {
+        return SignatureCheck::Serial;
+      }
+      if (name == "parallel") {
+        return SignatureCheck::Parallel;
+      }
+      if (name == "cached") {
+        return SignatureCheck::Cached;
+      }
+      return nonstd::nullopt;
+    }
+
+    ModelCryptoProviderImpl::ModelCryptoProviderImpl(
+        SignatureCheck check, std::shared_ptr<SignatureCache> cache)
+        : check_(check), cache_(std::move(cache)) {}
+
     bool ModelCryptoProviderImpl::verify(const Transaction &tx) const {
+      if (check_ == SignatureCheck::None) {
+        return true;
+      }
       HashProviderImpl hash_provider;
       auto tx_hash = hash_provider.get_hash(tx);
 
       if (tx.signatures.size() == 0) return false;
 
-      for (auto sign : tx.signatures) {
-        auto verified = iroha::verify(tx_hash.data(), tx_hash.size(),
-                                      sign.pubkey, sign.signature);
-        if (!verified) return false;
+      std::vector<SignedMessage> batch;
+      batch.reserve(tx.signatures.size());
+      for (const auto &sign : tx.signatures) {
+        batch.push_back(
+            {tx_hash.data(), tx_hash.size(), sign.pubkey, sign.signature});
       }
-      return true;
+      return verifyAll(batch);
     }
 
     bool ModelCryptoProviderImpl::verify(std::shared_ptr<const Query> query) const {
+      if (check_ == SignatureCheck::None) {
+        return true;
+      }
       HashProviderImpl hashProvider;
       auto query_hash = hashProvider.get_hash(query);
-      auto sign = query->signature;
+      const auto &sign = query->signature;
       return iroha::verify(query_hash.data(), query_hash.size(), sign.pubkey,
                            sign.signature);
     }
 
     bool ModelCryptoProviderImpl::verify(const Block &block) const {
+      if (check_ == SignatureCheck::None) {
+        return true;
+      }
       HashProviderImpl hashProvider;
       auto block_hash = hashProvider.get_hash(block);
 
@@ -51,12 +83,32 @@ namespace iroha {
         return false;
       }
 
-      for (auto sign : block.sigs) {
-        auto verified = iroha::verify(block_hash.data(), block_hash.size(),
-                                      sign.pubkey, sign.signature);
-        if (!verified) return false;
+      std::vector<SignedMessage> batch;
+      batch.reserve(block.sigs.size());
+      for (const auto &sign : block.sigs) {
+        batch.push_back({block_hash.data(), block_hash.size(), sign.pubkey,
+                         sign.signature});
+      }
+      return verifyAll(batch);
+    }
+
+    bool ModelCryptoProviderImpl::verifyAll(
+        const std::vector<SignedMessage> &batch) const {
+      switch (check_) {
+        case SignatureCheck::None:
+          return true;
+        case SignatureCheck::Serial:
+          return std::all_of(
+              batch.begin(), batch.end(), [](const auto &item) {
+                return iroha::verify(
+                    item.msg, item.msgsize, item.pub, item.sig);
+              });
+        case SignatureCheck::Parallel:
+          return verify_batch(batch);
+        case SignatureCheck::Cached:
+          return cache_->verify_quorum(batch, batch.size());
       }
-      return true;
+      return false;
     }
   }
 }
@@ -18,20 +18,65 @@
 #ifndef IROHA_MODEL_CRYPTO_PROVIDER_IMPL_HPP
 #define IROHA_MODEL_CRYPTO_PROVIDER_IMPL_HPP
 
+#include <crypto/signature_cache.hpp>
+#include <memory>
 #include <model/model_crypto_provider.hpp>
 #include <model/model_hash_provider.hpp>
+#include <nonstd/optional.hpp>
+#include <string>
 
 namespace iroha {
   namespace model {
 
+    /**
+     * How signatures of transactions and blocks are checked
+     */
+    enum class SignatureCheck {
+      // every signature is accepted, for trusted test networks
+      None,
+      // signatures are verified one by one
+      Serial,
+      // signatures of one transaction or block are verified in parallel
+      Parallel,
+      // as Parallel, skipping signatures already found valid, so
+      // transaction checked at Torii is not checked again in its block
+      Cached
+    };
+
+    /**
+     * Parse name of signature check
+     * @param name - "none", "serial", "parallel" or "cached"
+     * @return check, or nullopt for unknown name
+     */
+    nonstd::optional<SignatureCheck> parseSignatureCheck(
+        const std::string &name);
+
     class ModelCryptoProviderImpl : public ModelCryptoProvider {
      public:
+      /**
+       * @param check - how signatures are checked
+       * @param cache - valid signatures, shared with other providers, used
+       * by cached check
+       */
+      explicit ModelCryptoProviderImpl(
+          SignatureCheck check = SignatureCheck::Cached,
+          std::shared_ptr<SignatureCache> cache =
+              std::make_shared<SignatureCache>());
+
       bool verify(const Transaction &tx) const override;
 
       bool verify(std::shared_ptr<const Query> tx) const override;
 
       bool verify(const Block& block) const override;
 
+     private:
+      /**
+       * Verify signatures of one message according to the check
+       */
+      bool verifyAll(const std::vector<SignedMessage> &batch) const;
+
+      const SignatureCheck check_;
+      std::shared_ptr<SignatureCache> cache_;
     };
   }
 }
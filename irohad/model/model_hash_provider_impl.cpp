@@ -18,117 +18,210 @@
 #include <model/model_hash_provider_impl.hpp>
 #include <model/queries/get_account.hpp>
 #include <iostream>
+#include "block.pb.h"
 #include "common/types.hpp"
+#include "model/converters/pb_command_factory.hpp"
+#include "model/merkle_tree.hpp"
 #include "model/queries/get_account_assets.hpp"
 #include "model/queries/get_signatories.hpp"
+#include "model/queries/get_state_root.hpp"
 #include "model/queries/get_transactions.hpp"
+#include "model/queries/list_accounts.hpp"
+#include "model/queries/query_batch.hpp"
 
 namespace iroha {
   namespace model {
 
-    iroha::hash256_t HashProviderImpl::get_hash(const Proposal &proposal) {
-      std::string concat_;  // string representation of the proposal, made of
-      // proposals meta and body fields
-
-      // Append body data
-      for (auto tx : proposal.transactions) {
-        // Append each transaction hash
-        concat_ += get_hash(tx).to_string();
+    namespace {
+      std::string hashPagination(const TxPagination &pagination) {
+        std::string result = std::to_string(pagination.page_size);
+        if (pagination.after) {
+          result += std::to_string(pagination.after->height);
+          result += std::to_string(pagination.after->index);
+        }
+        return result;
       }
 
-      std::vector<uint8_t> concat(concat_.begin(), concat_.end());
-      auto concat_hash = sha3_256(concat.data(), concat.size());
-      return concat_hash;
-    }
-
-    iroha::hash256_t HashProviderImpl::get_hash(const Block &block) {
-      std::string concat_;
-
-      // Append block height
-      concat_ += std::to_string(block.height);
-
-      // Append prev_hash
-      std::copy(block.prev_hash.begin(), block.prev_hash.end(),
-                std::back_inserter(concat_));
+      std::string hashPagination(const AccountPagination &pagination) {
+        return std::to_string(pagination.page_size)
+            + pagination.after_account_id;
+      }
 
-      // Append txnumber
-      concat_ += std::to_string(block.txs_number);
+      std::string hashMask(const ResponseMask &mask) {
+        // default mask adds nothing, so hashes of such queries are unchanged
+        if (not mask.omit_permissions and not mask.omit_bodies
+            and not mask.omit_signatures) {
+          return "";
+        }
+        std::string result = "mask";
+        result += mask.omit_permissions ? '1' : '0';
+        result += mask.omit_bodies ? '1' : '0';
+        result += mask.omit_signatures ? '1' : '0';
+        return result;
+      }
 
-      // Append merkle root
-      std::copy(block.merkle_root.begin(), block.merkle_root.end(),
-                std::back_inserter(concat_));
-      // Append transactions data
-      for (auto tx : block.transactions) {
-        concat_ += get_hash(tx).to_string();
-      }
-      std::vector<uint8_t> concat(concat_.begin(), concat_.end());
+      /**
+       * Canonical encoding is protobuf encoding of meta and body, it is
+       * deterministic since the messages have no maps. The same payload
+       * identifies transactions in ordering mempool.
+       * Header with signatures is not covered, so that signatures of
+       * the hash do not change it
+       */
+      std::string canonicalPayload(const Transaction &tx) {
+        converters::PbCommandFactory factory;
+        protocol::Transaction::Meta meta;
+        meta.set_creator_account_id(tx.creator_account_id);
+        meta.set_tx_counter(tx.tx_counter);
+        protocol::Transaction::Body body;
+        body.mutable_commands()->Reserve(tx.commands.size());
+        for (const auto &command : tx.commands) {
+          auto pb_command = factory.serializeAbstractCommand(*command);
+          body.add_commands()->Swap(&pb_command);
+        }
+
+        std::string payload;
+        payload.reserve(meta.ByteSizeLong() + body.ByteSizeLong());
+        meta.AppendToString(&payload);
+        body.AppendToString(&payload);
+        return payload;
+      }
+    }  // namespace
 
-      auto concat_hash = sha3_256(concat.data(), concat.size());
-      return concat_hash;
+    iroha::hash256_t HashProviderImpl::get_hash(const Proposal &proposal) {
+      return get_merkle_root(proposal.transactions);
     }
 
-    iroha::hash256_t HashProviderImpl::get_hash(const Transaction &tx) {
-      // Resulting string for the hash
-      std::string concat_hash_commands_;
-      for (auto command : tx.commands) {
-        // convert command to blob and concat it to result string
-        std::array<char, sizeof(*command)> command_blob;
-        std::copy_n((char *)command.get(), sizeof(*command),
-                    command_blob.begin());
-        std::copy(command_blob.begin(), command_blob.end(),
-                  std::back_inserter(concat_hash_commands_));
+    iroha::hash256_t HashProviderImpl::get_merkle_root(
+        const std::vector<Transaction> &transactions) {
+      std::vector<hash256_t> leaves;
+      leaves.reserve(transactions.size());
+      // transactions without hash are hashed together
+      std::vector<size_t> missing;
+      std::vector<std::string> payloads;
+      for (const auto &tx : transactions) {
+        leaves.push_back(tx.tx_hash);
+        if (tx.tx_hash == hash256_t{}) {
+          missing.push_back(leaves.size() - 1);
+          payloads.push_back(canonicalPayload(tx));
+        }
       }
+      auto hashes = sha3_256_batch(payloads);
+      for (size_t i = 0; i < missing.size(); ++i) {
+        leaves[missing[i]] = hashes[i];
+      }
+      return MerkleTree::build(leaves).root();
+    }
 
-      concat_hash_commands_ += tx.creator_account_id;
-
+    iroha::hash256_t HashProviderImpl::get_hash(const Block &block) {
+      Sha3_256 hasher;
+      // merkle root covers transactions of the block
+      return hasher.update(std::to_string(block.height))
+          .update(block.prev_hash.data(), block.prev_hash.size())
+          .update(std::to_string(block.txs_number))
+          .update(block.merkle_root.data(), block.merkle_root.size())
+          .final();
+    }
 
-      // TODO: Decide if the header should be included
-      /*
-      for (auto sig : tx.signatures) {
-        std::copy(sig.pubkey.begin(), sig.pubkey.end(),
-                  std::back_inserter(concat_));
-        std::copy(sig.signature.begin(), sig.signature.end(),
-                  std::back_inserter(concat_));
+    iroha::hash256_t HashProviderImpl::get_hash(const Transaction &tx) {
+      // hash is computed once, when transaction enters the peer
+      if (tx.tx_hash != hash256_t{}) {
+        return tx.tx_hash;
       }
-       */
-      // Append tx counter
-      concat_hash_commands_ += tx.tx_counter;
 
-      std::vector<uint8_t> concat_hash_commands(concat_hash_commands_.begin(),
-                                                concat_hash_commands_.end());
-
-      auto concat_hash =
-          sha3_256(concat_hash_commands.data(), concat_hash_commands.size());
-      return concat_hash;
+      return Sha3_256().update(canonicalPayload(tx)).final();
     }
 
     iroha::hash256_t HashProviderImpl::get_hash(std::shared_ptr<const Query> query) {
       std::string result_hash;
-      if (instanceof <model::GetAccount>(query)) {
+      if (instanceof <model::GetAccount>(query.get())) {
         auto cast = static_cast<const GetAccount &>(*query);
         result_hash += cast.account_id;
         result_hash += cast.creator_account_id;
       }
-      if (instanceof <model::GetAccountAssets>(query)) {
+      if (instanceof <model::GetAccountAssets>(query.get())) {
         auto cast = static_cast<const GetAccountAssets &>(*query);
         result_hash += cast.account_id;
         result_hash += cast.asset_id;
         result_hash += cast.creator_account_id;
       }
-      if (instanceof <model::GetSignatories>(query)) {
+      if (instanceof <model::GetAccountAssetList>(query.get())) {
+        auto cast = static_cast<const GetAccountAssetList &>(*query);
+        result_hash += cast.account_id;
+        result_hash += std::to_string(cast.pagination.page_size);
+        result_hash += cast.pagination.after_asset_id;
+        result_hash += cast.creator_account_id;
+      }
+      if (instanceof <model::GetSignatories>(query.get())) {
         auto cast = static_cast<const GetSignatories &>(*query);
         result_hash += cast.account_id;
         result_hash += cast.creator_account_id;
       }
-      if (instanceof <model::GetAccountTransactions>(query)) {
+      if (instanceof <model::GetAccountTransactions>(query.get())) {
         auto cast = static_cast<const GetAccountTransactions &>(*query);
         result_hash += cast.account_id;
+        result_hash += hashPagination(cast.pagination);
+        result_hash += cast.creator_account_id;
+      }
+      if (instanceof <model::GetAccountAssetTransactions>(query.get())) {
+        auto cast = static_cast<const GetAccountAssetTransactions &>(*query);
+        result_hash += cast.account_id;
+        result_hash += cast.asset_id;
+        result_hash += hashPagination(cast.pagination);
+        result_hash += cast.creator_account_id;
+      }
+      if (instanceof <model::GetTransaction>(query.get())) {
+        auto cast = static_cast<const GetTransaction &>(*query);
+        result_hash += cast.tx_hash.to_string();
+        // hashes of queries without proof are unchanged
+        if (cast.with_proof) {
+          result_hash += "proof";
+        }
+        result_hash += cast.creator_account_id;
+      }
+      if (instanceof <model::GetAssetTransfers>(query.get())) {
+        auto cast = static_cast<const GetAssetTransfers &>(*query);
+        result_hash += cast.asset_id;
+        result_hash += std::to_string(cast.from_height);
+        result_hash += std::to_string(cast.to_height);
+        result_hash += std::to_string(cast.min_amount.int_part);
+        result_hash += std::to_string(cast.min_amount.frac_part);
+        result_hash += hashPagination(cast.pagination);
+        result_hash += cast.creator_account_id;
+      }
+      if (instanceof <model::GetAssetHolders>(query.get())) {
+        auto cast = static_cast<const GetAssetHolders &>(*query);
+        result_hash += cast.asset_id;
+        result_hash += hashPagination(cast.pagination);
+        result_hash += cast.creator_account_id;
+      }
+      if (instanceof <model::GetDomainAccounts>(query.get())) {
+        auto cast = static_cast<const GetDomainAccounts &>(*query);
+        result_hash += cast.domain_id;
+        result_hash += hashPagination(cast.pagination);
+        result_hash += cast.creator_account_id;
+      }
+      if (instanceof <model::GetAccountsBySignatory>(query.get())) {
+        auto cast = static_cast<const GetAccountsBySignatory &>(*query);
+        result_hash += cast.signatory.to_string();
+        result_hash += hashPagination(cast.pagination);
+        result_hash += cast.creator_account_id;
+      }
+      if (instanceof <model::GetStateRoot>(query.get())) {
+        // query has no fields, so its kind is hashed
+        result_hash += "state_root";
+        result_hash += query->creator_account_id;
+      }
+      if (instanceof <model::QueryBatch>(query.get())) {
+        // signature of the batch covers all of its queries
+        const auto &cast = static_cast<const QueryBatch &>(*query);
+        for (const auto &nested : cast.queries) {
+          result_hash += get_hash(nested).to_string();
+        }
         result_hash += cast.creator_account_id;
       }
       result_hash += query->query_counter;
-      std::vector<uint8_t> concat_hash_commands(result_hash.begin(),
-                                                result_hash.end());
-      return sha3_256(concat_hash_commands.data(), concat_hash_commands.size());
+      result_hash += hashMask(query->mask);
+      return Sha3_256().update(result_hash).final();
     }
 
   }  // namespace model
@@ -33,9 +33,21 @@ namespace iroha {
 
       iroha::hash256_t get_hash(const Block &block) override;
 
+      /**
+       * @return tx_hash of transaction if it is set, so transactions are
+       * hashed once in pipeline, computed hash otherwise
+       */
       iroha::hash256_t get_hash(const Transaction &tx) override;
 
       iroha::hash256_t  get_hash(std::shared_ptr<const Query> query) override;
+
+      /**
+       * Compute root of merkle tree of transaction hashes
+       * @param transactions - leaves of tree in order
+       * @return root, zero hash for empty list
+       */
+      iroha::hash256_t get_merkle_root(
+          const std::vector<Transaction> &transactions);
     };
   }
 }
@@ -31,6 +31,36 @@ namespace iroha {
       std::string account_id;
       std::string asset_id;
     };
+
+    /**
+     * Page of assets of account, in order of asset id
+     */
+    struct AssetPagination {
+      /**
+       * Maximum number of assets, 0 for all
+       */
+      uint32_t page_size = 0;
+
+      /**
+       * Page starts after this asset, from the first asset if empty
+       */
+      std::string after_asset_id;
+    };
+
+    /**
+     * Query for getting all assets of account with their balances at once
+     */
+    struct GetAccountAssetList : Query {
+      /**
+       * Account identifier
+       */
+      std::string account_id;
+
+      /**
+       * Requested page
+       */
+      AssetPagination pagination;
+    };
   }  // namespace model
 }  // namespace iroha
 #endif  // IROHA_GET_ACCOUNT_ASSETS_HPP
@@ -0,0 +1,33 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_GET_STATE_ROOT_HPP
+#define IROHA_GET_STATE_ROOT_HPP
+
+#include <model/query.hpp>
+
+namespace iroha {
+  namespace model {
+
+    /**
+     * Query for getting root of world state view, so operators can tell
+     * whether peers' state at the same height has diverged
+     */
+    struct GetStateRoot : Query {};
+  }  // namespace model
+}  // namespace iroha
+#endif  // IROHA_GET_STATE_ROOT_HPP
@@ -18,12 +18,44 @@
 #ifndef IROHA_GET_TRANSACTIONS_HPP
 #define IROHA_GET_TRANSACTIONS_HPP
 
+#include <common/types.hpp>
 #include <model/query.hpp>
+#include <nonstd/optional.hpp>
 #include <string>
 
 namespace iroha {
   namespace model {
 
+    /**
+     * Position of transaction in the chain
+     */
+    struct TxCursor {
+      /**
+       * Height of the block with the transaction
+       */
+      uint32_t height;
+
+      /**
+       * Index of the transaction in its block
+       */
+      uint32_t index;
+    };
+
+    /**
+     * Page of transaction history, in chain order
+     */
+    struct TxPagination {
+      /**
+       * Maximum number of transactions, 0 for all
+       */
+      uint32_t page_size = 0;
+
+      /**
+       * Page starts after this transaction, from the beginning if absent
+       */
+      nonstd::optional<TxCursor> after;
+    };
+
     /**
      * Query for getting transactions of given asset of an account
      */
@@ -37,6 +69,11 @@ namespace iroha {
        * Asset identifier
        */
       std::string asset_id;
+
+      /**
+       * Requested page
+       */
+      TxPagination pagination;
     };
 
     /**
@@ -47,6 +84,58 @@ namespace iroha {
        * Account identifier
        */
       std::string account_id;
+
+      /**
+       * Requested page
+       */
+      TxPagination pagination;
+    };
+
+    /**
+     * Query for getting committed transaction by its hash
+     */
+    struct GetTransaction : Query {
+      /**
+       * Hash of the transaction
+       */
+      hash256_t tx_hash;
+
+      /**
+       * Attach proof of inclusion into the block
+       */
+      bool with_proof = false;
+    };
+
+    /**
+     * Query for getting transactions transferring given asset within a
+     * range of blocks, e.g. for analytics without exporting the chain
+     */
+    struct GetAssetTransfers : Query {
+      /**
+       * Asset identifier
+       */
+      std::string asset_id;
+
+      /**
+       * First block of the range
+       */
+      uint32_t from_height = 1;
+
+      /**
+       * Last block of the range, 0 for the top block
+       */
+      uint32_t to_height = 0;
+
+      /**
+       * Transfers of smaller amount are skipped. Amount is in precision
+       * of the asset, as in TransferAsset
+       */
+      Amount min_amount;
+
+      /**
+       * Requested page
+       */
+      TxPagination pagination;
     };
   }  // namespace model
 }  // namespace iroha
@@ -0,0 +1,89 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_LIST_ACCOUNTS_HPP
+#define IROHA_LIST_ACCOUNTS_HPP
+
+#include <common/types.hpp>
+#include <model/query.hpp>
+#include <string>
+
+namespace iroha {
+  namespace model {
+
+    /**
+     * Page of accounts, in order of account id
+     */
+    struct AccountPagination {
+      /**
+       * Maximum number of accounts, 0 for all
+       */
+      uint32_t page_size = 0;
+
+      /**
+       * Page starts after this account, from the first account if empty
+       */
+      std::string after_account_id;
+    };
+
+    /**
+     * Query for getting balances of all accounts holding asset
+     */
+    struct GetAssetHolders : Query {
+      /**
+       * Asset identifier
+       */
+      std::string asset_id;
+
+      /**
+       * Requested page
+       */
+      AccountPagination pagination;
+    };
+
+    /**
+     * Query for getting all accounts of domain
+     */
+    struct GetDomainAccounts : Query {
+      /**
+       * Domain identifier
+       */
+      std::string domain_id;
+
+      /**
+       * Requested page
+       */
+      AccountPagination pagination;
+    };
+
+    /**
+     * Query for getting ids of all accounts signed by public key
+     */
+    struct GetAccountsBySignatory : Query {
+      /**
+       * Public key of signatory
+       */
+      ed25519::pubkey_t signatory;
+
+      /**
+       * Requested page
+       */
+      AccountPagination pagination;
+    };
+  }  // namespace model
+}  // namespace iroha
+#endif  // IROHA_LIST_ACCOUNTS_HPP
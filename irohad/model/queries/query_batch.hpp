@@ -0,0 +1,46 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_QUERY_BATCH_HPP
+#define IROHA_QUERY_BATCH_HPP
+
+#include <memory>
+#include <vector>
+#include "model/query.hpp"
+
+namespace iroha {
+  namespace model {
+
+    /**
+     * Queries signed once and answered from the same state of ledger.
+     * Nested queries take creator, counter and timestamp of the batch,
+     * their signature is the one of the batch
+     */
+    struct QueryBatch : Query {
+      /**
+       * Queries in order of their responses, batches are not nested
+       */
+      std::vector<std::shared_ptr<const Query>> queries;
+
+      /**
+       * Upper bound of queries in one batch
+       */
+      static constexpr size_t kMaxQueries = 32;
+    };
+  }  // namespace model
+}  // namespace iroha
+#endif  // IROHA_QUERY_BATCH_HPP
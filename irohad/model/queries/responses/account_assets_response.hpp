@@ -18,6 +18,8 @@
 #ifndef IROHA_ACCOUNT_ASSETS_RESPONSE_HPP
 #define IROHA_ACCOUNT_ASSETS_RESPONSE_HPP
 
+#include <nonstd/optional.hpp>
+#include <string>
 #include <vector>
 #include "model/account_asset.hpp"
 #include "model/query_response.hpp"
@@ -28,6 +30,18 @@ namespace iroha {
     struct AccountAssetResponse : public QueryResponse {
       AccountAsset acct_asset;
     };
+
+    /**
+     * Response with page of assets of account
+     */
+    struct AccountAssetsResponse : public QueryResponse {
+      std::vector<AccountAsset> account_assets;
+
+      /**
+       * Continuation of the page, set when it is full and more may follow
+       */
+      nonstd::optional<std::string> next_asset_id;
+    };
   }  // namespace model
 }  // namespace iroha
 #endif  // IROHA_ACCOUNT_ASSETS_RESPONSE_HPP
@@ -0,0 +1,68 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_ACCOUNTS_RESPONSE_HPP
+#define IROHA_ACCOUNTS_RESPONSE_HPP
+
+#include <nonstd/optional.hpp>
+#include <string>
+#include <vector>
+#include "model/account.hpp"
+#include "model/account_asset.hpp"
+#include "model/query_response.hpp"
+
+namespace iroha {
+  namespace model {
+
+    /**
+     * Response with page of balances of asset holders
+     */
+    struct AssetHoldersResponse : public QueryResponse {
+      std::vector<AccountAsset> account_assets;
+
+      /**
+       * Continuation of the page, set when it is full and more may follow
+       */
+      nonstd::optional<std::string> next_account_id;
+    };
+
+    /**
+     * Response with page of accounts
+     */
+    struct AccountsResponse : public QueryResponse {
+      std::vector<Account> accounts;
+
+      /**
+       * Continuation of the page, set when it is full and more may follow
+       */
+      nonstd::optional<std::string> next_account_id;
+    };
+
+    /**
+     * Response with page of account identifiers
+     */
+    struct AccountIdsResponse : public QueryResponse {
+      std::vector<std::string> account_ids;
+
+      /**
+       * Continuation of the page, set when it is full and more may follow
+       */
+      nonstd::optional<std::string> next_account_id;
+    };
+  }  // namespace model
+}  // namespace iroha
+#endif  // IROHA_ACCOUNTS_RESPONSE_HPP
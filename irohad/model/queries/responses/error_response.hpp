@@ -55,7 +55,11 @@ namespace iroha {
         /**
          * when unidentified request was received
          */
-        NOT_SUPPORTED
+        NOT_SUPPORTED,
+        /**
+         * when requested transaction is not committed
+         */
+        NO_TRANSACTION
       };
       Reason reason;
     };
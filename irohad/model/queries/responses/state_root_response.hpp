@@ -0,0 +1,46 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_STATE_ROOT_RESPONSE_HPP
+#define IROHA_STATE_ROOT_RESPONSE_HPP
+
+#include <common/types.hpp>
+#include <model/query_response.hpp>
+
+namespace iroha {
+  namespace model {
+
+    /**
+     * Provide root of world state view with the height it is taken at.
+     * Equal roots at equal heights mean state has not diverged by
+     * accident, root is not collision resistant and proves nothing
+     * about the state to a client
+     */
+    struct StateRootResponse : public QueryResponse {
+      /**
+       * Height of the last block applied to the state
+       */
+      uint32_t height;
+
+      /**
+       * Root of the state
+       */
+      hash256_t root;
+    };
+  }  // namespace model
+}  // namespace iroha
+#endif  // IROHA_STATE_ROOT_RESPONSE_HPP
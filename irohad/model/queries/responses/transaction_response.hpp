@@ -0,0 +1,55 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_TRANSACTION_RESPONSE_HPP
+#define IROHA_TRANSACTION_RESPONSE_HPP
+
+#include <nonstd/optional.hpp>
+#include "model/inclusion_proof.hpp"
+#include "model/query_response.hpp"
+#include "model/transaction.hpp"
+
+namespace iroha {
+  namespace model {
+
+    /**
+     * Provide committed transaction with its place in the chain
+     */
+    struct TransactionResponse : public QueryResponse {
+      /**
+       * Requested transaction
+       */
+      Transaction transaction;
+
+      /**
+       * Height of the block which contains the transaction
+       */
+      uint32_t height;
+
+      /**
+       * Index of the transaction in its block
+       */
+      uint32_t index;
+
+      /**
+       * Proof of inclusion, if it is requested and can be made
+       */
+      nonstd::optional<InclusionProof> proof;
+    };
+  }  // namespace model
+}  // namespace iroha
+#endif  // IROHA_TRANSACTION_RESPONSE_HPP
@@ -18,7 +18,10 @@
 #ifndef IROHA_TRANSACTIONS_RESPONSE_HPP
 #define IROHA_TRANSACTIONS_RESPONSE_HPP
 
+#include <nonstd/optional.hpp>
 #include <rxcpp/rx-observable.hpp>
+#include "model/queries/get_transactions.hpp"
+#include "model/query_response.hpp"
 #include "model/transaction.hpp"
 
 namespace iroha {
@@ -33,6 +36,17 @@ namespace iroha {
        * Observable contains transactions
        */
       rxcpp::observable <Transaction> transactions;
+
+      /**
+       * Continuation of paginated history, set when the page is full
+       */
+      nonstd::optional<TxCursor> next;
+
+      /**
+       * Position of the last transaction of paginated history, set for a
+       * page which is not full as well, so subscription resumes after it
+       */
+      nonstd::optional<TxCursor> last;
     };
   }  // namespace model
 }  // namespace iroha
@@ -24,6 +24,27 @@
 
 namespace iroha {
   namespace model {
+    /**
+     * Parts of query response which client does not need.
+     * Whole objects are returned by default.
+     */
+    struct ResponseMask {
+      /**
+       * Leave out permissions of accounts
+       */
+      bool omit_permissions = false;
+
+      /**
+       * Leave out commands of transactions, their hashes are returned instead
+       */
+      bool omit_bodies = false;
+
+      /**
+       * Leave out signatures of transactions
+       */
+      bool omit_signatures = false;
+    };
+
     /**
      * This model represents user intent for reading ledger.
      * Concrete queries should extend this interface.
@@ -56,6 +77,11 @@ namespace iroha {
        */
       uint64_t query_counter;
 
+      /**
+       * Parts of response to leave out
+       */
+      ResponseMask mask;
+
       virtual ~Query() {}
     };
   }  // namespace model
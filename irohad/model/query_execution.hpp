@@ -17,16 +17,24 @@
 #ifndef IROHA_QUERY_EXECUTION_HPP
 #define IROHA_QUERY_EXECUTION_HPP
 
+#include <map>
+#include <mutex>
 #include <nonstd/optional.hpp>
+#include <unordered_map>
+#include "model/block.hpp"
 #include "model/query.hpp"
 #include "model/query_response.hpp"
 
 #include "model/queries/get_account.hpp"
 #include "model/queries/get_account_assets.hpp"
 #include "model/queries/get_signatories.hpp"
+#include "model/queries/get_state_root.hpp"
 #include "model/queries/get_transactions.hpp"
+#include "model/queries/list_accounts.hpp"
+#include "model/queries/query_batch.hpp"
 
 #include "ametsuchi/block_query.hpp"
+#include "ametsuchi/snapshot_pin.hpp"
 #include "ametsuchi/wsv_query.hpp"
 
 namespace iroha {
@@ -39,6 +47,8 @@ namespace iroha {
      public:
       /**
        * Execute and validate query.
+       * Response carries mask of the query, so parts it leaves out are not
+       * serialized
        *
        * @param query
        * @return
@@ -49,26 +59,127 @@ namespace iroha {
        *
        * @param wsvQuery
        * @param blockQuery
+       * @param cache_results - keep accounts, account assets and signatories
+       * read by queries in memory until a commit touches their account.
+       * Requires wsvQuery to reflect commits before they are notified
+       * @param snapshots - pins reads of wsvQuery and blockQuery, so queries
+       * of a batch see the same state. Without it a commit may happen
+       * between them
        */
-      QueryProcessingFactory(std::shared_ptr<ametsuchi::WsvQuery> wsvQuery,
-                             std::shared_ptr<ametsuchi::BlockQuery> blockQuery);
+      QueryProcessingFactory(
+          std::shared_ptr<ametsuchi::WsvQuery> wsvQuery,
+          std::shared_ptr<ametsuchi::BlockQuery> blockQuery,
+          bool cache_results = false,
+          std::shared_ptr<ametsuchi::SnapshotPinFactory> snapshots = nullptr);
+
+      /**
+       * Drop cached reads of accounts touched by committed block.
+       * Must be called after the block is applied to world state view
+       */
+      void invalidate(const model::Block& block);
+
+      /**
+       * Upper bound of entries of one kind of cached reads, reaching it
+       * clears them
+       */
+      static constexpr size_t kMaxCachedEntries = 100000;
 
      private:
-      bool validate(const model::GetAccountAssets& query);
+      /**
+       * Return cached result of read or do the read and cache it, unless
+       * a commit happened meanwhile
+       */
+      template <typename Cache, typename Read>
+      typename Cache::mapped_type cached(Cache& cache,
+                                         const typename Cache::key_type& key,
+                                         Read read);
+
+      nonstd::optional<model::Account> getAccount(
+          const std::string& account_id);
 
-      bool validate(const model::GetAccount& query);
+      nonstd::optional<std::vector<ed25519::pubkey_t>> getSignatories(
+          const std::string& account_id);
 
-      bool validate(const model::GetSignatories& query);
+      nonstd::optional<model::AccountAsset> getAccountAsset(
+          const std::string& account_id, const std::string& asset_id);
 
-      bool validate(const model::GetAccountAssetTransactions& query);
+      /**
+       * Entities read for one query, so each of them is loaded at most once
+       */
+      struct QueryContext {
+        std::string creator_account_id;
+        nonstd::optional<model::Account> creator;
+      };
 
-      bool validate(const model::GetAccountTransactions& query);
+      QueryContext makeContext(const model::Query& query);
+
+      std::shared_ptr<iroha::model::QueryResponse> executeQuery(
+          std::shared_ptr<const model::Query> query,
+          const QueryContext& context);
+
+      /**
+       * Validate and execute queries of batch with one context over pinned
+       * state
+       */
+      std::shared_ptr<iroha::model::QueryResponse> executeQueryBatch(
+          const model::QueryBatch& batch);
+
+      /**
+       * @return account from context if it is the creator, otherwise read it
+       */
+      nonstd::optional<model::Account> account(const QueryContext& context,
+                                               const std::string& account_id);
+
+      /**
+       * @return true if creator exists and has permission to read data of
+       * given account, or it is the creator itself
+       */
+      bool canRead(const QueryContext& context, const std::string& account_id);
+
+      bool validate(const model::GetAccountAssets& query,
+                    const QueryContext& context);
+
+      bool validate(const model::GetAccountAssetList& query,
+                    const QueryContext& context);
+
+      bool validate(const model::GetAccount& query,
+                    const QueryContext& context);
+
+      bool validate(const model::GetSignatories& query,
+                    const QueryContext& context);
+
+      bool validate(const model::GetAccountAssetTransactions& query,
+                    const QueryContext& context);
+
+      bool validate(const model::GetAccountTransactions& query,
+                    const QueryContext& context);
+
+      bool validate(const model::GetTransaction& query,
+                    const QueryContext& context);
+
+      bool validate(const model::GetAssetTransfers& query,
+                    const QueryContext& context);
+
+      bool validate(const model::GetAssetHolders& query,
+                    const QueryContext& context);
+
+      bool validate(const model::GetDomainAccounts& query,
+                    const QueryContext& context);
+
+      bool validate(const model::GetAccountsBySignatory& query,
+                    const QueryContext& context);
+
+      bool validate(const model::GetStateRoot& query,
+                    const QueryContext& context);
 
       std::shared_ptr<iroha::model::QueryResponse> executeGetAccountAssets(
           const model::GetAccountAssets& query);
 
+      std::shared_ptr<iroha::model::QueryResponse> executeGetAccountAssetList(
+          const model::GetAccountAssetList& query);
+
       std::shared_ptr<iroha::model::QueryResponse> executeGetAccount(
-          const model::GetAccount& query);
+          const model::GetAccount& query, const QueryContext& context);
 
       std::shared_ptr<iroha::model::QueryResponse> executeGetSignatories(
           const model::GetSignatories& query);
@@ -80,8 +191,41 @@ namespace iroha {
       std::shared_ptr<iroha::model::QueryResponse>
       executeGetAccountTransactions(const model::GetAccountTransactions& query);
 
+      std::shared_ptr<iroha::model::QueryResponse> executeGetTransaction(
+          const model::GetTransaction& query, const QueryContext& context);
+
+      std::shared_ptr<iroha::model::QueryResponse> executeGetAssetTransfers(
+          const model::GetAssetTransfers& query);
+
+      std::shared_ptr<iroha::model::QueryResponse> executeGetAssetHolders(
+          const model::GetAssetHolders& query);
+
+      std::shared_ptr<iroha::model::QueryResponse> executeGetDomainAccounts(
+          const model::GetDomainAccounts& query);
+
+      std::shared_ptr<iroha::model::QueryResponse>
+      executeGetAccountsBySignatory(const model::GetAccountsBySignatory& query);
+
+      std::shared_ptr<iroha::model::QueryResponse> executeGetStateRoot(
+          const model::GetStateRoot& query);
+
       std::shared_ptr<ametsuchi::WsvQuery> _wsvQuery;
       std::shared_ptr<ametsuchi::BlockQuery> _blockQuery;
+      std::shared_ptr<ametsuchi::SnapshotPinFactory> snapshots_;
+
+      const bool cache_results_;
+      // number of invalidations, reads started before one are not cached
+      uint64_t cache_version_ = 0;
+      std::unordered_map<std::string, nonstd::optional<model::Account>>
+          accounts_;
+      std::unordered_map<std::string,
+                         nonstd::optional<std::vector<ed25519::pubkey_t>>>
+          signatories_;
+      // ordered by account, so all assets of an account are dropped at once
+      std::map<std::pair<std::string, std::string>,
+               nonstd::optional<model::AccountAsset>>
+          account_assets_;
+      std::mutex cache_mutex_;
     };
 
   }  // namespace model
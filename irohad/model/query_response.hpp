@@ -33,6 +33,11 @@ namespace iroha {
        */
       hash256_t query_hash;
 
+      /**
+       * Parts of response left out by request of client
+       */
+      ResponseMask mask;
+
       virtual ~QueryResponse() {}
     };
   }  // namespace model
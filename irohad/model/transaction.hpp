@@ -21,8 +21,10 @@ limitations under the License.
 #include <memory>
 #include <model/command.hpp>
 #include <model/signature.hpp>
+#include <nonstd/optional.hpp>
 #include <string>
 #include <vector>
+#include "tracing/tracing.hpp"
 
 namespace iroha {
   namespace model {
@@ -58,14 +60,24 @@ namespace iroha {
        * During a stateful validation look at account and compare numbers
        * if number inside a transaction is less than in account,
        * this transaction is replayed.
+       * Zero for transactions not protected by counter.
        * META field
        */
-      uint64_t tx_counter;
+      uint64_t tx_counter = 0;
 
       /**
        * Hash will be used in iroha for transaction identification
+       * Zero until it is computed, it is set once transaction is converted
+       * from protobuf and reused by hash provider afterwards, so it must be
+       * reset if transaction is changed
        */
-      hash256_t tx_hash;
+      hash256_t tx_hash{};
+
+      /**
+       * Trace of transaction if it is sampled, not part of transaction
+       * identity, so it is neither hashed nor compared
+       */
+      nonstd::optional<tracing::TraceContext> trace;
 
       /**
        * Bunch of commands attached to transaction
@@ -19,7 +19,10 @@
 #define IROHA_BLOCK_LOADER_HPP
 
 #include <model/block.hpp>
+#include <model/peer.hpp>
+#include <nonstd/optional.hpp>
 #include <rxcpp/rx-observable.hpp>
+#include <vector>
 
 namespace iroha {
   namespace network {
@@ -32,15 +35,39 @@ namespace iroha {
       /**
        * Method requests missed blocks from external peer starting from it's top
        * block.
-       * Note, that blocks will be in order: from the newest
-       * to your actual top block.
-       * This order is required for verify blocks before storing in a ledger.
+       * Note, that blocks will be in order of height, starting from the block
+       * following your actual top block.
+       * This order is required for applying blocks to a ledger.
        * @param target_peer - peer for requesting blocks
        * @param topBlock - your last actual block
        * @return observable with blocks
        */
       virtual rxcpp::observable <model::Block> requestBlocks(
           model::Peer &target_peer, model::Block &topBlock) = 0;
+
+      /**
+       * Download blocks following the local top block up to given height.
+       * Range is split between peers and parts are fetched in parallel,
+       * part which could not be fetched is requested from other peers.
+       * @param peers - peers which have the blocks, e.g. signers of commit
+       * @param height - height of the last requested block
+       * @return observable with blocks in order of height, chain ends
+       * before the first block which could not be downloaded
+       */
+      virtual rxcpp::observable<model::Block> retrieveChain(
+          const std::vector<model::Peer> &peers, uint64_t height) = 0;
+
+      /**
+       * Download single block
+       * @param peer - peer which has the block
+       * @param height - height of block
+       * @param hash - expected hash of block
+       * @return block if peer has it, nullopt otherwise
+       */
+      virtual nonstd::optional<model::Block> retrieveBlock(
+          const model::Peer &peer, uint64_t height, const hash256_t &hash) = 0;
+
+      virtual ~BlockLoader() = default;
     };
   } // namespace network
 } // namespace iroha
@@ -33,14 +33,15 @@ namespace iroha {
       /**
        * Providing data for consensus for voting
        */
-      virtual void vote(model::Block) = 0;
+      virtual void vote(std::shared_ptr<const model::Block>) = 0;
 
       /**
        * Emit committed blocks
        * Note: committed block may be not satisfy for top block in ledger
        * because synchronization reasons
        */
-      virtual rxcpp::observable<model::Block> on_commit() = 0;
+      virtual rxcpp::observable<std::shared_ptr<const model::Block>>
+      on_commit() = 0;
 
       virtual ~ConsensusGate() = default;
     };
@@ -17,12 +17,67 @@ limitations under the License.
 #ifndef NETWORK_GRPC_CALL_HPP
 #define NETWORK_GRPC_CALL_HPP
 
+#include <google/protobuf/arena.h>
 #include <grpc++/grpc++.h>
 #include <assert.h>
+#include <cstddef>
+#include <vector>
 #include <network/grpc_async_service.hpp>
 
 namespace network {
 
+  /**
+   * Per-thread free list of memory blocks of one size.
+   * Calls are created and finished on the thread which polls their
+   * completion queue, so finished calls are reused without locking.
+   * @tparam BlockSize - size of one block in bytes
+   */
+  template <size_t BlockSize>
+  class BlockPool {
+   public:
+    /**
+     * Upper bound of free blocks kept by one thread
+     */
+    static constexpr size_t kMaxFreeBlocks = 256;
+
+    static void *allocate() {
+      auto &blocks = freeList().blocks;
+      if (blocks.empty()) {
+        return ::operator new(BlockSize);
+      }
+      auto block = blocks.back();
+      blocks.pop_back();
+      return block;
+    }
+
+    static void release(void *block) {
+      auto &blocks = freeList().blocks;
+      if (blocks.size() >= kMaxFreeBlocks) {
+        ::operator delete(block);
+        return;
+      }
+      blocks.push_back(block);
+    }
+
+   private:
+    struct FreeList {
+      ~FreeList() {
+        for (auto block : blocks) {
+          ::operator delete(block);
+        }
+      }
+      std::vector<void *> blocks;
+    };
+
+    static FreeList &freeList() {
+      thread_local FreeList list;
+      return list;
+    }
+  };
+
+  template <size_t BlockSize>
+  constexpr size_t BlockPool<BlockSize>::kMaxFreeBlocks;
+
   /**
    * to use polymorphism in ServiceHandler::handleRpcs()
    * @tparam ServiceHandler
@@ -45,6 +100,12 @@ namespace network {
      */
     virtual void responseSent() = 0;
 
+    /**
+     * invokes when the operation of the call has failed, e.g. request was
+     * cancelled by server shutdown, so the call is finished.
+     */
+    virtual void dropped() = 0;
+
     /**
      * owns concrete Call type and executes derived functions.
      * container for vtable to work if casts UntypedCall<> from void*
@@ -72,6 +133,15 @@ namespace network {
         }
       }
 
+      /**
+       * finishes the call whose operation has failed.
+       * this is called from ServiceHandler::handleRpcs() for events which
+       * are not ok
+       */
+      void onFailed() {
+        call_->dropped();
+      }
+
     private:
       UntypedCall* call_; // owns concrete Call type, works vtable.
       const UntypedCall::State state_;
@@ -80,6 +150,9 @@ namespace network {
 
   /**
    * to manage the state of one rpc.
+   * Request and response live on the arena of the call, which starts
+   * with an inline block, so parsing small messages does not allocate.
+   * Memory of finished calls is reused through BlockPool.
    * @tparam ServiceHandler - class that has interface GrpcAsyncService.
    * @tparam AsyncService - [SomeService]::AsyncService in *.grpc.pb.h
    * @tparam RequestType - type of a request from client
@@ -95,11 +168,31 @@ namespace network {
     using UntypedCallType   = UntypedCall<ServiceHandler>;
     using CallOwnerType     = typename UntypedCallType::CallOwner;
 
+    /**
+     * Size of arena block embedded into the call
+     */
+    static constexpr size_t kArenaBlockSize = 4096;
+
     Call(RpcHandlerType rpcHandler)
-      : rpcHandler_(rpcHandler), responder_(&ctx_) {}
+        : rpcHandler_(rpcHandler),
+          arena_(arenaOptions(arena_block_)),
+          request_(google::protobuf::Arena::CreateMessage<RequestType>(
+              &arena_)),
+          response_(google::protobuf::Arena::CreateMessage<ResponseType>(
+              &arena_)),
+          responder_(&ctx_) {}
 
     virtual ~Call() {}
 
+    static void *operator new(size_t size) {
+      assert(size == sizeof(CallType));
+      return BlockPool<sizeof(CallType)>::allocate();
+    }
+
+    static void operator delete(void *block) {
+      BlockPool<sizeof(CallType)>::release(block);
+    }
+
     /**
      * invokes when state is RequestReceivedTag.
      * this method is called by onCompleted() in super class (UntypedCall).
@@ -119,12 +212,20 @@ namespace network {
       delete this;
     }
 
+    /**
+     * invokes when request or response of this call has failed.
+     * the call will not get any other event, so it is deleted.
+     */
+    void dropped() override {
+      delete this;
+    }
+
     /**
      * notifies response and grpc::Status when finishing handling rpc.
      * @param status
      */
     void sendResponse(::grpc::Status status) {
-      responder_.Finish(response_, status, &ResponseSentTag);
+      responder_.Finish(*response_, status, &ResponseSentTag);
     }
 
     /**
@@ -140,6 +241,7 @@ namespace network {
                                RequestMethodType requestMethod,
                                RpcHandlerType rpcHandler) {
       auto call = new CallType(rpcHandler);
+      call->cq_ = cq;
 
       (asyncService->*requestMethod)(&call->ctx_, &call->request(),
                                      &call->responder_, cq, cq,
@@ -147,21 +249,46 @@ namespace network {
     }
 
   public:
-    auto& request()  { return request_; }
-    auto& response() { return response_; }
+    auto& request()  { return *request_; }
+    auto& response() { return *response_; }
+    auto& context()  { return ctx_; }
+
+    /**
+     * @return completion queue which received the rpc, e.g. to request
+     * the next rpc from the same queue
+     */
+    auto completionQueue() { return cq_; }
 
   private:
     CallOwnerType RequestReceivedTag { this, UntypedCallType::State::RequestCreated };
     CallOwnerType ResponseSentTag { this, UntypedCallType::State::ResponseSent };
 
   private:
+    static google::protobuf::ArenaOptions arenaOptions(char *block) {
+      google::protobuf::ArenaOptions options;
+      options.initial_block = block;
+      options.initial_block_size = kArenaBlockSize;
+      return options;
+    }
+
     RpcHandlerType rpcHandler_;
-    RequestType request_;
-    ResponseType response_;
+    alignas(alignof(std::max_align_t)) char arena_block_[kArenaBlockSize];
+    google::protobuf::Arena arena_;
+    RequestType *request_;
+    ResponseType *response_;
     ::grpc::ServerContext ctx_;
     ::grpc::ServerAsyncResponseWriter<ResponseType> responder_;
+    ::grpc::ServerCompletionQueue* cq_ = nullptr;
   };
 
+  template <typename ServiceHandler,
+            typename AsyncService,
+            typename RequestType,
+            typename ResponseType>
+  constexpr size_t
+      Call<ServiceHandler, AsyncService, RequestType, ResponseType>::
+          kArenaBlockSize;
+
 }  // namespace network
 
 #endif  // NETWORK_GRPC_CALL_HPP
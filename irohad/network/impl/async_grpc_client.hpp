@@ -20,47 +20,82 @@
 
 #include <google/protobuf/empty.pb.h>
 #include <grpc++/grpc++.h>
-#include <thread>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include "network/impl/client_completion_pool.hpp"
 
 namespace iroha {
   namespace network {
 
     /**
      * Asynchronous gRPC client which does no processing of server responses
+     * except for tracking of server overload and unavailability.
+     * Calls complete on threads of the shared client completion pool
      * @tparam Response type of server response
      */
     template <typename Response>
     class AsyncGrpcClient {
      public:
-      AsyncGrpcClient() : thread_(&AsyncGrpcClient::asyncCompleteRpc, this) {}
+      using Clock = std::chrono::steady_clock;
 
       /**
-      * Listen to gRPC server responses
-      */
-      void asyncCompleteRpc() {
-        void *got_tag;
-        auto ok = false;
-        while (cq_.Next(&got_tag, &ok)) {
-          auto call = static_cast<AsyncClientCall *>(got_tag);
-
-          delete call;
-        }
-      }
+       * Time during which server is considered overloaded after it has
+       * refused a call with RESOURCE_EXHAUSTED
+       */
+      static constexpr std::chrono::milliseconds kRetryDelay{1000};
 
-      ~AsyncGrpcClient() {
-        cq_.Shutdown();
-        if (thread_.joinable()) {
-          thread_.join();
-        }
+      AsyncGrpcClient() : cq_(clientCompletionPool().queue()) {}
+
+      /**
+       * @return true if server has recently refused a call as overloaded,
+       * and no call has succeeded since then
+       */
+      bool serverOverloaded() const {
+        return Clock::now().time_since_epoch() < state_->retry_until.load();
       }
 
-      grpc::CompletionQueue cq_;
-      std::thread thread_;
+      /**
+       * @return number of the latest calls in a row which have not reached
+       * the server
+       */
+      size_t failedCalls() const { return state_->failed_calls; }
+
+      /**
+       * Server state seen by calls, shared with calls in flight since they
+       * may complete after the client is destroyed
+       */
+      struct State {
+        std::atomic<Clock::duration> retry_until{Clock::duration::zero()};
+        std::atomic<size_t> failed_calls{0};
+      };
+
+      std::shared_ptr<State> state_ = std::make_shared<State>();
+      grpc::CompletionQueue &cq_;
 
       /**
        * State and data information of gRPC call
        */
-      struct AsyncClientCall {
+      struct AsyncClientCall : public ClientCompletionPool::Call {
+        explicit AsyncClientCall(std::shared_ptr<State> state)
+            : state(std::move(state)) {}
+
+        void complete(bool ok) override {
+          auto code = status.error_code();
+          if (code == grpc::StatusCode::UNAVAILABLE
+              or code == grpc::StatusCode::DEADLINE_EXCEEDED) {
+            ++state->failed_calls;
+          } else {
+            state->failed_calls = 0;
+          }
+          if (code == grpc::StatusCode::RESOURCE_EXHAUSTED) {
+            state->retry_until =
+                (Clock::now() + kRetryDelay).time_since_epoch();
+          } else if (status.ok()) {
+            state->retry_until = Clock::duration::zero();
+          }
+        }
+
         Response reply;
 
         grpc::ClientContext context;
@@ -69,8 +104,13 @@ namespace iroha {
 
         std::unique_ptr<grpc::ClientAsyncResponseReader<Response>>
             response_reader;
+
+        std::shared_ptr<State> state;
       };
     };
+
+    template <typename Response>
+    constexpr std::chrono::milliseconds AsyncGrpcClient<Response>::kRetryDelay;
   }  // namespace network
 }  // namespace iroha
 
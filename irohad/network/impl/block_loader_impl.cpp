@@ -0,0 +1,207 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "network/impl/block_loader_impl.hpp"
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <iterator>
+
+namespace iroha {
+  namespace network {
+
+    BlockLoaderImpl::BlockLoaderImpl(
+        std::shared_ptr<ametsuchi::PeerQuery> peer_query,
+        std::shared_ptr<ametsuchi::BlockQuery> block_query,
+        std::shared_ptr<ChannelRegistry> channels)
+        : peer_query_(std::move(peer_query)),
+          block_query_(std::move(block_query)),
+          channels_(std::move(channels)) {
+      log_ = logger::log("BlockLoader");
+    }
+
+    rxcpp::observable<model::Block> BlockLoaderImpl::requestBlocks(
+        model::Peer &target_peer, model::Block &topBlock) {
+      auto peers = resolve({target_peer});
+      if (peers.empty()) {
+        log_->error("unknown peer to request blocks from");
+        return rxcpp::observable<>::empty<model::Block>();
+      }
+      return rxcpp::observable<>::iterate(
+          fetch(peers.front(), topBlock.height + 1, 0));
+    }
+
+    rxcpp::observable<model::Block> BlockLoaderImpl::retrieveChain(
+        const std::vector<model::Peer> &peers, uint64_t height) {
+      uint64_t from = block_query_->getTopBlockHeight() + 1ull;
+      auto targets = resolve(peers);
+      if (targets.empty() or from > height) {
+        return rxcpp::observable<>::empty<model::Block>();
+      }
+
+      auto total = height - from + 1;
+      auto parts = std::min<uint64_t>(
+          targets.size(), (total + kMinPartSize - 1) / kMinPartSize);
+      auto part_size = (total + parts - 1) / parts;
+
+      std::vector<uint64_t> sizes;
+      std::vector<std::future<std::vector<model::Block>>> fetches;
+      for (uint64_t i = 0; i < parts; ++i) {
+        auto begin = from + i * part_size;
+        auto count = std::min(part_size, height - begin + 1);
+        sizes.push_back(count);
+        fetches.push_back(std::async(
+            std::launch::async, [this, &targets, i, begin, count] {
+              // peer assigned to the part goes first, others take over
+              // the rest of the part if it fails
+              std::vector<model::Block> part;
+              for (size_t j = 0; j < targets.size() and part.size() < count;
+                   ++j) {
+                auto blocks = this->fetch(targets[(i + j) % targets.size()],
+                                          begin + part.size(),
+                                          count - part.size());
+                std::move(
+                    blocks.begin(), blocks.end(), std::back_inserter(part));
+              }
+              return part;
+            }));
+      }
+
+      std::vector<model::Block> chain;
+      auto complete = true;
+      for (size_t i = 0; i < fetches.size(); ++i) {
+        auto part = fetches[i].get();
+        if (not complete) {
+          continue;
+        }
+        complete = part.size() == sizes[i];
+        std::move(part.begin(), part.end(), std::back_inserter(chain));
+      }
+      log_->info("downloaded {} of {} blocks from {} peers",
+                 chain.size(),
+                 total,
+                 parts);
+      return rxcpp::observable<>::iterate(chain);
+    }
+
+    nonstd::optional<model::Block> BlockLoaderImpl::retrieveBlock(
+        const model::Peer &peer, uint64_t height, const hash256_t &hash) {
+      auto peers = resolve({peer});
+      if (peers.empty()) {
+        log_->error("unknown peer to request block from");
+        return nonstd::nullopt;
+      }
+
+      grpc::ClientContext context;
+      context.set_deadline(std::chrono::system_clock::now()
+                           + std::chrono::milliseconds(kBlockTimeout));
+      proto::BlockRequest request;
+      request.set_height(height);
+      request.set_hash(hash.data(), hash.size());
+      protocol::Block response;
+      auto status =
+          stub(peers.front())->retrieveBlock(&context, request, &response);
+      if (not status.ok()) {
+        log_->warn("block {} is not received from {}: {}",
+                   height,
+                   peers.front().address,
+                   status.error_message());
+        return nonstd::nullopt;
+      }
+
+      auto block = factory_.deserialize(response);
+      if (block.height != height or block.hash != hash) {
+        log_->warn("{} sent unexpected block", peers.front().address);
+        return nonstd::nullopt;
+      }
+      return block;
+    }
+
+    std::vector<model::Block> BlockLoaderImpl::fetch(const model::Peer &peer,
+                                                     uint64_t height,
+                                                     uint64_t count) {
+      grpc::ClientContext context;
+      proto::BlocksRequest request;
+      request.set_height(height);
+      request.set_count(count);
+
+      std::vector<model::Block> blocks;
+      auto reader = stub(peer)->retrieveBlocks(&context, request);
+      protocol::Block pb_block;
+      auto drained = false;
+      while (count == 0 or blocks.size() < count) {
+        if (not reader->Read(&pb_block)) {
+          drained = true;
+          break;
+        }
+        auto block = factory_.deserialize(pb_block);
+        if (block.height != height + blocks.size()) {
+          log_->warn("{} sent block out of order", peer.address);
+          break;
+        }
+        blocks.push_back(std::move(block));
+      }
+      if (not drained) {
+        // rest of the stream is not needed
+        context.TryCancel();
+      }
+      auto status = reader->Finish();
+      if (drained and not status.ok()) {
+        log_->warn("blocks from {} are not received from {}: {}",
+                   height + blocks.size(),
+                   peer.address,
+                   status.error_message());
+      }
+      return blocks;
+    }
+
+    std::vector<model::Peer> BlockLoaderImpl::resolve(
+        const std::vector<model::Peer> &peers) {
+      std::vector<model::Peer> result;
+      nonstd::optional<std::vector<model::Peer>> ledger_peers;
+      for (const auto &peer : peers) {
+        if (not peer.address.empty()) {
+          result.push_back(peer);
+          continue;
+        }
+        if (not ledger_peers) {
+          ledger_peers = peer_query_->getLedgerPeers();
+          if (not ledger_peers) {
+            log_->error("cannot read ledger peers");
+            break;
+          }
+        }
+        auto it = std::find_if(ledger_peers->begin(),
+                               ledger_peers->end(),
+                               [&peer](const model::Peer &ledger_peer) {
+                                 return ledger_peer.pubkey == peer.pubkey;
+                               });
+        if (it != ledger_peers->end()
+            and std::find(result.begin(), result.end(), *it)
+                == result.end()) {
+          result.push_back(*it);
+        }
+      }
+      return result;
+    }
+
+    std::unique_ptr<proto::Loader::Stub> BlockLoaderImpl::stub(
+        const model::Peer &peer) {
+      return proto::Loader::NewStub(channels_->channel(peer.address));
+    }
+  }  // namespace network
+}  // namespace iroha
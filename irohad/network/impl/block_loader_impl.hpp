@@ -0,0 +1,100 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_BLOCK_LOADER_IMPL_HPP
+#define IROHA_BLOCK_LOADER_IMPL_HPP
+
+#include <memory>
+#include <vector>
+#include "ametsuchi/block_query.hpp"
+#include "ametsuchi/peer_query.hpp"
+#include "loader.grpc.pb.h"
+#include "logger/logger.hpp"
+#include "model/converters/pb_block_factory.hpp"
+#include "network/block_loader.hpp"
+#include "network/impl/channel_registry.hpp"
+
+namespace iroha {
+  namespace network {
+
+    /**
+     * Block loader which downloads blocks from Loader service of peers
+     */
+    class BlockLoaderImpl : public BlockLoader {
+     public:
+      /**
+       * @param peer_query - source of peer addresses, peers given without
+       * address are looked up by public key
+       * @param block_query - local ledger, defines where download starts
+       * @param channels - registry of peer channels
+       */
+      BlockLoaderImpl(std::shared_ptr<ametsuchi::PeerQuery> peer_query,
+                      std::shared_ptr<ametsuchi::BlockQuery> block_query,
+                      std::shared_ptr<ChannelRegistry> channels);
+
+      rxcpp::observable<model::Block> requestBlocks(
+          model::Peer &target_peer, model::Block &topBlock) override;
+
+      rxcpp::observable<model::Block> retrieveChain(
+          const std::vector<model::Peer> &peers, uint64_t height) override;
+
+      nonstd::optional<model::Block> retrieveBlock(
+          const model::Peer &peer,
+          uint64_t height,
+          const hash256_t &hash) override;
+
+     private:
+      /**
+       * Ranges shorter than this are not split between peers
+       */
+      static constexpr uint64_t kMinPartSize = 16;
+
+      /**
+       * Deadline of single block request in milliseconds
+       */
+      static constexpr int64_t kBlockTimeout = 3000;
+
+      /**
+       * Fetch consecutive blocks from one peer
+       * @param peer - peer with known address
+       * @param height - height of the first block
+       * @param count - number of blocks, 0 fetches blocks up to peer top
+       * @return fetched blocks, may be shorter than requested on failure
+       */
+      std::vector<model::Block> fetch(const model::Peer &peer,
+                                      uint64_t height,
+                                      uint64_t count);
+
+      /**
+       * Fill in addresses of peers given by public key only
+       * @return peers with known address
+       */
+      std::vector<model::Peer> resolve(const std::vector<model::Peer> &peers);
+
+      std::unique_ptr<proto::Loader::Stub> stub(const model::Peer &peer);
+
+      std::shared_ptr<ametsuchi::PeerQuery> peer_query_;
+      std::shared_ptr<ametsuchi::BlockQuery> block_query_;
+      std::shared_ptr<ChannelRegistry> channels_;
+      model::converters::PbBlockFactory factory_;
+
+      logger::Logger log_;
+    };
+  }  // namespace network
+}  // namespace iroha
+
+#endif  // IROHA_BLOCK_LOADER_IMPL_HPP
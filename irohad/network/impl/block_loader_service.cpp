@@ -0,0 +1,169 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "network/impl/block_loader_service.hpp"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+namespace iroha {
+  namespace network {
+
+    constexpr int64_t BlockLoaderService::kSubscriberPoll;
+
+    BlockLoaderService::BlockLoaderService(
+        std::shared_ptr<ametsuchi::BlockQuery> storage)
+        : storage_(std::move(storage)) {
+      log_ = logger::log("LoaderService");
+    }
+
+    grpc::Status BlockLoaderService::retrieveBlocks(
+        ::grpc::ServerContext *context,
+        const proto::BlocksRequest *request,
+        ::grpc::ServerWriter<protocol::Block> *writer) {
+      uint64_t top = storage_->getTopBlockHeight();
+      auto from = request->height();
+      if (from == 0 or from > std::numeric_limits<uint32_t>::max()) {
+        return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT,
+                            "invalid height");
+      }
+      auto to = request->count() == 0
+          ? top
+          : std::min(top, from + request->count() - 1);
+      if (from > to) {
+        return grpc::Status::OK;
+      }
+      log_->info("send blocks {}..{}", from, to);
+      send(context, writer, from, to);
+      return grpc::Status::OK;
+    }
+
+    grpc::Status BlockLoaderService::retrieveBlock(
+        ::grpc::ServerContext *context,
+        const proto::BlockRequest *request,
+        protocol::Block *response) {
+      auto height = request->height();
+      if (height == 0 or height > std::numeric_limits<uint32_t>::max()
+          or request->hash().size() != hash256_t::size()) {
+        return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT,
+                            "invalid request");
+      }
+
+      nonstd::optional<model::Block> result;
+      storage_->getBlocks(height, height)
+          .as_blocking()
+          .subscribe([&result](const model::Block &block) { result = block; });
+      if (not result or result->hash.to_string() != request->hash()) {
+        return grpc::Status(grpc::StatusCode::NOT_FOUND, "no such block");
+      }
+      *response = factory_.serialize(*result);
+      return grpc::Status::OK;
+    }
+
+    grpc::Status BlockLoaderService::subscribeBlocks(
+        ::grpc::ServerContext *context,
+        const proto::BlocksRequest *request,
+        ::grpc::ServerWriter<protocol::Block> *writer) {
+      auto next = request->height();
+      if (next == 0 or next > std::numeric_limits<uint32_t>::max()) {
+        return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT,
+                            "invalid height");
+      }
+      log_->info("subscriber from block {}", next);
+
+      while (not context->IsCancelled()) {
+        uint64_t top = storage_->getTopBlockHeight();
+        if (next <= top) {
+          if (not send(context, writer, next, top)) {
+            break;
+          }
+          next = top + 1;
+        }
+        waitCommit(next);
+      }
+      log_->info("subscriber has gone at block {}", next);
+      return grpc::Status::OK;
+    }
+
+    grpc::Status BlockLoaderService::subscribeChanges(
+        ::grpc::ServerContext *context,
+        const proto::BlocksRequest *request,
+        ::grpc::ServerWriter<protocol::WsvChanges> *writer) {
+      auto next = request->height();
+      if (next == 0 or next > std::numeric_limits<uint32_t>::max()) {
+        return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT,
+                            "invalid height");
+      }
+      log_->info("changes subscriber from block {}", next);
+
+      while (not context->IsCancelled()) {
+        uint64_t top = storage_->getTopBlockHeight();
+        if (next <= top) {
+          auto writing = true;
+          storage_->getWsvChanges(next, top)
+              .take_while(
+                  [&writing](const protocol::WsvChanges &) { return writing; })
+              .as_blocking()
+              .subscribe([&writing, context, writer](
+                             const protocol::WsvChanges &changes) {
+                writing = not context->IsCancelled() and writer->Write(changes);
+              });
+          if (not writing) {
+            break;
+          }
+          next = top + 1;
+        }
+        waitCommit(next);
+      }
+      log_->info("changes subscriber has gone at block {}", next);
+      return grpc::Status::OK;
+    }
+
+    void BlockLoaderService::committed(uint64_t height) {
+      {
+        std::lock_guard<std::mutex> lock(committed_mutex_);
+        committed_height_ = std::max(committed_height_, height);
+      }
+      committed_cv_.notify_all();
+    }
+
+    void BlockLoaderService::waitCommit(uint64_t height) {
+      std::unique_lock<std::mutex> lock(committed_mutex_);
+      committed_cv_.wait_for(
+          lock, std::chrono::milliseconds(kSubscriberPoll), [this, height] {
+            return committed_height_ >= height;
+          });
+    }
+
+    bool BlockLoaderService::send(
+        ::grpc::ServerContext *context,
+        ::grpc::ServerWriter<protocol::Block> *writer,
+        uint64_t from,
+        uint64_t to) {
+      // stop reading blocks once the client has gone
+      auto writing = true;
+      // blocks are sent as stored, without conversion to model and back
+      storage_->getWireBlocks(from, to)
+          .take_while([&writing](const protocol::Block &) { return writing; })
+          .as_blocking()
+          .subscribe([&writing, context, writer](const protocol::Block &block) {
+            writing = not context->IsCancelled() and writer->Write(block);
+          });
+      return writing;
+    }
+  }  // namespace network
+}  // namespace iroha
@@ -0,0 +1,101 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_BLOCK_LOADER_SERVICE_HPP
+#define IROHA_BLOCK_LOADER_SERVICE_HPP
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include "ametsuchi/block_query.hpp"
+#include "loader.grpc.pb.h"
+#include "logger/logger.hpp"
+#include "model/converters/pb_block_factory.hpp"
+
+namespace iroha {
+  namespace network {
+
+    /**
+     * Service which serves committed blocks to lagging peers, and streams
+     * new blocks to observer nodes and changes of world state view to
+     * export consumers
+     */
+    class BlockLoaderService : public proto::Loader::Service {
+     public:
+      explicit BlockLoaderService(
+          std::shared_ptr<ametsuchi::BlockQuery> storage);
+
+      grpc::Status retrieveBlocks(
+          ::grpc::ServerContext *context,
+          const proto::BlocksRequest *request,
+          ::grpc::ServerWriter<protocol::Block> *writer) override;
+
+      grpc::Status retrieveBlock(::grpc::ServerContext *context,
+                                 const proto::BlockRequest *request,
+                                 protocol::Block *response) override;
+
+      grpc::Status subscribeBlocks(
+          ::grpc::ServerContext *context,
+          const proto::BlocksRequest *request,
+          ::grpc::ServerWriter<protocol::Block> *writer) override;
+
+      grpc::Status subscribeChanges(
+          ::grpc::ServerContext *context,
+          const proto::BlocksRequest *request,
+          ::grpc::ServerWriter<protocol::WsvChanges> *writer) override;
+
+      /**
+       * Wake up subscribers waiting for block
+       * @param height - height of committed block
+       */
+      void committed(uint64_t height);
+
+     private:
+      /**
+       * Period in milliseconds in which waiting subscribers check whether
+       * their client has gone
+       */
+      static constexpr int64_t kSubscriberPoll = 1000;
+
+      /**
+       * Write stored blocks in range to client
+       * @return false if the client has gone
+       */
+      bool send(::grpc::ServerContext *context,
+                ::grpc::ServerWriter<protocol::Block> *writer,
+                uint64_t from,
+                uint64_t to);
+
+      /**
+       * Wait until block with given height is committed or poll period
+       * elapses
+       */
+      void waitCommit(uint64_t height);
+
+      std::mutex committed_mutex_;
+      std::condition_variable committed_cv_;
+      uint64_t committed_height_ = 0;
+
+      std::shared_ptr<ametsuchi::BlockQuery> storage_;
+      model::converters::PbBlockFactory factory_;
+
+      logger::Logger log_;
+    };
+  }  // namespace network
+}  // namespace iroha
+
+#endif  // IROHA_BLOCK_LOADER_SERVICE_HPP
@@ -0,0 +1,134 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "network/impl/block_subscriber.hpp"
+#include <chrono>
+
+namespace iroha {
+  namespace network {
+
+    constexpr int64_t BlockSubscriber::kRetryDelay;
+
+    BlockSubscriber::BlockSubscriber(
+        std::vector<std::string> validators,
+        std::shared_ptr<ChannelRegistry> channels,
+        std::shared_ptr<validation::ChainValidator> validator,
+        std::shared_ptr<ametsuchi::MutableFactory> mutable_factory,
+        std::shared_ptr<ametsuchi::BlockQuery> block_query)
+        : validators_(std::move(validators)),
+          channels_(std::move(channels)),
+          validator_(std::move(validator)),
+          mutable_factory_(std::move(mutable_factory)),
+          block_query_(std::move(block_query)) {
+      log_ = logger::log("BlockSubscriber");
+    }
+
+    BlockSubscriber::~BlockSubscriber() {
+      stop();
+    }
+
+    void BlockSubscriber::start() {
+      if (validators_.empty()) {
+        log_->error("no validators to follow");
+        return;
+      }
+      thread_ = std::thread([this] { this->run(); });
+    }
+
+    void BlockSubscriber::stop() {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+        if (context_) {
+          context_->TryCancel();
+        }
+      }
+      stopped_cv_.notify_all();
+      if (thread_.joinable()) {
+        thread_.join();
+      }
+    }
+
+    rxcpp::observable<Commit> BlockSubscriber::on_commit() {
+      return notifier_.get_observable();
+    }
+
+    void BlockSubscriber::run() {
+      for (size_t i = 0;; i = (i + 1) % validators_.size()) {
+        follow(validators_[i]);
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (stopped_cv_.wait_for(lock,
+                                 std::chrono::milliseconds(kRetryDelay),
+                                 [this] { return stopped_; })) {
+          return;
+        }
+      }
+    }
+
+    void BlockSubscriber::follow(const std::string &address) {
+      grpc::ClientContext context;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopped_) {
+          return;
+        }
+        context_ = &context;
+      }
+
+      proto::BlocksRequest request;
+      request.set_height(block_query_->getTopBlockHeight() + 1);
+      log_->info("follow {} from block {}", address, request.height());
+      auto reader = proto::Loader::NewStub(channels_->channel(address))
+                        ->subscribeBlocks(&context, request);
+      protocol::Block pb_block;
+      auto drained = true;
+      while (reader->Read(&pb_block)) {
+        if (not apply(std::make_shared<const model::Block>(
+                factory_.deserialize(pb_block)))) {
+          log_->warn("{} sent invalid block", address);
+          drained = false;
+          context.TryCancel();
+          break;
+        }
+      }
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        context_ = nullptr;
+      }
+      auto status = reader->Finish();
+      if (drained and not status.ok()) {
+        log_->warn("stream of {} has ended: {}", address,
+                   status.error_message());
+      }
+    }
+
+    bool BlockSubscriber::apply(std::shared_ptr<const model::Block> block) {
+      auto storage = mutable_factory_->createMutableStorage();
+      if (not storage) {
+        log_->error("cannot create mutable storage");
+        return false;
+      }
+      if (not validator_->validateBlock(*block, *storage)) {
+        return false;
+      }
+      mutable_factory_->commit(std::move(storage));
+      notifier_.get_subscriber().on_next(
+          rxcpp::observable<>::just(std::move(block)));
+      return true;
+    }
+  }  // namespace network
+}  // namespace iroha
@@ -0,0 +1,121 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_BLOCK_SUBSCRIBER_HPP
+#define IROHA_BLOCK_SUBSCRIBER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <rxcpp/rx.hpp>
+#include "ametsuchi/block_query.hpp"
+#include "ametsuchi/mutable_factory.hpp"
+#include "loader.grpc.pb.h"
+#include "logger/logger.hpp"
+#include "model/commit.hpp"
+#include "model/converters/pb_block_factory.hpp"
+#include "network/impl/channel_registry.hpp"
+#include "validation/chain_validator.hpp"
+
+namespace iroha {
+  namespace network {
+
+    /**
+     * Follows the ledger of validators without taking part in consensus.
+     * Committed blocks are streamed from one validator at a time, checked by
+     * chain validator and applied to local storage. Another validator is
+     * used when the stream breaks or a block is invalid
+     */
+    class BlockSubscriber {
+     public:
+      /**
+       * @param validators - addresses of validators to follow
+       * @param channels - registry of peer channels
+       * @param validator - validator of received blocks
+       * @param mutable_factory - storage blocks are applied to
+       * @param block_query - local ledger, defines where the stream starts
+       */
+      BlockSubscriber(std::vector<std::string> validators,
+                      std::shared_ptr<ChannelRegistry> channels,
+                      std::shared_ptr<validation::ChainValidator> validator,
+                      std::shared_ptr<ametsuchi::MutableFactory> mutable_factory,
+                      std::shared_ptr<ametsuchi::BlockQuery> block_query);
+
+      ~BlockSubscriber();
+
+      /**
+       * Start following validators on a thread of its own
+       */
+      void start();
+
+      /**
+       * Cancel the stream and join the thread
+       */
+      void stop();
+
+      /**
+       * @return blocks applied to local storage
+       */
+      rxcpp::observable<Commit> on_commit();
+
+     private:
+      /**
+       * Delay in milliseconds before the next validator is subscribed to
+       * after a stream has ended
+       */
+      static constexpr int64_t kRetryDelay = 1000;
+
+      void run();
+
+      /**
+       * Apply blocks streamed by validator until the stream ends
+       * @param address - address of validator
+       */
+      void follow(const std::string &address);
+
+      /**
+       * Validate block and commit it to local storage
+       * @return true if block is applied
+       */
+      bool apply(std::shared_ptr<const model::Block> block);
+
+      std::vector<std::string> validators_;
+      std::shared_ptr<ChannelRegistry> channels_;
+      std::shared_ptr<validation::ChainValidator> validator_;
+      std::shared_ptr<ametsuchi::MutableFactory> mutable_factory_;
+      std::shared_ptr<ametsuchi::BlockQuery> block_query_;
+      model::converters::PbBlockFactory factory_;
+
+      rxcpp::subjects::subject<Commit> notifier_;
+
+      // context of current stream, cancelled on stop
+      std::mutex mutex_;
+      std::condition_variable stopped_cv_;
+      grpc::ClientContext *context_ = nullptr;
+      bool stopped_ = false;
+      std::thread thread_;
+
+      logger::Logger log_;
+    };
+  }  // namespace network
+}  // namespace iroha
+
+#endif  // IROHA_BLOCK_SUBSCRIBER_HPP
@@ -0,0 +1,185 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "network/impl/channel_options.hpp"
+#include <cstdlib>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#elif defined(__aarch64__) && defined(__linux__)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+
+namespace iroha {
+  namespace network {
+
+    namespace {
+      grpc_compression_algorithm algorithm(
+          ChannelOptions::Compression compression) {
+        switch (compression) {
+          case ChannelOptions::Compression::Gzip:
+            return GRPC_COMPRESS_GZIP;
+          case ChannelOptions::Compression::Deflate:
+            return GRPC_COMPRESS_DEFLATE;
+          default:
+            return GRPC_COMPRESS_NONE;
+        }
+      }
+
+      bool hasAesInstructions() {
+#if defined(__x86_64__) || defined(__i386__)
+        unsigned eax, ebx, ecx, edx;
+        return __get_cpuid(1, &eax, &ebx, &ecx, &edx) and (ecx & bit_AES);
+#elif defined(__aarch64__) && defined(__linux__)
+        return getauxval(AT_HWCAP) & HWCAP_AES;
+#else
+        return false;
+#endif
+      }
+
+      const char *kAesSuites =
+          "ECDHE-ECDSA-AES128-GCM-SHA256:ECDHE-RSA-AES128-GCM-SHA256:"
+          "ECDHE-ECDSA-AES256-GCM-SHA384:ECDHE-RSA-AES256-GCM-SHA384";
+      const char *kChaChaSuites =
+          "ECDHE-ECDSA-CHACHA20-POLY1305:ECDHE-RSA-CHACHA20-POLY1305";
+    }  // namespace
+
+    bool ChannelOptions::Tls::enabled() const {
+      return not certificate.empty();
+    }
+
+    nonstd::optional<ChannelOptions::Compression> parseCompression(
+        const std::string &name) {
+      if (name == "none") {
+        return ChannelOptions::Compression::None;
+      }
+      if (name == "gzip") {
+        return ChannelOptions::Compression::Gzip;
+      }
+      if (name == "deflate") {
+        return ChannelOptions::Compression::Deflate;
+      }
+      return nonstd::nullopt;
+    }
+
+    grpc::ChannelArguments channelArguments(const ChannelOptions &options) {
+      grpc::ChannelArguments args;
+      if (options.compression != ChannelOptions::Compression::None) {
+        args.SetCompressionAlgorithm(algorithm(options.compression));
+      }
+      if (options.keepalive_time.count() > 0) {
+        args.SetInt(GRPC_ARG_KEEPALIVE_TIME_MS,
+                    static_cast<int>(options.keepalive_time.count()));
+        // peers stay connected between rounds, when no call is active
+        args.SetInt(GRPC_ARG_KEEPALIVE_PERMIT_WITHOUT_CALLS, 1);
+      }
+      if (options.keepalive_timeout.count() > 0) {
+        args.SetInt(GRPC_ARG_KEEPALIVE_TIMEOUT_MS,
+                    static_cast<int>(options.keepalive_timeout.count()));
+      }
+      if (options.max_message_size > 0) {
+        args.SetInt(GRPC_ARG_MAX_RECEIVE_MESSAGE_LENGTH,
+                    options.max_message_size);
+        args.SetInt(GRPC_ARG_MAX_SEND_MESSAGE_LENGTH,
+                    options.max_message_size);
+      }
+      if (options.initial_window_size > 0) {
+        args.SetInt(GRPC_ARG_HTTP2_STREAM_LOOKAHEAD_BYTES,
+                    options.initial_window_size);
+      }
+      return args;
+    }
+
+    std::shared_ptr<grpc::ChannelCredentials> channelCredentials(
+        const ChannelOptions &options) {
+      if (not options.tls.enabled()) {
+        return grpc::InsecureChannelCredentials();
+      }
+      grpc::SslCredentialsOptions ssl;
+      ssl.pem_root_certs = options.tls.root_certificates;
+      ssl.pem_private_key = options.tls.private_key;
+      ssl.pem_cert_chain = options.tls.certificate;
+      return grpc::SslCredentials(ssl);
+    }
+
+    std::shared_ptr<grpc::ServerCredentials> serverCredentials(
+        const ChannelOptions &options,
+        std::shared_ptr<grpc::AuthMetadataProcessor> processor) {
+      if (not options.tls.enabled()) {
+        return grpc::InsecureServerCredentials();
+      }
+      grpc::SslServerCredentialsOptions ssl(
+          processor
+              ? GRPC_SSL_REQUEST_AND_REQUIRE_CLIENT_CERTIFICATE_AND_VERIFY
+              : GRPC_SSL_DONT_REQUEST_CLIENT_CERTIFICATE);
+      ssl.pem_root_certs = options.tls.root_certificates;
+      ssl.pem_key_cert_pairs.push_back(
+          {options.tls.private_key, options.tls.certificate});
+      auto credentials = grpc::SslServerCredentials(ssl);
+      if (processor) {
+        credentials->SetAuthMetadataProcessor(processor);
+      }
+      return credentials;
+    }
+
+    std::string preferredCipherSuites() {
+      return hasAesInstructions()
+          ? std::string(kAesSuites) + ":" + kChaChaSuites
+          : std::string(kChaChaSuites) + ":" + kAesSuites;
+    }
+
+    void selectCipherSuites() {
+      // grpc reads the list once, on the first secure channel or server;
+      // suites of TLS 1.3 are ordered by BoringSSL the same way by itself
+      setenv("GRPC_SSL_CIPHER_SUITES", preferredCipherSuites().c_str(), 0);
+    }
+
+    void configureServer(grpc::ServerBuilder &builder,
+                         const ChannelOptions &options) {
+      if (options.compression != ChannelOptions::Compression::None) {
+        builder.SetDefaultCompressionAlgorithm(
+            algorithm(options.compression));
+      }
+      if (options.keepalive_time.count() > 0) {
+        auto time = static_cast<int>(options.keepalive_time.count());
+        builder.AddChannelArgument(GRPC_ARG_KEEPALIVE_TIME_MS, time);
+        builder.AddChannelArgument(GRPC_ARG_KEEPALIVE_PERMIT_WITHOUT_CALLS,
+                                   1);
+        // pings of clients with the same period are not treated as abuse
+        builder.AddChannelArgument(
+            GRPC_ARG_HTTP2_MIN_PING_INTERVAL_WITHOUT_DATA_MS, time);
+      }
+      if (options.keepalive_timeout.count() > 0) {
+        builder.AddChannelArgument(
+            GRPC_ARG_KEEPALIVE_TIMEOUT_MS,
+            static_cast<int>(options.keepalive_timeout.count()));
+      }
+      if (options.max_message_size > 0) {
+        builder.AddChannelArgument(GRPC_ARG_MAX_RECEIVE_MESSAGE_LENGTH,
+                                   options.max_message_size);
+        builder.AddChannelArgument(GRPC_ARG_MAX_SEND_MESSAGE_LENGTH,
+                                   options.max_message_size);
+      }
+      if (options.initial_window_size > 0) {
+        builder.AddChannelArgument(GRPC_ARG_HTTP2_STREAM_LOOKAHEAD_BYTES,
+                                   options.initial_window_size);
+      }
+    }
+
+  }  // namespace network
+}  // namespace iroha
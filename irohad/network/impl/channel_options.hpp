@@ -0,0 +1,139 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_CHANNEL_OPTIONS_HPP
+#define IROHA_CHANNEL_OPTIONS_HPP
+
+#include <grpc++/grpc++.h>
+#include <chrono>
+#include <memory>
+#include <nonstd/optional.hpp>
+#include <string>
+
+namespace iroha {
+  namespace network {
+
+    /**
+     * Transport settings shared by channels and servers of a peer.
+     * Zero values keep defaults of gRPC
+     */
+    struct ChannelOptions {
+      enum class Compression { None, Gzip, Deflate };
+
+      /**
+       * Algorithm of message compression
+       */
+      Compression compression = Compression::None;
+
+      /**
+       * Period of keepalive pings on idle connections, disabled when zero
+       */
+      std::chrono::milliseconds keepalive_time{0};
+
+      /**
+       * Time to wait for keepalive acknowledgement before closing
+       * the connection
+       */
+      std::chrono::milliseconds keepalive_timeout{0};
+
+      /**
+       * Upper bound of sent and received message size in bytes
+       */
+      int max_message_size = 0;
+
+      /**
+       * Initial HTTP/2 flow control window in bytes, larger windows keep
+       * links with long round trip busy
+       */
+      int initial_window_size = 0;
+
+      /**
+       * Certificates of transport security, channels and servers are
+       * plaintext when certificate is empty
+       */
+      struct Tls {
+        // PEM chain of peer, issued for hex of its public key
+        std::string certificate;
+        // PEM private key of certificate
+        std::string private_key;
+        // PEM roots which issue certificates of ledger peers
+        std::string root_certificates;
+        // whether torii is served over TLS as well, clients of torii do
+        // not present certificates
+        bool torii = false;
+        // number of TLS sessions kept for resumption of handshakes
+        int session_cache_size = 1024;
+
+        bool enabled() const;
+      };
+
+      Tls tls;
+    };
+
+    /**
+     * Parse name of compression algorithm
+     * @param name - "none", "gzip" or "deflate"
+     * @return algorithm, or nullopt for unknown name
+     */
+    nonstd::optional<ChannelOptions::Compression> parseCompression(
+        const std::string &name);
+
+    /**
+     * @return arguments of client channel with given settings
+     */
+    grpc::ChannelArguments channelArguments(const ChannelOptions &options);
+
+    /**
+     * @return credentials of client channel, insecure ones if TLS is
+     * disabled
+     */
+    std::shared_ptr<grpc::ChannelCredentials> channelCredentials(
+        const ChannelOptions &options);
+
+    /**
+     * Make credentials of server listening port
+     * @param options - transport settings
+     * @param processor - authenticates calls of peers, when set clients
+     * must present certificate issued by root certificates
+     * @return credentials of server, insecure ones if TLS is disabled
+     */
+    std::shared_ptr<grpc::ServerCredentials> serverCredentials(
+        const ChannelOptions &options,
+        std::shared_ptr<grpc::AuthMetadataProcessor> processor = nullptr);
+
+    /**
+     * Cipher suites of TLS 1.2 in order of preference: AES-GCM first when
+     * CPU has AES instructions, ChaCha20-Poly1305 first otherwise
+     */
+    std::string preferredCipherSuites();
+
+    /**
+     * Set preferred cipher suites for grpc unless GRPC_SSL_CIPHER_SUITES
+     * is already set. Must be called before grpc is initialized
+     */
+    void selectCipherSuites();
+
+    /**
+     * Apply settings to server which is being built
+     */
+    void configureServer(grpc::ServerBuilder &builder,
+                         const ChannelOptions &options);
+
+  }  // namespace network
+}  // namespace iroha
+
+#endif  // IROHA_CHANNEL_OPTIONS_HPP
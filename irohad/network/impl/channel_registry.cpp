@@ -0,0 +1,126 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "network/impl/channel_registry.hpp"
+#include "network/impl/peer_authenticator.hpp"
+
+namespace iroha {
+  namespace network {
+
+    ChannelRegistry::ChannelRegistry(ChannelOptions options)
+        : options_(options), credentials_(channelCredentials(options_)) {
+      if (options_.tls.enabled() and options_.tls.session_cache_size > 0) {
+        sessions_ = grpc_ssl_session_cache_create_lru(
+            options_.tls.session_cache_size);
+      }
+    }
+
+    ChannelRegistry::~ChannelRegistry() {
+      // channels hold references of their own to the cache
+      if (sessions_) {
+        grpc_ssl_session_cache_destroy(sessions_);
+      }
+    }
+
+    std::shared_ptr<grpc::Channel> ChannelRegistry::create(
+        const std::string &address) {
+      auto args = channelArguments(options_);
+      if (sessions_) {
+        auto arg = grpc_ssl_session_cache_create_channel_arg(sessions_);
+        args.SetPointerWithVtable(
+            arg.key, arg.value.pointer.p, arg.value.pointer.vtable);
+      }
+      auto name = nameOf(address, names_, pinned_);
+      if (options_.tls.enabled() and name) {
+        // peers are addressed by ip, certificate is checked against key
+        args.SetSslTargetNameOverride(*name);
+      }
+      return grpc::CreateCustomChannel(address, credentials_, args);
+    }
+
+    std::shared_ptr<grpc::Channel> ChannelRegistry::channel(
+        const std::string &address) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto &channel = channels_[address];
+      if (not channel) {
+        channel = create(address);
+      }
+      return channel;
+    }
+
+    void ChannelRegistry::update(const std::vector<model::Peer> &peers) {
+      std::unordered_map<std::string, std::string> names;
+      for (const auto &peer : peers) {
+        names[peer.address] = PeerAuthenticator::certificateName(peer.pubkey);
+      }
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (auto it = channels_.begin(); it != channels_.end();) {
+        auto name = nameOf(it->first, names, pinned_);
+        auto created = nameOf(it->first, names_, pinned_);
+        // over TLS channel expects certificate of the key it was created
+        // with, so it is replaced when key of peer is changed
+        auto stale = options_.tls.enabled()
+            and (not created or not name or *created != *name);
+        if (not name or stale) {
+          it = channels_.erase(it);
+        } else {
+          ++it;
+        }
+      }
+      names_.swap(names);
+      for (auto table : {&names_, &pinned_}) {
+        for (const auto &name : *table) {
+          auto &channel = channels_[name.first];
+          if (not channel) {
+            channel = create(name.first);
+          }
+        }
+      }
+    }
+
+    void ChannelRegistry::pin(const std::string &address,
+                              const ed25519::pubkey_t &key) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto created = nameOf(address, names_, pinned_);
+      auto previous = created ? *created : std::string();
+      pinned_[address] = PeerAuthenticator::certificateName(key);
+      auto name = nameOf(address, names_, pinned_);
+      if (options_.tls.enabled() and (not created or previous != *name)) {
+        channels_.erase(address);
+      }
+    }
+
+    const std::string *ChannelRegistry::nameOf(
+        const std::string &address,
+        const std::unordered_map<std::string, std::string> &names,
+        const std::unordered_map<std::string, std::string> &pinned) {
+      // address of ledger peer is checked against key of the peer
+      auto name = names.find(address);
+      if (name != names.end()) {
+        return &name->second;
+      }
+      name = pinned.find(address);
+      return name == pinned.end() ? nullptr : &name->second;
+    }
+
+    size_t ChannelRegistry::size() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return channels_.size();
+    }
+  }  // namespace network
+}  // namespace iroha
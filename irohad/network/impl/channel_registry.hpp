@@ -0,0 +1,108 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_CHANNEL_REGISTRY_HPP
+#define IROHA_CHANNEL_REGISTRY_HPP
+
+#include <grpc++/grpc++.h>
+#include <grpc/grpc_security.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "model/peer.hpp"
+#include "network/impl/channel_options.hpp"
+
+namespace iroha {
+  namespace network {
+
+    /**
+     * Registry of gRPC channels to ledger peers.
+     * Channel to a peer is created once and shared by all components
+     * which talk to it, so connections survive between rounds.
+     * Over TLS channels share credentials and a cache of sessions, so
+     * reconnection resumes the session instead of full handshake, and
+     * a peer is required to present certificate issued for its key.
+     */
+    class ChannelRegistry {
+     public:
+      /**
+       * @param options - transport settings of created channels
+       */
+      explicit ChannelRegistry(ChannelOptions options = ChannelOptions());
+
+      ~ChannelRegistry();
+
+      /**
+       * Get channel to given address, creating it on first request
+       * @param address - endpoint of peer
+       * @return channel shared with other users of the registry
+       */
+      std::shared_ptr<grpc::Channel> channel(const std::string &address);
+
+      /**
+       * Align registry with current peer set of the ledger.
+       * Channels of new peers are created, channels of removed peers and
+       * of peers with changed key are released, channels of remaining
+       * peers are kept
+       * @param peers - current ledger peers
+       */
+      void update(const std::vector<model::Peer> &peers);
+
+      /**
+       * Check certificate of peer at address against key, though the
+       * address is not of a ledger peer, e.g. of validator followed by
+       * observer. Pinned key is kept on update, unless ledger peer has
+       * the same address
+       * @param address - endpoint of peer
+       * @param key - key certificate of peer is issued for
+       */
+      void pin(const std::string &address, const ed25519::pubkey_t &key);
+
+      /**
+       * @return number of open channels
+       */
+      size_t size() const;
+
+     private:
+      std::shared_ptr<grpc::Channel> create(const std::string &address);
+
+      /**
+       * @return certificate name expected at address, null if unknown
+       */
+      static const std::string *nameOf(
+          const std::string &address,
+          const std::unordered_map<std::string, std::string> &names,
+          const std::unordered_map<std::string, std::string> &pinned);
+
+      const ChannelOptions options_;
+      std::shared_ptr<grpc::ChannelCredentials> credentials_;
+      // sessions of all peers, null when TLS is disabled
+      grpc_ssl_session_cache *sessions_ = nullptr;
+      mutable std::mutex mutex_;
+      std::unordered_map<std::string, std::shared_ptr<grpc::Channel>>
+          channels_;
+      // certificate names of ledger peers by address
+      std::unordered_map<std::string, std::string> names_;
+      // certificate names pinned by address
+      std::unordered_map<std::string, std::string> pinned_;
+    };
+  }  // namespace network
+}  // namespace iroha
+
+#endif  // IROHA_CHANNEL_REGISTRY_HPP
@@ -0,0 +1,72 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "network/impl/client_completion_pool.hpp"
+#include <algorithm>
+#include "affinity/affinity.hpp"
+
+namespace iroha {
+  namespace network {
+
+    constexpr size_t ClientCompletionPool::kDefaultThreads;
+
+    ClientCompletionPool::ClientCompletionPool(size_t threads) {
+      threads = std::max<size_t>(threads, 1);
+      for (size_t i = 0; i < threads; ++i) {
+        queues_.push_back(std::make_unique<grpc::CompletionQueue>());
+      }
+      for (size_t i = 0; i < threads; ++i) {
+        threads_.emplace_back([this, i] {
+          affinity::nameCurrentThread("grpc-client-" + std::to_string(i));
+          poll(*queues_[i]);
+        });
+      }
+    }
+
+    ClientCompletionPool::~ClientCompletionPool() {
+      for (auto &queue : queues_) {
+        queue->Shutdown();
+      }
+      for (auto &thread : threads_) {
+        thread.join();
+      }
+    }
+
+    grpc::CompletionQueue &ClientCompletionPool::queue() {
+      return *queues_[next_++ % queues_.size()];
+    }
+
+    size_t ClientCompletionPool::size() const {
+      return queues_.size();
+    }
+
+    void ClientCompletionPool::poll(grpc::CompletionQueue &queue) {
+      void *tag;
+      auto ok = false;
+      while (queue.Next(&tag, &ok)) {
+        std::unique_ptr<Call> call(static_cast<Call *>(tag));
+        call->complete(ok);
+      }
+    }
+
+    ClientCompletionPool &clientCompletionPool(size_t threads) {
+      static ClientCompletionPool pool(threads);
+      return pool;
+    }
+
+  }  // namespace network
+}  // namespace iroha
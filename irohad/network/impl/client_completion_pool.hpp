@@ -0,0 +1,98 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_CLIENT_COMPLETION_POOL_HPP
+#define IROHA_CLIENT_COMPLETION_POOL_HPP
+
+#include <grpc++/grpc++.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace iroha {
+  namespace network {
+
+    /**
+     * Completion queues of asynchronous gRPC client calls, shared by all
+     * clients of the process, each polled by a thread of its own. Clients
+     * take queues in turn, so calls are spread over a fixed number of
+     * threads instead of one thread per client.
+     * Tags of calls are Call objects, which are completed and deleted by
+     * the polling thread.
+     */
+    class ClientCompletionPool {
+     public:
+      static constexpr size_t kDefaultThreads = 2;
+
+      /**
+       * Tag of call completed on the queue
+       */
+      class Call {
+       public:
+        virtual ~Call() = default;
+
+        /**
+         * Called on thread of the queue when call is finished, the call is
+         * deleted afterwards
+         * @param ok - false if queue is shutting down
+         */
+        virtual void complete(bool ok) = 0;
+      };
+
+      /**
+       * @param threads - number of queues and their threads
+       */
+      explicit ClientCompletionPool(size_t threads = kDefaultThreads);
+
+      ClientCompletionPool(const ClientCompletionPool &) = delete;
+      ClientCompletionPool &operator=(const ClientCompletionPool &) = delete;
+
+      /**
+       * Shut down queues and wait for remaining calls to be completed
+       */
+      ~ClientCompletionPool();
+
+      /**
+       * @return queue for calls of a client, queues are given in turn
+       */
+      grpc::CompletionQueue &queue();
+
+      /**
+       * @return number of queues
+       */
+      size_t size() const;
+
+     private:
+      void poll(grpc::CompletionQueue &queue);
+
+      std::vector<std::unique_ptr<grpc::CompletionQueue>> queues_;
+      std::vector<std::thread> threads_;
+      std::atomic<size_t> next_{0};
+    };
+
+    /**
+     * Pool shared by clients of the process, created on first call
+     * @param threads - number of threads, applies only to the first call
+     */
+    ClientCompletionPool &clientCompletionPool(
+        size_t threads = ClientCompletionPool::kDefaultThreads);
+
+  }  // namespace network
+}  // namespace iroha
+
+#endif  // IROHA_CLIENT_COMPLETION_POOL_HPP
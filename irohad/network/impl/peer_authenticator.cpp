@@ -0,0 +1,92 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "network/impl/peer_authenticator.hpp"
+#include <grpc/grpc_security_constants.h>
+
+namespace iroha {
+  namespace network {
+
+    namespace {
+      // methods of block loader, see loader.proto
+      const std::string kLoaderPath = "/iroha.network.proto.Loader/";
+    }  // namespace
+
+    std::string PeerAuthenticator::certificateName(
+        const ed25519::pubkey_t &key) {
+      return key.to_hexstring();
+    }
+
+    void PeerAuthenticator::update(const std::vector<model::Peer> &peers) {
+      std::unordered_set<std::string> names;
+      for (const auto &peer : peers) {
+        names.insert(certificateName(peer.pubkey));
+      }
+      std::lock_guard<std::mutex> lock(mutex_);
+      names_.swap(names);
+    }
+
+    void PeerAuthenticator::setObservers(
+        const std::vector<ed25519::pubkey_t> &keys) {
+      std::unordered_set<std::string> names;
+      for (const auto &key : keys) {
+        names.insert(certificateName(key));
+      }
+      std::lock_guard<std::mutex> lock(mutex_);
+      observers_.swap(names);
+    }
+
+    bool PeerAuthenticator::IsBlocking() const {
+      // lookup is short, and is done on the thread of the call
+      return false;
+    }
+
+    grpc::Status PeerAuthenticator::Process(
+        const InputMetadata &auth_metadata,
+        grpc::AuthContext *context,
+        OutputMetadata *consumed_auth_metadata,
+        OutputMetadata *response_metadata) {
+      auto path = auth_metadata.find(":path");
+      auto loader = path != auth_metadata.end()
+          and std::string(path->second.data(), path->second.size())
+                  .compare(0, kLoaderPath.size(), kLoaderPath)
+              == 0;
+      if (not context->IsPeerAuthenticated()
+          or not admitted(*context, loader)) {
+        return grpc::Status(grpc::StatusCode::UNAUTHENTICATED,
+                            "certificate is not issued for ledger peer");
+      }
+      return grpc::Status::OK;
+    }
+
+    bool PeerAuthenticator::admitted(const grpc::AuthContext &context,
+                                     bool loader) const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (auto property :
+           {GRPC_X509_SAN_PROPERTY_NAME, GRPC_X509_CN_PROPERTY_NAME}) {
+        for (const auto &value : context.FindPropertyValues(property)) {
+          auto name = std::string(value.data(), value.size());
+          if (names_.count(name) != 0
+              or (loader and observers_.count(name) != 0)) {
+            return true;
+          }
+        }
+      }
+      return false;
+    }
+  }  // namespace network
+}  // namespace iroha
@@ -0,0 +1,78 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_PEER_AUTHENTICATOR_HPP
+#define IROHA_PEER_AUTHENTICATOR_HPP
+
+#include <grpc++/grpc++.h>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "model/peer.hpp"
+
+namespace iroha {
+  namespace network {
+
+    /**
+     * Admits calls of ledger peers to internal services over TLS.
+     * Certificate of a peer is issued for hex of its public key, as
+     * common name or subject alternative name, so a certificate is bound
+     * to a single peer and stops being accepted once the peer is removed.
+     * Observers, which follow the ledger without being its peers, are
+     * admitted to block loader only
+     */
+    class PeerAuthenticator : public grpc::AuthMetadataProcessor {
+     public:
+      /**
+       * @return name which certificate of peer with given key carries
+       */
+      static std::string certificateName(const ed25519::pubkey_t &key);
+
+      /**
+       * Replace admitted peers with current peer set of the ledger
+       * @param peers - current ledger peers
+       */
+      void update(const std::vector<model::Peer> &peers);
+
+      /**
+       * Replace admitted observers
+       * @param keys - keys of observers following this peer
+       */
+      void setObservers(const std::vector<ed25519::pubkey_t> &keys);
+
+      bool IsBlocking() const override;
+
+      grpc::Status Process(const InputMetadata &auth_metadata,
+                           grpc::AuthContext *context,
+                           OutputMetadata *consumed_auth_metadata,
+                           OutputMetadata *response_metadata) override;
+
+     private:
+      /**
+       * @param loader - call is made to block loader
+       */
+      bool admitted(const grpc::AuthContext &context, bool loader) const;
+
+      mutable std::mutex mutex_;
+      std::unordered_set<std::string> names_;
+      std::unordered_set<std::string> observers_;
+    };
+  }  // namespace network
+}  // namespace iroha
+
+#endif  // IROHA_PEER_AUTHENTICATOR_HPP
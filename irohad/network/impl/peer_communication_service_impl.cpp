@@ -32,7 +32,11 @@ namespace iroha {
       ordering_gate_->propagate_transaction(transaction);
     }
 
-    rxcpp::observable<model::Proposal>
+    bool PeerCommunicationServiceImpl::overloaded() const {
+      return ordering_gate_->overloaded();
+    }
+
+    rxcpp::observable<std::shared_ptr<const model::Proposal>>
     PeerCommunicationServiceImpl::on_proposal() {
       return ordering_gate_->on_proposal();
     }
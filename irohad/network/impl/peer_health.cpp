@@ -0,0 +1,126 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "network/impl/peer_health.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace iroha {
+  namespace network {
+
+    namespace {
+      // gain of smoothed answer time, as srtt of RFC 6298
+      constexpr double kAlpha = 1.0 / 8;
+
+      /**
+       * Stable sort of peers by their keys
+       */
+      template <typename Key>
+      std::vector<model::Peer> sortBy(std::vector<model::Peer> peers,
+                                      const std::vector<Key> &keys) {
+        std::vector<size_t> indices(peers.size());
+        for (size_t i = 0; i < indices.size(); ++i) {
+          indices[i] = i;
+        }
+        std::stable_sort(
+            indices.begin(), indices.end(), [&keys](auto lhs, auto rhs) {
+              return keys[lhs] < keys[rhs];
+            });
+        std::vector<model::Peer> sorted;
+        sorted.reserve(peers.size());
+        for (auto i : indices) {
+          sorted.push_back(std::move(peers[i]));
+        }
+        return sorted;
+      }
+    }  // namespace
+
+    constexpr uint32_t PeerHealth::kMaxMisses;
+
+    PeerHealth::PeerHealth(uint64_t slow_millis, uint32_t max_misses)
+        : slow_millis_(slow_millis),
+          max_misses_(std::max<uint32_t>(max_misses, 1)) {}
+
+    void PeerHealth::onAnswer(const ed25519::pubkey_t &peer,
+                              uint64_t millis) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto &state = peers_[peer.to_string()];
+      auto rtt = static_cast<double>(millis);
+      state.srtt = state.measured ? (1 - kAlpha) * state.srtt + kAlpha * rtt
+                                  : rtt;
+      state.measured = true;
+      state.misses = 0;
+    }
+
+    void PeerHealth::onTimeout(const ed25519::pubkey_t &peer) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto &state = peers_[peer.to_string()];
+      if (state.misses < max_misses_) {
+        ++state.misses;
+      }
+    }
+
+    PeerHealth::Grade PeerHealth::grade(const ed25519::pubkey_t &peer) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = peers_.find(peer.to_string());
+      return it == peers_.end() ? Grade::Healthy : gradeOf(it->second);
+    }
+
+    PeerHealth::Grade PeerHealth::gradeOf(const State &state) const {
+      if (state.misses >= max_misses_) {
+        return Grade::Unresponsive;
+      }
+      if (state.measured and state.srtt > slow_millis_) {
+        return Grade::Slow;
+      }
+      return Grade::Healthy;
+    }
+
+    std::vector<model::Peer> PeerHealth::leaderOrder(
+        std::vector<model::Peer> peers) {
+      std::vector<Grade> grades;
+      for (const auto &peer : peers) {
+        grades.push_back(grade(peer.pubkey));
+      }
+      return sortBy(std::move(peers), grades);
+    }
+
+    std::vector<model::Peer> PeerHealth::syncOrder(
+        std::vector<model::Peer> peers) {
+      // grade and answer time of each peer, read once under the lock
+      std::vector<std::pair<Grade, double>> keys;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto &peer : peers) {
+          auto it = peers_.find(peer.pubkey.to_string());
+          if (it == peers_.end()) {
+            keys.emplace_back(Grade::Healthy,
+                              std::numeric_limits<double>::max());
+            continue;
+          }
+          const auto &state = it->second;
+          keys.emplace_back(gradeOf(state),
+                            state.measured
+                                ? state.srtt
+                                : std::numeric_limits<double>::max());
+        }
+      }
+      return sortBy(std::move(peers), keys);
+    }
+
+  }  // namespace network
+}  // namespace iroha
@@ -0,0 +1,109 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_PEER_HEALTH_HPP
+#define IROHA_PEER_HEALTH_HPP
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "model/peer.hpp"
+
+namespace iroha {
+  namespace network {
+
+    /**
+     * Thread-safe table of peer health, fed by answer times and missed
+     * answers observed by heartbeats and consensus. Peers are identified
+     * by public key, so every source of observations agrees on them.
+     * Health of peer is coarse: peers are graded healthy, slow or
+     * unresponsive, and only the grade changes order of leaders, so peers
+     * with the same view of the network pick the same leaders.
+     */
+    class PeerHealth {
+     public:
+      enum class Grade { Healthy = 0, Slow = 1, Unresponsive = 2 };
+
+      /**
+       * Number of missed answers in a row after which peer is unresponsive
+       */
+      static constexpr uint32_t kMaxMisses = 3;
+
+      /**
+       * @param slow_millis - smoothed answer time above which peer is slow
+       * @param max_misses - missed answers in a row of unresponsive peer
+       */
+      explicit PeerHealth(uint64_t slow_millis,
+                          uint32_t max_misses = kMaxMisses);
+
+      /**
+       * Report that peer has answered
+       * @param millis - time between request and answer
+       */
+      void onAnswer(const ed25519::pubkey_t &peer, uint64_t millis);
+
+      /**
+       * Report that peer has not answered in time
+       */
+      void onTimeout(const ed25519::pubkey_t &peer);
+
+      /**
+       * @return grade of peer, healthy if peer is not observed yet
+       */
+      Grade grade(const ed25519::pubkey_t &peer);
+
+      /**
+       * Order of leaders: healthier grades go first, order within a grade
+       * is kept, so deterministic order given by caller is only changed
+       * by grades
+       * @param peers - peers in deterministic order of round
+       * @return reordered peers
+       */
+      std::vector<model::Peer> leaderOrder(std::vector<model::Peer> peers);
+
+      /**
+       * Order of sources of blocks: healthier grades go first, and peers
+       * of the same grade by answer time. Unobserved peers go last in
+       * their grade, keeping order given by caller.
+       * @param peers - candidate sources
+       * @return reordered peers
+       */
+      std::vector<model::Peer> syncOrder(std::vector<model::Peer> peers);
+
+     private:
+      struct State {
+        double srtt = 0;
+        bool measured = false;
+        uint32_t misses = 0;
+      };
+
+      /**
+       * Grade of observed state, must be called under lock
+       */
+      Grade gradeOf(const State &state) const;
+
+      const uint64_t slow_millis_;
+      const uint32_t max_misses_;
+      std::unordered_map<std::string, State> peers_;
+      std::mutex mutex_;
+    };
+
+  }  // namespace network
+}  // namespace iroha
+
+#endif  // IROHA_PEER_HEALTH_HPP
@@ -41,7 +41,14 @@ namespace iroha {
        * Return observable of all proposals in the consensus
        * @return observable with notifications
        */
-      virtual rxcpp::observable<model::Proposal> on_proposal() = 0;
+      virtual rxcpp::observable<std::shared_ptr<const model::Proposal>>
+      on_proposal() = 0;
+
+      /**
+       * @return true if ordering service refuses new transactions, so they
+       * should be resent later
+       */
+      virtual bool overloaded() const { return false; }
 
       virtual ~OrderingGate() = default;
     };
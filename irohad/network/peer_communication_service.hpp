@@ -25,7 +25,7 @@
 namespace iroha {
   namespace network {
 
-    using Commit = rxcpp::observable<model::Block>;
+    using Commit = rxcpp::observable<std::shared_ptr<const model::Block>>;
 
     /**
      * Public API for notification about domain data
@@ -40,12 +40,19 @@ namespace iroha {
       virtual void propagate_transaction(
           std::shared_ptr<const model::Transaction> transaction) = 0;
 
+      /**
+       * @return true if network does not accept new transactions for now,
+       * so they should be resent later
+       */
+      virtual bool overloaded() const { return false; }
+
       /**
        * Event is triggered when proposal arrives from network.
        * @return observable with Proposals.
        * (List of Proposals)
        */
-      virtual rxcpp::observable<model::Proposal> on_proposal() = 0;
+      virtual rxcpp::observable<std::shared_ptr<const model::Proposal>>
+      on_proposal() = 0;
 
       /**
         * Event is triggered when commit block arrives.
@@ -0,0 +1,128 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ordering/impl/batch_pool.hpp"
+#include <algorithm>
+#include "crypto/hash.hpp"
+#include "ordering/impl/mempool.hpp"
+
+namespace iroha {
+  namespace ordering {
+
+    constexpr size_t BatchPool::kDefaultCapacity;
+    constexpr size_t BatchPool::kResolvedWindow;
+
+    BatchPool::BatchPool(size_t capacity) : capacity_(capacity) {}
+
+    hash256_t BatchPool::digestOf(const proto::TransactionBatch &batch) {
+      Sha3_256 hasher;
+      for (const auto &tx : batch.transactions()) {
+        auto hash = Mempool::hashOf(tx);
+        hasher.update(hash.data(), hash.size());
+      }
+      return hasher.final();
+    }
+
+    nonstd::optional<hash256_t> BatchPool::add(
+        proto::TransactionBatch batch) {
+      if (batch.transactions_size() == 0) {
+        return nonstd::nullopt;
+      }
+      auto digest = digestOf(batch);
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (batches_.size() >= capacity_ or batches_.count(digest) != 0
+          or resolved_.count(digest) != 0) {
+        return nonstd::nullopt;
+      }
+      batches_.emplace(digest, std::move(batch));
+      order_.push_back(digest);
+      return digest;
+    }
+
+    std::vector<hash256_t> BatchPool::pending(
+        size_t max_transactions) const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      std::vector<hash256_t> result;
+      size_t transactions = 0;
+      for (const auto &digest : order_) {
+        auto batch = batches_.find(digest);
+        if (batch == batches_.end()) {
+          continue;
+        }
+        auto size = static_cast<size_t>(batch->second.transactions_size());
+        if (not result.empty() and transactions + size > max_transactions) {
+          break;
+        }
+        result.push_back(digest);
+        transactions += size;
+      }
+      return result;
+    }
+
+    bool BatchPool::resolve(proto::Proposal &proposal) {
+      std::vector<hash256_t> digests;
+      for (const auto &bytes : proposal.batch_digests()) {
+        if (bytes.size() != hash256_t::size()) {
+          return false;
+        }
+        hash256_t digest;
+        std::copy(bytes.begin(), bytes.end(), digest.begin());
+        digests.push_back(digest);
+      }
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (const auto &digest : digests) {
+        if (batches_.count(digest) == 0) {
+          return false;
+        }
+      }
+      for (const auto &digest : digests) {
+        auto batch = batches_.find(digest);
+        for (auto &tx : *batch->second.mutable_transactions()) {
+          proposal.add_transactions()->Swap(&tx);
+        }
+        batches_.erase(batch);
+
+        resolved_.insert(digest);
+        resolved_order_.push_back(digest);
+        if (resolved_order_.size() > kResolvedWindow) {
+          resolved_.erase(resolved_order_.front());
+          resolved_order_.pop_front();
+        }
+      }
+      // digests of resolved batches are dropped from the head of arrival
+      // order, the rest are skipped by pending
+      while (not order_.empty() and batches_.count(order_.front()) == 0) {
+        order_.pop_front();
+      }
+      if (order_.size() > 2 * batches_.size()) {
+        order_.erase(std::remove_if(order_.begin(),
+                                    order_.end(),
+                                    [this](const auto &digest) {
+                                      return batches_.count(digest) == 0;
+                                    }),
+                     order_.end());
+      }
+      return true;
+    }
+
+    size_t BatchPool::size() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return batches_.size();
+    }
+  }  // namespace ordering
+}  // namespace iroha
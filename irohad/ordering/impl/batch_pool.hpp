@@ -0,0 +1,93 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_BATCH_POOL_HPP
+#define IROHA_BATCH_POOL_HPP
+
+#include <deque>
+#include <mutex>
+#include <nonstd/optional.hpp>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "common/types.hpp"
+#include "ordering.pb.h"
+
+namespace iroha {
+  namespace ordering {
+
+    /**
+     * Batches of transactions disseminated by peers in multi-ingest
+     * ordering, kept until a proposal refers to them by digest.
+     * Digest is computed from batch content on arrival, so peers can not
+     * forge it. Digests of resolved batches are remembered, so a late copy
+     * of a batch is not proposed twice.
+     * Thread safe.
+     */
+    class BatchPool {
+     public:
+      static constexpr size_t kDefaultCapacity = 10000;
+      static constexpr size_t kResolvedWindow = 10000;
+
+      explicit BatchPool(size_t capacity = kDefaultCapacity);
+
+      /**
+       * @return digest of batch, which covers hashes of its transactions
+       */
+      static hash256_t digestOf(const proto::TransactionBatch &batch);
+
+      /**
+       * Store batch
+       * @param batch - batch to store
+       * @return digest of batch if it is stored, nullopt if it is known,
+       * already resolved, empty or pool is full
+       */
+      nonstd::optional<hash256_t> add(proto::TransactionBatch batch);
+
+      /**
+       * Digests of unresolved batches in order of arrival
+       * @param max_transactions - limit of total number of transactions in
+       * selected batches, at least one batch is selected
+       */
+      std::vector<hash256_t> pending(size_t max_transactions) const;
+
+      /**
+       * Move transactions of batches to proposal and forget the batches
+       * @param proposal - proposal referring to batches by digests
+       * @return false if some batch has not arrived yet, then proposal is
+       * not changed
+       */
+      bool resolve(proto::Proposal &proposal);
+
+      /**
+       * @return number of stored batches
+       */
+      size_t size() const;
+
+     private:
+      const size_t capacity_;
+      std::unordered_map<hash256_t, proto::TransactionBatch> batches_;
+      // digests of stored batches in order of arrival
+      std::deque<hash256_t> order_;
+      std::unordered_set<hash256_t> resolved_;
+      std::deque<hash256_t> resolved_order_;
+      mutable std::mutex mutex_;
+    };
+  }  // namespace ordering
+}  // namespace iroha
+
+#endif  // IROHA_BATCH_POOL_HPP
@@ -0,0 +1,120 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ordering/impl/batching_controller.hpp"
+#include <algorithm>
+#include <limits>
+#include <sstream>
+
+namespace iroha {
+  namespace ordering {
+
+    constexpr double BatchingController::kSmoothing;
+
+    BatchingController::Bounds BatchingController::Bounds::fixed(
+        size_t size, std::chrono::milliseconds delay) {
+      return Bounds{size, size, delay, delay};
+    }
+
+    BatchingController::BatchingController(Bounds bounds,
+                                           Clock::time_point now)
+        : bounds_(bounds),
+          size_(bounds.min_size),
+          delay_ms_(bounds.max_delay.count()),
+          last_update_(now) {}
+
+    void BatchingController::transactionsArrived(size_t count) {
+      arrivals_ += count;
+    }
+
+    void BatchingController::roundCompleted(
+        std::chrono::milliseconds round_time) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto ms = static_cast<double>(std::max<int64_t>(round_time.count(), 0));
+      round_ms_ = round_ms_ == 0
+          ? ms
+          : kSmoothing * ms + (1 - kSmoothing) * round_ms_;
+    }
+
+    void BatchingController::update(size_t queue_depth,
+                                    Clock::time_point now) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto elapsed =
+          std::chrono::duration<double>(now - last_update_).count();
+      if (elapsed > 0) {
+        auto rate = arrivals_.exchange(0) / elapsed;
+        rate_ = kSmoothing * rate + (1 - kSmoothing) * rate_;
+        last_update_ = now;
+      }
+
+      // round time is unknown before the first commit
+      auto round_ms = round_ms_ == 0 ? bounds_.max_delay.count() : round_ms_;
+      auto expected = static_cast<size_t>(rate_ * round_ms / 1000);
+      auto size = std::min(std::max({expected, queue_depth, bounds_.min_size}),
+                           bounds_.max_size);
+
+      auto fill_ms = rate_ > 0 ? size * 1000 / rate_
+                               : std::numeric_limits<double>::infinity();
+      auto delay_ms = queue_depth >= size
+          ? static_cast<double>(bounds_.min_delay.count())
+          : std::min(fill_ms, round_ms);
+      delay_ms = std::min(
+          std::max(delay_ms, static_cast<double>(bounds_.min_delay.count())),
+          static_cast<double>(bounds_.max_delay.count()));
+
+      size_ = size;
+      delay_ms_ = static_cast<int64_t>(delay_ms);
+    }
+
+    size_t BatchingController::proposalSize() const { return size_; }
+
+    std::chrono::milliseconds BatchingController::delay() const {
+      return std::chrono::milliseconds(delay_ms_);
+    }
+
+    BatchingController::Bounds BatchingController::bounds() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return bounds_;
+    }
+
+    void BatchingController::setBounds(Bounds bounds) {
+      bounds.max_size = std::max(bounds.max_size, bounds.min_size);
+      bounds.max_delay = std::max(bounds.max_delay, bounds.min_delay);
+      std::lock_guard<std::mutex> lock(mutex_);
+      bounds_ = bounds;
+      size_ = std::min(std::max(size_.load(), bounds_.min_size),
+                       bounds_.max_size);
+      delay_ms_ = std::min(std::max<int64_t>(delay_ms_.load(),
+                                             bounds_.min_delay.count()),
+                           static_cast<int64_t>(bounds_.max_delay.count()));
+    }
+
+    std::string BatchingController::report() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      std::ostringstream out;
+      out << "# TYPE iroha_ordering_proposal_size gauge\n"
+          << "iroha_ordering_proposal_size " << size_ << "\n"
+          << "# TYPE iroha_ordering_proposal_delay_ms gauge\n"
+          << "iroha_ordering_proposal_delay_ms " << delay_ms_ << "\n"
+          << "# TYPE iroha_ordering_arrival_rate gauge\n"
+          << "iroha_ordering_arrival_rate " << rate_ << "\n"
+          << "# TYPE iroha_ordering_round_ms gauge\n"
+          << "iroha_ordering_round_ms " << round_ms_ << "\n";
+      return out.str();
+    }
+  }  // namespace ordering
+}  // namespace iroha
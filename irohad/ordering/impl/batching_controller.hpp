@@ -0,0 +1,127 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_BATCHING_CONTROLLER_HPP
+#define IROHA_BATCHING_CONTROLLER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+
+namespace iroha {
+  namespace ordering {
+
+    /**
+     * Chooses proposal size and delay of ordering service from load.
+     * Proposal is sized to hold transactions arriving during one consensus
+     * round, or the whole backlog if it is larger. Delay is the time needed
+     * to fill such proposal, but not longer than one round, so light load
+     * does not wait for the full timer. Arrival rate and round time are
+     * smoothed by exponential moving average.
+     * Thread safe.
+     */
+    class BatchingController {
+     public:
+      using Clock = std::chrono::steady_clock;
+
+      /**
+       * Limits of proposal size and delay
+       */
+      struct Bounds {
+        size_t min_size;
+        size_t max_size;
+        std::chrono::milliseconds min_delay;
+        std::chrono::milliseconds max_delay;
+
+        /**
+         * Bounds which disable adaptation
+         */
+        static Bounds fixed(size_t size, std::chrono::milliseconds delay);
+      };
+
+      /**
+       * Weight of the newest observation in moving averages
+       */
+      static constexpr double kSmoothing = 0.2;
+
+      explicit BatchingController(Bounds bounds, Clock::time_point now =
+                                                     Clock::now());
+
+      /**
+       * Account transactions accepted by ordering service
+       */
+      void transactionsArrived(size_t count = 1);
+
+      /**
+       * Account duration of consensus round, from receiving proposal to
+       * commit
+       */
+      void roundCompleted(std::chrono::milliseconds round_time);
+
+      /**
+       * Recompute proposal size and delay
+       * @param queue_depth - number of transactions waiting for proposal
+       * @param now - current time
+       */
+      void update(size_t queue_depth, Clock::time_point now = Clock::now());
+
+      /**
+       * @return max number of transactions in next proposal
+       */
+      size_t proposalSize() const;
+
+      /**
+       * @return delay before next proposal
+       */
+      std::chrono::milliseconds delay() const;
+
+      /**
+       * @return limits of proposal size and delay
+       */
+      Bounds bounds() const;
+
+      /**
+       * Change limits while the service runs, lower limit wins if they
+       * cross. Size and delay are clamped to them until the next update
+       */
+      void setBounds(Bounds bounds);
+
+      /**
+       * @return current parameters in Prometheus text format
+       */
+      std::string report() const;
+
+     private:
+      // guarded by mutex
+      Bounds bounds_;
+
+      std::atomic<size_t> arrivals_{0};
+      std::atomic<size_t> size_;
+      std::atomic<int64_t> delay_ms_;
+
+      mutable std::mutex mutex_;
+      Clock::time_point last_update_;
+      // transactions per second
+      double rate_ = 0;
+      // milliseconds, zero until the first round is observed
+      double round_ms_ = 0;
+    };
+  }  // namespace ordering
+}  // namespace iroha
+
+#endif  // IROHA_BATCHING_CONTROLLER_HPP
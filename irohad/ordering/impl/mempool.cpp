@@ -0,0 +1,309 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ordering/impl/mempool.hpp"
+#include <algorithm>
+#include <sstream>
+#include "crypto/hash.hpp"
+
+namespace iroha {
+  namespace ordering {
+
+    constexpr size_t Mempool::kDefaultCapacity;
+    constexpr size_t Mempool::kDefaultAccountCapacity;
+    constexpr size_t Mempool::kDefaultReplayWindow;
+    constexpr uint64_t Mempool::kDefaultMaxAge;
+    constexpr size_t Mempool::kWheelSlots;
+
+    namespace {
+      uint64_t secondsOf(std::chrono::system_clock::time_point time) {
+        return std::chrono::duration_cast<std::chrono::seconds>(
+                   time.time_since_epoch())
+            .count();
+      }
+    }  // namespace
+
+    Mempool::Mempool(size_t capacity,
+                     size_t account_capacity,
+                     size_t replay_window,
+                     std::shared_ptr<const OrderingPolicy> policy,
+                     uint64_t max_age)
+        : capacity_(capacity),
+          account_capacity_(account_capacity),
+          replay_window_(replay_window),
+          policy_(policy ? std::move(policy)
+                         : std::make_shared<const FifoPolicy>()),
+          max_age_(max_age),
+          lanes_(std::max<size_t>(policy_->classes(), 1)),
+          wheel_(kWheelSlots) {}
+
+    hash256_t Mempool::hashOf(const protocol::Transaction &transaction) {
+      // fixed size suffix, so it cannot be confused with body bytes
+      auto created = transaction.header().created_time();
+      uint8_t time[sizeof(created)];
+      for (size_t i = 0; i < sizeof(created); ++i) {
+        time[i] = static_cast<uint8_t>(created >> (8 * i));
+      }
+      Sha3_256 hasher;
+      return hasher.update(transaction.meta().SerializeAsString())
+          .update(transaction.body().SerializeAsString())
+          .update(time, sizeof(time))
+          .final();
+    }
+
+    hash256_t Mempool::fullHashOf(const protocol::Transaction &transaction) {
+      Sha3_256 hasher;
+      return hasher.update(transaction.SerializeAsString()).final();
+    }
+
+    Mempool::Admission Mempool::push(
+        protocol::Transaction &transaction,
+        Clock::time_point now,
+        std::chrono::system_clock::time_point wall_now) {
+      const auto &account = transaction.meta().creator_account_id();
+      auto hash = hashOf(transaction);
+      auto bytes = sizeof(Entry) + transaction.ByteSizeLong();
+      auto priority = std::min(policy_->classify(transaction),
+                               lanes_.size() - 1);
+      // transactions without creation time do not pass stateless
+      // validation, they are not expired here
+      auto created = transaction.header().created_time();
+      auto expiry_tick = created == 0 ? 0 : (created + max_age_) / 1000;
+      auto now_tick = secondsOf(wall_now);
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (expiry_tick != 0 and expiry_tick <= now_tick) {
+        ++expired_;
+        return Admission::Expired;
+      }
+      if (pending_.count(hash) != 0 or recent_.count(hash) != 0) {
+        ++duplicates_;
+        return Admission::Duplicate;
+      }
+      auto it = accounts_.find(account);
+      if (size_ >= capacity_
+          or (it != accounts_.end() and it->second >= account_capacity_)) {
+        ++rejected_;
+        return Admission::Full;
+      }
+      if (it == accounts_.end()) {
+        it = accounts_.emplace(account, 0).first;
+      }
+      ++it->second;
+      pending_.insert(hash);
+
+      auto &lane = lanes_[priority];
+      auto &queue = lane.accounts[account];
+      if (queue.empty()) {
+        lane.turns.push_back(account);
+      }
+      auto sequence = next_sequence_++;
+      queue.push_back(Entry{{}, hash, sequence, bytes});
+      queue.back().transaction.Swap(&transaction);
+      arrivals_.emplace(sequence, now);
+      if (expiry_tick != 0) {
+        if (wheel_tick_ == 0) {
+          wheel_tick_ = now_tick;
+        }
+        // references to deque elements survive pushes and pops of others
+        wheel_[expiry_tick % kWheelSlots].push_back(
+            Timer{expiry_tick, sequence, priority, &queue.back()});
+        ++timers_;
+      }
+      ++lane.size;
+      ++size_;
+      bytes_ += bytes;
+      return Admission::Accepted;
+    }
+
+    size_t Mempool::expire(std::chrono::system_clock::time_point now) {
+      auto now_tick = secondsOf(now);
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (wheel_tick_ == 0) {
+        wheel_tick_ = now_tick;
+        return 0;
+      }
+      auto before = expired_;
+      // one turn of the wheel visits every slot, later turns add nothing
+      auto from = std::max(wheel_tick_ + 1,
+                           now_tick >= kWheelSlots
+                               ? now_tick - kWheelSlots + 1
+                               : uint64_t(0));
+      for (auto tick = from; tick <= now_tick; ++tick) {
+        auto &slot = wheel_[tick % kWheelSlots];
+        // timers of later turns stay in the slot
+        auto due = std::partition(
+            slot.begin(), slot.end(), [now_tick](const Timer &timer) {
+              return timer.tick > now_tick;
+            });
+        std::for_each(due, slot.end(), [this](const Timer &timer) {
+          this->expireEntry(timer);
+        });
+        timers_ -= slot.end() - due;
+        slot.erase(due, slot.end());
+      }
+      wheel_tick_ = std::max(wheel_tick_, now_tick);
+      // timers of popped entries wait for their tick, they are swept once
+      // they outnumber queued entries
+      if (timers_ > 2 * size_ + kWheelSlots) {
+        for (auto &slot : wheel_) {
+          slot.erase(std::remove_if(slot.begin(),
+                                    slot.end(),
+                                    [this](const Timer &timer) {
+                                      return arrivals_.count(timer.sequence)
+                                          == 0;
+                                    }),
+                     slot.end());
+        }
+        timers_ = size_;
+      }
+      return expired_ - before;
+    }
+
+    void Mempool::expireEntry(const Timer &timer) {
+      // popped entries are gone, their timers are ignored
+      if (arrivals_.erase(timer.sequence) == 0) {
+        return;
+      }
+      auto &entry = *timer.entry;
+      entry.expired = true;
+      auto counter =
+          accounts_.find(entry.transaction.meta().creator_account_id());
+      if (--counter->second == 0) {
+        accounts_.erase(counter);
+      }
+      pending_.erase(entry.hash);
+      bytes_ -= entry.bytes;
+      --size_;
+      ++expired_;
+      auto &lane = lanes_[timer.lane];
+      // entries of lane left are all expired, they are dropped at once
+      if (--lane.size == 0) {
+        lane.accounts.clear();
+        lane.turns.clear();
+      }
+    }
+
+    bool Mempool::pop(protocol::Transaction &transaction) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto lane = std::find_if(lanes_.begin(), lanes_.end(), [](auto &lane) {
+        return lane.size != 0;
+      });
+      if (lane == lanes_.end()) {
+        return false;
+      }
+      // account at the front of turns takes its oldest transaction, and
+      // moves to the back if it has more; expired entries are dropped on
+      // the way, lane has at least one queued entry
+      auto account = std::move(lane->turns.front());
+      lane->turns.pop_front();
+      auto queue = lane->accounts.find(account);
+      while (queue->second.front().expired) {
+        queue->second.pop_front();
+        if (queue->second.empty()) {
+          lane->accounts.erase(queue);
+          account = std::move(lane->turns.front());
+          lane->turns.pop_front();
+          queue = lane->accounts.find(account);
+        }
+      }
+      auto &entry = queue->second.front();
+
+      auto counter = accounts_.find(account);
+      if (--counter->second == 0) {
+        accounts_.erase(counter);
+      }
+      pending_.erase(entry.hash);
+      remember(entry.hash);
+      arrivals_.erase(entry.sequence);
+      bytes_ -= entry.bytes;
+      transaction.Swap(&entry.transaction);
+      queue->second.pop_front();
+      // the account keeps its turn only for queued entries
+      while (not queue->second.empty() and queue->second.front().expired) {
+        queue->second.pop_front();
+      }
+      if (queue->second.empty()) {
+        lane->accounts.erase(queue);
+      } else {
+        lane->turns.push_back(std::move(account));
+      }
+      --lane->size;
+      --size_;
+      return true;
+    }
+
+    void Mempool::remember(const hash256_t &hash) {
+      if (replay_window_ == 0) {
+        return;
+      }
+      if (recent_order_.size() >= replay_window_) {
+        recent_.erase(recent_order_.front());
+        recent_order_.pop_front();
+      }
+      recent_.insert(hash);
+      recent_order_.push_back(hash);
+    }
+
+    bool Mempool::contains(const hash256_t &hash) const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return pending_.count(hash) != 0;
+    }
+
+    size_t Mempool::size() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return size_;
+    }
+
+    size_t Mempool::bytes() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return bytes_;
+    }
+
+    Mempool::Clock::duration Mempool::oldestAge(Clock::time_point now) const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (arrivals_.empty() or now < arrivals_.begin()->second) {
+        return Clock::duration::zero();
+      }
+      return now - arrivals_.begin()->second;
+    }
+
+    std::string Mempool::report(Clock::time_point now) const {
+      auto age = std::chrono::duration_cast<std::chrono::milliseconds>(
+          oldestAge(now));
+      std::lock_guard<std::mutex> lock(mutex_);
+      std::ostringstream out;
+      out << "# TYPE iroha_mempool_depth gauge\n"
+          << "iroha_mempool_depth " << size_ << "\n"
+          << "# TYPE iroha_mempool_class_depth gauge\n";
+      for (size_t i = 0; i < lanes_.size(); ++i) {
+        out << "iroha_mempool_class_depth{class=\"" << i << "\"} "
+            << lanes_[i].size << "\n";
+      }
+      out << "# TYPE iroha_mempool_accounts gauge\n"
+          << "iroha_mempool_accounts " << accounts_.size() << "\n"
+          << "# TYPE iroha_mempool_oldest_age_ms gauge\n"
+          << "iroha_mempool_oldest_age_ms " << age.count() << "\n"
+          << "# TYPE iroha_mempool_rejected_total counter\n"
+          << "iroha_mempool_rejected_total " << rejected_ << "\n"
+          << "# TYPE iroha_mempool_duplicates_total counter\n"
+          << "iroha_mempool_duplicates_total " << duplicates_ << "\n"
+          << "# TYPE iroha_mempool_expired_total counter\n"
+          << "iroha_mempool_expired_total " << expired_ << "\n";
+      return out.str();
+    }
+  }  // namespace ordering
+}  // namespace iroha
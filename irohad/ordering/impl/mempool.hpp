@@ -0,0 +1,250 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_MEMPOOL_HPP
+#define IROHA_MEMPOOL_HPP
+
+#include <chrono>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "block.pb.h"
+#include "common/types.hpp"
+#include "ordering/impl/ordering_policy.hpp"
+
+namespace iroha {
+  namespace ordering {
+
+    /**
+     * Bounded queue of transactions awaiting a proposal.
+     * Number of transactions is limited both globally and per creator
+     * account, so one account can not occupy the whole queue.
+     * Transactions over the limits are rejected, and the sender is
+     * expected to retry later.
+     * Transactions are indexed by hash of their payload and creation time,
+     * so copies of a queued transaction are dropped, as well as replays of
+     * transactions which have recently left the queue.
+     * Order of popping is defined by ordering policy: transactions of
+     * higher priority class go first, and accounts of one class take turns.
+     * Transactions older than max age by their creation time are expired
+     * by a hashed timing wheel of one second ticks: expire() visits only
+     * slots of elapsed ticks, and expired transactions stop counting
+     * against the limits at once, while their entries are dropped when
+     * their account takes its turn.
+     */
+    class Mempool {
+     public:
+      using Clock = std::chrono::steady_clock;
+
+      static constexpr size_t kDefaultCapacity = 100000;
+      static constexpr size_t kDefaultAccountCapacity = 1000;
+      static constexpr size_t kDefaultReplayWindow = 100000;
+
+      /**
+       * Max age of transaction in milliseconds, as accepted by stateless
+       * validation
+       */
+      static constexpr uint64_t kDefaultMaxAge = 1000 * 3600 * 24;
+
+      /**
+       * Number of slots of timing wheel, each covering one second
+       */
+      static constexpr size_t kWheelSlots = 4096;
+
+      /**
+       * Result of transaction admission
+       */
+      enum class Admission {
+        Accepted,
+        // the same transaction is queued or has recently left the queue
+        Duplicate,
+        // global or account limit is reached
+        Full,
+        // transaction is older than max age
+        Expired
+      };
+
+      /**
+       * @param capacity - max number of queued transactions
+       * @param account_capacity - max number of queued transactions of one
+       * creator account
+       * @param replay_window - number of popped transactions whose hashes
+       * are remembered to reject replays
+       * @param policy - priority classes of transactions, FIFO if null
+       * @param max_age - milliseconds after creation time of transaction
+       * when it expires
+       */
+      explicit Mempool(size_t capacity = kDefaultCapacity,
+                       size_t account_capacity = kDefaultAccountCapacity,
+                       size_t replay_window = kDefaultReplayWindow,
+                       std::shared_ptr<const OrderingPolicy> policy = nullptr,
+                       uint64_t max_age = kDefaultMaxAge);
+
+      /**
+       * Hash identifying transaction in mempool, it covers creation time,
+       * so the same transfer created again is a new transaction. Signatures
+       * are not covered, so the same transaction signed differently is a
+       * duplicate
+       */
+      static hash256_t hashOf(const protocol::Transaction &transaction);
+
+      /**
+       * Hash of the whole transaction, header and signatures included, so
+       * it identifies the exact copy of transaction
+       */
+      static hash256_t fullHashOf(const protocol::Transaction &transaction);
+
+      /**
+       * Enqueue transaction if there is room for it and it is not a duplicate
+       * @param transaction - transaction to enqueue, moved from on success
+       * @param now - time of arrival
+       * @param wall_now - time compared with creation time of transaction
+       * @return admission result
+       */
+      Admission push(
+          protocol::Transaction &transaction,
+          Clock::time_point now = Clock::now(),
+          std::chrono::system_clock::time_point wall_now =
+              std::chrono::system_clock::now());
+
+      /**
+       * Expire transactions which have reached max age, so they are not
+       * proposed
+       * @param now - current time
+       * @return number of expired transactions
+       */
+      size_t expire(std::chrono::system_clock::time_point now =
+                        std::chrono::system_clock::now());
+
+      /**
+       * Dequeue next transaction of the highest priority class
+       * @param transaction - receives dequeued transaction
+       * @return false if queue is empty
+       */
+      bool pop(protocol::Transaction &transaction);
+
+      /**
+       * @param hash - hash of transaction, see hashOf
+       * @return true if transaction is queued
+       */
+      bool contains(const hash256_t &hash) const;
+
+      /**
+       * @return number of queued transactions
+       */
+      size_t size() const;
+
+      /**
+       * @return approximate memory of queued transactions
+       */
+      size_t bytes() const;
+
+      /**
+       * @return time spent in queue by the oldest transaction, zero if queue
+       * is empty
+       */
+      Clock::duration oldestAge(Clock::time_point now = Clock::now()) const;
+
+      /**
+       * @return queue metrics in Prometheus text format
+       */
+      std::string report(Clock::time_point now = Clock::now()) const;
+
+     private:
+      struct Entry {
+        protocol::Transaction transaction;
+        hash256_t hash;
+        uint64_t sequence;
+        // accounted memory of entry
+        size_t bytes;
+        // set by expiry, entry no longer counts as queued
+        bool expired = false;
+      };
+
+      /**
+       * Expiry of entry in slot of timing wheel
+       */
+      struct Timer {
+        // second when entry expires
+        uint64_t tick;
+        uint64_t sequence;
+        size_t lane;
+        Entry *entry;
+      };
+
+      /**
+       * Transactions of one priority class, queued per account
+       */
+      struct Lane {
+        std::unordered_map<std::string, std::deque<Entry>> accounts;
+        // accounts with queued transactions in order of their turns
+        std::deque<std::string> turns;
+        size_t size = 0;
+      };
+
+      /**
+       * Remember hash of popped transaction, forgetting the oldest one when
+       * window is full
+       */
+      void remember(const hash256_t &hash);
+
+      /**
+       * Expire entry of timer if it is still queued, must be called under
+       * lock
+       */
+      void expireEntry(const Timer &timer);
+
+      const size_t capacity_;
+      const size_t account_capacity_;
+      const size_t replay_window_;
+      const std::shared_ptr<const OrderingPolicy> policy_;
+      const uint64_t max_age_;
+
+      std::vector<Lane> lanes_;
+      size_t size_ = 0;
+      size_t bytes_ = 0;
+      // arrival times of queued transactions by their sequence numbers
+      std::map<uint64_t, Clock::time_point> arrivals_;
+      uint64_t next_sequence_ = 0;
+      // number of queued transactions per account, over all classes
+      std::unordered_map<std::string, size_t> accounts_;
+      // hashes of queued transactions
+      std::unordered_set<hash256_t> pending_;
+      // hashes of recently popped transactions, in order of popping
+      std::unordered_set<hash256_t> recent_;
+      std::deque<hash256_t> recent_order_;
+      // slots by tick modulo number of slots, entries stay referenced by
+      // timers until their sequence leaves arrivals
+      std::vector<std::vector<Timer>> wheel_;
+      // the last visited tick, 0 until the first push or expiry
+      uint64_t wheel_tick_ = 0;
+      // timers in slots, including those of popped entries
+      size_t timers_ = 0;
+      uint64_t rejected_ = 0;
+      uint64_t duplicates_ = 0;
+      uint64_t expired_ = 0;
+      mutable std::mutex mutex_;
+    };
+  }  // namespace ordering
+}  // namespace iroha
+
+#endif  // IROHA_MEMPOOL_HPP
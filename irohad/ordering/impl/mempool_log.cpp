@@ -0,0 +1,187 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ordering/impl/mempool_log.hpp"
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
+#include "crypto/crc32c.hpp"
+#include "ordering/impl/mempool.hpp"
+
+namespace iroha {
+  namespace ordering {
+
+    namespace {
+      const std::string kLogName = "/mempool.wal";
+
+      /**
+       * Header of record preceding logging time and transaction
+       */
+      struct RecordHeader {
+        uint32_t size;
+        uint32_t crc;
+      };
+
+      int openForAppend(const std::string &name) {
+        return open(name.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0644);
+      }
+
+      bool writeAll(int fd, const std::vector<uint8_t> &bytes) {
+        size_t written = 0;
+        while (written < bytes.size()) {
+          auto result =
+              write(fd, bytes.data() + written, bytes.size() - written);
+          if (result <= 0) {
+            return false;
+          }
+          written += result;
+        }
+        return true;
+      }
+    }  // namespace
+
+    constexpr uint64_t MempoolLog::kCompactionBlocks;
+    constexpr int64_t MempoolLog::kInFlightSeconds;
+
+    std::unique_ptr<MempoolLog> MempoolLog::create(const std::string &path) {
+      auto fd = openForAppend(path + kLogName);
+      if (fd < 0) {
+        return nullptr;
+      }
+      auto log = std::unique_ptr<MempoolLog>(new MempoolLog(path, fd));
+      log->size_ = log->read().size();
+      return log;
+    }
+
+    MempoolLog::MempoolLog(std::string path, int fd)
+        : path_(std::move(path)), fd_(fd) {
+      log_ = logger::log("MempoolLog");
+    }
+
+    MempoolLog::~MempoolLog() {
+      close(fd_);
+    }
+
+    std::vector<uint8_t> MempoolLog::encode(
+        const protocol::Transaction &transaction, Clock::time_point now) {
+      uint64_t millis = std::chrono::duration_cast<std::chrono::milliseconds>(
+                            now.time_since_epoch())
+                            .count();
+      RecordHeader header;
+      header.size = transaction.ByteSizeLong();
+      std::vector<uint8_t> bytes(sizeof(header) + sizeof(millis)
+                                 + header.size);
+      auto body = bytes.data() + sizeof(header);
+      std::memcpy(body, &millis, sizeof(millis));
+      transaction.SerializeWithCachedSizesToArray(body + sizeof(millis));
+      header.crc = crc32c(body, sizeof(millis) + header.size);
+      std::memcpy(bytes.data(), &header, sizeof(header));
+      return bytes;
+    }
+
+    bool MempoolLog::append(const std::vector<uint8_t> &record) {
+      // appends are serialized, so records of concurrent calls do not mix
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (not writeAll(fd_, record)) {
+        return false;
+      }
+      ++size_;
+      return true;
+    }
+
+    std::vector<MempoolLog::Entry> MempoolLog::read() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return readLocked();
+    }
+
+    std::vector<MempoolLog::Entry> MempoolLog::readLocked() const {
+      std::vector<Entry> entries;
+      FILE *pfile = fopen((path_ + kLogName).c_str(), "rb");
+      if (not pfile) {
+        return entries;
+      }
+      RecordHeader header;
+      std::vector<uint8_t> body;
+      uint64_t millis;
+      // the first damaged record ends the log, later ones may be torn too
+      while (fread(&header, sizeof(header), 1, pfile) == 1) {
+        body.resize(sizeof(millis) + header.size);
+        if (fread(body.data(), 1, body.size(), pfile) != body.size()
+            or crc32c(body.data(), body.size()) != header.crc) {
+          log_->warn("Log is torn after {} records", entries.size());
+          break;
+        }
+        Entry entry;
+        if (not entry.transaction.ParseFromArray(body.data() + sizeof(millis),
+                                                 header.size)) {
+          continue;
+        }
+        std::memcpy(&millis, body.data(), sizeof(millis));
+        entry.hash = Mempool::hashOf(entry.transaction);
+        entry.logged = Clock::time_point(std::chrono::milliseconds(millis));
+        entries.push_back(std::move(entry));
+      }
+      fclose(pfile);
+      return entries;
+    }
+
+    nonstd::optional<std::vector<MempoolLog::Entry>> MempoolLog::compact(
+        const std::function<bool(const Entry &)> &keep) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      std::vector<Entry> kept;
+      std::vector<uint8_t> bytes;
+      for (auto &entry : readLocked()) {
+        if (keep(entry)) {
+          auto entry_bytes = encode(entry.transaction, entry.logged);
+          bytes.insert(bytes.end(), entry_bytes.begin(), entry_bytes.end());
+          kept.push_back(std::move(entry));
+        }
+      }
+
+      // rename is atomic, so log is either old or new one
+      auto name = path_ + kLogName;
+      auto tmp_name = name + ".tmp";
+      auto tmp_fd = open(tmp_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+      if (tmp_fd < 0) {
+        return nonstd::nullopt;
+      }
+      auto written = writeAll(tmp_fd, bytes) and fdatasync(tmp_fd) == 0;
+      written = close(tmp_fd) == 0 and written;
+      if (not written or std::rename(tmp_name.c_str(), name.c_str()) != 0) {
+        log_->error("Cannot rewrite {}", name);
+        std::remove(tmp_name.c_str());
+        return nonstd::nullopt;
+      }
+      auto fd = openForAppend(name);
+      if (fd < 0) {
+        log_->error("Cannot open {}, transactions are not logged", name);
+        return nonstd::nullopt;
+      }
+      close(fd_);
+      fd_ = fd;
+      size_ = kept.size();
+      return kept;
+    }
+
+    size_t MempoolLog::size() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return size_;
+    }
+
+  }  // namespace ordering
+}  // namespace iroha
@@ -0,0 +1,128 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_MEMPOOL_LOG_HPP
+#define IROHA_MEMPOOL_LOG_HPP
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <nonstd/optional.hpp>
+#include <string>
+#include <vector>
+#include "block.pb.h"
+#include "common/types.hpp"
+#include "logger/logger.hpp"
+
+namespace iroha {
+  namespace ordering {
+
+    /**
+     * Write-ahead log of transactions accepted by mempool, so the ordering
+     * service restores its queue after restart instead of waiting for
+     * clients to resubmit. Log is file mempool.wal of records
+     * [uint32 size][uint32 crc32c][uint64 logged ms][transaction bytes],
+     * checksum covers time and transaction. Records are appended without
+     * flushing, so they survive a crash of the process but not of the
+     * system. Records torn by a crash are dropped on compaction, which
+     * rewrites the log with records still needed.
+     */
+    class MempoolLog {
+     public:
+      using Clock = std::chrono::system_clock;
+
+      /**
+       * Log is compacted after every that many committed blocks
+       */
+      static constexpr uint64_t kCompactionBlocks = 64;
+
+      /**
+       * Seconds during which popped transaction is kept by compaction, so
+       * transactions of proposals in flight are restored after restart
+       */
+      static constexpr int64_t kInFlightSeconds = 60;
+
+      /**
+       * Entry of log with time it was appended
+       */
+      struct Entry {
+        protocol::Transaction transaction;
+        hash256_t hash;
+        Clock::time_point logged;
+      };
+
+      /**
+       * Open or create log in given directory
+       * @param path - existing directory
+       * @return log, nullptr if it can not be written
+       */
+      static std::unique_ptr<MempoolLog> create(const std::string &path);
+
+      ~MempoolLog();
+
+      /**
+       * Encode record of transaction, before it is moved into mempool
+       */
+      static std::vector<uint8_t> encode(
+          const protocol::Transaction &transaction,
+          Clock::time_point now = Clock::now());
+
+      /**
+       * Append record of transaction accepted by mempool
+       * @return false if it is not written
+       */
+      bool append(const std::vector<uint8_t> &record);
+
+      /**
+       * Read intact records in order of appending
+       */
+      std::vector<Entry> read() const;
+
+      /**
+       * Rewrite log with entries for which keep returns true, appends
+       * wait until it is done
+       * @return kept entries, nullopt if log could not be rewritten
+       */
+      nonstd::optional<std::vector<Entry>> compact(
+          const std::function<bool(const Entry &)> &keep);
+
+      /**
+       * @return number of records appended since the last compaction,
+       * together with records kept by it
+       */
+      size_t size() const;
+
+     private:
+      MempoolLog(std::string path, int fd);
+
+      /**
+       * Read records, must be called under lock
+       */
+      std::vector<Entry> readLocked() const;
+
+      const std::string path_;
+      int fd_;
+      size_t size_ = 0;
+      mutable std::mutex mutex_;
+      logger::Logger log_;
+    };
+
+  }  // namespace ordering
+}  // namespace iroha
+
+#endif  // IROHA_MEMPOOL_LOG_HPP
@@ -16,52 +16,392 @@
  */
 
 #include "ordering/impl/ordering_gate_impl.hpp"
+#include <algorithm>
+#include "consensus/round_tracer.hpp"
+#include "ordering/impl/mempool.hpp"
+#include "tracing/tracing.hpp"
 
 namespace iroha {
   namespace ordering {
 
-    OrderingGateImpl::OrderingGateImpl(const std::string &server_address)
-        : client_(proto::OrderingService::NewStub(grpc::CreateChannel(
-              server_address, grpc::InsecureChannelCredentials()))) {
+    constexpr size_t OrderingGateImpl::kFailedCallsToSwitch;
+    constexpr size_t OrderingGateImpl::kMaxInFlight;
+    constexpr std::chrono::milliseconds OrderingGateImpl::kFetchTimeout;
+
+    OrderingGateImpl::OrderingGateImpl(
+        const std::string &server_address,
+        std::shared_ptr<network::ChannelRegistry> channels,
+        size_t batch_size,
+        std::chrono::microseconds batch_delay,
+        std::shared_ptr<BatchPool> pool)
+        : client_(proto::OrderingService::NewStub(
+              channels->channel(server_address))),
+          batch_size_(std::max<size_t>(batch_size, 1)),
+          batch_delay_(batch_delay),
+          pool_(std::move(pool)),
+          channels_(std::move(channels)),
+          leader_address_(server_address) {
       log_ = logger::log("OrderingGate");
+      if (batch_size_ > 1) {
+        flusher_ = std::thread(&OrderingGateImpl::runFlusher, this);
+      }
+    }
+
+    void OrderingGateImpl::enableFailover(
+        consensus::yac::ClusterOrdering leaders,
+        std::chrono::milliseconds timeout) {
+      std::lock_guard<std::mutex> lock(batch_mutex_);
+      leader_address_ = leaders.currentLeader().address;
+      client_ = proto::OrderingService::NewStub(
+          channels_->channel(leader_address_));
+      leaders_ = std::move(leaders);
+      leader_timeout_ = timeout;
+      watchdog_ = std::thread(&OrderingGateImpl::runWatchdog, this);
+    }
+
+    void OrderingGateImpl::updateLeaders(std::vector<model::Peer> peers) {
+      std::lock_guard<std::mutex> lock(batch_mutex_);
+      if (not leaders_ or peers.empty()) {
+        return;
+      }
+      auto current = std::find_if(
+          peers.begin(), peers.end(), [this](const auto &peer) {
+            return peer.address == leader_address_;
+          });
+      if (current != peers.end()) {
+        std::rotate(peers.begin(), current, peers.end());
+      }
+      leaders_ = consensus::yac::ClusterOrdering(std::move(peers));
+      if (leaders_->currentLeader().address != leader_address_) {
+        leader_address_ = leaders_->currentLeader().address;
+        log_->info("ordering leader is removed, switch to {}",
+                   leader_address_);
+        client_ = proto::OrderingService::NewStub(
+            channels_->channel(leader_address_));
+        state_->failed_calls = 0;
+      }
+    }
+
+    std::string OrderingGateImpl::leader() const {
+      std::lock_guard<std::mutex> lock(batch_mutex_);
+      return leader_address_;
     }
 
     void OrderingGateImpl::propagate_transaction(
         std::shared_ptr<const model::Transaction> transaction) {
-      log_->info("propagate tx");
-      auto call = new AsyncClientCall;
+      static logger::RateLimit<spdlog::level::info> limit;
+      if (auto count = limit.pass()) {
+        log_->info("propagate {} txs", count);
+      }
+      tracing::Span span("ordering_gate.propagate", transaction->trace);
+      auto pb_tx = factory_.serialize(*transaction);
+      std::lock_guard<std::mutex> lock(batch_mutex_);
+      track(pb_tx);
+      if (batch_size_ == 1) {
+        auto call = new AsyncClientCall(state_);
+
+        call->response_reader =
+            client_->AsyncSendTransaction(&call->context, pb_tx, &cq_);
+
+        call->response_reader->Finish(&call->reply, &call->status, call);
+        return;
+      }
+
+      if (batch_.transactions_size() == 0) {
+        batch_started_ = std::chrono::steady_clock::now();
+        batch_added_.notify_one();
+      }
+      batch_.add_transactions()->Swap(&pb_tx);
+      if (static_cast<size_t>(batch_.transactions_size()) >= batch_size_) {
+        flushBatch();
+      }
+    }
+
+    void OrderingGateImpl::flushBatch() {
+      if (batch_.transactions_size() == 0) {
+        return;
+      }
+      log_->info("propagate batch of {} txs", batch_.transactions_size());
+      sendBatch(batch_);
+      batch_.Clear();
+      ++batches_sent_;
+    }
+
+    void OrderingGateImpl::sendBatch(const proto::TransactionBatch &batch) {
+      auto call = new AsyncClientCall(state_);
 
-      call->response_reader = client_->AsyncSendTransaction(
-          &call->context, factory_.serialize(*transaction), &cq_);
+      call->response_reader =
+          client_->AsyncSendBatch(&call->context, batch, &cq_);
 
       call->response_reader->Finish(&call->reply, &call->status, call);
     }
 
-    rxcpp::observable<model::Proposal> OrderingGateImpl::on_proposal() {
+    void OrderingGateImpl::track(const protocol::Transaction &transaction) {
+      if (in_flight_.empty()) {
+        last_progress_ = std::chrono::steady_clock::now();
+      }
+      auto hash = Mempool::hashOf(transaction).to_string();
+      if (in_flight_.emplace(hash, transaction).second) {
+        in_flight_bodies_.emplace(
+            Mempool::fullHashOf(transaction).to_string(), hash);
+        in_flight_order_.push_back(std::move(hash));
+      }
+      while (in_flight_.size() > kMaxInFlight) {
+        forget(in_flight_order_.front());
+        in_flight_order_.pop_front();
+      }
+    }
+
+    void OrderingGateImpl::forget(const std::string &hash) {
+      auto tx = in_flight_.find(hash);
+      if (tx != in_flight_.end()) {
+        in_flight_bodies_.erase(Mempool::fullHashOf(tx->second).to_string());
+        in_flight_.erase(tx);
+      }
+    }
+
+    void OrderingGateImpl::confirm(const proto::Proposal &proposal) {
+      std::lock_guard<std::mutex> lock(batch_mutex_);
+      last_progress_ = std::chrono::steady_clock::now();
+      for (const auto &tx : proposal.transactions()) {
+        forget(Mempool::hashOf(tx).to_string());
+      }
+      // hashes of confirmed transactions are dropped from the head of order
+      while (not in_flight_order_.empty()
+             and in_flight_.count(in_flight_order_.front()) == 0) {
+        in_flight_order_.pop_front();
+      }
+      if (in_flight_order_.size() > 2 * in_flight_.size() + kMaxInFlight) {
+        in_flight_order_.erase(
+            std::remove_if(in_flight_order_.begin(),
+                           in_flight_order_.end(),
+                           [this](const auto &hash) {
+                             return in_flight_.count(hash) == 0;
+                           }),
+            in_flight_order_.end());
+      }
+    }
+
+    void OrderingGateImpl::switchLeader() {
+      leaders_->switchToNext();
+      leader_address_ = leaders_->currentLeader().address;
+      log_->warn("ordering leader does not respond, switch to {}",
+                 leader_address_);
+      client_ = proto::OrderingService::NewStub(
+          channels_->channel(leader_address_));
+      state_->failed_calls = 0;
+      last_progress_ = std::chrono::steady_clock::now();
+
+      // resent transactions are forgotten, so transactions which the new
+      // leader drops as duplicates do not cause another switch
+      proto::TransactionBatch resend;
+      for (const auto &hash : in_flight_order_) {
+        auto tx = in_flight_.find(hash);
+        if (tx == in_flight_.end()) {
+          continue;
+        }
+        resend.add_transactions()->Swap(&tx->second);
+        if (static_cast<size_t>(resend.transactions_size()) >= batch_size_) {
+          sendBatch(resend);
+          resend.Clear();
+        }
+      }
+      if (resend.transactions_size() != 0) {
+        sendBatch(resend);
+      }
+      in_flight_.clear();
+      in_flight_bodies_.clear();
+      in_flight_order_.clear();
+    }
+
+    void OrderingGateImpl::runWatchdog() {
+      auto period = std::max(leader_timeout_ / 4, std::chrono::milliseconds(1));
+      std::unique_lock<std::mutex> lock(batch_mutex_);
+      while (not stopped_) {
+        watchdog_wakeup_.wait_for(lock, period);
+        if (stopped_) {
+          break;
+        }
+        auto stalled = not in_flight_.empty()
+            and std::chrono::steady_clock::now() - last_progress_
+                > leader_timeout_;
+        if (stalled or failedCalls() >= kFailedCallsToSwitch) {
+          switchLeader();
+        }
+      }
+    }
+
+    void OrderingGateImpl::runFlusher() {
+      std::unique_lock<std::mutex> lock(batch_mutex_);
+      while (not stopped_) {
+        batch_added_.wait(lock, [this] {
+          return stopped_ or batch_.transactions_size() > 0;
+        });
+        auto awaited = batches_sent_;
+        batch_added_.wait_until(lock, batch_started_ + batch_delay_, [&] {
+          return stopped_ or batches_sent_ != awaited;
+        });
+        // batch may be already sent as full, then the next one is awaited
+        if (batches_sent_ == awaited) {
+          flushBatch();
+        }
+      }
+    }
+
+    OrderingGateImpl::~OrderingGateImpl() {
+      {
+        std::lock_guard<std::mutex> lock(batch_mutex_);
+        stopped_ = true;
+      }
+      batch_added_.notify_one();
+      watchdog_wakeup_.notify_one();
+      if (flusher_.joinable()) {
+        flusher_.join();
+      }
+      if (watchdog_.joinable()) {
+        watchdog_.join();
+      }
+    }
+
+    rxcpp::observable<std::shared_ptr<const model::Proposal>>
+    OrderingGateImpl::on_proposal() {
       return proposals_.get_observable();
     }
 
+    bool OrderingGateImpl::overloaded() const {
+      return serverOverloaded();
+    }
+
     grpc::Status OrderingGateImpl::SendProposal(
         ::grpc::ServerContext *context, const proto::Proposal *request,
         ::google::protobuf::Empty *response) {
       log_->info("receive proposal");
+      if (request->transaction_hashes_size() != 0) {
+        auto proposal = *request;
+        if (not expand(proposal)) {
+          log_->error("transactions of proposal {} are not available",
+                      proposal.height());
+          return grpc::Status(grpc::StatusCode::NOT_FOUND,
+                              "transactions of proposal are not available");
+        }
+        deliver(proposal);
+        return grpc::Status::OK;
+      }
+      if (request->batch_digests_size() == 0) {
+        deliver(*request);
+        return grpc::Status::OK;
+      }
+      if (not pool_) {
+        return grpc::Status(grpc::StatusCode::FAILED_PRECONDITION,
+                            "multi-ingest ordering is not enabled");
+      }
+
+      std::lock_guard<std::mutex> lock(proposal_mutex_);
+      if (awaited_proposal_
+          and awaited_proposal_->height() > request->height()) {
+        return grpc::Status::OK;
+      }
+      awaited_proposal_ = *request;
+      tryDeliver();
+
+      return grpc::Status::OK;
+    }
+
+    grpc::Status OrderingGateImpl::DisseminateBatch(
+        ::grpc::ServerContext *context,
+        const proto::TransactionBatch *request,
+        ::google::protobuf::Empty *response) {
+      if (not pool_) {
+        return grpc::Status(grpc::StatusCode::FAILED_PRECONDITION,
+                            "multi-ingest ordering is not enabled");
+      }
+      pool_->add(*request);
+
+      std::lock_guard<std::mutex> lock(proposal_mutex_);
+      if (awaited_proposal_) {
+        tryDeliver();
+      }
+
+      return grpc::Status::OK;
+    }
+
+    bool OrderingGateImpl::expand(proto::Proposal &proposal) {
+      std::unordered_map<std::string, protocol::Transaction> found;
+      proto::TransactionHashes missing;
+      std::shared_ptr<proto::OrderingService::Stub> client;
+      {
+        std::lock_guard<std::mutex> lock(batch_mutex_);
+        for (const auto &hash : proposal.transaction_hashes()) {
+          auto body = in_flight_bodies_.find(hash);
+          if (body == in_flight_bodies_.end()) {
+            missing.add_hashes(hash);
+          } else {
+            found.emplace(hash, in_flight_.at(body->second));
+          }
+        }
+        client = client_;
+      }
+
+      if (missing.hashes_size() != 0) {
+        log_->info("fetch {} of {} transactions",
+                   missing.hashes_size(),
+                   proposal.transaction_hashes_size());
+        grpc::ClientContext context;
+        context.set_deadline(std::chrono::system_clock::now()
+                             + kFetchTimeout);
+        proto::TransactionBatch fetched;
+        if (not client->FetchTransactions(&context, missing, &fetched).ok()) {
+          return false;
+        }
+        for (auto &tx : *fetched.mutable_transactions()) {
+          auto hash = Mempool::fullHashOf(tx).to_string();
+          found.emplace(std::move(hash), std::move(tx));
+        }
+      }
+
+      for (const auto &hash : proposal.transaction_hashes()) {
+        auto tx = found.find(hash);
+        if (tx == found.end()) {
+          return false;
+        }
+        *proposal.add_transactions() = tx->second;
+      }
+      proposal.clear_transaction_hashes();
+      return true;
+    }
+
+    void OrderingGateImpl::tryDeliver() {
+      if (not pool_->resolve(*awaited_proposal_)) {
+        log_->info("proposal {} awaits batches",
+                   awaited_proposal_->height());
+        return;
+      }
+      auto proposal = std::move(*awaited_proposal_);
+      awaited_proposal_ = nonstd::nullopt;
+      deliver(proposal);
+    }
+
+    void OrderingGateImpl::deliver(const proto::Proposal &proposal) {
+      confirm(proposal);
       // auto removes const qualifier of model::Proposal.transactions
       auto transactions =
           decltype(std::declval<model::Proposal>().transactions)();
-      for (const auto &tx : request->transactions()) {
+      for (const auto &tx : proposal.transactions()) {
         transactions.push_back(*factory_.deserialize(tx));
       }
       log_->info("transactions in proposal: {}", transactions.size());
 
-      model::Proposal proposal(transactions);
-      proposal.height = request->height();
-      handleProposal(std::move(proposal));
-
-      return grpc::Status::OK;
+      auto model_proposal =
+          std::make_shared<model::Proposal>(std::move(transactions));
+      model_proposal->height = proposal.height();
+      handleProposal(std::move(model_proposal));
     }
 
-    void OrderingGateImpl::handleProposal(model::Proposal &&proposal) {
-      proposals_.get_subscriber().on_next(proposal);
+    void OrderingGateImpl::handleProposal(
+        std::shared_ptr<const model::Proposal> proposal) {
+      consensus::roundTracer().mark(proposal->height,
+                                    consensus::RoundPhase::ProposalReceived);
+      proposals_.get_subscriber().on_next(std::move(proposal));
     }
   }  // namespace ordering
 }  // namespace iroha
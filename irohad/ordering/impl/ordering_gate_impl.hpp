@@ -18,10 +18,19 @@
 #ifndef IROHA_ORDERING_GATE_IMPL_HPP
 #define IROHA_ORDERING_GATE_IMPL_HPP
 
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include "consensus/yac/cluster_order.hpp"
 #include "model/converters/pb_transaction_factory.hpp"
 #include "network/impl/async_grpc_client.hpp"
+#include "network/impl/channel_registry.hpp"
 #include "network/ordering_gate.hpp"
 #include "ordering.grpc.pb.h"
+#include "ordering/impl/batch_pool.hpp"
 
 #include "logger/logger.hpp"
 
@@ -33,35 +42,203 @@ namespace iroha {
      * Interacts with given OrderingService
      * by propagating transactions and receiving proposals
      * @param server_address OrderingService address
+     * @param channels registry of peer channels, shared with other
+     * components
+     * @param batch_size transactions are forwarded in batches of up to this
+     * size, 1 sends every transaction in its own call
+     * @param batch_delay incomplete batch is sent after this time since
+     * its first transaction
+     * @param pool storage of disseminated batches in multi-ingest mode,
+     * proposals referring to batches are delivered when all of them arrive
+     * Compact proposals are filled with transactions propagated through
+     * this gate, missing bodies are fetched from ordering service
+     * With failover enabled, transactions are forwarded to the next leader
+     * of cluster ordering when the current one stops responding or
+     * proposing, and transactions not yet seen in proposals are resent
      */
     class OrderingGateImpl : public network::OrderingGate,
                              public proto::OrderingGate::Service,
                              network::AsyncGrpcClient<google::protobuf::Empty> {
      public:
 
-      explicit OrderingGateImpl(const std::string &server_address);
+      explicit OrderingGateImpl(
+          const std::string &server_address,
+          std::shared_ptr<network::ChannelRegistry> channels =
+              std::make_shared<network::ChannelRegistry>(),
+          size_t batch_size = 1,
+          std::chrono::microseconds batch_delay =
+              std::chrono::microseconds(0),
+          std::shared_ptr<BatchPool> pool = nullptr);
+
+      OrderingGateImpl(const OrderingGateImpl &) = delete;
+      OrderingGateImpl &operator=(const OrderingGateImpl &) = delete;
+
+      ~OrderingGateImpl() override;
+
+      /**
+       * Number of calls in a row which have not reached leader, after which
+       * the next leader is used
+       */
+      static constexpr size_t kFailedCallsToSwitch = 3;
+
+      /**
+       * Limit of transactions kept for resending, the oldest are forgotten
+       */
+      static constexpr size_t kMaxInFlight = 10000;
+
+      /**
+       * Deadline of fetching transactions of compact proposal
+       */
+      static constexpr std::chrono::milliseconds kFetchTimeout{1000};
+
+      /**
+       * Switch ordering leader on failure, must be called before
+       * transactions are propagated
+       * @param leaders - order of leaders, starting from the current one
+       * @param timeout - time without proposals while transactions are in
+       * flight, after which leader is considered failed
+       */
+      void enableFailover(consensus::yac::ClusterOrdering leaders,
+                          std::chrono::milliseconds timeout);
+
+      /**
+       * Replace order of leaders after peer list is changed by committed
+       * block. Current leader is kept while it stays in the list, without
+       * failover the call does nothing
+       * @param peers - peers of ledger in ledger order
+       */
+      void updateLeaders(std::vector<model::Peer> peers);
+
+      /**
+       * @return address of ordering service transactions are sent to
+       */
+      std::string leader() const;
 
       void propagate_transaction(
           std::shared_ptr<const model::Transaction> transaction) override;
 
-      rxcpp::observable<model::Proposal> on_proposal() override;
+      rxcpp::observable<std::shared_ptr<const model::Proposal>> on_proposal()
+          override;
+
+      bool overloaded() const override;
 
       grpc::Status SendProposal(::grpc::ServerContext *context,
                                 const proto::Proposal *request,
                                 ::google::protobuf::Empty *response) override;
 
+      /**
+       * Store batch disseminated by ordering service of a peer
+       */
+      grpc::Status DisseminateBatch(
+          ::grpc::ServerContext *context,
+          const proto::TransactionBatch *request,
+          ::google::protobuf::Empty *response) override;
+
      private:
+      /**
+       * Resolve batches of proposal and deliver it, proposal with missing
+       * batches is kept until they arrive
+       * Must be called under proposal lock
+       */
+      void tryDeliver();
+
+      /**
+       * Convert proposal to model and publish it
+       */
+      void deliver(const proto::Proposal &proposal);
+
       /**
        * Process proposal received from network
        * Publishes proposal to on_proposal subscribers
        * @param proposal
        */
-      void handleProposal(model::Proposal &&proposal);
+      void handleProposal(std::shared_ptr<const model::Proposal> proposal);
 
-      rxcpp::subjects::subject<model::Proposal> proposals_;
+      /**
+       * Send accumulated batch, must be called under batch lock
+       */
+      void flushBatch();
+
+      /**
+       * Send batch to current leader, must be called under batch lock
+       */
+      void sendBatch(const proto::TransactionBatch &batch);
+
+      /**
+       * Remember transaction until it is seen in proposal, must be called
+       * under batch lock
+       */
+      void track(const protocol::Transaction &transaction);
+
+      /**
+       * Forget transaction in flight, must be called under batch lock
+       * @param hash - mempool hash of transaction
+       */
+      void forget(const std::string &hash);
+
+      /**
+       * Replace hashes of compact proposal with transactions
+       * @return false if some of transactions are not available
+       */
+      bool expand(proto::Proposal &proposal);
+
+      /**
+       * Forget transactions of proposal, which is a sign of leader progress
+       */
+      void confirm(const proto::Proposal &proposal);
+
+      /**
+       * Use the next leader and resend transactions in flight to it, must be
+       * called under batch lock
+       */
+      void switchLeader();
+
+      /**
+       * Check leader progress until gate is stopped
+       */
+      void runWatchdog();
+
+      /**
+       * Send incomplete batches when their delay expires
+       */
+      void runFlusher();
+
+      rxcpp::subjects::subject<std::shared_ptr<const model::Proposal>>
+          proposals_;
       model::converters::PbTransactionFactory factory_;
-      std::unique_ptr<proto::OrderingService::Stub> client_;
+      std::shared_ptr<proto::OrderingService::Stub> client_;
       logger::Logger log_;
+
+      const size_t batch_size_;
+      const std::chrono::microseconds batch_delay_;
+      proto::TransactionBatch batch_;
+      std::chrono::steady_clock::time_point batch_started_;
+      uint64_t batches_sent_ = 0;
+      bool stopped_ = false;
+      mutable std::mutex batch_mutex_;
+      std::condition_variable batch_added_;
+      std::thread flusher_;
+
+      std::shared_ptr<BatchPool> pool_;
+      // the latest proposal awaiting its batches
+      nonstd::optional<proto::Proposal> awaited_proposal_;
+      std::mutex proposal_mutex_;
+
+      // failover state, guarded by batch lock
+      std::shared_ptr<network::ChannelRegistry> channels_;
+      std::string leader_address_;
+      nonstd::optional<consensus::yac::ClusterOrdering> leaders_;
+      std::chrono::milliseconds leader_timeout_{0};
+      // transactions by mempool hash, which have not been seen in
+      // proposals, also source of bodies for compact proposals
+      std::unordered_map<std::string, protocol::Transaction> in_flight_;
+      // mempool hashes of transactions in flight by their full hashes,
+      // which identify bodies of compact proposals
+      std::unordered_map<std::string, std::string> in_flight_bodies_;
+      std::deque<std::string> in_flight_order_;
+      std::chrono::steady_clock::time_point last_progress_;
+      std::condition_variable watchdog_wakeup_;
+      std::thread watchdog_;
     };
   }  // namespace ordering
 }  // namespace iroha
@@ -0,0 +1,62 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ordering/impl/ordering_policy.hpp"
+#include <algorithm>
+
+namespace iroha {
+  namespace ordering {
+
+    size_t FifoPolicy::classes() const { return 1; }
+
+    size_t FifoPolicy::classify(const protocol::Transaction &) const {
+      return 0;
+    }
+
+    PriorityPolicy::PriorityPolicy(size_t classes, size_t default_class)
+        : classes_(std::max<size_t>(classes, 1)),
+          default_class_(std::min(default_class, classes_ - 1)) {}
+
+    void PriorityPolicy::setAccountClass(const std::string &account,
+                                         size_t priority) {
+      accounts_[account] = std::min(priority, classes_ - 1);
+    }
+
+    void PriorityPolicy::setCommandClass(
+        protocol::Command::CommandCase command, size_t priority) {
+      commands_[command] = std::min(priority, classes_ - 1);
+    }
+
+    size_t PriorityPolicy::classes() const { return classes_; }
+
+    size_t PriorityPolicy::classify(
+        const protocol::Transaction &transaction) const {
+      auto account = accounts_.find(transaction.meta().creator_account_id());
+      if (account != accounts_.end()) {
+        return account->second;
+      }
+      auto priority = default_class_;
+      for (const auto &command : transaction.body().commands()) {
+        auto it = commands_.find(command.command_case());
+        if (it != commands_.end()) {
+          priority = std::min(priority, it->second);
+        }
+      }
+      return priority;
+    }
+  }  // namespace ordering
+}  // namespace iroha
@@ -0,0 +1,99 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_ORDERING_POLICY_HPP
+#define IROHA_ORDERING_POLICY_HPP
+
+#include <string>
+#include <unordered_map>
+#include "block.pb.h"
+
+namespace iroha {
+  namespace ordering {
+
+    /**
+     * Policy of proposal assembly, which splits transactions into priority
+     * classes. Transactions of class 0 are proposed first, then of class 1,
+     * and so on. Within one class accounts take turns, so an account
+     * submitting in bulk does not delay others.
+     */
+    class OrderingPolicy {
+     public:
+      /**
+       * @return number of priority classes
+       */
+      virtual size_t classes() const = 0;
+
+      /**
+       * @param transaction - transaction to classify
+       * @return priority class of transaction, less than classes()
+       */
+      virtual size_t classify(
+          const protocol::Transaction &transaction) const = 0;
+
+      virtual ~OrderingPolicy() = default;
+    };
+
+    /**
+     * Single priority class, transactions are ordered by arrival with fair
+     * turns of accounts
+     */
+    class FifoPolicy : public OrderingPolicy {
+     public:
+      size_t classes() const override;
+      size_t classify(const protocol::Transaction &transaction) const override;
+    };
+
+    /**
+     * Priority classes assigned to creator accounts and command types.
+     * Class of account takes precedence, otherwise transaction gets the
+     * highest class among its commands, or the default one.
+     * Assignment is not synchronized and must be done before the policy
+     * is used by mempool.
+     */
+    class PriorityPolicy : public OrderingPolicy {
+     public:
+      /**
+       * @param classes - number of priority classes
+       * @param default_class - class of transactions without assignment
+       */
+      PriorityPolicy(size_t classes, size_t default_class);
+
+      /**
+       * Assign priority class to transactions of account
+       */
+      void setAccountClass(const std::string &account, size_t priority);
+
+      /**
+       * Assign priority class to transactions with command of given type
+       */
+      void setCommandClass(protocol::Command::CommandCase command,
+                           size_t priority);
+
+      size_t classes() const override;
+      size_t classify(const protocol::Transaction &transaction) const override;
+
+     private:
+      const size_t classes_;
+      const size_t default_class_;
+      std::unordered_map<std::string, size_t> accounts_;
+      std::unordered_map<int, size_t> commands_;
+    };
+  }  // namespace ordering
+}  // namespace iroha
+
+#endif  // IROHA_ORDERING_POLICY_HPP
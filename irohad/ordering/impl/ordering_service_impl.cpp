@@ -16,105 +16,413 @@
  */
 
 #include "ordering/impl/ordering_service_impl.hpp"
-
-/**
- * Will be published when transaction is received.
- */
-struct TransactionEvent {};
+#include <algorithm>
+#include <unordered_set>
+#include "metrics/metrics.hpp"
+#include "tracing/tracing.hpp"
 
 namespace iroha {
   namespace ordering {
+    namespace {
+      grpc::Status retryLater() {
+        return grpc::Status(grpc::StatusCode::RESOURCE_EXHAUSTED,
+                            "mempool is full, retry later");
+      }
+
+      metrics::Histogram &proposalSizes() {
+        static auto &histogram = metrics::registry().histogram(
+            "iroha_ordering_proposal_size",
+            "Transactions, hashes or batch digests in published proposals",
+            metrics::sizeBounds());
+        return histogram;
+      }
+
+      /**
+       * @return sampled trace of transaction, parsed only when it is set
+       */
+      nonstd::optional<tracing::TraceContext> traceOf(
+          const protocol::Transaction &transaction) {
+        if (transaction.trace_parent().empty()) {
+          return nonstd::nullopt;
+        }
+        return tracing::tracer().sample(
+            tracing::TraceContext::parse(transaction.trace_parent()));
+      }
+
+      /**
+       * Mark the moment transaction leaves mempool
+       */
+      void traceProposed(const protocol::Transaction &transaction,
+                         uint64_t height) {
+        tracing::Span span("ordering_service.propose", traceOf(transaction));
+        span.attribute("height", std::to_string(height));
+      }
+    }  // namespace
+
+    constexpr size_t OrderingServiceImpl::kProposedWindow;
+
     OrderingServiceImpl::OrderingServiceImpl(
         std::shared_ptr<ametsuchi::PeerQuery> wsv, size_t max_size,
-        size_t delay_milliseconds, std::shared_ptr<uvw::Loop> loop)
+        size_t delay_milliseconds, std::shared_ptr<uvw::Loop> loop,
+        std::shared_ptr<network::ChannelRegistry> channels,
+        size_t mempool_capacity, size_t account_capacity,
+        std::shared_ptr<const OrderingPolicy> policy)
+        : OrderingServiceImpl(
+              std::move(wsv),
+              BatchingController::Bounds::fixed(
+                  max_size, std::chrono::milliseconds(delay_milliseconds)),
+              std::move(loop),
+              std::move(channels),
+              mempool_capacity,
+              account_capacity,
+              std::move(policy)) {}
+
+    OrderingServiceImpl::OrderingServiceImpl(
+        std::shared_ptr<ametsuchi::PeerQuery> wsv,
+        BatchingController::Bounds bounds, std::shared_ptr<uvw::Loop> loop,
+        std::shared_ptr<network::ChannelRegistry> channels,
+        size_t mempool_capacity, size_t account_capacity,
+        std::shared_ptr<const OrderingPolicy> policy)
         : loop_(std::move(loop)),
           timer_(loop_->resource<uvw::TimerHandle>()),
+          wakeup_(loop_->resource<uvw::AsyncHandle>()),
           wsv_(wsv),
-          max_size_(max_size),
-          delay_milliseconds_(delay_milliseconds),
+          channels_(std::move(channels)),
+          mempool_(mempool_capacity,
+                   account_capacity,
+                   Mempool::kDefaultReplayWindow,
+                   std::move(policy)),
+          batching_(bounds),
           proposal_height(2) {
 
       timer_->on<uvw::TimerEvent>([this](const auto &, auto &) {
-        if (!queue_.empty()) {
+        if (mempool_.size() != 0 or (pool_ and pool_->size() != 0)) {
           this->generateProposal();
         }
-        timer_->start(uvw::TimerHandle::Time(delay_milliseconds_),
-                      uvw::TimerHandle::Time(0));
+        this->restartTimer();
       });
 
-      this->on<TransactionEvent>([this](const auto &, auto &) {
-        if (queue_.unsafe_size() >= max_size_) {
+      wakeup_->on<uvw::AsyncEvent>([this](const auto &, auto &) {
+        wakeup_pending_ = false;
+        batching_.transactionsArrived(arrivals_.exchange(0));
+        if (mempool_.size() >= batching_.proposalSize()) {
           timer_->stop();
           this->generateProposal();
-          timer_->start(uvw::TimerHandle::Time(delay_milliseconds_),
-                        uvw::TimerHandle::Time(0));
+          this->restartTimer();
         }
       });
 
-      timer_->start(uvw::TimerHandle::Time(delay_milliseconds_),
+      restartTimer();
+    }
+
+    void OrderingServiceImpl::restartTimer() {
+      batching_.update(mempool_.size());
+      timer_->start(uvw::TimerHandle::Time(batching_.delay()),
                     uvw::TimerHandle::Time(0));
     }
 
     grpc::Status OrderingServiceImpl::SendTransaction(
         ::grpc::ServerContext *context, const protocol::Transaction *request,
         ::google::protobuf::Empty *response) {
-      handleTransaction(std::move(*factory_.deserialize(*request)));
+      auto accepted = handleTransaction(protocol::Transaction(*request));
+      wakeUp();
 
-      return grpc::Status::OK;
+      return accepted ? grpc::Status::OK : retryLater();
+    }
+
+    grpc::Status OrderingServiceImpl::SendBatch(
+        ::grpc::ServerContext *context,
+        const proto::TransactionBatch *request,
+        ::google::protobuf::Empty *response) {
+      auto accepted = true;
+      for (const auto &pb_tx : request->transactions()) {
+        accepted &= handleTransaction(protocol::Transaction(pb_tx));
+      }
+      wakeUp();
+
+      return accepted ? grpc::Status::OK : retryLater();
+    }
+
+    bool OrderingServiceImpl::handleTransaction(
+        protocol::Transaction &&transaction) {
+      tracing::Span span("ordering_service.enqueue", traceOf(transaction));
+      // transaction is moved into mempool, so its record is encoded first
+      std::vector<uint8_t> record;
+      if (mempool_log_) {
+        record = MempoolLog::encode(transaction);
+      }
+      switch (mempool_.push(transaction)) {
+        case Mempool::Admission::Full:
+          return false;
+        case Mempool::Admission::Duplicate:
+          return true;
+        case Mempool::Admission::Expired:
+          // stale transaction is dropped, a retry would not help
+          return true;
+        case Mempool::Admission::Accepted:
+          break;
+      }
+      if (mempool_log_) {
+        mempool_log_->append(record);
+      }
+
+      ++arrivals_;
+      return true;
     }
 
-    void OrderingServiceImpl::handleTransaction(
-        model::Transaction &&transaction) {
-      queue_.push(transaction);
+    void OrderingServiceImpl::wakeUp() {
+      // signals of concurrent calls are coalesced by the loop, so only
+      // calls which have found no pending arrivals need to send one
+      if (arrivals_.load() != 0 and not wakeup_pending_.exchange(true)) {
+        wakeup_->send();
+      }
+    }
 
-      publish(TransactionEvent{});
+    void OrderingServiceImpl::enableMultiIngest(
+        std::shared_ptr<BatchPool> pool, std::string address) {
+      pool_ = std::move(pool);
+      address_ = std::move(address);
+    }
+
+    void OrderingServiceImpl::enableCompactProposals() { compact_ = true; }
+
+    nonstd::optional<size_t> OrderingServiceImpl::enableMempoolLog(
+        std::unique_ptr<MempoolLog> log,
+        std::function<bool(const hash256_t &)> committed) {
+      auto entries = log->compact([&committed](const MempoolLog::Entry &entry) {
+        return not committed(entry.hash);
+      });
+      if (not entries) {
+        return nonstd::nullopt;
+      }
+      size_t restored = 0;
+      for (auto &entry : *entries) {
+        if (mempool_.push(entry.transaction)
+            == Mempool::Admission::Accepted) {
+          ++restored;
+        }
+      }
+      mempool_log_ = std::move(log);
+      is_committed_ = std::move(committed);
+      arrivals_ += restored;
+      wakeUp();
+      return restored;
+    }
+
+    void OrderingServiceImpl::committed(uint64_t height) {
+      auto next = height + 1;
+      auto current = next_height_.load();
+      while (current < next
+             and not next_height_.compare_exchange_weak(current, next)) {
+      }
+      if (mempool_log_ and height % MempoolLog::kCompactionBlocks == 0) {
+        compactMempoolLog();
+      }
+    }
+
+    void OrderingServiceImpl::compactMempoolLog() {
+      auto in_flight_since = MempoolLog::Clock::now()
+          - std::chrono::seconds(MempoolLog::kInFlightSeconds);
+      // popped transactions rejected by validation leave the log once
+      // they are not in flight anymore
+      mempool_log_->compact(
+          [this, in_flight_since](const MempoolLog::Entry &entry) {
+            return (mempool_.contains(entry.hash)
+                    or entry.logged >= in_flight_since)
+                and not is_committed_(entry.hash);
+          });
     }
 
     void OrderingServiceImpl::generateProposal() {
-      auto txs = decltype(std::declval<model::Proposal>().transactions)();
-      for (model::Transaction tx;
-           txs.size() < max_size_ and queue_.try_pop(tx);) {
-        txs.push_back(std::move(tx));
+      preparePeersForProposalRound();
+      // stale transactions are dropped before they reach a proposal
+      mempool_.expire();
+      if (pool_) {
+        sealBatch();
+        proposeBatches();
+        return;
       }
 
-      model::Proposal proposal(txs);
-      proposal.height = proposal_height++;
+      proto::Proposal proposal;
+      // a leader taking over after failover continues from the ledger top
+      proposal_height = std::max<uint64_t>(proposal_height, next_height_);
+      proposal.set_height(proposal_height++);
+      const auto max_size = batching_.proposalSize();
+      if (compact_) {
+        std::lock_guard<std::mutex> lock(proposed_mutex_);
+        for (protocol::Transaction tx;
+             static_cast<size_t>(proposal.transaction_hashes_size())
+                 < max_size
+             and mempool_.pop(tx);) {
+          traceProposed(tx, proposal.height());
+          // peers fill proposal with the very copy the leader proposes,
+          // as copies may differ in header
+          auto hash = Mempool::fullHashOf(tx).to_string();
+          proposal.add_transaction_hashes(hash);
+          rememberProposed(std::move(hash), std::move(tx));
+        }
+      } else {
+        for (protocol::Transaction tx;
+             static_cast<size_t>(proposal.transactions_size()) < max_size
+             and mempool_.pop(tx);) {
+          traceProposed(tx, proposal.height());
+          proposal.add_transactions()->Swap(&tx);
+        }
+      }
 
       publishProposal(std::move(proposal));
     }
 
-    void OrderingServiceImpl::publishProposal(model::Proposal &&proposal) {
-      preparePeersForProposalRound();
-      proto::Proposal pb_proposal;
-      pb_proposal.set_height(proposal.height);
-      for (const auto &tx : proposal.transactions) {
-        auto pb_tx = pb_proposal.add_transactions();
-        new(pb_tx) protocol::Transaction(factory_.serialize(tx));
+    void OrderingServiceImpl::rememberProposed(
+        std::string hash, protocol::Transaction &&transaction) {
+      if (proposed_.emplace(hash, std::move(transaction)).second) {
+        proposed_order_.push_back(std::move(hash));
+      }
+      while (proposed_.size() > kProposedWindow) {
+        proposed_.erase(proposed_order_.front());
+        proposed_order_.pop_front();
+      }
+    }
+
+    grpc::Status OrderingServiceImpl::FetchTransactions(
+        ::grpc::ServerContext *context,
+        const proto::TransactionHashes *request,
+        proto::TransactionBatch *response) {
+      std::lock_guard<std::mutex> lock(proposed_mutex_);
+      for (const auto &hash : request->hashes()) {
+        auto tx = proposed_.find(hash);
+        if (tx != proposed_.end()) {
+          *response->add_transactions() = tx->second;
+        }
+      }
+      return grpc::Status::OK;
+    }
+
+    void OrderingServiceImpl::sealBatch() {
+      proto::TransactionBatch batch;
+      const auto max_size = batching_.proposalSize();
+      for (protocol::Transaction tx;
+           static_cast<size_t>(batch.transactions_size()) < max_size
+           and mempool_.pop(tx);) {
+        batch.add_transactions()->Swap(&tx);
+      }
+      if (batch.transactions_size() == 0) {
+        return;
       }
 
       for (const auto &peer : peers_) {
-        auto call = new AsyncClientCall;
+        if (peer.first == address_) {
+          continue;
+        }
+        auto call = new AsyncClientCall(state_);
 
         call->response_reader =
-            peer.second->AsyncSendProposal(&call->context, pb_proposal, &cq_);
+            peer.second->AsyncDisseminateBatch(&call->context, batch, &cq_);
+
+        call->response_reader->Finish(&call->reply, &call->status, call);
+      }
+      pool_->add(std::move(batch));
+    }
+
+    void OrderingServiceImpl::proposeBatches() {
+      auto height = next_height_.load();
+      if (height == proposed_height_ or ledger_order_.empty()
+          or ledger_order_[height % ledger_order_.size()] != address_) {
+        return;
+      }
+      auto digests = pool_->pending(batching_.proposalSize());
+      if (digests.empty()) {
+        return;
+      }
+
+      proto::Proposal proposal;
+      proposal.set_height(height);
+      for (const auto &digest : digests) {
+        proposal.add_batch_digests(digest.data(), digest.size());
+      }
+      proposed_height_ = height;
+
+      publishProposal(std::move(proposal));
+    }
+
+    void OrderingServiceImpl::publishProposal(proto::Proposal &&proposal) {
+      proposalSizes().observe(static_cast<double>(
+          proposal.transactions_size() + proposal.transaction_hashes_size()
+          + proposal.batch_digests_size()));
+      for (const auto &peer : peers_) {
+        auto call = new AsyncClientCall(state_);
+
+        call->response_reader =
+            peer.second->AsyncSendProposal(&call->context, proposal, &cq_);
 
         call->response_reader->Finish(&call->reply, &call->status, call);
       }
     }
 
     void OrderingServiceImpl::preparePeersForProposalRound() {
-      peers_.clear();
       auto round_peers = wsv_->getLedgerPeers();
       if (not round_peers.has_value()) {
         // todo log error
         return;
       }
+      channels_->update(round_peers.value());
+
+      std::unordered_set<std::string> addresses;
+      ledger_order_.clear();
       for (const auto &peer : round_peers.value()) {
-        peers_[peer.address] = proto::OrderingGate::NewStub(grpc::CreateChannel(
-            peer.address, grpc::InsecureChannelCredentials()));
+        addresses.insert(peer.address);
+        ledger_order_.push_back(peer.address);
+      }
+      for (auto it = peers_.begin(); it != peers_.end();) {
+        if (addresses.count(it->first) == 0) {
+          it = peers_.erase(it);
+        } else {
+          ++it;
+        }
+      }
+      for (const auto &address : addresses) {
+        auto &stub = peers_[address];
+        if (not stub) {
+          stub = proto::OrderingGate::NewStub(channels_->channel(address));
+        }
+      }
+    }
+
+    std::string OrderingServiceImpl::metrics() const {
+      auto report = mempool_.report() + batching_.report();
+      if (pool_) {
+        report += "# TYPE iroha_ordering_pooled_batches gauge\n"
+                  "iroha_ordering_pooled_batches "
+            + std::to_string(pool_->size()) + "\n";
       }
+      return report;
+    }
+
+    size_t OrderingServiceImpl::queueDepth() const {
+      return mempool_.size();
+    }
+
+    size_t OrderingServiceImpl::queueBytes() const {
+      return mempool_.bytes();
+    }
+
+    void OrderingServiceImpl::roundCompleted(
+        std::chrono::milliseconds round_time) {
+      batching_.roundCompleted(round_time);
+    }
+
+    BatchingController::Bounds OrderingServiceImpl::proposalBounds() const {
+      return batching_.bounds();
     }
 
-    OrderingServiceImpl::~OrderingServiceImpl() { timer_->close(); }
+    void OrderingServiceImpl::setProposalBounds(
+        BatchingController::Bounds bounds) {
+      batching_.setBounds(bounds);
+    }
+
+    OrderingServiceImpl::~OrderingServiceImpl() {
+      timer_->close();
+      wakeup_->close();
+    }
   }  // namespace ordering
 }  // namespace iroha
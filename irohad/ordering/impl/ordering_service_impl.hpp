@@ -18,14 +18,21 @@
 #ifndef IROHA_ORDERING_SERVICE_IMPL_HPP
 #define IROHA_ORDERING_SERVICE_IMPL_HPP
 
+#include <atomic>
+#include <deque>
+#include <functional>
 #include <memory>
-#include <tbb/concurrent_queue.h>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 #include <uvw.hpp>
-#include "model/converters/pb_transaction_factory.hpp"
-#include "model/proposal.hpp"
 #include "network/impl/async_grpc_client.hpp"
+#include "network/impl/channel_registry.hpp"
 #include "ordering.grpc.pb.h"
+#include "ordering/impl/batch_pool.hpp"
+#include "ordering/impl/batching_controller.hpp"
+#include "ordering/impl/mempool.hpp"
+#include "ordering/impl/mempool_log.hpp"
 #include "ametsuchi/peer_query.hpp"
 
 namespace iroha {
@@ -34,71 +41,248 @@ namespace iroha {
     /**
      * OrderingService implementation with gRPC synchronous server
      * Allows receiving transactions concurrently from multiple peers by using
-     * concurrent queue
-     * Sends proposal by given timer interval and proposal size
+     * bounded mempool, transactions over its limits are refused with
+     * RESOURCE_EXHAUSTED status, so senders retry them later
+     * Transactions are kept in their wire form, so proposals are built
+     * without converting them to model and back
+     * Sends proposal by timer interval and proposal size, which are either
+     * fixed or adapted to load within given bounds
+     * Compact proposals carry transaction hashes, bodies of recently
+     * proposed transactions are served on request of gates
+     * Arrivals wake the loop once per call, and proposals are always
+     * generated on the loop thread
+     * In multi-ingest mode every peer runs the service for its own clients:
+     * collected transactions are sealed into batches and disseminated to
+     * gates of all peers, and leader of each height, chosen round robin in
+     * ledger order, proposes digests of pooled batches
+     * Accepted transactions may be written ahead to mempool log, so the
+     * queue survives restart of the service
      * @param delay_milliseconds timer delay
      * @param max_size proposal size
+     * @param bounds limits of adaptive proposal size and delay
+     * @param channels registry of peer channels, shared with other
+     * components
+     * @param mempool_capacity max number of queued transactions
+     * @param account_capacity max number of queued transactions of one
+     * account
+     * @param policy priority classes for proposal assembly, FIFO if null
      */
     class OrderingServiceImpl
         : public proto::OrderingService::Service,
-          public uvw::Emitter<OrderingServiceImpl>,
           network::AsyncGrpcClient<google::protobuf::Empty> {
      public:
       OrderingServiceImpl(
           std::shared_ptr<ametsuchi::PeerQuery> wsv, size_t max_size,
           size_t delay_milliseconds,
-          std::shared_ptr<uvw::Loop> loop = uvw::Loop::getDefault());
+          std::shared_ptr<uvw::Loop> loop = uvw::Loop::getDefault(),
+          std::shared_ptr<network::ChannelRegistry> channels =
+              std::make_shared<network::ChannelRegistry>(),
+          size_t mempool_capacity = Mempool::kDefaultCapacity,
+          size_t account_capacity = Mempool::kDefaultAccountCapacity,
+          std::shared_ptr<const OrderingPolicy> policy = nullptr);
+
+      OrderingServiceImpl(
+          std::shared_ptr<ametsuchi::PeerQuery> wsv,
+          BatchingController::Bounds bounds,
+          std::shared_ptr<uvw::Loop> loop = uvw::Loop::getDefault(),
+          std::shared_ptr<network::ChannelRegistry> channels =
+              std::make_shared<network::ChannelRegistry>(),
+          size_t mempool_capacity = Mempool::kDefaultCapacity,
+          size_t account_capacity = Mempool::kDefaultAccountCapacity,
+          std::shared_ptr<const OrderingPolicy> policy = nullptr);
+
       grpc::Status SendTransaction(
           ::grpc::ServerContext *context, const protocol::Transaction *request,
           ::google::protobuf::Empty *response) override;
+
+      /**
+       * Enqueue transactions forwarded by gate in one call
+       * Transactions which do not fit into mempool are dropped, and
+       * RESOURCE_EXHAUSTED is returned
+       */
+      grpc::Status SendBatch(::grpc::ServerContext *context,
+                             const proto::TransactionBatch *request,
+                             ::google::protobuf::Empty *response) override;
+
+      /**
+       * Serve bodies of recently proposed transactions to gates which
+       * received compact proposal
+       */
+      grpc::Status FetchTransactions(
+          ::grpc::ServerContext *context,
+          const proto::TransactionHashes *request,
+          proto::TransactionBatch *response) override;
       ~OrderingServiceImpl() override;
 
+      /**
+       * Number of proposed transactions kept for fetching
+       */
+      static constexpr size_t kProposedWindow = 10000;
+
+      /**
+       * @return mempool depth and age metrics in Prometheus text format
+       */
+      std::string metrics() const;
+
+      /**
+       * @return number of transactions waiting in mempool
+       */
+      size_t queueDepth() const;
+
+      /**
+       * @return approximate memory of transactions waiting in mempool
+       */
+      size_t queueBytes() const;
+
+      /**
+       * Account duration of committed consensus round for adaptation of
+       * proposal size and delay
+       */
+      void roundCompleted(std::chrono::milliseconds round_time);
+
+      /**
+       * @return limits of proposal size and delay
+       */
+      BatchingController::Bounds proposalBounds() const;
+
+      /**
+       * Change limits of proposal size and delay, the running timer keeps
+       * its delay
+       */
+      void setProposalBounds(BatchingController::Bounds bounds);
+
+      /**
+       * Switch to multi-ingest ordering, must be called before transactions
+       * arrive
+       * @param pool - disseminated batches, shared with gate of this peer
+       * @param address - address of this peer in ledger
+       */
+      void enableMultiIngest(std::shared_ptr<BatchPool> pool,
+                             std::string address);
+
+      /**
+       * Send hashes of transactions in proposals instead of their bodies,
+       * must be called before transactions arrive
+       */
+      void enableCompactProposals();
+
+      /**
+       * Restore transactions of log into mempool and log accepted ones,
+       * must be called before transactions arrive. Log is compacted after
+       * every MempoolLog::kCompactionBlocks committed blocks, keeping
+       * queued and recently popped transactions which are not committed
+       * @param log - write-ahead log of mempool
+       * @param committed - whether transaction with given hash is in the
+       * chain
+       * @return number of restored transactions, nullopt if log could not
+       * be compacted and is not used
+       */
+      nonstd::optional<size_t> enableMempoolLog(
+          std::unique_ptr<MempoolLog> log,
+          std::function<bool(const hash256_t &)> committed);
+
+      /**
+       * Account committed block, in multi-ingest mode the next height is
+       * proposed by its leader
+       */
+      void committed(uint64_t height);
+
      private:
       /**
        * Process transaction received from network
-       * Enqueues transaction and publishes corresponding event
+       * Enqueues transaction and counts it as arrival
+       * Duplicates are dropped without counting
        * @param transaction
+       * @return false if mempool is full
        */
-      void handleTransaction(model::Transaction &&transaction);
+      bool handleTransaction(protocol::Transaction &&transaction);
 
       /**
-       * Collect transactions from queue
+       * Signal loop about counted arrivals, unless a signal is pending
+       */
+      void wakeUp();
+
+      /**
+       * Collect transactions from queue in order given by policy
        * Passes the generated proposal to publishProposal
        */
       void generateProposal();
 
       /**
-       * Transform model proposal to transport object and send to peers
+       * Keep body of transaction proposed by hash, must be called under
+       * proposed lock
+       */
+      void rememberProposed(std::string hash,
+                            protocol::Transaction &&transaction);
+
+      /**
+       * Seal transactions from mempool into batch and disseminate it
+       */
+      void sealBatch();
+
+      /**
+       * Propose pooled batches if this peer leads the next height
+       */
+      void proposeBatches();
+
+      /**
+       * Send proposal to peers, the same request is used for every peer
        * @param proposal - object for propagation
        */
-      void publishProposal(model::Proposal &&proposal);
+      void publishProposal(proto::Proposal &&proposal);
 
       /**
        * Method update peers for sending proposal
+       * Stubs of known peers are kept, only peers added to or removed from
+       * the ledger are processed
        */
       void preparePeersForProposalRound();
 
+      /**
+       * Restart proposal timer with delay chosen by batching controller
+       */
+      void restartTimer();
+
+      /**
+       * Drop committed and stale transactions from mempool log
+       */
+      void compactMempoolLog();
+
       std::shared_ptr<uvw::Loop> loop_;
       std::shared_ptr<uvw::TimerHandle> timer_;
+      std::shared_ptr<uvw::AsyncHandle> wakeup_;
+      // arrivals since the last wakeup of the loop
+      std::atomic<size_t> arrivals_{0};
+      std::atomic<bool> wakeup_pending_{false};
       std::shared_ptr<ametsuchi::PeerQuery> wsv_;
-
-      model::converters::PbTransactionFactory factory_;
+      std::shared_ptr<network::ChannelRegistry> channels_;
 
       std::unordered_map<std::string,
                          std::unique_ptr<proto::OrderingGate::Stub>> peers_;
 
-      tbb::concurrent_queue<model::Transaction> queue_;
-
-      /**
-       * max number of txs in proposal
-       */
-      const size_t max_size_;
+      Mempool mempool_;
+      // absent when mempool is not logged
+      std::unique_ptr<MempoolLog> mempool_log_;
+      std::function<bool(const hash256_t &)> is_committed_;
 
       /**
-       *  wait for specified time if queue is empty
+       * size of proposal and timer delay
        */
-      const size_t delay_milliseconds_;
+      BatchingController batching_;
       size_t proposal_height;
+
+      // multi-ingest state, pool is null in single service mode
+      std::shared_ptr<BatchPool> pool_;
+      std::string address_;
+      std::vector<std::string> ledger_order_;
+      std::atomic<uint64_t> next_height_{2};
+      uint64_t proposed_height_ = 0;
+
+      // bodies of transactions sent in compact proposals, by full hash
+      bool compact_ = false;
+      std::unordered_map<std::string, protocol::Transaction> proposed_;
+      std::deque<std::string> proposed_order_;
+      std::mutex proposed_mutex_;
     };
   }  // namespace ordering
 }  // namespace iroha
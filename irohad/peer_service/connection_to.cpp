@@ -16,6 +16,7 @@
  */
 
 #include "connection_to.hpp"
+#include <algorithm>
 #include "service.hpp"
 
 #ifndef SHORT_TIMER_LOW
@@ -39,6 +40,8 @@
 #endif
 
 namespace peerservice {
+  constexpr uint32_t ConnectionTo::kHeartbeatTimeout;
+
   std::random_device ConnectionTo::random_device;
   // generator with random distribution
   std::default_random_engine ConnectionTo::generator(
@@ -51,68 +54,142 @@ namespace peerservice {
   std::uniform_int_distribution<uint32_t> ConnectionTo::next_long_timer(
       LONG_TIMER_LOW, LONG_TIMER_HIGH);  // ms
 
-  ConnectionTo::ConnectionTo(const Node &n, std::shared_ptr<uvw::Loop> loop)
-      : node(n) {
+  ConnectionTo::ConnectionTo(
+      const Node &n,
+      std::shared_ptr<uvw::Loop> loop,
+      std::shared_ptr<iroha::network::PeerHealth> health)
+      : node(n), health_(std::move(health)) {
+    log_ = logger::log("ConnectionTo");
     if (loop == nullptr) throw std::invalid_argument("loop is null");
 
     this->online = false;
     this->timer = loop->resource<uvw::TimerHandle>();
+    this->completed_signal_ = loop->resource<uvw::AsyncHandle>();
 
     auto to = n.ip + ":" + std::to_string(n.port);
     auto channel = grpc::CreateChannel(to, grpc::InsecureChannelCredentials());
     stub_ = PeerService::NewStub(channel);
+
+    completed_signal_->on<uvw::AsyncEvent>([this](const auto &, auto &) {
+      std::unique_ptr<HeartbeatCall> call;
+      {
+        std::lock_guard<std::mutex> lock(call_lock_);
+        call = std::move(completed_);
+      }
+      if (call) {
+        this->onAnswer(*call);
+      }
+    });
+    completion_thread_ = std::thread(&ConnectionTo::completeCalls, this);
   }
 
-  ConnectionTo::~ConnectionTo() { this->timer->close(); }
+  ConnectionTo::~ConnectionTo() {
+    {
+      std::lock_guard<std::mutex> lock(call_lock_);
+      if (in_flight_) {
+        in_flight_->context.TryCancel();
+      }
+    }
+    cq_.Shutdown();
+    completion_thread_.join();
+    this->completed_signal_->close();
+    this->timer->close();
+  }
+
+  void ConnectionTo::completeCalls() {
+    void *tag;
+    auto ok = false;
+    while (cq_.Next(&tag, &ok)) {
+      std::lock_guard<std::mutex> lock(call_lock_);
+      completed_.reset(static_cast<HeartbeatCall *>(tag));
+      in_flight_ = nullptr;
+      completed_signal_->send();
+    }
+  }
 
   void ConnectionTo::start_timer(
-      std::uniform_int_distribution<uint32_t> &distr) {
+      std::uniform_int_distribution<uint32_t> &distr, uint32_t stretch) {
     if (timer->active()) timer->stop();
 
-    auto timeout_ms = std::chrono::milliseconds(distr(ConnectionTo::generator));
+    auto timeout_ms = std::chrono::milliseconds(
+        distr(ConnectionTo::generator) * std::max<uint32_t>(stretch, 1));
     timer->start(timeout_ms, uvw::TimerHandle::Time{0});
   }
 
   void ConnectionTo::ping(Heartbeat *request) {
     if (request == nullptr) throw std::invalid_argument("request is nullptr");
 
-    grpc::ClientContext context;
-    grpc::Status status;
-    Heartbeat answer;
-
-    status = stub_->RequestHeartbeat(&context, *request, &answer);
-    printf("[my ledger is %lu] ping %s... ", request->height(),
-           context.peer().c_str());
+    std::lock_guard<std::mutex> lock(call_lock_);
+    if (in_flight_ or completed_) {
+      // answer to previous heartbeat is not handled yet
+      log_->debug("ping {}:{} is skipped, previous one is in flight",
+                  node.ip,
+                  node.port);
+      return;
+    }
+    auto call = new HeartbeatCall;
+    call->request.set_height(request->height());
+    call->request.set_pubkey(request->pubkey());
+    if (pacing_.needsRoot(request->height())) {
+      call->request.set_gmroot(request->gmroot());
+    }
+    call->sent = std::chrono::steady_clock::now();
+    call->context.set_deadline(std::chrono::system_clock::now()
+                               + std::chrono::milliseconds(kHeartbeatTimeout));
+    log_->debug("ping {}:{}, height {}, root {}",
+                node.ip,
+                node.port,
+                request->height(),
+                call->request.gmroot().empty() ? "omitted" : "sent");
+    call->reader =
+        stub_->AsyncRequestHeartbeat(&call->context, call->request, &cq_);
+    call->reader->Finish(&call->answer, &call->status, call);
+    in_flight_ = call;
+  }
 
+  void ConnectionTo::onAnswer(const HeartbeatCall &call) {
     // TODO: validate heartbeat messages
-    if (status.ok()) {
+    if (call.status.ok()) {
       // peer is alive
+      pacing_.onAnswer(call.request.height(), call.answer.height());
+      if (health_) {
+        health_->onAnswer(
+            node.pubkey,
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - call.sent)
+                .count());
+      }
       this->make_online();
-      publish(answer);  // publish event to uvw
-
+      publish(call.answer);  // publish event to uvw
+      return;
+    }
+    if (call.status.error_code() == grpc::StatusCode::CANCELLED) {
+      // our heartbeat is invalid (this->myHeartbeat)
+      // TODO handle this
+      log_->warn("heartbeat is rejected by {}:{}", node.ip, node.port);
     } else {
-      if (status.error_code() == grpc::StatusCode::CANCELLED) {
-        // our heartbeat is invalid (this->myHeartbeat)
-        // TODO handle this
-        throw std::invalid_argument("our heartbeat is invalid");
+      log_->debug("{}:{} did not answer heartbeat: {}",
+                  node.ip,
+                  node.port,
+                  call.status.error_message());
+      if (health_) {
+        health_->onTimeout(node.pubkey);
       }
-
-      // peer is dead
-      this->make_offline();
     }
+    // peer is dead
+    this->make_offline();
   }
 
   void ConnectionTo::make_online() noexcept {
-    // TODO: change to logger
-    printf("alive\n");
+    log_->debug("{}:{} is alive", node.ip, node.port);
     this->online = true;
-    this->start_timer(next_short_timer);
+    this->start_timer(next_short_timer, pacing_.stretch());
   }
 
   void ConnectionTo::make_offline() noexcept {
-    // TODO: change to logger
-    printf("dead\n");
+    log_->debug("{}:{} is dead", node.ip, node.port);
     this->online = false;
+    pacing_.reset();
     this->start_timer(next_long_timer);
   }
 }
@@ -20,16 +20,31 @@
 
 #include <grpc++/grpc++.h>
 #include <peer_service.grpc.pb.h>
+#include <chrono>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <uvw.hpp>
+#include "logger/logger.hpp"
+#include "network/impl/peer_health.hpp"
 #include "node.hpp"
+#include "peer_service/heartbeat_pacing.hpp"
 #include <random>
 
 namespace peerservice {
 
   class ConnectionTo : public ::uvw::Emitter<ConnectionTo> {
    public:
-    explicit ConnectionTo(const Node& n, std::shared_ptr<uvw::Loop> loop);
+    /**
+     * @param n - peer to connect to
+     * @param loop - loop of timers and answers
+     * @param health - table of peer health, fed with heartbeat answer times
+     * when set
+     */
+    explicit ConnectionTo(
+        const Node& n,
+        std::shared_ptr<uvw::Loop> loop,
+        std::shared_ptr<iroha::network::PeerHealth> health = nullptr);
 
     ConnectionTo(const ConnectionTo&) = delete;
     ConnectionTo(const ConnectionTo&&) = delete;
@@ -46,17 +61,68 @@ namespace peerservice {
      * given delay. Whenever we receive any message from peer X, we reset its
      * timer with short timer. If peer is dead, then we restart long timer.
      * @param distr
+     * @param stretch - multiplier of delay
      */
-    void start_timer(std::uniform_int_distribution<uint32_t>& distr);
+    void start_timer(std::uniform_int_distribution<uint32_t>& distr,
+                     uint32_t stretch = 1);
 
+    /**
+     * Send heartbeat without waiting for answer. Answer is handled on the
+     * loop when it arrives or the call times out, so unreachable peer does
+     * not block the loop. Ping is skipped while previous one is in flight.
+     * Root is omitted while peer has confirmed the height of request
+     * @param request - heartbeat of this node
+     */
     void ping(Heartbeat* request);
 
     void make_online() noexcept;
     void make_offline() noexcept;
 
+    /**
+     * Time to wait for answer to heartbeat, in milliseconds
+     */
+    static constexpr uint32_t kHeartbeatTimeout = 1000;
+
    private:
+    /**
+     * State of asynchronous heartbeat call
+     */
+    struct HeartbeatCall {
+      Heartbeat request;
+      Heartbeat answer;
+      grpc::ClientContext context;
+      grpc::Status status;
+      std::unique_ptr<grpc::ClientAsyncResponseReader<Heartbeat>> reader;
+      std::chrono::steady_clock::time_point sent;
+    };
+
+    /**
+     * Wait for completed calls and pass them to the loop
+     */
+    void completeCalls();
+
+    /**
+     * Handle answer of completed call on the loop
+     */
+    void onAnswer(const HeartbeatCall& call);
+
     Heartbeat cachedHeartbeat;
     std::unique_ptr<PeerService::Stub> stub_;
+    std::shared_ptr<iroha::network::PeerHealth> health_;
+
+    grpc::CompletionQueue cq_;
+    std::thread completion_thread_;
+    // wakes the loop up when call is completed
+    std::shared_ptr<uvw::AsyncHandle> completed_signal_;
+    // guards completed_ and in_flight_
+    std::mutex call_lock_;
+    std::unique_ptr<HeartbeatCall> completed_;
+    HeartbeatCall* in_flight_ = nullptr;
+
+    // used on the loop only
+    HeartbeatPacing pacing_;
+
+    logger::Logger log_;
 
     static std::random_device random_device;
     static std::default_random_engine generator;
@@ -0,0 +1,55 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "peer_service/heartbeat_pacing.hpp"
+#include <algorithm>
+
+namespace peerservice {
+
+  constexpr uint32_t HeartbeatPacing::kMaxStretch;
+
+  bool HeartbeatPacing::needsRoot(uint64_t height) const noexcept {
+    // peer which has confirmed our height knows its root
+    return static_cast<int64_t>(height) != acked_height_;
+  }
+
+  void HeartbeatPacing::onAnswer(uint64_t sent_height,
+                                 uint64_t peer_height) noexcept {
+    if (peer_height >= sent_height) {
+      acked_height_ = sent_height;
+    }
+    // every answer which does not change height of peer stretches the
+    // interval, change brings it back
+    if (static_cast<int64_t>(peer_height) == peer_height_) {
+      stable_ = std::min(stable_ + 1, kMaxStretch);
+    } else {
+      peer_height_ = peer_height;
+      stable_ = 0;
+    }
+  }
+
+  void HeartbeatPacing::reset() noexcept {
+    acked_height_ = -1;
+    peer_height_ = -1;
+    stable_ = 0;
+  }
+
+  uint32_t HeartbeatPacing::stretch() const noexcept {
+    return 1u << stable_;
+  }
+
+}  // namespace peerservice
@@ -0,0 +1,73 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_HEARTBEAT_PACING_HPP
+#define IROHA_HEARTBEAT_PACING_HPP
+
+#include <cstdint>
+
+namespace peerservice {
+
+  /**
+   * Progress of heartbeats to one peer: our height it has confirmed and
+   * how long its height stays the same. Heartbeats carry root only until
+   * peer confirms our height, and their interval doubles with every answer
+   * which does not change height of peer
+   */
+  class HeartbeatPacing {
+   public:
+    /**
+     * Limit of stable answers in a row, each one doubles the interval
+     */
+    static constexpr uint32_t kMaxStretch = 3;
+
+    /**
+     * @param height - our height to be sent
+     * @return true if root must be sent with the height
+     */
+    bool needsRoot(uint64_t height) const noexcept;
+
+    /**
+     * Account answer of peer
+     * @param sent_height - our height in the request
+     * @param peer_height - height of peer in the answer
+     */
+    void onAnswer(uint64_t sent_height, uint64_t peer_height) noexcept;
+
+    /**
+     * Forget progress when peer does not answer, it may come back with
+     * any state
+     */
+    void reset() noexcept;
+
+    /**
+     * @return multiplier of short interval, 2^stable answers
+     */
+    uint32_t stretch() const noexcept;
+
+   private:
+    // our height confirmed by peer, its root needs not to be sent
+    int64_t acked_height_ = -1;
+    // height of peer in its last answer
+    int64_t peer_height_ = -1;
+    // answers in a row with unchanged height of peer
+    uint32_t stable_ = 0;
+  };
+
+}  // namespace peerservice
+
+#endif  // IROHA_HEARTBEAT_PACING_HPP
@@ -16,14 +16,18 @@
  */
 
 #include "service.hpp"
-#include <future>
+#include <algorithm>
 
 namespace peerservice {
 
-  PeerServiceImpl::PeerServiceImpl(const std::vector<Node> &cluster,
-                                   const pubkey_t self, const Heartbeat &my,
-                                   std::shared_ptr<uvw::Loop> loop)
+  PeerServiceImpl::PeerServiceImpl(
+      const std::vector<Node> &cluster, const pubkey_t self,
+      const Heartbeat &my, std::shared_ptr<uvw::Loop> loop,
+      std::shared_ptr<iroha::network::PeerHealth> health)
       : loop_{loop} {
+    log_ = logger::log("PeerService");
+    // own key identifies requests of this node
+    latestState.set_pubkey(my.pubkey());
     update_latest(&my);
 
     for (auto &&node : cluster) {
@@ -31,17 +35,21 @@ namespace peerservice {
       if (node.pubkey != self) {
         other_nodes_.push_back(node);
 
-        auto &&ptr = std::make_shared<ConnectionTo>(node, loop);
+        auto &&ptr = std::make_shared<ConnectionTo>(node, loop, health);
 
         // timeout handler
         ptr->timer->on<uvw::TimerEvent>(
             [ptr, this](const uvw::TimerEvent &e, auto &t) {
+              std::lock_guard<std::mutex> lock(state_lock_);
               ptr->ping(&this->latestState);
             });
 
         // heartbeat handler
         ptr->on<Heartbeat>(
-            [this](const Heartbeat &hb, auto &t) { this->update_latest(&hb); });
+            [this](const Heartbeat &hb, auto &t) {
+              std::lock_guard<std::mutex> lock(state_lock_);
+              this->update_latest(&hb);
+            });
 
         cluster_[node.pubkey] = std::move(ptr);
 
@@ -53,65 +61,77 @@ namespace peerservice {
   }
 
   void PeerServiceImpl::start() {
+    std::unique_lock<std::mutex> lock(state_lock_);
     if (latestState.gmroot().length() != iroha::hash256_t::size()) {
       throw std::invalid_argument("add your heartbeat");
     }
+    lock.unlock();
 
+    // timers belong to the loop, starting them does not block
     for (auto &&entry : cluster_) {
       auto &&node = entry.second;
-      std::async(std::launch::async,
-                 [&node]() { node->start_timer(node->next_short_timer); });
+      node->start_timer(node->next_short_timer);
     }
   }
 
   grpc::Status PeerServiceImpl::RequestHeartbeat(grpc::ServerContext *context,
                                                  const Heartbeat *request,
                                                  Heartbeat *response) {
-    printf("[ledger: %d] %s is requesting our heartbeat... ",
-           (int)this->latestState.height(), context->peer().c_str());
-    // TODO: handle
-    try {
-      // TODO: authenticate peer by pubkey and ip. Now we
-      // authenticate by pubkey
-      auto &&pub = iroha::to_blob<pubkey_t::size()>(
-          request->pubkey());  // throws if size does not match
-
-      // we have the latest known state
-      if(pub == self_node_.pubkey) {
-        response->CopyFrom(latestState);
-        return grpc::Status::OK;
+    // TODO: authenticate peer by pubkey and ip. Now we
+    // authenticate by pubkey
+    if (request->pubkey().size() != pubkey_t::size()) {
+      log_->warn("heartbeat with bad public key from {}", context->peer());
+      return grpc::Status::CANCELLED;
+    }
+    pubkey_t pub;
+    std::copy(
+        request->pubkey().begin(), request->pubkey().end(), pub.begin());
+
+    std::shared_ptr<ConnectionTo> node;
+    if (pub != self_node_.pubkey) {
+      auto it = cluster_.find(pub);
+      if (it == cluster_.end()) {
+        log_->warn("heartbeat from unknown peer {}", context->peer());
+        return grpc::Status::CANCELLED;
       }
-
-      auto &&node =
-          cluster_.at(pub);  // throws if no given pubkey in the map cluster_
+      node = it->second;
 
       // TODO validate. Is this ok?  We need separate validation module
-      if (request->height() < 0 ||
-          request->gmroot().size() != iroha::hash256_t::size()) {
+      // root may be omitted only when height is already confirmed
+      if (request->height() < 0
+          or (not request->gmroot().empty()
+              and request->gmroot().size() != iroha::hash256_t::size())) {
         return grpc::Status::CANCELLED;
       }
+    }
 
+    {
+      std::lock_guard<std::mutex> lock(state_lock_);
+      log_->debug("heartbeat of height {}, our height {}",
+                  request->height(),
+                  latestState.height());
       // if we received a heartbeat with higher ledger that we have
-      if (request->height() > latestState.height()) {
-        update_latest(request);
-
+      if (node and update_latest(request)) {
         // event type: peerservice::Heartbeat
         publish(latestState);  // emit to uvw
       }
+      // requester knows the root of its own height
+      response->set_height(latestState.height());
+      if (latestState.height() != request->height()) {
+        response->set_gmroot(latestState.gmroot());
+      }
+    }
 
+    if (node) {
       node->make_online();
-
-      response->CopyFrom(latestState);
-      return grpc::Status::OK;
-
-    } catch (...) {
-      // TODO: handle exceptions
-      printf("we received bad public key in heartbeat\n");
-      return grpc::Status::CANCELLED;
     }
+    return grpc::Status::OK;
   }
 
-  Heartbeat PeerServiceImpl::getLatestState() noexcept { return latestState; }
+  Heartbeat PeerServiceImpl::getLatestState() noexcept {
+    std::lock_guard<std::mutex> lock(state_lock_);
+    return latestState;
+  }
 
   Node PeerServiceImpl::getMyNode() noexcept { return self_node_; }
 
@@ -120,7 +140,8 @@ namespace peerservice {
   }
 
   std::vector<Node> PeerServiceImpl::getOnlineNodes() noexcept {
-    std::vector<Node> ret(other_nodes_.size());
+    std::vector<Node> ret;
+    ret.reserve(other_nodes_.size());
     for (auto &&entry : cluster_) {
       auto &&node = entry.second;
       if (node != nullptr && node->online) {
@@ -133,6 +154,7 @@ namespace peerservice {
 
   void PeerServiceImpl::setMyState(const Heartbeat *hb) noexcept {
     // if latest known state height < than new state
+    std::lock_guard<std::mutex> lock(state_lock_);
     update_latest(hb);
   }
 
@@ -140,12 +162,17 @@ namespace peerservice {
     return other_nodes_;
   }
 
-  void PeerServiceImpl::update_latest(const Heartbeat *hb) noexcept {
-    if (hb != nullptr && hb->height() > latestState.height()) {
-      // TODO  change to logger
-      printf("Previous ledger: %d, new ledger: %d\n", (int)latestState.height(),
-             (int)hb->height());
-      latestState.CopyFrom(*hb);
+  bool PeerServiceImpl::update_latest(const Heartbeat *hb) noexcept {
+    // only state is taken, pubkey of this node is kept
+    if (hb == nullptr or hb->height() <= latestState.height()
+        or hb->gmroot().size() != iroha::hash256_t::size()) {
+      return false;
     }
+    log_->info("previous ledger: {}, new ledger: {}",
+               latestState.height(),
+               hb->height());
+    latestState.set_height(hb->height());
+    latestState.set_gmroot(hb->gmroot());
+    return true;
   }
 }
@@ -23,10 +23,12 @@
 #include <common/byteutils.hpp>
 #include <common/types.hpp>
 #include <memory>
+#include <mutex>
 #include <random>
 #include <unordered_map>
 #include <uvw.hpp>
 #include "connection_to.hpp"
+#include "logger/logger.hpp"
 #include "node.hpp"
 
 namespace peerservice {
@@ -48,10 +50,14 @@ namespace peerservice {
      * @param self this node's public key
      * @param my latest known ledger state (my state)
      * @param loop uvw::Loop instance
+     * @param health table of peer health, fed with heartbeat answer times
+     * when set
      */
-    PeerServiceImpl(const std::vector<Node>& cluster, const pubkey_t self,
-                    const Heartbeat& my,
-                    std::shared_ptr<uvw::Loop> loop = uvw::Loop::getDefault());
+    PeerServiceImpl(
+        const std::vector<Node>& cluster, const pubkey_t self,
+        const Heartbeat& my,
+        std::shared_ptr<uvw::Loop> loop = uvw::Loop::getDefault(),
+        std::shared_ptr<iroha::network::PeerHealth> health = nullptr);
 
     /**
      * Start heartbeating.
@@ -85,11 +91,19 @@ namespace peerservice {
                                           Heartbeat* response) override;
 
    private:
-    void update_latest(const Heartbeat* hb) noexcept;
+    /**
+     * Take height and root of heartbeat if it is higher than latest state.
+     * Must be called under state lock
+     * @return true if latest state is updated
+     */
+    bool update_latest(const Heartbeat* hb) noexcept;
 
     std::shared_ptr<uvw::Loop> loop_;
     // latest known state. May be from any peer.
     Heartbeat latestState;
+    // guards latest state, which is used by the loop and grpc threads
+    std::mutex state_lock_;
+    logger::Logger log_;
     Node self_node_;
 
     std::vector<Node> other_nodes_;
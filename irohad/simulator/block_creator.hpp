@@ -35,13 +35,15 @@ namespace iroha {
        * Processing proposal for making stateful validation
        * @param proposal - object for validation
        */
-      virtual void process_verified_proposal(model::Proposal) = 0;
+      virtual void process_verified_proposal(
+          std::shared_ptr<const model::Proposal>) = 0;
 
       /**
        * Emit blocks made from proposals
        * @return
        */
-      virtual rxcpp::observable <model::Block> on_block() = 0;
+      virtual rxcpp::observable<std::shared_ptr<const model::Block>>
+      on_block() = 0;
 
       virtual ~BlockCreator() = default;
     };
@@ -16,6 +16,10 @@
  */
 
 #include "simulator/impl/simulator.hpp"
+#include "consensus/round_tracer.hpp"
+#include "model/merkle_tree.hpp"
+#include "tracing/tracing.hpp"
+#include "validation/impl/recording_wsv.hpp"
 
 namespace iroha {
   namespace simulator {
@@ -25,58 +29,159 @@ namespace iroha {
         std::shared_ptr<validation::StatefulValidator> statefulValidator,
         std::shared_ptr<ametsuchi::TemporaryFactory> factory,
         std::shared_ptr<ametsuchi::BlockQuery> blockQuery,
-        std::shared_ptr<model::HashProviderImpl> hash_provider)
-        : validator_(std::move(statefulValidator)),
+        std::shared_ptr<model::HashProviderImpl> hash_provider,
+        std::shared_ptr<validation::WsvDeltaCache> deltas)
+        : ordering_gate_(ordering_gate),
+          validator_(std::move(statefulValidator)),
           ametsuchi_factory_(std::move(factory)),
           block_queries_(std::move(blockQuery)),
-          hash_provider_(std::move(hash_provider)) {
+          hash_provider_(std::move(hash_provider)),
+          deltas_(std::move(deltas)) {
       log_ = logger::log("Simulator");
-      ordering_gate->on_proposal().subscribe(
-          [this](auto proposal) { this->process_proposal(proposal); });
+      ordering_gate->on_proposal().subscribe([this](auto proposal) {
+        this->process_proposal(std::move(proposal));
+      });
 
       notifier_.get_observable().subscribe([this](auto verified_proposal) {
-        this->process_verified_proposal(verified_proposal);
+        this->process_verified_proposal(std::move(verified_proposal));
       });
     }
 
-    rxcpp::observable<model::Proposal> Simulator::on_verified_proposal() {
+    rxcpp::observable<std::shared_ptr<const model::Proposal>>
+    Simulator::on_verified_proposal() {
       return notifier_.get_observable();
     }
 
-    void Simulator::process_proposal(model::Proposal proposal) {
+    void Simulator::process_proposal(
+        std::shared_ptr<const model::Proposal> proposal) {
       log_->info("process proposal");
-      auto current_height = proposal.height;
+      auto started = std::chrono::steady_clock::now();
+      auto current_height = proposal->height;
       // Get last block from local ledger
-      last_block = model::Block();
+      last_block = std::make_shared<const model::Block>();
       block_queries_->getBlocks(current_height - 1, current_height)
           .as_blocking()
           .subscribe([this](auto block) {
-            this->last_block = block;
+            this->last_block =
+                std::make_shared<const model::Block>(std::move(block));
           });
-      if (last_block.height + 1 != proposal.height) {
-        return;
+      std::unique_ptr<ametsuchi::TemporaryWsv> temporaryStorage;
+      if (last_block->height + 1 == proposal->height) {
+        // ledger has caught up, earlier blocks are committed or abandoned
+        pending_blocks_.erase(pending_blocks_.begin(),
+                              pending_blocks_.lower_bound(proposal->height));
+        temporaryStorage = ametsuchi_factory_->createTemporaryWsv();
+      } else {
+        temporaryStorage = speculate(*proposal);
+        if (not temporaryStorage) {
+          return;
+        }
+      }
+      // writes of pending block applied above are not recorded
+      validation::RecordingWsv *recording = nullptr;
+      if (deltas_) {
+        auto wrapped = std::make_unique<validation::RecordingWsv>(
+            std::move(temporaryStorage));
+        recording = wrapped.get();
+        temporaryStorage = std::move(wrapped);
+      }
+      std::vector<model::Transaction> postponed;
+      auto verified = std::make_shared<const model::Proposal>(
+          validator_->validate(*proposal, *temporaryStorage, postponed));
+      tracing::traceEach("simulator.validate",
+                         proposal->transactions,
+                         started,
+                         proposal->height);
+      // transactions not reached in time are proposed again later
+      for (auto &tx : postponed) {
+        ordering_gate_->propagate_transaction(
+            std::make_shared<const model::Transaction>(std::move(tx)));
+      }
+      if (recording) {
+        verified_deltas_.erase(verified_deltas_.begin(),
+                               verified_deltas_.lower_bound(proposal->height));
+        verified_deltas_[proposal->height] = recording->release();
+      }
+      consensus::roundTracer().mark(proposal->height,
+                                    consensus::RoundPhase::ProposalVerified);
+      notifier_.get_subscriber().on_next(std::move(verified));
+    }
+
+    std::unique_ptr<ametsuchi::TemporaryWsv> Simulator::speculate(
+        const model::Proposal &proposal) {
+      auto pending = pending_blocks_.find(proposal.height - 1);
+      if (pending == pending_blocks_.end() or proposal.height < 3) {
+        return nullptr;
       }
+      // pipeline is one block deep: pending block must extend ledger top
+      model::Block top;
+      block_queries_->getBlocks(proposal.height - 2, proposal.height - 1)
+          .as_blocking()
+          .subscribe([&top](auto block) { top = block; });
+      if (top.height + 2 != proposal.height
+          or pending->second->prev_hash != top.hash) {
+        log_->info("pending block {} is abandoned", pending->first);
+        pending_blocks_.erase(pending);
+        return nullptr;
+      }
+
       auto temporaryStorage = ametsuchi_factory_->createTemporaryWsv();
-      notifier_.get_subscriber().on_next(
-          validator_->validate(proposal, *temporaryStorage));
+      if (not temporaryStorage) {
+        return nullptr;
+      }
+      // commands of pending block have passed stateful validation already
+      auto execute = [](const auto &tx, auto &executor, auto &query) {
+        for (const auto &command : tx.commands) {
+          if (not command->execute(query, executor)) {
+            return false;
+          }
+        }
+        return true;
+      };
+      for (const auto &tx : pending->second->transactions) {
+        if (not temporaryStorage->apply(tx, execute)) {
+          pending_blocks_.erase(pending);
+          return nullptr;
+        }
+      }
+      log_->info("validate proposal {} on top of pending block",
+                 proposal.height);
+      last_block = pending->second;
+      return temporaryStorage;
     }
 
-    void Simulator::process_verified_proposal(model::Proposal proposal) {
+    void Simulator::process_verified_proposal(
+        std::shared_ptr<const model::Proposal> proposal) {
       log_->info("process verified proposal");
-      model::Block new_block;
-      new_block.height = proposal.height;
-      new_block.prev_hash = last_block.hash;
-      new_block.transactions = proposal.transactions;
-      new_block.txs_number = proposal.transactions.size();
-      new_block.created_ts = 0;
-      new_block.merkle_root.fill(0);
-      new_block.hash = hash_provider_->get_hash(new_block);
-      new_block.sigs.push_back({});
+      // the only copy of transactions, verified proposal stays shared
+      auto new_block = std::make_shared<model::Block>();
+      new_block->height = proposal->height;
+      new_block->prev_hash = last_block->hash;
+      new_block->transactions = proposal->transactions;
+      new_block->txs_number = proposal->transactions.size();
+      new_block->created_ts = 0;
+      model::MerkleTree tree;
+      for (auto &tx : new_block->transactions) {
+        // hash computed when proposal was converted is reused
+        tx.tx_hash = hash_provider_->get_hash(tx);
+        tree.append(tx.tx_hash);
+      }
+      new_block->merkle_root = tree.root();
+      new_block->hash = hash_provider_->get_hash(*new_block);
+      new_block->sigs.push_back({});
 
-      block_notifier_.get_subscriber().on_next(new_block);
+      pending_blocks_[new_block->height] = new_block;
+      auto delta = verified_deltas_.find(new_block->height);
+      if (delta != verified_deltas_.end()) {
+        deltas_->put(new_block, std::move(delta->second));
+        verified_deltas_.erase(delta);
+      }
+      block_notifier_.get_subscriber().on_next(
+          std::shared_ptr<const model::Block>(std::move(new_block)));
     }
 
-    rxcpp::observable<model::Block> Simulator::on_block() {
+    rxcpp::observable<std::shared_ptr<const model::Block>>
+    Simulator::on_block() {
       return block_notifier_.get_observable();
     }
 
@@ -18,6 +18,7 @@
 #ifndef IROHA_SIMULATOR_HPP
 #define IROHA_SIMULATOR_HPP
 
+#include <map>
 #include "ametsuchi/block_query.hpp"
 #include "ametsuchi/temporary_factory.hpp"
 #include "model/model_hash_provider_impl.hpp"
@@ -25,12 +26,23 @@
 #include "simulator/block_creator.hpp"
 #include "simulator/verified_proposal_creator.hpp"
 #include "validation/stateful_validator.hpp"
+#include "validation/wsv_delta.hpp"
 
 #include "logger/logger.hpp"
 
 namespace iroha {
   namespace simulator {
 
+    /**
+     * Validates proposals and creates blocks from them.
+     * Rounds are pipelined: proposal for the height after a pending block,
+     * which is still being agreed on, is validated on top of that block.
+     * Speculation is dropped when other block is committed instead.
+     * Writes of validated transactions are kept in delta cache, if given,
+     * so that commit of created block does not execute them again.
+     * Transactions validator has not reached in time are sent back to
+     * ordering service.
+     */
     class Simulator : public VerifiedProposalCreator, public BlockCreator {
      public:
       Simulator(
@@ -38,33 +50,58 @@ namespace iroha {
           std::shared_ptr<validation::StatefulValidator> statefulValidator,
           std::shared_ptr<ametsuchi::TemporaryFactory> factory,
           std::shared_ptr<ametsuchi::BlockQuery> blockQuery,
-          std::shared_ptr<model::HashProviderImpl> hash_provider);
+          std::shared_ptr<model::HashProviderImpl> hash_provider,
+          std::shared_ptr<validation::WsvDeltaCache> deltas = nullptr);
 
       Simulator(const Simulator&) = delete;
       Simulator& operator=(const Simulator&) = delete;
 
-      void process_proposal(model::Proposal proposal) override;
+      void process_proposal(
+          std::shared_ptr<const model::Proposal> proposal) override;
 
-      rxcpp::observable<model::Proposal> on_verified_proposal() override;
+      rxcpp::observable<std::shared_ptr<const model::Proposal>>
+      on_verified_proposal() override;
 
-      void process_verified_proposal(model::Proposal proposal) override;
+      void process_verified_proposal(
+          std::shared_ptr<const model::Proposal> proposal) override;
 
-      rxcpp::observable<model::Block> on_block() override;
+      rxcpp::observable<std::shared_ptr<const model::Block>> on_block()
+          override;
 
      private:
+      /**
+       * Prepare state for validation of proposal on top of pending block
+       * @param proposal - proposal one block ahead of ledger
+       * @return temporary storage with pending block applied, nullptr if
+       * there is no pending block which extends ledger
+       */
+      std::unique_ptr<ametsuchi::TemporaryWsv> speculate(
+          const model::Proposal &proposal);
+
       // internal
-      rxcpp::subjects::subject<model::Proposal> notifier_;
-      rxcpp::subjects::subject<model::Block> block_notifier_;
+      rxcpp::subjects::subject<std::shared_ptr<const model::Proposal>>
+          notifier_;
+      rxcpp::subjects::subject<std::shared_ptr<const model::Block>>
+          block_notifier_;
 
+      std::shared_ptr<network::OrderingGate> ordering_gate_;
       std::shared_ptr<validation::StatefulValidator> validator_;
       std::shared_ptr<ametsuchi::TemporaryFactory> ametsuchi_factory_;
       std::shared_ptr<ametsuchi::BlockQuery> block_queries_;
       std::shared_ptr<model::HashProviderImpl> hash_provider_;
+      std::shared_ptr<validation::WsvDeltaCache> deltas_;
 
       logger::Logger log_;
 
       // last block
-      model::Block last_block;
+      std::shared_ptr<const model::Block> last_block =
+          std::make_shared<const model::Block>();
+
+      // blocks created but not yet found in ledger, by height
+      std::map<uint64_t, std::shared_ptr<const model::Block>> pending_blocks_;
+
+      // writes of verified proposals not yet made into blocks, by height
+      std::map<uint64_t, validation::WsvDelta> verified_deltas_;
     };
   }  // namespace simulator
 }  // namespace iroha
@@ -33,13 +33,15 @@ namespace iroha {
        * Processing proposal for making stateful validation
        * @param proposal - object for validation
        */
-      virtual void process_proposal(model::Proposal proposal) = 0;
+      virtual void process_proposal(
+          std::shared_ptr<const model::Proposal> proposal) = 0;
 
       /**
        * Emit proposals that was verified by validation
        * @return
        */
-      virtual rxcpp::observable<model::Proposal> on_verified_proposal() = 0;
+      virtual rxcpp::observable<std::shared_ptr<const model::Proposal>>
+      on_verified_proposal() = 0;
 
       virtual ~VerifiedProposalCreator() = default;
     };
@@ -15,63 +15,101 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <utility>
 
 #include "synchronizer/impl/synchronizer_impl.hpp"
+#include "consensus/round_tracer.hpp"
+#include "tracing/tracing.hpp"
 
 namespace iroha {
   namespace synchronizer {
 
+    constexpr size_t SynchronizerImpl::kCommitBatch;
+
     SynchronizerImpl::SynchronizerImpl(
         std::shared_ptr<network::ConsensusGate> consensus_gate,
         std::shared_ptr<validation::ChainValidator> validator,
         std::shared_ptr<ametsuchi::MutableFactory> mutableFactory,
-        std::shared_ptr<network::BlockLoader> blockLoader)
+        std::shared_ptr<network::BlockLoader> blockLoader,
+        std::shared_ptr<ametsuchi::BlockQuery> blockQuery,
+        size_t commit_batch,
+        std::shared_ptr<network::PeerHealth> health)
         : validator_(std::move(validator)),
           mutableFactory_(std::move(mutableFactory)),
-          blockLoader_(std::move(blockLoader)) {
+          blockLoader_(std::move(blockLoader)),
+          blockQuery_(std::move(blockQuery)),
+          commit_batch_(std::max<size_t>(commit_batch, 1)),
+          health_(std::move(health)) {
       log_ = logger::log("synchronizer");
       consensus_gate->on_commit().subscribe([this](auto block) {
-        this->process_commit(block);
+        this->process_commit(std::move(block));
       });
     }
 
-    void SynchronizerImpl::process_commit(iroha::model::Block commit_message) {
+    void SynchronizerImpl::process_commit(
+        std::shared_ptr<const model::Block> commit_message) {
       log_->info("processing commit");
+      auto started = std::chrono::steady_clock::now();
       auto storage = mutableFactory_->createMutableStorage();
       if (not storage) {
         log_->error("Cannot create mutable storage");
         return;
       }
-      if (validator_->validateBlock(commit_message, *storage)) {
+      auto height = commit_message->height;
+      if (validator_->validateBlock(*commit_message, *storage)) {
         // Block can be applied to current storage
         // Commit to main Ametsuchi
         mutableFactory_->commit(std::move(storage));
+        consensus::roundTracer().mark(height,
+                                      consensus::RoundPhase::Committed);
+        tracing::traceEach("synchronizer.commit",
+                           commit_message->transactions,
+                           started,
+                           height);
 
-        auto single_commit = rxcpp::observable<>::just(commit_message);
+        auto single_commit =
+            rxcpp::observable<>::just(std::move(commit_message));
 
         notifier_.get_subscriber().on_next(single_commit);
       } else {
         // Block can't be applied to current storage
-        // Download all missing blocks
-        // TODO: Loading blocks from other Peer
-        // TODO: Replace with more effective realization
-        for (auto signature : commit_message.sigs) {
+        // Download all missing blocks from peers which signed the commit
+        std::vector<model::Peer> signers;
+        for (const auto &signature : commit_message->sigs) {
           auto target_peer = model::Peer();
           target_peer.pubkey = signature.pubkey;
+          signers.push_back(target_peer);
+        }
+        if (health_) {
+          signers = health_->syncOrder(std::move(signers));
+        }
 
-          // Get your last top block
-          auto top_block = model::Block();
-          auto chain = blockLoader_->requestBlocks(target_peer, top_block);
-          storage = mutableFactory_->createMutableStorage();
-          if (!storage) {
-            log_->error("cannot create storage");
+        // with known top, chain is downloaded one batch at a time, so
+        // only a batch of blocks is held in memory
+        while (true) {
+          auto target = height;
+          if (blockQuery_) {
+            target = std::min<uint64_t>(
+                height, blockQuery_->getTopBlockHeight() + commit_batch_);
+          }
+          std::vector<std::shared_ptr<const model::Block>> chain;
+          blockLoader_->retrieveChain(signers, target)
+              .as_blocking()
+              .subscribe([&chain](auto block) {
+                chain.push_back(
+                    std::make_shared<const model::Block>(std::move(block)));
+              });
+          if (not commitChain(chain)) {
+            return;
+          }
+          if (chain.empty() or chain.back()->height != target) {
+            log_->error("downloaded chain is incomplete");
             return;
           }
-          if (validator_->validateChain(chain, *storage)) {
-            // Peer send valid chain
-            mutableFactory_->commit(std::move(storage));
-            notifier_.get_subscriber().on_next(chain);
+          if (target == height) {
+            consensus::roundTracer().mark(height,
+                                          consensus::RoundPhase::Committed);
             // You are synchronized
             return;
           }
@@ -79,6 +117,32 @@ namespace iroha {
       }
     }
 
+    bool SynchronizerImpl::commitChain(
+        const std::vector<std::shared_ptr<const model::Block>> &chain) {
+      // chain is committed in batches, so progress of long catch-up is
+      // kept, and the next commit resumes download from the last batch
+      for (size_t begin = 0; begin < chain.size(); begin += commit_batch_) {
+        auto end = std::min(chain.size(), begin + commit_batch_);
+        Commit batch = rxcpp::observable<>::iterate(
+            std::vector<std::shared_ptr<const model::Block>>(
+                chain.begin() + begin, chain.begin() + end));
+        auto storage = mutableFactory_->createMutableStorage();
+        if (not storage) {
+          log_->error("cannot create storage");
+          return false;
+        }
+        if (not validator_->validateChain(batch, *storage)) {
+          log_->error("downloaded chain is invalid from block {}",
+                      chain[begin]->height);
+          return false;
+        }
+        // Peers sent valid blocks
+        mutableFactory_->commit(std::move(storage));
+        notifier_.get_subscriber().on_next(batch);
+      }
+      return true;
+    }
+
     rxcpp::observable<Commit> SynchronizerImpl::on_commit_chain() {
       return notifier_.get_observable();
     }
@@ -17,9 +17,11 @@
 #ifndef IROHA_SYNCHRONIZER_IMPL_HPP
 #define IROHA_SYNCHRONIZER_IMPL_HPP
 
+#include "ametsuchi/block_query.hpp"
 #include "ametsuchi/mutable_factory.hpp"
 #include "network/block_loader.hpp"
 #include "network/consensus_gate.hpp"
+#include "network/impl/peer_health.hpp"
 #include "synchronizer/synchronizer.hpp"
 #include "validation/chain_validator.hpp"
 
@@ -27,22 +29,50 @@
 
 namespace iroha {
   namespace synchronizer {
+    /**
+     * Applies commits of consensus, and downloads missing blocks from
+     * signers of commit when ledger is behind
+     */
     class SynchronizerImpl : public Synchronizer {
      public:
+      static constexpr size_t kCommitBatch = 64;
+
+      /**
+       * @param blockQuery - query of local top, when given missing chain
+       * is downloaded in batches, otherwise at once
+       * @param commit_batch - number of downloaded blocks applied and
+       * committed at once
+       * @param health - health of peers, when set signers of commit are
+       * asked for blocks healthiest and fastest first
+       */
       SynchronizerImpl(
           std::shared_ptr<network::ConsensusGate> consensus_gate,
           std::shared_ptr<validation::ChainValidator> validator,
           std::shared_ptr<ametsuchi::MutableFactory> mutableFactory,
-          std::shared_ptr<network::BlockLoader> blockLoader);
+          std::shared_ptr<network::BlockLoader> blockLoader,
+          std::shared_ptr<ametsuchi::BlockQuery> blockQuery = nullptr,
+          size_t commit_batch = kCommitBatch,
+          std::shared_ptr<network::PeerHealth> health = nullptr);
 
-      void process_commit(iroha::model::Block commit_message) override;
+      void process_commit(
+          std::shared_ptr<const model::Block> commit_message) override;
 
       rxcpp::observable<Commit> on_commit_chain() override;
 
      private:
+      /**
+       * Validate and commit downloaded blocks in batches
+       * @return false if a batch is not committed
+       */
+      bool commitChain(
+          const std::vector<std::shared_ptr<const model::Block>> &chain);
+
       std::shared_ptr<validation::ChainValidator> validator_;
       std::shared_ptr<ametsuchi::MutableFactory> mutableFactory_;
       std::shared_ptr<network::BlockLoader> blockLoader_;
+      std::shared_ptr<ametsuchi::BlockQuery> blockQuery_;
+      size_t commit_batch_;
+      std::shared_ptr<network::PeerHealth> health_;
 
       // internal
       rxcpp::subjects::subject<Commit> notifier_;
@@ -34,7 +34,8 @@ namespace iroha {
       /**
        * Processing block last committed block
        */
-      virtual void process_commit(model::Block block) = 0;
+      virtual void process_commit(
+          std::shared_ptr<const model::Block> block) = 0;
 
       /**
        * Emit committed blocks
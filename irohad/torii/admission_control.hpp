@@ -0,0 +1,120 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TORII_ADMISSION_CONTROL_HPP
+#define TORII_ADMISSION_CONTROL_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace torii {
+
+  /**
+   * Token bucket quotas of clients, checked before their requests are
+   * deserialized.
+   * Each client may send burst requests at once and rate requests per
+   * second on average. While downstream queue is at least shed depth long,
+   * a client is admitted only if it keeps half of its burst, so clients
+   * which send the most are shed first and the others keep low latency.
+   * Buckets are split into independently locked shards.
+   */
+  class AdmissionControl {
+   public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Default max number of tracked clients
+     */
+    static constexpr size_t kDefaultMaxClients = 100000;
+
+    /**
+     * @param rate - requests per second admitted from one client
+     * @param burst - requests admitted from idle client at once
+     * @param queue_depth - number of transactions waiting downstream, no
+     * shedding if empty
+     * @param shed_depth - queue depth from which clients are shed, no
+     * shedding if zero
+     * @param max_clients - max number of tracked clients, idle ones are
+     * forgotten first
+     */
+    AdmissionControl(double rate,
+                     size_t burst,
+                     std::function<size_t()> queue_depth = {},
+                     size_t shed_depth = 0,
+                     size_t max_clients = kDefaultMaxClients);
+
+    AdmissionControl(const AdmissionControl &) = delete;
+    AdmissionControl &operator=(const AdmissionControl &) = delete;
+
+    /**
+     * Take tokens of client for its request
+     * @param client - identity of client, e.g. creator account
+     * @param cost - number of requests, e.g. transactions of a list
+     * @param now - time of arrival
+     * @return false if request is over quota or is shed
+     */
+    bool admit(const std::string &client,
+               size_t cost = 1,
+               Clock::time_point now = Clock::now());
+
+    /**
+     * @return rejection counters in Prometheus text format
+     */
+    std::string report() const;
+
+   private:
+    static constexpr size_t kShards = 16;
+
+    struct Bucket {
+      double tokens;
+      Clock::time_point updated;
+    };
+
+    struct Shard {
+      std::mutex mutex;
+      std::unordered_map<std::string, Bucket> buckets;
+    };
+
+    /**
+     * @return true if downstream queue is too long
+     */
+    bool shedding() const;
+
+    /**
+     * Forget clients whose buckets are full, they are equal to new ones.
+     * Must be called under lock of shard
+     */
+    void forgetIdle(Shard &shard, Clock::time_point now);
+
+    const double rate_;
+    const double burst_;
+    const std::function<size_t()> queue_depth_;
+    const size_t shed_depth_;
+    const size_t shard_capacity_;
+    std::array<Shard, kShards> shards_;
+    std::atomic<uint64_t> over_quota_{0};
+    std::atomic<uint64_t> shed_{0};
+  };
+
+}  // namespace torii
+
+#endif  // TORII_ADMISSION_CONTROL_HPP
@@ -14,6 +14,7 @@ limitations under the License.
 #include <torii/command_client.hpp>
 #include <torii/torii_service_handler.hpp>
 #include <network/grpc_call.hpp>
+#include <algorithm>
 #include <block.pb.h>
 #include <grpc++/grpc++.h>
 #include <thread>
@@ -24,9 +25,11 @@ namespace torii {
   using iroha::protocol::ToriiResponse;
 
   CommandSyncClient::CommandSyncClient(std::string ip, int port)
-      : stub_(iroha::protocol::CommandService::NewStub(
-            grpc::CreateChannel(ip + ":" + std::to_string(port),
-                                grpc::InsecureChannelCredentials()))) {}
+      : CommandSyncClient(ip + ":" + std::to_string(port)) {}
+
+  CommandSyncClient::CommandSyncClient(const std::string& target)
+      : stub_(iroha::protocol::CommandService::NewStub(grpc::CreateChannel(
+            target, grpc::InsecureChannelCredentials()))) {}
 
   CommandSyncClient::~CommandSyncClient() {
     completionQueue_.Shutdown();
@@ -39,12 +42,14 @@ namespace torii {
    * @return grpc::Status - returns connection is success or not.
    */
   grpc::Status CommandSyncClient::Torii(const Transaction& tx, ToriiResponse& response) {
-
-    auto rpc = stub_->AsyncTorii(&context_, tx, &completionQueue_);
+    // context can not be reused, so each call has its own
+    grpc::ClientContext context;
+    grpc::Status status;
+    auto rpc = stub_->AsyncTorii(&context, tx, &completionQueue_);
 
     using State = network::UntypedCall<torii::ToriiServiceHandler>::State;
 
-    rpc->Finish(&response, &status_, (void *)static_cast<int>(State::ResponseSent));
+    rpc->Finish(&response, &status, (void *)static_cast<int>(State::ResponseSent));
 
     void* got_tag;
     bool ok = false;
@@ -59,7 +64,14 @@ namespace torii {
     assert(got_tag == (void *)static_cast<int>(State::ResponseSent));
     assert(ok);
 
-    return status_;
+    return status;
+  }
+
+  grpc::Status CommandSyncClient::ListTorii(
+      const iroha::protocol::TxList& txs,
+      iroha::protocol::ToriiResponseList& response) {
+    grpc::ClientContext context;
+    return stub_->ListTorii(&context, txs, &response);
   }
 
   /**
@@ -70,7 +82,7 @@ namespace torii {
     grpc::ClientContext context;
     grpc::Status status;
     std::unique_ptr<grpc::ClientAsyncResponseReader<iroha::protocol::ToriiResponse>> responseReader;
-    CommandAsyncClient::Callback callback;
+    CommandAsyncClient::StatusCallback callback;
   };
 
   /**
@@ -83,22 +95,60 @@ namespace torii {
     const Transaction& tx,
     const std::function<void(ToriiResponse& response)>& callback)
   {
+    return Torii(tx, [callback](const grpc::Status& status,
+                                ToriiResponse& response) {
+      if (status.ok()) {
+        callback(response);
+        return;
+      }
+      ToriiResponse responseFailure;
+      responseFailure.set_validation(
+          iroha::protocol::STATELESS_VALIDATION_FAILED);
+      callback(responseFailure);
+    });
+  }
+
+  grpc::Status CommandAsyncClient::Torii(const Transaction& tx,
+                                         const StatusCallback& callback) {
     auto call = new ToriiAsyncClientCall;
     call->callback = callback;
-    call->responseReader = stub_->AsyncTorii(&call->context, tx, &completionQueue_);
+    auto& stub = stubs_[nextStub_++ % stubs_.size()];
+    ++inFlight_;
+    call->responseReader = stub->AsyncTorii(&call->context, tx, &completionQueue_);
     call->responseReader->Finish(&call->response, &call->status, (void*)call);
     return call->status;
   }
 
+  std::future<ToriiResponse> CommandAsyncClient::Torii(const Transaction& tx) {
+    auto promise = std::make_shared<std::promise<ToriiResponse>>();
+    Torii(tx, [promise](ToriiResponse& response) {
+      promise->set_value(response);
+    });
+    return promise->get_future();
+  }
+
+  size_t CommandAsyncClient::inFlight() const {
+    return inFlight_;
+  }
+
   /**
    * sets ip and port and calls listenToriiNonBlocking() in a new thread.
    * @param ip
    * @param port
+   * @param channels
    */
-  CommandAsyncClient::CommandAsyncClient(const std::string& ip, const int port)
-    : stub_(iroha::protocol::CommandService::NewStub(
-    grpc::CreateChannel(ip + ":" + std::to_string(port), grpc::InsecureChannelCredentials())))
-  {
+  CommandAsyncClient::CommandAsyncClient(const std::string& ip,
+                                         const int port,
+                                         size_t channels) {
+    for (size_t i = 0; i < std::max<size_t>(channels, 1); ++i) {
+      // channels with equal arguments share one connection
+      grpc::ChannelArguments args;
+      args.SetInt("iroha.channel_index", static_cast<int>(i));
+      stubs_.push_back(iroha::protocol::CommandService::NewStub(
+          grpc::CreateCustomChannel(ip + ":" + std::to_string(port),
+                                    grpc::InsecureChannelCredentials(),
+                                    args)));
+    }
     listener_ = std::thread(&CommandAsyncClient::listen, this);
   }
 
@@ -131,17 +181,10 @@ namespace torii {
 
       auto call = static_cast<ToriiAsyncClientCall*>(got_tag);
 
-      if (call->status.ok()) {
-        call->callback(call->response);
-      } else {
-        ToriiResponse responseFailure;
-        responseFailure.set_validation(iroha::protocol::STATELESS_VALIDATION_FAILED);
-        //responseFailure.set_code(iroha::protocol::ResponseCode::FAIL);
-       // responseFailure.set_message("RPC failed");
-        call->callback(responseFailure);
-      }
+      call->callback(call->status, call->response);
 
       delete call;
+      --inFlight_;
     }
   }
 
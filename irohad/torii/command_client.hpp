@@ -19,8 +19,11 @@ limitations under the License.
 
 #include <endpoint.grpc.pb.h>
 #include <grpc++/grpc++.h>
+#include <atomic>
+#include <future>
 #include <memory>
 #include <thread>
+#include <vector>
 
 namespace torii {
 
@@ -30,6 +33,11 @@ namespace torii {
   class CommandSyncClient {
   public:
     CommandSyncClient(std::string ip, int port);
+
+    /**
+     * @param target - address of torii, host:port or unix:path
+     */
+    explicit CommandSyncClient(const std::string& target);
     ~CommandSyncClient();
 
     /**
@@ -41,15 +49,25 @@ namespace torii {
     grpc::Status Torii(const iroha::protocol::Transaction& tx,
                        iroha::protocol::ToriiResponse& response);
 
+    /**
+     * requests many txs in one call (blocking, sync)
+     * @param txs
+     * @param response - returns responses in order of txs if succeeded
+     * @return grpc::Status - returns connection is success or not.
+     */
+    grpc::Status ListTorii(const iroha::protocol::TxList& txs,
+                           iroha::protocol::ToriiResponseList& response);
+
   private:
-    grpc::ClientContext context_;
     std::unique_ptr<iroha::protocol::CommandService::Stub> stub_;
     grpc::CompletionQueue completionQueue_;
-    grpc::Status status_;
   };
 
   /**
-   * CommandAsyncClient is used by peer service.
+   * CommandAsyncClient is used by peer service and load generators.
+   * Any number of rpcs may be in flight, they are spread over a pool of
+   * channels, each with its own connection.
+   * Callbacks are executed by the listener thread.
    */
   class CommandAsyncClient {
   public:
@@ -57,12 +75,18 @@ namespace torii {
      * sets ip and port and calls listenToriiNonBlocking() in a new thread.
      * @param ip
      * @param port
+     * @param channels - number of connections to torii, at least one
      */
-    CommandAsyncClient(const std::string& ip, const int port);
+    CommandAsyncClient(const std::string& ip,
+                       const int port,
+                       size_t channels = 1);
 
     ~CommandAsyncClient();
 
     using Callback = std::function<void(iroha::protocol::ToriiResponse& response)>;
+    using StatusCallback =
+        std::function<void(const grpc::Status& status,
+                           iroha::protocol::ToriiResponse& response)>;
 
     /**
      * Async Torii rpc
@@ -72,6 +96,29 @@ namespace torii {
      */
     grpc::Status Torii(const iroha::protocol::Transaction& tx, const Callback& callback);
 
+    /**
+     * Async Torii rpc, which tells failed rpc from failed validation
+     * @param tx
+     * @param callback - receives status of rpc and response, empty if rpc
+     * has failed
+     * @return grpc::Status
+     */
+    grpc::Status Torii(const iroha::protocol::Transaction& tx,
+                       const StatusCallback& callback);
+
+    /**
+     * Async Torii rpc
+     * @param tx
+     * @return response, with failed validation if rpc has failed
+     */
+    std::future<iroha::protocol::ToriiResponse> Torii(
+        const iroha::protocol::Transaction& tx);
+
+    /**
+     * @return number of rpcs which are sent and not responded yet
+     */
+    size_t inFlight() const;
+
   private:
     /**
      * starts response listener of non-blocking rpcs.
@@ -79,10 +126,11 @@ namespace torii {
     void listen();
 
   private:
-    grpc::ClientContext context_;
-    std::unique_ptr<iroha::protocol::CommandService::Stub> stub_;
+    std::vector<std::unique_ptr<iroha::protocol::CommandService::Stub>>
+        stubs_;
+    std::atomic<size_t> nextStub_{0};
+    std::atomic<size_t> inFlight_{0};
     grpc::CompletionQueue completionQueue_;
-    grpc::Status status_;
     std::thread listener_; // listens rpcs' responses and executes callbacks.
   };
 
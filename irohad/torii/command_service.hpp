@@ -19,12 +19,17 @@ limitations under the License.
 
 #include <endpoint.grpc.pb.h>
 #include <endpoint.pb.h>
+#include <functional>
 #include <iostream>
 #include <string>
-#include <unordered_map>
 #include "model/converters/pb_transaction_factory.hpp"
+#include "model/converters/pb_transaction_view.hpp"
 #include "model/tx_responses/stateless_response.hpp"
+#include "torii/admission_control.hpp"
 #include "torii/processor/transaction_processor.hpp"
+#include "torii/processor/transaction_status_tracker.hpp"
+#include "torii/sharded_map.hpp"
+#include "torii/tx_counter_filter.hpp"
 
 namespace torii {
 
@@ -32,29 +37,99 @@ namespace torii {
    * Actual implementation of async CommandService.
    * ToriiServiceHandler::(SomeMethod)Handler calls a corresponding method in
    * this class.
+   * Methods are called concurrently from threads of all completion queues.
    */
   class CommandService {
    public:
     CommandService(
         std::shared_ptr<iroha::model::converters::PbTransactionFactory>
             pb_factory,
-        std::shared_ptr<iroha::torii::TransactionProcessor> txProccesor);
+        std::shared_ptr<iroha::torii::TransactionProcessor> txProccesor,
+        std::shared_ptr<iroha::torii::TransactionStatusTracker> tracker =
+            nullptr,
+        std::shared_ptr<AdmissionControl> admission = nullptr,
+        std::shared_ptr<TxCounterFilter> counters = nullptr);
 
     CommandService(const CommandService&) = delete;
     CommandService& operator=(const CommandService&) = delete;
     /**
      * actual implementation of async Torii in CommandService
+     * Transactions over quota of their creator are refused with retry
+     * later, and malformed or replayed ones fail, before they are
+     * deserialized.
+     * Response may be set by validation worker after return, request and
+     * response must live until done is called
      * @param request - Transaction
      * @param response - ToriiResponse
+     * @param done - called when response is ready
      */
     void ToriiAsync(iroha::protocol::Transaction const& request,
-                    iroha::protocol::ToriiResponse& response);
+                    iroha::protocol::ToriiResponse& response,
+                    std::function<void()> done);
+
+    /**
+     * actual implementation of async ListTorii in CommandService
+     * Transactions are validated together, each gets its own response.
+     * Each transaction is taken from quota of its creator, replayed ones
+     * fail
+     * @param request - TxList
+     * @param response - ToriiResponseList, in order of transactions
+     */
+    void ListToriiAsync(iroha::protocol::TxList const& request,
+                        iroha::protocol::ToriiResponseList& response);
+
+    /**
+     * Send current status of transaction and then each of its transitions,
+     * until status is final or stream is cancelled
+     * @param request - hash of transaction
+     * @param write - sends one response, returns false if stream is closed
+     * @param cancelled - returns true if client has gone
+     * @return false if statuses are not tracked
+     */
+    bool StatusStream(
+        iroha::protocol::TxStatusRequest const& request,
+        std::function<bool(const iroha::protocol::TxStatusResponse&)> write,
+        std::function<bool()> cancelled);
+
+    /**
+     * Period of checking cancellation of status stream
+     */
+    static constexpr std::chrono::milliseconds kStatusPollPeriod{100};
+
+    /**
+     * @return size and expiration metrics of handler map, admission and
+     * replay counters in Prometheus text format
+     */
+    std::string metrics() const;
+
+    /**
+     * @return approximate memory of pending responses
+     */
+    size_t memoryUsage() const;
+
+    /**
+     * Drop the oldest pending responses under memory pressure
+     * @param bytes - approximate memory to release
+     * @return approximate memory released
+     */
+    size_t releaseMemory(size_t bytes);
 
    private:
+    struct PendingResponse {
+      iroha::protocol::ToriiResponse* response;
+      // empty when response is awaited by caller of processor
+      std::function<void()> done;
+    };
+
     std::shared_ptr<iroha::model::converters::PbTransactionFactory> pb_factory_;
     std::shared_ptr<iroha::torii::TransactionProcessor> tx_processor_;
-    std::unordered_map<std::string, iroha::protocol::ToriiResponse&>
-        handler_map_;
+    std::shared_ptr<iroha::torii::TransactionStatusTracker> tracker_;
+    // quotas of creator accounts, none if null
+    std::shared_ptr<AdmissionControl> admission_;
+    // committed counters of creators, not checked if null
+    std::shared_ptr<TxCounterFilter> counters_;
+    // responses of transactions being validated, by transaction hash
+    ShardedMap<iroha::hash256_t, PendingResponse> handler_map_;
   };
 
 }  // namespace torii
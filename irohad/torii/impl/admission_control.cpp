@@ -0,0 +1,96 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "torii/admission_control.hpp"
+#include <algorithm>
+
+namespace torii {
+
+  constexpr size_t AdmissionControl::kDefaultMaxClients;
+  constexpr size_t AdmissionControl::kShards;
+
+  AdmissionControl::AdmissionControl(double rate,
+                                     size_t burst,
+                                     std::function<size_t()> queue_depth,
+                                     size_t shed_depth,
+                                     size_t max_clients)
+      : rate_(rate),
+        burst_(std::max<size_t>(burst, 1)),
+        queue_depth_(std::move(queue_depth)),
+        shed_depth_(shed_depth),
+        shard_capacity_(std::max<size_t>(max_clients / kShards, 1)) {}
+
+  bool AdmissionControl::admit(const std::string &client,
+                               size_t cost,
+                               Clock::time_point now) {
+    // remaining tokens required from client, more of them while shedding
+    auto reserve = shedding() ? burst_ / 2 : 0.;
+    auto &shard = shards_[std::hash<std::string>{}(client) % kShards];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.buckets.find(client);
+    if (it == shard.buckets.end()) {
+      if (shard.buckets.size() >= shard_capacity_) {
+        forgetIdle(shard, now);
+      }
+      it = shard.buckets.emplace(client, Bucket{burst_, now}).first;
+    }
+    auto &bucket = it->second;
+    auto elapsed =
+        std::chrono::duration<double>(now - bucket.updated).count();
+    if (elapsed > 0) {
+      bucket.tokens = std::min(burst_, bucket.tokens + elapsed * rate_);
+      bucket.updated = now;
+    }
+    if (bucket.tokens - cost < reserve) {
+      ++(bucket.tokens < cost ? over_quota_ : shed_);
+      return false;
+    }
+    bucket.tokens -= cost;
+    return true;
+  }
+
+  bool AdmissionControl::shedding() const {
+    return shed_depth_ != 0 and queue_depth_
+        and queue_depth_() >= shed_depth_;
+  }
+
+  void AdmissionControl::forgetIdle(Shard &shard, Clock::time_point now) {
+    for (auto it = shard.buckets.begin(); it != shard.buckets.end();) {
+      auto elapsed =
+          std::chrono::duration<double>(now - it->second.updated).count();
+      if (it->second.tokens + elapsed * rate_ >= burst_) {
+        it = shard.buckets.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    // all clients are active, tracking of one of them starts over
+    if (shard.buckets.size() >= shard_capacity_) {
+      shard.buckets.erase(shard.buckets.begin());
+    }
+  }
+
+  std::string AdmissionControl::report() const {
+    return "# TYPE iroha_torii_over_quota_total counter\n"
+           "iroha_torii_over_quota_total "
+        + std::to_string(over_quota_) + "\n"
+        + "# TYPE iroha_torii_shed_total counter\n"
+          "iroha_torii_shed_total "
+        + std::to_string(shed_) + "\n";
+  }
+
+}  // namespace torii
@@ -15,15 +15,50 @@ limitations under the License.
 */
 
 #include "torii/command_service.hpp"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include "common/types.hpp"
+#include "metrics/metrics.hpp"
+#include "tracing/tracing.hpp"
 
 namespace torii {
 
+  namespace {
+    /**
+     * Rate and latency of Torii command rpc
+     */
+    struct RpcMetrics {
+      iroha::metrics::Counter &requests;
+      iroha::metrics::Histogram &latency;
+    };
+
+    RpcMetrics rpcMetrics(const std::string &method) {
+      auto &registry = iroha::metrics::registry();
+      return {registry.counter("iroha_torii_command_requests_total",
+                               "Command rpcs received by Torii",
+                               {{"method", method}}),
+              registry.histogram("iroha_torii_command_latency_seconds",
+                                 "Time until command rpc is responded",
+                                 iroha::metrics::latencyBounds(),
+                                 {{"method", method}})};
+    }
+  }  // namespace
+
+  constexpr std::chrono::milliseconds CommandService::kStatusPollPeriod;
+
   CommandService::CommandService(
       std::shared_ptr<iroha::model::converters::PbTransactionFactory>
           pb_factory,
-      std::shared_ptr<iroha::torii::TransactionProcessor> txProccesor)
-      : pb_factory_(pb_factory), tx_processor_(txProccesor) {
+      std::shared_ptr<iroha::torii::TransactionProcessor> txProccesor,
+      std::shared_ptr<iroha::torii::TransactionStatusTracker> tracker,
+      std::shared_ptr<AdmissionControl> admission,
+      std::shared_ptr<TxCounterFilter> counters)
+      : pb_factory_(pb_factory),
+        tx_processor_(txProccesor),
+        tracker_(std::move(tracker)),
+        admission_(std::move(admission)),
+        counters_(std::move(counters)) {
     // Notifier for all clients
     tx_processor_->transactionNotifier().subscribe([this](auto iroha_response) {
 
@@ -35,29 +70,211 @@ namespace torii {
         // Find response in handler map
 
         auto res =
-            this->handler_map_.find(resp.transaction.tx_hash.to_string());
+            this->handler_map_.take(resp.transaction.tx_hash);
+        if (not res) {
+          return;
+        }
 
-        res->second.set_validation(
+        res->response->set_validation(
             resp.passed ? iroha::protocol::STATELESS_VALIDATION_SUCCESS
                         : iroha::protocol::STATELESS_VALIDATION_FAILED);
+        if (res->done) {
+          res->done();
+        }
       }
     });
   }
 
   void CommandService::ToriiAsync(iroha::protocol::Transaction const &request,
-                                  iroha::protocol::ToriiResponse &response) {
+                                  iroha::protocol::ToriiResponse &response,
+                                  std::function<void()> done) {
+    static auto metrics = rpcMetrics("Torii");
+    metrics.requests.inc();
+    // response is ready when done is called, possibly after return
+    done = [done = std::move(done),
+            start = std::chrono::steady_clock::now()] {
+      metrics.latency.observe(std::chrono::steady_clock::now() - start);
+      done();
+    };
+    iroha::model::converters::PbTransactionView view(request);
+    if (tx_processor_->overloaded()
+        or (admission_ and not admission_->admit(view.creatorAccountId()))) {
+      response.set_validation(iroha::protocol::STATELESS_VALIDATION_FAILED);
+      response.set_retry_later(true);
+      done();
+      return;
+    }
+    if (not view.wellFormed()
+        or (counters_
+            and not counters_->fresh(view.creatorAccountId(),
+                                     view.txCounter()))) {
+      response.set_validation(iroha::protocol::STATELESS_VALIDATION_FAILED);
+      done();
+      return;
+    }
+
     auto iroha_tx = pb_factory_->deserialize(request);
+    // spans of following stages are children of this one
+    iroha::tracing::Span span(
+        "torii.receive", iroha::tracing::tracer().sample(iroha_tx->trace));
+    iroha_tx->trace = span.context();
 
-    auto tx_hash = iroha_tx->tx_hash.to_string();
+    const auto &tx_hash = iroha_tx->tx_hash;
 
-    if (handler_map_.count(tx_hash)) {
+    // the same transaction is being validated by another thread
+    if (not handler_map_.insert(tx_hash, {&response, done})) {
       response.set_validation(iroha::protocol::STATELESS_VALIDATION_FAILED);
+      done();
       return;
     }
 
-    handler_map_.insert({tx_hash, response});
-    // Send transaction to iroha
+    // Send transaction to iroha, notifier sets response and calls done,
+    // possibly after return
     tx_processor_->transactionHandle(iroha_tx);
   }
 
+  void CommandService::ListToriiAsync(
+      iroha::protocol::TxList const &request,
+      iroha::protocol::ToriiResponseList &response) {
+    static auto metrics = rpcMetrics("ListTorii");
+    metrics.requests.inc();
+    iroha::metrics::ScopedTimer timer(metrics.latency);
+    // all responses are added first, so their addresses stay valid
+    for (int i = 0; i < request.transactions_size(); ++i) {
+      response.add_responses()->set_validation(
+          iroha::protocol::STATELESS_VALIDATION_FAILED);
+    }
+    if (tx_processor_->overloaded()) {
+      for (auto &tx_response : *response.mutable_responses()) {
+        tx_response.set_retry_later(true);
+      }
+      return;
+    }
+
+    std::vector<std::shared_ptr<iroha::model::Transaction>> transactions;
+    std::vector<iroha::hash256_t> hashes;
+    std::vector<iroha::tracing::Span> spans;
+    for (int i = 0; i < request.transactions_size(); ++i) {
+      iroha::model::converters::PbTransactionView view(
+          request.transactions(i));
+      if (admission_ and not admission_->admit(view.creatorAccountId())) {
+        response.mutable_responses(i)->set_retry_later(true);
+        continue;
+      }
+      if (not view.wellFormed()
+          or (counters_
+              and not counters_->fresh(view.creatorAccountId(),
+                                       view.txCounter()))) {
+        continue;
+      }
+      auto iroha_tx = pb_factory_->deserialize(request.transactions(i));
+      iroha::tracing::Span span(
+          "torii.receive", iroha::tracing::tracer().sample(iroha_tx->trace));
+      iroha_tx->trace = span.context();
+      if (span) {
+        spans.push_back(std::move(span));
+      }
+      auto tx_hash = iroha_tx->tx_hash;
+      // duplicates, also within the list, are refused
+      if (handler_map_.insert(tx_hash, {response.mutable_responses(i), {}})) {
+        transactions.push_back(std::move(iroha_tx));
+        hashes.push_back(tx_hash);
+      }
+    }
+
+    // responses are set by notifier before return
+    tx_processor_->transactionsHandle(std::move(transactions));
+    for (const auto &hash : hashes) {
+      handler_map_.take(hash);
+    }
+  }
+
+  bool CommandService::StatusStream(
+      iroha::protocol::TxStatusRequest const &request,
+      std::function<bool(const iroha::protocol::TxStatusResponse &)> write,
+      std::function<bool()> cancelled) {
+    using Status = iroha::torii::TransactionStatusTracker::Status;
+    if (not tracker_) {
+      return false;
+    }
+    const auto &hash = request.tx_hash();
+
+    std::mutex mutex;
+    std::condition_variable updated;
+    std::deque<Status> pending;
+    auto subscription = tracker_->updates()
+                            .filter([&hash](const auto &update) {
+                              return update.hash == hash;
+                            })
+                            .subscribe([&](const auto &update) {
+                              std::lock_guard<std::mutex> lock(mutex);
+                              pending.push_back(update.status);
+                              updated.notify_one();
+                            });
+    // status is read after subscription, so no transition is missed,
+    // and without the lock, which is taken by tracker under its own one
+    auto current = tracker_->status(hash);
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      pending.push_front(current);
+    }
+
+    iroha::protocol::TxStatusResponse response;
+    response.set_tx_hash(hash);
+    auto last = Status::NotReceived;
+    auto first = true;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (not cancelled()) {
+      updated.wait_for(
+          lock, kStatusPollPeriod, [&pending] { return not pending.empty(); });
+      auto statuses = std::move(pending);
+      pending.clear();
+      lock.unlock();
+      auto done = false;
+      for (auto status : statuses) {
+        // transitions published before the status was read are repeated
+        if (not first and status <= last) {
+          continue;
+        }
+        first = false;
+        last = status;
+        response.set_status(static_cast<iroha::protocol::TxStatus>(status));
+        done = not write(response)
+            or iroha::torii::TransactionStatusTracker::isFinal(status);
+        if (done) {
+          break;
+        }
+      }
+      lock.lock();
+      if (done) {
+        break;
+      }
+    }
+    lock.unlock();
+    subscription.unsubscribe();
+    // transitions are published under lock of tracker, so taking it waits
+    // for the one which may still refer to this stream
+    tracker_->status(hash);
+    return true;
+  }
+
+  std::string CommandService::metrics() const {
+    auto report = handler_map_.report("iroha_torii_command_handlers");
+    if (admission_) {
+      report += admission_->report();
+    }
+    if (counters_) {
+      report += counters_->report();
+    }
+    return report;
+  }
+
+  size_t CommandService::memoryUsage() const {
+    return handler_map_.memoryUsage();
+  }
+
+  size_t CommandService::releaseMemory(size_t bytes) {
+    return handler_map_.release(bytes);
+  }
+
 }  // namespace torii
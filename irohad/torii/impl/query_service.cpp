@@ -16,36 +16,383 @@
  */
 
 #include "torii/query_service.hpp"
+#include <algorithm>
+#include <future>
+#include "metrics/metrics.hpp"
+#include "model/queries/get_transactions.hpp"
+#include "model/queries/responses/error_response.hpp"
 
 namespace torii {
 
+  namespace {
+    // transactions sent in one streamed response
+    const int kStreamPageSize = 100;
+
+    /**
+     * Rate and latency of Torii query rpc
+     */
+    struct RpcMetrics {
+      iroha::metrics::Counter &requests;
+      iroha::metrics::Histogram &latency;
+    };
+
+    RpcMetrics rpcMetrics(const std::string &method) {
+      auto &registry = iroha::metrics::registry();
+      return {registry.counter("iroha_torii_query_requests_total",
+                               "Query rpcs received by Torii",
+                               {{"method", method}}),
+              registry.histogram("iroha_torii_query_latency_seconds",
+                                 "Time until query rpc is responded",
+                                 iroha::metrics::latencyBounds(),
+                                 {{"method", method}})};
+    }
+
+    /**
+     * @return pagination of history query which can be followed by
+     * subscription, nullptr for other queries
+     */
+    iroha::model::TxPagination *historyPagination(iroha::model::Query &query) {
+      using namespace iroha::model;
+      if (auto history = dynamic_cast<GetAccountTransactions *>(&query)) {
+        return &history->pagination;
+      }
+      if (auto history = dynamic_cast<GetAccountAssetTransactions *>(&query)) {
+        return &history->pagination;
+      }
+      auto transfers = dynamic_cast<GetAssetTransfers *>(&query);
+      if (transfers and transfers->to_height == 0) {
+        return &transfers->pagination;
+      }
+      return nullptr;
+    }
+
+    /**
+     * Outcome of waits of queries for commit
+     */
+    iroha::metrics::Counter &readWaits(const std::string &result) {
+      return iroha::metrics::registry().counter(
+          "iroha_torii_query_read_waits_total",
+          "Queries waiting for commit to read after, by how wait ended",
+          {{"result", result}});
+    }
+  }  // namespace
+
+  constexpr size_t QueryService::kDefaultWorkers;
+  constexpr std::chrono::milliseconds QueryService::kSubscriberPoll;
+  constexpr std::chrono::milliseconds QueryService::kDefaultReadWait;
+  constexpr std::chrono::milliseconds QueryService::kMaxReadWait;
+
   QueryService::QueryService(
       std::shared_ptr<iroha::model::converters::PbQueryFactory>
           pb_query_factory,
       std::shared_ptr<iroha::model::converters::PbQueryResponseFactory>
           pb_query_response_factory,
-      std::shared_ptr<iroha::torii::QueryProcessor> query_processor)
+      std::shared_ptr<iroha::torii::QueryProcessor> query_processor,
+      std::shared_ptr<iroha::ametsuchi::BlockQuery> block_query,
+      size_t workers)
       : pb_query_factory_(pb_query_factory),
         pb_query_response_factory_(pb_query_response_factory),
-        query_processor_(query_processor) {
+        query_processor_(query_processor),
+        block_query_(block_query),
+        committed_height_(block_query_->getTopBlockHeight()),
+        workers_(workers),
+        waiter_([this] { waitCommits(); }) {
     // Subscribe on result from iroha
     query_processor_->queryNotifier().subscribe([this](auto iroha_response) {
       // Find client to respond
-      auto res = handler_map_.find(iroha_response->query_hash.to_string());
-      // Serialize to proto an return to response
-      res->second =
-          pb_query_response_factory_->serialize(iroha_response).value();
-
+      auto handler =
+          handler_map_.take(iroha_response->query_hash);
+      if (not handler) {
+        return;
+      }
+      (*handler)(iroha_response);
     });
   }
 
   void QueryService::FindAsync(iroha::protocol::Query const& request,
-                               iroha::protocol::QueryResponse& response) {
+                               iroha::protocol::QueryResponse& response,
+                               std::function<void()> done) {
+    static auto metrics = rpcMetrics("Find");
+    metrics.requests.inc();
+    // time spent waiting for commit and for a worker is included
+    WorkerPool::Task task = [this,
+                             &request,
+                             &response,
+                             done = std::move(done),
+                             start = std::chrono::steady_clock::now()] {
+      // processor responds before returning, response stays empty if query
+      // is not processed
+      process(request, [this, &response](auto iroha_response) {
+        // Serialize to proto an return to response
+        response =
+            pb_query_response_factory_->serialize(iroha_response).value();
+      });
+      metrics.latency.observe(std::chrono::steady_clock::now() - start);
+      done();
+    };
+    readAfter(request, [this, task] { workers_.post(task); });
+  }
+
+  void QueryService::FindStream(
+      iroha::protocol::Query const& request,
+      std::function<bool(const iroha::protocol::QueryResponse&)> write) {
+    static auto metrics = rpcMetrics("FindStream");
+    metrics.requests.inc();
+    iroha::metrics::ScopedTimer timer(metrics.latency);
+    awaitReadAfter(request);
+    auto handled = process(request, [this, &write](auto iroha_response) {
+      this->stream(iroha_response, write);
+    });
+    if (not handled) {
+      iroha::model::ErrorResponse response;
+      response.reason = iroha::model::ErrorResponse::NOT_SUPPORTED;
+      write(pb_query_response_factory_
+                ->serialize(
+                    std::make_shared<iroha::model::ErrorResponse>(response))
+                .value());
+    }
+  }
+
+  void QueryService::Subscribe(
+      iroha::protocol::Query const& request,
+      std::function<bool(const iroha::protocol::QueryResponse&)> write,
+      std::function<bool()> cancelled) {
+    static auto metrics = rpcMetrics("Subscribe");
+    metrics.requests.inc();
+    awaitReadAfter(request);
+    auto query = pb_query_factory_->deserialize(request);
+    auto pagination = query ? historyPagination(*query) : nullptr;
+    if (not pagination or pagination->page_size == 0) {
+      iroha::model::ErrorResponse response;
+      response.reason = iroha::model::ErrorResponse::NOT_SUPPORTED;
+      write(pb_query_response_factory_
+                ->serialize(
+                    std::make_shared<iroha::model::ErrorResponse>(response))
+                .value());
+      return;
+    }
+
+    auto committedHeight = [this] {
+      std::lock_guard<std::mutex> lock(committed_mutex_);
+      return committed_height_;
+    };
+    // the first page is checked as any query, the next ones continue it
+    std::shared_ptr<iroha::model::QueryResponse> response;
+    auto seen = committedHeight();
+    handler_map_.insert(query->query_hash,
+                        [&response](auto iroha_response) {
+                          response = iroha_response;
+                        });
+    query_processor_->queryHandle(query);
+    auto first = true;
+    while (response and not cancelled()) {
+      auto page =
+          std::dynamic_pointer_cast<iroha::model::TransactionsResponse>(
+              response);
+      if (not page) {
+        // e.g. permission of creator has been revoked
+        write(pb_query_response_factory_->serialize(response).value());
+        return;
+      }
+      auto full = static_cast<bool>(page->next);
+      if (page->last) {
+        pagination->after = page->last;
+        page->next = page->last;
+      }
+      // pages without transactions are not sent, except the first one
+      // confirming the subscription
+      if ((first or page->last) and not stream(page, write)) {
+        return;
+      }
+      first = false;
+      if (not full) {
+        std::unique_lock<std::mutex> lock(committed_mutex_);
+        while (not committed_cv_.wait_for(lock, kSubscriberPoll, [&] {
+          return committed_height_ > seen;
+        })) {
+          if (cancelled()) {
+            return;
+          }
+        }
+        seen = committed_height_;
+      } else {
+        seen = committedHeight();
+      }
+      response = query_processor_->queryContinue(query);
+    }
+  }
+
+  void QueryService::committed(uint64_t height) {
+    {
+      std::lock_guard<std::mutex> lock(committed_mutex_);
+      committed_height_ = std::max(committed_height_, height);
+    }
+    committed_cv_.notify_all();
+  }
+
+  void QueryService::readAfter(iroha::protocol::Query const& request,
+                               std::function<void()> ready) {
+    if (request.min_height() == 0 and request.after_tx_hash().empty()) {
+      ready();
+      return;
+    }
+    auto wait = std::chrono::milliseconds(request.wait_ms());
+    if (wait.count() == 0) {
+      wait = kDefaultReadWait;
+    }
+    wait = std::min(wait, kMaxReadWait);
+    ReadAfter read{request.min_height(),
+                   nonstd::nullopt,
+                   std::chrono::steady_clock::now() + wait,
+                   std::move(ready),
+                   nonstd::nullopt};
+    // hash of wrong size can not be committed, query waits for height only
+    if (request.after_tx_hash().size() == iroha::hash256_t::size()) {
+      read.tx_hash = iroha::hash256_t();
+      std::copy(request.after_tx_hash().begin(),
+                request.after_tx_hash().end(),
+                read.tx_hash->begin());
+    }
+    {
+      std::lock_guard<std::mutex> lock(committed_mutex_);
+      waiting_.push_back(std::move(read));
+    }
+    committed_cv_.notify_all();
+  }
+
+  void QueryService::awaitReadAfter(iroha::protocol::Query const& request) {
+    // shared, so promise outlives setting its value after wait returns
+    auto ready = std::make_shared<std::promise<void>>();
+    auto future = ready->get_future();
+    readAfter(request, [ready] { ready->set_value(); });
+    future.wait();
+  }
+
+  void QueryService::waitCommits() {
+    std::list<ReadAfter> checked;
+    std::unique_lock<std::mutex> lock(committed_mutex_);
+    while (not stopped_) {
+      auto now = std::chrono::steady_clock::now();
+      auto height = committed_height_;
+      for (auto it = waiting_.begin(); it != waiting_.end();) {
+        auto next = std::next(it);
+        if (not it->checked or *it->checked < height or it->deadline <= now) {
+          checked.splice(checked.end(), waiting_, it);
+        }
+        it = next;
+      }
+      if (checked.empty()) {
+        auto earliest = std::min_element(
+            waiting_.begin(), waiting_.end(), [](auto &lhs, auto &rhs) {
+              return lhs.deadline < rhs.deadline;
+            });
+        if (earliest == waiting_.end()) {
+          committed_cv_.wait(lock);
+        } else {
+          committed_cv_.wait_until(lock, earliest->deadline);
+        }
+        continue;
+      }
+
+      // transactions are looked up in storage without blocking commits
+      lock.unlock();
+      for (auto it = checked.begin(); it != checked.end();) {
+        auto next = std::next(it);
+        auto reached = height >= it->min_height
+            and (not it->tx_hash
+                 or block_query_->hasTransaction(*it->tx_hash));
+        if (reached or it->deadline <= now) {
+          readWaits(reached ? "committed" : "deadline").inc();
+          it->ready();
+          checked.erase(it);
+        } else {
+          it->checked = height;
+        }
+        it = next;
+      }
+      lock.lock();
+      waiting_.splice(waiting_.end(), checked);
+    }
+  }
+
+  QueryService::~QueryService() {
+    {
+      std::lock_guard<std::mutex> lock(committed_mutex_);
+      stopped_ = true;
+    }
+    committed_cv_.notify_all();
+    waiter_.join();
+    // waiting queries are executed with the state they have
+    for (auto &read : waiting_) {
+      read.ready();
+    }
+  }
+
+  bool QueryService::process(iroha::protocol::Query const& request,
+                             Handler handler) {
     // Get iroha model query
     auto query = pb_query_factory_->deserialize(request);
+    if (not query) {
+      return false;
+    }
     // Query - response relationship
-    handler_map_.insert({query->query_hash.to_string(), response});
+    handler_map_.insert(query->query_hash, std::move(handler));
     // Send query to iroha
     query_processor_->queryHandle(query);
+    return true;
   }
-}
+
+  bool QueryService::stream(
+      std::shared_ptr<iroha::model::QueryResponse> response,
+      const std::function<bool(const iroha::protocol::QueryResponse&)>&
+          write) {
+    auto transactions =
+        std::dynamic_pointer_cast<iroha::model::TransactionsResponse>(
+            response);
+    if (not transactions) {
+      return write(pb_query_response_factory_->serialize(response).value());
+    }
+    iroha::protocol::QueryResponse page;
+    page.mutable_transactions_response();
+    bool closed = false;
+    rxcpp::composite_subscription lifetime;
+    transactions->transactions.as_blocking().subscribe(
+        lifetime, [&](const iroha::model::Transaction& tx) {
+          auto pb_page = page.mutable_transactions_response();
+          pb_query_response_factory_->appendTransaction(
+              *pb_page, tx, transactions->mask);
+          if (pb_page->transactions_size() == kStreamPageSize) {
+            // reading stops once client is gone
+            if (not write(page)) {
+              closed = true;
+              lifetime.unsubscribe();
+            }
+            pb_page->clear_transactions();
+            pb_page->clear_tx_hashes();
+          }
+        });
+    if (closed) {
+      return false;
+    }
+    // the last part carries continuation of paginated history
+    if (transactions->next) {
+      auto next = page.mutable_transactions_response()->mutable_next();
+      next->set_height(transactions->next->height);
+      next->set_index(transactions->next->index);
+    }
+    return write(page);
+  }
+
+  std::string QueryService::metrics() const {
+    return handler_map_.report("iroha_torii_query_handlers");
+  }
+
+  size_t QueryService::memoryUsage() const {
+    return handler_map_.memoryUsage();
+  }
+
+  size_t QueryService::releaseMemory(size_t bytes) {
+    return handler_map_.release(bytes);
+  }
+
+}  // namespace torii
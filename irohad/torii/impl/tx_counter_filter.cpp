@@ -0,0 +1,94 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "torii/tx_counter_filter.hpp"
+#include <algorithm>
+
+namespace torii {
+
+  constexpr size_t TxCounterFilter::kDefaultMaxAccounts;
+  constexpr size_t TxCounterFilter::kShards;
+
+  TxCounterFilter::TxCounterFilter(Load load, size_t max_accounts)
+      : load_(std::move(load)),
+        shard_capacity_(std::max<size_t>(max_accounts / kShards, 1)) {}
+
+  bool TxCounterFilter::fresh(const std::string &account_id,
+                              uint64_t tx_counter) {
+    if (tx_counter == 0) {
+      return true;
+    }
+    auto &shard = shardOf(account_id);
+    {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      auto it = shard.counters.find(account_id);
+      if (it != shard.counters.end()) {
+        if (tx_counter > it->second) {
+          return true;
+        }
+        ++stale_;
+        return false;
+      }
+    }
+
+    // loaded without lock, so other accounts of shard are not held up
+    auto loaded = load_(account_id);
+    if (not loaded) {
+      // unknown creator is rejected by validation, it is not tracked
+      return true;
+    }
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (shard.counters.size() >= shard_capacity_) {
+      shard.counters.clear();
+    }
+    auto &counter = shard.counters[account_id];
+    // a commit may have raised the counter meanwhile
+    counter = std::max(counter, *loaded);
+    if (tx_counter > counter) {
+      return true;
+    }
+    ++stale_;
+    return false;
+  }
+
+  void TxCounterFilter::committed(const iroha::model::Block &block) {
+    for (const auto &tx : block.transactions) {
+      if (tx.tx_counter == 0) {
+        continue;
+      }
+      auto &shard = shardOf(tx.creator_account_id);
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      // accounts which are not tracked read the counter from ledger
+      auto it = shard.counters.find(tx.creator_account_id);
+      if (it != shard.counters.end()) {
+        it->second = std::max(it->second, tx.tx_counter);
+      }
+    }
+  }
+
+  std::string TxCounterFilter::report() const {
+    return "# TYPE iroha_torii_stale_counter_total counter\n"
+           "iroha_torii_stale_counter_total "
+        + std::to_string(stale_) + "\n";
+  }
+
+  TxCounterFilter::Shard &TxCounterFilter::shardOf(
+      const std::string &account_id) {
+    return shards_[std::hash<std::string>{}(account_id) % kShards];
+  }
+
+}  // namespace torii
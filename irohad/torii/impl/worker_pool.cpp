@@ -0,0 +1,63 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "torii/worker_pool.hpp"
+#include <algorithm>
+
+namespace torii {
+
+  WorkerPool::WorkerPool(size_t workers) {
+    for (size_t i = 0; i < std::max<size_t>(workers, 1); ++i) {
+      workers_.emplace_back(&WorkerPool::run, this);
+    }
+  }
+
+  void WorkerPool::post(Task task) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.push_back(std::move(task));
+    }
+    wakeup_.notify_one();
+  }
+
+  void WorkerPool::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      wakeup_.wait(lock, [this] { return stopped_ or not tasks_.empty(); });
+      if (tasks_.empty()) {
+        return;
+      }
+      auto task = std::move(tasks_.front());
+      tasks_.pop_front();
+      lock.unlock();
+      task();
+      lock.lock();
+    }
+  }
+
+  WorkerPool::~WorkerPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopped_ = true;
+    }
+    wakeup_.notify_all();
+    for (auto &worker : workers_) {
+      worker.join();
+    }
+  }
+
+}  // namespace torii
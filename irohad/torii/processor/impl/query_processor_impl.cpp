@@ -40,6 +40,11 @@ namespace iroha {
       }
     }
 
+    std::shared_ptr<model::QueryResponse> QueryProcessorImpl::queryContinue(
+        std::shared_ptr<const model::Query> query) {
+      return qpf_->execute(query);
+    }
+
     rxcpp::observable<std::shared_ptr<model::QueryResponse>>
     QueryProcessorImpl::queryNotifier() {
       return subject_.get_observable();
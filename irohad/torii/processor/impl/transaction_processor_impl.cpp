@@ -15,10 +15,12 @@
  * limitations under the License.
  */
 
+#include <tbb/parallel_for.h>
 #include <iostream>
 #include <model/tx_responses/stateless_response.hpp>
 #include <torii/processor/transaction_processor_impl.hpp>
 #include <utility>
+#include "tracing/tracing.hpp"
 
 namespace iroha {
   namespace torii {
@@ -27,27 +29,112 @@ namespace iroha {
     using model::TransactionResponse;
     using network::PeerCommunicationService;
 
+    constexpr size_t TransactionProcessorImpl::kMaxPendingTransactions;
+
     TransactionProcessorImpl::TransactionProcessorImpl(
         std::shared_ptr<PeerCommunicationService> pcs,
-        std::shared_ptr<StatelessValidator> validator)
+        std::shared_ptr<StatelessValidator> validator,
+        size_t workers)
         : pcs_(std::move(pcs)), validator_(std::move(validator)) {
       log_ = logger::log("TxProcessor");
+      for (size_t i = 0; i < workers; ++i) {
+        workers_.emplace_back(&TransactionProcessorImpl::runWorker, this);
+      }
+    }
+
+    TransactionProcessorImpl::~TransactionProcessorImpl() {
+      {
+        std::lock_guard<std::mutex> lock(wakeup_mutex_);
+        stopped_ = true;
+      }
+      wakeup_.notify_all();
+      for (auto &worker : workers_) {
+        worker.join();
+      }
     }
 
     void TransactionProcessorImpl::transactionHandle(
         std::shared_ptr<model::Transaction> transaction) {
-      log_->info("handle transaction");
-      model::TransactionStatelessResponse response;
-      response.transaction = *transaction;
-      response.passed = false;
+      static logger::RateLimit<spdlog::level::info> limit;
+      if (auto count = limit.pass()) {
+        log_->info("handle transaction, {} since last message", count);
+      }
+      if (workers_.empty()) {
+        process(transaction);
+        return;
+      }
+      ++pending_size_;
+      pending_.push(std::move(transaction));
+      if (sleeping_ > 0) {
+        // workers check queue under the lock, so taking it here
+        // guarantees that notification is not lost
+        std::lock_guard<std::mutex> lock(wakeup_mutex_);
+        wakeup_.notify_one();
+      }
+    }
 
-      if (validator_->validate(*transaction)) {
-        response.passed = true;
+    void TransactionProcessorImpl::process(
+        const std::shared_ptr<model::Transaction> &transaction) {
+      tracing::Span span("stateless_validation", transaction->trace);
+      auto passed = validator_->validate(*transaction);
+      span.attribute("passed", logger::boolRepr(passed));
+      if (passed) {
         pcs_->propagate_transaction(transaction);
       }
-      log_->info("stateless validation status: {}", response.passed);
-      notifier_.get_subscriber().on_next(
-          std::make_shared<model::TransactionStatelessResponse>(response));
+      static logger::RateLimit<spdlog::level::info> limit;
+      if (auto count = limit.pass()) {
+        log_->info("stateless validation status: {}, {} since last message",
+                   passed,
+                   count);
+      }
+      notify(passed, *transaction);
+    }
+
+    void TransactionProcessorImpl::notify(
+        bool passed, const model::Transaction &transaction) {
+      auto response = std::make_shared<model::TransactionStatelessResponse>();
+      response->transaction = transaction;
+      response->passed = passed;
+      std::lock_guard<std::mutex> lock(notifier_mutex_);
+      notifier_.get_subscriber().on_next(response);
+    }
+
+    void TransactionProcessorImpl::runWorker() {
+      std::shared_ptr<model::Transaction> transaction;
+      while (not stopped_) {
+        while (not stopped_ and pending_.try_pop(transaction)) {
+          --pending_size_;
+          process(transaction);
+        }
+        std::unique_lock<std::mutex> lock(wakeup_mutex_);
+        ++sleeping_;
+        wakeup_.wait(lock,
+                     [this] { return stopped_ or not pending_.empty(); });
+        --sleeping_;
+      }
+    }
+
+    void TransactionProcessorImpl::transactionsHandle(
+        std::vector<std::shared_ptr<model::Transaction>> transactions) {
+      log_->info("handle {} transactions", transactions.size());
+      // vector<bool> is not safe for concurrent writes of its elements
+      std::vector<char> passed(transactions.size(), false);
+      tbb::parallel_for(size_t(0), transactions.size(), [&](size_t i) {
+        tracing::Span span("stateless_validation", transactions[i]->trace);
+        passed[i] = validator_->validate(*transactions[i]);
+        span.attribute("passed", logger::boolRepr(passed[i]));
+      });
+
+      for (size_t i = 0; i < transactions.size(); ++i) {
+        if (passed[i]) {
+          pcs_->propagate_transaction(transactions[i]);
+        }
+        notify(passed[i], *transactions[i]);
+      }
+    }
+
+    bool TransactionProcessorImpl::overloaded() const {
+      return pending_size_ >= kMaxPendingTransactions or pcs_->overloaded();
     }
 
     rxcpp::observable<std::shared_ptr<model::TransactionResponse>>
@@ -0,0 +1,122 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "torii/processor/transaction_status_tracker.hpp"
+#include "model/tx_responses/stateless_response.hpp"
+
+namespace iroha {
+  namespace torii {
+
+    constexpr size_t TransactionStatusTracker::kDefaultCapacity;
+
+    TransactionStatusTracker::TransactionStatusTracker(
+        std::shared_ptr<TransactionProcessor> processor,
+        std::shared_ptr<network::PeerCommunicationService> pcs,
+        std::shared_ptr<simulator::VerifiedProposalCreator> verified_proposals,
+        size_t capacity)
+        : capacity_(capacity) {
+      processor->transactionNotifier().subscribe([this](auto response) {
+        auto stateless =
+            std::dynamic_pointer_cast<model::TransactionStatelessResponse>(
+                response);
+        if (not stateless) {
+          return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        this->advance(stateless->transaction.tx_hash.to_string(),
+                      stateless->passed ? Status::StatelessAccepted
+                                        : Status::StatelessRejected);
+      });
+
+      pcs->on_proposal().subscribe([this](const auto &proposal) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        proposed_.clear();
+        for (const auto &tx : proposal->transactions) {
+          auto hash = this->hashOf(tx);
+          this->advance(hash, Status::Proposed);
+          proposed_.insert(std::move(hash));
+        }
+      });
+
+      verified_proposals->on_verified_proposal().subscribe(
+          [this](const auto &proposal) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto &tx : proposal->transactions) {
+              auto hash = this->hashOf(tx);
+              this->advance(hash, Status::StatefulValid);
+              proposed_.erase(hash);
+            }
+            // the rest of proposal has not passed stateful validation
+            for (const auto &hash : proposed_) {
+              this->advance(hash, Status::StatefulRejected);
+            }
+            proposed_.clear();
+          });
+
+      pcs->on_commit().subscribe([this](network::Commit commit) {
+        commit.subscribe([this](const auto &block) {
+          std::lock_guard<std::mutex> lock(mutex_);
+          for (const auto &tx : block->transactions) {
+            this->advance(this->hashOf(tx), Status::Committed);
+          }
+        });
+      });
+    }
+
+    bool TransactionStatusTracker::isFinal(Status status) {
+      return status == Status::StatelessRejected
+          or status == Status::StatefulRejected
+          or status == Status::Committed;
+    }
+
+    TransactionStatusTracker::Status TransactionStatusTracker::status(
+        const std::string &hash) const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = statuses_.find(hash);
+      return it == statuses_.end() ? Status::NotReceived : it->second;
+    }
+
+    rxcpp::observable<TransactionStatusTracker::Update>
+    TransactionStatusTracker::updates() {
+      return updates_.get_observable();
+    }
+
+    void TransactionStatusTracker::advance(const std::string &hash,
+                                           Status status) {
+      auto it = statuses_.find(hash);
+      if (it == statuses_.end()) {
+        it = statuses_.emplace(hash, Status::NotReceived).first;
+        order_.push_back(hash);
+      }
+      if (isFinal(it->second) or it->second >= status) {
+        return;
+      }
+      it->second = status;
+      updates_.get_subscriber().on_next(Update{hash, status});
+
+      while (statuses_.size() > capacity_) {
+        statuses_.erase(order_.front());
+        order_.pop_front();
+      }
+    }
+
+    std::string TransactionStatusTracker::hashOf(
+        const model::Transaction &transaction) {
+      return hash_provider_.get_hash(transaction).to_string();
+    }
+  }  // namespace torii
+}  // namespace iroha
@@ -39,6 +39,16 @@ namespace iroha {
        */
       virtual void queryHandle(std::shared_ptr<model::Query> query) = 0;
 
+      /**
+       * Execute query which has passed queryHandle before, e.g. the next
+       * page of a subscription. Signature and age of the query are not
+       * checked again, permissions of its creator are
+       * @param query - accepted query with changed pagination
+       * @return response, which is not published by queryNotifier
+       */
+      virtual std::shared_ptr<model::QueryResponse> queryContinue(
+          std::shared_ptr<const model::Query> query) = 0;
+
       /**
        * Subscribe for query responses
        * @return observable with query responses
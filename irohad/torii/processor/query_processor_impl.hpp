@@ -40,6 +40,9 @@ namespace iroha {
        */
       void queryHandle(std::shared_ptr<model::Query> query) override;
 
+      std::shared_ptr<model::QueryResponse> queryContinue(
+          std::shared_ptr<const model::Query> query) override;
+
       /**
        * Subscribe for query responses
        * @return observable with query responses
@@ -34,11 +34,30 @@ namespace iroha {
      public:
 
       /**
-       * Add transaction to the system for processing
+       * Add transaction to the system for processing.
+       * Its response may be notified after return.
        * @param transaction - transaction for processing
        */
       virtual void transactionHandle(std::shared_ptr<model::Transaction> transaction) = 0;
 
+      /**
+       * Add transactions received in one call to the system for processing,
+       * each of them is notified separately
+       * @param transactions - transactions for processing
+       */
+      virtual void transactionsHandle(
+          std::vector<std::shared_ptr<model::Transaction>> transactions) {
+        for (auto &transaction : transactions) {
+          transactionHandle(std::move(transaction));
+        }
+      }
+
+      /**
+       * @return true if new transactions are not accepted for now, and
+       * clients should retry later
+       */
+      virtual bool overloaded() const { return false; }
+
       /**
        * Subscribers will be notified with transaction status
        * @return observable for subscribing
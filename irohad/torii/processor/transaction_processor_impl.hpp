@@ -18,33 +18,76 @@
 #ifndef IROHA_TRANSACTION_PROCESSOR_STUB_HPP
 #define IROHA_TRANSACTION_PROCESSOR_STUB_HPP
 
+#include <tbb/concurrent_queue.h>
+#include <atomic>
+#include <condition_variable>
 #include <model/transaction_response.hpp>
+#include <mutex>
 #include <network/peer_communication_service.hpp>
 #include <torii/processor/transaction_processor.hpp>
 #include <validation/stateless_validator.hpp>
+#include <thread>
+#include <vector>
 #include "logger/logger.hpp"
 
 namespace iroha {
   namespace torii {
     class TransactionProcessorImpl : public TransactionProcessor {
      public:
+      /**
+       * Upper bound of transactions waiting for validation stage,
+       * processor is overloaded when it is reached
+       */
+      static constexpr size_t kMaxPendingTransactions = 10000;
+
       /**
        * @param pcs - provide information proposals and commits
        * @param os - ordering service for sharing transactions
        * @param validator - perform stateless validation
        * @param crypto_provider - sign income transactions
+       * @param workers - threads of validation stage, transactions are
+       * validated by calling thread when zero
        */
       TransactionProcessorImpl(
           std::shared_ptr<network::PeerCommunicationService> pcs,
-          std::shared_ptr<validation::StatelessValidator> validator);
+          std::shared_ptr<validation::StatelessValidator> validator,
+          size_t workers = 0);
 
+      ~TransactionProcessorImpl() override;
+
+      /**
+       * Queue transaction for validation stage, workers propagate valid
+       * transactions and notify results in order of completion
+       */
       void transactionHandle(
           std::shared_ptr<model::Transaction> transaction) override;
 
+      /**
+       * Validate transactions in parallel, then propagate valid ones and
+       * notify results in order of transactions
+       */
+      void transactionsHandle(
+          std::vector<std::shared_ptr<model::Transaction>> transactions)
+          override;
+
+      bool overloaded() const override;
+
       rxcpp::observable<std::shared_ptr<model::TransactionResponse>>
       transactionNotifier() override;
 
      private:
+      /**
+       * Validate transaction, propagate it if valid and notify result
+       */
+      void process(const std::shared_ptr<model::Transaction> &transaction);
+
+      void notify(bool passed, const model::Transaction &transaction);
+
+      /**
+       * Loop of validation stage worker
+       */
+      void runWorker();
+
       // connections
       std::shared_ptr<network::PeerCommunicationService> pcs_;
 
@@ -54,6 +97,17 @@ namespace iroha {
       // internal
       rxcpp::subjects::subject<std::shared_ptr<model::TransactionResponse>>
           notifier_;
+      // subject is not safe for concurrent notifications
+      std::mutex notifier_mutex_;
+
+      // validation stage
+      tbb::concurrent_queue<std::shared_ptr<model::Transaction>> pending_;
+      std::atomic<size_t> pending_size_{0};
+      std::atomic<size_t> sleeping_{0};
+      std::atomic<bool> stopped_{false};
+      std::mutex wakeup_mutex_;
+      std::condition_variable wakeup_;
+      std::vector<std::thread> workers_;
 
       logger::Logger log_;
     };
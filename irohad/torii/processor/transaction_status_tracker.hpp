@@ -0,0 +1,121 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_TRANSACTION_STATUS_TRACKER_HPP
+#define IROHA_TRANSACTION_STATUS_TRACKER_HPP
+
+#include <deque>
+#include <mutex>
+#include <rxcpp/rx.hpp>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include "model/model_hash_provider_impl.hpp"
+#include "network/peer_communication_service.hpp"
+#include "simulator/verified_proposal_creator.hpp"
+#include "torii/processor/transaction_processor.hpp"
+
+namespace iroha {
+  namespace torii {
+
+    /**
+     * Collects lifecycle of transactions from stateless validation, proposals,
+     * stateful validation and commits, and publishes every transition
+     * Statuses only advance, so a transaction rejected by stateful
+     * validation of one proposal stays rejected
+     * Statuses of the latest transactions are kept for late subscribers
+     */
+    class TransactionStatusTracker {
+     public:
+      /**
+       * Stages of transaction lifecycle in their order, values match
+       * protocol::TxStatus
+       */
+      enum class Status {
+        NotReceived,
+        StatelessRejected,
+        StatelessAccepted,
+        Proposed,
+        StatefulValid,
+        StatefulRejected,
+        Committed
+      };
+
+      /**
+       * Transition of transaction with given hash
+       */
+      struct Update {
+        std::string hash;
+        Status status;
+      };
+
+      /**
+       * Default number of transactions whose statuses are kept
+       */
+      static constexpr size_t kDefaultCapacity = 100000;
+
+      /**
+       * @param processor - source of stateless validation results
+       * @param pcs - source of proposals and commits
+       * @param verified_proposals - source of stateful validation results
+       * @param capacity - number of transactions whose statuses are kept
+       */
+      TransactionStatusTracker(
+          std::shared_ptr<TransactionProcessor> processor,
+          std::shared_ptr<network::PeerCommunicationService> pcs,
+          std::shared_ptr<simulator::VerifiedProposalCreator>
+              verified_proposals,
+          size_t capacity = kDefaultCapacity);
+
+      /**
+       * @return true if status is not followed by other ones
+       */
+      static bool isFinal(Status status);
+
+      /**
+       * @param hash - transaction hash in binary form
+       * @return the latest known status of transaction
+       */
+      Status status(const std::string &hash) const;
+
+      /**
+       * @return observable of transitions of all transactions
+       */
+      rxcpp::observable<Update> updates();
+
+     private:
+      /**
+       * Advance status of transaction and publish transition
+       * Must be called under lock
+       */
+      void advance(const std::string &hash, Status status);
+
+      std::string hashOf(const model::Transaction &transaction);
+
+      const size_t capacity_;
+      model::HashProviderImpl hash_provider_;
+      std::unordered_map<std::string, Status> statuses_;
+      std::deque<std::string> order_;
+      // transactions of the latest proposal awaiting stateful validation
+      std::unordered_set<std::string> proposed_;
+      rxcpp::subjects::subject<Update> updates_;
+      mutable std::mutex mutex_;
+    };
+  }  // namespace torii
+}  // namespace iroha
+
+#endif  // IROHA_TRANSACTION_STATUS_TRACKER_HPP
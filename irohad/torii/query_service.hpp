@@ -20,45 +20,207 @@ limitations under the License.
 #include <endpoint.grpc.pb.h>
 #include <endpoint.pb.h>
 #include <responses.pb.h>
-#include <unordered_map>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <thread>
+#include "ametsuchi/block_query.hpp"
 #include "model/converters/pb_query_factory.hpp"
 #include "model/converters/pb_query_response_factory.hpp"
+#include "model/converters/pb_transaction_factory.hpp"
 #include "torii/processor/query_processor.hpp"
+#include "torii/sharded_map.hpp"
+#include "torii/worker_pool.hpp"
 
 namespace torii {
   /**
    * Actual implementation of async QueryService.
    * ToriiServiceHandler::(SomeMethod)Handler calls a corresponding method in
    * this class.
+   * Methods are called concurrently from threads of all completion queues.
+   * Async queries are executed by own workers, so slow queries do not hold
+   * completion queue threads.
+   * Query with min height or transaction to read after waits for the
+   * commit without holding a worker, and is executed at its deadline
+   * if the commit has not come.
    */
   class QueryService {
    public:
+    /**
+     * Default number of threads executing async queries
+     */
+    static constexpr size_t kDefaultWorkers = 4;
+
     QueryService(
         std::shared_ptr<iroha::model::converters::PbQueryFactory>
             pb_query_factory,
         std::shared_ptr<iroha::model::converters::PbQueryResponseFactory>
             pb_query_response_factory,
-        std::shared_ptr<iroha::torii::QueryProcessor> query_processor);
+        std::shared_ptr<iroha::torii::QueryProcessor> query_processor,
+        std::shared_ptr<iroha::ametsuchi::BlockQuery> block_query,
+        size_t workers = kDefaultWorkers);
 
     QueryService(const QueryService &) = delete;
     QueryService &operator=(const QueryService &) = delete;
 
+    /**
+     * Queries waiting for commit are executed before workers stop
+     */
+    ~QueryService();
+
     /**
      * actual implementation of async Find in QueryService
+     * Query is executed on worker thread, request and response must live
+     * until done is called
      * @param request - Query
      * @param response - QueryResponse
+     * @param done - called on worker thread when response is ready
      */
     void FindAsync(iroha::protocol::Query const &request,
-                   iroha::protocol::QueryResponse &response);
+                   iroha::protocol::QueryResponse &response,
+                   std::function<void()> done);
+
+    /**
+     * Execute query and send its response in parts, transactions are
+     * serialized as they are read
+     * @param request - Query
+     * @param write - sends one response, returns false if stream is closed
+     */
+    void FindStream(
+        iroha::protocol::Query const &request,
+        std::function<bool(const iroha::protocol::QueryResponse &)> write);
+
+    /**
+     * Send paginated history of query from its cursor on, then
+     * transactions of every committed block, until the client has gone.
+     * Pages are read one at a time and written synchronously, so a slow
+     * client holds back its own subscription only. Each response carries
+     * the cursor after its last transaction, to resume the subscription.
+     * @param request - GetAccountTransactions, GetAccountAssetTransactions
+     * or GetAssetTransfers up to the top block, with page size
+     * @param write - sends one response, returns false if stream is closed
+     * @param cancelled - returns true if client has gone
+     */
+    void Subscribe(
+        iroha::protocol::Query const &request,
+        std::function<bool(const iroha::protocol::QueryResponse &)> write,
+        std::function<bool()> cancelled);
+
+    /**
+     * Wake up subscriptions waiting for block
+     * @param height - height of committed block
+     */
+    void committed(uint64_t height);
+
+    /**
+     * Period of checking cancellation of waiting subscription
+     */
+    static constexpr std::chrono::milliseconds kSubscriberPoll{1000};
+
+    /**
+     * Wait for commit of query which sets no wait_ms
+     */
+    static constexpr std::chrono::milliseconds kDefaultReadWait{5000};
+
+    /**
+     * Longest wait for commit, so waiting queries do not pile up
+     */
+    static constexpr std::chrono::milliseconds kMaxReadWait{30000};
+
+    /**
+     * @return size and expiration metrics of handler map in Prometheus text
+     * format
+     */
+    std::string metrics() const;
+
+    /**
+     * @return approximate memory of pending handlers
+     */
+    size_t memoryUsage() const;
+
+    /**
+     * Drop the oldest pending handlers under memory pressure
+     * @param bytes - approximate memory to release
+     * @return approximate memory released
+     */
+    size_t releaseMemory(size_t bytes);
 
    private:
+    using Handler =
+        std::function<void(std::shared_ptr<iroha::model::QueryResponse>)>;
+
+    /**
+     * Query waiting for the ledger to reach its min height and contain
+     * its transaction
+     */
+    struct ReadAfter {
+      uint64_t min_height;
+      nonstd::optional<iroha::hash256_t> tx_hash;
+      std::chrono::steady_clock::time_point deadline;
+      // called on waiter thread once ready, must not block
+      std::function<void()> ready;
+      // committed height at the last check, transaction is looked up
+      // again only after the next commit
+      nonstd::optional<uint64_t> checked;
+    };
+
+    /**
+     * Call ready once ledger satisfies read-after parameters of query, on
+     * waiter thread; at once on calling thread if query sets none
+     */
+    void readAfter(iroha::protocol::Query const &request,
+                   std::function<void()> ready);
+
+    /**
+     * Block until ledger satisfies read-after parameters of query
+     */
+    void awaitReadAfter(iroha::protocol::Query const &request);
+
+    /**
+     * Body of waiter thread, checks waiting queries on every commit and
+     * deadline
+     */
+    void waitCommits();
+
+    /**
+     * Send query to processor, response is passed to handler
+     * @return false if query can not be deserialized
+     */
+    bool process(iroha::protocol::Query const &request, Handler handler);
+
+    /**
+     * Write transactions response page by page, other responses at once
+     * @return false if stream is closed
+     */
+    bool stream(
+        std::shared_ptr<iroha::model::QueryResponse> response,
+        const std::function<bool(const iroha::protocol::QueryResponse &)>
+            &write);
+
     std::shared_ptr<iroha::model::converters::PbQueryFactory> pb_query_factory_;
     std::shared_ptr<iroha::model::converters::PbQueryResponseFactory>
         pb_query_response_factory_;
     std::shared_ptr<iroha::torii::QueryProcessor> query_processor_;
+    std::shared_ptr<iroha::ametsuchi::BlockQuery> block_query_;
+
+    // handlers of queries being processed, by query hash
+    ShardedMap<iroha::hash256_t, Handler> handler_map_;
+
+    std::mutex committed_mutex_;
+    std::condition_variable committed_cv_;
+    uint64_t committed_height_ = 0;
+    // queries waiting for commit, guarded by committed_mutex_
+    std::list<ReadAfter> waiting_;
+    bool stopped_ = false;
 
-    std::unordered_map<std::string, iroha::protocol::QueryResponse &>
-        handler_map_;
+    // destroyed before other members, so queued queries finish while
+    // service is alive
+    WorkerPool workers_;
+    // started after workers, posts ready queries to them, joined by
+    // destructor
+    std::thread waiter_;
   };
 
 }  // namespace torii
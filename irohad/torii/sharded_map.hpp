@@ -0,0 +1,249 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TORII_SHARDED_MAP_HPP
+#define TORII_SHARDED_MAP_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <nonstd/optional.hpp>
+#include <string>
+#include <unordered_map>
+
+namespace torii {
+
+  /**
+   * Hash map split into independently locked shards, so that handlers of
+   * different rpcs, running on different completion queue threads, rarely
+   * contend for the same lock
+   * Entries expire after given time, and the oldest entries of a full shard
+   * are evicted, so values which are never taken do not accumulate
+   * @tparam Key - type of key
+   * @tparam Value - type of stored value
+   */
+  template <typename Key, typename Value, size_t Shards = 16>
+  class ShardedMap {
+   public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Default max number of entries
+     */
+    static constexpr size_t kDefaultCapacity = 100000;
+
+    /**
+     * Default lifetime of entry
+     */
+    static constexpr std::chrono::milliseconds kDefaultTtl{60000};
+
+    /**
+     * @param capacity - max number of entries, divided between shards
+     * @param ttl - time after which entry is removed
+     */
+    explicit ShardedMap(size_t capacity = kDefaultCapacity,
+                        Clock::duration ttl = kDefaultTtl)
+        : shard_capacity_(std::max<size_t>(capacity / Shards, 1)),
+          ttl_(ttl) {}
+
+    /**
+     * Insert value if key is not present
+     * @return false if key is already present
+     */
+    bool insert(const Key &key, Value value) {
+      auto &shard = shardOf(key);
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      auto now = Clock::now();
+      expire(shard, now);
+      auto seq = ++shard.seq;
+      if (not shard.entries.emplace(key, Entry{std::move(value), seq})
+                  .second) {
+        return false;
+      }
+      shard.order.push_back({key, seq, now + ttl_});
+      // insertions of taken entries are dropped too, so order stays bounded
+      while (shard.entries.size() > shard_capacity_
+             or shard.order.size() > 2 * shard_capacity_) {
+        if (removeOldest(shard)) {
+          ++evicted_;
+        }
+      }
+      return true;
+    }
+
+    /**
+     * Remove value of key
+     * @return removed value if key was present
+     */
+    nonstd::optional<Value> take(const Key &key) {
+      auto &shard = shardOf(key);
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      auto it = shard.entries.find(key);
+      if (it == shard.entries.end()) {
+        return nonstd::nullopt;
+      }
+      auto value = std::move(it->second.value);
+      shard.entries.erase(it);
+      return value;
+    }
+
+    /**
+     * @return number of entries
+     */
+    size_t size() const {
+      size_t size = 0;
+      for (auto &shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        size += shard.entries.size();
+      }
+      return size;
+    }
+
+    /**
+     * Approximate memory of one entry with its insertion record and
+     * hash node, memory owned by the value is not included
+     */
+    static constexpr size_t kEntryBytes = 2 * sizeof(Key) + sizeof(Value)
+        + 2 * sizeof(uint64_t) + sizeof(Clock::time_point)
+        + 4 * sizeof(void *);
+
+    /**
+     * @return approximate memory of entries
+     */
+    size_t memoryUsage() const { return size() * kEntryBytes; }
+
+    /**
+     * Evict the oldest entries of every shard, e.g. under memory pressure
+     * @param bytes - approximate memory to release
+     * @return approximate memory of evicted entries
+     */
+    size_t release(size_t bytes) {
+      auto count = (bytes + kEntryBytes - 1) / kEntryBytes;
+      // evenly from all shards, so each shard holds its lock briefly
+      auto per_shard = (count + Shards - 1) / Shards;
+      size_t evicted = 0;
+      for (auto &shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        size_t shard_evicted = 0;
+        while (shard_evicted < per_shard and not shard.order.empty()) {
+          if (removeOldest(shard)) {
+            ++shard_evicted;
+          }
+        }
+        evicted += shard_evicted;
+      }
+      evicted_ += evicted;
+      return evicted * kEntryBytes;
+    }
+
+    /**
+     * @return number of entries removed after their lifetime
+     */
+    uint64_t expired() const { return expired_; }
+
+    /**
+     * @return number of entries removed from full shards
+     */
+    uint64_t evicted() const { return evicted_; }
+
+    /**
+     * @param name - prefix of metric names
+     * @return size and removal counters in Prometheus text format
+     */
+    std::string report(const std::string &name) const {
+      return "# TYPE " + name + "_size gauge\n" + name + "_size "
+          + std::to_string(size()) + "\n# TYPE " + name
+          + "_expired_total counter\n" + name + "_expired_total "
+          + std::to_string(expired()) + "\n# TYPE " + name
+          + "_evicted_total counter\n" + name + "_evicted_total "
+          + std::to_string(evicted()) + "\n";
+    }
+
+   private:
+    struct Entry {
+      Value value;
+      uint64_t seq;
+    };
+
+    struct Insertion {
+      Key key;
+      uint64_t seq;
+      Clock::time_point expires;
+    };
+
+    struct Shard {
+      mutable std::mutex mutex;
+      std::unordered_map<Key, Entry> entries;
+      // insertions in order, entries taken since then are skipped
+      std::deque<Insertion> order;
+      uint64_t seq = 0;
+    };
+
+    /**
+     * Remove the oldest insertion, must be called under shard lock
+     * @return true if its entry was still present
+     */
+    static bool removeOldest(Shard &shard) {
+      const auto &oldest = shard.order.front();
+      auto it = shard.entries.find(oldest.key);
+      auto present = it != shard.entries.end() and it->second.seq == oldest.seq;
+      if (present) {
+        shard.entries.erase(it);
+      }
+      shard.order.pop_front();
+      return present;
+    }
+
+    /**
+     * Remove expired entries, must be called under shard lock
+     */
+    void expire(Shard &shard, Clock::time_point now) {
+      while (not shard.order.empty() and shard.order.front().expires <= now) {
+        if (removeOldest(shard)) {
+          ++expired_;
+        }
+      }
+    }
+
+    Shard &shardOf(const Key &key) {
+      return shards_[std::hash<Key>()(key) % Shards];
+    }
+
+    const size_t shard_capacity_;
+    const Clock::duration ttl_;
+    std::array<Shard, Shards> shards_;
+    std::atomic<uint64_t> expired_{0};
+    std::atomic<uint64_t> evicted_{0};
+  };
+
+  template <typename Key, typename Value, size_t Shards>
+  constexpr size_t ShardedMap<Key, Value, Shards>::kDefaultCapacity;
+
+  template <typename Key, typename Value, size_t Shards>
+  constexpr size_t ShardedMap<Key, Value, Shards>::kEntryBytes;
+
+  template <typename Key, typename Value, size_t Shards>
+  constexpr std::chrono::milliseconds
+      ShardedMap<Key, Value, Shards>::kDefaultTtl;
+
+}  // namespace torii
+
+#endif  // TORII_SHARDED_MAP_HPP
@@ -17,6 +17,7 @@ limitations under the License.
 #include <endpoint.grpc.pb.h>
 #include <grpc/support/time.h>
 #include <unistd.h>
+#include <algorithm>
 #include <network/grpc_async_service.hpp>
 #include <network/grpc_call.hpp>
 #include <torii/command_service.hpp>
@@ -27,38 +28,151 @@ namespace prot = iroha::protocol;
 
 namespace torii {
 
+  ::grpc::Status QueryAsyncService::FindStream(
+      ::grpc::ServerContext* context,
+      const prot::Query* request,
+      ::grpc::ServerWriter<prot::QueryResponse>* writer) {
+    auto query_service = query_service_.load();
+    if (not query_service) {
+      return ::grpc::Status(::grpc::StatusCode::UNAVAILABLE,
+                            "query service is not started");
+    }
+    query_service->FindStream(
+        *request, [context, writer](const prot::QueryResponse& response) {
+          return not context->IsCancelled() and writer->Write(response);
+        });
+    return ::grpc::Status::OK;
+  }
+
+  ::grpc::Status QueryAsyncService::Subscribe(
+      ::grpc::ServerContext* context,
+      const prot::Query* request,
+      ::grpc::ServerWriter<prot::QueryResponse>* writer) {
+    auto query_service = query_service_.load();
+    if (not query_service) {
+      return ::grpc::Status(::grpc::StatusCode::UNAVAILABLE,
+                            "query service is not started");
+    }
+    query_service->Subscribe(
+        *request,
+        [context, writer](const prot::QueryResponse& response) {
+          return not context->IsCancelled() and writer->Write(response);
+        },
+        [context] { return context->IsCancelled(); });
+    return ::grpc::Status::OK;
+  }
+
+  void QueryAsyncService::assignQueryService(
+      torii::QueryService* query_service) {
+    query_service_ = query_service;
+  }
+
+  ::grpc::Status CommandAsyncService::StatusStream(
+      ::grpc::ServerContext* context,
+      const prot::TxStatusRequest* request,
+      ::grpc::ServerWriter<prot::TxStatusResponse>* writer) {
+    auto command_service = command_service_.load();
+    if (not command_service
+        or not command_service->StatusStream(
+               *request,
+               [writer](const prot::TxStatusResponse& response) {
+                 return writer->Write(response);
+               },
+               [context] { return context->IsCancelled(); })) {
+      return ::grpc::Status(::grpc::StatusCode::UNAVAILABLE,
+                            "transaction statuses are not tracked");
+    }
+    return ::grpc::Status::OK;
+  }
+
+  void CommandAsyncService::assignCommandService(
+      torii::CommandService* command_service) {
+    command_service_ = command_service;
+  }
+
   /**
    * registers async command service
    * @param builder
    */
-  ToriiServiceHandler::ToriiServiceHandler(::grpc::ServerBuilder& builder) {
+  ToriiServiceHandler::ToriiServiceHandler(::grpc::ServerBuilder& builder,
+                                           size_t queues) {
     builder.RegisterService(&commandAsyncService_);
     builder.RegisterService(&queryAsyncService_);
-    completionQueue_ = builder.AddCompletionQueue();
+    for (size_t i = 0; i < std::max<size_t>(queues, 1); ++i) {
+      completionQueues_.push_back(builder.AddCompletionQueue());
+    }
   }
 
   ToriiServiceHandler::~ToriiServiceHandler() {}
 
   /**
-   * shuts down service handler. (actually, shuts down completion queue only)
+   * shuts down service handler. (actually, shuts down completion queues
+   * only)
    */
-  void ToriiServiceHandler::shutdown() { completionQueue_->Shutdown(); }
+  void ToriiServiceHandler::shutdown() {
+    std::unique_lock<std::mutex> lock(mtx_);
+    if (isShutdown_) {
+      return;
+    }
+    // no rpcs are requested since then
+    isShutdown_ = true;
+    // responses are sent to the queues, so they must be alive meanwhile
+    stateChanged_.wait(lock, [this] { return asyncResponses_ == 0; });
+    for (auto& completionQueue : completionQueues_) {
+      completionQueue->Shutdown();
+    }
+    stateChanged_.wait(lock, [this] { return isShutdownCompletionQueue(); });
+  }
+
+  void ToriiServiceHandler::beginAsyncResponse() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    ++asyncResponses_;
+  }
+
+  void ToriiServiceHandler::endAsyncResponse() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (--asyncResponses_ == 0) {
+      stateChanged_.notify_all();
+    }
+  }
 
   /**
    * handles rpcs loop in CommandService.
    */
   void ToriiServiceHandler::handleRpcs() {
+    std::vector<std::thread> pollers;
+    for (size_t i = 1; i < completionQueues_.size(); ++i) {
+      pollers.emplace_back(&ToriiServiceHandler::pollQueue,
+                           this,
+                           completionQueues_[i].get());
+    }
+    pollQueue(completionQueues_.front().get());
+    for (auto& poller : pollers) {
+      poller.join();
+    }
+  }
+
+  void ToriiServiceHandler::pollQueue(
+      ::grpc::ServerCompletionQueue* completionQueue) {
     // CommandService::Torii()
-    enqueueRequest<prot::CommandService::AsyncService, prot::Transaction,
+    enqueueRequest<CommandAsyncService, prot::Transaction,
                    prot::ToriiResponse>(
-        &prot::CommandService::AsyncService::RequestTorii,
-        &ToriiServiceHandler::ToriiHandler, commandAsyncService_);
+        &CommandAsyncService::RequestTorii,
+        &ToriiServiceHandler::ToriiHandler, commandAsyncService_,
+        completionQueue);
+
+    // CommandService::ListTorii()
+    enqueueRequest<CommandAsyncService, prot::TxList,
+                   prot::ToriiResponseList>(
+        &CommandAsyncService::RequestListTorii,
+        &ToriiServiceHandler::ListToriiHandler, commandAsyncService_,
+        completionQueue);
 
     // QueryService::Find()
-    enqueueRequest<prot::QueryService::AsyncService, prot::Query,
-                   prot::QueryResponse>(
-        &prot::QueryService::AsyncService::RequestFind,
-        &ToriiServiceHandler::QueryFindHandler, queryAsyncService_);
+    enqueueRequest<QueryAsyncService, prot::Query, prot::QueryResponse>(
+        &QueryAsyncService::RequestFind,
+        &ToriiServiceHandler::QueryFindHandler, queryAsyncService_,
+        completionQueue);
 
     /**
      * tag is a state corresponding to one rpc connection.
@@ -72,20 +186,28 @@ namespace torii {
      * pulls a state of a new client's rpc request from completion queue.
      * If no request, CompletionQueue::Next() waits a new request (blocks this
      * thread). CompletionQueue::Next() returns false if
-     * completionQueue_->Shutdown() is executed.
+     * completionQueue->Shutdown() is executed.
      */
-    while (completionQueue_->Next(&tag, &ok)) {
+    while (completionQueue->Next(&tag, &ok)) {
       auto callbackTag =
           static_cast<network::UntypedCall<ToriiServiceHandler>::CallOwner*>(
               tag);
-      if (ok && callbackTag) {
-        /*assert(callbackTag);*/
+      if (not callbackTag) {
+        break;
+      }
+      // requests cancelled by server shutdown come here, the queue is
+      // drained until it is shut down
+      if (ok) {
         callbackTag->onCompleted(this);
       } else {
-        isShutdownCompletionQueue_ = true;
-        break;
+        callbackTag->onFailed();
       }
     }
+    {
+      std::lock_guard<std::mutex> lock(mtx_);
+      ++drainedQueues_;
+    }
+    stateChanged_.notify_all();
   }
 
   /**
@@ -95,35 +217,80 @@ namespace torii {
    */
   void ToriiServiceHandler::ToriiHandler(
       CommandServiceCall<prot::Transaction, prot::ToriiResponse>* call) {
-    command_service_->ToriiAsync(call->request(), call->response());
-    call->sendResponse(grpc::Status::OK);
+    if (not command_service_) {
+      // observer nodes serve queries only
+      call->sendResponse(grpc::Status(grpc::StatusCode::UNIMPLEMENTED,
+                                      "transactions are not accepted"));
+    } else {
+      // trace context of client is accepted in grpc metadata as well
+      const auto &metadata = call->context().client_metadata();
+      auto traceparent = metadata.find("traceparent");
+      if (traceparent != metadata.end()
+          and call->request().trace_parent().empty()) {
+        call->request().set_trace_parent(std::string(
+            traceparent->second.data(), traceparent->second.size()));
+      }
+      // response is sent once transaction passes validation stage
+      beginAsyncResponse();
+      command_service_->ToriiAsync(
+          call->request(), call->response(), [this, call] {
+            call->sendResponse(grpc::Status::OK);
+            endAsyncResponse();
+          });
+    }
 
     // Spawn a new Call instance to serve an another client.
-    enqueueRequest<prot::CommandService::AsyncService, prot::Transaction,
+    enqueueRequest<CommandAsyncService, prot::Transaction,
                    prot::ToriiResponse>(
-        &prot::CommandService::AsyncService::RequestTorii,
-        &ToriiServiceHandler::ToriiHandler, commandAsyncService_);
+        &CommandAsyncService::RequestTorii,
+        &ToriiServiceHandler::ToriiHandler, commandAsyncService_,
+        call->completionQueue());
+  }
+
+  void ToriiServiceHandler::ListToriiHandler(
+      CommandServiceCall<prot::TxList, prot::ToriiResponseList>* call) {
+    if (not command_service_) {
+      call->sendResponse(grpc::Status(grpc::StatusCode::UNIMPLEMENTED,
+                                      "transactions are not accepted"));
+    } else {
+      command_service_->ListToriiAsync(call->request(), call->response());
+      call->sendResponse(grpc::Status::OK);
+    }
+
+    // Spawn a new Call instance to serve an another client.
+    enqueueRequest<CommandAsyncService, prot::TxList,
+                   prot::ToriiResponseList>(
+        &CommandAsyncService::RequestListTorii,
+        &ToriiServiceHandler::ListToriiHandler, commandAsyncService_,
+        call->completionQueue());
   }
 
   void ToriiServiceHandler::QueryFindHandler(
       QueryServiceCall<iroha::protocol::Query, iroha::protocol::QueryResponse>*
           call) {
-    query_service_->FindAsync(call->request(), call->response());
-    call->sendResponse(grpc::Status::OK);
+    // response is sent from query worker once the query is executed
+    beginAsyncResponse();
+    query_service_->FindAsync(
+        call->request(), call->response(), [this, call] {
+          call->sendResponse(grpc::Status::OK);
+          endAsyncResponse();
+        });
 
     // Spawn a new Call instance to serve an another client.
-    enqueueRequest<prot::QueryService::AsyncService, prot::Query,
-                   prot::QueryResponse>(
-        &prot::QueryService::AsyncService::RequestFind,
-        &ToriiServiceHandler::QueryFindHandler, queryAsyncService_);
+    enqueueRequest<QueryAsyncService, prot::Query, prot::QueryResponse>(
+        &QueryAsyncService::RequestFind,
+        &ToriiServiceHandler::QueryFindHandler, queryAsyncService_,
+        call->completionQueue());
   }
   void ToriiServiceHandler::assignCommandHandler(
       std::unique_ptr<torii::CommandService> command_service) {
     command_service_ = std::move(command_service);
+    commandAsyncService_.assignCommandService(command_service_.get());
   }
   void ToriiServiceHandler::assignQueryHandler(
       std::unique_ptr<torii::QueryService> query_service) {
     query_service_ = std::move(query_service);
+    queryAsyncService_.assignQueryService(query_service_.get());
   }
 
 }  // namespace torii
@@ -19,22 +19,82 @@ limitations under the License.
 
 #include <endpoint.grpc.pb.h>
 #include <endpoint.pb.h>
+#include <atomic>
+#include <condition_variable>
+#include <thread>
+#include <vector>
 #include <network/grpc_async_service.hpp>
 #include <network/grpc_call.hpp>
 #include "torii/command_service.hpp"
 #include "torii/query_service.hpp"
 
 namespace torii {
+  /**
+   * QueryService with async Find and synchronous FindStream and Subscribe.
+   * Streams are written from grpc threads, so they do not hold the
+   * completion queue.
+   */
+  class QueryAsyncService
+      : public iroha::protocol::QueryService::WithAsyncMethod_Find<
+            iroha::protocol::QueryService::Service> {
+   public:
+    ::grpc::Status FindStream(
+        ::grpc::ServerContext* context,
+        const iroha::protocol::Query* request,
+        ::grpc::ServerWriter<iroha::protocol::QueryResponse>* writer) override;
+
+    ::grpc::Status Subscribe(
+        ::grpc::ServerContext* context,
+        const iroha::protocol::Query* request,
+        ::grpc::ServerWriter<iroha::protocol::QueryResponse>* writer) override;
+
+    /**
+     * @param query_service - service executing streamed queries
+     */
+    void assignQueryService(torii::QueryService* query_service);
+
+   private:
+    std::atomic<torii::QueryService*> query_service_{nullptr};
+  };
+
+  /**
+   * CommandService with async Torii, ListTorii and synchronous
+   * StatusStream. Status streams wait for transitions on grpc threads, so
+   * they do not hold the completion queue.
+   */
+  class CommandAsyncService
+      : public iroha::protocol::CommandService::WithAsyncMethod_Torii<
+            iroha::protocol::CommandService::WithAsyncMethod_ListTorii<
+                iroha::protocol::CommandService::Service>> {
+   public:
+    ::grpc::Status StatusStream(
+        ::grpc::ServerContext* context,
+        const iroha::protocol::TxStatusRequest* request,
+        ::grpc::ServerWriter<iroha::protocol::TxStatusResponse>* writer)
+        override;
+
+    /**
+     * @param command_service - service tracking transaction statuses
+     */
+    void assignCommandService(torii::CommandService* command_service);
+
+   private:
+    std::atomic<torii::CommandService*> command_service_{nullptr};
+  };
+
   /**
    * to handle rpcs loop of CommandService and QueryService.
+   * Each completion queue is polled by its own thread, and rpcs are
+   * requested on every queue, so handlers run on all of them in parallel.
    */
   class ToriiServiceHandler : public network::GrpcAsyncService {
    public:
     /**
      * requires builder to use same server.
      * @param builder
+     * @param queues - number of completion queues and polling threads
      */
-    ToriiServiceHandler(::grpc::ServerBuilder& builder);
+    ToriiServiceHandler(::grpc::ServerBuilder& builder, size_t queues = 1);
 
     void assignCommandHandler(
         std::unique_ptr<torii::CommandService> command_service);
@@ -45,40 +105,44 @@ namespace torii {
 
     template <typename RequestType, typename ResponseType>
     using CommandServiceCall =
-        network::Call<ToriiServiceHandler,
-                      iroha::protocol::CommandService::AsyncService,
-                      RequestType, ResponseType>;
+        network::Call<ToriiServiceHandler, CommandAsyncService, RequestType,
+                      ResponseType>;
 
     template <typename RequestType, typename ResponseType>
     using QueryServiceCall =
-        network::Call<ToriiServiceHandler,
-                      iroha::protocol::QueryService::AsyncService, RequestType,
+        network::Call<ToriiServiceHandler, QueryAsyncService, RequestType,
                       ResponseType>;
 
     /**
      * handles rpcs loop in CommandService.
+     * Polls the first queue on calling thread, the rest on spawned threads,
+     * returns when all queues are shut down.
      */
     virtual void handleRpcs() override;
 
     /**
-     * releases the completion queue of CommandService.
+     * releases the completion queues of CommandService.
+     * Waits for responses which are being prepared by workers, then shuts
+     * down the queues and waits until their pollers have drained them.
+     * Repeated calls do nothing.
      * @note Call this method after calling server->Shutdown() in ServerRunner
      */
     virtual void shutdown() override;
 
     /**
-     * @return true if completion queue has been shut down.
+     * @return true if all completion queues have been shut down.
      */
     bool isShutdownCompletionQueue() const {
-      return isShutdownCompletionQueue_;
+      return drainedQueues_ == completionQueues_.size();
     }
 
    private:
     /**
      * helper to call Call::enqueueRequest()
      * @param requester  - pointer to request method. e.g.
-     * &CommandService::AsyncService::RequestTorii
+     * &CommandAsyncService::RequestTorii
      * @param rpcHandler - handler of rpc in ServiceHandler.
+     * @param completionQueue - queue which receives the rpc
      */
     template <typename AsyncService, typename RequestType,
               typename ResponseType>
@@ -88,16 +152,23 @@ namespace torii {
         network::RpcHandler<ToriiServiceHandler, AsyncService, RequestType,
                             ResponseType>
             rpcHandler,
-        AsyncService& asyncService) {
+        AsyncService& asyncService,
+        ::grpc::ServerCompletionQueue* completionQueue) {
       std::unique_lock<std::mutex> lock(mtx_);
       if (!isShutdown_) {
         network::Call<ToriiServiceHandler, AsyncService, RequestType,
                       ResponseType>::enqueueRequest(&asyncService,
-                                                    completionQueue_.get(),
+                                                    completionQueue,
                                                     requester, rpcHandler);
       }
     }
 
+    /**
+     * requests rpcs of all services on the queue and handles them until the
+     * queue is shut down
+     */
+    void pollQueue(::grpc::ServerCompletionQueue* completionQueue);
+
     /**
      * extracts request and response from Call instance
      * and calls an actual CommandService::AsyncTorii() implementation.
@@ -106,16 +177,30 @@ namespace torii {
     void ToriiHandler(CommandServiceCall<iroha::protocol::Transaction,
                                          iroha::protocol::ToriiResponse>*);
 
+    void ListToriiHandler(
+        CommandServiceCall<iroha::protocol::TxList,
+                           iroha::protocol::ToriiResponseList>*);
+
     void QueryFindHandler(QueryServiceCall<iroha::protocol::Query,
                                            iroha::protocol::QueryResponse>*);
 
+    /**
+     * Count response which is sent later from another thread, queues are
+     * not shut down until it is sent
+     */
+    void beginAsyncResponse();
+    void endAsyncResponse();
+
    private:
-    iroha::protocol::CommandService::AsyncService commandAsyncService_;
-    iroha::protocol::QueryService::AsyncService queryAsyncService_;
-    std::unique_ptr<grpc::ServerCompletionQueue> completionQueue_;
+    CommandAsyncService commandAsyncService_;
+    QueryAsyncService queryAsyncService_;
+    std::vector<std::unique_ptr<grpc::ServerCompletionQueue>>
+        completionQueues_;
     std::mutex mtx_;
-    bool isShutdown_ = false;                 // called shutdown()
-    bool isShutdownCompletionQueue_ = false;  // called cq_->Shutdown()
+    std::condition_variable stateChanged_;  // signalled under mtx_
+    bool isShutdown_ = false;               // called shutdown()
+    size_t asyncResponses_ = 0;             // responses not sent yet
+    std::atomic<size_t> drainedQueues_{0};  // queues returned from Next()
 
     std::unique_ptr<torii::CommandService> command_service_;
     std::unique_ptr<torii::QueryService> query_service_;
@@ -0,0 +1,100 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TORII_TX_COUNTER_FILTER_HPP
+#define TORII_TX_COUNTER_FILTER_HPP
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <nonstd/optional.hpp>
+#include <string>
+#include <unordered_map>
+#include "model/block.hpp"
+
+namespace torii {
+
+  /**
+   * Latest committed transaction counters of accounts, to refuse replayed
+   * transactions before they are validated. Counters are loaded from world
+   * state view on first use and raised by committed blocks, so a check
+   * costs one map lookup. Number of accounts is bounded, a full shard is
+   * cleared and its counters are loaded again on demand.
+   * The check is a fast path only: counter loaded while a block commits
+   * may be behind, replays it lets through are rejected by stateful
+   * validation.
+   */
+  class TxCounterFilter {
+   public:
+    /**
+     * Reads counter of account, nullopt if account does not exist
+     */
+    using Load =
+        std::function<nonstd::optional<uint64_t>(const std::string &)>;
+
+    /**
+     * Default max number of tracked accounts
+     */
+    static constexpr size_t kDefaultMaxAccounts = 100000;
+
+    /**
+     * @param load - source of counters of accounts which are not tracked
+     * @param max_accounts - max number of tracked accounts
+     */
+    explicit TxCounterFilter(Load load,
+                             size_t max_accounts = kDefaultMaxAccounts);
+
+    TxCounterFilter(const TxCounterFilter &) = delete;
+    TxCounterFilter &operator=(const TxCounterFilter &) = delete;
+
+    /**
+     * @param account_id - creator of transaction
+     * @param tx_counter - counter of transaction, zero is not checked
+     * @return false if counter is not above the latest committed one
+     */
+    bool fresh(const std::string &account_id, uint64_t tx_counter);
+
+    /**
+     * Raise counters of creators of committed transactions
+     */
+    void committed(const iroha::model::Block &block);
+
+    /**
+     * @return rejection counter in Prometheus text format
+     */
+    std::string report() const;
+
+   private:
+    static constexpr size_t kShards = 16;
+
+    struct Shard {
+      std::mutex mutex;
+      std::unordered_map<std::string, uint64_t> counters;
+    };
+
+    Shard &shardOf(const std::string &account_id);
+
+    const Load load_;
+    const size_t shard_capacity_;
+    std::array<Shard, kShards> shards_;
+    std::atomic<uint64_t> stale_{0};
+  };
+
+}  // namespace torii
+
+#endif  // TORII_TX_COUNTER_FILTER_HPP
@@ -0,0 +1,66 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TORII_WORKER_POOL_HPP
+#define TORII_WORKER_POOL_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace torii {
+
+  /**
+   * Fixed set of threads executing posted tasks in order of posting.
+   * Tasks left in queue on destruction are executed before threads are
+   * joined, so pool must not be destroyed by its own task.
+   */
+  class WorkerPool {
+   public:
+    using Task = std::function<void()>;
+
+    /**
+     * @param workers - number of threads, at least one is started
+     */
+    explicit WorkerPool(size_t workers);
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    /**
+     * Queue task for execution on one of workers
+     */
+    void post(Task task);
+
+    ~WorkerPool();
+
+   private:
+    void run();
+
+    std::deque<Task> tasks_;
+    bool stopped_ = false;
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    std::vector<std::thread> workers_;
+  };
+
+}  // namespace torii
+
+#endif  // TORII_WORKER_POOL_HPP
@@ -16,34 +16,24 @@
  */
 
 #include "validation/impl/chain_validator_impl.hpp"
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <thread>
 
 namespace iroha {
   namespace validation {
 
     ChainValidatorImpl::ChainValidatorImpl(
-        std::shared_ptr<model::ModelCryptoProvider> crypto_provider)
-        : crypto_provider_(crypto_provider) {
+        std::shared_ptr<model::ModelCryptoProvider> crypto_provider,
+        std::shared_ptr<WsvDeltaCache> deltas)
+        : crypto_provider_(crypto_provider), deltas_(std::move(deltas)) {
       log_ = logger::log("ChainValidator");
     }
 
     bool ChainValidatorImpl::validateBlock(const model::Block& block,
                                            ametsuchi::MutableStorage& storage) {
       log_->info("validate block");
-      auto apply_block = [](const auto& current_block, auto& executor,
-                            auto& query, const auto& top_hash) {
-        if (current_block.prev_hash != top_hash) {
-          return false;
-        }
-        for (const auto& tx : current_block.transactions) {
-          for (const auto& command : tx.commands) {
-            if (not command->execute(query, executor)) {
-              return false;
-            }
-          }
-        }
-        return true;
-      };
-
       return
           // Check if block has supermajority
           checkSupermajority(storage, block.sigs.size()) &&
@@ -51,18 +41,107 @@ namespace iroha {
           // TODO: use stateful validation here ?
           crypto_provider_->verify(block) &&
           // Apply to temporary storage
-          storage.apply(block, apply_block);
+          applyBlock(block, storage);
     }
 
     bool ChainValidatorImpl::validateChain(Commit blocks,
                                            ametsuchi::MutableStorage& storage) {
       log_->info("validate chain...");
-      return blocks
-          .all([this, &storage](auto block) {
-            return this->validateBlock(block, storage);
-          })
-          .as_blocking()
-          .first();
+      std::vector<std::shared_ptr<const model::Block>> chain;
+      blocks.as_blocking().subscribe(
+          [&chain](auto block) { chain.push_back(std::move(block)); });
+
+      // signatures do not depend on state, so they are verified by
+      // several threads ahead of blocks being applied in order
+      std::vector<std::promise<bool>> verified(chain.size());
+      std::atomic<size_t> next{0};
+      std::atomic<bool> stop{false};
+      std::vector<std::thread> threads;
+      auto workers = chain.size() < 2
+          ? 0
+          : std::min<size_t>(chain.size(),
+                             std::max(1u, std::thread::hardware_concurrency()));
+      for (size_t worker = 0; worker < workers; ++worker) {
+        threads.emplace_back([&] {
+          for (auto i = next++; i < chain.size() and not stop; i = next++) {
+            verified[i].set_value(crypto_provider_->verify(*chain[i]));
+          }
+        });
+      }
+
+      auto valid = true;
+      for (size_t i = 0; i < chain.size() and valid; ++i) {
+        const auto& block = *chain[i];
+        auto signatures = workers == 0
+            ? crypto_provider_->verify(block)
+            : verified[i].get_future().get();
+        valid = checkSupermajority(storage, block.sigs.size()) and signatures
+            and applyBlock(block, storage);
+      }
+      stop = true;
+      for (auto& thread : threads) {
+        thread.join();
+      }
+      return valid;
+    }
+
+    bool ChainValidatorImpl::validateHeaders(
+        const std::vector<model::Block>& chain) {
+      log_->info("validate headers of {} blocks", chain.size());
+      for (size_t i = 1; i < chain.size(); ++i) {
+        if (chain[i].height != chain[i - 1].height + 1
+            or chain[i].prev_hash != chain[i - 1].hash) {
+          log_->warn("block {} does not follow previous", chain[i].height);
+          return false;
+        }
+      }
+
+      std::atomic<size_t> next{0};
+      std::atomic<bool> valid{true};
+      std::vector<std::thread> threads;
+      auto workers = std::min<size_t>(
+          chain.size(), std::max(1u, std::thread::hardware_concurrency()));
+      for (size_t worker = 0; worker < workers; ++worker) {
+        threads.emplace_back([&] {
+          for (auto i = next++; i < chain.size() and valid; i = next++) {
+            if (not crypto_provider_->verify(chain[i])) {
+              valid = false;
+            }
+          }
+        });
+      }
+      for (auto& thread : threads) {
+        thread.join();
+      }
+      return valid;
+    }
+
+    bool ChainValidatorImpl::applyBlock(const model::Block& block,
+                                        ametsuchi::MutableStorage& storage) {
+      auto apply_block = [this](const auto& current_block, auto& executor,
+                                auto& query, const auto& top_hash) {
+        if (current_block.prev_hash != top_hash) {
+          return false;
+        }
+        if (deltas_) {
+          // block was validated on the same state when this peer created it
+          if (auto delta = deltas_->take(current_block)) {
+            return std::all_of(
+                delta->begin(), delta->end(), [&executor](const auto& write) {
+                  return write(executor);
+                });
+          }
+        }
+        for (const auto& tx : current_block.transactions) {
+          for (const auto& command : tx.commands) {
+            if (not command->execute(query, executor)) {
+              return false;
+            }
+          }
+        }
+        return true;
+      };
+      return storage.apply(block, apply_block);
     }
 
     bool ChainValidatorImpl::checkSupermajority(
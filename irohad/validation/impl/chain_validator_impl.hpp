@@ -19,13 +19,21 @@
 
 #include "model/model_crypto_provider.hpp"
 #include "validation/chain_validator.hpp"
+#include "validation/wsv_delta.hpp"
 #include "logger/logger.hpp"
 
 namespace iroha {
   namespace validation {
     class ChainValidatorImpl : public ChainValidator {
      public:
-      explicit ChainValidatorImpl(std::shared_ptr<model::ModelCryptoProvider> crypto_provider);
+      /**
+       * @param crypto_provider - verifies signatures of blocks
+       * @param deltas - writes of blocks validated by this peer, applied
+       * instead of executing their commands, nullptr to always execute
+       */
+      explicit ChainValidatorImpl(
+          std::shared_ptr<model::ModelCryptoProvider> crypto_provider,
+          std::shared_ptr<WsvDeltaCache> deltas = nullptr);
 
       bool validateChain(Commit blocks,
                          ametsuchi::MutableStorage &storage) override;
@@ -33,13 +41,32 @@ namespace iroha {
       bool validateBlock(const model::Block &block,
                          ametsuchi::MutableStorage &storage) override;
 
+      /**
+       * Check that blocks form a chain and are signed, without executing
+       * their commands or checking signers against peers of the ledger.
+       * Blocks are as trusted as the block their chain leads to, e.g. the
+       * one a signed snapshot of world state view is taken at
+       * @param chain - blocks in order of height, with hashes computed
+       * from their contents
+       * @return true if chain is linked and all signatures are valid
+       */
+      bool validateHeaders(const std::vector<model::Block> &chain);
+
      private:
       // internal
       std::shared_ptr<model::ModelCryptoProvider> crypto_provider_;
+      std::shared_ptr<WsvDeltaCache> deltas_;
 
       bool checkSupermajority(ametsuchi::MutableStorage &storage,
                               uint64_t signs_num);
 
+      /**
+       * Execute commands of block, or apply its delta if this peer has
+       * validated it, on top of storage
+       */
+      bool applyBlock(const model::Block &block,
+                      ametsuchi::MutableStorage &storage);
+
       logger::Logger log_;
 
     };
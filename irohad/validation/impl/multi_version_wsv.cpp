@@ -0,0 +1,250 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "validation/impl/multi_version_wsv.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace iroha {
+  namespace validation {
+
+    namespace {
+      /**
+       * Find the latest entry written before transaction
+       * @return pointer to index of writer and entry, nullptr if none
+       */
+      template <typename Versions>
+      const typename Versions::value_type *latest(const Versions &versions,
+                                                  size_t transaction) {
+        auto it = versions.lower_bound(transaction);
+        if (it == versions.begin()) {
+          return nullptr;
+        }
+        return &*std::prev(it);
+      }
+
+      template <typename Map, typename Key>
+      MultiVersionWsv::Version versionOf(const Map &map,
+                                         const Key &key,
+                                         size_t transaction) {
+        auto versions = map.find(key);
+        if (versions == map.end()) {
+          return MultiVersionWsv::kBase;
+        }
+        auto entry = latest(versions->second, transaction);
+        if (not entry) {
+          return MultiVersionWsv::kBase;
+        }
+        return {entry->first, entry->second.incarnation};
+      }
+    }  // namespace
+
+    const MultiVersionWsv::Version MultiVersionWsv::kBase = {
+        std::numeric_limits<size_t>::max(), 0};
+
+    bool MultiVersionWsv::Version::operator==(const Version &rhs) const {
+      return transaction == rhs.transaction and incarnation == rhs.incarnation;
+    }
+
+    // View
+
+    MultiVersionWsv::View::View(MultiVersionWsv &wsv,
+                                size_t transaction,
+                                ReadSet &reads)
+        : wsv_(wsv), transaction_(transaction), reads_(reads) {}
+
+    nonstd::optional<model::Account> MultiVersionWsv::View::getAccount(
+        const std::string &account_id) {
+      auto versions = wsv_.accounts_.find(account_id);
+      if (versions != wsv_.accounts_.end()) {
+        if (auto entry = latest(versions->second, transaction_)) {
+          reads_.accounts.emplace_back(
+              account_id, Version{entry->first, entry->second.incarnation});
+          return entry->second.value;
+        }
+      }
+      reads_.accounts.emplace_back(account_id, kBase);
+      return wsv_.base_.getAccount(account_id);
+    }
+
+    nonstd::optional<std::vector<ed25519::pubkey_t>>
+    MultiVersionWsv::View::getSignatories(const std::string &account_id) {
+      return wsv_.base_.getSignatories(account_id);
+    }
+
+    nonstd::optional<model::Asset> MultiVersionWsv::View::getAsset(
+        const std::string &asset_id) {
+      return wsv_.base_.getAsset(asset_id);
+    }
+
+    nonstd::optional<model::AccountAsset>
+    MultiVersionWsv::View::getAccountAsset(const std::string &account_id,
+                                           const std::string &asset_id) {
+      AssetKey key{account_id, asset_id};
+      auto versions = wsv_.account_assets_.find(key);
+      if (versions != wsv_.account_assets_.end()) {
+        if (auto entry = latest(versions->second, transaction_)) {
+          reads_.account_assets.emplace_back(
+              key, Version{entry->first, entry->second.incarnation});
+          return entry->second.value;
+        }
+      }
+      reads_.account_assets.emplace_back(key, kBase);
+      return wsv_.base_.getAccountAsset(account_id, asset_id);
+    }
+
+    nonstd::optional<std::vector<model::AccountAsset>>
+    MultiVersionWsv::View::getAccountAssets(const std::string &account_id,
+                                            const std::string &after_asset_id,
+                                            size_t limit) {
+      // ranges are not recorded, overlay over the view marks reading
+      // transaction unsupported
+      return wsv_.base_.getAccountAssets(account_id, after_asset_id, limit);
+    }
+
+    nonstd::optional<std::vector<model::AccountAsset>>
+    MultiVersionWsv::View::getAssetHolders(const std::string &asset_id,
+                                           const std::string &after_account_id,
+                                           size_t limit) {
+      return wsv_.base_.getAssetHolders(asset_id, after_account_id, limit);
+    }
+
+    nonstd::optional<std::vector<model::Account>>
+    MultiVersionWsv::View::getDomainAccounts(
+        const std::string &domain_id,
+        const std::string &after_account_id,
+        size_t limit) {
+      return wsv_.base_.getDomainAccounts(domain_id, after_account_id, limit);
+    }
+
+    nonstd::optional<std::vector<std::string>>
+    MultiVersionWsv::View::getAccountsBySignatory(
+        const ed25519::pubkey_t &signatory,
+        const std::string &after_account_id,
+        size_t limit) {
+      return wsv_.base_.getAccountsBySignatory(signatory,
+                                               after_account_id,
+                                               limit);
+    }
+
+    nonstd::optional<std::vector<model::Peer>>
+    MultiVersionWsv::View::getPeers() {
+      return wsv_.base_.getPeers();
+    }
+
+    // Writer
+
+    MultiVersionWsv::Writer::Writer(MultiVersionWsv &wsv, Version version)
+        : wsv_(wsv), version_(version) {}
+
+    bool MultiVersionWsv::Writer::updateAccount(const model::Account &account) {
+      wsv_.accounts_[account.account_id][version_.transaction] = {
+          version_.incarnation, account};
+      wsv_.written_accounts_[version_.transaction].push_back(
+          account.account_id);
+      return true;
+    }
+
+    bool MultiVersionWsv::Writer::upsertAccountAsset(
+        const model::AccountAsset &asset) {
+      AssetKey key{asset.account_id, asset.asset_id};
+      wsv_.account_assets_[key][version_.transaction] = {version_.incarnation,
+                                                         asset};
+      wsv_.written_account_assets_[version_.transaction].push_back(key);
+      return true;
+    }
+
+    bool MultiVersionWsv::Writer::insertAccount(const model::Account &account) {
+      return false;
+    }
+
+    bool MultiVersionWsv::Writer::insertAsset(const model::Asset &asset) {
+      return false;
+    }
+
+    bool MultiVersionWsv::Writer::insertSignatory(
+        const ed25519::pubkey_t &signatory) {
+      return false;
+    }
+
+    bool MultiVersionWsv::Writer::insertAccountSignatory(
+        const std::string &account_id, const ed25519::pubkey_t &signatory) {
+      return false;
+    }
+
+    bool MultiVersionWsv::Writer::deleteAccountSignatory(
+        const std::string &account_id, const ed25519::pubkey_t &signatory) {
+      return false;
+    }
+
+    bool MultiVersionWsv::Writer::insertPeer(const model::Peer &peer) {
+      return false;
+    }
+
+    bool MultiVersionWsv::Writer::deletePeer(const model::Peer &peer) {
+      return false;
+    }
+
+    bool MultiVersionWsv::Writer::insertDomain(const model::Domain &domain) {
+      return false;
+    }
+
+    // MultiVersionWsv
+
+    MultiVersionWsv::MultiVersionWsv(ametsuchi::WsvQuery &base)
+        : base_(base) {}
+
+    std::mutex &MultiVersionWsv::lock() {
+      return lock_;
+    }
+
+    void MultiVersionWsv::clear(size_t transaction) {
+      auto accounts = written_accounts_.find(transaction);
+      if (accounts != written_accounts_.end()) {
+        for (const auto &account_id : accounts->second) {
+          accounts_[account_id].erase(transaction);
+        }
+        written_accounts_.erase(accounts);
+      }
+      auto assets = written_account_assets_.find(transaction);
+      if (assets != written_account_assets_.end()) {
+        for (const auto &key : assets->second) {
+          account_assets_[key].erase(transaction);
+        }
+        written_account_assets_.erase(assets);
+      }
+    }
+
+    bool MultiVersionWsv::validate(size_t transaction,
+                                   const ReadSet &reads) const {
+      return std::all_of(reads.accounts.begin(),
+                         reads.accounts.end(),
+                         [this, transaction](const auto &read) {
+                           return versionOf(accounts_, read.first, transaction)
+                               == read.second;
+                         })
+          and std::all_of(reads.account_assets.begin(),
+                          reads.account_assets.end(),
+                          [this, transaction](const auto &read) {
+                            return versionOf(
+                                       account_assets_, read.first, transaction)
+                                == read.second;
+                          });
+    }
+
+  }  // namespace validation
+}  // namespace iroha
@@ -0,0 +1,184 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_MULTI_VERSION_WSV_HPP
+#define IROHA_MULTI_VERSION_WSV_HPP
+
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "ametsuchi/wsv_command.hpp"
+#include "ametsuchi/wsv_query.hpp"
+
+namespace iroha {
+  namespace validation {
+
+    /**
+     * Accounts and account assets written by speculatively executed
+     * transactions of proposal, over world state view. Every transaction
+     * sees values written by transactions preceding it in proposal, and
+     * remembers which version of each value it has read, so the read can
+     * be checked once preceding transactions are final.
+     * Store and base are guarded by lock(), all methods expect it held.
+     */
+    class MultiVersionWsv {
+     public:
+      /**
+       * Execution of transaction which has written a value
+       */
+      struct Version {
+        // index of transaction, kBase for value of base wsv
+        size_t transaction;
+        // number of execution of transaction
+        size_t incarnation;
+
+        bool operator==(const Version &rhs) const;
+      };
+
+      static const Version kBase;
+
+      using AssetKey = std::pair<std::string, std::string>;
+
+      /**
+       * Versions of values read by execution of transaction
+       */
+      struct ReadSet {
+        std::vector<std::pair<std::string, Version>> accounts;
+        std::vector<std::pair<AssetKey, Version>> account_assets;
+      };
+
+      /**
+       * State seen by transaction, reads are recorded
+       */
+      class View : public ametsuchi::WsvQuery {
+       public:
+        View(MultiVersionWsv &wsv, size_t transaction, ReadSet &reads);
+
+        nonstd::optional<model::Account> getAccount(
+            const std::string &account_id) override;
+        nonstd::optional<std::vector<ed25519::pubkey_t>> getSignatories(
+            const std::string &account_id) override;
+        nonstd::optional<model::Asset> getAsset(
+            const std::string &asset_id) override;
+        nonstd::optional<model::AccountAsset> getAccountAsset(
+            const std::string &account_id,
+            const std::string &asset_id) override;
+        nonstd::optional<std::vector<model::AccountAsset>> getAccountAssets(
+            const std::string &account_id,
+            const std::string &after_asset_id,
+            size_t limit) override;
+        nonstd::optional<std::vector<model::AccountAsset>> getAssetHolders(
+            const std::string &asset_id,
+            const std::string &after_account_id,
+            size_t limit) override;
+        nonstd::optional<std::vector<model::Account>> getDomainAccounts(
+            const std::string &domain_id,
+            const std::string &after_account_id,
+            size_t limit) override;
+        nonstd::optional<std::vector<std::string>> getAccountsBySignatory(
+            const ed25519::pubkey_t &signatory,
+            const std::string &after_account_id,
+            size_t limit) override;
+        nonstd::optional<std::vector<model::Peer>> getPeers() override;
+
+       private:
+        MultiVersionWsv &wsv_;
+        size_t transaction_;
+        ReadSet &reads_;
+      };
+
+      /**
+       * Publishes writes of transaction execution, only updates of
+       * accounts and account assets are accepted
+       */
+      class Writer : public ametsuchi::WsvCommand {
+       public:
+        Writer(MultiVersionWsv &wsv, Version version);
+
+        bool updateAccount(const model::Account &account) override;
+        bool upsertAccountAsset(const model::AccountAsset &asset) override;
+
+        bool insertAccount(const model::Account &account) override;
+        bool insertAsset(const model::Asset &asset) override;
+        bool insertSignatory(const ed25519::pubkey_t &signatory) override;
+        bool insertAccountSignatory(
+            const std::string &account_id,
+            const ed25519::pubkey_t &signatory) override;
+        bool deleteAccountSignatory(
+            const std::string &account_id,
+            const ed25519::pubkey_t &signatory) override;
+        bool insertPeer(const model::Peer &peer) override;
+        bool deletePeer(const model::Peer &peer) override;
+        bool insertDomain(const model::Domain &domain) override;
+
+       private:
+        MultiVersionWsv &wsv_;
+        Version version_;
+      };
+
+      /**
+       * @param base - world state view which values are not written by
+       * transactions of proposal
+       */
+      explicit MultiVersionWsv(ametsuchi::WsvQuery &base);
+
+      /**
+       * @return lock guarding the store and reads of base
+       */
+      std::mutex &lock();
+
+      /**
+       * Remove values written by previous execution of transaction
+       * @param transaction - index of transaction
+       */
+      void clear(size_t transaction);
+
+      /**
+       * Check that transaction would read the same versions now
+       * @param transaction - index of transaction
+       * @param reads - versions read by its execution
+       * @return true if reads are still valid
+       */
+      bool validate(size_t transaction, const ReadSet &reads) const;
+
+     private:
+      template <typename Value>
+      struct Entry {
+        size_t incarnation;
+        Value value;
+      };
+
+      // entries of value by index of transaction
+      template <typename Value>
+      using Versions = std::map<size_t, Entry<Value>>;
+
+      ametsuchi::WsvQuery &base_;
+      std::mutex lock_;
+
+      std::map<std::string, Versions<model::Account>> accounts_;
+      std::map<AssetKey, Versions<model::AccountAsset>> account_assets_;
+
+      // keys written by transaction, to clear them on re-execution
+      std::map<size_t, std::vector<std::string>> written_accounts_;
+      std::map<size_t, std::vector<AssetKey>> written_account_assets_;
+    };
+
+  }  // namespace validation
+}  // namespace iroha
+
+#endif  // IROHA_MULTI_VERSION_WSV_HPP
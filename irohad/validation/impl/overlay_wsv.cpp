@@ -0,0 +1,223 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "validation/impl/overlay_wsv.hpp"
+
+namespace iroha {
+  namespace validation {
+
+    namespace {
+      template <typename Map, typename Key>
+      auto find(const Map &map, const Key &key)
+          -> nonstd::optional<typename Map::mapped_type> {
+        auto it = map.find(key);
+        if (it == map.end()) {
+          return nonstd::nullopt;
+        }
+        return it->second;
+      }
+
+      /**
+       * Find remembered result or load and remember it
+       */
+      template <typename Map, typename Key, typename Load>
+      auto remember(Map &map, const Key &key, Load load) ->
+          typename Map::mapped_type {
+        auto it = map.find(key);
+        if (it != map.end()) {
+          return it->second;
+        }
+        auto value = load();
+        map.emplace(key, value);
+        return value;
+      }
+    }  // namespace
+
+    OverlayWsv::OverlayWsv(ametsuchi::WsvQuery &base, std::mutex &base_lock)
+        : base_(base), base_lock_(base_lock) {}
+
+    bool OverlayWsv::apply(const model::Transaction &transaction,
+                           const Function &function,
+                           std::vector<Operation> &operations) {
+      auto result = function(transaction, *this, *this) and not unsupported_;
+      if (result) {
+        for (auto &account : pending_accounts_) {
+          accounts_[account.first] = std::move(account.second);
+        }
+        for (auto &asset : pending_account_assets_) {
+          account_assets_[asset.first] = std::move(asset.second);
+        }
+        operations = std::move(pending_operations_);
+      }
+      pending_accounts_.clear();
+      pending_account_assets_.clear();
+      pending_operations_.clear();
+      return result;
+    }
+
+    bool OverlayWsv::unsupported() const {
+      return unsupported_;
+    }
+
+    nonstd::optional<model::Account> OverlayWsv::getAccount(
+        const std::string &account_id) {
+      if (auto account = find(pending_accounts_, account_id)) {
+        return account;
+      }
+      if (auto account = find(accounts_, account_id)) {
+        return account;
+      }
+      return remember(base_accounts_, account_id, [&] {
+        std::lock_guard<std::mutex> lock(base_lock_);
+        return base_.getAccount(account_id);
+      });
+    }
+
+    nonstd::optional<std::vector<ed25519::pubkey_t>>
+    OverlayWsv::getSignatories(const std::string &account_id) {
+      return remember(base_signatories_, account_id, [&] {
+        std::lock_guard<std::mutex> lock(base_lock_);
+        return base_.getSignatories(account_id);
+      });
+    }
+
+    nonstd::optional<model::Asset> OverlayWsv::getAsset(
+        const std::string &asset_id) {
+      return remember(base_assets_, asset_id, [&] {
+        std::lock_guard<std::mutex> lock(base_lock_);
+        return base_.getAsset(asset_id);
+      });
+    }
+
+    nonstd::optional<model::AccountAsset> OverlayWsv::getAccountAsset(
+        const std::string &account_id, const std::string &asset_id) {
+      AssetKey key{account_id, asset_id};
+      if (auto asset = find(pending_account_assets_, key)) {
+        return asset;
+      }
+      if (auto asset = find(account_assets_, key)) {
+        return asset;
+      }
+      return remember(base_account_assets_, key, [&] {
+        std::lock_guard<std::mutex> lock(base_lock_);
+        return base_.getAccountAsset(account_id, asset_id);
+      });
+    }
+
+    nonstd::optional<std::vector<model::AccountAsset>>
+    OverlayWsv::getAccountAssets(const std::string &account_id,
+                                 const std::string &after_asset_id,
+                                 size_t limit) {
+      // range is not remembered, so groups reading it are not independent
+      unsupported_ = true;
+      std::lock_guard<std::mutex> lock(base_lock_);
+      return base_.getAccountAssets(account_id, after_asset_id, limit);
+    }
+
+    nonstd::optional<std::vector<model::AccountAsset>>
+    OverlayWsv::getAssetHolders(const std::string &asset_id,
+                                const std::string &after_account_id,
+                                size_t limit) {
+      // ranges are not remembered, as for assets of account
+      unsupported_ = true;
+      std::lock_guard<std::mutex> lock(base_lock_);
+      return base_.getAssetHolders(asset_id, after_account_id, limit);
+    }
+
+    nonstd::optional<std::vector<model::Account>>
+    OverlayWsv::getDomainAccounts(const std::string &domain_id,
+                                  const std::string &after_account_id,
+                                  size_t limit) {
+      unsupported_ = true;
+      std::lock_guard<std::mutex> lock(base_lock_);
+      return base_.getDomainAccounts(domain_id, after_account_id, limit);
+    }
+
+    nonstd::optional<std::vector<std::string>>
+    OverlayWsv::getAccountsBySignatory(const ed25519::pubkey_t &signatory,
+                                       const std::string &after_account_id,
+                                       size_t limit) {
+      unsupported_ = true;
+      std::lock_guard<std::mutex> lock(base_lock_);
+      return base_.getAccountsBySignatory(signatory, after_account_id, limit);
+    }
+
+    nonstd::optional<std::vector<model::Peer>> OverlayWsv::getPeers() {
+      return remember(base_peers_, true, [&] {
+        std::lock_guard<std::mutex> lock(base_lock_);
+        return base_.getPeers();
+      });
+    }
+
+    bool OverlayWsv::updateAccount(const model::Account &account) {
+      pending_accounts_[account.account_id] = account;
+      pending_operations_.push_back([account](auto &commands) {
+        return commands.updateAccount(account);
+      });
+      return true;
+    }
+
+    bool OverlayWsv::upsertAccountAsset(const model::AccountAsset &asset) {
+      pending_account_assets_[AssetKey{asset.account_id, asset.asset_id}] =
+          asset;
+      pending_operations_.push_back([asset](auto &commands) {
+        return commands.upsertAccountAsset(asset);
+      });
+      return true;
+    }
+
+    bool OverlayWsv::insertAccount(const model::Account &account) {
+      return reject();
+    }
+
+    bool OverlayWsv::insertAsset(const model::Asset &asset) {
+      return reject();
+    }
+
+    bool OverlayWsv::insertSignatory(const ed25519::pubkey_t &signatory) {
+      return reject();
+    }
+
+    bool OverlayWsv::insertAccountSignatory(
+        const std::string &account_id, const ed25519::pubkey_t &signatory) {
+      return reject();
+    }
+
+    bool OverlayWsv::deleteAccountSignatory(
+        const std::string &account_id, const ed25519::pubkey_t &signatory) {
+      return reject();
+    }
+
+    bool OverlayWsv::insertPeer(const model::Peer &peer) {
+      return reject();
+    }
+
+    bool OverlayWsv::deletePeer(const model::Peer &peer) {
+      return reject();
+    }
+
+    bool OverlayWsv::insertDomain(const model::Domain &domain) {
+      return reject();
+    }
+
+    bool OverlayWsv::reject() {
+      unsupported_ = true;
+      return false;
+    }
+
+  }  // namespace validation
+}  // namespace iroha
@@ -0,0 +1,151 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_OVERLAY_WSV_HPP
+#define IROHA_OVERLAY_WSV_HPP
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "ametsuchi/wsv_command.hpp"
+#include "ametsuchi/wsv_query.hpp"
+#include "model/transaction.hpp"
+
+namespace iroha {
+  namespace validation {
+
+    /**
+     * In-memory layer of accounts and account assets over world state
+     * view. Each group of independent transactions is validated on its own
+     * overlay, so groups run in parallel without touching the ledger.
+     * Writes are recorded to be replayed later on the real wsv.
+     * Only writes of updates and point reads are supported, other commands
+     * mark overlay unusable.
+     * Values read from base are remembered, base does not change while
+     * overlay is used, so each key is read from it at most once.
+     */
+    class OverlayWsv : public ametsuchi::WsvQuery,
+                       public ametsuchi::WsvCommand {
+     public:
+      using Operation = std::function<bool(ametsuchi::WsvCommand &)>;
+      using Function =
+          std::function<bool(const model::Transaction &,
+                             ametsuchi::WsvCommand &, ametsuchi::WsvQuery &)>;
+
+      /**
+       * @param base - world state view to read missing values from
+       * @param base_lock - serializes reads of base between overlays
+       */
+      OverlayWsv(ametsuchi::WsvQuery &base, std::mutex &base_lock);
+
+      /**
+       * Apply transaction to overlay, like TemporaryWsv::apply does
+       * @param transaction - transaction to apply
+       * @param function - logic of application
+       * @param operations - filled with writes of transaction on success
+       * @return true if transaction is applied
+       */
+      bool apply(const model::Transaction &transaction,
+                 const Function &function,
+                 std::vector<Operation> &operations);
+
+      /**
+       * @return true if some transaction tried write which overlay can not
+       * hold, results of the overlay are not valid then
+       */
+      bool unsupported() const;
+
+      nonstd::optional<model::Account> getAccount(
+          const std::string &account_id) override;
+      nonstd::optional<std::vector<ed25519::pubkey_t>> getSignatories(
+          const std::string &account_id) override;
+      nonstd::optional<model::Asset> getAsset(
+          const std::string &asset_id) override;
+      nonstd::optional<model::AccountAsset> getAccountAsset(
+          const std::string &account_id, const std::string &asset_id) override;
+      nonstd::optional<std::vector<model::AccountAsset>> getAccountAssets(
+          const std::string &account_id,
+          const std::string &after_asset_id,
+          size_t limit) override;
+      nonstd::optional<std::vector<model::AccountAsset>> getAssetHolders(
+          const std::string &asset_id,
+          const std::string &after_account_id,
+          size_t limit) override;
+      nonstd::optional<std::vector<model::Account>> getDomainAccounts(
+          const std::string &domain_id,
+          const std::string &after_account_id,
+          size_t limit) override;
+      nonstd::optional<std::vector<std::string>> getAccountsBySignatory(
+          const ed25519::pubkey_t &signatory,
+          const std::string &after_account_id,
+          size_t limit) override;
+      nonstd::optional<std::vector<model::Peer>> getPeers() override;
+
+      bool updateAccount(const model::Account &account) override;
+      bool upsertAccountAsset(const model::AccountAsset &asset) override;
+
+      bool insertAccount(const model::Account &account) override;
+      bool insertAsset(const model::Asset &asset) override;
+      bool insertSignatory(const ed25519::pubkey_t &signatory) override;
+      bool insertAccountSignatory(const std::string &account_id,
+                                  const ed25519::pubkey_t &signatory) override;
+      bool deleteAccountSignatory(const std::string &account_id,
+                                  const ed25519::pubkey_t &signatory) override;
+      bool insertPeer(const model::Peer &peer) override;
+      bool deletePeer(const model::Peer &peer) override;
+      bool insertDomain(const model::Domain &domain) override;
+
+     private:
+      using AssetKey = std::pair<std::string, std::string>;
+
+      /**
+       * Mark overlay unusable
+       * @return false, as result of rejected write
+       */
+      bool reject();
+
+      ametsuchi::WsvQuery &base_;
+      std::mutex &base_lock_;
+
+      // values written by applied transactions
+      std::map<std::string, model::Account> accounts_;
+      std::map<AssetKey, model::AccountAsset> account_assets_;
+
+      // values written by transaction being applied
+      std::map<std::string, model::Account> pending_accounts_;
+      std::map<AssetKey, model::AccountAsset> pending_account_assets_;
+      std::vector<Operation> pending_operations_;
+
+      // results of reads from base
+      std::map<std::string, nonstd::optional<model::Account>> base_accounts_;
+      std::map<std::string, nonstd::optional<std::vector<ed25519::pubkey_t>>>
+          base_signatories_;
+      std::map<std::string, nonstd::optional<model::Asset>> base_assets_;
+      std::map<AssetKey, nonstd::optional<model::AccountAsset>>
+          base_account_assets_;
+      // peers are remembered as a single entry
+      std::map<bool, nonstd::optional<std::vector<model::Peer>>> base_peers_;
+
+      bool unsupported_ = false;
+    };
+
+  }  // namespace validation
+}  // namespace iroha
+
+#endif  // IROHA_OVERLAY_WSV_HPP
@@ -0,0 +1,191 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "validation/impl/recording_wsv.hpp"
+#include <iterator>
+
+namespace iroha {
+  namespace validation {
+
+    // Recorder
+
+    RecordingWsv::Recorder::Recorder(ametsuchi::WsvCommand &executor,
+                                     WsvDelta &writes)
+        : executor_(executor), writes_(writes) {}
+
+    template <typename Write>
+    bool RecordingWsv::Recorder::record(Write write) {
+      writes_.emplace_back(write);
+      return write(executor_);
+    }
+
+    bool RecordingWsv::Recorder::insertAccount(const model::Account &account) {
+      return record([account](ametsuchi::WsvCommand &wsv) {
+        return wsv.insertAccount(account);
+      });
+    }
+
+    bool RecordingWsv::Recorder::updateAccount(const model::Account &account) {
+      return record([account](ametsuchi::WsvCommand &wsv) {
+        return wsv.updateAccount(account);
+      });
+    }
+
+    bool RecordingWsv::Recorder::insertAsset(const model::Asset &asset) {
+      return record([asset](ametsuchi::WsvCommand &wsv) {
+        return wsv.insertAsset(asset);
+      });
+    }
+
+    bool RecordingWsv::Recorder::upsertAccountAsset(
+        const model::AccountAsset &asset) {
+      return record([asset](ametsuchi::WsvCommand &wsv) {
+        return wsv.upsertAccountAsset(asset);
+      });
+    }
+
+    bool RecordingWsv::Recorder::upsertAccountAssets(
+        const std::vector<model::AccountAsset> &assets) {
+      return record([assets](ametsuchi::WsvCommand &wsv) {
+        return wsv.upsertAccountAssets(assets);
+      });
+    }
+
+    bool RecordingWsv::Recorder::insertSignatory(
+        const ed25519::pubkey_t &signatory) {
+      return record([signatory](ametsuchi::WsvCommand &wsv) {
+        return wsv.insertSignatory(signatory);
+      });
+    }
+
+    bool RecordingWsv::Recorder::insertAccountSignatory(
+        const std::string &account_id, const ed25519::pubkey_t &signatory) {
+      return record([account_id, signatory](ametsuchi::WsvCommand &wsv) {
+        return wsv.insertAccountSignatory(account_id, signatory);
+      });
+    }
+
+    bool RecordingWsv::Recorder::deleteAccountSignatory(
+        const std::string &account_id, const ed25519::pubkey_t &signatory) {
+      return record([account_id, signatory](ametsuchi::WsvCommand &wsv) {
+        return wsv.deleteAccountSignatory(account_id, signatory);
+      });
+    }
+
+    bool RecordingWsv::Recorder::insertPeer(const model::Peer &peer) {
+      return record(
+          [peer](ametsuchi::WsvCommand &wsv) { return wsv.insertPeer(peer); });
+    }
+
+    bool RecordingWsv::Recorder::deletePeer(const model::Peer &peer) {
+      return record(
+          [peer](ametsuchi::WsvCommand &wsv) { return wsv.deletePeer(peer); });
+    }
+
+    bool RecordingWsv::Recorder::insertDomain(const model::Domain &domain) {
+      return record([domain](ametsuchi::WsvCommand &wsv) {
+        return wsv.insertDomain(domain);
+      });
+    }
+
+    // RecordingWsv
+
+    RecordingWsv::RecordingWsv(std::unique_ptr<ametsuchi::TemporaryWsv> wsv)
+        : wsv_(std::move(wsv)) {}
+
+    bool RecordingWsv::apply(
+        const model::Transaction &transaction,
+        std::function<bool(const model::Transaction &,
+                           ametsuchi::WsvCommand &,
+                           ametsuchi::WsvQuery &)> function) {
+      WsvDelta writes;
+      auto applied = wsv_->apply(
+          transaction,
+          [&function, &writes](
+              const auto &tx, auto &executor, auto &query) {
+            Recorder recorder(executor, writes);
+            return function(tx, recorder, query);
+          });
+      // writes of rejected transaction are rolled back by wsv
+      if (applied) {
+        delta_.insert(delta_.end(),
+                      std::make_move_iterator(writes.begin()),
+                      std::make_move_iterator(writes.end()));
+      }
+      return applied;
+    }
+
+    WsvDelta RecordingWsv::release() {
+      WsvDelta delta;
+      delta.swap(delta_);
+      return delta;
+    }
+
+    nonstd::optional<model::Account> RecordingWsv::getAccount(
+        const std::string &account_id) {
+      return wsv_->getAccount(account_id);
+    }
+
+    nonstd::optional<std::vector<ed25519::pubkey_t>>
+    RecordingWsv::getSignatories(const std::string &account_id) {
+      return wsv_->getSignatories(account_id);
+    }
+
+    nonstd::optional<model::Asset> RecordingWsv::getAsset(
+        const std::string &asset_id) {
+      return wsv_->getAsset(asset_id);
+    }
+
+    nonstd::optional<model::AccountAsset> RecordingWsv::getAccountAsset(
+        const std::string &account_id, const std::string &asset_id) {
+      return wsv_->getAccountAsset(account_id, asset_id);
+    }
+
+    nonstd::optional<std::vector<model::AccountAsset>>
+    RecordingWsv::getAccountAssets(const std::string &account_id,
+                                   const std::string &after_asset_id,
+                                   size_t limit) {
+      return wsv_->getAccountAssets(account_id, after_asset_id, limit);
+    }
+
+    nonstd::optional<std::vector<model::AccountAsset>>
+    RecordingWsv::getAssetHolders(const std::string &asset_id,
+                                  const std::string &after_account_id,
+                                  size_t limit) {
+      return wsv_->getAssetHolders(asset_id, after_account_id, limit);
+    }
+
+    nonstd::optional<std::vector<model::Account>>
+    RecordingWsv::getDomainAccounts(const std::string &domain_id,
+                                    const std::string &after_account_id,
+                                    size_t limit) {
+      return wsv_->getDomainAccounts(domain_id, after_account_id, limit);
+    }
+
+    nonstd::optional<std::vector<std::string>>
+    RecordingWsv::getAccountsBySignatory(const ed25519::pubkey_t &signatory,
+                                         const std::string &after_account_id,
+                                         size_t limit) {
+      return wsv_->getAccountsBySignatory(signatory, after_account_id, limit);
+    }
+
+    nonstd::optional<std::vector<model::Peer>> RecordingWsv::getPeers() {
+      return wsv_->getPeers();
+    }
+
+  }  // namespace validation
+}  // namespace iroha
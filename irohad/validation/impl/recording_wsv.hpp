@@ -0,0 +1,118 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_RECORDING_WSV_HPP
+#define IROHA_RECORDING_WSV_HPP
+
+#include <memory>
+#include "ametsuchi/temporary_wsv.hpp"
+#include "validation/wsv_delta.hpp"
+
+namespace iroha {
+  namespace validation {
+
+    /**
+     * Temporary world state view which records writes of successfully
+     * applied transactions into delta
+     */
+    class RecordingWsv : public ametsuchi::TemporaryWsv {
+     public:
+      /**
+       * @param wsv - temporary wsv to apply transactions to
+       */
+      explicit RecordingWsv(std::unique_ptr<ametsuchi::TemporaryWsv> wsv);
+
+      bool apply(const model::Transaction &transaction,
+                 std::function<bool(const model::Transaction &,
+                                    ametsuchi::WsvCommand &,
+                                    ametsuchi::WsvQuery &)> function) override;
+
+      /**
+       * @return writes recorded so far, recording starts over
+       */
+      WsvDelta release();
+
+      nonstd::optional<model::Account> getAccount(
+          const std::string &account_id) override;
+      nonstd::optional<std::vector<ed25519::pubkey_t>> getSignatories(
+          const std::string &account_id) override;
+      nonstd::optional<model::Asset> getAsset(
+          const std::string &asset_id) override;
+      nonstd::optional<model::AccountAsset> getAccountAsset(
+          const std::string &account_id, const std::string &asset_id) override;
+      nonstd::optional<std::vector<model::AccountAsset>> getAccountAssets(
+          const std::string &account_id,
+          const std::string &after_asset_id,
+          size_t limit) override;
+      nonstd::optional<std::vector<model::AccountAsset>> getAssetHolders(
+          const std::string &asset_id,
+          const std::string &after_account_id,
+          size_t limit) override;
+      nonstd::optional<std::vector<model::Account>> getDomainAccounts(
+          const std::string &domain_id,
+          const std::string &after_account_id,
+          size_t limit) override;
+      nonstd::optional<std::vector<std::string>> getAccountsBySignatory(
+          const ed25519::pubkey_t &signatory,
+          const std::string &after_account_id,
+          size_t limit) override;
+      nonstd::optional<std::vector<model::Peer>> getPeers() override;
+
+     private:
+      /**
+       * Forwards writes to executor of temporary wsv and records them
+       */
+      class Recorder : public ametsuchi::WsvCommand {
+       public:
+        Recorder(ametsuchi::WsvCommand &executor, WsvDelta &writes);
+
+        bool insertAccount(const model::Account &account) override;
+        bool updateAccount(const model::Account &account) override;
+        bool insertAsset(const model::Asset &asset) override;
+        bool upsertAccountAsset(const model::AccountAsset &asset) override;
+        bool upsertAccountAssets(
+            const std::vector<model::AccountAsset> &assets) override;
+        bool insertSignatory(const ed25519::pubkey_t &signatory) override;
+        bool insertAccountSignatory(
+            const std::string &account_id,
+            const ed25519::pubkey_t &signatory) override;
+        bool deleteAccountSignatory(
+            const std::string &account_id,
+            const ed25519::pubkey_t &signatory) override;
+        bool insertPeer(const model::Peer &peer) override;
+        bool deletePeer(const model::Peer &peer) override;
+        bool insertDomain(const model::Domain &domain) override;
+
+       private:
+        /**
+         * Record write and perform it on executor
+         */
+        template <typename Write>
+        bool record(Write write);
+
+        ametsuchi::WsvCommand &executor_;
+        WsvDelta &writes_;
+      };
+
+      std::unique_ptr<ametsuchi::TemporaryWsv> wsv_;
+      WsvDelta delta_;
+    };
+
+  }  // namespace validation
+}  // namespace iroha
+
+#endif  // IROHA_RECORDING_WSV_HPP
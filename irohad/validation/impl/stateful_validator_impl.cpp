@@ -14,67 +14,492 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
-
 #include <algorithm>
-#include <numeric>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include "metrics/metrics.hpp"
+#include "validation/impl/multi_version_wsv.hpp"
+#include "validation/impl/overlay_wsv.hpp"
 #include "validation/impl/stateful_validator_impl.hpp"
 
 namespace iroha {
   namespace validation {
 
-    StatefulValidatorImpl::StatefulValidatorImpl() {
-      log_ = logger::log("SFV");
-    }
+    namespace {
+      /**
+       * Count distinct signatories of account which have signed transaction.
+       * Both key sets are sorted, so matching is linear after sorting
+       * @param tx - transaction
+       * @param signatories - keys of account
+       * @return number of matching keys
+       */
+      size_t signedSignatories(const model::Transaction &tx,
+                               std::vector<ed25519::pubkey_t> signatories) {
+        std::vector<ed25519::pubkey_t> signers;
+        signers.reserve(tx.signatures.size());
+        for (const auto &signature : tx.signatures) {
+          signers.push_back(signature.pubkey);
+        }
+        std::sort(signers.begin(), signers.end());
+        signers.erase(std::unique(signers.begin(), signers.end()),
+                      signers.end());
+        std::sort(signatories.begin(), signatories.end());
 
-    model::Proposal StatefulValidatorImpl::validate(
-        const model::Proposal &proposal,
-        ametsuchi::TemporaryWsv &temporaryWsv) {
-      log_->info("transactions in proposal: {}", proposal.transactions.size());
-      auto checking_transaction = [&temporaryWsv](auto &tx, auto &executor,
-                                                  auto &query) {
-        auto account = temporaryWsv.getAccount(tx.creator_account_id);
+        size_t matched = 0;
+        auto signer = signers.begin();
+        auto signatory = signatories.begin();
+        while (signer != signers.end() and signatory != signatories.end()) {
+          if (*signer < *signatory) {
+            ++signer;
+          } else if (*signatory < *signer) {
+            ++signatory;
+          } else {
+            ++matched;
+            ++signer;
+            ++signatory;
+          }
+        }
+        return matched;
+      }
+
+      bool checkTransaction(const model::Transaction &tx,
+                            ametsuchi::WsvCommand &executor,
+                            ametsuchi::WsvQuery &query) {
+        // every execution is observed, also repeated speculative ones
+        static auto &latency = metrics::registry().histogram(
+            "iroha_stateful_validation_seconds",
+            "Time of stateful checks and execution of one transaction",
+            metrics::latencyBounds());
+        metrics::ScopedTimer timer(latency);
+        auto account = query.getAccount(tx.creator_account_id);
         // Check if tx creator has account and has quorum to execute transaction
         if (!account || tx.signatures.size() < account.value().quorum)
           return false;
 
-        // Check if signatures in transaction are account signatory
-        auto account_signs = temporaryWsv.getSignatories(tx.creator_account_id);
+        // Counter must grow with every transaction of creator, so replays
+        // are rejected without lookup of their hashes; zero is not counted
+        if (tx.tx_counter != 0 and tx.tx_counter <= account->tx_counter)
+          return false;
+
+        // Check if signatures in transaction are account signatory,
+        // signatories are cached by wsv until they are changed
+        auto account_signs = query.getSignatories(tx.creator_account_id);
         if (!account_signs)
           // No signatories found
           return false;
-
-        // TODO: Check if signatures in transaction are valid
+        if (signedSignatories(tx, std::move(account_signs.value()))
+            < account.value().quorum)
+          // Not enough distinct signatories have signed
+          return false;
 
         // Validate and execute all commands in transaction
-        return std::all_of(
+        auto executed = std::all_of(
             std::begin(tx.commands), std::end(tx.commands),
             [&query, &account, &executor](auto &command) {
               return command->validate(query, account.value()) &&
                   command->execute(query, executor);
             });
+        if (not executed or tx.tx_counter == 0) {
+          return executed;
+        }
+        // commands may have changed the creator, e.g. its quorum
+        auto creator = query.getAccount(tx.creator_account_id);
+        if (not creator) {
+          return false;
+        }
+        creator->tx_counter = tx.tx_counter;
+        return executor.updateAccount(*creator);
+      }
 
-      };
+      /**
+       * Order transactions of each creator by counter, in positions they
+       * take in proposal, so transactions of a client which arrived out of
+       * order are not rejected as replays. Transactions without counter
+       * keep their positions
+       * @return reordered transactions, nullopt if they are in order
+       */
+      nonstd::optional<std::vector<model::Transaction>> inCounterOrder(
+          const std::vector<model::Transaction> &txs) {
+        std::unordered_map<std::string, std::vector<size_t>> positions;
+        for (size_t i = 0; i < txs.size(); ++i) {
+          if (txs[i].tx_counter != 0) {
+            positions[txs[i].creator_account_id].push_back(i);
+          }
+        }
+        auto by_counter = [&txs](size_t lhs, size_t rhs) {
+          return txs[lhs].tx_counter < txs[rhs].tx_counter;
+        };
+        nonstd::optional<std::vector<model::Transaction>> ordered;
+        for (auto &pair : positions) {
+          const auto &own = pair.second;
+          if (std::is_sorted(own.begin(), own.end(), by_counter)) {
+            continue;
+          }
+          if (not ordered) {
+            ordered = txs;
+          }
+          auto sorted = own;
+          std::stable_sort(sorted.begin(), sorted.end(), by_counter);
+          for (size_t k = 0; k < own.size(); ++k) {
+            (*ordered)[own[k]] = txs[sorted[k]];
+          }
+        }
+        return ordered;
+      }
+
+      using Clock = std::chrono::steady_clock;
 
-      // Filter only valid transactions
-      auto filter = [&temporaryWsv, checking_transaction](auto &acc,
-                                                          const auto &tx) {
-        auto answer = temporaryWsv.apply(tx, checking_transaction);
-        if (answer) {
-          acc.push_back(tx);
+      bool expired(Clock::time_point deadline) {
+        return deadline != Clock::time_point::max() and Clock::now() >= deadline;
+      }
+
+      /**
+       * Filter only valid transactions until deadline
+       * @return position of the first transaction not validated
+       */
+      template <typename Iterator, typename Transactions>
+      Iterator validateSerially(Iterator begin,
+                                Iterator end,
+                                ametsuchi::TemporaryWsv &temporaryWsv,
+                                Transactions &valid,
+                                Clock::time_point deadline) {
+        for (; begin != end and not expired(deadline); ++begin) {
+          if (temporaryWsv.apply(*begin, checkTransaction)) {
+            valid.push_back(*begin);
+          }
+        }
+        return begin;
+      }
+
+      /**
+       * Call function for indices [0, size) from several threads
+       */
+      template <typename Function>
+      void parallelFor(size_t size, size_t concurrency, Function function) {
+        std::atomic<size_t> next{0};
+        std::vector<std::thread> threads;
+        for (size_t worker = 0; worker < std::min(concurrency, size);
+             ++worker) {
+          threads.emplace_back([&] {
+            for (auto i = next++; i < size; i = next++) {
+              function(i);
+            }
+          });
+        }
+        for (auto &thread : threads) {
+          thread.join();
         }
-        return acc;
+      }
+
+      /**
+       * Outcome of the latest execution of transaction
+       */
+      struct Speculation {
+        size_t incarnation = 0;
+        bool applied = false;
+        bool unsupported = false;
+        MultiVersionWsv::ReadSet reads;
+        std::vector<OverlayWsv::Operation> operations;
       };
 
-      auto &txs = proposal.transactions;
-      decltype(txs) valid = {};
+      /**
+       * Execute transaction against values written by preceding ones and
+       * publish its writes
+       * @param transaction - index of transaction in multi-version wsv
+       */
+      void speculate(const model::Transaction &tx,
+                     size_t transaction,
+                     MultiVersionWsv &wsv,
+                     Speculation &speculation) {
+        MultiVersionWsv::ReadSet reads;
+        MultiVersionWsv::View view(wsv, transaction, reads);
+        OverlayWsv overlay(view, wsv.lock());
+        std::vector<OverlayWsv::Operation> operations;
+        auto applied = overlay.apply(tx, checkTransaction, operations);
+
+        std::lock_guard<std::mutex> lock(wsv.lock());
+        wsv.clear(transaction);
+        MultiVersionWsv::Writer writer(
+            wsv, {transaction, speculation.incarnation});
+        for (const auto &write : operations) {
+          write(writer);
+        }
+        speculation.applied = applied;
+        speculation.unsupported = overlay.unsupported();
+        speculation.reads = std::move(reads);
+        speculation.operations = std::move(operations);
+      }
+
+      bool isStale(size_t transaction,
+                   MultiVersionWsv &wsv,
+                   const Speculation &speculation) {
+        std::lock_guard<std::mutex> lock(wsv.lock());
+        return not wsv.validate(transaction, speculation.reads);
+      }
+    }  // namespace
+
+    constexpr size_t StatefulValidatorImpl::kMinParallelTransactions;
+    constexpr size_t StatefulValidatorImpl::kSpeculationPasses;
+
+    StatefulValidatorImpl::StatefulValidatorImpl(
+        size_t concurrency, bool speculative, std::chrono::milliseconds budget)
+        : concurrency_(concurrency ? concurrency
+                                   : std::thread::hardware_concurrency()),
+          speculative_(speculative),
+          budget_(budget) {
+      log_ = logger::log("SFV");
+    }
+
+    model::Proposal StatefulValidatorImpl::validate(
+        const model::Proposal &proposal,
+        ametsuchi::TemporaryWsv &temporaryWsv) {
+      Transactions postponed;
+      return validate(proposal, temporaryWsv, postponed);
+    }
+
+    model::Proposal StatefulValidatorImpl::validate(
+        const model::Proposal &proposal,
+        ametsuchi::TemporaryWsv &temporaryWsv,
+        std::vector<model::Transaction> &postponed) {
+      log_->info("transactions in proposal: {}", proposal.transactions.size());
 
-      model::Proposal validated_proposal(
-          std::accumulate(txs.begin(), txs.end(), valid, filter));
+      auto reordered = inCounterOrder(proposal.transactions);
+      const auto &txs = reordered ? *reordered : proposal.transactions;
+      Transactions valid;
+      auto deadline = budget_ == std::chrono::milliseconds::zero()
+          ? Deadline::max()
+          : Clock::now() + budget_;
+      auto stop = txs.end();
+
+      if (speculative_) {
+        stop = validateSpeculatively(
+            txs.begin(), txs.end(), temporaryWsv, valid, deadline);
+      } else {
+        // Proposal is split into runs of transactions with known access,
+        // separated by transactions which are validated alone
+        auto begin = txs.begin();
+        while (begin != txs.end()) {
+          std::vector<TransactionAccess> access;
+          auto end = begin;
+          for (; end != txs.end(); ++end) {
+            auto tx_access = accessOf(*end);
+            if (not tx_access.parallel) {
+              break;
+            }
+            access.push_back(std::move(tx_access));
+          }
+          auto run_end =
+              validateRun(begin, end, access, temporaryWsv, valid, deadline);
+          if (run_end != end) {
+            stop = run_end;
+            break;
+          }
+          if (end != txs.end()) {
+            auto next = std::next(end);
+            if (validateSerially(end, next, temporaryWsv, valid, deadline)
+                != next) {
+              stop = end;
+              break;
+            }
+            end = next;
+          }
+          begin = end;
+        }
+      }
+
+      if (stop != txs.end()) {
+        postponed.assign(stop, txs.end());
+        log_->warn("validation deadline reached, {} transactions postponed",
+                   postponed.size());
+      }
+
+      model::Proposal validated_proposal(valid);
       validated_proposal.height = proposal.height;
       log_->info("transactions in verified proposal: {}",
                  validated_proposal.transactions.size());
       return validated_proposal;
     }
 
+    StatefulValidatorImpl::Transactions::const_iterator
+    StatefulValidatorImpl::validateRun(
+        Transactions::const_iterator begin,
+        Transactions::const_iterator end,
+        const std::vector<TransactionAccess> &access,
+        ametsuchi::TemporaryWsv &temporaryWsv,
+        Transactions &valid,
+        Deadline deadline) {
+      if (access.size() < kMinParallelTransactions or concurrency_ < 2) {
+        return validateSerially(begin, end, temporaryWsv, valid, deadline);
+      }
+      auto groups = independentGroups(access);
+      if (groups.size() < 2) {
+        return validateSerially(begin, end, temporaryWsv, valid, deadline);
+      }
+      // parallel run is validated as a whole, so deadline is checked
+      // before it starts
+      if (expired(deadline)) {
+        return begin;
+      }
+
+      // temporary wsv is a single database session, so reads from it are
+      // serialized, while commands of transactions are checked in parallel
+      std::mutex base_lock;
+      std::vector<OverlayWsv> overlays(groups.size(),
+                                       OverlayWsv(temporaryWsv, base_lock));
+      std::vector<std::vector<OverlayWsv::Operation>> operations(
+          access.size());
+      std::vector<char> applied(access.size(), false);
+
+      auto workers = std::min(concurrency_, groups.size());
+      std::vector<std::thread> threads;
+      for (size_t worker = 0; worker < workers; ++worker) {
+        threads.emplace_back([&, worker] {
+          for (auto group = worker; group < groups.size(); group += workers) {
+            for (auto i : groups[group]) {
+              applied[i] = overlays[group].apply(
+                  *(begin + i), checkTransaction, operations[i]);
+            }
+          }
+        });
+      }
+      for (auto &thread : threads) {
+        thread.join();
+      }
+
+      if (std::any_of(overlays.begin(), overlays.end(), [](const auto &o) {
+            return o.unsupported();
+          })) {
+        log_->warn("unexpected write in parallel validation");
+        return validateSerially(begin, end, temporaryWsv, valid, deadline);
+      }
+
+      // writes are applied in order of proposal, so wsv does not depend on
+      // scheduling of threads
+      for (size_t i = 0; i < access.size(); ++i) {
+        if (not applied[i]) {
+          continue;
+        }
+        auto replay = [&operations, i](const auto &, auto &executor,
+                                       auto &) {
+          return std::all_of(
+              operations[i].begin(), operations[i].end(),
+              [&executor](const auto &write) { return write(executor); });
+        };
+        if (not temporaryWsv.apply(*(begin + i), replay)) {
+          // following transactions might have read the failed write
+          log_->warn("replay of transaction failed, validating serially");
+          return validateSerially(
+              begin + i + 1, end, temporaryWsv, valid, deadline);
+        }
+        valid.push_back(*(begin + i));
+      }
+      return end;
+    }
+
+    StatefulValidatorImpl::Transactions::const_iterator
+    StatefulValidatorImpl::validateSpeculatively(
+        Transactions::const_iterator begin,
+        Transactions::const_iterator end,
+        ametsuchi::TemporaryWsv &temporaryWsv,
+        Transactions &valid,
+        Deadline deadline) {
+      if (concurrency_ < 2) {
+        return validateSerially(begin, end, temporaryWsv, valid, deadline);
+      }
+
+      while (begin != end) {
+        if (expired(deadline)) {
+          return begin;
+        }
+        // each round speculates until transaction with writes which
+        // multi-version wsv can not hold, it is validated alone
+        auto round_end = std::find_if(begin, end, [](const auto &tx) {
+          return not accessOf(tx).parallel;
+        });
+        auto size = static_cast<size_t>(std::distance(begin, round_end));
+        if (size < kMinParallelTransactions) {
+          begin = validateSerially(
+              begin, round_end, temporaryWsv, valid, deadline);
+          if (begin != round_end) {
+            return begin;
+          }
+        }
+        if (begin == round_end) {
+          if (begin != end) {
+            auto next = std::next(begin);
+            if (validateSerially(begin, next, temporaryWsv, valid, deadline)
+                != next) {
+              return begin;
+            }
+            begin = next;
+          }
+          continue;
+        }
+
+        MultiVersionWsv wsv(temporaryWsv);
+        std::vector<Speculation> speculations(size);
+
+        parallelFor(size, concurrency_, [&](size_t i) {
+          speculate(*(begin + i), i, wsv, speculations[i]);
+        });
+        for (size_t pass = 0; pass < kSpeculationPasses; ++pass) {
+          std::atomic<bool> stale{false};
+          parallelFor(size, concurrency_, [&](size_t i) {
+            if (isStale(i, wsv, speculations[i])) {
+              stale = true;
+              ++speculations[i].incarnation;
+              speculate(*(begin + i), i, wsv, speculations[i]);
+            }
+          });
+          if (not stale) {
+            break;
+          }
+        }
+
+        // once preceding transactions are final, re-execution of stale
+        // transaction gives the same result as serial validation
+        size_t i = 0;
+        for (; i < size; ++i) {
+          auto &speculation = speculations[i];
+          if (isStale(i, wsv, speculation)) {
+            ++speculation.incarnation;
+            speculate(*(begin + i), i, wsv, speculation);
+          }
+          if (speculation.unsupported) {
+            // speculation of the following transactions missed its writes
+            break;
+          }
+          if (not speculation.applied) {
+            continue;
+          }
+          auto replay = [&speculation](const auto &, auto &executor, auto &) {
+            return std::all_of(
+                speculation.operations.begin(),
+                speculation.operations.end(),
+                [&executor](const auto &write) { return write(executor); });
+          };
+          if (not temporaryWsv.apply(*(begin + i), replay)) {
+            log_->warn("replay of transaction failed, validating serially");
+            return validateSerially(
+                begin + i + 1, end, temporaryWsv, valid, deadline);
+          }
+          valid.push_back(*(begin + i));
+        }
+        if (i < size) {
+          if (validateSerially(
+                  begin + i, begin + i + 1, temporaryWsv, valid, deadline)
+              != begin + i + 1) {
+            return begin + i;
+          }
+          ++i;
+        }
+        begin += i;
+      }
+      return end;
+    }
+
   }  // namespace validation
 }  // namespace iroha
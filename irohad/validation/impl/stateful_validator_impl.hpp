@@ -19,18 +19,48 @@
 
 #include "validation/stateful_validator.hpp"
 
+#include <chrono>
+#include <vector>
 #include "logger/logger.hpp"
+#include "validation/impl/transaction_access.hpp"
 
 namespace iroha {
   namespace validation {
 
     /**
-     * Interface for performing stateful validation
+     * Interface for performing stateful validation.
+     * Independent transactions of proposal are validated in parallel,
+     * their writes are applied to wsv in order of proposal afterwards.
+     * Independence is either derived from commands, or speculated and
+     * checked against values transactions have actually read.
+     * Validation may be limited in time, transactions not reached before
+     * the deadline are postponed.
      */
     class StatefulValidatorImpl : public StatefulValidator {
      public:
+      /**
+       * Shortest run of independent transactions validated in parallel
+       */
+      static constexpr size_t kMinParallelTransactions = 16;
+
+      /**
+       * Max number of parallel re-executions of speculated transactions
+       * which have read stale values, the rest are re-executed in order
+       */
+      static constexpr size_t kSpeculationPasses = 3;
 
-      StatefulValidatorImpl();
+      /**
+       * @param concurrency - number of validating threads,
+       * hardware concurrency if zero
+       * @param speculative - execute transactions speculatively instead of
+       * deriving conflicts from commands
+       * @param budget - time validation of proposal may take, checked
+       * between transactions and parallel runs, zero for no limit
+       */
+      explicit StatefulValidatorImpl(
+          size_t concurrency = 0,
+          bool speculative = false,
+          std::chrono::milliseconds budget = std::chrono::milliseconds::zero());
 
       /**
        * Function perform stateful validation on proposal
@@ -43,8 +73,55 @@ namespace iroha {
        */
       model::Proposal validate(const model::Proposal& proposal,
                                ametsuchi::TemporaryWsv& temporaryWsv) override;
+
+      model::Proposal validate(
+          const model::Proposal& proposal,
+          ametsuchi::TemporaryWsv& temporaryWsv,
+          std::vector<model::Transaction>& postponed) override;
+
      private:
-        logger::Logger log_;
+      using Transactions = std::vector<model::Transaction>;
+      using Deadline = std::chrono::steady_clock::time_point;
+
+      /**
+       * Validate transactions which do not affect each other besides
+       * conflicts described by their access
+       * @param begin, end - range of transactions in proposal
+       * @param access - access of transactions in range
+       * @param temporaryWsv - wsv to apply valid transactions to
+       * @param valid - valid transactions are appended here
+       * @param deadline - time after which transactions are not validated
+       * @return position of the first transaction not validated
+       */
+      Transactions::const_iterator validateRun(
+          Transactions::const_iterator begin,
+          Transactions::const_iterator end,
+          const std::vector<TransactionAccess> &access,
+          ametsuchi::TemporaryWsv &temporaryWsv,
+          Transactions &valid,
+          Deadline deadline);
+
+      /**
+       * Validate transactions by executing them in parallel against
+       * multi-version wsv, re-executing the ones which have read values
+       * changed by preceding transactions
+       * @param begin, end - range of transactions in proposal
+       * @param temporaryWsv - wsv to apply valid transactions to
+       * @param valid - valid transactions are appended here
+       * @param deadline - time after which transactions are not validated
+       * @return position of the first transaction not validated
+       */
+      Transactions::const_iterator validateSpeculatively(
+          Transactions::const_iterator begin,
+          Transactions::const_iterator end,
+          ametsuchi::TemporaryWsv &temporaryWsv,
+          Transactions &valid,
+          Deadline deadline);
+
+      size_t concurrency_;
+      bool speculative_;
+      std::chrono::milliseconds budget_;
+      logger::Logger log_;
     };
   }  // namespace validation
 }  // namespace iroha
@@ -16,11 +16,134 @@
  */
 
 #include "validation/impl/stateless_validator_impl.hpp"
+#include <algorithm>
+#include <cctype>
 #include <chrono>
+#include <limits>
 #include <utility>
+#include "model/commands/add_asset_quantity.hpp"
+#include "model/commands/add_peer.hpp"
+#include "model/commands/add_signatory.hpp"
+#include "model/commands/assign_master_key.hpp"
+#include "model/commands/create_account.hpp"
+#include "model/commands/create_asset.hpp"
+#include "model/commands/create_domain.hpp"
+#include "model/commands/remove_signatory.hpp"
+#include "model/commands/set_permissions.hpp"
+#include "model/commands/set_quorum.hpp"
+#include "model/commands/transfer_asset.hpp"
 
 namespace iroha {
   namespace validation {
+
+    namespace {
+      // bounds of parts of identifiers, loose enough for existing ledgers
+      const size_t kMaxNameLength = 32;
+      const size_t kMaxAddressLength = 255;
+
+      bool isName(const std::string &name) {
+        return not name.empty() and name.size() <= kMaxNameLength
+            and std::all_of(name.begin(), name.end(), [](char c) {
+                  return std::isalnum(static_cast<unsigned char>(c));
+                });
+      }
+
+      /**
+       * Check identifier of the form name<separator>domain
+       */
+      bool isId(const std::string &id, char separator) {
+        auto pos = id.find(separator);
+        return pos != std::string::npos and isName(id.substr(0, pos))
+            and isName(id.substr(pos + 1));
+      }
+
+      bool isAccountId(const std::string &id) {
+        return isId(id, '@');
+      }
+
+      bool isAssetId(const std::string &id) {
+        return isId(id, '#');
+      }
+
+      /**
+       * Amount is not zero and its joint value fits for precision implied
+       * by fractional part
+       */
+      bool isAmount(const Amount &amount) {
+        uint64_t joint;
+        return (amount.int_part > 0 or amount.frac_part > 0)
+            and amount.get_joint_amount(amount.get_frac_number(), joint);
+      }
+
+      bool isAddress(const std::string &address) {
+        return not address.empty() and address.size() <= kMaxAddressLength
+            and std::none_of(address.begin(), address.end(), [](char c) {
+                  return std::isspace(static_cast<unsigned char>(c))
+                      or std::iscntrl(static_cast<unsigned char>(c));
+                });
+      }
+
+      /**
+       * Check fields of command which do not depend on world state view,
+       * limits of names are the ones stateful validation applies
+       */
+      bool isWellFormed(const model::Command &command) {
+        if (instanceof <model::AddAssetQuantity>(command)) {
+          auto &cast = static_cast<const model::AddAssetQuantity &>(command);
+          return isAccountId(cast.account_id) and isAssetId(cast.asset_id)
+              and isAmount(cast.amount)
+              and cast.amount.int_part
+              < std::numeric_limits<uint32_t>::max();
+        }
+        if (instanceof <model::TransferAsset>(command)) {
+          auto &cast = static_cast<const model::TransferAsset &>(command);
+          return isAccountId(cast.src_account_id)
+              and isAccountId(cast.dest_account_id)
+              and isAssetId(cast.asset_id) and isAmount(cast.amount);
+        }
+        if (instanceof <model::AddPeer>(command)) {
+          auto &cast = static_cast<const model::AddPeer &>(command);
+          return isAddress(cast.address);
+        }
+        if (instanceof <model::AddSignatory>(command)) {
+          auto &cast = static_cast<const model::AddSignatory &>(command);
+          return isAccountId(cast.account_id);
+        }
+        if (instanceof <model::RemoveSignatory>(command)) {
+          auto &cast = static_cast<const model::RemoveSignatory &>(command);
+          return isAccountId(cast.account_id);
+        }
+        if (instanceof <model::AssignMasterKey>(command)) {
+          auto &cast = static_cast<const model::AssignMasterKey &>(command);
+          return isAccountId(cast.account_id);
+        }
+        if (instanceof <model::SetAccountPermissions>(command)) {
+          auto &cast =
+              static_cast<const model::SetAccountPermissions &>(command);
+          return isAccountId(cast.account_id);
+        }
+        if (instanceof <model::SetQuorum>(command)) {
+          auto &cast = static_cast<const model::SetQuorum &>(command);
+          return isAccountId(cast.account_id) and cast.new_quorum > 0
+              and cast.new_quorum < 10;
+        }
+        if (instanceof <model::CreateAccount>(command)) {
+          auto &cast = static_cast<const model::CreateAccount &>(command);
+          return cast.account_name.size() < 8 and isName(cast.account_name)
+              and isName(cast.domain_id);
+        }
+        if (instanceof <model::CreateAsset>(command)) {
+          auto &cast = static_cast<const model::CreateAsset &>(command);
+          return cast.asset_name.size() < 10 and isName(cast.asset_name)
+              and isName(cast.domain_id);
+        }
+        if (instanceof <model::CreateDomain>(command)) {
+          auto &cast = static_cast<const model::CreateDomain &>(command);
+          return cast.domain_name.size() < 10 and isName(cast.domain_name);
+        }
+        return true;
+      }
+    }  // namespace
     StatelessValidatorImpl::StatelessValidatorImpl(
         std::shared_ptr<model::ModelCryptoProvider> crypto_provider)
         : crypto_provider_(std::move(crypto_provider)) {
@@ -51,7 +174,18 @@ namespace iroha {
         log_->warn("timestamp broken: send from future");
         return false;
       }
-      log_->info("transaction validated");
+
+      // malformed commands would fail stateful validation anyway
+      for (const auto &command : transaction.commands) {
+        if (not command or not isWellFormed(*command)) {
+          log_->warn("command is malformed");
+          return false;
+        }
+      }
+      static logger::RateLimit<spdlog::level::info> limit;
+      if (auto count = limit.pass()) {
+        log_->info("{} transactions validated", count);
+      }
       return true;
     }
 
@@ -78,7 +212,10 @@ namespace iroha {
         log_->warn("timestamp broken: send from future");
         return false;
       }
-      log_->info("query validated");
+      static logger::RateLimit<spdlog::level::info> limit;
+      if (auto count = limit.pass()) {
+        log_->info("{} queries validated", count);
+      }
       return true;
     }
   }
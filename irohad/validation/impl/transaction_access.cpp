@@ -0,0 +1,158 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "validation/impl/transaction_access.hpp"
+#include <numeric>
+#include <unordered_map>
+#include "model/commands/add_asset_quantity.hpp"
+#include "model/commands/assign_master_key.hpp"
+#include "model/commands/set_permissions.hpp"
+#include "model/commands/set_quorum.hpp"
+#include "model/commands/transfer_asset.hpp"
+
+namespace iroha {
+  namespace validation {
+
+    namespace {
+      std::string accountKey(const std::string &account_id) {
+        return "a/" + account_id;
+      }
+
+      std::string accountAssetKey(const std::string &account_id,
+                                  const std::string &asset_id) {
+        return "b/" + account_id + "/" + asset_id;
+      }
+
+      /**
+       * Disjoint sets of transaction indices
+       */
+      class Components {
+       public:
+        explicit Components(size_t size) : parents_(size) {
+          std::iota(parents_.begin(), parents_.end(), 0);
+        }
+
+        size_t find(size_t i) {
+          while (parents_[i] != i) {
+            parents_[i] = parents_[parents_[i]];
+            i = parents_[i];
+          }
+          return i;
+        }
+
+        void join(size_t a, size_t b) {
+          a = find(a);
+          b = find(b);
+          // the earliest transaction represents the component
+          if (a < b) {
+            parents_[b] = a;
+          } else {
+            parents_[a] = b;
+          }
+        }
+
+       private:
+        std::vector<size_t> parents_;
+      };
+    }  // namespace
+
+    TransactionAccess accessOf(const model::Transaction &transaction) {
+      TransactionAccess access;
+      // quorum, signatories and permissions of creator, which also gets
+      // counter of transaction
+      if (transaction.tx_counter == 0) {
+        access.reads.push_back(accountKey(transaction.creator_account_id));
+      } else {
+        access.writes.push_back(accountKey(transaction.creator_account_id));
+      }
+      // asset definitions and signatories are read only, since commands
+      // which change them are never parallel
+      for (const auto &command : transaction.commands) {
+        if (instanceof <model::TransferAsset>(command.get())) {
+          auto cast = static_cast<const model::TransferAsset &>(*command);
+          access.reads.push_back(accountKey(cast.src_account_id));
+          access.reads.push_back(accountKey(cast.dest_account_id));
+          access.writes.push_back(
+              accountAssetKey(cast.src_account_id, cast.asset_id));
+          access.writes.push_back(
+              accountAssetKey(cast.dest_account_id, cast.asset_id));
+        } else if (instanceof <model::AddAssetQuantity>(command.get())) {
+          auto cast = static_cast<const model::AddAssetQuantity &>(*command);
+          access.reads.push_back(accountKey(cast.account_id));
+          access.writes.push_back(
+              accountAssetKey(cast.account_id, cast.asset_id));
+        } else if (instanceof <model::SetQuorum>(command.get())) {
+          auto cast = static_cast<const model::SetQuorum &>(*command);
+          access.writes.push_back(accountKey(cast.account_id));
+        } else if (instanceof <model::SetAccountPermissions>(command.get())) {
+          auto cast =
+              static_cast<const model::SetAccountPermissions &>(*command);
+          access.writes.push_back(accountKey(cast.account_id));
+        } else if (instanceof <model::AssignMasterKey>(command.get())) {
+          auto cast = static_cast<const model::AssignMasterKey &>(*command);
+          access.writes.push_back(accountKey(cast.account_id));
+        } else {
+          access.parallel = false;
+        }
+      }
+      return access;
+    }
+
+    std::vector<std::vector<size_t>> independentGroups(
+        const std::vector<TransactionAccess> &access) {
+      struct KeyUse {
+        std::vector<size_t> transactions;
+        bool written = false;
+      };
+      std::unordered_map<std::string, KeyUse> keys;
+      for (size_t i = 0; i < access.size(); ++i) {
+        for (const auto &key : access[i].reads) {
+          keys[key].transactions.push_back(i);
+        }
+        for (const auto &key : access[i].writes) {
+          auto &use = keys[key];
+          use.transactions.push_back(i);
+          use.written = true;
+        }
+      }
+
+      // keys which are only read do not order transactions
+      Components components(access.size());
+      for (const auto &key : keys) {
+        const auto &use = key.second;
+        if (use.written) {
+          for (auto i : use.transactions) {
+            components.join(use.transactions.front(), i);
+          }
+        }
+      }
+
+      std::vector<std::vector<size_t>> groups;
+      std::unordered_map<size_t, size_t> group_of_root;
+      for (size_t i = 0; i < access.size(); ++i) {
+        auto root = components.find(i);
+        auto group = group_of_root.emplace(root, groups.size());
+        if (group.second) {
+          groups.emplace_back();
+        }
+        groups[group.first->second].push_back(i);
+      }
+      return groups;
+    }
+
+  }  // namespace validation
+}  // namespace iroha
@@ -0,0 +1,65 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_TRANSACTION_ACCESS_HPP
+#define IROHA_TRANSACTION_ACCESS_HPP
+
+#include <string>
+#include <vector>
+#include "model/transaction.hpp"
+
+namespace iroha {
+  namespace validation {
+
+    /**
+     * Parts of world state which transaction reads and writes, derived
+     * from its commands
+     */
+    struct TransactionAccess {
+      /**
+       * False if transaction has commands which are not covered by
+       * conflict keys, e.g. creation of accounts or peers. Such
+       * transaction is validated alone, after all preceding ones
+       */
+      bool parallel = true;
+
+      // keys of accounts and account assets
+      std::vector<std::string> reads;
+      std::vector<std::string> writes;
+    };
+
+    /**
+     * Derive access of transaction. Keys are conservative: transactions
+     * with disjoint keys give the same result in any order
+     */
+    TransactionAccess accessOf(const model::Transaction &transaction);
+
+    /**
+     * Split transactions into independent groups. Transactions are in the
+     * same group when one writes a key the other one reads or writes,
+     * directly or through other transactions of the group
+     * @param access - access of every transaction, all of them parallel
+     * @return indices of transactions by group, in order of transactions
+     * inside of a group and by first transaction between groups
+     */
+    std::vector<std::vector<size_t>> independentGroups(
+        const std::vector<TransactionAccess> &access);
+
+  }  // namespace validation
+}  // namespace iroha
+
+#endif  // IROHA_TRANSACTION_ACCESS_HPP
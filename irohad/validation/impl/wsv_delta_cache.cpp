@@ -0,0 +1,77 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "validation/wsv_delta.hpp"
+#include <algorithm>
+
+namespace iroha {
+  namespace validation {
+
+    namespace {
+      /**
+       * Check that block has the contents delta was recorded for,
+       * hash alone is taken from the network and is not recomputed
+       */
+      bool sameContents(const model::Block &lhs, const model::Block &rhs) {
+        return lhs.height == rhs.height and lhs.prev_hash == rhs.prev_hash
+            and std::equal(lhs.transactions.begin(),
+                           lhs.transactions.end(),
+                           rhs.transactions.begin(),
+                           rhs.transactions.end(),
+                           [](const auto &l, const auto &r) {
+                             return l == r
+                                 and l.creator_account_id
+                                 == r.creator_account_id;
+                           });
+      }
+    }  // namespace
+
+    WsvDeltaCache::WsvDeltaCache(size_t capacity) : capacity_(capacity) {}
+
+    void WsvDeltaCache::put(std::shared_ptr<const model::Block> block,
+                            WsvDelta delta) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      entries_.push_back({std::move(block), std::move(delta)});
+      while (entries_.size() > capacity_) {
+        entries_.pop_front();
+      }
+    }
+
+    nonstd::optional<WsvDelta> WsvDeltaCache::take(
+        const model::Block &block) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      nonstd::optional<WsvDelta> result;
+      auto entry = std::find_if(
+          entries_.begin(), entries_.end(), [&block](const auto &entry) {
+            return entry.block->hash == block.hash;
+          });
+      if (entry != entries_.end() and sameContents(*entry->block, block)) {
+        result = std::move(entry->delta);
+      }
+      // deltas of other blocks at this height are abandoned
+      entries_.erase(std::remove_if(entries_.begin(),
+                                    entries_.end(),
+                                    [&block](const auto &entry) {
+                                      return entry.block->height
+                                          <= block.height;
+                                    }),
+                     entries_.end());
+      return result;
+    }
+
+  }  // namespace validation
+}  // namespace iroha
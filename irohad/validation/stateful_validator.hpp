@@ -18,6 +18,7 @@ limitations under the License.
 
 #include <ametsuchi/temporary_wsv.hpp>
 #include <model/proposal.hpp>
+#include <vector>
 
 namespace iroha {
   namespace validation {
@@ -41,6 +42,22 @@ namespace iroha {
       virtual model::Proposal validate(
           const model::Proposal& proposal,
           ametsuchi::TemporaryWsv& temporaryWsv) = 0;
+
+      /**
+       * Stateful validation which may stop before the end of proposal,
+       * e.g. when it runs out of time
+       * @param proposal - proposal for validation
+       * @param temporaryWsv - temporary wsv for validation
+       * @param postponed - filled with transactions which were neither
+       * accepted nor rejected, in order of proposal
+       * @return proposal with valid transactions
+       */
+      virtual model::Proposal validate(
+          const model::Proposal& proposal,
+          ametsuchi::TemporaryWsv& temporaryWsv,
+          std::vector<model::Transaction>& postponed) {
+        return validate(proposal, temporaryWsv);
+      }
     };
   }  // namespace validation
 }  // namespace iroha
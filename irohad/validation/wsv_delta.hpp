@@ -0,0 +1,80 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_WSV_DELTA_HPP
+#define IROHA_WSV_DELTA_HPP
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <nonstd/optional.hpp>
+#include <vector>
+#include "ametsuchi/wsv_command.hpp"
+#include "model/block.hpp"
+
+namespace iroha {
+  namespace validation {
+
+    /**
+     * Writes made to world state view by transactions of block during
+     * stateful validation, in order of execution
+     */
+    using WsvDelta = std::vector<std::function<bool(ametsuchi::WsvCommand &)>>;
+
+    /**
+     * Deltas of blocks created by this peer. Commit of such block applies
+     * its delta instead of executing commands of transactions again.
+     * Shared by simulator and chain validator, thread safe
+     */
+    class WsvDeltaCache {
+     public:
+      /**
+       * @param capacity - number of blocks to keep deltas of, oldest delta
+       * is dropped when exceeded
+       */
+      explicit WsvDeltaCache(size_t capacity = 4);
+
+      /**
+       * Remember delta of created block
+       * @param block - block created from validated proposal
+       * @param delta - writes of its transactions
+       */
+      void put(std::shared_ptr<const model::Block> block, WsvDelta delta);
+
+      /**
+       * Remove delta of block and deltas of blocks not above it
+       * @param block - block to be committed
+       * @return delta if the same block was created by this peer
+       */
+      nonstd::optional<WsvDelta> take(const model::Block &block);
+
+     private:
+      struct Entry {
+        std::shared_ptr<const model::Block> block;
+        WsvDelta delta;
+      };
+
+      size_t capacity_;
+      std::mutex mutex_;
+      std::deque<Entry> entries_;
+    };
+
+  }  // namespace validation
+}  // namespace iroha
+
+#endif  // IROHA_WSV_DELTA_HPP
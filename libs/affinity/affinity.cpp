@@ -0,0 +1,135 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "affinity/affinity.hpp"
+#include <fstream>
+#include <sstream>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace iroha {
+  namespace affinity {
+
+    namespace {
+      // mode of set_mempolicy, numaif.h is not required for one constant
+      constexpr int kMpolPreferred = 1;
+      constexpr size_t kMaxNameLength = 15;
+
+      /**
+       * Parse list of cores in format of sysfs, e.g. "0-3,8-11"
+       */
+      std::vector<int> parseCores(const std::string &list) {
+        std::vector<int> cores;
+        std::istringstream ranges(list);
+        std::string range;
+        while (std::getline(ranges, range, ',')) {
+          auto dash = range.find('-');
+          try {
+            auto first = std::stoi(range.substr(0, dash));
+            auto last = dash == std::string::npos
+                ? first
+                : std::stoi(range.substr(dash + 1));
+            for (auto core = first; core <= last; ++core) {
+              cores.push_back(core);
+            }
+          } catch (const std::exception &) {
+            return {};
+          }
+        }
+        return cores;
+      }
+    }  // namespace
+
+    void nameCurrentThread(const std::string &name) {
+#ifdef __linux__
+      pthread_setname_np(pthread_self(),
+                         name.substr(0, kMaxNameLength).c_str());
+#endif
+    }
+
+    bool pinThread(std::thread::native_handle_type thread, int core) {
+#ifdef __linux__
+      if (core < 0) {
+        return true;
+      }
+      cpu_set_t cpus;
+      CPU_ZERO(&cpus);
+      CPU_SET(core, &cpus);
+      return pthread_setaffinity_np(thread, sizeof(cpus), &cpus) == 0;
+#else
+      return core < 0;
+#endif
+    }
+
+    bool pinCurrentThread(int core) {
+#ifdef __linux__
+      return pinThread(pthread_self(), core);
+#else
+      return core < 0;
+#endif
+    }
+
+    std::vector<int> nodeCores(int node) {
+      std::ifstream file("/sys/devices/system/node/node"
+                         + std::to_string(node) + "/cpulist");
+      std::string list;
+      if (not std::getline(file, list)) {
+        return {};
+      }
+      return parseCores(list);
+    }
+
+    bool bindCurrentThreadToNode(int node) {
+      if (node < 0) {
+        return true;
+      }
+#ifdef __linux__
+      // memory policy takes a mask of nodes
+      unsigned long nodes = 0;
+      if (node >= static_cast<int>(sizeof(nodes) * 8)) {
+        return false;
+      }
+      nodes = 1ul << node;
+      auto cores = nodeCores(node);
+      if (cores.empty()) {
+        return false;
+      }
+      cpu_set_t cpus;
+      CPU_ZERO(&cpus);
+      for (auto core : cores) {
+        CPU_SET(core, &cpus);
+      }
+      if (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) != 0) {
+        return false;
+      }
+      // pages are still taken from other nodes when the node is full
+      return syscall(SYS_set_mempolicy,
+                     kMpolPreferred,
+                     &nodes,
+                     sizeof(nodes) * 8)
+          == 0;
+#else
+      return false;
+#endif
+    }
+
+  }  // namespace affinity
+}  // namespace iroha
@@ -0,0 +1,66 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_AFFINITY_HPP
+#define IROHA_AFFINITY_HPP
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace iroha {
+  namespace affinity {
+
+    /**
+     * Name calling thread, so it is told apart in top, perf and gdb.
+     * Names longer than 15 characters are truncated
+     */
+    void nameCurrentThread(const std::string &name);
+
+    /**
+     * Pin thread to core
+     * @param core - index of core, negative for no pinning
+     * @return false if pinning has failed
+     */
+    bool pinThread(std::thread::native_handle_type thread, int core);
+
+    /**
+     * Pin calling thread to core
+     * @param core - index of core, negative for no pinning
+     * @return false if pinning has failed
+     */
+    bool pinCurrentThread(int core);
+
+    /**
+     * @param node - index of NUMA node
+     * @return cores of node, empty if it is unknown
+     */
+    std::vector<int> nodeCores(int node);
+
+    /**
+     * Run calling thread on cores of NUMA node and allocate its memory
+     * from the node. Threads started afterwards inherit both, so it is
+     * called before the process starts its threads
+     * @param node - index of NUMA node, negative for no binding
+     * @return false if binding has failed
+     */
+    bool bindCurrentThreadToNode(int node);
+
+  }  // namespace affinity
+}  // namespace iroha
+
+#endif  // IROHA_AFFINITY_HPP
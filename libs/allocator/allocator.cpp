@@ -0,0 +1,130 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "allocator/allocator.hpp"
+
+#if defined(IROHA_JEMALLOC)
+#include <jemalloc/jemalloc.h>
+#elif defined(IROHA_MIMALLOC)
+#include <mimalloc.h>
+#elif defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace iroha {
+  namespace allocator {
+
+#if defined(IROHA_JEMALLOC)
+
+    namespace {
+      size_t readSize(const char *name) {
+        size_t value = 0;
+        size_t length = sizeof(value);
+        return mallctl(name, &value, &length, nullptr, 0) == 0 ? value : 0;
+      }
+    }  // namespace
+
+    const char *name() {
+      return "jemalloc";
+    }
+
+    nonstd::optional<Stats> stats() {
+      // statistics are cached by jemalloc until epoch is advanced
+      uint64_t epoch = 1;
+      size_t length = sizeof(epoch);
+      if (mallctl("epoch", &epoch, &length, &epoch, length) != 0) {
+        return nonstd::nullopt;
+      }
+      return Stats{readSize("stats.allocated"), readSize("stats.resident")};
+    }
+
+    bool purge() {
+      // MALLCTL_ARENAS_ALL is 4096
+      return mallctl("arena.4096.purge", nullptr, nullptr, nullptr, 0) == 0;
+    }
+
+#elif defined(IROHA_MIMALLOC)
+
+    const char *name() {
+      return "mimalloc";
+    }
+
+    nonstd::optional<Stats> stats() {
+      size_t elapsed, user, system, resident, peak_resident, committed,
+          peak_committed, page_faults;
+      mi_process_info(&elapsed,
+                      &user,
+                      &system,
+                      &resident,
+                      &peak_resident,
+                      &committed,
+                      &peak_committed,
+                      &page_faults);
+      // mimalloc does not count live bytes cheaply, committed memory is the
+      // closest bound
+      return Stats{committed, resident};
+    }
+
+    bool purge() {
+      mi_collect(true);
+      return true;
+    }
+
+#else
+
+    const char *name() {
+      return "system";
+    }
+
+    nonstd::optional<Stats> stats() {
+#if defined(__GLIBC__) \
+    and (__GLIBC__ > 2 or (__GLIBC__ == 2 and __GLIBC_MINOR__ >= 33))
+      auto info = mallinfo2();
+      return Stats{info.uordblks + info.hblkhd,
+                   info.arena + info.hblkhd};
+#else
+      return nonstd::nullopt;
+#endif
+    }
+
+    bool purge() {
+#if defined(__GLIBC__)
+      malloc_trim(0);
+      return true;
+#else
+      return false;
+#endif
+    }
+
+#endif
+
+    std::string report() {
+      auto current = stats();
+      if (not current) {
+        return "";
+      }
+      auto label = std::string("{allocator=\"") + name() + "\"} ";
+      return "# TYPE iroha_allocator_allocated_bytes gauge\n"
+             "iroha_allocator_allocated_bytes"
+          + label + std::to_string(current->allocated)
+          + "\n# TYPE iroha_allocator_resident_bytes gauge\n"
+            "iroha_allocator_resident_bytes"
+          + label + std::to_string(current->resident) + "\n";
+    }
+
+  }  // namespace allocator
+}  // namespace iroha
@@ -0,0 +1,64 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_ALLOCATOR_HPP
+#define IROHA_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <nonstd/optional.hpp>
+#include <string>
+
+namespace iroha {
+  namespace allocator {
+
+    /**
+     * Heap statistics of the allocator linked into the process, selected
+     * at build time with -DALLOCATOR=system|jemalloc|mimalloc
+     */
+    struct Stats {
+      // bytes requested by the program and not freed yet
+      size_t allocated;
+      // bytes of memory obtained from the system and held by allocator
+      size_t resident;
+    };
+
+    /**
+     * @return name of the allocator: system, jemalloc or mimalloc
+     */
+    const char *name();
+
+    /**
+     * @return current statistics, nullopt if allocator does not report them
+     */
+    nonstd::optional<Stats> stats();
+
+    /**
+     * Return unused pages of all threads and arenas to the system
+     * @return false if allocator can not purge
+     */
+    bool purge();
+
+    /**
+     * @return statistics in Prometheus text format, labelled with name of
+     * allocator
+     */
+    std::string report();
+
+  }  // namespace allocator
+}  // namespace iroha
+
+#endif  // IROHA_ALLOCATOR_HPP
@@ -20,7 +20,11 @@
 
 #include <array>
 #include <crypto/base64.hpp>
+#include <algorithm>
 #include <cstdio>
+#include <cstring>
+#include <functional>
+#include <limits>
 #include <string>
 #include <typeinfo>
 
@@ -70,27 +74,54 @@ namespace iroha {
      */
     std::string to_hexstring() const noexcept {
       std::string res(size_ * 2, 0);
-      uint8_t front, back;
-      auto ptr = this->data();
-      for (uint32_t i = 0, k = 0; i < size_; i++) {
-        front = (uint8_t) (ptr[i] & 0xF0) >> 4;
-        back = (uint8_t) (ptr[i] & 0xF);
-        res[k++] = code[front];
-        res[k++] = code[back];
-      }
+      to_hexstring(&res[0]);
       return res;
     }
+
+    /**
+     * Writes hex representation of current blob to caller buffer
+     * @param out - buffer of at least 2 * size() chars, no terminating
+     * zero is written
+     */
+    void to_hexstring(char *out) const noexcept {
+      for (auto byte : *this) {
+        *out++ = code[byte >> 4];
+        *out++ = code[byte & 0xF];
+      }
+    }
   };
 
-  // hex2bytes
-  inline std::vector<uint8_t> hex2bytes(const std::string &hex) {
-    std::vector<uint8_t> bytes;
+  /**
+   * @return value of hex digit, -1 if character is not a hex digit
+   */
+  inline int hexDigit(char c) {
+    if (c >= '0' and c <= '9') {
+      return c - '0';
+    }
+    c |= 0x20;  // lower case
+    if (c >= 'a' and c <= 'f') {
+      return c - 'a' + 10;
+    }
+    return -1;
+  }
 
-    for (size_t i = 0; i < hex.length(); i += 2) {
-      std::string byteString = hex.substr(i, 2);
-      uint8_t byte = (uint8_t) strtol(byteString.c_str(), NULL, 16);
-      bytes.push_back(byte);
+  /**
+   * Decode hex string into caller buffer of (size + 1) / 2 bytes.
+   * As with strtol of each pair of characters, pair starting with a
+   * non-hex character gives zero and trailing non-hex character is ignored
+   */
+  inline void hexToBytes(const char *hex, size_t size, uint8_t *out) {
+    for (size_t i = 0; i < size; i += 2) {
+      auto high = hexDigit(hex[i]);
+      auto low = i + 1 < size ? hexDigit(hex[i + 1]) : -1;
+      *out++ = high < 0 ? 0 : low < 0 ? high : high << 4 | low;
     }
+  }
+
+  // hex2bytes
+  inline std::vector<uint8_t> hex2bytes(const std::string &hex) {
+    std::vector<uint8_t> bytes((hex.size() + 1) / 2);
+    hexToBytes(hex.data(), hex.size(), bytes.data());
     return bytes;
   }
 
@@ -112,11 +143,22 @@ namespace iroha {
     return std::string(source.begin(), source.end());
   }
 
-  // Deserialize hex string to array
+  // Deserialize hex string to array, characters beyond array are ignored
+  template <size_t size>
+  inline void hexstringToArray(const char *string,
+                               size_t length,
+                               blob_t<size> &array) {
+    hexToBytes(string, std::min(length, 2 * size), array.data());
+  }
+
+  template <size_t size>
+  inline void hexstringToArray(const char *string, blob_t<size> &array) {
+    hexstringToArray(string, std::strlen(string), array);
+  }
+
   template <size_t size>
   inline void hexstringToArray(const std::string& string, blob_t<size>& array) {
-    auto bytes = hex2bytes(string);
-    std::copy(bytes.begin(), bytes.end(), array.begin());
+    hexstringToArray(string.data(), string.size(), array);
   }
 
   /**
@@ -124,15 +166,12 @@ namespace iroha {
    * @param str
    * @return
    */
-  inline std::string bytestringToHexstring(std::string str) {
+  inline std::string bytestringToHexstring(const std::string &str) {
     std::string res(str.size() * 2, 0);
-    uint8_t front, back;
-    auto ptr = str.data();
-    for (uint32_t i = 0, k = 0; i < str.size(); i++) {
-      front = (uint8_t) (ptr[i] & 0xF0) >> 4;
-      back = (uint8_t) (ptr[i] & 0xF);
-      res[k++] = code[front];
-      res[k++] = code[back];
+    auto out = &res[0];
+    for (unsigned char byte : str) {
+      *out++ = code[byte >> 4];
+      *out++ = code[byte & 0xF];
     }
     return res;
   }
@@ -162,25 +201,73 @@ namespace iroha {
   using ts64_t = uint64_t;
   using ts32_t = uint32_t;
 
+  /**
+   * Powers of ten which fit into uint64_t, by exponent
+   */
+  constexpr uint64_t kPowersOfTen[] = {1ull,
+                                       10ull,
+                                       100ull,
+                                       1000ull,
+                                       10000ull,
+                                       100000ull,
+                                       1000000ull,
+                                       10000000ull,
+                                       100000000ull,
+                                       1000000000ull,
+                                       10000000000ull,
+                                       100000000000ull,
+                                       1000000000000ull,
+                                       10000000000000ull,
+                                       100000000000000ull,
+                                       1000000000000000ull,
+                                       10000000000000000ull,
+                                       100000000000000000ull,
+                                       1000000000000000000ull,
+                                       10000000000000000000ull};
+
+  // the largest precision whose scale fits into uint64_t
+  constexpr uint32_t kMaxPrecision =
+      sizeof(kPowersOfTen) / sizeof(kPowersOfTen[0]) - 1;
+
   struct Amount {
     uint64_t int_part;
     uint64_t frac_part;
 
-    Amount(uint64_t integer_part, uint64_t fractional_part) {
-      int_part = integer_part;
-      frac_part = fractional_part;
-    }
+    constexpr Amount(uint64_t integer_part, uint64_t fractional_part)
+        : int_part(integer_part), frac_part(fractional_part) {}
 
-    Amount() {
-      int_part = 0;
-      frac_part = 0;
-    }
+    constexpr Amount() : int_part(0), frac_part(0) {}
 
-    uint32_t get_frac_number() { return std::to_string(frac_part).length(); }
+    /**
+     * @return number of decimal digits of fractional part, 1 for zero
+     */
+    constexpr uint32_t get_frac_number() const {
+      uint32_t digits = 1;
+      while (digits <= kMaxPrecision and frac_part >= kPowersOfTen[digits]) {
+        ++digits;
+      }
+      return digits;
+    }
 
-    uint64_t get_joint_amount(uint32_t precision) {
-      auto coef = ipow(10, precision);
-      return int_part * coef + frac_part;
+    /**
+     * Value of amount in minimal units of asset
+     * @param precision - number of digits after point of the asset
+     * @param joint - set to the value on success
+     * @return false if the value does not fit into uint64_t
+     */
+    constexpr bool get_joint_amount(uint32_t precision, uint64_t &joint) const {
+      if (precision > kMaxPrecision) {
+        return false;
+      }
+      // product of two 64 bit values always fits
+      auto value = static_cast<unsigned __int128>(int_part)
+              * kPowersOfTen[precision]
+          + frac_part;
+      if (value > std::numeric_limits<uint64_t>::max()) {
+        return false;
+      }
+      joint = static_cast<uint64_t>(value);
+      return true;
     }
 
     bool operator==(const Amount &rhs) const {
@@ -191,16 +278,12 @@ namespace iroha {
       return !operator==(rhs);
     }
 
-   private:
-    int ipow(int base, int exp) {
-      int result = 1;
-      while (exp) {
-        if (exp & 1) result *= base;
-        exp >>= 1;
-        base *= base;
-      }
-
-      return result;
+    /**
+     * Order of amounts in the same precision, i.e. of the same asset
+     */
+    bool operator<(const Amount &rhs) const {
+      return int_part < rhs.int_part
+          or (int_part == rhs.int_part and frac_part < rhs.frac_part);
     }
   };
 
@@ -216,4 +299,21 @@ namespace iroha {
   }
 
 }  // namespace iroha
+
+namespace std {
+  /**
+   * Blobs are keys of unordered containers without conversion to string.
+   * Hashes and keys are uniformly distributed, so their leading bytes are
+   * used as is
+   */
+  template <size_t size_>
+  struct hash<iroha::blob_t<size_>> {
+    size_t operator()(const iroha::blob_t<size_> &blob) const noexcept {
+      size_t result = 0;
+      std::memcpy(&result, blob.data(), std::min(sizeof(result), size_));
+      return result;
+    }
+  };
+}  // namespace std
+
 #endif  // IROHA_COMMON_HPP
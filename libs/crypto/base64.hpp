@@ -12,7 +12,9 @@ limitations under the License.
 */
 #pragma once
 
+#include <array>
 #include <cctype>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <string>
@@ -52,42 +54,26 @@ static inline bool is_base64(unsigned char c) {
 
 inline std::string base64_encode(unsigned char const *bytes_to_encode,
                           unsigned int in_len) {
-  std::string ret;
-  int i = 0;
-  int j = 0;
-  unsigned char char_array_3[3];
-  unsigned char char_array_4[4];
-
-  while (in_len--) {
-    char_array_3[i++] = *(bytes_to_encode++);
-    if (i == 3) {
-      char_array_4[0] = (char_array_3[0] & 0xfc) >> 2;
-      char_array_4[1] =
-        ((char_array_3[0] & 0x03) << 4) + ((char_array_3[1] & 0xf0) >> 4);
-      char_array_4[2] =
-        ((char_array_3[1] & 0x0f) << 2) + ((char_array_3[2] & 0xc0) >> 6);
-      char_array_4[3] = char_array_3[2] & 0x3f;
-
-      for (i = 0; (i < 4); i++) ret += base64_chars[char_array_4[i]];
-      i = 0;
-    }
+  // output is sized up front, every group of 3 bytes gives 4 characters
+  std::string ret((in_len + 2) / 3 * 4, '=');
+  auto out = &ret[0];
+  for (; in_len >= 3; in_len -= 3, bytes_to_encode += 3) {
+    uint32_t group = bytes_to_encode[0] << 16 | bytes_to_encode[1] << 8
+        | bytes_to_encode[2];
+    *out++ = base64_chars[group >> 18];
+    *out++ = base64_chars[(group >> 12) & 0x3f];
+    *out++ = base64_chars[(group >> 6) & 0x3f];
+    *out++ = base64_chars[group & 0x3f];
   }
-
-  if (i) {
-    for (j = i; j < 3; j++) char_array_3[j] = '\0';
-
-    char_array_4[0] = (char_array_3[0] & 0xfc) >> 2;
-    char_array_4[1] =
-      ((char_array_3[0] & 0x03) << 4) + ((char_array_3[1] & 0xf0) >> 4);
-    char_array_4[2] =
-      ((char_array_3[1] & 0x0f) << 2) + ((char_array_3[2] & 0xc0) >> 6);
-    char_array_4[3] = char_array_3[2] & 0x3f;
-
-    for (j = 0; (j < i + 1); j++) ret += base64_chars[char_array_4[j]];
-
-    while ((i++ < 3)) ret += '=';
+  if (in_len) {
+    uint32_t group = bytes_to_encode[0] << 16
+        | (in_len == 2 ? bytes_to_encode[1] << 8 : 0);
+    *out++ = base64_chars[group >> 18];
+    *out++ = base64_chars[(group >> 12) & 0x3f];
+    if (in_len == 2) {
+      *out++ = base64_chars[(group >> 6) & 0x3f];
+    }
   }
-
   return ret;
 }
 
@@ -99,49 +85,50 @@ inline int base64_chars_find(char c) {
   return -1;
 }
 
-inline std::vector<unsigned char> base64_decode(std::string const &encoded_string) {
-  int in_len = encoded_string.size();
-  int i = 0;
-  int j = 0;
-  int in_ = 0;
-  unsigned char char_array_4[4], char_array_3[3];
-  std::vector<unsigned char> ret;
-  // changes capacity, not size
-  // push_back becomes O(1)
-  ret.reserve(encoded_string.size());
-
-  while (in_len-- && (encoded_string[in_] != '=') &&
-         is_base64(encoded_string[in_])) {
-    char_array_4[i++] = encoded_string[in_];
-    in_++;
-    if (i == 4) {
-      for (i = 0; i < 4; i++)
-        char_array_4[i] = base64_chars_find(char_array_4[i]);
-
-      char_array_3[0] =
-        (char_array_4[0] << 2) + ((char_array_4[1] & 0x30) >> 4);
-      char_array_3[1] =
-        ((char_array_4[1] & 0xf) << 4) + ((char_array_4[2] & 0x3c) >> 2);
-      char_array_3[2] = ((char_array_4[2] & 0x3) << 6) + char_array_4[3];
-
-      for (i = 0; (i < 3); i++) ret.push_back(char_array_3[i]);
-      i = 0;
+/**
+ * @return values of base64 characters, -1 for other characters
+ */
+inline const std::array<signed char, 256> &base64_values() {
+  static const auto values = [] {
+    std::array<signed char, 256> values;
+    values.fill(-1);
+    for (size_t i = 0; i < base64_chars_len; ++i) {
+      values[static_cast<unsigned char>(base64_chars[i])] = i;
     }
-  }
-
-  if (i) {
-    for (j = i; j < 4; j++) char_array_4[j] = 0;
-
-    for (j = 0; j < 4; j++)
-      char_array_4[j] = base64_chars_find(char_array_4[j]);
-
-    char_array_3[0] = (char_array_4[0] << 2) + ((char_array_4[1] & 0x30) >> 4);
-    char_array_3[1] =
-      ((char_array_4[1] & 0xf) << 4) + ((char_array_4[2] & 0x3c) >> 2);
-    char_array_3[2] = ((char_array_4[2] & 0x3) << 6) + char_array_4[3];
+    return values;
+  }();
+  return values;
+}
 
-    for (j = 0; (j < i - 1); j++) ret.push_back(char_array_3[j]);
+inline std::vector<unsigned char> base64_decode(std::string const &encoded_string) {
+  const auto &values = base64_values();
+  // decoding stops at padding or at the first non-base64 character
+  size_t in_len = 0;
+  while (in_len < encoded_string.size()
+         and values[static_cast<unsigned char>(encoded_string[in_len])]
+             >= 0) {
+    ++in_len;
+  }
+  std::vector<unsigned char> ret(in_len / 4 * 3
+                                 + (in_len % 4 ? in_len % 4 - 1 : 0));
+  auto in = reinterpret_cast<const unsigned char *>(encoded_string.data());
+  auto out = ret.data();
+  for (; in_len >= 4; in_len -= 4, in += 4) {
+    uint32_t group = values[in[0]] << 18 | values[in[1]] << 12
+        | values[in[2]] << 6 | values[in[3]];
+    *out++ = group >> 16;
+    *out++ = group >> 8;
+    *out++ = group;
+  }
+  if (in_len) {
+    uint32_t group = 0;
+    for (size_t i = 0; i < in_len; ++i) {
+      group |= values[in[i]] << (18 - 6 * i);
+    }
+    // group of n characters carries n - 1 bytes
+    for (size_t i = 0; i + 1 < in_len; ++i) {
+      *out++ = group >> (16 - 8 * i);
+    }
   }
-
   return ret;
 }
@@ -0,0 +1,98 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "crypto/crc32c.hpp"
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <cpuid.h>
+#include <nmmintrin.h>
+#endif
+
+namespace iroha {
+
+  namespace {
+    // reflected polynomial of CRC-32C
+    const uint32_t kPolynomial = 0x82f63b78;
+
+    std::array<uint32_t, 256> make_table() {
+      std::array<uint32_t, 256> table;
+      for (uint32_t i = 0; i < table.size(); ++i) {
+        uint32_t crc = i;
+        for (auto bit = 0; bit < 8; ++bit) {
+          crc = (crc >> 1) ^ (kPolynomial & (0u - (crc & 1)));
+        }
+        table[i] = crc;
+      }
+      return table;
+    }
+
+    const std::array<uint32_t, 256> kTable = make_table();
+
+    uint32_t crc32cTable(const uint8_t *data, size_t size, uint32_t crc) {
+      for (; size > 0; --size, ++data) {
+        crc = kTable[(crc ^ *data) & 0xff] ^ (crc >> 8);
+      }
+      return crc;
+    }
+
+#if defined(__x86_64__)
+    // compiled for SSE4.2 regardless of build flags, called only when
+    // the CPU reports it
+    __attribute__((target("sse4.2"))) uint32_t crc32cHardware(
+        const uint8_t *data, size_t size, uint32_t crc) {
+      // hardware instruction processes eight bytes at a time
+      uint64_t crc64 = crc;
+      for (; size >= sizeof(uint64_t);
+           size -= sizeof(uint64_t), data += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, data, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+      }
+      crc = static_cast<uint32_t>(crc64);
+      for (; size > 0; --size, ++data) {
+        crc = _mm_crc32_u8(crc, *data);
+      }
+      return crc;
+    }
+
+    bool hasSse42() {
+      unsigned eax, ebx, ecx, edx;
+      return __get_cpuid(1, &eax, &ebx, &ecx, &edx) and (ecx & bit_SSE4_2);
+    }
+#endif
+
+    using Implementation = uint32_t (*)(const uint8_t *, size_t, uint32_t);
+
+    Implementation implementation() {
+#if defined(__x86_64__)
+      if (hasSse42()) {
+        return crc32cHardware;
+      }
+#endif
+      return crc32cTable;
+    }
+  }  // namespace
+
+  uint32_t crc32c(const uint8_t *data, size_t size, uint32_t crc) {
+    // chosen on first use by the CPU the process runs on
+    static const Implementation kImplementation = implementation();
+    return ~kImplementation(data, size, ~crc);
+  }
+
+}  // namespace iroha
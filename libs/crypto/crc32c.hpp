@@ -0,0 +1,37 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_CRC32C_HPP
+#define IROHA_CRC32C_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace iroha {
+
+  /**
+   * CRC-32C (Castagnoli) checksum, used for detection of torn writes
+   * @param data - pointer to data
+   * @param size - number of bytes
+   * @param crc - checksum of preceding data to continue from
+   * @return checksum of data
+   */
+  uint32_t crc32c(const uint8_t *data, size_t size, uint32_t crc = 0);
+
+}  // namespace iroha
+
+#endif  // IROHA_CRC32C_HPP
@@ -20,6 +20,7 @@
 
 #include <common/types.hpp>
 #include <string>
+#include <vector>
 
 namespace iroha {
 
@@ -46,6 +47,43 @@ namespace iroha {
   bool verify(const uint8_t *msg, size_t msgsize, const ed25519::pubkey_t &pub,
               const ed25519::sig_t &sig);
 
+  /**
+   * Decompressed points of recently seen public keys are cached by verify,
+   * so signatures of frequent signatories skip point decompression
+   * @return number of verifications which took point from the cache
+   */
+  uint64_t key_points_hits();
+
+  /**
+   * Signed message for batch verification, message memory is owned by caller
+   */
+  struct SignedMessage {
+    const uint8_t *msg;
+    size_t msgsize;
+    ed25519::pubkey_t pub;
+    ed25519::sig_t sig;
+  };
+
+  /**
+   * Verify many ed25519 signatures at once.
+   * Large batches are split between hardware threads, verification stops
+   * as soon as an invalid signature is found.
+   * @param batch - messages with signatures
+   * @return true if all signatures are valid, false otherwise
+   */
+  bool verify_batch(const std::vector<SignedMessage> &batch);
+
+  /**
+   * Verify signatures of batch until quorum of them is found valid, e.g.
+   * signatures of multisig account. Large batches are split between
+   * hardware threads like in verify_batch, verification stops as soon as
+   * the result is known.
+   * @param batch - messages with signatures
+   * @param quorum - required number of valid signatures
+   * @return true if at least quorum signatures are valid
+   */
+  bool verify_quorum(const std::vector<SignedMessage> &batch, size_t quorum);
+
   /**
    * Generate random seed reading from /dev/urandom
    */
@@ -56,7 +94,7 @@ namespace iroha {
    * @param passphrase
    * @return
    */
-  blob_t<32> create_seed(std::string passphrase);
+  blob_t<32> create_seed(const std::string &passphrase);
 
   /**
    * Create new keypair
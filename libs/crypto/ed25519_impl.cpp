@@ -16,9 +16,90 @@
  */
 
 #include <ed25519.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <string>
+#include <thread>
 #include "crypto.hpp"
 #include "hash.hpp"
+#include "map_queue/sharded_cache.hpp"
+
+extern "C" {
+#include <ge.h>
+#include <sc.h>
+}
+
+namespace {
+  using iroha::ed25519::pubkey_t;
+  using iroha::ed25519::sig_t;
+
+  /**
+   * Validators check signatures of the same accounts and peers over and
+   * over, so points of a small number of keys cover most of verifications
+   */
+  constexpr size_t kKeyCacheCapacity = 1024;
+
+  std::atomic<uint64_t> key_cache_hits{0};
+
+  /**
+   * Negated curve points of recently seen public keys. Decompression
+   * takes a square root in the field, about a tenth of verification
+   */
+  structure::ShardedCache<pubkey_t, ge_p3> &keyPoints() {
+    static structure::ShardedCache<pubkey_t, ge_p3> points(kKeyCacheCapacity);
+    return points;
+  }
+
+  /**
+   * Same check as ed25519_verify, with negated point of public key
+   * decompressed beforehand
+   */
+  bool verifyWithPoint(const uint8_t *msg,
+                       size_t msgsize,
+                       const pubkey_t &pub,
+                       const ge_p3 &point,
+                       const sig_t &sig) {
+    if (sig[63] & 224) {
+      return false;
+    }
+    std::vector<uint8_t> payload;
+    payload.reserve(32 + pub.size() + msgsize);
+    payload.insert(payload.end(), sig.begin(), sig.begin() + 32);
+    payload.insert(payload.end(), pub.begin(), pub.end());
+    payload.insert(payload.end(), msg, msg + msgsize);
+    auto h = iroha::sha3_512(payload.data(), payload.size());
+    sc_reduce(h.data());
+    ge_p2 r;
+    ge_double_scalarmult_vartime(&r, h.data(), &point, sig.data() + 32);
+    unsigned char checker[32];
+    ge_tobytes(checker, &r);
+    return std::memcmp(checker, sig.data(), sizeof(checker)) == 0;
+  }
+
+  /**
+   * Points are used only if verification with them agrees with
+   * ed25519_verify of the linked library, which is checked once
+   */
+  bool keyPointsUsable() {
+    static const bool usable = [] {
+      auto keypair =
+          iroha::create_keypair(iroha::create_seed("key points check"));
+      const uint8_t msg[] = "key points check";
+      auto sig = iroha::sign(msg, sizeof(msg), keypair.pubkey, keypair.privkey);
+      ge_p3 point;
+      if (ge_frombytes_negate_vartime(&point, keypair.pubkey.data()) != 0) {
+        return false;
+      }
+      return 1 == ed25519_verify(
+                      sig.data(), msg, sizeof(msg), keypair.pubkey.data())
+          and verifyWithPoint(msg, sizeof(msg), keypair.pubkey, point, sig)
+          and not verifyWithPoint(
+                  msg, sizeof(msg) - 1, keypair.pubkey, point, sig);
+    }();
+    return usable;
+  }
+}  // namespace
 
 namespace iroha {
 
@@ -41,7 +122,80 @@ namespace iroha {
    */
   bool verify(const uint8_t *msg, size_t msgsize, const pubkey_t &pub,
               const sig_t &sig) {
-    return 1 == ed25519_verify(sig.data(), msg, msgsize, pub.data());
+    if (not keyPointsUsable()) {
+      return 1 == ed25519_verify(sig.data(), msg, msgsize, pub.data());
+    }
+    auto &points = keyPoints();
+    auto point = points.get(pub);
+    if (point) {
+      ++key_cache_hits;
+    } else {
+      ge_p3 decoded;
+      if (ge_frombytes_negate_vartime(&decoded, pub.data()) != 0) {
+        return false;
+      }
+      points.put(pub, decoded);
+      point = decoded;
+    }
+    return verifyWithPoint(msg, msgsize, pub, *point, sig);
+  }
+
+  uint64_t key_points_hits() {
+    return key_cache_hits;
+  }
+
+  /**
+   * Verify signatures until quorum of them is valid
+   */
+  bool verify_quorum(const std::vector<SignedMessage> &batch, size_t quorum) {
+    if (quorum > batch.size()) {
+      return false;
+    }
+    // check stops once the other result is impossible
+    const auto max_invalid = batch.size() - quorum;
+    // below this size thread start costs more than verification
+    constexpr size_t kMinPerThread = 4;
+    size_t threads = std::min<size_t>(
+        std::max(1u, std::thread::hardware_concurrency()),
+        batch.size() / kMinPerThread);
+    if (threads < 2) {
+      size_t valid = 0, invalid = 0;
+      for (const auto &item : batch) {
+        if (valid >= quorum or invalid > max_invalid) {
+          break;
+        }
+        ++(verify(item.msg, item.msgsize, item.pub, item.sig) ? valid
+                                                                : invalid);
+      }
+      return valid >= quorum;
+    }
+
+    std::atomic<size_t> valid{0}, invalid{0};
+    auto check = [&](size_t part) {
+      for (size_t i = part;
+           i < batch.size() and valid < quorum and invalid <= max_invalid;
+           i += threads) {
+        const auto &item = batch[i];
+        ++(verify(item.msg, item.msgsize, item.pub, item.sig) ? valid
+                                                                : invalid);
+      }
+    };
+    std::vector<std::thread> workers;
+    for (size_t part = 1; part < threads; ++part) {
+      workers.emplace_back(check, part);
+    }
+    check(0);
+    for (auto &worker : workers) {
+      worker.join();
+    }
+    return valid >= quorum;
+  }
+
+  /**
+   * Verify batch of signatures
+   */
+  bool verify_batch(const std::vector<SignedMessage> &batch) {
+    return verify_quorum(batch, batch.size());
   }
 
   /**
@@ -58,8 +212,9 @@ namespace iroha {
    * @param passphrase
    * @return
    */
-  blob_t<32> create_seed(std::string passphrase) {
-    return sha3_256((uint8_t *)passphrase.data(), passphrase.size());
+  blob_t<32> create_seed(const std::string &passphrase) {
+    return sha3_256(reinterpret_cast<const uint8_t *>(passphrase.data()),
+                    passphrase.size());
   }
 
   /**
@@ -16,6 +16,14 @@
  */
 
 #include <common/types.hpp>
+#include "crypto/hash.hpp"
+#include <algorithm>
+#include <cstring>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
 extern "C" {
 #include <sha3.h>
 }
@@ -32,6 +40,226 @@ namespace sha3 {
   }
 }
 
+namespace {
+  const uint64_t kRoundConstants[24] = {
+      0x0000000000000001ull, 0x0000000000008082ull, 0x800000000000808aull,
+      0x8000000080008000ull, 0x000000000000808bull, 0x0000000080000001ull,
+      0x8000000080008081ull, 0x8000000000008009ull, 0x000000000000008aull,
+      0x0000000000000088ull, 0x0000000080008009ull, 0x000000008000000aull,
+      0x000000008000808bull, 0x800000000000008bull, 0x8000000000008089ull,
+      0x8000000000008003ull, 0x8000000000008002ull, 0x8000000000000080ull,
+      0x000000000000800aull, 0x800000008000000aull, 0x8000000080008081ull,
+      0x8000000000008080ull, 0x0000000080000001ull, 0x8000000080008008ull};
+
+  const int kRotations[24] = {1,  3,  6,  10, 15, 21, 28, 36,
+                              45, 55, 2,  14, 27, 41, 56, 8,
+                              25, 43, 62, 18, 39, 61, 20, 44};
+
+  const int kLanes[24] = {10, 7,  11, 17, 18, 3, 5,  16, 8,  21, 24, 4,
+                          15, 23, 19, 13, 12, 2, 20, 14, 22, 9,  6,  1};
+
+  /**
+   * Same lane of four independent states
+   */
+  struct Lanes4 {
+    uint64_t v[4];
+  };
+
+  uint64_t rotate(uint64_t lane, int shift) {
+    return (lane << shift) | (lane >> (64 - shift));
+  }
+
+  uint64_t andNot(uint64_t a, uint64_t b) {
+    return ~a & b;
+  }
+
+#ifdef __AVX2__
+  /**
+   * Four lanes in one vector register
+   */
+  struct Avx2Lanes {
+    __m256i v;
+  };
+
+  Avx2Lanes operator^(const Avx2Lanes &a, const Avx2Lanes &b) {
+    return {_mm256_xor_si256(a.v, b.v)};
+  }
+
+  Avx2Lanes &operator^=(Avx2Lanes &a, const Avx2Lanes &b) {
+    a.v = _mm256_xor_si256(a.v, b.v);
+    return a;
+  }
+
+  Avx2Lanes &operator^=(Avx2Lanes &a, uint64_t b) {
+    a.v = _mm256_xor_si256(a.v, _mm256_set1_epi64x(b));
+    return a;
+  }
+
+  Avx2Lanes rotate(const Avx2Lanes &a, int shift) {
+    return {_mm256_or_si256(
+        _mm256_sll_epi64(a.v, _mm_cvtsi32_si128(shift)),
+        _mm256_srl_epi64(a.v, _mm_cvtsi32_si128(64 - shift)))};
+  }
+
+  Avx2Lanes andNot(const Avx2Lanes &a, const Avx2Lanes &b) {
+    return {_mm256_andnot_si256(a.v, b.v)};
+  }
+#else
+  Lanes4 &operator^=(Lanes4 &a, const Lanes4 &b) {
+    for (int k = 0; k < 4; ++k) {
+      a.v[k] ^= b.v[k];
+    }
+    return a;
+  }
+
+  Lanes4 &operator^=(Lanes4 &a, uint64_t b) {
+    for (auto &lane : a.v) {
+      lane ^= b;
+    }
+    return a;
+  }
+
+  Lanes4 operator^(Lanes4 a, const Lanes4 &b) {
+    return a ^= b;
+  }
+
+  Lanes4 rotate(Lanes4 a, int shift) {
+    for (auto &lane : a.v) {
+      lane = rotate(lane, shift);
+    }
+    return a;
+  }
+
+  Lanes4 andNot(Lanes4 a, const Lanes4 &b) {
+    for (int k = 0; k < 4; ++k) {
+      a.v[k] = andNot(a.v[k], b.v[k]);
+    }
+    return a;
+  }
+#endif
+
+  /**
+   * Keccak-f[1600] permutation
+   * @tparam Lane - 64-bit lane or group of lanes of independent states
+   */
+  template <typename Lane>
+  void permute(std::array<Lane, 25> &state) {
+    Lane columns[5];
+    for (auto round_constant : kRoundConstants) {
+      // theta
+      for (int i = 0; i < 5; ++i) {
+        columns[i] = state[i] ^ state[i + 5] ^ state[i + 10] ^ state[i + 15]
+            ^ state[i + 20];
+      }
+      for (int i = 0; i < 5; ++i) {
+        auto t = columns[(i + 4) % 5] ^ rotate(columns[(i + 1) % 5], 1);
+        for (int j = 0; j < 25; j += 5) {
+          state[j + i] ^= t;
+        }
+      }
+      // rho and pi
+      auto t = state[1];
+      for (int i = 0; i < 24; ++i) {
+        auto lane = state[kLanes[i]];
+        state[kLanes[i]] = rotate(t, kRotations[i]);
+        t = lane;
+      }
+      // chi
+      for (int j = 0; j < 25; j += 5) {
+        for (int i = 0; i < 5; ++i) {
+          columns[i] = state[j + i];
+        }
+        for (int i = 0; i < 5; ++i) {
+          state[j + i] ^= andNot(columns[(i + 1) % 5], columns[(i + 2) % 5]);
+        }
+      }
+      // iota
+      state[0] ^= round_constant;
+    }
+  }
+
+  void permute4(std::array<Lanes4, 25> &state) {
+#ifdef __AVX2__
+    std::array<Avx2Lanes, 25> vectors;
+    for (size_t i = 0; i < state.size(); ++i) {
+      vectors[i].v =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(state[i].v));
+    }
+    permute(vectors);
+    for (size_t i = 0; i < state.size(); ++i) {
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(state[i].v),
+                          vectors[i].v);
+    }
+#else
+    permute(state);
+#endif
+  }
+
+  uint64_t load64(const uint8_t *bytes) {
+    uint64_t lane = 0;
+    for (int k = 0; k < 8; ++k) {
+      lane |= static_cast<uint64_t>(bytes[k]) << (8 * k);
+    }
+    return lane;
+  }
+
+  /**
+   * Absorb given block of message into one of four states, the last block
+   * of message is padded
+   */
+  void absorbBlock(std::array<Lanes4, 25> &state,
+                   size_t lane,
+                   const std::string &message,
+                   size_t block) {
+    constexpr auto rate = iroha::Sha3_256::kRate;
+    std::array<uint8_t, rate> data{};
+    auto begin = block * rate;
+    auto size = std::min(rate, message.size() - begin);
+    std::memcpy(data.data(), message.data() + begin, size);
+    if (size < rate) {
+      data[size] ^= 0x06;
+      data[rate - 1] ^= 0x80;
+    }
+    for (size_t i = 0; i < rate / 8; ++i) {
+      state[i].v[lane] ^= load64(data.data() + 8 * i);
+    }
+  }
+
+  /**
+   * Hash up to four messages with shared permutations
+   */
+  void hashGroup(const std::string *messages,
+                 size_t count,
+                 iroha::hash256_t *digests) {
+    std::array<Lanes4, 25> state{};
+    size_t blocks[4] = {};
+    size_t max_blocks = 0;
+    for (size_t lane = 0; lane < count; ++lane) {
+      // padding takes at least one byte
+      blocks[lane] = messages[lane].size() / iroha::Sha3_256::kRate + 1;
+      max_blocks = std::max(max_blocks, blocks[lane]);
+    }
+    for (size_t block = 0; block < max_blocks; ++block) {
+      for (size_t lane = 0; lane < count; ++lane) {
+        if (block < blocks[lane]) {
+          absorbBlock(state, lane, messages[lane], block);
+        }
+      }
+      permute4(state);
+      // finished states are permuted further, their digests are taken now
+      for (size_t lane = 0; lane < count; ++lane) {
+        if (block + 1 == blocks[lane]) {
+          auto &digest = digests[lane];
+          for (size_t i = 0; i < digest.size(); ++i) {
+            digest[i] =
+                static_cast<uint8_t>(state[i / 8].v[lane] >> (8 * (i % 8)));
+          }
+        }
+      }
+    }
+  }
+}  // namespace
+
 namespace iroha {
 
   void sha3_256(unsigned char *output, unsigned char *input,
@@ -56,4 +284,51 @@ namespace iroha {
     return h;
   }
 
+  std::vector<hash256_t> sha3_256_batch(
+      const std::vector<std::string> &messages) {
+    std::vector<hash256_t> digests(messages.size());
+    for (size_t first = 0; first < messages.size(); first += 4) {
+      hashGroup(messages.data() + first,
+                std::min<size_t>(4, messages.size() - first),
+                digests.data() + first);
+    }
+    return digests;
+  }
+
+  constexpr size_t Sha3_256::kRate;
+
+  Sha3_256::Sha3_256() : offset_(0) {
+    state_.fill(0);
+  }
+
+  Sha3_256 &Sha3_256::update(const uint8_t *input, size_t in_size) {
+    for (size_t i = 0; i < in_size; ++i) {
+      // lanes are little endian
+      state_[offset_ / 8] ^= static_cast<uint64_t>(input[i])
+          << (8 * (offset_ % 8));
+      if (++offset_ == kRate) {
+        permute(state_);
+        offset_ = 0;
+      }
+    }
+    return *this;
+  }
+
+  Sha3_256 &Sha3_256::update(const std::string &input) {
+    return update(reinterpret_cast<const uint8_t *>(input.data()),
+                  input.size());
+  }
+
+  hash256_t Sha3_256::final() {
+    // SHA3 domain padding
+    state_[offset_ / 8] ^= 0x06ull << (8 * (offset_ % 8));
+    state_[(kRate - 1) / 8] ^= 0x80ull << (8 * ((kRate - 1) % 8));
+    permute(state_);
+    hash256_t h;
+    for (size_t i = 0; i < h.size(); ++i) {
+      h[i] = static_cast<uint8_t>(state_[i / 8] >> (8 * (i % 8)));
+    }
+    return h;
+  }
+
 }  // namespace iroha
@@ -18,7 +18,10 @@
 #ifndef IROHA_HASH_H
 #define IROHA_HASH_H
 
+#include <array>
 #include <common/types.hpp>
+#include <string>
+#include <vector>
 
 namespace iroha {
 
@@ -32,6 +35,46 @@ namespace iroha {
 
   hash512_t sha3_512(const uint8_t *input, size_t in_size);
 
+  /**
+   * Hash independent messages, four of them share each permutation.
+   * Permutations run in AVX2 registers when built with AVX2 enabled.
+   * Digests equal sha3_256 of every message, batch is efficient when
+   * messages have similar lengths
+   * @return digests in order of messages
+   */
+  std::vector<hash256_t> sha3_256_batch(
+      const std::vector<std::string> &messages);
+
+  /**
+   * Incremental SHA3-256, digest of all updates is equal to sha3_256 of
+   * their concatenation, so parts of message need not be copied together
+   */
+  class Sha3_256 {
+   public:
+    Sha3_256();
+
+    /**
+     * Absorb next part of message
+     */
+    Sha3_256 &update(const uint8_t *input, size_t in_size);
+    Sha3_256 &update(const std::string &input);
+
+    /**
+     * Finish hashing, hasher must not be updated afterwards
+     * @return digest of absorbed message
+     */
+    hash256_t final();
+
+    /**
+     * Bytes absorbed per permutation
+     */
+    static constexpr size_t kRate = 136;
+
+   private:
+    std::array<uint64_t, 25> state_;
+    size_t offset_;  // position in current block
+  };
+
 }  // namespace iroha
 
 #endif  // IROHA_HASH_H
@@ -0,0 +1,44 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "crypto/merkle.hpp"
+#include <algorithm>
+#include <array>
+#include "crypto/hash.hpp"
+
+namespace iroha {
+
+  hash256_t merkle_parent(const hash256_t &left, const hash256_t &right) {
+    std::array<uint8_t, 2 * hash256_t::size()> data;
+    std::copy(right.begin(),
+              right.end(),
+              std::copy(left.begin(), left.end(), data.begin()));
+    return sha3_256(data.data(), data.size());
+  }
+
+  bool verify_merkle_path(const hash256_t &leaf,
+                          const MerklePath &path,
+                          const hash256_t &root) {
+    auto node = leaf;
+    for (const auto &step : path) {
+      node = step.sibling_is_left ? merkle_parent(step.sibling, node)
+                                  : merkle_parent(node, step.sibling);
+    }
+    return node == root;
+  }
+
+}  // namespace iroha
@@ -0,0 +1,56 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_MERKLE_HPP
+#define IROHA_MERKLE_HPP
+
+#include <vector>
+#include "common/types.hpp"
+
+namespace iroha {
+
+  /**
+   * Hash of sibling met on the path from leaf to root of hash tree
+   */
+  struct MerkleStep {
+    hash256_t sibling;
+    bool sibling_is_left;
+  };
+
+  using MerklePath = std::vector<MerkleStep>;
+
+  /**
+   * @return parent node of hash tree, sha3_256 of concatenated children
+   */
+  hash256_t merkle_parent(const hash256_t &left, const hash256_t &right);
+
+  /**
+   * Check that leaf belongs to hash tree with given root, e.g. that
+   * transaction is included into block with trusted header. Needs only
+   * log(n) hashes, so thin clients do not download the whole block.
+   * @param leaf - hash of leaf
+   * @param path - siblings from leaf up to root
+   * @param root - expected root of tree
+   * @return true if path leads from leaf to root
+   */
+  bool verify_merkle_path(const hash256_t &leaf,
+                          const MerklePath &path,
+                          const hash256_t &root);
+
+}  // namespace iroha
+
+#endif  // IROHA_MERKLE_HPP
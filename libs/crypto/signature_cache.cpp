@@ -0,0 +1,109 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "crypto/signature_cache.hpp"
+#include "crypto/hash.hpp"
+
+namespace iroha {
+
+  constexpr size_t SignatureCache::kDefaultCapacity;
+  constexpr size_t SignatureCache::kShards;
+
+  SignatureCache::SignatureCache(size_t capacity)
+      : known_(capacity, kShards) {}
+
+  bool SignatureCache::verify(const uint8_t *msg,
+                              size_t msgsize,
+                              const ed25519::pubkey_t &pub,
+                              const ed25519::sig_t &sig) {
+    auto key = keyOf({msg, msgsize, pub, sig});
+    if (known(key)) {
+      return true;
+    }
+    ++misses_;
+    // verification runs without lock, concurrent checks of one signature
+    // are rare and harmless
+    if (not iroha::verify(msg, msgsize, pub, sig)) {
+      return false;
+    }
+    remember(key);
+    return true;
+  }
+
+  bool SignatureCache::verify_quorum(const std::vector<SignedMessage> &batch,
+                                     size_t quorum) {
+    std::vector<SignedMessage> unknown;
+    std::vector<hash256_t> keys;
+    size_t valid = 0;
+    for (const auto &item : batch) {
+      auto key = keyOf(item);
+      if (known(key)) {
+        ++valid;
+      } else {
+        unknown.push_back(item);
+        keys.push_back(key);
+      }
+    }
+    if (valid >= quorum) {
+      return true;
+    }
+    misses_ += unknown.size();
+    if (not iroha::verify_quorum(unknown, quorum - valid)) {
+      return false;
+    }
+    if (quorum - valid == unknown.size()) {
+      for (const auto &key : keys) {
+        remember(key);
+      }
+    }
+    return true;
+  }
+
+  size_t SignatureCache::size() const {
+    return known_.size();
+  }
+
+  uint64_t SignatureCache::hits() const {
+    return hits_;
+  }
+
+  uint64_t SignatureCache::misses() const {
+    return misses_;
+  }
+
+  hash256_t SignatureCache::keyOf(const SignedMessage &item) {
+    // key binds signature to message and signer
+    return Sha3_256()
+        .update(item.msg, item.msgsize)
+        .update(item.pub.data(), item.pub.size())
+        .update(item.sig.data(), item.sig.size())
+        .final();
+  }
+
+  bool SignatureCache::known(const hash256_t &key) {
+    if (not known_.contains(key)) {
+      return false;
+    }
+    ++hits_;
+    return true;
+  }
+
+  void SignatureCache::remember(const hash256_t &key) {
+    known_.put(key, true);
+  }
+
+}  // namespace iroha
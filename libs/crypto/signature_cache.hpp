@@ -0,0 +1,102 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_SIGNATURE_CACHE_HPP
+#define IROHA_SIGNATURE_CACHE_HPP
+
+#include <atomic>
+#include <common/types.hpp>
+#include <vector>
+#include "crypto/crypto.hpp"
+#include "map_queue/sharded_cache.hpp"
+
+namespace iroha {
+
+  /**
+   * Bounded set of signatures which were found valid. The same signature is
+   * checked several times on its way through the peer, e.g. at Torii and
+   * in validation of the block, repeated checks cost one hash instead of
+   * curve arithmetic.
+   * Only valid signatures are kept, the least recently checked one is
+   * evicted first. Cache is sharded, so that validators running on
+   * different threads rarely contend for the same lock.
+   */
+  class SignatureCache {
+   public:
+    static constexpr size_t kDefaultCapacity = 65536;
+
+    static constexpr size_t kShards = 16;
+
+    /**
+     * @param capacity - max number of signatures, divided between shards
+     */
+    explicit SignatureCache(size_t capacity = kDefaultCapacity);
+
+    /**
+     * Verify ed25519 signature unless it is already known to be valid
+     * @return true if signature is valid, false otherwise
+     */
+    bool verify(const uint8_t *msg,
+                size_t msgsize,
+                const ed25519::pubkey_t &pub,
+                const ed25519::sig_t &sig);
+
+    /**
+     * Verify signatures which are not known to be valid in parallel, see
+     * iroha::verify_quorum. Signatures are remembered only when all of
+     * them were checked, since early exit tells nothing about the rest
+     * @return true if at least quorum signatures are valid
+     */
+    bool verify_quorum(const std::vector<SignedMessage> &batch,
+                       size_t quorum);
+
+    /**
+     * @return number of remembered signatures
+     */
+    size_t size() const;
+
+    /**
+     * @return number of verifications answered from cache
+     */
+    uint64_t hits() const;
+
+    /**
+     * @return number of signatures verified by ed25519
+     */
+    uint64_t misses() const;
+
+   private:
+    static hash256_t keyOf(const SignedMessage &item);
+
+    /**
+     * @return true if signature with given key is known to be valid
+     */
+    bool known(const hash256_t &key);
+
+    /**
+     * Remember valid signature
+     */
+    void remember(const hash256_t &key);
+
+    structure::ShardedCache<hash256_t, bool> known_;
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+  };
+
+}  // namespace iroha
+
+#endif  // IROHA_SIGNATURE_CACHE_HPP
@@ -0,0 +1,114 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "crypto/signer.hpp"
+#include <algorithm>
+#include <iterator>
+
+namespace iroha {
+
+  KeypairSigner::KeypairSigner(const ed25519::keypair_t &keypair)
+      : keypair_(keypair) {}
+
+  ed25519::pubkey_t KeypairSigner::publicKey() const {
+    return keypair_.pubkey;
+  }
+
+  std::vector<ed25519::sig_t> KeypairSigner::signBatch(
+      const std::vector<Message> &messages) {
+    std::vector<ed25519::sig_t> signatures;
+    signatures.reserve(messages.size());
+    for (const auto &message : messages) {
+      signatures.push_back(sign(message.data(),
+                                message.size(),
+                                keypair_.pubkey,
+                                keypair_.privkey));
+    }
+    return signatures;
+  }
+
+  constexpr size_t BatchingSigner::kDefaultBatchSize;
+  constexpr size_t BatchingSigner::kDefaultPipelineDepth;
+
+  BatchingSigner::BatchingSigner(std::shared_ptr<Signer> backend,
+                                 size_t batch_size,
+                                 size_t pipeline_depth)
+      : backend_(std::move(backend)),
+        batch_size_(std::max<size_t>(batch_size, 1)) {
+    auto workers = std::max<size_t>(pipeline_depth, 1);
+    workers_.reserve(workers);
+    for (size_t i = 0; i < workers; ++i) {
+      workers_.emplace_back([this] { run(); });
+    }
+  }
+
+  BatchingSigner::~BatchingSigner() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopped_ = true;
+    }
+    requested_.notify_all();
+    for (auto &worker : workers_) {
+      worker.join();
+    }
+  }
+
+  ed25519::pubkey_t BatchingSigner::publicKey() const {
+    return backend_->publicKey();
+  }
+
+  std::vector<ed25519::sig_t> BatchingSigner::signBatch(
+      const std::vector<Message> &messages) {
+    return backend_->signBatch(messages);
+  }
+
+  void BatchingSigner::signAsync(Message message, Callback callback) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      queue_.push_back({std::move(message), std::move(callback)});
+    }
+    requested_.notify_one();
+  }
+
+  void BatchingSigner::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      requested_.wait(lock, [this] { return stopped_ or not queue_.empty(); });
+      if (queue_.empty()) {
+        return;
+      }
+      auto end = queue_.begin() + std::min(queue_.size(), batch_size_);
+      std::vector<Request> batch(std::make_move_iterator(queue_.begin()),
+                                 std::make_move_iterator(end));
+      queue_.erase(queue_.begin(), end);
+      lock.unlock();
+
+      std::vector<Message> messages;
+      messages.reserve(batch.size());
+      for (auto &request : batch) {
+        messages.push_back(std::move(request.message));
+      }
+      auto signatures = backend_->signBatch(messages);
+      for (size_t i = 0; i < batch.size(); ++i) {
+        batch[i].callback(signatures[i]);
+      }
+
+      lock.lock();
+    }
+  }
+
+}  // namespace iroha
@@ -0,0 +1,145 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_SIGNER_HPP
+#define IROHA_SIGNER_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "crypto/crypto.hpp"
+
+namespace iroha {
+
+  /**
+   * Holder of ed25519 private key, e.g. key in memory or in hardware
+   * security module. Key itself is never exposed, only signatures of
+   * provided messages.
+   */
+  class Signer {
+   public:
+    using Message = std::vector<uint8_t>;
+    using Callback = std::function<void(const ed25519::sig_t &)>;
+
+    /**
+     * @return public key of signatures
+     */
+    virtual ed25519::pubkey_t publicKey() const = 0;
+
+    /**
+     * Sign messages in one round trip to the key.
+     * May be called from several threads at once.
+     * @return signature of each message, in order of messages
+     */
+    virtual std::vector<ed25519::sig_t> signBatch(
+        const std::vector<Message> &messages) = 0;
+
+    /**
+     * Sign message without waiting for the key, by default immediately
+     * @param callback - receives signature, may be invoked from another
+     * thread
+     */
+    virtual void signAsync(Message message, Callback callback) {
+      callback(signBatch({message}).front());
+    }
+
+    virtual ~Signer() = default;
+  };
+
+  /**
+   * Signer with key pair in memory of the process
+   */
+  class KeypairSigner : public Signer {
+   public:
+    explicit KeypairSigner(const ed25519::keypair_t &keypair);
+
+    ed25519::pubkey_t publicKey() const override;
+
+    std::vector<ed25519::sig_t> signBatch(
+        const std::vector<Message> &messages) override;
+
+   private:
+    ed25519::keypair_t keypair_;
+  };
+
+  /**
+   * Signer which pipelines asynchronous requests to slow signer, e.g. one
+   * with round trip of milliseconds to hardware module.
+   * Requests are taken by a fixed number of workers, each of them waits for
+   * one batch at a time. Requests which arrive while all workers wait are
+   * queued and sent together with the next batch, so round trip is paid
+   * once per batch instead of once per message, while a request to an
+   * idle signer is sent at once.
+   */
+  class BatchingSigner : public Signer {
+   public:
+    static constexpr size_t kDefaultBatchSize = 64;
+
+    static constexpr size_t kDefaultPipelineDepth = 4;
+
+    /**
+     * @param backend - signer which holds the key
+     * @param batch_size - max number of messages in one batch
+     * @param pipeline_depth - max number of batches waited for at once
+     */
+    explicit BatchingSigner(std::shared_ptr<Signer> backend,
+                            size_t batch_size = kDefaultBatchSize,
+                            size_t pipeline_depth = kDefaultPipelineDepth);
+
+    /**
+     * Signs queued requests and stops workers
+     */
+    ~BatchingSigner() override;
+
+    ed25519::pubkey_t publicKey() const override;
+
+    /**
+     * Messages are already a batch, so they are passed to backend directly
+     */
+    std::vector<ed25519::sig_t> signBatch(
+        const std::vector<Message> &messages) override;
+
+    void signAsync(Message message, Callback callback) override;
+
+   private:
+    struct Request {
+      Message message;
+      Callback callback;
+    };
+
+    /**
+     * Loop of one worker
+     */
+    void run();
+
+    std::shared_ptr<Signer> backend_;
+    const size_t batch_size_;
+
+    std::mutex mutex_;
+    std::condition_variable requested_;
+    std::deque<Request> queue_;
+    bool stopped_ = false;
+    std::vector<std::thread> workers_;
+  };
+
+}  // namespace iroha
+
+#endif  // IROHA_SIGNER_HPP
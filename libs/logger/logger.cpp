@@ -15,6 +15,7 @@ limitations under the License.
 */
 
 #include "logger/logger.hpp"
+#include <mutex>
 
 namespace logger {
   std::string red(const std::string &string) {
@@ -37,6 +38,20 @@ namespace logger {
 
   void setGlobalPattern() {
     spdlog::set_pattern("[%H:%M:%S][th: %t][%l] [%n] << %v");
+    // loggers created after this are asynchronous, callers wait only when
+    // the queue is full, so no message is lost. Hot path messages are rate
+    // limited at their call sites and do not fill the queue
+    static std::once_flag async;
+    std::call_once(async, [] {
+      spdlog::set_async_mode(kAsyncQueueSize,
+                             spdlog::async_overflow_policy::block_retry);
+    });
+  }
+
+  void shutdown() {
+    spdlog::apply_all(
+        [](std::shared_ptr<spdlog::logger> logger) { logger->flush(); });
+    spdlog::drop_all();
   }
 
   std::shared_ptr<spdlog::logger> createLogger(const std::string &tag) {
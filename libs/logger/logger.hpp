@@ -16,15 +16,84 @@ limitations under the License.
 #ifndef __IROHA_LOGGER_LOGGER_HPP__
 #define __IROHA_LOGGER_LOGGER_HPP__
 
+#include <atomic>
+#include <chrono>
+#include <limits>
 #include <sstream>
 #include <string>
 
 #include <spdlog/spdlog.h>
 
+/**
+ * Lowest level of messages compiled in, as spdlog::level::level_enum.
+ * Set by LOG_LEVEL cmake option, all levels are compiled by default
+ */
+#ifndef IROHA_LOG_LEVEL
+#define IROHA_LOG_LEVEL 0
+#endif
+
 namespace logger {
 
   using Logger = std::shared_ptr<spdlog::logger>;
 
+  /**
+   * Messages are formatted by caller and written by a background thread,
+   * caller waits while the queue is full. Queue size must be a power of two
+   */
+  constexpr size_t kAsyncQueueSize = 8192;
+
+  /**
+   * @return true if messages of level are compiled in, checks of
+   * disabled levels are removed by compiler together with the logging
+   */
+  constexpr bool enabled(spdlog::level::level_enum level) {
+    return static_cast<int>(level) >= IROHA_LOG_LEVEL;
+  }
+
+  /**
+   * Rate limit of one call site on hot path, e.g.
+   *   static logger::RateLimit<spdlog::level::info> limit;
+   *   if (auto count = limit.pass()) {
+   *     log_->info("{} transactions handled", count);
+   *   }
+   * Calls of disabled level are removed at compile time.
+   * @tparam Level - level of the message
+   */
+  template <spdlog::level::level_enum Level>
+  class RateLimit {
+   public:
+    explicit RateLimit(
+        std::chrono::milliseconds period = std::chrono::seconds(1))
+        : period_(period.count()) {}
+
+    /**
+     * @return 0 if message is suppressed, otherwise number of calls since
+     * the last passed one including this one
+     */
+    uint64_t pass() {
+      if (not enabled(Level)) {
+        return 0;
+      }
+      ++calls_;
+      auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                     std::chrono::steady_clock::now().time_since_epoch())
+                     .count();
+      auto last = last_.load(std::memory_order_relaxed);
+      // one of concurrent callers wins the period
+      if (now - last < period_
+          or not last_.compare_exchange_strong(last, now)) {
+        return 0;
+      }
+      return calls_.exchange(0);
+    }
+
+   private:
+    const int64_t period_;
+    // far in the past, so the first call passes
+    std::atomic<int64_t> last_{std::numeric_limits<int64_t>::min() / 2};
+    std::atomic<uint64_t> calls_{0};
+  };
+
   std::string red(const std::string &string);
 
   std::string yellow(const std::string &string);
@@ -35,6 +104,12 @@ namespace logger {
 
   Logger log(const std::string &tag);
 
+  /**
+   * Write queued messages and release loggers, must be called before
+   * process exits, otherwise the last messages are lost
+   */
+  void shutdown();
+
   /**
    * Convert bool value to human readable string repr
    * @param value value for transformation
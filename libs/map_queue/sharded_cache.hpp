@@ -0,0 +1,274 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_SHARDED_CACHE_HPP
+#define IROHA_SHARDED_CACHE_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <nonstd/optional.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace structure {
+
+  /**
+   * Concurrent key-value cache, bounded by number of entries and
+   * optionally by their total size in bytes. Least recently used entry is
+   * evicted first, entries older than time to live are dropped when they
+   * are looked up. All operations are O(1).
+   * Cache is split into independently locked shards, so threads rarely
+   * contend for the same lock; limits are divided between shards, and
+   * recency is tracked per shard.
+   * @tparam Key - hashable key
+   * @tparam Value - copyable value, returned by copy
+   * @tparam Hash - hash of key, which is also used for choosing shard
+   */
+  template <typename Key, typename Value, typename Hash = std::hash<Key>>
+  class ShardedCache {
+   public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Size of entry in bytes
+     */
+    using Sizer = std::function<size_t(const Key &, const Value &)>;
+
+    /**
+     * Counters of cache operations
+     */
+    struct Stats {
+      uint64_t hits = 0;
+      uint64_t misses = 0;
+      uint64_t evictions = 0;
+      uint64_t expirations = 0;
+    };
+
+    static constexpr size_t kDefaultShards = 16;
+
+    /**
+     * @param capacity - max number of entries
+     * @param shards - number of shards
+     * @param ttl - time to live of entry, zero for no expiration
+     * @param max_bytes - max total size of entries, zero for no limit
+     * @param sizer - size of entry, required when max_bytes is given
+     */
+    explicit ShardedCache(size_t capacity,
+                          size_t shards = kDefaultShards,
+                          Clock::duration ttl = Clock::duration::zero(),
+                          size_t max_bytes = 0,
+                          Sizer sizer = nullptr)
+        : ttl_(ttl), sizer_(std::move(sizer)) {
+      shards = std::max<size_t>(shards, 1);
+      for (size_t i = 0; i < shards; ++i) {
+        shards_.emplace_back(new Shard);
+        shards_.back()->capacity = (capacity + shards - 1) / shards;
+        shards_.back()->max_bytes = (max_bytes + shards - 1) / shards;
+      }
+    }
+
+    ShardedCache(const ShardedCache &) = delete;
+    ShardedCache &operator=(const ShardedCache &) = delete;
+
+    /**
+     * Look up value and mark entry as recently used
+     * @return value, nullopt if it is absent or expired
+     */
+    nonstd::optional<Value> get(const Key &key) {
+      auto &shard = shardOf(key);
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      auto entry = find(shard, key);
+      if (entry == shard.entries.end()) {
+        return nonstd::nullopt;
+      }
+      return entry->value;
+    }
+
+    /**
+     * Same as get, without copying value
+     * @return true if entry is present and not expired
+     */
+    bool contains(const Key &key) {
+      auto &shard = shardOf(key);
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      return find(shard, key) != shard.entries.end();
+    }
+
+    /**
+     * Insert or replace entry, evicting least recently used entries over
+     * the limits of shard. Entry larger than byte limit of shard is not
+     * kept.
+     */
+    void put(Key key, Value value) {
+      auto &shard = shardOf(key);
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      auto existing = shard.index.find(key);
+      if (existing != shard.index.end()) {
+        remove(shard, existing->second);
+      }
+      if (shard.capacity == 0) {
+        return;
+      }
+      auto bytes = sizer_ ? sizer_(key, value) : 0;
+      if (shard.max_bytes != 0 and bytes > shard.max_bytes) {
+        return;
+      }
+      shard.entries.push_front(Entry{std::move(key),
+                                     std::move(value),
+                                     bytes,
+                                     Clock::now() + ttl_});
+      shard.index.emplace(shard.entries.front().key, shard.entries.begin());
+      shard.bytes += bytes;
+      while (shard.entries.size() > shard.capacity
+             or (shard.max_bytes != 0 and shard.bytes > shard.max_bytes)) {
+        remove(shard, std::prev(shard.entries.end()));
+        ++shard.stats.evictions;
+      }
+    }
+
+    /**
+     * @return true if entry was present
+     */
+    bool erase(const Key &key) {
+      auto &shard = shardOf(key);
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      auto existing = shard.index.find(key);
+      if (existing == shard.index.end()) {
+        return false;
+      }
+      remove(shard, existing->second);
+      return true;
+    }
+
+    void clear() {
+      for (auto &shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        shard->index.clear();
+        shard->entries.clear();
+        shard->bytes = 0;
+      }
+    }
+
+    /**
+     * @return number of entries, including expired ones not looked up yet
+     */
+    size_t size() const {
+      return sum([](const Shard &shard) { return shard.entries.size(); });
+    }
+
+    /**
+     * @return total size of entries in bytes
+     */
+    size_t bytes() const {
+      return sum([](const Shard &shard) { return shard.bytes; });
+    }
+
+    Stats stats() const {
+      Stats total;
+      for (const auto &shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        total.hits += shard->stats.hits;
+        total.misses += shard->stats.misses;
+        total.evictions += shard->stats.evictions;
+        total.expirations += shard->stats.expirations;
+      }
+      return total;
+    }
+
+   private:
+    struct Entry {
+      Key key;
+      Value value;
+      size_t bytes;
+      Clock::time_point expires;
+    };
+
+    using Entries = std::list<Entry>;
+
+    // padded, so locks of neighbour shards do not share cache line
+    struct alignas(64) Shard {
+      mutable std::mutex mutex;
+      // most recently used first
+      Entries entries;
+      std::unordered_map<Key, typename Entries::iterator, Hash> index;
+      size_t bytes = 0;
+      size_t capacity = 0;
+      size_t max_bytes = 0;
+      Stats stats;
+    };
+
+    Shard &shardOf(const Key &key) {
+      // hash is mixed, since its low bits also choose bucket of index
+      uint64_t hash = hasher_(key);
+      return *shards_[((hash * 0x9E3779B97F4A7C15ull) >> 32) % shards_.size()];
+    }
+
+    /**
+     * Find live entry and move it to front, must be called under lock
+     */
+    typename Entries::iterator find(Shard &shard, const Key &key) {
+      auto existing = shard.index.find(key);
+      if (existing == shard.index.end()) {
+        ++shard.stats.misses;
+        return shard.entries.end();
+      }
+      auto entry = existing->second;
+      if (ttl_ != Clock::duration::zero() and entry->expires <= Clock::now()) {
+        remove(shard, entry);
+        ++shard.stats.expirations;
+        ++shard.stats.misses;
+        return shard.entries.end();
+      }
+      shard.entries.splice(shard.entries.begin(), shard.entries, entry);
+      ++shard.stats.hits;
+      return entry;
+    }
+
+    void remove(Shard &shard, typename Entries::iterator entry) {
+      shard.bytes -= entry->bytes;
+      shard.index.erase(entry->key);
+      shard.entries.erase(entry);
+    }
+
+    template <typename Of>
+    size_t sum(Of of) const {
+      size_t total = 0;
+      for (const auto &shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        total += of(*shard);
+      }
+      return total;
+    }
+
+    const Clock::duration ttl_;
+    const Sizer sizer_;
+    Hash hasher_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+  };
+
+  template <typename Key, typename Value, typename Hash>
+  constexpr size_t ShardedCache<Key, Value, Hash>::kDefaultShards;
+
+}  // namespace structure
+
+#endif  // IROHA_SHARDED_CACHE_HPP
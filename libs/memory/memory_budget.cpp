@@ -0,0 +1,162 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "memory/memory_budget.hpp"
+#include <algorithm>
+#include <vector>
+#include "logger/logger.hpp"
+#include "metrics/metrics.hpp"
+
+namespace iroha {
+  namespace memory {
+
+    namespace {
+      metrics::Gauge &usageOf(const std::string &subsystem) {
+        return metrics::registry().gauge("iroha_memory_bytes",
+                                         "Bytes held by subsystem",
+                                         {{"subsystem", subsystem}});
+      }
+
+      metrics::Counter &releasedBy(const std::string &subsystem) {
+        return metrics::registry().counter(
+            "iroha_memory_released_bytes_total",
+            "Bytes released by subsystem under memory pressure",
+            {{"subsystem", subsystem}});
+      }
+    }  // namespace
+
+    MemoryBudget::MemoryBudget(size_t limit) : limit_(limit) {}
+
+    MemoryBudget::~MemoryBudget() {
+      stop();
+    }
+
+    MemoryBudget::Id MemoryBudget::add(const std::string &subsystem,
+                                       int priority,
+                                       Usage usage,
+                                       Release release) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto id = next_id_++;
+      subsystems_.emplace(
+          id,
+          Subsystem{subsystem, priority, std::move(usage), std::move(release)});
+      return id;
+    }
+
+    void MemoryBudget::remove(Id id) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = subsystems_.find(id);
+      if (it == subsystems_.end()) {
+        return;
+      }
+      // usage of removed subsystem is not reported anymore
+      usageOf(it->second.name).set(0);
+      subsystems_.erase(it);
+    }
+
+    void MemoryBudget::setLimit(size_t limit) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      limit_ = limit;
+    }
+
+    size_t MemoryBudget::limit() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return limit_;
+    }
+
+    size_t MemoryBudget::enforce() {
+      std::lock_guard<std::mutex> lock(mutex_);
+      metrics::registry()
+          .gauge("iroha_memory_limit_bytes",
+                 "Limit of bytes held by all subsystems, 0 if unlimited")
+          .set(limit_);
+
+      size_t total = 0;
+      std::vector<std::pair<size_t, Subsystem *>> usage;
+      for (auto &entry : subsystems_) {
+        auto bytes = entry.second.usage();
+        usageOf(entry.second.name).set(bytes);
+        total += bytes;
+        usage.emplace_back(bytes, &entry.second);
+      }
+      if (limit_ == 0 or total <= limit_) {
+        return total;
+      }
+
+      // stable, so subsystems of equal priority release in order of
+      // registration
+      std::stable_sort(
+          usage.begin(), usage.end(), [](const auto &a, const auto &b) {
+            return a.second->priority < b.second->priority;
+          });
+      for (auto &entry : usage) {
+        if (total <= limit_) {
+          break;
+        }
+        auto &subsystem = *entry.second;
+        if (not subsystem.release or entry.first == 0) {
+          continue;
+        }
+        auto released =
+            std::min(subsystem.release(total - limit_), entry.first);
+        releasedBy(subsystem.name).inc(released);
+        usageOf(subsystem.name).set(entry.first - released);
+        total -= released;
+      }
+      if (total > limit_) {
+        logger::log("MemoryBudget")
+            ->warn("{} bytes are held over limit of {} bytes",
+                   total - limit_,
+                   limit_);
+      }
+      return total;
+    }
+
+    void MemoryBudget::start(std::chrono::milliseconds period) {
+      stop();
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = false;
+      }
+      thread_ = std::thread([this, period] {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (not wakeup_.wait_for(lock, period, [this] { return stopped_; })) {
+          lock.unlock();
+          enforce();
+          lock.lock();
+        }
+      });
+    }
+
+    void MemoryBudget::stop() {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+      }
+      wakeup_.notify_all();
+      if (thread_.joinable()) {
+        thread_.join();
+      }
+    }
+
+    MemoryBudget &budget() {
+      static MemoryBudget budget;
+      return budget;
+    }
+
+  }  // namespace memory
+}  // namespace iroha
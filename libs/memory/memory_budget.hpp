@@ -0,0 +1,139 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_MEMORY_BUDGET_HPP
+#define IROHA_MEMORY_BUDGET_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace iroha {
+  namespace memory {
+
+    /**
+     * Global limit of memory held by caches and queues of the peer.
+     * Subsystems register functions reporting their usage in bytes, and
+     * evictable ones a function releasing memory. When total usage exceeds
+     * the limit, evictable subsystems are asked to release the excess in
+     * order of priority, lower priority first. Usage of every subsystem is
+     * exported as iroha_memory_bytes{subsystem}.
+     * Functions are called under lock of the budget, they must be thread
+     * safe and must not call the budget.
+     */
+    class MemoryBudget {
+     public:
+      using Id = size_t;
+
+      /**
+       * @return bytes used by subsystem
+       */
+      using Usage = std::function<size_t()>;
+
+      /**
+       * Release memory of subsystem
+       * @param bytes - amount which should be released
+       * @return bytes actually released
+       */
+      using Release = std::function<size_t(size_t bytes)>;
+
+      /**
+       * @param limit - max total usage in bytes, 0 for no limit
+       */
+      explicit MemoryBudget(size_t limit = 0);
+
+      MemoryBudget(const MemoryBudget &) = delete;
+      MemoryBudget &operator=(const MemoryBudget &) = delete;
+
+      ~MemoryBudget();
+
+      /**
+       * Register subsystem
+       * @param subsystem - name used as metric label
+       * @param priority - subsystems of lower priority release first
+       * @param usage - reports usage of subsystem
+       * @param release - releases memory, null if subsystem is only
+       * accounted, e.g. queues which can not drop their items
+       * @return id for removal
+       */
+      Id add(const std::string &subsystem,
+             int priority,
+             Usage usage,
+             Release release = nullptr);
+
+      /**
+       * Unregister subsystem, waits for running enforcement, so functions
+       * of subsystem are not called after return
+       */
+      void remove(Id id);
+
+      /**
+       * @param limit - max total usage in bytes, 0 for no limit
+       */
+      void setLimit(size_t limit);
+
+      size_t limit() const;
+
+      /**
+       * Read usage of all subsystems and export it, then release memory of
+       * evictable subsystems while usage exceeds the limit
+       * @return total usage after release
+       */
+      size_t enforce();
+
+      /**
+       * Enforce limit periodically in background thread
+       * @param period - time between enforcements
+       */
+      void start(std::chrono::milliseconds period);
+
+      /**
+       * Stop periodic enforcement
+       */
+      void stop();
+
+     private:
+      struct Subsystem {
+        std::string name;
+        int priority;
+        Usage usage;
+        Release release;
+      };
+
+      size_t limit_;
+      Id next_id_ = 0;
+      std::map<Id, Subsystem> subsystems_;
+      mutable std::mutex mutex_;
+
+      std::thread thread_;
+      std::condition_variable wakeup_;
+      bool stopped_ = false;
+    };
+
+    /**
+     * @return budget shared by all subsystems of the process
+     */
+    MemoryBudget &budget();
+
+  }  // namespace memory
+}  // namespace iroha
+
+#endif  // IROHA_MEMORY_BUDGET_HPP
@@ -0,0 +1,284 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "metrics/metrics.hpp"
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include "logger/logger.hpp"
+
+namespace iroha {
+  namespace metrics {
+
+    namespace {
+      std::string renderLabels(const Labels &labels,
+                               const std::string &extra = "") {
+        if (labels.empty() and extra.empty()) {
+          return "";
+        }
+        std::string result = "{";
+        for (const auto &label : labels) {
+          if (result.size() > 1) {
+            result += ",";
+          }
+          result += label.first + "=\"";
+          // escaping of exposition format
+          for (auto c : label.second) {
+            switch (c) {
+              case '\\':
+                result += "\\\\";
+                break;
+              case '"':
+                result += "\\\"";
+                break;
+              case '\n':
+                result += "\\n";
+                break;
+              default:
+                result += c;
+            }
+          }
+          result += "\"";
+        }
+        if (not extra.empty()) {
+          if (result.size() > 1) {
+            result += ",";
+          }
+          result += extra;
+        }
+        return result + "}";
+      }
+
+      void renderHistogram(std::ostringstream &out,
+                           const std::string &name,
+                           const Labels &labels,
+                           const Histogram &histogram) {
+        auto buckets = histogram.buckets();
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < histogram.bounds().size(); ++i) {
+          cumulative += buckets[i];
+          std::ostringstream bound;
+          bound << histogram.bounds()[i];
+          out << name << "_bucket"
+              << renderLabels(labels, "le=\"" + bound.str() + "\"") << " "
+              << cumulative << "\n";
+        }
+        cumulative += buckets.back();
+        out << name << "_bucket" << renderLabels(labels, "le=\"+Inf\"")
+            << " " << cumulative << "\n";
+        out << name << "_sum" << renderLabels(labels) << " "
+            << histogram.sum() << "\n";
+        out << name << "_count" << renderLabels(labels) << " " << cumulative
+            << "\n";
+      }
+    }  // namespace
+
+    size_t threadShard() {
+      static std::atomic<size_t> next_shard{0};
+      thread_local size_t shard =
+          next_shard.fetch_add(1, std::memory_order_relaxed) % kShards;
+      return shard;
+    }
+
+    uint64_t Counter::value() const {
+      uint64_t value = 0;
+      for (const auto &shard : shards_) {
+        value += shard.value.load(std::memory_order_relaxed);
+      }
+      return value;
+    }
+
+    Histogram::Histogram(std::vector<double> bounds)
+        : bounds_(std::move(bounds)) {
+      for (auto &shard : shards_) {
+        shard.buckets.reset(new std::atomic<uint64_t>[bounds_.size() + 1]);
+        for (size_t i = 0; i <= bounds_.size(); ++i) {
+          shard.buckets[i].store(0, std::memory_order_relaxed);
+        }
+      }
+    }
+
+    void Histogram::observe(double value) {
+      auto bucket = std::lower_bound(bounds_.begin(), bounds_.end(), value)
+          - bounds_.begin();
+      auto &shard = shards_[threadShard()];
+      shard.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+      shard.count.fetch_add(1, std::memory_order_relaxed);
+      // shard is rarely shared, so the loop almost never repeats
+      auto sum = shard.sum.load(std::memory_order_relaxed);
+      while (not shard.sum.compare_exchange_weak(
+          sum, sum + value, std::memory_order_relaxed)) {
+      }
+    }
+
+    std::vector<uint64_t> Histogram::buckets() const {
+      std::vector<uint64_t> result(bounds_.size() + 1);
+      for (const auto &shard : shards_) {
+        for (size_t i = 0; i < result.size(); ++i) {
+          result[i] += shard.buckets[i].load(std::memory_order_relaxed);
+        }
+      }
+      return result;
+    }
+
+    uint64_t Histogram::count() const {
+      uint64_t count = 0;
+      for (const auto &shard : shards_) {
+        count += shard.count.load(std::memory_order_relaxed);
+      }
+      return count;
+    }
+
+    double Histogram::sum() const {
+      double sum = 0;
+      for (const auto &shard : shards_) {
+        sum += shard.sum.load(std::memory_order_relaxed);
+      }
+      return sum;
+    }
+
+    const std::vector<double> &latencyBounds() {
+      static const std::vector<double> bounds = {0.0001,
+                                                 0.00025,
+                                                 0.0005,
+                                                 0.001,
+                                                 0.0025,
+                                                 0.005,
+                                                 0.01,
+                                                 0.025,
+                                                 0.05,
+                                                 0.1,
+                                                 0.25,
+                                                 0.5,
+                                                 1,
+                                                 2.5,
+                                                 5,
+                                                 10};
+      return bounds;
+    }
+
+    const std::vector<double> &sizeBounds() {
+      static const std::vector<double> bounds = {
+          1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000, 10000};
+      return bounds;
+    }
+
+    Registry::Family &Registry::family(const std::string &name,
+                                       const std::string &help,
+                                       const std::string &type) {
+      auto &family = families_[name];
+      if (family.type.empty()) {
+        family.help = help;
+        family.type = type;
+      } else if (family.type != type) {
+        throw std::invalid_argument("metric " + name + " is a "
+                                    + family.type);
+      }
+      return family;
+    }
+
+    Counter &Registry::counter(const std::string &name,
+                               const std::string &help,
+                               const Labels &labels) {
+      std::lock_guard<std::mutex> lock(lock_);
+      auto &counter = family(name, help, "counter").counters[labels];
+      if (not counter) {
+        counter = std::make_unique<Counter>();
+      }
+      return *counter;
+    }
+
+    Gauge &Registry::gauge(const std::string &name,
+                           const std::string &help,
+                           const Labels &labels) {
+      std::lock_guard<std::mutex> lock(lock_);
+      auto &gauge = family(name, help, "gauge").gauges[labels];
+      if (not gauge) {
+        gauge = std::make_unique<Gauge>();
+      }
+      return *gauge;
+    }
+
+    Histogram &Registry::histogram(const std::string &name,
+                                   const std::string &help,
+                                   const std::vector<double> &bounds,
+                                   const Labels &labels) {
+      std::lock_guard<std::mutex> lock(lock_);
+      auto &histogram = family(name, help, "histogram").histograms[labels];
+      if (not histogram) {
+        histogram = std::make_unique<Histogram>(bounds);
+      }
+      return *histogram;
+    }
+
+    size_t Registry::collect(std::function<std::string()> collector) {
+      std::lock_guard<std::mutex> lock(lock_);
+      collectors_.emplace(next_collector_, std::move(collector));
+      return next_collector_++;
+    }
+
+    void Registry::remove(size_t id) {
+      std::lock_guard<std::mutex> lock(lock_);
+      collectors_.erase(id);
+    }
+
+    std::string Registry::render() const {
+      std::lock_guard<std::mutex> lock(lock_);
+      std::ostringstream out;
+      for (const auto &entry : families_) {
+        const auto &name = entry.first;
+        const auto &family = entry.second;
+        out << "# HELP " << name << " " << family.help << "\n";
+        out << "# TYPE " << name << " " << family.type << "\n";
+        for (const auto &counter : family.counters) {
+          out << name << renderLabels(counter.first) << " "
+              << counter.second->value() << "\n";
+        }
+        for (const auto &gauge : family.gauges) {
+          out << name << renderLabels(gauge.first) << " "
+              << gauge.second->value() << "\n";
+        }
+        for (const auto &histogram : family.histograms) {
+          renderHistogram(out, name, histogram.first, *histogram.second);
+        }
+      }
+      for (const auto &collector : collectors_) {
+        out << collector.second();
+      }
+      return out.str();
+    }
+
+    void startupPhase(const std::string &phase,
+                      std::chrono::steady_clock::duration duration) {
+      auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration)
+                    .count();
+      registry()
+          .gauge("iroha_startup_phase_milliseconds",
+                 "Duration of phase of the last start of the peer",
+                 {{"phase", phase}})
+          .set(ms);
+      static auto log = logger::log("Startup");
+      log->info("{} took {} ms", phase, ms);
+    }
+
+    Registry &registry() {
+      static Registry registry;
+      return registry;
+    }
+
+  }  // namespace metrics
+}  // namespace iroha
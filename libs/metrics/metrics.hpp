@@ -0,0 +1,259 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_METRICS_HPP
+#define IROHA_METRICS_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace iroha {
+  namespace metrics {
+
+    /**
+     * Number of shards of counters and histograms. Each thread updates
+     * its own shard, so hot paths do not contend on one cache line
+     */
+    constexpr size_t kShards = 16;
+
+    /**
+     * @return shard of calling thread, assigned on its first update
+     */
+    size_t threadShard();
+
+    /**
+     * Label names and values of one series
+     */
+    using Labels = std::map<std::string, std::string>;
+
+    /**
+     * Monotonic counter, updated with relaxed atomics
+     */
+    class Counter {
+     public:
+      void inc(uint64_t value = 1) {
+        shards_[threadShard()].value.fetch_add(value,
+                                               std::memory_order_relaxed);
+      }
+
+      uint64_t value() const;
+
+     private:
+      struct alignas(64) Shard {
+        std::atomic<uint64_t> value{0};
+      };
+
+      std::array<Shard, kShards> shards_;
+    };
+
+    /**
+     * Current value, e.g. depth of a queue
+     */
+    class Gauge {
+     public:
+      void set(int64_t value) {
+        value_.store(value, std::memory_order_relaxed);
+      }
+
+      void add(int64_t value) {
+        value_.fetch_add(value, std::memory_order_relaxed);
+      }
+
+      int64_t value() const {
+        return value_.load(std::memory_order_relaxed);
+      }
+
+     private:
+      std::atomic<int64_t> value_{0};
+    };
+
+    /**
+     * Histogram with fixed upper bounds of buckets, the last bucket is
+     * unbounded. Durations are observed in seconds
+     */
+    class Histogram {
+     public:
+      /**
+       * @param bounds - increasing upper bounds of buckets
+       */
+      explicit Histogram(std::vector<double> bounds);
+
+      void observe(double value);
+
+      template <typename Rep, typename Period>
+      void observe(std::chrono::duration<Rep, Period> duration) {
+        observe(std::chrono::duration<double>(duration).count());
+      }
+
+      const std::vector<double> &bounds() const {
+        return bounds_;
+      }
+
+      /**
+       * @return number of observations in each bucket, not cumulative
+       */
+      std::vector<uint64_t> buckets() const;
+
+      uint64_t count() const;
+
+      double sum() const;
+
+     private:
+      struct alignas(64) Shard {
+        std::unique_ptr<std::atomic<uint64_t>[]> buckets;
+        std::atomic<uint64_t> count{0};
+        std::atomic<double> sum{0};
+      };
+
+      const std::vector<double> bounds_;
+      std::array<Shard, kShards> shards_;
+    };
+
+    /**
+     * Bounds in seconds for latencies from 100us to 10s
+     */
+    const std::vector<double> &latencyBounds();
+
+    /**
+     * Bounds for sizes, e.g. of proposals, from 1 to 10000
+     */
+    const std::vector<double> &sizeBounds();
+
+    /**
+     * Observes time since construction when destroyed
+     */
+    class ScopedTimer {
+     public:
+      explicit ScopedTimer(Histogram &histogram)
+          : histogram_(histogram), start_(std::chrono::steady_clock::now()) {}
+
+      ~ScopedTimer() {
+        histogram_.observe(std::chrono::steady_clock::now() - start_);
+      }
+
+      ScopedTimer(const ScopedTimer &) = delete;
+      ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+     private:
+      Histogram &histogram_;
+      std::chrono::steady_clock::time_point start_;
+    };
+
+    /**
+     * Record duration of startup phase as gauge of milliseconds labelled
+     * with the phase, and log it, so restart time is broken down
+     */
+    void startupPhase(const std::string &phase,
+                      std::chrono::steady_clock::duration duration);
+
+    /**
+     * Startup phases which run one after another, each mark records the
+     * time since the previous one
+     */
+    class StartupPhases {
+     public:
+      StartupPhases() : last_(std::chrono::steady_clock::now()) {}
+
+      void mark(const std::string &phase) {
+        auto now = std::chrono::steady_clock::now();
+        startupPhase(phase, now - last_);
+        last_ = now;
+      }
+
+     private:
+      std::chrono::steady_clock::time_point last_;
+    };
+
+    /**
+     * Named metrics rendered in Prometheus text exposition format.
+     * Metric is created on first request and lives as long as registry,
+     * so callers keep references to it and update it without lookups.
+     * Components with reports of their own are added as collectors.
+     * Thread safe.
+     */
+    class Registry {
+     public:
+      Counter &counter(const std::string &name,
+                       const std::string &help,
+                       const Labels &labels = {});
+
+      Gauge &gauge(const std::string &name,
+                   const std::string &help,
+                   const Labels &labels = {});
+
+      /**
+       * @param bounds - bounds of buckets, used when series is created
+       */
+      Histogram &histogram(const std::string &name,
+                           const std::string &help,
+                           const std::vector<double> &bounds,
+                           const Labels &labels = {});
+
+      /**
+       * Add text in exposition format, rendered after own metrics
+       * @param collector - called on each rendering, must outlive registry
+       * or be removed before
+       * @return id of collector
+       */
+      size_t collect(std::function<std::string()> collector);
+
+      /**
+       * Stop calling collector
+       * @param id - value returned by collect
+       */
+      void remove(size_t id);
+
+      /**
+       * @return all metrics in Prometheus text format
+       */
+      std::string render() const;
+
+     private:
+      struct Family {
+        std::string help;
+        std::string type;
+        std::map<Labels, std::unique_ptr<Counter>> counters;
+        std::map<Labels, std::unique_ptr<Gauge>> gauges;
+        std::map<Labels, std::unique_ptr<Histogram>> histograms;
+      };
+
+      Family &family(const std::string &name,
+                     const std::string &help,
+                     const std::string &type);
+
+      std::map<std::string, Family> families_;
+      std::map<size_t, std::function<std::string()>> collectors_;
+      size_t next_collector_ = 0;
+      mutable std::mutex lock_;
+    };
+
+    /**
+     * @return registry of the process
+     */
+    Registry &registry();
+
+  }  // namespace metrics
+}  // namespace iroha
+#endif  // IROHA_METRICS_HPP
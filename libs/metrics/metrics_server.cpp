@@ -0,0 +1,177 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "metrics/metrics_server.hpp"
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cstring>
+#include <stdexcept>
+
+namespace iroha {
+  namespace metrics {
+
+    namespace {
+      // requests are single lines of scrapers, larger ones are refused
+      constexpr size_t kMaxRequest = 8192;
+
+      void sendAll(int client, const std::string &data) {
+        size_t sent = 0;
+        while (sent < data.size()) {
+          auto result =
+              ::send(client, data.data() + sent, data.size() - sent, 0);
+          if (result <= 0) {
+            return;
+          }
+          sent += result;
+        }
+      }
+
+      std::string response(const std::string &status,
+                           const std::string &body) {
+        return "HTTP/1.1 " + status
+            + "\r\nContent-Type: text/plain; version=0.0.4"
+            + "\r\nContent-Length: " + std::to_string(body.size())
+            + "\r\nConnection: close\r\n\r\n" + body;
+      }
+    }  // namespace
+
+    MetricsServer::MetricsServer(const std::string &address,
+                                 std::function<std::string()> render,
+                                 std::map<std::string, Handler> handlers)
+        : render_(std::move(render)),
+          handlers_(std::move(handlers)),
+          log_(logger::log("MetricsServer")) {
+      auto colon = address.rfind(':');
+      if (colon == std::string::npos) {
+        throw std::runtime_error("metrics address without port: " + address);
+      }
+      auto host = address.substr(0, colon);
+      auto service = address.substr(colon + 1);
+
+      addrinfo hints{};
+      hints.ai_family = AF_UNSPEC;
+      hints.ai_socktype = SOCK_STREAM;
+      hints.ai_flags = AI_PASSIVE;
+      addrinfo *info = nullptr;
+      if (::getaddrinfo(host.empty() ? nullptr : host.c_str(),
+                        service.c_str(),
+                        &hints,
+                        &info)
+          != 0) {
+        throw std::runtime_error("cannot resolve metrics address " + address);
+      }
+
+      socket_ = ::socket(info->ai_family, info->ai_socktype, info->ai_protocol);
+      int reuse = 1;
+      auto bound = socket_ >= 0
+          and ::setsockopt(
+                  socket_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse))
+              == 0
+          and ::bind(socket_, info->ai_addr, info->ai_addrlen) == 0
+          and ::listen(socket_, SOMAXCONN) == 0;
+      ::freeaddrinfo(info);
+      if (not bound) {
+        auto error = std::string(std::strerror(errno));
+        if (socket_ >= 0) {
+          ::close(socket_);
+        }
+        throw std::runtime_error("cannot listen on metrics address " + address
+                                 + ": " + error);
+      }
+
+      sockaddr_storage local{};
+      socklen_t length = sizeof(local);
+      ::getsockname(socket_, reinterpret_cast<sockaddr *>(&local), &length);
+      port_ = local.ss_family == AF_INET6
+          ? ntohs(reinterpret_cast<sockaddr_in6 *>(&local)->sin6_port)
+          : ntohs(reinterpret_cast<sockaddr_in *>(&local)->sin_port);
+
+      thread_ = std::thread([this] { this->serve(); });
+      log_->info("serving metrics on {}", address);
+    }
+
+    MetricsServer::~MetricsServer() {
+      stopped_ = true;
+      // wakes the blocked accept
+      ::shutdown(socket_, SHUT_RDWR);
+      thread_.join();
+      ::close(socket_);
+    }
+
+    int MetricsServer::port() const {
+      return port_;
+    }
+
+    void MetricsServer::serve() {
+      while (not stopped_) {
+        auto client = ::accept(socket_, nullptr, nullptr);
+        if (client < 0) {
+          if (not stopped_ and errno != EINTR) {
+            log_->warn("accept failed: {}", std::strerror(errno));
+          }
+          continue;
+        }
+        respond(client);
+        ::close(client);
+      }
+    }
+
+    void MetricsServer::respond(int client) {
+      // scrapers which hang are dropped instead of blocking the next ones
+      timeval timeout{5, 0};
+      ::setsockopt(
+          client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+      std::string request;
+      char buffer[1024];
+      while (request.find("\r\n\r\n") == std::string::npos
+             and request.size() < kMaxRequest) {
+        auto received = ::recv(client, buffer, sizeof(buffer), 0);
+        if (received <= 0) {
+          return;
+        }
+        request.append(buffer, received);
+      }
+
+      auto line = request.substr(0, request.find("\r\n"));
+      if (line.compare(0, 4, "GET ") != 0) {
+        sendAll(client, response("405 Method Not Allowed", ""));
+        return;
+      }
+      auto target = line.substr(4, line.find(' ', 4) - 4);
+      auto question = target.find('?');
+      auto path = target.substr(0, question);
+      if (path == "/metrics") {
+        sendAll(client, response("200 OK", render_()));
+        return;
+      }
+      auto handler = handlers_.find(path);
+      if (handler == handlers_.end()) {
+        sendAll(client, response("404 Not Found", ""));
+        return;
+      }
+      sendAll(client,
+              response("200 OK",
+                       handler->second(question == std::string::npos
+                                           ? std::string()
+                                           : target.substr(question + 1))));
+    }
+
+  }  // namespace metrics
+}  // namespace iroha
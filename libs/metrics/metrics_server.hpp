@@ -0,0 +1,85 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_METRICS_SERVER_HPP
+#define IROHA_METRICS_SERVER_HPP
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <string>
+#include <thread>
+#include "logger/logger.hpp"
+
+namespace iroha {
+  namespace metrics {
+
+    /**
+     * Minimal HTTP server answering GET /metrics for Prometheus scrapers.
+     * Requests are served one by one on own thread, so scraping never
+     * blocks the node
+     */
+    class MetricsServer {
+     public:
+      /**
+       * Produces body of response to GET of additional path
+       * @param query - query string of request, without '?'
+       */
+      using Handler = std::function<std::string(const std::string &query)>;
+
+      /**
+       * Start listening
+       * @param address - host:port to listen on
+       * @param render - produces body of the response
+       * @param handlers - additional paths, served on the same thread, so
+       * slow handlers delay scrapes
+       * @throws std::runtime_error if address cannot be bound
+       */
+      MetricsServer(const std::string &address,
+                    std::function<std::string()> render,
+                    std::map<std::string, Handler> handlers = {});
+
+      /**
+       * Stop listening and wait for the serving thread
+       */
+      ~MetricsServer();
+
+      MetricsServer(const MetricsServer &) = delete;
+      MetricsServer &operator=(const MetricsServer &) = delete;
+
+      /**
+       * @return port the server listens on, useful when bound to port 0
+       */
+      int port() const;
+
+     private:
+      void serve();
+      void respond(int client);
+
+      std::function<std::string()> render_;
+      std::map<std::string, Handler> handlers_;
+      int socket_;
+      int port_;
+      std::atomic<bool> stopped_{false};
+      std::thread thread_;
+      logger::Logger log_;
+    };
+
+  }  // namespace metrics
+}  // namespace iroha
+
+#endif  // IROHA_METRICS_SERVER_HPP
@@ -0,0 +1,163 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "profiler/profiler.hpp"
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <signal.h>
+#include <sys/time.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <map>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+namespace iroha {
+  namespace profiler {
+
+    namespace {
+      // frames of the signal handler and signal trampoline
+      constexpr int kSkippedFrames = 2;
+
+      /**
+       * @return readable name of code address
+       */
+      std::string symbolize(void *address) {
+        Dl_info info{};
+        if (::dladdr(address, &info) == 0) {
+          std::stringstream ss;
+          ss << address;
+          return ss.str();
+        }
+        if (info.dli_sname) {
+          int status = 0;
+          auto demangled =
+              abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+          std::string name = status == 0 ? demangled : info.dli_sname;
+          std::free(demangled);
+          return name;
+        }
+        std::string module = info.dli_fname ? info.dli_fname : "?";
+        module = module.substr(module.rfind('/') + 1);
+        std::stringstream ss;
+        ss << module << "+0x" << std::hex
+           << (static_cast<char *>(address)
+               - static_cast<char *>(info.dli_fbase));
+        return ss.str();
+      }
+
+      void setTimer(unsigned frequency) {
+        itimerval timer{};
+        if (frequency > 0) {
+          timer.it_interval.tv_usec = 1000000 / frequency;
+          timer.it_value = timer.it_interval;
+        }
+        ::setitimer(ITIMER_PROF, &timer, nullptr);
+      }
+    }  // namespace
+
+    std::atomic<Profiler *> Profiler::active_{nullptr};
+
+    void Profiler::onSignal(int) {
+      auto saved_errno = errno;
+      auto profiler = active_.load();
+      if (profiler) {
+        auto index = profiler->next_.fetch_add(1);
+        if (index < profiler->samples_.size()) {
+          auto &sample = profiler->samples_[index];
+          sample.depth = ::backtrace(sample.frames, kMaxDepth);
+        }
+      }
+      errno = saved_errno;
+    }
+
+    nonstd::optional<std::string> Profiler::profile(
+        std::chrono::milliseconds duration, unsigned frequency) {
+      std::unique_lock<std::mutex> lock(lock_, std::try_to_lock);
+      if (not lock.owns_lock()) {
+        return nonstd::nullopt;
+      }
+      samples_.resize(kMaxSamples);
+      next_ = 0;
+      // the first call loads unwinder, which is not safe in signal handler
+      void *warmup[1];
+      ::backtrace(warmup, 1);
+
+      struct sigaction action {};
+      struct sigaction previous {};
+      action.sa_handler = &Profiler::onSignal;
+      action.sa_flags = SA_RESTART;
+      sigemptyset(&action.sa_mask);
+      ::sigaction(SIGPROF, &action, &previous);
+      active_ = this;
+      setTimer(std::max(1u, frequency));
+
+      std::this_thread::sleep_for(duration);
+
+      setTimer(0);
+      active_ = nullptr;
+      // a handler may still run on another thread
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      ::sigaction(SIGPROF, &previous, nullptr);
+
+      auto result = collapse(std::min(next_.load(), samples_.size()));
+      samples_.clear();
+      samples_.shrink_to_fit();
+      return result;
+    }
+
+    std::string Profiler::collapse(size_t samples) const {
+      std::unordered_map<void *, std::string> names;
+      std::map<std::string, size_t> stacks;
+      for (size_t i = 0; i < samples; ++i) {
+        const auto &sample = samples_[i];
+        std::string stack;
+        // root first, as flame graphs expect
+        for (auto frame = sample.depth - 1; frame >= kSkippedFrames; --frame) {
+          auto address = sample.frames[frame];
+          auto name = names.find(address);
+          if (name == names.end()) {
+            name = names.emplace(address, symbolize(address)).first;
+          }
+          if (not stack.empty()) {
+            stack += ';';
+          }
+          stack += name->second;
+        }
+        if (not stack.empty()) {
+          ++stacks[stack];
+        }
+      }
+      std::stringstream ss;
+      for (const auto &stack : stacks) {
+        ss << stack.first << ' ' << stack.second << '\n';
+      }
+      if (next_ > samples_.size()) {
+        ss << "[lost] " << next_ - samples_.size() << '\n';
+      }
+      return ss.str();
+    }
+
+    Profiler &profiler() {
+      static Profiler profiler;
+      return profiler;
+    }
+
+  }  // namespace profiler
+}  // namespace iroha
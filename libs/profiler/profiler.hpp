@@ -0,0 +1,81 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef IROHA_PROFILER_HPP
+#define IROHA_PROFILER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <nonstd/optional.hpp>
+#include <string>
+#include <vector>
+
+namespace iroha {
+  namespace profiler {
+
+    /**
+     * Sampling CPU profiler of the whole process. While profile is taken,
+     * SIGPROF interrupts threads which consume CPU at given frequency and
+     * their stacks are recorded; nothing is done otherwise.
+     * Output is in collapsed-stack format, one "root;...;leaf count" line
+     * per distinct stack, which flamegraph.pl and speedscope read.
+     * Functions of executables are named only if they export symbols
+     * (-rdynamic), other frames are written as module+offset
+     */
+    class Profiler {
+     public:
+      // frames kept of every stack, deeper frames are dropped
+      static constexpr size_t kMaxDepth = 64;
+      // samples kept of one profile, later ones are counted as lost
+      static constexpr size_t kMaxSamples = 1 << 16;
+
+      /**
+       * Take profile, blocking the caller for its duration
+       * @param duration - time of sampling
+       * @param frequency - samples per second of CPU time
+       * @return collapsed stacks, nullopt if another profile is being
+       * taken
+       */
+      nonstd::optional<std::string> profile(std::chrono::milliseconds duration,
+                                            unsigned frequency = 99);
+
+     private:
+      struct Sample {
+        void *frames[kMaxDepth];
+        int depth;
+      };
+
+      static void onSignal(int);
+
+      std::string collapse(size_t samples) const;
+
+      std::mutex lock_;
+      std::vector<Sample> samples_;
+
+      static std::atomic<Profiler *> active_;
+      std::atomic<size_t> next_{0};
+    };
+
+    /**
+     * @return profiler of process
+     */
+    Profiler &profiler();
+
+  }  // namespace profiler
+}  // namespace iroha
+
+#endif  // IROHA_PROFILER_HPP
@@ -0,0 +1,421 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_RING_BUFFER_HPP
+#define IROHA_RING_BUFFER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace iroha {
+
+  /**
+   * Size of cache line, indices written by different threads are kept on
+   * separate lines to avoid false sharing
+   */
+  constexpr size_t kCacheLineSize = 64;
+
+  /**
+   * Wait strategy which spins, yielding the core, until condition holds.
+   * Lowest latency, for hand-offs between threads pinned to their own
+   * cores.
+   */
+  class SpinWait {
+   public:
+    template <typename Condition>
+    void wait(Condition &&ready) {
+      while (not ready()) {
+        std::this_thread::yield();
+      }
+    }
+
+    void notify() {}
+  };
+
+  /**
+   * Wait strategy which spins shortly and then sleeps on condition
+   * variable. Notification costs an atomic load while nobody sleeps.
+   */
+  class BlockingWait {
+   public:
+    template <typename Condition>
+    void wait(Condition &&ready) {
+      for (size_t i = 0; i < kSpins; ++i) {
+        if (ready()) {
+          return;
+        }
+      }
+      std::unique_lock<std::mutex> lock(mutex_);
+      sleeping_.fetch_add(1);
+      // pairs with the fence in notify, so either the waiter sees the
+      // change or the notifier sees the waiter
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      condition_.wait(lock, ready);
+      sleeping_.fetch_sub(1);
+    }
+
+    void notify() {
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (sleeping_.load(std::memory_order_relaxed) != 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        condition_.notify_all();
+      }
+    }
+
+   private:
+    static constexpr size_t kSpins = 64;
+
+    alignas(kCacheLineSize) std::atomic<size_t> sleeping_{0};
+    std::mutex mutex_;
+    std::condition_variable condition_;
+  };
+
+  namespace detail {
+
+    inline size_t roundUpToPowerOfTwo(size_t value) {
+      size_t result = 1;
+      while (result < value) {
+        result <<= 1;
+      }
+      return result;
+    }
+
+    /**
+     * Waiting operations over non-blocking tryPush and tryPop of Buffer
+     */
+    template <typename Buffer, typename T, typename Wait>
+    class WaitingBuffer {
+     public:
+      /**
+       * Push value, waiting while buffer is full
+       * @return false if buffer is closed, value is not consumed then
+       */
+      bool push(T &&value) {
+        bool pushed = false;
+        not_full_.wait([&] {
+          pushed = self().push_(std::move(value));
+          return pushed or closed();
+        });
+        if (pushed) {
+          not_empty_.notify();
+        }
+        return pushed;
+      }
+
+      bool push(const T &value) {
+        T copy(value);
+        return push(std::move(copy));
+      }
+
+      /**
+       * Pop value, waiting while buffer is empty
+       * @return false if buffer is closed and drained
+       */
+      bool pop(T &value) {
+        bool popped = false;
+        not_empty_.wait([&] {
+          popped = self().pop_(value);
+          return popped or closed();
+        });
+        if (popped) {
+          not_full_.notify();
+        }
+        return popped;
+      }
+
+      /**
+       * Refuse further pushes and wake up all waiting threads, values
+       * already in buffer can still be popped
+       */
+      void close() {
+        closed_.store(true);
+        not_full_.notify();
+        not_empty_.notify();
+      }
+
+      bool closed() const {
+        return closed_.load(std::memory_order_acquire);
+      }
+
+     protected:
+      /**
+       * Wake up threads waiting in pop after value is pushed without
+       * waiting. Predicates of waits use the non-notifying operations, so
+       * no wait strategy is notified under lock of the other one.
+       */
+      void notifyPushed() {
+        not_empty_.notify();
+      }
+
+      /**
+       * Wake up threads waiting in push after value is popped without
+       * waiting
+       */
+      void notifyPopped() {
+        not_full_.notify();
+      }
+
+     private:
+      Buffer &self() {
+        return static_cast<Buffer &>(*this);
+      }
+
+      std::atomic<bool> closed_{false};
+      Wait not_full_;
+      Wait not_empty_;
+    };
+
+  }  // namespace detail
+
+  /**
+   * Bounded lock-free queue for one producer and one consumer thread.
+   * Each side caches the index of the other one, so shared lines are
+   * touched only when the cached index says the buffer is full or empty.
+   * @tparam T - type of values, default constructible and move assignable
+   * @tparam Wait - SpinWait or BlockingWait, used by push and pop
+   */
+  template <typename T, typename Wait = BlockingWait>
+  class SpscRingBuffer
+      : public detail::WaitingBuffer<SpscRingBuffer<T, Wait>, T, Wait> {
+    using Base = detail::WaitingBuffer<SpscRingBuffer<T, Wait>, T, Wait>;
+    friend Base;
+
+   public:
+    /**
+     * @param capacity - max number of values, rounded up to power of two
+     */
+    explicit SpscRingBuffer(size_t capacity)
+        : mask_(detail::roundUpToPowerOfTwo(capacity) - 1),
+          values_(new T[mask_ + 1]) {}
+
+    SpscRingBuffer(const SpscRingBuffer &) = delete;
+    SpscRingBuffer &operator=(const SpscRingBuffer &) = delete;
+
+    /**
+     * Push value without waiting, must be called by producer thread only
+     * @return false if buffer is full or closed, value is not consumed then
+     */
+    bool tryPush(T &&value) {
+      if (not push_(std::move(value))) {
+        return false;
+      }
+      Base::notifyPushed();
+      return true;
+    }
+
+    /**
+     * Pop value without waiting, must be called by consumer thread only
+     * @return false if buffer is empty
+     */
+    bool tryPop(T &value) {
+      if (not pop_(value)) {
+        return false;
+      }
+      Base::notifyPopped();
+      return true;
+    }
+
+    size_t capacity() const {
+      return mask_ + 1;
+    }
+
+    /**
+     * @return number of values in buffer, approximate while it is used
+     */
+    size_t size() const {
+      return tail_.load(std::memory_order_acquire)
+          - head_.load(std::memory_order_acquire);
+    }
+
+   private:
+    bool push_(T &&value) {
+      if (Base::closed()) {
+        return false;
+      }
+      auto tail = tail_.load(std::memory_order_relaxed);
+      if (tail - cached_head_ > mask_) {
+        cached_head_ = head_.load(std::memory_order_acquire);
+        if (tail - cached_head_ > mask_) {
+          return false;
+        }
+      }
+      values_[tail & mask_] = std::move(value);
+      tail_.store(tail + 1, std::memory_order_release);
+      return true;
+    }
+
+    bool pop_(T &value) {
+      auto head = head_.load(std::memory_order_relaxed);
+      if (head == cached_tail_) {
+        cached_tail_ = tail_.load(std::memory_order_acquire);
+        if (head == cached_tail_) {
+          return false;
+        }
+      }
+      value = std::move(values_[head & mask_]);
+      head_.store(head + 1, std::memory_order_release);
+      return true;
+    }
+
+    const size_t mask_;
+    std::unique_ptr<T[]> values_;
+
+    // written by consumer
+    alignas(kCacheLineSize) std::atomic<size_t> head_{0};
+    size_t cached_tail_ = 0;
+
+    // written by producer
+    alignas(kCacheLineSize) std::atomic<size_t> tail_{0};
+    size_t cached_head_ = 0;
+
+    alignas(kCacheLineSize) char padding_[1];
+  };
+
+  /**
+   * Bounded lock-free queue for any number of producer and consumer
+   * threads. Every slot carries a sequence number which tells whether it
+   * is free for the producer or filled for the consumer of the current
+   * lap, so threads contend only on the index of their side.
+   * @tparam T - type of values, default constructible and move assignable
+   * @tparam Wait - SpinWait or BlockingWait, used by push and pop
+   */
+  template <typename T, typename Wait = BlockingWait>
+  class MpmcRingBuffer
+      : public detail::WaitingBuffer<MpmcRingBuffer<T, Wait>, T, Wait> {
+    using Base = detail::WaitingBuffer<MpmcRingBuffer<T, Wait>, T, Wait>;
+    friend Base;
+
+   public:
+    /**
+     * @param capacity - max number of values, rounded up to power of two
+     */
+    explicit MpmcRingBuffer(size_t capacity)
+        : mask_(detail::roundUpToPowerOfTwo(capacity) - 1),
+          cells_(new Cell[mask_ + 1]) {
+      for (size_t i = 0; i <= mask_; ++i) {
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+      }
+    }
+
+    MpmcRingBuffer(const MpmcRingBuffer &) = delete;
+    MpmcRingBuffer &operator=(const MpmcRingBuffer &) = delete;
+
+    /**
+     * Push value without waiting
+     * @return false if buffer is full or closed, value is not consumed then
+     */
+    bool tryPush(T &&value) {
+      if (not push_(std::move(value))) {
+        return false;
+      }
+      Base::notifyPushed();
+      return true;
+    }
+
+    /**
+     * Pop value without waiting
+     * @return false if buffer is empty
+     */
+    bool tryPop(T &value) {
+      if (not pop_(value)) {
+        return false;
+      }
+      Base::notifyPopped();
+      return true;
+    }
+
+    size_t capacity() const {
+      return mask_ + 1;
+    }
+
+    /**
+     * @return number of values in buffer, approximate while it is used
+     */
+    size_t size() const {
+      auto head = head_.load(std::memory_order_acquire);
+      auto tail = tail_.load(std::memory_order_acquire);
+      return tail > head ? tail - head : 0;
+    }
+
+   private:
+    struct Cell {
+      std::atomic<size_t> sequence;
+      T value;
+    };
+
+    bool push_(T &&value) {
+      if (Base::closed()) {
+        return false;
+      }
+      auto tail = tail_.load(std::memory_order_relaxed);
+      while (true) {
+        auto &cell = cells_[tail & mask_];
+        auto sequence = cell.sequence.load(std::memory_order_acquire);
+        auto lap = static_cast<std::ptrdiff_t>(sequence - tail);
+        if (lap == 0) {
+          if (tail_.compare_exchange_weak(
+                  tail, tail + 1, std::memory_order_relaxed)) {
+            cell.value = std::move(value);
+            cell.sequence.store(tail + 1, std::memory_order_release);
+            return true;
+          }
+        } else if (lap < 0) {
+          // slot still holds value of the previous lap
+          return false;
+        } else {
+          tail = tail_.load(std::memory_order_relaxed);
+        }
+      }
+    }
+
+    bool pop_(T &value) {
+      auto head = head_.load(std::memory_order_relaxed);
+      while (true) {
+        auto &cell = cells_[head & mask_];
+        auto sequence = cell.sequence.load(std::memory_order_acquire);
+        auto lap = static_cast<std::ptrdiff_t>(sequence - (head + 1));
+        if (lap == 0) {
+          if (head_.compare_exchange_weak(
+                  head, head + 1, std::memory_order_relaxed)) {
+            value = std::move(cell.value);
+            cell.sequence.store(head + mask_ + 1, std::memory_order_release);
+            return true;
+          }
+        } else if (lap < 0) {
+          // slot is not filled yet
+          return false;
+        } else {
+          head = head_.load(std::memory_order_relaxed);
+        }
+      }
+    }
+
+    const size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+
+    alignas(kCacheLineSize) std::atomic<size_t> head_{0};
+    alignas(kCacheLineSize) std::atomic<size_t> tail_{0};
+    alignas(kCacheLineSize) char padding_[1];
+  };
+
+}  // namespace iroha
+
+#endif  // IROHA_RING_BUFFER_HPP
@@ -17,16 +17,13 @@ limitations under the License.
 #include "timer.hpp"
 #include <chrono>
 #include <thread>
+#include "timer_wheel.hpp"
 
 namespace timer {
 
 void setAwkTimer(int const sleepMillisecs,
                  std::function<void(void)> const &action) {
-  std::thread([action, sleepMillisecs]() {
-    std::this_thread::sleep_for(std::chrono::milliseconds(sleepMillisecs));
-    action();
-  })
-      .join();
+  wheel().schedule(std::chrono::milliseconds(sleepMillisecs), action);
 }
 
 void setAwkTimerForCurrentThread(int const sleepMillisecs,
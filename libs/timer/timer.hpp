@@ -21,6 +21,9 @@ limitations under the License.
 
 namespace timer {
 
+/**
+ * Run action on the shared timer wheel after delay, without waiting
+ */
 void setAwkTimer(int const sleepMillisecs,
                  std::function<void(void)> const &action);
 
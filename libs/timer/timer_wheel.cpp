@@ -0,0 +1,172 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "timer/timer_wheel.hpp"
+#include <algorithm>
+
+namespace timer {
+
+  constexpr size_t TimerWheel::kLevels;
+  constexpr size_t TimerWheel::kSlotBits;
+  constexpr size_t TimerWheel::kSlots;
+
+  namespace {
+    /**
+     * @return number of ticks covered by one slot of level
+     */
+    constexpr uint64_t span(size_t level) {
+      return uint64_t(1) << (TimerWheel::kSlotBits * level);
+    }
+  }  // namespace
+
+  TimerWheel::TimerWheel(std::chrono::milliseconds tick)
+      : tick_(std::max(tick, std::chrono::milliseconds(1))),
+        start_(std::chrono::steady_clock::now()),
+        thread_(&TimerWheel::run, this) {}
+
+  TimerWheel::Id TimerWheel::schedule(std::chrono::milliseconds delay,
+                                      Action action) {
+    auto since_start = std::chrono::steady_clock::now() - start_
+        + std::max(delay, std::chrono::milliseconds::zero());
+    // rounded up, so timer never fires before its delay
+    auto deadline = static_cast<uint64_t>(
+        (since_start + tick_ - std::chrono::nanoseconds(1)) / tick_);
+    bool idle;
+    Id id;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      idle = timers_.empty();
+      if (idle) {
+        // wheel does not turn while it is empty, all slots are empty too
+        now_ = std::max(now_, elapsed());
+      }
+      id = ++next_id_;
+      insert({id, std::max(deadline, now_ + 1), std::move(action)});
+    }
+    if (idle) {
+      // thread sleeps without deadline while there are no timers
+      wakeup_.notify_one();
+    }
+    return id;
+  }
+
+  bool TimerWheel::cancel(Id id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto location = timers_.find(id);
+    if (location == timers_.end()) {
+      return false;
+    }
+    location->second.slot->erase(location->second.timer);
+    timers_.erase(location);
+    return true;
+  }
+
+  size_t TimerWheel::pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return timers_.size();
+  }
+
+  TimerWheel::~TimerWheel() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopped_ = true;
+    }
+    wakeup_.notify_one();
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  void TimerWheel::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (not stopped_) {
+      if (timers_.empty()) {
+        wakeup_.wait(lock);
+        continue;
+      }
+      auto next = start_ + tick_ * (now_ + 1);
+      if (wakeup_.wait_until(lock, next) != std::cv_status::timeout
+          and std::chrono::steady_clock::now() < next) {
+        continue;
+      }
+      // catch up with the clock, if the thread was late
+      auto target = elapsed();
+      while (now_ < target and not stopped_) {
+        auto due = advance();
+        if (due.empty()) {
+          continue;
+        }
+        lock.unlock();
+        for (auto &timer : due) {
+          timer.action();
+        }
+        lock.lock();
+      }
+    }
+  }
+
+  uint64_t TimerWheel::elapsed() const {
+    return static_cast<uint64_t>((std::chrono::steady_clock::now() - start_)
+                                 / tick_);
+  }
+
+  void TimerWheel::insert(Timer timer) {
+    auto distance = timer.deadline - now_;
+    size_t level = 0;
+    while (level + 1 < kLevels and distance >= span(level + 1)) {
+      ++level;
+    }
+    // deadline beyond the last level is parked in its farthest slot
+    auto position = distance >= span(kLevels)
+        ? now_ + span(kLevels) - span(kLevels - 1)
+        : timer.deadline;
+    auto &slot = levels_[level][(position >> (kSlotBits * level)) % kSlots];
+    auto id = timer.id;
+    slot.push_back(std::move(timer));
+    timers_[id] = {&slot, std::prev(slot.end())};
+  }
+
+  bool TimerWheel::cascade(size_t level) {
+    auto index = (now_ >> (kSlotBits * level)) % kSlots;
+    Slot moved;
+    moved.swap(levels_[level][index]);
+    for (auto &timer : moved) {
+      insert(std::move(timer));
+    }
+    return index == 0;
+  }
+
+  TimerWheel::Slot TimerWheel::advance() {
+    ++now_;
+    if (now_ % kSlots == 0) {
+      for (size_t level = 1; level < kLevels and cascade(level); ++level) {
+      }
+    }
+    Slot due;
+    due.swap(levels_[0][now_ % kSlots]);
+    for (const auto &timer : due) {
+      timers_.erase(timer.id);
+    }
+    return due;
+  }
+
+  TimerWheel &wheel() {
+    static TimerWheel wheel;
+    return wheel;
+  }
+
+}  // namespace timer
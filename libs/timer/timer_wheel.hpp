@@ -0,0 +1,146 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_TIMER_WHEEL_HPP
+#define IROHA_TIMER_WHEEL_HPP
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace timer {
+
+  /**
+   * Hierarchical timing wheel which runs timers of many components on one
+   * thread. Each level has kSlots slots, a slot of level covers kSlots
+   * slots of the level below, and timers due in a far slot are moved down
+   * when the wheel reaches it. Scheduling and cancellation are O(1), and
+   * the caller never waits for the timer.
+   * Actions run on the thread of the wheel one by one, so they must be
+   * short: components post their work to own executors.
+   */
+  class TimerWheel {
+   public:
+    using Id = uint64_t;
+    using Action = std::function<void()>;
+
+    static constexpr size_t kLevels = 4;
+    static constexpr size_t kSlotBits = 6;
+    static constexpr size_t kSlots = 1u << kSlotBits;
+
+    /**
+     * @param tick - resolution of the wheel, timers fire within one tick
+     * after their delay; delays up to kSlots^kLevels ticks are kept in
+     * place, longer ones are parked in the last level and placed again
+     * when it turns
+     */
+    explicit TimerWheel(
+        std::chrono::milliseconds tick = std::chrono::milliseconds(1));
+
+    TimerWheel(const TimerWheel &) = delete;
+    TimerWheel &operator=(const TimerWheel &) = delete;
+
+    /**
+     * Run action after delay
+     * @return id of timer for cancellation
+     */
+    Id schedule(std::chrono::milliseconds delay, Action action);
+
+    /**
+     * Cancel timer which has not fired yet
+     * @return false if timer has fired, is firing or is unknown
+     */
+    bool cancel(Id id);
+
+    /**
+     * @return number of timers which have not fired yet
+     */
+    size_t pending() const;
+
+    /**
+     * Stop the thread, pending timers are dropped
+     */
+    ~TimerWheel();
+
+   private:
+    struct Timer {
+      Id id;
+      uint64_t deadline;
+      Action action;
+    };
+
+    using Slot = std::list<Timer>;
+
+    struct Location {
+      Slot *slot;
+      Slot::iterator timer;
+    };
+
+    void run();
+
+    /**
+     * @return number of whole ticks since start of the wheel
+     */
+    uint64_t elapsed() const;
+
+    /**
+     * Put timer into slot of its deadline, must be called under lock
+     */
+    void insert(Timer timer);
+
+    /**
+     * Move timers of current slot of level down, must be called under lock
+     * @return true if the level has turned over as well
+     */
+    bool cascade(size_t level);
+
+    /**
+     * Advance the wheel by one tick, must be called under lock
+     * @return timers which are due
+     */
+    Slot advance();
+
+    const std::chrono::milliseconds tick_;
+    const std::chrono::steady_clock::time_point start_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable wakeup_;
+    bool stopped_ = false;
+
+    // the last processed tick
+    uint64_t now_ = 0;
+    Id next_id_ = 0;
+    std::array<std::array<Slot, kSlots>, kLevels> levels_;
+    std::unordered_map<Id, Location> timers_;
+
+    std::thread thread_;
+  };
+
+  /**
+   * @return wheel shared by components of the process
+   */
+  TimerWheel &wheel();
+
+}  // namespace timer
+
+#endif  // IROHA_TIMER_WHEEL_HPP
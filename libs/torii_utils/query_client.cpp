@@ -24,8 +24,11 @@ namespace torii_utils {
   using iroha::protocol::QueryResponse;
 
   QuerySyncClient::QuerySyncClient(const std::string& ip, const int port)
+    : QuerySyncClient(ip + ":" + std::to_string(port)) {}
+
+  QuerySyncClient::QuerySyncClient(const std::string& target)
     : stub_(iroha::protocol::QueryService::NewStub(
-    grpc::CreateChannel(ip + ":" + std::to_string(port), grpc::InsecureChannelCredentials())))
+    grpc::CreateChannel(target, grpc::InsecureChannelCredentials())))
   {}
 
   QuerySyncClient::~QuerySyncClient() {
@@ -64,4 +67,31 @@ namespace torii_utils {
     return status_;
   }
 
+  grpc::Status QuerySyncClient::FindStream(
+      const iroha::protocol::Query &query,
+      std::function<void(const QueryResponse &)> handler) {
+    grpc::ClientContext context;
+    auto reader = stub_->FindStream(&context, query);
+    QueryResponse response;
+    while (reader->Read(&response)) {
+      handler(response);
+    }
+    return reader->Finish();
+  }
+
+  grpc::Status QuerySyncClient::Subscribe(
+      const iroha::protocol::Query &query,
+      std::function<bool(const QueryResponse &)> handler) {
+    grpc::ClientContext context;
+    auto reader = stub_->Subscribe(&context, query);
+    QueryResponse response;
+    while (reader->Read(&response)) {
+      if (not handler(response)) {
+        context.TryCancel();
+        break;
+      }
+    }
+    return reader->Finish();
+  }
+
 }  // namespace torii
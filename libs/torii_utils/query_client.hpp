@@ -21,6 +21,7 @@ limitations under the License.
 #include <endpoint.pb.h>
 #include <grpc++/grpc++.h>
 #include <grpc++/channel.h>
+#include <functional>
 #include <memory>
 #include <thread>
 
@@ -32,6 +33,11 @@ namespace torii_utils {
   class QuerySyncClient {
   public:
     QuerySyncClient(const std::string& ip, const int port);
+
+    /**
+     * @param target - address of torii, host:port or unix:path
+     */
+    explicit QuerySyncClient(const std::string& target);
     ~QuerySyncClient();
 
     /**
@@ -42,6 +48,28 @@ namespace torii_utils {
      */
     grpc::Status Find(const iroha::protocol::Query &query, iroha::protocol::QueryResponse &response);
 
+    /**
+     * requests query and receives its response in parts (blocking, sync)
+     * @param query - contains Query what clients request.
+     * @param handler - called for every received part of response.
+     * @return grpc::Status
+     */
+    grpc::Status FindStream(
+        const iroha::protocol::Query &query,
+        std::function<void(const iroha::protocol::QueryResponse &)> handler);
+
+    /**
+     * subscribes to history of query and transactions of following blocks
+     * (blocking, sync)
+     * @param query - history query with page size
+     * @param handler - called for every received response, returns false to
+     * cancel the subscription
+     * @return grpc::Status
+     */
+    grpc::Status Subscribe(
+        const iroha::protocol::Query &query,
+        std::function<bool(const iroha::protocol::QueryResponse &)> handler);
+
   private:
     grpc::ClientContext context_;
     std::unique_ptr<iroha::protocol::QueryService::Stub> stub_;
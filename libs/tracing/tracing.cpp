@@ -0,0 +1,317 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "tracing/tracing.hpp"
+#include <algorithm>
+#include <fstream>
+#include <random>
+
+namespace iroha {
+  namespace tracing {
+
+    constexpr size_t Tracer::kBatchSize;
+
+    namespace {
+      std::mt19937_64 &generator() {
+        thread_local std::mt19937_64 generator(std::random_device{}());
+        return generator;
+      }
+
+      template <size_t N>
+      std::array<uint8_t, N> randomId() {
+        std::array<uint8_t, N> id;
+        // id of zeros is invalid
+        do {
+          for (size_t i = 0; i < N; i += 8) {
+            auto value = generator()();
+            for (size_t j = i; j < std::min(N, i + 8); ++j) {
+              id[j] = static_cast<uint8_t>(value >> (8 * (j - i)));
+            }
+          }
+        } while (std::all_of(
+            id.begin(), id.end(), [](auto byte) { return byte == 0; }));
+        return id;
+      }
+
+      template <size_t N>
+      std::string hex(const std::array<uint8_t, N> &bytes) {
+        static const char digits[] = "0123456789abcdef";
+        std::string result;
+        result.reserve(2 * N);
+        for (auto byte : bytes) {
+          result += digits[byte >> 4];
+          result += digits[byte & 0xf];
+        }
+        return result;
+      }
+
+      int digit(char c) {
+        if (c >= '0' and c <= '9') {
+          return c - '0';
+        }
+        if (c >= 'a' and c <= 'f') {
+          return c - 'a' + 10;
+        }
+        return -1;
+      }
+
+      template <size_t N>
+      bool unhex(const std::string &value,
+                 size_t offset,
+                 std::array<uint8_t, N> &bytes) {
+        for (size_t i = 0; i < N; ++i) {
+          auto high = digit(value[offset + 2 * i]);
+          auto low = digit(value[offset + 2 * i + 1]);
+          if (high < 0 or low < 0) {
+            return false;
+          }
+          bytes[i] = static_cast<uint8_t>(high << 4 | low);
+        }
+        return true;
+      }
+
+      template <size_t N>
+      bool isZero(const std::array<uint8_t, N> &bytes) {
+        return std::all_of(
+            bytes.begin(), bytes.end(), [](auto byte) { return byte == 0; });
+      }
+
+      std::string quote(const std::string &value) {
+        std::string result = "\"";
+        for (auto c : value) {
+          switch (c) {
+            case '"':
+              result += "\\\"";
+              break;
+            case '\\':
+              result += "\\\\";
+              break;
+            case '\n':
+              result += "\\n";
+              break;
+            default:
+              if (static_cast<unsigned char>(c) < 0x20) {
+                static const char digits[] = "0123456789abcdef";
+                result += "\\u00";
+                result += digits[c >> 4];
+                result += digits[c & 0xf];
+              } else {
+                result += c;
+              }
+          }
+        }
+        return result + "\"";
+      }
+
+      uint64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::system_clock::now().time_since_epoch())
+            .count();
+      }
+    }  // namespace
+
+    // TraceContext
+
+    std::string TraceContext::traceparent() const {
+      return "00-" + hex(trace_id) + "-" + hex(span_id)
+          + (sampled ? "-01" : "-00");
+    }
+
+    nonstd::optional<TraceContext> TraceContext::parse(
+        const std::string &value) {
+      // version 00 has 55 characters, later versions may append fields
+      if (value.size() < 55 or (value.size() > 55 and value[55] != '-')
+          or value[2] != '-' or value[35] != '-' or value[52] != '-'
+          or value.compare(0, 2, "ff") == 0) {
+        return nonstd::nullopt;
+      }
+      std::array<uint8_t, 1> version, flags;
+      TraceContext context;
+      if (not unhex(value, 0, version) or not unhex(value, 3, context.trace_id)
+          or not unhex(value, 36, context.span_id)
+          or not unhex(value, 53, flags) or isZero(context.trace_id)
+          or isZero(context.span_id)
+          or (version[0] == 0 and value.size() != 55)) {
+        return nonstd::nullopt;
+      }
+      context.sampled = flags[0] & 1;
+      return context;
+    }
+
+    // Tracer
+
+    Tracer::~Tracer() {
+      flush();
+    }
+
+    void Tracer::configure(double ratio, const std::string &path) {
+      std::lock_guard<std::mutex> lock(lock_);
+      path_ = path;
+      ratio_ = ratio;
+      enabled_ = not path.empty();
+    }
+
+    nonstd::optional<TraceContext> Tracer::sample(
+        const nonstd::optional<TraceContext> &parent) {
+      if (not enabled()) {
+        return nonstd::nullopt;
+      }
+      if (parent) {
+        return parent->sampled ? parent : nonstd::nullopt;
+      }
+      auto ratio = ratio_.load(std::memory_order_relaxed);
+      if (ratio <= 0
+          or (ratio < 1
+              and std::generate_canonical<double, 32>(generator())
+                  >= ratio)) {
+        return nonstd::nullopt;
+      }
+      TraceContext context;
+      context.trace_id = randomId<16>();
+      context.sampled = true;
+      return context;
+    }
+
+    void Tracer::record(SpanData span) {
+      std::vector<SpanData> batch;
+      {
+        std::lock_guard<std::mutex> lock(lock_);
+        if (path_.empty()) {
+          return;
+        }
+        spans_.push_back(std::move(span));
+        if (spans_.size() < kBatchSize) {
+          return;
+        }
+        batch.swap(spans_);
+      }
+      write(batch);
+    }
+
+    void Tracer::flush() {
+      std::vector<SpanData> batch;
+      {
+        std::lock_guard<std::mutex> lock(lock_);
+        batch.swap(spans_);
+      }
+      if (not batch.empty()) {
+        write(batch);
+      }
+    }
+
+    void Tracer::write(const std::vector<SpanData> &spans) {
+      std::string path;
+      {
+        std::lock_guard<std::mutex> lock(lock_);
+        path = path_;
+      }
+      std::lock_guard<std::mutex> lock(write_lock_);
+      std::ofstream file(path, std::ios::app);
+      file << toOtlpJson(spans) << "\n";
+    }
+
+    std::string Tracer::toOtlpJson(const std::vector<SpanData> &spans) {
+      std::string json =
+          "{\"resourceSpans\":[{\"resource\":{\"attributes\":[{\"key\":"
+          "\"service.name\",\"value\":{\"stringValue\":\"irohad\"}}]},"
+          "\"scopeSpans\":[{\"scope\":{\"name\":\"iroha\"},\"spans\":[";
+      for (size_t i = 0; i < spans.size(); ++i) {
+        const auto &span = spans[i];
+        if (i != 0) {
+          json += ",";
+        }
+        json += "{\"traceId\":\"" + hex(span.trace_id) + "\",\"spanId\":\""
+            + hex(span.span_id) + "\"";
+        if (not isZero(span.parent_span_id)) {
+          json += ",\"parentSpanId\":\"" + hex(span.parent_span_id) + "\"";
+        }
+        // 1 is SPAN_KIND_INTERNAL, 64-bit integers are strings in OTLP/JSON
+        json += ",\"name\":" + quote(span.name)
+            + ",\"kind\":1,\"startTimeUnixNano\":\""
+            + std::to_string(span.start_ns) + "\",\"endTimeUnixNano\":\""
+            + std::to_string(span.end_ns) + "\",\"attributes\":[";
+        for (size_t j = 0; j < span.attributes.size(); ++j) {
+          if (j != 0) {
+            json += ",";
+          }
+          json += "{\"key\":" + quote(span.attributes[j].first)
+              + ",\"value\":{\"stringValue\":"
+              + quote(span.attributes[j].second) + "}}";
+        }
+        json += "]}";
+      }
+      return json + "]}]}]}";
+    }
+
+    Tracer &tracer() {
+      static Tracer tracer;
+      return tracer;
+    }
+
+    // Span
+
+    Span::Span(const char *name, const nonstd::optional<TraceContext> &parent) {
+      if (not parent or not parent->sampled or not tracer().enabled()) {
+        return;
+      }
+      data_ = SpanData{parent->trace_id,
+                       randomId<8>(),
+                       parent->span_id,
+                       name,
+                       nowNs(),
+                       0,
+                       {}};
+    }
+
+    Span::Span(Span &&other) : data_(std::move(other.data_)) {
+      other.data_ = nonstd::nullopt;
+    }
+
+    Span::~Span() {
+      if (data_) {
+        data_->end_ns = nowNs();
+        tracer().record(std::move(*data_));
+      }
+    }
+
+    void Span::start(std::chrono::steady_clock::time_point time) {
+      if (data_) {
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - time);
+        data_->start_ns = nowNs() - elapsed.count();
+      }
+    }
+
+    void Span::attribute(const std::string &key, const std::string &value) {
+      if (data_) {
+        data_->attributes.emplace_back(key, value);
+      }
+    }
+
+    nonstd::optional<TraceContext> Span::context() const {
+      if (not data_) {
+        return nonstd::nullopt;
+      }
+      TraceContext context;
+      context.trace_id = data_->trace_id;
+      context.span_id = data_->span_id;
+      context.sampled = true;
+      return context;
+    }
+
+  }  // namespace tracing
+}  // namespace iroha
@@ -0,0 +1,207 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_TRACING_HPP
+#define IROHA_TRACING_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <nonstd/optional.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace iroha {
+  namespace tracing {
+
+    using TraceId = std::array<uint8_t, 16>;
+    using SpanId = std::array<uint8_t, 8>;
+
+    /**
+     * Position of work in a distributed trace, propagated between
+     * components and peers in W3C traceparent format
+     */
+    struct TraceContext {
+      TraceId trace_id{};
+      // span which following spans are children of, zero for new trace
+      SpanId span_id{};
+      bool sampled = false;
+
+      /**
+       * @return value of traceparent header, e.g.
+       * 00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01
+       */
+      std::string traceparent() const;
+
+      /**
+       * @return context of traceparent header, none if it is malformed
+       */
+      static nonstd::optional<TraceContext> parse(const std::string &value);
+    };
+
+    /**
+     * Finished span, as exported
+     */
+    struct SpanData {
+      TraceId trace_id;
+      SpanId span_id;
+      SpanId parent_span_id;
+      std::string name;
+      uint64_t start_ns;
+      uint64_t end_ns;
+      std::vector<std::pair<std::string, std::string>> attributes;
+    };
+
+    /**
+     * Decides which traces are sampled and exports their spans as
+     * OpenTelemetry (OTLP/JSON) ExportTraceServiceRequest lines to a file,
+     * which a collector reads with its file receiver.
+     * Thread safe.
+     */
+    class Tracer {
+     public:
+      // spans buffered before they are written to file
+      static constexpr size_t kBatchSize = 256;
+
+      ~Tracer();
+
+      /**
+       * @param ratio - fraction of new traces sampled, traces sampled by
+       * other peers and clients are followed also with 0
+       * @param path - file spans are appended to, empty disables tracing
+       */
+      void configure(double ratio, const std::string &path);
+
+      /**
+       * @return true if spans are exported
+       */
+      bool enabled() const {
+        return enabled_.load(std::memory_order_relaxed);
+      }
+
+      /**
+       * Decide on sampling of work
+       * @param parent - context received with work, sampling decision of
+       * its origin is kept
+       * @return sampled context, none if work is not traced
+       */
+      nonstd::optional<TraceContext> sample(
+          const nonstd::optional<TraceContext> &parent = nonstd::nullopt);
+
+      /**
+       * Buffer finished span of sampled trace
+       */
+      void record(SpanData span);
+
+      /**
+       * Write buffered spans to file
+       */
+      void flush();
+
+      /**
+       * @return spans as ExportTraceServiceRequest in OTLP/JSON encoding
+       */
+      static std::string toOtlpJson(const std::vector<SpanData> &spans);
+
+     private:
+      void write(const std::vector<SpanData> &spans);
+
+      // checked without lock, so unsampled work does not contend
+      std::atomic<bool> enabled_{false};
+      std::atomic<double> ratio_{0};
+      std::string path_;
+      std::vector<SpanData> spans_;
+      std::mutex lock_;
+      // batches are appended as whole lines
+      std::mutex write_lock_;
+    };
+
+    /**
+     * @return tracer shared by all components of the peer
+     */
+    Tracer &tracer();
+
+    /**
+     * Span of work of one component, recorded when destroyed. Span of
+     * unsampled work is empty and costs one branch
+     */
+    class Span {
+     public:
+      /**
+       * @param name - name of operation
+       * @param parent - sampled context of work, none if not traced
+       */
+      Span(const char *name, const nonstd::optional<TraceContext> &parent);
+
+      Span(Span &&other);
+
+      ~Span();
+
+      Span(const Span &) = delete;
+      Span &operator=(const Span &) = delete;
+
+      /**
+       * @return true if span is recorded
+       */
+      explicit operator bool() const {
+        return static_cast<bool>(data_);
+      }
+
+      /**
+       * Move start of span back, e.g. to the moment work was received
+       */
+      void start(std::chrono::steady_clock::time_point time);
+
+      void attribute(const std::string &key, const std::string &value);
+
+      /**
+       * @return context of children of this span, none if not sampled
+       */
+      nonstd::optional<TraceContext> context() const;
+
+     private:
+      nonstd::optional<SpanData> data_;
+    };
+
+    /**
+     * Record span of the same interval for every sampled transaction of
+     * a batch, e.g. of proposal or block, till now
+     * @param transactions - range of objects with trace member
+     * @param start - beginning of the work on batch
+     * @param height - height of batch, added as attribute
+     */
+    template <typename Transactions>
+    void traceEach(const char *name,
+                   const Transactions &transactions,
+                   std::chrono::steady_clock::time_point start,
+                   uint64_t height) {
+      for (const auto &transaction : transactions) {
+        if (transaction.trace) {
+          Span span(name, transaction.trace);
+          span.start(start);
+          span.attribute("height", std::to_string(height));
+        }
+      }
+    }
+
+  }  // namespace tracing
+}  // namespace iroha
+
+#endif  // IROHA_TRACING_HPP
@@ -72,7 +72,7 @@ class ClientServerTest : public testing::Test {
           std::make_shared<iroha::model::converters::PbQueryResponseFactory>();
 
       auto query_service = std::make_unique<torii::QueryService>(
-          pb_query_factory, pb_query_resp_factory, qpi);
+          pb_query_factory, pb_query_resp_factory, qpi, block_query);
 
       //----------- Server run ----------------
       runner->run(std::move(command_service), std::move(query_service));
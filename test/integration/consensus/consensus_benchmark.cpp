@@ -0,0 +1,199 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <map>
+#include "consensus/yac/impl/peer_orderer_impl.hpp"
+#include "consensus/yac/yac.hpp"
+#include "integration/consensus/yac_simulation.hpp"
+#include "module/irohad/consensus/yac/yac_mocks.hpp"
+
+using namespace simulation;
+
+/**
+ * Parameters of one simulated run
+ */
+struct Scenario {
+  size_t peers;
+  size_t rounds;
+  NetworkConditions conditions;
+  uint64_t delay;
+  uint32_t seed = 42;
+};
+
+/**
+ * Outcome of simulated run
+ */
+struct Result {
+  // committed rounds of every peer
+  std::vector<size_t> committed;
+  // time between vote and commit of every peer in every round
+  std::vector<uint64_t> latencies;
+  // virtual time of the last commit
+  uint64_t duration = 0;
+  uint64_t messages = 0;
+  uint64_t dropped = 0;
+  uint64_t wall_ms = 0;
+};
+
+/**
+ * Run cluster of yac instances until all rounds are committed or nothing
+ * is left to happen. Every peer starts the next round right after commit.
+ */
+Result simulate(const Scenario &scenario) {
+  auto started = std::chrono::steady_clock::now();
+  auto clock = std::make_shared<VirtualClock>();
+  SimulatedNetwork network(clock, scenario.conditions, scenario.seed);
+
+  std::vector<iroha::model::Peer> peers(scenario.peers);
+  for (size_t i = 0; i < scenario.peers; ++i) {
+    peers[i].address = std::to_string(i);
+  }
+
+  Result result;
+  result.committed.assign(scenario.peers, 0);
+  std::vector<uint64_t> voted_at(scenario.peers, 0);
+  std::vector<std::shared_ptr<Yac>> cluster;
+
+  auto vote = [&](size_t peer, size_t round) {
+    auto hash = mk_hash("proposal_" + std::to_string(round),
+                        "block_" + std::to_string(round));
+    voted_at[peer] = clock->now();
+    auto order =
+        PeerOrdererImpl::permute(peers, hash.proposal_hash.to_string());
+    cluster[peer]->vote(hash, ClusterOrdering(order));
+  };
+
+  for (size_t i = 0; i < scenario.peers; ++i) {
+    auto endpoint = network.join(i);
+    auto yac = Yac::create(YacVoteStorage(),
+                           endpoint,
+                           std::make_shared<SimulatedCryptoProvider>(i),
+                           std::make_shared<VirtualTimer>(clock),
+                           ClusterOrdering(peers),
+                           scenario.delay);
+    endpoint->subscribe(yac);
+    yac->on_commit().subscribe([&, i](const CommitMessage &commit) {
+      // zero padding of hash terminates the round number
+      auto proposal = commit.votes.at(0).hash.proposal_hash.to_string();
+      auto round = std::stoul(proposal.substr(sizeof("proposal_") - 1));
+      if (round != result.committed[i]) {
+        return;
+      }
+      result.latencies.push_back(clock->now() - voted_at[i]);
+      result.duration = clock->now();
+      if (++result.committed[i] < scenario.rounds) {
+        // vote outside of commit handling, which closes the round after
+        clock->schedule(0, [&, i] { vote(i, result.committed[i]); });
+      }
+    });
+    cluster.push_back(yac);
+  }
+
+  for (size_t i = 0; i < scenario.peers; ++i) {
+    vote(i, 0);
+  }
+  clock->runUntil(std::numeric_limits<uint64_t>::max());
+
+  result.messages = network.sent();
+  result.dropped = network.dropped();
+  result.wall_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                       std::chrono::steady_clock::now() - started)
+                       .count();
+  return result;
+}
+
+void report(const Scenario &scenario, const Result &result) {
+  auto complete = std::count(
+      result.committed.begin(), result.committed.end(), scenario.rounds);
+  auto rounds = *std::max_element(result.committed.begin(),
+                                  result.committed.end());
+  std::cout << "peers=" << scenario.peers << " rounds=" << rounds
+            << " complete_peers=" << complete << " commits/s="
+            << (result.duration ? rounds * 1000.0 / result.duration : 0)
+            << " latency_ms p50=" << percentile(result.latencies, 0.5)
+            << " p90=" << percentile(result.latencies, 0.9)
+            << " p99=" << percentile(result.latencies, 0.99)
+            << " messages=" << result.messages
+            << " dropped=" << result.dropped << " wall_ms=" << result.wall_ms
+            << std::endl;
+}
+
+class ConsensusBenchmark : public ::testing::TestWithParam<size_t> {};
+
+/**
+ * @given cluster of peers connected by network with latency and jitter
+ * @when peers vote for consecutive rounds
+ * @then every peer commits every round
+ */
+TEST_P(ConsensusBenchmark, ClusterCommitsAllRounds) {
+  Scenario scenario{GetParam(), 20, {}, 200};
+  scenario.conditions.latency = 10;
+  scenario.conditions.jitter = 5;
+
+  auto result = simulate(scenario);
+  report(scenario, result);
+
+  for (auto committed : result.committed) {
+    ASSERT_EQ(committed, scenario.rounds);
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(ClusterSizes,
+                        ConsensusBenchmark,
+                        ::testing::Values(4, 10, 25, 50, 100));
+
+/**
+ * @given cluster of 4 peers, one of them is isolated for the first second
+ * @when peers vote for consecutive rounds
+ * @then remaining supermajority commits all rounds
+ */
+TEST(ConsensusSimulationTest, SupermajorityCommitsDuringPartition) {
+  Scenario scenario{4, 20, {}, 200};
+  scenario.conditions.partitions.push_back(Partition{0, 1000, {3}});
+
+  auto result = simulate(scenario);
+  report(scenario, result);
+
+  for (size_t i = 0; i < 3; ++i) {
+    ASSERT_EQ(result.committed[i], scenario.rounds);
+  }
+  ASSERT_GT(result.dropped, 0);
+}
+
+/**
+ * @given cluster of 7 peers with lossy network
+ * @when the same run is repeated with the same seed
+ * @then results are identical
+ */
+TEST(ConsensusSimulationTest, RunIsDeterministic) {
+  Scenario scenario{7, 10, {}, 200};
+  scenario.conditions.jitter = 20;
+  scenario.conditions.loss = 0.05;
+
+  auto first = simulate(scenario);
+  auto second = simulate(scenario);
+  report(scenario, first);
+
+  ASSERT_EQ(first.committed, second.committed);
+  ASSERT_EQ(first.latencies, second.latencies);
+  ASSERT_EQ(first.dropped, second.dropped);
+}
@@ -146,7 +146,7 @@ TEST_F(ConsensusSunnyDayTest, SunnyDayTest) {
   // Wait for other peers to start
   std::this_thread::sleep_for(std::chrono::milliseconds(delay_before));
 
-  YacHash my_hash("proposal_hash", "block_hash");
+  auto my_hash = mk_hash("proposal_hash", "block_hash");
   yac->vote(my_hash, ClusterOrdering(default_peers));
   std::this_thread::sleep_for(
       std::chrono::milliseconds(delay_after));
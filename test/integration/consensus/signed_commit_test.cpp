@@ -0,0 +1,97 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "module/irohad/ametsuchi/ametsuchi_mocks.hpp"
+#include "module/irohad/consensus/yac/yac_mocks.hpp"
+#include "module/irohad/network/network_mocks.hpp"
+#include "module/irohad/simulator/simulator_mocks.hpp"
+
+#include <rxcpp/rx.hpp>
+#include "consensus/yac/impl/yac_crypto_provider_impl.hpp"
+#include "consensus/yac/impl/yac_gate_impl.hpp"
+#include "consensus/yac/impl/yac_hash_provider_impl.hpp"
+#include "crypto/crypto.hpp"
+#include "model/model_crypto_provider_impl.hpp"
+#include "model/model_hash_provider_impl.hpp"
+#include "validation/impl/chain_validator_impl.hpp"
+
+using namespace iroha;
+using namespace iroha::consensus::yac;
+
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::Return;
+
+/**
+ * @given single peer with real key, voting for its block through YAC gate
+ * @when block of the commit is validated with verified signatures
+ * @then block is accepted, since votes sign the block hash
+ */
+TEST(SignedCommitTest, CommittedBlockHasValidSignatures) {
+  auto keypair = create_keypair(create_seed());
+  model::Peer peer;
+  peer.address = "0.0.0.0:10001";
+  peer.pubkey = keypair.pubkey;
+  auto crypto = std::make_shared<YacCryptoProviderImpl>(keypair);
+
+  // supermajority of the single peer is reached by its own vote
+  rxcpp::subjects::subject<CommitMessage> commits;
+  auto hash_gate = std::make_shared<MockHashGate>();
+  EXPECT_CALL(*hash_gate, on_commit())
+      .WillOnce(Return(commits.get_observable()));
+  EXPECT_CALL(*hash_gate, vote(_, _))
+      .WillOnce(Invoke([&](YacHash hash, ClusterOrdering) {
+        commits.get_subscriber().on_next(
+            CommitMessage({crypto->getVote(hash)}));
+      }));
+  auto orderer = std::make_shared<MockYacPeerOrderer>();
+  EXPECT_CALL(*orderer, getOrdering(_))
+      .WillOnce(Return(ClusterOrdering({peer})));
+
+  rxcpp::subjects::subject<std::shared_ptr<const model::Block>> blocks;
+  auto block_creator = std::make_shared<simulator::MockBlockCreator>();
+  EXPECT_CALL(*block_creator, on_block())
+      .WillOnce(Return(blocks.get_observable()));
+
+  YacGateImpl gate(hash_gate,
+                   orderer,
+                   std::make_shared<YacHashProviderImpl>(),
+                   block_creator,
+                   std::make_shared<network::MockBlockLoader>());
+  std::shared_ptr<const model::Block> committed;
+  gate.on_commit().subscribe([&committed](auto block) { committed = block; });
+
+  // block is built as block creator does
+  model::Block block;
+  block.height = 2;
+  block.created_ts = 100500;
+  block.txs_number = 0;
+  block.hash = model::HashProviderImpl().get_hash(block);
+  blocks.get_subscriber().on_next(
+      std::make_shared<const model::Block>(block));
+  ASSERT_TRUE(committed);
+  ASSERT_EQ(1, committed->sigs.size());
+
+  ametsuchi::MockMutableStorage storage;
+  EXPECT_CALL(storage, getPeers())
+      .WillOnce(Return(std::vector<model::Peer>({peer})));
+  EXPECT_CALL(storage, apply(_, _)).WillOnce(Return(true));
+  validation::ChainValidatorImpl validator(
+      std::make_shared<model::ModelCryptoProviderImpl>(
+          model::SignatureCheck::Serial));
+  ASSERT_TRUE(validator.validateBlock(*committed, storage));
+}
@@ -0,0 +1,292 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_YAC_SIMULATION_HPP
+#define IROHA_YAC_SIMULATION_HPP
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <random>
+#include <set>
+#include <tuple>
+#include <vector>
+#include "consensus/yac/timer.hpp"
+#include "consensus/yac/yac_crypto_provider.hpp"
+#include "consensus/yac/yac_network_interface.hpp"
+
+namespace simulation {
+
+  using namespace iroha::consensus::yac;
+
+  /**
+   * Discrete event loop driven by virtual time in milliseconds.
+   * Events with equal time run in order of scheduling, so a run with the
+   * same seed always gives the same result.
+   */
+  class VirtualClock {
+   public:
+    uint64_t now() const { return now_; }
+
+    void schedule(uint64_t delay, std::function<void()> event) {
+      events_.push(Event{now_ + delay, sequence_++, std::move(event)});
+    }
+
+    /**
+     * Run events until there are none left or time passes the deadline
+     * @return number of executed events
+     */
+    uint64_t runUntil(uint64_t deadline) {
+      uint64_t executed = 0;
+      while (not events_.empty() and events_.top().time <= deadline) {
+        auto event = events_.top();
+        events_.pop();
+        now_ = event.time;
+        event.action();
+        ++executed;
+      }
+      now_ = std::max(now_, deadline);
+      return executed;
+    }
+
+   private:
+    struct Event {
+      uint64_t time;
+      uint64_t sequence;
+      std::function<void()> action;
+
+      bool operator<(const Event &rhs) const {
+        // priority queue keeps the largest element on top
+        return std::tie(time, sequence) > std::tie(rhs.time, rhs.sequence);
+      }
+    };
+
+    uint64_t now_ = 0;
+    uint64_t sequence_ = 0;
+    std::priority_queue<Event> events_;
+  };
+
+  /**
+   * Timer which fires in virtual time, one pending handler at a time
+   */
+  class VirtualTimer : public Timer {
+   public:
+    explicit VirtualTimer(std::shared_ptr<VirtualClock> clock)
+        : clock_(std::move(clock)) {}
+
+    void invokeAfterDelay(uint64_t millis,
+                          std::function<void()> handler) override {
+      auto generation = ++generation_;
+      clock_->schedule(millis, [this, generation, handler] {
+        if (generation == generation_) {
+          handler();
+        }
+      });
+    }
+
+    void deny() override { ++generation_; }
+
+   private:
+    std::shared_ptr<VirtualClock> clock_;
+    uint64_t generation_ = 0;
+  };
+
+  /**
+   * Peer is isolated from the rest of cluster within [begin, end)
+   */
+  struct Partition {
+    uint64_t begin;
+    uint64_t end;
+    std::set<size_t> isolated;
+  };
+
+  /**
+   * Conditions applied to every message between two peers
+   */
+  struct NetworkConditions {
+    uint64_t latency = 10;
+    uint64_t jitter = 0;
+    double loss = 0;
+    std::vector<Partition> partitions;
+  };
+
+  class SimulatedPeerNetwork;
+
+  /**
+   * In-process network of virtual peers, messages are delivered through
+   * the virtual clock with latency, jitter, loss and partitions applied
+   */
+  class SimulatedNetwork {
+   public:
+    SimulatedNetwork(std::shared_ptr<VirtualClock> clock,
+                     NetworkConditions conditions,
+                     uint32_t seed)
+        : clock_(std::move(clock)),
+          conditions_(std::move(conditions)),
+          random_(seed) {}
+
+    /**
+     * Create endpoint of peer with given index
+     */
+    std::shared_ptr<SimulatedPeerNetwork> join(size_t index);
+
+    /**
+     * Schedule delivery of message, unless it is lost
+     * @param deliver - invokes handler of recipient
+     */
+    void send(size_t from, size_t to, std::function<void()> deliver) {
+      ++sent_;
+      auto now = clock_->now();
+      for (const auto &partition : conditions_.partitions) {
+        auto crossed =
+            partition.isolated.count(from) != partition.isolated.count(to);
+        if (partition.begin <= now and now < partition.end and crossed) {
+          ++dropped_;
+          return;
+        }
+      }
+      if (conditions_.loss > 0
+          and std::uniform_real_distribution<>(0, 1)(random_)
+              < conditions_.loss) {
+        ++dropped_;
+        return;
+      }
+      auto delay = conditions_.latency;
+      if (conditions_.jitter > 0) {
+        delay += random_() % (conditions_.jitter + 1);
+      }
+      clock_->schedule(delay, std::move(deliver));
+    }
+
+    uint64_t sent() const { return sent_; }
+
+    uint64_t dropped() const { return dropped_; }
+
+    std::vector<std::weak_ptr<YacNetworkNotifications>> handlers;
+
+   private:
+    std::shared_ptr<VirtualClock> clock_;
+    NetworkConditions conditions_;
+    std::mt19937 random_;
+    uint64_t sent_ = 0;
+    uint64_t dropped_ = 0;
+  };
+
+  /**
+   * Endpoint of one virtual peer, peers are addressed by index in address
+   */
+  class SimulatedPeerNetwork : public YacNetwork {
+   public:
+    SimulatedPeerNetwork(SimulatedNetwork &network, size_t index)
+        : network_(network), index_(index) {
+      self_.address = std::to_string(index);
+    }
+
+    void subscribe(
+        std::shared_ptr<YacNetworkNotifications> handler) override {
+      network_.handlers.at(index_) = handler;
+    }
+
+    void send_commit(iroha::model::Peer to, CommitMessage commit) override {
+      deliver(to, [commit](auto &handler, auto from) {
+        handler.on_commit(from, commit);
+      });
+    }
+
+    void send_reject(iroha::model::Peer to, RejectMessage reject) override {
+      deliver(to, [reject](auto &handler, auto from) {
+        handler.on_reject(from, reject);
+      });
+    }
+
+    void send_vote(iroha::model::Peer to, VoteMessage vote) override {
+      deliver(to, [vote](auto &handler, auto from) {
+        handler.on_vote(from, vote);
+      });
+    }
+
+   private:
+    template <typename Handler>
+    void deliver(const iroha::model::Peer &to, Handler handler) {
+      auto target = std::stoul(to.address);
+      auto &handlers = network_.handlers;
+      auto from = self_;
+      network_.send(index_, target, [&handlers, target, from, handler] {
+        if (auto recipient = handlers.at(target).lock()) {
+          handler(*recipient, from);
+        }
+      });
+    }
+
+    SimulatedNetwork &network_;
+    size_t index_;
+    iroha::model::Peer self_;
+  };
+
+  inline std::shared_ptr<SimulatedPeerNetwork> SimulatedNetwork::join(
+      size_t index) {
+    if (handlers.size() <= index) {
+      handlers.resize(index + 1);
+    }
+    return std::make_shared<SimulatedPeerNetwork>(*this, index);
+  }
+
+  /**
+   * Crypto provider which accepts every message and marks votes with
+   * index of peer as public key, signatures cost nothing in simulation
+   */
+  class SimulatedCryptoProvider : public YacCryptoProvider {
+   public:
+    explicit SimulatedCryptoProvider(size_t index) {
+      pubkey_.fill(0);
+      std::memcpy(pubkey_.data(), &index, sizeof(index));
+    }
+
+    bool verify(CommitMessage) override { return true; }
+
+    bool verify(RejectMessage) override { return true; }
+
+    bool verify(VoteMessage) override { return true; }
+
+    VoteMessage getVote(YacHash hash) override {
+      VoteMessage vote;
+      vote.hash = std::move(hash);
+      vote.signature.pubkey = pubkey_;
+      return vote;
+    }
+
+   private:
+    decltype(VoteMessage().signature.pubkey) pubkey_;
+  };
+
+  /**
+   * @return value at given fraction of sorted values, 0 for empty set
+   */
+  inline uint64_t percentile(std::vector<uint64_t> values, double fraction) {
+    if (values.empty()) {
+      return 0;
+    }
+    std::sort(values.begin(), values.end());
+    auto index = static_cast<size_t>(fraction * (values.size() - 1));
+    return values.at(index);
+  }
+
+}  // namespace simulation
+
+#endif  // IROHA_YAC_SIMULATION_HPP
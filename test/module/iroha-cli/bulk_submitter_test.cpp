@@ -0,0 +1,77 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bulk_submitter.hpp"
+#include <gtest/gtest.h>
+#include "model/commands/create_domain.hpp"
+#include "model/converters/json_common.hpp"
+#include "model/converters/json_transaction_factory.hpp"
+#include "model/converters/pb_transaction_factory.hpp"
+#include "model/model_hash_provider_impl.hpp"
+
+using namespace iroha;
+
+/**
+ * @given json transactions and one malformed line
+ * @when they are signed by several threads
+ * @then every well formed transaction carries valid signature of the key,
+ * and the malformed one is reported in its place
+ */
+TEST(BulkSubmitterTest, TransactionsAreSignedInParallel) {
+  auto keypair = create_keypair(create_seed("bulk"));
+  iroha_cli::BulkOptions options;
+  options.signing_threads = 3;
+  iroha_cli::BulkSubmitter submitter(
+      "127.0.0.1", 50051, std::make_shared<KeypairSigner>(keypair), options);
+
+  model::converters::JsonTransactionFactory serializer;
+  std::vector<std::string> json_txs;
+  for (uint64_t i = 0; i < 10; ++i) {
+    model::Transaction tx;
+    tx.created_ts = 1000;
+    tx.tx_counter = i;
+    tx.creator_account_id = "admin@test";
+    auto domain = std::make_shared<model::CreateDomain>();
+    domain->domain_name = "bulk";
+    tx.commands.push_back(domain);
+    json_txs.push_back(
+        model::converters::jsonToString(serializer.serialize(tx)));
+  }
+  json_txs[4] = "{\"creator_account_id\":";
+
+  auto txs = submitter.sign(json_txs);
+  ASSERT_EQ(json_txs.size(), txs.size());
+  ASSERT_FALSE(txs[4].has_value());
+
+  model::converters::PbTransactionFactory factory;
+  model::HashProviderImpl hash_provider;
+  for (size_t i = 0; i < txs.size(); ++i) {
+    if (i == 4) {
+      continue;
+    }
+    ASSERT_TRUE(txs[i].has_value());
+    auto tx = *factory.deserialize(txs[i].value());
+    ASSERT_EQ(i, tx.tx_counter);
+    ASSERT_EQ(1, tx.signatures.size());
+    ASSERT_EQ(keypair.pubkey, tx.signatures.front().pubkey);
+    auto signature = tx.signatures.front();
+    tx.signatures.clear();
+    auto hash = hash_provider.get_hash(tx);
+    ASSERT_TRUE(verify(
+        hash.data(), hash.size(), signature.pubkey, signature.signature));
+  }
+}
@@ -0,0 +1,67 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "genesis_generator.hpp"
+#include <gtest/gtest.h>
+#include "ametsuchi/impl/block_serializer.hpp"
+#include "model/commands/create_account.hpp"
+#include "model/model_hash_provider_impl.hpp"
+
+using namespace iroha;
+
+/**
+ * @given generator of ten accounts holding two assets, four accounts per
+ * transaction
+ * @when genesis block is generated by three threads
+ * @then accounts are created in order with derived keys, and the block
+ * survives binary serialization
+ */
+TEST(GenesisGeneratorTest, AccountsAreGeneratedInOrder) {
+  iroha_cli::GenesisOptions options;
+  options.accounts = 10;
+  options.assets = 2;
+  options.threads = 3;
+  options.accounts_per_transaction = 4;
+  iroha_cli::GenesisGenerator generator(options);
+  model::Peer peer;
+  peer.address = "127.0.0.1:10001";
+  auto block = generator.generate({peer});
+
+  // setup transaction and three ranges of accounts
+  ASSERT_EQ(4, block.transactions.size());
+  ASSERT_EQ(4, block.txs_number);
+  // peer, domain and two assets
+  ASSERT_EQ(4, block.transactions[0].commands.size());
+  // account, permissions and two balances per account
+  ASSERT_EQ(16, block.transactions[1].commands.size());
+  ASSERT_EQ(8, block.transactions[3].commands.size());
+
+  auto last = std::dynamic_pointer_cast<model::CreateAccount>(
+      block.transactions[3].commands[4]);
+  ASSERT_TRUE(last);
+  ASSERT_EQ(generator.accountId(9),
+            last->account_name + "@" + last->domain_id);
+  ASSERT_LT(last->account_name.size(), 8);
+  ASSERT_EQ(generator.keypair(9).pubkey, last->pubkey);
+
+  ametsuchi::BlockSerializer serializer;
+  auto bytes = serializer.serialize(block);
+  auto restored = serializer.deserialize(bytes.data(), bytes.size());
+  ASSERT_TRUE(restored);
+  model::HashProviderImpl hash_provider;
+  ASSERT_EQ(block.hash, hash_provider.get_hash(*restored));
+}
@@ -41,6 +41,26 @@ namespace iroha {
       MOCK_METHOD2(getAccountAsset, nonstd::optional<model::AccountAsset>(
                                         const std::string &account_id,
                                         const std::string &asset_id));
+      MOCK_METHOD3(getAccountAssets,
+                   nonstd::optional<std::vector<model::AccountAsset>>(
+                       const std::string &account_id,
+                       const std::string &after_asset_id,
+                       size_t limit));
+      MOCK_METHOD3(getAssetHolders,
+                   nonstd::optional<std::vector<model::AccountAsset>>(
+                       const std::string &asset_id,
+                       const std::string &after_account_id,
+                       size_t limit));
+      MOCK_METHOD3(getDomainAccounts,
+                   nonstd::optional<std::vector<model::Account>>(
+                       const std::string &domain_id,
+                       const std::string &after_account_id,
+                       size_t limit));
+      MOCK_METHOD3(getAccountsBySignatory,
+                   nonstd::optional<std::vector<std::string>>(
+                       const ed25519::pubkey_t &signatory,
+                       const std::string &after_account_id,
+                       size_t limit));
       MOCK_METHOD0(getPeers, nonstd::optional<std::vector<model::Peer>>());
     };
 
@@ -50,6 +70,8 @@ namespace iroha {
       MOCK_METHOD1(updateAccount, bool(const model::Account &));
       MOCK_METHOD1(insertAsset, bool(const model::Asset &));
       MOCK_METHOD1(upsertAccountAsset, bool(const model::AccountAsset &));
+      MOCK_METHOD1(upsertAccountAssets,
+                   bool(const std::vector<model::AccountAsset> &));
       MOCK_METHOD1(insertSignatory, bool(const ed25519::pubkey_t &));
 
       MOCK_METHOD2(insertAccountSignatory,
@@ -70,8 +92,77 @@ namespace iroha {
       MOCK_METHOD1(
           getAccountTransactions,
           rxcpp::observable<model::Transaction>(std::string account_id));
+      MOCK_METHOD2(getAccountTransactions,
+                   rxcpp::observable<CommittedTransaction>(
+                       std::string account_id,
+                       const model::TxPagination &pagination));
+      MOCK_METHOD3(getAccountAssetTransactions,
+                   rxcpp::observable<CommittedTransaction>(
+                       std::string account_id,
+                       std::string asset_id,
+                       const model::TxPagination &pagination));
+      MOCK_METHOD5(getAssetTransfers,
+                   rxcpp::observable<CommittedTransaction>(
+                       std::string asset_id,
+                       uint32_t from,
+                       uint32_t to,
+                       Amount min_amount,
+                       const model::TxPagination &pagination));
       MOCK_METHOD2(getBlocks,
                    rxcpp::observable<model::Block>(uint32_t from, uint32_t to));
+      MOCK_METHOD2(getWireBlocks,
+                   rxcpp::observable<protocol::Block>(uint32_t from,
+                                                      uint32_t to));
+      MOCK_METHOD2(getWsvChanges,
+                   rxcpp::observable<protocol::WsvChanges>(uint32_t from,
+                                                           uint32_t to));
+      MOCK_METHOD1(getTransaction,
+                   nonstd::optional<CommittedTransaction>(const hash256_t &));
+      MOCK_METHOD1(getInclusionProof,
+                   nonstd::optional<model::InclusionProof>(
+                       const CommittedTransaction &));
+      MOCK_METHOD1(hasTransaction, bool(const hash256_t &));
+      MOCK_METHOD0(getTopBlockHeight, uint32_t());
+      MOCK_METHOD0(getStateRoot, nonstd::optional<CommittedStateRoot>());
+    };
+
+    class MockTemporaryWsv : public TemporaryWsv {
+     public:
+      MOCK_METHOD2(apply,
+                   bool(const model::Transaction &,
+                        std::function<bool(const model::Transaction &,
+                                           WsvCommand &, WsvQuery &)>));
+      MOCK_METHOD1(getAccount, nonstd::optional<model::Account>(
+                                   const std::string &account_id));
+      MOCK_METHOD1(getSignatories,
+                   nonstd::optional<std::vector<ed25519::pubkey_t>>(
+                       const std::string &account_id));
+      MOCK_METHOD1(getAsset,
+                   nonstd::optional<model::Asset>(const std::string &asset_id));
+      MOCK_METHOD2(getAccountAsset, nonstd::optional<model::AccountAsset>(
+                                        const std::string &account_id,
+                                        const std::string &asset_id));
+      MOCK_METHOD3(getAccountAssets,
+                   nonstd::optional<std::vector<model::AccountAsset>>(
+                       const std::string &account_id,
+                       const std::string &after_asset_id,
+                       size_t limit));
+      MOCK_METHOD3(getAssetHolders,
+                   nonstd::optional<std::vector<model::AccountAsset>>(
+                       const std::string &asset_id,
+                       const std::string &after_account_id,
+                       size_t limit));
+      MOCK_METHOD3(getDomainAccounts,
+                   nonstd::optional<std::vector<model::Account>>(
+                       const std::string &domain_id,
+                       const std::string &after_account_id,
+                       size_t limit));
+      MOCK_METHOD3(getAccountsBySignatory,
+                   nonstd::optional<std::vector<std::string>>(
+                       const ed25519::pubkey_t &signatory,
+                       const std::string &after_account_id,
+                       size_t limit));
+      MOCK_METHOD0(getPeers, nonstd::optional<std::vector<model::Peer>>());
     };
 
     class MockTemporaryFactory : public TemporaryFactory {
@@ -95,6 +186,26 @@ namespace iroha {
       MOCK_METHOD2(getAccountAsset, nonstd::optional<model::AccountAsset>(
                                         const std::string &account_id,
                                         const std::string &asset_id));
+      MOCK_METHOD3(getAccountAssets,
+                   nonstd::optional<std::vector<model::AccountAsset>>(
+                       const std::string &account_id,
+                       const std::string &after_asset_id,
+                       size_t limit));
+      MOCK_METHOD3(getAssetHolders,
+                   nonstd::optional<std::vector<model::AccountAsset>>(
+                       const std::string &asset_id,
+                       const std::string &after_account_id,
+                       size_t limit));
+      MOCK_METHOD3(getDomainAccounts,
+                   nonstd::optional<std::vector<model::Account>>(
+                       const std::string &domain_id,
+                       const std::string &after_account_id,
+                       size_t limit));
+      MOCK_METHOD3(getAccountsBySignatory,
+                   nonstd::optional<std::vector<std::string>>(
+                       const ed25519::pubkey_t &signatory,
+                       const std::string &after_account_id,
+                       size_t limit));
       MOCK_METHOD0(getPeers, nonstd::optional<std::vector<model::Peer>>());
     };
 
@@ -110,6 +221,7 @@ namespace iroha {
     class MockMutableFactory : public MutableFactory {
      public:
       MOCK_METHOD0(createMutableStorage, std::unique_ptr<MutableStorage>());
+      MOCK_METHOD0(createBulkStorage, std::unique_ptr<MutableStorage>());
 
       void commit(std::unique_ptr<MutableStorage> mutableStorage) override {
         // gmock workaround for non-copyable parameters
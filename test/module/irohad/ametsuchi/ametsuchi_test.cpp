@@ -263,10 +263,18 @@ namespace iroha {
         }
       });
 
-      storage->getAccountTransactions("admin1").subscribe(
-          [](auto tx) { EXPECT_EQ(tx.commands.size(), 2); });
-      storage->getAccountTransactions("admin2").subscribe(
-          [](auto tx) { EXPECT_EQ(tx.commands.size(), 4); });
+      size_t admin1_txs = 0, admin2_txs = 0;
+      storage->getAccountTransactions("admin1").subscribe([&](auto tx) {
+        EXPECT_EQ(tx.commands.size(), 2);
+        ++admin1_txs;
+      });
+      storage->getAccountTransactions("admin2").subscribe([&](auto tx) {
+        EXPECT_EQ(tx.commands.size(), 4);
+        ++admin2_txs;
+      });
+      // each account created one transaction
+      ASSERT_EQ(admin1_txs, 1);
+      ASSERT_EQ(admin2_txs, 1);
     }
 
     TEST_F(AmetsuchiTest, PeerTest) {
@@ -0,0 +1,110 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/block_cache.hpp"
+#include <gtest/gtest.h>
+
+namespace iroha {
+  namespace ametsuchi {
+
+    std::shared_ptr<const model::Block> makeBlock(uint64_t height) {
+      auto block = std::make_shared<model::Block>();
+      block->height = height;
+      return block;
+    }
+
+    /**
+     * @given cache with some blocks
+     * @when blocks are looked up
+     * @then cached blocks are found and counters are updated
+     */
+    TEST(BlockCacheTest, HitMissTest) {
+      BlockCache cache(10, 1000);
+      cache.put(1, makeBlock(1), 10);
+      auto block = cache.get(1);
+      ASSERT_TRUE(block);
+      ASSERT_EQ(block->height, 1);
+      ASSERT_FALSE(cache.get(2));
+      ASSERT_EQ(cache.hits(), 1);
+      ASSERT_EQ(cache.misses(), 1);
+    }
+
+    /**
+     * @given cache limited by number of blocks
+     * @when more blocks are inserted
+     * @then least recently used block is evicted
+     */
+    TEST(BlockCacheTest, CountLimitTest) {
+      BlockCache cache(2, 1000);
+      cache.put(1, makeBlock(1), 10);
+      cache.put(2, makeBlock(2), 10);
+      ASSERT_TRUE(cache.get(1));
+      cache.put(3, makeBlock(3), 10);
+      ASSERT_TRUE(cache.get(1));
+      ASSERT_FALSE(cache.get(2));
+      ASSERT_TRUE(cache.get(3));
+    }
+
+    /**
+     * @given cache limited by size of blocks
+     * @when blocks exceeding the limit are inserted
+     * @then old blocks are evicted and too large blocks are not cached
+     */
+    TEST(BlockCacheTest, ByteLimitTest) {
+      BlockCache cache(10, 100);
+      cache.put(1, makeBlock(1), 60);
+      cache.put(2, makeBlock(2), 60);
+      ASSERT_FALSE(cache.get(1));
+      ASSERT_TRUE(cache.get(2));
+      cache.put(3, makeBlock(3), 200);
+      ASSERT_FALSE(cache.get(3));
+      ASSERT_TRUE(cache.get(2));
+    }
+
+    /**
+     * @given disabled cache
+     * @when block is inserted
+     * @then it is not cached
+     */
+    TEST(BlockCacheTest, DisabledTest) {
+      BlockCache cache(0, 100);
+      cache.put(1, makeBlock(1), 10);
+      ASSERT_FALSE(cache.get(1));
+    }
+
+    /**
+     * @given cache with blocks
+     * @when it is shrunk
+     * @then least recently used blocks are evicted until enough bytes are
+     * released
+     */
+    TEST(BlockCacheTest, ShrinkTest) {
+      BlockCache cache(10, 1000);
+      cache.put(1, makeBlock(1), 10);
+      cache.put(2, makeBlock(2), 20);
+      cache.put(3, makeBlock(3), 30);
+      ASSERT_TRUE(cache.get(1));
+      ASSERT_EQ(60, cache.bytes());
+      ASSERT_EQ(50, cache.shrink(25));
+      ASSERT_EQ(10, cache.bytes());
+      ASSERT_TRUE(cache.get(1));
+      ASSERT_FALSE(cache.get(2));
+      ASSERT_FALSE(cache.get(3));
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,143 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/block_range_reader.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace iroha {
+  namespace ametsuchi {
+
+    std::shared_ptr<const model::Block> loadBlock(uint32_t height) {
+      auto block = std::make_shared<model::Block>();
+      block->height = height;
+      return block;
+    }
+
+    /**
+     * @given range of blocks loaded by several workers
+     * @when blocks are consumed
+     * @then they come in height order
+     */
+    TEST(BlockRangeReaderTest, OrderTest) {
+      BlockReadPool pool(4);
+      BlockRangeReader reader(1, 100, loadBlock, &pool, 8);
+      for (auto height = 1u; height <= 100; ++height) {
+        auto block = reader.next();
+        ASSERT_TRUE(block);
+        ASSERT_TRUE(*block);
+        ASSERT_EQ((*block)->height, height);
+      }
+      ASSERT_FALSE(reader.next());
+    }
+
+    /**
+     * @given reader with small read-ahead window
+     * @when consumer does not take blocks
+     * @then workers load no more than the window
+     */
+    TEST(BlockRangeReaderTest, ReadAheadTest) {
+      BlockReadPool pool(4);
+      std::atomic<uint32_t> loaded(0);
+      {
+        BlockRangeReader reader(1,
+                                100,
+                                [&loaded](uint32_t height) {
+                                  ++loaded;
+                                  return loadBlock(height);
+                                },
+                                &pool,
+                                3);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        ASSERT_LE(loaded, 3);
+        ASSERT_TRUE(reader.next());
+      }
+      ASSERT_LE(loaded, 4);
+    }
+
+    /**
+     * @given reader without workers and loader failing for some block
+     * @when blocks are consumed
+     * @then failed block is returned as nullptr and reading continues
+     */
+    TEST(BlockRangeReaderTest, InlineFailureTest) {
+      BlockRangeReader reader(1,
+                              3,
+                              [](uint32_t height) {
+                                return height == 2 ? nullptr
+                                                   : loadBlock(height);
+                              },
+                              nullptr,
+                              1);
+      ASSERT_EQ((*reader.next())->height, 1);
+      ASSERT_FALSE(*reader.next());
+      ASSERT_EQ((*reader.next())->height, 3);
+      ASSERT_FALSE(reader.next());
+    }
+
+    /**
+     * @given empty range
+     * @when block is requested
+     * @then nothing is returned
+     */
+    TEST(BlockRangeReaderTest, EmptyRangeTest) {
+      BlockReadPool pool(4);
+      BlockRangeReader reader(5, 4, loadBlock, &pool, 8);
+      ASSERT_FALSE(reader.next());
+    }
+
+    /**
+     * @given readers of two ranges sharing a pool of two workers
+     * @when they are consumed concurrently, and one is dropped unread
+     * @then both return their blocks in order, and no more loads run at
+     * once than the pool has workers
+     */
+    TEST(BlockRangeReaderTest, SharedPoolTest) {
+      BlockReadPool pool(2);
+      std::atomic<int> running(0);
+      std::atomic<int> max_running(0);
+      auto loader = [&](uint32_t height) {
+        auto now = ++running;
+        auto max = max_running.load();
+        while (now > max and not max_running.compare_exchange_weak(max, now))
+          ;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        --running;
+        return loadBlock(height);
+      };
+
+      auto consume = [&](uint32_t from, uint32_t to) {
+        BlockRangeReader reader(from, to, loader, &pool, 8);
+        for (auto height = from; height <= to; ++height) {
+          auto block = reader.next();
+          ASSERT_TRUE(block);
+          ASSERT_EQ((**block).height, height);
+        }
+        ASSERT_FALSE(reader.next());
+      };
+      std::thread other(consume, 1, 50);
+      consume(101, 150);
+      { BlockRangeReader dropped(1, 100, loader, &pool, 8); }
+      other.join();
+
+      ASSERT_LE(max_running, 2);
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,200 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/block_serializer.hpp"
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+#include "ametsuchi/impl/flat_file/flat_file.hpp"
+#include "ametsuchi/impl/segmented_log/segmented_log.hpp"
+#include "ametsuchi_test_common.hpp"
+#include "model/commands/create_domain.hpp"
+#include "model/commands/transfer_asset.hpp"
+#include "model/model_hash_provider_impl.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    class BlockSerializerTest : public ::testing::Test {
+     protected:
+      virtual void SetUp() {
+        mkdir(block_store_path.c_str(),
+              S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH);
+        mkdir(converted_path.c_str(), S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH);
+      }
+      virtual void TearDown() {
+        remove_all(block_store_path);
+        remove_all(converted_path);
+      }
+
+      model::Block makeBlock(uint64_t height) {
+        model::Block block;
+        block.height = height;
+        block.created_ts = 42;
+        block.txs_number = 0;
+        block.prev_hash.fill(1);
+        block.merkle_root.fill(2);
+        block.hash = model::HashProviderImpl().get_hash(block);
+        return block;
+      }
+
+      std::string block_store_path = "/tmp/serializer_dump";
+      std::string converted_path = "/tmp/serializer_converted";
+    };
+
+    /**
+     * @given block
+     * @when it is serialized in each format
+     * @then format is detected and block is restored
+     */
+    TEST_F(BlockSerializerTest, RoundTripTest) {
+      auto block = makeBlock(1);
+      for (auto format : {BlockFormat::Json, BlockFormat::Protobuf}) {
+        BlockSerializer serializer(format);
+        auto bytes = serializer.serialize(block);
+        ASSERT_EQ(BlockSerializer::format(bytes.data(), bytes.size()), format);
+        auto result = serializer.deserialize(bytes.data(), bytes.size());
+        ASSERT_TRUE(result);
+        ASSERT_EQ(*result, block);
+      }
+    }
+
+    /**
+     * @given binary serializer
+     * @when JSON block written by earlier versions is read
+     * @then block is restored
+     */
+    TEST_F(BlockSerializerTest, ReadsJsonTest) {
+      auto block = makeBlock(1);
+      auto bytes = BlockSerializer(BlockFormat::Json).serialize(block);
+      BlockSerializer serializer;
+      auto result = serializer.deserialize(bytes.data(), bytes.size());
+      ASSERT_TRUE(result);
+      ASSERT_EQ(*result, block);
+
+      std::vector<uint8_t> garbage(10, 0);
+      ASSERT_FALSE(serializer.deserialize(garbage.data(), garbage.size()));
+    }
+
+    /**
+     * @given block stored in each format
+     * @when it is read in wire format
+     * @then protobuf block converts to the stored block
+     */
+    TEST_F(BlockSerializerTest, WireTest) {
+      auto block = makeBlock(1);
+      model::converters::PbBlockFactory factory;
+      for (auto format : {BlockFormat::Json, BlockFormat::Protobuf}) {
+        BlockSerializer serializer(format);
+        auto bytes = serializer.serialize(block);
+        auto result = serializer.deserializeWire(bytes.data(), bytes.size());
+        ASSERT_TRUE(result);
+        ASSERT_EQ(factory.deserialize(*result), block);
+      }
+
+      std::vector<uint8_t> garbage(10, 0);
+      ASSERT_FALSE(
+          BlockSerializer().deserializeWire(garbage.data(), garbage.size()));
+    }
+
+    /**
+     * @given block with transactions stored in each format
+     * @when it is read lazily
+     * @then header, hashes, creators and decoded transactions are the
+     * same as of the block read at once
+     */
+    TEST_F(BlockSerializerTest, LazyTest) {
+      auto block = makeBlock(1);
+      for (auto creator : {"alice@test", "bob@test"}) {
+        model::Transaction tx{};
+        tx.creator_account_id = creator;
+        tx.tx_counter = 7;
+        auto transfer = std::make_shared<model::TransferAsset>();
+        transfer->src_account_id = creator;
+        transfer->dest_account_id = "carol@test";
+        transfer->asset_id = "coin#test";
+        transfer->amount = Amount(1, 50);
+        tx.commands.push_back(transfer);
+        auto domain = std::make_shared<model::CreateDomain>();
+        domain->domain_name = "test";
+        tx.commands.push_back(domain);
+        block.transactions.push_back(tx);
+      }
+      block.txs_number = block.transactions.size();
+
+      for (auto format : {BlockFormat::Json, BlockFormat::Protobuf}) {
+        BlockSerializer serializer(format);
+        auto stored = std::make_shared<const std::vector<uint8_t>>(
+            serializer.serialize(block));
+        auto expected = serializer.deserialize(stored->data(), stored->size());
+        ASSERT_TRUE(expected);
+
+        auto lazy = serializer.deserializeLazy(
+            BlockView(stored, stored->data(), stored->size()));
+        ASSERT_TRUE(lazy);
+        ASSERT_EQ(expected->height, lazy->height());
+        ASSERT_EQ(expected->prev_hash, lazy->prevHash());
+        ASSERT_EQ(expected->transactions.size(), lazy->transactionsSize());
+        for (size_t i = 0; i < expected->transactions.size(); ++i) {
+          const auto &tx = expected->transactions[i];
+          ASSERT_EQ(tx.creator_account_id, lazy->creatorAccountId(i));
+          ASSERT_EQ(tx.tx_hash, lazy->transactionHash(i));
+        }
+        ASSERT_EQ(expected->hash, lazy->hash());
+        auto tx = lazy->transaction(1);
+        ASSERT_TRUE(tx);
+        ASSERT_EQ(expected->transactions[1], *tx);
+        auto whole = lazy->block();
+        ASSERT_TRUE(whole);
+        ASSERT_EQ(*expected, *whole);
+      }
+
+      std::vector<uint8_t> garbage(10, 0);
+      auto bytes = std::make_shared<const std::vector<uint8_t>>(garbage);
+      ASSERT_FALSE(BlockSerializer().deserializeLazy(
+          BlockView(bytes, bytes->data(), bytes->size())));
+    }
+
+    /**
+     * @given flat file store with JSON blocks
+     * @when it is converted to segmented log with binary blocks
+     * @then all blocks are converted and restored
+     */
+    TEST_F(BlockSerializerTest, ConvertTest) {
+      auto source = FlatFile::create(block_store_path);
+      ASSERT_TRUE(source);
+      BlockSerializer json_serializer(BlockFormat::Json);
+      for (auto id = 1u; id <= 3; ++id) {
+        source->add(id, json_serializer.serialize(makeBlock(id)));
+      }
+
+      auto destination = SegmentedLog::create(converted_path);
+      ASSERT_TRUE(destination);
+      BlockSerializer serializer;
+      ASSERT_TRUE(convertBlocks(*source, *destination, serializer));
+      ASSERT_EQ(destination->last_id(), 3);
+      for (auto id = 1u; id <= 3; ++id) {
+        auto bytes = destination->get(id);
+        ASSERT_TRUE(bytes);
+        ASSERT_EQ(BlockSerializer::format(bytes->data(), bytes->size()),
+                  BlockFormat::Protobuf);
+        ASSERT_EQ(serializer.deserialize(bytes->data(), bytes->size()),
+                  makeBlock(id));
+      }
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,103 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/bulk_wsv.hpp"
+#include <gtest/gtest.h>
+
+using namespace iroha;
+using namespace iroha::ametsuchi;
+
+class BulkWsvTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    pubkey.fill(1);
+    account.account_id = "alice@test";
+    account.domain_name = "test";
+    account.master_key = pubkey;
+    account.quorum = 1;
+  }
+
+  BulkTables tables;
+  BulkWsv wsv{tables};
+  ed25519::pubkey_t pubkey;
+  model::Account account;
+};
+
+/**
+ * @given empty bulk wsv
+ * @when rows are inserted
+ * @then they are queried back and collected in tables
+ */
+TEST_F(BulkWsvTest, InsertTest) {
+  ASSERT_TRUE(wsv.insertSignatory(pubkey));
+  ASSERT_TRUE(wsv.insertAccount(account));
+  ASSERT_TRUE(wsv.insertAccountSignatory(account.account_id, pubkey));
+
+  model::AccountAsset asset;
+  asset.account_id = account.account_id;
+  asset.asset_id = "coin#test";
+  asset.balance = 10;
+  ASSERT_TRUE(wsv.upsertAccountAsset(asset));
+  asset.balance = 20;
+  ASSERT_TRUE(wsv.upsertAccountAsset(asset));
+
+  ASSERT_EQ(wsv.getAccount(account.account_id)->quorum, 1);
+  ASSERT_EQ(*wsv.getSignatories(account.account_id),
+            std::vector<ed25519::pubkey_t>{pubkey});
+  ASSERT_EQ(wsv.getAccountAsset(asset.account_id, asset.asset_id)->balance,
+            20);
+  ASSERT_EQ(tables.accounts.size(), 1);
+  ASSERT_EQ(tables.account_assets.size(), 1);
+}
+
+/**
+ * @given bulk wsv with inserted rows
+ * @when rows with the same keys are inserted
+ * @then inserts fail
+ */
+TEST_F(BulkWsvTest, DuplicateTest) {
+  ASSERT_TRUE(wsv.insertSignatory(pubkey));
+  ASSERT_TRUE(wsv.insertAccount(account));
+  ASSERT_TRUE(wsv.insertAccountSignatory(account.account_id, pubkey));
+  ASSERT_FALSE(wsv.insertSignatory(pubkey));
+  ASSERT_FALSE(wsv.insertAccount(account));
+  ASSERT_FALSE(wsv.insertAccountSignatory(account.account_id, pubkey));
+
+  model::Peer peer;
+  peer.address = "127.0.0.1:50051";
+  peer.pubkey = pubkey;
+  ASSERT_TRUE(wsv.insertPeer(peer));
+  peer.pubkey.fill(2);
+  ASSERT_FALSE(wsv.insertPeer(peer));
+  ASSERT_EQ(wsv.getPeers()->size(), 1);
+}
+
+/**
+ * @given bulk wsv with account
+ * @when account is updated
+ * @then its domain is kept as in SQL update
+ */
+TEST_F(BulkWsvTest, UpdateTest) {
+  ASSERT_TRUE(wsv.insertAccount(account));
+  auto updated = account;
+  updated.domain_name = "other";
+  updated.quorum = 2;
+  ASSERT_TRUE(wsv.updateAccount(updated));
+  auto stored = wsv.getAccount(account.account_id);
+  ASSERT_EQ(stored->quorum, 2);
+  ASSERT_EQ(stored->domain_name, "test");
+}
@@ -0,0 +1,362 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/cached_wsv.hpp"
+#include <gtest/gtest.h>
+#include "module/irohad/ametsuchi/ametsuchi_mocks.hpp"
+
+using ::testing::Return;
+using ::testing::SizeIs;
+using ::testing::_;
+
+namespace iroha {
+  namespace ametsuchi {
+
+    class CachedWsvTest : public ::testing::Test {
+     protected:
+      void SetUp() override { create(false); }
+
+      void create(bool defer_asset_writes) {
+        auto query = std::make_unique<MockWsvQuery>();
+        auto command = std::make_unique<MockWsvCommand>();
+        wsv = query.get();
+        executor = command.get();
+        cache = std::make_unique<CachedWsv>(
+            std::move(query), std::move(command), defer_asset_writes);
+
+        asset.account_id = "alice@test";
+        asset.asset_id = "coin#test";
+        asset.balance = 100;
+      }
+
+      MockWsvQuery *wsv;
+      MockWsvCommand *executor;
+      std::unique_ptr<CachedWsv> cache;
+      model::AccountAsset asset;
+      int savepoints = 0;
+    };
+
+    /**
+     * @given cached wsv
+     * @when the same account asset is queried twice
+     * @then database is queried once
+     */
+    TEST_F(CachedWsvTest, RepeatedReadTest) {
+      EXPECT_CALL(*wsv, getAccountAsset(asset.account_id, asset.asset_id))
+          .WillOnce(Return(asset));
+      for (auto i = 0; i < 2; ++i) {
+        auto result = cache->getAccountAsset(asset.account_id, asset.asset_id);
+        ASSERT_TRUE(result);
+        ASSERT_EQ(result->balance, 100);
+      }
+    }
+
+    /**
+     * @given cached wsv
+     * @when account asset is written and then read
+     * @then write is passed to database and read is served from memory
+     */
+    TEST_F(CachedWsvTest, WriteThroughTest) {
+      EXPECT_CALL(*executor, upsertAccountAsset(_)).WillOnce(Return(true));
+      EXPECT_CALL(*wsv, getAccountAsset(_, _)).Times(0);
+      ASSERT_TRUE(cache->upsertAccountAsset(asset));
+      auto result = cache->getAccountAsset(asset.account_id, asset.asset_id);
+      ASSERT_TRUE(result);
+      ASSERT_EQ(result->balance, 100);
+    }
+
+    /**
+     * @given cached wsv with cached account asset
+     * @when balance is changed after savepoint and savepoint is rolled back
+     * @then previous balance is served
+     */
+    TEST_F(CachedWsvTest, RollbackTest) {
+      EXPECT_CALL(*wsv, getAccountAsset(asset.account_id, asset.asset_id))
+          .WillOnce(Return(asset));
+      EXPECT_CALL(*executor, upsertAccountAsset(_)).WillOnce(Return(true));
+      cache->getAccountAsset(asset.account_id, asset.asset_id);
+
+      cache->savepoint([this] { ++savepoints; });
+      auto changed = asset;
+      changed.balance = 50;
+      ASSERT_TRUE(cache->upsertAccountAsset(changed));
+      ASSERT_EQ(
+          cache->getAccountAsset(asset.account_id, asset.asset_id)->balance,
+          50);
+      cache->rollbackToSavepoint();
+
+      ASSERT_EQ(
+          cache->getAccountAsset(asset.account_id, asset.asset_id)->balance,
+          100);
+    }
+
+    /**
+     * @given cached wsv
+     * @when account asset is written after savepoint which is released
+     * @then written balance is kept
+     */
+    TEST_F(CachedWsvTest, ReleaseTest) {
+      EXPECT_CALL(*executor, upsertAccountAsset(_)).WillOnce(Return(true));
+      EXPECT_CALL(*wsv, getAccountAsset(_, _)).Times(0);
+      cache->savepoint([this] { ++savepoints; });
+      ASSERT_TRUE(cache->upsertAccountAsset(asset));
+      cache->releaseSavepoint();
+      cache->rollbackToSavepoint();
+      ASSERT_EQ(
+          cache->getAccountAsset(asset.account_id, asset.asset_id)->balance,
+          100);
+    }
+
+    /**
+     * @given cached wsv with cached signatories
+     * @when signatory is added
+     * @then signatories are queried again
+     */
+    TEST_F(CachedWsvTest, InvalidationTest) {
+      ed25519::pubkey_t key{};
+      std::vector<ed25519::pubkey_t> before;
+      std::vector<ed25519::pubkey_t> after{key};
+      EXPECT_CALL(*wsv, getSignatories(asset.account_id))
+          .WillOnce(Return(before))
+          .WillOnce(Return(after));
+      EXPECT_CALL(*executor, insertAccountSignatory(asset.account_id, key))
+          .WillOnce(Return(true));
+
+      ASSERT_TRUE(cache->getSignatories(asset.account_id)->empty());
+      ASSERT_TRUE(cache->insertAccountSignatory(asset.account_id, key));
+      ASSERT_EQ(cache->getSignatories(asset.account_id)->size(), 1);
+      ASSERT_EQ(cache->getSignatories(asset.account_id)->size(), 1);
+    }
+
+    /**
+     * @given cached wsv
+     * @when write fails in database
+     * @then overlay is not changed
+     */
+    TEST_F(CachedWsvTest, FailedWriteTest) {
+      EXPECT_CALL(*executor, upsertAccountAsset(_)).WillOnce(Return(false));
+      EXPECT_CALL(*wsv, getAccountAsset(_, _))
+          .WillOnce(Return(nonstd::nullopt));
+      ASSERT_FALSE(cache->upsertAccountAsset(asset));
+      ASSERT_FALSE(cache->getAccountAsset(asset.account_id, asset.asset_id));
+    }
+
+    /**
+     * @given cached wsv in deferred mode with existing account and asset
+     * @when account assets are written, one of them twice
+     * @then nothing is written until flush, which writes one batch
+     */
+    TEST_F(CachedWsvTest, DeferredWriteTest) {
+      create(true);
+      EXPECT_CALL(*wsv, getAccount(asset.account_id))
+          .WillOnce(Return(model::Account()));
+      EXPECT_CALL(*wsv, getAsset(_)).WillRepeatedly(Return(model::Asset()));
+      EXPECT_CALL(*executor, upsertAccountAsset(_)).Times(0);
+      EXPECT_CALL(*executor, upsertAccountAssets(SizeIs(2)))
+          .WillOnce(Return(true));
+
+      auto other = asset;
+      other.asset_id = "gold#test";
+      ASSERT_TRUE(cache->upsertAccountAsset(asset));
+      ASSERT_TRUE(cache->upsertAccountAsset(other));
+      asset.balance = 10;
+      ASSERT_TRUE(cache->upsertAccountAsset(asset));
+      ASSERT_EQ(
+          cache->getAccountAsset(asset.account_id, asset.asset_id)->balance,
+          10);
+
+      ASSERT_TRUE(cache->flush());
+      // nothing is left to write
+      ASSERT_TRUE(cache->flush());
+    }
+
+    /**
+     * @given cached wsv in deferred mode with page of account assets in
+     * database
+     * @when one of them is updated and a new one is written, not flushed
+     * @then page of account assets has both writes in order of asset id,
+     * within its limit
+     */
+    TEST_F(CachedWsvTest, DeferredWritesInAccountAssetsTest) {
+      create(true);
+      auto gold = asset;
+      gold.asset_id = "gold#test";
+      auto iron = asset;
+      iron.asset_id = "iron#test";
+      EXPECT_CALL(*wsv, getAccount(asset.account_id))
+          .WillOnce(Return(model::Account()));
+      EXPECT_CALL(*wsv, getAsset(_)).WillRepeatedly(Return(model::Asset()));
+      EXPECT_CALL(*wsv, getAccountAssets(asset.account_id, "", 2))
+          .WillOnce(Return(std::vector<model::AccountAsset>{asset, iron}));
+      EXPECT_CALL(*wsv, getAccountAssets(asset.account_id, "coin#test", 0))
+          .WillOnce(Return(std::vector<model::AccountAsset>{iron}));
+      EXPECT_CALL(*executor, upsertAccountAssets(_)).Times(0);
+
+      asset.balance = 10;
+      ASSERT_TRUE(cache->upsertAccountAsset(asset));
+      ASSERT_TRUE(cache->upsertAccountAsset(gold));
+
+      auto page = cache->getAccountAssets(asset.account_id, "", 2);
+      ASSERT_TRUE(page);
+      ASSERT_THAT(*page, SizeIs(2));
+      ASSERT_EQ((*page)[0].asset_id, "coin#test");
+      ASSERT_EQ((*page)[0].balance, 10);
+      ASSERT_EQ((*page)[1].asset_id, "gold#test");
+
+      page = cache->getAccountAssets(asset.account_id, "coin#test", 0);
+      ASSERT_TRUE(page);
+      ASSERT_THAT(*page, SizeIs(2));
+      ASSERT_EQ((*page)[0].asset_id, "gold#test");
+      ASSERT_EQ((*page)[1].asset_id, "iron#test");
+    }
+
+    /**
+     * @given cached wsv in deferred mode with holders of asset in database
+     * @when balance of one holder is updated and a new holder is written,
+     * not flushed
+     * @then page of holders has both writes in order of account id, within
+     * its limit
+     */
+    TEST_F(CachedWsvTest, DeferredWritesInAssetHoldersTest) {
+      create(true);
+      auto bob = asset;
+      bob.account_id = "bob@test";
+      auto carol = asset;
+      carol.account_id = "carol@test";
+      EXPECT_CALL(*wsv, getAccount(_)).WillRepeatedly(Return(model::Account()));
+      EXPECT_CALL(*wsv, getAsset(asset.asset_id))
+          .WillOnce(Return(model::Asset()));
+      EXPECT_CALL(*wsv, getAssetHolders(asset.asset_id, "", 2))
+          .WillOnce(Return(std::vector<model::AccountAsset>{asset, carol}));
+      EXPECT_CALL(*wsv, getAssetHolders(asset.asset_id, "alice@test", 0))
+          .WillOnce(Return(std::vector<model::AccountAsset>{carol}));
+      EXPECT_CALL(*executor, upsertAccountAssets(_)).Times(0);
+
+      asset.balance = 10;
+      ASSERT_TRUE(cache->upsertAccountAsset(asset));
+      ASSERT_TRUE(cache->upsertAccountAsset(bob));
+
+      auto page = cache->getAssetHolders(asset.asset_id, "", 2);
+      ASSERT_TRUE(page);
+      ASSERT_THAT(*page, SizeIs(2));
+      ASSERT_EQ((*page)[0].account_id, "alice@test");
+      ASSERT_EQ((*page)[0].balance, 10);
+      ASSERT_EQ((*page)[1].account_id, "bob@test");
+
+      page = cache->getAssetHolders(asset.asset_id, "alice@test", 0);
+      ASSERT_TRUE(page);
+      ASSERT_THAT(*page, SizeIs(2));
+      ASSERT_EQ((*page)[0].account_id, "bob@test");
+      ASSERT_EQ((*page)[1].account_id, "carol@test");
+    }
+
+    /**
+     * @given cached wsv in deferred mode
+     * @when account asset is written after savepoint which is rolled back
+     * @then the write is not flushed
+     */
+    TEST_F(CachedWsvTest, DeferredRollbackTest) {
+      create(true);
+      EXPECT_CALL(*wsv, getAccount(_)).WillOnce(Return(model::Account()));
+      EXPECT_CALL(*wsv, getAsset(_)).WillOnce(Return(model::Asset()));
+      EXPECT_CALL(*executor, upsertAccountAssets(_)).Times(0);
+
+      cache->savepoint([this] { ++savepoints; });
+      ASSERT_TRUE(cache->upsertAccountAsset(asset));
+      cache->rollbackToSavepoint();
+      ASSERT_TRUE(cache->flush());
+    }
+
+    /**
+     * @given cached wsv in deferred mode
+     * @when account asset of missing account is written
+     * @then write fails
+     */
+    TEST_F(CachedWsvTest, DeferredMissingAccountTest) {
+      create(true);
+      EXPECT_CALL(*wsv, getAccount(_)).WillOnce(Return(nonstd::nullopt));
+      ASSERT_FALSE(cache->upsertAccountAsset(asset));
+    }
+
+    /**
+     * @given cached wsv in deferred mode
+     * @when transaction writes only deferred account assets
+     * @then database savepoint is not opened
+     * @when transaction writes to the database
+     * @then database savepoint is opened once and has to be rolled back
+     */
+    TEST_F(CachedWsvTest, LazySavepointTest) {
+      create(true);
+      EXPECT_CALL(*wsv, getAccount(_)).WillOnce(Return(model::Account()));
+      EXPECT_CALL(*wsv, getAsset(_)).WillOnce(Return(model::Asset()));
+      EXPECT_CALL(*executor, insertPeer(_)).WillRepeatedly(Return(true));
+
+      cache->savepoint([this] { ++savepoints; });
+      ASSERT_TRUE(cache->upsertAccountAsset(asset));
+      ASSERT_FALSE(cache->releaseSavepoint());
+      ASSERT_EQ(savepoints, 0);
+
+      cache->savepoint([this] { ++savepoints; });
+      ASSERT_TRUE(cache->insertPeer(model::Peer()));
+      ASSERT_TRUE(cache->insertPeer(model::Peer()));
+      ASSERT_TRUE(cache->rollbackToSavepoint());
+      ASSERT_EQ(savepoints, 1);
+    }
+
+    /**
+     * @given cached wsv with cached account asset
+     * @when other account asset is written and writes are discarded
+     * @then cached account asset is served from memory
+     * @then written account asset is queried again
+     */
+    TEST_F(CachedWsvTest, DiscardWritesTest) {
+      auto written = asset;
+      written.asset_id = "token#test";
+      EXPECT_CALL(*wsv, getAccountAsset(asset.account_id, asset.asset_id))
+          .WillOnce(Return(asset));
+      EXPECT_CALL(*wsv, getAccountAsset(written.account_id, written.asset_id))
+          .WillOnce(Return(nonstd::nullopt));
+      EXPECT_CALL(*executor, upsertAccountAsset(_)).WillOnce(Return(true));
+
+      cache->getAccountAsset(asset.account_id, asset.asset_id);
+      ASSERT_TRUE(cache->upsertAccountAsset(written));
+      cache->discardWrites();
+
+      ASSERT_EQ(
+          cache->getAccountAsset(asset.account_id, asset.asset_id)->balance,
+          100);
+      ASSERT_FALSE(
+          cache->getAccountAsset(written.account_id, written.asset_id));
+    }
+
+    /**
+     * @given cached wsv
+     * @when missing account is queried twice
+     * @then its identifier is not interned and database is queried each time
+     */
+    TEST_F(CachedWsvTest, MissIsNotInterned) {
+      const std::string ghost = "ghost@cached_wsv_test";
+      EXPECT_CALL(*wsv, getAccount(ghost))
+          .Times(2)
+          .WillRepeatedly(Return(nonstd::nullopt));
+      ASSERT_FALSE(cache->getAccount(ghost));
+      ASSERT_FALSE(cache->getAccount(ghost));
+      ASSERT_FALSE(model::InternedId::find(ghost));
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,132 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/connection_pool.hpp"
+#include <gtest/gtest.h>
+
+namespace iroha {
+  namespace ametsuchi {
+
+    struct FakeConnection {
+      explicit FakeConnection(int id) : id(id), open(true) {}
+      int id;
+      bool open;
+    };
+
+    class ConnectionPoolTest : public ::testing::Test {
+     protected:
+      ConnectionPool<FakeConnection> makePool(size_t capacity) {
+        return ConnectionPool<FakeConnection>(
+            capacity,
+            [this]() -> std::unique_ptr<FakeConnection> {
+              if (fail) {
+                return nullptr;
+              }
+              return std::make_unique<FakeConnection>(++created);
+            },
+            [](FakeConnection &connection) { return connection.open; });
+      }
+
+      int created = 0;
+      bool fail = false;
+    };
+
+    /**
+     * @given pool with returned connection
+     * @when connection is acquired again
+     * @then the same connection is reused
+     */
+    TEST_F(ConnectionPoolTest, ReuseTest) {
+      auto pool = makePool(2);
+      {
+        auto connection = pool.acquire();
+        ASSERT_TRUE(connection);
+        ASSERT_EQ(connection->id, 1);
+        ASSERT_EQ(pool.idle(), 0);
+      }
+      ASSERT_EQ(pool.idle(), 1);
+      auto connection = pool.acquire();
+      ASSERT_EQ(connection->id, 1);
+      ASSERT_EQ(created, 1);
+    }
+
+    /**
+     * @given pool with capacity of one connection
+     * @when two connections are returned
+     * @then only one of them is kept
+     */
+    TEST_F(ConnectionPoolTest, CapacityTest) {
+      auto pool = makePool(1);
+      {
+        auto first = pool.acquire();
+        auto second = pool.acquire();
+        ASSERT_NE(first->id, second->id);
+      }
+      ASSERT_EQ(pool.idle(), 1);
+    }
+
+    /**
+     * @given pool with connection broken while idle
+     * @when connection is acquired
+     * @then broken connection is dropped and new one is opened
+     */
+    TEST_F(ConnectionPoolTest, HealthCheckTest) {
+      auto pool = makePool(2);
+      FakeConnection *raw;
+      {
+        auto connection = pool.acquire();
+        raw = connection.get();
+      }
+      raw->open = false;
+      auto connection = pool.acquire();
+      ASSERT_EQ(connection->id, 2);
+      ASSERT_EQ(pool.idle(), 0);
+
+      // connections broken while used are not returned
+      connection->open = false;
+      connection.reset();
+      ASSERT_EQ(pool.idle(), 0);
+    }
+
+    /**
+     * @given pool which can not open connections
+     * @when connection is acquired
+     * @then nullptr is returned
+     */
+    TEST_F(ConnectionPoolTest, FactoryFailureTest) {
+      auto pool = makePool(2);
+      fail = true;
+      ASSERT_FALSE(pool.acquire());
+    }
+
+    /**
+     * @given connection taken from pool
+     * @when pool is destroyed before the connection
+     * @then connection is released safely
+     */
+    TEST_F(ConnectionPoolTest, OutlivePoolTest) {
+      PooledConnection<FakeConnection> connection;
+      {
+        auto pool = makePool(2);
+        connection = pool.acquire();
+      }
+      ASSERT_EQ(connection->id, 1);
+      connection.reset();
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
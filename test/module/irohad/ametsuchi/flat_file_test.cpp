@@ -20,11 +20,27 @@
 #include "ametsuchi_test_common.hpp"
 #include "common/types.hpp"
 
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
 namespace iroha {
   namespace ametsuchi {
 
     namespace block_store {
 
+      std::vector<uint8_t> read_file(const std::string &path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::vector<uint8_t>(std::istreambuf_iterator<char>(file),
+                                    std::istreambuf_iterator<char>());
+      }
+
+      void write_file(const std::string &path,
+                      const std::vector<uint8_t> &data) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(data.data()), data.size());
+      }
+
       class BlStore_Test : public ::testing::Test {
        protected:
         virtual void SetUp() {
@@ -75,7 +91,7 @@ namespace iroha {
           // Remove file in the middle of the block store
           std::remove((block_store_path + "/0000000000000002").c_str());
           std::vector<uint8_t> block(1000, 5);
-          auto bl_store = FlatFile::create(block_store_path);
+          auto bl_store = FlatFile::create(block_store_path, true);
           ASSERT_TRUE(bl_store);
           auto res = bl_store->last_id();
           // Must return 1
@@ -83,6 +99,290 @@ namespace iroha {
         }
       }
 
+      /**
+       * @given block store with several blocks
+       * @when store is reopened
+       * @then all blocks are restored
+       */
+      TEST_F(BlStore_Test, Reopen_Test) {
+        std::vector<uint8_t> block(1000, 5);
+        {
+          auto bl_store = FlatFile::create(block_store_path);
+          ASSERT_TRUE(bl_store);
+          for (auto id = 1u; id <= 3; ++id) {
+            bl_store->add(id, block);
+          }
+        }
+        auto bl_store = FlatFile::create(block_store_path);
+        ASSERT_TRUE(bl_store);
+        ASSERT_EQ(bl_store->last_id(), 3);
+        ASSERT_EQ(*bl_store->get(3u), block);
+
+        auto verified = FlatFile::create(block_store_path, true);
+        ASSERT_TRUE(verified);
+        ASSERT_EQ(verified->last_id(), 3);
+      }
+
+      /**
+       * @given block store with manifest behind the stored blocks
+       * @when store is reopened
+       * @then blocks written after the manifest are restored
+       */
+      TEST_F(BlStore_Test, Stale_Manifest_Test) {
+        std::vector<uint8_t> block(1000, 5);
+        std::vector<uint8_t> manifest;
+        {
+          auto bl_store = FlatFile::create(block_store_path);
+          ASSERT_TRUE(bl_store);
+          bl_store->add(1u, block);
+          manifest = read_file(block_store_path + "/manifest");
+          bl_store->add(2u, block);
+        }
+        write_file(block_store_path + "/manifest", manifest);
+
+        auto bl_store = FlatFile::create(block_store_path);
+        ASSERT_TRUE(bl_store);
+        ASSERT_EQ(bl_store->last_id(), 2);
+      }
+
+      /**
+       * @given block store with last block changed after manifest was written
+       * @when store is reopened
+       * @then manifest is rejected and store is recovered by full scan
+       */
+      TEST_F(BlStore_Test, Corrupted_Manifest_Test) {
+        std::vector<uint8_t> block(1000, 5);
+        {
+          auto bl_store = FlatFile::create(block_store_path);
+          ASSERT_TRUE(bl_store);
+          bl_store->add(1u, block);
+          bl_store->add(2u, block);
+        }
+        write_file(block_store_path + "/0000000000000002",
+                   std::vector<uint8_t>(10, 1));
+
+        auto bl_store = FlatFile::create(block_store_path);
+        ASSERT_TRUE(bl_store);
+        ASSERT_EQ(bl_store->last_id(), 2);
+        ASSERT_EQ(*bl_store->get(2u), std::vector<uint8_t>(10, 1));
+      }
+
+      /**
+       * @given empty block store
+       * @when several blocks are added in one batch
+       * @then all of them are stored and restored after reopening
+       */
+      TEST_F(BlStore_Test, Add_Batch_Test) {
+        BlockBatch blocks;
+        for (auto id = 1u; id <= 3; ++id) {
+          blocks.emplace_back(id, std::vector<uint8_t>(1000, id));
+        }
+        {
+          auto bl_store = FlatFile::create(
+              block_store_path, false, DurabilityPolicy::PerCommit);
+          ASSERT_TRUE(bl_store);
+          bl_store->add_batch(blocks);
+          ASSERT_EQ(bl_store->last_id(), 3);
+        }
+        auto bl_store = FlatFile::create(block_store_path);
+        ASSERT_TRUE(bl_store);
+        ASSERT_EQ(bl_store->last_id(), 3);
+        for (const auto &block : blocks) {
+          ASSERT_EQ(*bl_store->get(block.first), block.second);
+        }
+      }
+
+      /**
+       * @given empty block store and a block which cannot be written
+       * @when a batch containing it is added
+       * @then batch is reported as failed, preceding blocks are stored and
+       * following ones are not, so there is no gap when batch is retried
+       */
+      TEST_F(BlStore_Test, Add_Batch_Failure_Test) {
+        BlockBatch blocks;
+        for (auto id = 1u; id <= 3; ++id) {
+          blocks.emplace_back(id, std::vector<uint8_t>(1000, id));
+        }
+        auto bl_store = FlatFile::create(block_store_path);
+        ASSERT_TRUE(bl_store);
+        auto blocker = block_store_path + "/0000000000000002.tmp";
+        mkdir(blocker.c_str(), S_IRWXU);
+        ASSERT_FALSE(bl_store->add_batch(blocks));
+        ASSERT_EQ(bl_store->last_id(), 1);
+        ASSERT_FALSE(bl_store->get(3u));
+
+        rmdir(blocker.c_str());
+        ASSERT_TRUE(bl_store->add_batch(blocks));
+        ASSERT_EQ(bl_store->last_id(), 3);
+        ASSERT_FALSE(bl_store->add(5u, blocks.back().second));
+        ASSERT_EQ(bl_store->last_id(), 3);
+      }
+
+      /**
+       * @given block store with compression and some plain blocks
+       * @when similar blocks are added until dictionary is trained
+       * @then blocks take less space and are read back unchanged, also
+       * after reopening without compression
+       */
+      TEST_F(BlStore_Test, Compression_Test) {
+        auto make_block = [](uint32_t id) {
+          auto text = "{\"height\": " + std::to_string(id) +
+              ", \"transactions\": [";
+          for (auto i = 0; i < 20; ++i) {
+            text += "{\"command\": \"transfer\", \"amount\": " +
+                std::to_string(id * i) + "}, ";
+          }
+          text += "]}";
+          return std::vector<uint8_t>(text.begin(), text.end());
+        };
+        // last block is compressed with dictionary
+        const auto last_id = 138u;
+        static_assert(last_id > BlockCompressor::kTrainingBlocks,
+                      "dictionary is not trained");
+        {
+          auto plain = FlatFile::create(block_store_path);
+          ASSERT_TRUE(plain);
+          plain->add(1u, std::vector<uint8_t>(1000, 5));
+        }
+        {
+          auto bl_store = FlatFile::create(block_store_path,
+                                           false,
+                                           DurabilityPolicy::None,
+                                           BlockCompression::Zstd);
+          ASSERT_TRUE(bl_store);
+          for (auto id = 2u; id <= last_id; ++id) {
+            bl_store->add(id, make_block(id));
+          }
+          ASSERT_EQ(*bl_store->get(1u), std::vector<uint8_t>(1000, 5));
+          auto view = bl_store->view(last_id);
+          ASSERT_TRUE(view);
+          ASSERT_EQ(std::vector<uint8_t>(view->begin(), view->end()),
+                    make_block(last_id));
+        }
+        ASSERT_LT(read_file(block_store_path + "/0000000000000138").size(),
+                  make_block(last_id).size());
+        ASSERT_FALSE(
+            read_file(block_store_path + "/0000000000000001.dict").empty());
+
+        auto bl_store = FlatFile::create(block_store_path);
+        ASSERT_TRUE(bl_store);
+        ASSERT_EQ(bl_store->last_id(), last_id);
+        for (auto id = 2u; id <= last_id; ++id) {
+          ASSERT_EQ(*bl_store->get(id), make_block(id));
+        }
+      }
+
+      /**
+       * @given compressed frame whose header declares block larger than
+       * kMaxBlockSize, and frame whose size disagrees with its payload
+       * @when frames are decompressed
+       * @then they are rejected before output is allocated
+       */
+      TEST_F(BlStore_Test, Oversized_Frame_Test) {
+        BlockCompressor compressor(block_store_path);
+        std::vector<uint8_t> block(1000, 5);
+        auto frame = compressor.compress(1u, block);
+        ASSERT_TRUE(BlockCompressor::isCompressed(frame.data(), frame.size()));
+        ASSERT_EQ(*compressor.decompress(1u, frame.data(), frame.size()),
+                  block);
+
+        auto oversized = frame;
+        uint32_t raw_size = BlockCompressor::kMaxBlockSize + 1;
+        std::memcpy(&oversized[1], &raw_size, sizeof(raw_size));
+        ASSERT_FALSE(
+            compressor.decompress(1u, oversized.data(), oversized.size()));
+
+        auto mismatched = frame;
+        raw_size = block.size() * 2;
+        std::memcpy(&mismatched[1], &raw_size, sizeof(raw_size));
+        ASSERT_FALSE(
+            compressor.decompress(1u, mismatched.data(), mismatched.size()));
+      }
+
+      /**
+       * @given block store with torn last block and leftover temporary file
+       * @when store is reopened
+       * @then damaged block and temporary file are removed
+       */
+      TEST_F(BlStore_Test, Torn_Write_Test) {
+        std::vector<uint8_t> block(1000, 5);
+        {
+          auto bl_store = FlatFile::create(block_store_path);
+          ASSERT_TRUE(bl_store);
+          for (auto id = 1u; id <= 3; ++id) {
+            bl_store->add(id, block);
+          }
+        }
+        auto last = block_store_path + "/0000000000000003";
+        auto contents = read_file(last);
+        contents.resize(contents.size() - 10);
+        write_file(last, contents);
+        auto tmp = block_store_path + "/0000000000000004.tmp";
+        write_file(tmp, block);
+
+        auto bl_store = FlatFile::create(block_store_path);
+        ASSERT_TRUE(bl_store);
+        ASSERT_EQ(bl_store->last_id(), 2);
+        ASSERT_FALSE(bl_store->get(3u));
+        ASSERT_TRUE(read_file(tmp).empty());
+
+        bl_store->add(3u, block);
+        ASSERT_EQ(bl_store->last_id(), 3);
+        ASSERT_EQ(*bl_store->get(3u), block);
+      }
+
+      TEST_F(BlStore_Test, View_Test) {
+        std::vector<uint8_t> block(100000, 5);
+        auto bl_store = FlatFile::create(block_store_path);
+        ASSERT_TRUE(bl_store);
+
+        bl_store->add(1u, block);
+        auto res = bl_store->view(1u);
+        ASSERT_TRUE(res);
+        ASSERT_EQ(std::vector<uint8_t>(res->begin(), res->end()), block);
+        ASSERT_FALSE(bl_store->view(2u));
+      }
+
+      /**
+       * @given block store with several blocks
+       * @when old blocks are pruned and store is reopened
+       * @then only blocks from the oldest kept one are available, the last
+       * block is never removed and removed blocks can be archived
+       */
+      TEST_F(BlStore_Test, Prune_Test) {
+        std::vector<uint8_t> block(1000, 5);
+        auto archive_path = block_store_path + "/archive";
+        mkdir(archive_path.c_str(), S_IRWXU);
+        {
+          auto bl_store = FlatFile::create(block_store_path);
+          ASSERT_TRUE(bl_store);
+          for (auto id = 1u; id <= 5; ++id) {
+            bl_store->add(id, block);
+          }
+          ASSERT_EQ(bl_store->first_id(), 1);
+          ASSERT_TRUE(bl_store->prune(3u, archive_path));
+          ASSERT_EQ(bl_store->first_id(), 3);
+          ASSERT_FALSE(bl_store->get(2u));
+          ASSERT_EQ(read_file(archive_path + "/0000000000000002"),
+                    read_file(block_store_path + "/0000000000000003"));
+        }
+        auto verified = FlatFile::create(block_store_path, true);
+        ASSERT_TRUE(verified);
+        ASSERT_EQ(verified->first_id(), 3);
+        ASSERT_EQ(verified->last_id(), 5);
+        verified.reset();
+
+        auto bl_store = FlatFile::create(block_store_path);
+        ASSERT_TRUE(bl_store);
+        ASSERT_EQ(bl_store->first_id(), 3);
+        ASSERT_EQ(*bl_store->get(3u), block);
+        bl_store->add(6u, block);
+        ASSERT_TRUE(bl_store->prune(100u, ""));
+        ASSERT_EQ(bl_store->first_id(), 6);
+        ASSERT_EQ(bl_store->last_id(), 6);
+        ASSERT_EQ(*bl_store->get(6u), block);
+      }
+
     }  // namespace block_store
 
   }  // namespace ametsuchi
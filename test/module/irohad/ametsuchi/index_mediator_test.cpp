@@ -0,0 +1,101 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/index/index_mediator.hpp"
+#include <gtest/gtest.h>
+#include "ametsuchi/impl/kv/key_value_block_index.hpp"
+#include "module/irohad/ametsuchi/ametsuchi_mocks.hpp"
+#include "module/irohad/ametsuchi/memory_store.hpp"
+
+using namespace iroha;
+using namespace iroha::ametsuchi;
+using ::testing::_;
+using ::testing::Invoke;
+
+class IndexMediatorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    auto memory = std::make_unique<MemoryStore>();
+    store = memory.get();
+    index = std::make_unique<KeyValueBlockIndex>(std::move(memory));
+    // blocks of requested range, except the missing one
+    ON_CALL(blocks, getBlocks(_, _))
+        .WillByDefault(Invoke([this](uint32_t from, uint32_t to) {
+          std::vector<model::Block> range;
+          for (auto height = from; height <= to; ++height) {
+            if (height != missing) {
+              model::Block block{};
+              block.height = height;
+              block.hash.fill(height);
+              range.push_back(block);
+            }
+          }
+          return rxcpp::observable<>::iterate(range);
+        }));
+  }
+
+  MockBlockQuery blocks;
+  MemoryStore *store;
+  std::unique_ptr<KeyValueBlockIndex> index;
+  uint32_t missing = 0;
+};
+
+/**
+ * @given empty index and storage with more blocks than one batch
+ * @when index is synchronized
+ * @then blocks are written batch by batch
+ */
+TEST_F(IndexMediatorTest, SynchronizeTest) {
+  auto height = IndexMediator::kBatchSize + 10;
+  EXPECT_CALL(blocks, getBlocks(_, _)).Times(2);
+  IndexMediator mediator(blocks, *index);
+  ASSERT_TRUE(mediator.synchronize(height));
+  ASSERT_EQ(index->height(), height);
+  ASSERT_EQ(store->writes, 2);
+  // nothing to do for covered height
+  ASSERT_TRUE(mediator.synchronize(height));
+}
+
+/**
+ * @given storage with unreadable block in the second batch
+ * @when index is synchronized
+ * @then the first batch is kept, so the next attempt resumes after it
+ */
+TEST_F(IndexMediatorTest, ResumeTest) {
+  auto height = IndexMediator::kBatchSize + 10;
+  missing = IndexMediator::kBatchSize + 5;
+  IndexMediator mediator(blocks, *index);
+  ASSERT_FALSE(mediator.synchronize(height));
+  ASSERT_EQ(index->height(), IndexMediator::kBatchSize);
+
+  missing = 0;
+  EXPECT_CALL(blocks, getBlocks(IndexMediator::kBatchSize + 1, height));
+  ASSERT_TRUE(mediator.synchronize(height));
+  ASSERT_EQ(index->height(), height);
+}
+
+/**
+ * @given stopped mediator
+ * @when index is synchronized
+ * @then no blocks are indexed
+ */
+TEST_F(IndexMediatorTest, StopTest) {
+  IndexMediator mediator(blocks, *index);
+  mediator.stop();
+  ASSERT_FALSE(mediator.synchronize(10));
+  ASSERT_EQ(index->height(), 0);
+}
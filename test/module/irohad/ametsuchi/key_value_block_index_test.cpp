@@ -0,0 +1,137 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/kv/key_value_block_index.hpp"
+#include <gtest/gtest.h>
+#include "model/commands/transfer_asset.hpp"
+#include "module/irohad/ametsuchi/memory_store.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    class KeyValueBlockIndexTest : public ::testing::Test {
+     protected:
+      void SetUp() override {
+        auto memory = std::make_unique<MemoryStore>();
+        store = memory.get();
+        index = std::make_unique<KeyValueBlockIndex>(std::move(memory));
+      }
+
+      /**
+       * Block with transaction of alice transferring coin to bob and
+       * transaction of bob without commands
+       */
+      model::Block makeBlock(uint32_t height) {
+        model::Block block{};
+        block.height = height;
+        block.hash.fill(height);
+        model::Transaction transfer{};
+        transfer.creator_account_id = "alice@test";
+        transfer.tx_counter = height;
+        auto command = std::make_shared<model::TransferAsset>();
+        command->src_account_id = "alice@test";
+        command->dest_account_id = "bob@test";
+        command->asset_id = "coin#test";
+        transfer.commands.push_back(command);
+        block.transactions.push_back(transfer);
+        model::Transaction empty{};
+        empty.creator_account_id = "bob@test";
+        empty.tx_counter = height;
+        block.transactions.push_back(empty);
+        return block;
+      }
+
+      MemoryStore *store;
+      std::unique_ptr<KeyValueBlockIndex> index;
+      model::HashProviderImpl hash_provider;
+    };
+
+    /**
+     * @given empty index
+     * @when two blocks are added with one call
+     * @then they are written with one batch and all lookups see them
+     */
+    TEST_F(KeyValueBlockIndexTest, AddTest) {
+      ASSERT_EQ(index->height(), 0);
+      auto first = makeBlock(1), second = makeBlock(2);
+      ASSERT_TRUE(index->add({std::cref(first), std::cref(second)}));
+      ASSERT_EQ(store->writes, 1);
+      ASSERT_EQ(index->height(), 2);
+
+      ASSERT_EQ(index->blockHeight(second.hash), 2);
+      auto position =
+          index->transaction(hash_provider.get_hash(second.transactions[1]));
+      ASSERT_TRUE(position);
+      ASSERT_EQ(position->height, 2);
+      ASSERT_EQ(position->index, 1);
+
+      auto alice = index->accountTransactions("alice@test");
+      ASSERT_TRUE(alice);
+      ASSERT_EQ(alice->size(), 2);
+      ASSERT_EQ((*alice)[0].height, 1);
+      ASSERT_EQ((*alice)[1].height, 2);
+      ASSERT_EQ((*alice)[1].index, 0);
+
+      auto received = index->accountAssetTransactions("bob@test", "coin#test");
+      ASSERT_TRUE(received);
+      ASSERT_EQ(received->size(), 2);
+    }
+
+    /**
+     * @given index with one block
+     * @when unknown keys are looked up
+     * @then nothing is found
+     */
+    TEST_F(KeyValueBlockIndexTest, MissingTest) {
+      auto block = makeBlock(1);
+      ASSERT_TRUE(index->add({std::cref(block)}));
+
+      hash256_t unknown;
+      unknown.fill(0xff);
+      ASSERT_FALSE(index->blockHeight(unknown));
+      ASSERT_FALSE(index->transaction(unknown));
+      // account id which is a prefix of indexed one
+      auto positions = index->accountTransactions("alice@tes");
+      ASSERT_TRUE(positions);
+      ASSERT_TRUE(positions->empty());
+      positions = index->accountAssetTransactions("alice@test", "coin#other");
+      ASSERT_TRUE(positions);
+      ASSERT_TRUE(positions->empty());
+    }
+
+    /**
+     * @given index with many blocks
+     * @when transactions of account are read
+     * @then they are in chain order regardless of key encoding
+     */
+    TEST_F(KeyValueBlockIndexTest, OrderTest) {
+      std::vector<model::Block> blocks;
+      for (uint32_t height = 1; height <= 300; ++height) {
+        blocks.push_back(makeBlock(height));
+      }
+      ASSERT_TRUE(index->add(BlockRefs(blocks.begin(), blocks.end())));
+      auto positions = index->accountTransactions("bob@test");
+      ASSERT_TRUE(positions);
+      ASSERT_EQ(positions->size(), 300);
+      for (uint32_t i = 0; i < positions->size(); ++i) {
+        ASSERT_EQ((*positions)[i].height, i + 1);
+        ASSERT_EQ((*positions)[i].index, 1);
+      }
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,317 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/kv/key_value_wsv_backend.hpp"
+#include <gtest/gtest.h>
+#include "module/irohad/ametsuchi/memory_store.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    class KeyValueWsvBackendTest : public ::testing::Test {
+     protected:
+      void SetUp() override {
+        auto memory = std::make_unique<MemoryStore>();
+        store = memory.get();
+        backend = std::make_unique<KeyValueWsvBackend>(std::move(memory));
+
+        pubkey.fill(1);
+        account.account_id = "alice@test";
+        account.domain_name = "test";
+        account.master_key = pubkey;
+        account.quorum = 1;
+        account.permissions.can_transfer = true;
+        asset.asset_id = "coin#test";
+        asset.domain_id = "test";
+        asset.precision = 2;
+      }
+
+      /**
+       * Create domain, signatory, account and asset in one transaction
+       */
+      void createAccount() {
+        auto transaction = backend->begin();
+        auto command = transaction->command();
+        model::Domain domain;
+        domain.domain_id = "test";
+        ASSERT_TRUE(command->insertDomain(domain));
+        ASSERT_TRUE(command->insertSignatory(pubkey));
+        ASSERT_TRUE(command->insertAccount(account));
+        ASSERT_TRUE(command->insertAccountSignatory(account.account_id,
+                                                    pubkey));
+        ASSERT_TRUE(command->insertAsset(asset));
+        ASSERT_TRUE(transaction->commit());
+      }
+
+      MemoryStore *store;
+      std::unique_ptr<KeyValueWsvBackend> backend;
+      ed25519::pubkey_t pubkey;
+      model::Account account;
+      model::Asset asset;
+    };
+
+    /**
+     * @given backend with committed account and asset
+     * @when they are queried
+     * @then stored values are returned
+     */
+    TEST_F(KeyValueWsvBackendTest, ReadWriteTest) {
+      createAccount();
+      ASSERT_EQ(store->writes, 1);
+
+      auto snapshot = backend->snapshot();
+      auto query = snapshot->query();
+      auto stored = query->getAccount(account.account_id);
+      ASSERT_TRUE(stored);
+      ASSERT_EQ(stored->domain_name, account.domain_name);
+      ASSERT_EQ(stored->master_key, account.master_key);
+      ASSERT_EQ(stored->quorum, account.quorum);
+      ASSERT_TRUE(stored->permissions.can_transfer);
+      ASSERT_FALSE(stored->permissions.issue_assets);
+
+      auto signatories = query->getSignatories(account.account_id);
+      ASSERT_TRUE(signatories);
+      ASSERT_EQ(*signatories, std::vector<ed25519::pubkey_t>{pubkey});
+
+      auto stored_asset = query->getAsset(asset.asset_id);
+      ASSERT_TRUE(stored_asset);
+      ASSERT_EQ(stored_asset->domain_id, asset.domain_id);
+      ASSERT_EQ(stored_asset->precision, asset.precision);
+      ASSERT_FALSE(query->getAccountAsset(account.account_id, asset.asset_id));
+    }
+
+    /**
+     * @given backend with committed account
+     * @when rows violating constraints are inserted
+     * @then inserts fail
+     */
+    TEST_F(KeyValueWsvBackendTest, ConstraintTest) {
+      createAccount();
+      auto transaction = backend->begin();
+      auto command = transaction->command();
+      // duplicates
+      ASSERT_FALSE(command->insertAccount(account));
+      ASSERT_FALSE(command->insertSignatory(pubkey));
+      ASSERT_FALSE(command->insertAsset(asset));
+      // missing references
+      auto orphan = account;
+      orphan.account_id = "bob@none";
+      orphan.domain_name = "none";
+      ASSERT_FALSE(command->insertAccount(orphan));
+      model::AccountAsset balance;
+      balance.account_id = orphan.account_id;
+      balance.asset_id = asset.asset_id;
+      balance.balance = 1;
+      ASSERT_FALSE(command->upsertAccountAsset(balance));
+
+      model::Peer peer;
+      peer.address = "127.0.0.1:50051";
+      peer.pubkey = pubkey;
+      ASSERT_TRUE(command->insertPeer(peer));
+      peer.pubkey.fill(2);
+      ASSERT_FALSE(command->insertPeer(peer));
+    }
+
+    /**
+     * @given transaction over committed state
+     * @when changes are made and transaction is destroyed without commit
+     * @then changes are visible only inside the transaction
+     */
+    TEST_F(KeyValueWsvBackendTest, IsolationTest) {
+      createAccount();
+      model::AccountAsset balance;
+      balance.account_id = account.account_id;
+      balance.asset_id = asset.asset_id;
+      balance.balance = 100;
+      {
+        auto transaction = backend->begin();
+        ASSERT_TRUE(transaction->command()->upsertAccountAsset(balance));
+        auto stored = transaction->query()->getAccountAsset(
+            balance.account_id, balance.asset_id);
+        ASSERT_TRUE(stored);
+        ASSERT_EQ(stored->balance, 100);
+        ASSERT_FALSE(backend->snapshot()->query()->getAccountAsset(
+            balance.account_id, balance.asset_id));
+      }
+      ASSERT_FALSE(backend->snapshot()->query()->getAccountAsset(
+          balance.account_id, balance.asset_id));
+      ASSERT_EQ(store->writes, 1);
+    }
+
+    /**
+     * @given account with several assets, and account which id has the
+     * first one as prefix
+     * @when assets of the first account are queried in pages
+     * @then only its assets are returned, in order of asset id
+     */
+    TEST_F(KeyValueWsvBackendTest, AccountAssetsTest) {
+      createAccount();
+      auto transaction = backend->begin();
+      auto command = transaction->command();
+      auto other = account;
+      other.account_id = "alice@test2";
+      ASSERT_TRUE(command->insertAccount(other));
+      for (auto id : {"gold#test", "coin#test", "silver#test"}) {
+        auto extra = asset;
+        extra.asset_id = id;
+        if (extra.asset_id != asset.asset_id) {
+          ASSERT_TRUE(command->insertAsset(extra));
+        }
+        model::AccountAsset balance;
+        balance.account_id = account.account_id;
+        balance.asset_id = id;
+        balance.balance = 1;
+        ASSERT_TRUE(command->upsertAccountAsset(balance));
+        balance.account_id = other.account_id;
+        ASSERT_TRUE(command->upsertAccountAsset(balance));
+      }
+      auto query = transaction->query();
+
+      auto all = query->getAccountAssets(account.account_id, "", 0);
+      ASSERT_TRUE(all);
+      ASSERT_EQ(3, all->size());
+      ASSERT_EQ("coin#test", all->at(0).asset_id);
+      ASSERT_EQ("gold#test", all->at(1).asset_id);
+      ASSERT_EQ("silver#test", all->at(2).asset_id);
+      for (const auto &balance : *all) {
+        ASSERT_EQ(account.account_id, balance.account_id);
+      }
+
+      auto page = query->getAccountAssets(account.account_id, "coin#test", 1);
+      ASSERT_TRUE(page);
+      ASSERT_EQ(1, page->size());
+      ASSERT_EQ("gold#test", page->at(0).asset_id);
+      ASSERT_TRUE(
+          query->getAccountAssets(account.account_id, "silver#test", 1)
+              ->empty());
+    }
+
+    /**
+     * @given two accounts of domain sharing signatory and asset
+     * @when they are listed by domain, asset and signatory, also over store
+     * written without indexes
+     * @then both accounts are returned in order of account id
+     */
+    TEST_F(KeyValueWsvBackendTest, IndexesTest) {
+      createAccount();
+      auto transaction = backend->begin();
+      auto command = transaction->command();
+      auto other = account;
+      other.account_id = "bob@test";
+      ASSERT_TRUE(command->insertAccount(other));
+      ASSERT_TRUE(command->insertAccountSignatory(other.account_id, pubkey));
+      for (auto id : {account.account_id, other.account_id}) {
+        model::AccountAsset balance;
+        balance.account_id = id;
+        balance.asset_id = asset.asset_id;
+        balance.balance = 1;
+        ASSERT_TRUE(command->upsertAccountAsset(balance));
+      }
+      ASSERT_TRUE(transaction->commit());
+
+      auto check = [&](KeyValueWsvBackend &backend) {
+        auto snapshot = backend.snapshot();
+        auto query = snapshot->query();
+        auto accounts = query->getDomainAccounts("test", "", 0);
+        ASSERT_TRUE(accounts);
+        ASSERT_EQ(2, accounts->size());
+        ASSERT_EQ(account.account_id, accounts->at(0).account_id);
+        ASSERT_EQ(other.account_id, accounts->at(1).account_id);
+        auto page = query->getDomainAccounts("test", account.account_id, 1);
+        ASSERT_EQ(1, page->size());
+        ASSERT_EQ(other.account_id, page->at(0).account_id);
+        ASSERT_TRUE(query->getDomainAccounts("test2", "", 0)->empty());
+
+        auto holders = query->getAssetHolders(asset.asset_id, "", 0);
+        ASSERT_TRUE(holders);
+        ASSERT_EQ(2, holders->size());
+        ASSERT_EQ(other.account_id, holders->at(1).account_id);
+        ASSERT_EQ(1, holders->at(1).balance);
+
+        auto signed_by = query->getAccountsBySignatory(pubkey, "", 1);
+        ASSERT_TRUE(signed_by);
+        ASSERT_EQ(std::vector<std::string>{account.account_id}, *signed_by);
+      };
+      check(*backend);
+
+      // store of previous version has records only
+      auto old_store = std::make_unique<MemoryStore>();
+      for (const auto &pair : store->data) {
+        if (pair.first[0] != 'D' and pair.first[0] != 'h'
+            and pair.first[0] != 'S' and pair.first[0] != 'v') {
+          old_store->data.insert(pair);
+        }
+      }
+      KeyValueWsvBackend rebuilt(std::move(old_store));
+      check(rebuilt);
+
+      auto removal = backend->begin();
+      ASSERT_TRUE(removal->command()->deleteAccountSignatory(account.account_id,
+                                                             pubkey));
+      ASSERT_TRUE(removal->commit());
+      auto snapshot = backend->snapshot();
+      ASSERT_EQ(std::vector<std::string>{other.account_id},
+                *snapshot->query()->getAccountsBySignatory(pubkey, "", 0));
+    }
+
+    /**
+     * @given transaction with savepoint
+     * @when changes after savepoint are rolled back and transaction committed
+     * @then only changes before savepoint are stored
+     */
+    TEST_F(KeyValueWsvBackendTest, SavepointTest) {
+      createAccount();
+      auto other = pubkey;
+      other.fill(3);
+      auto transaction = backend->begin();
+      auto command = transaction->command();
+      ASSERT_TRUE(command->insertSignatory(other));
+
+      transaction->savepoint();
+      ASSERT_TRUE(command->insertAccountSignatory(account.account_id, other));
+      ASSERT_TRUE(command->deleteAccountSignatory(account.account_id, pubkey));
+      ASSERT_EQ(*transaction->query()->getSignatories(account.account_id),
+                std::vector<ed25519::pubkey_t>{other});
+      transaction->rollbackToSavepoint();
+      ASSERT_TRUE(transaction->commit());
+
+      auto snapshot = backend->snapshot();
+      auto query = snapshot->query();
+      ASSERT_EQ(*query->getSignatories(account.account_id),
+                std::vector<ed25519::pubkey_t>{pubkey});
+      // signatory inserted before savepoint is kept
+      auto stranger = account;
+      stranger.account_id = "carol@test";
+      stranger.master_key = other;
+      auto next = backend->begin();
+      ASSERT_TRUE(next->command()->insertAccount(stranger));
+    }
+
+    /**
+     * @given snapshot taken before commit
+     * @when transaction is committed
+     * @then snapshot keeps reading old state, new snapshot sees the commit
+     */
+    TEST_F(KeyValueWsvBackendTest, SnapshotTest) {
+      auto before = backend->snapshot();
+      createAccount();
+      ASSERT_FALSE(before->query()->getAccount(account.account_id));
+      ASSERT_TRUE(backend->snapshot()->query()->getAccount(account.account_id));
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,83 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IROHA_MEMORY_STORE_HPP
+#define IROHA_MEMORY_STORE_HPP
+
+#include <map>
+#include "ametsuchi/impl/kv/key_value_store.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Store keeping data in memory, snapshots are copies of it
+     */
+    class MemoryStore : public KeyValueStore {
+     public:
+      class Snapshot : public KeyValueSnapshot {
+       public:
+        explicit Snapshot(std::map<std::string, std::string> data)
+            : data_(std::move(data)) {}
+
+        nonstd::optional<std::string> get(const std::string &key) override {
+          auto it = data_.find(key);
+          if (it == data_.end()) {
+            return nonstd::nullopt;
+          }
+          return it->second;
+        }
+
+        std::vector<std::pair<std::string, std::string>> scan(
+            const std::string &prefix) override {
+          std::vector<std::pair<std::string, std::string>> result;
+          for (auto it = data_.lower_bound(prefix);
+               it != data_.end() and
+               it->first.compare(0, prefix.size(), prefix) == 0;
+               ++it) {
+            result.push_back(*it);
+          }
+          return result;
+        }
+
+       private:
+        std::map<std::string, std::string> data_;
+      };
+
+      std::unique_ptr<KeyValueSnapshot> snapshot() override {
+        return std::make_unique<Snapshot>(data);
+      }
+
+      bool write(const WriteBatch &batch) override {
+        ++writes;
+        for (const auto &change : batch) {
+          if (change.second) {
+            data[change.first] = *change.second;
+          } else {
+            data.erase(change.first);
+          }
+        }
+        return true;
+      }
+
+      std::map<std::string, std::string> data;
+      int writes = 0;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+#endif  // IROHA_MEMORY_STORE_HPP
@@ -0,0 +1,342 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/segmented_log/segmented_log.hpp"
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "ametsuchi_test_common.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    class SegmentedLogTest : public ::testing::Test {
+     protected:
+      virtual void SetUp() {
+        mkdir(block_store_path.c_str(),
+              S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH);
+      }
+      virtual void TearDown() { remove_all(block_store_path); }
+      std::string block_store_path = "/tmp/segmented_dump";
+    };
+
+    TEST_F(SegmentedLogTest, ReadWriteTest) {
+      std::vector<uint8_t> block(100000, 5);
+      auto bl_store = SegmentedLog::create(block_store_path);
+      ASSERT_TRUE(bl_store);
+      ASSERT_EQ(bl_store->last_id(), 0);
+
+      bl_store->add(1u, block);
+      bl_store->add(2u, std::vector<uint8_t>(10, 7));
+
+      auto res = bl_store->get(1u);
+      ASSERT_TRUE(res);
+      ASSERT_EQ(*res, block);
+      res = bl_store->get(2u);
+      ASSERT_TRUE(res);
+      ASSERT_EQ(*res, std::vector<uint8_t>(10, 7));
+      ASSERT_FALSE(bl_store->get(3u));
+      ASSERT_EQ(bl_store->last_id(), 2);
+    }
+
+    /**
+     * @given segmented log with small segment size
+     * @when blocks are written and log is reopened
+     * @then blocks are spread among several segments and all of them are
+     * readable after reopening
+     */
+    TEST_F(SegmentedLogTest, SegmentRotationTest) {
+      const auto segment_size = 1000u;
+      {
+        auto bl_store = SegmentedLog::create(block_store_path, segment_size);
+        ASSERT_TRUE(bl_store);
+        for (auto id = 1u; id <= 10; ++id) {
+          bl_store->add(id, std::vector<uint8_t>(300, id));
+        }
+      }
+      auto bl_store = SegmentedLog::create(block_store_path, segment_size);
+      ASSERT_TRUE(bl_store);
+      ASSERT_EQ(bl_store->last_id(), 10);
+      for (auto id = 1u; id <= 10; ++id) {
+        auto res = bl_store->get(id);
+        ASSERT_TRUE(res);
+        ASSERT_EQ(*res, std::vector<uint8_t>(300, id));
+      }
+      // segments are named after their first block
+      struct stat buffer;
+      ASSERT_EQ(
+          stat((block_store_path + "/0000000000000005.seg").c_str(), &buffer),
+          0);
+    }
+
+    /**
+     * @given segmented log with several blocks
+     * @when block out of sequence is added
+     * @then it is rejected and last id is not changed
+     */
+    TEST_F(SegmentedLogTest, OutOfOrderTest) {
+      auto bl_store = SegmentedLog::create(block_store_path);
+      ASSERT_TRUE(bl_store);
+      bl_store->add(1u, std::vector<uint8_t>(10, 1));
+      bl_store->add(3u, std::vector<uint8_t>(10, 3));
+      ASSERT_EQ(bl_store->last_id(), 1);
+      ASSERT_FALSE(bl_store->get(3u));
+    }
+
+    /**
+     * @given segmented log with torn tail of data file
+     * @when log is reopened
+     * @then incomplete block is dropped
+     */
+    TEST_F(SegmentedLogTest, TornTailTest) {
+      {
+        auto bl_store = SegmentedLog::create(block_store_path);
+        ASSERT_TRUE(bl_store);
+        bl_store->add(1u, std::vector<uint8_t>(100, 1));
+        bl_store->add(2u, std::vector<uint8_t>(100, 2));
+      }
+      auto data = block_store_path + "/0000000000000001.seg";
+      struct stat buffer;
+      ASSERT_EQ(stat(data.c_str(), &buffer), 0);
+      ASSERT_EQ(truncate(data.c_str(), buffer.st_size - 10), 0);
+
+      auto bl_store = SegmentedLog::create(block_store_path);
+      ASSERT_TRUE(bl_store);
+      ASSERT_EQ(bl_store->last_id(), 1);
+      ASSERT_TRUE(bl_store->get(1u));
+      ASSERT_FALSE(bl_store->get(2u));
+
+      bl_store->add(2u, std::vector<uint8_t>(50, 2));
+      auto res = bl_store->get(2u);
+      ASSERT_TRUE(res);
+      ASSERT_EQ(*res, std::vector<uint8_t>(50, 2));
+    }
+
+    /**
+     * @given segmented log with small segment size
+     * @when batch of blocks larger than one segment is added
+     * @then blocks are split among segments and survive reopening
+     */
+    TEST_F(SegmentedLogTest, AddBatchTest) {
+      const auto segment_size = 1000u;
+      BlockBatch blocks;
+      for (auto id = 1u; id <= 10; ++id) {
+        blocks.emplace_back(id, std::vector<uint8_t>(300, id));
+      }
+      {
+        auto bl_store = SegmentedLog::create(block_store_path, segment_size);
+        ASSERT_TRUE(bl_store);
+        bl_store->add_batch(blocks);
+        ASSERT_EQ(bl_store->last_id(), 10);
+        // already stored blocks are skipped
+        bl_store->add_batch(
+            {{10u, std::vector<uint8_t>(1, 0)}, {11u, {1, 2, 3}}});
+        ASSERT_EQ(bl_store->last_id(), 11);
+      }
+      auto bl_store = SegmentedLog::create(block_store_path, segment_size);
+      ASSERT_TRUE(bl_store);
+      ASSERT_EQ(bl_store->last_id(), 11);
+      for (const auto &block : blocks) {
+        ASSERT_EQ(*bl_store->get(block.first), block.second);
+      }
+      ASSERT_EQ(*bl_store->get(11u), std::vector<uint8_t>({1, 2, 3}));
+      struct stat buffer;
+      ASSERT_EQ(
+          stat((block_store_path + "/0000000000000005.seg").c_str(), &buffer),
+          0);
+    }
+
+    /**
+     * @given segmented log with damaged record header
+     * @when log is reopened in verification mode
+     * @then damaged block and blocks after it are dropped
+     */
+    TEST_F(SegmentedLogTest, VerifyBlocksTest) {
+      {
+        auto bl_store = SegmentedLog::create(block_store_path);
+        ASSERT_TRUE(bl_store);
+        for (auto id = 1u; id <= 3; ++id) {
+          bl_store->add(id, std::vector<uint8_t>(100, id));
+        }
+      }
+      // header of second record follows segment header and first record
+      auto data = block_store_path + "/0000000000000001.seg";
+      auto fd = open(data.c_str(), O_WRONLY);
+      ASSERT_GE(fd, 0);
+      uint32_t size = 7;
+      ASSERT_EQ(pwrite(fd, &size, sizeof(size), 8 + 8 + 100),
+                static_cast<ssize_t>(sizeof(size)));
+      close(fd);
+
+      auto bl_store = SegmentedLog::create(
+          block_store_path, SegmentedLog::kDefaultSegmentSize, true);
+      ASSERT_TRUE(bl_store);
+      ASSERT_EQ(bl_store->last_id(), 1);
+      ASSERT_FALSE(bl_store->get(2u));
+    }
+
+    /**
+     * @given segmented log with flipped byte in the last record
+     * @when log is reopened
+     * @then checksum mismatch is detected and the record is dropped
+     */
+    TEST_F(SegmentedLogTest, ChecksumTest) {
+      {
+        auto bl_store = SegmentedLog::create(block_store_path);
+        ASSERT_TRUE(bl_store);
+        bl_store->add(1u, std::vector<uint8_t>(100, 1));
+        bl_store->add(2u, std::vector<uint8_t>(100, 2));
+      }
+      auto data = block_store_path + "/0000000000000001.seg";
+      auto fd = open(data.c_str(), O_WRONLY);
+      ASSERT_GE(fd, 0);
+      uint8_t byte = 0;
+      ASSERT_EQ(pwrite(fd, &byte, sizeof(byte), 8 + 2 * 8 + 100 + 50),
+                static_cast<ssize_t>(sizeof(byte)));
+      close(fd);
+
+      auto bl_store = SegmentedLog::create(block_store_path);
+      ASSERT_TRUE(bl_store);
+      ASSERT_EQ(bl_store->last_id(), 1);
+      ASSERT_EQ(*bl_store->get(1u), std::vector<uint8_t>(100, 1));
+      ASSERT_FALSE(bl_store->get(2u));
+    }
+
+    /**
+     * @given segmented log with stored block
+     * @when view of the block is taken and more blocks are appended
+     * @then view still refers to the same block contents
+     */
+    TEST_F(SegmentedLogTest, ViewTest) {
+      auto bl_store = SegmentedLog::create(block_store_path, 1000u);
+      ASSERT_TRUE(bl_store);
+      bl_store->add(1u, std::vector<uint8_t>(300, 1));
+
+      auto view = bl_store->view(1u);
+      ASSERT_TRUE(view);
+      for (auto id = 2u; id <= 10; ++id) {
+        bl_store->add(id, std::vector<uint8_t>(300, id));
+      }
+      ASSERT_EQ(std::vector<uint8_t>(view->begin(), view->end()),
+                std::vector<uint8_t>(300, 1));
+
+      for (auto id = 1u; id <= 10; ++id) {
+        auto current = bl_store->view(id);
+        ASSERT_TRUE(current);
+        ASSERT_EQ(std::vector<uint8_t>(current->begin(), current->end()),
+                  *bl_store->get(id));
+      }
+      ASSERT_FALSE(bl_store->view(11u));
+    }
+
+    /**
+     * @given segmented log with several segments
+     * @when old blocks are pruned and log is reopened
+     * @then segments before the oldest kept block are removed, the last
+     * segment is kept
+     */
+    TEST_F(SegmentedLogTest, PruneTest) {
+      const auto segment_size = 1000u;
+      {
+        auto bl_store = SegmentedLog::create(block_store_path, segment_size);
+        ASSERT_TRUE(bl_store);
+        for (auto id = 1u; id <= 10; ++id) {
+          bl_store->add(id, std::vector<uint8_t>(300, id));
+        }
+        ASSERT_EQ(bl_store->first_id(), 1);
+        // first segment holds blocks 1..4
+        ASSERT_TRUE(bl_store->prune(6u, ""));
+        ASSERT_EQ(bl_store->first_id(), 5);
+        ASSERT_FALSE(bl_store->get(4u));
+        ASSERT_TRUE(bl_store->get(5u));
+      }
+      auto bl_store = SegmentedLog::create(block_store_path, segment_size);
+      ASSERT_TRUE(bl_store);
+      ASSERT_EQ(bl_store->first_id(), 5);
+      ASSERT_EQ(bl_store->last_id(), 10);
+
+      ASSERT_TRUE(bl_store->prune(100u, ""));
+      ASSERT_EQ(bl_store->first_id(), 9);
+      ASSERT_EQ(*bl_store->get(10u), std::vector<uint8_t>(300, 10));
+      bl_store->add(11u, std::vector<uint8_t>(300, 11));
+      ASSERT_EQ(bl_store->last_id(), 11);
+    }
+
+    /**
+     * @given segmented log with compression and a plain block
+     * @when similar blocks are added in one batch past dictionary training
+     * @then they take less space than plain ones and are read back
+     * unchanged, also after reopening without compression
+     */
+    TEST_F(SegmentedLogTest, CompressionTest) {
+      auto make_block = [](uint32_t id) {
+        auto text = "{\"height\": " + std::to_string(id) +
+            ", \"transactions\": [";
+        for (auto i = 0; i < 20; ++i) {
+          text += "{\"command\": \"transfer\", \"amount\": " +
+              std::to_string(id * i) + "}, ";
+        }
+        text += "]}";
+        return std::vector<uint8_t>(text.begin(), text.end());
+      };
+      // last block is compressed with dictionary
+      const auto last_id = 138u;
+      static_assert(last_id > BlockCompressor::kTrainingBlocks,
+                    "dictionary is not trained");
+      {
+        auto plain = SegmentedLog::create(block_store_path);
+        ASSERT_TRUE(plain);
+        plain->add(1u, std::vector<uint8_t>(1000, 5));
+      }
+      uint64_t plain_size = 0;
+      BlockBatch batch;
+      for (auto id = 2u; id <= last_id; ++id) {
+        batch.emplace_back(id, make_block(id));
+        plain_size += batch.back().second.size();
+      }
+      {
+        auto bl_store = SegmentedLog::create(block_store_path,
+                                             SegmentedLog::kDefaultSegmentSize,
+                                             false,
+                                             DurabilityPolicy::None,
+                                             BlockCompression::Zstd);
+        ASSERT_TRUE(bl_store);
+        bl_store->add_batch(batch);
+        ASSERT_EQ(bl_store->last_id(), last_id);
+        ASSERT_EQ(*bl_store->get(1u), std::vector<uint8_t>(1000, 5));
+        auto view = bl_store->view(last_id);
+        ASSERT_TRUE(view);
+        ASSERT_EQ(std::vector<uint8_t>(view->begin(), view->end()),
+                  make_block(last_id));
+      }
+      struct stat data;
+      ASSERT_EQ(
+          stat((block_store_path + "/0000000000000001.seg").c_str(), &data),
+          0);
+      ASSERT_LT(static_cast<uint64_t>(data.st_size), plain_size);
+
+      auto bl_store = SegmentedLog::create(block_store_path);
+      ASSERT_TRUE(bl_store);
+      ASSERT_EQ(bl_store->last_id(), last_id);
+      for (const auto &block : batch) {
+        ASSERT_EQ(*bl_store->get(block.first), block.second);
+      }
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
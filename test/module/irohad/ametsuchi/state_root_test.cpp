@@ -0,0 +1,104 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/state_root.hpp"
+#include <gtest/gtest.h>
+
+using namespace iroha;
+using namespace iroha::ametsuchi;
+
+class StateRootTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    key.fill(1);
+    other_key.fill(2);
+
+    domain.domain_id = "test";
+
+    account.account_id = "alice@test";
+    account.domain_name = "test";
+    account.master_key = key;
+    account.quorum = 1;
+
+    asset.asset_id = "coin#test";
+    asset.domain_id = "test";
+    asset.precision = 2;
+
+    balance.account_id = account.account_id;
+    balance.asset_id = asset.asset_id;
+    balance.balance = 100;
+
+    peer.address = "127.0.0.1:50051";
+    peer.pubkey = key;
+  }
+
+  ed25519::pubkey_t key, other_key;
+  model::Domain domain;
+  model::Account account;
+  model::Asset asset;
+  model::AccountAsset balance;
+  model::Peer peer;
+};
+
+/**
+ * @given empty tables
+ * @when rows are written, updated and deleted through state root command
+ * @then root equals the root computed from resulting tables
+ */
+TEST_F(StateRootTest, IncrementalRootMatchesRootOfTables) {
+  BulkTables tables;
+  BulkWsv wsv(tables);
+  StateRoot root;
+  StateRootCommand command(wsv, wsv, root);
+
+  ASSERT_TRUE(command.insertDomain(domain));
+  ASSERT_TRUE(command.insertSignatory(key));
+  ASSERT_TRUE(command.insertAccount(account));
+  ASSERT_TRUE(command.insertAccountSignatory(account.account_id, key));
+  ASSERT_TRUE(command.insertAccountSignatory(account.account_id, other_key));
+  ASSERT_TRUE(command.insertAsset(asset));
+  ASSERT_TRUE(command.upsertAccountAsset(balance));
+  balance.balance = 50;
+  ASSERT_TRUE(command.upsertAccountAsset(balance));
+  account.quorum = 2;
+  ASSERT_TRUE(command.updateAccount(account));
+  ASSERT_TRUE(command.deleteAccountSignatory(account.account_id, key));
+  ASSERT_TRUE(command.insertPeer(peer));
+  ASSERT_TRUE(command.deletePeer(peer));
+
+  ASSERT_EQ(StateRoot::of(tables), root);
+  ASSERT_NE(StateRoot().value(), root.value());
+}
+
+/**
+ * @given the same rows added in different order
+ * @when roots are compared
+ * @then they are equal, and differ once a value changes
+ */
+TEST_F(StateRootTest, RootDoesNotDependOnOrderOfRows) {
+  StateRoot first, second;
+  first.add(StateRoot::row(account));
+  first.add(StateRoot::row(balance));
+  second.add(StateRoot::row(balance));
+  second.add(StateRoot::row(account));
+  ASSERT_EQ(first.value(), second.value());
+
+  second.remove(StateRoot::row(balance));
+  balance.balance = 1;
+  second.add(StateRoot::row(balance));
+  ASSERT_NE(first.value(), second.value());
+}
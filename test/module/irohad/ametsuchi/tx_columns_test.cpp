@@ -0,0 +1,186 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/tx_columns.hpp"
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+#include "ametsuchi_test_common.hpp"
+#include "model/commands/transfer_asset.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    class TxColumnsTest : public ::testing::Test {
+     protected:
+      virtual void SetUp() {
+        mkdir(block_store_path.c_str(),
+              S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH);
+      }
+      virtual void TearDown() { remove_all(block_store_path); }
+
+      /**
+       * Block where alice transfers height % 10 coins to bob, then bob
+       * 1.50 coins to carol on even heights
+       */
+      model::Block makeBlock(uint32_t height) {
+        model::Block block{};
+        block.height = height;
+        block.transactions.push_back(
+            transfer("alice@test", "bob@test", Amount(height % 10, 0)));
+        if (height % 2 == 0) {
+          block.transactions.push_back(
+              transfer("bob@test", "carol@test", Amount(1, 50)));
+        }
+        return block;
+      }
+
+      model::Transaction transfer(const std::string &src,
+                                  const std::string &dest,
+                                  Amount amount = Amount()) {
+        model::Transaction tx{};
+        tx.creator_account_id = src;
+        auto command = std::make_shared<model::TransferAsset>();
+        command->src_account_id = src;
+        command->dest_account_id = dest;
+        command->asset_id = "coin#test";
+        command->amount = amount;
+        tx.commands.push_back(command);
+        return tx;
+      }
+
+      bool add(TxColumns &columns, uint32_t from, uint32_t to) {
+        std::vector<model::Block> blocks;
+        for (auto height = from; height <= to; ++height) {
+          blocks.push_back(makeBlock(height));
+        }
+        return columns.add(BlockRefs(blocks.begin(), blocks.end()));
+      }
+
+      std::vector<uint32_t> heights(const std::vector<TxPosition> &positions,
+                                    uint32_t index) {
+        std::vector<uint32_t> result;
+        for (const auto &position : positions) {
+          EXPECT_EQ(index, position.index);
+          result.push_back(position.height);
+        }
+        return result;
+      }
+
+      std::string block_store_path = "/tmp/tx_columns";
+    };
+
+    /**
+     * @given columns of blocks of two segments
+     * @when transactions of account and of account asset are looked up
+     * @then positions up to requested height are found in chain order
+     */
+    TEST_F(TxColumnsTest, LookupTest) {
+      auto columns = TxColumns::create(block_store_path);
+      ASSERT_TRUE(columns);
+      auto last = TxColumns::kSegmentBlocks + 5;
+      ASSERT_TRUE(add(*columns, 1, last));
+      ASSERT_EQ(last, columns->height());
+
+      auto alice = columns->accountTransactions("alice@test", last);
+      ASSERT_EQ(last, alice.size());
+      ASSERT_EQ(1, alice.front().height);
+      ASSERT_EQ(last, alice.back().height);
+
+      auto bob = columns->accountTransactions("bob@test", 6);
+      ASSERT_EQ((std::vector<uint32_t>{2, 4, 6}), heights(bob, 1));
+
+      auto carol = columns->accountAssetTransactions(
+          "carol@test", "coin#test", last);
+      ASSERT_EQ(last / 2, carol.size());
+      ASSERT_EQ(last - 1, carol.back().height);
+      ASSERT_EQ(1, carol.back().index);
+
+      // bob receives from alice and sends to carol
+      auto bob_coins =
+          columns->accountAssetTransactions("bob@test", "coin#test", 2);
+      ASSERT_EQ(3, bob_coins.size());
+
+      ASSERT_TRUE(columns->accountTransactions("dave@test", last).empty());
+      ASSERT_TRUE(
+          columns->accountAssetTransactions("bob@test", "alice@test", last)
+              .empty());
+    }
+
+    /**
+     * @given columns of blocks of several segments
+     * @when transfers of asset within range over amount are looked up
+     * @then positions of transactions of the range with transfers not
+     * below the amount are found in chain order
+     */
+    TEST_F(TxColumnsTest, AssetTransfersTest) {
+      auto columns = TxColumns::create(block_store_path);
+      ASSERT_TRUE(columns);
+      auto last = 3 * TxColumns::kSegmentBlocks + 5;
+      ASSERT_TRUE(add(*columns, 1, last));
+
+      auto from = TxColumns::kSegmentBlocks - 3, to = last - 2;
+      std::vector<std::pair<uint32_t, uint32_t>> expected;
+      for (auto height = from; height <= to; ++height) {
+        if (height % 10 >= 2) {
+          expected.emplace_back(height, 0);
+        }
+        if (height % 2 == 0) {
+          expected.emplace_back(height, 1);
+        }
+      }
+      auto transfers =
+          columns->assetTransfers("coin#test", from, to, Amount(1, 50));
+      std::vector<std::pair<uint32_t, uint32_t>> found;
+      for (const auto &position : transfers) {
+        found.emplace_back(position.height, position.index);
+      }
+      ASSERT_EQ(expected, found);
+
+      ASSERT_EQ(last + last / 2,
+                columns->assetTransfers("coin#test", 1, last, Amount())
+                    .size());
+      ASSERT_TRUE(
+          columns->assetTransfers("coin#test", 1, last, Amount(10, 0))
+              .empty());
+      ASSERT_TRUE(
+          columns->assetTransfers("gold#test", 1, last, Amount()).empty());
+    }
+
+    /**
+     * @given columns of stored blocks
+     * @when they are reopened and blocks are added again or with a gap
+     * @then restored columns are the same and only following blocks
+     * are appended
+     */
+    TEST_F(TxColumnsTest, ReopenTest) {
+      {
+        auto columns = TxColumns::create(block_store_path);
+        ASSERT_TRUE(add(*columns, 1, 10));
+      }
+      auto columns = TxColumns::create(block_store_path);
+      ASSERT_TRUE(columns);
+      ASSERT_EQ(10, columns->height());
+      ASSERT_EQ(10, columns->accountTransactions("alice@test", 10).size());
+
+      ASSERT_TRUE(add(*columns, 5, 11));
+      ASSERT_TRUE(add(*columns, 13, 13));
+      ASSERT_EQ(11, columns->height());
+      ASSERT_EQ(11, columns->accountTransactions("alice@test", 20).size());
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
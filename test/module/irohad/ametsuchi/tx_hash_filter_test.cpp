@@ -0,0 +1,132 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/tx_hash_filter.hpp"
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "ametsuchi_test_common.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    class TxHashFilterTest : public ::testing::Test {
+     protected:
+      virtual void SetUp() {
+        mkdir(block_store_path.c_str(),
+              S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH);
+      }
+      virtual void TearDown() { remove_all(block_store_path); }
+
+      /**
+       * Block with one transaction distinguished by height
+       */
+      model::Block makeBlock(uint32_t height) {
+        model::Block block{};
+        block.height = height;
+        model::Transaction tx{};
+        // hash covers only the low byte of tx counter
+        tx.creator_account_id = "user" + std::to_string(height) + "@test";
+        block.transactions.push_back(tx);
+        return block;
+      }
+
+      hash256_t txHash(uint32_t height) {
+        return hash_provider.get_hash(makeBlock(height).transactions[0]);
+      }
+
+      std::string block_store_path = "/tmp/tx_hash_filter";
+      model::HashProviderImpl hash_provider;
+    };
+
+    /**
+     * @given bloom filter with inserted hashes
+     * @when it is serialized and restored
+     * @then inserted hashes are found and most others are not
+     */
+    TEST_F(TxHashFilterTest, BloomFilterTest) {
+      BloomFilter filter(TxHashFilter::kSegmentBits, TxHashFilter::kProbes);
+      for (uint32_t i = 1; i <= 1000; ++i) {
+        filter.insert(txHash(i));
+      }
+      auto bytes = filter.serialize();
+      auto restored = BloomFilter::deserialize(bytes.data(), bytes.size());
+      ASSERT_TRUE(restored);
+      auto false_positives = 0;
+      for (uint32_t i = 1; i <= 1000; ++i) {
+        ASSERT_TRUE(restored->mayContain(txHash(i)));
+        false_positives += restored->mayContain(txHash(i + 1000));
+      }
+      ASSERT_LT(false_positives, 10);
+      ASSERT_FALSE(BloomFilter::deserialize(bytes.data(), bytes.size() - 1));
+    }
+
+    /**
+     * @given filter with blocks of two segments
+     * @when it is reopened
+     * @then committed transactions are found and covered height is kept
+     */
+    TEST_F(TxHashFilterTest, PersistenceTest) {
+      auto last = TxHashFilter::kSegmentBlocks + 10;
+      {
+        auto filter = TxHashFilter::create(block_store_path);
+        ASSERT_TRUE(filter);
+        ASSERT_EQ(filter->height(), 0);
+        std::vector<model::Block> blocks;
+        for (uint32_t height = 1; height <= last; ++height) {
+          blocks.push_back(makeBlock(height));
+        }
+        ASSERT_TRUE(filter->add(BlockRefs(blocks.begin(), blocks.end())));
+        ASSERT_EQ(filter->height(), last);
+      }
+      auto filter = TxHashFilter::create(block_store_path);
+      ASSERT_TRUE(filter);
+      ASSERT_EQ(filter->height(), last);
+      ASSERT_TRUE(filter->mayContain(txHash(1)));
+      ASSERT_TRUE(filter->mayContain(txHash(last)));
+      ASSERT_FALSE(filter->mayContain(txHash(last + 1)));
+    }
+
+    /**
+     * @given stored filters of two segments
+     * @when filter of the first one is damaged
+     * @then covered height stops before it, so the blocks are added again
+     */
+    TEST_F(TxHashFilterTest, DamagedFilterTest) {
+      auto last = TxHashFilter::kSegmentBlocks + 1;
+      {
+        auto filter = TxHashFilter::create(block_store_path);
+        std::vector<model::Block> blocks;
+        for (uint32_t height = 1; height <= last; ++height) {
+          blocks.push_back(makeBlock(height));
+        }
+        ASSERT_TRUE(filter->add(BlockRefs(blocks.begin(), blocks.end())));
+      }
+      auto name = block_store_path + "/0000000000000001.bloom";
+      ASSERT_EQ(truncate(name.c_str(), 100), 0);
+
+      auto filter = TxHashFilter::create(block_store_path);
+      ASSERT_TRUE(filter);
+      ASSERT_EQ(filter->height(), 0);
+      auto block = makeBlock(1);
+      ASSERT_TRUE(filter->add({std::cref(block)}));
+      ASSERT_EQ(filter->height(), 1);
+      ASSERT_TRUE(filter->mayContain(txHash(1)));
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
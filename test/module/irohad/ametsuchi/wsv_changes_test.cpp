@@ -0,0 +1,87 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/wsv_changes.hpp"
+#include <gtest/gtest.h>
+#include "ametsuchi/impl/bulk_wsv.hpp"
+
+using namespace iroha;
+using namespace iroha::ametsuchi;
+
+class WsvChangesTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    key.fill(1);
+
+    account.account_id = "alice@test";
+    account.domain_name = "test";
+    account.master_key = key;
+    account.quorum = 1;
+
+    existing = account;
+    existing.account_id = "bob@test";
+
+    balance.account_id = account.account_id;
+    balance.asset_id = "coin#test";
+    balance.balance = 100;
+
+    tables.accounts.emplace(existing.account_id, existing);
+  }
+
+  ed25519::pubkey_t key;
+  model::Account account, existing;
+  model::AccountAsset balance;
+  BulkTables tables;
+};
+
+/**
+ * @given command recording changes of a block
+ * @when rows are written several times through it
+ * @then accounts and account assets are exported at their final values,
+ * signatories in order of execution
+ */
+TEST_F(WsvChangesTest, KeepsFinalValuesOfRows) {
+  BulkWsv wsv(tables);
+  WsvChanges changes;
+  WsvChangesCommand command(wsv, changes);
+
+  ASSERT_TRUE(command.insertAccount(account));
+  account.quorum = 2;
+  ASSERT_TRUE(command.updateAccount(account));
+  existing.quorum = 3;
+  ASSERT_TRUE(command.updateAccount(existing));
+  ASSERT_TRUE(command.upsertAccountAsset(balance));
+  balance.balance = 50;
+  ASSERT_TRUE(command.upsertAccountAssets({balance}));
+  ASSERT_TRUE(command.insertAccountSignatory(account.account_id, key));
+  ASSERT_TRUE(command.deleteAccountSignatory(account.account_id, key));
+  // duplicate is rejected by the wrapped command and not recorded
+  ASSERT_FALSE(command.insertAccount(existing));
+
+  auto pb_changes = changes.serialize(7);
+  ASSERT_EQ(7, pb_changes.height());
+  ASSERT_EQ(1, pb_changes.new_accounts_size());
+  ASSERT_EQ(account.account_id, pb_changes.new_accounts(0).account_id());
+  ASSERT_EQ(2, pb_changes.new_accounts(0).quorum());
+  ASSERT_EQ(1, pb_changes.updated_accounts_size());
+  ASSERT_EQ(3, pb_changes.updated_accounts(0).quorum());
+  ASSERT_EQ(1, pb_changes.account_assets_size());
+  ASSERT_EQ(50, pb_changes.account_assets(0).balance());
+  ASSERT_EQ(2, pb_changes.signatories_size());
+  ASSERT_FALSE(pb_changes.signatories(0).removed());
+  ASSERT_TRUE(pb_changes.signatories(1).removed());
+}
@@ -0,0 +1,213 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ametsuchi/impl/wsv_snapshot.hpp"
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+#include <cstdio>
+#include "ametsuchi/impl/kv/key_value_wsv_backend.hpp"
+#include "ametsuchi/impl/record_codec.hpp"
+#include "ametsuchi_test_common.hpp"
+#include "crypto/crypto.hpp"
+#include "crypto/hash.hpp"
+#include "module/irohad/ametsuchi/memory_store.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    class WsvSnapshotTest : public ::testing::Test {
+     protected:
+      void SetUp() override {
+        mkdir(block_store_path.c_str(),
+              S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH);
+        backend = std::make_unique<KeyValueWsvBackend>(
+            std::make_unique<MemoryStore>());
+        keypair = create_keypair(create_seed("snapshot"));
+      }
+      void TearDown() override { remove_all(block_store_path); }
+
+      /**
+       * Fill world state view with one row in every table
+       */
+      void fillState() {
+        ed25519::pubkey_t pubkey;
+        pubkey.fill(1);
+        model::Domain domain;
+        domain.domain_id = "test";
+        model::Account account;
+        account.account_id = "alice@test";
+        account.domain_name = "test";
+        account.master_key = pubkey;
+        account.quorum = 1;
+        account.permissions.can_transfer = true;
+        model::Asset asset;
+        asset.asset_id = "coin#test";
+        asset.domain_id = "test";
+        asset.precision = 2;
+        model::AccountAsset balance;
+        balance.account_id = account.account_id;
+        balance.asset_id = asset.asset_id;
+        balance.balance = 150;
+        model::Peer peer;
+        peer.address = "127.0.0.1:50541";
+        peer.pubkey = pubkey;
+
+        auto transaction = backend->begin();
+        auto command = transaction->command();
+        ASSERT_TRUE(command->insertDomain(domain));
+        ASSERT_TRUE(command->insertSignatory(pubkey));
+        ASSERT_TRUE(command->insertAccount(account));
+        ASSERT_TRUE(command->insertAccountSignatory(account.account_id,
+                                                    pubkey));
+        ASSERT_TRUE(command->insertAsset(asset));
+        ASSERT_TRUE(command->upsertAccountAsset(balance));
+        ASSERT_TRUE(command->insertPeer(peer));
+        ASSERT_TRUE(transaction->commit());
+      }
+
+      WsvSnapshot makeSnapshot(uint32_t height) {
+        WsvSnapshot snapshot{height, {}, {}};
+        snapshot.top_hash.fill(height);
+        backend->snapshot()->dump(snapshot.tables);
+        return snapshot;
+      }
+
+      std::string block_store_path = "/tmp/wsv_snapshot";
+      std::unique_ptr<KeyValueWsvBackend> backend;
+      ed25519::keypair_t keypair;
+    };
+
+    /**
+     * @given world state view with rows in all tables
+     * @when it is exported to snapshot and read back
+     * @then all rows are restored
+     */
+    TEST_F(WsvSnapshotTest, ExportReadTest) {
+      fillState();
+      WsvSnapshotStore store(block_store_path);
+      ASSERT_TRUE(store.write(makeSnapshot(10), nonstd::nullopt));
+
+      ASSERT_EQ(store.heights(), std::vector<uint32_t>{10});
+      auto snapshot = store.read(10, {});
+      ASSERT_TRUE(snapshot);
+      ASSERT_EQ(snapshot->height, 10);
+      ASSERT_EQ(snapshot->top_hash, makeSnapshot(10).top_hash);
+      const auto &tables = snapshot->tables;
+      ASSERT_EQ(tables.domains.size(), 1);
+      ASSERT_EQ(tables.signatories.size(), 1);
+      ASSERT_EQ(tables.accounts.at("alice@test").domain_name, "test");
+      ASSERT_TRUE(tables.accounts.at("alice@test").permissions.can_transfer);
+      ASSERT_EQ(tables.account_signatories.at("alice@test").size(), 1);
+      ASSERT_EQ(tables.assets.at("coin#test").precision, 2);
+      ASSERT_EQ(
+          tables.account_assets.at({"alice@test", "coin#test"}).balance, 150);
+      ASSERT_EQ(tables.peers.size(), 1);
+      ASSERT_EQ(tables.peers[0].address, "127.0.0.1:50541");
+    }
+
+    /**
+     * @given snapshot signed by a key
+     * @when it is read with and without that key trusted, or changed
+     * @then it is accepted only if intact and signed by a trusted key
+     */
+    TEST_F(WsvSnapshotTest, SignatureTest) {
+      fillState();
+      WsvSnapshotStore store(block_store_path);
+      ASSERT_TRUE(store.write(makeSnapshot(1), keypair));
+      ASSERT_TRUE(store.write(makeSnapshot(2), nonstd::nullopt));
+
+      ed25519::pubkey_t other;
+      other.fill(2);
+      ASSERT_TRUE(store.read(1, {keypair.pubkey}));
+      ASSERT_TRUE(store.read(1, {}));
+      ASSERT_FALSE(store.read(1, {other}));
+      // unsigned snapshot is trusted only without trusted keys
+      ASSERT_TRUE(store.read(2, {}));
+      ASSERT_FALSE(store.read(2, {keypair.pubkey}));
+
+      auto name = block_store_path + "/0000000000000001.wsv";
+      FILE *pfile = fopen(name.c_str(), "r+b");
+      ASSERT_NE(pfile, nullptr);
+      fseek(pfile, 8, SEEK_SET);
+      fputc(0xff, pfile);
+      fclose(pfile);
+      ASSERT_FALSE(store.read(1, {}));
+    }
+
+    /**
+     * @given unsigned snapshot of version 1, written before accounts had
+     * tx_counter
+     * @when it is read
+     * @then it is accepted and counter of its account is zero
+     */
+    TEST_F(WsvSnapshotTest, ReadVersionOneTest) {
+      ed25519::pubkey_t pubkey;
+      pubkey.fill(1);
+      hash256_t top_hash;
+      top_hash.fill(5);
+      RecordEncoder encoder;
+      encoder.u64(1).u64(5).blob(top_hash);
+      encoder.u64(1).str("test");
+      encoder.u64(1).pubkey(pubkey);
+      encoder.u64(1)
+          .str("alice@test")
+          .str("test")
+          .pubkey(pubkey)
+          .u64(1)
+          .u64(model::Account::Permissions().toBitmask());
+      encoder.u64(1).str("alice@test").u64(1).pubkey(pubkey);
+      encoder.u64(0);
+      encoder.u64(0);
+      encoder.u64(0);
+      auto bytes = "IRWS" + encoder.value();
+      auto hash = sha3_256(reinterpret_cast<const uint8_t *>(bytes.data()),
+                           bytes.size());
+      bytes.append(hash.begin(), hash.end());
+      bytes.append(ed25519::pubkey_t::size() + ed25519::sig_t::size(), '\0');
+
+      auto name = block_store_path + "/0000000000000005.wsv";
+      FILE *pfile = fopen(name.c_str(), "wb");
+      ASSERT_NE(pfile, nullptr);
+      ASSERT_EQ(fwrite(bytes.data(), 1, bytes.size(), pfile), bytes.size());
+      fclose(pfile);
+
+      WsvSnapshotStore store(block_store_path);
+      auto snapshot = store.read(5, {});
+      ASSERT_TRUE(snapshot);
+      ASSERT_EQ(snapshot->top_hash, top_hash);
+      const auto &account = snapshot->tables.accounts.at("alice@test");
+      ASSERT_EQ(account.quorum, 1);
+      ASSERT_EQ(account.tx_counter, 0);
+      ASSERT_EQ(snapshot->tables.account_signatories.at("alice@test").size(),
+                1);
+    }
+
+    /**
+     * @given store with several written snapshots
+     * @when heights are listed
+     * @then only the latest ones are kept
+     */
+    TEST_F(WsvSnapshotTest, PruneTest) {
+      WsvSnapshotStore store(block_store_path);
+      for (uint32_t height = 1; height <= 4; ++height) {
+        ASSERT_TRUE(store.write(makeSnapshot(height), nonstd::nullopt));
+      }
+      ASSERT_EQ(store.heights(), (std::vector<uint32_t>{3, 4}));
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
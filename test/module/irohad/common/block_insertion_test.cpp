@@ -136,7 +136,7 @@ TEST(JsonRepr, JsonBlockReprGeneration) {
 
   JsonBlockFactory serializer;
   auto blob = serializer.serialize(generateBlock());
-  auto json_block = jsonToString(blob);
+  auto json_block = jsonToString(blob, true);
 
   cout << json_block << endl;
   ASSERT_TRUE(save_to_file(json_block, "zero.block"));
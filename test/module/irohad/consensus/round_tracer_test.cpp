@@ -0,0 +1,102 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include "consensus/round_tracer.hpp"
+
+using namespace iroha::consensus;
+using namespace std::chrono_literals;
+
+/**
+ * @given histogram
+ * @when values on bucket bounds and above all bounds are observed
+ * @then values fall into buckets with inclusive upper bound
+ */
+TEST(LatencyHistogramTest, BucketsHaveInclusiveBounds) {
+  LatencyHistogram histogram;
+  histogram.observe(1ms);
+  histogram.observe(3ms);
+  histogram.observe(10000ms);
+
+  ASSERT_EQ(histogram.buckets().front(), 1);
+  ASSERT_EQ(histogram.buckets()[2], 1);
+  ASSERT_EQ(histogram.buckets().back(), 1);
+  ASSERT_EQ(histogram.count(), 3);
+  ASSERT_EQ(histogram.sum(), 10004);
+}
+
+/**
+ * @given tracer
+ * @when phases of round are marked twice
+ * @then the first mark of each phase is kept
+ */
+TEST(RoundTracerTest, FirstMarkIsKept) {
+  RoundTracer tracer;
+  auto start = RoundTracer::Clock::now();
+  tracer.mark(2, RoundPhase::ProposalReceived, start);
+  tracer.mark(2, RoundPhase::ProposalReceived, start + 5ms);
+
+  auto trace = tracer.round(2);
+  ASSERT_TRUE(trace);
+  ASSERT_EQ(
+      trace->phases[static_cast<size_t>(RoundPhase::ProposalReceived)], start);
+  ASSERT_FALSE(trace->phases[static_cast<size_t>(RoundPhase::Voted)]);
+  ASSERT_FALSE(tracer.round(3));
+}
+
+/**
+ * @given tracer with committed round which skipped voting
+ * @when report is rendered
+ * @then phase durations are measured from previous observed phase
+ * and votes are reported per peer
+ */
+TEST(RoundTracerTest, CommittedRoundIsReported) {
+  RoundTracer tracer;
+  auto start = RoundTracer::Clock::now();
+  tracer.mark(2, RoundPhase::ProposalReceived, start);
+  tracer.mark(2, RoundPhase::ProposalVerified, start + 3ms);
+  tracer.mark(2, RoundPhase::Supermajority, start + 30ms);
+  tracer.mark(2, RoundPhase::Committed, start + 31ms);
+  tracer.voteArrived("peer", 7ms);
+
+  auto report = tracer.report();
+  ASSERT_NE(report.find("iroha_round_phase_ms_bucket{phase=\"verified\","
+                        "le=\"5\"} 1"),
+            std::string::npos);
+  ASSERT_NE(
+      report.find("iroha_round_phase_ms_sum{phase=\"supermajority\"} 27"),
+      std::string::npos);
+  ASSERT_NE(report.find("iroha_round_phase_ms_count{phase=\"voted\"} 0"),
+            std::string::npos);
+  ASSERT_NE(report.find("iroha_vote_latency_ms_bucket{peer=\"peer\","
+                        "le=\"10\"} 1"),
+            std::string::npos);
+}
+
+/**
+ * @given tracer
+ * @when more rounds than kept are marked
+ * @then the oldest rounds are evicted
+ */
+TEST(RoundTracerTest, OldRoundsAreEvicted) {
+  RoundTracer tracer;
+  for (uint64_t i = 0; i <= RoundTracer::kRoundsKept; ++i) {
+    tracer.mark(i, RoundPhase::ProposalReceived);
+  }
+  ASSERT_FALSE(tracer.round(0));
+  ASSERT_TRUE(tracer.round(RoundTracer::kRoundsKept));
+}
@@ -0,0 +1,97 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include "consensus/yac/impl/adaptive_timer.hpp"
+
+using namespace iroha::consensus::yac;
+
+class ManualTimer : public Timer {
+ public:
+  void invokeAfterDelay(uint64_t millis,
+                        std::function<void()> handler) override {
+    last_delay = millis;
+  }
+  void deny() override {}
+
+  uint64_t last_delay = 0;
+};
+
+class AdaptiveTimerTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    inner = std::make_shared<ManualTimer>();
+    timer = std::make_shared<AdaptiveTimer>(inner, 20000);
+    peer.address = "leader";
+  }
+
+  std::shared_ptr<ManualTimer> inner;
+  std::shared_ptr<AdaptiveTimer> timer;
+  iroha::model::Peer peer;
+};
+
+/**
+ * @given adaptive timer without observations
+ * @when delay for peer is requested
+ * @then configured delay is used
+ */
+TEST_F(AdaptiveTimerTest, UsesBaseDelayForUnknownPeer) {
+  ASSERT_EQ(5000, timer->delayFor(peer, 5000));
+  timer->invokeAfterDelay(42, [] {});
+  ASSERT_EQ(42, inner->last_delay);
+}
+
+/**
+ * @given peer which answers in stable time
+ * @when delay for peer is requested
+ * @then it converges to answer time and respects lower bound
+ */
+TEST_F(AdaptiveTimerTest, TracksAnswerTime) {
+  for (int i = 0; i < 50; ++i) {
+    timer->onAnswer(peer, 400);
+  }
+  auto delay = timer->delayFor(peer, 5000);
+  ASSERT_GE(delay, 400);
+  ASSERT_LT(delay, 500);
+
+  for (int i = 0; i < 50; ++i) {
+    timer->onAnswer(peer, 1);
+  }
+  ASSERT_EQ(AdaptiveTimer::kMinDelay, timer->delayFor(peer, 5000));
+}
+
+/**
+ * @given measured peer
+ * @when it times out repeatedly and answers again
+ * @then delay doubles up to upper bound and is reset by answer
+ */
+TEST_F(AdaptiveTimerTest, BacksOffOnTimeout) {
+  for (int i = 0; i < 50; ++i) {
+    timer->onAnswer(peer, 1000);
+  }
+  auto delay = timer->delayFor(peer, 5000);
+  timer->onTimeout(peer);
+  ASSERT_EQ(2 * delay, timer->delayFor(peer, 5000));
+
+  for (int i = 0; i < 10; ++i) {
+    timer->onTimeout(peer);
+  }
+  ASSERT_EQ(20000, timer->delayFor(peer, 5000));
+
+  timer->onAnswer(peer, 1000);
+  ASSERT_LT(timer->delayFor(peer, 5000), 2 * delay);
+}
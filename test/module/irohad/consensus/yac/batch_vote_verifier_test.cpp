@@ -0,0 +1,101 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <future>
+#include <vector>
+#include "consensus/yac/impl/batch_vote_verifier.hpp"
+#include "module/irohad/consensus/yac/yac_mocks.hpp"
+
+using namespace iroha::consensus::yac;
+
+/**
+ * Crypto provider which rejects votes for block "invalid" and records sizes
+ * of verified batches
+ */
+class BatchRecordingCryptoProvider : public YacCryptoProvider {
+ public:
+  bool verify(CommitMessage) override { return true; }
+
+  bool verify(RejectMessage) override { return true; }
+
+  bool verify(VoteMessage msg) override {
+    return msg.hash != mk_hash("proposal", "invalid");
+  }
+
+  std::vector<bool> verifyBatch(
+      const std::vector<VoteMessage> &votes) override {
+    batches.push_back(votes.size());
+    return YacCryptoProvider::verifyBatch(votes);
+  }
+
+  VoteMessage getVote(YacHash hash) override { return VoteMessage{hash, {}}; }
+
+  // accessed only by verifier thread until it is stopped
+  std::vector<size_t> batches;
+};
+
+VoteMessage makeVote(const std::string &block) {
+  return VoteMessage{mk_hash("proposal", block), {}};
+}
+
+/**
+ * @given batch verifier with long window
+ * @when several votes are submitted together, one of them is invalid
+ * @then votes are verified as one batch and handlers are invoked in order
+ * of submission, invalid vote gets its own handler
+ */
+TEST(BatchVoteVerifierTest, VotesOfWindowAreVerifiedTogether) {
+  auto crypto = std::make_shared<BatchRecordingCryptoProvider>();
+  std::vector<int> handled;
+  std::promise<void> done;
+  {
+    BatchVoteVerifier verifier(crypto, std::chrono::milliseconds(100));
+    verifier.verify(makeVote("1"), [&] { handled.push_back(1); });
+    verifier.verify(makeVote("invalid"),
+                    [&] { handled.push_back(2); },
+                    [&] { handled.push_back(-2); });
+    verifier.verify(makeVote("3"), [&] {
+      handled.push_back(3);
+      done.set_value();
+    });
+    ASSERT_EQ(std::future_status::ready,
+              done.get_future().wait_for(std::chrono::seconds(5)));
+  }
+
+  ASSERT_EQ(std::vector<int>({1, -2, 3}), handled);
+  ASSERT_EQ(std::vector<size_t>({3}), crypto->batches);
+}
+
+/**
+ * @given batch verifier with window longer than test timeout
+ * @when votes fill the batch
+ * @then batch is verified without waiting for the window
+ */
+TEST(BatchVoteVerifierTest, FullBatchIsVerifiedImmediately) {
+  auto crypto = std::make_shared<BatchRecordingCryptoProvider>();
+  std::promise<void> done;
+  {
+    BatchVoteVerifier verifier(crypto, std::chrono::seconds(60), 2);
+    verifier.verify(makeVote("1"), [] {});
+    verifier.verify(makeVote("2"), [&] { done.set_value(); });
+    ASSERT_EQ(std::future_status::ready,
+              done.get_future().wait_for(std::chrono::seconds(5)));
+  }
+
+  ASSERT_EQ(std::vector<size_t>({2}), crypto->batches);
+}
@@ -0,0 +1,105 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include "consensus/yac/commit_certificate.hpp"
+#include "module/irohad/consensus/yac/yac_mocks.hpp"
+
+using namespace iroha::consensus::yac;
+
+class CommitCertificateTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    for (uint8_t i = 0; i < 10; ++i) {
+      iroha::model::Peer peer;
+      peer.address = std::to_string(i);
+      peer.pubkey.fill(i);
+      peers.push_back(peer);
+    }
+  }
+
+  VoteMessage makeVote(size_t peer) {
+    VoteMessage vote{};
+    vote.hash = hash;
+    vote.signature.pubkey = peers.at(peer).pubkey;
+    vote.signature.signature.fill(peer);
+    return vote;
+  }
+
+  std::vector<iroha::model::Peer> peers;
+  YacHash hash = mk_hash("proposal", "block");
+};
+
+/**
+ * @given votes of some peers in arbitrary order
+ * @when certificate is made and opened with the same peer list
+ * @then votes are restored in order of peer list
+ */
+TEST_F(CommitCertificateTest, RoundTrip) {
+  std::vector<VoteMessage> votes{makeVote(9), makeVote(0), makeVote(4)};
+  auto certificate = makeCertificate(votes, peers);
+  ASSERT_TRUE(certificate);
+  ASSERT_EQ(2, certificate->signers.size());
+  ASSERT_EQ(3, certificate->signatures.size());
+
+  auto opened = openCertificate(*certificate, peers);
+  ASSERT_TRUE(opened);
+  std::vector<VoteMessage> expected{makeVote(0), makeVote(4), makeVote(9)};
+  ASSERT_EQ(expected, *opened);
+}
+
+/**
+ * @given votes for different hashes, repeated or unknown signers
+ * @when certificate is made
+ * @then it is not created
+ */
+TEST_F(CommitCertificateTest, RejectsInconsistentVotes) {
+  auto other = makeVote(1);
+  other.hash.block_hash = mk_hash("proposal", "other").block_hash;
+  ASSERT_FALSE(makeCertificate({makeVote(0), other}, peers));
+  ASSERT_FALSE(makeCertificate({makeVote(2), makeVote(2)}, peers));
+
+  auto unknown = makeVote(3);
+  unknown.signature.pubkey.fill(42);
+  ASSERT_FALSE(makeCertificate({unknown}, peers));
+  ASSERT_FALSE(makeCertificate({}, peers));
+}
+
+/**
+ * @given certificate
+ * @when it is opened with mismatching bitmap or signatures
+ * @then votes are not restored
+ */
+TEST_F(CommitCertificateTest, RejectsMalformedCertificate) {
+  auto certificate = makeCertificate({makeVote(1), makeVote(2)}, peers);
+  ASSERT_TRUE(certificate);
+
+  auto extra_signature = *certificate;
+  extra_signature.signatures.push_back({});
+  ASSERT_FALSE(openCertificate(extra_signature, peers));
+
+  auto missing_signature = *certificate;
+  missing_signature.signatures.pop_back();
+  ASSERT_FALSE(openCertificate(missing_signature, peers));
+
+  auto out_of_range = *certificate;
+  out_of_range.signers.back() |= 0x80;
+  ASSERT_FALSE(openCertificate(out_of_range, peers));
+
+  std::vector<iroha::model::Peer> fewer(peers.begin(), peers.begin() + 7);
+  ASSERT_FALSE(openCertificate(*certificate, fewer));
+}
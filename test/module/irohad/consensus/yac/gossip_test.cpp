@@ -0,0 +1,108 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include "consensus/yac/impl/gossip.hpp"
+
+using namespace iroha::consensus::yac;
+
+/**
+ * @given relay tree over peer list for every origin and fanout
+ * @when targets of all peers are collected
+ * @then each peer except origin receives message exactly once
+ * and nobody sends more than fanout messages
+ */
+TEST(GossipTest, RelayTreeCoversPeersOnce) {
+  size_t peers = 13;
+  for (size_t fanout = 1; fanout <= 4; ++fanout) {
+    for (size_t origin = 0; origin < peers; ++origin) {
+      std::vector<size_t> received(peers, 0);
+      for (size_t self = 0; self < peers; ++self) {
+        auto targets = relayTargets(self, origin, peers, fanout);
+        ASSERT_LE(targets.size(), fanout);
+        for (auto target : targets) {
+          ++received.at(target);
+        }
+      }
+      for (size_t peer = 0; peer < peers; ++peer) {
+        ASSERT_EQ(peer == origin ? 0 : 1, received[peer]);
+      }
+    }
+  }
+}
+
+/**
+ * @given relay tree with fanout 2 rooted at peer 3 of 7
+ * @when targets of origin are computed
+ * @then they are the next two peers in the list
+ */
+TEST(GossipTest, OriginRelaysToNextPeers) {
+  ASSERT_EQ((std::vector<size_t>{4, 5}), relayTargets(3, 3, 7, 2));
+  ASSERT_EQ((std::vector<size_t>{6, 0}), relayTargets(4, 3, 7, 2));
+  ASSERT_TRUE(relayTargets(0, 0, 7, 0).empty());
+  ASSERT_TRUE(relayTargets(7, 0, 7, 2).empty());
+}
+
+/**
+ * @given recent messages set with capacity of two keys
+ * @when keys are inserted
+ * @then repeated keys are reported until they are forgotten
+ */
+TEST(GossipTest, RecentMessagesForgetsOldest) {
+  RecentMessages recent(2);
+  ASSERT_TRUE(recent.insert("a"));
+  ASSERT_FALSE(recent.insert("a"));
+  ASSERT_TRUE(recent.insert("b"));
+  ASSERT_TRUE(recent.insert("c"));
+  ASSERT_FALSE(recent.insert("b"));
+  ASSERT_TRUE(recent.insert("a"));
+}
+
+/**
+ * @given duplicate filter with window of 100 ms
+ * @when copies of a message arrive inside and after the window
+ * @then only the first copy and the copy after the window pass
+ */
+TEST(GossipTest, DuplicateFilterDropsRetransmissions) {
+  using namespace std::chrono_literals;
+  DuplicateFilter filter(2, 100ms);
+  auto start = DuplicateFilter::Clock::now();
+
+  ASSERT_TRUE(filter.admit("vote", start));
+  ASSERT_FALSE(filter.admit("vote", start + 10ms));
+  ASSERT_FALSE(filter.admit("vote", start + 99ms));
+  ASSERT_TRUE(filter.admit("other", start + 10ms));
+  ASSERT_TRUE(filter.admit("vote", start + 100ms));
+  ASSERT_FALSE(filter.admit("vote", start + 150ms));
+}
+
+/**
+ * @given duplicate filter with capacity of two keys
+ * @when third key is admitted
+ * @then the oldest key is forgotten
+ */
+TEST(GossipTest, DuplicateFilterForgetsOldestKey) {
+  using namespace std::chrono_literals;
+  DuplicateFilter filter(2, 100ms);
+  auto now = DuplicateFilter::Clock::now();
+
+  ASSERT_TRUE(filter.admit("first", now));
+  ASSERT_TRUE(filter.admit("second", now));
+  ASSERT_TRUE(filter.admit("third", now));
+  ASSERT_TRUE(filter.admit("first", now));
+}
@@ -35,8 +35,7 @@ TEST(NetworkTest, MessageHandledWhenMessageSent) {
       std::make_shared<NetworkImpl>(peer.address, peers);
 
   VoteMessage message;
-  message.hash.proposal_hash = "proposal";
-  message.hash.block_hash = "block";
+  message.hash = mk_hash("proposal", "block");
 
   EXPECT_CALL(*notifications, on_vote(peer, message)).Times(1);
 
@@ -73,3 +72,88 @@ TEST(NetworkTest, MessageHandledWhenMessageSent) {
     thread.join();
   }
 }
+
+/**
+ * @given network which does not know its peer
+ * @when vote is sent before and after the peer is added to peer list
+ * @then only the vote sent after update is handled
+ */
+TEST(NetworkTest, PeerIsAcceptedAfterUpdate) {
+  auto notifications = std::make_shared<MockYacNetworkNotifications>();
+
+  auto peer = mk_peer("0.0.0.0:50052");
+  auto network = std::make_shared<NetworkImpl>(
+      peer.address, std::vector<Peer>{mk_peer("0.0.0.0:50053")});
+
+  VoteMessage message;
+  message.hash = mk_hash("proposal", "block");
+
+  EXPECT_CALL(*notifications, on_vote(peer, message)).Times(1);
+
+  network->subscribe(notifications);
+
+  grpc::ServerBuilder builder;
+  int port = 0;
+  builder.AddListeningPort(
+      peer.address, grpc::InsecureServerCredentials(), &port);
+  builder.RegisterService(network.get());
+  auto server = builder.BuildAndStart();
+  ASSERT_TRUE(server);
+  ASSERT_NE(port, 0);
+
+  // sender is unknown, vote is denied
+  network->send_vote(peer, message);
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+
+  network->updatePeers({peer});
+  network->send_vote(peer, message);
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+
+  server->Shutdown();
+}
+
+/**
+ * @given network relaying commits over a tree
+ * @when commit with forged signature is relayed before the genuine commit
+ * of the same hash
+ * @then both are handled, so forged copy does not shadow genuine commit,
+ * and a repeated genuine commit is dropped
+ */
+TEST(NetworkTest, ForgedRelayedCommitDoesNotShadowGenuine) {
+  auto notifications = std::make_shared<MockYacNetworkNotifications>();
+
+  auto peer = mk_peer("0.0.0.0:50054");
+  auto network = std::make_shared<NetworkImpl>(
+      peer.address, std::vector<Peer>{peer}, false, 1);
+
+  VoteMessage genuine;
+  genuine.hash = mk_hash("proposal", "block");
+  genuine.signature.signature.fill(1);
+  auto forged = genuine;
+  forged.signature.signature.fill(2);
+
+  EXPECT_CALL(*notifications, on_commit(peer, CommitMessage({forged})))
+      .Times(1);
+  EXPECT_CALL(*notifications, on_commit(peer, CommitMessage({genuine})))
+      .Times(1);
+
+  network->subscribe(notifications);
+
+  grpc::ServerBuilder builder;
+  int port = 0;
+  builder.AddListeningPort(
+      peer.address, grpc::InsecureServerCredentials(), &port);
+  builder.RegisterService(network.get());
+  auto server = builder.BuildAndStart();
+  ASSERT_TRUE(server);
+  ASSERT_NE(port, 0);
+
+  network->broadcast_commit({peer}, CommitMessage({forged}));
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+  network->broadcast_commit({peer}, CommitMessage({genuine}));
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+  network->broadcast_commit({peer}, CommitMessage({genuine}));
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+
+  server->Shutdown();
+}
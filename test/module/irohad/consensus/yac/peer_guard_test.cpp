@@ -0,0 +1,89 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include "consensus/yac/impl/peer_guard.hpp"
+
+using namespace iroha::consensus::yac;
+using namespace std::chrono_literals;
+
+/**
+ * @given guard with rate of 10 messages per second and burst of 2
+ * @when peer sends messages faster than rate
+ * @then burst is accepted, then messages pass as tokens are refilled
+ */
+TEST(PeerGuardTest, RateLimitsPeer) {
+  PeerGuard guard(10, 2, 100, 1s);
+  auto start = PeerGuard::Clock::now();
+
+  ASSERT_TRUE(guard.admit("a", start));
+  ASSERT_TRUE(guard.admit("a", start));
+  ASSERT_FALSE(guard.admit("a", start));
+  ASSERT_TRUE(guard.admit("b", start));
+  ASSERT_FALSE(guard.admit("a", start + 50ms));
+  ASSERT_TRUE(guard.admit("a", start + 100ms));
+}
+
+/**
+ * @given guard with ban score of 40
+ * @when peer sends two messages with invalid signatures
+ * @then it is ignored until the ban ends, other peers are not affected
+ */
+TEST(PeerGuardTest, BansMisbehavingPeer) {
+  PeerGuard guard(10, 10, 40, 5s);
+  auto start = PeerGuard::Clock::now();
+
+  guard.penalize("a", PeerGuard::Offence::InvalidSignature, start);
+  ASSERT_TRUE(guard.admit("a", start));
+  guard.penalize("a", PeerGuard::Offence::InvalidSignature, start);
+  ASSERT_TRUE(guard.banned("a", start));
+  ASSERT_FALSE(guard.admit("a", start + 4s));
+  ASSERT_TRUE(guard.admit("b", start + 4s));
+  ASSERT_TRUE(guard.admit("a", start + 5s));
+}
+
+/**
+ * @given guard with ban score of 40
+ * @when offences of peer are spread over time
+ * @then score decays and peer is not banned
+ */
+TEST(PeerGuardTest, ScoreDecays) {
+  PeerGuard guard(10, 10, 40, 5s);
+  auto start = PeerGuard::Clock::now();
+
+  guard.penalize("a", PeerGuard::Offence::InvalidSignature, start);
+  guard.penalize("a", PeerGuard::Offence::InvalidSignature, start + 10s);
+  ASSERT_FALSE(guard.banned("a", start + 10s));
+  ASSERT_TRUE(guard.admit("a", start + 10s));
+}
+
+/**
+ * @given guard with burst of one message and ban score of three
+ * @when peer keeps flooding
+ * @then dropped messages count as offences and peer is banned
+ */
+TEST(PeerGuardTest, FloodLeadsToBan) {
+  PeerGuard guard(1, 1, 3, 5s);
+  auto start = PeerGuard::Clock::now();
+
+  ASSERT_TRUE(guard.admit("a", start));
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_FALSE(guard.admit("a", start));
+  }
+  ASSERT_TRUE(guard.banned("a", start));
+  ASSERT_FALSE(guard.admit("a", start + 2s));
+}
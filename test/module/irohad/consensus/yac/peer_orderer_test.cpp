@@ -15,12 +15,14 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <vector>
 #include <memory>
 #include <iostream>
 
 #include "module/irohad/ametsuchi/ametsuchi_mocks.hpp"
 #include "module/irohad/consensus/yac/yac_mocks.hpp"
+#include "consensus/yac/impl/peer_orderer_impl.hpp"
 #include "consensus/yac/impl/yac_peer_orderer_impl.hpp"
 #include "module/irohad/ametsuchi/ametsuchi_mocks.hpp"
 
@@ -84,3 +86,100 @@ TEST_F(YacPeerOrdererTest, PeerOrdererOrderingWhenInvokeFaillCase) {
   auto order = orderer.getOrdering(YacHash());
   ASSERT_EQ(order, nonstd::nullopt);
 }
+
+class PeerOrdererCacheTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    wsv = make_shared<MockWsvQuery>();
+    blocks = make_shared<MockBlockQuery>();
+    orderer = make_shared<PeerOrdererImpl>(wsv, blocks);
+  }
+
+  std::vector<iroha::model::Peer> peers = [] {
+    std::vector<iroha::model::Peer> result;
+    for (size_t i = 1; i <= 4; ++i) {
+      result.push_back(iroha::consensus::yac::mk_peer(std::to_string(i)));
+    }
+    return result;
+  }();
+
+  shared_ptr<MockWsvQuery> wsv;
+  shared_ptr<MockBlockQuery> blocks;
+  shared_ptr<PeerOrdererImpl> orderer;
+};
+
+/**
+ * @given orderer with peers of ledger
+ * @when ordering is requested several times on the same height
+ * and then after a commit
+ * @then peers are read once per height
+ */
+TEST_F(PeerOrdererCacheTest, PeersAreReadOncePerHeight) {
+  EXPECT_CALL(*blocks, getTopBlockHeight())
+      .WillOnce(Return(1))
+      .WillOnce(Return(1))
+      .WillOnce(Return(2));
+  EXPECT_CALL(*wsv, getPeers()).Times(2).WillRepeatedly(Return(peers));
+
+  ASSERT_TRUE(orderer->getInitialOrdering());
+  ASSERT_TRUE(orderer->getOrdering(mk_hash("proposal", "block")));
+  ASSERT_TRUE(orderer->getOrdering(mk_hash("proposal", "block")));
+}
+
+/**
+ * @given orderer which failed to read peers
+ * @when ordering is requested again on the same height
+ * @then peers are read again
+ */
+TEST_F(PeerOrdererCacheTest, FailedReadIsNotCached) {
+  EXPECT_CALL(*blocks, getTopBlockHeight()).WillRepeatedly(Return(1));
+  EXPECT_CALL(*wsv, getPeers())
+      .WillOnce(Return(nonstd::nullopt))
+      .WillOnce(Return(peers));
+
+  ASSERT_EQ(orderer->getInitialOrdering(), nonstd::nullopt);
+  ASSERT_EQ(orderer->getInitialOrdering().value().getPeers(), peers);
+}
+
+/**
+ * @given list of peers
+ * @when it is permuted with different seeds
+ * @then the same seed gives the same order, which contains all peers
+ */
+TEST_F(PeerOrdererCacheTest, PermutationIsDeterministic) {
+  auto first = PeerOrdererImpl::permute(peers, "seed");
+  ASSERT_EQ(first, PeerOrdererImpl::permute(peers, "seed"));
+  ASSERT_TRUE(std::is_permutation(first.begin(), first.end(), peers.begin()));
+
+  // leader has to rotate between rounds
+  std::vector<std::string> leaders;
+  for (auto seed : {"a", "b", "c", "d", "e", "f", "g", "h"}) {
+    leaders.push_back(PeerOrdererImpl::permute(peers, seed).front().address);
+  }
+  ASSERT_NE(std::count(leaders.begin(), leaders.end(), leaders.front()),
+            leaders.size());
+}
+
+/**
+ * @given orderer with health of peers, where one peer is unresponsive
+ * @when ordering for proposal is requested
+ * @then the peer is the last leader, others keep permuted order
+ */
+TEST_F(PeerOrdererCacheTest, UnresponsivePeerIsLastLeader) {
+  for (size_t i = 0; i < peers.size(); ++i) {
+    peers[i].pubkey.fill(i + 1);
+  }
+  auto health = make_shared<iroha::network::PeerHealth>(100, 1);
+  orderer = make_shared<PeerOrdererImpl>(wsv, blocks, health);
+  EXPECT_CALL(*blocks, getTopBlockHeight()).WillRepeatedly(Return(1));
+  EXPECT_CALL(*wsv, getPeers()).WillOnce(Return(peers));
+
+  auto hash = mk_hash("proposal", "block");
+  auto permuted =
+      PeerOrdererImpl::permute(peers, hash.proposal_hash.to_string());
+  health->onTimeout(permuted.front().pubkey);
+
+  auto expected = permuted;
+  std::rotate(expected.begin(), expected.begin() + 1, expected.end());
+  ASSERT_EQ(expected, orderer->getOrdering(hash).value().getPeers());
+}
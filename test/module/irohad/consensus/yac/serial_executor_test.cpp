@@ -0,0 +1,100 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <future>
+#include <vector>
+#include "consensus/yac/impl/serial_executor.hpp"
+
+using namespace iroha::consensus::yac;
+
+/**
+ * @given serial executor
+ * @when tasks are posted concurrently from several threads
+ * @then all tasks are executed in one thread, tasks of each producer
+ * in order of posting
+ */
+TEST(SerialExecutorTest, TasksAreExecutedSerially) {
+  const size_t producers = 4, tasks = 1000;
+  std::vector<std::vector<size_t>> executed(producers);
+  std::vector<std::thread::id> threads;
+  std::promise<void> done;
+  size_t remaining = producers * tasks;
+
+  {
+    SerialExecutor executor;
+    std::vector<std::thread> posting;
+    for (size_t p = 0; p < producers; ++p) {
+      posting.emplace_back([&, p] {
+        for (size_t i = 0; i < tasks; ++i) {
+          executor.post([&, p, i] {
+            executed[p].push_back(i);
+            threads.push_back(std::this_thread::get_id());
+            if (--remaining == 0) {
+              done.set_value();
+            }
+          });
+        }
+      });
+    }
+    for (auto &thread : posting) {
+      thread.join();
+    }
+    ASSERT_EQ(std::future_status::ready,
+              done.get_future().wait_for(std::chrono::seconds(5)));
+  }
+
+  for (const auto &order : executed) {
+    ASSERT_EQ(tasks, order.size());
+    for (size_t i = 0; i < tasks; ++i) {
+      ASSERT_EQ(i, order[i]);
+    }
+  }
+  for (const auto &id : threads) {
+    ASSERT_EQ(threads.front(), id);
+  }
+  ASSERT_NE(std::this_thread::get_id(), threads.front());
+}
+
+/**
+ * @given serial executor with queue of one task
+ * @when task posts more tasks than the queue holds
+ * @then posting does not wait for the executor itself, and nested tasks
+ * run in order of posting
+ */
+TEST(SerialExecutorTest, NestedTasksDoNotBlock) {
+  const size_t nested = 10;
+  std::vector<size_t> executed;
+  std::promise<void> done;
+
+  SerialExecutor executor(1);
+  executor.post([&] {
+    for (size_t i = 0; i < nested; ++i) {
+      executor.post([&, i] {
+        executed.push_back(i);
+        if (executed.size() == nested) {
+          done.set_value();
+        }
+      });
+    }
+  });
+  ASSERT_EQ(std::future_status::ready,
+            done.get_future().wait_for(std::chrono::seconds(5)));
+  for (size_t i = 0; i < nested; ++i) {
+    ASSERT_EQ(i, executed[i]);
+  }
+}
@@ -0,0 +1,96 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <future>
+#include "consensus/yac/impl/yac_crypto_provider_impl.hpp"
+#include "crypto/crypto.hpp"
+#include "module/irohad/consensus/yac/yac_mocks.hpp"
+
+using namespace iroha::consensus::yac;
+
+class YacCryptoProviderTest : public ::testing::Test {
+ public:
+  CommitMessage makeCommit(const YacHash &hash, size_t peers) {
+    CommitMessage commit;
+    for (size_t i = 0; i < peers; ++i) {
+      YacCryptoProviderImpl peer(
+          iroha::create_keypair(iroha::create_seed()));
+      commit.votes.push_back(peer.getVote(hash));
+    }
+    return commit;
+  }
+
+  YacHash hash = mk_hash("proposal", "block");
+};
+
+/**
+ * @given vote made by crypto provider
+ * @when vote is verified
+ * @then it is valid until its hash is changed
+ */
+TEST_F(YacCryptoProviderTest, VerifyVote) {
+  YacCryptoProviderImpl crypto(iroha::create_keypair(iroha::create_seed()));
+  auto vote = crypto.getVote(hash);
+  ASSERT_TRUE(crypto.verify(vote));
+
+  vote.hash.block_hash = mk_hash("proposal", "other").block_hash;
+  ASSERT_FALSE(crypto.verify(vote));
+}
+
+/**
+ * @given commit with votes of many peers
+ * @when commit is verified
+ * @then it is valid, and invalid if any vote signature is corrupted
+ */
+TEST_F(YacCryptoProviderTest, VerifyCommit) {
+  YacCryptoProviderImpl crypto(iroha::create_keypair(iroha::create_seed()));
+  auto commit = makeCommit(hash, 31);
+  ASSERT_TRUE(crypto.verify(commit));
+
+  commit.votes.at(17).signature.signature[0] ^= 1;
+  ASSERT_FALSE(crypto.verify(commit));
+}
+
+/**
+ * @given reject without votes
+ * @when reject is verified
+ * @then it is invalid
+ */
+TEST_F(YacCryptoProviderTest, VerifyEmptyReject) {
+  YacCryptoProviderImpl crypto(iroha::create_keypair(iroha::create_seed()));
+  ASSERT_FALSE(crypto.verify(RejectMessage{}));
+}
+
+/**
+ * @given crypto provider which signs through batching signer
+ * @when vote is requested asynchronously
+ * @then vote arrives with valid signature of the signer key
+ */
+TEST_F(YacCryptoProviderTest, AsyncVoteIsSigned) {
+  auto keypair = iroha::create_keypair(iroha::create_seed());
+  YacCryptoProviderImpl crypto(std::make_shared<iroha::BatchingSigner>(
+      std::make_shared<iroha::KeypairSigner>(keypair)));
+  std::promise<VoteMessage> promise;
+  crypto.getVoteAsync(
+      hash, [&promise](VoteMessage vote) { promise.set_value(vote); });
+  auto vote = promise.get_future().get();
+
+  ASSERT_EQ(hash, vote.hash);
+  ASSERT_EQ(keypair.pubkey, vote.signature.pubkey);
+  ASSERT_TRUE(crypto.verify(vote));
+}
@@ -16,6 +16,7 @@
  */
 
 #include "module/irohad/consensus/yac/yac_mocks.hpp"
+#include "module/irohad/network/network_mocks.hpp"
 #include "module/irohad/simulator/simulator_mocks.hpp"
 
 #include <memory>
@@ -25,6 +26,7 @@
 
 using namespace iroha::consensus::yac;
 using namespace iroha::simulator;
+using namespace iroha::network;
 using namespace framework::test_subscriber;
 
 #include <iostream>
@@ -40,7 +42,7 @@ TEST(YacGateTest, YacGateSubscriptionTest) {
       "HashGate (commit) => YacGate => on_commit() |----------" << endl;
 
   // expected values
-  YacHash expected_hash("proposal", "block");
+  auto expected_hash = mk_hash("proposal", "block");
   iroha::model::Block expected_block;
   expected_block.created_ts = 100500;
   expected_block.sigs.push_back({});
@@ -80,15 +82,17 @@ TEST(YacGateTest, YacGateSubscriptionTest) {
   // make blocks
   auto block_creator = make_shared<MockBlockCreator>();
   EXPECT_CALL(*block_creator, on_block())
-      .WillOnce(Return(rxcpp::observable<>::just(expected_block)));
+      .WillOnce(Return(rxcpp::observable<>::just(
+          std::make_shared<const iroha::model::Block>(expected_block))));
 
   YacGateImpl gate(std::move(hash_gate), std::move(peer_orderer),
-                   hash_provider, block_creator);
+                   hash_provider, block_creator,
+                   make_shared<MockBlockLoader>());
 
   // verify that yac gate emit expected block
   auto gate_wrapper = make_test_subscriber<CallExact>(gate.on_commit(), 1);
   gate_wrapper.subscribe([expected_block](auto block) {
-    ASSERT_EQ(block, expected_block);
+    ASSERT_EQ(*block, expected_block);
   });
 
   ASSERT_TRUE(gate_wrapper.validate());
@@ -99,7 +103,7 @@ TEST(YacGateTest, YacGateSubscribtionTestFailCase) {
        << endl;
 
   // expected values
-  YacHash expected_hash("proposal", "block");
+  auto expected_hash = mk_hash("proposal", "block");
   iroha::model::Block expected_block;
   expected_block.created_ts = 100500;
   VoteMessage message;
@@ -138,8 +142,145 @@ TEST(YacGateTest, YacGateSubscribtionTestFailCase) {
   // make blocks
   auto block_creator = make_shared<MockBlockCreator>();
   EXPECT_CALL(*block_creator, on_block())
-      .WillOnce(Return(rxcpp::observable<>::just(expected_block)));
+      .WillOnce(Return(rxcpp::observable<>::just(
+          std::make_shared<const iroha::model::Block>(expected_block))));
 
   YacGateImpl gate(std::move(hash_gate), std::move(peer_orderer),
-                   hash_provider, block_creator);
+                   hash_provider, block_creator,
+                   make_shared<MockBlockLoader>());
+}
+
+TEST(YacGateTest, LoadBlockOfOtherPeer) {
+  cout << "----------| Commit of block which was not voted for "
+      "=> block is downloaded from signer |----------" << endl;
+
+  // expected values
+  auto voted_hash = mk_hash("proposal", "block");
+  iroha::model::Block voted_block;
+  voted_block.height = 3;
+
+  auto committed_hash = mk_hash("other_proposal", std::string(32, 'a'));
+  iroha::model::Block committed_block;
+  committed_block.height = 3;
+  committed_block.created_ts = 100500;
+  VoteMessage message;
+  message.hash = committed_hash;
+  message.signature.pubkey.fill(1);
+  CommitMessage commit_message({message});
+
+  // yac consensus
+  unique_ptr<HashGate> hash_gate = make_unique<MockHashGate>();
+  auto hash_gate_raw = hash_gate.get();
+
+  EXPECT_CALL(*static_cast<MockHashGate *>(hash_gate_raw),
+              vote(voted_hash, _)).Times(1);
+
+  EXPECT_CALL(*static_cast<MockHashGate *>(hash_gate_raw), on_commit())
+      .WillOnce(Return(rxcpp::observable<>::just(commit_message)));
+
+  // generate order of peers
+  unique_ptr<YacPeerOrderer> peer_orderer =
+      make_unique<MockYacPeerOrderer>();
+
+  EXPECT_CALL(*static_cast<MockYacPeerOrderer *>(peer_orderer.get()),
+              getOrdering(_))
+      .WillOnce(Return(ClusterOrdering({mk_peer("fake_node")})));
+
+  // make hash from block
+  shared_ptr<YacHashProvider> hash_provider =
+      make_shared<MockYacHashProvider>();
+
+  EXPECT_CALL(
+      *static_cast<MockYacHashProvider *>(hash_provider.get()), makeHash(_))
+      .WillOnce(Return(voted_hash));
+
+  // make blocks
+  auto block_creator = make_shared<MockBlockCreator>();
+  EXPECT_CALL(*block_creator, on_block())
+      .WillOnce(Return(rxcpp::observable<>::just(
+          std::make_shared<const iroha::model::Block>(voted_block))));
+
+  // download committed block
+  auto block_loader = make_shared<MockBlockLoader>();
+  EXPECT_CALL(*block_loader, retrieveBlock(_, voted_block.height, _))
+      .WillOnce(Return(committed_block));
+
+  YacGateImpl gate(std::move(hash_gate), std::move(peer_orderer),
+                   hash_provider, block_creator, block_loader);
+
+  // verify that yac gate emit downloaded block signed by commit
+  auto gate_wrapper = make_test_subscriber<CallExact>(gate.on_commit(), 1);
+  gate_wrapper.subscribe([committed_block, message](auto block) {
+    ASSERT_EQ(block->created_ts, committed_block.created_ts);
+    ASSERT_EQ(1, block->sigs.size());
+    ASSERT_EQ(block->sigs.front(), message.signature);
+  });
+
+  ASSERT_TRUE(gate_wrapper.validate());
+}
+
+/**
+ * @given gate voting for proposals
+ * @when proposal is received, its hash is committed and then block of the
+ * proposal is built
+ * @then gate votes before block exists and emits the built block signed by
+ * commit
+ */
+TEST(YacGateTest, VoteForProposalBeforeBlockIsBuilt) {
+  iroha::model::Proposal proposal({});
+  proposal.height = 2;
+  auto proposal_hash = mk_hash("proposal", "proposal");
+
+  iroha::model::Block built_block;
+  built_block.height = 2;
+  built_block.created_ts = 100500;
+  VoteMessage message;
+  message.hash = proposal_hash;
+  message.signature.pubkey.fill(1);
+  CommitMessage commit_message({message});
+
+  rxcpp::subjects::subject<std::shared_ptr<const iroha::model::Proposal>>
+      proposals;
+  rxcpp::subjects::subject<std::shared_ptr<const iroha::model::Block>> blocks;
+  rxcpp::subjects::subject<CommitMessage> commits;
+
+  auto hash_gate = make_shared<MockHashGate>();
+  EXPECT_CALL(*hash_gate, vote(proposal_hash, _)).Times(1);
+  EXPECT_CALL(*hash_gate, on_commit())
+      .WillOnce(Return(commits.get_observable()));
+
+  auto peer_orderer = make_shared<MockYacPeerOrderer>();
+  EXPECT_CALL(*peer_orderer, getOrdering(proposal_hash))
+      .WillOnce(Return(ClusterOrdering({mk_peer("fake_node")})));
+
+  auto hash_provider = make_shared<MockYacHashProvider>();
+  EXPECT_CALL(*hash_provider, makeHash(_)).Times(0);
+  EXPECT_CALL(*hash_provider, makeProposalHash(_))
+      .WillOnce(Return(proposal_hash));
+
+  auto block_creator = make_shared<MockBlockCreator>();
+  EXPECT_CALL(*block_creator, on_block())
+      .WillOnce(Return(blocks.get_observable()));
+
+  auto ordering_gate = make_shared<MockOrderingGate>();
+  EXPECT_CALL(*ordering_gate, on_proposal())
+      .WillOnce(Return(proposals.get_observable()));
+
+  YacGateImpl gate(hash_gate, peer_orderer, hash_provider, block_creator,
+                   make_shared<MockBlockLoader>(), ordering_gate);
+
+  auto gate_wrapper = make_test_subscriber<CallExact>(gate.on_commit(), 1);
+  gate_wrapper.subscribe([built_block, message](auto block) {
+    ASSERT_EQ(block->created_ts, built_block.created_ts);
+    ASSERT_EQ(1, block->sigs.size());
+    ASSERT_EQ(block->sigs.front(), message.signature);
+  });
+
+  proposals.get_subscriber().on_next(
+      std::make_shared<const iroha::model::Proposal>(proposal));
+  commits.get_subscriber().on_next(commit_message);
+  blocks.get_subscriber().on_next(
+      std::make_shared<const iroha::model::Block>(built_block));
+
+  ASSERT_TRUE(gate_wrapper.validate());
 }
@@ -30,6 +30,23 @@ TEST(YacHashProviderTest, MakeYacHashTest) {
 
   auto yac_hash = hash_provider.makeHash(block);
 
-  ASSERT_EQ(test_hash, yac_hash.proposal_hash);
-  ASSERT_EQ(test_hash, yac_hash.block_hash);
+  ASSERT_EQ(test_hash, yac_hash.proposal_hash.to_string());
+  ASSERT_EQ(test_hash, yac_hash.block_hash.to_string());
+}
+
+/**
+ * @given byte strings shorter and longer than hash
+ * @when yac hash is made from them
+ * @then it is rejected, while strings of hash size make the hash
+ */
+TEST(YacHashProviderTest, MakeYacHashFromBytes) {
+  std::string proposal(32, 'p'), block(32, 'b');
+
+  ASSERT_FALSE(YacHash::fromBytes("proposal", block));
+  ASSERT_FALSE(YacHash::fromBytes(proposal, std::string(40, 'b')));
+
+  auto hash = YacHash::fromBytes(proposal, block);
+  ASSERT_TRUE(hash);
+  ASSERT_EQ(proposal, hash->proposal_hash.to_string());
+  ASSERT_EQ(block, hash->block_hash.to_string());
 }
@@ -26,6 +26,7 @@
 #include "consensus/yac/yac_gate.hpp"
 #include "consensus/yac/yac_hash_provider.hpp"
 #include "consensus/yac/yac_peer_orderer.hpp"
+#include "crypto/hash.hpp"
 
 namespace iroha {
   namespace consensus {
@@ -36,8 +37,20 @@ namespace iroha {
         return peer;
       }
 
+      /**
+       * Make vote hash whose parts are digests of given names, so that
+       * different names give different hashes of valid size
+       */
+      YacHash mk_hash(const std::string &proposal, const std::string &block) {
+        auto digest = [](const std::string &name) {
+          return sha3_256(reinterpret_cast<const uint8_t *>(name.data()),
+                          name.size());
+        };
+        return YacHash(digest(proposal), digest(block));
+      }
+
       VoteMessage create_vote(YacHash hash, std::string sign) {
-        VoteMessage vote;
+        VoteMessage vote{};
         vote.hash = hash;
         std::copy(sign.begin(), sign.end(), vote.signature.pubkey.begin());
         return vote;
@@ -149,7 +162,8 @@ namespace iroha {
 
       class MockYacHashProvider : public YacHashProvider {
        public:
-        MOCK_METHOD1(makeHash, YacHash(model::Block &));
+        MOCK_METHOD1(makeHash, YacHash(const model::Block &));
+        MOCK_METHOD1(makeProposalHash, YacHash(const model::Proposal &));
 
         MockYacHashProvider() = default;
 
@@ -71,7 +71,7 @@ TEST_F(YacTest, YacWhenVoting) {
   EXPECT_CALL(*network, send_reject(_, _)).Times(0);
   EXPECT_CALL(*network, send_vote(_, _)).Times(default_peers.size());
 
-  YacHash my_hash("my_proposal_hash", "my_block_hash");
+  auto my_hash = mk_hash("my_proposal_hash", "my_block_hash");
   yac->vote(my_hash, ClusterOrdering(default_peers));
 }
 
@@ -95,7 +95,7 @@ TEST_F(YacTest, YacWhenColdStartAndAchieveOneVote) {
       .Times(1)
       .WillRepeatedly(Return(true));
 
-  YacHash received_hash("my_proposal", "my_block");
+  auto received_hash = mk_hash("my_proposal", "my_block");
   auto peer = default_peers.at(0);
   // assume that our peer receive message
   network->notification->on_vote(peer, crypto->getVote(received_hash));
@@ -126,7 +126,7 @@ TEST_F(YacTest, YacWhenColdStartAndAchieveSupermajorityOfVotes) {
       .Times(default_peers.size())
       .WillRepeatedly(Return(true));
 
-  YacHash received_hash("my_proposal", "my_block");
+  auto received_hash = mk_hash("my_proposal", "my_block");
   for (auto &peer : default_peers) {
     network->notification->on_vote(peer, crypto->getVote(received_hash));
   }
@@ -140,7 +140,7 @@ TEST_F(YacTest, YacWhenColdStartAndAchieveSupermajorityOfVotes) {
  */
 TEST_F(YacTest, YacWhenColdStartAndAchieveCommitMessage) {
   cout << "----------|Start => receive commit|----------" << endl;
-  YacHash propagated_hash("my_proposal", "my_block");
+  auto propagated_hash = mk_hash("my_proposal", "my_block");
 
   // verify that commit emitted
   auto wrapper = make_test_subscriber<CallExact>(yac->on_commit(), 1);
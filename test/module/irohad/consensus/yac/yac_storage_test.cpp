@@ -50,7 +50,7 @@ TEST(YacStorageTest, SupermajorityFunctionForAllCases4) {
 TEST(YacStorageTest, YacBlockStorageWhenNormalDataInput) {
   cout << "-----------| Sequentially insertion of votes |-----------" << endl;
 
-  YacHash hash("proposal", "commit");
+  auto hash = mk_hash("proposal", "commit");
   int N = 4;
   YacBlockStorage storage(hash, N);
 
@@ -79,7 +79,7 @@ TEST(YacStorageTest, YacBlockStorageWhenNormalDataInput) {
 TEST(YacStorageTest, YacBlockStorageWhenNotCommittedAndCommitAcheive) {
   cout << "-----------| Insert vote => insert commit |-----------" << endl;
 
-  YacHash hash("proposal", "commit");
+  auto hash = mk_hash("proposal", "commit");
   int N = 4;
   YacBlockStorage storage(hash, N);
 
@@ -96,3 +96,68 @@ TEST(YacStorageTest, YacBlockStorageWhenNotCommittedAndCommitAcheive) {
   ASSERT_EQ(4, insert_commit.answer.commit->votes.size());
   ASSERT_EQ(nonstd::nullopt, insert_1.answer.reject);
 }
+
+/**
+ * @given block storage with vote of peer
+ * @when the same peer votes again
+ * @then second vote is not counted
+ */
+TEST(YacStorageTest, YacBlockStorageIgnoresRepeatedVoter) {
+  auto hash = mk_hash("proposal", "commit");
+  int N = 4;
+  YacBlockStorage storage(hash, N);
+
+  storage.insert(create_vote(hash, "one"));
+  storage.insert(create_vote(hash, "two"));
+  auto repeated = storage.insert(create_vote(hash, "two"));
+  ASSERT_EQ(CommitState::not_committed, repeated.state);
+  ASSERT_EQ(2, storage.getVotes().size());
+}
+
+/**
+ * @given vote storage with window of one round and committed first round
+ * @when votes for the next proposals arrive
+ * @then committed round out of the window is evicted
+ */
+TEST(YacStorageTest, YacVoteStorageEvictsClosedRound) {
+  YacVoteStorage storage(1);
+  int N = 4;
+  auto first = mk_hash("first", "commit");
+  auto second = mk_hash("second", "commit");
+
+  for (auto name : {"one", "two", "three"}) {
+    storage.storeVote(create_vote(first, name), N);
+  }
+  ASSERT_EQ(1, storage.liveRounds());
+
+  storage.storeVote(create_vote(second, "one"), N);
+  ASSERT_EQ(nonstd::nullopt, storage.findProposal(first));
+  ASSERT_NE(nonstd::nullopt, storage.findProposal(second));
+  ASSERT_EQ(1, storage.liveRounds());
+}
+
+/**
+ * @given vote storage with window of one round
+ * @when rounds stay open
+ * @then they are kept until they are older than twice the window
+ */
+TEST(YacStorageTest, YacVoteStorageEvictsStaleOpenRound) {
+  YacVoteStorage storage(1);
+  int N = 4;
+  auto first = mk_hash("first", "commit");
+  auto second = mk_hash("second", "commit");
+  auto third = mk_hash("third", "commit");
+
+  storage.storeVote(create_vote(first, "one"), N);
+  storage.storeVote(create_vote(second, "one"), N);
+  ASSERT_NE(nonstd::nullopt, storage.findProposal(first));
+  ASSERT_EQ(2, storage.liveRounds());
+  auto usage = storage.memoryUsage();
+  ASSERT_GT(usage, 0);
+
+  storage.storeVote(create_vote(third, "one"), N);
+  ASSERT_EQ(nonstd::nullopt, storage.findProposal(first));
+  ASSERT_NE(nonstd::nullopt, storage.findProposal(second));
+  ASSERT_NE(nonstd::nullopt, storage.findProposal(third));
+  ASSERT_EQ(2, storage.liveRounds());
+}
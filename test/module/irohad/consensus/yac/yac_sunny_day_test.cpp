@@ -63,7 +63,7 @@ TEST_F(YacTest, ValidCaseWhenReceiveSupermajority) {
   EXPECT_CALL(*crypto, verify(An<RejectMessage>())).Times(0);
   EXPECT_CALL(*crypto, verify(An<VoteMessage>())).WillRepeatedly(Return(true));
 
-  YacHash my_hash("proposal_hash", "block_hash");
+  auto my_hash = mk_hash("proposal_hash", "block_hash");
   yac->vote(my_hash, my_order);
 
   for (auto i = 0; i < 3; ++i) {
@@ -91,7 +91,7 @@ TEST_F(YacTest, ValidCaseWhenReceiveCommit) {
                     my_order,
                     delay);
 
-  YacHash my_hash("proposal_hash", "block_hash");
+  auto my_hash = mk_hash("proposal_hash", "block_hash");
   auto wrapper = make_test_subscriber<CallExact>(yac->on_commit(), 1);
   wrapper.subscribe([my_hash](auto val) {
     ASSERT_EQ(my_hash, val.votes.at(0).hash);
@@ -139,7 +139,7 @@ TEST_F(YacTest, ValidCaseWhenReceiveCommitTwice) {
                     my_order,
                     delay);
 
-  YacHash my_hash("proposal_hash", "block_hash");
+  auto my_hash = mk_hash("proposal_hash", "block_hash");
   auto wrapper = make_test_subscriber<CallExact>(yac->on_commit(), 1);
   wrapper.subscribe([my_hash](auto val) {
     ASSERT_EQ(my_hash, val.votes.at(0).hash);
@@ -203,7 +203,7 @@ TEST_F(YacTest, ValidCaseWhenSoloConsensus) {
       .Times(1)
       .WillRepeatedly(Return(true));
 
-  YacHash my_hash("proposal_hash", "block_hash");
+  auto my_hash = mk_hash("proposal_hash", "block_hash");
 
   auto wrapper = make_test_subscriber<CallExact>(yac->on_commit(), 1);
   wrapper.subscribe([my_hash](auto val) {
@@ -251,7 +251,7 @@ TEST_F(YacTest, ValidCaseWhenVoteAfterCommit) {
   EXPECT_CALL(*crypto, verify(An<RejectMessage>())).Times(0);
   EXPECT_CALL(*crypto, verify(An<VoteMessage>())).Times(0);
 
-  YacHash my_hash("proposal_hash", "block_hash");
+  auto my_hash = mk_hash("proposal_hash", "block_hash");
 
   std::vector<VoteMessage> votes;
 
@@ -262,3 +262,34 @@ TEST_F(YacTest, ValidCaseWhenVoteAfterCommit) {
 
   yac->vote(my_hash, my_order);
 }
+
+TEST_F(YacTest, ValidCaseWhenReceiveVoteOfDecidedRound) {
+  cout << "-----------| Start => receive commit => receive vote "
+      "=> answer with commit without verification |-----------"
+       << endl;
+
+  auto my_peers = std::vector<iroha::model::Peer>(
+      {default_peers.begin(), default_peers.begin() + 4});
+  ClusterOrdering my_order(my_peers);
+
+  yac = Yac::create(std::move(YacVoteStorage()), network, crypto, timer,
+                    my_order, delay);
+
+  EXPECT_CALL(*network, send_commit(my_peers.at(3), _)).Times(1);
+  EXPECT_CALL(*network, send_reject(_, _)).Times(0);
+
+  EXPECT_CALL(*crypto, verify(An<CommitMessage>()))
+      .Times(1)
+      .WillRepeatedly(Return(true));
+  EXPECT_CALL(*crypto, verify(An<VoteMessage>())).Times(0);
+
+  auto my_hash = mk_hash("proposal_hash", "block_hash");
+
+  std::vector<VoteMessage> votes;
+  for (auto i = 0; i < 3; ++i) {
+    votes.push_back(create_vote(my_hash, std::to_string(i)));
+  };
+  yac->on_commit(my_peers.at(0), CommitMessage(votes));
+
+  yac->on_vote(my_peers.at(3), create_vote(my_hash, std::to_string(3)));
+}
@@ -0,0 +1,72 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <future>
+#include "main/impl/stage.hpp"
+
+using iroha::Stage;
+
+/**
+ * @given stage
+ * @when tasks are posted from the test thread
+ * @then they run in order of posting on one thread of the stage
+ */
+TEST(StageTest, TasksRunInOrderOnStageThread) {
+  Stage stage("test");
+  std::vector<int> order;
+  std::vector<std::thread::id> threads;
+  std::promise<void> done;
+  for (int i = 0; i < 10; ++i) {
+    stage.post([&order, &threads, i] {
+      order.push_back(i);
+      threads.push_back(std::this_thread::get_id());
+    });
+  }
+  stage.post([&done] { done.set_value(); });
+
+  ASSERT_EQ(std::future_status::ready,
+            done.get_future().wait_for(std::chrono::seconds(5)));
+  ASSERT_EQ((std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}), order);
+  ASSERT_NE(std::this_thread::get_id(), threads.front());
+  ASSERT_EQ(threads.size(),
+            std::count(threads.begin(), threads.end(), threads.front()));
+}
+
+/**
+ * @given stage with a timer created on its loop
+ * @when stage is started
+ * @then the timer fires on the thread of the loop, and stop returns
+ */
+TEST(StageTest, LoopRunsOnStart) {
+  Stage stage("test");
+  std::promise<std::thread::id> fired;
+  auto timer = stage.loop()->resource<uvw::TimerHandle>();
+  timer->on<uvw::TimerEvent>([&fired](const auto &, auto &handle) {
+    fired.set_value(std::this_thread::get_id());
+    handle.close();
+  });
+  timer->start(std::chrono::milliseconds(1), std::chrono::milliseconds(0));
+
+  stage.start();
+  auto future = fired.get_future();
+  ASSERT_EQ(std::future_status::ready,
+            future.wait_for(std::chrono::seconds(5)));
+  ASSERT_NE(std::this_thread::get_id(), future.get());
+  stage.stop();
+}
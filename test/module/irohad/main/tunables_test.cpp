@@ -0,0 +1,84 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include "main/impl/tunables.hpp"
+
+using iroha::Tunables;
+
+class TunablesTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    tunables.add("size", 10, 1, 100, [this](uint64_t value) {
+      applied.push_back(value);
+    });
+  }
+
+  void TearDown() override {
+    std::remove(path.c_str());
+  }
+
+  void write(const std::string &content) {
+    std::ofstream(path) << content;
+  }
+
+  std::string path = "tunables_test.json";
+  Tunables tunables{path};
+  std::vector<uint64_t> applied;
+};
+
+/**
+ * @given registered parameter
+ * @when config with the same, changed, out of range and mistyped values
+ * is loaded
+ * @then only the changed value in range is applied and reported
+ */
+TEST_F(TunablesTest, OnlyValidChangesAreApplied) {
+  rapidjson::Document config;
+  config.Parse(R"({"size": 10})");
+  ASSERT_EQ(0, tunables.load(config));
+
+  config.Parse(R"({"size": 20, "other": 1})");
+  ASSERT_EQ(1, tunables.load(config));
+
+  config.Parse(R"({"size": 1000})");
+  ASSERT_EQ(0, tunables.load(config));
+
+  config.Parse(R"({"size": "30"})");
+  ASSERT_EQ(0, tunables.load(config));
+
+  ASSERT_EQ(std::vector<uint64_t>({20}), applied);
+  ASSERT_EQ("size 20\n", tunables.report());
+}
+
+/**
+ * @given config file
+ * @when it is changed and reloaded, and then it is broken and reloaded
+ * @then the new value is applied, and broken file changes nothing
+ */
+TEST_F(TunablesTest, ReloadReadsFileAgain) {
+  write(R"({"size": 50})");
+  ASSERT_EQ(1, tunables.reload());
+
+  write(R"({"size": )");
+  ASSERT_EQ(0, tunables.reload());
+
+  ASSERT_EQ(std::vector<uint64_t>({50}), applied);
+  ASSERT_EQ("size 50\n", tunables.report());
+}
@@ -0,0 +1,70 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "model/command_pool.hpp"
+#include <gtest/gtest.h>
+#include <array>
+#include <thread>
+#include "model/commands/add_peer.hpp"
+
+using namespace iroha::model;
+
+/**
+ * @given pooled command which is released
+ * @when command of the same type is created
+ * @then it reuses memory of the released one
+ */
+TEST(CommandPoolTest, ReleasedMemoryIsReused) {
+  auto first = makePooled<AddPeer>();
+  auto address = first.get();
+  first.reset();
+
+  auto second = makePooled<AddPeer>();
+  ASSERT_EQ(address, second.get());
+}
+
+/**
+ * @given object too big for the pool
+ * @when it is allocated and released
+ * @then allocation succeeds from the heap
+ */
+TEST(CommandPoolTest, BigObjectsAreNotPooled) {
+  using Big = std::array<char, 4096>;
+  PoolAllocator<Big> allocator;
+  auto big = allocator.allocate(1);
+  ASSERT_NE(nullptr, big);
+  allocator.deallocate(big, 1);
+}
+
+/**
+ * @given commands created on one thread
+ * @when they are released on another thread
+ * @then both threads keep allocating
+ */
+TEST(CommandPoolTest, ReleasedOnOtherThread) {
+  std::vector<std::shared_ptr<Command>> commands;
+  for (int i = 0; i < 100; ++i) {
+    auto command = makePooled<AddPeer>();
+    command->address = std::to_string(i);
+    commands.push_back(command);
+  }
+  std::thread([&commands] {
+    commands.clear();
+    ASSERT_TRUE(makePooled<AddPeer>());
+  }).join();
+  ASSERT_TRUE(makePooled<AddPeer>());
+}
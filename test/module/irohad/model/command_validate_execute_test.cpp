@@ -27,6 +27,8 @@
 #include "model/commands/set_quorum.hpp"
 #include "model/commands/transfer_asset.hpp"
 
+#include <limits>
+
 using ::testing::Return;
 using ::testing::AtLeast;
 using ::testing::_;
@@ -160,6 +162,20 @@ TEST_F(AddAssetQuantityTest, InvalidWhenWrongPrecision) {
   ASSERT_FALSE(validateAndExecute());
 }
 
+TEST_F(AddAssetQuantityTest, InvalidWhenBalanceOverflows) {
+  // Balance would not fit after addition
+  creator.permissions.issue_assets = true;
+  wallet.balance = std::numeric_limits<uint64_t>::max() - 100;
+  EXPECT_CALL(*wsv_query, getAccountAsset(add_asset_quantity->account_id,
+                                          add_asset_quantity->asset_id))
+      .WillOnce(Return(wallet));
+
+  EXPECT_CALL(*wsv_query, getAsset(asset_id)).WillOnce(Return(asset));
+  EXPECT_CALL(*wsv_query, getAccount(account_id)).WillOnce(Return(account));
+
+  ASSERT_FALSE(validateAndExecute());
+}
+
 TEST_F(AddAssetQuantityTest, InvalidWhenNoAccount) {
   // Account to add doesn't exist
   creator.permissions.issue_assets = true;
@@ -16,7 +16,10 @@
  */
 
 #include <gtest/gtest.h>
+#include "model/commands/add_peer.hpp"
+#include "model/commands/create_domain.hpp"
 #include "model/converters/json_block_factory.hpp"
+#include "model/converters/json_common.hpp"
 
 using namespace iroha;
 using namespace iroha::model;
@@ -47,3 +50,105 @@ TEST_F(JsonBlockTest, InvalidWhenFieldsMissing) {
 
   ASSERT_FALSE(serial_block.has_value());
 }
+
+/**
+ * @return block with signatures and transactions with commands
+ */
+Block makeBlock() {
+  Block block;
+  block.height = 5;
+  block.created_ts = 100;
+  block.txs_number = 1;
+  block.hash.fill(1);
+  block.prev_hash.fill(2);
+  block.merkle_root.fill(3);
+  Signature signature;
+  signature.pubkey.fill(4);
+  signature.signature.fill(5);
+  block.sigs.push_back(signature);
+
+  Transaction transaction;
+  transaction.creator_account_id = "admin@test";
+  transaction.tx_counter = 7;
+  transaction.created_ts = 99;
+  transaction.signatures.push_back(signature);
+  auto add_peer = std::make_shared<AddPeer>();
+  add_peer->address = "localhost:10001";
+  add_peer->peer_key.fill(6);
+  auto create_domain = std::make_shared<CreateDomain>();
+  create_domain->domain_name = "test";
+  transaction.commands = {add_peer, create_domain};
+  block.transactions.push_back(transaction);
+  return block;
+}
+
+/**
+ * @given block with transactions and commands serialized to json
+ * @when it is deserialized from bytes
+ * @then the same block is read
+ */
+TEST_F(JsonBlockTest, StreamedWhenWellFormed) {
+  auto orig_block = makeBlock();
+  auto bytes = jsonToVector(factory.serialize(orig_block));
+
+  auto block = factory.deserialize(bytes.data(), bytes.size());
+
+  ASSERT_TRUE(block);
+  ASSERT_EQ(orig_block, *block);
+  ASSERT_EQ(2, block->transactions.at(0).commands.size());
+}
+
+/**
+ * @given serialized block with member unknown to factory
+ * @when it is deserialized from bytes
+ * @then the member is skipped
+ */
+TEST_F(JsonBlockTest, StreamedSkipsUnknownMembers) {
+  auto orig_block = makeBlock();
+  auto document = factory.serialize(orig_block);
+  rapidjson::Value extra(rapidjson::kObjectType);
+  extra.AddMember("nested", rapidjson::Value(rapidjson::kArrayType),
+                  document.GetAllocator());
+  document.AddMember("extra", extra, document.GetAllocator());
+  auto bytes = jsonToVector(document);
+
+  auto block = factory.deserialize(bytes.data(), bytes.size());
+
+  ASSERT_TRUE(block);
+  ASSERT_EQ(orig_block, *block);
+}
+
+/**
+ * @given serialized block without required member, and truncated block
+ * @when they are deserialized from bytes
+ * @then both are rejected
+ */
+TEST_F(JsonBlockTest, StreamedInvalidWhenMalformed) {
+  auto document = factory.serialize(makeBlock());
+  document.RemoveMember("height");
+  auto bytes = jsonToVector(document);
+  ASSERT_FALSE(factory.deserialize(bytes.data(), bytes.size()));
+
+  bytes = jsonToVector(factory.serialize(makeBlock()));
+  ASSERT_FALSE(factory.deserialize(bytes.data(), bytes.size() / 2));
+}
+
+/**
+ * @given serialized block
+ * @when it is written compact, pretty and into reused buffer
+ * @then compact output has no whitespace, is shorter than pretty one, and
+ * reused buffer holds only the last document
+ */
+TEST_F(JsonBlockTest, CompactUnlessPretty) {
+  auto document = factory.serialize(makeBlock());
+
+  auto compact = jsonToString(document);
+  auto pretty = jsonToString(document, true);
+  ASSERT_EQ(std::string::npos, compact.find('\n'));
+  ASSERT_LT(compact.size(), pretty.size());
+
+  std::vector<uint8_t> buffer;
+  jsonToVector(factory.serialize(Block{}), buffer);
+  jsonToVector(document, buffer);
+  ASSERT_EQ(compact, std::string(buffer.begin(), buffer.end()));
+}
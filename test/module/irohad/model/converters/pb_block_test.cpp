@@ -67,12 +67,13 @@ TEST(BlockTest, bl_test) {
   std::fill(orig_block.prev_hash.begin(), orig_block.prev_hash.end(), 0x3);
   orig_block.sigs = {siga};
 
-  std::fill(orig_block.merkle_root.begin(), orig_block.merkle_root.end(), 0x14);
   orig_block.height = 3;
   orig_block.txs_number = 1;
   orig_block.transactions = {orig_tx};
 
   iroha::model::HashProviderImpl hash_provider;
+  orig_block.merkle_root =
+      hash_provider.get_merkle_root(orig_block.transactions);
   orig_block.hash = hash_provider.get_hash(orig_block);
 
   auto factory = iroha::model::converters::PbBlockFactory();
@@ -87,3 +88,40 @@ TEST(BlockTest, bl_test) {
   ASSERT_EQ(orig_block.txs_number, serial_block.txs_number);
   ASSERT_EQ(orig_block, serial_block);
 }
+
+/**
+ * @given proto block holding a larger block
+ * @when another block is serialized into it
+ * @then nothing of the previous block is left
+ */
+TEST(BlockTest, ReusedMessageIsOverwritten) {
+  auto make_tx = [](const std::string &creator) {
+    auto tx = iroha::model::Transaction();
+    tx.creator_account_id = creator;
+    auto command = iroha::model::CreateDomain();
+    command.domain_name = creator;
+    tx.commands = {std::make_shared<iroha::model::CreateDomain>(command)};
+    return tx;
+  };
+  auto large = iroha::model::Block();
+  large.height = 1;
+  large.txs_number = 2;
+  large.sigs.resize(2);
+  large.transactions = {make_tx("a@b"), make_tx("c@d")};
+  auto small = iroha::model::Block();
+  small.height = 2;
+  small.txs_number = 1;
+  small.transactions = {make_tx("e@f")};
+  iroha::model::HashProviderImpl hash_provider;
+  small.merkle_root = hash_provider.get_merkle_root(small.transactions);
+  small.hash = hash_provider.get_hash(small);
+
+  auto factory = iroha::model::converters::PbBlockFactory();
+  iroha::protocol::Block proto_block;
+  factory.serialize(large, proto_block);
+  factory.serialize(small, proto_block);
+
+  ASSERT_EQ(factory.serialize(small).SerializeAsString(),
+            proto_block.SerializeAsString());
+  ASSERT_EQ(small, factory.deserialize(proto_block));
+}
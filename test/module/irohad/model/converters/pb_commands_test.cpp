@@ -200,3 +200,35 @@ TEST(CommandTest, set_transfer_asset) {
   command_converter_test(orig_command);
 }
 
+
+TEST(CommandTest, kinds_follow_command_list) {
+  using namespace iroha::model;
+  ASSERT_EQ(0u, AddAssetQuantity().kind());
+  ASSERT_EQ(1u, AddPeer().kind());
+  ASSERT_EQ(kCommandKinds - 1, TransferAsset().kind());
+}
+
+/**
+ * Command which is not in the command list
+ */
+struct UnlistedCommand : public iroha::model::Command {
+  bool validate(iroha::ametsuchi::WsvQuery &,
+                const iroha::model::Account &) override {
+    return false;
+  }
+  bool execute(iroha::ametsuchi::WsvQuery &,
+               iroha::ametsuchi::WsvCommand &) override {
+    return false;
+  }
+  bool operator==(const Command &) const override { return false; }
+  bool operator!=(const Command &) const override { return true; }
+};
+
+TEST(CommandTest, unlisted_command_is_not_serialized) {
+  auto factory = iroha::model::converters::PbCommandFactory();
+
+  auto pb_command = factory.serializeAbstractCommand(UnlistedCommand());
+  ASSERT_EQ(iroha::protocol::Command::COMMAND_NOT_SET,
+            pb_command.command_case());
+  ASSERT_EQ(nullptr, factory.deserializeAbstractCommand(pb_command));
+}
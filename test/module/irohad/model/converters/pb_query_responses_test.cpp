@@ -16,7 +16,9 @@
  */
 
 #include <gtest/gtest.h>
+#include "model/commands/add_peer.hpp"
 #include "model/converters/pb_query_response_factory.hpp"
+#include "model/model_hash_provider_impl.hpp"
 
 using namespace iroha;
 
@@ -147,3 +149,31 @@ TEST(QueryResponseTest, TransactionsResponseTest) {
               i);
   }
 }
+
+/**
+ * @given transaction response with mask leaving out bodies and signatures
+ * @when response is serialized
+ * @then transaction is sent without commands and signatures, and hash of
+ * the whole transaction is sent with it
+ */
+TEST(QueryResponseTest, MaskedTransactionResponseTest) {
+  model::converters::PbQueryResponseFactory pb_factory;
+
+  model::Transaction tx;
+  tx.tx_counter = 5;
+  tx.commands.push_back(std::make_shared<model::AddPeer>());
+  tx.signatures.push_back(model::Signature{});
+
+  model::TransactionResponse tx_response;
+  tx_response.transaction = tx;
+  tx_response.mask.omit_bodies = true;
+  tx_response.mask.omit_signatures = true;
+
+  auto pb_response = pb_factory.serializeTransactionResponse(tx_response);
+
+  ASSERT_EQ(pb_response.transaction().body().commands_size(), 0);
+  ASSERT_EQ(pb_response.transaction().header().signatures_size(), 0);
+  ASSERT_EQ(pb_response.transaction().meta().tx_counter(), 5);
+  auto hash = model::HashProviderImpl().get_hash(tx);
+  ASSERT_EQ(pb_response.tx_hash(), hash.to_string());
+}
@@ -18,6 +18,7 @@
 #include <gtest/gtest.h>
 #include "commands.pb.h"
 #include "model/converters/pb_transaction_factory.hpp"
+#include "model/converters/pb_transaction_view.hpp"
 #include "model/transaction.hpp"
 
 #include "model/commands/add_asset_quantity.hpp"
@@ -80,3 +81,57 @@ TEST(TransactionTest, tx_test) {
   auto serial_tx = factory.deserialize(proto_tx);
   ASSERT_EQ(orig_tx, *serial_tx);
 }
+
+/**
+ * @given serialized transaction
+ * @when its view is read and its signature or command is broken
+ * @then fields are read from the message, and the broken one is not
+ * well formed
+ */
+TEST(TransactionTest, ViewChecksMessageBeforeConversion) {
+  auto orig_tx = iroha::model::Transaction();
+  orig_tx.creator_account_id = "andr@kek";
+  orig_tx.tx_counter = 3;
+  orig_tx.signatures.push_back(iroha::model::Signature());
+  orig_tx.commands.push_back(std::make_shared<iroha::model::AddPeer>());
+
+  iroha::model::converters::PbTransactionFactory factory;
+  auto proto_tx = factory.serialize(orig_tx);
+  iroha::model::converters::PbTransactionView view(proto_tx);
+  ASSERT_EQ(orig_tx.creator_account_id, view.creatorAccountId());
+  ASSERT_EQ(3, view.txCounter());
+  ASSERT_EQ(1, view.signaturesSize());
+  ASSERT_EQ(1, view.commandsSize());
+  ASSERT_TRUE(view.wellFormed());
+
+  proto_tx.mutable_header()->mutable_signatures(0)->set_pubkey("short");
+  ASSERT_FALSE(view.wellFormed());
+
+  proto_tx = factory.serialize(orig_tx);
+  proto_tx.mutable_body()->mutable_commands(0)->Clear();
+  ASSERT_FALSE(view.wellFormed());
+}
+
+/**
+ * @given transaction of sampled trace
+ * @when it is converted to protobuf and back
+ * @then trace is kept, and hash does not depend on it
+ */
+TEST(TransactionTest, TraceIsCarriedButNotHashed) {
+  auto orig_tx = iroha::model::Transaction();
+  orig_tx.creator_account_id = "andr@kek";
+  orig_tx.commands.push_back(std::make_shared<iroha::model::AddPeer>());
+
+  iroha::model::converters::PbTransactionFactory factory;
+  auto untraced = factory.deserialize(factory.serialize(orig_tx));
+  ASSERT_FALSE(untraced->trace);
+
+  orig_tx.trace = iroha::tracing::TraceContext::parse(
+      "00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01");
+  auto proto_tx = factory.serialize(orig_tx);
+  ASSERT_EQ(proto_tx.trace_parent(), orig_tx.trace->traceparent());
+  auto traced = factory.deserialize(proto_tx);
+  ASSERT_TRUE(traced->trace);
+  ASSERT_EQ(traced->trace->traceparent(), orig_tx.trace->traceparent());
+  ASSERT_EQ(traced->tx_hash, untraced->tx_hash);
+}
@@ -0,0 +1,79 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "model/interned_id.hpp"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using namespace iroha::model;
+
+/**
+ * @given identifier interned twice
+ * @when handles are compared
+ * @then they are equal and read the same string
+ */
+TEST(InternedIdTest, SameIdentifierSameHandle) {
+  InternedId first(std::string("alice@interned_test"));
+  InternedId second(std::string("alice@interned_test"));
+  InternedId other(std::string("bob@interned_test"));
+
+  ASSERT_EQ(first, second);
+  ASSERT_EQ(first.hash(), second.hash());
+  ASSERT_NE(first, other);
+  ASSERT_EQ("alice@interned_test", first.str());
+}
+
+/**
+ * @given identifier which is not interned
+ * @when it is looked up and then interned
+ * @then lookup finds it only after interning
+ */
+TEST(InternedIdTest, FindDoesNotIntern) {
+  const std::string id = "carol@interned_test";
+  ASSERT_FALSE(InternedId::find(id));
+  ASSERT_FALSE(InternedId::find(id));
+
+  InternedId interned(id);
+  auto found = InternedId::find(id);
+  ASSERT_TRUE(found);
+  ASSERT_EQ(interned, *found);
+}
+
+/**
+ * @given threads interning the same identifiers
+ * @when all of them are done
+ * @then they have got the same handles
+ */
+TEST(InternedIdTest, ConcurrentIntern) {
+  const size_t kThreads = 4, kIds = 1000;
+  std::vector<std::vector<InternedId>> results(kThreads);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&results, t] {
+      for (size_t i = 0; i < kIds; ++i) {
+        results[t].emplace_back(std::to_string(i) + "@concurrent");
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (size_t t = 1; t < kThreads; ++t) {
+    ASSERT_EQ(results[0], results[t]);
+  }
+}
@@ -0,0 +1,110 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include "crypto/hash.hpp"
+#include "model/merkle_tree.hpp"
+#include "model/model_hash_provider_impl.hpp"
+
+using namespace iroha;
+using iroha::model::MerkleTree;
+
+class MerkleTreeTest : public ::testing::Test {
+ public:
+  static hash256_t leaf(uint8_t i) {
+    hash256_t leaf{};
+    leaf.fill(i);
+    return leaf;
+  }
+
+  static hash256_t combine(const hash256_t &left, const hash256_t &right) {
+    auto data = left.to_string() + right.to_string();
+    return sha3_256(reinterpret_cast<const uint8_t *>(data.data()),
+                    data.size());
+  }
+};
+
+/**
+ * @given empty tree and tree of one leaf
+ * @when root is computed
+ * @then it is zero hash and the leaf itself
+ */
+TEST_F(MerkleTreeTest, RootOfSmallTrees) {
+  MerkleTree tree;
+  ASSERT_EQ(hash256_t{}, tree.root());
+
+  tree.append(leaf(1));
+  ASSERT_EQ(1, tree.size());
+  ASSERT_EQ(leaf(1), tree.root());
+}
+
+/**
+ * @given tree of five leaves
+ * @when root is computed
+ * @then unpaired nodes are promoted to the next level
+ */
+TEST_F(MerkleTreeTest, UnpairedNodesArePromoted) {
+  auto tree = MerkleTree::build(
+      {leaf(0), leaf(1), leaf(2), leaf(3), leaf(4)});
+
+  auto left = combine(combine(leaf(0), leaf(1)), combine(leaf(2), leaf(3)));
+  ASSERT_EQ(combine(left, leaf(4)), tree.root());
+}
+
+/**
+ * @given trees of different sizes
+ * @when proof is made for every leaf
+ * @then it leads to the root, and not for other leaf or root
+ */
+TEST_F(MerkleTreeTest, ProofsLeadToRoot) {
+  MerkleTree tree;
+  for (uint8_t size = 1; size <= 17; ++size) {
+    tree.append(leaf(size - 1));
+    auto root = tree.root();
+    for (uint8_t i = 0; i < size; ++i) {
+      auto proof = tree.proof(i);
+      ASSERT_TRUE(proof);
+      ASSERT_TRUE(MerkleTree::verify(leaf(i), *proof, root));
+      ASSERT_FALSE(MerkleTree::verify(leaf(size), *proof, root));
+      ASSERT_FALSE(MerkleTree::verify(leaf(i), *proof, leaf(size)));
+    }
+    ASSERT_FALSE(tree.proof(size));
+  }
+}
+
+/**
+ * @given block whose merkle root is computed by hash provider
+ * @when proof of its transaction is checked with crypto helper only
+ * @then path leads from hash of the transaction to root of the block
+ */
+TEST_F(MerkleTreeTest, ProofOfBlockTransaction) {
+  model::HashProviderImpl hash_provider;
+  std::vector<model::Transaction> transactions(5);
+  std::vector<hash256_t> leaves;
+  for (size_t i = 0; i < transactions.size(); ++i) {
+    transactions[i].tx_counter = i;
+    leaves.push_back(hash_provider.get_hash(transactions[i]));
+  }
+  auto root = hash_provider.get_merkle_root(transactions);
+  auto tree = MerkleTree::build(leaves);
+  ASSERT_EQ(root, tree.root());
+
+  auto proof = tree.proof(3);
+  ASSERT_TRUE(proof);
+  ASSERT_TRUE(verify_merkle_path(leaves[3], *proof, root));
+  ASSERT_FALSE(verify_merkle_path(leaves[2], *proof, root));
+}
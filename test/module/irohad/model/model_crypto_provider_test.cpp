@@ -62,3 +62,25 @@ TEST(CryptoProvider, SignAndVerify) {
   model_tx.creator_account_id = "test1";
   ASSERT_FALSE(crypto_provider.verify(model_tx));
 }
+
+/**
+ * @given signed transaction
+ * @when it is modified and verified with every signature check
+ * @then only check none accepts it
+ */
+TEST(CryptoProvider, EverySignatureCheckRejectsModifiedTransaction) {
+  auto keypair = iroha::create_keypair(iroha::create_seed());
+  auto model_tx = create_transaction();
+  sign(model_tx, keypair.privkey, keypair.pubkey);
+  model_tx.creator_account_id = "test1";
+
+  for (auto check : {SignatureCheck::Serial,
+                     SignatureCheck::Parallel,
+                     SignatureCheck::Cached}) {
+    ModelCryptoProviderImpl crypto_provider(check);
+    ASSERT_FALSE(crypto_provider.verify(model_tx));
+  }
+  ASSERT_TRUE(ModelCryptoProviderImpl(SignatureCheck::None).verify(model_tx));
+  ASSERT_EQ(SignatureCheck::Parallel, parseSignatureCheck("parallel"));
+  ASSERT_FALSE(parseSignatureCheck("unknown"));
+}
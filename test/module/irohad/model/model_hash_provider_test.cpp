@@ -17,6 +17,10 @@ limitations under the License.
 #include <gtest/gtest.h>
 #include <common/types.hpp>
 #include <model/model_hash_provider_impl.hpp>
+#include "crypto/hash.hpp"
+#include "model/commands/add_peer.hpp"
+#include "model/converters/pb_transaction_factory.hpp"
+#include "model/merkle_tree.hpp"
 
 iroha::model::Signature create_signature();
 iroha::model::Transaction create_transaction();
@@ -104,3 +108,86 @@ TEST(ModelHashProviderTest, ModelHashProviderWhenGetHashTransactionIsCalled) {
 
   std::cout << "transaction hash: " << res.to_hexstring() << std::endl;
 }
+
+/**
+ * @given block with transactions
+ * @when merkle root of its transactions changes
+ * @then block hash changes, root is the same as of proposal with them
+ */
+TEST(ModelHashProviderTest, BlockHashCoversMerkleRoot) {
+  iroha::model::HashProviderImpl hash_provider;
+  auto block = create_block();
+  block.transactions.push_back(create_transaction());
+  block.transactions.back().tx_counter = 1;
+  auto hash = hash_provider.get_hash(block);
+
+  block.merkle_root = hash_provider.get_merkle_root(block.transactions);
+  ASSERT_NE(hash, hash_provider.get_hash(block));
+
+  auto tree = iroha::model::MerkleTree::build(
+      {hash_provider.get_hash(block.transactions.at(0)),
+       hash_provider.get_hash(block.transactions.at(1))});
+  ASSERT_EQ(tree.root(), block.merkle_root);
+  ASSERT_EQ(tree.root(),
+            hash_provider.get_hash(iroha::model::Proposal(block.transactions)));
+}
+
+/**
+ * @given transaction with command
+ * @when field of command, creator or counter changes
+ * @then hash changes, while signatures and copies of command do not
+ * change it, and it is a hash of protobuf meta and body
+ */
+TEST(ModelHashProviderTest, TransactionHashIsCanonical) {
+  iroha::model::HashProviderImpl hash_provider;
+  auto tx = create_transaction();
+  iroha::model::AddPeer add_peer;
+  add_peer.address = "localhost";
+  tx.commands.push_back(std::make_shared<iroha::model::AddPeer>(add_peer));
+  auto hash = hash_provider.get_hash(tx);
+
+  auto copy = tx;
+  copy.commands = {std::make_shared<iroha::model::AddPeer>(add_peer)};
+  copy.signatures.clear();
+  ASSERT_EQ(hash, hash_provider.get_hash(copy));
+
+  add_peer.address = "otherhost";
+  copy.commands = {std::make_shared<iroha::model::AddPeer>(add_peer)};
+  ASSERT_NE(hash, hash_provider.get_hash(copy));
+
+  copy = tx;
+  copy.tx_counter = 256;
+  ASSERT_NE(hash, hash_provider.get_hash(copy));
+
+  copy = tx;
+  copy.creator_account_id = "2";
+  ASSERT_NE(hash, hash_provider.get_hash(copy));
+
+  auto pb_tx = iroha::model::converters::PbTransactionFactory().serialize(tx);
+  auto payload =
+      pb_tx.meta().SerializeAsString() + pb_tx.body().SerializeAsString();
+  ASSERT_EQ(hash,
+            iroha::sha3_256(reinterpret_cast<const uint8_t *>(payload.data()),
+                            payload.size()));
+}
+
+/**
+ * @given transaction converted from protobuf
+ * @when it is hashed again
+ * @then hash kept with it is returned, while unset one is computed
+ */
+TEST(ModelHashProviderTest, TransactionHashIsComputedOnce) {
+  iroha::model::HashProviderImpl hash_provider;
+  auto tx = create_transaction();
+  auto hash = hash_provider.get_hash(tx);
+
+  iroha::model::converters::PbTransactionFactory factory;
+  auto converted = factory.deserialize(factory.serialize(tx));
+  ASSERT_EQ(hash, converted->tx_hash);
+
+  // kept hash is trusted, proposal and block roots reuse it
+  converted->tx_hash.fill(0x1);
+  ASSERT_EQ(converted->tx_hash, hash_provider.get_hash(*converted));
+  converted->tx_hash = {};
+  ASSERT_EQ(hash, hash_provider.get_hash(*converted));
+}
@@ -196,6 +196,22 @@ TEST(ModelOperatorTest, SetAccountPermissionsTest) {
   ASSERT_NE(first, second);
 }
 
+TEST(ModelOperatorTest, PermissionsBitmaskTest) {
+  Account::Permissions permissions;
+  ASSERT_EQ(permissions.toBitmask(), 0);
+  permissions.set_quorum = true;
+  permissions.add_signatory = true;
+  ASSERT_EQ(permissions.toBitmask(),
+            Account::Permissions::kSetQuorum |
+                Account::Permissions::kAddSignatory);
+
+  auto restored =
+      Account::Permissions::fromBitmask(permissions.toBitmask() | 1ull << 63);
+  ASSERT_EQ(permissions, restored);
+  restored.can_transfer = true;
+  ASSERT_NE(permissions, restored);
+}
+
 // -----|SetQuorum|-----
 
 SetQuorum createSetQuorum() {
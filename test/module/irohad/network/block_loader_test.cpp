@@ -0,0 +1,151 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <grpc++/grpc++.h>
+#include <gtest/gtest.h>
+#include "model/model_hash_provider_impl.hpp"
+#include "module/irohad/ametsuchi/ametsuchi_mocks.hpp"
+#include "network/impl/block_loader_impl.hpp"
+#include "network/impl/block_loader_service.hpp"
+
+using namespace iroha::network;
+using namespace iroha::ametsuchi;
+using namespace iroha::model;
+
+using ::testing::Invoke;
+using ::testing::Return;
+using ::testing::_;
+
+class BlockLoaderTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    for (uint64_t height = 1; height <= 40; ++height) {
+      Block block;
+      block.height = height;
+      block.created_ts = height;
+      block.hash = HashProviderImpl().get_hash(block);
+      blocks.push_back(block);
+    }
+    peers = {make_peer(1), make_peer(2)};
+
+    peer_query = std::make_shared<MockPeerQuery>();
+    local_storage = std::make_shared<MockBlockQuery>();
+    remote_storage = std::make_shared<MockBlockQuery>();
+    EXPECT_CALL(*peer_query, getLedgerPeers()).WillRepeatedly(Return(peers));
+    EXPECT_CALL(*remote_storage, getTopBlockHeight())
+        .WillRepeatedly(Return(blocks.size()));
+    EXPECT_CALL(*remote_storage, getBlocks(_, _))
+        .WillRepeatedly(Invoke([this](uint32_t from, uint32_t to) {
+          return rxcpp::observable<>::iterate(std::vector<Block>(
+              blocks.begin() + from - 1, blocks.begin() + to));
+        }));
+    EXPECT_CALL(*remote_storage, getWireBlocks(_, _))
+        .WillRepeatedly(Invoke([this](uint32_t from, uint32_t to) {
+          std::vector<iroha::protocol::Block> wire;
+          for (auto i = from; i <= to; ++i) {
+            wire.push_back(factory.serialize(blocks.at(i - 1)));
+          }
+          return rxcpp::observable<>::iterate(wire);
+        }));
+
+    service = std::make_shared<BlockLoaderService>(remote_storage);
+    loader = std::make_shared<BlockLoaderImpl>(
+        peer_query, local_storage, std::make_shared<ChannelRegistry>());
+
+    grpc::ServerBuilder builder;
+    int port = 0;
+    builder.AddListeningPort(
+        address, grpc::InsecureServerCredentials(), &port);
+    builder.RegisterService(service.get());
+    server = builder.BuildAndStart();
+    ASSERT_NE(port, 0);
+  }
+
+  void TearDown() override { server->Shutdown(); }
+
+  /**
+   * Peer known to ledger, all peers are served by one service
+   */
+  Peer make_peer(uint8_t key) {
+    Peer peer;
+    peer.address = address;
+    peer.pubkey.fill(key);
+    return peer;
+  }
+
+  const std::string address = "0.0.0.0:50071";
+  std::vector<Block> blocks;
+  converters::PbBlockFactory factory;
+  std::vector<Peer> peers;
+  std::shared_ptr<MockPeerQuery> peer_query;
+  std::shared_ptr<MockBlockQuery> local_storage;
+  std::shared_ptr<MockBlockQuery> remote_storage;
+  std::shared_ptr<BlockLoaderService> service;
+  std::shared_ptr<BlockLoaderImpl> loader;
+  std::unique_ptr<grpc::Server> server;
+};
+
+/**
+ * @given peer with 10 blocks and ledger of 40 blocks held by two signers
+ * @when chain up to block 40 is requested from signers known by public key
+ * @then missing blocks are received in order of height
+ */
+TEST_F(BlockLoaderTest, RetrieveChainFromSigners) {
+  EXPECT_CALL(*local_storage, getTopBlockHeight()).WillOnce(Return(10));
+  std::vector<Peer> signers(2);
+  signers[0].pubkey = peers[0].pubkey;
+  signers[1].pubkey = peers[1].pubkey;
+
+  std::vector<Block> chain;
+  loader->retrieveChain(signers, 40).as_blocking().subscribe(
+      [&chain](const Block &block) { chain.push_back(block); });
+
+  ASSERT_EQ(30, chain.size());
+  for (size_t i = 0; i < chain.size(); ++i) {
+    ASSERT_EQ(blocks.at(10 + i).hash, chain.at(i).hash);
+  }
+}
+
+/**
+ * @given peer with 38 blocks
+ * @when blocks following its top are requested from other peer
+ * @then all blocks up to top of that peer are received
+ */
+TEST_F(BlockLoaderTest, RequestBlocksFromPeer) {
+  auto top = blocks.at(37);
+
+  std::vector<Block> chain;
+  loader->requestBlocks(peers.front(), top).as_blocking().subscribe(
+      [&chain](const Block &block) { chain.push_back(block); });
+
+  ASSERT_EQ(2, chain.size());
+  ASSERT_EQ(39, chain.front().height);
+  ASSERT_EQ(40, chain.back().height);
+}
+
+/**
+ * @given ledger of 40 blocks
+ * @when block is requested by its height and hash
+ * @then block is received only if hash matches
+ */
+TEST_F(BlockLoaderTest, RetrieveBlockByHash) {
+  auto block = loader->retrieveBlock(peers.front(), 3, blocks.at(2).hash);
+  ASSERT_TRUE(block);
+  ASSERT_EQ(blocks.at(2).hash, block->hash);
+
+  ASSERT_FALSE(loader->retrieveBlock(peers.front(), 4, blocks.at(2).hash));
+}
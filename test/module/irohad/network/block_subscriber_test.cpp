@@ -0,0 +1,227 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <grpc++/grpc++.h>
+#include <gtest/gtest.h>
+#include <future>
+#include "model/model_hash_provider_impl.hpp"
+#include "module/irohad/ametsuchi/ametsuchi_mocks.hpp"
+#include "module/irohad/network/tls_certificates.hpp"
+#include "module/irohad/validation/validation_mocks.hpp"
+#include "network/impl/block_loader_service.hpp"
+#include "network/impl/block_subscriber.hpp"
+#include "network/impl/peer_authenticator.hpp"
+
+using namespace iroha;
+using namespace iroha::network;
+using namespace iroha::ametsuchi;
+using namespace iroha::model;
+using namespace iroha::validation;
+
+using ::testing::Invoke;
+using ::testing::Return;
+using ::testing::_;
+
+class BlockSubscriberTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    for (uint64_t height = 1; height <= 40; ++height) {
+      Block block;
+      block.height = height;
+      block.created_ts = height;
+      block.hash = HashProviderImpl().get_hash(block);
+      blocks.push_back(block);
+    }
+
+    remote_storage = std::make_shared<MockBlockQuery>();
+    local_storage = std::make_shared<MockBlockQuery>();
+    mutable_factory = std::make_shared<MockMutableFactory>();
+    validator = std::make_shared<MockChainValidator>();
+    EXPECT_CALL(*remote_storage, getTopBlockHeight())
+        .WillRepeatedly(Invoke([this] { return top.load(); }));
+    EXPECT_CALL(*remote_storage, getBlocks(_, _))
+        .WillRepeatedly(Invoke([this](uint32_t from, uint32_t to) {
+          return rxcpp::observable<>::iterate(std::vector<Block>(
+              blocks.begin() + from - 1, blocks.begin() + to));
+        }));
+    EXPECT_CALL(*remote_storage, getWireBlocks(_, _))
+        .WillRepeatedly(Invoke([this](uint32_t from, uint32_t to) {
+          std::vector<iroha::protocol::Block> wire;
+          for (auto i = from; i <= to; ++i) {
+            wire.push_back(factory.serialize(blocks.at(i - 1)));
+          }
+          return rxcpp::observable<>::iterate(wire);
+        }));
+    EXPECT_CALL(*mutable_factory, createMutableStorage())
+        .WillRepeatedly(Invoke([] {
+          return std::unique_ptr<MutableStorage>(
+              std::make_unique<MockMutableStorage>());
+        }));
+
+    service = std::make_shared<BlockLoaderService>(remote_storage);
+    subscriber = std::make_unique<BlockSubscriber>(
+        std::vector<std::string>{address},
+        std::make_shared<ChannelRegistry>(),
+        validator,
+        mutable_factory,
+        local_storage);
+
+    grpc::ServerBuilder builder;
+    int port = 0;
+    builder.AddListeningPort(
+        address, grpc::InsecureServerCredentials(), &port);
+    builder.RegisterService(service.get());
+    server = builder.BuildAndStart();
+    ASSERT_NE(port, 0);
+  }
+
+  void TearDown() override {
+    subscriber->stop();
+    server->Shutdown();
+  }
+
+  const std::string address = "0.0.0.0:50072";
+  std::vector<Block> blocks;
+  converters::PbBlockFactory factory;
+  std::atomic<uint64_t> top{38};
+  std::shared_ptr<MockBlockQuery> remote_storage;
+  std::shared_ptr<MockBlockQuery> local_storage;
+  std::shared_ptr<MockMutableFactory> mutable_factory;
+  std::shared_ptr<MockChainValidator> validator;
+  std::shared_ptr<BlockLoaderService> service;
+  std::unique_ptr<BlockSubscriber> subscriber;
+  std::unique_ptr<grpc::Server> server;
+};
+
+/**
+ * @given observer with 36 blocks and validator with 38 blocks
+ * @when observer follows validator, which commits two more blocks
+ * @then blocks from 37 to 40 are validated and committed in order
+ */
+TEST_F(BlockSubscriberTest, FollowsCommittedBlocks) {
+  EXPECT_CALL(*local_storage, getTopBlockHeight()).WillOnce(Return(36));
+  EXPECT_CALL(*validator, validateBlock(_, _)).WillRepeatedly(Return(true));
+  EXPECT_CALL(*mutable_factory, commit_(_)).Times(4);
+
+  std::vector<uint64_t> heights;
+  std::promise<void> done;
+  subscriber->on_commit().subscribe([&heights, &done](Commit commit) {
+    commit.subscribe([&heights, &done](const auto &block) {
+      heights.push_back(block->height);
+      if (block->height == 40) {
+        done.set_value();
+      }
+    });
+  });
+  subscriber->start();
+
+  top = 40;
+  service->committed(40);
+
+  ASSERT_EQ(std::future_status::ready,
+            done.get_future().wait_for(std::chrono::seconds(5)));
+  ASSERT_EQ(std::vector<uint64_t>({37, 38, 39, 40}), heights);
+}
+
+/**
+ * @given observer with 38 blocks
+ * @when validator sends block which is invalid
+ * @then block is not committed
+ */
+TEST_F(BlockSubscriberTest, InvalidBlockIsNotCommitted) {
+  top = 40;
+  EXPECT_CALL(*local_storage, getTopBlockHeight()).WillRepeatedly(Return(38));
+  std::promise<void> validated;
+  EXPECT_CALL(*validator, validateBlock(_, _))
+      .WillOnce(Invoke([&validated](const Block &, MutableStorage &) {
+        validated.set_value();
+        return false;
+      }))
+      .WillRepeatedly(Return(false));
+  EXPECT_CALL(*mutable_factory, commit_(_)).Times(0);
+
+  subscriber->start();
+  ASSERT_EQ(std::future_status::ready,
+            validated.get_future().wait_for(std::chrono::seconds(5)));
+}
+
+/**
+ * @given validator serving blocks over TLS, which admits certificate of
+ * observer key
+ * @when observer with its own certificate follows validator at address
+ * which is not in peer list of observer, with key of validator pinned
+ * @then blocks of validator are committed by observer
+ */
+TEST_F(BlockSubscriberTest, FollowsValidatorOverTls) {
+  using namespace tls_certificates;
+  const std::string tls_address = "0.0.0.0:50073";
+  Peer validator_peer;
+  validator_peer.address = tls_address;
+  validator_peer.pubkey.fill(1);
+  ed25519::pubkey_t observer_key;
+  observer_key.fill(2);
+
+  ChannelOptions validator_options;
+  validator_options.tls.certificate = kValidatorCertificate;
+  validator_options.tls.private_key = kValidatorKey;
+  validator_options.tls.root_certificates = kRootCertificate;
+  auto authenticator = std::make_shared<PeerAuthenticator>();
+  authenticator->update({validator_peer});
+  authenticator->setObservers({observer_key});
+  grpc::ServerBuilder builder;
+  int port = 0;
+  builder.AddListeningPort(
+      tls_address, serverCredentials(validator_options, authenticator), &port);
+  builder.RegisterService(service.get());
+  auto tls_server = builder.BuildAndStart();
+  ASSERT_NE(port, 0);
+
+  ChannelOptions observer_options;
+  observer_options.tls.certificate = kObserverCertificate;
+  observer_options.tls.private_key = kObserverKey;
+  observer_options.tls.root_certificates = kRootCertificate;
+  auto channels = std::make_shared<ChannelRegistry>(observer_options);
+  channels->update({});
+  channels->pin(tls_address, validator_peer.pubkey);
+  BlockSubscriber tls_subscriber({tls_address},
+                                 channels,
+                                 validator,
+                                 mutable_factory,
+                                 local_storage);
+
+  EXPECT_CALL(*local_storage, getTopBlockHeight()).WillOnce(Return(36));
+  EXPECT_CALL(*validator, validateBlock(_, _)).WillRepeatedly(Return(true));
+  EXPECT_CALL(*mutable_factory, commit_(_)).Times(2);
+
+  std::vector<uint64_t> heights;
+  std::promise<void> done;
+  tls_subscriber.on_commit().subscribe([&heights, &done](Commit commit) {
+    commit.subscribe([&heights, &done](const auto &block) {
+      heights.push_back(block->height);
+      if (block->height == 38) {
+        done.set_value();
+      }
+    });
+  });
+  tls_subscriber.start();
+
+  auto synced = done.get_future().wait_for(std::chrono::seconds(5));
+  tls_subscriber.stop();
+  tls_server->Shutdown();
+  ASSERT_EQ(std::future_status::ready, synced);
+  ASSERT_EQ(std::vector<uint64_t>({37, 38}), heights);
+}
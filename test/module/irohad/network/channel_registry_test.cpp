@@ -0,0 +1,167 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <map>
+#include "network/impl/channel_registry.hpp"
+
+using namespace iroha::network;
+using iroha::model::Peer;
+
+Peer make_peer(const std::string &address) {
+  Peer peer;
+  peer.address = address;
+  return peer;
+}
+
+/**
+ * @given channel registry
+ * @when channel to same address is requested twice
+ * @then same channel is returned
+ */
+TEST(ChannelRegistryTest, ChannelIsCreatedOnce) {
+  ChannelRegistry registry;
+  auto first = registry.channel("0.0.0.0:10001");
+  auto second = registry.channel("0.0.0.0:10001");
+
+  ASSERT_NE(nullptr, first);
+  ASSERT_EQ(first, second);
+  ASSERT_EQ(1, registry.size());
+}
+
+/**
+ * @given channel registry with channels to two peers
+ * @when peer set is updated with one peer replaced
+ * @then channel of remaining peer is kept, channel of removed peer is
+ * released and channel of new peer is created
+ */
+TEST(ChannelRegistryTest, UpdateIsIncremental) {
+  ChannelRegistry registry;
+  registry.update({make_peer("0.0.0.0:10001"), make_peer("0.0.0.0:10002")});
+  auto kept = registry.channel("0.0.0.0:10001");
+  std::weak_ptr<grpc::Channel> removed = registry.channel("0.0.0.0:10002");
+
+  registry.update({make_peer("0.0.0.0:10001"), make_peer("0.0.0.0:10003")});
+
+  ASSERT_EQ(2, registry.size());
+  ASSERT_EQ(kept, registry.channel("0.0.0.0:10001"));
+  ASSERT_TRUE(removed.expired());
+  ASSERT_EQ(2, registry.size());
+}
+
+/**
+ * @given transport settings with compression, keepalive and limits
+ * @when channel arguments are made of them
+ * @then every setting is passed to grpc, and unset ones are left out
+ */
+TEST(ChannelRegistryTest, OptionsAreTranslatedToArguments) {
+  ChannelOptions options;
+  options.compression = *parseCompression("gzip");
+  options.keepalive_time = std::chrono::milliseconds(10000);
+  options.max_message_size = 64 * 1024 * 1024;
+
+  grpc_channel_args args;
+  channelArguments(options).SetChannelArgs(&args);
+  std::map<std::string, int> values;
+  for (size_t i = 0; i < args.num_args; ++i) {
+    if (args.args[i].type == GRPC_ARG_INTEGER) {
+      values[args.args[i].key] = args.args[i].value.integer;
+    }
+  }
+
+  ASSERT_EQ(GRPC_COMPRESS_GZIP,
+            values[GRPC_COMPRESSION_CHANNEL_DEFAULT_ALGORITHM]);
+  ASSERT_EQ(10000, values[GRPC_ARG_KEEPALIVE_TIME_MS]);
+  ASSERT_EQ(64 * 1024 * 1024, values[GRPC_ARG_MAX_RECEIVE_MESSAGE_LENGTH]);
+  ASSERT_EQ(0, values.count(GRPC_ARG_KEEPALIVE_TIMEOUT_MS));
+  ASSERT_EQ(0, values.count(GRPC_ARG_HTTP2_STREAM_LOOKAHEAD_BYTES));
+  ASSERT_FALSE(parseCompression("lz4"));
+
+  ChannelRegistry registry(options);
+  ASSERT_NE(nullptr, registry.channel("0.0.0.0:10001"));
+}
+
+/**
+ * @given transport settings without certificates
+ * @when credentials are made of them
+ * @then TLS is disabled, and preferred cipher suites list both AES-GCM and
+ * ChaCha20-Poly1305
+ */
+TEST(ChannelRegistryTest, PlaintextWithoutCertificates) {
+  ChannelOptions options;
+  ASSERT_FALSE(options.tls.enabled());
+  ASSERT_NE(nullptr, channelCredentials(options));
+  ASSERT_NE(nullptr, serverCredentials(options));
+
+  auto suites = preferredCipherSuites();
+  ASSERT_NE(std::string::npos, suites.find("AES128-GCM"));
+  ASSERT_NE(std::string::npos, suites.find("CHACHA20-POLY1305"));
+}
+
+/**
+ * @given channel registry over TLS with channel to a peer
+ * @when key of the peer is changed
+ * @then channel is replaced, as it checks certificate of the old key
+ */
+TEST(ChannelRegistryTest, ChannelIsReplacedWhenKeyChanges) {
+  ChannelOptions options;
+  options.tls.certificate = "certificate";
+  options.tls.private_key = "key";
+  options.tls.root_certificates = "roots";
+  ChannelRegistry registry(options);
+
+  auto peer = make_peer("0.0.0.0:10001");
+  registry.update({peer});
+  auto first = registry.channel(peer.address);
+  registry.update({peer});
+  ASSERT_EQ(first, registry.channel(peer.address));
+
+  peer.pubkey.fill(1);
+  registry.update({peer});
+  ASSERT_NE(first, registry.channel(peer.address));
+  ASSERT_EQ(1, registry.size());
+}
+
+/**
+ * @given channel registry over TLS with channel to address of validator
+ * which is not a ledger peer
+ * @when key of validator is pinned, and peer set is updated
+ * @then channel is replaced to check certificate of the key, and is kept
+ * on update
+ */
+TEST(ChannelRegistryTest, PinnedChannelIsKeptOnUpdate) {
+  ChannelOptions options;
+  options.tls.certificate = "certificate";
+  options.tls.private_key = "key";
+  options.tls.root_certificates = "roots";
+  ChannelRegistry registry(options);
+
+  const std::string validator = "0.0.0.0:10002";
+  auto unchecked = registry.channel(validator);
+  iroha::ed25519::pubkey_t key;
+  key.fill(1);
+  registry.pin(validator, key);
+  auto pinned = registry.channel(validator);
+  ASSERT_NE(unchecked, pinned);
+
+  registry.update({make_peer("0.0.0.0:10001")});
+  ASSERT_EQ(pinned, registry.channel(validator));
+  ASSERT_EQ(2, registry.size());
+
+  registry.pin(validator, key);
+  ASSERT_EQ(pinned, registry.channel(validator));
+}
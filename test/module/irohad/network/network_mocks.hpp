@@ -31,7 +31,8 @@ namespace iroha {
       MOCK_METHOD1(propagate_transaction,
                    void(std::shared_ptr<const model::Transaction>));
 
-      MOCK_METHOD0(on_proposal, rxcpp::observable<model::Proposal>());
+      MOCK_METHOD0(on_proposal,
+                   rxcpp::observable<std::shared_ptr<const model::Proposal>>());
 
       MOCK_METHOD0(on_commit, rxcpp::observable<Commit>());
     };
@@ -41,6 +42,14 @@ namespace iroha {
       MOCK_METHOD2(requestBlocks,
                    rxcpp::observable<model::Block>(model::Peer &,
                                                    model::Block &));
+
+      MOCK_METHOD2(retrieveChain,
+                   rxcpp::observable<model::Block>(
+                       const std::vector<model::Peer> &, uint64_t));
+
+      MOCK_METHOD3(retrieveBlock,
+                   nonstd::optional<model::Block>(
+                       const model::Peer &, uint64_t, const hash256_t &));
     };
 
     class MockOrderingGate : public OrderingGate {
@@ -48,14 +57,16 @@ namespace iroha {
       MOCK_METHOD1(propagate_transaction,
                    void(std::shared_ptr<const model::Transaction> transaction));
 
-      MOCK_METHOD0(on_proposal, rxcpp::observable<model::Proposal>());
+      MOCK_METHOD0(on_proposal,
+                   rxcpp::observable<std::shared_ptr<const model::Proposal>>());
     };
 
     class MockConsensusGate : public ConsensusGate {
      public:
-      MOCK_METHOD1(vote, void(model::Block));
+      MOCK_METHOD1(vote, void(std::shared_ptr<const model::Block>));
 
-      MOCK_METHOD0(on_commit, rxcpp::observable<model::Block>());
+      MOCK_METHOD0(on_commit,
+                   rxcpp::observable<std::shared_ptr<const model::Block>>());
     };
   }  // namespace network
 }  // namespace iroha
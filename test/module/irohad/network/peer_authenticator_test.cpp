@@ -0,0 +1,175 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <map>
+#include "network/impl/peer_authenticator.hpp"
+
+using namespace iroha::network;
+using iroha::model::Peer;
+
+/**
+ * Iterator over no properties, the default one is constructed only by grpc
+ */
+struct EmptyIterator : public grpc::AuthPropertyIterator {};
+
+/**
+ * Properties of TLS connection, as grpc fills them from certificate of
+ * client
+ */
+class TestAuthContext : public grpc::AuthContext {
+ public:
+  explicit TestAuthContext(bool authenticated)
+      : authenticated_(authenticated) {}
+
+  bool IsPeerAuthenticated() const override {
+    return authenticated_;
+  }
+  std::vector<grpc::string_ref> GetPeerIdentity() const override {
+    return FindPropertyValues(GRPC_X509_CN_PROPERTY_NAME);
+  }
+  std::string GetPeerIdentityPropertyName() const override {
+    return GRPC_X509_CN_PROPERTY_NAME;
+  }
+  std::vector<grpc::string_ref> FindPropertyValues(
+      const std::string &name) const override {
+    std::vector<grpc::string_ref> values;
+    auto range = properties_.equal_range(name);
+    for (auto it = range.first; it != range.second; ++it) {
+      values.emplace_back(it->second);
+    }
+    return values;
+  }
+  grpc::AuthPropertyIterator begin() const override {
+    return EmptyIterator();
+  }
+  grpc::AuthPropertyIterator end() const override {
+    return EmptyIterator();
+  }
+  void AddProperty(const std::string &key,
+                   const grpc::string_ref &value) override {
+    properties_.emplace(key, std::string(value.data(), value.size()));
+  }
+  bool SetPeerIdentityPropertyName(const std::string &name) override {
+    return false;
+  }
+
+ private:
+  bool authenticated_;
+  std::multimap<std::string, std::string> properties_;
+};
+
+Peer make_peer(const std::string &address, uint8_t key) {
+  Peer peer;
+  peer.address = address;
+  peer.pubkey.fill(key);
+  return peer;
+}
+
+class PeerAuthenticatorTest : public ::testing::Test {
+ public:
+  grpc::Status process(TestAuthContext &context) {
+    PeerAuthenticator::InputMetadata input;
+    PeerAuthenticator::OutputMetadata consumed, response;
+    return authenticator.Process(input, &context, &consumed, &response);
+  }
+
+  PeerAuthenticator authenticator;
+  Peer peer = make_peer("0.0.0.0:10001", 1);
+  Peer other = make_peer("0.0.0.0:10002", 2);
+};
+
+/**
+ * @given authenticator of single ledger peer
+ * @when peer presents certificate issued for its key, as subject
+ * alternative name or common name
+ * @then call is admitted
+ */
+TEST_F(PeerAuthenticatorTest, LedgerPeerIsAdmitted) {
+  authenticator.update({peer});
+
+  TestAuthContext san(true);
+  san.AddProperty(GRPC_X509_SAN_PROPERTY_NAME, "localhost");
+  san.AddProperty(GRPC_X509_SAN_PROPERTY_NAME,
+                  PeerAuthenticator::certificateName(peer.pubkey));
+  ASSERT_TRUE(process(san).ok());
+
+  TestAuthContext cn(true);
+  cn.AddProperty(GRPC_X509_CN_PROPERTY_NAME,
+                 PeerAuthenticator::certificateName(peer.pubkey));
+  ASSERT_TRUE(process(cn).ok());
+}
+
+/**
+ * @given authenticator of ledger peers
+ * @when certificate of unknown key, unverified certificate, or
+ * certificate of removed peer is presented
+ * @then call is rejected as unauthenticated
+ */
+TEST_F(PeerAuthenticatorTest, OtherCertificatesAreRejected) {
+  authenticator.update({peer});
+
+  TestAuthContext unknown(true);
+  unknown.AddProperty(GRPC_X509_CN_PROPERTY_NAME,
+                      PeerAuthenticator::certificateName(other.pubkey));
+  ASSERT_EQ(grpc::StatusCode::UNAUTHENTICATED,
+            process(unknown).error_code());
+
+  TestAuthContext unverified(false);
+  unverified.AddProperty(GRPC_X509_CN_PROPERTY_NAME,
+                         PeerAuthenticator::certificateName(peer.pubkey));
+  ASSERT_FALSE(process(unverified).ok());
+
+  authenticator.update({other});
+  TestAuthContext removed(true);
+  removed.AddProperty(GRPC_X509_CN_PROPERTY_NAME,
+                      PeerAuthenticator::certificateName(peer.pubkey));
+  ASSERT_FALSE(process(removed).ok());
+  ASSERT_TRUE(process(unknown).ok());
+}
+
+/**
+ * @given authenticator of ledger peer with admitted observer
+ * @when observer presents its certificate to block loader and to other
+ * internal services
+ * @then only calls of block loader are admitted, while ledger peer is
+ * admitted to all services
+ */
+TEST_F(PeerAuthenticatorTest, ObserverIsAdmittedToLoaderOnly) {
+  authenticator.update({peer});
+  authenticator.setObservers({other.pubkey});
+
+  auto call = [this](const Peer &caller, const std::string &path) {
+    TestAuthContext context(true);
+    context.AddProperty(GRPC_X509_CN_PROPERTY_NAME,
+                        PeerAuthenticator::certificateName(caller.pubkey));
+    PeerAuthenticator::InputMetadata input;
+    input.emplace(":path", path);
+    PeerAuthenticator::OutputMetadata consumed, response;
+    return authenticator.Process(input, &context, &consumed, &response);
+  };
+
+  ASSERT_TRUE(call(other, "/iroha.network.proto.Loader/retrieveBlocks").ok());
+  ASSERT_EQ(grpc::StatusCode::UNAUTHENTICATED,
+            call(other, "/iroha.consensus.yac.proto.Yac/SendVote")
+                .error_code());
+  ASSERT_TRUE(call(peer, "/iroha.consensus.yac.proto.Yac/SendVote").ok());
+  ASSERT_TRUE(call(peer, "/iroha.network.proto.Loader/retrieveBlocks").ok());
+
+  authenticator.setObservers({});
+  ASSERT_FALSE(call(other, "/iroha.network.proto.Loader/retrieveBlocks").ok());
+}
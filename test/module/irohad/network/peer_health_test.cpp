@@ -0,0 +1,95 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include "network/impl/peer_health.hpp"
+
+using iroha::network::PeerHealth;
+
+class PeerHealthTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    health = std::make_shared<PeerHealth>(100, 2);
+    for (char i = 1; i <= 4; ++i) {
+      iroha::model::Peer peer;
+      peer.address = std::to_string(i);
+      peer.pubkey.fill(i);
+      peers.push_back(peer);
+    }
+  }
+
+  std::shared_ptr<PeerHealth> health;
+  std::vector<iroha::model::Peer> peers;
+};
+
+/**
+ * @given table without observations
+ * @when peers are ordered
+ * @then they are healthy and order is kept
+ */
+TEST_F(PeerHealthTest, UnknownPeersKeepOrder) {
+  ASSERT_EQ(PeerHealth::Grade::Healthy, health->grade(peers[0].pubkey));
+  ASSERT_EQ(peers, health->leaderOrder(peers));
+  ASSERT_EQ(peers, health->syncOrder(peers));
+}
+
+/**
+ * @given one slow and one silent peer
+ * @when leaders are ordered
+ * @then healthy peers go first in given order, then slow, then unresponsive
+ */
+TEST_F(PeerHealthTest, UnhealthyLeadersAreDemoted) {
+  health->onAnswer(peers[0].pubkey, 500);
+  health->onTimeout(peers[1].pubkey);
+  health->onTimeout(peers[1].pubkey);
+  health->onAnswer(peers[3].pubkey, 10);
+
+  ASSERT_EQ(PeerHealth::Grade::Slow, health->grade(peers[0].pubkey));
+  ASSERT_EQ(PeerHealth::Grade::Unresponsive, health->grade(peers[1].pubkey));
+  auto order = health->leaderOrder(peers);
+  ASSERT_EQ((std::vector<iroha::model::Peer>{
+                peers[2], peers[3], peers[0], peers[1]}),
+            order);
+}
+
+/**
+ * @given unresponsive peer
+ * @when it answers again
+ * @then it is healthy
+ */
+TEST_F(PeerHealthTest, AnswerRestoresPeer) {
+  health->onTimeout(peers[0].pubkey);
+  health->onTimeout(peers[0].pubkey);
+  ASSERT_EQ(PeerHealth::Grade::Unresponsive, health->grade(peers[0].pubkey));
+
+  health->onAnswer(peers[0].pubkey, 10);
+  ASSERT_EQ(PeerHealth::Grade::Healthy, health->grade(peers[0].pubkey));
+}
+
+/**
+ * @given healthy peers with different answer times
+ * @when sources of blocks are ordered
+ * @then measured peers go by answer time, unmeasured after them
+ */
+TEST_F(PeerHealthTest, SyncSourcesAreOrderedByAnswerTime) {
+  health->onAnswer(peers[1].pubkey, 50);
+  health->onAnswer(peers[2].pubkey, 20);
+
+  ASSERT_EQ((std::vector<iroha::model::Peer>{
+                peers[2], peers[1], peers[0], peers[3]}),
+            health->syncOrder(peers));
+}
@@ -0,0 +1,108 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include "ordering/impl/batch_pool.hpp"
+
+using namespace iroha::ordering;
+
+proto::TransactionBatch makeBatch(uint64_t first, uint64_t size) {
+  proto::TransactionBatch batch;
+  for (auto i = first; i < first + size; ++i) {
+    batch.add_transactions()->mutable_meta()->set_tx_counter(i);
+  }
+  return batch;
+}
+
+proto::Proposal makeProposal(const std::vector<iroha::hash256_t> &digests) {
+  proto::Proposal proposal;
+  for (const auto &digest : digests) {
+    proposal.add_batch_digests(digest.data(), digest.size());
+  }
+  return proposal;
+}
+
+/**
+ * @given empty pool
+ * @when the same batch is added twice
+ * @then the copy is rejected, and digest matches batch content
+ */
+TEST(BatchPoolTest, CopyOfBatchIsRejected) {
+  BatchPool pool;
+  auto digest = pool.add(makeBatch(0, 2));
+  ASSERT_TRUE(digest);
+  ASSERT_EQ(BatchPool::digestOf(makeBatch(0, 2)), *digest);
+  ASSERT_NE(BatchPool::digestOf(makeBatch(1, 2)), *digest);
+
+  ASSERT_FALSE(pool.add(makeBatch(0, 2)));
+  ASSERT_FALSE(pool.add(proto::TransactionBatch()));
+  ASSERT_EQ(1, pool.size());
+}
+
+/**
+ * @given pool with batches of 2, 3 and 4 transactions
+ * @when pending batches are selected with limit of 5 and 1 transactions
+ * @then batches fitting under the limit are selected in order of arrival,
+ * and at least one batch is always selected
+ */
+TEST(BatchPoolTest, PendingRespectsTransactionLimit) {
+  BatchPool pool;
+  auto first = *pool.add(makeBatch(0, 2));
+  auto second = *pool.add(makeBatch(10, 3));
+  pool.add(makeBatch(20, 4));
+
+  ASSERT_EQ(std::vector<iroha::hash256_t>({first, second}), pool.pending(5));
+  ASSERT_EQ(std::vector<iroha::hash256_t>({first}), pool.pending(1));
+}
+
+/**
+ * @given pool with one batch
+ * @when proposal refers to the batch and to a missing one
+ * @then it is not resolved until the missing batch arrives, then
+ * transactions of both are appended in order of digests
+ */
+TEST(BatchPoolTest, ProposalIsResolvedWhenAllBatchesArrive) {
+  BatchPool pool;
+  auto first = *pool.add(makeBatch(0, 2));
+  auto second = BatchPool::digestOf(makeBatch(10, 1));
+  auto proposal = makeProposal({second, first});
+
+  ASSERT_FALSE(pool.resolve(proposal));
+  ASSERT_EQ(0, proposal.transactions_size());
+
+  pool.add(makeBatch(10, 1));
+  ASSERT_TRUE(pool.resolve(proposal));
+  ASSERT_EQ(3, proposal.transactions_size());
+  ASSERT_EQ(10, proposal.transactions(0).meta().tx_counter());
+  ASSERT_EQ(0, proposal.transactions(1).meta().tx_counter());
+  ASSERT_EQ(0, pool.size());
+  ASSERT_TRUE(pool.pending(10).empty());
+}
+
+/**
+ * @given pool with resolved batch
+ * @when the batch arrives again
+ * @then it is rejected as already proposed
+ */
+TEST(BatchPoolTest, ResolvedBatchIsNotPooledAgain) {
+  BatchPool pool;
+  auto digest = *pool.add(makeBatch(0, 2));
+  auto proposal = makeProposal({digest});
+  ASSERT_TRUE(pool.resolve(proposal));
+
+  ASSERT_FALSE(pool.add(makeBatch(0, 2)));
+}
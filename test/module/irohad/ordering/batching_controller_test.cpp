@@ -0,0 +1,132 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include "ordering/impl/batching_controller.hpp"
+
+using namespace iroha::ordering;
+using namespace std::chrono_literals;
+
+class BatchingControllerTest : public ::testing::Test {
+ public:
+  BatchingController::Clock::time_point start =
+      BatchingController::Clock::now();
+  BatchingController::Bounds bounds{10, 1000, 100ms, 5000ms};
+};
+
+/**
+ * @given controller with fixed bounds
+ * @when load changes
+ * @then proposal size and delay stay fixed
+ */
+TEST_F(BatchingControllerTest, FixedBoundsDisableAdaptation) {
+  BatchingController controller(
+      BatchingController::Bounds::fixed(10, 5000ms), start);
+  controller.transactionsArrived(10000);
+  controller.roundCompleted(200ms);
+  controller.update(500, start + 1s);
+
+  ASSERT_EQ(10, controller.proposalSize());
+  ASSERT_EQ(5000ms, controller.delay());
+}
+
+/**
+ * @given controller before the first round
+ * @when there is no load
+ * @then proposal has the smallest size and the longest delay
+ */
+TEST_F(BatchingControllerTest, IdleUsesLowerSizeAndUpperDelay) {
+  BatchingController controller(bounds, start);
+  controller.update(0, start + 1s);
+
+  ASSERT_EQ(10, controller.proposalSize());
+  ASSERT_EQ(5000ms, controller.delay());
+}
+
+/**
+ * @given controller which observed 200 ms rounds
+ * @when transactions trickle in
+ * @then delay shrinks to round time
+ */
+TEST_F(BatchingControllerTest, LightLoadWaitsOneRound) {
+  BatchingController controller(bounds, start);
+  controller.roundCompleted(200ms);
+  controller.transactionsArrived(1);
+  controller.update(1, start + 1s);
+
+  ASSERT_EQ(10, controller.proposalSize());
+  ASSERT_EQ(200ms, controller.delay());
+}
+
+/**
+ * @given controller which observed 1 s rounds
+ * @when thousands of transactions arrive per second
+ * @then proposal grows to upper bound and is sent without waiting
+ */
+TEST_F(BatchingControllerTest, HeavyLoadGrowsProposal) {
+  BatchingController controller(bounds, start);
+  controller.roundCompleted(1000ms);
+  auto now = start;
+  for (int i = 0; i < 20; ++i) {
+    controller.transactionsArrived(5000);
+    now += 1s;
+    controller.update(2000, now);
+  }
+
+  ASSERT_EQ(1000, controller.proposalSize());
+  ASSERT_EQ(100ms, controller.delay());
+}
+
+/**
+ * @given controller with moderate load
+ * @when backlog is smaller than expected proposal
+ * @then delay is the time to fill the proposal
+ */
+TEST_F(BatchingControllerTest, ModerateLoadWaitsToFillProposal) {
+  BatchingController controller(bounds, start);
+  controller.roundCompleted(2000ms);
+  auto now = start;
+  for (int i = 0; i < 50; ++i) {
+    controller.transactionsArrived(100);
+    now += 1s;
+    controller.update(0, now);
+  }
+
+  // about 100 tx/s during 2 s rounds
+  ASSERT_NEAR(200, controller.proposalSize(), 2);
+  ASSERT_NEAR(2000, controller.delay().count(), 20);
+}
+
+/**
+ * @given controller which has adapted to high load
+ * @when bounds are changed to lower limits, with crossing delay limits
+ * @then size and delay are clamped to the new bounds at once, and lower
+ * delay limit wins
+ */
+TEST_F(BatchingControllerTest, BoundsAreChangedAtRuntime) {
+  BatchingController controller(bounds, start);
+  controller.transactionsArrived(10000);
+  controller.roundCompleted(1000ms);
+  controller.update(500, start + 1s);
+  ASSERT_LT(100, controller.proposalSize());
+
+  controller.setBounds({10, 100, 300ms, 200ms});
+
+  ASSERT_EQ(100, controller.proposalSize());
+  ASSERT_EQ(300ms, controller.delay());
+  ASSERT_EQ(300ms, controller.bounds().max_delay);
+}
@@ -0,0 +1,97 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ordering/impl/mempool_log.hpp"
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstdio>
+#include "ordering/impl/mempool.hpp"
+
+using namespace iroha::ordering;
+using iroha::protocol::Transaction;
+
+class MempoolLogTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    mkdir(path.c_str(), S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH);
+  }
+
+  void TearDown() override {
+    std::remove((path + "/mempool.wal").c_str());
+    rmdir(path.c_str());
+  }
+
+  Transaction makeTx(uint64_t counter) {
+    Transaction tx;
+    tx.mutable_meta()->set_creator_account_id("admin@test");
+    tx.mutable_meta()->set_tx_counter(counter);
+    return tx;
+  }
+
+  std::string path = "/tmp/mempool_log";
+};
+
+/**
+ * @given log with three appended transactions
+ * @when it is reopened and compacted dropping one of them
+ * @then the other two are kept in order, also after reopening again
+ */
+TEST_F(MempoolLogTest, CompactionKeepsOrderOfRestoredTransactions) {
+  {
+    auto log = MempoolLog::create(path);
+    ASSERT_TRUE(log);
+    for (uint64_t i = 0; i < 3; ++i) {
+      ASSERT_TRUE(log->append(MempoolLog::encode(makeTx(i))));
+    }
+  }
+
+  auto log = MempoolLog::create(path);
+  ASSERT_EQ(3, log->size());
+  auto committed = Mempool::hashOf(makeTx(1));
+  auto kept = log->compact([&committed](const MempoolLog::Entry &entry) {
+    return entry.hash != committed;
+  });
+  ASSERT_TRUE(kept);
+  ASSERT_EQ(2, kept->size());
+  ASSERT_EQ(0, kept->at(0).transaction.meta().tx_counter());
+  ASSERT_EQ(2, kept->at(1).transaction.meta().tx_counter());
+
+  ASSERT_TRUE(log->append(MempoolLog::encode(makeTx(3))));
+  log.reset();
+  auto entries = MempoolLog::create(path)->read();
+  ASSERT_EQ(3, entries.size());
+  ASSERT_EQ(3, entries.back().transaction.meta().tx_counter());
+}
+
+/**
+ * @given log whose last record is torn by a crash
+ * @when it is read
+ * @then records before the torn one are returned
+ */
+TEST_F(MempoolLogTest, TornRecordEndsLog) {
+  {
+    auto log = MempoolLog::create(path);
+    ASSERT_TRUE(log->append(MempoolLog::encode(makeTx(0))));
+    auto record = MempoolLog::encode(makeTx(1));
+    record.pop_back();
+    ASSERT_TRUE(log->append(record));
+  }
+  auto entries = MempoolLog::create(path)->read();
+  ASSERT_EQ(1, entries.size());
+  ASSERT_EQ(0, entries.front().transaction.meta().tx_counter());
+}
@@ -0,0 +1,313 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include "ordering/impl/mempool.hpp"
+
+using namespace iroha::ordering;
+using iroha::protocol::Transaction;
+
+Transaction makeTx(const std::string &account, uint64_t counter) {
+  Transaction tx;
+  tx.mutable_meta()->set_creator_account_id(account);
+  tx.mutable_meta()->set_tx_counter(counter);
+  return tx;
+}
+
+std::string popAccount(Mempool &mempool) {
+  Transaction tx;
+  mempool.pop(tx);
+  return tx.meta().creator_account_id();
+}
+
+/**
+ * @given mempool with free room
+ * @when transactions are pushed and popped
+ * @then they are popped in order of arrival
+ */
+TEST(MempoolTest, TransactionsArePoppedInOrder) {
+  Mempool mempool(10, 10);
+  for (uint64_t i = 0; i < 3; ++i) {
+    auto tx = makeTx("admin@test", i);
+    ASSERT_EQ(Mempool::Admission::Accepted, mempool.push(tx));
+  }
+  ASSERT_EQ(3, mempool.size());
+
+  Transaction tx;
+  for (uint64_t i = 0; i < 3; ++i) {
+    ASSERT_TRUE(mempool.pop(tx));
+    ASSERT_EQ(i, tx.meta().tx_counter());
+  }
+  ASSERT_FALSE(mempool.pop(tx));
+  ASSERT_EQ(0, mempool.size());
+}
+
+/**
+ * @given mempool with global capacity of two transactions
+ * @when three transactions of different accounts are pushed
+ * @then the third one is rejected until a transaction is popped
+ */
+TEST(MempoolTest, GlobalCapacityIsEnforced) {
+  Mempool mempool(2, 10);
+  auto a = makeTx("a@test", 0), b = makeTx("b@test", 0),
+       c = makeTx("c@test", 0);
+  ASSERT_EQ(Mempool::Admission::Accepted, mempool.push(a));
+  ASSERT_EQ(Mempool::Admission::Accepted, mempool.push(b));
+  ASSERT_EQ(Mempool::Admission::Full, mempool.push(c));
+  ASSERT_EQ("c@test", c.meta().creator_account_id());
+
+  Transaction tx;
+  ASSERT_TRUE(mempool.pop(tx));
+  ASSERT_EQ(Mempool::Admission::Accepted, mempool.push(c));
+}
+
+/**
+ * @given mempool with account capacity of one transaction
+ * @when account pushes two transactions
+ * @then the second one is rejected, while other accounts are accepted
+ */
+TEST(MempoolTest, AccountCapacityIsEnforced) {
+  Mempool mempool(10, 1);
+  auto first = makeTx("a@test", 0), second = makeTx("a@test", 1),
+       other = makeTx("b@test", 0);
+  ASSERT_EQ(Mempool::Admission::Accepted, mempool.push(first));
+  ASSERT_EQ(Mempool::Admission::Full, mempool.push(second));
+  ASSERT_EQ(Mempool::Admission::Accepted, mempool.push(other));
+
+  Transaction tx;
+  ASSERT_TRUE(mempool.pop(tx));
+  ASSERT_EQ(Mempool::Admission::Accepted, mempool.push(second));
+}
+
+/**
+ * @given mempool with transactions enqueued at different times
+ * @when age of the oldest transaction is requested
+ * @then it is measured from the head of the queue
+ */
+TEST(MempoolTest, OldestAgeIsReported) {
+  Mempool mempool(10, 10);
+  auto start = Mempool::Clock::now();
+  ASSERT_EQ(Mempool::Clock::duration::zero(), mempool.oldestAge(start));
+
+  auto first = makeTx("a@test", 0), second = makeTx("a@test", 1);
+  mempool.push(first, start);
+  mempool.push(second, start + std::chrono::seconds(1));
+
+  auto now = start + std::chrono::seconds(3);
+  ASSERT_EQ(std::chrono::seconds(3), mempool.oldestAge(now));
+  auto report = mempool.report(now);
+  ASSERT_NE(std::string::npos, report.find("iroha_mempool_depth 2\n"));
+  ASSERT_NE(std::string::npos,
+            report.find("iroha_mempool_oldest_age_ms 3000\n"));
+
+  Transaction tx;
+  mempool.pop(tx);
+  ASSERT_EQ(std::chrono::seconds(2), mempool.oldestAge(now));
+}
+
+/**
+ * @given mempool with a queued transaction
+ * @when the same transaction with other signatures is pushed
+ * @then it is dropped as duplicate
+ */
+TEST(MempoolTest, QueuedDuplicateIsDropped) {
+  Mempool mempool(10, 10);
+  auto tx = makeTx("a@test", 0);
+  auto copy = tx;
+  copy.mutable_header()->add_signatures()->set_pubkey("other");
+  ASSERT_EQ(Mempool::hashOf(tx), Mempool::hashOf(copy));
+
+  ASSERT_EQ(Mempool::Admission::Accepted, mempool.push(tx));
+  ASSERT_EQ(Mempool::Admission::Duplicate, mempool.push(copy));
+  ASSERT_EQ(1, mempool.size());
+}
+
+/**
+ * @given mempool with a popped transaction
+ * @when the same transfer created later is pushed
+ * @then it is accepted as a new transaction
+ */
+TEST(MempoolTest, RepeatedTransferIsAccepted) {
+  Mempool mempool(10, 10);
+  auto now = std::chrono::system_clock::time_point(std::chrono::hours(1));
+  auto created = std::chrono::duration_cast<std::chrono::milliseconds>(
+                     now.time_since_epoch())
+                     .count();
+  auto tx = makeTx("a@test", 0);
+  tx.mutable_header()->set_created_time(created);
+  auto repeat = tx;
+  repeat.mutable_header()->set_created_time(created + 1);
+  ASSERT_NE(Mempool::hashOf(tx), Mempool::hashOf(repeat));
+
+  ASSERT_EQ(Mempool::Admission::Accepted,
+            mempool.push(tx, Mempool::Clock::now(), now));
+  Transaction popped;
+  ASSERT_TRUE(mempool.pop(popped));
+  ASSERT_EQ(Mempool::Admission::Accepted,
+            mempool.push(repeat, Mempool::Clock::now(), now));
+  ASSERT_EQ(1, mempool.size());
+}
+
+/**
+ * @given mempool with replay window of one transaction
+ * @when popped transactions are pushed again
+ * @then the most recent one is rejected as replay, the older one is
+ * accepted once it is out of the window
+ */
+TEST(MempoolTest, ReplayWithinWindowIsDropped) {
+  Mempool mempool(10, 10, 1);
+  auto first = makeTx("a@test", 0), second = makeTx("a@test", 1);
+  auto first_copy = first, second_copy = second;
+  mempool.push(first);
+  mempool.push(second);
+
+  Transaction tx;
+  ASSERT_TRUE(mempool.pop(tx));
+  ASSERT_EQ(Mempool::Admission::Duplicate, mempool.push(first_copy));
+  ASSERT_TRUE(mempool.pop(tx));
+
+  ASSERT_EQ(Mempool::Admission::Duplicate, mempool.push(second_copy));
+  ASSERT_EQ(Mempool::Admission::Accepted, mempool.push(first_copy));
+  ASSERT_NE(std::string::npos,
+            mempool.report().find("iroha_mempool_duplicates_total 2\n"));
+}
+
+/**
+ * @given FIFO mempool with bulk transactions of one account queued before
+ * transaction of another account
+ * @when transactions are popped
+ * @then accounts take turns
+ */
+TEST(MempoolTest, AccountsTakeTurns) {
+  Mempool mempool(10, 10);
+  for (uint64_t i = 0; i < 3; ++i) {
+    auto tx = makeTx("bulk@test", i);
+    mempool.push(tx);
+  }
+  auto tx = makeTx("user@test", 0);
+  mempool.push(tx);
+
+  ASSERT_EQ("bulk@test", popAccount(mempool));
+  ASSERT_EQ("user@test", popAccount(mempool));
+  ASSERT_EQ("bulk@test", popAccount(mempool));
+  ASSERT_EQ("bulk@test", popAccount(mempool));
+}
+
+/**
+ * @given priority policy with transfers in class 0 and bulk account in
+ * class 2
+ * @when transactions are classified
+ * @then account class takes precedence over command class
+ */
+TEST(MempoolTest, PriorityPolicyClassifiesTransactions) {
+  PriorityPolicy policy(3, 1);
+  policy.setCommandClass(iroha::protocol::Command::kTransferAsset, 0);
+  policy.setAccountClass("bulk@test", 2);
+
+  auto plain = makeTx("user@test", 0);
+  ASSERT_EQ(1, policy.classify(plain));
+
+  auto transfer = makeTx("user@test", 1);
+  transfer.mutable_body()->add_commands()->mutable_transfer_asset();
+  ASSERT_EQ(0, policy.classify(transfer));
+
+  auto bulk_transfer = makeTx("bulk@test", 0);
+  bulk_transfer.mutable_body()->add_commands()->mutable_transfer_asset();
+  ASSERT_EQ(2, policy.classify(bulk_transfer));
+}
+
+/**
+ * @given mempool with priority policy and bulk transactions queued first
+ * @when transactions are popped
+ * @then transactions of higher class go ahead of earlier bulk ones
+ */
+TEST(MempoolTest, HigherClassIsPoppedFirst) {
+  auto policy = std::make_shared<PriorityPolicy>(2, 1);
+  policy->setAccountClass("settlement@test", 0);
+  Mempool mempool(10, 10, 10, policy);
+  for (uint64_t i = 0; i < 3; ++i) {
+    auto tx = makeTx("bulk@test", i);
+    mempool.push(tx);
+  }
+  auto tx = makeTx("settlement@test", 0);
+  mempool.push(tx);
+
+  ASSERT_NE(std::string::npos,
+            mempool.report().find("iroha_mempool_class_depth{class=\"0\"} 1"));
+  ASSERT_EQ("settlement@test", popAccount(mempool));
+  ASSERT_EQ("bulk@test", popAccount(mempool));
+  ASSERT_EQ(2, mempool.size());
+}
+
+/**
+ * @given mempool with max age of ten seconds
+ * @when transaction created more than max age ago is pushed
+ * @then it is rejected as expired
+ */
+TEST(MempoolTest, StaleTransactionIsRejected) {
+  Mempool mempool(10, 10, 10, nullptr, 10000);
+  auto now = std::chrono::system_clock::time_point(std::chrono::hours(1));
+  auto created = std::chrono::duration_cast<std::chrono::milliseconds>(
+                     now.time_since_epoch())
+                     .count();
+
+  auto stale = makeTx("admin@test", 0);
+  stale.mutable_header()->set_created_time(created - 10000);
+  ASSERT_EQ(Mempool::Admission::Expired,
+            mempool.push(stale, Mempool::Clock::now(), now));
+
+  auto fresh = makeTx("admin@test", 1);
+  fresh.mutable_header()->set_created_time(created);
+  ASSERT_EQ(Mempool::Admission::Accepted,
+            mempool.push(fresh, Mempool::Clock::now(), now));
+  ASSERT_NE(std::string::npos,
+            mempool.report().find("iroha_mempool_expired_total 1"));
+}
+
+/**
+ * @given mempool with queued transactions of different creation time
+ * @when max age of older ones elapses
+ * @then they are expired and the rest is popped in order
+ */
+TEST(MempoolTest, QueuedTransactionsExpire) {
+  Mempool mempool(10, 2, 10, nullptr, 10000);
+  auto now = std::chrono::system_clock::time_point(std::chrono::hours(1));
+  auto created = std::chrono::duration_cast<std::chrono::milliseconds>(
+                     now.time_since_epoch())
+                     .count();
+  auto push = [&](const std::string &account, uint64_t counter, int64_t age) {
+    auto tx = makeTx(account, counter);
+    tx.mutable_header()->set_created_time(created - age);
+    return mempool.push(tx, Mempool::Clock::now(), now);
+  };
+  ASSERT_EQ(Mempool::Admission::Accepted, push("admin@test", 0, 5000));
+  ASSERT_EQ(Mempool::Admission::Accepted, push("admin@test", 1, 0));
+  ASSERT_EQ(Mempool::Admission::Accepted, push("user@test", 0, 5000));
+  ASSERT_EQ(0, mempool.expire(now + std::chrono::seconds(4)));
+
+  ASSERT_EQ(2, mempool.expire(now + std::chrono::seconds(6)));
+  ASSERT_EQ(1, mempool.size());
+  // expired transaction no longer counts against account capacity
+  ASSERT_EQ(Mempool::Admission::Accepted, push("admin@test", 2, 0));
+
+  Transaction tx;
+  ASSERT_TRUE(mempool.pop(tx));
+  ASSERT_EQ(1, tx.meta().tx_counter());
+  ASSERT_TRUE(mempool.pop(tx));
+  ASSERT_EQ(2, tx.meta().tx_counter());
+  ASSERT_FALSE(mempool.pop(tx));
+}
@@ -71,7 +71,7 @@ TEST_F(OrderingGateServiceTest, ProposalsReceivedWhenTimer) {
   start();
 
   auto wrapper = make_test_subscriber<CallExact>(gate_impl->on_proposal(), 2);
-  wrapper.subscribe([this](auto proposal) { proposals.push_back(proposal); });
+  wrapper.subscribe([this](auto proposal) { proposals.push_back(*proposal); });
 
   for (size_t i = 0; i < 10; ++i) {
     auto tx = std::make_shared<Transaction>();
@@ -108,7 +108,7 @@ TEST_F(OrderingGateServiceTest, ProposalsReceivedWhenProposalSize) {
   start();
 
   auto wrapper = make_test_subscriber<CallExact>(gate_impl->on_proposal(), 2);
-  wrapper.subscribe([this](auto proposal) { proposals.push_back(proposal); });
+  wrapper.subscribe([this](auto proposal) { proposals.push_back(*proposal); });
 
   for (size_t i = 0; i < 10; ++i) {
     auto tx = std::make_shared<Transaction>();
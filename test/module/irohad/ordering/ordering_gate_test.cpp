@@ -18,6 +18,7 @@
 #include "module/irohad/ordering/ordering_mocks.hpp"
 
 #include "framework/test_subscriber.hpp"
+#include "ordering/impl/mempool.hpp"
 #include "ordering/impl/ordering_gate_impl.hpp"
 
 using namespace iroha::ordering;
@@ -51,6 +52,37 @@ TEST_F(OrderingGateTest, TransactionReceivedByServerWhenSent) {
   std::this_thread::sleep_for(std::chrono::seconds(1));
 }
 
+/**
+ * @given gate which forwards transactions in batches of three
+ * @when five transactions are propagated
+ * @then full batch is sent at once and the rest after batch delay
+ */
+TEST_F(OrderingGateTest, TransactionsAreSentInBatches) {
+  auto batch_gate = std::make_shared<OrderingGateImpl>(
+      address,
+      std::make_shared<ChannelRegistry>(),
+      3,
+      std::chrono::milliseconds(100));
+  std::vector<int> sizes;
+  std::mutex sizes_mutex;
+  EXPECT_CALL(*fake_service, SendTransaction(_, _, _)).Times(0);
+  EXPECT_CALL(*fake_service, SendBatch(_, _, _))
+      .Times(2)
+      .WillRepeatedly(::testing::Invoke([&](auto, auto request, auto) {
+        std::lock_guard<std::mutex> lock(sizes_mutex);
+        sizes.push_back(request->transactions_size());
+        return grpc::Status::OK;
+      }));
+
+  for (size_t i = 0; i < 5; ++i) {
+    batch_gate->propagate_transaction(std::make_shared<Transaction>());
+  }
+
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+  std::lock_guard<std::mutex> lock(sizes_mutex);
+  ASSERT_EQ(std::vector<int>({3, 2}), sizes);
+}
+
 TEST_F(OrderingGateTest, ProposalReceivedByGateWhenSent) {
   auto wrapper = make_test_subscriber<CallExact>(gate_impl->on_proposal(), 1);
   wrapper.subscribe();
@@ -64,3 +96,162 @@ TEST_F(OrderingGateTest, ProposalReceivedByGateWhenSent) {
 
   ASSERT_TRUE(wrapper.validate());
 }
+
+/**
+ * @given gate in multi-ingest mode
+ * @when proposal refers to batch which arrives after it
+ * @then proposal is delivered with transactions of the batch once the batch
+ * arrives
+ */
+TEST_F(OrderingGateTest, ProposalAwaitsDisseminatedBatches) {
+  auto pool = std::make_shared<BatchPool>();
+  auto multi_gate = std::make_shared<OrderingGateImpl>(
+      address,
+      std::make_shared<ChannelRegistry>(),
+      1,
+      std::chrono::microseconds(0),
+      pool);
+  std::vector<size_t> sizes;
+  multi_gate->on_proposal().subscribe([&sizes](auto proposal) {
+    sizes.push_back(proposal->transactions.size());
+  });
+
+  proto::TransactionBatch batch;
+  for (uint64_t i = 0; i < 3; ++i) {
+    batch.add_transactions()->mutable_meta()->set_tx_counter(i);
+  }
+  auto digest = BatchPool::digestOf(batch);
+  proto::Proposal proposal;
+  proposal.set_height(2);
+  proposal.add_batch_digests(digest.data(), digest.size());
+
+  grpc::ServerContext context;
+  google::protobuf::Empty response;
+  ASSERT_TRUE(multi_gate->SendProposal(&context, &proposal, &response).ok());
+  ASSERT_TRUE(sizes.empty());
+
+  ASSERT_TRUE(multi_gate->DisseminateBatch(&context, &batch, &response).ok());
+  ASSERT_EQ(std::vector<size_t>({3}), sizes);
+  ASSERT_EQ(0, pool->size());
+}
+
+/**
+ * @given gate with failover, whose first leader is not reachable
+ * @when transactions are propagated
+ * @then gate switches to the next leader and resends the transactions to it
+ */
+TEST_F(OrderingGateTest, TransactionsAreResentToNextLeaderOnFailure) {
+  Peer dead, alive;
+  dead.address = "127.0.0.1:50099";
+  alive.address = address;
+  gate_impl->enableFailover(
+      iroha::consensus::yac::ClusterOrdering({dead, alive}),
+      std::chrono::milliseconds(200));
+  std::atomic<int> resent{0};
+  EXPECT_CALL(*fake_service, SendTransaction(_, _, _)).Times(0);
+  EXPECT_CALL(*fake_service, SendBatch(_, _, _))
+      .WillRepeatedly(::testing::Invoke([&](auto, auto request, auto) {
+        resent += request->transactions_size();
+        return grpc::Status::OK;
+      }));
+
+  for (uint64_t i = 0; i < 3; ++i) {
+    auto tx = std::make_shared<Transaction>();
+    tx->tx_counter = i;
+    gate_impl->propagate_transaction(tx);
+  }
+
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+  ASSERT_EQ(address, gate_impl->leader());
+  ASSERT_EQ(3, resent);
+}
+
+/**
+ * @given gate which has propagated one of two transactions of compact
+ * proposal
+ * @when the proposal is received
+ * @then only the other transaction is fetched, and proposal is delivered in
+ * order of hashes
+ */
+TEST_F(OrderingGateTest, CompactProposalIsFilledLocallyAndFetched) {
+  auto own = std::make_shared<Transaction>();
+  own->tx_counter = 1;
+  EXPECT_CALL(*fake_service, SendTransaction(_, _, _))
+      .WillOnce(::testing::Return(grpc::Status::OK));
+  gate_impl->propagate_transaction(own);
+
+  iroha::model::converters::PbTransactionFactory factory;
+  auto own_pb = factory.serialize(*own);
+  iroha::protocol::Transaction other_pb;
+  other_pb.mutable_meta()->set_tx_counter(2);
+  auto other_hash = Mempool::fullHashOf(other_pb).to_string();
+
+  EXPECT_CALL(*fake_service, FetchTransactions(_, _, _))
+      .WillOnce(::testing::Invoke([&](auto, auto request, auto response) {
+        EXPECT_EQ(1, request->hashes_size());
+        EXPECT_EQ(other_hash, request->hashes(0));
+        *response->add_transactions() = other_pb;
+        return grpc::Status::OK;
+      }));
+
+  std::vector<uint64_t> counters;
+  gate_impl->on_proposal().subscribe([&counters](auto proposal) {
+    for (const auto &tx : proposal->transactions) {
+      counters.push_back(tx.tx_counter);
+    }
+  });
+
+  proto::Proposal proposal;
+  proposal.set_height(2);
+  proposal.add_transaction_hashes(other_hash);
+  proposal.add_transaction_hashes(Mempool::fullHashOf(own_pb).to_string());
+
+  grpc::ServerContext context;
+  google::protobuf::Empty response;
+  ASSERT_TRUE(gate_impl->SendProposal(&context, &proposal, &response).ok());
+  ASSERT_EQ(std::vector<uint64_t>({2, 1}), counters);
+}
+
+/**
+ * @given gate which has propagated a transaction
+ * @when compact proposal carries copy of the transaction with another
+ * creation time in header
+ * @then copy of the leader is fetched and delivered instead of own copy
+ */
+TEST_F(OrderingGateTest, CompactProposalTakesCopyOfLeader) {
+  auto own = std::make_shared<Transaction>();
+  own->tx_counter = 1;
+  own->created_ts = 100;
+  EXPECT_CALL(*fake_service, SendTransaction(_, _, _))
+      .WillOnce(::testing::Return(grpc::Status::OK));
+  gate_impl->propagate_transaction(own);
+
+  iroha::model::converters::PbTransactionFactory factory;
+  auto leader_pb = factory.serialize(*own);
+  leader_pb.mutable_header()->set_created_time(200);
+  auto leader_hash = Mempool::fullHashOf(leader_pb).to_string();
+
+  EXPECT_CALL(*fake_service, FetchTransactions(_, _, _))
+      .WillOnce(::testing::Invoke([&](auto, auto request, auto response) {
+        EXPECT_EQ(1, request->hashes_size());
+        EXPECT_EQ(leader_hash, request->hashes(0));
+        *response->add_transactions() = leader_pb;
+        return grpc::Status::OK;
+      }));
+
+  std::vector<uint64_t> created;
+  gate_impl->on_proposal().subscribe([&created](auto proposal) {
+    for (const auto &tx : proposal->transactions) {
+      created.push_back(tx.created_ts);
+    }
+  });
+
+  proto::Proposal proposal;
+  proposal.set_height(2);
+  proposal.add_transaction_hashes(leader_hash);
+
+  grpc::ServerContext context;
+  google::protobuf::Empty response;
+  ASSERT_TRUE(gate_impl->SendProposal(&context, &proposal, &response).ok());
+  ASSERT_EQ(std::vector<uint64_t>({200}), created);
+}
@@ -58,6 +58,19 @@ class OrderingServiceTest : public OrderingTest {
   std::thread loop_thread;
   ordering::MockOrderingGate *fake_gate;
   std::unique_ptr<iroha::ordering::proto::OrderingService::Stub> client;
+
+  /**
+   * @return the same transfer, created at distinct time for each counter
+   * value, so it is repeated rather than replayed
+   */
+  static iroha::protocol::Transaction makeTx(uint64_t counter) {
+    auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::system_clock::now().time_since_epoch())
+                   .count();
+    iroha::protocol::Transaction tx;
+    tx.mutable_header()->set_created_time(now + counter);
+    return tx;
+  }
 };
 
 TEST_F(OrderingServiceTest, ValidWhenProposalSizeStrategy) {
@@ -78,7 +91,7 @@ TEST_F(OrderingServiceTest, ValidWhenProposalSizeStrategy) {
 
     google::protobuf::Empty reply;
 
-    client->SendTransaction(&context, iroha::protocol::Transaction(), &reply);
+    client->SendTransaction(&context, makeTx(i), &reply);
   }
 
   std::this_thread::sleep_for(std::chrono::seconds(1));
@@ -102,10 +115,152 @@ TEST_F(OrderingServiceTest, ValidWhenTimerStrategy) {
 
     google::protobuf::Empty reply;
 
-    client->SendTransaction(&context, iroha::protocol::Transaction(), &reply);
+    client->SendTransaction(&context, makeTx(i), &reply);
 
     std::this_thread::sleep_for(std::chrono::milliseconds(50));
   }
 
   std::this_thread::sleep_for(std::chrono::seconds(1));
 }
+
+/**
+ * @given ordering service with proposal size 5
+ * @when ten transactions arrive in one batch
+ * @then two proposals are sent
+ */
+TEST_F(OrderingServiceTest, ValidWhenTransactionsComeInBatch) {
+  std::shared_ptr<MockPeerQuery> wsv = std::make_shared<MockPeerQuery>();
+  EXPECT_CALL(*wsv, getLedgerPeers()).WillRepeatedly(Return(std::vector<Peer>{
+      peer}));
+
+  service = std::make_shared<OrderingServiceImpl>(wsv, 5, 1000, loop);
+
+  EXPECT_CALL(*fake_gate, SendProposal(_, _, _)).Times(2);
+
+  start();
+
+  proto::TransactionBatch batch;
+  for (size_t i = 0; i < 10; ++i) {
+    *batch.add_transactions() = makeTx(i);
+  }
+  grpc::ClientContext context;
+  google::protobuf::Empty reply;
+  client->SendBatch(&context, batch, &reply);
+
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+}
+
+/**
+ * @given ordering service with proposal size 5
+ * @when the same transaction arrives ten times
+ * @then copies are dropped and no proposal is filled by them
+ */
+TEST_F(OrderingServiceTest, DuplicatesAreDropped) {
+  std::shared_ptr<MockPeerQuery> wsv = std::make_shared<MockPeerQuery>();
+  EXPECT_CALL(*wsv, getLedgerPeers()).WillRepeatedly(Return(std::vector<Peer>{
+      peer}));
+
+  service = std::make_shared<OrderingServiceImpl>(wsv, 5, 10000, loop);
+
+  EXPECT_CALL(*fake_gate, SendProposal(_, _, _)).Times(0);
+
+  start();
+
+  auto tx = makeTx(0);
+  for (size_t i = 0; i < 10; ++i) {
+    grpc::ClientContext context;
+    google::protobuf::Empty reply;
+    ASSERT_TRUE(client->SendTransaction(&context, tx, &reply).ok());
+  }
+
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+}
+
+/**
+ * @given ordering service in multi-ingest mode, leading every height in
+ * one-peer ledger
+ * @when proposal worth of transactions arrives
+ * @then they are sealed into pooled batch, and proposal refers to it by
+ * digest
+ */
+TEST_F(OrderingServiceTest, MultiIngestProposesBatchDigests) {
+  std::shared_ptr<MockPeerQuery> wsv = std::make_shared<MockPeerQuery>();
+  EXPECT_CALL(*wsv, getLedgerPeers()).WillRepeatedly(Return(std::vector<Peer>{
+      peer}));
+
+  auto pool = std::make_shared<BatchPool>();
+  auto multi_service =
+      std::make_shared<OrderingServiceImpl>(wsv, 5, 1000, loop);
+  multi_service->enableMultiIngest(pool, address);
+  service = multi_service;
+
+  // own gate is not called, the batch is pooled directly
+  EXPECT_CALL(*fake_gate, DisseminateBatch(_, _, _)).Times(0);
+  EXPECT_CALL(*fake_gate, SendProposal(_, _, _))
+      .WillOnce(::testing::Invoke([](auto, auto request, auto) {
+        EXPECT_EQ(2, request->height());
+        EXPECT_EQ(0, request->transactions_size());
+        EXPECT_EQ(1, request->batch_digests_size());
+        return grpc::Status::OK;
+      }));
+
+  start();
+
+  for (size_t i = 0; i < 5; ++i) {
+    grpc::ClientContext context;
+    google::protobuf::Empty reply;
+    client->SendTransaction(&context, makeTx(i), &reply);
+  }
+
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+  ASSERT_EQ(1, pool->size());
+}
+
+/**
+ * @given ordering service with compact proposals
+ * @when proposal worth of transactions arrives
+ * @then proposal carries their hashes only, and bodies are fetched by hash
+ */
+TEST_F(OrderingServiceTest, CompactProposalBodiesAreFetched) {
+  std::shared_ptr<MockPeerQuery> wsv = std::make_shared<MockPeerQuery>();
+  EXPECT_CALL(*wsv, getLedgerPeers()).WillRepeatedly(Return(std::vector<Peer>{
+      peer}));
+
+  auto compact_service =
+      std::make_shared<OrderingServiceImpl>(wsv, 5, 1000, loop);
+  compact_service->enableCompactProposals();
+  service = compact_service;
+
+  proto::TransactionHashes hashes;
+  std::mutex hashes_mutex;
+  EXPECT_CALL(*fake_gate, SendProposal(_, _, _))
+      .WillOnce(::testing::Invoke([&](auto, auto request, auto) {
+        EXPECT_EQ(0, request->transactions_size());
+        std::lock_guard<std::mutex> lock(hashes_mutex);
+        for (const auto &hash : request->transaction_hashes()) {
+          hashes.add_hashes(hash);
+        }
+        return grpc::Status::OK;
+      }));
+
+  start();
+
+  for (size_t i = 0; i < 5; ++i) {
+    grpc::ClientContext context;
+    google::protobuf::Empty reply;
+    client->SendTransaction(&context, makeTx(i), &reply);
+  }
+
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+  std::lock_guard<std::mutex> lock(hashes_mutex);
+  ASSERT_EQ(5, hashes.hashes_size());
+  hashes.add_hashes("unknown");
+
+  grpc::ClientContext context;
+  proto::TransactionBatch fetched;
+  ASSERT_TRUE(client->FetchTransactions(&context, hashes, &fetched).ok());
+  ASSERT_EQ(5, fetched.transactions_size());
+  for (size_t i = 0; i < 5; ++i) {
+    EXPECT_EQ(i, fetched.transactions(i).meta().tx_counter());
+  }
+}
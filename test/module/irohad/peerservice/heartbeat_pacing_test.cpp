@@ -0,0 +1,91 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include "peer_service/heartbeat_pacing.hpp"
+
+using peerservice::HeartbeatPacing;
+
+/**
+ * @given pacing of peer which has not answered yet
+ * @when peer answers with height below ours, then at our height
+ * @then root is sent until peer confirms our height, and again once our
+ * height grows
+ */
+TEST(HeartbeatPacingTest, RootIsOmittedOnceHeightIsConfirmed) {
+  HeartbeatPacing pacing;
+  ASSERT_TRUE(pacing.needsRoot(5));
+
+  pacing.onAnswer(5, 4);
+  ASSERT_TRUE(pacing.needsRoot(5));
+
+  pacing.onAnswer(5, 5);
+  ASSERT_FALSE(pacing.needsRoot(5));
+  ASSERT_TRUE(pacing.needsRoot(6));
+
+  // peer ahead of us confirms our height as well
+  pacing.onAnswer(6, 9);
+  ASSERT_FALSE(pacing.needsRoot(6));
+}
+
+/**
+ * @given pacing of peer which answers with the same height
+ * @when answers keep coming
+ * @then interval doubles with each of them up to the limit
+ */
+TEST(HeartbeatPacingTest, StableAnswersStretchInterval) {
+  HeartbeatPacing pacing;
+  ASSERT_EQ(1u, pacing.stretch());
+
+  pacing.onAnswer(1, 3);
+  ASSERT_EQ(1u, pacing.stretch());
+  for (uint32_t i = 1; i <= HeartbeatPacing::kMaxStretch; ++i) {
+    pacing.onAnswer(1, 3);
+    ASSERT_EQ(1u << i, pacing.stretch());
+  }
+  pacing.onAnswer(1, 3);
+  ASSERT_EQ(1u << HeartbeatPacing::kMaxStretch, pacing.stretch());
+}
+
+/**
+ * @given pacing with stretched interval and confirmed height
+ * @when peer changes its height, or stops answering
+ * @then interval falls back to the short one, and after reset root is
+ * sent again
+ */
+TEST(HeartbeatPacingTest, ChangeOrResetFallsBackToShortInterval) {
+  HeartbeatPacing pacing;
+  pacing.onAnswer(2, 2);
+  pacing.onAnswer(2, 2);
+  pacing.onAnswer(2, 2);
+  ASSERT_EQ(4u, pacing.stretch());
+
+  pacing.onAnswer(2, 3);
+  ASSERT_EQ(1u, pacing.stretch());
+  ASSERT_FALSE(pacing.needsRoot(2));
+
+  pacing.onAnswer(2, 3);
+  ASSERT_EQ(2u, pacing.stretch());
+
+  pacing.reset();
+  ASSERT_EQ(1u, pacing.stretch());
+  ASSERT_TRUE(pacing.needsRoot(2));
+
+  // first answer after reset starts counting anew
+  pacing.onAnswer(2, 3);
+  ASSERT_EQ(1u, pacing.stretch());
+}
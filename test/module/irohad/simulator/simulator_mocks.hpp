@@ -25,8 +25,10 @@ namespace iroha {
   namespace simulator {
     class MockBlockCreator : public BlockCreator {
      public:
-      MOCK_METHOD1(process_verified_proposal, void(model::Proposal));
-      MOCK_METHOD0(on_block, rxcpp::observable<model::Block>());
+      MOCK_METHOD1(process_verified_proposal,
+                   void(std::shared_ptr<const model::Proposal>));
+      MOCK_METHOD0(on_block,
+                   rxcpp::observable<std::shared_ptr<const model::Block>>());
     };
   }  // namespace simulator
 }  // namespace iroha
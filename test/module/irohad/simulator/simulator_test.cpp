@@ -60,7 +60,8 @@ class SimulatorTest : public ::testing::Test {
 TEST_F(SimulatorTest, ValidWhenInitialized) {
   // simulator constructor => on_proposal subscription called
   EXPECT_CALL(*ordering_gate, on_proposal())
-      .WillOnce(Return(rxcpp::observable<>::empty<Proposal>()));
+      .WillOnce(Return(
+          rxcpp::observable<>::empty<std::shared_ptr<const Proposal>>()));
 
   init();
 }
@@ -82,24 +83,25 @@ TEST_F(SimulatorTest, ValidWhenPreviousBlock) {
   EXPECT_CALL(*validator, validate(_, _)).WillOnce(Return(proposal));
 
   EXPECT_CALL(*ordering_gate, on_proposal())
-      .WillOnce(Return(rxcpp::observable<>::empty<Proposal>()));
+      .WillOnce(Return(
+          rxcpp::observable<>::empty<std::shared_ptr<const Proposal>>()));
 
   init();
 
   auto proposal_wrapper =
       make_test_subscriber<CallExact>(simulator->on_verified_proposal(), 1);
   proposal_wrapper.subscribe([&proposal](auto verified_proposal) {
-    ASSERT_EQ(verified_proposal.height, proposal.height);
-    ASSERT_EQ(verified_proposal.transactions, proposal.transactions);
+    ASSERT_EQ(verified_proposal->height, proposal.height);
+    ASSERT_EQ(verified_proposal->transactions, proposal.transactions);
   });
 
   auto block_wrapper = make_test_subscriber<CallExact>(simulator->on_block(), 1);
   block_wrapper.subscribe([&proposal](auto block) {
-    ASSERT_EQ(block.height, proposal.height);
-    ASSERT_EQ(block.transactions, proposal.transactions);
+    ASSERT_EQ(block->height, proposal.height);
+    ASSERT_EQ(block->transactions, proposal.transactions);
   });
 
-  simulator->process_proposal(proposal);
+  simulator->process_proposal(std::make_shared<Proposal>(proposal));
 
   ASSERT_TRUE(proposal_wrapper.validate());
   ASSERT_TRUE(block_wrapper.validate());
@@ -119,7 +121,8 @@ TEST_F(SimulatorTest, FailWhenNoBlock) {
   EXPECT_CALL(*validator, validate(_, _)).Times(0);
 
   EXPECT_CALL(*ordering_gate, on_proposal())
-      .WillOnce(Return(rxcpp::observable<>::empty<Proposal>()));
+      .WillOnce(Return(
+          rxcpp::observable<>::empty<std::shared_ptr<const Proposal>>()));
 
   init();
 
@@ -130,7 +133,7 @@ TEST_F(SimulatorTest, FailWhenNoBlock) {
   auto block_wrapper = make_test_subscriber<CallExact>(simulator->on_block(), 0);
   block_wrapper.subscribe();
 
-  simulator->process_proposal(proposal);
+  simulator->process_proposal(std::make_shared<Proposal>(proposal));
 
   ASSERT_TRUE(proposal_wrapper.validate());
   ASSERT_TRUE(block_wrapper.validate());
@@ -153,7 +156,8 @@ TEST_F(SimulatorTest, FailWhenSameAsProposalHeight) {
   EXPECT_CALL(*validator, validate(_, _)).Times(0);
 
   EXPECT_CALL(*ordering_gate, on_proposal())
-      .WillOnce(Return(rxcpp::observable<>::empty<Proposal>()));
+      .WillOnce(Return(
+          rxcpp::observable<>::empty<std::shared_ptr<const Proposal>>()));
 
   init();
 
@@ -164,8 +168,102 @@ TEST_F(SimulatorTest, FailWhenSameAsProposalHeight) {
   auto block_wrapper = make_test_subscriber<CallExact>(simulator->on_block(), 0);
   block_wrapper.subscribe();
 
-  simulator->process_proposal(proposal);
+  simulator->process_proposal(std::make_shared<Proposal>(proposal));
 
   ASSERT_TRUE(proposal_wrapper.validate());
   ASSERT_TRUE(block_wrapper.validate());
 }
+
+/**
+ * @given block 2 created by simulator and not committed yet
+ * @when proposal with height 3 arrives
+ * @then it is validated on top of pending block 2
+ */
+TEST_F(SimulatorTest, ValidateOnTopOfPendingBlock) {
+  auto txs = std::vector<model::Transaction>(2);
+  auto proposal = model::Proposal(txs);
+  proposal.height = 2;
+  auto next_proposal = model::Proposal(txs);
+  next_proposal.height = 3;
+
+  model::Block block;
+  block.height = 1;
+  block.hash.fill(1);
+
+  auto wsv = std::make_unique<MockTemporaryWsv>();
+  EXPECT_CALL(*wsv, apply(_, _)).Times(2).WillRepeatedly(Return(true));
+  EXPECT_CALL(*factory, createTemporaryWsv())
+      .WillOnce(Return(::testing::ByMove(nullptr)))
+      .WillOnce(Return(::testing::ByMove(std::move(wsv))));
+
+  EXPECT_CALL(*query, getBlocks(1, 2))
+      .Times(2)
+      .WillRepeatedly(Return(rxcpp::observable<>::just(block)));
+  EXPECT_CALL(*query, getBlocks(2, 3))
+      .WillOnce(Return(rxcpp::observable<>::empty<model::Block>()));
+
+  EXPECT_CALL(*validator, validate(_, _))
+      .WillOnce(Return(proposal))
+      .WillOnce(Return(next_proposal));
+
+  EXPECT_CALL(*ordering_gate, on_proposal())
+      .WillOnce(Return(
+          rxcpp::observable<>::empty<std::shared_ptr<const Proposal>>()));
+
+  init();
+
+  std::vector<model::Block> blocks;
+  auto block_wrapper = make_test_subscriber<CallExact>(simulator->on_block(), 2);
+  block_wrapper.subscribe([&blocks](auto block) { blocks.push_back(*block); });
+
+  simulator->process_proposal(std::make_shared<Proposal>(proposal));
+  simulator->process_proposal(std::make_shared<Proposal>(next_proposal));
+
+  ASSERT_TRUE(block_wrapper.validate());
+  ASSERT_EQ(block.hash, blocks.at(0).prev_hash);
+  ASSERT_EQ(3, blocks.at(1).height);
+  ASSERT_EQ(blocks.at(0).hash, blocks.at(1).prev_hash);
+}
+
+/**
+ * @given pending block 2 which does not extend ledger top
+ * @when proposal with height 3 arrives
+ * @then speculation is abandoned and proposal is skipped
+ */
+TEST_F(SimulatorTest, DropPendingBlockOfFailedRound) {
+  auto txs = std::vector<model::Transaction>(2);
+  auto proposal = model::Proposal(txs);
+  proposal.height = 2;
+  auto next_proposal = model::Proposal(txs);
+  next_proposal.height = 3;
+
+  model::Block block;
+  block.height = 1;
+  block.hash.fill(1);
+  model::Block other_block = block;
+  other_block.hash.fill(2);
+
+  EXPECT_CALL(*factory, createTemporaryWsv()).Times(1);
+
+  EXPECT_CALL(*query, getBlocks(1, 2))
+      .WillOnce(Return(rxcpp::observable<>::just(block)))
+      .WillOnce(Return(rxcpp::observable<>::just(other_block)));
+  EXPECT_CALL(*query, getBlocks(2, 3))
+      .WillOnce(Return(rxcpp::observable<>::empty<model::Block>()));
+
+  EXPECT_CALL(*validator, validate(_, _)).WillOnce(Return(proposal));
+
+  EXPECT_CALL(*ordering_gate, on_proposal())
+      .WillOnce(Return(
+          rxcpp::observable<>::empty<std::shared_ptr<const Proposal>>()));
+
+  init();
+
+  auto block_wrapper = make_test_subscriber<CallExact>(simulator->on_block(), 1);
+  block_wrapper.subscribe();
+
+  simulator->process_proposal(std::make_shared<Proposal>(proposal));
+  simulator->process_proposal(std::make_shared<Proposal>(next_proposal));
+
+  ASSERT_TRUE(block_wrapper.validate());
+}
@@ -60,7 +60,8 @@ class SynchronizerTest : public ::testing::Test {
 TEST_F(SynchronizerTest, ValidWhenInitialized) {
   // synchronizer constructor => on_commit subscription called
   EXPECT_CALL(*consensus_gate, on_commit())
-      .WillOnce(Return(rxcpp::observable<>::empty<Block>()));
+      .WillOnce(Return(
+          rxcpp::observable<>::empty<std::shared_ptr<const Block>>()));
 
   init();
 }
@@ -79,10 +80,11 @@ TEST_F(SynchronizerTest, ValidWhenSingleCommitSynchronized) {
   EXPECT_CALL(*chain_validator, validateBlock(test_block, _))
       .WillOnce(Return(true));
 
-  EXPECT_CALL(*block_loader, requestBlocks(_, _)).Times(0);
+  EXPECT_CALL(*block_loader, retrieveChain(_, _)).Times(0);
 
   EXPECT_CALL(*consensus_gate, on_commit())
-      .WillOnce(Return(rxcpp::observable<>::empty<Block>()));
+      .WillOnce(Return(
+          rxcpp::observable<>::empty<std::shared_ptr<const Block>>()));
 
   init();
 
@@ -92,12 +94,12 @@ TEST_F(SynchronizerTest, ValidWhenSingleCommitSynchronized) {
     auto block_wrapper = make_test_subscriber<CallExact>(commit, 1);
     block_wrapper.subscribe([&test_block](auto block) {
       // Check commit block
-      ASSERT_EQ(block.height, test_block.height);
+      ASSERT_EQ(block->height, test_block.height);
     });
     ASSERT_TRUE(block_wrapper.validate());
   });
 
-  synchronizer->process_commit(test_block);
+  synchronizer->process_commit(std::make_shared<const Block>(test_block));
 
   ASSERT_TRUE(wrapper.validate());
 }
@@ -113,10 +115,11 @@ TEST_F(SynchronizerTest, ValidWhenBadStorage) {
 
   EXPECT_CALL(*chain_validator, validateBlock(test_block, _)).Times(0);
 
-  EXPECT_CALL(*block_loader, requestBlocks(_, _)).Times(0);
+  EXPECT_CALL(*block_loader, retrieveChain(_, _)).Times(0);
 
   EXPECT_CALL(*consensus_gate, on_commit())
-      .WillOnce(Return(rxcpp::observable<>::empty<Block>()));
+      .WillOnce(Return(
+          rxcpp::observable<>::empty<std::shared_ptr<const Block>>()));
 
   init();
 
@@ -124,7 +127,7 @@ TEST_F(SynchronizerTest, ValidWhenBadStorage) {
       make_test_subscriber<CallExact>(synchronizer->on_commit_chain(), 0);
   wrapper.subscribe();
 
-  synchronizer->process_commit(test_block);
+  synchronizer->process_commit(std::make_shared<const Block>(test_block));
 
   ASSERT_TRUE(wrapper.validate());
 }
@@ -145,11 +148,12 @@ TEST_F(SynchronizerTest, ValidWhenBlockValidationFailure) {
       .WillOnce(Return(false));
   EXPECT_CALL(*chain_validator, validateChain(_, _)).WillOnce(Return(true));
 
-  EXPECT_CALL(*block_loader, requestBlocks(_, _))
+  EXPECT_CALL(*block_loader, retrieveChain(_, test_block.height))
       .WillOnce(Return(rxcpp::observable<>::just(test_block)));
 
   EXPECT_CALL(*consensus_gate, on_commit())
-      .WillOnce(Return(rxcpp::observable<>::empty<Block>()));
+      .WillOnce(Return(
+          rxcpp::observable<>::empty<std::shared_ptr<const Block>>()));
 
   init();
 
@@ -159,12 +163,112 @@ TEST_F(SynchronizerTest, ValidWhenBlockValidationFailure) {
     auto block_wrapper = make_test_subscriber<CallExact>(commit, 1);
     block_wrapper.subscribe([&test_block](auto block) {
       // Check commit block
-      ASSERT_EQ(block.height, test_block.height);
+      ASSERT_EQ(block->height, test_block.height);
     });
     ASSERT_TRUE(block_wrapper.validate());
   });
 
-  synchronizer->process_commit(test_block);
+  synchronizer->process_commit(std::make_shared<const Block>(test_block));
+
+  ASSERT_TRUE(wrapper.validate());
+}
+
+/**
+ * @given commit which can not be applied, and missing chain longer than
+ * commit batch
+ * @when chain is downloaded
+ * @then it is validated and committed in two batches
+ */
+TEST_F(SynchronizerTest, LongChainIsCommittedInBatches) {
+  std::vector<Block> chain(SynchronizerImpl::kCommitBatch + 1);
+  for (size_t i = 0; i < chain.size(); ++i) {
+    chain[i].height = i + 2;
+    chain[i].sigs.emplace_back();
+  }
+  auto &test_block = chain.back();
+
+  DefaultValue<std::unique_ptr<MutableStorage>>::SetFactory(
+      &createMockMutableStorage);
+  EXPECT_CALL(*mutable_factory, createMutableStorage()).Times(3);
+
+  EXPECT_CALL(*mutable_factory, commit_(_)).Times(2);
+
+  EXPECT_CALL(*chain_validator, validateBlock(test_block, _))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*chain_validator, validateChain(_, _))
+      .Times(2)
+      .WillRepeatedly(Return(true));
+
+  EXPECT_CALL(*block_loader, retrieveChain(_, test_block.height))
+      .WillOnce(Return(rxcpp::observable<>::iterate(chain)));
+
+  EXPECT_CALL(*consensus_gate, on_commit())
+      .WillOnce(Return(
+          rxcpp::observable<>::empty<std::shared_ptr<const Block>>()));
+
+  init();
+
+  auto wrapper =
+      make_test_subscriber<CallExact>(synchronizer->on_commit_chain(), 2);
+  wrapper.subscribe();
+
+  synchronizer->process_commit(std::make_shared<const Block>(test_block));
+
+  ASSERT_TRUE(wrapper.validate());
+}
+
+/**
+ * @given commit four blocks ahead of local top, and commit batch of two
+ * blocks
+ * @when missing chain is downloaded
+ * @then it is requested and committed one batch at a time
+ */
+TEST_F(SynchronizerTest, ChainIsDownloadedInBatchesFromLocalTop) {
+  std::vector<Block> chain(4);
+  for (size_t i = 0; i < chain.size(); ++i) {
+    chain[i].height = i + 2;
+    chain[i].sigs.emplace_back();
+  }
+  auto &test_block = chain.back();
+  auto block_query = std::make_shared<MockBlockQuery>();
+
+  DefaultValue<std::unique_ptr<MutableStorage>>::SetFactory(
+      &createMockMutableStorage);
+  EXPECT_CALL(*mutable_factory, createMutableStorage()).Times(3);
+  EXPECT_CALL(*mutable_factory, commit_(_)).Times(2);
+
+  EXPECT_CALL(*chain_validator, validateBlock(test_block, _))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*chain_validator, validateChain(_, _))
+      .Times(2)
+      .WillRepeatedly(Return(true));
+
+  EXPECT_CALL(*block_query, getTopBlockHeight())
+      .WillOnce(Return(1))
+      .WillOnce(Return(3));
+  EXPECT_CALL(*block_loader, retrieveChain(_, 3))
+      .WillOnce(Return(rxcpp::observable<>::iterate(
+          std::vector<Block>(chain.begin(), chain.begin() + 2))));
+  EXPECT_CALL(*block_loader, retrieveChain(_, 5))
+      .WillOnce(Return(rxcpp::observable<>::iterate(
+          std::vector<Block>(chain.begin() + 2, chain.end()))));
+
+  EXPECT_CALL(*consensus_gate, on_commit())
+      .WillOnce(Return(
+          rxcpp::observable<>::empty<std::shared_ptr<const Block>>()));
+
+  synchronizer = std::make_shared<SynchronizerImpl>(consensus_gate,
+                                                    chain_validator,
+                                                    mutable_factory,
+                                                    block_loader,
+                                                    block_query,
+                                                    2);
+
+  auto wrapper =
+      make_test_subscriber<CallExact>(synchronizer->on_commit_chain(), 2);
+  wrapper.subscribe();
+
+  synchronizer->process_commit(std::make_shared<const Block>(test_block));
 
   ASSERT_TRUE(wrapper.validate());
 }
@@ -0,0 +1,56 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include "torii/admission_control.hpp"
+
+using torii::AdmissionControl;
+
+/**
+ * @given admission control with burst of two requests
+ * @when client sends three requests at once and one more a second later
+ * @then the third one is over quota, and quota is refilled with time
+ */
+TEST(AdmissionControlTest, RequestsOverQuotaAreRejected) {
+  AdmissionControl admission(1, 2);
+  auto now = AdmissionControl::Clock::now();
+  ASSERT_TRUE(admission.admit("alice", 1, now));
+  ASSERT_TRUE(admission.admit("alice", 1, now));
+  ASSERT_FALSE(admission.admit("alice", 1, now));
+  // quotas are separate
+  ASSERT_TRUE(admission.admit("bob", 1, now));
+  ASSERT_TRUE(admission.admit("alice", 1, now + std::chrono::seconds(1)));
+}
+
+/**
+ * @given admission control with long downstream queue
+ * @when heavy and light clients send requests
+ * @then the heavy one is shed while light one is admitted
+ */
+TEST(AdmissionControlTest, HeavyClientsAreShedFirst) {
+  size_t depth = 0;
+  AdmissionControl admission(1, 10, [&depth] { return depth; }, 100);
+  auto now = AdmissionControl::Clock::now();
+  for (int i = 0; i < 6; ++i) {
+    ASSERT_TRUE(admission.admit("heavy", 1, now));
+  }
+  depth = 100;
+  ASSERT_FALSE(admission.admit("heavy", 1, now));
+  ASSERT_TRUE(admission.admit("light", 1, now));
+  depth = 0;
+  ASSERT_TRUE(admission.admit("heavy", 1, now));
+}
@@ -91,3 +91,35 @@ TEST_F(TransactionProcessorTest,
 
   ASSERT_TRUE(wrapper.validate());
 }
+
+/**
+ * @given transaction processor with validation stage of several workers
+ * @when many transactions are handled
+ * @then every transaction is propagated and notified once
+ */
+TEST_F(TransactionProcessorTest, ValidationStageNotifiesEveryTransaction) {
+  constexpr size_t kTransactions = 100;
+  tp = std::make_shared<TransactionProcessorImpl>(pcs, validation, 4);
+
+  EXPECT_CALL(*pcs, propagate_transaction(_)).Times(kTransactions);
+  EXPECT_CALL(*validation, validate(A<const Transaction &>()))
+      .WillRepeatedly(Return(true));
+
+  std::mutex mutex;
+  std::condition_variable notified;
+  size_t passed = 0;
+  tp->transactionNotifier().subscribe([&](auto response) {
+    std::lock_guard<std::mutex> lock(mutex);
+    passed +=
+        static_cast<TransactionStatelessResponse &>(*response).passed;
+    notified.notify_one();
+  });
+  for (size_t i = 0; i < kTransactions; ++i) {
+    tp->transactionHandle(std::make_shared<Transaction>());
+  }
+
+  std::unique_lock<std::mutex> lock(mutex);
+  ASSERT_TRUE(notified.wait_for(lock, std::chrono::seconds(5), [&] {
+    return passed == kTransactions;
+  }));
+}
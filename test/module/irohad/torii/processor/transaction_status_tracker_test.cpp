@@ -0,0 +1,131 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "module/irohad/network/network_mocks.hpp"
+#include "module/irohad/validation/validation_mocks.hpp"
+
+#include "torii/processor/transaction_processor_impl.hpp"
+#include "torii/processor/transaction_status_tracker.hpp"
+
+using namespace iroha;
+using namespace iroha::network;
+using namespace iroha::validation;
+using namespace iroha::torii;
+using namespace iroha::model;
+
+using ::testing::Return;
+using ::testing::_;
+using ::testing::A;
+
+class MockVerifiedProposalCreator : public simulator::VerifiedProposalCreator {
+ public:
+  MOCK_METHOD1(process_proposal, void(std::shared_ptr<const model::Proposal>));
+  MOCK_METHOD0(on_verified_proposal,
+               rxcpp::observable<std::shared_ptr<const model::Proposal>>());
+};
+
+class TransactionStatusTrackerTest : public ::testing::Test {
+ public:
+  using Status = TransactionStatusTracker::Status;
+
+  void SetUp() override {
+    pcs = std::make_shared<MockPeerCommunicationService>();
+    validation = std::make_shared<MockStatelessValidator>();
+    verified = std::make_shared<MockVerifiedProposalCreator>();
+    EXPECT_CALL(*pcs, on_proposal())
+        .WillRepeatedly(Return(proposals.get_observable()));
+    EXPECT_CALL(*pcs, on_commit())
+        .WillRepeatedly(Return(commits.get_observable()));
+    EXPECT_CALL(*verified, on_verified_proposal())
+        .WillRepeatedly(Return(verified_proposals.get_observable()));
+    tp = std::make_shared<TransactionProcessorImpl>(pcs, validation);
+    tracker = std::make_shared<TransactionStatusTracker>(tp, pcs, verified);
+  }
+
+  /**
+   * @return distinct transaction with its hash set
+   */
+  static Transaction makeTx(uint64_t counter) {
+    Transaction tx;
+    tx.tx_counter = counter;
+    tx.tx_hash = HashProviderImpl().get_hash(tx);
+    return tx;
+  }
+
+  std::shared_ptr<MockPeerCommunicationService> pcs;
+  std::shared_ptr<MockStatelessValidator> validation;
+  std::shared_ptr<MockVerifiedProposalCreator> verified;
+  rxcpp::subjects::subject<std::shared_ptr<const Proposal>> proposals;
+  rxcpp::subjects::subject<std::shared_ptr<const Proposal>> verified_proposals;
+  rxcpp::subjects::subject<Commit> commits;
+  std::shared_ptr<TransactionProcessorImpl> tp;
+  std::shared_ptr<TransactionStatusTracker> tracker;
+};
+
+/**
+ * @given two stateless valid transactions
+ * @when both are proposed, only the first passes stateful validation and is
+ * committed
+ * @then the first goes through all stages up to commit, the second is
+ * rejected after proposal
+ */
+TEST_F(TransactionStatusTrackerTest, StatusesFollowLifecycle) {
+  EXPECT_CALL(*pcs, propagate_transaction(_)).Times(2);
+  EXPECT_CALL(*validation, validate(A<const Transaction &>()))
+      .WillRepeatedly(Return(true));
+
+  auto valid = makeTx(1), invalid = makeTx(2);
+  auto valid_hash = valid.tx_hash.to_string();
+  auto invalid_hash = invalid.tx_hash.to_string();
+  std::vector<Status> valid_statuses, invalid_statuses;
+  tracker->updates().subscribe([&](const auto &update) {
+    if (update.hash == valid_hash) {
+      valid_statuses.push_back(update.status);
+    } else if (update.hash == invalid_hash) {
+      invalid_statuses.push_back(update.status);
+    }
+  });
+
+  ASSERT_EQ(Status::NotReceived, tracker->status(valid_hash));
+  tp->transactionHandle(std::make_shared<Transaction>(valid));
+  tp->transactionHandle(std::make_shared<Transaction>(invalid));
+
+  proposals.get_subscriber().on_next(
+      std::make_shared<Proposal>(std::vector<Transaction>{valid, invalid}));
+  verified_proposals.get_subscriber().on_next(
+      std::make_shared<Proposal>(std::vector<Transaction>{valid}));
+  auto block = std::make_shared<Block>();
+  block->transactions = {valid};
+  commits.get_subscriber().on_next(
+      rxcpp::observable<>::just(std::shared_ptr<const Block>(block)));
+  // proposal of already committed transaction does not change its status
+  proposals.get_subscriber().on_next(
+      std::make_shared<Proposal>(std::vector<Transaction>{valid}));
+
+  ASSERT_EQ(std::vector<Status>({Status::StatelessAccepted,
+                                 Status::Proposed,
+                                 Status::StatefulValid,
+                                 Status::Committed}),
+            valid_statuses);
+  ASSERT_EQ(std::vector<Status>({Status::StatelessAccepted,
+                                 Status::Proposed,
+                                 Status::StatefulRejected}),
+            invalid_statuses);
+  ASSERT_EQ(Status::Committed, tracker->status(valid_hash));
+  ASSERT_TRUE(TransactionStatusTracker::isFinal(
+      tracker->status(invalid_hash)));
+}
@@ -0,0 +1,86 @@
+/*
+Copyright Soramitsu Co., Ltd. 2016 All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+
+#include <gtest/gtest.h>
+#include <thread>
+#include "torii/sharded_map.hpp"
+
+using torii::ShardedMap;
+
+/**
+ * @given map
+ * @when value is inserted and taken
+ * @then it is taken once, and the same key is refused while present
+ */
+TEST(ShardedMapTest, ValueIsTakenOnce) {
+  ShardedMap<std::string, int> map;
+  ASSERT_TRUE(map.insert("a", 1));
+  ASSERT_FALSE(map.insert("a", 2));
+  ASSERT_EQ(1, map.size());
+  ASSERT_EQ(1, map.take("a").value());
+  ASSERT_FALSE(map.take("a"));
+  ASSERT_EQ(0, map.size());
+}
+
+/**
+ * @given map with capacity of one entry per shard
+ * @when more entries than fit into a shard are inserted
+ * @then the oldest ones are evicted
+ */
+TEST(ShardedMapTest, OldestEntriesAreEvicted) {
+  ShardedMap<int, int, 1> map(2);
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_TRUE(map.insert(i, i));
+  }
+  ASSERT_EQ(2, map.size());
+  ASSERT_EQ(3, map.evicted());
+  ASSERT_FALSE(map.take(2));
+  ASSERT_EQ(3, map.take(3).value());
+}
+
+/**
+ * @given map with short lifetime of entries
+ * @when entry is not taken in time
+ * @then it is removed on the next insertion
+ */
+TEST(ShardedMapTest, EntriesExpire) {
+  ShardedMap<int, int, 1> map(10, std::chrono::milliseconds(10));
+  ASSERT_TRUE(map.insert(1, 1));
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  ASSERT_TRUE(map.insert(2, 2));
+  ASSERT_FALSE(map.take(1));
+  ASSERT_EQ(1, map.expired());
+  ASSERT_NE(std::string::npos, map.report("test").find("test_size 1"));
+}
+
+/**
+ * @given map with entries in one shard
+ * @when memory of two entries is released
+ * @then the two oldest entries are evicted
+ */
+TEST(ShardedMapTest, ReleaseEvictsOldest) {
+  using Map = ShardedMap<int, int, 1>;
+  Map map;
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(map.insert(i, i));
+  }
+  ASSERT_EQ(4 * Map::kEntryBytes, map.memoryUsage());
+  ASSERT_EQ(2 * Map::kEntryBytes, map.release(2 * Map::kEntryBytes - 1));
+  ASSERT_EQ(2, map.size());
+  ASSERT_FALSE(map.take(1));
+  ASSERT_EQ(2, map.take(2).value());
+}
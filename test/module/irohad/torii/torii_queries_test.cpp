@@ -74,7 +74,7 @@ class ToriiServiceTest : public testing::Test {
           std::make_shared<iroha::model::converters::PbQueryResponseFactory>();
 
       auto query_service = std::make_unique<torii::QueryService>(
-          pb_query_factory, pb_query_resp_factory, qpi);
+          pb_query_factory, pb_query_resp_factory, qpi, block_query);
 
       //----------- Server run ----------------
       runner->run(std::move(command_service), std::move(query_service));
@@ -411,6 +411,102 @@ TEST_F(ToriiServiceTest, FindTransactionsWhenValid) {
   }
 }
 
+/**
+ * @given account with 250 transactions
+ * @when its history is requested with FindStream
+ * @then transactions are received in order, in parts of at most 100
+ */
+TEST_F(ToriiServiceTest, FindStreamSplitsTransactions) {
+  EXPECT_CALL(*statelessValidatorMock,
+              validate(A<std::shared_ptr<const iroha::model::Query>>()))
+      .WillOnce(Return(true));
+
+  iroha::model::Account account;
+  account.account_id = "accountA";
+
+  std::vector<iroha::model::Transaction> txs(250);
+  for (size_t i = 0; i < txs.size(); ++i) {
+    txs[i].creator_account_id = account.account_id;
+    txs[i].tx_counter = i;
+  }
+
+  EXPECT_CALL(*wsv_query, getAccount(_)).WillOnce(Return(account));
+  EXPECT_CALL(*block_query, getAccountTransactions(account.account_id))
+      .WillOnce(Return(rxcpp::observable<>::iterate(txs)));
+
+  auto query = iroha::protocol::Query();
+  query.set_creator_account_id(account.account_id);
+  query.mutable_get_account_transactions()->set_account_id(account.account_id);
+
+  std::vector<int> parts;
+  uint64_t expected_counter = 0;
+  auto stat = torii_utils::QuerySyncClient(Ip, Port).FindStream(
+      query, [&](const iroha::protocol::QueryResponse &response) {
+        ASSERT_TRUE(response.has_transactions_response());
+        const auto &page = response.transactions_response();
+        parts.push_back(page.transactions_size());
+        for (const auto &tx : page.transactions()) {
+          ASSERT_EQ(tx.meta().tx_counter(), expected_counter++);
+        }
+      });
+  ASSERT_TRUE(stat.ok());
+  ASSERT_EQ(parts, std::vector<int>({100, 100, 50}));
+}
+
+/**
+ * @given account with three transactions in two blocks
+ * @when its history is subscribed to in pages of two
+ * @then full page is followed by the rest at once, and each response
+ * carries the cursor after its last transaction
+ */
+TEST_F(ToriiServiceTest, SubscribeResumesAfterLastTransaction) {
+  EXPECT_CALL(*statelessValidatorMock,
+              validate(A<std::shared_ptr<const iroha::model::Query>>()))
+      .WillOnce(Return(true));
+
+  iroha::model::Account account;
+  account.account_id = "accountA";
+
+  std::vector<CommittedTransaction> txs(3);
+  for (size_t i = 0; i < txs.size(); ++i) {
+    txs[i].transaction.creator_account_id = account.account_id;
+    txs[i].transaction.tx_counter = i;
+    txs[i].height = 1 + i / 2;
+    txs[i].index = i % 2;
+  }
+
+  EXPECT_CALL(*wsv_query, getAccount(_)).WillRepeatedly(Return(account));
+  EXPECT_CALL(*block_query, getAccountTransactions(account.account_id, _))
+      .WillOnce(Return(rxcpp::observable<>::iterate(
+          std::vector<CommittedTransaction>(txs.begin(), txs.begin() + 2))))
+      .WillOnce(Return(rxcpp::observable<>::iterate(
+          std::vector<CommittedTransaction>(txs.begin() + 2, txs.end()))));
+
+  auto query = iroha::protocol::Query();
+  query.set_creator_account_id(account.account_id);
+  auto history = query.mutable_get_account_transactions();
+  history->set_account_id(account.account_id);
+  history->mutable_pagination()->set_page_size(2);
+
+  std::vector<std::pair<uint64_t, uint32_t>> cursors;
+  uint64_t expected_counter = 0;
+  auto stat = torii_utils::QuerySyncClient(Ip, Port).Subscribe(
+      query, [&](const iroha::protocol::QueryResponse &response) {
+        EXPECT_TRUE(response.has_transactions_response());
+        const auto &page = response.transactions_response();
+        for (const auto &tx : page.transactions()) {
+          EXPECT_EQ(tx.meta().tx_counter(), expected_counter++);
+        }
+        cursors.emplace_back(page.next().height(), page.next().index());
+        // the rest waits for a commit
+        return expected_counter < txs.size();
+      });
+  ASSERT_EQ(stat.error_code(), grpc::StatusCode::CANCELLED);
+  ASSERT_EQ(expected_counter, txs.size());
+  ASSERT_EQ(cursors,
+            (std::vector<std::pair<uint64_t, uint32_t>>{{1, 1}, {2, 0}}));
+}
+
 TEST_F(ToriiServiceTest, FindManyTimesWhereQueryServiceSync) {
   EXPECT_CALL(*statelessValidatorMock,
               validate(A<std::shared_ptr<const iroha::model::Query>>()))
@@ -430,3 +526,55 @@ TEST_F(ToriiServiceTest, FindManyTimesWhereQueryServiceSync) {
               iroha::model::ErrorResponse::STATELESS_INVALID);
   }
 }
+
+/**
+ * @given query reading after transaction, which is committed
+ * @when it is sent with long wait
+ * @then it is executed without waiting for its deadline
+ */
+TEST_F(ToriiServiceTest, FindAfterCommittedTransactionDoesNotWait) {
+  EXPECT_CALL(*statelessValidatorMock,
+              validate(A<std::shared_ptr<const iroha::model::Query>>()))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*block_query, hasTransaction(_)).WillOnce(Return(true));
+
+  iroha::protocol::QueryResponse response;
+  auto query = iroha::protocol::Query();
+  query.set_creator_account_id("accountA");
+  query.mutable_get_account()->set_account_id("accountB");
+  query.set_after_tx_hash(std::string(iroha::hash256_t::size(), 'a'));
+  query.set_wait_ms(10000);
+
+  auto start = std::chrono::steady_clock::now();
+  auto stat = torii_utils::QuerySyncClient(Ip, Port).Find(query, response);
+  ASSERT_TRUE(stat.ok());
+  ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+  ASSERT_EQ(response.error_response().reason(),
+            iroha::model::ErrorResponse::STATELESS_INVALID);
+}
+
+/**
+ * @given query reading at height above the top block
+ * @when no block is committed
+ * @then it is executed once its wait has passed
+ */
+TEST_F(ToriiServiceTest, FindAtMissingHeightWaitsForDeadline) {
+  EXPECT_CALL(*statelessValidatorMock,
+              validate(A<std::shared_ptr<const iroha::model::Query>>()))
+      .WillOnce(Return(false));
+
+  iroha::protocol::QueryResponse response;
+  auto query = iroha::protocol::Query();
+  query.set_creator_account_id("accountA");
+  query.mutable_get_account()->set_account_id("accountB");
+  query.set_min_height(1);
+  query.set_wait_ms(200);
+
+  auto start = std::chrono::steady_clock::now();
+  auto stat = torii_utils::QuerySyncClient(Ip, Port).Find(query, response);
+  ASSERT_TRUE(stat.ok());
+  ASSERT_GE(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(200));
+  ASSERT_EQ(response.error_response().reason(),
+            iroha::model::ErrorResponse::STATELESS_INVALID);
+}
@@ -38,6 +38,7 @@ constexpr int Port = 50051;
 constexpr size_t TimesToriiBlocking = 5;
 constexpr size_t TimesToriiNonBlocking = 5;
 constexpr size_t TimesFind = 10;
+constexpr size_t kToriiQueues = 4;
 
 using ::testing::Return;
 using ::testing::A;
@@ -51,7 +52,9 @@ using namespace iroha::ametsuchi;
 class ToriiServiceTest : public testing::Test {
  public:
   virtual void SetUp() {
-    runner = new ServerRunner(std::string(Ip) + ":" + std::to_string(Port));
+    // several completion queues, so handlers run concurrently
+    runner = new ServerRunner(std::string(Ip) + ":" + std::to_string(Port),
+                              kToriiQueues);
     th = std::thread([this] {
       // ----------- Command Service --------------
       pcsMock = std::make_shared<MockPeerCommunicationService>();
@@ -81,7 +84,7 @@ class ToriiServiceTest : public testing::Test {
           std::make_shared<iroha::model::converters::PbQueryResponseFactory>();
 
       auto query_service = std::make_unique<torii::QueryService>(
-          pb_query_factory, pb_query_resp_factory, qpi);
+          pb_query_factory, pb_query_resp_factory, qpi, block_query);
 
       //----------- Server run ----------------
       runner->run(std::move(command_service), std::move(query_service));
@@ -146,6 +149,41 @@ TEST_F(ToriiServiceTest, ToriiWhenBlockingInvalid) {
   }
 }
 
+/**
+ * @given list of transactions with one of them repeated
+ * @when the list is sent in one call
+ * @then each distinct transaction is validated and accepted, and the
+ * repeated one is refused in its own response
+ */
+TEST_F(ToriiServiceTest, ListToriiWhenBlocking) {
+  EXPECT_CALL(*statelessValidatorMock,
+              validate(A<const iroha::model::Transaction &>()))
+      .Times(TimesToriiBlocking)
+      .WillRepeatedly(Return(true));
+
+  EXPECT_CALL(*pcsMock, propagate_transaction(_)).Times(TimesToriiBlocking);
+
+  iroha::protocol::TxList list;
+  for (size_t i = 0; i < TimesToriiBlocking; ++i) {
+    auto meta = list.add_transactions()->mutable_meta();
+    meta->set_tx_counter(i);
+    meta->set_creator_account_id("accountA");
+  }
+  *list.add_transactions() = list.transactions(0);
+
+  iroha::protocol::ToriiResponseList response;
+  auto stat = torii::CommandSyncClient(Ip, Port).ListTorii(list, response);
+  ASSERT_TRUE(stat.ok());
+  ASSERT_EQ(static_cast<int>(TimesToriiBlocking) + 1,
+            response.responses_size());
+  for (size_t i = 0; i < TimesToriiBlocking; ++i) {
+    ASSERT_EQ(iroha::protocol::STATELESS_VALIDATION_SUCCESS,
+              response.responses(i).validation());
+  }
+  ASSERT_EQ(iroha::protocol::STATELESS_VALIDATION_FAILED,
+            response.responses(TimesToriiBlocking).validation());
+}
+
 TEST_F(ToriiServiceTest, ToriiWhenNonBlocking) {
   torii::CommandAsyncClient client(Ip, Port);
   std::atomic_int count{0};
@@ -175,3 +213,37 @@ TEST_F(ToriiServiceTest, ToriiWhenNonBlocking) {
     ;
   ASSERT_EQ(count, TimesToriiNonBlocking);
 }
+
+/**
+ * @given async client with several channels
+ * @when many transactions are sent without waiting for responses
+ * @then every future gets successful response and no rpc stays in flight
+ */
+TEST_F(ToriiServiceTest, ToriiWhenPipelined) {
+  torii::CommandAsyncClient client(Ip, Port, 4);
+
+  EXPECT_CALL(*statelessValidatorMock,
+              validate(A<const iroha::model::Transaction &>()))
+      .Times(TimesToriiNonBlocking)
+      .WillRepeatedly(Return(true));
+
+  EXPECT_CALL(*pcsMock, propagate_transaction(_)).Times(AtLeast(1));
+
+  std::vector<std::future<iroha::protocol::ToriiResponse>> responses;
+  for (size_t i = 0; i < TimesToriiNonBlocking; ++i) {
+    auto new_tx = iroha::protocol::Transaction();
+    auto meta = new_tx.mutable_meta();
+    meta->set_tx_counter(i);
+    meta->set_creator_account_id("accountA");
+    responses.push_back(client.Torii(new_tx));
+  }
+
+  for (auto &response : responses) {
+    ASSERT_EQ(response.get().validation(),
+              iroha::protocol::STATELESS_VALIDATION_SUCCESS);
+  }
+  // callback is executed before its call is released
+  while (client.inFlight() != 0) {
+    std::this_thread::yield();
+  }
+}
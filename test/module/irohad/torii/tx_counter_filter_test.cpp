@@ -0,0 +1,67 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include "torii/tx_counter_filter.hpp"
+
+using torii::TxCounterFilter;
+
+/**
+ * @given filter over ledger where alice has committed counter 5
+ * @when transactions with counters around it are checked
+ * @then only counters above 5 and uncounted transactions pass, and the
+ * ledger is read once
+ */
+TEST(TxCounterFilterTest, StaleCountersAreRejected) {
+  size_t loads = 0;
+  TxCounterFilter filter([&loads](const std::string &account_id)
+                             -> nonstd::optional<uint64_t> {
+    ++loads;
+    if (account_id == "alice@test") {
+      return 5;
+    }
+    return nonstd::nullopt;
+  });
+  ASSERT_FALSE(filter.fresh("alice@test", 4));
+  ASSERT_FALSE(filter.fresh("alice@test", 5));
+  ASSERT_TRUE(filter.fresh("alice@test", 6));
+  ASSERT_TRUE(filter.fresh("alice@test", 0));
+  ASSERT_EQ(loads, 1);
+  // unknown accounts are left to validation
+  ASSERT_TRUE(filter.fresh("bob@test", 1));
+}
+
+/**
+ * @given filter tracking alice
+ * @when block with her transaction is committed
+ * @then its counter is not fresh anymore
+ */
+TEST(TxCounterFilterTest, CommitsRaiseCounters) {
+  TxCounterFilter filter(
+      [](const std::string &) -> nonstd::optional<uint64_t> { return 1; });
+  ASSERT_TRUE(filter.fresh("alice@test", 3));
+
+  iroha::model::Block block;
+  iroha::model::Transaction tx;
+  tx.creator_account_id = "alice@test";
+  tx.tx_counter = 3;
+  block.transactions.push_back(tx);
+  filter.committed(block);
+
+  ASSERT_FALSE(filter.fresh("alice@test", 3));
+  ASSERT_TRUE(filter.fresh("alice@test", 4));
+}
@@ -29,6 +29,8 @@ using ::testing::A;
 using ::testing::Return;
 using ::testing::InvokeArgument;
 using ::testing::ByRef;
+using ::testing::InSequence;
+using ::testing::Invoke;
 
 class ChainValidationTest : public ::testing::Test {
  public:
@@ -130,9 +132,153 @@ TEST_F(ChainValidationTest, ValidWhenValidateChainFromOnePeer) {
 
   Block block;
   block.sigs.emplace_back();
-  auto block_observable = rxcpp::observable<>::just(block);
+  auto block_observable =
+      rxcpp::observable<>::just(std::make_shared<const Block>(block));
 
   EXPECT_CALL(storage, apply(block, _)).WillOnce(Return(true));
 
   ASSERT_TRUE(validator.validateChain(block_observable, storage));
 }
+
+/**
+ * @given block created by this peer with delta of its validation
+ * @when the same block is validated for commit
+ * @then delta is applied instead of executing commands
+ */
+TEST_F(ChainValidationTest, AppliesDeltaOfLocallyValidatedBlock) {
+  MockWsvCommand wsvCommand;
+  auto deltas = std::make_shared<WsvDeltaCache>();
+  ChainValidatorImpl delta_validator(provider, deltas);
+
+  EXPECT_CALL(storage, getPeers())
+      .WillOnce(Return(std::vector<model::Peer>(1)));
+  EXPECT_CALL(*provider, verify(A<const model::Block &>()))
+      .WillOnce(Return(true));
+
+  auto cmd = std::make_shared<MockCommand>();
+
+  Block block;
+  block.sigs.emplace_back();
+  block.transactions.emplace_back();
+  block.transactions.front().commands.emplace_back(cmd);
+  block.prev_hash.fill(0);
+  block.hash.fill(2);
+
+  Account account;
+  account.account_id = "admin@test";
+  deltas->put(std::make_shared<const Block>(block),
+              {[account](WsvCommand &wsv) {
+                return wsv.updateAccount(account);
+              }});
+
+  hash256_t myhash;
+  myhash.fill(0);
+
+  EXPECT_CALL(*cmd, Equals(_)).WillRepeatedly(Return(true));
+  EXPECT_CALL(*cmd, execute(_, _)).Times(0);
+  EXPECT_CALL(wsvCommand, updateAccount(_)).WillOnce(Return(true));
+
+  EXPECT_CALL(storage, apply(_, _))
+      .WillOnce(InvokeArgument<1>(ByRef(block), ByRef(wsvCommand),
+                                  ByRef(storage), ByRef(myhash)));
+
+  ASSERT_TRUE(delta_validator.validateBlock(block, storage));
+}
+
+/**
+ * @given delta recorded for block with the same hash but other contents
+ * @when block is validated for commit
+ * @then commands of block are executed
+ */
+TEST_F(ChainValidationTest, ExecutesCommandsWhenBlockDiffersFromDelta) {
+  MockWsvCommand wsvCommand;
+  auto deltas = std::make_shared<WsvDeltaCache>();
+  ChainValidatorImpl delta_validator(provider, deltas);
+
+  EXPECT_CALL(storage, getPeers())
+      .WillOnce(Return(std::vector<model::Peer>(1)));
+  EXPECT_CALL(*provider, verify(A<const model::Block &>()))
+      .WillOnce(Return(true));
+
+  auto cmd = std::make_shared<MockCommand>();
+
+  Block block;
+  block.sigs.emplace_back();
+  block.transactions.emplace_back();
+  block.transactions.front().commands.emplace_back(cmd);
+  block.prev_hash.fill(0);
+  block.hash.fill(2);
+
+  Block created = block;
+  created.transactions.front().tx_counter = 1;
+  deltas->put(std::make_shared<const Block>(created),
+              {[](WsvCommand &wsv) { return false; }});
+
+  hash256_t myhash;
+  myhash.fill(0);
+
+  EXPECT_CALL(*cmd, Equals(_)).WillRepeatedly(Return(true));
+  EXPECT_CALL(*cmd, execute(_, _)).WillOnce(Return(true));
+
+  EXPECT_CALL(storage, apply(_, _))
+      .WillOnce(InvokeArgument<1>(ByRef(block), ByRef(wsvCommand),
+                                  ByRef(storage), ByRef(myhash)));
+
+  ASSERT_TRUE(delta_validator.validateBlock(block, storage));
+}
+
+/**
+ * @given chain of blocks where signatures of the third block are invalid
+ * @when chain is validated
+ * @then blocks before it are applied in order
+ * @then chain is invalid
+ */
+TEST_F(ChainValidationTest, InvalidWhenSignaturesOfBlockInChainAreInvalid) {
+  std::vector<std::shared_ptr<const Block>> chain;
+  for (uint64_t height = 1; height <= 4; ++height) {
+    Block block;
+    block.height = height;
+    block.sigs.emplace_back();
+    chain.push_back(std::make_shared<const Block>(block));
+  }
+
+  EXPECT_CALL(storage, getPeers())
+      .WillRepeatedly(Return(std::vector<model::Peer>(1)));
+  EXPECT_CALL(*provider, verify(A<const model::Block &>()))
+      .WillRepeatedly(Invoke(
+          [](const model::Block &block) { return block.height != 3; }));
+
+  {
+    InSequence sequence;
+    EXPECT_CALL(storage, apply(*chain[0], _)).WillOnce(Return(true));
+    EXPECT_CALL(storage, apply(*chain[1], _)).WillOnce(Return(true));
+  }
+
+  ASSERT_FALSE(validator.validateChain(rxcpp::observable<>::iterate(chain),
+                                       storage));
+}
+
+/**
+ * @given signed blocks linked by hashes, and the same chain with a block
+ * which does not refer to the previous one
+ * @when their headers are validated
+ * @then linked chain is valid without applying blocks
+ * @then broken chain is invalid
+ */
+TEST_F(ChainValidationTest, HeadersAreValidWhenBlocksAreLinked) {
+  std::vector<Block> chain(3);
+  for (size_t i = 0; i < chain.size(); ++i) {
+    chain[i].height = i + 1;
+    chain[i].hash.fill(i + 1);
+    chain[i].prev_hash.fill(i);
+    chain[i].sigs.emplace_back();
+  }
+  EXPECT_CALL(*provider, verify(A<const model::Block &>()))
+      .WillRepeatedly(Return(true));
+  EXPECT_CALL(storage, apply(_, _)).Times(0);
+
+  ASSERT_TRUE(validator.validateHeaders(chain));
+
+  chain[2].prev_hash.fill(7);
+  ASSERT_FALSE(validator.validateHeaders(chain));
+}
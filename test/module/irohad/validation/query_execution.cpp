@@ -17,10 +17,17 @@
 
 #include "module/irohad/ametsuchi/ametsuchi_mocks.hpp"
 
+#include "model/commands/create_domain.hpp"
+#include "model/commands/transfer_asset.hpp"
 #include "model/query_execution.hpp"
 #include <model/queries/responses/account_assets_response.hpp>
 #include "model/queries/responses/account_response.hpp"
+#include "model/queries/responses/accounts_response.hpp"
 #include "model/queries/responses/error_response.hpp"
+#include "model/queries/responses/query_batch_response.hpp"
+#include "model/queries/responses/state_root_response.hpp"
+#include "model/queries/responses/transaction_response.hpp"
+#include "model/queries/responses/transactions_response.hpp"
 
 using ::testing::Return;
 using ::testing::AtLeast;
@@ -175,6 +182,137 @@ TEST(QueryExecutor, get_account) {
   // TODO: tests for signatures
 }
 
+/**
+ * @given account with assets
+ * @when all of them are requested at once, then in pages of two
+ * @then one range read of wsv serves each request, and continuation is set
+ * only for a full page, and other accounts can not read them
+ */
+TEST(QueryExecutor, get_account_asset_list) {
+  auto wsv_queries = std::make_shared<MockWsvQuery>();
+  auto block_queries = std::make_shared<MockBlockQuery>();
+
+  auto query_proccesor =
+      iroha::model::QueryProcessingFactory(wsv_queries, block_queries);
+
+  set_default_ametsuchi(*wsv_queries, *block_queries);
+
+  std::vector<iroha::model::AccountAsset> assets;
+  for (auto id : {"coin", "gold", "silver"}) {
+    iroha::model::AccountAsset asset;
+    asset.account_id = ACCOUNT_ID;
+    asset.asset_id = id;
+    asset.balance = 1;
+    assets.push_back(asset);
+  }
+  EXPECT_CALL(*wsv_queries, getAccountAssets(ACCOUNT_ID, "", 0))
+      .WillOnce(Return(assets));
+  EXPECT_CALL(*wsv_queries, getAccountAssets(ACCOUNT_ID, "", 2))
+      .WillOnce(Return(std::vector<iroha::model::AccountAsset>(
+          assets.begin(), assets.begin() + 2)));
+  EXPECT_CALL(*wsv_queries, getAccountAsset(ACCOUNT_ID, _)).Times(0);
+
+  auto query = std::make_shared<iroha::model::GetAccountAssetList>();
+  query->account_id = ACCOUNT_ID;
+  query->creator_account_id = ACCOUNT_ID;
+  query->signature.pubkey = get_default_account().master_key;
+  using ListResponse = iroha::model::AccountAssetsResponse;
+  auto response =
+      std::dynamic_pointer_cast<ListResponse>(query_proccesor.execute(query));
+  ASSERT_NE(response, nullptr);
+  ASSERT_EQ(response->account_assets.size(), 3);
+  ASSERT_FALSE(response->next_asset_id);
+
+  query->pagination.page_size = 2;
+  response =
+      std::dynamic_pointer_cast<ListResponse>(query_proccesor.execute(query));
+  ASSERT_NE(response, nullptr);
+  ASSERT_EQ(response->account_assets.size(), 2);
+  ASSERT_EQ(response->next_asset_id, std::string("gold"));
+
+  query->creator_account_id = ADVERSARY_ID;
+  query->signature.pubkey = get_default_adversary().master_key;
+  auto err_resp = std::dynamic_pointer_cast<iroha::model::ErrorResponse>(
+      query_proccesor.execute(query));
+  ASSERT_NE(err_resp, nullptr);
+  ASSERT_EQ(err_resp->reason, iroha::model::ErrorResponse::STATEFUL_INVALID);
+}
+
+/**
+ * @given accounts of domain holding asset and signed by one key
+ * @when they are listed by domain, asset and key in pages of one
+ * @then continuation is set to the last account of the page, and accounts
+ * without read_all_accounts can not list them
+ */
+TEST(QueryExecutor, list_accounts) {
+  auto wsv_queries = std::make_shared<MockWsvQuery>();
+  auto block_queries = std::make_shared<MockBlockQuery>();
+
+  auto query_proccesor =
+      iroha::model::QueryProcessingFactory(wsv_queries, block_queries);
+
+  set_default_ametsuchi(*wsv_queries, *block_queries);
+
+  auto account = get_default_account();
+  iroha::model::AccountAsset balance;
+  balance.account_id = ACCOUNT_ID;
+  balance.asset_id = "coin#test";
+  balance.balance = 1;
+  EXPECT_CALL(*wsv_queries, getAssetHolders("coin#test", "", 1))
+      .WillOnce(Return(std::vector<iroha::model::AccountAsset>{balance}));
+  EXPECT_CALL(*wsv_queries, getDomainAccounts("test", ADMIN_ID, 1))
+      .WillOnce(Return(std::vector<iroha::model::Account>{account}));
+  EXPECT_CALL(*wsv_queries,
+              getAccountsBySignatory(account.master_key, "", 2))
+      .WillOnce(Return(std::vector<std::string>{ACCOUNT_ID}));
+
+  auto holders = std::make_shared<iroha::model::GetAssetHolders>();
+  holders->asset_id = "coin#test";
+  holders->pagination.page_size = 1;
+  holders->creator_account_id = ADMIN_ID;
+  holders->signature.pubkey = get_default_creator().master_key;
+  auto holders_response =
+      std::dynamic_pointer_cast<iroha::model::AssetHoldersResponse>(
+          query_proccesor.execute(holders));
+  ASSERT_NE(holders_response, nullptr);
+  ASSERT_EQ(holders_response->account_assets.size(), 1);
+  ASSERT_EQ(holders_response->next_account_id, std::string(ACCOUNT_ID));
+
+  auto accounts = std::make_shared<iroha::model::GetDomainAccounts>();
+  accounts->domain_id = "test";
+  accounts->pagination.page_size = 1;
+  accounts->pagination.after_account_id = ADMIN_ID;
+  accounts->creator_account_id = ADMIN_ID;
+  accounts->signature.pubkey = get_default_creator().master_key;
+  auto accounts_response =
+      std::dynamic_pointer_cast<iroha::model::AccountsResponse>(
+          query_proccesor.execute(accounts));
+  ASSERT_NE(accounts_response, nullptr);
+  ASSERT_EQ(accounts_response->accounts.size(), 1);
+  ASSERT_EQ(accounts_response->next_account_id, std::string(ACCOUNT_ID));
+
+  // page is not full, so there is no continuation
+  auto signed_by = std::make_shared<iroha::model::GetAccountsBySignatory>();
+  signed_by->signatory = account.master_key;
+  signed_by->pagination.page_size = 2;
+  signed_by->creator_account_id = ADMIN_ID;
+  signed_by->signature.pubkey = get_default_creator().master_key;
+  auto ids_response =
+      std::dynamic_pointer_cast<iroha::model::AccountIdsResponse>(
+          query_proccesor.execute(signed_by));
+  ASSERT_NE(ids_response, nullptr);
+  ASSERT_EQ(ids_response->account_ids,
+            std::vector<std::string>{ACCOUNT_ID});
+  ASSERT_FALSE(ids_response->next_account_id);
+
+  signed_by->creator_account_id = ACCOUNT_ID;
+  signed_by->signature.pubkey = account.master_key;
+  auto err_resp = std::dynamic_pointer_cast<iroha::model::ErrorResponse>(
+      query_proccesor.execute(signed_by));
+  ASSERT_NE(err_resp, nullptr);
+  ASSERT_EQ(err_resp->reason, iroha::model::ErrorResponse::STATEFUL_INVALID);
+}
+
 TEST(QueryExecutor, get_account_assets) {
   auto wsv_queries = std::make_shared<MockWsvQuery>();
   auto block_queries = std::make_shared<MockBlockQuery>();
@@ -263,3 +401,434 @@ TEST(QueryExecutor, get_account_assets) {
 
   // TODO: tests for signatures
 }
+
+TEST(QueryExecutor, get_transaction) {
+  auto wsv_queries = std::make_shared<MockWsvQuery>();
+  auto block_queries = std::make_shared<MockBlockQuery>();
+
+  auto query_proccesor =
+      iroha::model::QueryProcessingFactory(wsv_queries, block_queries);
+
+  set_default_ametsuchi(*wsv_queries, *block_queries);
+
+  iroha::hash256_t committed_hash;
+  committed_hash.fill(0x1);
+  iroha::ametsuchi::CommittedTransaction committed;
+  committed.transaction.creator_account_id = ACCOUNT_ID;
+  committed.height = 3;
+  committed.index = 1;
+  EXPECT_CALL(*block_queries, getTransaction(_))
+      .WillRepeatedly(Return(nonstd::nullopt));
+  EXPECT_CALL(*block_queries, getTransaction(committed_hash))
+      .WillRepeatedly(Return(committed));
+
+  // Valid cases:
+  // 1. Transaction creator asks about his transaction
+  auto query = std::make_shared<iroha::model::GetTransaction>();
+  query->tx_hash = committed_hash;
+  query->creator_account_id = ACCOUNT_ID;
+  auto response = query_proccesor.execute(query);
+  auto cast_resp =
+      std::dynamic_pointer_cast<iroha::model::TransactionResponse>(response);
+  ASSERT_NE(cast_resp, nullptr);
+  ASSERT_EQ(cast_resp->transaction.creator_account_id, ACCOUNT_ID);
+  ASSERT_EQ(cast_resp->height, 3);
+  ASSERT_EQ(cast_resp->index, 1);
+
+  // 2. Admin asks about transaction of test account
+  query->creator_account_id = ADMIN_ID;
+  response = query_proccesor.execute(query);
+  cast_resp =
+      std::dynamic_pointer_cast<iroha::model::TransactionResponse>(response);
+  ASSERT_NE(cast_resp, nullptr);
+
+  // --------- Non valid cases: -------
+
+  // 1. Asking not committed transaction
+  query->tx_hash.fill(0x2);
+  response = query_proccesor.execute(query);
+  auto err_resp =
+      std::dynamic_pointer_cast<iroha::model::ErrorResponse>(response);
+  ASSERT_NE(err_resp, nullptr);
+  ASSERT_EQ(err_resp->reason, iroha::model::ErrorResponse::NO_TRANSACTION);
+
+  // 2. No rights to ask
+  query->tx_hash = committed_hash;
+  query->creator_account_id = ADVERSARY_ID;
+  response = query_proccesor.execute(query);
+  err_resp = std::dynamic_pointer_cast<iroha::model::ErrorResponse>(response);
+  ASSERT_NE(err_resp, nullptr);
+  ASSERT_EQ(err_resp->reason, iroha::model::ErrorResponse::STATEFUL_INVALID);
+
+  // 3. No creator
+  query->creator_account_id = "noacct";
+  response = query_proccesor.execute(query);
+  err_resp = std::dynamic_pointer_cast<iroha::model::ErrorResponse>(response);
+  ASSERT_NE(err_resp, nullptr);
+  ASSERT_EQ(err_resp->reason, iroha::model::ErrorResponse::STATEFUL_INVALID);
+}
+
+/**
+ * @given storage which maintains state root
+ * @when account asks for the root
+ * @then root is returned with height of the state it is taken at, and
+ * missing root is reported as not supported
+ */
+TEST(QueryExecutor, get_state_root) {
+  auto wsv_queries = std::make_shared<MockWsvQuery>();
+  auto block_queries = std::make_shared<MockBlockQuery>();
+
+  auto query_proccesor =
+      iroha::model::QueryProcessingFactory(wsv_queries, block_queries);
+
+  set_default_ametsuchi(*wsv_queries, *block_queries);
+
+  CommittedStateRoot root;
+  root.height = 7;
+  root.root.fill(0x3);
+  EXPECT_CALL(*block_queries, getStateRoot())
+      .WillOnce(Return(root))
+      .WillOnce(Return(nonstd::nullopt));
+
+  auto query = std::make_shared<iroha::model::GetStateRoot>();
+  query->creator_account_id = ACCOUNT_ID;
+  auto response = query_proccesor.execute(query);
+  auto cast_resp =
+      std::dynamic_pointer_cast<iroha::model::StateRootResponse>(response);
+  ASSERT_NE(cast_resp, nullptr);
+  ASSERT_EQ(cast_resp->height, 7);
+  ASSERT_EQ(cast_resp->root, root.root);
+
+  response = query_proccesor.execute(query);
+  auto err_resp =
+      std::dynamic_pointer_cast<iroha::model::ErrorResponse>(response);
+  ASSERT_NE(err_resp, nullptr);
+  ASSERT_EQ(err_resp->reason, iroha::model::ErrorResponse::NOT_SUPPORTED);
+
+  // No creator
+  query->creator_account_id = "noacct";
+  response = query_proccesor.execute(query);
+  err_resp = std::dynamic_pointer_cast<iroha::model::ErrorResponse>(response);
+  ASSERT_NE(err_resp, nullptr);
+  ASSERT_EQ(err_resp->reason, iroha::model::ErrorResponse::STATEFUL_INVALID);
+}
+
+TEST(QueryExecutor, get_transaction_with_proof) {
+  auto wsv_queries = std::make_shared<MockWsvQuery>();
+  auto block_queries = std::make_shared<MockBlockQuery>();
+
+  auto query_proccesor =
+      iroha::model::QueryProcessingFactory(wsv_queries, block_queries);
+
+  set_default_ametsuchi(*wsv_queries, *block_queries);
+
+  iroha::hash256_t committed_hash;
+  committed_hash.fill(0x1);
+  iroha::ametsuchi::CommittedTransaction committed;
+  committed.transaction.creator_account_id = ACCOUNT_ID;
+  committed.height = 3;
+  committed.index = 1;
+  iroha::model::InclusionProof proof;
+  proof.header.height = 3;
+  proof.path.push_back({committed_hash, true});
+  EXPECT_CALL(*block_queries, getTransaction(committed_hash))
+      .WillRepeatedly(Return(committed));
+  EXPECT_CALL(*block_queries, getInclusionProof(_)).WillOnce(Return(proof));
+
+  auto query = std::make_shared<iroha::model::GetTransaction>();
+  query->tx_hash = committed_hash;
+  query->creator_account_id = ACCOUNT_ID;
+
+  // proof is attached only on request
+  auto response = std::dynamic_pointer_cast<iroha::model::TransactionResponse>(
+      query_proccesor.execute(query));
+  ASSERT_NE(response, nullptr);
+  ASSERT_FALSE(response->proof);
+
+  query->with_proof = true;
+  response = std::dynamic_pointer_cast<iroha::model::TransactionResponse>(
+      query_proccesor.execute(query));
+  ASSERT_NE(response, nullptr);
+  ASSERT_TRUE(response->proof);
+  ASSERT_EQ(response->proof->header.height, 3);
+  ASSERT_EQ(response->proof->path.size(), 1);
+}
+
+TEST(QueryExecutor, get_account_asset_transactions) {
+  auto wsv_queries = std::make_shared<MockWsvQuery>();
+  auto block_queries = std::make_shared<MockBlockQuery>();
+
+  auto query_proccesor =
+      iroha::model::QueryProcessingFactory(wsv_queries, block_queries);
+
+  set_default_ametsuchi(*wsv_queries, *block_queries);
+
+  std::vector<CommittedTransaction> txs(2);
+  txs[0].transaction.creator_account_id = ACCOUNT_ID;
+  txs[0].height = 3;
+  txs[0].index = 0;
+  txs[1].transaction.creator_account_id = ADMIN_ID;
+  txs[1].height = 5;
+  txs[1].index = 2;
+  EXPECT_CALL(*block_queries,
+              getAccountAssetTransactions(ACCOUNT_ID, ASSET_ID, _))
+      .WillRepeatedly(Return(rxcpp::observable<>::iterate(txs)));
+
+  // Valid cases:
+  // 1. Account asks about full page of his asset transactions
+  auto query = std::make_shared<iroha::model::GetAccountAssetTransactions>();
+  query->account_id = ACCOUNT_ID;
+  query->asset_id = ASSET_ID;
+  query->pagination.page_size = 2;
+  query->creator_account_id = ACCOUNT_ID;
+  auto response = query_proccesor.execute(query);
+  auto cast_resp =
+      std::dynamic_pointer_cast<iroha::model::TransactionsResponse>(response);
+  ASSERT_NE(cast_resp, nullptr);
+  auto count = cast_resp->transactions.count().as_blocking().first();
+  ASSERT_EQ(count, 2);
+  // continuation points to the last transaction of the page
+  ASSERT_TRUE(cast_resp->next);
+  ASSERT_EQ(cast_resp->next->height, 5);
+  ASSERT_EQ(cast_resp->next->index, 2);
+
+  // 2. Last page is not full and has no continuation
+  query->pagination.page_size = 3;
+  response = query_proccesor.execute(query);
+  cast_resp =
+      std::dynamic_pointer_cast<iroha::model::TransactionsResponse>(response);
+  ASSERT_NE(cast_resp, nullptr);
+  ASSERT_FALSE(cast_resp->next);
+
+  // --------- Non valid cases: -------
+
+  // 1. No rights to ask
+  query->creator_account_id = ADVERSARY_ID;
+  response = query_proccesor.execute(query);
+  auto err_resp =
+      std::dynamic_pointer_cast<iroha::model::ErrorResponse>(response);
+  ASSERT_NE(err_resp, nullptr);
+  ASSERT_EQ(err_resp->reason, iroha::model::ErrorResponse::STATEFUL_INVALID);
+}
+
+/**
+ * @given committed transfers of asset
+ * @when they are queried by account with and without read_all_accounts
+ * @then page of transfers is returned only to the former
+ */
+TEST(QueryExecutor, get_asset_transfers) {
+  auto wsv_queries = std::make_shared<MockWsvQuery>();
+  auto block_queries = std::make_shared<MockBlockQuery>();
+
+  auto query_proccesor =
+      iroha::model::QueryProcessingFactory(wsv_queries, block_queries);
+
+  set_default_ametsuchi(*wsv_queries, *block_queries);
+
+  std::vector<CommittedTransaction> txs(2);
+  txs[0].height = 3;
+  txs[0].index = 0;
+  txs[1].height = 5;
+  txs[1].index = 1;
+  EXPECT_CALL(*block_queries,
+              getAssetTransfers(ASSET_ID, 2, 6, iroha::Amount(1, 50), _))
+      .WillRepeatedly(Return(rxcpp::observable<>::iterate(txs)));
+
+  auto query = std::make_shared<iroha::model::GetAssetTransfers>();
+  query->asset_id = ASSET_ID;
+  query->from_height = 2;
+  query->to_height = 6;
+  query->min_amount = iroha::Amount(1, 50);
+  query->pagination.page_size = 2;
+  query->creator_account_id = ADMIN_ID;
+  auto cast_resp =
+      std::dynamic_pointer_cast<iroha::model::TransactionsResponse>(
+          query_proccesor.execute(query));
+  ASSERT_NE(cast_resp, nullptr);
+  ASSERT_EQ(cast_resp->transactions.count().as_blocking().first(), 2);
+  ASSERT_TRUE(cast_resp->next);
+  ASSERT_EQ(cast_resp->next->height, 5);
+  ASSERT_EQ(cast_resp->next->index, 1);
+
+  // transfers of all accounts need read_all_accounts
+  query->creator_account_id = ACCOUNT_ID;
+  auto err_resp = std::dynamic_pointer_cast<iroha::model::ErrorResponse>(
+      query_proccesor.execute(query));
+  ASSERT_NE(err_resp, nullptr);
+  ASSERT_EQ(err_resp->reason, iroha::model::ErrorResponse::STATEFUL_INVALID);
+}
+
+/**
+ * @given query processing factory with results cache
+ * @when the same account asset is queried before and after commits
+ * @then world state view is read again only after a commit which touches
+ * the account
+ */
+TEST(QueryExecutor, CachedReadsAreDroppedByTouchingCommit) {
+  auto wsv_queries = std::make_shared<MockWsvQuery>();
+  auto block_queries = std::make_shared<MockBlockQuery>();
+  auto query_proccesor =
+      iroha::model::QueryProcessingFactory(wsv_queries, block_queries, true);
+
+  auto acct_asset = iroha::model::AccountAsset();
+  acct_asset.asset_id = ASSET_ID;
+  acct_asset.account_id = ACCOUNT_ID;
+  acct_asset.balance = 150;
+  EXPECT_CALL(*wsv_queries, getAccount(ACCOUNT_ID))
+      .Times(2)
+      .WillRepeatedly(Return(get_default_account()));
+  EXPECT_CALL(*wsv_queries, getAccountAsset(ACCOUNT_ID, ASSET_ID))
+      .Times(2)
+      .WillRepeatedly(Return(acct_asset));
+
+  auto query = std::make_shared<iroha::model::GetAccountAssets>();
+  query->account_id = ACCOUNT_ID;
+  query->creator_account_id = ACCOUNT_ID;
+  query->asset_id = ASSET_ID;
+  auto execute = [&] {
+    auto response = std::dynamic_pointer_cast<
+        iroha::model::AccountAssetResponse>(query_proccesor.execute(query));
+    ASSERT_NE(response, nullptr);
+    ASSERT_EQ(response->acct_asset.balance, 150);
+  };
+  execute();
+  execute();
+
+  // commit of unrelated command keeps cached reads
+  iroha::model::Transaction domain_tx;
+  domain_tx.commands.push_back(
+      std::make_shared<iroha::model::CreateDomain>());
+  iroha::model::Block block;
+  block.transactions.push_back(domain_tx);
+  query_proccesor.invalidate(block);
+  execute();
+
+  // transfer from the account drops them
+  auto transfer = std::make_shared<iroha::model::TransferAsset>();
+  transfer->src_account_id = ACCOUNT_ID;
+  transfer->dest_account_id = ADMIN_ID;
+  transfer->asset_id = ASSET_ID;
+  iroha::model::Transaction transfer_tx;
+  transfer_tx.commands.push_back(transfer);
+  block.transactions = {transfer_tx};
+  query_proccesor.invalidate(block);
+  execute();
+  execute();
+}
+
+/**
+ * @given query processing factory without results cache
+ * @when account queries itself
+ * @then its account is read from world state view once
+ */
+TEST(QueryExecutor, SelfQueryReadsAccountOnce) {
+  auto wsv_queries = std::make_shared<MockWsvQuery>();
+  auto block_queries = std::make_shared<MockBlockQuery>();
+  auto query_proccesor =
+      iroha::model::QueryProcessingFactory(wsv_queries, block_queries);
+
+  EXPECT_CALL(*wsv_queries, getAccount(ACCOUNT_ID))
+      .WillOnce(Return(get_default_account()));
+
+  auto query = std::make_shared<iroha::model::GetAccount>();
+  query->account_id = ACCOUNT_ID;
+  query->creator_account_id = ACCOUNT_ID;
+  auto response = std::dynamic_pointer_cast<iroha::model::AccountResponse>(
+      query_proccesor.execute(query));
+  ASSERT_NE(response, nullptr);
+  ASSERT_EQ(response->account.account_id, ACCOUNT_ID);
+}
+
+/**
+ * Counts pins of state, which have no effect on mocks
+ */
+class CountingSnapshotPinFactory : public SnapshotPinFactory {
+ public:
+  std::unique_ptr<SnapshotPin> pinSnapshot() override {
+    ++pins;
+    return std::make_unique<SnapshotPin>();
+  }
+
+  size_t pins = 0;
+};
+
+/**
+ * @given batch of account and account asset queries
+ * @when it is executed
+ * @then state is pinned once, creator is read once and responses follow
+ * order of queries
+ */
+TEST(QueryExecutor, QueryBatchSharesStateAndCreator) {
+  auto wsv_queries = std::make_shared<MockWsvQuery>();
+  auto block_queries = std::make_shared<MockBlockQuery>();
+  auto snapshots = std::make_shared<CountingSnapshotPinFactory>();
+  auto query_proccesor = iroha::model::QueryProcessingFactory(
+      wsv_queries, block_queries, false, snapshots);
+
+  auto acct_asset = iroha::model::AccountAsset();
+  acct_asset.asset_id = ASSET_ID;
+  acct_asset.account_id = ACCOUNT_ID;
+  acct_asset.balance = 150;
+  EXPECT_CALL(*wsv_queries, getAccount(ADMIN_ID))
+      .WillOnce(Return(get_default_creator()));
+  EXPECT_CALL(*wsv_queries, getAccount(ACCOUNT_ID))
+      .WillOnce(Return(get_default_account()));
+  EXPECT_CALL(*wsv_queries, getAccountAsset(ACCOUNT_ID, ASSET_ID))
+      .WillOnce(Return(acct_asset));
+
+  auto account_query = std::make_shared<iroha::model::GetAccount>();
+  account_query->account_id = ACCOUNT_ID;
+  account_query->creator_account_id = ADMIN_ID;
+  account_query->query_hash.fill(1);
+  auto asset_query = std::make_shared<iroha::model::GetAccountAssets>();
+  asset_query->account_id = ACCOUNT_ID;
+  asset_query->asset_id = ASSET_ID;
+  asset_query->creator_account_id = ADMIN_ID;
+  asset_query->query_hash.fill(2);
+  auto batch = std::make_shared<iroha::model::QueryBatch>();
+  batch->creator_account_id = ADMIN_ID;
+  batch->queries = {account_query, asset_query};
+
+  auto response = std::dynamic_pointer_cast<iroha::model::QueryBatchResponse>(
+      query_proccesor.execute(batch));
+  ASSERT_NE(response, nullptr);
+  ASSERT_EQ(snapshots->pins, 1);
+  ASSERT_EQ(response->responses.size(), 2);
+  auto account = std::dynamic_pointer_cast<iroha::model::AccountResponse>(
+      response->responses[0]);
+  ASSERT_NE(account, nullptr);
+  ASSERT_EQ(account->account.account_id, ACCOUNT_ID);
+  ASSERT_EQ(account->query_hash, account_query->query_hash);
+  auto asset = std::dynamic_pointer_cast<iroha::model::AccountAssetResponse>(
+      response->responses[1]);
+  ASSERT_NE(asset, nullptr);
+  ASSERT_EQ(asset->acct_asset.balance, 150);
+  ASSERT_EQ(asset->query_hash, asset_query->query_hash);
+}
+
+/**
+ * @given batch of queries by not existing creator
+ * @when it is executed
+ * @then whole batch is answered with one stateful invalid error
+ */
+TEST(QueryExecutor, QueryBatchOfMissingCreatorIsInvalid) {
+  auto wsv_queries = std::make_shared<MockWsvQuery>();
+  auto block_queries = std::make_shared<MockBlockQuery>();
+  auto query_proccesor =
+      iroha::model::QueryProcessingFactory(wsv_queries, block_queries);
+
+  EXPECT_CALL(*wsv_queries, getAccount("nobody@test"))
+      .WillOnce(Return(nonstd::nullopt));
+
+  auto query = std::make_shared<iroha::model::GetAccount>();
+  query->account_id = ACCOUNT_ID;
+  query->creator_account_id = "nobody@test";
+  auto batch = std::make_shared<iroha::model::QueryBatch>();
+  batch->creator_account_id = "nobody@test";
+  batch->queries = {query, query};
+
+  auto response = std::dynamic_pointer_cast<iroha::model::ErrorResponse>(
+      query_proccesor.execute(batch));
+  ASSERT_NE(response, nullptr);
+  ASSERT_EQ(response->reason, iroha::model::ErrorResponse::STATEFUL_INVALID);
+}
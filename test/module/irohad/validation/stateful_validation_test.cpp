@@ -0,0 +1,427 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <map>
+#include <thread>
+#include "model/commands/create_domain.hpp"
+#include "model/commands/transfer_asset.hpp"
+#include "validation/impl/overlay_wsv.hpp"
+#include "validation/impl/stateful_validator_impl.hpp"
+
+using namespace iroha;
+using namespace iroha::model;
+using namespace iroha::validation;
+using namespace iroha::ametsuchi;
+
+/**
+ * Temporary wsv over accounts and account assets kept in memory
+ */
+class MemoryWsv : public TemporaryWsv, public WsvCommand {
+ public:
+  bool apply(const Transaction &transaction,
+             std::function<bool(const Transaction &, WsvCommand &,
+                                WsvQuery &)> function) override {
+    std::this_thread::sleep_for(apply_delay);
+    auto accounts_backup = accounts;
+    auto assets_backup = account_assets;
+    auto result = function(transaction, *this, *this);
+    if (not result) {
+      accounts = accounts_backup;
+      account_assets = assets_backup;
+    }
+    return result;
+  }
+
+  nonstd::optional<Account> getAccount(
+      const std::string &account_id) override {
+    auto it = accounts.find(account_id);
+    if (it == accounts.end()) {
+      return nonstd::nullopt;
+    }
+    return it->second;
+  }
+
+  nonstd::optional<std::vector<ed25519::pubkey_t>> getSignatories(
+      const std::string &account_id) override {
+    return std::vector<ed25519::pubkey_t>(1);
+  }
+
+  nonstd::optional<Asset> getAsset(const std::string &asset_id) override {
+    ++asset_reads;
+    Asset asset;
+    asset.asset_id = asset_id;
+    asset.precision = 2;
+    return asset;
+  }
+
+  nonstd::optional<AccountAsset> getAccountAsset(
+      const std::string &account_id, const std::string &asset_id) override {
+    auto it = account_assets.find(account_id);
+    if (it == account_assets.end()) {
+      return nonstd::nullopt;
+    }
+    return it->second;
+  }
+
+  nonstd::optional<std::vector<AccountAsset>> getAccountAssets(
+      const std::string &account_id,
+      const std::string &after_asset_id,
+      size_t limit) override {
+    return nonstd::nullopt;
+  }
+
+  nonstd::optional<std::vector<AccountAsset>> getAssetHolders(
+      const std::string &asset_id,
+      const std::string &after_account_id,
+      size_t limit) override {
+    return nonstd::nullopt;
+  }
+
+  nonstd::optional<std::vector<Account>> getDomainAccounts(
+      const std::string &domain_id,
+      const std::string &after_account_id,
+      size_t limit) override {
+    return nonstd::nullopt;
+  }
+
+  nonstd::optional<std::vector<std::string>> getAccountsBySignatory(
+      const ed25519::pubkey_t &signatory,
+      const std::string &after_account_id,
+      size_t limit) override {
+    return nonstd::nullopt;
+  }
+
+  nonstd::optional<std::vector<Peer>> getPeers() override {
+    return std::vector<Peer>();
+  }
+
+  bool updateAccount(const Account &account) override {
+    accounts[account.account_id] = account;
+    return true;
+  }
+
+  bool upsertAccountAsset(const AccountAsset &asset) override {
+    account_assets[asset.account_id] = asset;
+    return true;
+  }
+
+  bool insertDomain(const Domain &domain) override {
+    ++domains;
+    return true;
+  }
+
+  bool insertAccount(const Account &) override { return false; }
+  bool insertAsset(const Asset &) override { return false; }
+  bool insertSignatory(const ed25519::pubkey_t &) override { return false; }
+  bool insertAccountSignatory(const std::string &,
+                              const ed25519::pubkey_t &) override {
+    return false;
+  }
+  bool deleteAccountSignatory(const std::string &,
+                              const ed25519::pubkey_t &) override {
+    return false;
+  }
+  bool insertPeer(const Peer &) override { return false; }
+  bool deletePeer(const Peer &) override { return false; }
+
+  std::map<std::string, Account> accounts;
+  // balances of the only asset by account
+  std::map<std::string, AccountAsset> account_assets;
+  size_t domains = 0;
+  size_t asset_reads = 0;
+  std::chrono::milliseconds apply_delay{0};
+};
+
+class StatefulValidationTest : public ::testing::Test {
+ public:
+  static constexpr size_t kAccounts = 8;
+
+  void SetUp() override {
+    for (size_t i = 0; i < kAccounts; ++i) {
+      Account account;
+      account.account_id = accountId(i);
+      account.quorum = 1;
+      account.permissions.can_transfer = true;
+      account.permissions.create_domains = true;
+      wsv.accounts[account.account_id] = account;
+
+      AccountAsset asset;
+      asset.account_id = account.account_id;
+      asset.asset_id = "coin#test";
+      asset.balance = 1000;
+      wsv.account_assets[asset.account_id] = asset;
+    }
+  }
+
+  static std::string accountId(size_t i) {
+    return "user" + std::to_string(i) + "@test";
+  }
+
+  static Transaction transfer(size_t src, size_t dest, uint64_t amount) {
+    auto command = std::make_shared<TransferAsset>();
+    command->src_account_id = accountId(src);
+    command->dest_account_id = accountId(dest);
+    command->asset_id = "coin#test";
+    command->amount = Amount(amount, 50);
+    Transaction tx;
+    tx.creator_account_id = command->src_account_id;
+    tx.signatures.emplace_back();
+    tx.commands.push_back(command);
+    return tx;
+  }
+
+  /**
+   * Transfers between pairs of accounts, some of them overdraw
+   */
+  static std::vector<Transaction> transfers(size_t count) {
+    std::vector<Transaction> txs;
+    for (size_t i = 0; i < count; ++i) {
+      auto src = i % kAccounts;
+      // every second transfer depends on the previous one of the pair
+      auto dest = (src + (i / kAccounts) % 2 + 1) % kAccounts;
+      txs.push_back(transfer(src, dest, 1 + (i * 7) % 6));
+    }
+    return txs;
+  }
+
+  MemoryWsv wsv;
+};
+
+constexpr size_t StatefulValidationTest::kAccounts;
+
+/**
+ * @given transfers between distinct pairs of accounts
+ * @when transactions are grouped by conflicts
+ * @then each pair forms its own group in order of transactions
+ */
+TEST_F(StatefulValidationTest, IndependentTransfersFormSeparateGroups) {
+  std::vector<Transaction> txs{
+      transfer(0, 1, 1), transfer(2, 3, 1), transfer(1, 0, 1)};
+  std::vector<TransactionAccess> access;
+  for (const auto &tx : txs) {
+    access.push_back(accessOf(tx));
+    ASSERT_TRUE(access.back().parallel);
+  }
+
+  auto groups = independentGroups(access);
+
+  ASSERT_EQ(2, groups.size());
+  ASSERT_EQ((std::vector<size_t>{0, 2}), groups[0]);
+  ASSERT_EQ((std::vector<size_t>{1}), groups[1]);
+}
+
+/**
+ * @given transaction of several transfers of the same asset
+ * @when it is applied to overlay
+ * @then asset is read from base once
+ */
+TEST_F(StatefulValidationTest, OverlayReadsBaseOncePerKey) {
+  auto tx = transfer(0, 1, 1);
+  tx.commands.push_back(transfer(0, 2, 1).commands.front());
+  tx.commands.push_back(transfer(0, 3, 1).commands.front());
+  std::mutex lock;
+  OverlayWsv overlay(wsv, lock);
+  std::vector<OverlayWsv::Operation> operations;
+
+  ASSERT_TRUE(overlay.apply(tx,
+                            [](const auto &tx, auto &executor, auto &query) {
+                              auto account = query.getAccount(
+                                  tx.creator_account_id);
+                              for (const auto &command : tx.commands) {
+                                if (not command->validate(query, *account)
+                                    or not command->execute(query, executor)) {
+                                  return false;
+                                }
+                              }
+                              return true;
+                            },
+                            operations));
+  ASSERT_EQ(6, operations.size());
+  ASSERT_EQ(1, wsv.asset_reads);
+}
+
+/**
+ * @given transaction creating domain
+ * @when its access is derived
+ * @then it is not parallel
+ */
+TEST_F(StatefulValidationTest, CreateDomainIsNotParallel) {
+  Transaction tx;
+  tx.creator_account_id = accountId(0);
+  tx.commands.push_back(std::make_shared<CreateDomain>());
+
+  ASSERT_FALSE(accessOf(tx).parallel);
+}
+
+/**
+ * @given proposal of dependent and independent transfers split by
+ * transaction which creates domain
+ * @when it is validated by several threads
+ * @then valid transactions and resulting balances are the same as
+ * with serial validation
+ */
+TEST_F(StatefulValidationTest, ParallelValidationMatchesSerial) {
+  auto txs = transfers(64);
+  Transaction barrier;
+  barrier.creator_account_id = accountId(0);
+  barrier.signatures.emplace_back();
+  auto create_domain = std::make_shared<CreateDomain>();
+  create_domain->domain_name = "other";
+  barrier.commands.push_back(create_domain);
+  txs.insert(txs.begin() + 32, barrier);
+  Proposal proposal(txs);
+  proposal.height = 3;
+
+  MemoryWsv serial_wsv = wsv;
+  auto serial = StatefulValidatorImpl(1).validate(proposal, serial_wsv);
+  auto parallel = StatefulValidatorImpl(4).validate(proposal, wsv);
+
+  ASSERT_EQ(3, parallel.height);
+  ASSERT_LT(parallel.transactions.size(), txs.size());
+  ASSERT_EQ(serial.transactions, parallel.transactions);
+  ASSERT_EQ(1, wsv.domains);
+  for (size_t i = 0; i < kAccounts; ++i) {
+    ASSERT_EQ(serial_wsv.account_assets[accountId(i)].balance,
+              wsv.account_assets[accountId(i)].balance);
+  }
+}
+
+/**
+ * @given proposal of dependent and independent transfers split by
+ * transaction which creates domain
+ * @when it is validated speculatively by several threads
+ * @then valid transactions and resulting balances are the same as
+ * with serial validation
+ */
+TEST_F(StatefulValidationTest, SpeculativeValidationMatchesSerial) {
+  auto txs = transfers(64);
+  Transaction barrier;
+  barrier.creator_account_id = accountId(0);
+  barrier.signatures.emplace_back();
+  auto create_domain = std::make_shared<CreateDomain>();
+  create_domain->domain_name = "other";
+  barrier.commands.push_back(create_domain);
+  txs.insert(txs.begin() + 32, barrier);
+  Proposal proposal(txs);
+
+  MemoryWsv serial_wsv = wsv;
+  auto serial = StatefulValidatorImpl(1).validate(proposal, serial_wsv);
+  auto speculative = StatefulValidatorImpl(4, true).validate(proposal, wsv);
+
+  ASSERT_LT(speculative.transactions.size(), txs.size());
+  ASSERT_EQ(serial.transactions, speculative.transactions);
+  ASSERT_EQ(1, wsv.domains);
+  for (size_t i = 0; i < kAccounts; ++i) {
+    ASSERT_EQ(serial_wsv.account_assets[accountId(i)].balance,
+              wsv.account_assets[accountId(i)].balance);
+  }
+}
+
+/**
+ * @given proposal where every account pays to the same account, until
+ * payers run out of funds
+ * @when it is validated speculatively by several threads
+ * @then result is the same as with serial validation
+ */
+TEST_F(StatefulValidationTest, SpeculativeValidationOfHotSpotMatchesSerial) {
+  std::vector<Transaction> txs;
+  for (size_t i = 0; i < 256; ++i) {
+    txs.push_back(transfer(1 + i % (kAccounts - 1), 0, 1 + i % 3));
+  }
+  Proposal proposal(txs);
+
+  MemoryWsv serial_wsv = wsv;
+  auto serial = StatefulValidatorImpl(1).validate(proposal, serial_wsv);
+  auto speculative = StatefulValidatorImpl(4, true).validate(proposal, wsv);
+
+  ASSERT_LT(speculative.transactions.size(), txs.size());
+  ASSERT_EQ(serial.transactions, speculative.transactions);
+  for (size_t i = 0; i < kAccounts; ++i) {
+    ASSERT_EQ(serial_wsv.account_assets[accountId(i)].balance,
+              wsv.account_assets[accountId(i)].balance);
+  }
+}
+
+/**
+ * @given transactions signed by key which is not signatory of creator,
+ * and by one signatory twice when quorum is two
+ * @when they are validated
+ * @then they are rejected
+ * @then transaction signed by signatory is accepted
+ */
+TEST_F(StatefulValidationTest, QuorumCountsDistinctSignatories) {
+  auto stranger = transfer(0, 1, 1);
+  stranger.signatures.front().pubkey.fill(1);
+
+  auto repeated = transfer(2, 3, 1);
+  repeated.signatures.emplace_back();
+  wsv.accounts[accountId(2)].quorum = 2;
+
+  auto signed_tx = transfer(4, 5, 1);
+
+  Proposal proposal({stranger, repeated, signed_tx});
+  auto verified = StatefulValidatorImpl(1).validate(proposal, wsv);
+
+  ASSERT_EQ(std::vector<Transaction>{signed_tx}, verified.transactions);
+}
+
+/**
+ * @given validator with time budget shorter than validation of one
+ * transaction
+ * @when proposal is validated
+ * @then only the first transaction is validated
+ * @then the rest are postponed in order of proposal
+ */
+TEST_F(StatefulValidationTest, TransactionsAfterDeadlineArePostponed) {
+  auto txs = transfers(4);
+  Proposal proposal(txs);
+  wsv.apply_delay = std::chrono::milliseconds(100);
+
+  std::vector<Transaction> postponed;
+  auto verified =
+      StatefulValidatorImpl(1, false, std::chrono::milliseconds(50))
+          .validate(proposal, wsv, postponed);
+
+  ASSERT_EQ(std::vector<Transaction>{txs.front()}, verified.transactions);
+  ASSERT_EQ(std::vector<Transaction>(txs.begin() + 1, txs.end()), postponed);
+}
+
+/**
+ * @given transactions of one creator with counters out of order, one of
+ * them replaying a counter already used, and an uncounted transaction
+ * @when proposal is validated
+ * @then counted transactions are applied in order of counters
+ * @then replayed counter is rejected and uncounted transaction accepted
+ * @then creator keeps the highest applied counter
+ */
+TEST_F(StatefulValidationTest, TxCountersRejectReplays) {
+  auto first = transfer(0, 1, 1);
+  first.tx_counter = 1;
+  auto second = transfer(0, 2, 1);
+  second.tx_counter = 2;
+  auto replay = transfer(0, 3, 1);
+  replay.tx_counter = 1;
+  auto uncounted = transfer(0, 4, 1);
+
+  Proposal proposal({second, uncounted, first, replay});
+  auto verified = StatefulValidatorImpl(1).validate(proposal, wsv);
+
+  ASSERT_EQ((std::vector<Transaction>{first, uncounted, second}),
+            verified.transactions);
+  ASSERT_EQ(2, wsv.accounts[accountId(0)].tx_counter);
+}
@@ -19,8 +19,11 @@
 #include <crypto/crypto.hpp>
 #include <model/model_crypto_provider_impl.hpp>
 #include <model/model_hash_provider_impl.hpp>
+#include "model/commands/set_quorum.hpp"
+#include "model/commands/transfer_asset.hpp"
 #include "validation/impl/stateless_validator_impl.hpp"
 #include <chrono>
+#include <limits>
 
 using namespace iroha::model;
 
@@ -126,3 +129,67 @@ TEST(stateless_validation,
 
   ASSERT_FALSE(transaction_validator.validate(tx));
 }
+
+/**
+ * @given transaction with well-formed transfer
+ * @when it is validated
+ * @then it passes stateless validation
+ */
+TEST(stateless_validation, stateless_validation_when_command_well_formed) {
+  auto keypair = iroha::create_keypair(iroha::create_seed());
+  iroha::validation::StatelessValidatorImpl transaction_validator(
+      std::make_shared<iroha::model::ModelCryptoProviderImpl>());
+
+  auto tx = create_transaction();
+  auto transfer = std::make_shared<TransferAsset>();
+  transfer->src_account_id = "alice@test";
+  transfer->dest_account_id = "bob@test";
+  transfer->asset_id = "coin#test";
+  transfer->amount = iroha::Amount(1, 50);
+  tx.commands.push_back(transfer);
+  sign(tx, keypair.privkey, keypair.pubkey);
+
+  ASSERT_TRUE(transaction_validator.validate(tx));
+}
+
+/**
+ * @given transactions with malformed identifiers, amounts and quorum
+ * @when they are validated
+ * @then they are rejected without world state view
+ */
+TEST(stateless_validation, stateless_validation_when_command_malformed) {
+  auto keypair = iroha::create_keypair(iroha::create_seed());
+  iroha::validation::StatelessValidatorImpl transaction_validator(
+      std::make_shared<iroha::model::ModelCryptoProviderImpl>());
+
+  auto validate = [&](std::shared_ptr<Command> command) {
+    auto tx = create_transaction();
+    tx.commands.push_back(command);
+    sign(tx, keypair.privkey, keypair.pubkey);
+    return transaction_validator.validate(tx);
+  };
+  auto transfer = [](std::string src, std::string asset, iroha::Amount amount) {
+    auto command = std::make_shared<TransferAsset>();
+    command->src_account_id = src;
+    command->dest_account_id = "bob@test";
+    command->asset_id = asset;
+    command->amount = amount;
+    return command;
+  };
+
+  ASSERT_FALSE(validate(transfer("alice", "coin#test", iroha::Amount(1, 0))));
+  ASSERT_FALSE(
+      validate(transfer("al ice@test", "coin#test", iroha::Amount(1, 0))));
+  ASSERT_FALSE(
+      validate(transfer("alice@test", "coin@test", iroha::Amount(1, 0))));
+  ASSERT_FALSE(validate(transfer("alice@test", "coin#test", iroha::Amount())));
+  ASSERT_FALSE(validate(transfer(
+      "alice@test",
+      "coin#test",
+      iroha::Amount(std::numeric_limits<uint64_t>::max(), 1))));
+
+  auto quorum = std::make_shared<SetQuorum>();
+  quorum->account_id = "alice@test";
+  quorum->new_quorum = 0;
+  ASSERT_FALSE(validate(quorum));
+}
@@ -0,0 +1,70 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "affinity/affinity.hpp"
+#include <gtest/gtest.h>
+#include <pthread.h>
+
+using namespace iroha::affinity;
+
+/**
+ * @given thread
+ * @when it is named with a long name
+ * @then name is truncated to the limit of the system
+ */
+TEST(Affinity, long_name_is_truncated) {
+  std::thread thread([] {
+    nameCurrentThread("consensus-loop-of-stage");
+    char name[16];
+    pthread_getname_np(pthread_self(), name, sizeof(name));
+    ASSERT_STREQ("consensus-loop-", name);
+  });
+  thread.join();
+}
+
+/**
+ * @given thread
+ * @when it is pinned to the first core it may run on
+ * @then it runs only on that core
+ */
+TEST(Affinity, thread_is_pinned) {
+  std::thread thread([] {
+    cpu_set_t allowed;
+    ASSERT_EQ(0,
+              pthread_getaffinity_np(pthread_self(), sizeof(allowed), &allowed));
+    int core = 0;
+    while (not CPU_ISSET(core, &allowed)) {
+      ++core;
+    }
+    ASSERT_TRUE(pinCurrentThread(core));
+    cpu_set_t pinned;
+    pthread_getaffinity_np(pthread_self(), sizeof(pinned), &pinned);
+    ASSERT_EQ(1, CPU_COUNT(&pinned));
+    ASSERT_TRUE(CPU_ISSET(core, &pinned));
+  });
+  thread.join();
+}
+
+/**
+ * @given negative core and node
+ * @when thread is pinned and bound
+ * @then nothing is done and it succeeds
+ */
+TEST(Affinity, negative_index_is_no_op) {
+  ASSERT_TRUE(pinCurrentThread(-1));
+  ASSERT_TRUE(bindCurrentThreadToNode(-1));
+}
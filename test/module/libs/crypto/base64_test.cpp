@@ -165,3 +165,28 @@ TEST(Base64, HennaMozi) {
   int original_text_length = strlen((char*)original);
   test_text_equals_original_text(original, original_text_length);
 }
+
+/**
+ * @given binary strings of every length up to two groups
+ * @when they are encoded and decoded back
+ * @then padding matches length and decoded bytes equal original ones
+ */
+TEST(Base64, EncodeAndDecodeEveryTailLength) {
+  std::vector<unsigned char> original;
+  for (size_t length = 0; length <= 6; ++length) {
+    auto encoded = base64_encode(original.data(), original.size());
+    ASSERT_EQ((length + 2) / 3 * 4, encoded.size());
+    ASSERT_EQ(original, base64_decode(encoded));
+    original.push_back(static_cast<unsigned char>(0xF0 + length));
+  }
+}
+
+/**
+ * @given base64 string which is broken in the middle
+ * @when it is decoded
+ * @then only the part before the broken character is decoded
+ */
+TEST(Base64, DecodeStopsAtInvalidCharacter) {
+  std::vector<unsigned char> expected{'a', 'b', 'c'};
+  ASSERT_EQ(expected, base64_decode("YWJj?ZGVm"));
+}
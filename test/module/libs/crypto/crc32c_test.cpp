@@ -0,0 +1,51 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <crypto/crc32c.hpp>
+#include <string>
+#include <vector>
+
+using iroha::crc32c;
+
+// Check values from RFC 3720, appendix B.4
+
+TEST(Crc32c, check_value) {
+  std::string str("123456789");
+  ASSERT_EQ(crc32c(reinterpret_cast<const uint8_t *>(str.data()), str.size()),
+            0xe3069283);
+}
+
+TEST(Crc32c, zeros) {
+  std::vector<uint8_t> zeros(32, 0);
+  ASSERT_EQ(crc32c(zeros.data(), zeros.size()), 0x8a9136aa);
+}
+
+TEST(Crc32c, ones) {
+  std::vector<uint8_t> ones(32, 0xff);
+  ASSERT_EQ(crc32c(ones.data(), ones.size()), 0x62a8ab43);
+}
+
+TEST(Crc32c, incremental) {
+  std::vector<uint8_t> data(100);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = i;
+  }
+  auto crc = crc32c(data.data(), 37);
+  ASSERT_EQ(crc32c(data.data() + 37, data.size() - 37, crc),
+            crc32c(data.data(), data.size()));
+}
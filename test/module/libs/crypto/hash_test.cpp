@@ -16,6 +16,7 @@ limitations under the License.
 
 #include <gtest/gtest.h>
 #include <crypto/hash.hpp>
+#include <unordered_map>
 
 #define LOOP_N (100)
 
@@ -146,3 +147,73 @@ TEST(Hash, sha3_512_RU_text_LOOP) {
                  res.c_str());
   }
 }
+
+TEST(Hash, sha3_256_incremental_text) {
+  std::string res =
+      "cb7c96616a2466df29a1edc2979ef5080945f92d1907c08a55b502eba063d638";
+  iroha::Sha3_256 hasher;
+  hasher.update("Is the Order ").update("a distributed ").update("ledger?");
+  ASSERT_STREQ(hasher.final().to_hexstring().c_str(), res.c_str());
+}
+
+/**
+ * @given message longer than several blocks of sha3-256
+ * @when message is hashed by parts of every size
+ * @then digest is equal to digest of the whole message
+ */
+TEST(Hash, sha3_256_incremental_equals_oneshot) {
+  std::vector<uint8_t> str(1000);
+  for (size_t i = 0; i < str.size(); ++i) {
+    str[i] = static_cast<uint8_t>(i * 31 + 7);
+  }
+  for (size_t length : {0, 1, 135, 136, 137, 272, 1000}) {
+    auto expected = sha3_256(str.data(), length);
+    for (size_t part = 1; part <= 300; part += 37) {
+      iroha::Sha3_256 hasher;
+      for (size_t offset = 0; offset < length; offset += part) {
+        hasher.update(str.data() + offset, std::min(part, length - offset));
+      }
+      ASSERT_EQ(expected, hasher.final()) << length << " by " << part;
+    }
+  }
+}
+
+/**
+ * @given messages of different lengths, more than hashed at once
+ * @when they are hashed in batch
+ * @then every digest is equal to digest of the message alone
+ */
+TEST(Hash, sha3_256_batch_equals_oneshot) {
+  std::vector<std::string> messages;
+  for (size_t length : {0, 5, 135, 136, 137, 300, 1000}) {
+    messages.emplace_back(length, static_cast<char>('a' + length % 26));
+  }
+  auto digests = iroha::sha3_256_batch(messages);
+  ASSERT_EQ(messages.size(), digests.size());
+  for (size_t i = 0; i < messages.size(); ++i) {
+    const auto &message = messages[i];
+    ASSERT_EQ(sha3_256(reinterpret_cast<const uint8_t *>(message.data()),
+                       message.size()),
+              digests[i]);
+  }
+}
+
+/**
+ * @given hashes of different messages
+ * @when they are used as keys of unordered map and written as hex
+ * @then map finds them without conversion, hex matches string version
+ */
+TEST(Hash, blob_is_unordered_map_key) {
+  std::unordered_map<iroha::hash256_t, int> map;
+  for (int i = 0; i < 100; ++i) {
+    auto message = std::to_string(i);
+    map[iroha::Sha3_256().update(message).final()] = i;
+  }
+  ASSERT_EQ(100, map.size());
+  auto hash = iroha::Sha3_256().update("42").final();
+  ASSERT_EQ(42, map.at(hash));
+
+  char hex[2 * iroha::hash256_t::size()];
+  hash.to_hexstring(hex);
+  ASSERT_EQ(hash.to_hexstring(), std::string(hex, sizeof(hex)));
+}
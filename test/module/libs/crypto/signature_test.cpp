@@ -18,6 +18,7 @@ limitations under the License.
 #include <common/types.hpp>
 #include <crypto/base64.hpp>
 #include <crypto/crypto.hpp>
+#include <crypto/signature_cache.hpp>
 
 #include <gtest/gtest.h>
 
@@ -116,3 +117,142 @@ TEST(Signature, generatedByGO) {
 
   ASSERT_TRUE(verify(message.data(), message.size(), pubkey, signature));
 }
+
+/**
+ * @given batch of messages signed by different keys
+ * @when batch is verified
+ * @then it is valid, and invalid once any signature is corrupted
+ */
+TEST(Signature, VerifyBatch) {
+  std::vector<std::string> messages;
+  for (int i = 0; i < 64; ++i) {
+    messages.push_back("message " + std::to_string(i));
+  }
+  std::vector<iroha::SignedMessage> batch;
+  for (const auto &message : messages) {
+    auto keypair = create_keypair(create_seed());
+    auto data = reinterpret_cast<const uint8_t *>(message.data());
+    batch.push_back(
+        {data, message.size(), keypair.pubkey,
+         sign(data, message.size(), keypair.pubkey, keypair.privkey)});
+  }
+  ASSERT_TRUE(iroha::verify_batch(batch));
+
+  batch.back().sig[0] ^= 1;
+  ASSERT_FALSE(iroha::verify_batch(batch));
+
+  batch.resize(2);
+  ASSERT_TRUE(iroha::verify_batch(batch));
+}
+
+/**
+ * @given signature cache
+ * @when valid and invalid signatures are verified through it
+ * @then only valid ones are remembered and answered from cache
+ */
+TEST(Signature, CacheKeepsValidSignatures) {
+  iroha::SignatureCache cache;
+  auto keypair = create_keypair(create_seed());
+  std::vector<std::string> messages{"first", "second"};
+  std::vector<ed25519::sig_t> signatures;
+  for (const auto &message : messages) {
+    auto data = reinterpret_cast<const uint8_t *>(message.data());
+    signatures.push_back(
+        sign(data, message.size(), keypair.pubkey, keypair.privkey));
+  }
+  auto check = [&](size_t i, const ed25519::sig_t &signature) {
+    return cache.verify(reinterpret_cast<const uint8_t *>(messages[i].data()),
+                        messages[i].size(),
+                        keypair.pubkey,
+                        signature);
+  };
+
+  ASSERT_TRUE(check(0, signatures[0]));
+  ASSERT_TRUE(check(0, signatures[0]));
+  ASSERT_EQ(1, cache.size());
+  ASSERT_EQ(1, cache.hits());
+  ASSERT_EQ(1, cache.misses());
+
+  // signature of another message is not valid for this one
+  ASSERT_FALSE(check(0, signatures[1]));
+  ASSERT_EQ(1, cache.size());
+  ASSERT_EQ(2, cache.misses());
+}
+
+/**
+ * @given cache with one signature per shard
+ * @when more signatures are verified
+ * @then cache size stays within capacity
+ */
+TEST(Signature, CacheIsBounded) {
+  iroha::SignatureCache cache(iroha::SignatureCache::kShards);
+  auto keypair = create_keypair(create_seed());
+  for (int i = 0; i < 100; ++i) {
+    auto message = std::to_string(i);
+    auto data = reinterpret_cast<const uint8_t *>(message.data());
+    auto signature =
+        sign(data, message.size(), keypair.pubkey, keypair.privkey);
+    ASSERT_TRUE(
+        cache.verify(data, message.size(), keypair.pubkey, signature));
+  }
+  ASSERT_LE(cache.size(), iroha::SignatureCache::kShards);
+  ASSERT_EQ(100, cache.misses());
+}
+
+/**
+ * @given multisig batch with one corrupted signature of five
+ * @when quorum of signatures is verified
+ * @then quorum up to four valid signatures is reached, five is not
+ */
+TEST(Signature, VerifyQuorum) {
+  std::string message = "multisig transaction";
+  auto data = reinterpret_cast<const uint8_t *>(message.data());
+  std::vector<iroha::SignedMessage> batch;
+  for (int i = 0; i < 5; ++i) {
+    auto keypair = create_keypair(create_seed());
+    batch.push_back(
+        {data, message.size(), keypair.pubkey,
+         sign(data, message.size(), keypair.pubkey, keypair.privkey)});
+  }
+  batch[2].sig[0] ^= 1;
+
+  ASSERT_TRUE(iroha::verify_quorum(batch, 0));
+  ASSERT_TRUE(iroha::verify_quorum(batch, 4));
+  ASSERT_FALSE(iroha::verify_quorum(batch, 5));
+  ASSERT_FALSE(iroha::verify_quorum(batch, 6));
+
+  iroha::SignatureCache cache;
+  ASSERT_FALSE(cache.verify_quorum(batch, 5));
+  ASSERT_TRUE(cache.verify_quorum(batch, 4));
+  batch.erase(batch.begin() + 2);
+  ASSERT_TRUE(cache.verify_quorum(batch, 4));
+  ASSERT_EQ(4, cache.size());
+  ASSERT_TRUE(cache.verify_quorum(batch, 4));
+  ASSERT_EQ(4, cache.hits());
+}
+
+/**
+ * @given signatory whose key was seen by verify
+ * @when its other signatures are verified
+ * @then point of the key is taken from the cache, and corrupted
+ * signatures and messages are still rejected
+ */
+TEST(Signature, KeyPointIsReused) {
+  auto keypair = create_keypair(create_seed());
+  std::string first = "first transaction", second = "second transaction";
+  auto first_data = reinterpret_cast<const uint8_t *>(first.data());
+  auto second_data = reinterpret_cast<const uint8_t *>(second.data());
+  auto first_sig =
+      sign(first_data, first.size(), keypair.pubkey, keypair.privkey);
+  auto second_sig =
+      sign(second_data, second.size(), keypair.pubkey, keypair.privkey);
+
+  ASSERT_TRUE(verify(first_data, first.size(), keypair.pubkey, first_sig));
+  auto hits = iroha::key_points_hits();
+  ASSERT_TRUE(verify(second_data, second.size(), keypair.pubkey, second_sig));
+  ASSERT_EQ(hits + 1, iroha::key_points_hits());
+
+  ASSERT_FALSE(verify(first_data, first.size(), keypair.pubkey, second_sig));
+  second_sig[40] ^= 1;
+  ASSERT_FALSE(verify(second_data, second.size(), keypair.pubkey, second_sig));
+}
@@ -0,0 +1,101 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "crypto/signer.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <future>
+
+using namespace iroha;
+
+/**
+ * Signer which is slow like a remote one and counts round trips
+ */
+class SlowSigner : public Signer {
+ public:
+  explicit SlowSigner(const ed25519::keypair_t &keypair) : local_(keypair) {}
+
+  ed25519::pubkey_t publicKey() const override {
+    return local_.publicKey();
+  }
+
+  std::vector<ed25519::sig_t> signBatch(
+      const std::vector<Message> &messages) override {
+    ++round_trips;
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    return local_.signBatch(messages);
+  }
+
+  std::atomic<size_t> round_trips{0};
+
+ private:
+  KeypairSigner local_;
+};
+
+class SignerTest : public ::testing::Test {
+ public:
+  Signer::Message message(size_t i) {
+    return {static_cast<uint8_t>(i), 1, 2, 3};
+  }
+
+  ed25519::keypair_t keypair = create_keypair(create_seed());
+};
+
+/**
+ * @given signer with key pair in memory
+ * @when batch of messages is signed
+ * @then each signature is valid for its message
+ */
+TEST_F(SignerTest, KeypairSignerSignsBatch) {
+  KeypairSigner signer(keypair);
+  std::vector<Signer::Message> messages{message(0), message(1)};
+  auto signatures = signer.signBatch(messages);
+
+  ASSERT_EQ(messages.size(), signatures.size());
+  for (size_t i = 0; i < messages.size(); ++i) {
+    ASSERT_TRUE(verify(messages[i].data(),
+                       messages[i].size(),
+                       signer.publicKey(),
+                       signatures[i]));
+  }
+}
+
+/**
+ * @given batching signer over slow signer
+ * @when many messages are signed asynchronously at once
+ * @then every callback gets valid signature, and messages share round trips
+ */
+TEST_F(SignerTest, BatchingSignerSharesRoundTrips) {
+  constexpr size_t kMessages = 100;
+  auto slow = std::make_shared<SlowSigner>(keypair);
+  std::vector<std::promise<ed25519::sig_t>> promises(kMessages);
+  {
+    BatchingSigner signer(slow, 16, 2);
+    for (size_t i = 0; i < kMessages; ++i) {
+      signer.signAsync(message(i), [&promises, i](const auto &signature) {
+        promises[i].set_value(signature);
+      });
+    }
+  }
+
+  for (size_t i = 0; i < kMessages; ++i) {
+    auto signature = promises[i].get_future().get();
+    auto msg = message(i);
+    ASSERT_TRUE(verify(msg.data(), msg.size(), keypair.pubkey, signature));
+  }
+  ASSERT_LT(slow->round_trips, kMessages / 4);
+}
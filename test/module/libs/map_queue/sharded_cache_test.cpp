@@ -0,0 +1,120 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include "map_queue/sharded_cache.hpp"
+
+using namespace std::chrono_literals;
+using Cache = structure::ShardedCache<int, std::string>;
+
+/**
+ * @given cache of one shard holding two entries
+ * @when the first entry is used and the third one is put
+ * @then the second entry, least recently used, is evicted
+ */
+TEST(ShardedCacheTest, LeastRecentlyUsedIsEvicted) {
+  Cache cache(2, 1);
+  cache.put(1, "a");
+  cache.put(2, "b");
+  ASSERT_EQ(std::string("a"), cache.get(1).value());
+  cache.put(3, "c");
+
+  ASSERT_TRUE(cache.contains(1));
+  ASSERT_FALSE(cache.contains(2));
+  ASSERT_TRUE(cache.contains(3));
+  ASSERT_EQ(2u, cache.size());
+
+  auto stats = cache.stats();
+  ASSERT_EQ(3u, stats.hits);
+  ASSERT_EQ(1u, stats.misses);
+  ASSERT_EQ(1u, stats.evictions);
+}
+
+/**
+ * @given cache limited by bytes, entry size is length of value
+ * @when entries over the limit are put, and entry is replaced
+ * @then oldest entries are evicted to fit the limit, and replacement
+ * is accounted by its new size
+ */
+TEST(ShardedCacheTest, BytesAreAccounted) {
+  Cache cache(100, 1, Cache::Clock::duration::zero(), 10,
+              [](int, const std::string &value) { return value.size(); });
+  cache.put(1, "aaaa");
+  cache.put(2, "bbbb");
+  ASSERT_EQ(8u, cache.bytes());
+  cache.put(3, "cccc");
+  ASSERT_FALSE(cache.contains(1));
+  ASSERT_EQ(8u, cache.bytes());
+
+  cache.put(3, "c");
+  ASSERT_EQ(5u, cache.bytes());
+  cache.put(4, std::string(11, 'd'));
+  ASSERT_FALSE(cache.contains(4));
+
+  ASSERT_TRUE(cache.erase(2));
+  ASSERT_FALSE(cache.erase(2));
+  ASSERT_EQ(1u, cache.bytes());
+}
+
+/**
+ * @given cache with time to live
+ * @when entry is looked up after it expired
+ * @then it is absent and counted as expired
+ */
+TEST(ShardedCacheTest, ExpiredEntryIsDropped) {
+  Cache cache(10, 1, 10ms);
+  cache.put(1, "a");
+  ASSERT_TRUE(cache.contains(1));
+  std::this_thread::sleep_for(20ms);
+  ASSERT_FALSE(cache.get(1));
+  ASSERT_EQ(0u, cache.size());
+  ASSERT_EQ(1u, cache.stats().expirations);
+}
+
+/**
+ * @given sharded cache
+ * @when threads put and get disjoint keys concurrently
+ * @then every thread finds all of its entries
+ */
+TEST(ShardedCacheTest, ConcurrentAccess) {
+  const int threads = 4, keys = 1000;
+  Cache cache(threads * keys);
+  std::vector<std::thread> workers;
+  std::vector<int> found(threads, 0);
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      for (int i = 0; i < keys; ++i) {
+        cache.put(t * keys + i, std::to_string(i));
+      }
+      for (int i = 0; i < keys; ++i) {
+        auto value = cache.get(t * keys + i);
+        if (value and *value == std::to_string(i)) {
+          ++found[t];
+        }
+      }
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  for (auto count : found) {
+    ASSERT_LE(keys * 9 / 10, count);
+  }
+}
@@ -0,0 +1,128 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "memory/memory_budget.hpp"
+#include "metrics/metrics.hpp"
+
+using namespace iroha::memory;
+
+/**
+ * Subsystem whose usage is a plain counter
+ */
+struct FakeSubsystem {
+  size_t bytes;
+  std::vector<size_t> requests;
+
+  size_t release(size_t amount) {
+    requests.push_back(amount);
+    auto released = std::min(amount, bytes);
+    bytes -= released;
+    return released;
+  }
+};
+
+/**
+ * @given budget without limit
+ * @when it is enforced
+ * @then usage is summed and exported, and nothing is released
+ */
+TEST(MemoryBudget, unlimited_budget_only_accounts) {
+  MemoryBudget budget;
+  FakeSubsystem cache{100, {}};
+  budget.add("test_unlimited",
+             0,
+             [&] { return cache.bytes; },
+             [&](size_t bytes) { return cache.release(bytes); });
+  ASSERT_EQ(100, budget.enforce());
+  ASSERT_TRUE(cache.requests.empty());
+  ASSERT_NE(std::string::npos,
+            iroha::metrics::registry().render().find(
+                "iroha_memory_bytes{subsystem=\"test_unlimited\"} 100"));
+}
+
+/**
+ * @given budget over its limit with subsystems of different priority
+ * @when it is enforced
+ * @then subsystems release the excess in order of priority, and the
+ * accounted-only one is not asked
+ */
+TEST(MemoryBudget, excess_is_released_by_priority) {
+  MemoryBudget budget(150);
+  FakeSubsystem first{30, {}};
+  FakeSubsystem second{100, {}};
+  FakeSubsystem third{50, {}};
+  size_t queue = 20;
+  budget.add("test_second", 1, [&] { return second.bytes; }, [&](size_t b) {
+    return second.release(b);
+  });
+  budget.add("test_queue", 0, [&] { return queue; });
+  budget.add("test_first", 0, [&] { return first.bytes; }, [&](size_t b) {
+    return first.release(b);
+  });
+  budget.add("test_third", 2, [&] { return third.bytes; }, [&](size_t b) {
+    return third.release(b);
+  });
+
+  ASSERT_EQ(150, budget.enforce());
+  // 200 bytes held, first releases all 30 of 50 asked, second the rest
+  ASSERT_EQ(std::vector<size_t>{50}, first.requests);
+  ASSERT_EQ(std::vector<size_t>{20}, second.requests);
+  ASSERT_TRUE(third.requests.empty());
+  ASSERT_EQ(0, first.bytes);
+  ASSERT_EQ(80, second.bytes);
+}
+
+/**
+ * @given budget with removed subsystem
+ * @when it is enforced
+ * @then removed subsystem is not called
+ */
+TEST(MemoryBudget, removed_subsystem_is_not_called) {
+  MemoryBudget budget(1);
+  bool called = false;
+  auto id = budget.add("test_removed", 0, [&] {
+    called = true;
+    return size_t(10);
+  });
+  budget.remove(id);
+  ASSERT_EQ(0, budget.enforce());
+  ASSERT_FALSE(called);
+}
+
+/**
+ * @given budget enforced periodically
+ * @when subsystem exceeds the limit
+ * @then it is shrunk by background enforcement
+ */
+TEST(MemoryBudget, periodic_enforcement) {
+  MemoryBudget budget(10);
+  std::atomic<size_t> bytes{100};
+  budget.add("test_periodic", 0, [&] { return bytes.load(); }, [&](size_t b) {
+    bytes -= b;
+    return b;
+  });
+  budget.start(std::chrono::milliseconds(1));
+  for (int i = 0; i < 1000 and bytes > 10; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  budget.stop();
+  ASSERT_EQ(10, bytes);
+}
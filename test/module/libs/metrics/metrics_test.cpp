@@ -0,0 +1,133 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <arpa/inet.h>
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <thread>
+#include "metrics/metrics.hpp"
+#include "metrics/metrics_server.hpp"
+
+using namespace iroha::metrics;
+
+TEST(Metrics, counter_sums_threads) {
+  Counter counter;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; ++i) {
+    threads.emplace_back([&counter] {
+      for (int j = 0; j < 1000; ++j) {
+        counter.inc();
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(counter.value(), 8000u);
+}
+
+TEST(Metrics, histogram_buckets) {
+  Histogram histogram({1, 10});
+  histogram.observe(0.5);
+  histogram.observe(1);
+  histogram.observe(5);
+  histogram.observe(100);
+  ASSERT_EQ(histogram.buckets(), std::vector<uint64_t>({2, 1, 1}));
+  ASSERT_EQ(histogram.count(), 4u);
+  ASSERT_DOUBLE_EQ(histogram.sum(), 106.5);
+}
+
+TEST(Metrics, render) {
+  Registry registry;
+  registry.counter("requests_total", "Requests", {{"type", "a"}}).inc(3);
+  registry.gauge("depth", "Depth").set(-2);
+  registry.histogram("latency", "Latency", {1}).observe(2);
+  registry.collect([] { return std::string("extra 1\n"); });
+
+  auto text = registry.render();
+  ASSERT_NE(text.find("# TYPE requests_total counter\n"
+                      "requests_total{type=\"a\"} 3\n"),
+            std::string::npos);
+  ASSERT_NE(text.find("depth -2\n"), std::string::npos);
+  ASSERT_NE(text.find("latency_bucket{le=\"1\"} 0\n"
+                      "latency_bucket{le=\"+Inf\"} 1\n"
+                      "latency_sum 2\n"
+                      "latency_count 1\n"),
+            std::string::npos);
+  ASSERT_NE(text.find("extra 1\n"), std::string::npos);
+}
+
+TEST(Metrics, same_series_is_shared) {
+  Registry registry;
+  auto &first = registry.counter("c", "C");
+  auto &second = registry.counter("c", "C");
+  ASSERT_EQ(&first, &second);
+  ASSERT_THROW(registry.gauge("c", "C"), std::invalid_argument);
+}
+
+namespace {
+  std::string get(int port, const std::string &path) {
+    auto client = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    connect(client, reinterpret_cast<sockaddr *>(&address), sizeof(address));
+    auto request = "GET " + path + " HTTP/1.1\r\nHost: x\r\n\r\n";
+    send(client, request.data(), request.size(), 0);
+    std::string response;
+    char buffer[1024];
+    ssize_t received;
+    while ((received = recv(client, buffer, sizeof(buffer), 0)) > 0) {
+      response.append(buffer, received);
+    }
+    close(client);
+    return response;
+  }
+}  // namespace
+
+TEST(MetricsServer, serves_metrics) {
+  MetricsServer server("127.0.0.1:0", [] { return std::string("up 1\n"); });
+  auto response = get(server.port(), "/metrics");
+  ASSERT_EQ(response.compare(0, 15, "HTTP/1.1 200 OK"), 0);
+  ASSERT_NE(response.find("\r\n\r\nup 1\n"), std::string::npos);
+  ASSERT_NE(get(server.port(), "/").find("404"), std::string::npos);
+}
+
+TEST(MetricsServer, serves_handlers_with_query) {
+  MetricsServer server(
+      "127.0.0.1:0",
+      [] { return std::string(); },
+      {{"/debug/echo", [](const std::string &query) { return query; }}});
+  auto response = get(server.port(), "/debug/echo?seconds=5");
+  ASSERT_EQ(response.compare(0, 15, "HTTP/1.1 200 OK"), 0);
+  ASSERT_NE(response.find("\r\n\r\nseconds=5"), std::string::npos);
+  ASSERT_NE(get(server.port(), "/debug").find("404"), std::string::npos);
+}
+
+TEST(Metrics, startup_phases) {
+  StartupPhases phases;
+  phases.mark("first");
+  phases.mark("second");
+
+  auto text = registry().render();
+  ASSERT_NE(std::string::npos,
+            text.find("iroha_startup_phase_milliseconds{phase=\"first\"}"));
+  ASSERT_NE(std::string::npos,
+            text.find("iroha_startup_phase_milliseconds{phase=\"second\"}"));
+}
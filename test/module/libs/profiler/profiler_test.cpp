@@ -0,0 +1,64 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <atomic>
+#include <sstream>
+#include <thread>
+#include "profiler/profiler.hpp"
+
+using namespace iroha::profiler;
+
+/**
+ * Keeps CPU busy until stopped, so it appears in profile
+ */
+__attribute__((noinline)) void spinUntil(const std::atomic<bool> &stopped) {
+  volatile uint64_t counter = 0;
+  while (not stopped) {
+    counter = counter + 1;
+  }
+}
+
+TEST(ProfilerTest, busy_function_is_sampled) {
+  std::atomic<bool> stopped{false};
+  std::thread worker([&stopped] { spinUntil(stopped); });
+  auto profile = profiler().profile(std::chrono::milliseconds(500), 200);
+  stopped = true;
+  worker.join();
+
+  ASSERT_TRUE(profile);
+  ASSERT_NE(profile->find("spinUntil"), std::string::npos) << *profile;
+
+  // every line is a stack followed by its count
+  std::istringstream lines(*profile);
+  std::string line;
+  size_t total = 0;
+  while (std::getline(lines, line)) {
+    auto space = line.rfind(' ');
+    ASSERT_NE(space, std::string::npos) << line;
+    total += std::stoul(line.substr(space + 1));
+  }
+  ASSERT_GT(total, 0u);
+}
+
+TEST(ProfilerTest, concurrent_profile_is_refused) {
+  std::thread first(
+      [] { profiler().profile(std::chrono::milliseconds(300)); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  ASSERT_FALSE(profiler().profile(std::chrono::milliseconds(10)));
+  first.join();
+  ASSERT_TRUE(profiler().profile(std::chrono::milliseconds(10)));
+}
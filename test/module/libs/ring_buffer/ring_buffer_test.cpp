@@ -0,0 +1,155 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "ring_buffer/ring_buffer.hpp"
+
+using namespace iroha;
+
+template <typename Buffer>
+class RingBufferTest : public ::testing::Test {};
+
+using Buffers = ::testing::Types<SpscRingBuffer<size_t, SpinWait>,
+                                 SpscRingBuffer<size_t, BlockingWait>,
+                                 MpmcRingBuffer<size_t, SpinWait>,
+                                 MpmcRingBuffer<size_t, BlockingWait>>;
+TYPED_TEST_CASE(RingBufferTest, Buffers);
+
+/**
+ * @given empty buffer of capacity which is not power of two
+ * @when values are pushed until it is full and popped back
+ * @then capacity is rounded up, pushes over it are refused and values
+ * are popped in order of pushing
+ */
+TYPED_TEST(RingBufferTest, BoundedFifo) {
+  TypeParam buffer(3);
+  ASSERT_EQ(4u, buffer.capacity());
+
+  for (size_t i = 0; i < 4; ++i) {
+    ASSERT_TRUE(buffer.tryPush(size_t(i)));
+  }
+  ASSERT_FALSE(buffer.tryPush(4u));
+  ASSERT_EQ(4u, buffer.size());
+
+  size_t value;
+  for (size_t i = 0; i < 4; ++i) {
+    ASSERT_TRUE(buffer.tryPop(value));
+    ASSERT_EQ(i, value);
+  }
+  ASSERT_FALSE(buffer.tryPop(value));
+  ASSERT_EQ(0u, buffer.size());
+}
+
+/**
+ * @given buffer with values, and consumer waiting on empty buffer
+ * @when buffer is closed
+ * @then pushes are refused, remaining values are popped, and then pop
+ * returns false instead of waiting
+ */
+TYPED_TEST(RingBufferTest, CloseWakesUpConsumer) {
+  TypeParam buffer(4);
+  ASSERT_TRUE(buffer.push(1u));
+
+  size_t value;
+  ASSERT_TRUE(buffer.pop(value));
+  std::thread consumer([&] { ASSERT_FALSE(buffer.pop(value)); });
+  buffer.close();
+  consumer.join();
+
+  ASSERT_FALSE(buffer.push(2u));
+}
+
+/**
+ * @given buffer smaller than number of transferred values
+ * @when one producer pushes values while one consumer pops them
+ * @then producer waits for free space, and all values are received in
+ * order
+ */
+TYPED_TEST(RingBufferTest, ProducerWaitsForConsumer) {
+  const size_t count = 100000;
+  TypeParam buffer(16);
+
+  std::thread producer([&] {
+    for (size_t i = 0; i < count; ++i) {
+      ASSERT_TRUE(buffer.push(size_t(i)));
+    }
+  });
+  size_t value;
+  for (size_t i = 0; i < count; ++i) {
+    ASSERT_TRUE(buffer.pop(value));
+    ASSERT_EQ(i, value);
+  }
+  producer.join();
+}
+
+/**
+ * @given mpmc buffer
+ * @when several producers push distinct values and several consumers pop
+ * them concurrently
+ * @then every value is popped exactly once, values of each producer in
+ * order of pushing
+ */
+TEST(MpmcRingBufferTest, ValuesAreDeliveredOnce) {
+  const size_t producers = 4, consumers = 4, count = 20000;
+  MpmcRingBuffer<size_t> buffer(64);
+
+  std::vector<std::vector<size_t>> received(consumers);
+  std::vector<std::thread> threads;
+  for (size_t c = 0; c < consumers; ++c) {
+    threads.emplace_back([&, c] {
+      size_t value;
+      while (buffer.pop(value)) {
+        received[c].push_back(value);
+      }
+    });
+  }
+  std::vector<std::thread> producing;
+  for (size_t p = 0; p < producers; ++p) {
+    producing.emplace_back([&, p] {
+      for (size_t i = 0; i < count; ++i) {
+        buffer.push(p * count + i);
+      }
+    });
+  }
+  for (auto &thread : producing) {
+    thread.join();
+  }
+  buffer.close();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  std::vector<size_t> times(producers * count, 0);
+  for (const auto &values : received) {
+    std::vector<size_t> last(producers, 0);
+    std::vector<bool> seen(producers, false);
+    for (auto value : values) {
+      ++times[value];
+      auto p = value / count;
+      if (seen[p]) {
+        ASSERT_LT(last[p], value);
+      }
+      seen[p] = true;
+      last[p] = value;
+    }
+  }
+  for (auto t : times) {
+    ASSERT_EQ(1u, t);
+  }
+}
@@ -0,0 +1,91 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <future>
+#include <mutex>
+#include <vector>
+#include "timer/timer_wheel.hpp"
+
+using namespace std::chrono;
+using timer::TimerWheel;
+
+/**
+ * @given timer wheel
+ * @when timers are scheduled in reverse order of their delays
+ * @then scheduling does not wait, and timers fire in order of deadlines,
+ * not earlier than their delays
+ */
+TEST(TimerWheelTest, TimersFireInOrderOfDeadlines) {
+  TimerWheel wheel;
+  std::mutex mutex;
+  std::vector<int> fired;
+  std::promise<void> done;
+
+  auto start = steady_clock::now();
+  for (int i = 3; i > 0; --i) {
+    wheel.schedule(milliseconds(20 * i), [&, i, start] {
+      ASSERT_LE(milliseconds(20 * i), steady_clock::now() - start);
+      std::lock_guard<std::mutex> lock(mutex);
+      fired.push_back(i);
+      if (fired.size() == 3) {
+        done.set_value();
+      }
+    });
+  }
+  ASSERT_GT(milliseconds(20), steady_clock::now() - start);
+  ASSERT_EQ(3u, wheel.pending());
+
+  ASSERT_EQ(std::future_status::ready,
+            done.get_future().wait_for(seconds(5)));
+  ASSERT_EQ(std::vector<int>({1, 2, 3}), fired);
+  ASSERT_EQ(0u, wheel.pending());
+}
+
+/**
+ * @given timer wheel with timer
+ * @when timer is cancelled before its deadline
+ * @then it does not fire, and cannot be cancelled again
+ */
+TEST(TimerWheelTest, CancelledTimerDoesNotFire) {
+  TimerWheel wheel;
+  std::promise<void> later;
+  auto cancelled = wheel.schedule(milliseconds(10), [] { FAIL(); });
+  wheel.schedule(milliseconds(50), [&] { later.set_value(); });
+
+  ASSERT_TRUE(wheel.cancel(cancelled));
+  ASSERT_FALSE(wheel.cancel(cancelled));
+  ASSERT_EQ(std::future_status::ready,
+            later.get_future().wait_for(seconds(5)));
+}
+
+/**
+ * @given timer wheel with 1ms tick
+ * @when timer is due beyond the first two levels of the wheel
+ * @then it is moved down the levels and fires after its delay
+ */
+TEST(TimerWheelTest, FarTimerIsCascaded) {
+  TimerWheel wheel(milliseconds(1));
+  std::promise<void> fired;
+  auto start = steady_clock::now();
+  // 64^2 ticks, due in the third level
+  wheel.schedule(milliseconds(4100), [&] { fired.set_value(); });
+
+  ASSERT_EQ(std::future_status::ready,
+            fired.get_future().wait_for(seconds(10)));
+  ASSERT_LE(milliseconds(4100), steady_clock::now() - start);
+}
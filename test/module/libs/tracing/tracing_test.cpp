@@ -0,0 +1,112 @@
+/**
+ * Copyright Soramitsu Co., Ltd. 2017 All Rights Reserved.
+ * http://soramitsu.co.jp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include "tracing/tracing.hpp"
+
+using namespace iroha::tracing;
+
+TEST(TraceContext, traceparent_round_trip) {
+  auto value = "00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01";
+  auto context = TraceContext::parse(value);
+  ASSERT_TRUE(context);
+  ASSERT_TRUE(context->sampled);
+  ASSERT_EQ(context->traceparent(), value);
+}
+
+TEST(TraceContext, malformed_is_rejected) {
+  for (auto value :
+       {"",
+        "00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7",
+        "00-00000000000000000000000000000000-00f067aa0ba902b7-01",
+        "00-4bf92f3577b34da6a3ce929d0e0e4736-0000000000000000-01",
+        "00-4BF92F3577B34DA6A3CE929D0E0E4736-00f067aa0ba902b7-01",
+        "ff-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01",
+        "00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01-x"}) {
+    ASSERT_FALSE(TraceContext::parse(value)) << value;
+  }
+}
+
+class TracerTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    std::remove(path.c_str());
+  }
+
+  void TearDown() override {
+    tracer().configure(0, "");
+    std::remove(path.c_str());
+  }
+
+  std::string read() {
+    tracer().flush();
+    std::ifstream file(path);
+    return std::string(std::istreambuf_iterator<char>(file), {});
+  }
+
+  std::string path = "/tmp/tracing_test.json";
+};
+
+TEST_F(TracerTest, unsampled_is_not_recorded) {
+  auto sampled = TraceContext::parse(
+      "00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01");
+  ASSERT_FALSE(tracer().sample(sampled));
+  ASSERT_FALSE(Span("work", sampled));
+
+  tracer().configure(0, path);
+  ASSERT_FALSE(tracer().sample());
+  {
+    Span span("work", tracer().sample());
+    ASSERT_FALSE(span);
+  }
+  ASSERT_EQ(read(), "");
+  // decision of origin is followed
+  ASSERT_TRUE(tracer().sample(sampled));
+}
+
+TEST_F(TracerTest, parent_decision_is_kept) {
+  tracer().configure(1, path);
+  auto unsampled = TraceContext::parse(
+      "00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-00");
+  ASSERT_FALSE(tracer().sample(unsampled));
+  ASSERT_TRUE(tracer().sample());
+}
+
+TEST_F(TracerTest, spans_are_exported) {
+  tracer().configure(1, path);
+  auto root = tracer().sample();
+  nonstd::optional<TraceContext> parent;
+  {
+    Span span("torii", root);
+    span.attribute("height", "3");
+    parent = span.context();
+  }
+  { Span child("simulator", parent); }
+
+  auto json = read();
+  auto trace_id = parent->traceparent().substr(3, 32);
+  auto span_id = parent->traceparent().substr(36, 16);
+  ASSERT_NE(json.find("\"traceId\":\"" + trace_id + "\""), std::string::npos);
+  ASSERT_NE(json.find("\"name\":\"torii\""), std::string::npos);
+  ASSERT_NE(json.find("{\"key\":\"height\",\"value\":{\"stringValue\":\"3\"}}"),
+            std::string::npos);
+  ASSERT_NE(json.find("\"parentSpanId\":\"" + span_id
+                      + "\",\"name\":\"simulator\""),
+            std::string::npos);
+}